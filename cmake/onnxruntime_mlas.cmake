@@ -5,8 +5,13 @@ set(mlas_common_srcs
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/platform.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/threading.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/sgemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/halfgemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/sbgemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/sparsegemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/q4gemm.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qdwconv.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/sdwconv.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/convolve.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/pooling.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/transpose.cpp
@@ -17,7 +22,9 @@ set(mlas_common_srcs
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/tanh.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/erf.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/compute.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/channelnorm.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/quantize.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/convert.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qladd.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qlmul.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/qpostprocessor.cpp
@@ -25,14 +32,25 @@ set(mlas_common_srcs
 )
 
 if (onnxruntime_BUILD_WEBASSEMBLY)
-  file(GLOB_RECURSE mlas_platform_srcs
-    "${ONNXRUNTIME_ROOT}/core/mlas/lib/wasm/*.cpp"
-  )
+  if (onnxruntime_ENABLE_WEBASSEMBLY_SIMD)
+    file(GLOB_RECURSE mlas_platform_srcs
+      "${ONNXRUNTIME_ROOT}/core/mlas/lib/wasm_simd/*.cpp"
+    )
+    set(mlas_platform_srcs
+      ${mlas_platform_srcs}
+      "${ONNXRUNTIME_ROOT}/core/mlas/lib/wasm/SconvDepthwiseKernelWasmScalar.cpp"
+    )
+  else()
+    file(GLOB_RECURSE mlas_platform_srcs
+      "${ONNXRUNTIME_ROOT}/core/mlas/lib/wasm/*.cpp"
+    )
+  endif()
 elseif(MSVC)
   if(onnxruntime_target_platform STREQUAL "ARM64")
     set(mlas_platform_preprocess_srcs
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/arm64/QgemmU8X8KernelNeon.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/arm64/QgemmU8X8KernelUdot.asm
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/arm64/QgemmS8S8KernelSdot.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/arm64/SgemmKernelNeon.asm
     )
 
@@ -80,11 +98,15 @@ elseif(MSVC)
       set_source_files_properties(${mlas_common_srcs} PROPERTIES COMPILE_FLAGS "-DMLAS_AVX512F_UNSUPPORTED")
     endif()
 
+    # The SBGEMM kernels are only built with GCC and Clang.
+    set_property(SOURCE ${mlas_common_srcs} APPEND PROPERTY COMPILE_DEFINITIONS MLAS_SBGEMM_AVX512BF16_UNSUPPORTED)
+
     set(mlas_platform_srcs
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/dgemm.cpp
       ${mlas_platform_srcs_avx}
       ${mlas_platform_srcs_avx2}
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/quantize_avx512f.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/convert_avx512f.cpp
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/QgemmU8S8KernelAvx2.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/QgemmU8U8KernelAvx2.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/QgemmU8X8KernelAvx2.asm
@@ -187,9 +209,36 @@ else()
     set(mlas_platform_srcs
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/aarch64/QgemmU8X8KernelNeon.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/aarch64/QgemmU8X8KernelUdot.S
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/aarch64/QgemmS8S8KernelSdot.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/aarch64/SgemmKernelNeon.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/aarch64/SgemvKernelNeon.S
     )
+
+    # The half precision kernel requires the ARMv8.2-A FP16 extension. The
+    # extension is only enabled for this source file and the kernel is
+    # selected at runtime based on the processor capabilities.
+    set(CMAKE_REQUIRED_FLAGS "-march=armv8.2-a+fp16")
+    check_cxx_source_compiles("
+      #include <arm_neon.h>
+      int main() {
+        float16x8_t a = vdupq_n_f16(0);
+        a = vfmaq_n_f16(a, a, (__fp16)1.0f);
+        (void)a;
+        return 0;
+      }"
+      COMPILES_ARMV82_FP16_INTRINSICS
+    )
+    unset(CMAKE_REQUIRED_FLAGS)
+
+    if(COMPILES_ARMV82_FP16_INTRINSICS)
+      set(mlas_platform_srcs_fp16
+        ${ONNXRUNTIME_ROOT}/core/mlas/lib/aarch64/HalfGemmKernelNeon.cpp
+      )
+      set_source_files_properties(${mlas_platform_srcs_fp16} PROPERTIES COMPILE_FLAGS "-march=armv8.2-a+fp16")
+      list(APPEND mlas_platform_srcs ${mlas_platform_srcs_fp16})
+    else()
+      set_source_files_properties(${mlas_common_srcs} PROPERTIES COMPILE_FLAGS "-DMLAS_F16VEC_INTRINSICS_UNSUPPORTED")
+    endif()
   elseif(POWER)
     set(mlas_platform_srcs
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/power/SgemmKernelPower.cpp
@@ -261,8 +310,12 @@ else()
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/ErfKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qladd_avx2.cpp
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qdwconv_avx2.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/convert_avx2.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/activation_fast_avx2.cpp
     )
     set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
+    set_source_files_properties(${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/convert_avx2.cpp
+      PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mf16c")
 
     # Some toolchains do not support AVX512 compiler flags but are still able
     # to build the sources. Other toolchains require the AVX512 compiler flags
@@ -302,6 +355,7 @@ else()
       if(COMPILES_AVX512F_INTRINSICS)
         set(mlas_platform_srcs_avx512f
           ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/quantize_avx512f.cpp
+          ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/convert_avx512f.cpp
           ${mlas_platform_srcs_avx512f}
         )
       else()
@@ -333,6 +387,50 @@ else()
         if(HAS_AVX512CORE)
           set_source_files_properties(${mlas_platform_srcs_avx512core} PROPERTIES COMPILE_FLAGS "-mavx512bw -mavx512dq -mavx512vl")
         endif()
+
+        # The SBGEMM kernels are written with intrinsics and require compiler
+        # support for the AVX512_BF16 and AMX instruction set extensions.
+        set(CMAKE_REQUIRED_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512bf16")
+        check_cxx_source_compiles("
+          #include <immintrin.h>
+          int main() {
+            __m512 acc = _mm512_setzero_ps();
+            __m512i a = _mm512_setzero_si512();
+            acc = _mm512_dpbf16_ps(acc, (__m512bh)a, (__m512bh)a);
+            (void)acc;
+            return 0;
+          }"
+          COMPILES_AVX512BF16_INTRINSICS
+        )
+        if(COMPILES_AVX512BF16_INTRINSICS)
+          set(mlas_platform_srcs_avx512bf16
+            ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/sbgemm_kernel_avx512bf16.cpp
+          )
+          set_source_files_properties(${mlas_platform_srcs_avx512bf16} PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512bf16")
+
+          set(CMAKE_REQUIRED_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512bf16 -mamx-tile -mamx-bf16")
+          check_cxx_source_compiles("
+            #include <immintrin.h>
+            int main() {
+              _tile_zero(0);
+              _tile_dpbf16ps(0, 1, 2);
+              _tile_release();
+              return 0;
+            }"
+            COMPILES_AMX_INTRINSICS
+          )
+          if(COMPILES_AMX_INTRINSICS)
+            set(mlas_platform_srcs_amx
+              ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/sbgemm_kernel_amx.cpp
+            )
+            set_source_files_properties(${mlas_platform_srcs_amx} PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512bf16 -mamx-tile -mamx-bf16")
+          else()
+            set_property(SOURCE ${mlas_common_srcs} APPEND PROPERTY COMPILE_DEFINITIONS MLAS_SBGEMM_AMX_UNSUPPORTED)
+          endif()
+        else()
+          set_property(SOURCE ${mlas_common_srcs} APPEND PROPERTY COMPILE_DEFINITIONS MLAS_SBGEMM_AVX512BF16_UNSUPPORTED)
+        endif()
+        set(CMAKE_REQUIRED_FLAGS "")
       else()
         set_source_files_properties(${mlas_common_srcs} PROPERTIES COMPILE_FLAGS "-DMLAS_AVX512CORE_UNSUPPORTED")
       endif()
@@ -347,6 +445,8 @@ else()
       ${mlas_platform_srcs_avx2}
       ${mlas_platform_srcs_avx512f}
       ${mlas_platform_srcs_avx512core}
+      ${mlas_platform_srcs_avx512bf16}
+      ${mlas_platform_srcs_amx}
     )
   endif()
 endif()
@@ -820,6 +820,16 @@ if(onnxruntime_BUILD_BENCHMARKS)
   add_dependencies(onnxruntime_benchmark ${onnxruntime_EXTERNAL_DEPENDENCIES})
   set_target_properties(onnxruntime_benchmark PROPERTIES FOLDER "ONNXRuntimeTest")
 
+  onnxruntime_add_executable(onnxruntime_startup_benchmark ${TEST_SRC_DIR}/startup_benchmark/main.cc)
+  target_include_directories(onnxruntime_startup_benchmark PRIVATE ${ONNXRUNTIME_ROOT} ${onnxruntime_graph_header})
+  if(WIN32)
+    target_compile_options(onnxruntime_startup_benchmark PRIVATE "$<$<COMPILE_LANGUAGE:CUDA>:SHELL:--compiler-options /utf-8>"
+            "$<$<NOT:$<COMPILE_LANGUAGE:CUDA>>:/utf-8>")
+  endif()
+  target_link_libraries(onnxruntime_startup_benchmark PRIVATE ${onnx_test_libs})
+  add_dependencies(onnxruntime_startup_benchmark ${onnxruntime_EXTERNAL_DEPENDENCIES})
+  set_target_properties(onnxruntime_startup_benchmark PROPERTIES FOLDER "ONNXRuntimeTest")
+
   SET(MLAS_BENCH_DIR ${TEST_SRC_DIR}/mlas/bench)
   file(GLOB_RECURSE MLAS_BENCH_SOURCE_FILES "${MLAS_BENCH_DIR}/*.cpp" "${MLAS_BENCH_DIR}/*.h")
   onnxruntime_add_executable(onnxruntime_mlas_benchmark ${MLAS_BENCH_SOURCE_FILES})
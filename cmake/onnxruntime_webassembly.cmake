@@ -60,9 +60,19 @@ else()
 endif()
 
 if (onnxruntime_ENABLE_WEBASSEMBLY_THREADS)
-  set_property(TARGET onnxruntime_webassembly APPEND_STRING PROPERTY LINK_FLAGS " -s EXPORT_NAME=ortWasmThreaded -s USE_PTHREADS=1")
-  set_target_properties(onnxruntime_webassembly PROPERTIES OUTPUT_NAME "ort-wasm-threaded")
+  # The intra-op thread pool starts numThreads - 1 threads. Their web workers are spawned when the module is
+  # instantiated, as the browser main thread cannot wait for a worker to load while it blocks in pthread_create.
+  set_property(TARGET onnxruntime_webassembly APPEND_STRING PROPERTY LINK_FLAGS " -s EXPORT_NAME=ortWasmThreaded -s USE_PTHREADS=1 -s PTHREAD_POOL_SIZE=Module.numThreads-1")
+  if (onnxruntime_ENABLE_WEBASSEMBLY_SIMD)
+    set_target_properties(onnxruntime_webassembly PROPERTIES OUTPUT_NAME "ort-wasm-simd-threaded")
+  else()
+    set_target_properties(onnxruntime_webassembly PROPERTIES OUTPUT_NAME "ort-wasm-threaded")
+  endif()
 else()
   set_property(TARGET onnxruntime_webassembly APPEND_STRING PROPERTY LINK_FLAGS " -s EXPORT_NAME=ortWasm")
-  set_target_properties(onnxruntime_webassembly PROPERTIES OUTPUT_NAME "ort-wasm")
+  if (onnxruntime_ENABLE_WEBASSEMBLY_SIMD)
+    set_target_properties(onnxruntime_webassembly PROPERTIES OUTPUT_NAME "ort-wasm-simd")
+  else()
+    set_target_properties(onnxruntime_webassembly PROPERTIES OUTPUT_NAME "ort-wasm")
+  endif()
 endif()
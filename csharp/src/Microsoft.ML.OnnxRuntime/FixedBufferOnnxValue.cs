@@ -127,6 +127,31 @@ namespace Microsoft.ML.OnnxRuntime
             }
         }
 
+        /// <summary>
+        /// Creates a FixedBufferOnnxValue on top of a managed CPU buffer of one of the supported primitive types.
+        /// The element type and the size of the buffer are inferred from T and the memory length.
+        ///
+        /// The buffer stays pinned until the instance is disposed, so it can be bound once to an OrtIoBinding
+        /// and reused for many InferenceSession.RunWithBinding() calls: write the next inputs into the input
+        /// buffers and read the results from the output buffers without any managed allocations per run.
+        /// </summary>
+        /// <typeparam name="T">primitive type supported by Tensor, except string</typeparam>
+        /// <param name="memory">managed buffer holding at least as many elements as the shape</param>
+        /// <param name="shape">shape of the tensor to be created</param>
+        /// <returns>a disposable instance of FixedBufferOnnxValue</returns>
+        public static FixedBufferOnnxValue CreateFromMemory<T>(Memory<T> memory, long[] shape)
+        {
+            var typeInfo = TensorBase.GetTypeInfo(typeof(T));
+            if (typeInfo == null || typeInfo.IsString)
+            {
+                throw new OnnxRuntimeException(ErrorCode.InvalidArgument,
+                    "Unsupported data type: " + typeof(T).ToString() + ". Use the overload that takes the element type");
+            }
+
+            return CreateFromMemory(OrtMemoryInfo.DefaultInstance, memory, typeInfo.ElementType, shape,
+                (long)memory.Length * typeInfo.TypeSize);
+        }
+
         #region IDisposable Support
 
         /// <summary>
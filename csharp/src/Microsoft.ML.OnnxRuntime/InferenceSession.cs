@@ -476,6 +476,18 @@ namespace Microsoft.ML.OnnxRuntime
             NativeApiStatus.VerifySuccess(NativeMethods.OrtRunWithBinding(Handle, runOptions.Handle, ioBinding.Handle));
         }
 
+        /// <summary>
+        /// Same as RunWithBinding(RunOptions, OrtIoBinding) with the default run options of the session.
+        /// When the inputs and outputs are bound once to FixedBufferOnnxValue instances created with
+        /// FixedBufferOnnxValue.CreateFromMemory(), the outputs are written directly into the caller's
+        /// pinned buffers and repeated calls do not allocate any managed memory.
+        /// </summary>
+        /// <param name="ioBinding">ioBinding instance to use</param>
+        public void RunWithBinding(OrtIoBinding ioBinding)
+        {
+            RunWithBinding(_builtInRunOptions, ioBinding);
+        }
+
         /// <summary>
         ///  This method return a collection of DisposableNamedOnnxValue as in other interfaces
         ///  Query names from OrtIoBinding object and pair then with the array of OrtValues returned
@@ -100,5 +100,52 @@ namespace Microsoft.ML.OnnxRuntime.Tests
                 }
             }
         }
+
+        [Fact]
+        public void TestIOBindingWithPinnedManagedBuffers()
+        {
+            var inputName = "data_0";
+            var outputName = "softmaxout_1";
+            using (var dispList = new DisposableListTest<IDisposable>())
+            {
+                var tuple = OpenSessionSqueezeNet();
+                var session = tuple.Item1;
+                var inputData = tuple.Item2;
+                var outputData = tuple.Item4;
+                dispList.Add(session);
+
+                var inputShape = Array.ConvertAll<int, long>(session.InputMetadata[inputName].Dimensions, d => d);
+                var outputShape = Array.ConvertAll<int, long>(session.OutputMetadata[outputName].Dimensions, d => d);
+
+                // The buffers are pinned and bound once, then reused by every run
+                var inputBuffer = new float[inputData.Length];
+                var outputBuffer = new float[outputData.Length];
+                var fixedInput = FixedBufferOnnxValue.CreateFromMemory<float>(inputBuffer, inputShape);
+                dispList.Add(fixedInput);
+                var fixedOutput = FixedBufferOnnxValue.CreateFromMemory<float>(outputBuffer, outputShape);
+                dispList.Add(fixedOutput);
+
+                var ioBinding = session.CreateIoBinding();
+                dispList.Add(ioBinding);
+                ioBinding.BindInput(inputName, fixedInput);
+                ioBinding.BindOutput(outputName, fixedOutput);
+
+                for (int run = 0; run < 3; ++run)
+                {
+                    Array.Clear(outputBuffer, 0, outputBuffer.Length);
+                    Array.Copy(inputData, inputBuffer, inputData.Length);
+                    session.RunWithBinding(ioBinding);
+                    Assert.Equal(outputData, outputBuffer, new floatComparer());
+                }
+            }
+        }
+
+        [Fact]
+        public void TestCreateFromMemoryUnsupportedType()
+        {
+            var ex = Assert.Throws<OnnxRuntimeException>(
+                () => FixedBufferOnnxValue.CreateFromMemory<string>(new string[1], new long[] { 1 }));
+            Assert.Contains("Unsupported data type", ex.Message);
+        }
     }
 }
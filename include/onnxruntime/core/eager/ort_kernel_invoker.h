@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -28,10 +31,14 @@ class ORTInvoker {
     }
   }
 
+  ~ORTInvoker();
+
   IExecutionProvider& GetCurrentExecutionProvider() {
     return *execution_provider_;
   }
 
+  // The kernels are created once per op, domain, version, attributes, input types and output count, and re-used
+  // along with their execution frames by the later calls with the same ones.
   common::Status Invoke(const std::string& op_name,
                         //optional inputs / outputs?
                         const std::vector<OrtValue>& inputs,
@@ -41,8 +48,21 @@ class ORTInvoker {
                         const int version = -1);
 
  private:
+  struct CachedKernel;
+
+  common::Status CreateKernel(const std::string& op_name,
+                              const std::vector<OrtValue>& inputs,
+                              size_t output_count,
+                              const NodeAttributes* attributes,
+                              const std::string& domain,
+                              int version,
+                              std::unique_ptr<CachedKernel>& cached_kernel);
+
   std::unique_ptr<IExecutionProvider> execution_provider_;
   const logging::Logger& logger_;
+
+  std::mutex kernels_mutex_;
+  std::unordered_map<std::string, std::unique_ptr<CachedKernel>> kernels_;
 };
 
 #ifdef __GNUC__
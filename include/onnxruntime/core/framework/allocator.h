@@ -30,6 +30,13 @@ struct OrtArenaCfg {
   int initial_chunk_size_bytes;           // use -1 to allow ORT to choose the default
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_regrowth_chunk_size_bytes;  // use -1 to allow ORT to choose the default
+  // Returning idle memory while the arena is in use. See BFCArena for details.
+  int idle_release_ms = -1;                 // use -1 to only release memory on Shrink()
+  size_t idle_release_watermark_bytes = 0;  // memory kept by the arena regardless of idle time
+  size_t decommit_chunk_bytes = 0;          // use 0 to keep the pages of free chunks committed
+  size_t thread_cache_max_bytes = 0;        // use 0 to disable the per-thread caches of small free chunks
+  // CPU allocations of at least 2 MB backed by huge pages. Linux only. See HugePageAllocator for details.
+  int huge_pages = 0;  // 0 = disabled, 1 = transparent huge pages, 2 = 2 MB hugetlbfs pages, 3 = 1 GB hugetlbfs pages
 };
 
 namespace onnxruntime {
@@ -181,4 +188,30 @@ using TAllocator = CPUAllocator;
 
 using AllocatorPtr = std::shared_ptr<IAllocator>;
 
+// TODO: Do we need this class or is IAllocator::MakeUniquePtr sufficient/better
+class BufferDeleter {
+ public:
+  BufferDeleter() : alloc_(nullptr) {}
+  BufferDeleter(AllocatorPtr alloc)
+      : alloc_(alloc) {}
+
+  void operator()(void* p) const {
+    if (alloc_)
+      alloc_->Free(p);
+  }
+
+ private:
+  // TODO: we may need consider the lifetime of alloc carefully
+  // The alloc_ here is the allocator that used to allocate the buffer
+  // And need go with the unique_ptr together. If it is using our internal
+  // allocator, it is ok as our allocators are global managed. But if it
+  // is provide by user, user need to be very careful about it.
+  // A weak_ptr may be a choice to reduce the impact, but that require to
+  // change our current allocator mgr to use shared_ptr. Will revisit it
+  // later.
+  AllocatorPtr alloc_;
+};
+
+using BufferUniquePtr = std::unique_ptr<void, BufferDeleter>;
+
 }  // namespace onnxruntime
@@ -167,9 +167,41 @@ class IExecutionProvider {
   */
   virtual common::Status OnSessionInitializationEnd() { return Status::OK(); }
 
+  /**
+     Indicate whether the graph capturing mode (e.g., cuda graph) is enabled for
+     the provider. Currently only CUDA execution provider supports it.
+   */
+  virtual bool IsGraphCaptureEnabled() const { return false; }
+
+  /**
+     Indicate whether the graph has been captured and instantiated.
+     Currently only CUDA execution provider supports it.
+   */
+  virtual bool IsGraphCaptured() const { return false; }
+
+  /**
+     Run the instantiated graph.
+     Currently only CUDA execution provider supports it.
+   */
+  virtual common::Status ReplayGraph() { return Status::OK(); }
+
+  /**
+     Discard the captured graph so that it is captured again by a later Run.
+     Currently only CUDA execution provider supports it.
+   */
+  virtual void ResetGraph() {}
+
   virtual common::Status SetComputeStream(void*) { return Status::OK(); }
   virtual void* GetComputeStream() const { return nullptr; }
 
+  /**
+     Get the exec queue ids of the compute streams of the provider, starting with the default queue 0.
+     If a provider returns more than one id, the allocation planner assigns independent branches of the graph
+     to different queues and kernels run on the queue returned by OpKernelContext::GetExecQueueId().
+     Currently only CUDA execution provider supports more than one compute stream.
+   */
+  virtual std::vector<int> GetComputeQueueIds() const { return {0}; }
+
   void InsertAllocator(AllocatorPtr allocator);
   void ReplaceAllocator(AllocatorPtr allocator);
   // TODO: temparary sulotion, need to unify the interface in EP and AllocatorManager
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -95,8 +98,36 @@ class KernelRegistry {
   static std::string GetMapKey(const KernelDef& kernel_def) {
     return GetMapKey(kernel_def.OpName(), kernel_def.Domain(), kernel_def.Provider());
   }
+
+  struct IndexEntry {
+    int start_version;
+    int end_version;
+    const KernelCreateInfo* create_info;  // points into kernel_creator_fn_map_
+  };
+
+  // Hash of the op name, domain and provider. Identifies the same kernels as GetMapKey without building a string.
+  static uint64_t GetIndexKey(const std::string& op_name, const std::string& domain, const std::string& provider);
+
+  // Adds a kernel in kernel_creator_fn_map_ to kernel_index_ and kernel_def_hash_index_.
+  void AddToIndex(const KernelCreateInfo& create_info);
+
+  // Returns the kernel_index_ entries for the op and domain of the node and the provider, or nullptr if there are
+  // none. On a hash collision the entries include the kernels of other ops.
+  const std::vector<IndexEntry>* FindIndexEntries(const onnxruntime::Node& node, const std::string& provider) const;
+
   // Kernel create function map from op name to kernel creation info.
   // key is opname+domain_name+provider_name
   KernelCreateMap kernel_creator_fn_map_;
+
+  // Lookup index for TryFindKernel. Maps GetIndexKey to the kernels registered for the op, domain and provider,
+  // sorted by start version. A node is resolved without building the map key and only the kernels whose version
+  // range matches the node have their type constraints checked, which is usually a single kernel.
+  std::unordered_map<uint64_t, std::vector<IndexEntry>> kernel_index_;
+
+  // Kernel def hash to kernel, for nodes from ORT format models.
+  std::unordered_map<uint64_t, const KernelCreateInfo*> kernel_def_hash_index_;
+
+  // the indexes point into kernel_creator_fn_map_
+  ORT_DISALLOW_COPY_AND_ASSIGNMENT(KernelRegistry);
 };
 }  // namespace onnxruntime
@@ -68,6 +68,55 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function together with UseSharedPrePackedBuffers to allow the buffers packed by PrePack to be
+  // shared with other kernels when the session uses a shared prepacked weights container.
+  // It is called after PrePack packed the tensor at input_idx, and the kernel moves the buffers it packed into
+  // prepacked_buffers. Leave prepacked_buffers empty if the buffers cannot be shared.
+  // @param input_idx: The input index of the tensor that was packed
+  // @param prepacked_buffers: The buffers owned by the kernel for input_idx
+  virtual Status TransferPrePackedBuffers(int /*input_idx*/, std::vector<BufferUniquePtr>& /*prepacked_buffers*/) {
+    return Status::OK();
+  }
+
+  // Override this function together with TransferPrePackedBuffers.
+  // It is called after TransferPrePackedBuffers with the shared buffers for the tensor at input_idx, in the order
+  // they were transferred. The buffers are owned by the container, and the kernel keeps using them in place of the
+  // buffers it transferred.
+  // @param prepacked_buffers: Buffers that do not free the memory they point to
+  // @param input_idx: The input index of the tensor that was packed
+  // @param used_shared_buffers: Set it to true if the kernel uses the shared buffers
+  virtual Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                           int /*input_idx*/,
+                                           bool& used_shared_buffers) {
+    used_shared_buffers = false;
+    return Status::OK();
+  }
+
+  // Override this function together with UseSavedPrePackedBuffers to allow the buffers packed by PrePack to be saved
+  // in an ORT format model, so a session loading the model on a CPU with the same instruction sets can skip PrePack.
+  // It is called after PrePack packed the tensor at input_idx. Leave prepacked_buffers empty if the buffers
+  // cannot be saved.
+  // @param input_idx: The input index of the tensor that was packed
+  // @param prepacked_buffers: Views of the buffers the kernel uses for input_idx
+  virtual Status GetPrePackedBuffers(int /*input_idx*/,
+                                     std::vector<gsl::span<const uint8_t>>& /*prepacked_buffers*/) const {
+    return Status::OK();
+  }
+
+  // Override this function together with GetPrePackedBuffers.
+  // It is called instead of PrePack with the buffers GetPrePackedBuffers returned when the model was saved. The views
+  // are only valid during the call, so the kernel copies the buffers it uses.
+  // @param tensor: The initialized constant tensor
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param prepacked_buffers: The saved buffers, in the order GetPrePackedBuffers returned them
+  // @param used_saved_buffers: Set it to true if the kernel uses the saved buffers. PrePack is called otherwise.
+  virtual Status UseSavedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                          const std::vector<gsl::span<const uint8_t>>& /*prepacked_buffers*/,
+                                          bool& used_saved_buffers) {
+    used_saved_buffers = false;
+    return Status::OK();
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const;
   const OpKernelInfo& Info() const { return *op_kernel_info_; }
 
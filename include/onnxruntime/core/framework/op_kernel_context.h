@@ -169,6 +169,13 @@ class OpKernelContext {
     return true;
   }
 
+  /**
+  Returns the id of the execution queue that the kernel runs on.
+  This is the queue id of the kernel definition unless the session planned the node onto another compute queue
+  of the execution provider.
+  */
+  virtual int GetExecQueueId() const;
+
  protected:
   onnxruntime::NodeIndex GetNodeIndex() const;
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/framework/config_options.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/ml_value.h"
@@ -27,7 +28,8 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
                         const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                         const OrtValueNameIdxMap& mlvalue_name_idx_map,
                         const FuncManager& funcs_mgr,
-                        const DataTransferManager& data_transfer_mgr);
+                        const DataTransferManager& data_transfer_mgr,
+                        const ConfigOptions* config_options = nullptr);
 
   OpKernelInfo(const OpKernelInfo& other);
 
@@ -45,6 +47,11 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
 
   bool TryGetConstantInput(int input_index, const Tensor** constant_input_value) const;
 
+  // The session configuration options. They are only available while the kernel is being constructed,
+  // so a kernel should read the entries it needs in its constructor. Copies of this instance (such as the one
+  // held by OpKernel) and kernels not created by a session see an empty set of options.
+  const ConfigOptions& GetConfigOptions() const noexcept;
+
   common::Status GetFusedFuncs(NodeComputeInfo*& compute_info) const;
 
  private:
@@ -60,6 +67,7 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
   const OrtValueNameIdxMap& ort_value_name_idx_map_;
   const FuncManager& funcs_mgr_;
   const DataTransferManager& data_transfer_mgr_;
+  const ConfigOptions* config_options_;
   ProtoHelperNodeContext proto_helper_context_;
 };
 
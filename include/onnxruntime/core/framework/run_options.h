@@ -5,8 +5,10 @@
 
 #include <string>
 #include <atomic>
+#include <unordered_map>
 #include "core/session/onnxruntime_c_api.h"
 #include "core/framework/config_options.h"
+#include "core/framework/ortmemoryinfo.h"
 
 /**
  * Configuration information for a Run call.
@@ -38,6 +40,17 @@ struct OrtRunOptions {
   // /include/onnxruntime/core/session/onnxruntime_run_options_config_keys.h
   onnxruntime::ConfigOptions config_options;
 
+  // A caller owned buffer that an output is written into if the output fits in it.
+  struct OutputBuffer {
+    void* data{nullptr};
+    size_t size{0};  // in bytes
+    OrtMemoryInfo memory_info;
+  };
+
+  // Caller owned buffers for the outputs of the Run calls that are not pre-allocated, by output name.
+  // To set a buffer, call OrtApis::RunOptionsSetOutputBuffer
+  std::unordered_map<std::string, OutputBuffer> output_buffers;
+
   OrtRunOptions() = default;
   ~OrtRunOptions() = default;
 };
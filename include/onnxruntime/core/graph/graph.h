@@ -334,7 +334,10 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    verified_type_versions_.clear();
+    return attributes_;
+  }
 
   /** Gets the Graph instance that is instantiated from a GraphProto attribute during Graph::Resolve.
   @param attr_name Attribute name for the GraphProto attribute.
@@ -491,6 +494,14 @@ class Node {
             const NodeAttributes* attributes,
             const std::string& domain);
 
+  void Init(const std::string& name,
+            const std::string& op_type,
+            const std::string& description,
+            const std::vector<NodeArg*>& input_args,
+            const std::vector<NodeArg*>& output_args,
+            NodeAttributes&& attributes,
+            const std::string& domain);
+
   // internal only method to allow selected classes to directly alter the input/output definitions and arg counts
   Definitions& MutableDefinitions() noexcept;
 
@@ -565,6 +576,10 @@ class Node {
 
   // Graph instances for subgraphs that are owned by this Node
   std::vector<std::unique_ptr<Graph>> subgraphs_;
+
+  // The number of input defs followed by the type versions of the input and output defs when the node's types were
+  // last inferred by Graph::Resolve. Empty if they need to be inferred again, e.g. because an attribute changed.
+  std::vector<size_t> verified_type_versions_;
 };
 
 /**
@@ -1068,8 +1083,10 @@ class Graph {
     return Resolve(default_options);
   }
 
+  // If compress_initializers is true, the raw data of the large initializers is compressed when it saves enough space.
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                 flatbuffers::Offset<onnxruntime::experimental::fbs::Graph>& fbs_graph) const;
+                                 flatbuffers::Offset<onnxruntime::experimental::fbs::Graph>& fbs_graph,
+                                 bool compress_initializers = false) const;
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
@@ -1105,6 +1122,7 @@ class Graph {
 #if !defined(ORT_MINIMAL_BUILD)
       IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
+      bool use_ort_format_bytes_for_initializers,
       const logging::Logger& logger, std::unique_ptr<Graph>& graph);
 
   // deserialize a subgraph
@@ -1132,7 +1150,9 @@ class Graph {
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
   // Populate Graph instance from ORT format serialized data.
-  common::Status LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs_graph);
+  // If use_ort_format_bytes_for_initializers is true the initializers refer to the data in fbs_graph.
+  common::Status LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs_graph,
+                                   bool use_ort_format_bytes_for_initializers);
 #endif
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -1161,6 +1181,10 @@ class Graph {
   Node& AddNode(const ONNX_NAMESPACE::NodeProto& node_proto,
                 const ArgNameToTypeMap& name_to_type);
 
+  // Add node with specified <node_proto>, moving its attributes into the node.
+  Node& AddNode(ONNX_NAMESPACE::NodeProto&& node_proto,
+                const ArgNameToTypeMap& name_to_type);
+
 #endif
 
   Version IrVersion() const noexcept {
@@ -1248,6 +1272,13 @@ class Graph {
   // information matches between node and op.
   common::Status VerifyNodeAndOpMatch(const ResolveOptions& options);
 
+  // Returns true if the types of the node were inferred by a previous Resolve and neither the node's attributes, its
+  // input and output NodeArgs, their types, nor the initializers it consumes have changed since.
+  bool NodeTypesAreUpToDate(const Node& node) const;
+
+  // Records the state of the node after its types were inferred so NodeTypesAreUpToDate can check it.
+  void SetNodeTypesUpToDate(Node& node) const;
+
   // Set graph inputs/outputs when resolving a graph..
   common::Status SetGraphInputsOutputs();
 
@@ -1352,6 +1383,13 @@ class Graph {
 
   bool graph_proto_sync_needed_ = false;
 
+  // The NodeProtos of graph_proto_ were moved into the nodes when loading, so graph_proto_ must be synced before use.
+  bool node_protos_released_ = false;
+
+  // Initializers added, removed or replaced, and graph inputs changed, since the last Resolve. The type inferencing of
+  // the nodes consuming them may read the initializer data, so it must be repeated.
+  std::unordered_set<std::string> modified_initializer_names_;
+
   // The topological order of node index used to do node and op match verification temporarily.
   std::vector<NodeIndex> nodes_in_topological_order_;
 
@@ -1421,6 +1459,11 @@ class Graph {
 
   // distinguishes between graph loaded from model file and graph created from scratch
   const bool is_loaded_from_model_file_;
+
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  // initializers refer to the ORT format bytes rather than holding a copy. subgraphs inherit this.
+  bool use_ort_format_bytes_for_initializers_ = false;
+#endif
 };
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -112,5 +112,9 @@ class NodeArg {
 
   // Flag indicates whether <*this> node arg exists or not.
   bool exists_;
+
+  // Changes whenever the type or shape changes. Graph::Resolve uses it to skip the type and shape inferencing of
+  // nodes whose inputs and outputs are unchanged.
+  size_t type_version_;
 };
 }  // namespace onnxruntime
@@ -10,6 +10,9 @@
 #include "core/optimizer/graph_transformer_level.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 
 /**
 @class GraphTransformer
@@ -35,15 +38,31 @@ class GraphTransformer {
 
   /** Apply the in-place transformation defined by this transformer to the provided Graph instance.
   @param[out] modified Set to true if the Graph was modified.
+  @param thread_pool Optional thread pool the transformer may use. See SupportsParallelSubgraphs and GetThreadPool.
   @returns Status with success or error information.
   */
-  common::Status Apply(Graph& graph, bool& modified, const logging::Logger& logger) const;
+  common::Status Apply(Graph& graph, bool& modified, const logging::Logger& logger,
+                       concurrency::ThreadPool* thread_pool = nullptr) const;
 
   virtual bool ShouldOnlyApplyOnce() const { return false; }
 
+  /** Returns true if ApplyImpl only modifies the Graph it is given, and its result on a subgraph does not depend on
+  the transformation of the outer graphs. Apply then transforms the subgraphs of the main graph concurrently on the
+  thread pool before the main graph, instead of when ApplyImpl calls Recurse.
+  */
+  virtual bool SupportsParallelSubgraphs() const { return false; }
+
  protected:
+  /** Gets the thread pool passed to Apply, or nullptr. Only valid during ApplyImpl. */
+  concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
+
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   common::Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
+    // the subgraphs of the main graph were transformed in parallel by Apply
+    if (graph_level == 0 && main_graph_subgraphs_applied_) {
+      return Status::OK();
+    }
+
     int subgraph_level = ++graph_level;
     for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
       auto& subgraph = *entry.second;
@@ -56,6 +75,9 @@ class GraphTransformer {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformer);
 
+  // Applies ApplyImpl to the subgraphs of the nodes in the main graph in parallel.
+  common::Status ApplyToSubgraphsInParallel(Graph& graph, bool& modified, const logging::Logger& logger) const;
+
   // Apply the transform to the graph.
   // graph_level is 0 for the main graph, and is incremented when descending into the subgraph of a node.
   // You MUST call Recurse for all valid Nodes in the graph to ensure any subgraphs in control flow nodes
@@ -68,5 +90,9 @@ class GraphTransformer {
 
   const std::string name_;
   const std::unordered_set<std::string> compatible_provider_types_;
+
+  // state of the current Apply call
+  mutable concurrency::ThreadPool* thread_pool_ = nullptr;
+  mutable bool main_graph_subgraphs_applied_ = false;
 };
 }  // namespace onnxruntime
@@ -24,6 +24,7 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <limits>
 #include <memory>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
@@ -36,6 +37,7 @@
 #include "core/common/spin_pause.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -61,6 +63,13 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   Within that bound the spin is adaptive: the pool tracks the
+//   average time between the starts of parallel sections, and a
+//   worker spins only when the next section is expected soon enough
+//   for spinning to pay off.  Callers can also keep the workers hot
+//   (spinning without bound, even if spinning is disabled) for the
+//   duration of a request via StartKeepWorkersHot/EndKeepWorkersHot,
+//   letting them block between requests.
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -137,6 +146,10 @@
 //   respective sets of preferred workers.
 
 namespace onnxruntime {
+namespace profiling {
+class HardwareCounters;
+}  // namespace profiling
+
 namespace concurrency {
 
 #ifdef _WIN32
@@ -189,7 +202,9 @@ struct PaddingToAvoidFalseSharing {
 2. Inside thread pool, call LogStart() before interested section and LogEnd... after to log elapsed time;
 3. To extend, just add more events in enum Event before "All", and update GetEventName(...) accordingly;
 4. Note LogStart must pair with either LogEnd or LogEndAndStart, otherwise ORT_ENFORCE will fail;
-5. ThreadPoolProfiler is thread-safe.
+5. ThreadPoolProfiler is thread-safe;
+6. With the task trace, each task is logged with LogTask by the thread that ran it, tagged with the thread that
+   started the loop or queued the work item, and TakeTasks returns the tasks of the calling thread.
 */
 #ifdef ORT_MINIMAL_BUILD
 class ThreadPoolProfiler {
@@ -205,8 +220,11 @@ class ThreadPoolProfiler {
   ThreadPoolProfiler(int, const CHAR_TYPE*){};
   ~ThreadPoolProfiler() = default;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
-  void Start(){};
+  void Start(bool = false, bool = false){};
   std::string Stop() { return "not available for minimal build"; }
+  bool TaskTraceEnabled() const { return false; }
+  void LogTask(std::thread::id, const ThreadPoolTaskRecord&){};
+  void TakeTasks(std::vector<ThreadPoolTaskRecord>&){};
   void LogStart(){};
   void LogEnd(ThreadPoolEvent){};
   void LogEndAndStart(ThreadPoolEvent){};
@@ -231,8 +249,13 @@ class ThreadPoolProfiler {
   ~ThreadPoolProfiler();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
   using Clock = std::chrono::high_resolution_clock;
-  void Start();                  //called by executor to start profiling
+  void Start(bool with_hardware_counters = false, bool with_task_trace = false);  //called by executor to start profiling
   std::string Stop();            //called by executor to stop profiling and return collected numbers
+  bool TaskTraceEnabled() const {
+    return enabled_ && task_trace_enabled_;
+  }
+  void LogTask(std::thread::id origin, const ThreadPoolTaskRecord& task);  //called by the thread that ran the task
+  void TakeTasks(std::vector<ThreadPoolTaskRecord>& tasks);  //called by executor to move out the tasks of its thread
   void LogStart();               //called in main thread to record the starting time point
   void LogEnd(ThreadPoolEvent);  //called in main thread to calculate and save the time elapsed from last start point
   void LogEndAndStart(ThreadPoolEvent);
@@ -264,10 +287,18 @@ class ThreadPoolProfiler {
     uint64_t num_run_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  //core that the child thread is running on
+    int os_thread_id_ = 0;  //id used to open the hardware counters of the child thread
     PaddingToAvoidFalseSharing padding_; //to prevent false sharing
   };
   std::vector<ChildThreadStat> child_thread_stats_;
+  bool hardware_counters_enabled_ = false;
+  OrtMutex counters_mutex_;
+  std::vector<std::unique_ptr<profiling::HardwareCounters>> child_thread_counters_;
   std::string thread_pool_name_;
+  bool task_trace_enabled_ = false;
+  OrtMutex tasks_mutex_;
+  // the tasks logged since the last TakeTasks of the thread that started their loops or queued them
+  std::vector<std::pair<std::thread::id, ThreadPoolTaskRecord>> tasks_;
 };
 #endif
 
@@ -314,8 +345,21 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   // two loops execute in series in a parallel section. ]
   virtual void RunInParallel(std::function<void(unsigned idx)> fn,
                              unsigned n, std::ptrdiff_t block_size) = 0;
-  virtual void StartProfiling()  = 0;
-  virtual std::string StopProfiling() = 0;
+  virtual void StartProfiling(bool with_hardware_counters, bool with_task_trace) = 0;
+  virtual std::string StopProfiling(std::vector<ThreadPoolTaskRecord>* tasks) = 0;
+  // Whether the tasks run by the pool are recorded, and records one.  Used by the parallel loops of threadpool.cc
+  // to record the blocks of iterations.
+  virtual bool TaskTraceEnabled() const = 0;
+  virtual void LogTask(std::thread::id origin, const ThreadPoolTaskRecord& task) = 0;
+  // Fills in the always-on counters of the pool, other than num_threads.
+  virtual void GetUtilization(ThreadPoolUtilization& utilization) const = 0;
+
+  // Keep the workers spinning for work, rather than blocking, until
+  // the matching EndKeepWorkersHot.  Calls may overlap, e.g. from
+  // concurrent requests, and the workers stay hot until the last one
+  // ends.
+  virtual void StartKeepWorkersHot() = 0;
+  virtual void EndKeepWorkersHot() = 0;
 };
 
 
@@ -670,14 +714,36 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
  public:
 
-  void StartProfiling() override {
-    profiler_.Start();
+  void StartProfiling(bool with_hardware_counters, bool with_task_trace) override {
+    profiler_.Start(with_hardware_counters, with_task_trace);
   }
 
-  std::string StopProfiling() override {
+  std::string StopProfiling(std::vector<ThreadPoolTaskRecord>* tasks) override {
+    if (tasks) {
+      profiler_.TakeTasks(*tasks);
+    }
     return profiler_.Stop();
   }
 
+  bool TaskTraceEnabled() const override {
+    return profiler_.TaskTraceEnabled();
+  }
+
+  void LogTask(std::thread::id origin, const ThreadPoolTaskRecord& task) override {
+    profiler_.LogTask(origin, task);
+  }
+
+  void GetUtilization(ThreadPoolUtilization& utilization) const override {
+    utilization.parallel_loops = parallel_loops_.load(std::memory_order_relaxed);
+    utilization.parallel_loop_ns = parallel_loop_ns_.load(std::memory_order_relaxed);
+    utilization.scheduled_tasks = scheduled_tasks_.load(std::memory_order_relaxed);
+    utilization.task_queue_ns = task_queue_ns_.load(std::memory_order_relaxed);
+    utilization.worker_busy_ns = 0;
+    for (size_t i = 0; i < worker_data_.size(); i++) {
+      utilization.worker_busy_ns += worker_data_[i].busy_ns.load(std::memory_order_relaxed);
+    }
+  }
+
   struct Tag {
     constexpr Tag() : v_(0) {
     }
@@ -738,6 +804,38 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    // Group the workers by NUMA node.  Grouping is only used when the
+    // workers span more than one node.
+    if (thread_options.numa_node.size() >= num_threads_) {
+      std::vector<std::vector<unsigned>> workers_by_node;
+      for (auto i = 0u; i < num_threads_; i++) {
+        const int node = thread_options.numa_node[i];
+        assert(node >= 0);
+        if (static_cast<size_t>(node) >= workers_by_node.size()) {
+          workers_by_node.resize(node + 1);
+        }
+        workers_by_node[node].push_back(i);
+      }
+      worker_node_.resize(num_threads_);
+      for (auto& workers : workers_by_node) {
+        if (workers.empty()) {
+          continue;
+        }
+        for (unsigned w : workers) {
+          worker_node_[w] = static_cast<unsigned>(node_workers_.size());
+        }
+        node_start_.push_back(static_cast<unsigned>(node_order_.size()));
+        node_order_.insert(node_order_.end(), workers.begin(), workers.end());
+        node_workers_.push_back(std::move(workers));
+      }
+      if (node_workers_.size() < 2) {
+        worker_node_.clear();
+        node_workers_.clear();
+        node_order_.clear();
+        node_start_.clear();
+      }
+    }
+
     worker_data_.resize(num_threads_);
     for (auto i = 0u; i < num_threads_; i++) {
       worker_data_[i].thread.reset(env_.CreateThread(name, i, WorkerLoop, this, thread_options));
@@ -763,9 +861,28 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
   void Schedule(std::function<void()> fn) override {
     PerThread* pt = GetPerThread();
-    int q_idx = Rand(&pt->rand) % num_threads_;
+    int q_idx;
+    if (!node_workers_.empty() && pt->pool == this) {
+      // Keep work submitted by a worker on the worker's NUMA node.
+      const auto& workers = node_workers_[worker_node_[pt->thread_id]];
+      q_idx = workers[Rand(&pt->rand) % workers.size()];
+    } else {
+      q_idx = Rand(&pt->rand) % num_threads_;
+    }
     WorkerData &td = worker_data_[q_idx];
     Queue& q = td.queue;
+    // Record how long the task waits for a thread to pick it up
+    const bool trace = profiler_.TaskTraceEnabled();
+    fn = [this, scheduled = std::chrono::steady_clock::now(), fn = std::move(fn), trace,
+          origin = std::this_thread::get_id(), enqueue_time = TraceNow(trace)]() {
+      scheduled_tasks_.fetch_add(1, std::memory_order_relaxed);
+      task_queue_ns_.fetch_add(ElapsedNs(scheduled), std::memory_order_relaxed);
+      const auto start_time = TraceNow(trace);
+      fn();
+      if (trace) {
+        LogWorkItem(origin, enqueue_time, start_time);
+      }
+    };
     fn = q.PushBack(std::move(fn));
     if (!fn) {
       // The queue accepted the work; ensure that the thread will pick it up
@@ -806,6 +923,7 @@ void StartParallelSectionInternal(PerThread &pt,
   assert((!pt.leading_par_section) && "Nested parallelism not supported");
   assert((!ps.active) && "Starting parallel section, but active already");
   pt.leading_par_section = true;
+  RecordParallelSectionArrival();
   if (!pt.tag.Get()) {
     pt.tag = Tag::GetNext();
   }
@@ -909,6 +1027,25 @@ void EndParallelSection(ThreadPoolParallelSection &ps) override {
   EndParallelSectionInternal(*pt, ps);
 }
 
+// The first caller to keep the workers hot wakes any blocked workers,
+// so that the first loop of the request does not wait for OS
+// wake-ups.  Workers notice the end of the last call the next time
+// they check their spin budget, and then fall back to the adaptive
+// spin-then-block policy.
+void StartKeepWorkersHot() override {
+  if (hot_requests_.fetch_add(1, std::memory_order_relaxed) == 0) {
+    for (auto& td : worker_data_) {
+      td.EnsureAwake();
+    }
+  }
+}
+
+void EndKeepWorkersHot() override {
+  const int prev = hot_requests_.fetch_sub(1, std::memory_order_relaxed);
+  assert(prev > 0 && "EndKeepWorkersHot without StartKeepWorkersHot");
+  (void)prev;
+}
+
 //----------------------------------------------------------------------
 //
 // Preferred workers
@@ -1014,6 +1151,19 @@ void InitializePreferredWorkers(std::vector<int> &preferred_workers) {
   static std::atomic<unsigned> next_worker;
   // preferred_workers maps from a par_idx to a q_idx, hence we
   // initialize slots in the range [0,num_threads_]
+  if (!node_workers_.empty()) {
+    // Successive par_idx values map to the workers of one NUMA node
+    // before moving on to the next node, so that contiguous ranges
+    // of a loop run on the same node.  Different main threads start
+    // at different nodes.
+    if (preferred_workers.size() <= num_threads_) {
+      unsigned start = node_start_[next_worker++ % node_start_.size()];
+      while (preferred_workers.size() <= num_threads_) {
+        preferred_workers.push_back(node_order_[(start + preferred_workers.size()) % num_threads_]);
+      }
+    }
+    return;
+  }
   while (preferred_workers.size() <= num_threads_) {
     preferred_workers.push_back(next_worker++ % num_threads_);
   }
@@ -1026,6 +1176,12 @@ void UpdatePreferredWorker(std::vector<int> &preferred_workers,
   unsigned ran_on_idx = GetPerThread()->thread_id;
   assert(ran_on_idx >= 0 && ran_on_idx < num_threads_);
   assert(par_idx < preferred_workers.size());
+  // Do not let a task stolen by another NUMA node move its par_idx
+  // off the node that it was assigned to.
+  if (!node_workers_.empty() &&
+      worker_node_[ran_on_idx] != worker_node_[preferred_workers[par_idx] % num_threads_]) {
+    return;
+  }
   preferred_workers[par_idx] = ran_on_idx;
 }
 
@@ -1036,7 +1192,9 @@ void ScheduleOnPreferredWorkers(PerThread& pt,
                                 std::vector<int> &preferred_workers,
                                 unsigned par_idx_start,
                                 unsigned par_idx_end,
-                                std::function<void(unsigned)> worker_fn) {
+                                std::function<void(unsigned)> worker_fn,
+                                std::thread::id origin) {
+  const bool trace = profiler_.TaskTraceEnabled();
   for (auto par_idx = par_idx_start; par_idx < par_idx_end; ++par_idx) {
     // Look up hint for par_idx.  Note that the hints may have been
     // recorded from a prior thread pool with a different number of
@@ -1049,11 +1207,16 @@ void ScheduleOnPreferredWorkers(PerThread& pt,
     unsigned w_idx;
 
     // Attempt to enqueue the task
-    auto push_status = q.PushBackWithTag([worker_fn, par_idx, &preferred_workers, &ps, this]() {
+    auto push_status = q.PushBackWithTag([worker_fn, par_idx, &preferred_workers, &ps, this,
+                                          trace, origin, enqueue_time = TraceNow(trace)]() {
+        const auto start_time = TraceNow(trace);
         // Record the worker thread that actually runs this task.
         // This will form the preferred worker for the next loop.
         UpdatePreferredWorker(preferred_workers, par_idx);
         worker_fn(par_idx);
+        if (trace) {
+          LogWorkItem(origin, enqueue_time, start_time);
+        }
         ps.tasks_finished++;
       },
       pt.tag,
@@ -1117,6 +1280,10 @@ void RunInParallelInternal(PerThread& pt,
   std::vector<int> &preferred_workers = pt.preferred_workers;
   InitializePreferredWorkers(preferred_workers);
 
+  // The tasks of the loop are attributed to the calling thread in the
+  // task trace, whichever thread queues them.
+  const std::thread::id origin = std::this_thread::get_id();
+
   // current_dop is the degree of parallelism via any workers already
   // participating in the current parallel section.  Usually, for
   // single-loop parallel sections, current_dop=1.
@@ -1132,7 +1299,10 @@ void RunInParallelInternal(PerThread& pt,
       assert(current_dop == 1);
       
       // Task for dispatching work asynchronously.
-      Task dispatch_task = [current_dop, new_dop, worker_fn, &preferred_workers, &ps, &pt, this]() {
+      const bool trace = profiler_.TaskTraceEnabled();
+      Task dispatch_task = [current_dop, new_dop, worker_fn, &preferred_workers, &ps, &pt, this,
+                            trace, origin, enqueue_time = TraceNow(trace)]() {
+        const auto start_time = TraceNow(trace);
         // Record that dispatch work has started.  This must occur
         // prior to scheduling tasks, in order to synchronize with
         // EndParallelSectionInternal.  [ If EndParallelSection
@@ -1143,7 +1313,7 @@ void RunInParallelInternal(PerThread& pt,
         ps.dispatch_started.store(true, std::memory_order_seq_cst);
 
         // Schedule tasks par_idx=[current_dop+1,new_dop)
-        ScheduleOnPreferredWorkers(pt, ps, preferred_workers, current_dop+1, new_dop, worker_fn);
+        ScheduleOnPreferredWorkers(pt, ps, preferred_workers, current_dop+1, new_dop, worker_fn, origin);
         ps.dispatch_done.store(true, std::memory_order_release);
 
         // Record the worker thread that actually runs this task.
@@ -1152,6 +1322,9 @@ void RunInParallelInternal(PerThread& pt,
 
         // Run dispatcher task's own work, par_idx=current_dop
         worker_fn(current_dop);
+        if (trace) {
+          LogWorkItem(origin, enqueue_time, start_time);
+        }
 
         // Dispatcher's work complete
         ps.work_done.store(true, std::memory_order_release);
@@ -1178,7 +1351,7 @@ void RunInParallelInternal(PerThread& pt,
       profiler_.LogEnd(ThreadPoolProfiler::DISTRIBUTION_ENQUEUE);
     } else {
       // Synchronous dispatch
-      ScheduleOnPreferredWorkers(pt, ps, preferred_workers, current_dop, new_dop, std::move(worker_fn));
+      ScheduleOnPreferredWorkers(pt, ps, preferred_workers, current_dop, new_dop, std::move(worker_fn), origin);
     }
     ps.current_dop = new_dop;
   }
@@ -1192,6 +1365,7 @@ void RunInParallelSection(ThreadPoolParallelSection &ps,
                           std::function<void(unsigned idx)> fn,
                           unsigned n,
                           std::ptrdiff_t block_size) override {
+  const auto loop_start = std::chrono::steady_clock::now();
   profiler_.LogStartAndCoreAndBlock(block_size);
   PerThread* pt = GetPerThread();
   assert(pt->leading_par_section && "RunInParallel, but not in parallel section");
@@ -1234,6 +1408,7 @@ void RunInParallelSection(ThreadPoolParallelSection &ps,
     onnxruntime::concurrency::SpinPause();
   }
   profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+  RecordParallelLoop(loop_start);
 }
 
 // Run a single parallel loop _without_ a parallel section.  This is a
@@ -1249,6 +1424,7 @@ void RunInParallelSection(ThreadPoolParallelSection &ps,
 // For all other threads:
 //  1. run fn(...);
 void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) override {
+  const auto loop_start = std::chrono::steady_clock::now();
   profiler_.LogStartAndCoreAndBlock(block_size);
   PerThread* pt = GetPerThread();
   ThreadPoolParallelSection ps;
@@ -1259,6 +1435,7 @@ void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdif
   profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
   EndParallelSectionInternal(*pt, ps);  // wait for all
   profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+  RecordParallelLoop(loop_start);
 }
 
 
@@ -1312,6 +1489,7 @@ int CurrentThreadId() const EIGEN_FINAL {
     int thread_id{-1};                // Worker thread index in pool.
     Tag tag{};                        // Work item tag used to identify this thread.
     bool leading_par_section{false};  // Leading a parallel section (used only for asserts)
+    bool task_stolen{false};          // The running task was stolen from another worker (for the task trace)
 
     // When this thread is entering a parallel section, it will
     // initially push work to this set of workers.  The aim is to
@@ -1328,6 +1506,9 @@ int CurrentThreadId() const EIGEN_FINAL {
     std::unique_ptr<Thread> thread;
     Queue queue;
 
+    // Time spent running tasks, reported by GetUtilization
+    std::atomic<uint64_t> busy_ns{0};
+
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
     // purposes:
@@ -1420,9 +1601,102 @@ int CurrentThreadId() const EIGEN_FINAL {
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
+
+  // NUMA grouping of the workers, empty unless the workers span more
+  // than one node.  node_workers_ lists the workers of each non-empty
+  // node, worker_node_ maps a worker to its index in node_workers_,
+  // node_order_ is the concatenation of node_workers_, and node_start_
+  // is the offset of each node within node_order_.
+  std::vector<unsigned> worker_node_;
+  std::vector<std::vector<unsigned>> node_workers_;
+  std::vector<unsigned> node_order_;
+  std::vector<unsigned> node_start_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
+  // Always-on counters reported by GetUtilization
+  std::atomic<uint64_t> parallel_loops_{0};
+  std::atomic<uint64_t> parallel_loop_ns_{0};
+  std::atomic<uint64_t> scheduled_tasks_{0};
+  std::atomic<uint64_t> task_queue_ns_{0};
+
+  static uint64_t ElapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+  }
+
+  // The time of a task trace event, which is left unset when the trace
+  // is disabled to keep the clock reads off the fast paths.
+  static onnxruntime::TimePoint TraceNow(bool trace) {
+    return trace ? std::chrono::high_resolution_clock::now() : onnxruntime::TimePoint();
+  }
+
+  // Log a work item to the task trace.  Work items log themselves
+  // before signalling their completion, so that the record is in
+  // place when the thread waiting for them takes its tasks.
+  void LogWorkItem(std::thread::id origin, const onnxruntime::TimePoint& enqueue_time,
+                   const onnxruntime::TimePoint& start_time) {
+    PerThread* pt = GetPerThread();
+    ThreadPoolTaskRecord task;
+    task.enqueue_time = enqueue_time;
+    task.start_time = start_time;
+    task.end_time = std::chrono::high_resolution_clock::now();
+    task.worker = pt->pool == this ? pt->thread_id : -1;
+    task.stolen = pt->pool == this && pt->task_stolen;
+    profiler_.LogTask(origin, task);
+  }
+
+  void RecordParallelLoop(std::chrono::steady_clock::time_point start) {
+    parallel_loops_.fetch_add(1, std::memory_order_relaxed);
+    parallel_loop_ns_.fetch_add(ElapsedNs(start), std::memory_order_relaxed);
+  }
+
+  // State for the adaptive spin policy.  arrival_gap_ns_ is a moving
+  // average (weight 1/8) of the time between the starts of parallel
+  // sections, including the single-loop sections of RunInParallel, or
+  // 0 until two sections have started.  The updates are racy between
+  // concurrent callers, which is fine for a heuristic.
+  std::atomic<uint64_t> last_arrival_ns_{0};
+  std::atomic<uint64_t> arrival_gap_ns_{0};
+  // Count of the callers currently keeping the workers hot.
+  std::atomic<int> hot_requests_{0};
+
+  // A worker spins for at most twice the expected gap, so that it
+  // catches the next section when the arrivals are regular.  If the
+  // expected gap is beyond kMaxUsefulSpinNs then spinning is unlikely
+  // to pay off, and the worker spins only for kMinSpinNs to pick up
+  // stragglers of the current burst of work.
+  static constexpr uint64_t kMinSpinNs = 50 * 1000;
+  static constexpr uint64_t kMaxUsefulSpinNs = 10 * 1000 * 1000;
+
+  void RecordParallelSectionArrival() {
+    const uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                   std::chrono::steady_clock::now().time_since_epoch())
+                                                   .count());
+    const uint64_t prev = last_arrival_ns_.exchange(now, std::memory_order_relaxed);
+    if (prev != 0 && now > prev) {
+      const uint64_t gap = now - prev;
+      const uint64_t avg = arrival_gap_ns_.load(std::memory_order_relaxed);
+      arrival_gap_ns_.store(avg == 0 ? gap : avg - avg / 8 + gap / 8, std::memory_order_relaxed);
+    }
+  }
+
+  uint64_t SpinBudgetNs() const {
+    if (!allow_spinning_) {
+      return 0;
+    }
+    const uint64_t gap = arrival_gap_ns_.load(std::memory_order_relaxed);
+    if (gap == 0) {
+      // No history yet, spin for the full spin_count
+      return std::numeric_limits<uint64_t>::max();
+    }
+    if (2 * gap > kMaxUsefulSpinNs || 2 * gap < kMinSpinNs) {
+      return kMinSpinNs;
+    }
+    return 2 * gap;
+  }
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1446,27 +1720,47 @@ int CurrentThreadId() const EIGEN_FINAL {
     assert(td.GetStatus() == WorkerData::ThreadStatus::Spinning);
 
     const int log2_spin = 20;
-    const int spin_count = allow_spinning_ ? (1ull<<log2_spin) : 0;
-    const int steal_count = spin_count/100;
+    const int max_spin_count = 1 << log2_spin;
+    const int spin_count = allow_spinning_ ? max_spin_count : 0;
+    const int steal_count = max_spin_count/100;
+    // Iterations between checks of the spin budget and of hot_requests_
+    const int check_interval = 64;
 
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
     while (!should_exit) {
       Task t = q.PopFront();
+      bool stolen = false;
       if (!t) {
-        // Spin waiting for work.
-        for (int i = 0; i < spin_count && !t && !done_; i++) {
+        // Spin waiting for work, for up to spin_count iterations and
+        // the adaptive spin budget, or for as long as the workers are
+        // kept hot.
+        const auto spin_start = std::chrono::steady_clock::now();
+        const uint64_t spin_budget_ns = SpinBudgetNs();
+        for (int i = 0; !t && !done_; i++) {
+          if (i % check_interval == 0) {
+            if (hot_requests_.load(std::memory_order_relaxed) != 0) {
+              if (i >= max_spin_count) {
+                i = 0;  // Restart the count so that it cannot overflow while hot
+              }
+            } else if (i >= spin_count || (i > 0 && ElapsedNs(spin_start) >= spin_budget_ns)) {
+              break;
+            }
+          }
           if (((i+1)%steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
+            stolen = true;
           } else {
             t = q.PopFront();
+            stolen = false;
           }
           onnxruntime::concurrency::SpinPause();
         }
 
         // Attempt to block
         if (!t) {
+          stolen = false;
           td.SetBlocked(// Pre-block test
                         [&]() -> bool {
                           bool should_block = true;
@@ -1527,12 +1821,18 @@ int CurrentThreadId() const EIGEN_FINAL {
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
           if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) {
+            t = Steal(StealAttemptKind::TRY_ALL);
+            stolen = true;
+          }
         }
       }
       if (t) {
+        pt->task_stolen = stolen;
         td.SetActive();
+        const auto task_start = std::chrono::steady_clock::now();
         t();
+        td.busy_ns.fetch_add(ElapsedNs(task_start), std::memory_order_relaxed);
         profiler_.LogRun(thread_id);
         td.SetSpinning();
       }
@@ -1554,6 +1854,33 @@ int CurrentThreadId() const EIGEN_FINAL {
 
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
+    if (!node_workers_.empty() && pt->pool == this) {
+      // Steal from the workers of the same NUMA node first.  Only a
+      // full attempt goes on to steal from the other nodes.
+      const auto& workers = node_workers_[worker_node_[pt->thread_id]];
+      const unsigned local_size = static_cast<unsigned>(workers.size());
+      unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? local_size : 1;
+      unsigned r = Rand(&pt->rand);
+      unsigned inc = all_coprimes_[local_size - 1][r % all_coprimes_[local_size - 1].size()];
+      unsigned victim = r % local_size;
+      for (unsigned i = 0; i < num_attempts; i++) {
+        WorkerData& td = worker_data_[workers[victim]];
+        if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+          Task t = td.queue.PopBack();
+          if (t) {
+            return t;
+          }
+        }
+        victim += inc;
+        if (victim >= local_size) {
+          victim -= local_size;
+        }
+      }
+      if (steal_kind != StealAttemptKind::TRY_ALL) {
+        return Task();
+      }
+    }
+
     unsigned size = num_threads_;
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
     unsigned r = Rand(&pt->rand);
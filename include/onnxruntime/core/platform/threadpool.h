@@ -20,6 +20,7 @@ limitations under the License.
 #include <vector>
 #include <functional>
 #include <memory>
+#include <thread>
 #include "core/common/common.h"
 #include "core/platform/env.h"
 
@@ -88,6 +89,12 @@ limitations under the License.
 //   situations such as multiple loops running concurrently on the
 //   same thread pool.
 //
+//   Loops with iterations of irregular cost can instead ask for
+//   LoopScheduling::Guided, which maps onto
+//   ThreadPool::ParallelForGuidedScheduling.  There the block size is
+//   not fixed up front: blocks shrink as the remaining work shrinks
+//   (see GuidedLoopCounter::ClaimIterations).
+//
 // - When running a series of loops inside a parallel section, the
 //   LoopCounter also helps obtain affinity between these loops (i.e.,
 //   iteration X of one loop will tend to run on the same thread that
@@ -137,6 +144,46 @@ class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
 
+// Counters of the work run by a thread pool since it was created. They are always collected, unlike the
+// ThreadPoolProfiler stats, and are cheap enough to be left on in production.
+struct ThreadPoolUtilization {
+  int num_threads = 0;              // threads created in the pool
+  uint64_t parallel_loops = 0;      // parallel loops (and loops of parallel sections) run with the pool
+  uint64_t parallel_loop_ns = 0;    // wall time of those loops, measured by the threads that started them
+  uint64_t worker_busy_ns = 0;      // time the threads of the pool spent running tasks, summed over the threads.
+                                    // Includes the time spent waiting between the loops of a parallel section.
+  uint64_t scheduled_tasks = 0;     // tasks passed to Schedule, e.g. nodes run by the parallel executor
+  uint64_t task_queue_ns = 0;       // time those tasks waited in the queues of the pool before starting
+};
+
+// A task run by a thread pool, recorded while profiling with the task trace. Tasks are either the work items taken
+// from the queues of the pool, e.g. a worker summoned to help with a parallel loop, or the blocks of iterations of a
+// parallel loop claimed by the threads running it.
+struct ThreadPoolTaskRecord {
+  bool is_loop_block = false;
+  TimePoint enqueue_time;  // when the work item was queued, or when the loop of the block started
+  TimePoint start_time;
+  TimePoint end_time;
+  int worker = -1;              // index of the thread in the pool, -1 for the thread that started the loop
+  unsigned thread_id = 0;       // logging::GetThreadId() of the thread that ran the task
+  bool stolen = false;          // the work item was taken from the queue of another worker, or the block from
+                                // another shard of the loop than the home shard of the thread
+  std::ptrdiff_t first = 0;     // iterations [first, last) of a loop block
+  std::ptrdiff_t last = 0;
+};
+
+// An executor owned by the application, e.g. the scheduler of a service that already runs a thread on every core,
+// to which a ThreadPool forwards its work instead of creating threads of its own.
+struct ExternalExecutor {
+  // Runs fn asynchronously on one of the threads of the executor.
+  std::function<void(std::function<void()> fn)> schedule;
+  // Runs fn(i) for i in [0, n) and returns once all the calls have returned. The calling thread must run calls
+  // itself rather than only wait for them, so that nested loops cannot deadlock when all the threads are busy.
+  std::function<void(const std::function<void(unsigned i)>& fn, unsigned n)> parallel_for;
+  // Number of threads that may run the calls of one parallel_for, including the calling thread.
+  int degree_of_parallelism = 1;
+};
+
 class ThreadPool {
  public:
 #ifdef _WIN32
@@ -159,6 +206,13 @@ class ThreadPool {
              int degree_of_parallelism,
              bool low_latency_hint);
 
+  // Constructs a pool that creates no threads and forwards its work to
+  // "executor". The parallel loops are divided for the degree of
+  // parallelism of the executor.
+  //
+  // REQUIRES: executor.degree_of_parallelism > 0
+  explicit ThreadPool(const ExternalExecutor& executor);
+
   // Waits until all scheduled work has finished and then destroy the
   // set of threads.
   ~ThreadPool();
@@ -222,6 +276,30 @@ class ThreadPool {
                   "Per-thread state should be trivially destructible");
   };
 
+  // Keep the threads of the pool spinning for work, rather than
+  // blocking, while a KeepWorkersHot object exists.  This is a hint
+  // for the duration of a request, e.g. an InferenceSession::Run,
+  // whose loops arrive too far apart for the adaptive spinning of the
+  // pool to bridge: the threads stay hot during the request, and may
+  // block between requests.  Spinning is kept even if the pool was
+  // created without low_latency_hint, so a pool with spinning
+  // disabled spins only within such requests.
+  //
+  // KeepWorkersHot objects may overlap, including across threads.
+  // They have no effect with OpenMP, or if tp is nullptr.
+
+  class KeepWorkersHot {
+  public:
+    explicit KeepWorkersHot(ThreadPool *tp);
+    ~KeepWorkersHot();
+
+  private:
+#ifndef _OPENMP
+    ThreadPool *tp_;
+#endif
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KeepWorkersHot);
+  };
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -255,6 +333,25 @@ class ThreadPool {
   static void TryParallelFor(ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
 
+  // How TryParallelFor hands out blocks of iterations to the threads.
+  enum class LoopScheduling {
+    // Blocks of a fixed size chosen up front from cost_per_unit.  This
+    // suits loops whose iterations cost about the same.
+    FixedBlockSize,
+    // Guided self-scheduling for iterations of irregular cost, such as
+    // tree ensembles, NMS or ragged batches.  Each claim takes a share
+    // of the iterations that remain, so the blocks start large and
+    // shrink as the loop drains, down to the block size that
+    // cost_per_unit gives for amortizing the per-block overhead.  Late
+    // expensive iterations then leave little work behind them on any
+    // one thread.
+    Guided,
+  };
+
+  static void TryParallelFor(ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                             LoopScheduling scheduling,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
   // Directly schedule the 'total' tasks to the underlying threadpool, without
   // cutting them by halves
 
@@ -381,8 +478,17 @@ class ThreadPool {
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
   // StartProfiling and StopProfiling are not to be consumed as public-facing API
-  static void StartProfiling(concurrency::ThreadPool* tp);
-  static std::string StopProfiling(concurrency::ThreadPool* tp);
+  // with_hardware_counters adds the hardware events counted on each worker thread to the stats.
+  // with_task_trace records each task run for the calling thread until StopProfiling, which moves the records
+  // into tasks if it is not nullptr.
+  static void StartProfiling(concurrency::ThreadPool* tp, bool with_hardware_counters = false,
+                             bool with_task_trace = false);
+  static std::string StopProfiling(concurrency::ThreadPool* tp,
+                                   std::vector<ThreadPoolTaskRecord>* tasks = nullptr);
+
+  // Returns the utilization counters of the pool. All counters are 0 if tp is nullptr or the pool
+  // has no threads.
+  static ThreadPoolUtilization GetUtilization(const concurrency::ThreadPool* tp);
 
  private:
   friend class LoopCounter;
@@ -411,6 +517,13 @@ class ThreadPool {
   void ParallelForFixedBlockSizeScheduling(std::ptrdiff_t total, std::ptrdiff_t block_size,
                                            const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn);
 
+  // Divides the work represented by the range [0, total) into blocks
+  // claimed from a shared counter, each taking a share of the
+  // iterations that remain but at least min_block_size iterations (see
+  // LoopScheduling::Guided).  Requires min_block_size > 0.
+  void ParallelForGuidedScheduling(std::ptrdiff_t total, std::ptrdiff_t min_block_size,
+                                   const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn);
+
   // Return whether or not the calling thread should run a loop of
   // num_iterations divided in chunks of block_size in parallel.  If not,
   // the caller should run the loop sequentially.
@@ -425,13 +538,20 @@ class ThreadPool {
   void ParallelFor(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
                    const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn);
 
+  void GuidedParallelFor(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                         const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn);
+
   void SimpleParallelFor(std::ptrdiff_t total, const std::function<void(std::ptrdiff_t)>& fn);
 
   void Schedule(std::function<void()> fn);
 
-  void StartProfiling();
+  void StartProfiling(bool with_hardware_counters, bool with_task_trace);
+
+  std::string StopProfiling(std::vector<ThreadPoolTaskRecord>* tasks);
 
-  std::string StopProfiling();
+  // Records a block of iterations of a loop started by the thread origin, if the task trace is enabled.
+  void LogLoopBlock(std::thread::id origin, const TimePoint& loop_start, const TimePoint& block_start,
+                    std::ptrdiff_t first, std::ptrdiff_t last, bool stolen);
 
   ThreadOptions thread_options_;
 
@@ -443,6 +563,10 @@ class ThreadPool {
 
   // If used, underlying_threadpool_ is instantiated and owned by the ThreadPool.
   std::unique_ptr<ThreadPoolTempl<Env> > extended_eigen_threadpool_;
+
+  // If the pool forwards its work to an ExternalExecutor, underlying_threadpool_ is
+  // this adapter, owned by the ThreadPool.
+  std::unique_ptr<ExtendedThreadPoolInterface> external_threadpool_;
 };
 
 }  // namespace concurrency
@@ -24,9 +24,16 @@ enum COREMLFlags {
   // Please note, enable this option does not guarantee the entire model to be executed using ANE only
   COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE = 0x004,
 
+  // Keep the compiled CoreML models in the caches directory of the app, keyed by a hash of the converted model
+  // and the OS version, so that later sessions and app launches load them instead of compiling them again
+  COREML_FLAG_CACHE_COMPILED_MODEL = 0x008,
+
+  // Allow the GPU to accumulate in float16 instead of float32, this is faster but less precise
+  COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU = 0x010,
+
   // Keep COREML_FLAG_MAX at the end of the enum definition
   // And assign the last COREMLFlag to it
-  COREML_FLAG_LAST = COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE,
+  COREML_FLAG_LAST = COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU,
 };
 
 #ifdef __cplusplus
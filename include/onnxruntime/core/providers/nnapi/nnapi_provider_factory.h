@@ -35,9 +35,15 @@ enum NNAPIFlags {
   // For NNAPI CPU fallback, see https://developer.android.com/ndk/guides/neuralnetworks#cpu-fallback
   NNAPI_FLAG_CPU_DISABLED = 0x004,
 
+  // Ask NNAPI to prefer sustained speed over the latency of a single answer.
+  //
+  // By default the NNAPI compilations prefer a fast single answer, which suits models run once in a while. Models
+  // run repeatedly, such as on camera frames, may get a better throughput and power usage with this flag.
+  NNAPI_FLAG_PREFER_SUSTAINED_SPEED = 0x008,
+
   // Keep NNAPI_FLAG_MAX at the end of the enum definition
   // And assign the last NNAPIFlag to it
-  NNAPI_FLAG_LAST = NNAPI_FLAG_CPU_DISABLED,
+  NNAPI_FLAG_LAST = NNAPI_FLAG_PREFER_SUSTAINED_SPEED,
 };
 
 #ifdef __cplusplus
@@ -170,6 +170,8 @@ ORT_RUNTIME_CLASS(ModelMetadata);
 ORT_RUNTIME_CLASS(ThreadPoolParams);
 ORT_RUNTIME_CLASS(ThreadingOptions);
 ORT_RUNTIME_CLASS(ArenaCfg);
+ORT_RUNTIME_CLASS(SessionReplicas);
+ORT_RUNTIME_CLASS(PreparedRun);
 
 #ifdef _WIN32
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -206,6 +208,33 @@ typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
 
+// Completion callback of RunAsync, invoked from the thread that ran the model.
+// outputs is the output array passed to RunAsync and status is nullptr on success.
+// status is released by ORT after the callback returns.
+typedef void(ORT_API_CALL* RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs,
+                                               OrtStatusPtr status);
+
+// Callback of SessionGetMetrics, invoked once per metric. name is only valid during the call.
+typedef void(ORT_API_CALL* OrtSessionMetricCallback)(void* user_data, const char* name, double value);
+
+// An executor owned by the application, e.g. the scheduler of a service that already runs a thread on every core,
+// on which ORT runs its parallel work instead of on thread pools of its own. See SetGlobalExternalExecutor and
+// SessionOptionsSetExternalExecutor.
+typedef struct OrtExternalExecutor {
+  // Runs fn(fn_param) asynchronously on one of the threads of the executor.
+  void(ORT_API_CALL* Schedule)(void* executor_param, void(ORT_API_CALL* fn)(void* fn_param), void* fn_param);
+  // Runs fn(fn_param, i) for i in [0, n), possibly concurrently, and returns once all the calls have returned.
+  // ORT calls ParallelFor from within the calls of ParallelFor and Schedule, so the calling thread must run calls
+  // itself rather than only wait for the other threads, or nested loops could deadlock when all of them are busy.
+  void(ORT_API_CALL* ParallelFor)(void* executor_param, void(ORT_API_CALL* fn)(void* fn_param, size_t i),
+                                  void* fn_param, size_t n);
+  // Returns the number of threads that may run the calls of one ParallelFor, including the calling thread.
+  // ORT sizes the blocks of its parallel loops with it. Called once, when the session or env is created.
+  int(ORT_API_CALL* DegreeOfParallelism)(void* executor_param);
+  // Passed to the functions above. Must outlive the sessions, or the env, using the executor.
+  void* executor_param;
+} OrtExternalExecutor;
+
 // Set Graph optimization level.
 // Refer https://github.com/microsoft/onnxruntime/blob/master/docs/ONNX_Runtime_Graph_Optimizations.md
 // for in-depth undersrtanding of Graph Optimizations in ORT
@@ -302,6 +331,11 @@ typedef struct OrtTensorRTProviderOptions {
   const char* trt_int8_calibration_table_name;  // TensorRT INT8 calibration table name.
   int trt_int8_use_native_calibration_table;    // use native TensorRT generated calibration table. Default 0 = false, nonzero = true
   int trt_force_sequential_engine_build;        // force building TensorRT engine sequentially. Default 0 = false, nonzero = true
+  // Explicit optimization profile shapes of dynamic shape inputs, e.g. "input_ids:1x1,input_ids:8x128". An input listed
+  // more than once gets one profile per occurrence, selected at runtime by the input shapes. nullptr = profiles grow with the input shapes seen.
+  const char* trt_profile_min_shapes;  // minimum shapes of the optimization profiles.
+  const char* trt_profile_max_shapes;  // maximum shapes of the optimization profiles.
+  const char* trt_profile_opt_shapes;  // shapes the optimization profiles are tuned for. nullptr = the maximum shapes.
 } OrtTensorRTProviderOptions;
 
 /// <summary>
@@ -309,14 +343,18 @@ typedef struct OrtTensorRTProviderOptions {
 /// </summary>
 typedef struct OrtOpenVINOProviderOptions {
 #ifdef __cplusplus
-  OrtOpenVINOProviderOptions() : device_type{}, enable_vpu_fast_compile{}, device_id{}, num_of_threads{}, use_compiled_network{}, blob_dump_path{} {}
+  OrtOpenVINOProviderOptions() : device_type{}, enable_vpu_fast_compile{}, device_id{}, num_of_threads{}, use_compiled_network{}, blob_dump_path{}, num_streams{} {}
 #endif
   const char* device_type;                // CPU_FP32, GPU_FP32, GPU_FP16, MYRIAD_FP16, VAD-M_FP16 or VAD-F_FP32
   unsigned char enable_vpu_fast_compile;  // 0 = false, nonzero = true
   const char* device_id;
   size_t num_of_threads;               // 0 uses default number of threads
-  unsigned char use_compiled_network;  // 0 = false, nonzero = true
-  const char* blob_dump_path;          // path is set to empty by default
+  unsigned char use_compiled_network;  // 0 = false, nonzero = true; caches the networks compiled for each subgraph
+                                       // in blob_dump_path/ov_compiled_blobs, keyed by subgraph, device and
+                                       // OpenVINO build, and imports them in later sessions
+  const char* blob_dump_path;          // path is set to empty by default, i.e. the current working directory
+  size_t num_streams;                  // 0 uses the device default; otherwise the number of parallel OpenVINO streams
+                                       // (CPU, GPU and MYRIAD) that concurrent Runs are spread across
 } OrtOpenVINOProviderOptions;
 
 struct OrtApi;
@@ -1302,6 +1340,18 @@ struct OrtApi {
      Only relevant if arena strategy is `kNextPowerOfTwo`. Use -1 to allow ORT to choose the default.
      Ultimately, the allocation size is determined by the allocation memory request.
      Further allocation sizes are governed by the arena extend strategy.
+  * "idle_release_ms": Allocation regions that stay completely unused for this many milliseconds are returned
+     to the device while the arena keeps serving allocations. Use -1 (the default) to only release them on shrinkage.
+  * "idle_release_watermark_bytes": Idle regions are not released if that would bring the arena below this size.
+  * "decommit_chunk_bytes": CPU arenas on Linux only. The pages of free chunks of at least this size that stay unused
+     for "idle_release_ms" are returned to the OS while the chunks remain in the arena. Use 0 (the default) to disable.
+  * "thread_cache_max_bytes": Each thread allocating from the arena keeps the chunks smaller than 1 MB it frees in
+     a cache of up to this many bytes, and serves its next allocations of similar sizes from it without locking the
+     arena. Use 0 (the default) to disable.
+  * "huge_pages": CPU allocators on Linux only. Allocations of at least 2 MB, such as the arena regions, are backed by
+     huge pages to reduce TLB misses. 1 = transparent huge pages, 2 = 2 MB hugetlbfs pages, 3 = 1 GB hugetlbfs pages
+     (for allocations of at least 1 GB). hugetlbfs pages fall back to transparent huge pages, and those to regular
+     allocations, if they can't be mapped. Use 0 (the default) to disable.
   */
   ORT_API2_STATUS(CreateArenaCfgV2, _In_reads_(num_keys) const char* const* arena_config_keys,
                   _In_reads_(num_keys) const size_t* arena_config_values, _In_ size_t num_keys,
@@ -1316,6 +1366,181 @@ struct OrtApi {
      */
   ORT_API2_STATUS(AddRunConfigEntry, _Inout_ OrtRunOptions* options,
                   _In_z_ const char* config_key, _In_z_ const char* config_value);
+
+  /**
+     * Run the model without blocking, see RunAsyncCallbackFn.
+     * The run is scheduled on the inter-op thread pool of the session, or on the intra-op thread pool
+     * if there is none, so the session needs at least one of them with more than one thread.
+     * GPU execution providers are driven from the same thread pool.
+     * The names and input values are copied before RunAsync returns, the input buffers are not.
+     * run_options (if any), the output array and the input buffers must stay valid until run_async_callback
+     * is invoked. The outputs that are nullptr are allocated as in Run and must be released with ReleaseValue.
+     * run_async_callback must not release the session.
+     * An error is returned, and run_async_callback is not invoked, if the run could not be scheduled.
+     */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+  /**
+     * Create a tensor that shares the buffer of a DLPack tensor (a DLManagedTensor*, see dlpack.h), without a copy.
+     * The buffer may be on CPU or on a GPU. The OrtValue takes the ownership of dl_managed_tensor:
+     * its deleter is invoked when the OrtValue is released, and the caller must not invoke it.
+     * Only contiguous (row major) tensors are supported, an error is returned for any other.
+     * \param is_bool_tensor  DLPack uses the same type for bool and uint8, set it to 1 to create a bool tensor.
+     * ORT does not synchronize with the stream that produced the buffer, the caller has to.
+     */
+  ORT_API2_STATUS(CreateTensorFromDLPack, _In_ void* dl_managed_tensor, int is_bool_tensor, _Outptr_ OrtValue** out);
+
+  /**
+     * Share the buffer of a tensor as a DLPack tensor (a DLManagedTensor*, see dlpack.h), without a copy.
+     * The DLPack tensor holds a reference to the buffer, so it stays valid after value is released.
+     * The caller owns the returned DLManagedTensor and must invoke its deleter once done with it.
+     */
+  ORT_API2_STATUS(GetTensorDLPack, _Inout_ OrtValue* value, _Outptr_ void** dl_managed_tensor);
+
+  /**
+     * Initialize the subgraphs of control flow nodes (e.g. both branches of an If) ahead of the first Run that executes
+     * them, when the session was created with the config entry "session.lazy_subgraph_initialization" set to "1".
+     * A node may be in a subgraph, in which case the subgraphs containing it are initialized as well.
+     * \param node_names  names of the nodes whose subgraphs to initialize. All the subgraphs are initialized if
+     *                    node_names_len is 0.
+     * An error is returned if a node is not found.
+     */
+  ORT_API2_STATUS(SessionInitializeSubgraphs, _Inout_ OrtSession* sess,
+                  _In_reads_(node_names_len) const char* const* node_names, size_t node_names_len);
+
+  /**
+     * Set a caller owned buffer that the output named output_name is written into by the Run calls using these
+     * run options, so the output is not allocated by ORT. It applies to outputs whose OrtValue is not provided
+     * by the caller, including outputs whose shape is only known at runtime.
+     * If the output (a non-string tensor) does not fit in buffer_size bytes, or is not produced on the device of
+     * memory_info, ORT allocates it as usual. The caller can tell from the data pointer of the returned output
+     * and grow the buffer for the next Run.
+     * The returned output refers to the buffer, which must stay valid until the output is released.
+     * A buffer must not be set for more than one output of a Run.
+     * \param buffer  Set to nullptr to remove the buffer of output_name.
+     */
+  ORT_API2_STATUS(RunOptionsSetOutputBuffer, _Inout_ OrtRunOptions* options, _In_z_ const char* output_name,
+                  _In_opt_ void* buffer, size_t buffer_size, _In_opt_ const OrtMemoryInfo* memory_info);
+
+  /**
+     * Remove all the buffers set with RunOptionsSetOutputBuffer.
+     */
+  ORT_API2_STATUS(RunOptionsClearOutputBuffers, _Inout_ OrtRunOptions* options);
+
+  /**
+     * Create a set of replicas of the model at model_path, one per entry of options, to serve the model on
+     * several devices. Typically each entry appends the same execution provider with a different device id.
+     * The model is parsed once and the replicas are initialized in parallel, so the weights are copied to the
+     * devices concurrently. Weights prepacked by CPU kernels are shared between the replicas unless
+     * "session.use_env_prepacked_weights" is set in their options.
+     * Each RunSessionReplicas call runs on the replica with the fewest runs in flight.
+     */
+  ORT_API2_STATUS(CreateSessionReplicas, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                  _In_reads_(num_replicas) const OrtSessionOptions* const* options, size_t num_replicas,
+                  _Outptr_ OrtSessionReplicas** out);
+
+  /**
+     * Same as CreateSessionReplicas with the model read from a buffer.
+     */
+  ORT_API2_STATUS(CreateSessionReplicasFromArray, _In_ const OrtEnv* env, _In_ const void* model_data,
+                  size_t model_data_length, _In_reads_(num_replicas) const OrtSessionOptions* const* options,
+                  size_t num_replicas, _Outptr_ OrtSessionReplicas** out);
+
+  /**
+     * Run the model on the least loaded replica. The arguments are the same as Run. Thread safe.
+     */
+  ORT_API2_STATUS(RunSessionReplicas, _Inout_ OrtSessionReplicas* replicas, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output);
+
+  ORT_CLASS_RELEASE(SessionReplicas);
+
+  /**
+     * Resolve the input and output names of a Run once. RunPrepared calls with the returned OrtPreparedRun skip
+     * looking up the names, which matters for small models where it takes a noticeable part of the Run.
+     * The OrtPreparedRun must not outlive the session, nor be used by concurrent RunPrepared calls.
+     * \param input_names, output_names the names of the inputs and outputs of the RunPrepared calls, in order.
+     */
+  ORT_API2_STATUS(SessionPrepareRun, _In_ const OrtSession* sess,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Outptr_ OrtPreparedRun** out);
+
+  /**
+     * Same as Run with the input and output names of prepared_run.
+     * \param input in the order of the input names of prepared_run.
+     * \param output in the order of the output names of prepared_run, with pre-allocated or null values as in Run.
+     */
+  ORT_API2_STATUS(RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                  _Inout_ OrtPreparedRun* prepared_run,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _Inout_updates_all_(output_len) OrtValue** output, size_t output_len);
+
+  ORT_CLASS_RELEASE(PreparedRun);
+
+  /**
+     * Report the always-on metrics of the session: the Run count, failures and latency histogram, the utilization
+     * of the intra-op and inter-op thread pools (time in parallel loops, worker busy time, queueing time of the
+     * tasks scheduled by the parallel executor), the bytes in use and peak of the arenas and the bytes copied
+     * between the host and the devices. These are cheap enough to be collected in production, unlike profiling.
+     * Each metric is reported with a Prometheus sample name, including its labels, so that writing
+     * '<name> <value>' lines gives the Prometheus text exposition format. Counters are cumulative.
+     * Thread safe, and may be called while the session is running.
+     */
+  ORT_API2_STATUS(SessionGetMetrics, _In_ const OrtSession* sess, _In_ OrtSessionMetricCallback callback,
+                  _In_opt_ void* user_data);
+
+  /**
+     * Run the parallel work of the sessions using the global thread pools, i.e. their parallel loops and, in
+     * ORT_PARALLEL execution mode, their nodes, on an executor owned by the application instead of on threads
+     * created by ORT. The intra-op and inter-op thread counts are then ignored. In OpenMP builds the parallel
+     * loops still run on OpenMP.
+     * \param executor is copied, its executor_param must outlive the env.
+     */
+  ORT_API2_STATUS(SetGlobalExternalExecutor, _Inout_ OrtThreadingOptions* tp_options,
+                  _In_ const OrtExternalExecutor* executor);
+
+  /**
+     * Same as SetGlobalExternalExecutor for a session with its own thread pools.
+     * \param executor is copied, its executor_param must outlive the session.
+     */
+  ORT_API2_STATUS(SessionOptionsSetExternalExecutor, _Inout_ OrtSessionOptions* options,
+                  _In_ const OrtExternalExecutor* executor);
+
+  /**
+     * Same as CreateEnvWithCustomLoggerAndGlobalThreadPools, with the log messages passed to the logging function,
+     * or to stderr without one, from a background thread. Logging threads append their messages to ring buffers
+     * of their own without taking locks, so verbose logging can be left on without Run waiting for the output.
+     * Messages are dropped when a thread logs faster than they are written out. Messages of ORT_LOGGING_LEVEL_ERROR
+     * and above are written out before the logging call returns.
+     * \param logging_function optional, as in CreateEnvWithCustomLogger.
+     * \param tp_options optional, global thread pools are created as in CreateEnvWithGlobalThreadPools if set.
+     * \param out should be freed by `ReleaseEnv` after use
+     */
+  ORT_API2_STATUS(CreateEnvWithAsyncLogging, _In_opt_ OrtLoggingFunction logging_function, _In_opt_ void* logger_param,
+                  OrtLoggingLevel logging_level, _In_ const char* logid,
+                  _In_opt_ const struct OrtThreadingOptions* tp_options, _Outptr_ OrtEnv** out);
+
+  /**
+     * Runs fn(fn_param, i) for i in [0, n) on the intra-op thread pool of the session running the custom op kernel,
+     * possibly concurrently, and returns once all the calls have returned. Runs them on the calling thread when the
+     * session has no intra-op thread pool.
+     */
+  ORT_API2_STATUS(KernelContext_ParallelFor, _In_ const OrtKernelContext* context,
+                  _In_ void(ORT_API_CALL* fn)(void* fn_param, size_t i), _In_opt_ void* fn_param, size_t n);
+
+  /**
+     * Returns the number of threads that may run the calls of one KernelContext_ParallelFor, including the calling
+     * thread, so that the kernel can split its work into as many blocks.
+     */
+  ORT_API2_STATUS(KernelContext_GetDegreeOfParallelism, _In_ const OrtKernelContext* context, _Out_ int* out);
 };
 
 /*
@@ -1336,6 +1561,17 @@ typedef enum OrtCustomOpInputOutputCharacteristic {
   INPUT_OUTPUT_OPTIONAL,
 } OrtCustomOpInputOutputCharacteristic;
 
+// Describes an input or an output of a custom op to KernelComputeV2 of OrtCustomOp. Only valid during the call.
+typedef struct OrtCustomOpTensor {
+  // nullptr for a missing optional input or output, a string tensor, or an output ORT did not allocate. Such inputs
+  // and outputs can still be accessed through KernelContext_GetInput and KernelContext_GetOutput.
+  void* data;
+  // ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED for a missing input or output, or an output ORT did not allocate.
+  ONNXTensorElementDataType type;
+  const int64_t* dims;
+  size_t num_dims;
+} OrtCustomOpTensor;
+
 /*
  * The OrtCustomOp structure defines a custom op's schema and its kernel callbacks. The callbacks are filled in by
  * the implementor of the custom op.
@@ -1366,6 +1602,18 @@ struct OrtCustomOp {
   // Returns the characteristics of the input & output tensors
   OrtCustomOpInputOutputCharacteristic(ORT_API_CALL* GetInputCharacteristic)(_In_ const struct OrtCustomOp* op, _In_ size_t index);
   OrtCustomOpInputOutputCharacteristic(ORT_API_CALL* GetOutputCharacteristic)(_In_ const struct OrtCustomOp* op, _In_ size_t index);
+
+  // Since version 8, optional. Returns the index of the input whose shape the output at index has, or -1 if the
+  // kernel computes the shape of the output. ORT allocates the outputs with the shape of an input before calling
+  // KernelComputeV2, which then finds their data in its outputs.
+  int(ORT_API_CALL* GetOutputShapeSource)(_In_ const struct OrtCustomOp* op, _In_ size_t index);
+
+  // Since version 8, optional. Called instead of KernelCompute when set, with the inputs and outputs described by
+  // arrays ORT builds for the call, so that the kernel does not need an API call per input and output to get at
+  // their data. Returns nullptr on success, or a status created by CreateStatus that ORT releases.
+  OrtStatusPtr(ORT_API_CALL* KernelComputeV2)(_In_ void* op_kernel, _In_ OrtKernelContext* context,
+                                              _In_ const OrtCustomOpTensor* inputs, size_t num_inputs,
+                                              _Inout_ OrtCustomOpTensor* outputs, size_t num_outputs);
 };
 
 #ifdef __cplusplus
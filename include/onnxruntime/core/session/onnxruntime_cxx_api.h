@@ -99,6 +99,8 @@ ORT_DEFINE_RELEASE(ModelMetadata);
 ORT_DEFINE_RELEASE(ThreadingOptions);
 ORT_DEFINE_RELEASE(IoBinding);
 ORT_DEFINE_RELEASE(ArenaCfg);
+ORT_DEFINE_RELEASE(SessionReplicas);
+ORT_DEFINE_RELEASE(PreparedRun);
 
 /*! \class Ort::Float16_t
   * \brief it is a structure that represents float16 data.
@@ -286,6 +288,11 @@ struct RunOptions : Base<OrtRunOptions> {
 
   RunOptions& AddConfigEntry(const char* config_key, const char* config_value);
 
+  // write the output named output_name into a caller owned buffer if it fits, see OrtApi::RunOptionsSetOutputBuffer
+  RunOptions& SetOutputBuffer(const char* output_name, void* buffer, size_t buffer_size,
+                              const OrtMemoryInfo* memory_info);
+  RunOptions& ClearOutputBuffers();
+
   // terminate ALL currently executing Session::Run calls that were made using this RunOptions instance
   RunOptions& SetTerminate();
   // unset the terminate flag so this RunOptions instance can be used in a new Session::Run call
@@ -301,6 +308,7 @@ struct SessionOptions : Base<OrtSessionOptions> {
 
   SessionOptions& SetIntraOpNumThreads(int intra_op_num_threads);
   SessionOptions& SetInterOpNumThreads(int inter_op_num_threads);
+  SessionOptions& SetExternalExecutor(const OrtExternalExecutor& executor);  // see OrtApi::SessionOptionsSetExternalExecutor
   SessionOptions& SetGraphOptimizationLevel(GraphOptimizationLevel graph_optimization_level);
 
   SessionOptions& EnableCpuMemArena();
@@ -360,6 +368,22 @@ struct Session : Base<OrtSession> {
 
   void Run(const RunOptions& run_options, const struct IoBinding&);
 
+  // Run with the input and output names resolved by a PreparedRun of this session, see OrtApi::RunPrepared.
+  std::vector<Value> Run(const RunOptions& run_options, struct PreparedRun& prepared_run, const Value* input_values,
+                         size_t input_count, size_t output_count);
+  void Run(const RunOptions& run_options, struct PreparedRun& prepared_run, const Value* input_values,
+           size_t input_count, Value* output_values, size_t output_count);
+
+  // Run that returns immediately and invokes callback when the outputs are ready, see OrtApi::RunAsync.
+  // output_values (nullptr entries are allocated by the run) and run_options must outlive the callback.
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, Value* output_values, size_t output_count,
+                RunAsyncCallbackFn callback, void* user_data);
+
+  // Initialize the subgraphs of the given control flow nodes ahead of their first Run, or of all of them if
+  // node_count is 0, see OrtApi::SessionInitializeSubgraphs.
+  void InitializeSubgraphs(const char* const* node_names, size_t node_count);
+
   size_t GetInputCount() const;
   size_t GetOutputCount() const;
   size_t GetOverridableInitializerCount() const;
@@ -370,12 +394,36 @@ struct Session : Base<OrtSession> {
   char* EndProfiling(OrtAllocator* allocator) const;
   uint64_t GetProfilingStartTimeNs() const;
   ModelMetadata GetModelMetadata() const;
+  // The always-on metrics of the session as (Prometheus sample name, value) pairs, see OrtApi::SessionGetMetrics.
+  std::vector<std::pair<std::string, double>> GetMetrics() const;
 
   TypeInfo GetInputTypeInfo(size_t index) const;
   TypeInfo GetOutputTypeInfo(size_t index) const;
   TypeInfo GetOverridableInitializerTypeInfo(size_t index) const;
 };
 
+// The input and output names of Session::Run calls resolved once, see OrtApi::SessionPrepareRun.
+// Must not outlive the session, nor be used by concurrent Run calls.
+struct PreparedRun : Base<OrtPreparedRun> {
+  explicit PreparedRun(std::nullptr_t) {}
+  PreparedRun(const Session& session, const char* const* input_names, size_t input_count,
+              const char* const* output_names, size_t output_count);
+};
+
+// Replicas of a model, typically one per device, see OrtApi::CreateSessionReplicas.
+// Run calls are served by the replica with the fewest runs in flight.
+struct SessionReplicas : Base<OrtSessionReplicas> {
+  explicit SessionReplicas(std::nullptr_t) {}
+  SessionReplicas(Env& env, const ORTCHAR_T* model_path, const SessionOptions* options, size_t num_replicas);
+  SessionReplicas(Env& env, const void* model_data, size_t model_data_length, const SessionOptions* options,
+                  size_t num_replicas);
+
+  std::vector<Value> Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                         const char* const* output_names, size_t output_count);
+  void Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+           const char* const* output_names, Value* output_values, size_t output_count);
+};
+
 struct TensorTypeAndShapeInfo : Base<OrtTensorTypeAndShapeInfo> {
   explicit TensorTypeAndShapeInfo(std::nullptr_t) {}
   explicit TensorTypeAndShapeInfo(OrtTensorTypeAndShapeInfo* p) : Base<OrtTensorTypeAndShapeInfo>{p} {}
@@ -602,6 +650,9 @@ struct CustomOpApi {
   const OrtValue* KernelContext_GetInput(const OrtKernelContext* context, _In_ size_t index);
   size_t KernelContext_GetOutputCount(const OrtKernelContext* context);
   OrtValue* KernelContext_GetOutput(OrtKernelContext* context, _In_ size_t index, _In_ const int64_t* dim_values, size_t dim_count);
+  void KernelContext_ParallelFor(const OrtKernelContext* context, void(ORT_API_CALL* fn)(void* fn_param, size_t i),
+                                 void* fn_param, size_t n);
+  int KernelContext_GetDegreeOfParallelism(const OrtKernelContext* context);
 
   void ThrowOnError(OrtStatus* result);
 
@@ -629,6 +680,10 @@ struct CustomOpBase : OrtCustomOp {
 
     OrtCustomOp::GetInputCharacteristic = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetInputCharacteristic(index); };
     OrtCustomOp::GetOutputCharacteristic = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetOutputCharacteristic(index); };
+
+    OrtCustomOp::GetOutputShapeSource = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetOutputShapeSource(index); };
+    // Set by a derived op whose kernel computes from the tensor descriptors instead
+    OrtCustomOp::KernelComputeV2 = nullptr;
   }
 
   // Default implementation of GetExecutionProviderType that returns nullptr to default to the CPU provider
@@ -643,6 +698,11 @@ struct CustomOpBase : OrtCustomOp {
   OrtCustomOpInputOutputCharacteristic GetOutputCharacteristic(size_t /*index*/) const {
     return OrtCustomOpInputOutputCharacteristic::INPUT_OUTPUT_REQUIRED;
   }
+
+  // Default implementation of GetOutputShapeSource() (the kernel computes the shapes of the outputs)
+  int GetOutputShapeSource(size_t /*index*/) const {
+    return -1;
+  }
 };
 
 }  // namespace Ort
@@ -390,6 +390,17 @@ inline RunOptions& RunOptions::AddConfigEntry(const char* config_key, const char
   return *this;
 }
 
+inline RunOptions& RunOptions::SetOutputBuffer(const char* output_name, void* buffer, size_t buffer_size,
+                                               const OrtMemoryInfo* memory_info) {
+  ThrowOnError(GetApi().RunOptionsSetOutputBuffer(p_, output_name, buffer, buffer_size, memory_info));
+  return *this;
+}
+
+inline RunOptions& RunOptions::ClearOutputBuffers() {
+  ThrowOnError(GetApi().RunOptionsClearOutputBuffers(p_));
+  return *this;
+}
+
 inline RunOptions& RunOptions::SetTerminate() {
   ThrowOnError(GetApi().RunOptionsSetTerminate(p_));
   return *this;
@@ -420,6 +431,11 @@ inline SessionOptions& SessionOptions::SetInterOpNumThreads(int inter_op_num_thr
   return *this;
 }
 
+inline SessionOptions& SessionOptions::SetExternalExecutor(const OrtExternalExecutor& executor) {
+  ThrowOnError(GetApi().SessionOptionsSetExternalExecutor(p_, &executor));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::SetGraphOptimizationLevel(GraphOptimizationLevel graph_optimization_level) {
   ThrowOnError(GetApi().SetSessionGraphOptimizationLevel(p_, graph_optimization_level));
   return *this;
@@ -539,6 +555,19 @@ inline void Session::Run(const RunOptions& run_options, const IoBinding& io_bind
   ThrowOnError(GetApi().RunWithBinding(p_, run_options, io_binding));
 }
 
+inline void Session::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                              const char* const* output_names, Value* output_values, size_t output_count,
+                              RunAsyncCallbackFn callback, void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunAsync(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count,
+                                 ort_output_values, callback, user_data));
+}
+
+inline void Session::InitializeSubgraphs(const char* const* node_names, size_t node_count) {
+  ThrowOnError(GetApi().SessionInitializeSubgraphs(p_, node_names, node_count));
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(GetApi().SessionGetInputCount(p_, &out));
@@ -587,6 +616,17 @@ inline uint64_t Session::GetProfilingStartTimeNs() const {
   return out;
 }
 
+inline std::vector<std::pair<std::string, double>> Session::GetMetrics() const {
+  std::vector<std::pair<std::string, double>> metrics;
+  ThrowOnError(GetApi().SessionGetMetrics(
+      p_,
+      [](void* user_data, const char* name, double value) {
+        static_cast<std::vector<std::pair<std::string, double>>*>(user_data)->emplace_back(name, value);
+      },
+      &metrics));
+  return metrics;
+}
+
 inline ModelMetadata Session::GetModelMetadata() const {
   OrtModelMetadata* out;
   ThrowOnError(GetApi().SessionGetModelMetadata(p_, &out));
@@ -659,6 +699,60 @@ inline TypeInfo Session::GetOverridableInitializerTypeInfo(size_t index) const {
   return TypeInfo{out};
 }
 
+inline std::vector<Value> Session::Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                                      const Value* input_values, size_t input_count, size_t output_count) {
+  std::vector<Ort::Value> output_values;
+  for (size_t i = 0; i < output_count; i++)
+    output_values.emplace_back(nullptr);
+  Run(run_options, prepared_run, input_values, input_count, output_values.data(), output_count);
+  return output_values;
+}
+
+inline void Session::Run(const RunOptions& run_options, PreparedRun& prepared_run, const Value* input_values,
+                         size_t input_count, Value* output_values, size_t output_count) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunPrepared(p_, run_options, prepared_run, ort_input_values, input_count, ort_output_values,
+                                    output_count));
+}
+
+inline PreparedRun::PreparedRun(const Session& session, const char* const* input_names, size_t input_count,
+                                const char* const* output_names, size_t output_count) {
+  ThrowOnError(GetApi().SessionPrepareRun(session, input_names, input_count, output_names, output_count, &p_));
+}
+
+inline SessionReplicas::SessionReplicas(Env& env, const ORTCHAR_T* model_path, const SessionOptions* options,
+                                        size_t num_replicas) {
+  static_assert(sizeof(SessionOptions) == sizeof(OrtSessionOptions*), "SessionOptions is really just an OrtSessionOptions*, so we can reinterpret_cast safely");
+  auto ort_options = reinterpret_cast<const OrtSessionOptions* const*>(options);
+  ThrowOnError(GetApi().CreateSessionReplicas(env, model_path, ort_options, num_replicas, &p_));
+}
+
+inline SessionReplicas::SessionReplicas(Env& env, const void* model_data, size_t model_data_length,
+                                        const SessionOptions* options, size_t num_replicas) {
+  auto ort_options = reinterpret_cast<const OrtSessionOptions* const*>(options);
+  ThrowOnError(GetApi().CreateSessionReplicasFromArray(env, model_data, model_data_length, ort_options, num_replicas,
+                                                       &p_));
+}
+
+inline std::vector<Value> SessionReplicas::Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                                               const char* const* output_names, size_t output_names_count) {
+  std::vector<Ort::Value> output_values;
+  for (size_t i = 0; i < output_names_count; i++)
+    output_values.emplace_back(nullptr);
+  Run(run_options, input_names, input_values, input_count, output_names, output_values.data(), output_names_count);
+  return output_values;
+}
+
+inline void SessionReplicas::Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                                 const char* const* output_names, Value* output_values, size_t output_count) {
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunSessionReplicas(p_, run_options, input_names, ort_input_values, input_count, output_names,
+                                           output_count, ort_output_values));
+}
+
 inline ONNXTensorElementDataType TensorTypeAndShapeInfo::GetElementType() const {
   ONNXTensorElementDataType out;
   ThrowOnError(GetApi().GetTensorElementType(p_, &out));
@@ -1013,6 +1107,18 @@ inline OrtValue* CustomOpApi::KernelContext_GetOutput(OrtKernelContext* context,
   return out;
 }
 
+inline void CustomOpApi::KernelContext_ParallelFor(const OrtKernelContext* context,
+                                                   void(ORT_API_CALL* fn)(void* fn_param, size_t i),
+                                                   void* fn_param, size_t n) {
+  ThrowOnError(api_.KernelContext_ParallelFor(context, fn, fn_param, n));
+}
+
+inline int CustomOpApi::KernelContext_GetDegreeOfParallelism(const OrtKernelContext* context) {
+  int out;
+  ThrowOnError(api_.KernelContext_GetDegreeOfParallelism(context, &out));
+  return out;
+}
+
 inline SessionOptions& SessionOptions::DisablePerSessionThreads() {
   ThrowOnError(GetApi().DisablePerSessionThreads(p_));
   return *this;
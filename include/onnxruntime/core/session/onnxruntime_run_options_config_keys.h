@@ -25,3 +25,22 @@
 // Example usage: "cpu:0;gpu:0" (or) "gpu:0"
 // By default, the value for this key is empty (i.e.) no memory arenas are shrunk
 static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memory.enable_memory_arena_shrinkage";
+
+// Set to "1" to discard the state that a streaming session (see kOrtSessionOptionsConfigStreamingState) carried over
+// from the previous Runs before this Run, e.g. at the beginning of a new utterance. The default is "0".
+static const char* const kOrtRunOptionsConfigResetStreamingState = "session.reset_streaming_state";
+
+// Set to "1" to keep the threads of the intra-op thread pool spinning for work for the duration of this Run, rather
+// than letting them block between the parallel loops of the Run. The threads may block again once the Run ends, so
+// combined with "session.intra_op.allow_spinning" set to "0" the threads spin only while Runs are in flight.
+// The default is "0", where the threads follow the adaptive spin-then-block policy of the pool.
+static const char* const kOrtRunOptionsConfigKeepIntraOpWorkersHot = "session.intra_op.keep_workers_hot";
+
+// Number of rows of the batch (the first dimension of every feed) run at a time. A Run whose batch is larger is
+// executed as a sequence of Runs over slices of the feeds, so that the activations are only allocated for a
+// micro-batch, e.g. to run a batch of 4096 on a GPU sized for batches of 256. The feeds must all be tensors with the
+// same first dimension, and the outputs must have the batch as their first dimension and the same other dimensions
+// for every micro-batch. The outputs of each micro-batch are written into the slice of the full outputs, which are
+// pre-allocated by the caller or allocated after the first micro-batch. Not supported for streaming sessions and with
+// graph capture. By default, the value for this key is empty (i.e.) the batch is run at once.
+static const char* const kOrtRunOptionsConfigMicroBatchSize = "session.micro_batch_size";
@@ -24,6 +24,12 @@ static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.di
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
 
+// A value of "1" means the weights prepacked by the kernels of this session are shared with the other sessions
+// created in the same env that also set this option. Sessions packing the same initializer in the same way reference
+// a single copy of the packed buffers, which are kept alive by the env. "0" (default) means the session owns its
+// prepacked weights.
+static const char* const kOrtSessionOptionsConfigUseEnvPrepackedWeights = "session.use_env_prepacked_weights";
+
 // Set to 'ORT' (case sensitive) to load an ORT format model.
 // If unset, model type will default to ONNX unless inferred from filename ('.ort' == ORT format) or bytes to be ORT
 static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load_model_format";
@@ -32,6 +38,15 @@ static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load
 // If unset, format will default to ONNX unless optimized_model_filepath ends in '.ort'.
 static const char* const kOrtSessionOptionsConfigSaveModelFormat = "session.save_model_format";
 
+// Directory of a cache of optimized models, to skip the graph optimizations and the partitioning when a session is
+// created again for the same model. The cache is looked up with a hash of the ONNX model bytes, the ORT version, the
+// execution providers, the graph optimization level, the disabled optimizers, the free dimension overrides and the
+// other config entries. On a hit the optimized model is loaded from the ORT format model in the cache, on a miss it
+// is saved there once the session is initialized. The directory is created if it doesn't exist.
+// The cache is not used for models with external data, with custom op schemas, or with nodes compiled by an
+// execution provider, nor when optimized_model_filepath is set. By default, the value is empty (no cache).
+static const char* const kOrtSessionOptionsConfigOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // If a value is "1", flush-to-zero and denormal-as-zero are applied. The default is "0".
 // When multiple sessions are created, a main thread doesn't override changes from succeeding session options,
 // but threads in session thread pools follow option changes.
@@ -51,6 +66,48 @@ static const char* const kOrtSessionOptionsDisableQuantQDQ = "session.disable_qu
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable the NHWC layout for float convolution networks on CPU. "0": disable; "1": enable. The default is "0".
+// If enabled, the level 3 optimizations replace float Conv nodes by NhwcConv nodes and keep the tensors between them in
+// the NHWC layout (instead of the NCHWc layout), transposing tensors only where NCHW operators consume them.
+static const char* const kOrtSessionOptionsEnableFloatNhwc = "optimization.enable_float_nhwc";
+
+// Enable or disable the autotuning of the NCHWc layout for float convolutions on CPU. "0": disable; "1": enable.
+// The default is "0". If enabled, the level 3 optimizations benchmark each Conv taking an NCHW input on a single thread
+// and only convert it to the NCHWc layout if the NCHWc Conv, including the reorders of its input and output, is faster
+// than the NCHW Conv for its shapes. The results are shared by the sessions of the process. This needs the input and
+// output shapes of the Conv to be static, otherwise it is converted as without autotuning.
+static const char* const kOrtSessionOptionsNchwcAutotune = "optimization.nchwc_autotune";
+
+// The path of a file keeping the results of the NCHWc autotuning across processes. The default is "" (none).
+// The results are looked up in the file before benchmarking a Conv, and new results are appended to it. They are only
+// used on a CPU with the same signature.
+static const char* const kOrtSessionOptionsNchwcTuningFile = "optimization.nchwc_tuning_file";
+
+// Enable or disable the fusion of chains of float elementwise nodes on CPU. "0": disable; "1": enable. The default is "0".
+// If enabled, the level 3 optimizations replace connected Add, Sub, Mul, Div and unary math nodes left on CPU by one
+// FusedElementwise node, which evaluates the whole chain over blocks of the output that stay in the L1 cache instead
+// of making a pass over memory for every node.
+static const char* const kOrtSessionOptionsEnableCpuElementwiseFusion = "optimization.enable_cpu_elementwise_fusion";
+
+// Limit the growth of the model from constant folding. A node is not constant folded if its outputs are larger than
+// this many times the size of its inputs and larger than 1 MB, e.g. an Expand or Tile of a small constant is computed
+// at run time instead of being stored as a large initializer. The value is a float. "0", the default, means no limit.
+static const char* const kOrtSessionOptionsConfigConstantFoldingMaxOutputToInputRatio =
+    "optimization.constant_folding_max_output_to_input_ratio";
+
+// Directory that constant folding writes folded initializers larger than
+// kOrtSessionOptionsConfigConstantFoldingSpillThresholdBytes to. The files are memory mapped and the session uses
+// the mapped data in place, so the folded values are paged in from disk rather than held in memory. The files are
+// not deleted by ORT. The default is "", which keeps all folded initializers in memory.
+// The option is ignored if SessionOptions.optimized_model_filepath is set.
+static const char* const kOrtSessionOptionsConfigConstantFoldingSpillDirectory =
+    "optimization.constant_folding_spill_directory";
+
+// Minimum size in bytes of a folded initializer written to kOrtSessionOptionsConfigConstantFoldingSpillDirectory.
+// The default is "1048576".
+static const char* const kOrtSessionOptionsConfigConstantFoldingSpillThresholdBytes =
+    "optimization.constant_folding_spill_threshold_bytes";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
@@ -60,3 +117,219 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 // "1": default, thread will spin a number of times before blocking
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
+
+// Set to "1" to make the intra_op thread pool NUMA aware on machines with more than one NUMA node.
+// The threads are spread across the nodes and bound to their cores, idle threads steal work from their own node
+// first, and parallel loops give each node a contiguous range of iterations so that the data touched by a range
+// stays on the node that computes it. If the intra_op thread count is 0, one thread is created per physical core
+// of all nodes. The default is "0". The setting has no effect on machines with a single NUMA node.
+static const char* const kOrtSessionOptionsConfigIntraOpNumaAware = "session.intra_op.numa_aware";
+
+// Set to "1" to bind the intra_op threads to the performance cores of a hybrid CPU (P-cores on Intel, big cores on
+// ARM big.LITTLE), for latency-critical sessions whose parallel loops would otherwise wait on the slower cores.
+// If the intra_op thread count is 0, one thread is created per physical performance core. The default is "0".
+// The setting has no effect on CPUs whose cores are all of one type, or if an explicit thread affinity is given.
+static const char* const kOrtSessionOptionsConfigIntraOpPerformanceCoresOnly = "session.intra_op.performance_cores_only";
+
+// Set to "1" to run the nodes of a session in ORT_PARALLEL execution mode on the intra-op thread pool, instead of on
+// a separate inter-op thread pool. The nodes of concurrent branches and the parallel loops inside their kernels then
+// share one work-stealing pool: a kernel running on a pool thread parallelizes over the threads that are not busy
+// with other nodes, rather than the two pools oversubscribing the cores. No inter-op thread pool is created, and the
+// inter-op thread settings are ignored. The default is "0". The setting has no effect in ORT_SEQUENTIAL mode.
+static const char* const kOrtSessionOptionsConfigUseUnifiedThreadPool = "session.use_unified_thread_pool";
+
+// Set to "1" to memory map an ORT format model loaded from a file instead of reading it into a heap buffer.
+// Initializers that are placed in CPU memory will use the mapped model data directly, so multiple processes loading
+// the same model share a single copy of the weights in the page cache.
+// The model file must not be modified while the session is alive. The default is "0".
+// If memory mapping is not supported on the platform, the model is read into a heap buffer as usual.
+static const char* const kOrtSessionOptionsConfigMapOrtModelIntoMemory = "session.map_ort_model_into_memory";
+
+// Set to "1" to compress the initializers of at least 64KB when saving an ORT format model, if that makes them at
+// least an eighth smaller. The compression is LZ4, after grouping the bytes of the elements by significance.
+// Loading decompresses them, which costs less than reading the bytes saved from a slow disk or network. If the model
+// is memory mapped (session.map_ort_model_into_memory), they are decompressed directly into the buffers of the
+// initializers when the session is initialized, in parallel across initializers. The default is "0".
+static const char* const kOrtSessionOptionsConfigCompressOrtFormatInitializers =
+    "session.ort_format_compress_initializers";
+
+// Set to "1" to memory map an ONNX model loaded from a file instead of parsing all of it into the ModelProto.
+// Only the rest of the model is parsed: the large initializers refer to their raw data in the mapped file, so they
+// are neither copied by protobuf nor when the Graph is created, and CPU initializers use the mapped data directly.
+// The model file must not be modified while the session is alive. The default is "0".
+// The setting has no effect if the optimized model is saved (session_options.optimized_model_filepath), or if memory
+// mapping is not supported on the platform.
+static const char* const kOrtSessionOptionsConfigMapOnnxModelIntoMemory = "session.map_onnx_model_into_memory";
+
+// Maximum total size in bytes of the memory patterns cached by a session, measured as the sum of the peak sizes of the
+// cached patterns. When the limit would be exceeded the least recently used memory patterns are evicted.
+// The default is "0", which means the cache size is not limited.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheMaxBytes = "session.memory_pattern_cache_max_bytes";
+
+// Set to "1" to round input dimensions up to the next power of two when looking up cached memory patterns, so one
+// memory pattern serves all input shapes in the same bucket (e.g. sequence lengths 257 to 512).
+// A cached memory pattern is used for smaller shapes in its bucket, and is regenerated if a larger shape doesn't fit.
+// By default ("0") a memory pattern is only used for the exact input shapes it was generated for.
+static const char* const kOrtSessionOptionsConfigMemoryPatternShapeBucketing = "session.memory_pattern_shape_bucketing";
+
+// Set to "1" to assign the offsets of a memory pattern once the whole iteration has been traced, instead of only
+// while tracing it. Every tensor is treated as an interval from its allocation to its release with a size, and the
+// tensors are placed largest first at the best fitting gap among the tensors that are alive at the same time. The
+// result is used if its peak size is lower. Only used by the memory patterns traced at run time. The default is "0".
+static const char* const kOrtSessionOptionsConfigMemoryPatternLifetimePacking = "session.memory_pattern_lifetime_packing";
+
+// Set to "1" to derive the memory patterns from the inferred shapes of the graph when the session is created, instead
+// of tracing a Run for each new input shape. The size of each tensor is recorded as a formula of the symbolic input
+// dims (e.g. batch * seq * 768 * 4 bytes), and for a Run the formulas are evaluated for the input dims to lay out the
+// tensors in a single buffer, so every Run gets a memory pattern without it being cached. Tensors whose size can't be
+// expressed from the input dims are allocated when they're produced. Not supported in a training build.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigMemoryPatternSymbolicPlanning = "session.memory_pattern_symbolic_planning";
+
+// Maximum size in bytes of the CPU tensors that are allocated from blocks owned by the execution of a Run, e.g. the
+// small int64 tensors produced by Shape, Gather and Concat nodes computing shapes. These tensors are placed one after
+// the other in the blocks without going through the allocator, and are all released together at the end of the Run.
+// Graph outputs and tensors placed by a memory pattern are allocated as usual. The default is "0" (disabled).
+static const char* const kOrtSessionOptionsConfigSmallTensorMaxBytes = "session.small_tensor_max_bytes";
+
+// Back the allocations of at least 2 MB made by the default CPU execution provider, e.g. the regions of its arena and
+// the initializers, with huge pages to reduce TLB misses on large weights and activations. Linux only.
+// "1" = transparent huge pages (madvise(MADV_HUGEPAGE) on 2 MB aligned mappings), "2" = 2 MB hugetlbfs pages,
+// "3" = 1 GB hugetlbfs pages for the allocations of at least 1 GB. hugetlbfs pages fall back to transparent huge pages
+// when the pool doesn't have enough free pages, and transparent huge pages to regular allocations if the memory can't
+// be mapped. Only applies if the CPU execution provider is not registered explicitly. The default is "0" (disabled).
+static const char* const kOrtSessionOptionsConfigCpuHugePages = "session.cpu_huge_pages";
+
+// Set to "1" to sample hardware performance counters while profiling. Each kernel event of the trace gets a
+// "hardware_counters" arg with the cycles, instructions, last level cache misses and an estimate of the bytes read
+// from DRAM on the thread running the kernel, and the thread scheduling stats report the same counters for each
+// intra_op worker thread. Only supported on Linux, where perf_event_paranoid must allow user space counters.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigProfileHardwareCounters = "session.profile_hardware_counters";
+
+// Set to "1" to record the memory used by each node while profiling. After each node the trace gets a
+// "<node>_memory" event with the bytes of the tensors it allocated, split into the bytes placed by a memory pattern
+// (planned) and the bytes allocated at run time (dynamic), the bytes freed after it and the bytes live, per device.
+// At the end of each Run a "memory_peak" event reports the peak live bytes of each device, with the tensors live at
+// that point and the nodes producing them. Feeds and initializers are not included. Only the sequential executor
+// attributes the memory to the nodes. The default is "0".
+static const char* const kOrtSessionOptionsConfigProfileMemory = "session.profile_memory";
+
+// Set to "1" to record the phases of the session creation while profiling: "model_parse" ("model_read" and
+// "model_parse" for an ORT format model), "graph_resolve", one
+// "graph_transformer_<name>" event per application of a graph transformer, "graph_partitioning",
+// "graph_final_resolve", "kernel_lookup", "execution_planning", "initializer_copy", "kernel_creation" and
+// "prepacking". Each event has the peak resident set size of the process at its end in its "peak_rss" argument.
+// Profiling must be started before the model is loaded for the load phases to be recorded. The default is "0".
+static const char* const kOrtSessionOptionsConfigProfileSessionCreation = "session.profile_session_creation";
+
+// Set to "1" to trace the tasks of the intra_op thread pool while profiling. Each block of iterations of a parallel
+// loop and each work item of the pool gets a "<node>_loop_block" or "<node>_work_item" event on the thread that ran
+// it, with the "worker" index of the thread, whether the task was "stolen" from another worker and its
+// "queue_time_us" before starting, and a flow arrow from the node. With the parallel executor each node also gets a
+// flow arrow from the node that made it ready and its "ready_time_us" before starting. The trace can be large, as
+// every task of every node is recorded. The default is "0".
+static const char* const kOrtSessionOptionsConfigProfileThreadPoolTasks = "session.profile_thread_pool_tasks";
+
+// Enables the streaming mode, where the session carries state (e.g. the loop-carried state of a Scan or Loop over
+// time steps) from one Run to the next so that a long sequence can be fed in chunks.
+// Expects a list of semi-colon separated pairs of a graph input and the graph output holding its next value,
+// separated by colon in the following format: "state_in_0:state_out_0;state_in_1:state_out_1"
+// Every Run fetches the state outputs (even if they are not requested) and keeps them on the device they are
+// produced on, and the next Run feeds them to the state inputs that are not fed explicitly. Before the first Run,
+// or after a reset with the run option kOrtRunOptionsConfigResetStreamingState, a state input that is not fed is
+// filled with zeros if the model declares a fixed shape for it. The Runs of a streaming session are serialized.
+// By default, the value for this key is empty (i.e.) no state is carried between Runs.
+static const char* const kOrtSessionOptionsConfigStreamingState = "session.streaming_state";
+
+// Set to "1" to defer creating the kernels and prepacking the weights of the subgraphs of control flow nodes
+// (e.g. the 'then_branch' and 'else_branch' of an If) until the first Run that executes the node. This reduces the
+// initialization time and memory of models with many subgraphs, of which a Run typically executes only a few.
+// The first Run executing a node pays for initializing its subgraphs, which can be done ahead of time for specific
+// nodes with OrtApi::SessionInitializeSubgraphs. Ignored when saving an ORT format model. The default is "0".
+static const char* const kOrtSessionOptionsConfigLazySubgraphInitialization = "session.lazy_subgraph_initialization";
+
+// Set to "1" to let the CPU MatMul and Gemm kernels with a constant float B input round both inputs to bfloat16
+// and accumulate in single precision, using AMX or AVX512_BF16 instructions on processors that support them.
+// B is converted once when the weights are prepacked. This trades accuracy for throughput and is ignored on
+// processors without bfloat16 support. The default is "0".
+static const char* const kOrtSessionOptionsConfigGemmFastMathBf16 = "mlas.enable_gemm_fastmath_bf16";
+
+// Maximum fraction of the values of a constant float B input of the CPU MatMul kernel that may be kept when B is
+// packed into a block sparse format (blocks of 4x4, 16x1 or 1x4 values, keeping only the blocks with a non-zero
+// value). If the non-zero blocks of B take no more than this fraction, e.g. for weights pruned to blocks of zeros,
+// B is packed once when the weights are prepacked and the multiplication skips the zero blocks. Set to "0" to
+// disable. The default is "0.2".
+static const char* const kOrtSessionOptionsConfigGemmSparseMaxDensity = "mlas.gemm_sparse_max_density";
+
+// Magnitude at or below which a value of B is treated as zero when looking for the zero blocks of B for
+// kOrtSessionOptionsConfigGemmSparseMaxDensity. Values of the kept blocks are not changed. A value above "0"
+// changes the results of the multiplication and is meant for weights pruned to near zero values. The default is "0".
+static const char* const kOrtSessionOptionsConfigGemmSparseZeroThreshold = "mlas.gemm_sparse_zero_threshold";
+
+// Path of a file that caches the MLAS SGEMM blocking and threading parameters tuned per CPU model. When the file has
+// no entry for this CPU and intra-op thread count, the first session created with this option benchmarks a few
+// candidate parameters (which takes about a second) and appends the best ones to the file; later sessions and
+// processes reuse them. The parameters are global to the process and set once. The default is "" (no tuning).
+static const char* const kOrtSessionOptionsConfigMlasTuningFile = "mlas.sgemm_tuning_file";
+
+// Set to "1" to let the CPU Gelu, FastGelu and BiasGelu kernels and the Sigmoid and Tanh activations of the LSTM
+// and GRU kernels use faster rational approximations of the hyperbolic tangent, logistic and error functions.
+// The absolute error is below 7.5e-5 for tanh, 4e-5 for the logistic function and 5e-4 for erf, instead of a few
+// units in the last place. The default is "0".
+static const char* const kOrtSessionOptionsConfigActivationFastMath = "mlas.enable_activation_fastmath";
+
+// Number of GPUs the MatMul weights of the MLP and self-attention blocks of transformer models (GPT-2 and BART
+// patterns) are partitioned across, Megatron style, so that models too large for one GPU can be served.
+// The model is run by one process per GPU, launched with MPI, and each process registers the CUDA execution provider
+// with the device of its local rank. The partial results are combined with NCCL all-reduce nodes. Only supported in
+// training builds with NCCL. The default is "1" (no partitioning).
+static const char* const kOrtSessionOptionsConfigTensorParallelSize = "session.tensor_parallel_size";
+
+// Set to "1" to let the DirectML execution provider record the command list of every fused graph partition once and
+// resubmit it on each Run, with only the bindings of the inputs, outputs and temporary resources updated, instead of
+// recording the operators again. A few recorded command lists are kept per partition, so that a Run does not wait
+// for the previous execution to complete on the GPU. This removes most of the CPU cost of a Run, which dominates the
+// latency of small models. Read by OrtSessionOptionsAppendExecutionProvider_DML and
+// OrtSessionOptionsAppendExecutionProviderEx_DML, so it must be set before them. The default is "0".
+static const char* const kOrtSessionOptionsConfigDmlPersistentCommandLists = "ep.dml.enable_persistent_command_lists";
+
+// Directory in which the NNAPI execution provider lets the NNAPI drivers cache the compiled models, so that the
+// compilation of the partitions is skipped on later launches of the application. The directory must exist and be
+// private to the application. The cache of a partition is keyed by a token computed from the nodes and initializers
+// of the partition and the NNAPI flags. Only available from Android API level 29. Read by
+// OrtSessionOptionsAppendExecutionProvider_Nnapi, so it must be set before it. The default is "" (no caching).
+static const char* const kOrtSessionOptionsConfigNnapiCacheDir = "ep.nnapi.cache_dir";
+
+// Set to "1" to move small islands of nodes that were assigned to a device execution provider (e.g. CUDA) back to
+// the CPU execution provider when the copies of the values they exchange with CPU nodes, graph inputs and graph
+// outputs are estimated to cost more than the device saves on the computation. The estimates use the static shapes
+// of the values, so islands with unknown shapes are left on the device. Nodes fused by compiling execution providers
+// are never moved. The default is "0".
+static const char* const kOrtSessionOptionsConfigCostBasedPartitioning = "session.cost_based_partitioning";
+
+// Set to "float16" or "bfloat16" to store the large float activations of the CPU execution provider in 16 bits
+// when they stay alive while other nodes run, e.g. the skip connections of residual networks and the layer outputs
+// kept for attention. Each such activation is cast to 16 bits after it's produced and cast back to float right
+// before each consumer, halving the memory it takes in the arena while the kernels still compute in single
+// precision. The rounding changes the results. bfloat16 requires a model importing opset 13 or later.
+// The default is "" (activations are stored as float).
+static const char* const kOrtSessionOptionsConfigCpuActivationStorageType = "session.cpu_activation_storage_type";
+
+// Minimum size in bytes of the activations stored in 16 bits with kOrtSessionOptionsConfigCpuActivationStorageType.
+// Only activations with a static shape are considered. The default is "1048576".
+static const char* const kOrtSessionOptionsConfigCpuActivationStorageMinBytes =
+    "session.cpu_activation_storage_min_bytes";
+
+// Byte budget of a cache of the outputs of the Runs by the content of their feeds, for models that are run on the
+// same inputs repeatedly, e.g. a recommendation model scoring the same user and items within a short time.
+// A Run whose feed names, shapes, types and bytes and output names are identical to a cached one returns copies of
+// the cached outputs without executing the model. Only Runs whose feeds and outputs are all non-string tensors in CPU
+// memory and whose outputs are not pre-allocated are cached. The feeds are kept with the outputs and compared byte for
+// byte. The least recently used Runs are evicted to stay within the budget. The cache is not enabled for a streaming
+// session or a model with random number generator operators. The default is "0" (no caching).
+static const char* const kOrtSessionOptionsConfigResultCacheMaxBytes = "session.result_cache_max_bytes";
+
+// Time in milliseconds after which a Run cached with kOrtSessionOptionsConfigResultCacheMaxBytes is executed again
+// instead of being served from the cache. The default is "0" (cached Runs don't expire).
+static const char* const kOrtSessionOptionsConfigResultCacheTtlMs = "session.result_cache_ttl_ms";
@@ -140,6 +140,24 @@ public class OnnxTensor implements OnnxValue {
     }
   }
 
+  /**
+   * Returns a direct ByteBuffer in the native byte order which views the memory of the OnnxTensor
+   * without copying it.
+   *
+   * <p>The view is only valid until the OnnxTensor is closed, and writes to it modify the tensor.
+   * This method returns null if the OnnxTensor contains Strings as they are stored externally to
+   * the OnnxTensor.
+   *
+   * @return A ByteBuffer view of the OnnxTensor.
+   */
+  public ByteBuffer getByteBufferView() {
+    if (info.type != OnnxJavaType.STRING) {
+      return getBuffer();
+    } else {
+      return null;
+    }
+  }
+
   /**
    * Returns a copy of the underlying OnnxTensor as a FloatBuffer if it can be losslessly converted
    * into a float (i.e. it's a float or fp16), otherwise it returns null.
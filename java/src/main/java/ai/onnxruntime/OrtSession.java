@@ -306,6 +306,95 @@ public class OrtSession implements AutoCloseable {
     }
   }
 
+  /**
+   * Scores an input feed dict, writing the requested outputs into the supplied tensors.
+   *
+   * <p>The output tensors must have the shape and type the model produces, and are usually created
+   * once from direct ByteBuffers with {@link OnnxTensor#createTensor(OrtEnvironment,
+   * java.nio.ByteBuffer, long[], OnnxJavaType)} and reused for every call. Together with direct
+   * buffer inputs this avoids copying the inputs and outputs and creating new Java objects per run.
+   * The outputs remain owned by the caller.
+   *
+   * @param inputs The inputs to score.
+   * @param pinnedOutputs The requested outputs and the tensors to write them into.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public void runWithPinnedOutputs(
+      Map<String, OnnxTensor> inputs, Map<String, OnnxTensor> pinnedOutputs) throws OrtException {
+    runWithPinnedOutputs(inputs, pinnedOutputs, null);
+  }
+
+  /**
+   * Scores an input feed dict, writing the requested outputs into the supplied tensors.
+   *
+   * <p>See {@link #runWithPinnedOutputs(Map, Map)}.
+   *
+   * @param inputs The inputs to score.
+   * @param pinnedOutputs The requested outputs and the tensors to write them into.
+   * @param runOptions The RunOptions to control this run.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public void runWithPinnedOutputs(
+      Map<String, OnnxTensor> inputs, Map<String, OnnxTensor> pinnedOutputs, RunOptions runOptions)
+      throws OrtException {
+    if (!closed) {
+      if (inputs.isEmpty() || (inputs.size() > numInputs)) {
+        throw new OrtException(
+            "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
+      }
+      if (pinnedOutputs.isEmpty() || (pinnedOutputs.size() > numOutputs)) {
+        throw new OrtException(
+            "Unexpected number of pinnedOutputs, expected [1,"
+                + numOutputs
+                + ") found "
+                + pinnedOutputs.size());
+      }
+      String[] inputNamesArray = new String[inputs.size()];
+      long[] inputHandles = new long[inputs.size()];
+      int i = 0;
+      for (Map.Entry<String, OnnxTensor> t : inputs.entrySet()) {
+        if (inputNames.contains(t.getKey())) {
+          inputNamesArray[i] = t.getKey();
+          inputHandles[i] = t.getValue().getNativeHandle();
+          i++;
+        } else {
+          throw new OrtException(
+              "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
+        }
+      }
+      String[] outputNamesArray = new String[pinnedOutputs.size()];
+      long[] outputHandles = new long[pinnedOutputs.size()];
+      i = 0;
+      for (Map.Entry<String, OnnxTensor> t : pinnedOutputs.entrySet()) {
+        if (outputNames.contains(t.getKey())) {
+          outputNamesArray[i] = t.getKey();
+          outputHandles[i] = t.getValue().getNativeHandle();
+          i++;
+        } else {
+          throw new OrtException(
+              "Unknown output name " + t.getKey() + ", expected one of " + outputNames.toString());
+        }
+      }
+      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
+
+      runWithPinnedOutputs(
+          OnnxRuntime.ortApiHandle,
+          nativeHandle,
+          allocator.handle,
+          inputNamesArray,
+          inputHandles,
+          inputNamesArray.length,
+          outputNamesArray,
+          outputHandles,
+          outputNamesArray.length,
+          runOptionsHandle);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
   /**
    * Gets the metadata for the currently loaded model.
    *
@@ -428,6 +517,35 @@ public class OrtSession implements AutoCloseable {
       long runOptionsHandle)
       throws OrtException;
 
+  /**
+   * The native run call writing into preallocated outputs. runOptionsHandle can be zero (i.e. the
+   * null pointer), but all other handles must be valid pointers.
+   *
+   * @param apiHandle The pointer to the api.
+   * @param nativeHandle The pointer to the session.
+   * @param allocatorHandle The pointer to the allocator.
+   * @param inputNamesArray The input names.
+   * @param inputs The input tensors.
+   * @param numInputs The number of inputs.
+   * @param outputNamesArray The requested output names.
+   * @param outputs The output tensors.
+   * @param numOutputs The number of requested outputs.
+   * @param runOptionsHandle The (possibly null) pointer to the run options.
+   * @throws OrtException If the native call failed in some way.
+   */
+  private native void runWithPinnedOutputs(
+      long apiHandle,
+      long nativeHandle,
+      long allocatorHandle,
+      String[] inputNamesArray,
+      long[] inputs,
+      long numInputs,
+      String[] outputNamesArray,
+      long[] outputs,
+      long numOutputs,
+      long runOptionsHandle)
+      throws OrtException;
+
   private native long getProfilingStartTimeInNs(long apiHandle, long nativeHandle)
       throws OrtException;
 
@@ -8,7 +8,9 @@ package ai.onnxruntime.providers;
 public enum CoreMLFlags implements OrtFlags {
   CPU_ONLY(1), // COREML_FLAG_USE_CPU_ONLY(0x001)
   ENABLE_ON_SUBGRAPH(2), // COREML_FLAG_ENABLE_ON_SUBGRAPH(0x002)
-  ONLY_ENABLE_DEVICE_WITH_ANE(4); // COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE(0x004),
+  ONLY_ENABLE_DEVICE_WITH_ANE(4), // COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE(0x004),
+  CACHE_COMPILED_MODEL(8), // COREML_FLAG_CACHE_COMPILED_MODEL(0x008)
+  ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU(16); // COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU(0x010)
 
   public final int value;
 
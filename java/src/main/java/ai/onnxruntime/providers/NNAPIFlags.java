@@ -8,7 +8,8 @@ package ai.onnxruntime.providers;
 public enum NNAPIFlags implements OrtFlags {
   USE_FP16(1), // NNAPI_FLAG_USE_FP16(0x001)
   USE_NCHW(2), // NNAPI_FLAG_USE_NCHW(0x002)
-  CPU_DISABLED(4); // NNAPI_FLAG_CPU_DISABLED(0x004)
+  CPU_DISABLED(4), // NNAPI_FLAG_CPU_DISABLED(0x004)
+  PREFER_SUSTAINED_SPEED(8); // NNAPI_FLAG_PREFER_SUSTAINED_SPEED(0x008)
 
   public final int value;
 
@@ -314,6 +314,66 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
     return outputArray;
 }
 
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    runWithPinnedOutputs
+ * Signature: (JJJ[Ljava/lang/String;[JJ[Ljava/lang/String;[JJJ)V
+ * private native void runWithPinnedOutputs(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long[] outputs, long numOutputs, long runOptionsHandle)
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_runWithPinnedOutputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong allocatorHandle, jobjectArray inputNamesArr, jlongArray tensorArr, jlong numInputs, jobjectArray outputNamesArr, jlongArray outputTensorArr, jlong numOutputs, jlong runOptionsHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+    OrtSession* session = (OrtSession*) sessionHandle;
+    OrtRunOptions* runOptions = (OrtRunOptions*) runOptionsHandle;
+
+    // Create the buffers for the Java input and output strings
+    const char** inputNames;
+    checkOrtStatus(jniEnv, api, api->AllocatorAlloc(allocator,sizeof(char*)*numInputs,(void**)&inputNames));
+    const char** outputNames;
+    checkOrtStatus(jniEnv, api, api->AllocatorAlloc(allocator,sizeof(char*)*numOutputs,(void**)&outputNames));
+    jobject* javaInputStrings;
+    checkOrtStatus(jniEnv, api, api->AllocatorAlloc(allocator,sizeof(jobject)*numInputs,(void**)&javaInputStrings));
+    jobject* javaOutputStrings;
+    checkOrtStatus(jniEnv, api, api->AllocatorAlloc(allocator,sizeof(jobject)*numOutputs,(void**)&javaOutputStrings));
+
+    // Extract the names of the input and output values.
+    for (int i = 0; i < numInputs; i++) {
+        javaInputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,inputNamesArr,i);
+        inputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaInputStrings[i],NULL);
+    }
+    for (int i = 0; i < numOutputs; i++) {
+        javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,outputNamesArr,i);
+        outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaOutputStrings[i],NULL);
+    }
+
+    // Extract C arrays of longs which are pointers to the input and output tensors.
+    // The non-null outputs are used as the preallocated fetches, so nothing is copied or created.
+    jlong* inputTensors = (*jniEnv)->GetLongArrayElements(jniEnv,tensorArr,NULL);
+    jlong* outputTensors = (*jniEnv)->GetLongArrayElements(jniEnv,outputTensorArr,NULL);
+
+    checkOrtStatus(jniEnv,api,api->Run(session, runOptions, (const char* const*) inputNames, (const OrtValue* const*) inputTensors, numInputs, (const char* const*) outputNames, numOutputs, (OrtValue**) outputTensors));
+
+    // Release the C arrays of pointers to the tensors.
+    (*jniEnv)->ReleaseLongArrayElements(jniEnv,tensorArr,inputTensors,JNI_ABORT);
+    (*jniEnv)->ReleaseLongArrayElements(jniEnv,outputTensorArr,outputTensors,JNI_ABORT);
+
+    // Release the Java input and output strings
+    for (int i = 0; i < numInputs; i++) {
+        (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaInputStrings[i],inputNames[i]);
+    }
+    for (int i = 0; i < numOutputs; i++) {
+        (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaOutputStrings[i],outputNames[i]);
+    }
+
+    // Release the buffers
+    checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, (void*)inputNames));
+    checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, (void*)outputNames));
+    checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, javaInputStrings));
+    checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, javaOutputStrings));
+}
+
 
 /*
  * Class:     ai_onnxruntime_OrtSession
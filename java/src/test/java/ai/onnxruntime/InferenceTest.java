@@ -33,6 +33,7 @@ import java.nio.file.Path;
 import java.nio.file.Paths;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.Collections;
 import java.util.EnumSet;
 import java.util.HashMap;
 import java.util.HashSet;
@@ -971,6 +972,46 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void testPinnedOutputs() throws OrtException {
+    // model takes 1x5 input of fixed type, echoes back
+    String modelPath = getResourcePath("/test_types_FLOAT.pb").toString();
+
+    try (OrtEnvironment env = OrtEnvironment.getEnvironment("testPinnedOutputs");
+        SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options)) {
+      String inputName = session.getInputNames().iterator().next();
+      String outputName = session.getOutputNames().iterator().next();
+      long[] shape = new long[] {1, 5};
+      ByteBuffer inputBuffer = ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder());
+      ByteBuffer outputBuffer = ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder());
+
+      // the tensors are created once and reused by every run
+      try (OnnxTensor input =
+              OnnxTensor.createTensor(env, inputBuffer, shape, OnnxJavaType.FLOAT);
+          OnnxTensor output =
+              OnnxTensor.createTensor(env, outputBuffer, shape, OnnxJavaType.FLOAT)) {
+        Map<String, OnnxTensor> inputs = Collections.singletonMap(inputName, input);
+        Map<String, OnnxTensor> outputs = Collections.singletonMap(outputName, output);
+        FloatBuffer inputView = input.getByteBufferView().asFloatBuffer();
+        for (int i = 0; i < 3; i++) {
+          float[] inputArr = new float[] {i, -2.0f * i, 3.0f, -4.0f, 5.0f + i};
+          inputView.clear();
+          inputView.put(inputArr);
+          session.runWithPinnedOutputs(inputs, outputs);
+
+          float[] resultArray = new float[5];
+          output.getByteBufferView().asFloatBuffer().get(resultArray);
+          assertArrayEquals(inputArr, resultArray, 1e-6f);
+          outputBuffer.rewind();
+          float[] pinnedArray = new float[5];
+          outputBuffer.asFloatBuffer().get(pinnedArray);
+          assertArrayEquals(inputArr, pinnedArray, 1e-6f);
+        }
+      }
+    }
+  }
+
   @Test
   public void testRunOptions() throws OrtException {
     // model takes 1x5 input of fixed type, echoes back
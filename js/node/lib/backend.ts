@@ -34,16 +34,7 @@ class OnnxruntimeSessionHandler implements SessionHandler {
 
   async run(feeds: SessionHandler.FeedsType, fetches: SessionHandler.FetchesType, options: InferenceSession.RunOptions):
       Promise<SessionHandler.ReturnType> {
-    return new Promise((resolve, reject) => {
-      process.nextTick(() => {
-        try {
-          resolve(this.#inferenceSession.run(feeds, fetches, options));
-        } catch (e) {
-          // reject if any error is thrown
-          reject(e);
-        }
-      });
-    });
+    return this.#inferenceSession.runAsync(feeds, fetches, options);
   }
 }
 
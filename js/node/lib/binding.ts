@@ -17,7 +17,7 @@ type RunOptions = InferenceSession.RunOptions;
 
 
 /**
- * Binding exports a simple synchronized inference session object wrap.
+ * Binding exports a simple inference session object wrap.
  */
 export declare namespace Binding {
   export interface InferenceSession {
@@ -28,6 +28,9 @@ export declare namespace Binding {
     readonly outputNames: string[];
 
     run(feeds: FeedsType, fetches: FetchesType, options: RunOptions): ReturnType;
+    // runs on a thread of the libuv thread pool. the typed arrays of the feeds and fetches are used without a copy,
+    // so they must not be modified before the returned promise is settled.
+    runAsync(feeds: FeedsType, fetches: FetchesType, options: RunOptions): Promise<ReturnType>;
   }
 
   export interface InferenceSessionConstructor {
@@ -23,6 +23,7 @@ Napi::Object InferenceSessionWrap::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(
       env, "InferenceSession",
       {InstanceMethod("loadModel", &InferenceSessionWrap::LoadModel), InstanceMethod("run", &InferenceSessionWrap::Run),
+       InstanceMethod("runAsync", &InferenceSessionWrap::RunAsync),
        InstanceAccessor("inputNames", &InferenceSessionWrap::GetInputNames, nullptr, napi_default, nullptr),
        InstanceAccessor("outputNames", &InferenceSessionWrap::GetOutputNames, nullptr, napi_default, nullptr)});
 
@@ -128,65 +129,154 @@ Napi::Value InferenceSessionWrap::GetOutputNames(const Napi::CallbackInfo &info)
   return scope.Escape(CreateNapiArrayFrom(env, outputNames_));
 }
 
-Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
+namespace {
+
+// the values of a run. input and output values of typed arrays wrap the memory of the typed arrays.
+struct RunValues {
+  std::vector<const char *> inputNames;
+  std::vector<Ort::Value> inputValues;
+  std::vector<const char *> outputNames;
+  std::vector<Ort::Value> outputValues;
+  std::vector<bool> reuseOutput;
+  Ort::RunOptions runOptions{nullptr};
+};
+
+void ParseRunArguments(const Napi::CallbackInfo &info, const std::vector<std::string> &inputNames,
+                       const std::vector<std::string> &outputNames, RunValues &values) {
   Napi::Env env = info.Env();
-  ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
   ORT_NAPI_THROW_TYPEERROR_IF(info.Length() < 2, env, "Expect argument: inputs(feed) and outputs(fetch).");
   ORT_NAPI_THROW_TYPEERROR_IF(!info[0].IsObject() || !info[1].IsObject(), env,
                               "Expect inputs(feed) and outputs(fetch) to be objects.");
   ORT_NAPI_THROW_TYPEERROR_IF(info.Length() > 2 && (!info[2].IsObject() || info[2].IsNull()), env,
                               "'runOptions' must be an object.");
 
-  Napi::EscapableHandleScope scope(env);
-
   auto feed = info[0].As<Napi::Object>();
   auto fetch = info[1].As<Napi::Object>();
 
-  std::vector<const char *> inputNames_cstr;
-  std::vector<Ort::Value> inputValues;
-  std::vector<const char *> outputNames_cstr;
-  std::vector<Ort::Value> outputValues;
-  std::vector<bool> reuseOutput;
-  size_t inputIndex = 0;
-  size_t outputIndex = 0;
+  for (auto &name : inputNames) {
+    if (feed.Has(name)) {
+      values.inputNames.push_back(name.c_str());
+      auto value = feed.Get(name);
+      values.inputValues.push_back(NapiValueToOrtValue(env, value));
+    }
+  }
+  for (auto &name : outputNames) {
+    if (fetch.Has(name)) {
+      values.outputNames.push_back(name.c_str());
+      auto value = fetch.Get(name);
+      values.reuseOutput.push_back(!value.IsNull());
+      values.outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr} : NapiValueToOrtValue(env, value));
+    }
+  }
 
-  try {
-    for (auto &name : inputNames_) {
-      if (feed.Has(name)) {
-        inputIndex++;
-        inputNames_cstr.push_back(name.c_str());
-        auto value = feed.Get(name);
-        inputValues.push_back(NapiValueToOrtValue(env, value));
-      }
+  if (info.Length() > 2) {
+    values.runOptions = Ort::RunOptions{};
+    ParseRunOptions(info[2].As<Napi::Object>(), values.runOptions);
+  }
+}
+
+void RunSession(Ort::Session &session, Ort::RunOptions &defaultRunOptions, RunValues &values) {
+  size_t inputCount = values.inputValues.size();
+  size_t outputCount = values.outputValues.size();
+  session.Run(values.runOptions == nullptr ? defaultRunOptions : values.runOptions,
+              inputCount == 0 ? nullptr : &values.inputNames[0], inputCount == 0 ? nullptr : &values.inputValues[0],
+              inputCount, outputCount == 0 ? nullptr : &values.outputNames[0],
+              outputCount == 0 ? nullptr : &values.outputValues[0], outputCount);
+}
+
+Napi::Object CreateRunResult(Napi::Env env, const Napi::Object &fetch, RunValues &values) {
+  Napi::Object result = Napi::Object::New(env);
+  for (size_t i = 0; i < values.outputValues.size(); i++) {
+    if (values.reuseOutput[i] &&
+        values.outputValues[i].GetTensorTypeAndShapeInfo().GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+      // the output is written to the typed array of the pre-allocated tensor
+      result.Set(values.outputNames[i], fetch.Get(values.outputNames[i]));
+    } else {
+      result.Set(values.outputNames[i], OrtValueToNapiValue(env, std::move(values.outputValues[i])));
     }
-    for (auto &name : outputNames_) {
-      if (fetch.Has(name)) {
-        outputIndex++;
-        outputNames_cstr.push_back(name.c_str());
-        auto value = fetch.Get(name);
-        reuseOutput.push_back(!value.IsNull());
-        outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr} : NapiValueToOrtValue(env, value));
-      }
+  }
+  return result;
+}
+
+// RunWorker runs the session on a thread of the libuv thread pool, so the event loop is not blocked by the run.
+// The session and the typed arrays of the feeds and fetches are referenced until the run is completed.
+class RunWorker : public Napi::AsyncWorker {
+public:
+  RunWorker(Napi::Env env, const Napi::CallbackInfo &info, Ort::Session &session, Ort::RunOptions &defaultRunOptions,
+            std::unique_ptr<RunValues> values)
+      : Napi::AsyncWorker(env, "onnxruntime-node.run"), deferred_(Napi::Promise::Deferred::New(env)),
+        sessionRef_(Napi::Persistent(info.This().As<Napi::Object>())),
+        feedRef_(Napi::Persistent(info[0].As<Napi::Object>())), fetchRef_(Napi::Persistent(info[1].As<Napi::Object>())),
+        session_(session), defaultRunOptions_(defaultRunOptions), values_(std::move(values)) {}
+
+  Napi::Promise Promise() const { return deferred_.Promise(); }
+
+protected:
+  void Execute() override {
+    try {
+      RunSession(session_, defaultRunOptions_, *values_);
+    } catch (std::exception const &e) {
+      SetError(e.what());
     }
+  }
 
-    Ort::RunOptions runOptions{nullptr};
-    if (info.Length() > 2) {
-      runOptions = Ort::RunOptions{};
-      ParseRunOptions(info[2].As<Napi::Object>(), runOptions);
+  void OnOK() override {
+    Napi::Env env = Env();
+    Napi::HandleScope scope(env);
+    try {
+      deferred_.Resolve(CreateRunResult(env, fetchRef_.Value(), *values_));
+    } catch (Napi::Error const &e) {
+      deferred_.Reject(e.Value());
+    } catch (std::exception const &e) {
+      deferred_.Reject(Napi::Error::New(env, e.what()).Value());
     }
+  }
 
-    session_->Run(runOptions == nullptr ? *defaultRunOptions_.get() : runOptions,
-                  inputIndex == 0 ? nullptr : &inputNames_cstr[0], inputIndex == 0 ? nullptr : &inputValues[0],
-                  inputIndex, outputIndex == 0 ? nullptr : &outputNames_cstr[0],
-                  outputIndex == 0 ? nullptr : &outputValues[0], outputIndex);
+  void OnError(const Napi::Error &e) override { deferred_.Reject(e.Value()); }
 
-    Napi::Object result = Napi::Object::New(env);
+private:
+  Napi::Promise::Deferred deferred_;
+  Napi::ObjectReference sessionRef_;
+  Napi::ObjectReference feedRef_;
+  Napi::ObjectReference fetchRef_;
+  Ort::Session &session_;
+  Ort::RunOptions &defaultRunOptions_;
+  std::unique_ptr<RunValues> values_;
+};
 
-    for (size_t i = 0; i < outputIndex; i++) {
-      result.Set(outputNames_[i], OrtValueToNapiValue(env, outputValues[i]));
-    }
+} // namespace
+
+Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
+
+  Napi::EscapableHandleScope scope(env);
+
+  try {
+    RunValues values;
+    ParseRunArguments(info, inputNames_, outputNames_, values);
+    RunSession(*session_, *defaultRunOptions_, values);
+    return scope.Escape(CreateRunResult(env, info[1].As<Napi::Object>(), values));
+  } catch (Napi::Error const &e) {
+    throw e;
+  } catch (std::exception const &e) {
+    ORT_NAPI_THROW_ERROR(env, e.what());
+  }
+}
 
-    return scope.Escape(result);
+Napi::Value InferenceSessionWrap::RunAsync(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
+
+  Napi::EscapableHandleScope scope(env);
+
+  try {
+    std::unique_ptr<RunValues> values{new RunValues{}};
+    ParseRunArguments(info, inputNames_, outputNames_, *values);
+    auto *worker = new RunWorker(env, info, *session_, *defaultRunOptions_, std::move(values));
+    auto promise = worker->Promise();
+    worker->Queue();
+    return scope.Escape(promise);
   } catch (Napi::Error const &e) {
     throw e;
   } catch (std::exception const &e) {
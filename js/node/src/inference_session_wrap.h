@@ -49,6 +49,17 @@ private:
    */
   Napi::Value Run(const Napi::CallbackInfo &info);
 
+  /**
+   * [async] run the model on a thread of the libuv thread pool.
+   * The data of the typed arrays in the inputs and the pre-allocated outputs must not be modified until the run is
+   * completed.
+   * @param arg0 input object: all keys must present, value is object
+   * @param arg1 output object: at least one key must present, value can be null.
+   * @returns a promise of an object that every output specified will present and value must be object
+   * @throw error if the arguments are invalid. the promise is rejected if status code != 0
+   */
+  Napi::Value RunAsync(const Napi::CallbackInfo &info);
+
   // private members
 
   // persistent constructor
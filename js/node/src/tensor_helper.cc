@@ -191,7 +191,7 @@ Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value) {
   }
 }
 
-Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value) {
+Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &&value) {
   Napi::EscapableHandleScope scope(env);
   auto returnValue = Napi::Object::New(env);
 
@@ -247,10 +247,17 @@ Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value) {
     returnValue.Set("data", Napi::Value(env, stringArray));
   } else {
     // number data
-    // TODO: optimize memory
-    auto arrayBuffer = Napi::ArrayBuffer::New(env, size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+    size_t byteLength = size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType];
+    Napi::ArrayBuffer arrayBuffer;
     if (size > 0) {
-      memcpy(arrayBuffer.Data(), value.GetTensorMutableData<void>(), size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+      // the ArrayBuffer owns the OrtValue object, so the tensor memory is used without a copy
+      void *data = value.GetTensorMutableData<void>();
+      auto *ownedValue = new Ort::Value(std::move(value));
+      arrayBuffer = Napi::ArrayBuffer::New(
+          env, data, byteLength, [](Napi::Env /*env*/, void * /*data*/, Ort::Value *hint) { delete hint; },
+          ownedValue);
+    } else {
+      arrayBuffer = Napi::ArrayBuffer::New(env, 0);
     }
     napi_value typedArrayData;
     napi_status status =
@@ -11,5 +11,6 @@
 // convert a Javascript OnnxValue object to an OrtValue object
 Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value);
 
-// convert an OrtValue object to a Javascript OnnxValue object
-Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value);
+// convert an OrtValue object to a Javascript OnnxValue object. the data of a numeric tensor is not copied: the
+// OrtValue object is moved to the external ArrayBuffer of the typed array, and released when it is garbage collected.
+Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &&value);
@@ -52,11 +52,15 @@ module.exports = function (config) {
       { pattern: 'test/data/**/*', included: false, nocache: true },
       { pattern: 'dist/ort-wasm.wasm', included: false },
       { pattern: 'dist/ort-wasm-threaded.wasm', included: false },
+      { pattern: 'dist/ort-wasm-simd.wasm', included: false },
+      { pattern: 'dist/ort-wasm-simd-threaded.wasm', included: false },
       { pattern: 'dist/ort-wasm-threaded.worker.js', included: false },
     ],
     proxies: {
       '/base/test/ort-wasm.wasm': '/base/dist/ort-wasm.wasm',
       '/base/test/ort-wasm-threaded.wasm': '/base/dist/ort-wasm-threaded.wasm',
+      '/base/test/ort-wasm-simd.wasm': '/base/dist/ort-wasm-simd.wasm',
+      '/base/test/ort-wasm-simd-threaded.wasm': '/base/dist/ort-wasm-simd-threaded.wasm',
       '/base/test/ort-wasm-threaded.worker.js': '/base/dist/ort-wasm-threaded.worker.js',
     },
     plugins: karmaPlugins,
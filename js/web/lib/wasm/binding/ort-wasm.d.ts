@@ -36,6 +36,7 @@ export interface OrtWasmModule extends EmscriptenModule {
 
   //#region config
   mainScriptUrlOrBlob?: string|Blob;
+  numThreads?: number;
   //#endregion
 }
 
@@ -13,6 +13,15 @@ let aborted = false;
 
 const isMultiThreadSupported = (): boolean => {
   try {
+    // SharedArrayBuffer is only available when the page is cross-origin isolated
+    // (Cross-Origin-Opener-Policy: same-origin and Cross-Origin-Embedder-Policy: require-corp)
+    if (typeof SharedArrayBuffer === 'undefined') {
+      return false;
+    }
+    if (typeof self !== 'undefined' && (self as {crossOriginIsolated?: boolean}).crossOriginIsolated === false) {
+      return false;
+    }
+
     // Test for transferability of SABs (needed for Firefox)
     // https://groups.google.com/forum/#!msg/mozilla.dev.platform/IHkBZlHETpA/dwsMNchWEQAJ
     new MessageChannel().port1.postMessage(new SharedArrayBuffer(1));
@@ -27,6 +36,19 @@ const isMultiThreadSupported = (): boolean => {
   }
 };
 
+const isSimdSupported = (): boolean => {
+  try {
+    // Test for WebAssembly SIMD capability (for both browsers and Node.js)
+    // This typed array is a WebAssembly program containing SIMD instructions.
+    return WebAssembly.validate(new Uint8Array([
+      0,   97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10,
+      10,  1,  8,   0,   65, 0, 253, 15, 253, 98, 11
+    ]));
+  } catch (e) {
+    return false;
+  }
+};
+
 export const initializeWebAssembly = async(): Promise<void> => {
   if (initialized) {
     return Promise.resolve();
@@ -45,6 +67,11 @@ export const initializeWebAssembly = async(): Promise<void> => {
   const numThreads = env.wasm.numThreads!;
 
   const useThreads = numThreads > 1 && isMultiThreadSupported();
+  if (!useThreads) {
+    // fall back to the single-threaded build, which runs the whole inference on the calling thread
+    env.wasm.numThreads = 1;
+  }
+  const useSimd = isSimdSupported();
   let isTimeout = false;
 
   const tasks: Array<Promise<void>> = [];
@@ -62,9 +89,19 @@ export const initializeWebAssembly = async(): Promise<void> => {
   // promise for module initialization
   tasks.push(new Promise((resolve, reject) => {
     const factory = useThreads ? ortWasmFactoryThreaded : ortWasmFactory;
-    const config: Partial<OrtWasmModule> = {};
+    const config: Partial<OrtWasmModule> = {
+      locateFile: (fileName: string, scriptDirectory: string) => {
+        // the SIMD builds share the JavaScript glue code of the builds without SIMD
+        if (useSimd && fileName.endsWith('.wasm')) {
+          return scriptDirectory + fileName.replace('ort-wasm', 'ort-wasm-simd');
+        }
+        return scriptDirectory + fileName;
+      }
+    };
 
     if (useThreads) {
+      // used by the threaded build to spawn the web workers of the thread pool when the module is instantiated
+      config.numThreads = numThreads;
       config.mainScriptUrlOrBlob = new Blob(
           [`var ortWasmThreaded=(function(){var _scriptDir;return ${ortWasmFactoryThreaded.toString()}})();`],
           {type: 'text/javascript'});
@@ -8,6 +8,7 @@
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include <unsupported/Eigen/SpecialFunctions>
 #include "core/providers/cpu/element_wise_ranged_transform.h"
 
@@ -56,6 +57,7 @@ template <typename T>
 class Gelu : public OpKernel {
  public:
   Gelu(const OpKernelInfo& info) : OpKernel(info) {
+    use_fast_math_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigActivationFastMath, "0") == "1";
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -82,7 +84,11 @@ class Gelu : public OpKernel {
             p_output[i] = value * static_cast<T>(M_SQRT1_2);
           }
 
-          MlasComputeErf(p_output, p_output, count);
+          if (use_fast_math_) {
+            MlasComputeFastErf(p_output, p_output, count);
+          } else {
+            MlasComputeErf(p_output, p_output, count);
+          }
 
           for (int64_t i = 0; i < count; i++) {
             p_output[i] = 0.5f * p_input[i] * (p_output[i] + 1.0f);
@@ -91,6 +97,9 @@ class Gelu : public OpKernel {
         0);
     return Status::OK();
   }
+
+ private:
+  bool use_fast_math_;
 };
 
 }  // namespace contrib
@@ -22,6 +22,9 @@ class Attention : public OpKernel, public AttentionCPUBase {
 
   Status Compute(OpKernelContext* context) const override;
   Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+  Status TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) override;
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   bool& used_shared_buffers) override;
 
  private:
   BufferUniquePtr packed_weights_;
@@ -37,7 +40,8 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
     float,
     kCpuExecutionProvider,
     KernelDefBuilder()
-        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .MayInplace(4, 1),  // present may reuse the buffer of past when they share a buffer
     Attention<float>);
 
 AttentionBase::AttentionBase(const OpKernelInfo& info) {
@@ -46,13 +50,15 @@ AttentionBase::AttentionBase(const OpKernelInfo& info) {
   num_heads_ = static_cast<int>(num_heads);
 
   is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 0) == 1;
+  past_present_share_buffer_ = info.GetAttrOrDefault<int64_t>("past_present_share_buffer", 0) == 1;
 }
 
 Status AttentionBase::CheckInputs(const TensorShape& input_shape,
                                   const TensorShape& weights_shape,
                                   const TensorShape& bias_shape,
                                   const Tensor*& mask_index,
-                                  const Tensor* past) const {
+                                  const Tensor* past,
+                                  const Tensor* past_seq_len) const {
   // Input shapes:
   //   input       : (batch_size, sequence_length, input_hidden_size)
   //   weights     : (input_hidden_size, 3 * hidden_size)
@@ -62,6 +68,8 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
   //                 or (batch_size, past_sequence_length + sequence_length)
   //                 or (batch_size, sequence_length, past_sequence_length + sequence_length)
   //   past        : (2, batch_size, num_heads, past_sequence_length, head_size)
+  //                 or (2, batch_size, num_heads, max_sequence_length, head_size) when past and present share a buffer
+  //   past_seq_len: scalar past_sequence_length when past and present share a buffer
   //
   // Where hidden_size = num_heads * head_size.
   // When a model is pruned (like some attention heads are removed), hidden_size < input_hidden_size.
@@ -126,6 +134,22 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
     past_sequence_length = static_cast<int>(past_dims[3]);
   }
 
+  if (past_present_share_buffer_) {
+    if (past == nullptr || past_seq_len == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Inputs 'past' and 'past_sequence_length' are required when past_present_share_buffer is 1");
+    }
+    if (past_seq_len->Shape().Size() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'past_sequence_length' is expected to be a scalar");
+    }
+    const int max_sequence_length = past_sequence_length;
+    past_sequence_length = *past_seq_len->Data<int32_t>();
+    if (past_sequence_length < 0 || past_sequence_length + sequence_length > max_sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'past_sequence_length' is ", past_sequence_length,
+                             ", the past buffer can't hold ", sequence_length, " more positions");
+    }
+  }
+
   if (mask_index != nullptr) {  // mask_index is optional
     const auto& mask_dims = mask_index->Shape().GetDims();
     if (mask_dims.size() == 1) {
@@ -166,12 +190,13 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
                                   const TensorShape& bias_shape,
                                   const Tensor*& mask_index,
                                   const Tensor* past,
-                                  const int max_threads_per_block) const {
+                                  const int max_threads_per_block,
+                                  const Tensor* past_seq_len) const {
   if (num_heads_ > max_threads_per_block) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "num_heads should be no larger than ", max_threads_per_block);
   }
 
-  return CheckInputs(input_shape, weights_shape, bias_shape, mask_index, past);
+  return CheckInputs(input_shape, weights_shape, bias_shape, mask_index, past, past_seq_len);
 }
 
 Tensor* AttentionBase::GetPresent(OpKernelContext* context,
@@ -179,13 +204,21 @@ Tensor* AttentionBase::GetPresent(OpKernelContext* context,
                                   int batch_size,
                                   int head_size,
                                   int sequence_length,
-                                  int& past_sequence_length) const {
+                                  int& past_sequence_length,
+                                  const Tensor* past_seq_len) const {
   // Input and output shapes:
   //   past        : (2, batch_size, num_heads, past_sequence_length, head_size)
   //   present     : (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)
+  // or when past and present share a buffer:
+  //   past        : (2, batch_size, num_heads, max_sequence_length, head_size)
+  //   present     : (2, batch_size, num_heads, max_sequence_length, head_size)
 
   std::vector<int64_t> present_dims{2, batch_size, num_heads_, sequence_length, head_size};
-  if (nullptr != past) {
+  if (past_present_share_buffer_) {
+    ORT_ENFORCE(nullptr != past && nullptr != past_seq_len);
+    past_sequence_length = *past_seq_len->Data<int32_t>();
+    present_dims = past->Shape().GetDims();
+  } else if (nullptr != past) {
     const auto& past_dims = past->Shape().GetDims();
     past_sequence_length = static_cast<int>(past_dims[3]);
     present_dims[3] += past_dims[3];
@@ -250,6 +283,26 @@ Status Attention<T>::PrePack(const Tensor& weights, int input_idx, bool& is_pack
   return Status::OK();
 }
 
+template <typename T>
+Status Attention<T>::TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) {
+  if (1 == input_idx && packed_weights_) {
+    prepacked_buffers.push_back(std::move(packed_weights_));
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Attention<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                               bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (1 == input_idx) {
+    used_shared_buffers = true;
+    packed_weights_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 Status Attention<T>::Compute(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
@@ -257,13 +310,15 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   const Tensor* bias = context->Input<Tensor>(2);
   const Tensor* mask_index = context->Input<Tensor>(3);
   const Tensor* past = context->Input<Tensor>(4);
+  const Tensor* past_seq_len = context->Input<Tensor>(5);
 
   const TensorShape& weights_shape = (weights ? weights->Shape() : weight_shape_);
   ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(),
                                   weights_shape,
                                   bias->Shape(),
                                   mask_index,
-                                  past));
+                                  past,
+                                  past_seq_len));
 
   const auto& shape = input->Shape().GetDims();
   const int batch_size = static_cast<int>(shape[0]);
@@ -370,7 +425,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   // Compute the attention score and apply the score to V
   return ApplyAttention(Q, K, V, mask_index, past, output,
                         batch_size, sequence_length,
-                        head_size, hidden_size, context);
+                        head_size, hidden_size, context, past_seq_len);
 }
 
 }  // namespace contrib
@@ -17,7 +17,8 @@ class AttentionBase {
                      const TensorShape& weights_shape,
                      const TensorShape& bias_shape,
                      const Tensor*& mask_index,  // For dummy mask with shape (1, 1) or (batch_size, 1), it will be updated to nullptr.
-                     const Tensor* past) const;
+                     const Tensor* past,
+                     const Tensor* past_seq_len = nullptr) const;
 
   // This check function is specifically used in cuda
   Status CheckInputs(const TensorShape& input_shape,
@@ -25,17 +26,22 @@ class AttentionBase {
                      const TensorShape& bias_shape,
                      const Tensor*& mask_index,  // For dummy mask with shape (1, 1) or (batch_size, 1), it will be updated to nullptr.
                      const Tensor* past,
-                     const int max_threads_per_block) const;
+                     const int max_threads_per_block,
+                     const Tensor* past_seq_len = nullptr) const;
 
+  // When past_present_share_buffer_ is set, present has the shape of past, and past_sequence_length
+  // is read from past_seq_len instead of the shape of past.
   Tensor* GetPresent(OpKernelContext* context,
                      const Tensor* past,
                      int batch_size,
                      int head_size,
                      int sequence_length,
-                     int& past_sequence_length) const;
+                     int& past_sequence_length,
+                     const Tensor* past_seq_len = nullptr) const;
 
-  int num_heads_;           // number of attention heads
-  bool is_unidirectional_;  // whether every token can only attend to previous tokens.
+  int num_heads_;                   // number of attention heads
+  bool is_unidirectional_;          // whether every token can only attend to previous tokens.
+  bool past_present_share_buffer_;  // whether past and present share a buffer of max_sequence_length positions.
 };
 
 }  // namespace contrib
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+
 #include "attention_base.h"
 #include "attention_helper.h"
 
@@ -28,18 +31,38 @@ class AttentionCPUBase : public AttentionBase {
                         int sequence_length,       // sequence length
                         int head_size,             // head size
                         int hidden_size,           // hidden size
-                        OpKernelContext* context) const {
+                        OpKernelContext* context,
+                        const Tensor* past_seq_len = nullptr) const {  // past sequence length when past and present share a buffer
     AllocatorPtr allocator;
     ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
     auto* tp = context->GetOperatorThreadPool();
 
     int past_sequence_length = 0;
-    Tensor* present = GetPresent(context, past, batch_size, head_size, sequence_length, past_sequence_length);
+    Tensor* present = GetPresent(context, past, batch_size, head_size, sequence_length, past_sequence_length, past_seq_len);
+
+    // Number of positions of the buffer shared by past and present, or 0 when present is a new buffer.
+    int max_sequence_length = 0;
+    if (past_present_share_buffer_) {
+      ORT_RETURN_IF_NOT(nullptr != present, "Expect to have present state output when past and present share a buffer");
+      max_sequence_length = static_cast<int>(present->Shape()[3]);
+    }
 
     // Total sequence length including that of past state: S* = S' + S
     const int all_sequence_length = past_sequence_length + sequence_length;
 
+    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
+    const std::vector<int64_t>* mask_index_dims = mask_index != nullptr ? &(mask_index->Shape().GetDims()) : nullptr;
+    const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
+    T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
+
+    if (UseFusedAttention(mask_index_dims, sequence_length, all_sequence_length)) {
+      ComputeFusedAttention(output->template MutableData<T>(), Q, K, V, mask_index_data, mask_index_dims,
+                            batch_size, sequence_length, past_sequence_length, max_sequence_length, head_size, hidden_size,
+                            past_data, present_data, allocator, tp);
+      return Status::OK();
+    }
+
     // Compute the attention score. It does 2 things:
     //         I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
     //                                           1 x mask_data(B, N, S, S*)
@@ -56,14 +79,9 @@ class AttentionCPUBase : public AttentionBase {
     }
     BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
 
-    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
-    const std::vector<int64_t>* mask_index_dims = mask_index != nullptr ? &(mask_index->Shape().GetDims()) : nullptr;
-    const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
-    T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
-
     ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, K,
                              mask_index_data, mask_index_dims, static_cast<T*>(mask_data),
-                             batch_size, sequence_length, past_sequence_length, head_size,
+                             batch_size, sequence_length, past_sequence_length, max_sequence_length, head_size,
                              past_data, present_data, tp);
 
     // Compute the attentionScore * Value. It does: out_tmp(B, N, S, H) = attention_probs(B, N, S, S*) x V(B, N, S*, H)
@@ -72,13 +90,207 @@ class AttentionCPUBase : public AttentionBase {
     BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
 
     ComputeVxAttentionScore(output->template MutableData<T>(), static_cast<T*>(out_tmp_data), static_cast<T*>(attention_probs), V,
-                            batch_size, sequence_length, past_sequence_length, head_size, hidden_size,
+                            batch_size, sequence_length, past_sequence_length, max_sequence_length, head_size, hidden_size,
                             past_data, present_data, tp);
 
     return Status::OK();
   }
 
  private:
+  // The fused attention is used once the attention probs of one head, S x S*, exceed 256KB of floats.
+  static bool UseFusedAttention(const std::vector<int64_t>* mask_index_dims, int sequence_length, int all_sequence_length) {
+    constexpr size_t kFusedAttentionMinProbsCount = 64 * 1024;
+    // 4D mask is not supported in cpu kernel
+    if (mask_index_dims != nullptr && mask_index_dims->size() == 4) {
+      return false;
+    }
+    return static_cast<size_t>(sequence_length) * static_cast<size_t>(all_sequence_length) >= kFusedAttentionMinProbsCount;
+  }
+
+  // Helper function to compute the attention output without materializing the attention probs(B, N, S, S*).
+  // Q is processed in blocks of rows. For each block, the scores of K are computed one block of positions at a time
+  // and applied to the matching block of V, keeping a running maximum and sum of each row (online softmax) and
+  // rescaling the partial output whenever the maximum grows. The scratch memory only depends on the block sizes,
+  // so the working set of a block stays in cache for long sequences.
+  template <typename T>
+  void ComputeFusedAttention(T* output,                                    // output buffer with size BxSxNxH
+                             const T* Q,                                   // Q data. Its size is BxNxSxH
+                             const T* K,                                   // K data. Its size is BxNxSxH
+                             const T* V,                                   // V data. Its size is BxNxSxH
+                             const int32_t* mask_index,                    // mask index. nullptr if no mask
+                             const std::vector<int64_t>* mask_index_dims,  // mask index shape
+                             int batch_size,                               // batch size of self-attention
+                             int sequence_length,                          // sequence length of self-attention
+                             int past_sequence_length,                     // sequence length of past state
+                             int max_sequence_length,                      // sequence length of shared past/present buffer, or 0
+                             int head_size,                                // head size of self-attention
+                             int hidden_size,                              // hidden size
+                             const T* past,                                // past state
+                             T* present,                                   // present state
+                             AllocatorPtr allocator,
+                             ThreadPool* tp) const {
+    constexpr int kQueryBlockSize = 64;
+    constexpr int kKeyBlockSize = 128;
+
+    const int all_sequence_length = past_sequence_length + sequence_length;                  // S* = S' + S
+    const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;  // S' x H
+    const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;      // S x H
+    const size_t present_chunk_length = past_chunk_length + input_chunk_length;              // S* x H
+    const bool share_buffer = max_sequence_length > 0;
+    const size_t buffer_chunk_length = share_buffer ? static_cast<size_t>(max_sequence_length) * head_size
+                                                    : present_chunk_length;
+    const int loop_len = batch_size * num_heads_;
+
+    // concatenate past_K and K, past_V and V: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
+    const T* k_data = K;
+    const T* v_data = V;
+    size_t kv_chunk_length = input_chunk_length;
+    if (nullptr != present) {
+      const T* past_v = past != nullptr
+                            ? past + static_cast<size_t>(loop_len) * (share_buffer ? buffer_chunk_length : past_chunk_length)
+                            : nullptr;
+      T* present_v = present + static_cast<size_t>(loop_len) * buffer_chunk_length;
+      ThreadPool::TryParallelFor(tp, loop_len, static_cast<double>(present_chunk_length),
+                                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                                   for (std::ptrdiff_t i = begin; i != end; ++i) {
+                                     if (share_buffer) {
+                                       AppendStateChunk(past, K + input_chunk_length * i, present,
+                                                        past_chunk_length, input_chunk_length, buffer_chunk_length, i);
+                                       AppendStateChunk(past_v, V + input_chunk_length * i, present_v,
+                                                        past_chunk_length, input_chunk_length, buffer_chunk_length, i);
+                                     } else {
+                                       ConcatStateChunk(past, K + input_chunk_length * i, present,
+                                                        past_chunk_length, present_chunk_length, i);
+                                       ConcatStateChunk(past_v, V + input_chunk_length * i, present_v,
+                                                        past_chunk_length, present_chunk_length, i);
+                                     }
+                                   }
+                                 });
+      k_data = present;
+      v_data = present_v;
+      kv_chunk_length = buffer_chunk_length;
+    }
+
+    // 1D and 2D masks only depend on the position in K: convert them to (B)xS* once.
+    // 3D masks are converted on the fly.
+    const bool is_3d_mask = nullptr != mask_index_dims && mask_index_dims->size() == 3;
+    T* key_mask = nullptr;
+    if (nullptr != mask_index && !is_3d_mask) {
+      size_t key_mask_bytes = SafeInt<size_t>(batch_size) * all_sequence_length * sizeof(T);
+      key_mask = static_cast<T*>(allocator->Alloc(key_mask_bytes));
+      memset(key_mask, 0, key_mask_bytes);
+      PrepareMask(mask_index, mask_index_dims, key_mask, false, batch_size, 1, all_sequence_length - 1);
+    }
+    BufferUniquePtr key_mask_buffer(key_mask, BufferDeleter(allocator));
+
+    const bool apply_unidirectional_mask = is_unidirectional_ && sequence_length > 1;
+    const int query_block_count = (sequence_length + kQueryBlockSize - 1) / kQueryBlockSize;
+    const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+
+    // The cost of the two Gemms of a block of rows
+    const double cost = 2.0 * kQueryBlockSize * all_sequence_length * head_size;
+
+    ThreadPool::TryParallelFor(tp, static_cast<std::ptrdiff_t>(loop_len) * query_block_count, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      // scratch: scores (kQueryBlockSize x kKeyBlockSize), output (kQueryBlockSize x H), row max and row sum
+      const size_t scratch_count = static_cast<size_t>(kQueryBlockSize) * (kKeyBlockSize + head_size + 2);
+      void* scratch = allocator->Alloc(SafeInt<size_t>(scratch_count) * sizeof(T));
+      BufferUniquePtr scratch_buffer(scratch, BufferDeleter(allocator));
+      T* scores = static_cast<T*>(scratch);
+      T* out = scores + kQueryBlockSize * kKeyBlockSize;
+      T* row_max = out + kQueryBlockSize * head_size;
+      T* row_sum = row_max + kQueryBlockSize;
+
+      for (std::ptrdiff_t task = begin; task != end; ++task) {
+        const std::ptrdiff_t i = task / query_block_count;
+        const int batch_index = static_cast<int>(i / num_heads_);
+        const int head_index = static_cast<int>(i % num_heads_);
+        const int row_begin = static_cast<int>(task % query_block_count) * kQueryBlockSize;
+        const int rows = std::min(kQueryBlockSize, sequence_length - row_begin);
+
+        const T* q = Q + input_chunk_length * i + static_cast<size_t>(row_begin) * head_size;
+        const T* k = k_data + kv_chunk_length * i;
+        const T* v = v_data + kv_chunk_length * i;
+
+        std::fill_n(row_max, rows, -std::numeric_limits<T>::infinity());
+        std::fill_n(row_sum, rows, static_cast<T>(0));
+        std::fill_n(out, static_cast<size_t>(rows) * head_size, static_cast<T>(0));
+
+        for (int col_begin = 0; col_begin < all_sequence_length; col_begin += kKeyBlockSize) {
+          const int cols = std::min(kKeyBlockSize, all_sequence_length - col_begin);
+
+          // scores(rows, cols) = 1/sqrt(H) x Q(rows, H) x K'(H, cols)
+          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, rows, cols, head_size, alpha,
+                                    q, k + static_cast<size_t>(col_begin) * head_size, 0.0f, scores, nullptr);
+
+          for (int r = 0; r < rows; r++) {
+            T* x = scores + r * cols;
+            const int s_i = row_begin + r;
+
+            if (nullptr != key_mask) {
+              const T* key_mask_row = key_mask + static_cast<size_t>(batch_index) * all_sequence_length + col_begin;
+              for (int c = 0; c < cols; c++) {
+                x[c] += key_mask_row[c];
+              }
+            } else if (is_3d_mask) {
+              const int32_t* mask_row = mask_index +
+                                        (static_cast<size_t>(batch_index) * sequence_length + s_i) * all_sequence_length + col_begin;
+              for (int c = 0; c < cols; c++) {
+                x[c] += (mask_row[c] > 0) ? static_cast<T>(0.0f) : static_cast<T>(-10000.0f);
+              }
+            }
+
+            if (apply_unidirectional_mask) {
+              for (int c = std::max(0, past_sequence_length + s_i + 1 - col_begin); c < cols; c++) {
+                x[c] += static_cast<T>(-10000.0f);
+              }
+            }
+
+            T max = row_max[r];
+            for (int c = 0; c < cols; c++) {
+              if (max < x[c])
+                max = x[c];
+            }
+            for (int c = 0; c < cols; c++) {
+              x[c] -= max;
+            }
+            ComputeExpInplace(x, static_cast<size_t>(cols));
+
+            T sum = 0;
+            for (int c = 0; c < cols; c++) {
+              sum += x[c];
+            }
+
+            // rescale the partial results of the previous blocks to the new maximum
+            const T scale = std::exp(row_max[r] - max);
+            row_sum[r] = row_sum[r] * scale + sum;
+            row_max[r] = max;
+            if (scale != static_cast<T>(1)) {
+              T* out_row = out + r * head_size;
+              for (int h = 0; h < head_size; h++) {
+                out_row[h] *= scale;
+              }
+            }
+          }
+
+          // out(rows, H) += scores(rows, cols) x V(cols, H)
+          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasNoTrans, rows, head_size, cols, 1.0f,
+                                    scores, v + static_cast<size_t>(col_begin) * head_size, 1.0f, out, nullptr);
+        }
+
+        // normalize and transpose: out(B, S, N, H) = out_tmp(B, N, S, H) / sum
+        for (int r = 0; r < rows; r++) {
+          const T* src = out + r * head_size;
+          T* dest = output + (static_cast<size_t>(batch_index) * sequence_length + row_begin + r) * hidden_size +
+                    static_cast<size_t>(head_index) * head_size;
+          const T inverse_sum = static_cast<T>(1) / row_sum[r];
+          for (int h = 0; h < head_size; h++) {
+            dest[h] = src[h] * inverse_sum;
+          }
+        }
+      }
+    });
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
   //                                    1 x mask_data(B, N, S, S*)
@@ -93,6 +305,7 @@ class AttentionCPUBase : public AttentionBase {
                              int batch_size,                               // batch size of self-attention
                              int sequence_length,                          // sequence length of self-attention
                              int past_sequence_length,                     // sequence length of past state
+                             int max_sequence_length,                      // sequence length of shared past/present buffer, or 0
                              int head_size,                                // head size of self-attention
                              const T* past,                                // past state
                              T* present,                                   // present state
@@ -101,6 +314,7 @@ class AttentionCPUBase : public AttentionBase {
     const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;  // S' x H
     const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;      // S x H
     const size_t present_chunk_length = past_chunk_length + input_chunk_length;              // S* x H
+    const size_t buffer_chunk_length = static_cast<size_t>(max_sequence_length) * head_size;  // max_S x H
 
     {
       if (mask_data != nullptr) {
@@ -129,7 +343,9 @@ class AttentionCPUBase : public AttentionBase {
           const T* k = K + input_chunk_length * i;
           if (nullptr != present) {
             // concatenate past_K and K : (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
-            k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
+            k = max_sequence_length > 0
+                    ? AppendStateChunk(past, k, present, past_chunk_length, input_chunk_length, buffer_chunk_length, i)
+                    : ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
           }
 
           // gemm
@@ -160,6 +376,7 @@ class AttentionCPUBase : public AttentionBase {
                                int batch_size,            // batch size
                                int sequence_length,       // sequence length
                                int past_sequence_length,  // sequence length in past state
+                               int max_sequence_length,   // sequence length of shared past/present buffer, or 0
                                int head_size,             // head size
                                int hidden_size,           // hidden size
                                const T* past,             // past state
@@ -169,13 +386,14 @@ class AttentionCPUBase : public AttentionBase {
     const size_t past_chunk_length = static_cast<size_t>(past_sequence_length * head_size);  // S' x H
     const size_t input_chunk_length = static_cast<size_t>(sequence_length * head_size);      // S x H
     const size_t present_chunk_length = past_chunk_length + input_chunk_length;              // S* x H
+    const size_t buffer_chunk_length = static_cast<size_t>(max_sequence_length) * head_size;  // max_S x H
 
     // Move the pointer of past and present to start of v values.
     if (nullptr != past) {
-      past += batch_size * num_heads_ * past_sequence_length * head_size;
+      past += batch_size * num_heads_ * (max_sequence_length > 0 ? max_sequence_length : past_sequence_length) * head_size;
     }
     if (nullptr != present) {
-      present += batch_size * num_heads_ * all_sequence_length * head_size;
+      present += batch_size * num_heads_ * (max_sequence_length > 0 ? max_sequence_length : all_sequence_length) * head_size;
     }
 
     const double cost =
@@ -186,7 +404,9 @@ class AttentionCPUBase : public AttentionBase {
         const T* v = V + input_chunk_length * i;
         if (nullptr != present) {
           // concatenate past_V and V: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
-          v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
+          v = max_sequence_length > 0
+                  ? AppendStateChunk(past, v, present, past_chunk_length, input_chunk_length, buffer_chunk_length, i)
+                  : ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
         }
 
         T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + input_chunk_length * i;
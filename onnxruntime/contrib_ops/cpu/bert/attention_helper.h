@@ -60,6 +60,18 @@ inline void ComputeAttentionSoftmaxInplace(float* score, int N, int D, ThreadPoo
   MlasComputeSoftmax(score, score, N, D, false, tp);
 }
 
+template <typename T>
+void ComputeExpInplace(T* x, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    x[i] = std::exp(x[i]);
+  }
+}
+
+template <>
+inline void ComputeExpInplace(float* x, size_t n) {
+  MlasComputeExp(x, x, n);
+}
+
 template <typename T>
 void PrepareMask(const int32_t* mask_index,
                  const std::vector<int64_t>* mask_index_dims,
@@ -165,5 +177,22 @@ T* ConcatStateChunk(const T* past, const T* chunk, T* present, size_t past_chunk
   return start;
 }
 
+// Append an input state chunk SxH after the first S' positions of a present state chunk with a buffer of
+// buffer_chunk_length elements, which past shares when past and present share a buffer. The past positions
+// are only copied when past and present are different buffers.
+// Returns a pointer to the start of present state chunk.
+template <typename T>
+T* AppendStateChunk(const T* past, const T* chunk, T* present, size_t past_chunk_length, size_t input_chunk_length,
+                    size_t buffer_chunk_length, std::ptrdiff_t i) {
+  T* start = present + i * buffer_chunk_length;
+
+  if (nullptr != past && past != present) {
+    memcpy(start, past + i * buffer_chunk_length, past_chunk_length * sizeof(T));
+  }
+
+  memcpy(start + past_chunk_length, chunk, input_chunk_length * sizeof(T));
+  return start;
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -60,7 +60,11 @@ Status BiasGelu<T, use_approximation>::Compute(OpKernelContext* context) const {
               p_output[i] = value * (static_cast<T>(C) * value * value + static_cast<T>(B));
             }
 
-            MlasComputeTanh(p_output, p_output, count);
+            if (use_fast_math_) {
+              MlasComputeFastTanh(p_output, p_output, count);
+            } else {
+              MlasComputeTanh(p_output, p_output, count);
+            }
 
             for (int64_t i = 0; i < count; i++) {
               p_output[i] = 0.5f * p_input[i] * (p_output[i] + 1.0f);
@@ -106,7 +110,11 @@ void BiasGelu<T, use_approximation>::AddBiasGelu(
       temp[i] = value * 0.5f;
     }
 
-    MlasComputeTanh(output, output, count);
+    if (use_fast_math_) {
+      MlasComputeFastTanh(output, output, count);
+    } else {
+      MlasComputeTanh(output, output, count);
+    }
 
     for (int64_t i = 0; i < count; i++) {
       output[i] = temp[i] * (output[i] + 1.0f);
@@ -118,7 +126,11 @@ void BiasGelu<T, use_approximation>::AddBiasGelu(
       temp[i] = value * 0.5f;
     }
 
-    MlasComputeErf(output, output, count);
+    if (use_fast_math_) {
+      MlasComputeFastErf(output, output, count);
+    } else {
+      MlasComputeErf(output, output, count);
+    }
 
     for (int64_t i = 0; i < count; i++) {
       output[i] = temp[i] * (output[i] + 1.0f);
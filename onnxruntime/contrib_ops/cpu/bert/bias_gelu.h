@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -12,11 +13,16 @@ namespace contrib {
 template <typename T, bool use_approximation>
 class BiasGelu : public OpKernel {
  public:
-  BiasGelu(const OpKernelInfo& info) : OpKernel(info) {}
+  BiasGelu(const OpKernelInfo& info) : OpKernel(info) {
+    use_fast_math_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigActivationFastMath, "0") == "1";
+  }
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   void AddBiasGelu(const T* input, const T* bias, T* temp, T* output, int64_t count) const;
+
+  // Tanh and Erf are computed with the fast approximations of MLAS.
+  bool use_fast_math_;
 };
 
 }  // namespace contrib
@@ -5,6 +5,7 @@
 #include "embed_layer_norm_helper.h"
 #include "core/util/math_cpuonly.h"
 #include "core/platform/threadpool.h"
+#include "core/mlas/inc/mlas.h"
 
 #include <atomic>
 
@@ -97,25 +98,13 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
       const T* input_position_embedding = position_embedding_data + position_col_index * hidden_size;
       const T* input_segment_embedding = (nullptr == segment_embedding_data) ? nullptr : segment_embedding_data + segment_col_index * hidden_size;
 
-      T sum = static_cast<T>(0);
-      for (int i = 0; i < hidden_size; i++) {
-        T subtotal = input_word_embedding[i] + input_position_embedding[i];
-        if (nullptr != segment_embedding_data)
-          subtotal += input_segment_embedding[i];
-        y[i] = subtotal;
-        sum += subtotal;
-      }
-      T mean = sum / hidden_size;
-      sum = 0;
-      for (int i = 0; i < hidden_size; i++) {
-        T a = y[i] - mean;
-        y[i] = a;
-        sum += a * a;
-      }
-      T e = sqrt(sum / hidden_size + static_cast<T>(epsilon_));
-      for (int i = 0; i < hidden_size; i++) {
-        y[i] = y[i] / e * gamma_data[i] + beta_data[i];
-      }
+      // The sum of the embeddings is stored to y in the same pass that computes its moments.
+      T mean;
+      T variance;
+      MlasComputeAddMeanVariance(input_word_embedding, input_position_embedding, input_segment_embedding, y,
+                                 static_cast<size_t>(hidden_size), &mean, &variance);
+      MlasComputeNormalization(y, y, static_cast<size_t>(hidden_size), mean,
+                               1.0f / std::sqrt(variance + epsilon_), gamma_data, beta_data);
     }, 0);
 
     if (failed.load(std::memory_order_acquire)) {
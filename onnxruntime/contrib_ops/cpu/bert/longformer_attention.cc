@@ -0,0 +1,269 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "longformer_attention_base.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class LongformerAttention : public OpKernel, public LongformerAttentionBase {
+ public:
+  explicit LongformerAttention(const OpKernelInfo& info) : OpKernel(info), LongformerAttentionBase(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+// These ops are internal-only, so register outside of onnx
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    LongformerAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    LongformerAttention<float>);
+
+namespace {
+
+// Computes the sliding window attention of one block of W rows of a head. The rows of the block attend the columns
+// of the three blocks around it, which cover the windows [s - W, s + W] of all the rows, and the global tokens out
+// of these columns. Entries outside of the window of their row are excluded, unless their column is a global token.
+// q, k and v point to the first row of the head, and their rows are qkv_stride apart.
+void ComputeLocalAttentionBlock(const float* q, const float* k, const float* v, int qkv_stride,
+                                const float* mask, const int* global, const std::vector<int>& global_index,
+                                float* output, int output_stride, int row_start, int sequence_length, int window,
+                                int head_size, float scale, std::vector<float>& scores,
+                                std::vector<float>& global_kv, std::vector<int>& extra_columns) {
+  const int column_start = std::max(row_start - window, 0);
+  const int column_end = std::min(row_start + 2 * window, sequence_length);
+  const int column_count = column_end - column_start;
+
+  // Gather K and V of the global tokens out of the columns of the block.
+  extra_columns.clear();
+  for (int g : global_index) {
+    if (g < column_start || g >= column_end) {
+      extra_columns.push_back(g);
+    }
+  }
+  const int extra_count = static_cast<int>(extra_columns.size());
+  global_kv.resize(2 * static_cast<size_t>(extra_count) * head_size);
+  float* global_k = global_kv.data();
+  float* global_v = global_k + static_cast<size_t>(extra_count) * head_size;
+  for (int e = 0; e < extra_count; e++) {
+    const size_t offset = static_cast<size_t>(extra_columns[e]) * qkv_stride;
+    std::copy_n(k + offset, head_size, global_k + e * head_size);
+    std::copy_n(v + offset, head_size, global_v + e * head_size);
+  }
+
+  // scores(W, 3W + G) = 1/sqrt(H) x q(W, H) x [k(3W, H), global_k(G, H)]'
+  const int ld = column_count + extra_count;
+  scores.resize(static_cast<size_t>(window) * ld);
+  const float* q_block = q + static_cast<size_t>(row_start) * qkv_stride;
+  MlasGemm(CblasNoTrans, CblasTrans, window, column_count, head_size, scale, q_block, qkv_stride,
+           k + static_cast<size_t>(column_start) * qkv_stride, qkv_stride, 0.0f, scores.data(), ld, nullptr);
+  if (extra_count > 0) {
+    MlasGemm(CblasNoTrans, CblasTrans, window, extra_count, head_size, scale, q_block, qkv_stride,
+             global_k, head_size, 0.0f, scores.data() + column_count, ld, nullptr);
+  }
+
+  for (int r = 0; r < window; r++) {
+    const int s = row_start + r;
+    float* row = scores.data() + static_cast<size_t>(r) * ld;
+    for (int c = 0; c < column_count; c++) {
+      const int j = column_start + c;
+      if (std::abs(j - s) <= window || global[j] != 0) {
+        row[c] += mask[j];
+      } else {
+        row[c] = std::numeric_limits<float>::lowest();
+      }
+    }
+    for (int e = 0; e < extra_count; e++) {
+      row[column_count + e] += mask[extra_columns[e]];
+    }
+  }
+
+  MlasComputeSoftmax(scores.data(), scores.data(), window, ld, false, nullptr);
+
+  // To be consistent with Huggingface Longformer, the rows of masked tokens are zeros.
+  for (int r = 0; r < window; r++) {
+    if (mask[row_start + r] < 0.0f) {
+      std::fill_n(scores.data() + static_cast<size_t>(r) * ld, ld, 0.0f);
+    }
+  }
+
+  // output(W, H) = scores(W, 3W + G) x [v(3W, H), global_v(G, H)]
+  float* output_block = output + static_cast<size_t>(row_start) * output_stride;
+  MlasGemm(CblasNoTrans, CblasNoTrans, window, head_size, column_count, 1.0f, scores.data(), ld,
+           v + static_cast<size_t>(column_start) * qkv_stride, qkv_stride, 0.0f, output_block, output_stride, nullptr);
+  if (extra_count > 0) {
+    MlasGemm(CblasNoTrans, CblasNoTrans, window, head_size, extra_count, 1.0f, scores.data() + column_count, ld,
+             global_v, head_size, 1.0f, output_block, output_stride, nullptr);
+  }
+}
+
+// Computes the attention of the global tokens of one head, which attend every row with the global projections.
+void ComputeGlobalAttention(const float* q, const float* k, const float* v, int qkv_stride,
+                            const float* mask, const std::vector<int>& global_index,
+                            float* output, int output_stride, int sequence_length, int head_size, float scale,
+                            std::vector<float>& query, std::vector<float>& scores) {
+  const int global_count = static_cast<int>(global_index.size());
+  query.resize(static_cast<size_t>(global_count) * head_size);
+  for (int g = 0; g < global_count; g++) {
+    std::copy_n(q + static_cast<size_t>(global_index[g]) * qkv_stride, head_size, query.data() + g * head_size);
+  }
+
+  // scores(G, S) = 1/sqrt(H) x query(G, H) x k(S, H)' + mask(S)
+  scores.resize(static_cast<size_t>(global_count) * sequence_length);
+  MlasGemm(CblasNoTrans, CblasTrans, global_count, sequence_length, head_size, scale, query.data(), head_size,
+           k, qkv_stride, 0.0f, scores.data(), sequence_length, nullptr);
+  for (int g = 0; g < global_count; g++) {
+    float* row = scores.data() + static_cast<size_t>(g) * sequence_length;
+    for (int j = 0; j < sequence_length; j++) {
+      row[j] += mask[j];
+    }
+  }
+
+  MlasComputeSoftmax(scores.data(), scores.data(), global_count, sequence_length, false, nullptr);
+
+  // query(G, H) = scores(G, S) x v(S, H), then written to the rows of the global tokens that are not masked.
+  MlasGemm(CblasNoTrans, CblasNoTrans, global_count, head_size, sequence_length, 1.0f, scores.data(), sequence_length,
+           v, qkv_stride, 0.0f, query.data(), head_size, nullptr);
+  for (int g = 0; g < global_count; g++) {
+    if (mask[global_index[g]] >= 0.0f) {
+      std::copy_n(query.data() + g * head_size, head_size,
+                  output + static_cast<size_t>(global_index[g]) * output_stride);
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+Status LongformerAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* mask = context->Input<Tensor>(3);
+  const Tensor* global_weights = context->Input<Tensor>(4);
+  const Tensor* global_bias = context->Input<Tensor>(5);
+  const Tensor* global_attention = context->Input<Tensor>(6);
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask->Shape(),
+                                  global_weights->Shape(), global_bias->Shape(), global_attention->Shape()));
+
+  // Input and output shapes:
+  //   Input 0 - input       : (batch_size, sequence_length, hidden_size)
+  //   Output 0 - output     : (batch_size, sequence_length, hidden_size)
+  const auto& shape = input->Shape();
+  const int batch_size = static_cast<int>(shape[0]);
+  const int sequence_length = static_cast<int>(shape[1]);
+  const int hidden_size = static_cast<int>(shape[2]);
+  const int head_size = hidden_size / num_heads_;
+
+  Tensor* output = context->Output(0, shape);
+  if (shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto* tp = context->GetOperatorThreadPool();
+
+  // Positions of the global tokens of each batch.
+  const int* global_data = global_attention->template Data<int>();
+  std::vector<std::vector<int>> global_index(batch_size);
+  size_t max_global_count = 0;
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      if (global_data[b * sequence_length + s] != 0) {
+        global_index[b].push_back(s);
+      }
+    }
+    max_global_count = std::max(max_global_count, global_index[b].size());
+  }
+
+  // qkv(B, S, 3, N, H) = input(B, S, D) x weights(D, 3, N, H) + bias(3, N, H), and the same for the global
+  // projections when there are global tokens.
+  const int qkv_stride = 3 * hidden_size;
+  const size_t qkv_length = SafeInt<size_t>(batch_size) * sequence_length * qkv_stride;
+  auto qkv_data = allocator->Alloc(SafeInt<size_t>(max_global_count > 0 ? 2 : 1) * qkv_length * sizeof(T));
+  BufferUniquePtr qkv_buffer(qkv_data, BufferDeleter(allocator));
+  T* qkv = static_cast<T*>(qkv_data);
+  T* global_qkv = qkv + qkv_length;
+
+  const T* input_data = input->template Data<T>();
+  auto project = [&](const Tensor* projection_weights, const Tensor* projection_bias, T* destination) {
+    const T* bias_data = projection_bias->template Data<T>();
+    for (int i = 0; i < batch_size * sequence_length; i++) {
+      std::copy_n(bias_data, qkv_stride, destination + static_cast<size_t>(i) * qkv_stride);
+    }
+    MlasGemm(CblasNoTrans, CblasNoTrans, static_cast<size_t>(batch_size) * sequence_length, qkv_stride, hidden_size,
+             1.0f, input_data, hidden_size, projection_weights->template Data<T>(), qkv_stride,
+             1.0f, destination, qkv_stride, tp);
+  };
+  project(weights, bias, qkv);
+  if (max_global_count > 0) {
+    project(global_weights, global_bias, global_qkv);
+  }
+
+  const T* mask_data = mask->template Data<T>();
+  T* output_data = output->template MutableData<T>();
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+
+  // The local attention is computed for each block of W rows of each head, with the cost of its 3 blocks of columns.
+  const int block_count = sequence_length / window_;
+  const double local_cost = 6.0 * window_ * window_ * head_size;
+  ThreadPool::TryParallelFor(tp, batch_size * num_heads_ * block_count, local_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    std::vector<float> scores;
+    std::vector<float> global_kv;
+    std::vector<int> extra_columns;
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int block_index = static_cast<int>(i % block_count);
+      const int head_index = static_cast<int>((i / block_count) % num_heads_);
+      const int batch_index = static_cast<int>(i / (block_count * num_heads_));
+      const T* q = qkv + static_cast<size_t>(batch_index) * sequence_length * qkv_stride + head_index * head_size;
+      T* output_head = output_data + static_cast<size_t>(batch_index) * sequence_length * hidden_size +
+                       head_index * head_size;
+      ComputeLocalAttentionBlock(q, q + hidden_size, q + 2 * hidden_size, qkv_stride,
+                                 mask_data + batch_index * sequence_length, global_data + batch_index * sequence_length,
+                                 global_index[batch_index], output_head, hidden_size, block_index * window_,
+                                 sequence_length, window_, head_size, scale, scores, global_kv, extra_columns);
+    }
+  });
+
+  // The rows of the global tokens are then replaced by their global attention.
+  if (max_global_count > 0) {
+    const double global_cost = 4.0 * max_global_count * sequence_length * head_size;
+    ThreadPool::TryParallelFor(tp, batch_size * num_heads_, global_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      std::vector<float> query;
+      std::vector<float> scores;
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const int head_index = static_cast<int>(i % num_heads_);
+        const int batch_index = static_cast<int>(i / num_heads_);
+        if (global_index[batch_index].empty()) {
+          continue;
+        }
+        const T* q = global_qkv + static_cast<size_t>(batch_index) * sequence_length * qkv_stride +
+                     head_index * head_size;
+        T* output_head = output_data + static_cast<size_t>(batch_index) * sequence_length * hidden_size +
+                         head_index * head_size;
+        ComputeGlobalAttention(q, q + hidden_size, q + 2 * hidden_size, qkv_stride,
+                               mask_data + batch_index * sequence_length, global_index[batch_index],
+                               output_head, hidden_size, sequence_length, head_size, scale, query, scores);
+      }
+    });
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/util/prefetch.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Sums or averages the rows of an embedding table selected by each bag of indices, which is Gather followed
+// by ReduceSum/ReduceMean without the intermediate gathered tensor.
+class EmbeddingBag final : public OpKernel {
+ public:
+  EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    ORT_ENFORCE(mode == "sum" || mode == "mean", "EmbeddingBag mode must be 'sum' or 'mean', got: ", mode);
+    is_mean_ = mode == "mean";
+    keepdims_ = info.GetAttrOrDefault<int64_t>("keepdims", 0) != 0;
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(const Tensor& data, const Tensor& indices, Tensor& output,
+                     concurrency::ThreadPool* thread_pool) const;
+
+  bool is_mean_;
+  bool keepdims_;
+};
+
+template <typename Tind>
+Status EmbeddingBag::ComputeImpl(const Tensor& data, const Tensor& indices, Tensor& output,
+                                 concurrency::ThreadPool* thread_pool) const {
+  const auto& indices_shape = indices.Shape();
+  const int64_t num_rows = data.Shape()[0];
+  const int64_t row_size = data.Shape().SizeFromDimension(1);
+  const int64_t bag_size = indices_shape[indices_shape.NumDimensions() - 1];
+  const int64_t num_bags = indices_shape.SizeToDimension(indices_shape.NumDimensions() - 1);
+
+  const float* data_base = data.Data<float>();
+  const Tind* indices_data = indices.Data<Tind>();
+  float* output_data = output.MutableData<float>();
+
+  const int64_t num_indices = indices_shape.Size();
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    if (idx < -num_rows || idx >= num_rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -num_rows, ",", num_rows - 1, "]");
+    }
+  }
+
+  const auto row_at = [&](int64_t i) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    return data_base + (idx < 0 ? idx + num_rows : idx) * row_size;
+  };
+  const size_t row_bytes = static_cast<size_t>(row_size) * sizeof(float);
+  // mean of an empty bag is 0 / 0 like ReduceMean
+  const float scale = is_mean_ ? 1.0f / static_cast<float>(bag_size) : 1.0f;
+
+  const double bag_elements = static_cast<double>(bag_size * row_size);
+  const TensorOpCost cost{bag_elements * sizeof(float), static_cast<double>(row_bytes), bag_elements};
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, num_bags, cost, [&](ptrdiff_t first, ptrdiff_t last) {
+        // the indices of the bags in [first, last) are contiguous, so prefetching runs across bag boundaries
+        const int64_t indices_begin = static_cast<int64_t>(first) * bag_size;
+        const int64_t indices_end = static_cast<int64_t>(last) * bag_size;
+        for (int64_t i = indices_begin; i < std::min<int64_t>(indices_end, indices_begin + kGatherPrefetchDistance); ++i) {
+          PrefetchRead(row_at(i), row_bytes);
+        }
+
+        for (ptrdiff_t bag = first; bag < last; ++bag) {
+          float* output_row = output_data + bag * row_size;
+          std::fill_n(output_row, row_size, 0.0f);
+
+          for (int64_t i = bag * bag_size, end = i + bag_size; i < end; ++i) {
+            if (i + kGatherPrefetchDistance < indices_end) {
+              PrefetchRead(row_at(i + kGatherPrefetchDistance), row_bytes);
+            }
+            const float* row = row_at(i);
+            for (int64_t j = 0; j < row_size; ++j) {
+              output_row[j] += row[j];
+            }
+          }
+
+          if (is_mean_) {
+            for (int64_t j = 0; j < row_size; ++j) {
+              output_row[j] *= scale;
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+Status EmbeddingBag::Compute(OpKernelContext* context) const {
+  const auto* data = context->Input<Tensor>(0);
+  const auto* indices = context->Input<Tensor>(1);
+
+  const auto& data_shape = data->Shape();
+  const auto& indices_shape = indices->Shape();
+  if (data_shape.NumDimensions() < 1 || indices_shape.NumDimensions() < 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "EmbeddingBag: data and indices need to have rank larger than zero");
+  }
+
+  std::vector<int64_t> output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end() - 1);
+  if (keepdims_) {
+    output_dims.push_back(1);
+  }
+  output_dims.insert(output_dims.end(), data_shape.GetDims().begin() + 1, data_shape.GetDims().end());
+  auto* output = context->Output(0, TensorShape(output_dims));
+
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(*data, *indices, *output, thread_pool);
+  }
+  return ComputeImpl<int64_t>(*data, *indices, *output, thread_pool);
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(),
+                                 DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,360 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// limits of the program, the same as those of the CUDA kernel
+constexpr size_t kMaxInputs = 8;
+constexpr size_t kMaxOps = 16;
+
+// the number of elements evaluated at a time. the values of a block stay in the L1 cache for the whole program.
+constexpr int64_t kBlockSize = 128;
+
+// the number of plans kept before the cache is cleared, for inputs whose shapes keep changing
+constexpr size_t kMaxCachedPlans = 64;
+
+enum class ElementwiseOp : uint8_t {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Abs,
+  Erf,
+  Exp,
+  Log,
+  Neg,
+  Reciprocal,
+  Relu,
+  Sigmoid,
+  Sqrt,
+  Tanh,
+};
+
+const std::unordered_map<std::string, std::pair<ElementwiseOp, bool>>& ElementwiseOps() {
+  // op type -> op, is binary
+  static const std::unordered_map<std::string, std::pair<ElementwiseOp, bool>> ops = {
+      {"Add", {ElementwiseOp::Add, true}},
+      {"Sub", {ElementwiseOp::Sub, true}},
+      {"Mul", {ElementwiseOp::Mul, true}},
+      {"Div", {ElementwiseOp::Div, true}},
+      {"Abs", {ElementwiseOp::Abs, false}},
+      {"Erf", {ElementwiseOp::Erf, false}},
+      {"Exp", {ElementwiseOp::Exp, false}},
+      {"Log", {ElementwiseOp::Log, false}},
+      {"Neg", {ElementwiseOp::Neg, false}},
+      {"Reciprocal", {ElementwiseOp::Reciprocal, false}},
+      {"Relu", {ElementwiseOp::Relu, false}},
+      {"Sigmoid", {ElementwiseOp::Sigmoid, false}},
+      {"Sqrt", {ElementwiseOp::Sqrt, false}},
+      {"Tanh", {ElementwiseOp::Tanh, false}},
+  };
+  return ops;
+}
+
+void ComputeOp(ElementwiseOp op, const float* a, const float* b, float* y, ptrdiff_t n) {
+  ConstEigenVectorArrayMap<float> a_array(a, n);
+  ConstEigenVectorArrayMap<float> b_array(b, n);
+  EigenVectorArrayMap<float> y_array(y, n);
+
+  switch (op) {
+    case ElementwiseOp::Add:
+      y_array = a_array + b_array;
+      break;
+    case ElementwiseOp::Sub:
+      y_array = a_array - b_array;
+      break;
+    case ElementwiseOp::Mul:
+      y_array = a_array * b_array;
+      break;
+    case ElementwiseOp::Div:
+      y_array = a_array / b_array;
+      break;
+    case ElementwiseOp::Abs:
+      y_array = a_array.abs();
+      break;
+    case ElementwiseOp::Erf:
+      MlasComputeErf(a, y, static_cast<size_t>(n));
+      break;
+    case ElementwiseOp::Exp:
+      MlasComputeExp(a, y, static_cast<size_t>(n));
+      break;
+    case ElementwiseOp::Log:
+      y_array = a_array.log();
+      break;
+    case ElementwiseOp::Neg:
+      y_array = -a_array;
+      break;
+    case ElementwiseOp::Reciprocal:
+      y_array = a_array.inverse();
+      break;
+    case ElementwiseOp::Relu:
+      y_array = a_array.cwiseMax(0.0f);
+      break;
+    case ElementwiseOp::Sigmoid:
+      MlasComputeLogistic(a, y, static_cast<size_t>(n));
+      break;
+    case ElementwiseOp::Sqrt:
+      y_array = a_array.sqrt();
+      break;
+    case ElementwiseOp::Tanh:
+      MlasComputeTanh(a, y, static_cast<size_t>(n));
+      break;
+  }
+}
+
+}  // namespace
+
+// Evaluates the program of a FusedElementwise node, see the schema of the op. The output is computed in blocks of
+// kBlockSize elements: every op of the program runs over the block before the next block is started, so that the
+// intermediate values are never written to memory. The broadcasting of the inputs is planned once for each
+// combination of input shapes.
+class FusedElementwise final : public OpKernel {
+ public:
+  FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // The output is a sequence of runs of inner_size elements, in which each input is either contiguous or a single
+  // broadcast value. The offset of the run of an input is computed from the coordinates of the run in the outer dims.
+  struct BroadcastPlan {
+    TensorShape output_shape;
+    int64_t inner_size;
+    std::vector<int64_t> outer_dims;
+    // for each input, the stride of each outer dim
+    std::vector<std::vector<int64_t>> outer_strides;
+    // for each input, whether it is contiguous in the runs
+    std::vector<bool> is_contiguous;
+  };
+
+  Status GetBroadcastPlan(const std::vector<TensorShape>& input_shapes, BroadcastPlan& plan) const;
+
+  size_t num_inputs_;
+  std::vector<ElementwiseOp> ops_;
+  std::vector<size_t> operands_;
+
+  // plans by the dims of the inputs, each followed by the rank
+  mutable std::mutex plans_mutex_;
+  mutable std::map<std::vector<int64_t>, BroadcastPlan> plans_;
+};
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs("ops", ops).IsOK());
+  ORT_ENFORCE(info.GetAttrs("operands", operands).IsOK());
+
+  num_inputs_ = info.GetInputCount();
+  ORT_ENFORCE(num_inputs_ >= 1 && num_inputs_ <= kMaxInputs,
+              "FusedElementwise supports 1 to ", kMaxInputs, " inputs. Got ", num_inputs_);
+  ORT_ENFORCE(ops.size() >= 1 && ops.size() <= kMaxOps,
+              "FusedElementwise supports 1 to ", kMaxOps, " ops. Got ", ops.size());
+  ORT_ENFORCE(operands.size() == 2 * ops.size(), "FusedElementwise needs two operands for each op.");
+
+  for (size_t i = 0; i < ops.size(); ++i) {
+    const auto op = ElementwiseOps().find(ops[i]);
+    ORT_ENFORCE(op != ElementwiseOps().end(), "FusedElementwise does not support op ", ops[i]);
+    ops_.push_back(op->second.first);
+
+    // the operators can only read the inputs and the results of the previous operators
+    for (size_t j = 0; j < 2; ++j) {
+      int64_t operand = operands[2 * i + j];
+      if (j == 1 && !op->second.second) {
+        operand = operands[2 * i];
+      }
+      ORT_ENFORCE(operand >= 0 && static_cast<size_t>(operand) < num_inputs_ + i, "Invalid operand ", operand,
+                  " of op ", i);
+      operands_.push_back(static_cast<size_t>(operand));
+    }
+  }
+}
+
+Status FusedElementwise::GetBroadcastPlan(const std::vector<TensorShape>& input_shapes, BroadcastPlan& plan) const {
+  std::vector<int64_t> signature;
+  for (const auto& shape : input_shapes) {
+    signature.insert(signature.end(), shape.GetDims().begin(), shape.GetDims().end());
+    signature.push_back(static_cast<int64_t>(shape.NumDimensions()));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(plans_mutex_);
+    auto it = plans_.find(signature);
+    if (it != plans_.end()) {
+      plan = it->second;
+      return Status::OK();
+    }
+  }
+
+  size_t output_rank = 0;
+  for (const auto& shape : input_shapes) {
+    output_rank = std::max(output_rank, shape.NumDimensions());
+  }
+
+  // the dims of the inputs aligned with the output dims
+  std::vector<std::vector<int64_t>> padded_dims(input_shapes.size(), std::vector<int64_t>(output_rank, 1));
+  std::vector<int64_t> output_dims(output_rank, 1);
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    const auto& dims = input_shapes[i].GetDims();
+    std::copy(dims.begin(), dims.end(), padded_dims[i].begin() + (output_rank - dims.size()));
+    for (size_t d = 0; d < output_rank; ++d) {
+      const int64_t dim = padded_dims[i][d];
+      if (dim != 1 && output_dims[d] != 1 && dim != output_dims[d]) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, Node().Name(), ": input ", i, " with shape ",
+                               input_shapes[i], " can not be broadcast with the other inputs.");
+      }
+      if (dim != 1) {
+        output_dims[d] = dim;
+      }
+    }
+  }
+
+  // the runs are the longest suffix of the output dims in which no input changes between contiguous and broadcast
+  std::vector<bool> is_contiguous(input_shapes.size());
+  std::vector<bool> is_known(input_shapes.size(), false);
+  size_t split = output_rank;
+  while (split > 0) {
+    const size_t d = split - 1;
+    bool same_kinds = true;
+    if (output_dims[d] != 1) {
+      for (size_t i = 0; i < input_shapes.size(); ++i) {
+        const bool contiguous = padded_dims[i][d] != 1;
+        same_kinds = same_kinds && (!is_known[i] || is_contiguous[i] == contiguous);
+      }
+    }
+    if (!same_kinds) {
+      break;
+    }
+    if (output_dims[d] != 1) {
+      for (size_t i = 0; i < input_shapes.size(); ++i) {
+        is_contiguous[i] = padded_dims[i][d] != 1;
+        is_known[i] = true;
+      }
+    }
+    --split;
+  }
+
+  plan.output_shape = TensorShape(output_dims);
+  plan.inner_size = 1;
+  for (size_t d = split; d < output_rank; ++d) {
+    plan.inner_size *= output_dims[d];
+  }
+  plan.outer_dims.assign(output_dims.begin(), output_dims.begin() + split);
+  plan.outer_strides.assign(input_shapes.size(), std::vector<int64_t>(split, 0));
+  plan.is_contiguous.assign(input_shapes.size(), false);
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    plan.is_contiguous[i] = is_known[i] && is_contiguous[i];
+    int64_t stride = plan.is_contiguous[i] ? plan.inner_size : 1;
+    for (size_t d = split; d-- > 0;) {
+      plan.outer_strides[i][d] = padded_dims[i][d] == 1 ? 0 : stride;
+      stride *= padded_dims[i][d];
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(plans_mutex_);
+  if (plans_.size() >= kMaxCachedPlans) {
+    plans_.clear();
+  }
+  plans_.emplace(std::move(signature), plan);
+  return Status::OK();
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  std::vector<const float*> inputs(num_inputs_);
+  std::vector<TensorShape> input_shapes;
+  input_shapes.reserve(num_inputs_);
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    const Tensor* input = context->Input<Tensor>(static_cast<int>(i));
+    inputs[i] = input->Data<float>();
+    input_shapes.push_back(input->Shape());
+  }
+
+  BroadcastPlan plan;
+  ORT_RETURN_IF_ERROR(GetBroadcastPlan(input_shapes, plan));
+
+  Tensor* output = context->Output(0, plan.output_shape);
+  const int64_t output_size = plan.output_shape.Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+  float* output_data = output->MutableData<float>();
+
+  const int64_t blocks_per_run = (plan.inner_size + kBlockSize - 1) / kBlockSize;
+  const int64_t num_blocks = (output_size / plan.inner_size) * blocks_per_run;
+  const size_t num_values = num_inputs_ + ops_.size();
+
+  const double block_elements = static_cast<double>(std::min(kBlockSize, plan.inner_size));
+  const TensorOpCost cost{block_elements * num_inputs_ * sizeof(float), block_elements * sizeof(float),
+                          block_elements * ops_.size() * 4};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_blocks), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // the broadcast inputs and the results of the ops, except the last one which is written to the output
+        std::vector<float> buffers(num_values * kBlockSize);
+        std::vector<const float*> values(num_values);
+        for (size_t i = num_inputs_; i < num_values; ++i) {
+          values[i] = buffers.data() + i * kBlockSize;
+        }
+        std::vector<int64_t> offsets(num_inputs_);
+
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int64_t run = block / blocks_per_run;
+          const int64_t start = (block % blocks_per_run) * kBlockSize;
+          const int64_t count = std::min(kBlockSize, plan.inner_size - start);
+
+          std::fill(offsets.begin(), offsets.end(), 0);
+          int64_t remainder = run;
+          for (size_t d = plan.outer_dims.size(); d-- > 0;) {
+            const int64_t coordinate = remainder % plan.outer_dims[d];
+            remainder /= plan.outer_dims[d];
+            for (size_t i = 0; i < num_inputs_; ++i) {
+              offsets[i] += coordinate * plan.outer_strides[i][d];
+            }
+          }
+
+          for (size_t i = 0; i < num_inputs_; ++i) {
+            if (plan.is_contiguous[i]) {
+              values[i] = inputs[i] + offsets[i] + start;
+            } else {
+              float* buffer = buffers.data() + i * kBlockSize;
+              std::fill_n(buffer, count, inputs[i][offsets[i]]);
+              values[i] = buffer;
+            }
+          }
+
+          float* y = output_data + run * plan.inner_size + start;
+          for (size_t op = 0; op < ops_.size(); ++op) {
+            float* result = op + 1 == ops_.size() ? y : buffers.data() + (num_inputs_ + op) * kBlockSize;
+            ComputeOp(ops_[op], values[operands_[2 * op]], values[operands_[2 * op + 1]], result, count);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+}  // namespace contrib
+}  // namespace onnxruntime
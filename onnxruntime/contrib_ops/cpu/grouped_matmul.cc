@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Computes Y_i = A * B_i for all the B_i inputs with a single grouped MLAS call.
+template <typename T>
+class GroupedMatMul final : public OpKernel {
+ public:
+  GroupedMatMul(const OpKernelInfo& info) : OpKernel(info) {
+    const size_t num_b = info.GetInputCount() - 1;
+    packed_b_.resize(num_b);
+    b_shapes_.resize(num_b);
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+
+  Status TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  std::vector<TensorShape> b_shapes_;
+  std::vector<BufferUniquePtr> packed_b_;
+};
+
+template <typename T>
+Status GroupedMatMul<T>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  is_packed = false;
+
+  if (input_idx >= 1) {
+    const size_t b_idx = static_cast<size_t>(input_idx) - 1;
+    is_packed = GemmPackBFp32(Info(), tensor, false, packed_b_[b_idx], b_shapes_[b_idx]);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status GroupedMatMul<T>::TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) {
+  if (input_idx >= 1 && packed_b_[input_idx - 1]) {
+    prepacked_buffers.push_back(std::move(packed_b_[input_idx - 1]));
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status GroupedMatMul<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                                   bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx >= 1) {
+    used_shared_buffers = true;
+    packed_b_[input_idx - 1] = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status GroupedMatMul<T>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const auto* a_data = a->Data<float>();
+
+  const size_t num_b = packed_b_.size();
+  std::vector<MLAS_SGEMM_GROUPED_PROBLEM> problems;
+  problems.reserve(num_b);
+
+  for (size_t i = 0; i < num_b; i++) {
+    const bool is_packed = bool(packed_b_[i]);
+    const Tensor* b = is_packed ? nullptr : ctx->Input<Tensor>(static_cast<int>(i) + 1);
+    const auto& b_shape = b ? b->Shape() : b_shapes_[i];
+    ORT_RETURN_IF_NOT(b_shape.NumDimensions() == 2, "GroupedMatMul: input B must be 2-dimensional");
+
+    MatMulComputeHelper helper;
+    ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+    Tensor* y = ctx->Output(static_cast<int>(i), helper.OutputShape());
+
+    if (y->Shape().Size() == 0) {
+      continue;
+    }
+
+    MLAS_SGEMM_GROUPED_PROBLEM problem;
+    problem.TransA = CblasNoTrans;
+    problem.TransB = CblasNoTrans;
+    problem.M = static_cast<size_t>(helper.M());
+    problem.N = static_cast<size_t>(helper.N());
+    problem.K = static_cast<size_t>(helper.K());
+    problem.Data.BIsPacked = is_packed;
+    problem.Data.A = a_data;
+    problem.Data.lda = problem.K;
+    problem.Data.B = is_packed ? static_cast<const float*>(packed_b_[i].get()) : b->Data<float>();
+    problem.Data.ldb = problem.N;
+    problem.Data.C = y->MutableData<float>();
+    problem.Data.ldc = problem.N;
+    problems.push_back(problem);
+  }
+
+  MlasGemmGrouped(problems.data(), problems.size(), thread_pool);
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    GroupedMatMul,
+    1,
+    float,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    GroupedMatMul<float>);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -34,6 +35,67 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+
+template <bool simplified>
+void ComputeRow(const double* input, const double* scale, const double* bias, double* output, int64_t norm_size,
+                float epsilon, double& mean, double& inv_std_dev, std::vector<float>& /*buffer*/) {
+  double mean_square = 0;
+  mean = 0;
+  for (int64_t h = 0; h < norm_size; h++) {
+    mean += input[h];
+    mean_square += input[h] * input[h];
+  }
+
+  mean = mean / norm_size;
+  if (simplified) {
+    mean_square = sqrt(mean_square / norm_size + epsilon);
+  } else {
+    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
+  }
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    if (simplified) {
+      output[h] = input[h] / mean_square * scale[h];
+    } else if (nullptr == bias) {
+      output[h] = (input[h] - mean) / mean_square * scale[h];
+    } else {
+      output[h] = (input[h] - mean) / mean_square * scale[h] + bias[h];
+    }
+  }
+
+  inv_std_dev = 1 / mean_square;
+}
+
+// The moments come from a single vectorized pass over the row.
+template <bool simplified>
+void ComputeRow(const float* input, const float* scale, const float* bias, float* output, int64_t norm_size,
+                float epsilon, float& mean, float& inv_std_dev, std::vector<float>& /*buffer*/) {
+  float variance;
+  MlasComputeMeanVariance(input, static_cast<size_t>(norm_size), &mean, &variance);
+
+  if (simplified) {
+    // the root mean square is the variance plus the square of the mean
+    inv_std_dev = 1.0f / std::sqrt(variance + mean * mean + epsilon);
+    MlasComputeNormalization(input, output, static_cast<size_t>(norm_size), 0.0f, inv_std_dev, scale, nullptr);
+  } else {
+    inv_std_dev = 1.0f / std::sqrt(variance + epsilon);
+    MlasComputeNormalization(input, output, static_cast<size_t>(norm_size), mean, inv_std_dev, scale, bias);
+  }
+}
+
+template <bool simplified>
+void ComputeRow(const MLFloat16* input, const float* scale, const float* bias, MLFloat16* output, int64_t norm_size,
+                float epsilon, float& mean, float& inv_std_dev, std::vector<float>& buffer) {
+  buffer.resize(static_cast<size_t>(norm_size));
+  MlasConvertHalfToFloat(&input->val, buffer.data(), buffer.size());
+  ComputeRow<simplified>(buffer.data(), scale, bias, buffer.data(), norm_size, epsilon, mean, inv_std_dev, buffer);
+  MlasConvertFloatToHalf(buffer.data(), &output->val, buffer.size());
+}
+
+}  // namespace
 
 template <typename T, bool simplified>
 LayerNorm<T, simplified>::LayerNorm(const OpKernelInfo& op_kernel_info)
@@ -48,9 +110,13 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   const Tensor* X = p_ctx->Input<Tensor>(0);
   const Tensor* scale = p_ctx->Input<Tensor>(1);
   const Tensor* bias = p_ctx->Input<Tensor>(2);
+  using U = typename LayerNormComputeType<T>::type;
   auto X_data = X->template Data<T>();
-  auto scale_data = scale->template Data<T>();
-  auto bias_data = (simplified || nullptr == bias) ? nullptr : bias->template Data<T>();
+
+  std::vector<float> scale_buffer;
+  std::vector<float> bias_buffer;
+  const U* scale_data = LayerNormParameterData<T>(scale, scale_buffer);
+  const U* bias_data = simplified ? nullptr : LayerNormParameterData<T>(bias, bias_buffer);
 
   const TensorShape& x_shape = X->Shape();
   const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
@@ -73,7 +139,7 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
 
-  T* mean_data = nullptr;
+  U* mean_data = nullptr;
   BufferUniquePtr mean_data_buf_ptr;
 
   int output_index = 1;
@@ -81,61 +147,41 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   if (!simplified) {
     Tensor* mean = p_ctx->Output(output_index++, TensorShape(mean_inv_std_dev_dim));
     if (mean != nullptr) {
-      mean_data = mean->template MutableData<T>();
+      mean_data = mean->template MutableData<U>();
     } else {
-      auto mean_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(T)) * norm_count);
+      auto mean_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(U)) * norm_count);
       mean_data_buf_ptr = BufferUniquePtr(mean_data_buf, BufferDeleter(alloc));
-      mean_data = static_cast<T*>(mean_data_buf_ptr.get());
+      mean_data = static_cast<U*>(mean_data_buf_ptr.get());
     }
   }
 
-  T* inv_std_dev_data = nullptr;
+  U* inv_std_dev_data = nullptr;
   BufferUniquePtr inv_std_dev_data_buf_ptr;
 
   Tensor* inv_std_dev = p_ctx->Output(output_index, TensorShape(mean_inv_std_dev_dim));
   if (inv_std_dev != nullptr) {
-    inv_std_dev_data = inv_std_dev->template MutableData<T>();
+    inv_std_dev_data = inv_std_dev->template MutableData<U>();
   } else {
-    auto inv_std_dev_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(T)) * norm_count);
+    auto inv_std_dev_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(U)) * norm_count);
     inv_std_dev_data_buf_ptr = BufferUniquePtr(inv_std_dev_data_buf, BufferDeleter(alloc));
-    inv_std_dev_data = static_cast<T*>(inv_std_dev_data_buf_ptr.get());
+    inv_std_dev_data = static_cast<U*>(inv_std_dev_data_buf_ptr.get());
   }
 
-  concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
-                                               [&](ptrdiff_t task_idx) {
-                                                 const T* p_input = X_data + task_idx * norm_size;
-                                                 T* p_output = Y_data + task_idx * norm_size;
-
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   mean += p_input[h];
-                                                   mean_square += p_input[h] * p_input[h];
-                                                 }
-
-                                                 mean = mean / norm_size;
-                                                 if (simplified) {
-                                                   mean_square = sqrt(mean_square / norm_size + epsilon_);
-                                                 } else {
-                                                   mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
-                                                 }
-
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   if (simplified) {
-                                                     p_output[h] = p_input[h] / mean_square * scale_data[h];
-                                                   } else if (nullptr == bias){
-                                                     p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
-                                                   } else {
-                                                     p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
-                                                   }
-                                                 }
-
-                                                 if (mean_data != nullptr) {
-                                                   mean_data[task_idx] = mean;
-                                                 }
-                                                 inv_std_dev_data[task_idx] = 1 / mean_square;
-                                               }, 0);
+  const double bytes = static_cast<double>(norm_size * sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(
+      p_ctx->GetOperatorThreadPool(), norm_count,
+      TensorOpCost{bytes, bytes, static_cast<double>(norm_size) * 4},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> buffer;
+        for (std::ptrdiff_t task_idx = first; task_idx < last; ++task_idx) {
+          U mean;
+          ComputeRow<simplified>(X_data + task_idx * norm_size, scale_data, bias_data, Y_data + task_idx * norm_size,
+                                 norm_size, epsilon_, mean, inv_std_dev_data[task_idx], buffer);
+          if (mean_data != nullptr) {
+            mean_data[task_idx] = mean;
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -6,10 +6,40 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+// The moments and the scale and bias of the layer normalization kernels are computed in float for float16 inputs,
+// and in the input type otherwise.
+template <typename T>
+struct LayerNormComputeType {
+  using type = T;
+};
+
+template <>
+struct LayerNormComputeType<MLFloat16> {
+  using type = float;
+};
+
+// Get the data of an optional scale or bias input as LayerNormComputeType<T>, converting it into buffer if needed.
+template <typename T>
+const typename LayerNormComputeType<T>::type* LayerNormParameterData(const Tensor* tensor,
+                                                                     std::vector<float>& /*buffer*/) {
+  return tensor == nullptr ? nullptr : tensor->template Data<T>();
+}
+
+template <>
+inline const float* LayerNormParameterData<MLFloat16>(const Tensor* tensor, std::vector<float>& buffer) {
+  if (tensor == nullptr) {
+    return nullptr;
+  }
+  buffer.resize(static_cast<size_t>(tensor->Shape().Size()));
+  MlasConvertHalfToFloat(&tensor->template Data<MLFloat16>()->val, buffer.data(), buffer.size());
+  return buffer.data();
+}
+
 template <typename T, bool simplified>
 class LayerNorm final : public OpKernel {
  public:
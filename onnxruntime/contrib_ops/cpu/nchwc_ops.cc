@@ -265,14 +265,74 @@ Status NchwcUpsample::Compute(OpKernelContext* context) const {
   TensorShape Y_shape{X_shape[0], X_shape[1], X_shape[2] * scales_[2], X_shape[3] * scales_[3]};
   auto* Y = context->Output(0, Y_shape);
 
-  MlasNchwcUpsample(X_shape.GetDims().data(),
-                    scales_.data() + 2,
-                    X->template Data<float>(),
-                    Y->template MutableData<float>());
+  if (nearest_mode_) {
+    MlasNchwcUpsample(X_shape.GetDims().data(),
+                      scales_.data() + 2,
+                      X->template Data<float>(),
+                      Y->template MutableData<float>());
+    return Status::OK();
+  }
+
+  const int64_t input_h = X_shape[2];
+  const int64_t input_w = X_shape[3];
+  const int64_t output_h = Y_shape[2];
+  const int64_t output_w = Y_shape[3];
+
+  const auto interpolation_h = ComputeInterpolation(input_h, output_h, scales_[2]);
+  const auto interpolation_w = ComputeInterpolation(input_w, output_w, scales_[3]);
+
+  const int64_t nchwc_block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const int64_t channel_blocks = X_shape[0] * (X_shape[1] / nchwc_block_size);
+  const auto* x_data = X->template Data<float>();
+  auto* y_data = Y->template MutableData<float>();
+
+  // Every output row of every channel block is computed independently.
+  const double row_elements = static_cast<double>(output_w * nchwc_block_size);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(channel_blocks * output_h),
+      TensorOpCost{row_elements * 2 * sizeof(float), row_elements * sizeof(float), row_elements * 8},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; row++) {
+          const int64_t channel_block = row / output_h;
+          const int64_t y = row % output_h;
+          MlasNchwcUpsampleLinear(static_cast<size_t>(input_h),
+                                  static_cast<size_t>(input_w),
+                                  static_cast<size_t>(output_w),
+                                  interpolation_h[y],
+                                  interpolation_w.data(),
+                                  x_data + channel_block * input_h * input_w * nchwc_block_size,
+                                  y_data + row * output_w * nchwc_block_size);
+        }
+      });
 
   return Status::OK();
 }
 
+std::vector<float> NchwcUpsample::ComputeInterpolation(int64_t input_length,
+                                                       int64_t output_length,
+                                                       int64_t scale) const {
+  std::vector<float> interpolation(output_length);
+
+  if (transformation_mode_ == "align_corners") {
+    const float ratio = output_length > 1 ? static_cast<float>(input_length - 1) / (output_length - 1) : 0.0f;
+    for (int64_t o = 0; o < output_length; o++) {
+      interpolation[o] = o * ratio;
+    }
+  } else if (transformation_mode_ == "half_pixel" ||
+             (transformation_mode_ == "pytorch_half_pixel" && output_length > 1)) {
+    for (int64_t o = 0; o < output_length; o++) {
+      interpolation[o] = (o + 0.5f) / scale - 0.5f;
+    }
+  } else if (transformation_mode_ == "asymmetric") {
+    for (int64_t o = 0; o < output_length; o++) {
+      interpolation[o] = static_cast<float>(o) / scale;
+    }
+  }
+  // pytorch_half_pixel maps a single output index to the input coordinate 0.
+
+  return interpolation;
+}
+
 #define ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(name, ver, type, builder, ...) \
   ONNX_OPERATOR_TYPED_KERNEL_EX(name, kMSNchwcDomain, ver, type, kCpuExecutionProvider, builder, __VA_ARGS__)
 
@@ -87,12 +87,25 @@ class NchwcUpsample : public OpKernel {
     ORT_ENFORCE(scales_.size() == 4);
     // Batch and channel dimensions cannot scale and spatial scaling must be positive.
     ORT_ENFORCE(scales_[0] == 1 && scales_[1] == 1 && scales_[2] >= 1 && scales_[3] >= 1);
+    const std::string mode = info.GetAttrOrDefault<std::string>("mode", "nearest");
+    ORT_ENFORCE(mode == "nearest" || mode == "linear");
+    nearest_mode_ = mode == "nearest";
+    transformation_mode_ = info.GetAttrOrDefault<std::string>("coordinate_transformation_mode", "asymmetric");
+    // The nearest mode only implements the asymmetric transformation of the coordinates.
+    ORT_ENFORCE(!nearest_mode_ || transformation_mode_ == "asymmetric");
+    ORT_ENFORCE(transformation_mode_ == "asymmetric" || transformation_mode_ == "align_corners" ||
+                transformation_mode_ == "half_pixel" || transformation_mode_ == "pytorch_half_pixel");
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  // Returns the input coordinate of each output index along an axis.
+  std::vector<float> ComputeInterpolation(int64_t input_length, int64_t output_length, int64_t scale) const;
+
   std::vector<int64_t> scales_;
+  bool nearest_mode_;
+  std::string transformation_mode_;
 };
 
 }  // namespace contrib
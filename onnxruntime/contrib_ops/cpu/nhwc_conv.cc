@@ -0,0 +1,434 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Float convolution consuming and producing channels last (NHWC) tensors. Every
+// output pixel is a row of the output matrix, so the convolution is a GEMM of the
+// NHWC im2col buffer (or the input itself for pointwise convolutions) with the
+// filter reordered to HWIO.
+class NhwcConv final : public OpKernel {
+ public:
+  explicit NhwcConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+
+ private:
+  static void ReorderFilter(const float* input,
+                            float* output,
+                            size_t output_channels,
+                            size_t input_channels,
+                            size_t kernel_size) {
+    for (size_t k = 0; k < kernel_size; k++) {
+      for (size_t ic = 0; ic < input_channels; ic++) {
+        for (size_t oc = 0; oc < output_channels; oc++) {
+          size_t index = (oc * input_channels * kernel_size) + (ic * kernel_size) + k;
+          *output++ = input[index];
+        }
+      }
+    }
+  }
+
+  MLAS_ACTIVATION activation_;
+  ConvAttributes conv_attrs_;
+  TensorShape W_shape_;
+  BufferUniquePtr packed_W_buffer_;
+  size_t packed_W_size_{0};
+  BufferUniquePtr reordered_W_buffer_;
+  bool is_W_packed_{false};
+};
+
+Status NhwcConv::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  is_packed = false;
+
+  // Support packing the weight matrix.
+  if (input_idx != 1) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape().GetDims();
+  size_t rank = shape.size();
+  if (rank <= 2) {
+    return Status::OK();
+  }
+
+  if (shape[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  // Note: The tensor has already been allocated with this tensor shape, so all
+  // shape indices are guaranteed to fit inside size_t.
+  const size_t output_channels = static_cast<size_t>(shape[0]);
+  const size_t group_input_channels = static_cast<size_t>(shape[1]);
+  const size_t kernel_size =
+      static_cast<size_t>(std::accumulate(shape.data() + 2, shape.data() + rank, 1LL, std::multiplies<int64_t>()));
+
+  const auto* Wdata = tensor.Data<float>();
+  W_shape_ = shape;
+
+  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t group_output_channels = output_channels / group_count;
+  const size_t kernel_dim = group_input_channels * kernel_size;
+
+  // Don't pack the filter buffer if the MlasConvDepthwise path is used.
+  if (group_input_channels != 1 || group_output_channels != 1) {
+    packed_W_size_ = MlasGemmPackBSize(group_output_channels, kernel_dim);
+
+    if (packed_W_size_ != 0) {
+      auto* packed_W = static_cast<uint8_t*>(alloc->Alloc(SafeInt<size_t>(group_count) * packed_W_size_));
+      packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(alloc));
+
+      // Allocate a temporary buffer to hold the reordered oihw->hwio filter for
+      // a single group.
+      auto* group_reordered_W = static_cast<float*>(
+          alloc->Alloc(SafeInt<size_t>(sizeof(float)) * group_output_channels * kernel_dim));
+      BufferUniquePtr group_reordered_W_buffer(group_reordered_W, BufferDeleter(alloc));
+
+      const size_t W_offset = group_output_channels * kernel_dim;
+
+      for (size_t group_id = 0; group_id < group_count; ++group_id) {
+        ReorderFilter(Wdata, group_reordered_W, group_output_channels, group_input_channels, kernel_size);
+        MlasGemmPackB(CblasNoTrans, group_output_channels, kernel_dim, group_reordered_W, group_output_channels,
+                      packed_W);
+        packed_W += packed_W_size_;
+        Wdata += W_offset;
+      }
+
+      is_W_packed_ = true;
+      is_packed = true;
+      return Status::OK();
+    }
+  }
+
+  auto* reordered_W = static_cast<float*>(
+      alloc->Alloc(SafeInt<size_t>(sizeof(float)) * output_channels * group_input_channels * kernel_size));
+  reordered_W_buffer_ = BufferUniquePtr(reordered_W, BufferDeleter(alloc));
+
+  ReorderFilter(Wdata, reordered_W, output_channels, group_input_channels, kernel_size);
+
+  is_W_packed_ = true;
+  is_packed = true;
+  return Status::OK();
+}
+
+Status NhwcConv::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = is_W_packed_ ? nullptr : context->Input<Tensor>(1);
+  const Tensor* B = context->Input<Tensor>(2);
+  const auto& W_shape = W ? W->Shape() : W_shape_;
+
+  const int64_t N = X->Shape()[0];
+  const int64_t M = W_shape[0];
+
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape, true));
+
+  std::vector<int64_t> kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+
+  const size_t kernel_rank = kernel_shape.size();
+
+  std::vector<int64_t> pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  std::vector<int64_t> dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  std::vector<int64_t> strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const int64_t C = X->Shape()[1 + kernel_rank];
+
+  std::vector<int64_t> Y_dims({N});
+  TensorShape input_shape = X->Shape().Slice(1, 1 + kernel_rank);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(1, 1 + kernel_rank);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // Handle the case of a dynamic weight filter.
+  BufferUniquePtr reordered_W_buffer;
+  const float* reordered_W = nullptr;
+  if (!packed_W_buffer_) {
+    if (W == nullptr) {
+      // Weight was constant and reordered.
+      reordered_W = static_cast<const float*>(reordered_W_buffer_.get());
+    } else {
+      // Weight tensor was not constant or prepacking is disabled.
+      auto* reordered_W_data = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * W_shape.Size()));
+      reordered_W_buffer = BufferUniquePtr(reordered_W_data, BufferDeleter(alloc));
+      ReorderFilter(
+          W->Data<float>(),
+          reordered_W_data,
+          static_cast<size_t>(M),
+          static_cast<size_t>(W_shape[1]),
+          static_cast<size_t>(kernel_size));
+      reordered_W = reordered_W_data;
+    }
+  }
+
+  int64_t group_count = conv_attrs_.group;
+  int64_t group_input_channels = W_shape[1];
+  int64_t group_output_channels = M / group_count;
+
+  // Test for depthwise convolution.
+  const bool is_depthwise_conv = (reordered_W != nullptr && group_input_channels == 1 && group_output_channels == 1);
+  if (is_depthwise_conv) {
+    // Update the input and output channels to the number of groups in order to
+    // reuse as much of the below standard convolution path.
+    group_input_channels = group_count;
+    group_output_channels = group_count;
+    group_count = 1;
+  }
+
+  const int64_t X_offset = C * input_image_size;
+  const int64_t Y_offset = M * output_image_size;
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+  const int64_t col_buffer_size = kernel_dim * output_image_size;
+
+  const auto* Xdata = X->template Data<float>();
+  const auto* Bdata = B != nullptr ? B->template Data<float>() : nullptr;
+  auto* Ydata = Y->template MutableData<float>();
+
+  BufferUniquePtr col_buffer;
+  std::vector<float> padding_data;
+
+  if (is_depthwise_conv) {
+    // Allocate indirection buffer pointers and prepare a padding vector for
+    // the im2col transform.
+    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(const float*)) * kernel_size * output_image_size);
+    col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
+    padding_data.resize(static_cast<size_t>(C), 0.f);
+  } else if (kernel_size != 1 || !conv_attrs_.HasStridesOneAndNoPadding()) {
+    // Pointwise convolutions can use the original input tensor in place,
+    // otherwise a temporary buffer is required for the im2col transform.
+    int64_t group_col_buffer_size = (kernel_rank > 2) ? group_count * col_buffer_size : col_buffer_size;
+    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * group_col_buffer_size);
+    col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
+  }
+
+  // Give every thread at least this many multiply-adds, and at least one output pixel.
+  constexpr double thread_complexity = static_cast<double>(64 * 1024);
+
+  const double complexity = static_cast<double>(output_image_size) *
+                            static_cast<double>(M) *
+                            static_cast<double>(kernel_dim);
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+  int32_t thread_count = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+  if (complexity < thread_complexity * thread_count) {
+    thread_count = static_cast<int32_t>(complexity / thread_complexity) + 1;
+  }
+  if (thread_count > output_image_size) {
+    thread_count = static_cast<int32_t>(output_image_size);
+  }
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    const auto* input_data = Xdata;
+    auto* output_data = Ydata;
+
+    // Threaded implementation of ND convolution is not yet supported, so
+    // prepare all im2col transformations here.
+    if (!is_depthwise_conv && col_buffer && kernel_rank > 2) {
+      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+        math::Im2col<float, StorageOrder::NHWC>()(
+            input_data + group_id * group_input_channels,
+            group_input_channels,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<int64_t>(kernel_rank),
+            static_cast<float*>(col_buffer.get()) + group_id * col_buffer_size,
+            0.f);
+      }
+    }
+
+    auto conv_worker = [&](ptrdiff_t batch) {
+      auto work = concurrency::ThreadPool::PartitionWork(batch, thread_count, static_cast<ptrdiff_t>(output_image_size));
+      int64_t output_start = static_cast<int64_t>(work.start);
+      int64_t output_count = static_cast<int64_t>(work.end - work.start);
+
+      auto* worker_output = output_data + output_start * M;
+
+      if (is_depthwise_conv) {
+        auto* worker_col_buffer = static_cast<float const**>(col_buffer.get()) + output_start * kernel_size;
+        math::Im2col<float, StorageOrder::NHWC>()(
+            input_data,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<ptrdiff_t>(kernel_rank),
+            output_start,
+            output_count,
+            worker_col_buffer,
+            padding_data.data());
+        MlasConvDepthwise(
+            worker_col_buffer,
+            reordered_W,
+            Bdata,
+            worker_output,
+            static_cast<size_t>(M),
+            static_cast<size_t>(output_count),
+            static_cast<size_t>(kernel_size));
+      } else {
+        // Seed the output with the bias so that the GEMMs accumulate onto it.
+        float beta = 0.f;
+        if (Bdata != nullptr) {
+          for (int64_t i = 0; i < output_count; i++) {
+            std::copy_n(Bdata, M, worker_output + i * M);
+          }
+          beta = 1.f;
+        }
+
+        for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+          // Prepare the im2col transformation or use the input buffer directly for
+          // pointwise convolutions.
+          const float* worker_gemm_input;
+          int64_t lda = kernel_dim;
+          if (col_buffer) {
+            auto* worker_col_buffer = static_cast<float*>(col_buffer.get()) + output_start * kernel_dim;
+            if (kernel_rank == 2) {
+              math::Im2col<float, StorageOrder::NHWC>()(
+                  input_data + group_id * group_input_channels,
+                  group_input_channels,
+                  C,
+                  input_shape[0],
+                  input_shape[1],
+                  kernel_shape[0],
+                  kernel_shape[1],
+                  dilations[0],
+                  dilations[1],
+                  pads[0],
+                  pads[1],
+                  strides[0],
+                  strides[1],
+                  output_shape[1],
+                  output_start,
+                  output_count,
+                  worker_col_buffer,
+                  0.f);
+            } else if (kernel_rank == 1) {
+              math::Im2col<float, StorageOrder::NHWC>()(
+                  input_data + group_id * group_input_channels,
+                  group_input_channels,
+                  C,
+                  1,
+                  input_shape[0],
+                  1,
+                  kernel_shape[0],
+                  1,
+                  dilations[0],
+                  0,
+                  pads[0],
+                  1,
+                  strides[0],
+                  output_shape[0],
+                  output_start,
+                  output_count,
+                  worker_col_buffer,
+                  0.f);
+            } else {
+              // Use the im2col buffer prepared outside the thread, indexed by group.
+              worker_col_buffer += group_id * col_buffer_size;
+            }
+            worker_gemm_input = worker_col_buffer;
+          } else {
+            worker_gemm_input = input_data + output_start * C + group_id * group_input_channels;
+            lda = C;
+          }
+
+          if (packed_W_buffer_) {
+            MlasGemm(
+                CblasNoTrans,
+                static_cast<size_t>(output_count),
+                static_cast<size_t>(group_output_channels),
+                static_cast<size_t>(kernel_dim),
+                1.f,
+                worker_gemm_input,
+                static_cast<size_t>(lda),
+                static_cast<const uint8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_,
+                beta,
+                worker_output + group_id * group_output_channels,
+                static_cast<size_t>(M),
+                nullptr);
+          } else {
+            MlasGemm(
+                CblasNoTrans,
+                CblasNoTrans,
+                static_cast<size_t>(output_count),
+                static_cast<size_t>(group_output_channels),
+                static_cast<size_t>(kernel_dim),
+                1.f,
+                worker_gemm_input,
+                static_cast<size_t>(lda),
+                reordered_W + group_id * group_output_channels,
+                static_cast<size_t>(M),
+                beta,
+                worker_output + group_id * group_output_channels,
+                static_cast<size_t>(M),
+                nullptr);
+          }
+        }
+      }
+
+      MlasActivation(&activation_, worker_output, nullptr, static_cast<size_t>(output_count),
+                     static_cast<size_t>(M), static_cast<size_t>(M));
+    };
+
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, thread_count, conv_worker);
+
+    Xdata += X_offset;
+    Ydata += Y_offset;
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    NhwcConv,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcConv);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
+#include "core/common/safeint.h"
 #include "core/util/math.h"
 #include "core/mlas/inc/mlas.h"
 
@@ -33,6 +34,16 @@ inline uint8_t quantize_value<uint8_t>(float y, float y_scale, uint8_t y_zero_po
     return static_cast<uint8_t>(std::max(0.0f, std::min(std::nearbyintf(y / y_scale + y_zero_point), 255.0f)));
 }
 
+template <>
+inline float dequantize_value<int8_t>(int8_t x, float x_scale, int8_t x_zero_point) {
+    return x_scale * (static_cast<int>(x) - x_zero_point);
+}
+
+template <>
+inline int8_t quantize_value<int8_t>(float y, float y_scale, int8_t y_zero_point) {
+    return static_cast<int8_t>(std::max(-128.0f, std::min(std::nearbyintf(y / y_scale + y_zero_point), 127.0f)));
+}
+
 template <typename T8Bits, typename PoolType>
 struct QLinearPool1DTask final {
   const float* X_data;
@@ -218,7 +229,9 @@ struct QLinearPool3DTask final {
   }
 };
 
-Status QLinearAveragePool::Compute(OpKernelContext* context) const {
+template <typename T8Bits>
+Status QLinearAveragePool::ComputeImpl(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
   const auto tensor_x_scale = context->Input<Tensor>(1);
   const auto tensor_x_zero_point = context->Input<Tensor>(2);
   const auto tensor_y_scale = context->Input<Tensor>(3);
@@ -233,18 +246,18 @@ Status QLinearAveragePool::Compute(OpKernelContext* context) const {
   ORT_ENFORCE(tensor_y_zero_point == nullptr || IsScalarOr1ElementVector(tensor_y_zero_point),
               "input y_zero_point must be a scalar or 1D tensor of size 1 if given");
 
-  const auto* X = context->Input<Tensor>(0);
-  auto dtype = X->GetElementType();
-  if (dtype != ONNX_NAMESPACE::TensorProto_DataType_UINT8) {
-      ORT_THROW("Unsupported 'dtype' in QLinear Pooling:", dtype);
-  }
   const TensorShape& x_shape = X->Shape();
   const float x_scale = *(tensor_x_scale->Data<float>());
   const float y_scale = *(tensor_y_scale->Data<float>());
-  uint8_t x_zero_point = (tensor_x_zero_point ? *(tensor_x_zero_point->Data<uint8_t>()) : (uint8_t)0);
-  uint8_t y_zero_point = (tensor_y_zero_point ? *(tensor_y_zero_point->Data<uint8_t>()) : (uint8_t)0);
+  T8Bits x_zero_point = (tensor_x_zero_point ? *(tensor_x_zero_point->Data<T8Bits>()) : (T8Bits)0);
+  T8Bits y_zero_point = (tensor_y_zero_point ? *(tensor_y_zero_point->Data<T8Bits>()) : (T8Bits)0);
 
   ORT_RETURN_IF_NOT(x_shape.NumDimensions() >= 3, "Input dimension cannot be less than 3.");
+
+  if (channels_last_) {
+    return ComputeNhwc<T8Bits>(context, X->Data<T8Bits>(), x_shape, x_scale, x_zero_point, y_scale, y_zero_point);
+  }
+
   std::vector<int64_t> pads = pool_attrs_.pads;
   std::vector<int64_t> strides = pool_attrs_.strides;
   std::vector<int64_t> kernel_shape = pool_attrs_.kernel_shape;
@@ -252,8 +265,8 @@ Status QLinearAveragePool::Compute(OpKernelContext* context) const {
   std::vector<int64_t> output_dims = pool_attrs_.SetOutputSize(x_shape, x_shape[1], &pads);
   Tensor* Y = context->Output(0, output_dims);
 
-  const auto* X_data = X->Data<uint8_t>();
-  auto* Y_data = Y->MutableData<uint8_t>();
+  const auto* X_data = X->Data<T8Bits>();
+  auto* Y_data = Y->MutableData<T8Bits>();
 
   const int64_t channels = x_shape[1];
   const int64_t height = x_shape[2];
@@ -282,7 +295,7 @@ Status QLinearAveragePool::Compute(OpKernelContext* context) const {
   switch (kernel_shape.size()) {
     case 1:
     {
-      QLinearPool1DTask<uint8_t, onnxruntime::AveragePool> avg_pool_task_1d = {
+      QLinearPool1DTask<T8Bits, onnxruntime::AveragePool> avg_pool_task_1d = {
           x_data_fp32.data(), Y_data, y_scale, y_zero_point, x_step, y_step,
           pooled_height, strides[0], height, kernel_shape, pads, pool_context_, pool_attrs_};
       ThreadPool::TryParallelFor(tp, total_channels, avg_pool_task_1d.Cost(), avg_pool_task_1d);
@@ -291,7 +304,7 @@ Status QLinearAveragePool::Compute(OpKernelContext* context) const {
 
     case 2:
     {
-      QLinearPool2DTask<uint8_t, onnxruntime::AveragePool> avg_pool_task_2d = {
+      QLinearPool2DTask<T8Bits, onnxruntime::AveragePool> avg_pool_task_2d = {
           x_data_fp32.data(), Y_data, y_scale, y_zero_point, x_step, y_step,
           pooled_height, pooled_width, strides[0], strides[1], height, width, kernel_shape, pads, pool_context_, pool_attrs_};
       ThreadPool::TryParallelFor(tp, total_channels, avg_pool_task_2d.Cost(), avg_pool_task_2d);
@@ -300,7 +313,7 @@ Status QLinearAveragePool::Compute(OpKernelContext* context) const {
 
     case 3:
     {
-      QLinearPool3DTask<uint8_t, onnxruntime::AveragePool> avg_pool_task_3d = {
+      QLinearPool3DTask<T8Bits, onnxruntime::AveragePool> avg_pool_task_3d = {
           x_data_fp32.data(), Y_data, y_scale, y_zero_point, x_step, y_step,
           pooled_height, pooled_width, pooled_depth, strides[0], strides[1], strides[2], height, width, depth,
           kernel_shape, pads, pool_context_, pool_attrs_};
@@ -320,6 +333,127 @@ Status QLinearAveragePool::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+template <typename T8Bits>
+Status QLinearAveragePool::ComputeNhwc(OpKernelContext* context, const T8Bits* X_data, const TensorShape& x_shape,
+                                       float x_scale, T8Bits x_zero_point,
+                                       float y_scale, T8Bits y_zero_point) const {
+  const size_t input_rank = x_shape.NumDimensions();
+  const int64_t N = x_shape[0];
+  const int64_t C = x_shape[input_rank - 1];
+  const size_t spatial_dims = input_rank - 2;
+  ORT_RETURN_IF_NOT(pool_attrs_.kernel_shape.size() == spatial_dims,
+                    "kernel_shape must have the same number of spatial dimensions as the input.");
+
+  // Compute the output size and effective padding for this pooling operation.
+  std::vector<int64_t> output_dims({N});
+  std::vector<int64_t> pads = pool_attrs_.pads;
+  int64_t kernel_size = 1;
+  int64_t input_image_size = 1;
+  int64_t output_image_size = 1;
+  for (size_t dim = 0; dim < spatial_dims; ++dim) {
+    int64_t kernel = pool_attrs_.kernel_shape[dim];
+    int64_t input_dim = x_shape[dim + 1];
+
+    kernel_size *= kernel;
+    input_image_size *= input_dim;
+
+    int64_t output_dim = 0;
+    pool_attrs_.ComputeSizePadDilations(input_dim,
+                                        pool_attrs_.strides[dim],
+                                        kernel,
+                                        &pads.at(dim),
+                                        &pads.at(spatial_dims + dim),
+                                        pool_attrs_.dilations[dim],
+                                        &output_dim);
+    output_dims.push_back(output_dim);
+
+    output_image_size *= output_dim;
+  }
+  output_dims.push_back(C);
+
+  Tensor* Y = context->Output(0, output_dims);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  constexpr int64_t output_batch_count = 512;
+
+  // Split each image into batches of output elements and distribute the
+  // batches across the thread pool, each with its own indirection buffer.
+  const int64_t batches_per_image = (output_image_size + output_batch_count - 1) / output_batch_count;
+  const int64_t total_batches = N * batches_per_image;
+  const int64_t col_buffer_batch_count = std::min(output_image_size, output_batch_count);
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // The padding vector holds the input zero point, so that padding elements
+  // contribute nothing to the sums when they are counted in the averages.
+  // Otherwise the kernel skips the elements that reference the padding vector.
+  std::vector<T8Bits> padding_data(static_cast<size_t>(C), x_zero_point);
+  const T8Bits* excluded_padding = pool_attrs_.count_include_pad ? nullptr : padding_data.data();
+
+  T8Bits* Y_data = Y->MutableData<T8Bits>();
+
+  auto worker = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(const T8Bits*)) * kernel_size * col_buffer_batch_count);
+    BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
+
+    for (std::ptrdiff_t batch = first; batch < last; ++batch) {
+      const int64_t image_id = batch / batches_per_image;
+      const int64_t output_start = (batch % batches_per_image) * output_batch_count;
+      const int64_t output_count = std::min(output_image_size - output_start, output_batch_count);
+
+      math::Im2col<T8Bits, StorageOrder::NHWC>()(
+          X_data + image_id * input_image_size * C,
+          C,
+          x_shape.GetDims().data() + 1,
+          output_dims.data() + 1,
+          pool_attrs_.kernel_shape.data(),
+          pool_attrs_.strides.data(),
+          pool_attrs_.dilations.data(),
+          pads.data(),
+          static_cast<ptrdiff_t>(spatial_dims),
+          output_start,
+          output_count,
+          static_cast<T8Bits const**>(col_buffer.get()),
+          padding_data.data());
+      MlasQLinearAveragePoolNhwc<T8Bits>(
+          static_cast<T8Bits const**>(col_buffer.get()),
+          x_scale,
+          static_cast<int32_t>(x_zero_point),
+          Y_data + (image_id * output_image_size + output_start) * C,
+          y_scale,
+          static_cast<int32_t>(y_zero_point),
+          static_cast<size_t>(C),
+          static_cast<size_t>(output_count),
+          static_cast<size_t>(kernel_size),
+          excluded_padding);
+    }
+  };
+
+  const double batch_elements = static_cast<double>(col_buffer_batch_count * C);
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(),
+      static_cast<std::ptrdiff_t>(total_batches),
+      TensorOpCost{batch_elements * kernel_size, batch_elements, batch_elements * kernel_size},
+      worker);
+
+  return Status::OK();
+}
+
+Status QLinearAveragePool::Compute(OpKernelContext* context) const {
+  auto dtype = context->Input<Tensor>(0)->GetElementType();
+  switch (dtype) {
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+      return ComputeImpl<uint8_t>(context);
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+      return ComputeImpl<int8_t>(context);
+    default:
+      ORT_THROW("Unsupported 'dtype' in QLinear Pooling:", dtype);
+  }
+}
+
 ONNX_OPERATOR_KERNEL_EX(QLinearAveragePool, kMSDomain, 1, kCpuExecutionProvider, KernelDefBuilder(), QLinearAveragePool);
 
 }  // namespace contrib
@@ -12,15 +12,24 @@ namespace contrib {
 
 class QLinearAveragePool final : public OpKernel, public PoolBase {
  public:
-  QLinearAveragePool(const OpKernelInfo& info) : OpKernel(info), PoolBase(info) { }
+  QLinearAveragePool(const OpKernelInfo& info) : OpKernel(info), PoolBase(info) {
+    channels_last_ = (info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(0)) != 0);
+  }
 
   ~QLinearAveragePool() override = default;
 
   Status Compute(OpKernelContext* context) const override;
 
 private:
-  PoolProcessContext pool_context_;
+  template <typename T8Bits>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  template <typename T8Bits>
+  Status ComputeNhwc(OpKernelContext* context, const T8Bits* X_data, const TensorShape& x_shape,
+                     float x_scale, T8Bits x_zero_point, float y_scale, T8Bits y_zero_point) const;
 
+  PoolProcessContext pool_context_;
+  bool channels_last_;
 };
 
 }  // namespace contrib
@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "qlinear_softmax.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/providers/common.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// The softmax of a slice only depends on the differences between its values and its maximum, which are the
+// quantized differences times X_scale, so exp() is looked up in a table of the 256 possible differences.
+static void BuildExpTable(const Tensor* tensor_x_scale, float* table) {
+  ORT_ENFORCE(IsScalarOr1ElementVector(tensor_x_scale),
+              "QLinearSoftmax : input X_scale must be a scalar or 1D tensor of size 1");
+  const float X_scale = *(tensor_x_scale->Data<float>());
+  for (int i = 0; i < 256; ++i) {
+    table[i] = std::exp(-X_scale * static_cast<float>(i));
+  }
+}
+
+template <typename T>
+QLinearSoftmax<T>::QLinearSoftmax(const OpKernelInfo& info)
+    : OpKernel(info), axis_(info.GetAttrOrDefault<int64_t>("axis", -1)) {
+  const Tensor* tensor_x_scale = nullptr;
+  if (info.TryGetConstantInput(1, &tensor_x_scale)) {
+    fixed_exp_table_.resize(256);
+    BuildExpTable(tensor_x_scale, fixed_exp_table_.data());
+  }
+}
+
+template <typename T>
+Status QLinearSoftmax<T>::Compute(OpKernelContext* context) const {
+  const auto& X = *context->Input<Tensor>(0);
+  const auto& input_shape = X.Shape();
+  auto& Y = *context->Output(0, input_shape);
+  if (input_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  float table[256];
+  const float* exp_table = fixed_exp_table_.data();
+  if (fixed_exp_table_.empty()) {
+    BuildExpTable(context->Input<Tensor>(1), table);
+    exp_table = table;
+  }
+
+  const auto* tensor_y_scale = context->Input<Tensor>(3);
+  const auto* tensor_y_zero_point = context->Input<Tensor>(4);
+  ORT_ENFORCE(IsScalarOr1ElementVector(tensor_y_scale),
+              "QLinearSoftmax : input Y_scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(tensor_y_zero_point == nullptr || IsScalarOr1ElementVector(tensor_y_zero_point),
+              "QLinearSoftmax : input Y_zero_point must be a scalar or 1D tensor of size 1");
+  const float Y_scale = *(tensor_y_scale->Data<float>());
+  const T Y_zero_point = (tensor_y_zero_point == nullptr) ? static_cast<T>(0) : *(tensor_y_zero_point->template Data<T>());
+
+  const size_t axis = static_cast<size_t>(HandleNegativeAxis(axis_, static_cast<int64_t>(input_shape.NumDimensions())));
+  const size_t axis_dim = static_cast<size_t>(input_shape[axis]);
+  const size_t inner_size = static_cast<size_t>(input_shape.SizeFromDimension(axis + 1));
+  const size_t slice_count = static_cast<size_t>(input_shape.Size()) / axis_dim;
+
+  const T* x_data = X.template Data<T>();
+  T* y_data = Y.template MutableData<T>();
+
+  using onnxruntime::TensorOpCost;
+  using onnxruntime::concurrency::ThreadPool;
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(slice_count),
+      TensorOpCost{static_cast<double>(axis_dim), static_cast<double>(axis_dim), static_cast<double>(axis_dim) * 4.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> values(axis_dim);
+        // the slices along an inner axis are strided, quantize them to a buffer first
+        std::vector<T> quantized(inner_size == 1 ? 0 : axis_dim);
+
+        for (std::ptrdiff_t slice = first; slice < last; ++slice) {
+          const size_t outer_index = static_cast<size_t>(slice) / inner_size;
+          const size_t inner_index = static_cast<size_t>(slice) % inner_size;
+          const T* x = x_data + outer_index * axis_dim * inner_size + inner_index;
+          T* y = y_data + outer_index * axis_dim * inner_size + inner_index;
+
+          int max_value = static_cast<int>(x[0]);
+          for (size_t i = 1; i < axis_dim; ++i) {
+            max_value = std::max(max_value, static_cast<int>(x[i * inner_size]));
+          }
+
+          float sum = 0.0f;
+          for (size_t i = 0; i < axis_dim; ++i) {
+            values[i] = exp_table[max_value - static_cast<int>(x[i * inner_size])];
+            sum += values[i];
+          }
+
+          const float inverse_sum = 1.0f / sum;
+          for (size_t i = 0; i < axis_dim; ++i) {
+            values[i] *= inverse_sum;
+          }
+
+          if (inner_size == 1) {
+            MlasQuantizeLinear(values.data(), y, axis_dim, Y_scale, Y_zero_point);
+          } else {
+            MlasQuantizeLinear(values.data(), quantized.data(), axis_dim, Y_scale, Y_zero_point);
+            for (size_t i = 0; i < axis_dim; ++i) {
+              y[i * inner_size] = quantized[i];
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(data_type)                       \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                           \
+      QLinearSoftmax, 1, data_type,                                            \
+      KernelDefBuilder()                                                       \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()),      \
+      QLinearSoftmax<data_type>);
+
+REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class QLinearSoftmax final : public OpKernel {
+ public:
+  QLinearSoftmax(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+
+  // exp(-X_scale * d) for the 256 differences d between the maximum of a slice and its values.
+  // After construction, non-zero size means pre-computed as X_scale is constant.
+  std::vector<float> fixed_exp_table_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -25,10 +25,17 @@ class QAttention : public OpKernel, public AttentionCPUBase {
   Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
 
  private:
+  // Computes the attention of Q, K and V(BxNxSxH) with 8-bit GEMMs. Q, K and V are quantized per tensor with the
+  // range of their values, and the attention probs with the fixed range [0, 1].
+  Status ComputeQuantizedAttention(const T* Q, const T* K, const T* V, const Tensor* mask_index, Tensor* output,
+                                   int batch_size, int sequence_length, int head_size, int hidden_size,
+                                   OpKernelContext* context) const;
+
   BufferUniquePtr packed_weights_;
   size_t packed_weights_size_;
   TensorShape weight_shape_;
   bool weights_is_signed_;
+  bool quantize_attention_;
 };
 
 // These ops are internal-only, so register outside of onnx
@@ -46,7 +53,9 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
     QAttention<float>);
 
 template <typename T>
-QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {}
+QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {
+  quantize_attention_ = info.GetAttrOrDefault<int64_t>("quantize_attention", 0) != 0;
+}
 
 template <typename T>
 Status QAttention<T>::PrePack(const Tensor& weights, int input_idx, bool& is_packed) {
@@ -242,11 +251,132 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
     MlasGemmBatch(gemm_shape, gemm_data_vec.data(), loop_len, tp);
   }
 
+  // The quantized attention has no past or present state.
+  if (quantize_attention_ && past_tensor == nullptr && context->OutputCount() < 2) {
+    return ComputeQuantizedAttention(Q, K, V, mask_index, output, batch_size, sequence_length, head_size, hidden_size,
+                                     context);
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(Q, K, V, mask_index, past_tensor, output,
                         batch_size, sequence_length,
                         head_size, hidden_size, context);
 }
 
+template <typename T>
+Status QAttention<T>::ComputeQuantizedAttention(const T* Q, const T* K, const T* V, const Tensor* mask_index,
+                                                Tensor* output, int batch_size, int sequence_length, int head_size,
+                                                int hidden_size, OpKernelContext* context) const {
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto* tp = context->GetOperatorThreadPool();
+
+  const T* QKV[3] = {Q, K, V};
+  T scales[3];
+  uint8_t zero_points[3];
+  const int64_t qkv_count = static_cast<int64_t>(batch_size) * sequence_length * hidden_size;
+  for (int i = 0; i < 3; i++) {
+    GetQuantizationParameter(QKV[i], qkv_count, scales[i], zero_points[i], tp);
+  }
+
+  const size_t chunk_length = static_cast<size_t>(sequence_length) * head_size;        // S x H
+  const size_t probs_length = static_cast<size_t>(sequence_length) * sequence_length;  // S x S
+
+  void* mask_data = nullptr;
+  if (mask_index != nullptr || (is_unidirectional_ && sequence_length > 1)) {
+    size_t mask_data_bytes = SafeInt<size_t>(batch_size) * probs_length * sizeof(T);
+    mask_data = allocator->Alloc(mask_data_bytes);
+    memset(mask_data, 0, mask_data_bytes);
+    PrepareMask(mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr,
+                mask_index != nullptr ? &(mask_index->Shape().GetDims()) : nullptr,
+                static_cast<T*>(mask_data), is_unidirectional_, batch_size, sequence_length, 0);
+  }
+  BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+
+  constexpr T probs_scale = 1.0f / 255.0f;
+  const T scores_scale = scales[0] * scales[1] / std::sqrt(static_cast<T>(head_size));
+  const T output_scale = probs_scale * scales[2];
+  constexpr uint8_t probs_zero_point = 0;
+
+  MLAS_GEMM_U8X8_SHAPE_PARAMS scores_shape;
+  scores_shape.M = sequence_length;
+  scores_shape.N = sequence_length;
+  scores_shape.K = head_size;
+
+  MLAS_GEMM_U8X8_SHAPE_PARAMS output_shape;
+  output_shape.M = sequence_length;
+  output_shape.N = head_size;
+  output_shape.K = sequence_length;
+
+  T* output_data = output->template MutableData<T>();
+
+  // Each head is quantized, scored and applied to V in buffers of its own, so that it stays in cache.
+  const double cost = 2.0 * static_cast<double>(probs_length) * head_size;
+  ThreadPool::TryParallelFor(tp, batch_size * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    std::vector<uint8_t> quantized(4 * chunk_length + probs_length);
+    uint8_t* q = quantized.data();
+    uint8_t* k = q + chunk_length;
+    uint8_t* k_transposed = k + chunk_length;
+    uint8_t* v = k_transposed + chunk_length;
+    uint8_t* probs = v + chunk_length;
+    std::vector<T> scores(probs_length);
+
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      MlasQuantizeLinear(Q + chunk_length * i, q, chunk_length, scales[0], zero_points[0]);
+      MlasQuantizeLinear(K + chunk_length * i, k, chunk_length, scales[1], zero_points[1]);
+      MlasQuantizeLinear(V + chunk_length * i, v, chunk_length, scales[2], zero_points[2]);
+      for (int s = 0; s < sequence_length; s++) {
+        for (int h = 0; h < head_size; h++) {
+          k_transposed[h * sequence_length + s] = k[s * head_size + h];
+        }
+      }
+
+      // scores(S, S) = 1/sqrt(H) x q(S, H) x k'(H, S) + mask(S, S)
+      MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR scores_processor(scores.data(), sequence_length, &scores_scale, nullptr);
+      MLAS_GEMM_U8X8_DATA_PARAMS scores_params;
+      scores_params.A = q;
+      scores_params.lda = head_size;
+      scores_params.ZeroPointA = zero_points[0];
+      scores_params.B = k_transposed;
+      scores_params.ldb = sequence_length;
+      scores_params.ZeroPointB = &zero_points[1];
+      scores_params.C = reinterpret_cast<int32_t*>(scores.data());
+      scores_params.ldc = sequence_length;
+      scores_params.OutputProcessor = &scores_processor;
+      MlasGemm(scores_shape, scores_params, nullptr);
+
+      const int batch_index = static_cast<int>(i / num_heads_);
+      const int head_index = static_cast<int>(i % num_heads_);
+      if (mask_data != nullptr) {
+        const T* mask = static_cast<const T*>(mask_data) + batch_index * probs_length;
+        for (size_t j = 0; j < probs_length; j++) {
+          scores[j] += mask[j];
+        }
+      }
+
+      MlasComputeSoftmax(scores.data(), scores.data(), sequence_length, sequence_length, false, nullptr);
+      MlasQuantizeLinear(scores.data(), probs, probs_length, probs_scale, probs_zero_point);
+
+      // output(B, S, N, H) = probs(S, S) x v(S, H), written to the columns of the head.
+      T* dest = output_data + (static_cast<size_t>(batch_index) * sequence_length * num_heads_ + head_index) * head_size;
+      MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR output_processor(dest, hidden_size, &output_scale, nullptr);
+      MLAS_GEMM_U8X8_DATA_PARAMS output_params;
+      output_params.A = probs;
+      output_params.lda = sequence_length;
+      output_params.ZeroPointA = probs_zero_point;
+      output_params.B = v;
+      output_params.ldb = head_size;
+      output_params.ZeroPointB = &zero_points[2];
+      output_params.C = reinterpret_cast<int32_t*>(dest);
+      output_params.ldc = hidden_size;
+      output_params.OutputProcessor = &output_processor;
+      MlasGemm(output_shape, output_params, nullptr);
+    }
+  });
+
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
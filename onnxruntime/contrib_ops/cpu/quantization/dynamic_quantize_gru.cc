@@ -0,0 +1,230 @@
+#include "core/providers/cpu/rnn/gru_base.h"
+#include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/providers/cpu/rnn/uni_directional_gru.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using namespace rnn::detail;
+
+class DynamicQuantizeGRU : public OpKernel, public GRUBase {
+ public:
+  DynamicQuantizeGRU(const OpKernelInfo& info) : OpKernel(info), GRUBase(info) {}
+  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+  ~DynamicQuantizeGRU() override = default;
+
+ private:
+  Status TryPackWeights(const Tensor& weights, size_t N, size_t column_offset,
+                        PackedWeights& packed_weights, bool& is_packed);
+
+  PackedWeights packed_W_;
+  // the recurrence weights are packed as two matrices as R[zr] and R[h] are applied separately
+  PackedWeights packed_R_zr_;
+  PackedWeights packed_R_h_;
+  bool is_W_signed_;
+  bool is_R_signed_;
+};
+
+Status DynamicQuantizeGRU::TryPackWeights(const Tensor& weights, size_t N, size_t column_offset,
+                                          PackedWeights& packed_weights, bool& is_packed) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3) {
+    return Status::OK();
+  }
+
+  // weights: [num_directions, input_size, 3*hidden_size]
+  // recurrence weights: [num_directions, hidden_size, 3*hidden_size]
+  const size_t K = static_cast<size_t>(shape[1]);
+  const size_t ldb = static_cast<size_t>(shape[2]);
+
+  if ((shape[0] != num_directions_) || (ldb != static_cast<size_t>(hidden_size_ * 3))) {
+    return Status::OK();
+  }
+
+  const bool is_weight_signed = weights.IsDataType<int8_t>();
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K, is_weight_signed);
+  if (packed_weights_size == 0) {
+    return Status::OK();
+  }
+
+  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_weights_data = alloc->Alloc(SafeInt<size_t>(packed_weights_size) * num_directions_);
+  packed_weights.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
+  packed_weights.weights_size_ = packed_weights_size;
+  packed_weights.shape_ = shape;
+
+  const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw()) + column_offset;
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(N, K, weights_data, ldb, is_weight_signed, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += ldb * K;
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DynamicQuantizeGRU::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  is_packed = false;
+
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+
+  if (input_idx == 1) {
+    is_W_signed_ = tensor.IsDataType<int8_t>();
+    return TryPackWeights(tensor, 3 * hidden_size, 0, packed_W_, is_packed);
+  } else if (input_idx == 2) {
+    is_R_signed_ = tensor.IsDataType<int8_t>();
+    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 2 * hidden_size, 0, packed_R_zr_, is_packed));
+    if (is_packed) {
+      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, hidden_size, 2 * hidden_size, packed_R_h_, is_packed));
+      if (!is_packed) {
+        packed_R_zr_.buffer_.reset();
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+static Status CheckQuantizationParameter(const Tensor& scale, const Tensor& zero_point, bool is_signed,
+                                         int64_t num_directions, int64_t hidden_size, const char* name) {
+  for (const auto* shape : {&scale.Shape(), &zero_point.Shape()}) {
+    if ((shape->NumDimensions() != 1 && shape->NumDimensions() != 2) ||
+        (shape->NumDimensions() == 2 && (*shape)[1] != hidden_size * 3) ||
+        (*shape)[0] != num_directions) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input ", name, " scale and zero point must have shape {", num_directions,
+                             "} for per-tensor/layer quantization or shape {", num_directions, ", 3*", hidden_size,
+                             "} for per-channel quantization. Actual:", *shape);
+    }
+  }
+
+  if (scale.Shape() != zero_point.Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input ", name, " scale and zero point must have the same shape. ",
+                           "Scale:", scale.Shape(), " Zero point:", zero_point.Shape());
+  }
+
+  // the quantized GEMM takes one zero point for B, so it must be the same across all the channels of a direction
+  const int64_t zp_size_per_direction = zero_point.Shape().Size() / num_directions;
+  const uint8_t* zp_data = static_cast<const uint8_t*>(zero_point.DataRaw());
+  for (int64_t d = 0; d < num_directions; d++, zp_data += zp_size_per_direction) {
+    for (int64_t i = 0; i < zp_size_per_direction; i++) {
+      if (is_signed ? zp_data[i] != 0 : zp_data[i] != zp_data[0]) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeGRU : ", name,
+                               is_signed ? " weight zero point must be zero" : " weight zero point must be constant");
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DynamicQuantizeGRU::Compute(OpKernelContext* context) const {
+  // weights. [num_directions, input_size, 3*hidden_size]
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context->Input<Tensor>(1);
+  // recurrence weights. [num_directions, hidden_size, 3*hidden_size]
+  const Tensor* R = packed_R_zr_.buffer_ ? nullptr : context->Input<Tensor>(2);
+
+  const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
+  const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_zr_.shape_;
+
+  const int64_t input_size = context->Input<Tensor>(0)->Shape().NumDimensions() == 3
+                                 ? context->Input<Tensor>(0)->Shape()[2]
+                                 : 0;
+  if (W_shape.NumDimensions() != 3 || W_shape[0] != num_directions_ || W_shape[1] != input_size ||
+      W_shape[2] != 3 * hidden_size_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input W must have shape {", num_directions_, ",",
+                           input_size, ",3*", hidden_size_, "}. Actual:", W_shape);
+  }
+  if (R_shape.NumDimensions() != 3 || R_shape[0] != num_directions_ || R_shape[1] != hidden_size_ ||
+      R_shape[2] != 3 * hidden_size_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input R must have shape {", num_directions_, ",",
+                           hidden_size_, ",3*", hidden_size_, "}. Actual:", R_shape);
+  }
+
+  const Tensor* w_scale = context->Input<Tensor>(6);
+  const Tensor* w_zp = context->Input<Tensor>(7);
+  const Tensor* r_scale = context->Input<Tensor>(8);
+  const Tensor* r_zp = context->Input<Tensor>(9);
+
+  const bool is_W_signed = (W != nullptr) ? W->IsDataType<int8_t>() : is_W_signed_;
+  const bool is_R_signed = (R != nullptr) ? R->IsDataType<int8_t>() : is_R_signed_;
+
+  ORT_RETURN_IF_ERROR(CheckQuantizationParameter(*w_scale, *w_zp, is_W_signed, num_directions_, hidden_size_, "W"));
+  ORT_RETURN_IF_ERROR(CheckQuantizationParameter(*r_scale, *r_zp, is_R_signed, num_directions_, hidden_size_, "R"));
+
+  const bool is_W_per_channel = w_scale->Shape().NumDimensions() == 2;
+  const bool is_R_per_channel = r_scale->Shape().NumDimensions() == 2;
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+  const size_t W_scale_size = is_W_per_channel ? 3 * hidden_size : 1;
+  const size_t R_scale_size = is_R_per_channel ? 3 * hidden_size : 1;
+
+  const float* w_scale_data = w_scale->Data<float>();
+  const float* r_scale_data = r_scale->Data<float>();
+  const uint8_t* w_zp_data = static_cast<const uint8_t*>(w_zp->DataRaw());
+  const uint8_t* r_zp_data = static_cast<const uint8_t*>(r_zp->DataRaw());
+
+  // per direction quantization parameters. the per-channel scales of R are split between R[zr] and R[h].
+  const size_t R_h_scale_offset = is_R_per_channel ? 2 * hidden_size : 0;
+  std::vector<QuantizationParameter> quant_para_W;
+  std::vector<QuantizationParameter> quant_para_R_zr;
+  std::vector<QuantizationParameter> quant_para_R_h;
+  quant_para_W.reserve(num_directions_);
+  quant_para_R_zr.reserve(num_directions_);
+  quant_para_R_h.reserve(num_directions_);
+  for (int i = 0; i < num_directions_; i++) {
+    quant_para_W.emplace_back(w_scale_data + i * W_scale_size, w_zp_data + i * W_scale_size,
+                              is_W_signed, W_scale_size);
+    quant_para_R_zr.emplace_back(r_scale_data + i * R_scale_size, r_zp_data + i * R_scale_size,
+                                 is_R_signed, is_R_per_channel ? 2 * hidden_size : 1);
+    quant_para_R_h.emplace_back(r_scale_data + i * R_scale_size + R_h_scale_offset,
+                                r_zp_data + i * R_scale_size + R_h_scale_offset,
+                                is_R_signed, is_R_per_channel ? hidden_size : 1);
+  }
+
+  const uint8_t* W_data = W != nullptr ? static_cast<const uint8_t*>(W->DataRaw()) : nullptr;
+  const uint8_t* R_data = R != nullptr ? static_cast<const uint8_t*>(R->DataRaw()) : nullptr;
+  // unpacked R[h] is the last hidden_size columns of R
+  const uint8_t* R_h_data = R != nullptr ? R_data + 2 * hidden_size : nullptr;
+
+  const size_t W_size_per_direction = W_shape[1] * W_shape[2];
+  const size_t R_size_per_direction = R_shape[1] * R_shape[2];
+
+  GemmWeights<uint8_t> W_1(0, W_data, W_size_per_direction, packed_W_, &quant_para_W[0]);
+  GemmWeights<uint8_t> R_zr_1(0, R_data, R_size_per_direction, packed_R_zr_, &quant_para_R_zr[0]);
+  GemmWeights<uint8_t> R_h_1(0, R_h_data, R_size_per_direction, packed_R_h_, &quant_para_R_h[0]);
+
+  GemmWeights<uint8_t> W_2;
+  GemmWeights<uint8_t> R_zr_2;
+  GemmWeights<uint8_t> R_h_2;
+
+  if (direction_ == Direction::kBidirectional) {
+    W_2.Init(1, W_data, W_size_per_direction, packed_W_, &quant_para_W[1]);
+    R_zr_2.Init(1, R_data, R_size_per_direction, packed_R_zr_, &quant_para_R_zr[1]);
+    R_h_2.Init(1, R_h_data, R_size_per_direction, packed_R_h_, &quant_para_R_h[1]);
+  }
+
+  // R[zr] and R[h] are column slices of the unpacked R so step over the full row
+  R_zr_1.ldb_ = R_zr_2.ldb_ = 3 * hidden_size;
+  R_h_1.ldb_ = R_h_2.ldb_ = 3 * hidden_size;
+
+  return GRUBase::ComputeImpl<float, uint8_t>(*context, W_1, W_2, R_zr_1, R_zr_2, R_h_1, R_h_2);
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    DynamicQuantizeGRU,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    DynamicQuantizeGRU);
+
+}  // namespace contrib
+}  // namespace onnxruntime
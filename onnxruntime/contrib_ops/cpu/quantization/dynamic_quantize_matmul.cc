@@ -2,12 +2,14 @@
 // Licensed under the MIT License.
 
 #include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/cpu/math/matmul_integer_base.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/qmath.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -15,28 +17,120 @@ namespace contrib {
 class MatMulIntegerToFloatBase : public MatMulIntegerBase {
  public:
   MatMulIntegerToFloatBase(const OpKernelInfo& info) : MatMulIntegerBase(info) {
+    block_size_ = info.GetAttrOrDefault<int64_t>("block_size", 0);
+    ORT_ENFORCE(block_size_ >= 0, "block_size must not be negative");
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+
   enum OutputTensors : int { OUT_Y = 0 };
 
-protected:
+ protected:
+  // Matrix A as seen by the integer GEMM. If `data` is null, the float matrix `float_data` is quantized with
+  // `scale` and `zero_point` as it is consumed.
+  struct QuantizedA {
+    const uint8_t* data = nullptr;
+    const float* float_data = nullptr;
+    float scale = 1.0f;
+    uint8_t zero_point = 0;
+  };
+
   Status ComputeCommon(OpKernelContext* ctx,
-                       const uint8_t* a_data,
+                       QuantizedA a,
                        const TensorShape& a_shape,
-                       uint8_t a_zero_point,
                        const Tensor* b,
-                       uint8_t b_zero_point,
-                       float multiplier,
+                       const Tensor* b_scale_tensor,
+                       const Tensor* b_zero_point_tensor,
                        const Tensor* bias_tensor) const;
+
+ private:
+  // A block-wise quantized B is packed as separate [block_size_ x kColumnBlock] panels, so a GEMM over
+  // one block of rows and one range of columns can use its panel directly.
+  static constexpr size_t kColumnBlock = 128;
+
+  // Rows of A quantized at a time by the thread that multiplies them, when A is quantized on the fly.
+  static constexpr size_t kRowBlock = 32;
+
+  Status ComputeTiled(OpKernelContext* ctx,
+                      const QuantizedA& a,
+                      const MatMulComputeHelper& helper,
+                      const uint8_t* b_data,
+                      bool b_is_signed,
+                      size_t num_k_blocks,
+                      const float* scales,
+                      const uint8_t* b_zero_points,
+                      MLAS_QUANTIZATION_GRANULARITY granularity,
+                      bool per_column_zero_points,
+                      const float* bias_data,
+                      float* y_data) const;
+
+  // rows of B in each quantization block, 0 for per-tensor or per-column quantization
+  int64_t block_size_;
+
+  // offset of the packed panel of each (row block, column block) of B when block_size_ is set
+  std::vector<size_t> packed_b_panel_offsets_;
 };
 
+constexpr size_t MatMulIntegerToFloatBase::kColumnBlock;
+constexpr size_t MatMulIntegerToFloatBase::kRowBlock;
+
+Status MatMulIntegerToFloatBase::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  if (block_size_ == 0 || input_idx != GetBIdx()) {
+    return MatMulIntegerBase::PrePack(tensor, input_idx, is_packed);
+  }
+
+  is_packed = false;
+  b_shape_ = tensor.Shape();
+  if (b_shape_.NumDimensions() != 2) {
+    return Status::OK();
+  }
+
+  const size_t K = static_cast<size_t>(b_shape_[0]);
+  const size_t N = static_cast<size_t>(b_shape_[1]);
+  const size_t block_size = static_cast<size_t>(block_size_);
+  const auto* b_data = static_cast<const uint8_t*>(tensor.DataRaw());
+  b_is_signed_ = tensor.IsDataType<int8_t>();
+
+  // pack each [block_size x kColumnBlock] panel separately, 64 byte aligned
+  packed_b_panel_offsets_.clear();
+  size_t packed_b_size = 0;
+  for (size_t k = 0; k < K; k += block_size) {
+    for (size_t n = 0; n < N; n += kColumnBlock) {
+      const size_t panel_size = MlasGemmPackBSize(std::min(kColumnBlock, N - n), std::min(block_size, K - k),
+                                                  a_is_signed_, b_is_signed_);
+      if (panel_size == 0) {
+        packed_b_panel_offsets_.clear();
+        return Status::OK();
+      }
+      packed_b_panel_offsets_.push_back(packed_b_size);
+      packed_b_size += (panel_size + 63) & ~size_t{63};
+    }
+  }
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = static_cast<uint8_t*>(alloc->Alloc(packed_b_size));
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+
+  size_t panel = 0;
+  for (size_t k = 0; k < K; k += block_size) {
+    for (size_t n = 0; n < N; n += kColumnBlock) {
+      MlasGemmPackB(std::min(kColumnBlock, N - n), std::min(block_size, K - k), b_data + k * N + n, N,
+                    a_is_signed_, b_is_signed_, packed_b_data + packed_b_panel_offsets_[panel++]);
+    }
+  }
+  is_packed = true;
+  return Status::OK();
+}
+
 Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
-                                               const uint8_t* a_data,
+                                               QuantizedA a,
                                                const TensorShape& a_shape,
-                                               uint8_t a_zero_point,
                                                const Tensor* b,
-                                               uint8_t b_zero_point,
-                                               float multiplier,
+                                               const Tensor* b_scale_tensor,
+                                               const Tensor* b_zero_point_tensor,
                                                const Tensor* bias_tensor) const {
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a_shape, packed_b_ ? b_shape_ : b->Shape()));
@@ -46,17 +140,86 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
   if (y->Shape().Size() == 0)
     return Status::OK();
 
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t num_k_blocks = block_size_ > 0 ? (K + block_size_ - 1) / block_size_ : 1;
+
+  // B is quantized per tensor, per column, or per block of block_size_ rows of each column
+  const auto& b_scale_shape = b_scale_tensor->Shape();
+  MLAS_QUANTIZATION_GRANULARITY granularity = MLAS_QUANTIZATION_GRANULARITY::PerMatrix;
+  size_t num_scales = 1;
+  if (!IsScalarOr1ElementVector(b_scale_tensor)) {
+    if (block_size_ > 0) {
+      ORT_RETURN_IF_NOT(b_scale_shape.NumDimensions() == 2 &&
+                            static_cast<size_t>(b_scale_shape[0]) == num_k_blocks &&
+                            static_cast<size_t>(b_scale_shape[1]) == N,
+                        "input B scale must be a scalar or a tensor of shape [ceil(K / block_size), N], got ",
+                        b_scale_shape);
+    } else {
+      ORT_RETURN_IF_NOT(b_scale_shape.NumDimensions() == 1 && static_cast<size_t>(b_scale_shape[0]) == N,
+                        "input B scale must be a scalar or a 1D tensor with one scale per column of B, got ",
+                        b_scale_shape);
+    }
+    granularity = MLAS_QUANTIZATION_GRANULARITY::PerColumn;
+    num_scales = static_cast<size_t>(b_scale_shape.Size());
+  }
+
+  // the output processors take the combined scale of A and B
+  std::vector<float> scales(b_scale_tensor->Data<float>(), b_scale_tensor->Data<float>() + num_scales);
+  for (auto& scale : scales) {
+    scale *= a.scale;
+  }
+
+  uint8_t b_zero_point = 0;
+  const uint8_t* b_zero_points = &b_zero_point;
+  bool per_column_zero_points = false;
+  if (b_zero_point_tensor != nullptr) {
+    b_zero_points = static_cast<const uint8_t*>(b_zero_point_tensor->DataRaw());
+    if (!IsScalarOr1ElementVector(b_zero_point_tensor)) {
+      ORT_RETURN_IF_NOT(b_zero_point_tensor->Shape() == b_scale_shape,
+                        "input B zero point must be a scalar or have the same shape as the B scale");
+      per_column_zero_points = true;
+    }
+  }
+  const bool b_is_signed = packed_b_ ? b_is_signed_ : b->IsDataType<int8_t>();
+  const auto* b_data = packed_b_ ? static_cast<const uint8_t*>(packed_b_.get())
+                                 : static_cast<const uint8_t*>(b->DataRaw());
   auto* y_data = y->template MutableData<float>();
   const auto* bias_data = bias_tensor != nullptr ? bias_tensor->Data<float>() : nullptr;
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+  const size_t num_gemms = helper.OutputOffsets().size();
+
+  // Quantize A as its rows are multiplied when there are enough blocks of rows to keep every thread busy,
+  // so the quantized copy of A is written to and read back from cache instead of memory.
+  const size_t num_row_blocks = num_gemms * ((M + kRowBlock - 1) / kRowBlock);
+  const bool quantize_a_on_the_fly =
+      a.data == nullptr &&
+      num_row_blocks >= static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+
+  BufferUniquePtr a_buffer_quant_holder;
+  if (a.data == nullptr && !quantize_a_on_the_fly) {
+    const size_t num_of_elements = static_cast<size_t>(a_shape.Size());
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+    uint8_t* a_data_quant = static_cast<uint8_t*>(allocator->Alloc(SafeInt<size_t>(num_of_elements) * sizeof(uint8_t)));
+    a_buffer_quant_holder = BufferUniquePtr(a_data_quant, BufferDeleter(allocator));
+    ParQuantizeLinear(a.float_data, a_data_quant, num_of_elements, a.scale, a.zero_point, thread_pool);
+    a.data = a_data_quant;
+  }
+
+  if (num_k_blocks > 1 || quantize_a_on_the_fly || !packed_b_panel_offsets_.empty()) {
+    return ComputeTiled(ctx, a, helper, b_data, b_is_signed, num_k_blocks, scales.data(), b_zero_points,
+                        granularity, per_column_zero_points, bias_data, y_data);
+  }
 
   // batch gemm
   MLAS_GEMM_U8X8_SHAPE_PARAMS gemm_shape;
-  gemm_shape.M = static_cast<size_t>(helper.M());
-  gemm_shape.N = static_cast<size_t>(helper.N());
-  gemm_shape.K = static_cast<size_t>(helper.K());
-  gemm_shape.BIsSigned = packed_b_ ? b_is_signed_ : b->IsDataType<int8_t>();
+  gemm_shape.M = M;
+  gemm_shape.N = N;
+  gemm_shape.K = K;
+  gemm_shape.BIsSigned = b_is_signed;
 
-  const size_t num_gemms = helper.OutputOffsets().size();
   std::vector<MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR> gemm_scale_procs;
   gemm_scale_procs.reserve(num_gemms);
   std::vector<MLAS_GEMM_U8X8_DATA_PARAMS> gemm_data_vec(num_gemms);
@@ -64,23 +227,144 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
   for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
     gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
                                   gemm_shape.N,
-                                  &multiplier,
-                                  bias_data);
+                                  scales.data(),
+                                  bias_data,
+                                  MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
+                                  granularity);
     auto& params = gemm_data_vec[gemm_idx];
     params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
-    params.A = a_data + helper.LeftOffsets()[gemm_idx];
+    params.A = a.data + helper.LeftOffsets()[gemm_idx];
     params.lda = gemm_shape.K;
-    params.ZeroPointA = a_zero_point;
+    params.ZeroPointA = a.zero_point;
     params.BIsPacked = bool(packed_b_);
-    params.B = bool(packed_b_) ? packed_b_.get() : 
-        static_cast<const uint8_t*>(b->DataRaw()) + helper.RightOffsets()[gemm_idx];
+    params.B = bool(packed_b_) ? b_data : b_data + helper.RightOffsets()[gemm_idx];
     params.ldb = gemm_shape.N;
-    params.ZeroPointB = &b_zero_point;
+    params.ZeroPointB = b_zero_points;
+    params.PerColumnZeroPoints = per_column_zero_points;
     params.C = reinterpret_cast<int32_t*>(y_data + helper.OutputOffsets()[gemm_idx]);
     params.ldc = gemm_shape.N;
   }
 
-  MlasGemmBatch(gemm_shape, gemm_data_vec.data(), num_gemms, ctx->GetOperatorThreadPool());
+  MlasGemmBatch(gemm_shape, gemm_data_vec.data(), num_gemms, thread_pool);
+
+  return Status::OK();
+}
+
+// Splits the output into tiles that each thread computes with single threaded GEMMs, one for each block of
+// rows of B, accumulating the scaled results in the output. A tile is either a block of kRowBlock rows of
+// the output, whose rows of A are quantized first, or a range of columns of all the rows.
+Status MatMulIntegerToFloatBase::ComputeTiled(OpKernelContext* ctx,
+                                              const QuantizedA& a,
+                                              const MatMulComputeHelper& helper,
+                                              const uint8_t* b_data,
+                                              bool b_is_signed,
+                                              size_t num_k_blocks,
+                                              const float* scales,
+                                              const uint8_t* b_zero_points,
+                                              MLAS_QUANTIZATION_GRANULARITY granularity,
+                                              bool per_column_zero_points,
+                                              const float* bias_data,
+                                              float* y_data) const {
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t num_gemms = helper.OutputOffsets().size();
+  const size_t k_block = num_k_blocks > 1 ? static_cast<size_t>(block_size_) : K;
+  const bool quantize_a = a.data == nullptr;
+  const bool per_block_scales = num_k_blocks > 1 && granularity == MLAS_QUANTIZATION_GRANULARITY::PerColumn;
+
+  // panels of a block-wise packed B are kColumnBlock wide, otherwise a GEMM can cover any range of columns
+  const bool packed_panels = packed_b_ && !packed_b_panel_offsets_.empty();
+  const size_t num_column_blocks = (N + kColumnBlock - 1) / kColumnBlock;
+  const size_t tile_m = quantize_a ? std::min(M, kRowBlock) : M;
+  const size_t tile_n = quantize_a || (packed_b_ && !packed_panels) ? N : kColumnBlock;
+  const size_t gemm_n = packed_panels ? kColumnBlock : tile_n;
+  const size_t tiles_m = (M + tile_m - 1) / tile_m;
+  const size_t tiles_n = (N + tile_n - 1) / tile_n;
+
+  const double tile_ops = static_cast<double>(tile_m) * static_cast<double>(tile_n) * static_cast<double>(K);
+  const TensorOpCost cost{static_cast<double>(tile_m * K + tile_n * K), static_cast<double>(tile_m * tile_n * sizeof(float)),
+                          tile_ops};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_gemms * tiles_m * tiles_n), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<uint8_t> a_rows(quantize_a ? tile_m * K : 0);
+        std::vector<int32_t> accumulators(num_k_blocks > 1 ? tile_m * gemm_n : 0);
+
+        for (std::ptrdiff_t tile = first; tile < last; ++tile) {
+          const size_t gemm_idx = static_cast<size_t>(tile) / (tiles_m * tiles_n);
+          const size_t m_start = (static_cast<size_t>(tile) / tiles_n % tiles_m) * tile_m;
+          const size_t n_tile_start = (static_cast<size_t>(tile) % tiles_n) * tile_n;
+          const size_t rows = std::min(tile_m, M - m_start);
+          float* y_rows = y_data + helper.OutputOffsets()[gemm_idx] + m_start * N;
+
+          const uint8_t* a_data;
+          if (quantize_a) {
+            MlasQuantizeLinear(a.float_data + helper.LeftOffsets()[gemm_idx] + m_start * K, a_rows.data(),
+                               rows * K, a.scale, a.zero_point);
+            a_data = a_rows.data();
+          } else {
+            a_data = a.data + helper.LeftOffsets()[gemm_idx] + m_start * K;
+          }
+
+          for (size_t n_start = n_tile_start; n_start < std::min(N, n_tile_start + tile_n); n_start += gemm_n) {
+            const size_t columns = std::min(gemm_n, N - n_start);
+
+            for (size_t k_block_idx = 0; k_block_idx < num_k_blocks; ++k_block_idx) {
+              const size_t k_start = k_block_idx * k_block;
+
+              MLAS_GEMM_U8X8_SHAPE_PARAMS gemm_shape;
+              gemm_shape.M = rows;
+              gemm_shape.N = columns;
+              gemm_shape.K = std::min(k_block, K - k_start);
+              gemm_shape.BIsSigned = b_is_signed;
+
+              // the first block of rows of B overwrites the output and adds the bias, later ones accumulate
+              const bool first_k_block = k_block_idx == 0;
+              const float* scale = scales;
+              if (granularity == MLAS_QUANTIZATION_GRANULARITY::PerColumn) {
+                scale += (per_block_scales ? k_block_idx * N : 0) + n_start;
+              }
+              MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR scale_bias_processor(
+                  y_rows + n_start, N, scale,
+                  first_k_block && bias_data != nullptr ? bias_data + n_start : nullptr,
+                  first_k_block ? MLAS_QGEMM_OUTPUT_MODE::ZeroMode : MLAS_QGEMM_OUTPUT_MODE::AccumulateMode,
+                  granularity);
+
+              MLAS_GEMM_U8X8_DATA_PARAMS params;
+              params.A = a_data + k_start;
+              params.lda = K;
+              params.ZeroPointA = a.zero_point;
+              if (packed_panels) {
+                params.B = b_data + packed_b_panel_offsets_[k_block_idx * num_column_blocks + n_start / kColumnBlock];
+              } else if (packed_b_) {
+                params.B = b_data;
+              } else {
+                params.B = b_data + helper.RightOffsets()[gemm_idx] + k_start * N + n_start;
+              }
+              params.BIsPacked = bool(packed_b_);
+              params.ldb = N;
+              params.ZeroPointB = b_zero_points;
+              if (per_column_zero_points) {
+                params.ZeroPointB += (num_k_blocks > 1 ? k_block_idx * N : 0) + n_start;
+              }
+              params.PerColumnZeroPoints = per_column_zero_points;
+              // with a single block of rows the output buffer holds the accumulators, as in ComputeCommon
+              if (num_k_blocks > 1) {
+                params.C = accumulators.data();
+                params.ldc = columns;
+              } else {
+                params.C = reinterpret_cast<int32_t*>(y_rows + n_start);
+                params.ldc = N;
+              }
+              params.OutputProcessor = &scale_bias_processor;
+
+              MlasGemm(gemm_shape, params, nullptr);
+            }
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -127,41 +411,18 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   const Tensor* a = ctx->Input<Tensor>(IN_A);
   const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(IN_B);
 
-  const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
-  ORT_ENFORCE(IsScalarOr1ElementVector(b_scale_tensor),
-              "DynamicQuantizeMatMul : input B scale must be a scalar or 1D tensor of size 1. Per-Channel is not supported yet.");
-  float b_scale = *b_scale_tensor->template Data<float>();
-
-  const Tensor* b_zero_point_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
-  uint8_t b_zero_point = 0;
-  if (b_zero_point_tensor != nullptr) {
-    ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point_tensor),
-                "DynamicQuantizeMatMul : input B zero point must be a scalar or 1D tensor of size 1. Per-Channel is not supported yet.");
-    b_zero_point = *static_cast<const uint8_t*>(b_zero_point_tensor->DataRaw());
-  }
-
-  // calculate quantization parameter of a
-  const float* a_data = a->template Data<float>();
-  int64_t num_of_elements = a->Shape().Size();
-
-  float a_scale;
-  uint8_t a_zero_point;
-  GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
-
-  AllocatorPtr allocator;
-  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
-  uint8_t* a_data_quant = static_cast<uint8_t*>(allocator->Alloc(SafeInt<size_t>(num_of_elements) * sizeof(uint8_t)));
-  BufferUniquePtr a_buffer_quant_holder(a_data_quant, BufferDeleter(allocator));
-
-  ParQuantizeLinear(a_data, a_data_quant, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  // calculate quantization parameter of a, a is quantized by ComputeCommon
+  QuantizedA quantized_a;
+  quantized_a.float_data = a->template Data<float>();
+  GetQuantizationParameter(quantized_a.float_data, a->Shape().Size(), quantized_a.scale, quantized_a.zero_point,
+                           ctx->GetOperatorThreadPool());
 
   return ComputeCommon(ctx,
-                       a_data_quant,
+                       quantized_a,
                        a->Shape(),
-                       a_zero_point,
                        b,
-                       b_zero_point,
-                       a_scale * b_scale,
+                       ctx->Input<Tensor>(IN_B_SCALE),
+                       ctx->Input<Tensor>(IN_B_ZERO_POINT),
                        ctx->Input<Tensor>(IN_BIAS));
 }
 
@@ -172,37 +433,25 @@ Status MatMulIntegerToFloat::Compute(OpKernelContext* ctx) const {
   const Tensor* a_scale_tensor = ctx->Input<Tensor>(IN_A_SCALE);
   ORT_ENFORCE(IsScalarOr1ElementVector(a_scale_tensor),
               "MatMulIntegerToFloat : input A scale must be a scalar or 1D tensor of size 1. Per-Channel is not supported yet.");
-  float a_scale = *a_scale_tensor->template Data<float>();
 
-  const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
-  ORT_ENFORCE(IsScalarOr1ElementVector(b_scale_tensor),
-              "MatMulIntegerToFloat : input B scale must be a scalar or 1D tensor of size 1. Per-Channel is not supported yet.");
-  float b_scale = *b_scale_tensor->template Data<float>();
+  QuantizedA quantized_a;
+  quantized_a.data = a->Data<uint8_t>();
+  quantized_a.scale = *a_scale_tensor->template Data<float>();
 
   // validate zero points
-  uint8_t a_zero_point = 0;
   const Tensor* a_zero_point_tensor = ctx->Input<Tensor>(IN_A_ZERO_POINT);
   if (a_zero_point_tensor != nullptr) {
     ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point_tensor),
                 "MatMulIntegerToFloat : input A zero point must be a scalar or 1D tensor of size 1. Per-Channel is not supported yet.");
-    a_zero_point = *a_zero_point_tensor->Data<uint8_t>();
-  }
-
-  uint8_t b_zero_point = 0;
-  const Tensor* b_zero_point_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
-  if (b_zero_point_tensor != nullptr) {
-    ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point_tensor),
-                "MatMulIntegerToFloat : input B zero point must be a scalar or 1D tensor of size 1. Per-Channel is not supported yet.");
-    b_zero_point = *static_cast<const uint8_t*>(b_zero_point_tensor->DataRaw());
+    quantized_a.zero_point = *a_zero_point_tensor->Data<uint8_t>();
   }
 
   return ComputeCommon(ctx,
-                       a->Data<uint8_t>(),
+                       quantized_a,
                        a->Shape(),
-                       a_zero_point,
                        b,
-                       b_zero_point,
-                       a_scale * b_scale,
+                       ctx->Input<Tensor>(IN_B_SCALE),
+                       ctx->Input<Tensor>(IN_B_ZERO_POINT),
                        ctx->Input<Tensor>(IN_BIAS));
 }
 
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+#include <vector>
+
+namespace onnxruntime {
+namespace contrib {
+
+// Multiplies A with a weight B quantized to 4 bits block-wise along K. The blocks of B are dequantized as MLAS
+// multiplies them, so only the quantized weight is read from memory.
+class MatMulNBits final : public OpKernel {
+ public:
+  MatMulNBits(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("K", &K_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("N", &N_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("block_size", &block_size_));
+    const int64_t bits = info.GetAttrOrDefault<int64_t>("bits", 4);
+    ORT_ENFORCE(bits == 4, "MatMulNBits only supports 4 bits, got ", bits);
+    ORT_ENFORCE(K_ > 0 && N_ > 0, "MatMulNBits K and N must be positive");
+    ORT_ENFORCE(MlasQ4GemmIsBlockSizeSupported(static_cast<size_t>(block_size_)),
+                "MatMulNBits block_size must be a power of 2 from 16 to 256, got ", block_size_);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t K_;
+  int64_t N_;
+  int64_t block_size_;
+};
+
+Status MatMulNBits::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+  const Tensor* bias = ctx->Input<Tensor>(4);
+
+  const int64_t block_count_k = (K_ + block_size_ - 1) / block_size_;
+  ORT_RETURN_IF_NOT(b->Shape().Size() == N_ * block_count_k * (block_size_ / 2),
+                    "MatMulNBits input B must hold N * ceil(K / block_size) * block_size / 2 bytes, got shape ",
+                    b->Shape());
+  ORT_RETURN_IF_NOT(scales->Shape().Size() == N_ * block_count_k,
+                    "MatMulNBits scales must hold N * ceil(K / block_size) values, got shape ", scales->Shape());
+  ORT_RETURN_IF_NOT(zero_points == nullptr || zero_points->Shape().Size() == N_ * ((block_count_k + 1) / 2),
+                    "MatMulNBits zero_points must hold N * ceil(ceil(K / block_size) / 2) bytes, got shape ",
+                    zero_points->Shape());
+  ORT_RETURN_IF_NOT(bias == nullptr || bias->Shape().Size() == N_,
+                    "MatMulNBits bias must hold N values, got shape ", bias->Shape());
+
+  // B is seen as a [K, N] matrix for the output shape and the batch offsets of A
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), TensorShape({K_, N_})));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t batch_count = helper.OutputOffsets().size();
+
+  const auto* a_data = a->Data<float>();
+  auto* y_data = y->MutableData<float>();
+
+  std::vector<MLAS_Q4_GEMM_DATA_PARAMS> data(batch_count);
+  for (size_t i = 0; i < batch_count; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].QuantBData = b->Data<uint8_t>();
+    data[i].QuantBScale = scales->Data<float>();
+    data[i].QuantBZeroPoint = zero_points != nullptr ? zero_points->Data<uint8_t>() : nullptr;
+    data[i].Bias = bias != nullptr ? bias->Data<float>() : nullptr;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+
+  MlasQ4GemmBatch(M, N, K, static_cast<size_t>(block_size_), data.data(), batch_count,
+                  ctx->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MatMulNBits,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    MatMulNBits);
+
+}  // namespace contrib
+}  // namespace onnxruntime
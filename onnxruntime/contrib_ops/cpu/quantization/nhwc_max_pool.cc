@@ -1,16 +1,20 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/pool_attributes.h"
 #include "core/common/safeint.h"
 #include "core/util/math.h"
+#include "core/platform/threadpool.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+template <typename T>
 class NhwcMaxPool : public OpKernel {
  public:
   explicit NhwcMaxPool(const OpKernelInfo& info) : OpKernel(info),
@@ -23,7 +27,8 @@ class NhwcMaxPool : public OpKernel {
    PoolAttributes pool_attrs_;
 };
 
-Status NhwcMaxPool::Compute(OpKernelContext* context) const {
+template <typename T>
+Status NhwcMaxPool<T>::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const TensorShape& input_shape = X->Shape();
 
@@ -66,25 +71,38 @@ Status NhwcMaxPool::Compute(OpKernelContext* context) const {
 
   Tensor* Y = context->Output(0, output_dims);
 
+  if (output_image_size == 0 || N == 0) {
+    return Status::OK();
+  }
+
   constexpr int64_t output_batch_count = 512;
 
-  // Allocate indirection buffer pointers and prepare a padding vector for the
-  // im2col transform.
+  // Split each image into batches of output elements and distribute the
+  // batches across the thread pool. Each batch is transformed through its own
+  // indirection buffer, so the batches can be processed independently.
+  const int64_t batches_per_image = (output_image_size + output_batch_count - 1) / output_batch_count;
+  const int64_t total_batches = N * batches_per_image;
+  const int64_t col_buffer_batch_count = std::min(output_image_size, output_batch_count);
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-  int64_t col_buffer_batch_count = std::min(output_image_size, output_batch_count);
-  auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(const uint8_t*)) * kernel_size * col_buffer_batch_count);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  std::vector<uint8_t> padding_data(static_cast<size_t>(C), 0);
-
-  const auto* Xdata = X->template Data<uint8_t>();
-  auto* Ydata = Y->template MutableData<uint8_t>();
-
-  for (int64_t image_id = 0; image_id < N; ++image_id) {
-    for (int64_t output_start = 0; output_start < output_image_size;) {
-      int64_t output_count = std::min(output_image_size - output_start, output_batch_count);
-      math::Im2col<uint8_t, StorageOrder::NHWC>()(
-          Xdata,
+  std::vector<T> padding_data(static_cast<size_t>(C), std::numeric_limits<T>::lowest());
+
+  const auto* Xdata = X->template Data<T>();
+  auto* Ydata = Y->template MutableData<T>();
+
+  auto worker = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    // Allocate indirection buffer pointers for the im2col transform.
+    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(const T*)) * kernel_size * col_buffer_batch_count);
+    BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
+
+    for (std::ptrdiff_t batch = first; batch < last; ++batch) {
+      const int64_t image_id = batch / batches_per_image;
+      const int64_t output_start = (batch % batches_per_image) * output_batch_count;
+      const int64_t output_count = std::min(output_image_size - output_start, output_batch_count);
+
+      math::Im2col<T, StorageOrder::NHWC>()(
+          Xdata + image_id * input_image_size * C,
           C,
           input_shape.GetDims().data() + 1,
           output_dims.data() + 1,
@@ -95,33 +113,57 @@ Status NhwcMaxPool::Compute(OpKernelContext* context) const {
           static_cast<ptrdiff_t>(spatial_dims),
           output_start,
           output_count,
-          static_cast<uint8_t const**>(col_buffer.get()),
+          static_cast<T const**>(col_buffer.get()),
           padding_data.data());
       MlasMaximumPool(
-          static_cast<uint8_t const**>(col_buffer.get()),
-          Ydata,
+          static_cast<T const**>(col_buffer.get()),
+          Ydata + (image_id * output_image_size + output_start) * C,
           static_cast<size_t>(C),
           static_cast<size_t>(output_count),
           static_cast<size_t>(kernel_size));
-
-      Ydata += output_count * C;
-      output_start += output_count;
     }
+  };
 
-    Xdata += input_image_size * C;
-  }
+  const double batch_elements = static_cast<double>(col_buffer_batch_count * C);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(),
+      static_cast<std::ptrdiff_t>(total_batches),
+      TensorOpCost{batch_elements * kernel_size * sizeof(T), batch_elements * sizeof(T),
+                   batch_elements * kernel_size},
+      worker);
 
   return Status::OK();
 }
 
-ONNX_OPERATOR_KERNEL_EX(
+ONNX_OPERATOR_TYPED_KERNEL_EX(
     NhwcMaxPool,
     kMSDomain,
     1,
+    uint8_t,
     kCpuExecutionProvider,
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
-    NhwcMaxPool);
+    NhwcMaxPool<uint8_t>);
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    NhwcMaxPool,
+    kMSDomain,
+    1,
+    int8_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<int8_t>()),
+    NhwcMaxPool<int8_t>);
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    NhwcMaxPool,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcMaxPool<float>);
 
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #ifdef BUILD_MS_EXPERIMENTAL_OPS
 
+#include "contrib_ops/cpu/signal/fft.h"
+
 namespace onnxruntime {
 namespace contrib {
 
@@ -13,6 +15,9 @@ class DFT final : public OpKernel {
     is_onesided_ = info.GetAttrOrDefault<int64_t>("onesided", 0);
   }
   Status Compute(OpKernelContext* ctx) const override;
+
+ private:
+  mutable FFTPlanCache plans_;
 };
 
 class IDFT final : public OpKernel {
@@ -20,6 +25,9 @@ class IDFT final : public OpKernel {
   explicit IDFT(const OpKernelInfo& info) : OpKernel(info) {
   }
   Status Compute(OpKernelContext* ctx) const override;
+
+ private:
+  mutable FFTPlanCache plans_;
 };
 
 class STFT final : public OpKernel {
@@ -29,6 +37,9 @@ class STFT final : public OpKernel {
     is_onesided_ = info.GetAttrOrDefault<int64_t>("onesided", 1);
   }
   Status Compute(OpKernelContext* ctx) const override;
+
+ private:
+  mutable FFTPlanCache plans_;
 };
 
 }  // namespace contrib
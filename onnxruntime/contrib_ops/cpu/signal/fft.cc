@@ -0,0 +1,331 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef BUILD_MS_EXPERIMENTAL_OPS
+
+#include "contrib_ops/cpu/signal/fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// multiplies by +i when sign is positive and by -i otherwise
+template <typename T>
+inline std::complex<T> rotate(const std::complex<T>& value, T sign) {
+  return std::complex<T>(-sign * value.imag(), sign * value.real());
+}
+
+template <typename T>
+std::complex<T> unit_phasor(double angle) {
+  return std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+}
+
+template <typename T>
+void butterfly2(std::complex<T>* output, const std::complex<T>* twiddles, size_t twiddle_stride, size_t m) {
+  for (size_t u = 0; u < m; u++) {
+    const std::complex<T> t = output[u + m] * twiddles[u * twiddle_stride];
+    output[u + m] = output[u] - t;
+    output[u] += t;
+  }
+}
+
+template <typename T>
+void butterfly3(std::complex<T>* output, const std::complex<T>* twiddles, size_t twiddle_stride, size_t m,
+                T sign) {
+  const T half_sqrt3 = static_cast<T>(0.86602540378443864676);
+  for (size_t u = 0; u < m; u++) {
+    const std::complex<T> a0 = output[u];
+    const std::complex<T> a1 = output[u + m] * twiddles[u * twiddle_stride];
+    const std::complex<T> a2 = output[u + 2 * m] * twiddles[2 * u * twiddle_stride];
+    const std::complex<T> sum = a1 + a2;
+    const std::complex<T> base = a0 - sum * static_cast<T>(0.5);
+    const std::complex<T> difference = rotate(a1 - a2, sign) * half_sqrt3;
+    output[u] = a0 + sum;
+    output[u + m] = base + difference;
+    output[u + 2 * m] = base - difference;
+  }
+}
+
+template <typename T>
+void butterfly4(std::complex<T>* output, const std::complex<T>* twiddles, size_t twiddle_stride, size_t m,
+                T sign) {
+  for (size_t u = 0; u < m; u++) {
+    const std::complex<T> a0 = output[u];
+    const std::complex<T> a1 = output[u + m] * twiddles[u * twiddle_stride];
+    const std::complex<T> a2 = output[u + 2 * m] * twiddles[2 * u * twiddle_stride];
+    const std::complex<T> a3 = output[u + 3 * m] * twiddles[3 * u * twiddle_stride];
+    const std::complex<T> s0 = a0 + a2;
+    const std::complex<T> s1 = a0 - a2;
+    const std::complex<T> s2 = a1 + a3;
+    const std::complex<T> s3 = rotate(a1 - a3, sign);
+    output[u] = s0 + s2;
+    output[u + m] = s1 + s3;
+    output[u + 2 * m] = s0 - s2;
+    output[u + 3 * m] = s1 - s3;
+  }
+}
+
+template <typename T>
+void butterfly5(std::complex<T>* output, const std::complex<T>* twiddles, size_t twiddle_stride, size_t m,
+                T sign) {
+  const T c1 = static_cast<T>(std::cos(2 * kPi / 5));
+  const T c2 = static_cast<T>(std::cos(4 * kPi / 5));
+  const T s1 = static_cast<T>(std::sin(2 * kPi / 5));
+  const T s2 = static_cast<T>(std::sin(4 * kPi / 5));
+  for (size_t u = 0; u < m; u++) {
+    const std::complex<T> a0 = output[u];
+    const std::complex<T> a1 = output[u + m] * twiddles[u * twiddle_stride];
+    const std::complex<T> a2 = output[u + 2 * m] * twiddles[2 * u * twiddle_stride];
+    const std::complex<T> a3 = output[u + 3 * m] * twiddles[3 * u * twiddle_stride];
+    const std::complex<T> a4 = output[u + 4 * m] * twiddles[4 * u * twiddle_stride];
+    const std::complex<T> b1 = a1 + a4;
+    const std::complex<T> b2 = a2 + a3;
+    const std::complex<T> d1 = a1 - a4;
+    const std::complex<T> d2 = a2 - a3;
+    const std::complex<T> e1 = a0 + b1 * c1 + b2 * c2;
+    const std::complex<T> e2 = a0 + b1 * c2 + b2 * c1;
+    const std::complex<T> f1 = rotate(d1 * s1 + d2 * s2, sign);
+    const std::complex<T> f2 = rotate(d1 * s2 - d2 * s1, sign);
+    output[u] = a0 + b1 + b2;
+    output[u + m] = e1 + f1;
+    output[u + 2 * m] = e2 + f2;
+    output[u + 3 * m] = e2 - f2;
+    output[u + 4 * m] = e1 - f1;
+  }
+}
+
+}  // namespace
+
+template <typename T>
+FFTPlan<T>::FFTPlan(size_t length) : length_(length) {
+  ORT_ENFORCE(length > 0, "The FFT length must be positive.");
+
+  size_t remaining = length;
+  for (size_t radix : {4, 2, 3, 5}) {
+    while (remaining % radix == 0) {
+      remaining /= radix;
+      factors_.push_back(radix);
+      factors_.push_back(remaining);
+    }
+  }
+
+  if (remaining != 1) {
+    // Bluestein: X[k] = w[k] * sum_n (x[n] * w[n]) * conj(w[k - n]) with w[k] = e^(-pi i k^2 / N),
+    // evaluated as a circular convolution of a power of two length of at least 2N - 1
+    factors_.clear();
+    size_t convolution_length = 1;
+    while (convolution_length < 2 * length - 1) {
+      convolution_length <<= 1;
+    }
+    convolution_plan_ = std::make_unique<FFTPlan<T>>(convolution_length);
+
+    chirp_.resize(length);
+    for (size_t k = 0; k < length; k++) {
+      // reduce k^2 modulo 2N first so the angle stays accurate for long transforms
+      const auto k_squared = static_cast<double>((static_cast<uint64_t>(k) * k) % (2 * static_cast<uint64_t>(length)));
+      chirp_[k] = unit_phasor<T>(-kPi * k_squared / static_cast<double>(length));
+    }
+
+    // the transformed kernel includes the 1/M scaling of the inverse convolution transform
+    std::vector<std::complex<T>> kernel(convolution_length);
+    const T scale = static_cast<T>(1) / static_cast<T>(convolution_length);
+    for (int direction = 0; direction < 2; direction++) {
+      std::fill(kernel.begin(), kernel.end(), std::complex<T>());
+      for (size_t k = 0; k < length; k++) {
+        const std::complex<T> w = direction == 0 ? std::conj(chirp_[k]) : chirp_[k];
+        kernel[k] = w * scale;
+        if (k != 0) {
+          kernel[convolution_length - k] = w * scale;
+        }
+      }
+      kernel_[direction].resize(convolution_length);
+      convolution_plan_->Transform(kernel.data(), 1, kernel_[direction].data(), false, nullptr);
+    }
+    return;
+  }
+
+  twiddles_[0].resize(length);
+  twiddles_[1].resize(length);
+  for (size_t k = 0; k < length; k++) {
+    twiddles_[0][k] = unit_phasor<T>(-2 * kPi * static_cast<double>(k) / static_cast<double>(length));
+    twiddles_[1][k] = std::conj(twiddles_[0][k]);
+  }
+}
+
+template <typename T>
+size_t FFTPlan<T>::ScratchSize() const {
+  return convolution_plan_ ? 2 * convolution_plan_->Length() : 0;
+}
+
+template <typename T>
+void FFTPlan<T>::Transform(const std::complex<T>* input, size_t input_stride, std::complex<T>* output,
+                           bool inverse, std::complex<T>* scratch) const {
+  if (convolution_plan_) {
+    Bluestein(input, input_stride, output, inverse, scratch);
+  } else if (factors_.empty()) {
+    output[0] = input[0];
+  } else {
+    Work(input, input_stride, output, 1, factors_.data(), inverse);
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Work(const std::complex<T>* input, size_t input_stride, std::complex<T>* output,
+                      size_t twiddle_stride, const size_t* factors, bool inverse) const {
+  // decimation in time: transform the `radix` interleaved subsequences into consecutive blocks of `m` outputs,
+  // then combine them with one butterfly per output index
+  const size_t radix = factors[0];
+  const size_t m = factors[1];
+  const size_t step = twiddle_stride * input_stride;
+
+  if (m == 1) {
+    for (size_t k = 0; k < radix; k++) {
+      output[k] = input[k * step];
+    }
+  } else {
+    for (size_t k = 0; k < radix; k++) {
+      Work(input + k * step, input_stride, output + k * m, twiddle_stride * radix, factors + 2, inverse);
+    }
+  }
+
+  const std::complex<T>* twiddles = twiddles_[inverse ? 1 : 0].data();
+  const T sign = inverse ? static_cast<T>(1) : static_cast<T>(-1);
+  switch (radix) {
+    case 2:
+      butterfly2(output, twiddles, twiddle_stride, m);
+      break;
+    case 3:
+      butterfly3(output, twiddles, twiddle_stride, m, sign);
+      break;
+    case 4:
+      butterfly4(output, twiddles, twiddle_stride, m, sign);
+      break;
+    case 5:
+      butterfly5(output, twiddles, twiddle_stride, m, sign);
+      break;
+    default:
+      ORT_THROW("Unexpected FFT radix ", radix);
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Bluestein(const std::complex<T>* input, size_t input_stride, std::complex<T>* output,
+                           bool inverse, std::complex<T>* scratch) const {
+  const size_t convolution_length = convolution_plan_->Length();
+  std::complex<T>* sequence = scratch;
+  std::complex<T>* spectrum = scratch + convolution_length;
+
+  for (size_t k = 0; k < length_; k++) {
+    const std::complex<T> w = inverse ? std::conj(chirp_[k]) : chirp_[k];
+    sequence[k] = input[k * input_stride] * w;
+  }
+  std::fill(sequence + length_, sequence + convolution_length, std::complex<T>());
+
+  convolution_plan_->Transform(sequence, 1, spectrum, false, nullptr);
+  const std::complex<T>* kernel = kernel_[inverse ? 1 : 0].data();
+  for (size_t k = 0; k < convolution_length; k++) {
+    spectrum[k] *= kernel[k];
+  }
+  convolution_plan_->Transform(spectrum, 1, sequence, true, nullptr);
+
+  for (size_t k = 0; k < length_; k++) {
+    const std::complex<T> w = inverse ? std::conj(chirp_[k]) : chirp_[k];
+    output[k] = sequence[k] * w;
+  }
+}
+
+template <typename T>
+RealFFTPlan<T>::RealFFTPlan(size_t length) : length_(length), half_plan_(length / 2) {
+  ORT_ENFORCE(length >= 2 && length % 2 == 0, "The real FFT length must be even.");
+
+  twiddles_.resize(length / 2 + 1);
+  for (size_t k = 0; k <= length / 2; k++) {
+    twiddles_[k] = unit_phasor<T>(-2 * kPi * static_cast<double>(k) / static_cast<double>(length));
+  }
+}
+
+template <typename T>
+size_t RealFFTPlan<T>::ScratchSize() const {
+  return length_ + half_plan_.ScratchSize();
+}
+
+template <typename T>
+void RealFFTPlan<T>::Transform(const T* input, size_t input_stride, std::complex<T>* output, size_t output_size,
+                               std::complex<T>* scratch) const {
+  // pack the even and odd samples as the real and imaginary parts of a half length complex signal z, then
+  // separate the spectra of the even (E) and odd (O) samples using the conjugate symmetry of real signals:
+  //   E[k] = (Z[k] + conj(Z[H - k])) / 2,  O[k] = -i (Z[k] - conj(Z[H - k])) / 2,  X[k] = E[k] + W^k O[k]
+  const size_t half = length_ / 2;
+  std::complex<T>* packed = scratch;
+  std::complex<T>* spectrum = scratch + half;
+
+  for (size_t n = 0; n < half; n++) {
+    packed[n] = std::complex<T>(input[2 * n * input_stride], input[(2 * n + 1) * input_stride]);
+  }
+  half_plan_.Transform(packed, 1, spectrum, false, scratch + length_);
+
+  const size_t unique_bins = std::min(output_size, half + 1);
+  for (size_t k = 0; k < unique_bins; k++) {
+    const std::complex<T> z = spectrum[k == half ? 0 : k];
+    const std::complex<T> z_mirror = std::conj(spectrum[k == 0 ? 0 : half - k]);
+    const std::complex<T> even = (z + z_mirror) * static_cast<T>(0.5);
+    const std::complex<T> odd = rotate(z - z_mirror, static_cast<T>(-1)) * static_cast<T>(0.5);
+    output[k] = even + twiddles_[k] * odd;
+  }
+  for (size_t k = unique_bins; k < output_size; k++) {
+    output[k] = std::conj(output[length_ - k]);
+  }
+}
+
+template <>
+FFTPlanCache::Plans<float>& FFTPlanCache::GetPlans<float>() {
+  return float_plans_;
+}
+
+template <>
+FFTPlanCache::Plans<double>& FFTPlanCache::GetPlans<double>() {
+  return double_plans_;
+}
+
+template <typename T>
+std::shared_ptr<const FFTPlan<T>> FFTPlanCache::GetPlan(size_t length) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& plan = GetPlans<T>().complex[length];
+  if (!plan) {
+    plan = std::make_shared<const FFTPlan<T>>(length);
+  }
+  return plan;
+}
+
+template <typename T>
+std::shared_ptr<const RealFFTPlan<T>> FFTPlanCache::GetRealPlan(size_t length) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& plan = GetPlans<T>().real[length];
+  if (!plan) {
+    plan = std::make_shared<const RealFFTPlan<T>>(length);
+  }
+  return plan;
+}
+
+template class FFTPlan<float>;
+template class FFTPlan<double>;
+template class RealFFTPlan<float>;
+template class RealFFTPlan<double>;
+template std::shared_ptr<const FFTPlan<float>> FFTPlanCache::GetPlan<float>(size_t);
+template std::shared_ptr<const FFTPlan<double>> FFTPlanCache::GetPlan<double>(size_t);
+template std::shared_ptr<const RealFFTPlan<float>> FFTPlanCache::GetRealPlan<float>(size_t);
+template std::shared_ptr<const RealFFTPlan<double>> FFTPlanCache::GetRealPlan<double>(size_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#ifdef BUILD_MS_EXPERIMENTAL_OPS
+
+#include <complex>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Precomputed tables for a complex FFT of a fixed length.
+// Lengths whose prime factors are 2, 3 and 5 use a mixed-radix (2/3/4/5) decimation in time transform.
+// Other lengths use Bluestein's algorithm on top of a power of two transform.
+// A plan is immutable once built and may be shared between threads.
+template <typename T>
+class FFTPlan {
+ public:
+  explicit FFTPlan(size_t length);
+
+  size_t Length() const { return length_; }
+
+  // Number of complex elements of scratch space Transform needs.
+  size_t ScratchSize() const;
+
+  // Computes the unscaled forward (e^-i) or inverse (e^+i) DFT of `input` into `output`.
+  // Input elements are read `input_stride` elements apart. `input` and `output` must not overlap.
+  void Transform(const std::complex<T>* input, size_t input_stride, std::complex<T>* output, bool inverse,
+                 std::complex<T>* scratch) const;
+
+ private:
+  void Work(const std::complex<T>* input, size_t input_stride, std::complex<T>* output, size_t twiddle_stride,
+            const size_t* factors, bool inverse) const;
+
+  void Bluestein(const std::complex<T>* input, size_t input_stride, std::complex<T>* output, bool inverse,
+                 std::complex<T>* scratch) const;
+
+  size_t length_;
+
+  // (radix, remaining length) pairs, outermost stage first
+  std::vector<size_t> factors_;
+
+  // e^(-2 pi i k / length) and its conjugate
+  std::vector<std::complex<T>> twiddles_[2];
+
+  // Bluestein state: the chirp e^(-pi i k^2 / length), the transformed convolution kernel for each direction and
+  // the power of two plan used for the convolution
+  std::vector<std::complex<T>> chirp_;
+  std::vector<std::complex<T>> kernel_[2];
+  std::unique_ptr<FFTPlan<T>> convolution_plan_;
+};
+
+// FFT of a real signal of even length computed with a complex FFT of half the length.
+template <typename T>
+class RealFFTPlan {
+ public:
+  explicit RealFFTPlan(size_t length);
+
+  size_t Length() const { return length_; }
+
+  size_t ScratchSize() const;
+
+  // Computes the first `output_size` (at most length) bins of the unscaled forward DFT of `input`, which is read
+  // `input_stride` elements apart. Bins above length / 2 are filled from the conjugate symmetry.
+  void Transform(const T* input, size_t input_stride, std::complex<T>* output, size_t output_size,
+                 std::complex<T>* scratch) const;
+
+ private:
+  size_t length_;
+  FFTPlan<T> half_plan_;
+
+  // e^(-2 pi i k / length) for k in [0, length / 2]
+  std::vector<std::complex<T>> twiddles_;
+};
+
+// Plans built by a kernel, keyed by element type and length, so repeated runs do not recompute the tables.
+class FFTPlanCache {
+ public:
+  template <typename T>
+  std::shared_ptr<const FFTPlan<T>> GetPlan(size_t length);
+
+  template <typename T>
+  std::shared_ptr<const RealFFTPlan<T>> GetRealPlan(size_t length);
+
+ private:
+  template <typename T>
+  struct Plans {
+    std::unordered_map<size_t, std::shared_ptr<const FFTPlan<T>>> complex;
+    std::unordered_map<size_t, std::shared_ptr<const RealFFTPlan<T>>> real;
+  };
+
+  template <typename T>
+  Plans<T>& GetPlans();
+
+  OrtMutex mutex_;
+  Plans<float> float_plans_;
+  Plans<double> double_plans_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif
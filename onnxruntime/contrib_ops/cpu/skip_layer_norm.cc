@@ -5,6 +5,8 @@
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
+#include "core/mlas/inc/mlas.h"
+#include "layer_norm.h"
 #include "skip_layer_norm.h"
 
 namespace onnxruntime {
@@ -23,6 +25,60 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+
+void ComputeRow(const double* input, const double* skip, const double* gamma, const double* beta, const double* bias,
+                double* output, int64_t hidden_size, float epsilon, std::vector<float>& /*buffer*/) {
+  double mean = 0;
+  double mean_square = 0;
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    double value = input[h] + skip[h];
+    if (nullptr != bias) {
+      value += bias[h];
+    }
+    output[h] = value;
+    mean += value;
+    mean_square += value * value;
+  }
+
+  mean = mean / hidden_size;
+  mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon);
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    if (nullptr == beta) {
+      output[h] = (output[h] - mean) / mean_square * gamma[h];
+    } else {
+      output[h] = (output[h] - mean) / mean_square * gamma[h] + beta[h];
+    }
+  }
+}
+
+// The sum of input, skip and bias is stored to output in the same pass that computes its moments.
+void ComputeRow(const float* input, const float* skip, const float* gamma, const float* beta, const float* bias,
+                float* output, int64_t hidden_size, float epsilon, std::vector<float>& /*buffer*/) {
+  float mean;
+  float variance;
+  MlasComputeAddMeanVariance(input, skip, bias, output, static_cast<size_t>(hidden_size), &mean, &variance);
+  MlasComputeNormalization(output, output, static_cast<size_t>(hidden_size), mean, 1.0f / std::sqrt(variance + epsilon),
+                           gamma, beta);
+}
+
+void ComputeRow(const MLFloat16* input, const MLFloat16* skip, const float* gamma, const float* beta,
+                const float* bias, MLFloat16* output, int64_t hidden_size, float epsilon, std::vector<float>& buffer) {
+  const size_t size = static_cast<size_t>(hidden_size);
+  buffer.resize(2 * size);
+  float* input_buffer = buffer.data();
+  float* skip_buffer = input_buffer + size;
+  MlasConvertHalfToFloat(&input->val, input_buffer, size);
+  MlasConvertHalfToFloat(&skip->val, skip_buffer, size);
+  ComputeRow(input_buffer, skip_buffer, gamma, beta, bias, input_buffer, hidden_size, epsilon, buffer);
+  MlasConvertFloatToHalf(input_buffer, &output->val, size);
+}
+
+}  // namespace
 
 template <typename T>
 SkipLayerNorm<T>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
@@ -92,42 +148,27 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
 
   const T* input_data = input->Data<T>();
   const T* skip_data = skip->Data<T>();
-  const T* gamma_data = gamma->Data<T>();
-  const T* beta_data = beta == nullptr ? nullptr : beta->Data<T>();
-  const T* bias_data = bias == nullptr ? nullptr : bias->Data<T>();
+
+  std::vector<float> gamma_buffer;
+  std::vector<float> beta_buffer;
+  std::vector<float> bias_buffer;
+  const auto* gamma_data = LayerNormParameterData<T>(gamma, gamma_buffer);
+  const auto* beta_data = LayerNormParameterData<T>(beta, beta_buffer);
+  const auto* bias_data = LayerNormParameterData<T>(bias, bias_buffer);
 
   T* output_data = output->MutableData<T>();
 
-  concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
-                                               [&](ptrdiff_t task_idx) {
-                                                 const T* p_input = input_data + task_idx * hidden_size;
-                                                 const T* p_skip = skip_data + task_idx * hidden_size;
-                                                 T* p_output = output_data + task_idx * hidden_size;
-
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   T value = p_input[h] + p_skip[h];
-                                                   if (nullptr != bias_data) {
-                                                     value += bias_data[h];
-                                                   }
-                                                   p_output[h] = value;
-                                                   mean += value;
-                                                   mean_square += value * value;
-                                                 }
-
-                                                 mean = mean / hidden_size;
-                                                 mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   if (nullptr == beta_data) {
-                                                     p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
-                                                   } else {
-                                                     p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
-                                                   }
-                                                 }
-                                               }, 0);
+  const double bytes = static_cast<double>(hidden_size * sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(
+      p_ctx->GetOperatorThreadPool(), task_count,
+      TensorOpCost{2 * bytes, bytes, static_cast<double>(hidden_size) * 5},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> buffer;
+        for (std::ptrdiff_t task_idx = first; task_idx < last; ++task_idx) {
+          ComputeRow(input_data + task_idx * hidden_size, skip_data + task_idx * hidden_size, gamma_data, beta_data,
+                     bias_data, output_data + task_idx * hidden_size, hidden_size, epsilon_, buffer);
+        }
+      });
 
   return Status::OK();
 }
@@ -1,15 +1,125 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+
 #include "core/common/common.h"
 #include "core/common/utf8_util.h"
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
 #include "re2/re2.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace tokenizer_details {
+const char start_text = 0x2;
+const char end_text = 0x3;
+
+// Separators without regex operators are plain strings. An Aho-Corasick automaton over them
+// finds the occurrences of all of them in a single pass over the text, instead of one regex
+// search per separator and per token.
+class SeparatorMatcher {
+ public:
+  // Position in the text and index of the separator
+  using Occurrence = std::pair<size_t, size_t>;
+
+  explicit SeparatorMatcher(const std::vector<std::string>& separators);
+
+  static bool IsLiteral(const std::string& separator);
+
+  // Appends all the occurrences of the separators in the text, including overlapping ones
+  void FindAll(re2::StringPiece text, std::vector<Occurrence>& occurrences) const;
+
+  size_t SeparatorLength(size_t separator) const { return lengths_[separator]; }
+
+ private:
+  static constexpr size_t kAlphabetSize = 256;
+
+  // Goto function completed with the failure transitions, indexed by state * kAlphabetSize + byte
+  std::vector<int32_t> transitions_;
+  // Separator ending at the state, or -1. A repeated separator keeps the index of its first
+  // occurrence, since the first one already splits the text everywhere the repeated one would.
+  std::vector<int32_t> separator_;
+  // Closest state on the failure chain at which a separator ends, or -1
+  std::vector<int32_t> output_link_;
+  std::vector<size_t> lengths_;
+};
+
+SeparatorMatcher::SeparatorMatcher(const std::vector<std::string>& separators)
+    : transitions_(kAlphabetSize, -1), separator_(1, -1) {
+  for (size_t i = 0; i < separators.size(); ++i) {
+    const auto& sep = separators[i];
+    int32_t state = 0;
+    for (const char c : sep) {
+      const size_t index = state * kAlphabetSize + static_cast<unsigned char>(c);
+      if (transitions_[index] < 0) {
+        transitions_[index] = static_cast<int32_t>(separator_.size());
+        transitions_.resize(transitions_.size() + kAlphabetSize, -1);
+        separator_.push_back(-1);
+      }
+      state = transitions_[index];
+    }
+    if (separator_[state] < 0) {
+      separator_[state] = static_cast<int32_t>(i);
+    }
+    lengths_.push_back(sep.size());
+  }
+
+  // Breadth first, so that the transitions of the failure state of a state are complete before the state
+  const size_t num_states = separator_.size();
+  std::vector<int32_t> failure(num_states, 0);
+  output_link_.assign(num_states, -1);
+  std::queue<int32_t> states;
+  for (size_t c = 0; c < kAlphabetSize; ++c) {
+    if (transitions_[c] < 0) {
+      transitions_[c] = 0;
+    } else {
+      states.push(transitions_[c]);
+    }
+  }
+  while (!states.empty()) {
+    const int32_t state = states.front();
+    states.pop();
+    for (size_t c = 0; c < kAlphabetSize; ++c) {
+      const int32_t fallback = transitions_[failure[state] * kAlphabetSize + c];
+      int32_t& next = transitions_[state * kAlphabetSize + c];
+      if (next < 0) {
+        next = fallback;
+      } else {
+        failure[next] = fallback;
+        output_link_[next] = separator_[fallback] >= 0 ? fallback : output_link_[fallback];
+        states.push(next);
+      }
+    }
+  }
+}
+
+bool SeparatorMatcher::IsLiteral(const std::string& separator) {
+  size_t utf8_chars = 0;
+  return !separator.empty() &&
+         separator.find_first_of("\\^$.|?*+()[]{}") == std::string::npos &&
+         utf8_util::utf8_validate(reinterpret_cast<const unsigned char*>(separator.data()), separator.size(),
+                                  utf8_chars);
+}
+
+void SeparatorMatcher::FindAll(re2::StringPiece text, std::vector<Occurrence>& occurrences) const {
+  int32_t state = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    state = transitions_[state * kAlphabetSize + static_cast<unsigned char>(text[i])];
+    for (int32_t s = separator_[state] >= 0 ? state : output_link_[state]; s >= 0; s = output_link_[s]) {
+      const size_t sep = static_cast<size_t>(separator_[s]);
+      occurrences.emplace_back(i + 1 - lengths_[sep], sep);
+    }
+  }
+}
+}  // namespace tokenizer_details
+
 class Tokenizer final : public OpKernel {
  public:
   explicit Tokenizer(const OpKernelInfo& info);
@@ -20,6 +130,8 @@ class Tokenizer final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  using Row = std::vector<re2::StringPiece>;
+
   Status CharTokenize(OpKernelContext* context, size_t N, size_t C,
                       const std::vector<int64_t>& input_dims) const;
 
@@ -30,11 +142,22 @@ class Tokenizer final : public OpKernel {
                          size_t N, size_t C,
                          const std::vector<int64_t>& input_dims) const;
 
+  // Tokenization of a single input string into its row of tokens
+  Status SplitBySeparators(const std::string& s, Row& row) const;
+  void SplitByLiteralSeparators(const std::string& s, Row& row) const;
+  Status MatchTokenExpression(const std::string& s, Row& row) const;
+
+  // Writes the rows of tokens, with the markers and the padding, to the output
+  void OutputRows(OpKernelContext* ctx, const std::vector<Row>& rows,
+                  const std::vector<int64_t>& input_dims) const;
+
   bool mark_{false};
   std::string pad_value_;
   int64_t mincharnum_{0};
   bool char_tokenezation_{false};
   std::vector<std::unique_ptr<re2::RE2>> separators_;
+  // Set when none of the separators is a regular expression
+  std::unique_ptr<tokenizer_details::SeparatorMatcher> literal_separators_;
   std::unique_ptr<re2::RE2> regex_;
 };
 
@@ -48,11 +171,6 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<std::string>()),
     contrib::Tokenizer);
 
-namespace tokenizer_details {
-const char start_text = 0x2;
-const char end_text = 0x3;
-}  // namespace tokenizer_details
-
 using namespace tokenizer_details;
 
 Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
@@ -99,6 +217,9 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
         }
         separators_.push_back(std::move(regex));
       }
+      if (std::all_of(separators.cbegin(), separators.cend(), SeparatorMatcher::IsLiteral)) {
+        literal_separators_ = std::make_unique<SeparatorMatcher>(separators);
+      }
     } else {
       // Use tokenexp
       assert(!tokenexp.empty());
@@ -113,27 +234,69 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 }
 
+namespace {
+// Runs fn on every input string, in parallel. As with a sequential loop, the error
+// returned is the one of the first failing string.
+Status ForEachString(OpKernelContext* ctx, const std::string* input, size_t count,
+                     const std::function<Status(size_t)>& fn) {
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    total_bytes += input[i].size();
+  }
+  // A few cycles per byte for the utf8 validation and the matching
+  const double cost = 16.0 * static_cast<double>(total_bytes) / count + 64.0;
+
+  OrtMutex error_mutex;
+  size_t error_index = count;
+  Status error;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(count), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          Status status = fn(static_cast<size_t>(i));
+          if (!status.IsOK()) {
+            std::lock_guard<OrtMutex> lock(error_mutex);
+            if (static_cast<size_t>(i) < error_index) {
+              error_index = static_cast<size_t>(i);
+              error = status;
+            }
+            return;
+          }
+        }
+      });
+  return error;
+}
+
+Status ValidateUtf8(const std::string& s) {
+  size_t utf8_chars = 0;
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
+  }
+  return Status::OK();
+}
+}  // namespace
+
 Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
                                const std::vector<int64_t>& input_dims) const {
   // With char tokenzation we get as many tokens as the number of
   // utf8 characters in the string. So for every string we calculate its character(utf8) length
   // add padding and add start/end test separators if necessary
-  size_t max_tokens = 0;
   auto X = ctx->Input<Tensor>(0);
   auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
+  std::vector<size_t> row_tokens(N * C);
+  ORT_RETURN_IF_ERROR(ForEachString(ctx, input_data, N * C, [&](size_t i) {
+    const auto& s = input_data[i];
     size_t tokens = 0;  // length in utf8 chars
     if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
                        tokens)) {
       return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                     "Input string contains invalid utf8 chars: " + s);
     }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
-  }
+    row_tokens[i] = tokens;
+    return Status::OK();
+  }));
+  size_t max_tokens = row_tokens.empty() ? 0 : *std::max_element(row_tokens.cbegin(), row_tokens.cend());
 
   std::vector<int64_t> output_dims(input_dims);
   // Check if we have no output due to apparently empty strings input.
@@ -152,126 +315,169 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   TensorShape output_shape(output_dims);
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->template MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      (void)result;
-      assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (mark_ * 2) <= max_tokens);
-    const size_t pads = max_tokens - (mark_ * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
-  }
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(N * C), 32.0 * max_tokens,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const auto& s = input_data[i];
+          size_t output_index = static_cast<size_t>(i) * max_tokens;
+          if (mark_) {
+            (output_data + output_index)->assign(&start_text, 1);
+            ++output_index;
+          }
+          const size_t str_len = s.size();
+          for (size_t token_idx = 0; token_idx < str_len;) {
+            size_t tlen = 0;
+            bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+            assert(result);
+            (void)result;
+            assert(token_idx + tlen <= str_len);
+            (output_data + output_index)->assign(s.data() + token_idx, tlen);
+            ++output_index;
+            token_idx += tlen;
+          }
+          if (mark_) {
+            (output_data + output_index)->assign(&end_text, 1);
+            ++output_index;
+          }
+          // Padding strings
+          assert(row_tokens[i] + (mark_ * 2) <= max_tokens);
+          for (const size_t row_end = static_cast<size_t>(i + 1) * max_tokens; output_index < row_end; ++output_index) {
+            *(output_data + output_index) = pad_value_;
+          }
+        }
+      });
   return Status::OK();
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::SplitBySeparators(const std::string& s, Row& row) const {
   using namespace re2;
-  std::vector<std::vector<StringPiece>> rows;
-  rows.reserve(N * C);
+  ORT_RETURN_IF_ERROR(ValidateUtf8(s));
+  if (literal_separators_ != nullptr) {
+    SplitByLiteralSeparators(s, row);
+    return Status::OK();
+  }
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t utf8_chars = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    std::vector<StringPiece> row{s};
-
-    for (const auto& sep : separators_) {
-      std::vector<StringPiece> tokens;
-      for (const auto& text : row) {
-        const auto end_pos = text.length();
-        size_t start_pos = 0;
-        StringPiece submatch;
-
-        bool match = true;
-        do {
-          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-          if (match) {
-            // Record  pos/len
-            assert(submatch.data() != nullptr);
-            size_t match_pos = submatch.data() - text.data();
-            assert(match_pos >= start_pos);
-            auto token_len = match_pos - start_pos;
-            utf8_chars = 0;
-            bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                                  token_len, utf8_chars);
-            if (!valid) {
-              return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                            "Match contains invalid utf8 chars: " + submatch.as_string());
-            }
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, token_len);
-            }
-            // Update starting position
-            // Guard against empty string match
-            auto match_len = submatch.length();
-            if (match_len > 0) {
-              start_pos = match_pos + match_len;
-            } else {
-              size_t bytes = 0;
-              utf8_bytes(*submatch.data(), bytes);
-              start_pos = match_pos + bytes;
-            }
+  row.emplace_back(s);
+  size_t utf8_chars = 0;
+  for (const auto& sep : separators_) {
+    std::vector<StringPiece> tokens;
+    for (const auto& text : row) {
+      const auto end_pos = text.length();
+      size_t start_pos = 0;
+      StringPiece submatch;
+
+      bool match = true;
+      do {
+        match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+        if (match) {
+          // Record  pos/len
+          assert(submatch.data() != nullptr);
+          size_t match_pos = submatch.data() - text.data();
+          assert(match_pos >= start_pos);
+          auto token_len = match_pos - start_pos;
+          utf8_chars = 0;
+          bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                                token_len, utf8_chars);
+          if (!valid) {
+            return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                          "Match contains invalid utf8 chars: " + submatch.as_string());
+          }
+          if (utf8_chars >= size_t(mincharnum_)) {
+            tokens.emplace_back(text.data() + start_pos, token_len);
+          }
+          // Update starting position
+          // Guard against empty string match
+          auto match_len = submatch.length();
+          if (match_len > 0) {
+            start_pos = match_pos + match_len;
           } else {
-            // record trailing token
-            auto trailing_len = end_pos - start_pos;
-            utf8_chars = 0;
-            utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                     trailing_len, utf8_chars);
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, trailing_len);
-            }
+            size_t bytes = 0;
+            utf8_bytes(*submatch.data(), bytes);
+            start_pos = match_pos + bytes;
+          }
+        } else {
+          // record trailing token
+          auto trailing_len = end_pos - start_pos;
+          utf8_chars = 0;
+          utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                   trailing_len, utf8_chars);
+          if (utf8_chars >= size_t(mincharnum_)) {
+            tokens.emplace_back(text.data() + start_pos, trailing_len);
           }
-        } while (match);
-      }  // row
-      // Replace the row with the results of this tokenezation
-      row.swap(tokens);
-    }  // separators_
+        }
+      } while (match);
+    }  // row
+    // Replace the row with the results of this tokenezation
+    row.swap(tokens);
+  }  // separators_
+  return Status::OK();
+}
+
+// Gives the same tokens as splitting by each separator in turn: the occurrences of a separator
+// are taken leftmost first, skipping those overlapping a previous occurrence of the same separator
+// or of a separator listed before it. The tokens left between the occurrences are kept.
+void Tokenizer::SplitByLiteralSeparators(const std::string& s, Row& row) const {
+  using Occurrence = SeparatorMatcher::Occurrence;
+  std::vector<Occurrence> occurrences;
+  literal_separators_->FindAll(s, occurrences);
+  std::sort(occurrences.begin(), occurrences.end(), [](const Occurrence& lhs, const Occurrence& rhs) {
+    return lhs.second != rhs.second ? lhs.second < rhs.second : lhs.first < rhs.first;
+  });
+
+  // Non overlapping [begin, end) byte ranges of the taken occurrences, ordered by position
+  std::vector<std::pair<size_t, size_t>> cuts;
+  std::vector<std::pair<size_t, size_t>> separator_cuts;
+  std::vector<std::pair<size_t, size_t>> merged_cuts;
+  for (auto it = occurrences.cbegin(); it != occurrences.cend();) {
+    const size_t sep = it->second;
+    const size_t length = literal_separators_->SeparatorLength(sep);
+    size_t last_end = 0;
+    separator_cuts.clear();
+    for (; it != occurrences.cend() && it->second == sep; ++it) {
+      const size_t begin = it->first;
+      const size_t end = begin + length;
+      if (begin < last_end) {
+        continue;
+      }
+      // Only the last cut starting before the end of the occurrence may overlap it
+      auto next = std::lower_bound(cuts.cbegin(), cuts.cend(), std::make_pair(end, size_t{0}));
+      if (next != cuts.cbegin() && std::prev(next)->second > begin) {
+        continue;
+      }
+      separator_cuts.emplace_back(begin, end);
+      last_end = end;
+    }
+    merged_cuts.clear();
+    std::merge(cuts.cbegin(), cuts.cend(), separator_cuts.cbegin(), separator_cuts.cend(),
+               std::back_inserter(merged_cuts));
+    cuts.swap(merged_cuts);
+  }
+
+  auto add_token = [this, &s, &row](size_t begin, size_t end) {
+    size_t utf8_chars = 0;
+    utf8_len(reinterpret_cast<const unsigned char*>(s.data() + begin), end - begin, utf8_chars);
+    if (utf8_chars >= size_t(mincharnum_)) {
+      row.emplace_back(s.data() + begin, end - begin);
+    }
+  };
+  size_t start_pos = 0;
+  for (const auto& cut : cuts) {
+    add_token(start_pos, cut.first);
+    start_pos = cut.second;
+  }
+  add_token(start_pos, s.size());
+}
+
+void Tokenizer::OutputRows(OpKernelContext* ctx, const std::vector<Row>& rows,
+                           const std::vector<int64_t>& input_dims) const {
+  size_t max_tokens = 0;
+  for (const auto& row : rows) {
     max_tokens = std::max(max_tokens, row.size());
-    rows.push_back(std::move(row));
-    ++curr_input;
   }
 
   std::vector<int64_t> output_dims(input_dims);
@@ -281,7 +487,7 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
     output_dims.push_back(0);
     TensorShape output_shape(output_dims);
     ctx->Output(0, output_shape);
-    return Status::OK();
+    return;
   }
 
   if (mark_) {
@@ -294,165 +500,102 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->template MutableData<std::string>();
 
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  curr_input = input_data;
-  for (auto& row : rows) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.size());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
-  }
-  return Status::OK();
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(rows.size()), 32.0 * max_tokens,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const auto& row = rows[i];
+          size_t output_index = static_cast<size_t>(i) * max_tokens;
+          if (mark_) {
+            (output_data + output_index)->assign(&start_text, 1);
+            ++output_index;
+          }
+          // Output tokens for this row
+          for (const auto& token : row) {
+            (output_data + output_index)->assign(token.data(), token.size());
+            ++output_index;
+          }
+          if (mark_) {
+            (output_data + output_index)->assign(&end_text, 1);
+            ++output_index;
+          }
+          assert(row.size() + (mark_ * 2) <= max_tokens);
+          for (const size_t row_end = static_cast<size_t>(i + 1) * max_tokens; output_index < row_end; ++output_index) {
+            *(output_data + output_index) = pad_value_;
+          }
+        }
+      });
 }
 
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  const std::vector<int64_t>& input_dims) const {
-  using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  std::vector<std::vector<StringPiece>> tokens;
-  tokens.reserve(N * C);
-
-  size_t max_tokens = 0;
+Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
+                                               size_t N, size_t C,
+                                               const std::vector<int64_t>& input_dims) const {
+  // Scan all strings and attempt to find separators in them
+  // collect all the output tokens here
   auto X = ctx->Input<Tensor>(0);
   auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
+  std::vector<Row> rows(N * C);
+  ORT_RETURN_IF_ERROR(ForEachString(ctx, input_data, N * C, [&](size_t i) {
+    return SplitBySeparators(input_data[i], rows[i]);
+  }));
+
+  OutputRows(ctx, rows, input_dims);
+  return Status::OK();
+}
+
+Status Tokenizer::MatchTokenExpression(const std::string& s, Row& row) const {
+  using namespace re2;
+  ORT_RETURN_IF_ERROR(ValidateUtf8(s));
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-
-    size_t utf8_chars = 0;
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    tokens.emplace_back();
-    auto& row = tokens.back();
-
-    StringPiece text(s);
-    const auto end_pos = s.length();
-    size_t start_pos = 0;
-    StringPiece submatch;
-
-    bool match = true;
-    do {
-      match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-      if (match) {
-        // Record  pos/len
-        assert(submatch.data() != nullptr);
-        size_t match_pos = submatch.data() - s.data();
-        assert(match_pos >= start_pos);
-        // Guard against empty match and make
-        // sure we make progress either way
-        auto token_len = submatch.length();
-        utf8_chars = 0;
-        if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Match contains invalid utf8 chars: " + submatch.as_string());
-        }
-        if (utf8_chars >= size_t(mincharnum_)) {
-          row.push_back(submatch);
-          start_pos = match_pos + token_len;
-        } else {
-          size_t bytes = 0;
-          utf8_bytes(*submatch.data(), bytes);
-          start_pos = match_pos + bytes;
-        }
+  StringPiece text(s);
+  const auto end_pos = s.length();
+  size_t start_pos = 0;
+  StringPiece submatch;
+
+  bool match = true;
+  do {
+    match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+    if (match) {
+      // Record  pos/len
+      assert(submatch.data() != nullptr);
+      size_t match_pos = submatch.data() - s.data();
+      assert(match_pos >= start_pos);
+      // Guard against empty match and make
+      // sure we make progress either way
+      auto token_len = submatch.length();
+      size_t utf8_chars = 0;
+      if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
+        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                      "Match contains invalid utf8 chars: " + submatch.as_string());
+      }
+      if (utf8_chars >= size_t(mincharnum_)) {
+        row.push_back(submatch);
+        start_pos = match_pos + token_len;
+      } else {
+        size_t bytes = 0;
+        utf8_bytes(*submatch.data(), bytes);
+        start_pos = match_pos + bytes;
       }
-    } while (match);
-    max_tokens = std::max(max_tokens, row.size());
-    ++curr_input;
-  }
-
-  // Check for empty output
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  curr_input = input_data;
-  size_t output_index = 0;
-  for (const auto& row : tokens) {
-    assert(curr_input != last);
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.length());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
     }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
-  }
+  } while (match);
+  return Status::OK();
+}
+
+Status Tokenizer::TokenExpression(OpKernelContext* ctx,
+                                  size_t N, size_t C,
+                                  const std::vector<int64_t>& input_dims) const {
+  auto X = ctx->Input<Tensor>(0);
+  auto const input_data = X->template Data<std::string>();
+  std::vector<Row> rows(N * C);
+  ORT_RETURN_IF_ERROR(ForEachString(ctx, input_data, N * C, [&](size_t i) {
+    return MatchTokenExpression(input_data[i], rows[i]);
+  }));
 
+  OutputRows(ctx, rows, input_dims);
   return Status::OK();
 }
 
@@ -0,0 +1,654 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/transformers/beam_search.h"
+
+#include <cstring>
+
+#include "core/framework/framework_common.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/framework/utils.h"
+#include "contrib_ops/cpu/transformers/beam_search_scorer.h"
+#include "contrib_ops/cpu/transformers/logits_processor.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    BeamSearch,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    transformers::BeamSearch);
+
+namespace transformers {
+
+/*
+The decoder subgraph is a GPT-2 style decoder with the inputs
+  input_ids:      int32 with shape (batch_size * num_beams, sequence_length)
+  position_ids:   int32 with shape (batch_size * num_beams, sequence_length)
+  attention_mask: int32 with shape (batch_size * num_beams, past_sequence_length + sequence_length)
+  past_i:         float with shape (2, batch_size * num_beams, num_heads, past_sequence_length, head_size)
+and the outputs
+  logits:         float with shape (batch_size * num_beams, sequence_length, vocab_size)
+  present_i:      float with shape (2, batch_size * num_beams, num_heads, past_sequence_length + sequence_length, head_size)
+for each of the num_layers layers.
+*/
+static constexpr int kFirstPastInputIndex = 3;
+static constexpr int kFirstPresentOutputIndex = 1;
+
+struct BeamSearch::Info {
+  Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in) : subgraph(subgraph_in) {
+    num_implicit_inputs = static_cast<int>(node.ImplicitInputDefs().size());
+
+    auto& subgraph_inputs = subgraph.GetInputs();
+    auto& subgraph_outputs = subgraph.GetOutputs();
+    num_subgraph_inputs = static_cast<int>(subgraph_inputs.size());
+    num_subgraph_outputs = static_cast<int>(subgraph_outputs.size());
+    num_layers = num_subgraph_outputs - kFirstPresentOutputIndex;
+
+    subgraph_input_names.reserve(num_subgraph_inputs);
+    for (int i = 0; i < num_subgraph_inputs; ++i) {
+      subgraph_input_names.push_back(subgraph_inputs[i]->Name());
+    }
+
+    subgraph_output_names.reserve(num_subgraph_outputs);
+    for (int i = 0; i < num_subgraph_outputs; ++i) {
+      subgraph_output_names.push_back(subgraph_outputs[i]->Name());
+    }
+  }
+
+  // check the subgraph inputs and outputs, and read num_heads and head_size from the shape of the past state.
+  Status Validate();
+
+  const GraphViewer& subgraph;
+
+  int num_implicit_inputs;
+  int num_subgraph_inputs;
+  int num_subgraph_outputs;
+  int num_layers;
+  int num_heads;
+  int head_size;
+
+  std::vector<std::string> subgraph_input_names;
+  std::vector<std::string> subgraph_output_names;
+
+  // device each past state input is consumed on. the present state outputs are fetched to the same device.
+  std::vector<OrtDevice> past_devices;
+};
+
+static bool HasElementType(const NodeArg& node_arg, int32_t element_type) {
+  const auto* type = node_arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() && type->tensor_type().elem_type() == element_type;
+}
+
+Status BeamSearch::Info::Validate() {
+  auto& subgraph_inputs = subgraph.GetInputs();
+  auto& subgraph_outputs = subgraph.GetOutputs();
+
+  ORT_RETURN_IF(num_layers < 1 || num_subgraph_inputs != kFirstPastInputIndex + num_layers,
+                "BeamSearch decoder subgraph is expected to have inputs input_ids, position_ids, attention_mask and "
+                "a past state per layer, and outputs logits and a present state per layer. Got ",
+                num_subgraph_inputs, " inputs and ", num_subgraph_outputs, " outputs.");
+
+  for (int i = 0; i < kFirstPastInputIndex; ++i) {
+    ORT_RETURN_IF_NOT(HasElementType(*subgraph_inputs[i], TensorProto_DataType_INT32),
+                      "BeamSearch decoder subgraph input ", i, " (", subgraph_input_names[i],
+                      ") is expected to have type int32.");
+  }
+
+  ORT_RETURN_IF_NOT(HasElementType(*subgraph_outputs[0], TensorProto_DataType_FLOAT),
+                    "BeamSearch decoder subgraph output 0 (", subgraph_output_names[0],
+                    ") is expected to have type float.");
+
+  for (int i = kFirstPastInputIndex; i < num_subgraph_inputs; ++i) {
+    const NodeArg& past = *subgraph_inputs[i];
+    ORT_RETURN_IF_NOT(HasElementType(past, TensorProto_DataType_FLOAT),
+                      "BeamSearch decoder subgraph input ", i, " (", past.Name(), ") is expected to have type float.");
+
+    // the initial past state is empty, so its shape has to come from the subgraph
+    const auto* shape = past.Shape();
+    ORT_RETURN_IF(shape == nullptr || shape->dim_size() != 5 ||
+                      !shape->dim(2).has_dim_value() || !shape->dim(4).has_dim_value(),
+                  "BeamSearch decoder subgraph input ", i, " (", past.Name(),
+                  ") is expected to have shape (2, batch_size, num_heads, past_sequence_length, head_size)"
+                  " with known num_heads and head_size.");
+
+    const int layer_num_heads = static_cast<int>(shape->dim(2).dim_value());
+    const int layer_head_size = static_cast<int>(shape->dim(4).dim_value());
+    if (i == kFirstPastInputIndex) {
+      num_heads = layer_num_heads;
+      head_size = layer_head_size;
+    } else {
+      ORT_RETURN_IF(layer_num_heads != num_heads || layer_head_size != head_size,
+                    "BeamSearch decoder subgraph input ", i, " (", past.Name(),
+                    ") has a different num_heads or head_size than the past state of the first layer.");
+    }
+  }
+
+  return Status::OK();
+}
+
+struct BeamSearchParameters {
+  // from the attributes
+  int eos_token_id;
+  int pad_token_id;
+  int no_repeat_ngram_size;
+  bool early_stopping;
+
+  // from the inputs
+  int batch_size;
+  int sequence_length;
+  int max_length;
+  int min_length;
+  int num_beams;
+  int num_return_sequences;
+  float temperature;
+  float length_penalty;
+  float repetition_penalty;
+};
+
+class BeamSearchImpl {
+ public:
+  BeamSearchImpl(OpKernelContextInternal& context,
+                 const SessionState& session_state,
+                 const BeamSearch::Info& info,
+                 const BeamSearchParameters& parameters,
+                 const BeamSearch::DeviceCopy& device_copy_func,
+                 void* stream);
+
+  // Initialize by validating all the inputs
+  Status Initialize();
+
+  // Generate the output sequences, running the subgraph once per generated token.
+  Status Execute(const FeedsFetchesManager& ffm);
+
+ private:
+  template <typename T>
+  OrtValue CreateTensorValue(const AllocatorPtr& allocator, const TensorShape& shape) const;
+
+  Status CreateInitialFeeds(std::vector<OrtValue>& feeds);
+
+  // create the feeds of the next step from the tokens selected for the beams and the outputs of the last step
+  Status UpdateFeeds(const std::vector<OrtValue>& last_outputs,
+                     std::vector<OrtValue>& next_inputs,
+                     int current_length,
+                     gsl::span<const int32_t> beam_next_tokens,
+                     gsl::span<const int32_t> beam_indices);
+
+  // reorder the present state of the last step so that each beam gets the state of the beam it was selected from
+  Status PickPastState(const OrtValue& present, const OrtDevice& device, gsl::span<const int32_t> beam_indices,
+                       OrtValue& past);
+
+  OpKernelContextInternal& context_;
+  const SessionState& session_state_;
+  const BeamSearch::Info& info_;
+  BeamSearchParameters parameters_;
+
+  const std::vector<const OrtValue*>& implicit_inputs_;
+
+  const BeamSearch::DeviceCopy& device_copy_func_;
+  void* stream_;
+
+  AllocatorPtr cpu_allocator_;
+
+  // the tokens of each beam, with the current length of the sequences in each of the batch_size * num_beams rows.
+  std::vector<int32_t> sequences_;
+
+  // position of the next token of each beam
+  std::vector<int32_t> next_positions_;
+};
+
+static Status CopyCpuState(void* /*stream*/, void* target, const void* source, size_t size_in_bytes) {
+  memcpy(target, source, size_in_bytes);
+  return Status::OK();
+}
+
+BeamSearch::BeamSearch(const OpKernelInfo& info) : IControlFlowKernel(info) {
+  // make sure the attribute was present even though we don't need it here.
+  // The GraphProto is loaded as a Graph instance by main Graph::Resolve,
+  // and a SessionState instance for executing the subgraph is created by InferenceSession.
+  // This is available via Info().GetSubgraphSessionState("attribute_name") when Compute is called.
+  ONNX_NAMESPACE::GraphProto proto;
+  ORT_ENFORCE(info.GetAttr<ONNX_NAMESPACE::GraphProto>("decoder", &proto).IsOK());
+  ORT_IGNORE_RETURN_VALUE(proto);
+
+  int64_t eos_token_id;
+  ORT_ENFORCE(info.GetAttr<int64_t>("eos_token_id", &eos_token_id).IsOK());
+  eos_token_id_ = static_cast<int>(eos_token_id);
+
+  int64_t pad_token_id;
+  ORT_ENFORCE(info.GetAttr<int64_t>("pad_token_id", &pad_token_id).IsOK());
+  pad_token_id_ = static_cast<int>(pad_token_id);
+
+  no_repeat_ngram_size_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("no_repeat_ngram_size", 0));
+  early_stopping_ = info.GetAttrOrDefault<int64_t>("early_stopping", 0) != 0;
+
+  device_copy_func_ = CopyCpuState;
+  stream_ = nullptr;
+}
+
+// we need this to be in the .cc so 'unique_ptr<Info> info_' can be handled
+BeamSearch::~BeamSearch() = default;
+
+common::Status BeamSearch::SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                                      const std::string& attribute_name,
+                                                      const SessionState& subgraph_session_state) {
+  ORT_ENFORCE(info_ == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
+  ORT_UNUSED_PARAMETER(attribute_name);
+
+  const auto& node = Node();
+  info_ = std::make_unique<BeamSearch::Info>(node, subgraph_session_state.GetGraphViewer());
+  ORT_RETURN_IF_ERROR(info_->Validate());
+
+  // the subgraph inputs are created by BeamSearchImpl, followed by the implicit inputs
+  std::vector<std::string> feed_names = info_->subgraph_input_names;
+  feed_names.reserve(info_->num_subgraph_inputs + info_->num_implicit_inputs);
+  for (auto& entry : node.ImplicitInputDefs()) {
+    feed_names.push_back(entry->Name());
+  }
+
+  std::unique_ptr<FeedsFetchesManager> ffm;
+  ORT_RETURN_IF_ERROR(FeedsFetchesManager::Create(feed_names, info_->subgraph_output_names,
+                                                  subgraph_session_state.GetOrtValueNameIdxMap(), ffm));
+  ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(subgraph_session_state, *ffm));
+
+  // input_ids, position_ids and attention_mask are created on CPU so skip those (they will correctly default to
+  // CPU). use the SessionState from the BeamSearch node to find the implicit input locations.
+  std::vector<OrtDevice> feed_locations;
+  ORT_RETURN_IF_ERROR(controlflow::detail::FindDevicesForValues(session_state, feed_names, feed_locations,
+                                                                info_->num_subgraph_inputs));
+
+  // the past state is created directly on the device the subgraph consumes it on, so it is never copied.
+  const auto& feeds_copy_info = ffm->GetFeedsDeviceCopyInfo();
+  for (int i = kFirstPastInputIndex; i < info_->num_subgraph_inputs; ++i) {
+    feed_locations[i] = feeds_copy_info[i].target_device;
+    info_->past_devices.push_back(feeds_copy_info[i].target_device);
+  }
+
+  std::vector<const OrtMemoryInfo*> fetch_locations;
+  fetch_locations.reserve(info_->num_subgraph_outputs);
+
+  // logits need to be on CPU to select the next tokens
+  const auto& cpu_allocator_info = session_state.GetExecutionProviders()
+                                       .Get(onnxruntime::kCpuExecutionProvider)
+                                       ->GetAllocator(0, OrtMemTypeDefault)
+                                       ->Info();
+  fetch_locations.push_back(&cpu_allocator_info);
+
+  // the present state is fed in to the next step as the past state, so set the fetch location to match the
+  // feed location.
+  for (const auto& device : info_->past_devices) {
+    auto allocator = subgraph_session_state.GetAllocator(device);
+    ORT_RETURN_IF(allocator == nullptr, "BeamSearch: no allocator found for the past state device ", device.ToString());
+    fetch_locations.push_back(&allocator->Info());
+  }
+
+  utils::FinalizeFeedFetchCopyInfo(*ffm, feed_locations, fetch_locations);
+
+  feeds_fetches_manager_ = std::move(ffm);
+
+  return Status::OK();
+}
+
+Status BeamSearch::Compute(OpKernelContext* ctx) const {
+  auto* ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
+  auto* session_state = ctx_internal->SubgraphSessionState("decoder");
+  ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'decoder' attribute.");
+  ORT_ENFORCE(feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
+  BeamSearchParameters parameters;
+  parameters.eos_token_id = eos_token_id_;
+  parameters.pad_token_id = pad_token_id_;
+  parameters.no_repeat_ngram_size = no_repeat_ngram_size_;
+  parameters.early_stopping = early_stopping_;
+
+  BeamSearchImpl impl{*ctx_internal, *session_state, *info_, parameters, device_copy_func_, stream_};
+
+  auto status = impl.Initialize();
+  ORT_RETURN_IF_ERROR(status);
+
+  status = impl.Execute(*feeds_fetches_manager_);
+
+  return status;
+}
+
+BeamSearchImpl::BeamSearchImpl(OpKernelContextInternal& context,
+                               const SessionState& session_state,
+                               const BeamSearch::Info& info,
+                               const BeamSearchParameters& parameters,
+                               const BeamSearch::DeviceCopy& device_copy_func,
+                               void* stream)
+    : context_(context),
+      session_state_(session_state),
+      info_(info),
+      parameters_(parameters),
+      implicit_inputs_(context_.GetImplicitInputs()),
+      device_copy_func_(device_copy_func),
+      stream_(stream) {
+  cpu_allocator_ = session_state_.GetExecutionProviders()
+                       .Get(onnxruntime::kCpuExecutionProvider)
+                       ->GetAllocator(0, OrtMemTypeDefault);
+}
+
+template <typename T>
+static Status GetScalarInput(OpKernelContext& context, int index, const char* name, T default_value, T& value) {
+  const Tensor* tensor = context.Input<Tensor>(index);
+  if (tensor == nullptr) {
+    value = default_value;
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_NOT(tensor->Shape().Size() == 1, "BeamSearch input '", name,
+                    "' should be a scalar tensor. Got shape of ", tensor->Shape());
+  value = *tensor->Data<T>();
+  return Status::OK();
+}
+
+Status BeamSearchImpl::Initialize() {
+  const Tensor* input_ids = context_.Input<Tensor>(0);
+  const auto& dims = input_ids->Shape().GetDims();
+  ORT_RETURN_IF(dims.size() != 2, "Input 'input_ids' is expected to have 2 dimensions, got ", dims.size());
+  ORT_RETURN_IF(dims[0] < 1 || dims[1] < 1, "Input 'input_ids' is expected to be non-empty, got shape of ",
+                input_ids->Shape());
+  parameters_.batch_size = static_cast<int>(dims[0]);
+  parameters_.sequence_length = static_cast<int>(dims[1]);
+
+  ORT_RETURN_IF_ERROR(GetScalarInput<int32_t>(context_, 1, "max_length", 0, parameters_.max_length));
+  ORT_RETURN_IF_ERROR(GetScalarInput<int32_t>(context_, 2, "min_length", 0, parameters_.min_length));
+  ORT_RETURN_IF_ERROR(GetScalarInput<int32_t>(context_, 3, "num_beams", 1, parameters_.num_beams));
+  ORT_RETURN_IF_ERROR(GetScalarInput<int32_t>(context_, 4, "num_return_sequences", 1,
+                                              parameters_.num_return_sequences));
+  ORT_RETURN_IF_ERROR(GetScalarInput<float>(context_, 5, "temperature", 1.0f, parameters_.temperature));
+  ORT_RETURN_IF_ERROR(GetScalarInput<float>(context_, 6, "length_penalty", 1.0f, parameters_.length_penalty));
+  ORT_RETURN_IF_ERROR(GetScalarInput<float>(context_, 7, "repetition_penalty", 1.0f,
+                                            parameters_.repetition_penalty));
+
+  ORT_RETURN_IF(parameters_.max_length <= parameters_.sequence_length,
+                "max_length (", parameters_.max_length, ") should be greater than the sequence length of input_ids (",
+                parameters_.sequence_length, ")");
+  ORT_RETURN_IF(parameters_.num_beams < 1, "num_beams should be positive, got ", parameters_.num_beams);
+  ORT_RETURN_IF(parameters_.num_return_sequences < 1 || parameters_.num_return_sequences > parameters_.num_beams,
+                "num_return_sequences (", parameters_.num_return_sequences,
+                ") should be positive and not greater than num_beams (", parameters_.num_beams, ")");
+  ORT_RETURN_IF_NOT(parameters_.temperature > 0.0f, "temperature should be positive, got ", parameters_.temperature);
+  ORT_RETURN_IF_NOT(parameters_.repetition_penalty > 0.0f, "repetition_penalty should be positive, got ",
+                    parameters_.repetition_penalty);
+
+  return Status::OK();
+}
+
+template <typename T>
+OrtValue BeamSearchImpl::CreateTensorValue(const AllocatorPtr& allocator, const TensorShape& shape) const {
+  auto p_tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<T>(), shape, allocator);
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  return OrtValue{p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc()};
+}
+
+Status BeamSearchImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
+  const int num_beams = parameters_.num_beams;
+  const int sequence_length = parameters_.sequence_length;
+  const int64_t batch_beam_size = static_cast<int64_t>(parameters_.batch_size) * num_beams;
+  const TensorShape input_shape({batch_beam_size, sequence_length});
+
+  OrtValue input_ids = CreateTensorValue<int32_t>(cpu_allocator_, input_shape);
+  OrtValue position_ids = CreateTensorValue<int32_t>(cpu_allocator_, input_shape);
+  OrtValue attention_mask = CreateTensorValue<int32_t>(cpu_allocator_, input_shape);
+
+  int32_t* ids = input_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* positions = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* mask = attention_mask.GetMutable<Tensor>()->MutableData<int32_t>();
+
+  // every beam of a batch entry starts from the same prompt. padding is masked out and not counted in positions.
+  const int32_t* prompt = context_.Input<Tensor>(0)->Data<int32_t>();
+  sequences_.resize(static_cast<size_t>(batch_beam_size) * sequence_length);
+  next_positions_.resize(static_cast<size_t>(batch_beam_size));
+  for (int64_t i = 0; i < batch_beam_size; i++) {
+    const int32_t* prompt_row = prompt + (i / num_beams) * sequence_length;
+    int32_t position = 0;
+    for (int j = 0; j < sequence_length; j++, ids++, positions++, mask++) {
+      *ids = prompt_row[j];
+      if (prompt_row[j] == parameters_.pad_token_id) {
+        *mask = 0;
+        *positions = 0;
+      } else {
+        *mask = 1;
+        *positions = position++;
+      }
+    }
+    std::copy(prompt_row, prompt_row + sequence_length, sequences_.begin() + i * sequence_length);
+    next_positions_[i] = position;
+  }
+
+  feeds.reserve(info_.num_subgraph_inputs + info_.num_implicit_inputs);
+  feeds.push_back(input_ids);
+  feeds.push_back(position_ids);
+  feeds.push_back(attention_mask);
+
+  // the past state is empty at the first step
+  const TensorShape past_shape({2, batch_beam_size, info_.num_heads, 0, info_.head_size});
+  for (const auto& device : info_.past_devices) {
+    auto allocator = session_state_.GetAllocator(device);
+    ORT_RETURN_IF(allocator == nullptr, "BeamSearch: no allocator found for the past state device ",
+                  device.ToString());
+    feeds.push_back(CreateTensorValue<float>(allocator, past_shape));
+  }
+
+  for (const auto* entry : implicit_inputs_) {
+    feeds.push_back(*entry);
+  }
+
+  return Status::OK();
+}
+
+Status BeamSearchImpl::PickPastState(const OrtValue& present, const OrtDevice& device,
+                                     gsl::span<const int32_t> beam_indices, OrtValue& past) {
+  const Tensor& present_tensor = present.Get<Tensor>();
+  const int64_t batch_beam_size = static_cast<int64_t>(beam_indices.size());
+  ORT_RETURN_IF(present_tensor.Shape().NumDimensions() != 5 || present_tensor.Shape()[0] != 2 ||
+                    present_tensor.Shape()[1] != batch_beam_size,
+                "BeamSearch decoder subgraph present state is expected to have shape "
+                "(2, batch_size * num_beams, num_heads, sequence_length, head_size). Got ",
+                present_tensor.Shape());
+
+  // in greedy search, and when every beam continues itself, the present state already is the next past state
+  bool is_identity = true;
+  for (int64_t i = 0; i < batch_beam_size; i++) {
+    is_identity = is_identity && beam_indices[i] == i;
+  }
+  if (is_identity) {
+    past = present;
+    return Status::OK();
+  }
+
+  past = CreateTensorValue<float>(session_state_.GetAllocator(device), present_tensor.Shape());
+
+  // the key and value of a beam are each one contiguous chunk of num_heads * sequence_length * head_size
+  const size_t chunk_size_in_bytes = present_tensor.SizeInBytes() / (2 * batch_beam_size);
+  const auto* source = static_cast<const uint8_t*>(present_tensor.DataRaw());
+  auto* target = static_cast<uint8_t*>(past.GetMutable<Tensor>()->MutableDataRaw());
+  for (int64_t kv = 0; kv < 2; kv++) {
+    for (int64_t i = 0; i < batch_beam_size; i++) {
+      ORT_RETURN_IF_ERROR(device_copy_func_(stream_,
+                                            target + (kv * batch_beam_size + i) * chunk_size_in_bytes,
+                                            source + (kv * batch_beam_size + beam_indices[i]) * chunk_size_in_bytes,
+                                            chunk_size_in_bytes));
+    }
+  }
+
+  return Status::OK();
+}
+
+Status BeamSearchImpl::UpdateFeeds(const std::vector<OrtValue>& last_outputs,
+                                   std::vector<OrtValue>& next_inputs,
+                                   int current_length,
+                                   gsl::span<const int32_t> beam_next_tokens,
+                                   gsl::span<const int32_t> beam_indices) {
+  const int64_t batch_beam_size = static_cast<int64_t>(beam_next_tokens.size());
+  const TensorShape input_shape({batch_beam_size, 1});
+
+  OrtValue input_ids = CreateTensorValue<int32_t>(cpu_allocator_, input_shape);
+  std::copy(beam_next_tokens.begin(), beam_next_tokens.end(), input_ids.GetMutable<Tensor>()->MutableData<int32_t>());
+
+  OrtValue position_ids = CreateTensorValue<int32_t>(cpu_allocator_, input_shape);
+  int32_t* positions = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  for (int64_t i = 0; i < batch_beam_size; i++) {
+    positions[i] = next_positions_[i]++;
+  }
+
+  // the mask of the prompt is the same for every beam of a batch entry and the generated tokens are never masked,
+  // so the mask only needs the new position appended.
+  OrtValue attention_mask = CreateTensorValue<int32_t>(cpu_allocator_, TensorShape({batch_beam_size, current_length}));
+  const int32_t* old_mask = next_inputs[2].Get<Tensor>().Data<int32_t>();
+  int32_t* mask = attention_mask.GetMutable<Tensor>()->MutableData<int32_t>();
+  for (int64_t i = 0; i < batch_beam_size; i++) {
+    mask = std::copy(old_mask + i * (current_length - 1), old_mask + (i + 1) * (current_length - 1), mask);
+    *mask++ = 1;
+  }
+
+  next_inputs[0] = input_ids;
+  next_inputs[1] = position_ids;
+  next_inputs[2] = attention_mask;
+
+  for (int i = 0; i < info_.num_layers; ++i) {
+    ORT_RETURN_IF_ERROR(PickPastState(last_outputs[kFirstPresentOutputIndex + i], info_.past_devices[i],
+                                      beam_indices, next_inputs[kFirstPastInputIndex + i]));
+  }
+
+  return Status::OK();
+}
+
+Status BeamSearchImpl::Execute(const FeedsFetchesManager& ffm) {
+  auto status = Status::OK();
+
+  const int batch_size = parameters_.batch_size;
+  const int num_beams = parameters_.num_beams;
+  const int batch_beam_size = batch_size * num_beams;
+  concurrency::ThreadPool* thread_pool = context_.GetOperatorThreadPool();
+
+  std::vector<OrtValue> feeds;
+  std::vector<OrtValue> fetches;
+
+  ORT_RETURN_IF_ERROR(CreateInitialFeeds(feeds));
+
+  // all the beams of a batch entry are the same at the first step, so only the first one is a candidate
+  std::vector<float> beam_scores(batch_beam_size, 0.0f);
+  for (int i = 0; i < batch_beam_size; i++) {
+    if (i % num_beams != 0) {
+      beam_scores[i] = -1e9f;
+    }
+  }
+
+  BeamSearchScorer scorer(batch_size, num_beams, parameters_.length_penalty, parameters_.early_stopping,
+                          parameters_.eos_token_id, parameters_.pad_token_id);
+
+  LogitsProcessorParameters logits_parameters;
+  logits_parameters.min_length = parameters_.min_length;
+  logits_parameters.temperature = parameters_.temperature;
+  logits_parameters.repetition_penalty = parameters_.repetition_penalty;
+  logits_parameters.no_repeat_ngram_size = parameters_.no_repeat_ngram_size;
+  logits_parameters.eos_token_id = parameters_.eos_token_id;
+
+  std::vector<float> last_logits;
+  std::vector<float> next_token_scores;
+  std::vector<float> next_scores(static_cast<size_t>(batch_size) * 2 * num_beams);
+  std::vector<int32_t> next_tokens(next_scores.size());
+  std::vector<int32_t> next_indices(next_scores.size());
+  std::vector<int32_t> next_sequences;
+
+  int current_length = parameters_.sequence_length;
+  while (current_length < parameters_.max_length) {
+    fetches.clear();
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+    ORT_RETURN_IF_ERROR(status);
+
+    const Tensor& logits = fetches[0].Get<Tensor>();
+    const auto& logits_shape = logits.Shape();
+    ORT_RETURN_IF(logits_shape.NumDimensions() != 3 || logits_shape[0] != batch_beam_size,
+                  "BeamSearch decoder subgraph logits are expected to have shape "
+                  "(batch_size * num_beams, sequence_length, vocab_size). Got ", logits_shape);
+
+    const int vocab_size = static_cast<int>(logits_shape[2]);
+    ORT_RETURN_IF(vocab_size < 2, "BeamSearch needs a vocabulary of at least 2 tokens, got ", vocab_size);
+    ORT_RETURN_IF(parameters_.eos_token_id < 0 || parameters_.eos_token_id >= vocab_size,
+                  "eos_token_id (", parameters_.eos_token_id, ") is out of the range of the vocabulary size (",
+                  vocab_size, ")");
+    logits_parameters.vocab_size = vocab_size;
+
+    // scores of the next token come from the logits of the last position
+    gsl::span<const float> logits_data = gsl::make_span(logits.Data<float>(), logits_shape.Size());
+    const int64_t logits_length = logits_shape[1];
+    if (logits_length != 1) {
+      last_logits.resize(static_cast<size_t>(batch_beam_size) * vocab_size);
+      for (int i = 0; i < batch_beam_size; i++) {
+        const auto row = logits_data.subspan(((i + 1) * logits_length - 1) * vocab_size, vocab_size);
+        std::copy(row.begin(), row.end(), last_logits.begin() + static_cast<size_t>(i) * vocab_size);
+      }
+      logits_data = last_logits;
+    }
+
+    next_token_scores.resize(static_cast<size_t>(batch_beam_size) * vocab_size);
+    ComputeNextTokenScores(logits_parameters, logits_data, sequences_, current_length, next_token_scores,
+                           thread_pool);
+
+    for (int i = 0; i < batch_beam_size; i++) {
+      float* row = next_token_scores.data() + static_cast<size_t>(i) * vocab_size;
+      for (int v = 0; v < vocab_size; v++) {
+        row[v] += beam_scores[i];
+      }
+    }
+
+    SelectTopCandidates(next_token_scores, batch_size, num_beams, vocab_size,
+                        next_scores, next_tokens, next_indices, thread_pool);
+
+    scorer.Process(sequences_, current_length, next_scores, next_tokens, next_indices);
+
+    auto beam_next_scores = scorer.GetNextScores();
+    auto beam_next_tokens = scorer.GetNextTokens();
+    auto beam_indices = scorer.GetNextIndices();
+    beam_scores.assign(beam_next_scores.begin(), beam_next_scores.end());
+
+    // append the selected tokens to the sequences of the beams they were selected from
+    next_sequences.resize(static_cast<size_t>(batch_beam_size) * (current_length + 1));
+    auto next_sequence = next_sequences.begin();
+    for (int i = 0; i < batch_beam_size; i++) {
+      const auto source = sequences_.begin() + static_cast<size_t>(beam_indices[i]) * current_length;
+      next_sequence = std::copy(source, source + current_length, next_sequence);
+      *next_sequence++ = beam_next_tokens[i];
+    }
+    sequences_.swap(next_sequences);
+    ++current_length;
+
+    if (scorer.IsDone() || current_length >= parameters_.max_length) {
+      break;
+    }
+
+    ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length, beam_next_tokens, beam_indices));
+  }
+
+  Tensor* output_sequences = context_.Output(0, TensorShape({batch_size, parameters_.num_return_sequences,
+                                                            parameters_.max_length}));
+  Tensor* output_sequences_scores = context_.Output(1, TensorShape({batch_size, parameters_.num_return_sequences}));
+
+  scorer.Finalize(sequences_, current_length, parameters_.max_length, parameters_.num_return_sequences, beam_scores,
+                  gsl::make_span(output_sequences->MutableData<int32_t>(), output_sequences->Shape().Size()),
+                  output_sequences_scores == nullptr
+                      ? gsl::span<float>()
+                      : gsl::make_span(output_sequences_scores->MutableData<float>(),
+                                       output_sequences_scores->Shape().Size()));
+
+  return status;
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <functional>
+#include "gsl/gsl"
+
+#include "core/common/common.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/controlflow/utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Generates sequences with beam search, running the decoder subgraph once per generated token.
+// With num_beams of 1 it is greedy search.
+class BeamSearch : public controlflow::IControlFlowKernel {
+ public:
+  BeamSearch(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+  common::Status SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                            const std::string& attribute_name,
+                                            const SessionState& subgraph_session_state) override;
+
+  // hide internal implementation details via forward declaration.
+  struct Info;
+  ~BeamSearch();
+
+  // function to copy bytes between two buffers on the device the decoder state is on.
+  // used to reorder the past state of the beams between steps without moving it off the device.
+  using DeviceCopy = std::function<Status(void* stream, void* target, const void* source, size_t size_in_bytes)>;
+
+ protected:
+  // derived class can provide implementation for copying the decoder state on a different device
+  void SetDeviceCopyFunc(const DeviceCopy& device_copy_func) { device_copy_func_ = device_copy_func; }
+  void SetComputeStream(void* stream) { stream_ = stream; }
+
+ private:
+  int eos_token_id_;
+  int pad_token_id_;
+  int no_repeat_ngram_size_;
+  bool early_stopping_;
+
+  // Info and FeedsFetchesManager re-used for each subgraph execution.
+  std::unique_ptr<Info> info_;
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
+  DeviceCopy device_copy_func_;
+  void* stream_;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,184 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/transformers/beam_search_scorer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+BeamHypotheses::BeamHypotheses(int num_beams, float length_penalty, bool early_stopping)
+    : num_beams_(num_beams),
+      length_penalty_(length_penalty),
+      early_stopping_(early_stopping),
+      worst_score_(std::numeric_limits<float>::max()) {
+  beams_.reserve(static_cast<size_t>(num_beams) + 1);
+}
+
+void BeamHypotheses::Add(gsl::span<const int32_t> hypothesis, float sum_logprobs) {
+  const float score = sum_logprobs / std::pow(static_cast<float>(hypothesis.size()), length_penalty_);
+
+  if (beams_.size() < static_cast<size_t>(num_beams_) || score > worst_score_) {
+    beams_.push_back({std::vector<int32_t>(hypothesis.begin(), hypothesis.end()), score});
+
+    if (beams_.size() > static_cast<size_t>(num_beams_)) {
+      auto worst = std::min_element(beams_.begin(), beams_.end(),
+                                    [](const Hypothesis& a, const Hypothesis& b) { return a.score < b.score; });
+      beams_.erase(worst);
+      worst_score_ = std::min_element(beams_.begin(), beams_.end(),
+                                      [](const Hypothesis& a, const Hypothesis& b) { return a.score < b.score; })
+                         ->score;
+    } else {
+      worst_score_ = std::min(score, worst_score_);
+    }
+  }
+}
+
+bool BeamHypotheses::IsDone(float best_sum_logprobs, int current_length) const {
+  if (beams_.size() < static_cast<size_t>(num_beams_)) {
+    return false;
+  }
+
+  if (early_stopping_) {
+    return true;
+  }
+
+  const float current_score = best_sum_logprobs / std::pow(static_cast<float>(current_length), length_penalty_);
+  return worst_score_ >= current_score;
+}
+
+void BeamHypotheses::Output(int top_k, int max_length, int eos_token_id, int pad_token_id,
+                            gsl::span<int32_t> sequences, gsl::span<float> sequences_scores) const {
+  std::vector<const Hypothesis*> sorted;
+  sorted.reserve(beams_.size());
+  for (const auto& beam : beams_) {
+    sorted.push_back(&beam);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const Hypothesis* a, const Hypothesis* b) { return a->score > b->score; });
+
+  for (int i = 0; i < top_k; i++) {
+    auto target = sequences.subspan(static_cast<size_t>(i) * max_length, max_length);
+    std::fill(target.begin(), target.end(), pad_token_id);
+
+    // there are at least num_beams >= top_k hypotheses after Finalize
+    const Hypothesis& item = *sorted[i];
+    std::copy(item.sequence.begin(), item.sequence.end(), target.begin());
+    if (item.sequence.size() < static_cast<size_t>(max_length)) {
+      target[item.sequence.size()] = eos_token_id;
+    }
+
+    if (!sequences_scores.empty()) {
+      sequences_scores[i] = item.score;
+    }
+  }
+}
+
+BeamSearchScorer::BeamSearchScorer(int batch_size, int num_beams, float length_penalty, bool early_stopping,
+                                   int eos_token_id, int pad_token_id)
+    : batch_size_(batch_size),
+      num_beams_(num_beams),
+      eos_token_id_(eos_token_id),
+      pad_token_id_(pad_token_id),
+      done_(batch_size, 0) {
+  beam_hyps_.reserve(batch_size);
+  for (int i = 0; i < batch_size; i++) {
+    beam_hyps_.emplace_back(num_beams, length_penalty, early_stopping);
+  }
+
+  const size_t batch_beam_size = static_cast<size_t>(batch_size) * num_beams;
+  next_beam_scores_.resize(batch_beam_size, 0.0f);
+  next_beam_tokens_.resize(batch_beam_size, 0);
+  next_beam_indices_.resize(batch_beam_size, 0);
+}
+
+bool BeamSearchScorer::IsDone() const {
+  return std::all_of(done_.begin(), done_.end(), [](char done) { return done != 0; });
+}
+
+void BeamSearchScorer::Process(gsl::span<const int32_t> sequences,
+                               int current_length,
+                               gsl::span<const float> next_scores,
+                               gsl::span<const int32_t> next_tokens,
+                               gsl::span<const int32_t> next_indices) {
+  const int num_candidates = 2 * num_beams_;
+
+  for (int batch = 0; batch < batch_size_; batch++) {
+    const int first_beam = batch * num_beams_;
+
+    if (done_[batch]) {
+      // keep decoding a finished batch entry with padding so that the shapes stay the same
+      for (int i = 0; i < num_beams_; i++) {
+        next_beam_scores_[first_beam + i] = 0.0f;
+        next_beam_tokens_[first_beam + i] = pad_token_id_;
+        next_beam_indices_[first_beam + i] = first_beam;
+      }
+      continue;
+    }
+
+    int beam = 0;
+    for (int j = 0; j < num_candidates; j++) {
+      const int candidate = batch * num_candidates + j;
+      const int32_t token = next_tokens[candidate];
+      const int32_t row = next_indices[candidate];
+
+      if (token == eos_token_id_) {
+        // only a candidate among the top num_beams may finish a hypothesis
+        if (j < num_beams_) {
+          beam_hyps_[batch].Add(sequences.subspan(static_cast<size_t>(row) * current_length, current_length),
+                                next_scores[candidate]);
+        }
+      } else {
+        next_beam_scores_[first_beam + beam] = next_scores[candidate];
+        next_beam_tokens_[first_beam + beam] = token;
+        next_beam_indices_[first_beam + beam] = row;
+        beam++;
+      }
+
+      if (beam == num_beams_) {
+        break;
+      }
+    }
+
+    // the candidates are sorted so the first one has the best score
+    done_[batch] = beam_hyps_[batch].IsDone(next_scores[batch * num_candidates], current_length);
+  }
+}
+
+void BeamSearchScorer::Finalize(gsl::span<const int32_t> sequences,
+                                int current_length,
+                                int max_length,
+                                int num_return_sequences,
+                                gsl::span<const float> final_beam_scores,
+                                gsl::span<int32_t> output_sequences,
+                                gsl::span<float> output_sequences_scores) {
+  for (int batch = 0; batch < batch_size_; batch++) {
+    if (done_[batch]) {
+      continue;
+    }
+
+    for (int i = 0; i < num_beams_; i++) {
+      const int row = batch * num_beams_ + i;
+      beam_hyps_[batch].Add(sequences.subspan(static_cast<size_t>(row) * current_length, current_length),
+                            final_beam_scores[row]);
+    }
+  }
+
+  const size_t sequences_per_batch = static_cast<size_t>(num_return_sequences) * max_length;
+  for (int batch = 0; batch < batch_size_; batch++) {
+    beam_hyps_[batch].Output(num_return_sequences, max_length, eos_token_id_, pad_token_id_,
+                             output_sequences.subspan(batch * sequences_per_batch, sequences_per_batch),
+                             output_sequences_scores.empty()
+                                 ? output_sequences_scores
+                                 : output_sequences_scores.subspan(static_cast<size_t>(batch) * num_return_sequences,
+                                                                   num_return_sequences));
+  }
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+#include "gsl/gsl"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// The finished hypotheses of one batch entry. At most num_beams hypotheses are kept, and a hypothesis is
+// ranked by the sum of log probabilities of its tokens divided by length ^ length_penalty.
+class BeamHypotheses {
+ public:
+  BeamHypotheses(int num_beams, float length_penalty, bool early_stopping);
+
+  // Add a finished hypothesis, which does not include the end of sentence token.
+  void Add(gsl::span<const int32_t> hypothesis, float sum_logprobs);
+
+  // Whether none of the running beams can be better than the worst hypothesis kept.
+  bool IsDone(float best_sum_logprobs, int current_length) const;
+
+  // Write the best top_k hypotheses, each followed by eos_token_id when it is shorter than max_length and
+  // padded with pad_token_id.
+  void Output(int top_k, int max_length, int eos_token_id, int pad_token_id,
+              gsl::span<int32_t> sequences,        // [top_k, max_length]
+              gsl::span<float> sequences_scores)  // [top_k], or empty
+      const;
+
+ private:
+  struct Hypothesis {
+    std::vector<int32_t> sequence;
+    float score;
+  };
+
+  int num_beams_;
+  float length_penalty_;
+  bool early_stopping_;
+  float worst_score_;
+  std::vector<Hypothesis> beams_;
+};
+
+// Selects the next beams of every batch entry from the top candidates of a generation step, and keeps the finished
+// hypotheses. Beam i of batch entry b is row b * num_beams + i of the sequences.
+class BeamSearchScorer {
+ public:
+  BeamSearchScorer(int batch_size, int num_beams, float length_penalty, bool early_stopping,
+                   int eos_token_id, int pad_token_id);
+
+  bool IsDone() const;
+
+  // The candidates are the top 2 * num_beams (score, token, row of sequences) of each batch entry, in descending
+  // order of score. sequences has current_length tokens in each of the batch_size * num_beams rows.
+  void Process(gsl::span<const int32_t> sequences,
+               int current_length,
+               gsl::span<const float> next_scores,
+               gsl::span<const int32_t> next_tokens,
+               gsl::span<const int32_t> next_indices);
+
+  // Add the running beams of the batch entries that are not done, and output the best num_return_sequences
+  // hypotheses of each batch entry.
+  void Finalize(gsl::span<const int32_t> sequences,
+                int current_length,
+                int max_length,
+                int num_return_sequences,
+                gsl::span<const float> final_beam_scores,
+                gsl::span<int32_t> output_sequences,        // [batch_size, num_return_sequences, max_length]
+                gsl::span<float> output_sequences_scores);  // [batch_size, num_return_sequences], or empty
+
+  // The score, token and row of sequences of each of the batch_size * num_beams beams selected by Process.
+  gsl::span<const float> GetNextScores() const { return next_beam_scores_; }
+  gsl::span<const int32_t> GetNextTokens() const { return next_beam_tokens_; }
+  gsl::span<const int32_t> GetNextIndices() const { return next_beam_indices_; }
+
+ private:
+  int batch_size_;
+  int num_beams_;
+  int eos_token_id_;
+  int pad_token_id_;
+
+  std::vector<char> done_;
+  std::vector<BeamHypotheses> beam_hyps_;
+
+  std::vector<float> next_beam_scores_;
+  std::vector<int32_t> next_beam_tokens_;
+  std::vector<int32_t> next_beam_indices_;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/transformers/logits_processor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+using concurrency::ThreadPool;
+
+void ComputeNextTokenScores(const LogitsProcessorParameters& parameters,
+                            gsl::span<const float> logits,
+                            gsl::span<const int32_t> sequences,
+                            int current_length,
+                            gsl::span<float> next_token_scores,
+                            ThreadPool* thread_pool) {
+  const int vocab_size = parameters.vocab_size;
+  const std::ptrdiff_t batch_beam_size = static_cast<std::ptrdiff_t>(logits.size() / vocab_size);
+  const float banned = -std::numeric_limits<float>::infinity();
+
+  ThreadPool::TryParallelFor(
+      thread_pool, batch_beam_size, static_cast<double>(vocab_size) * 4.0,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const float* x = logits.data() + i * vocab_size;
+          float* y = next_token_scores.data() + i * vocab_size;
+          const int32_t* sequence = sequences.data() + i * current_length;
+
+          float max = -std::numeric_limits<float>::infinity();
+          for (int v = 0; v < vocab_size; v++) {
+            y[v] = x[v] / parameters.temperature;
+            max = std::max(max, y[v]);
+          }
+
+          double sum = 0.0;
+          for (int v = 0; v < vocab_size; v++) {
+            sum += std::exp(y[v] - max);
+          }
+
+          const float log_sum = max + static_cast<float>(std::log(sum));
+          for (int v = 0; v < vocab_size; v++) {
+            y[v] -= log_sum;
+          }
+
+          if (current_length < parameters.min_length) {
+            y[parameters.eos_token_id] = banned;
+          }
+
+          if (parameters.repetition_penalty != 1.0f) {
+            // a token is penalized once however many times it appears
+            std::vector<int32_t> tokens(sequence, sequence + current_length);
+            std::sort(tokens.begin(), tokens.end());
+            tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+            for (int32_t token : tokens) {
+              float& score = y[token];
+              score = score < 0.0f ? score * parameters.repetition_penalty : score / parameters.repetition_penalty;
+            }
+          }
+
+          const int ngram_size = parameters.no_repeat_ngram_size;
+          if (ngram_size > 0 && current_length + 1 >= ngram_size) {
+            // ban the last token of every n-gram whose first n - 1 tokens end the sequence
+            const int32_t* prefix = sequence + current_length - (ngram_size - 1);
+            for (int start = 0; start + ngram_size <= current_length; start++) {
+              if (std::equal(prefix, prefix + ngram_size - 1, sequence + start)) {
+                y[sequence[start + ngram_size - 1]] = banned;
+              }
+            }
+          }
+        }
+      });
+}
+
+void SelectTopCandidates(gsl::span<const float> scores,
+                         int batch_size,
+                         int num_beams,
+                         int vocab_size,
+                         gsl::span<float> next_scores,
+                         gsl::span<int32_t> next_tokens,
+                         gsl::span<int32_t> next_indices,
+                         ThreadPool* thread_pool) {
+  const int num_scores = num_beams * vocab_size;
+  const int num_candidates = 2 * num_beams;
+
+  ThreadPool::TryParallelFor(
+      thread_pool, batch_size, static_cast<double>(num_scores) * 2.0,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<int32_t> indices(num_scores);
+        for (std::ptrdiff_t batch = begin; batch != end; ++batch) {
+          const float* batch_scores = scores.data() + batch * num_scores;
+
+          // ties are broken by the lower index so that the selection is deterministic
+          std::iota(indices.begin(), indices.end(), 0);
+          std::partial_sort(indices.begin(), indices.begin() + num_candidates, indices.end(),
+                            [batch_scores](int32_t a, int32_t b) {
+                              return batch_scores[a] > batch_scores[b] ||
+                                     (batch_scores[a] == batch_scores[b] && a < b);
+                            });
+
+          for (int j = 0; j < num_candidates; j++) {
+            const int32_t index = indices[j];
+            const std::ptrdiff_t candidate = batch * num_candidates + j;
+            next_scores[candidate] = batch_scores[index];
+            next_tokens[candidate] = index % vocab_size;
+            next_indices[candidate] = static_cast<int32_t>(batch * num_beams + index / vocab_size);
+          }
+        }
+      });
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "gsl/gsl"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+struct LogitsProcessorParameters {
+  int vocab_size;
+  int min_length;
+  float temperature;
+  float repetition_penalty;
+  int no_repeat_ngram_size;
+  int eos_token_id;
+};
+
+// Compute the scores of the next token of each beam from the logits of its last position:
+// log_softmax(logits / temperature), with end of sentence banned before min_length, the repetition penalty applied
+// to the tokens already in the sequence, and the tokens that would repeat an n-gram banned.
+// sequences has current_length tokens in each of the batch_beam_size rows.
+void ComputeNextTokenScores(const LogitsProcessorParameters& parameters,
+                            gsl::span<const float> logits,  // [batch_beam_size, vocab_size]
+                            gsl::span<const int32_t> sequences,
+                            int current_length,
+                            gsl::span<float> next_token_scores,  // [batch_beam_size, vocab_size]
+                            concurrency::ThreadPool* thread_pool);
+
+// Select the top 2 * num_beams candidates among the num_beams * vocab_size scores of each batch entry, in
+// descending order of score. The index of a candidate is the row of its beam in the batch_size * num_beams rows.
+void SelectTopCandidates(gsl::span<const float> scores,  // [batch_size, num_beams * vocab_size]
+                         int batch_size,
+                         int num_beams,
+                         int vocab_size,
+                         gsl::span<float> next_scores,     // [batch_size, 2 * num_beams]
+                         gsl::span<int32_t> next_tokens,   // [batch_size, 2 * num_beams]
+                         gsl::span<int32_t> next_indices,  // [batch_size, 2 * num_beams]
+                         concurrency::ThreadPool* thread_pool);
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "attention_impl.h"
+#include "fused_multihead_attention.h"
 
 using namespace onnxruntime::cuda;
 using namespace ::onnxruntime::common;
@@ -23,7 +24,9 @@ namespace cuda {
       T,                                                          \
       kCudaExecutionProvider,                                     \
       KernelDefBuilder()                                          \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())  \
+          .MayInplace(4, 1)                                       \
+          .InputMemoryType<OrtMemTypeCPUInput>(5),                \
       Attention<T>);
 
 REGISTER_KERNEL_TYPED(float)
@@ -39,9 +42,11 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
   const Tensor* bias = context->Input<Tensor>(2);
   const Tensor* mask_index = context->Input<Tensor>(3);
   const Tensor* past = context->Input<Tensor>(4);
+  const Tensor* past_seq_len = context->Input<Tensor>(5);
 
   auto& device_prop = GetDeviceProp();
-  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask_index, past, device_prop.maxThreadsPerBlock));
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask_index, past, device_prop.maxThreadsPerBlock,
+                                  past_seq_len));
 
   // input shape (batch_size, sequence_length, input_hidden_size)
   const auto& shape = input->Shape();
@@ -62,7 +67,14 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
   Tensor* output = context->Output(0, output_shape);
 
   int past_sequence_length = 0;
-  Tensor* present = GetPresent(context, past, batch_size, head_size, sequence_length, past_sequence_length);
+  Tensor* present = GetPresent(context, past, batch_size, head_size, sequence_length, past_sequence_length, past_seq_len);
+
+  // Number of positions of the buffer shared by past and present, or 0 when present is a new buffer.
+  int max_sequence_length = 0;
+  if (past_present_share_buffer_) {
+    ORT_RETURN_IF_NOT(nullptr != present, "Expect to have present state output when past and present share a buffer");
+    max_sequence_length = static_cast<int>(present->Shape()[3]);
+  }
 
   cublasHandle_t cublas = CublasHandle();
   constexpr size_t element_size = sizeof(T);
@@ -92,7 +104,13 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
       reinterpret_cast<const CudaT*>(input->template Data<T>()), k,
       &one, reinterpret_cast<CudaT*>(gemm_buffer.get()), n, device_prop));
 
-  size_t workSpaceSize = GetAttentionWorkspaceSize(element_size, batch_size, num_heads_, head_size, sequence_length, past_sequence_length);
+  // The fused kernel reads the GEMM output directly and needs no workspace.
+  const bool use_fused_attention = IsFusedMultiHeadAttentionSupported(
+      device_prop, element_size, batch_size, head_size,
+      nullptr == mask_index ? nullptr : mask_index->template Data<int>(),
+      nullptr == mask_index ? nullptr : &(mask_index->Shape().GetDims()),
+      is_unidirectional_, past_sequence_length, past, present);
+  size_t workSpaceSize = use_fused_attention ? 0 : GetAttentionWorkspaceSize(element_size, batch_size, num_heads_, head_size, sequence_length, past_sequence_length);
   auto temp_buffer = GetScratchBuffer<void>(workSpaceSize);
   if (!LaunchAttentionKernel(
           device_prop,
@@ -111,7 +129,8 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
           is_unidirectional_,
           past_sequence_length,
           nullptr == past ? nullptr : past->template Data<T>(),
-          nullptr == present ? nullptr : present->template MutableData<T>())) {
+          nullptr == present ? nullptr : present->template MutableData<T>(),
+          max_sequence_length)) {
     // Get last error to reset it to cudaSuccess.
     CUDA_CALL(cudaGetLastError());
     return Status(common::ONNXRUNTIME, common::FAIL);
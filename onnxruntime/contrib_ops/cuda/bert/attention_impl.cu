@@ -27,6 +27,7 @@ limitations under the License.
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "attention_impl.h"
 #include "attention_softmax.h"
+#include "fused_multihead_attention.h"
 
 using namespace onnxruntime::cuda;
 using namespace cub;
@@ -65,7 +66,7 @@ bool QkvToContext(
     const int batch_size, const int sequence_length, const int num_heads, const int head_size, const size_t element_size,
     const T* input, T* output, T* workspace,
     const int* mask_index, const std::vector<int64_t>* mask_index_dims,
-    bool is_unidirectional, int past_sequence_length, const T* past, T* present) {
+    bool is_unidirectional, int past_sequence_length, const T* past, T* present, int max_sequence_length) {
   const int all_sequence_length = past_sequence_length + sequence_length;
   const size_t bytes = GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, all_sequence_length);
   T* scratch1 = workspace;
@@ -93,9 +94,15 @@ bool QkvToContext(
   // Concat past (2xBxNxS'xH) to present (2xBxNxS*xH):
   // past_k (BxNxS'xH) + k (BxNxSxH) => present_k (BxNxS*xH)
   // past_v (BxNxS'xH) + v (BxNxSxH) => present_v (BxNxS*xH)
-  const int present_size_per_batch = all_sequence_length * head_size;
+  // When past and present share a buffer of M positions, k and v are written after the first S' positions
+  // of present (2xBxNxMxH), and the attention reads the first S* positions of each BxN chunk.
+  const int present_size_per_batch = (max_sequence_length > 0 ? max_sequence_length : all_sequence_length) * head_size;
   if (nullptr != present) {
-    if (!LaunchConcatPastToPresent(stream, all_sequence_length, sequence_length, batch_size, head_size, num_heads, max_threads_per_block, past, k, present)) {
+    if (max_sequence_length > 0) {
+      if (!LaunchAppendToPresent(stream, max_sequence_length, past_sequence_length, sequence_length, batch_size, head_size, num_heads, max_threads_per_block, past, k, present)) {
+        return false;
+      }
+    } else if (!LaunchConcatPastToPresent(stream, all_sequence_length, sequence_length, batch_size, head_size, num_heads, max_threads_per_block, past, k, present)) {
       return false;
     }
 
@@ -173,19 +180,28 @@ bool LaunchAttentionKernel(
     bool is_unidirectional,
     int past_sequence_length,
     const void* past,
-    void* present) {
+    void* present,
+    int max_sequence_length) {
+  if (IsFusedMultiHeadAttentionSupported(prop, element_size, batch_size, head_size, mask_index, mask_index_dims,
+                                         is_unidirectional, past_sequence_length, past, present)) {
+    return LaunchFusedMultiHeadAttention(stream, reinterpret_cast<const half*>(input), mask_index, nullptr,
+                                         reinterpret_cast<half*>(output), batch_size, sequence_length, num_heads, head_size);
+  }
+
   if (element_size == 2) {
     return QkvToContext(prop, cublas, stream,
                         batch_size, sequence_length, num_heads, head_size, element_size,
                         reinterpret_cast<const half*>(input), reinterpret_cast<half*>(output), reinterpret_cast<half*>(workspace),
                         mask_index, mask_index_dims, is_unidirectional,
-                        past_sequence_length, reinterpret_cast<const half*>(past), reinterpret_cast<half*>(present));
+                        past_sequence_length, reinterpret_cast<const half*>(past), reinterpret_cast<half*>(present),
+                        max_sequence_length);
   } else {
     return QkvToContext(prop, cublas, stream,
                         batch_size, sequence_length, num_heads, head_size, element_size,
                         reinterpret_cast<const float*>(input), reinterpret_cast<float*>(output), reinterpret_cast<float*>(workspace),
                         mask_index, mask_index_dims, is_unidirectional,
-                        past_sequence_length, reinterpret_cast<const float*>(past), reinterpret_cast<float*>(present));
+                        past_sequence_length, reinterpret_cast<const float*>(past), reinterpret_cast<float*>(present),
+                        max_sequence_length);
   }
 }
 
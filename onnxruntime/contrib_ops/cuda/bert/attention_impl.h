@@ -35,7 +35,8 @@ bool LaunchAttentionKernel(
     bool is_unidirectional,                       // Whether there is unidirecitonal mask.
     int past_sequence_length,                     // Sequence length in past state
     const void* past,                             // Past state input
-    void* present                                 // Present state output
+    void* present,                                // Present state output
+    int max_sequence_length = 0                   // Sequence length of the buffer shared by past and present, or 0
 );
 
 bool LaunchTransCtx(cudaStream_t stream,
@@ -76,6 +77,30 @@ bool LaunchConcatPastToPresent(cudaStream_t stream,
                                const half* k_v,
                                half* present);
 
+bool LaunchAppendToPresent(cudaStream_t stream,
+                           const int max_sequence_length,
+                           const int past_sequence_length,
+                           const int sequence_length,
+                           const int batch_size,
+                           const int head_size,
+                           const int num_heads,
+                           const int max_threads_per_block,
+                           const float* past,
+                           const float* k_v,
+                           float* present);
+
+bool LaunchAppendToPresent(cudaStream_t stream,
+                           const int max_sequence_length,
+                           const int past_sequence_length,
+                           const int sequence_length,
+                           const int batch_size,
+                           const int head_size,
+                           const int num_heads,
+                           const int max_threads_per_block,
+                           const half* past,
+                           const half* k_v,
+                           half* present);
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include "core/providers/cuda/cuda_common.h"
 #include "attention_impl.h"
 
@@ -164,6 +165,116 @@ bool LaunchConcatPastToPresent(cudaStream_t stream,
   return CUDA_CALL(cudaPeekAtLastError());
 }
 
+template <typename T>
+__global__ void AppendToPresent(const int max_sequence_length,
+                                const int first_position,
+                                const int past_sequence_length,
+                                const int sequence_length,
+                                const int H,
+                                const T* past,
+                                const T* k_v,
+                                T* present) {
+  int h = threadIdx.x;
+  const int n = threadIdx.y;
+  const int s = first_position + blockIdx.x;
+  const int b = blockIdx.y;
+  const int is_v = blockIdx.z;  // 0 for k, 1 for v
+
+  const int batch_size = gridDim.y;
+  const int num_heads = blockDim.y;
+  const int stride = blockDim.x;
+
+  // past:    2 x BxNxMxH    (past_k and past_v), M is the max sequence length of the shared buffer
+  // k_v:     2 x BxNxSxH    (k and v)
+  // present: 2 x BxNxMxH    (present_k and present_v)
+  const int present_SH = max_sequence_length * H;
+  const int present_NSH = num_heads * present_SH;
+  while (h < H) {
+    const int out_offset = b * present_NSH + n * present_SH + s * H + h + is_v * (present_NSH * batch_size);
+    if (s < past_sequence_length) {
+      present[out_offset] = past[out_offset];
+    } else {
+      const int SH = sequence_length * H;
+      const int NSH = num_heads * SH;
+      const int in_offset = b * NSH + n * SH + (s - past_sequence_length) * H + h + is_v * (NSH * batch_size);
+      present[out_offset] = k_v[in_offset];
+    }
+
+    h += stride;
+  }
+}
+
+template <typename T>
+void LaunchAppendToPresentTyped(cudaStream_t stream,
+                                const int max_sequence_length,
+                                const int past_sequence_length,
+                                const int sequence_length,
+                                const int batch_size,
+                                const int H,
+                                const int num_heads,
+                                const int max_threads_per_block,
+                                const T* past,
+                                const T* k_v,
+                                T* present) {
+  // The past positions are only copied when past and present are different buffers.
+  const int first_position = (past == present) ? past_sequence_length : 0;
+  const dim3 grid(past_sequence_length + sequence_length - first_position, batch_size, 2);
+  const dim3 block(std::min(H, max_threads_per_block / num_heads), num_heads, 1);
+  AppendToPresent<T><<<grid, block, 0, stream>>>(max_sequence_length, first_position, past_sequence_length, sequence_length,
+                                                 H, past, k_v, present);
+}
+
+bool LaunchAppendToPresent(cudaStream_t stream,
+                           const int max_sequence_length,
+                           const int past_sequence_length,
+                           const int sequence_length,
+                           const int batch_size,
+                           const int head_size,
+                           const int num_heads,
+                           const int max_threads_per_block,
+                           const float* past,
+                           const float* k_v,
+                           float* present) {
+  if (0 == (head_size & 1)) {
+    LaunchAppendToPresentTyped(stream, max_sequence_length, past_sequence_length, sequence_length, batch_size,
+                               head_size / 2, num_heads, max_threads_per_block,
+                               reinterpret_cast<const float2*>(past), reinterpret_cast<const float2*>(k_v),
+                               reinterpret_cast<float2*>(present));
+  } else {
+    LaunchAppendToPresentTyped(stream, max_sequence_length, past_sequence_length, sequence_length, batch_size,
+                               head_size, num_heads, max_threads_per_block, past, k_v, present);
+  }
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+bool LaunchAppendToPresent(cudaStream_t stream,
+                           const int max_sequence_length,
+                           const int past_sequence_length,
+                           const int sequence_length,
+                           const int batch_size,
+                           const int head_size,
+                           const int num_heads,
+                           const int max_threads_per_block,
+                           const half* past,
+                           const half* k_v,
+                           half* present) {
+  if (0 == (head_size % 4)) {
+    LaunchAppendToPresentTyped(stream, max_sequence_length, past_sequence_length, sequence_length, batch_size,
+                               head_size / 4, num_heads, max_threads_per_block,
+                               reinterpret_cast<const float2*>(past), reinterpret_cast<const float2*>(k_v),
+                               reinterpret_cast<float2*>(present));
+  } else if (0 == (head_size & 1)) {
+    LaunchAppendToPresentTyped(stream, max_sequence_length, past_sequence_length, sequence_length, batch_size,
+                               head_size / 2, num_heads, max_threads_per_block,
+                               reinterpret_cast<const half2*>(past), reinterpret_cast<const half2*>(k_v),
+                               reinterpret_cast<half2*>(present));
+  } else {
+    LaunchAppendToPresentTyped(stream, max_sequence_length, past_sequence_length, sequence_length, batch_size,
+                               head_size, num_heads, max_threads_per_block, past, k_v, present);
+  }
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cuda_fp16.h>
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cuda_common.h"
+#include "bert_padding.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+constexpr int kPaddingThreadsPerBlock = 256;
+
+__global__ void GetTokenOffsetKernel(const int* sequence_token_count, int* token_offset,
+                                     int* cumulative_sequence_length, const int batch_size, const int sequence_length) {
+  extern __shared__ int cumulative[];  // batch_size + 1
+
+  if (threadIdx.x == 0) {
+    cumulative[0] = 0;
+    for (int b = 0; b < batch_size; b++) {
+      const int count = min(max(sequence_token_count[b], 0), sequence_length);
+      cumulative[b + 1] = cumulative[b] + count;
+    }
+  }
+  __syncthreads();
+
+  for (int i = threadIdx.x; i <= batch_size; i += blockDim.x) {
+    cumulative_sequence_length[i] = cumulative[i];
+  }
+
+  // Tokens are listed first, in order, then the padding positions.
+  const int token_count = cumulative[batch_size];
+  for (int i = threadIdx.x; i < batch_size * sequence_length; i += blockDim.x) {
+    const int b = i / sequence_length;
+    const int s = i - b * sequence_length;
+    const int count = cumulative[b + 1] - cumulative[b];
+    const int index = s < count ? cumulative[b] + s
+                                : token_count + (b * sequence_length - cumulative[b]) + (s - count);
+    token_offset[index] = i;
+  }
+}
+
+bool LaunchGetTokenOffset(cudaStream_t stream,
+                          const int* sequence_token_count,
+                          int* token_offset,
+                          int* cumulative_sequence_length,
+                          const int batch_size,
+                          const int sequence_length) {
+  GetTokenOffsetKernel<<<1, kPaddingThreadsPerBlock, (batch_size + 1) * sizeof(int), stream>>>(
+      sequence_token_count, token_offset, cumulative_sequence_length, batch_size, sequence_length);
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+__global__ void GetSequenceLengthKernel(const int* cumulative_sequence_length, int* sequence_lengths,
+                                        const int batch_size) {
+  const int b = blockIdx.x * blockDim.x + threadIdx.x;
+  if (b < batch_size) {
+    sequence_lengths[b] = cumulative_sequence_length[b + 1] - cumulative_sequence_length[b];
+  }
+}
+
+bool LaunchGetSequenceLength(cudaStream_t stream,
+                             const int* cumulative_sequence_length,
+                             int* sequence_lengths,
+                             const int batch_size) {
+  const int blocks = CeilDiv(batch_size, kPaddingThreadsPerBlock);
+  GetSequenceLengthKernel<<<blocks, kPaddingThreadsPerBlock, 0, stream>>>(
+      cumulative_sequence_length, sequence_lengths, batch_size);
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+// One block per token of the packed tensor.
+template <typename T>
+__global__ void RemovePaddingKernel(const T* input, const int* token_offset, T* output, const int hidden_size) {
+  const int token = blockIdx.x;
+  const T* input_row = input + static_cast<int64_t>(token_offset[token]) * hidden_size;
+  T* output_row = output + static_cast<int64_t>(token) * hidden_size;
+  for (int i = threadIdx.x; i < hidden_size; i += blockDim.x) {
+    output_row[i] = input_row[i];
+  }
+}
+
+// One block per position of the padded tensor.
+template <typename T>
+__global__ void RestorePaddingKernel(const T* input, const int* token_offset, T* output,
+                                     const int token_count, const int hidden_size) {
+  const int index = blockIdx.x;
+  T* output_row = output + static_cast<int64_t>(token_offset[index]) * hidden_size;
+  if (index < token_count) {
+    const T* input_row = input + static_cast<int64_t>(index) * hidden_size;
+    for (int i = threadIdx.x; i < hidden_size; i += blockDim.x) {
+      output_row[i] = input_row[i];
+    }
+  } else {
+    for (int i = threadIdx.x; i < hidden_size; i += blockDim.x) {
+      output_row[i] = T{};
+    }
+  }
+}
+
+// Rows are copied as float2, float or 16-bit words, whichever divides their size in bytes.
+template <typename T>
+bool LaunchRemovePadding(cudaStream_t stream,
+                         const T* input,
+                         const int* token_offset,
+                         T* output,
+                         const int token_count,
+                         const int hidden_size) {
+  if (token_count == 0 || hidden_size == 0) {
+    return true;
+  }
+
+  const int row_bytes = hidden_size * static_cast<int>(sizeof(T));
+  if (row_bytes % sizeof(float2) == 0) {
+    const int width = row_bytes / sizeof(float2);
+    RemovePaddingKernel<float2><<<token_count, std::min(width, kPaddingThreadsPerBlock), 0, stream>>>(
+        reinterpret_cast<const float2*>(input), token_offset, reinterpret_cast<float2*>(output), width);
+  } else if (row_bytes % sizeof(float) == 0) {
+    const int width = row_bytes / sizeof(float);
+    RemovePaddingKernel<float><<<token_count, std::min(width, kPaddingThreadsPerBlock), 0, stream>>>(
+        reinterpret_cast<const float*>(input), token_offset, reinterpret_cast<float*>(output), width);
+  } else {
+    const int width = row_bytes / sizeof(uint16_t);
+    RemovePaddingKernel<uint16_t><<<token_count, std::min(width, kPaddingThreadsPerBlock), 0, stream>>>(
+        reinterpret_cast<const uint16_t*>(input), token_offset, reinterpret_cast<uint16_t*>(output), width);
+  }
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+template <typename T>
+bool LaunchRestorePadding(cudaStream_t stream,
+                          const T* input,
+                          const int* token_offset,
+                          T* output,
+                          const int token_count,
+                          const int hidden_size,
+                          const int batch_size,
+                          const int sequence_length) {
+  const int padded_count = batch_size * sequence_length;
+  if (padded_count == 0 || hidden_size == 0) {
+    return true;
+  }
+
+  const int row_bytes = hidden_size * static_cast<int>(sizeof(T));
+  if (row_bytes % sizeof(float2) == 0) {
+    const int width = row_bytes / sizeof(float2);
+    RestorePaddingKernel<float2><<<padded_count, std::min(width, kPaddingThreadsPerBlock), 0, stream>>>(
+        reinterpret_cast<const float2*>(input), token_offset, reinterpret_cast<float2*>(output), token_count, width);
+  } else if (row_bytes % sizeof(float) == 0) {
+    const int width = row_bytes / sizeof(float);
+    RestorePaddingKernel<float><<<padded_count, std::min(width, kPaddingThreadsPerBlock), 0, stream>>>(
+        reinterpret_cast<const float*>(input), token_offset, reinterpret_cast<float*>(output), token_count, width);
+  } else {
+    const int width = row_bytes / sizeof(uint16_t);
+    RestorePaddingKernel<uint16_t><<<padded_count, std::min(width, kPaddingThreadsPerBlock), 0, stream>>>(
+        reinterpret_cast<const uint16_t*>(input), token_offset, reinterpret_cast<uint16_t*>(output), token_count, width);
+  }
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+template bool LaunchRemovePadding<float>(cudaStream_t, const float*, const int*, float*, const int, const int);
+template bool LaunchRemovePadding<half>(cudaStream_t, const half*, const int*, half*, const int, const int);
+template bool LaunchRestorePadding<float>(cudaStream_t, const float*, const int*, float*,
+                                          const int, const int, const int, const int);
+template bool LaunchRestorePadding<half>(cudaStream_t, const half*, const int*, half*,
+                                         const int, const int, const int, const int);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Computes the token offset (BxS) and the cumulative sequence length (B + 1) of a batch with right-side padding,
+// from the number of tokens of each sequence (the mask index of EmbedLayerNormalization).
+// The token offset lists the positions in the padded BxS layout of the T tokens of the batch, followed by those of
+// the padding. The cumulative sequence length holds the offset of the first token of each sequence in the packed
+// layout, with the total number of tokens T at the end.
+bool LaunchGetTokenOffset(cudaStream_t stream,
+                          const int* sequence_token_count,
+                          int* token_offset,
+                          int* cumulative_sequence_length,
+                          const int batch_size,
+                          const int sequence_length);
+
+// Computes the length of each sequence from the cumulative sequence length.
+bool LaunchGetSequenceLength(cudaStream_t stream,
+                             const int* cumulative_sequence_length,
+                             int* sequence_lengths,
+                             const int batch_size);
+
+// Gathers the T tokens of a padded BxSxH tensor into a packed TxH tensor.
+template <typename T>
+bool LaunchRemovePadding(cudaStream_t stream,
+                         const T* input,
+                         const int* token_offset,
+                         T* output,
+                         const int token_count,
+                         const int hidden_size);
+
+// Scatters the tokens of a packed TxH tensor to a padded BxSxH tensor, with zeros for the padding.
+template <typename T>
+bool LaunchRestorePadding(cudaStream_t stream,
+                          const T* input,
+                          const int* token_offset,
+                          T* output,
+                          const int token_count,
+                          const int hidden_size,
+                          const int batch_size,
+                          const int sequence_length);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,312 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Multi-head attention in a single kernel with tensor cores. Each block computes the attention of a tile of 64 queries
+// of one head: Q x K' of a tile of keys is computed with WMMA into shared memory, turned into probabilities with an
+// online softmax (running maximum and sum per query, with the output rescaled when the maximum changes), and
+// multiplied by the tile of V into an output accumulator that stays in shared memory. The BxNxSxS scores are never
+// written to global memory, and key tiles after the end position of a sequence are neither loaded nor computed.
+
+#include <cuda_fp16.h>
+#include <math_constants.h>
+#include <mma.h>
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cuda_common.h"
+#include "fused_multihead_attention.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+constexpr int kWarpsPerBlock = 4;
+constexpr int kWmmaSize = 16;                                 // tile size of the WMMA matrix multiplications
+constexpr int kQueriesPerBlock = kWarpsPerBlock * kWmmaSize;  // each warp computes 16 queries
+constexpr int kHalfsPerVector = sizeof(float4) / sizeof(half);
+
+// Keys per tile: smaller for head size 128 so that the shared memory fits in the 64KB of sm_75.
+template <int kHeadSize>
+struct KeysPerTile {
+  static constexpr int value = kHeadSize == 64 ? 64 : 32;
+};
+
+template <int kHeadSize>
+constexpr size_t GetSharedMemorySize() {
+  return 2 * KeysPerTile<kHeadSize>::value * kHeadSize * sizeof(half) +      // K and V tiles
+         kQueriesPerBlock * KeysPerTile<kHeadSize>::value * sizeof(float) +  // scores, then probabilities
+         kQueriesPerBlock * kHeadSize * sizeof(float);                       // output accumulator
+}
+
+template <int kHeadSize>
+__global__ void __launch_bounds__(kWarpsPerBlock* GPU_WARP_SIZE)
+    FusedMultiHeadAttentionKernel(const half* input, const int* mask_index, const int* cumulative_sequence_length,
+                                  half* output, const int sequence_length, const int num_heads, const float scale) {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+  using namespace nvcuda;
+  constexpr int kKeysPerTile = KeysPerTile<kHeadSize>::value;
+  constexpr int kVectorsPerRow = kHeadSize / kHalfsPerVector;
+
+  extern __shared__ float4 shared_memory[];
+  half* k_tile = reinterpret_cast<half*>(shared_memory);
+  half* v_tile = k_tile + kKeysPerTile * kHeadSize;
+  float* scores = reinterpret_cast<float*>(v_tile + kKeysPerTile * kHeadSize);
+  float* accumulator = scores + kQueriesPerBlock * kKeysPerTile;
+
+  const int warp = threadIdx.x / GPU_WARP_SIZE;
+  const int lane = threadIdx.x % GPU_WARP_SIZE;
+  const int batch = blockIdx.z;
+  const int head = blockIdx.y;
+
+  // Padded input is BxSx3xNxH. Packed input is Tx3xNxH without padding, where the tokens of a sequence start at
+  // its cumulative sequence length, and blocks after the end of a sequence have nothing to compute.
+  int64_t token_start = static_cast<int64_t>(batch) * sequence_length;
+  int query_end = sequence_length;
+  int key_end = sequence_length;
+  if (cumulative_sequence_length != nullptr) {
+    token_start = cumulative_sequence_length[batch];
+    query_end = cumulative_sequence_length[batch + 1] - cumulative_sequence_length[batch];
+    key_end = query_end;
+    if (static_cast<int>(blockIdx.x) * kQueriesPerBlock >= query_end) {
+      return;
+    }
+  } else if (mask_index != nullptr) {
+    // Same as ComputeSoftmaxWithMask1D: an end position that is not positive means that no key is masked.
+    const int end_position = min(sequence_length, mask_index[batch]);
+    key_end = end_position > 0 ? end_position : sequence_length;
+  }
+
+  const int query_start = blockIdx.x * kQueriesPerBlock + warp * kWmmaSize;
+  const bool is_warp_active = query_start < query_end;
+
+  // Q, K and V of a token are 3 x hidden_size apart from those of the next token.
+  const int hidden_size = num_heads * kHeadSize;
+  const int token_stride = 3 * hidden_size;
+  const half* q_input = input + token_start * token_stride + head * kHeadSize;
+  const half* k_input = q_input + hidden_size;
+  const half* v_input = q_input + 2 * hidden_size;
+
+  float* warp_scores = scores + warp * kWmmaSize * kKeysPerTile;
+  half* warp_probs = reinterpret_cast<half*>(warp_scores);  // same row pitch in bytes as the scores
+  float* warp_accumulator = accumulator + warp * kWmmaSize * kHeadSize;
+
+  // Stage the queries of the warp in its accumulator, with zeros after the end of the sequence, and keep them
+  // in registers for all key tiles.
+  wmma::fragment<wmma::matrix_a, kWmmaSize, kWmmaSize, kWmmaSize, half, wmma::row_major> q_frag[kHeadSize / kWmmaSize];
+  {
+    half* q_stage = reinterpret_cast<half*>(warp_accumulator);
+    for (int i = lane; i < kWmmaSize * kVectorsPerRow; i += GPU_WARP_SIZE) {
+      const int row = i / kVectorsPerRow;
+      const int col = (i % kVectorsPerRow) * kHalfsPerVector;
+      float4 value = make_float4(0.f, 0.f, 0.f, 0.f);
+      if (query_start + row < query_end) {
+        value = *reinterpret_cast<const float4*>(q_input + (query_start + row) * token_stride + col);
+      }
+      *reinterpret_cast<float4*>(q_stage + row * kHeadSize + col) = value;
+    }
+    __syncwarp();
+#pragma unroll
+    for (int d = 0; d < kHeadSize / kWmmaSize; ++d) {
+      wmma::load_matrix_sync(q_frag[d], q_stage + d * kWmmaSize, kHeadSize);
+    }
+    __syncwarp();
+    for (int i = lane; i < kWmmaSize * kHeadSize; i += GPU_WARP_SIZE) {
+      warp_accumulator[i] = 0.f;
+    }
+  }
+
+  // Two lanes share a query: each handles half of the keys of a tile and half of the output.
+  const int row = lane / 2;
+  const int key_offset = (lane % 2) * (kKeysPerTile / 2);
+  const int output_offset = (lane % 2) * (kHeadSize / 2);
+  float row_max = -CUDART_INF_F;
+  float row_sum = 0.f;
+
+  for (int key_start = 0; key_start < key_end; key_start += kKeysPerTile) {
+    __syncthreads();  // the previous K and V tiles are no longer used
+
+    for (int i = threadIdx.x; i < kKeysPerTile * kVectorsPerRow; i += blockDim.x) {
+      const int key = key_start + i / kVectorsPerRow;
+      const int col = (i % kVectorsPerRow) * kHalfsPerVector;
+      float4 k_value = make_float4(0.f, 0.f, 0.f, 0.f);
+      float4 v_value = k_value;
+      if (key < key_end) {
+        k_value = *reinterpret_cast<const float4*>(k_input + key * token_stride + col);
+        v_value = *reinterpret_cast<const float4*>(v_input + key * token_stride + col);
+      }
+      reinterpret_cast<float4*>(k_tile)[i] = k_value;
+      reinterpret_cast<float4*>(v_tile)[i] = v_value;
+    }
+    __syncthreads();
+
+    if (!is_warp_active) {
+      continue;
+    }
+
+    // Scores = Q x K'. K' is read as a column major matrix from the row major K tile.
+#pragma unroll
+    for (int n = 0; n < kKeysPerTile / kWmmaSize; ++n) {
+      wmma::fragment<wmma::accumulator, kWmmaSize, kWmmaSize, kWmmaSize, float> s_frag;
+      wmma::fill_fragment(s_frag, 0.f);
+#pragma unroll
+      for (int d = 0; d < kHeadSize / kWmmaSize; ++d) {
+        wmma::fragment<wmma::matrix_b, kWmmaSize, kWmmaSize, kWmmaSize, half, wmma::col_major> k_frag;
+        wmma::load_matrix_sync(k_frag, k_tile + n * kWmmaSize * kHeadSize + d * kWmmaSize, kHeadSize);
+        wmma::mma_sync(s_frag, q_frag[d], k_frag, s_frag);
+      }
+      wmma::store_matrix_sync(warp_scores + n * kWmmaSize, s_frag, kKeysPerTile, wmma::mem_row_major);
+    }
+    __syncwarp();
+
+    // Online softmax. The first key of the tile is valid, so the new maximum is finite.
+    float values[kKeysPerTile / 2];
+    float tile_max = -CUDART_INF_F;
+#pragma unroll
+    for (int i = 0; i < kKeysPerTile / 2; ++i) {
+      const int col = key_offset + i;
+      values[i] = key_start + col < key_end ? warp_scores[row * kKeysPerTile + col] * scale : -CUDART_INF_F;
+      tile_max = fmaxf(tile_max, values[i]);
+    }
+    tile_max = fmaxf(tile_max, WARP_SHFL_XOR(tile_max, 1));
+    const float new_max = fmaxf(row_max, tile_max);
+
+    float tile_sum = 0.f;
+#pragma unroll
+    for (int i = 0; i < kKeysPerTile / 2; ++i) {
+      values[i] = __expf(values[i] - new_max);
+      tile_sum += values[i];
+    }
+    tile_sum += WARP_SHFL_XOR(tile_sum, 1);
+
+    const float rescale = __expf(row_max - new_max);
+    row_sum = row_sum * rescale + tile_sum;
+    row_max = new_max;
+
+    __syncwarp();  // all scores are read before the probabilities overwrite them
+#pragma unroll
+    for (int i = 0; i < kKeysPerTile / 2; ++i) {
+      warp_probs[row * 2 * kKeysPerTile + key_offset + i] = __float2half(values[i]);
+    }
+    float* accumulator_row = warp_accumulator + row * kHeadSize + output_offset;
+#pragma unroll
+    for (int i = 0; i < kHeadSize / 2; ++i) {
+      accumulator_row[i] *= rescale;
+    }
+    __syncwarp();
+
+    // Output += P x V.
+    wmma::fragment<wmma::matrix_a, kWmmaSize, kWmmaSize, kWmmaSize, half, wmma::row_major> p_frag[kKeysPerTile / kWmmaSize];
+#pragma unroll
+    for (int n = 0; n < kKeysPerTile / kWmmaSize; ++n) {
+      wmma::load_matrix_sync(p_frag[n], warp_probs + n * kWmmaSize, 2 * kKeysPerTile);
+    }
+#pragma unroll
+    for (int d = 0; d < kHeadSize / kWmmaSize; ++d) {
+      wmma::fragment<wmma::accumulator, kWmmaSize, kWmmaSize, kWmmaSize, float> o_frag;
+      wmma::load_matrix_sync(o_frag, warp_accumulator + d * kWmmaSize, kHeadSize, wmma::mem_row_major);
+#pragma unroll
+      for (int n = 0; n < kKeysPerTile / kWmmaSize; ++n) {
+        wmma::fragment<wmma::matrix_b, kWmmaSize, kWmmaSize, kWmmaSize, half, wmma::row_major> v_frag;
+        wmma::load_matrix_sync(v_frag, v_tile + n * kWmmaSize * kHeadSize + d * kWmmaSize, kHeadSize);
+        wmma::mma_sync(o_frag, p_frag[n], v_frag, o_frag);
+      }
+      wmma::store_matrix_sync(warp_accumulator + d * kWmmaSize, o_frag, kHeadSize, wmma::mem_row_major);
+    }
+    __syncwarp();
+  }
+
+  // Output is BxSxNxH, or TxNxH when packed.
+  const int query = query_start + row;
+  if (is_warp_active && query < query_end) {
+    const float inverse_sum = 1.f / row_sum;
+    const float* accumulator_row = warp_accumulator + row * kHeadSize + output_offset;
+    half2* output_row = reinterpret_cast<half2*>(
+        output + (token_start + query) * hidden_size + head * kHeadSize + output_offset);
+#pragma unroll
+    for (int i = 0; i < kHeadSize / 4; ++i) {
+      output_row[i] = __floats2half2_rn(accumulator_row[2 * i] * inverse_sum, accumulator_row[2 * i + 1] * inverse_sum);
+    }
+  }
+#endif
+}
+
+template <int kHeadSize>
+bool LaunchFusedMultiHeadAttentionKernel(cudaStream_t stream, const half* input, const int* mask_index,
+                                         const int* cumulative_sequence_length, half* output,
+                                         const int batch_size, const int sequence_length, const int num_heads) {
+  constexpr size_t shared_memory_size = GetSharedMemorySize<kHeadSize>();
+  if (shared_memory_size > 48 * 1024) {
+    if (!CUDA_CALL(cudaFuncSetAttribute(FusedMultiHeadAttentionKernel<kHeadSize>,
+                                        cudaFuncAttributeMaxDynamicSharedMemorySize,
+                                        static_cast<int>(shared_memory_size)))) {
+      return false;
+    }
+  }
+
+  const dim3 grid(CeilDiv(sequence_length, kQueriesPerBlock), num_heads, batch_size);
+  const float scale = 1.f / sqrtf(static_cast<float>(kHeadSize));
+  FusedMultiHeadAttentionKernel<kHeadSize><<<grid, kWarpsPerBlock * GPU_WARP_SIZE, shared_memory_size, stream>>>(
+      input, mask_index, cumulative_sequence_length, output, sequence_length, num_heads, scale);
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+}  // namespace
+
+bool IsFusedMultiHeadAttentionSupported(
+    const cudaDeviceProp& prop,
+    size_t element_size,
+    int batch_size,
+    int head_size,
+    const int* mask_index,
+    const std::vector<int64_t>* mask_index_dims,
+    bool is_unidirectional,
+    int past_sequence_length,
+    const void* past,
+    const void* present) {
+  if (element_size != 2 || prop.major < 7 || is_unidirectional ||
+      past_sequence_length != 0 || nullptr != past || nullptr != present) {
+    return false;
+  }
+
+  // Only the end positions of 1D mask index are supported: not the start positions, nor the raw attention mask.
+  if (nullptr != mask_index &&
+      (nullptr == mask_index_dims || mask_index_dims->size() != 1 || mask_index_dims->at(0) != batch_size)) {
+    return false;
+  }
+
+  size_t shared_memory_size = 0;
+  if (head_size == 64) {
+    shared_memory_size = GetSharedMemorySize<64>();
+  } else if (head_size == 128) {
+    shared_memory_size = GetSharedMemorySize<128>();
+  } else {
+    return false;
+  }
+  return shared_memory_size <= prop.sharedMemPerBlockOptin;
+}
+
+bool LaunchFusedMultiHeadAttention(
+    cudaStream_t stream,
+    const half* input,
+    const int* mask_index,
+    const int* cumulative_sequence_length,
+    half* output,
+    int batch_size,
+    int sequence_length,
+    int num_heads,
+    int head_size) {
+  if (head_size == 64) {
+    return LaunchFusedMultiHeadAttentionKernel<64>(stream, input, mask_index, cumulative_sequence_length, output,
+                                                   batch_size, sequence_length, num_heads);
+  } else if (head_size == 128) {
+    return LaunchFusedMultiHeadAttentionKernel<128>(stream, input, mask_index, cumulative_sequence_length, output,
+                                                    batch_size, sequence_length, num_heads);
+  }
+  return false;
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
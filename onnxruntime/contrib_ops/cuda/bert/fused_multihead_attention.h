@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Whether the fused multi-head attention kernel can compute the attention of the given inputs.
+// The kernel uses tensor cores (sm_70 and above) for float16 inputs with head size 64 or 128. It supports no mask or
+// a 1D mask index of shape (batch_size) with the end position of each sequence, and has no past or present state.
+bool IsFusedMultiHeadAttentionSupported(
+    const cudaDeviceProp& prop,
+    size_t element_size,
+    int batch_size,
+    int head_size,
+    const int* mask_index,
+    const std::vector<int64_t>* mask_index_dims,
+    bool is_unidirectional,
+    int past_sequence_length,
+    const void* past,
+    const void* present);
+
+// Computes softmax(Q x K' / sqrt(H)) x V in one kernel, reading Q, K and V from the BxSx3xNxH input of the
+// Attention GEMM and writing the BxSxNxH output. The scores of a tile of queries are kept in shared memory with an
+// online softmax, so no BxNxSxS buffer is used, and the keys after the end position of each sequence are skipped.
+// With cumulative_sequence_length, the input is Tx3xNxH and the output TxNxH for the T tokens of the batch without
+// padding, and sequence_length is the maximum length of a sequence.
+bool LaunchFusedMultiHeadAttention(
+    cudaStream_t stream,
+    const half* input,
+    const int* mask_index,                  // End position of each sequence, or nullptr for no mask.
+    const int* cumulative_sequence_length,  // B + 1 token offsets of the sequences of packed input, or nullptr.
+    half* output,
+    int batch_size,
+    int sequence_length,
+    int num_heads,
+    int head_size);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "packed_attention.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+#include "attention_impl.h"
+#include "bert_padding.h"
+#include "fused_multihead_attention.h"
+
+using namespace onnxruntime::cuda;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      PackedAttention,                                            \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      KernelDefBuilder()                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      PackedAttention<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+PackedAttention<T>::PackedAttention(const OpKernelInfo& info) : CudaKernel(info) {
+  int64_t num_heads = 0;
+  ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+  num_heads_ = static_cast<int>(num_heads);
+}
+
+template <typename T>
+Status PackedAttention<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* token_offset = context->Input<Tensor>(3);
+  const Tensor* cumulative_sequence_length = context->Input<Tensor>(4);
+
+  // input shape (token_count, input_hidden_size)
+  const auto& dims = input->Shape().GetDims();
+  if (dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'input' is expected to have 2 dimensions, got ",
+                           dims.size());
+  }
+
+  const auto& weights_dims = weights->Shape().GetDims();
+  if (weights_dims.size() != 2 || weights_dims[0] != dims[1] || weights_dims[1] % 3 != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'weights' is expected to have shape (input_hidden_size, 3 * hidden_size)");
+  }
+
+  const auto& bias_dims = bias->Shape().GetDims();
+  if (bias_dims.size() != 1 || bias_dims[0] != weights_dims[1]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'bias' is expected to have shape (3 * hidden_size)");
+  }
+
+  const auto& offset_dims = token_offset->Shape().GetDims();
+  if (offset_dims.size() != 2 || dims[0] > offset_dims[0] * offset_dims[1]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'token_offset' is expected to have shape (batch_size, sequence_length)"
+                           " with no more than batch_size x sequence_length tokens in input");
+  }
+
+  const auto& cumulative_dims = cumulative_sequence_length->Shape().GetDims();
+  if (cumulative_dims.size() != 1 || cumulative_dims[0] != offset_dims[0] + 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'cumulative_sequence_length' is expected to have shape (batch_size + 1)");
+  }
+
+  int token_count = static_cast<int>(dims[0]);
+  int input_hidden_size = static_cast<int>(dims[1]);
+  int hidden_size = static_cast<int>(weights_dims[1]) / 3;
+  int batch_size = static_cast<int>(offset_dims[0]);
+  int sequence_length = static_cast<int>(offset_dims[1]);
+  if (hidden_size % num_heads_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "hidden_size should be divisible by num_heads.");
+  }
+  int head_size = hidden_size / num_heads_;
+
+  Tensor* output = context->Output(0, TensorShape({dims[0], static_cast<int64_t>(hidden_size)}));
+  if (token_count == 0) {
+    return Status::OK();
+  }
+
+  auto& device_prop = GetDeviceProp();
+  cublasHandle_t cublas = CublasHandle();
+  constexpr size_t element_size = sizeof(T);
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  CudaT one = ToCudaType<T>::FromFloat(1.0f);
+  CudaT zero = ToCudaType<T>::FromFloat(0.0f);
+
+  // Same GEMM as Attention, on the tokens only: result (3 x hidden_size, token_count) in column major.
+  int m = token_count;
+  int n = 3 * hidden_size;
+  int k = input_hidden_size;
+  auto gemm_buffer = GetScratchBuffer<T>(static_cast<size_t>(token_count) * 3 * hidden_size);
+
+  CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+      cublas, CUBLAS_OP_N, CUBLAS_OP_N, n, m, 1, &one,
+      reinterpret_cast<const CudaT*>(bias->template Data<T>()), n,
+      GetConstOnes<CudaT>(m), 1,
+      &zero, reinterpret_cast<CudaT*>(gemm_buffer.get()), n, device_prop));
+
+  CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+      cublas, CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &one,
+      reinterpret_cast<const CudaT*>(weights->template Data<T>()), n,
+      reinterpret_cast<const CudaT*>(input->template Data<T>()), k,
+      &one, reinterpret_cast<CudaT*>(gemm_buffer.get()), n, device_prop));
+
+  const int* cumulative_data = cumulative_sequence_length->template Data<int>();
+  if (IsFusedMultiHeadAttentionSupported(device_prop, element_size, batch_size, head_size, nullptr, nullptr,
+                                         false, 0, nullptr, nullptr)) {
+    if (!LaunchFusedMultiHeadAttention(Stream(), reinterpret_cast<const half*>(gemm_buffer.get()), nullptr,
+                                       cumulative_data, reinterpret_cast<half*>(output->template MutableData<T>()),
+                                       batch_size, sequence_length, num_heads_, head_size)) {
+      // Get last error to reset it to cudaSuccess.
+      CUDA_CALL(cudaGetLastError());
+      return Status(common::ONNXRUNTIME, common::FAIL);
+    }
+    return Status::OK();
+  }
+
+  // Otherwise the attention runs on padded tensors, with the length of each sequence as the 1D mask index.
+  const size_t padded_count = static_cast<size_t>(batch_size) * sequence_length;
+  auto padded_qkv = GetScratchBuffer<T>(padded_count * 3 * hidden_size);
+  auto padded_output = GetScratchBuffer<T>(padded_count * hidden_size);
+  auto sequence_lengths = GetScratchBuffer<int>(batch_size);
+  size_t workspace_size = GetAttentionWorkspaceSize(element_size, batch_size, num_heads_, head_size, sequence_length, 0);
+  auto workspace = GetScratchBuffer<void>(workspace_size);
+  const std::vector<int64_t> mask_index_dims{batch_size};
+
+  if (!LaunchRestorePadding<CudaT>(Stream(), reinterpret_cast<const CudaT*>(gemm_buffer.get()),
+                                   token_offset->template Data<int>(), reinterpret_cast<CudaT*>(padded_qkv.get()),
+                                   token_count, 3 * hidden_size, batch_size, sequence_length) ||
+      !LaunchGetSequenceLength(Stream(), cumulative_data, sequence_lengths.get(), batch_size) ||
+      !LaunchAttentionKernel(device_prop, Stream(), padded_qkv.get(), sequence_lengths.get(), &mask_index_dims,
+                             padded_output.get(), batch_size, sequence_length, num_heads_, head_size,
+                             workspace.get(), cublas, element_size, false, 0, nullptr, nullptr) ||
+      !LaunchRemovePadding<CudaT>(Stream(), reinterpret_cast<const CudaT*>(padded_output.get()),
+                                  token_offset->template Data<int>(),
+                                  reinterpret_cast<CudaT*>(output->template MutableData<T>()),
+                                  token_count, hidden_size)) {
+    CUDA_CALL(cudaGetLastError());
+    return Status(common::ONNXRUNTIME, common::FAIL);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+// Bidirectional multi-head self attention of a batch without padding: the input holds the tokens of all sequences
+// one after the other, as the output of RemovePadding.
+template <typename T>
+class PackedAttention final : public CudaKernel {
+ public:
+  PackedAttention(const OpKernelInfo& info);
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  int num_heads_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_common.h"
+#include "remove_padding.h"
+#include "bert_padding.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      RemovePadding,                                              \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      KernelDefBuilder()                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      RemovePadding<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+RemovePadding<T>::RemovePadding(const OpKernelInfo& op_kernel_info) : CudaKernel(op_kernel_info) {
+}
+
+template <typename T>
+Status RemovePadding<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* sequence_token_count = context->Input<Tensor>(1);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 3 dimensions, got ", input_dims.size());
+  }
+
+  const auto& count_dims = sequence_token_count->Shape().GetDims();
+  if (count_dims.size() != 1 || count_dims[0] != input_dims[0]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "sequence_token_count is expected to have shape (batch_size)");
+  }
+
+  int batch_size = static_cast<int>(input_dims[0]);
+  int sequence_length = static_cast<int>(input_dims[1]);
+  int hidden_size = static_cast<int>(input_dims[2]);
+
+  Tensor* token_offset = context->Output(1, TensorShape({input_dims[0], input_dims[1]}));
+  Tensor* cumulative_sequence_length = context->Output(2, TensorShape({input_dims[0] + 1}));
+  int* token_offset_data = token_offset->template MutableData<int>();
+  int* cumulative_data = cumulative_sequence_length->template MutableData<int>();
+
+  if (!LaunchGetTokenOffset(Stream(), sequence_token_count->template Data<int>(), token_offset_data, cumulative_data,
+                            batch_size, sequence_length)) {
+    // Get last error to reset it to cudaSuccess.
+    CUDA_CALL(cudaGetLastError());
+    return Status(common::ONNXRUNTIME, common::FAIL);
+  }
+
+  // The shape of the output depends on the total number of tokens.
+  auto token_count_pinned = AllocateBufferOnCPUPinned<int>(1);
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(token_count_pinned.get(), cumulative_data + batch_size, sizeof(int),
+                                       cudaMemcpyDeviceToHost, Stream()));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(Stream()));
+  const int token_count = *token_count_pinned;
+
+  Tensor* output = context->Output(0, TensorShape({static_cast<int64_t>(token_count), input_dims[2]}));
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  if (!LaunchRemovePadding<CudaT>(Stream(), reinterpret_cast<const CudaT*>(input->template Data<T>()),
+                                  token_offset_data, reinterpret_cast<CudaT*>(output->template MutableData<T>()),
+                                  token_count, hidden_size)) {
+    CUDA_CALL(cudaGetLastError());
+    return Status(common::ONNXRUNTIME, common::FAIL);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_common.h"
+#include "restore_padding.h"
+#include "bert_padding.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      RestorePadding,                                             \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      KernelDefBuilder()                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      RestorePadding<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+RestorePadding<T>::RestorePadding(const OpKernelInfo& op_kernel_info) : CudaKernel(op_kernel_info) {
+}
+
+template <typename T>
+Status RestorePadding<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* token_offset = context->Input<Tensor>(1);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 2 dimensions, got ", input_dims.size());
+  }
+
+  const auto& offset_dims = token_offset->Shape().GetDims();
+  if (offset_dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "token_offset is expected to have 2 dimensions, got ", offset_dims.size());
+  }
+  if (input_dims[0] > offset_dims[0] * offset_dims[1]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input has more tokens than the batch_size x sequence_length positions of token_offset");
+  }
+
+  int token_count = static_cast<int>(input_dims[0]);
+  int hidden_size = static_cast<int>(input_dims[1]);
+  int batch_size = static_cast<int>(offset_dims[0]);
+  int sequence_length = static_cast<int>(offset_dims[1]);
+
+  Tensor* output = context->Output(0, TensorShape({offset_dims[0], offset_dims[1], input_dims[1]}));
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  if (!LaunchRestorePadding<CudaT>(Stream(), reinterpret_cast<const CudaT*>(input->template Data<T>()),
+                                   token_offset->template Data<int>(),
+                                   reinterpret_cast<CudaT*>(output->template MutableData<T>()),
+                                   token_count, hidden_size, batch_size, sequence_length)) {
+    // Get last error to reset it to cudaSuccess.
+    CUDA_CALL(cudaGetLastError());
+    return Status(common::ONNXRUNTIME, common::FAIL);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "contrib_ops/cuda/bert/layer_norm.cuh"
 #include "contrib_ops/cuda/bert/skip_layer_norm_impl.h"
+#include "contrib_ops/cuda/layer_norm_vectorized.cuh"
 #include <cuda_fp16.h>
 
 namespace onnxruntime {
@@ -72,14 +73,105 @@ __global__ void SkipLayerNormKernel(
   LayerNorm<T, TPB>(thread_data, ld, offset, beta, gamma, epsilon, output);
 }
 
+// Single pass kernel: each thread adds ILP consecutive values of the input, skip and bias with vector loads and keeps
+// the sums in registers while the mean and variance are reduced, so the data is read and written once.
+template <typename T, int ILP>
+__global__ void SkipLayerNormKernelVectorized(
+    const int ld, const T* input, const T* skip, const T* beta, const T* gamma, const T* bias,
+    const float epsilon, T* output) {
+  using VecT = LayerNormVector<T, ILP>;
+  __shared__ float shared[3 * GPU_WARP_SIZE];
+
+  const int offset = blockIdx.x * ld;
+  const int i = threadIdx.x * ILP;
+
+  float vals[ILP];
+  float mean = 0.f;
+  float m2 = 0.f;
+  float count = 0.f;
+  if (i < ld) {
+    const VecT input_v = *reinterpret_cast<const VecT*>(&input[offset + i]);
+    const VecT skip_v = *reinterpret_cast<const VecT*>(&skip[offset + i]);
+#pragma unroll
+    for (int k = 0; k < ILP; k++) {
+      vals[k] = static_cast<float>(input_v.val[k]) + static_cast<float>(skip_v.val[k]);
+    }
+    if (bias != nullptr) {
+      const VecT bias_v = *reinterpret_cast<const VecT*>(&bias[i]);
+#pragma unroll
+      for (int k = 0; k < ILP; k++) {
+        vals[k] += static_cast<float>(bias_v.val[k]);
+      }
+    }
+    WelfordThreadValues<ILP>(vals, mean, m2, count);
+  }
+
+  WelfordBlockAllReduce(mean, m2, count, shared);
+
+  if (i < ld) {
+    const float rsigma = rsqrtf(m2 / ld + epsilon);
+    const VecT gamma_v = *reinterpret_cast<const VecT*>(&gamma[i]);
+    VecT beta_v;
+    if (beta != nullptr) {
+      beta_v = *reinterpret_cast<const VecT*>(&beta[i]);
+    }
+    VecT output_v;
+#pragma unroll
+    for (int k = 0; k < ILP; k++) {
+      const float b = (beta == nullptr) ? 0.f : static_cast<float>(beta_v.val[k]);
+      output_v.val[k] = T(static_cast<float>(gamma_v.val[k]) * (vals[k] - mean) * rsigma + b);
+    }
+    *reinterpret_cast<VecT*>(&output[offset + i]) = output_v;
+  }
+}
+
+template <typename T>
+bool LaunchSkipLayerNormKernelVectorized(
+    cudaStream_t stream, const int ld, const int grid_size, const T* input, const T* skip,
+    const T* beta, const T* gamma, const T* bias, const float epsilon, T* output) {
+  const int ilp = GetLayerNormVectorizedILP<T>(ld, {input, skip, beta, gamma, bias, output});
+  if (ilp == 0) {
+    return false;
+  }
+
+  const int block_size = GetLayerNormVectorizedThreads(ld, ilp);
+  switch (ilp) {
+    case 8:
+      SkipLayerNormKernelVectorized<T, 8>
+          <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+      break;
+    case 4:
+      SkipLayerNormKernelVectorized<T, 4>
+          <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+      break;
+    case 2:
+      SkipLayerNormKernelVectorized<T, 2>
+          <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+      break;
+    default:
+      SkipLayerNormKernelVectorized<T, 1>
+          <<<grid_size, block_size, 0, stream>>>(ld, input, skip, beta, gamma, bias, epsilon, output);
+      break;
+  }
+  return true;
+}
+
 template <typename T>
 bool ComputeSkipLayerNorm(
     cudaStream_t stream, const int ld, const int n, const T* input, const T* skip,
-    const T* beta, const T* gamma, const T* bias, const T epsilon, T* output) {
+    const T* beta, const T* gamma, const T* bias, const float epsilon_float, T* output) {
   // this must be true because n is the total size of the tensor
   assert(n % ld == 0);
   const int grid_size = n / ld;
 
+  // rows of a few hundred values and more are normalized in a single pass when they fit in the registers of a block
+  if (ld > 128 && LaunchSkipLayerNormKernelVectorized(stream, ld, grid_size, input, skip, beta, gamma, bias,
+                                                       epsilon_float, output)) {
+    return CUDA_CALL(cudaPeekAtLastError());
+  }
+
+  const T epsilon = T(epsilon_float);
+
   if (ld <= 32) {
     constexpr int block_size = 32;
     SkipLayerNormKernelSmall<T, block_size>
@@ -121,7 +213,7 @@ bool LaunchSkipLayerNormKernel(
         reinterpret_cast<const half*>(beta),
         reinterpret_cast<const half*>(gamma),
         reinterpret_cast<const half*>(bias),
-        __float2half_rn(epsilon),
+        epsilon,
         reinterpret_cast<half*>(output));
   } else {
     return ComputeSkipLayerNorm(
@@ -25,6 +25,7 @@
 #include "core/providers/cuda/cu_inc/common.cuh"
 
 #include "layer_norm_impl.h"
+#include "layer_norm_vectorized.cuh"
 
 namespace onnxruntime {
 namespace contrib {
@@ -347,6 +348,108 @@ __global__ void cuApplyLayerNorm(
   }
 }
 
+// Single pass kernel for rows that fit in the registers of a block: each thread loads ILP consecutive values with
+// a vector access and keeps them while the mean and variance are reduced, so the input is read once.
+template <typename T, bool simplified, int ILP>
+__global__ void cuApplyLayerNormVectorized(
+    T* __restrict__ output_vals,
+    float* __restrict__ mean,
+    float* __restrict__ inv_std_dev,
+    const T* __restrict__ vals,
+    const int n2,
+    const float epsilon,
+    const T* __restrict__ gamma,
+    const T* __restrict__ beta) {
+  using VecT = LayerNormVector<T, ILP>;
+  __shared__ float shared[3 * GPU_WARP_SIZE];
+
+  const int64_t offset = static_cast<int64_t>(blockIdx.x) * n2;
+  const int i = threadIdx.x * ILP;
+
+  float curr[ILP];
+  float mu = 0.f;
+  float m2 = 0.f;
+  float count = 0.f;
+  if (i < n2) {
+    const VecT vals_v = *reinterpret_cast<const VecT*>(&vals[offset + i]);
+#pragma unroll
+    for (int k = 0; k < ILP; k++) {
+      curr[k] = static_cast<float>(vals_v.val[k]);
+    }
+    WelfordThreadValues<ILP>(curr, mu, m2, count);
+  }
+
+  WelfordBlockAllReduce(mu, m2, count, shared);
+
+  // the simplified variant normalizes by the root mean square
+  const float sigma2 = simplified ? m2 / n2 + mu * mu : m2 / n2;
+  const float c_inv_std_dev = rsqrtf(sigma2 + epsilon);
+
+  if (i < n2) {
+    VecT gamma_v;
+    VecT beta_v;
+    if (gamma != nullptr) {
+      gamma_v = *reinterpret_cast<const VecT*>(&gamma[i]);
+    }
+    if (!simplified && beta != nullptr) {
+      beta_v = *reinterpret_cast<const VecT*>(&beta[i]);
+    }
+    VecT output_v;
+#pragma unroll
+    for (int k = 0; k < ILP; k++) {
+      const float gamma_k = (gamma != nullptr) ? static_cast<float>(gamma_v.val[k]) : 1.f;
+      if (simplified) {
+        output_v.val[k] = T(gamma_k * (c_inv_std_dev * curr[k]));
+      } else {
+        const float beta_k = (beta != nullptr) ? static_cast<float>(beta_v.val[k]) : 0.f;
+        output_v.val[k] = T(gamma_k * (c_inv_std_dev * (curr[k] - mu)) + beta_k);
+      }
+    }
+    *reinterpret_cast<VecT*>(&output_vals[offset + i]) = output_v;
+  }
+
+  if (threadIdx.x == 0) {
+    if (mean != nullptr) mean[blockIdx.x] = mu;
+    if (inv_std_dev != nullptr) inv_std_dev[blockIdx.x] = c_inv_std_dev;
+  }
+}
+
+// The single pass kernel accumulates in float, so it is only used when the statistics are float.
+template <typename T, typename U, bool simplified>
+struct LayerNormVectorized {
+  static bool TryApply(cudaStream_t, T*, U*, U*, const T*, int, int, double, const T*, const T*) {
+    return false;
+  }
+};
+
+template <typename T, bool simplified>
+struct LayerNormVectorized<T, float, simplified> {
+  static bool TryApply(cudaStream_t stream, T* output, float* mean, float* inv_std_dev, const T* input,
+                       int n1, int n2, double epsilon, const T* gamma, const T* beta) {
+    const int ilp = GetLayerNormVectorizedILP<T>(n2, {output, input, gamma, beta});
+    if (ilp == 0 || n1 == 0) {
+      return false;
+    }
+
+    const int threads = GetLayerNormVectorizedThreads(n2, ilp);
+    switch (ilp) {
+      case 8:
+        cuApplyLayerNormVectorized<T, simplified, 8><<<n1, threads, 0, stream>>>(
+            output, mean, inv_std_dev, input, n2, static_cast<float>(epsilon), gamma, beta);
+        break;
+      case 4:
+        cuApplyLayerNormVectorized<T, simplified, 4><<<n1, threads, 0, stream>>>(
+            output, mean, inv_std_dev, input, n2, static_cast<float>(epsilon), gamma, beta);
+        break;
+      default:
+        cuApplyLayerNormVectorized<T, simplified, 2><<<n1, threads, 0, stream>>>(
+            output, mean, inv_std_dev, input, n2, static_cast<float>(epsilon), gamma, beta);
+        break;
+    }
+    return true;
+  }
+};
+
 template <typename T, typename U, bool simplified>
 void HostApplyLayerNorm(
     const cudaDeviceProp& prop,
@@ -364,6 +467,11 @@ void HostApplyLayerNorm(
   const int warp_size = prop.warpSize;
   ORT_ENFORCE(warp_size == GPU_WARP_SIZE);
 
+  if (LayerNormVectorized<T, U, simplified>::TryApply(stream, output, mean, inv_std_dev, input, n1, n2, epsilon,
+                                                      gamma, beta)) {
+    return;
+  }
+
   const dim3 threads(warp_size, 4, 1);
   const dim3 blocks(1, std::min<unsigned int>(n1, maxGridY), 1);
   int nshared =
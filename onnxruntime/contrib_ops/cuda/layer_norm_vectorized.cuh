@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Helpers of the single pass LayerNorm kernels, where each thread keeps ILP consecutive values of the normalized row
+// in registers, loaded and stored with vector accesses, and the mean and variance are reduced with Welford's
+// algorithm across the warps of the block.
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include "core/providers/cuda/cu_inc/common.cuh"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+// the largest number of threads of a block normalizing one row
+constexpr int kLayerNormVectorizedMaxThreads = 1024;
+
+template <typename T, int ILP>
+struct alignas(sizeof(T) * ILP) LayerNormVector {
+  T val[ILP];
+};
+
+// Merge the mean and the sum of squared deviations (m2) of count values with those of count_b other values.
+__device__ __forceinline__ void WelfordCombine(float mean_b, float m2_b, float count_b,
+                                               float& mean, float& m2, float& count) {
+  const float new_count = count + count_b;
+  if (new_count == 0.f) {
+    return;
+  }
+  const float delta = mean_b - mean;
+  const float ratio_b = count_b / new_count;
+  mean += delta * ratio_b;
+  m2 += m2_b + delta * delta * count * ratio_b;
+  count = new_count;
+}
+
+// Compute the mean and m2 of the values held by the thread.
+template <int ILP>
+__device__ __forceinline__ void WelfordThreadValues(const float (&vals)[ILP], float& mean, float& m2, float& count) {
+  float sum = 0.f;
+#pragma unroll
+  for (int k = 0; k < ILP; k++) {
+    sum += vals[k];
+  }
+  mean = sum / ILP;
+  m2 = 0.f;
+#pragma unroll
+  for (int k = 0; k < ILP; k++) {
+    const float delta = vals[k] - mean;
+    m2 += delta * delta;
+  }
+  count = static_cast<float>(ILP);
+}
+
+// Reduce the statistics of all the threads of the block, whose size is a multiple of the warp size, and give the
+// result to every thread. shared must hold 3 * GPU_WARP_SIZE floats.
+__device__ __forceinline__ void WelfordBlockAllReduce(float& mean, float& m2, float& count, float* shared) {
+#pragma unroll
+  for (int mask = GPU_WARP_SIZE / 2; mask > 0; mask /= 2) {
+    WelfordCombine(WARP_SHFL_DOWN(mean, mask), WARP_SHFL_DOWN(m2, mask), WARP_SHFL_DOWN(count, mask),
+                   mean, m2, count);
+  }
+
+  const int num_warps = blockDim.x / GPU_WARP_SIZE;
+  if (num_warps > 1) {
+    const int warp = threadIdx.x / GPU_WARP_SIZE;
+    const int lane = threadIdx.x % GPU_WARP_SIZE;
+    if (lane == 0) {
+      shared[warp] = mean;
+      shared[GPU_WARP_SIZE + warp] = m2;
+      shared[2 * GPU_WARP_SIZE + warp] = count;
+    }
+    __syncthreads();
+
+    // every warp reduces the partial results of the warps, so no second synchronization is needed
+    mean = lane < num_warps ? shared[lane] : 0.f;
+    m2 = lane < num_warps ? shared[GPU_WARP_SIZE + lane] : 0.f;
+    count = lane < num_warps ? shared[2 * GPU_WARP_SIZE + lane] : 0.f;
+#pragma unroll
+    for (int mask = GPU_WARP_SIZE / 2; mask > 0; mask /= 2) {
+      WelfordCombine(WARP_SHFL_DOWN(mean, mask), WARP_SHFL_DOWN(m2, mask), WARP_SHFL_DOWN(count, mask),
+                     mean, m2, count);
+    }
+  }
+
+  mean = WARP_SHFL(mean, 0);
+  m2 = WARP_SHFL(m2, 0);
+  count = WARP_SHFL(count, 0);
+}
+
+// The number of values each thread of the single pass kernels holds for rows of ld values of type T, or 0 if the
+// row does not fit or the pointers are not aligned for vector accesses.
+// Wide vectors make the fewest memory transactions, but the block is kept above 128 threads when the row allows it
+// so that enough warps hide the memory latency.
+template <typename T>
+int GetLayerNormVectorizedILP(int ld, std::initializer_list<const void*> pointers) {
+  constexpr int max_ilp = 16 / sizeof(T);
+  int ilp = max_ilp;
+  while (ilp > 1 && (ld % ilp != 0 || ld / ilp < 128)) {
+    ilp /= 2;
+  }
+  if (ld % ilp != 0 || ld / ilp > kLayerNormVectorizedMaxThreads) {
+    return 0;
+  }
+  // with a single value per thread there is nothing to gain over the multi pass kernels
+  if (ilp == 1 && max_ilp > 1) {
+    return 0;
+  }
+  for (const void* p : pointers) {
+    if (p != nullptr && reinterpret_cast<uintptr_t>(p) % (sizeof(T) * ilp) != 0) {
+      return 0;
+    }
+  }
+  return ilp;
+}
+
+// The number of threads of a block normalizing rows of ld values with ilp values per thread.
+inline int GetLayerNormVectorizedThreads(int ld, int ilp) {
+  const int threads = ld / ilp;
+  return (threads + GPU_WARP_SIZE - 1) / GPU_WARP_SIZE * GPU_WARP_SIZE;
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
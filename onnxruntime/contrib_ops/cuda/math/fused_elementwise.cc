@@ -0,0 +1,226 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/math/fused_elementwise.h"
+
+#include <unordered_map>
+
+#include "core/providers/cuda/math/binary_elementwise_ops.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      FusedElementwise,                                           \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      KernelDefBuilder()                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      FusedElementwise<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+
+// the number of plans kept before the cache is cleared, for inputs whose shapes keep changing
+constexpr size_t kMaxCachedPlans = 64;
+
+const std::unordered_map<std::string, std::pair<FusedElementwiseOp, bool>>& FusedElementwiseOps() {
+  // op type -> op, is binary
+  static const std::unordered_map<std::string, std::pair<FusedElementwiseOp, bool>> ops = {
+      {"Add", {FusedElementwiseOp::Add, true}},
+      {"Sub", {FusedElementwiseOp::Sub, true}},
+      {"Mul", {FusedElementwiseOp::Mul, true}},
+      {"Div", {FusedElementwiseOp::Div, true}},
+      {"Abs", {FusedElementwiseOp::Abs, false}},
+      {"Erf", {FusedElementwiseOp::Erf, false}},
+      {"Exp", {FusedElementwiseOp::Exp, false}},
+      {"Log", {FusedElementwiseOp::Log, false}},
+      {"Neg", {FusedElementwiseOp::Neg, false}},
+      {"Reciprocal", {FusedElementwiseOp::Reciprocal, false}},
+      {"Relu", {FusedElementwiseOp::Relu, false}},
+      {"Sigmoid", {FusedElementwiseOp::Sigmoid, false}},
+      {"Sqrt", {FusedElementwiseOp::Sqrt, false}},
+      {"Tanh", {FusedElementwiseOp::Tanh, false}},
+  };
+  return ops;
+}
+
+}  // namespace
+
+template <typename T>
+FusedElementwise<T>::FusedElementwise(const OpKernelInfo& info) : CudaKernel(info) {
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs("ops", ops).IsOK());
+  ORT_ENFORCE(info.GetAttrs("operands", operands).IsOK());
+
+  const int num_inputs = static_cast<int>(info.GetInputCount());
+  const int num_ops = static_cast<int>(ops.size());
+  ORT_ENFORCE(num_inputs >= 1 && num_inputs <= kFusedElementwiseMaxInputs,
+              "FusedElementwise supports 1 to ", kFusedElementwiseMaxInputs, " inputs. Got ", num_inputs);
+  ORT_ENFORCE(num_ops >= 1 && num_ops <= kFusedElementwiseMaxOps,
+              "FusedElementwise supports 1 to ", kFusedElementwiseMaxOps, " ops. Got ", num_ops);
+  ORT_ENFORCE(operands.size() == 2 * ops.size(), "FusedElementwise needs two operands for each op.");
+
+  program_.num_inputs = num_inputs;
+  program_.num_ops = num_ops;
+  for (int i = 0; i < num_ops; ++i) {
+    const auto op = FusedElementwiseOps().find(ops[i]);
+    ORT_ENFORCE(op != FusedElementwiseOps().end(), "FusedElementwise does not support op ", ops[i]);
+    program_.ops[i] = op->second.first;
+
+    // the operators can only read the inputs and the results of the previous operators
+    for (int j = 0; j < 2; ++j) {
+      int64_t operand = operands[2 * i + j];
+      if (j == 1 && !op->second.second) {
+        operand = 0;
+      }
+      ORT_ENFORCE(operand >= 0 && operand < num_inputs + i, "Invalid operand ", operand, " of op ", i);
+      program_.operands[2 * i + j] = static_cast<int8_t>(operand);
+    }
+  }
+}
+
+template <typename T>
+Status FusedElementwise<T>::GetBroadcastPlan(const std::vector<int64_t>& signature,
+                                             const std::vector<TensorShape>& input_shapes,
+                                             CachedPlan& cached_plan) const {
+  {
+    std::lock_guard<std::mutex> lock(plans_mutex_);
+    auto it = plans_.find(signature);
+    if (it != plans_.end()) {
+      cached_plan = it->second;
+      return Status::OK();
+    }
+  }
+
+  TensorShape output_shape = input_shapes[0];
+  for (size_t i = 1; i < input_shapes.size(); ++i) {
+    TensorShape broadcast_shape;
+    ORT_RETURN_IF_ERROR(ComputeOutputShape(Node().Name(), output_shape, input_shapes[i], broadcast_shape));
+    output_shape = broadcast_shape;
+  }
+
+  const auto& output_dims = output_shape.GetDims();
+  const int32_t output_rank = static_cast<int32_t>(output_dims.size());
+  const int64_t output_size = output_shape.Size();
+
+  FusedElementwiseBroadcastPlan& plan = cached_plan.plan;
+  plan.output_rank = output_rank;
+  plan.has_general = false;
+
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    const TensorShape& input_shape = input_shapes[i];
+    const int64_t input_size = input_shape.Size();
+    if (input_size == output_size) {
+      plan.kinds[i] = FusedElementwiseBroadcast::None;
+      continue;
+    }
+    if (input_size == 1) {
+      plan.kinds[i] = FusedElementwiseBroadcast::Scalar;
+      continue;
+    }
+
+    // the dims of the input aligned with the output dims
+    std::vector<int64_t> padded_dims(output_rank, 1);
+    std::copy(input_shape.GetDims().begin(), input_shape.GetDims().end(),
+              padded_dims.begin() + (output_rank - input_shape.NumDimensions()));
+
+    int32_t first = 0;
+    while (padded_dims[first] == 1) {
+      ++first;
+    }
+    int32_t last = output_rank - 1;
+    while (padded_dims[last] == 1) {
+      --last;
+    }
+
+    bool is_inner = true;
+    for (int32_t d = first; d < output_rank; ++d) {
+      is_inner = is_inner && padded_dims[d] == output_dims[d];
+    }
+    bool is_outer = true;
+    for (int32_t d = 0; d <= last; ++d) {
+      is_outer = is_outer && padded_dims[d] == output_dims[d];
+    }
+
+    if (is_inner) {
+      plan.kinds[i] = FusedElementwiseBroadcast::Inner;
+      plan.fdm_inputs[i] = fast_divmod(gsl::narrow_cast<int>(input_size));
+    } else if (is_outer) {
+      plan.kinds[i] = FusedElementwiseBroadcast::Outer;
+      plan.fdm_inputs[i] = fast_divmod(gsl::narrow_cast<int>(output_size / input_size));
+    } else {
+      ORT_RETURN_IF(output_rank > kFusedElementwiseMaxRank, Node().Name(), ": broadcasting of ", output_rank,
+                    "-D outputs is limited to ", kFusedElementwiseMaxRank, " dimensions.");
+      plan.kinds[i] = FusedElementwiseBroadcast::General;
+      plan.has_general = true;
+      int64_t stride = 1;
+      for (int32_t d = output_rank - 1; d >= 0; --d) {
+        plan.strides[i][d] = padded_dims[d] == 1 ? 0 : gsl::narrow_cast<int32_t>(stride);
+        stride *= padded_dims[d];
+      }
+    }
+  }
+
+  if (plan.has_general) {
+    TensorPitches output_pitches(output_dims);
+    plan.fdm_output_strides.SetSize(output_rank);
+    for (int32_t d = 0; d < output_rank; ++d) {
+      plan.fdm_output_strides[d] = fast_divmod(gsl::narrow_cast<int>(output_pitches[d]));
+    }
+  }
+  cached_plan.output_shape = output_shape;
+
+  std::lock_guard<std::mutex> lock(plans_mutex_);
+  if (plans_.size() >= kMaxCachedPlans) {
+    plans_.clear();
+  }
+  plans_.emplace(signature, cached_plan);
+  return Status::OK();
+}
+
+template <typename T>
+Status FusedElementwise<T>::ComputeInternal(OpKernelContext* context) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const int num_inputs = program_.num_inputs;
+  TArray<const CudaT*, kFusedElementwiseMaxInputs> inputs(num_inputs);
+  std::vector<TensorShape> input_shapes;
+  input_shapes.reserve(num_inputs);
+  std::vector<int64_t> signature;
+  for (int i = 0; i < num_inputs; ++i) {
+    const Tensor* input = context->Input<Tensor>(i);
+    inputs[i] = reinterpret_cast<const CudaT*>(input->template Data<T>());
+    input_shapes.push_back(input->Shape());
+    const auto& dims = input->Shape().GetDims();
+    signature.insert(signature.end(), dims.begin(), dims.end());
+    signature.push_back(static_cast<int64_t>(dims.size()));
+  }
+
+  CachedPlan cached_plan;
+  ORT_RETURN_IF_ERROR(GetBroadcastPlan(signature, input_shapes, cached_plan));
+
+  Tensor* output = context->Output(0, cached_plan.output_shape);
+  FusedElementwiseImpl<CudaT>(
+      Stream(),
+      program_,
+      cached_plan.plan,
+      inputs,
+      reinterpret_cast<CudaT*>(output->template MutableData<T>()),
+      output->Shape().Size());
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "core/providers/cuda/cuda_kernel.h"
+#include "contrib_ops/cuda/math/fused_elementwise_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Evaluates the program of a FusedElementwise node, see the schema of the op. The program is interpreted by one
+// kernel per element type, and the indexing of the inputs is planned once for each combination of input shapes.
+template <typename T>
+class FusedElementwise final : public onnxruntime::cuda::CudaKernel {
+ public:
+  FusedElementwise(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  struct CachedPlan {
+    TensorShape output_shape;
+    FusedElementwiseBroadcastPlan plan;
+  };
+
+  Status GetBroadcastPlan(const std::vector<int64_t>& signature, const std::vector<TensorShape>& input_shapes,
+                          CachedPlan& cached_plan) const;
+
+  FusedElementwiseProgram program_;
+
+  // plans by the dims of the inputs, each followed by the rank
+  mutable std::mutex plans_mutex_;
+  mutable std::map<std::vector<int64_t>, CachedPlan> plans_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "contrib_ops/cuda/math/fused_elementwise_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+__device__ __forceinline__ float _FusedElementwiseOp(FusedElementwiseOp op, float a, float b) {
+  switch (op) {
+    case FusedElementwiseOp::Add:
+      return a + b;
+    case FusedElementwiseOp::Sub:
+      return a - b;
+    case FusedElementwiseOp::Mul:
+      return a * b;
+    case FusedElementwiseOp::Div:
+      return a / b;
+    case FusedElementwiseOp::Abs:
+      return fabsf(a);
+    case FusedElementwiseOp::Erf:
+      return erff(a);
+    case FusedElementwiseOp::Exp:
+      return expf(a);
+    case FusedElementwiseOp::Log:
+      return logf(a);
+    case FusedElementwiseOp::Neg:
+      return -a;
+    case FusedElementwiseOp::Reciprocal:
+      return 1.f / a;
+    case FusedElementwiseOp::Relu:
+      return a > 0.f ? a : 0.f;
+    case FusedElementwiseOp::Sigmoid:
+      return 1.f / (1.f + expf(-a));
+    case FusedElementwiseOp::Sqrt:
+      return sqrtf(a);
+    case FusedElementwiseOp::Tanh:
+      return tanhf(a);
+  }
+  return a;
+}
+
+// Every thread evaluates the whole program for NumElementsPerThread output elements, so each input is read once
+// and only the result is written. The operators and the broadcast kinds are the same for all the threads, so the
+// switches do not diverge.
+template <typename T, bool HasGeneralBroadcast, int NumThreadsPerBlock, int NumElementsPerThread>
+__global__ void _FusedElementwise(
+    const FusedElementwiseProgram program,
+    const FusedElementwiseBroadcastPlan plan,
+    const TArray<const T*, kFusedElementwiseMaxInputs> inputs,
+    T* output_data,
+    CUDA_LONG N) {
+  CUDA_LONG id = NumElementsPerThread * NumThreadsPerBlock * blockIdx.x + threadIdx.x;
+
+#pragma unroll
+  for (int e = 0; e < NumElementsPerThread; e++) {
+    if (id < N) {
+      // output coordinates, only needed by the inputs with a general broadcast
+      int coordinates[kFusedElementwiseMaxRank];
+      if (HasGeneralBroadcast) {
+        int offset = id;
+#pragma unroll
+        for (int dim = 0; dim < kFusedElementwiseMaxRank; dim++) {
+          if (dim >= plan.output_rank) {
+            break;
+          }
+          int r;
+          plan.fdm_output_strides[dim].divmod(offset, coordinates[dim], r);
+          offset = r;
+        }
+      }
+
+      float values[kFusedElementwiseMaxInputs + kFusedElementwiseMaxOps];
+      for (int i = 0; i < program.num_inputs; i++) {
+        int index = 0;
+        switch (plan.kinds[i]) {
+          case FusedElementwiseBroadcast::None:
+            index = id;
+            break;
+          case FusedElementwiseBroadcast::Scalar:
+            break;
+          case FusedElementwiseBroadcast::Inner:
+            index = plan.fdm_inputs[i].mod(id);
+            break;
+          case FusedElementwiseBroadcast::Outer:
+            index = plan.fdm_inputs[i].div(id);
+            break;
+          case FusedElementwiseBroadcast::General:
+            if (HasGeneralBroadcast) {
+              for (int dim = 0; dim < plan.output_rank; dim++) {
+                index += plan.strides[i][dim] * coordinates[dim];
+              }
+            }
+            break;
+        }
+        values[i] = static_cast<float>(inputs[i][index]);
+      }
+
+      for (int k = 0; k < program.num_ops; k++) {
+        values[program.num_inputs + k] = _FusedElementwiseOp(program.ops[k],
+                                                             values[program.operands[2 * k]],
+                                                             values[program.operands[2 * k + 1]]);
+      }
+
+      output_data[id] = T(values[program.num_inputs + program.num_ops - 1]);
+      id += NumThreadsPerBlock;
+    }
+  }
+}
+
+template <typename T>
+void FusedElementwiseImpl(
+    cudaStream_t stream,
+    const FusedElementwiseProgram& program,
+    const FusedElementwiseBroadcastPlan& plan,
+    const TArray<const T*, kFusedElementwiseMaxInputs>& inputs,
+    T* output,
+    size_t count) {
+  if (count == 0)  // special case where there's a dim value of 0 in the output shape
+    return;
+
+  CUDA_LONG N = static_cast<CUDA_LONG>(count);
+  int blocksPerGrid = static_cast<int>(CeilDiv(N, GridDim::maxThreadsPerBlock * GridDim::maxElementsPerThread));
+  if (plan.has_general) {
+    _FusedElementwise<T, true, GridDim::maxThreadsPerBlock, GridDim::maxElementsPerThread>
+        <<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(program, plan, inputs, output, N);
+  } else {
+    _FusedElementwise<T, false, GridDim::maxThreadsPerBlock, GridDim::maxElementsPerThread>
+        <<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(program, plan, inputs, output, N);
+  }
+}
+
+#define SPECIALIZED_FUSED_ELEMENTWISE_IMPL(T)                                  \
+  template void FusedElementwiseImpl<T>(                                        \
+      cudaStream_t stream,                                                      \
+      const FusedElementwiseProgram& program,                                   \
+      const FusedElementwiseBroadcastPlan& plan,                                \
+      const TArray<const T*, kFusedElementwiseMaxInputs>& inputs,               \
+      T* output,                                                                \
+      size_t count);
+
+SPECIALIZED_FUSED_ELEMENTWISE_IMPL(float)
+SPECIALIZED_FUSED_ELEMENTWISE_IMPL(half)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <stdint.h>
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+constexpr int kFusedElementwiseMaxInputs = 8;
+constexpr int kFusedElementwiseMaxOps = 16;
+constexpr int kFusedElementwiseMaxRank = 8;
+
+enum class FusedElementwiseOp : int8_t {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Abs,
+  Erf,
+  Exp,
+  Log,
+  Neg,
+  Reciprocal,
+  Relu,
+  Sigmoid,
+  Sqrt,
+  Tanh,
+};
+
+// The operators of a FusedElementwise node. The values of the program are the inputs followed by the result of
+// each operator, and operator i reads the values operands[2 * i] and operands[2 * i + 1].
+struct FusedElementwiseProgram {
+  int32_t num_inputs;
+  int32_t num_ops;
+  FusedElementwiseOp ops[kFusedElementwiseMaxOps];
+  int8_t operands[2 * kFusedElementwiseMaxOps];
+};
+
+// How the offset of an input element is computed from the offset of the output element.
+enum class FusedElementwiseBroadcast : int8_t {
+  None,     // same shape as the output: the output offset
+  Scalar,   // a single value: 0
+  Inner,    // the trailing dimensions of the output, e.g. a bias: output offset % input size
+  Outer,    // the leading dimensions of the output: output offset / size of the broadcast trailing dimensions
+  General,  // the strides of the input over the output dimensions
+};
+
+// The indexing of the inputs for one combination of input shapes.
+struct FusedElementwiseBroadcastPlan {
+  int32_t output_rank;
+  bool has_general;
+  TArray<fast_divmod, kFusedElementwiseMaxRank> fdm_output_strides;
+  FusedElementwiseBroadcast kinds[kFusedElementwiseMaxInputs];
+  // divisor of the Inner and Outer inputs
+  fast_divmod fdm_inputs[kFusedElementwiseMaxInputs];
+  // strides of the General inputs for each output dimension, 0 on the broadcast dimensions
+  int32_t strides[kFusedElementwiseMaxInputs][kFusedElementwiseMaxRank];
+};
+
+template <typename T>
+void FusedElementwiseImpl(
+    cudaStream_t stream,
+    const FusedElementwiseProgram& program,
+    const FusedElementwiseBroadcastPlan& plan,
+    const TArray<const T*, kFusedElementwiseMaxInputs>& inputs,
+    T* output,
+    size_t count);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/math/gemm.h"
+#include "core/providers/cuda/activation/activations_impl.h"
+#include "contrib_ops/cuda/bert/fast_gelu_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Gemm followed by one of the activations cuBLASLt can apply in the epilogue of the matrix multiplication.
+// When cuBLASLt cannot, the activation is applied to the output in place.
+template <typename T>
+class FusedGemm final : public onnxruntime::cuda::Gemm<T> {
+ public:
+  using Base = onnxruntime::cuda::Gemm<T>;
+  FusedGemm(const OpKernelInfo& info) : Base(info) {
+    std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+    if (activation == "Relu") {
+      activation_ = onnxruntime::cuda::GemmActivation::kRelu;
+    } else if (activation == "FastGelu") {
+      activation_ = onnxruntime::cuda::GemmActivation::kFastGelu;
+    } else {
+      ORT_THROW("Unsupported activation of FusedGemm on CUDA: ", activation);
+    }
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override {
+    bool activation_applied = false;
+    ORT_RETURN_IF_ERROR(Base::ComputeGemm(context, activation_, activation_applied));
+    if (activation_applied) {
+      return Status::OK();
+    }
+
+    typedef typename onnxruntime::cuda::ToCudaType<T>::MappedType CudaT;
+    Tensor* Y = context->Output<Tensor>(0);
+    CudaT* y_data = reinterpret_cast<CudaT*>(Y->template MutableData<T>());
+    const size_t count = gsl::narrow<size_t>(Y->Shape().Size());
+    if (count == 0) {
+      return Status::OK();
+    }
+
+    if (activation_ == onnxruntime::cuda::GemmActivation::kRelu) {
+      onnxruntime::cuda::CtxRelu ctx;
+      onnxruntime::cuda::Impl_Relu<CudaT>(this->Stream(), y_data, y_data, &ctx, count);
+    } else if (!LaunchFastGeluKernel<CudaT>(this->GetDeviceProp(), this->Stream(), static_cast<int>(count), 0,
+                                            y_data, nullptr, y_data)) {
+      CUDA_CALL(cudaGetLastError());
+      return Status(common::ONNXRUNTIME, common::FAIL);
+    }
+    return Status::OK();
+  }
+
+ private:
+  onnxruntime::cuda::GemmActivation activation_;
+};
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      FusedGemm,                                                  \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      KernelDefBuilder()                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      FusedGemm<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "matmul_nbits.h"
+#include "matmul_nbits_impl.h"
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+
+#include <vector>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                       \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                       \
+      MatMulNBits,                                                     \
+      kMSDomain,                                                       \
+      1,                                                               \
+      T,                                                               \
+      kCudaExecutionProvider,                                          \
+      KernelDefBuilder()                                               \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>())      \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()), \
+      MatMulNBits<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+MatMulNBits<T>::MatMulNBits(const OpKernelInfo& op_kernel_info) : CudaKernel(op_kernel_info) {
+  ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("K", &K_).IsOK());
+  ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("N", &N_).IsOK());
+  ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("block_size", &block_size_).IsOK());
+  const int64_t bits = op_kernel_info.GetAttrOrDefault<int64_t>("bits", 4);
+  ORT_ENFORCE(bits == 4, "MatMulNBits only supports 4 bits, got ", bits);
+  ORT_ENFORCE(K_ > 0 && N_ > 0, "MatMulNBits K and N must be positive");
+  ORT_ENFORCE(block_size_ >= 16 && (block_size_ & (block_size_ - 1)) == 0,
+              "MatMulNBits block_size must be a power of 2 and at least 16, got ", block_size_);
+}
+
+template <typename T>
+Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+  const Tensor* bias = ctx->Input<Tensor>(4);
+
+  const int64_t block_count_k = (K_ + block_size_ - 1) / block_size_;
+  ORT_RETURN_IF_NOT(b->Shape().Size() == N_ * block_count_k * (block_size_ / 2),
+                    "MatMulNBits input B must hold N * ceil(K / block_size) * block_size / 2 bytes, got shape ",
+                    b->Shape());
+  ORT_RETURN_IF_NOT(scales->Shape().Size() == N_ * block_count_k,
+                    "MatMulNBits scales must hold N * ceil(K / block_size) values, got shape ", scales->Shape());
+  ORT_RETURN_IF_NOT(zero_points == nullptr || zero_points->Shape().Size() == N_ * ((block_count_k + 1) / 2),
+                    "MatMulNBits zero_points must hold N * ceil(ceil(K / block_size) / 2) bytes, got shape ",
+                    zero_points->Shape());
+  ORT_RETURN_IF_NOT(bias == nullptr || bias->Shape().Size() == N_,
+                    "MatMulNBits bias must hold N values, got shape ", bias->Shape());
+
+  const auto& a_shape = a->Shape();
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 1 && a_shape[a_shape.NumDimensions() - 1] == K_,
+                    "MatMulNBits input A must have a last dimension of K, got shape ", a_shape);
+
+  std::vector<int64_t> y_dims(a_shape.GetDims().begin(), a_shape.GetDims().end());
+  y_dims.back() = N_;
+  Tensor* y = ctx->Output(0, TensorShape(y_dims));
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  // B is shared by every matrix of A, so the leading dimensions of A are rows of one matrix
+  const int m = static_cast<int>(a_shape.SizeToDimension(a_shape.NumDimensions() - 1));
+  const int n = static_cast<int>(N_);
+  const int k = static_cast<int>(K_);
+
+  const auto* a_data = reinterpret_cast<const CudaT*>(a->template Data<T>());
+  const auto* scales_data = reinterpret_cast<const CudaT*>(scales->template Data<T>());
+  const auto* zero_points_data = zero_points != nullptr ? zero_points->template Data<uint8_t>() : nullptr;
+  const auto* bias_data = bias != nullptr ? reinterpret_cast<const CudaT*>(bias->template Data<T>()) : nullptr;
+  auto* y_data = reinterpret_cast<CudaT*>(y->template MutableData<T>());
+
+  if (m <= kMatMul4BitsGemvMaxRows) {
+    MatMul4BitsGemv<CudaT>(Stream(), y_data, a_data, b->template Data<uint8_t>(), scales_data, zero_points_data,
+                           bias_data, m, n, k, static_cast<int>(block_size_));
+    CUDA_RETURN_IF_ERROR(cudaGetLastError());
+    return Status::OK();
+  }
+
+  // More rows reuse each weight enough for cuBLAS on the dequantized weight to be faster.
+  auto b_dequantized = GetScratchBuffer<CudaT>(static_cast<size_t>(n) * k);
+  Dequantize4Bits<CudaT>(Stream(), b_dequantized.get(), b->template Data<uint8_t>(), scales_data, zero_points_data,
+                         n, k, static_cast<int>(block_size_));
+
+  cublasHandle_t cublas = CublasHandle();
+  const cudaDeviceProp& device_prop = GetDeviceProp();
+  CudaT one = ToCudaType<T>::FromFloat(1.0f);
+  CudaT zero = ToCudaType<T>::FromFloat(0.0f);
+
+  // Bias shape is (N), broadcast using Y(N, M) = 1 * bias(N, 1) x ones(1, M) + 0 * Y.
+  if (bias_data != nullptr) {
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        cublas, CUBLAS_OP_N, CUBLAS_OP_N, n, m, 1, &one,
+        bias_data, n,
+        GetConstOnes<CudaT>(m), 1,
+        &zero, y_data, n, device_prop));
+  }
+
+  // CUDA assumes col-major, so Y(N, M) = dequantized B(K, N)^T x A(K, M) + Y.
+  CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+      cublas, CUBLAS_OP_T, CUBLAS_OP_N, n, m, k, &one,
+      b_dequantized.get(), k,
+      a_data, k,
+      bias_data != nullptr ? &one : &zero, y_data, n, device_prop));
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
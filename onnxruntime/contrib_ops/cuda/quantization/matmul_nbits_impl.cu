@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "contrib_ops/cuda/quantization/matmul_nbits_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Each lane of the GEMV kernel reads 4 bytes, 8 quantized values, at a time. Blocks hold a multiple of 8 values
+// and are padded, so the reads never cross the end of a column.
+constexpr int kValuesPerLane = 8;
+constexpr int kGemvColumnsPerBlock = 8;
+
+__device__ __forceinline__ int _ZeroPoint4Bits(const uint8_t* zero_points, int column, int block, int block_count_k) {
+  if (zero_points == nullptr) {
+    return 8;
+  }
+  const uint8_t pair = zero_points[column * ((block_count_k + 1) / 2) + block / 2];
+  return (block & 1) ? (pair >> 4) : (pair & 0x0F);
+}
+
+// A warp computes one output value: its lanes walk the column of B together, so the quantized values are read
+// with coalesced 4 byte loads, and the partial sums are reduced with shuffles.
+template <typename T>
+__global__ void _MatMul4BitsGemv(
+    T* output,
+    const T* a,
+    const uint8_t* b,
+    const T* scales,
+    const uint8_t* zero_points,
+    const T* bias,
+    int n,
+    int k,
+    int block_size,
+    int block_count_k) {
+  const int column = blockIdx.x * kGemvColumnsPerBlock + threadIdx.y;
+  const int row = blockIdx.y;
+  if (column >= n) {
+    return;
+  }
+
+  const T* a_row = a + static_cast<int64_t>(row) * k;
+  const uint8_t* b_column = b + static_cast<int64_t>(column) * block_count_k * (block_size / 2);
+
+  float sum = 0.f;
+  for (int kk = threadIdx.x * kValuesPerLane; kk < k; kk += GPU_WARP_SIZE * kValuesPerLane) {
+    const uint32_t values = *reinterpret_cast<const uint32_t*>(b_column + kk / 2);
+    const int block = kk / block_size;
+    const float scale = static_cast<float>(scales[column * block_count_k + block]);
+    const int zero_point = _ZeroPoint4Bits(zero_points, column, block, block_count_k);
+
+#pragma unroll
+    for (int i = 0; i < kValuesPerLane; i++) {
+      if (kk + i < k) {
+        const int value = static_cast<int>((values >> (4 * i)) & 0x0F);
+        sum += static_cast<float>(value - zero_point) * scale * static_cast<float>(a_row[kk + i]);
+      }
+    }
+  }
+
+#pragma unroll
+  for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+    sum += WARP_SHFL_DOWN(sum, offset);
+  }
+
+  if (threadIdx.x == 0) {
+    if (bias != nullptr) {
+      sum += static_cast<float>(bias[column]);
+    }
+    output[static_cast<int64_t>(row) * n + column] = static_cast<T>(sum);
+  }
+}
+
+// Every thread dequantizes one byte, two consecutive values of a column.
+template <typename T>
+__global__ void _Dequantize4Bits(
+    T* output,
+    const uint8_t* b,
+    const T* scales,
+    const uint8_t* zero_points,
+    int k,
+    int block_size,
+    int block_count_k,
+    CUDA_LONG column_bytes,
+    CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+
+  const int column = id / column_bytes;
+  const int kk = (id % column_bytes) * 2;
+  if (kk >= k) {
+    return;
+  }
+
+  const int block = kk / block_size;
+  const float scale = static_cast<float>(scales[column * block_count_k + block]);
+  const int zero_point = _ZeroPoint4Bits(zero_points, column, block, block_count_k);
+  const uint8_t pair = b[id];
+
+  T* out = output + static_cast<int64_t>(column) * k + kk;
+  out[0] = static_cast<T>(static_cast<float>((pair & 0x0F) - zero_point) * scale);
+  if (kk + 1 < k) {
+    out[1] = static_cast<T>(static_cast<float>((pair >> 4) - zero_point) * scale);
+  }
+}
+
+template <typename T>
+void MatMul4BitsGemv(
+    cudaStream_t stream,
+    T* output,
+    const T* a,
+    const uint8_t* b,
+    const T* scales,
+    const uint8_t* zero_points,
+    const T* bias,
+    int m,
+    int n,
+    int k,
+    int block_size) {
+  const int block_count_k = CeilDiv(k, block_size);
+  const dim3 threads(GPU_WARP_SIZE, kGemvColumnsPerBlock);
+  const dim3 blocks(CeilDiv(n, kGemvColumnsPerBlock), m);
+  _MatMul4BitsGemv<T><<<blocks, threads, 0, stream>>>(
+      output, a, b, scales, zero_points, bias, n, k, block_size, block_count_k);
+}
+
+template <typename T>
+void Dequantize4Bits(
+    cudaStream_t stream,
+    T* output,
+    const uint8_t* b,
+    const T* scales,
+    const uint8_t* zero_points,
+    int n,
+    int k,
+    int block_size) {
+  const int block_count_k = CeilDiv(k, block_size);
+  const CUDA_LONG column_bytes = static_cast<CUDA_LONG>(block_count_k * (block_size / 2));
+  const CUDA_LONG N = column_bytes * n;
+  const int blocksPerGrid = static_cast<int>(CeilDiv(N, GridDim::maxThreadsPerBlock));
+  _Dequantize4Bits<T><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      output, b, scales, zero_points, k, block_size, block_count_k, column_bytes, N);
+}
+
+#define SPECIALIZED_MATMUL_4BITS_IMPL(T)                                                                         \
+  template void MatMul4BitsGemv<T>(cudaStream_t stream, T * output, const T* a, const uint8_t* b,             \
+                                   const T* scales, const uint8_t* zero_points, const T* bias,               \
+                                   int m, int n, int k, int block_size);                                     \
+  template void Dequantize4Bits<T>(cudaStream_t stream, T * output, const uint8_t* b, const T* scales,        \
+                                   const uint8_t* zero_points, int n, int k, int block_size);
+
+SPECIALIZED_MATMUL_4BITS_IMPL(float)
+SPECIALIZED_MATMUL_4BITS_IMPL(half)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
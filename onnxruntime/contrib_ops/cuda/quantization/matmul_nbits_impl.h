@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <stdint.h>
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Number of rows of A up to which MatMulNBits multiplies the quantized weight directly, instead of
+// dequantizing it for cuBLAS.
+constexpr int kMatMul4BitsGemvMaxRows = 4;
+
+// Computes output[m, n] = a[m, :] * dequantize(b)[:, n] + bias[n], reading each quantized value of B once
+// per row of A.
+template <typename T>
+void MatMul4BitsGemv(
+    cudaStream_t stream,
+    T* output,
+    const T* a,
+    const uint8_t* b,
+    const T* scales,
+    const uint8_t* zero_points,
+    const T* bias,
+    int m,
+    int n,
+    int k,
+    int block_size);
+
+// Dequantizes B into a column major [K, N] matrix, that is row n of output holds column n of B.
+template <typename T>
+void Dequantize4Bits(
+    cudaStream_t stream,
+    T* output,
+    const uint8_t* b,
+    const T* scales,
+    const uint8_t* zero_points,
+    int n,
+    int k,
+    int block_size);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/transformers/beam_search.h"
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    BeamSearch,
+    kMSDomain,
+    1,
+    float,
+    kCudaExecutionProvider,
+    KernelDefBuilder()
+        .InputMemoryType<OrtMemTypeCPUInput>(0)  // 'input_ids' is needed on CPU to build the sequences
+        .InputMemoryType<OrtMemTypeCPUInput>(1)  // the scalar parameters need to be on CPU
+        .InputMemoryType<OrtMemTypeCPUInput>(2)
+        .InputMemoryType<OrtMemTypeCPUInput>(3)
+        .InputMemoryType<OrtMemTypeCPUInput>(4)
+        .InputMemoryType<OrtMemTypeCPUInput>(5)
+        .InputMemoryType<OrtMemTypeCPUInput>(6)
+        .InputMemoryType<OrtMemTypeCPUInput>(7)
+        .OutputMemoryType<OrtMemTypeCPUOutput>(0)  // the sequences and scores are produced on CPU
+        .OutputMemoryType<OrtMemTypeCPUOutput>(1)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    BeamSearch);
+
+static Status CopyGpuState(void* stream, void* target, const void* source, size_t size_in_bytes) {
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(target, source, size_in_bytes, cudaMemcpyDeviceToDevice,
+                                       static_cast<cudaStream_t>(stream)));
+  return Status::OK();
+}
+
+BeamSearch::BeamSearch(const OpKernelInfo& info) : onnxruntime::contrib::transformers::BeamSearch(info) {
+  SetDeviceCopyFunc(CopyGpuState);
+  SetComputeStream(static_cast<void*>(info.GetExecutionProvider()->GetComputeStream()));
+}
+
+Status BeamSearch::Compute(OpKernelContext* ctx) const {
+  // call the base CPU version.
+  // we have this CUDA implementation so the decoder subgraph and its past state stay on GPU between steps,
+  // and only the logits of each step are copied to CPU to select the next tokens.
+  auto status = onnxruntime::contrib::transformers::BeamSearch::Compute(ctx);
+  return status;
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
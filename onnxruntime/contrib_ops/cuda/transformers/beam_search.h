@@ -0,0 +1,23 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "contrib_ops/cpu/transformers/beam_search.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Use the CPU implementation for the logic
+class BeamSearch final : public onnxruntime::contrib::transformers::BeamSearch {
+ public:
+  BeamSearch(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
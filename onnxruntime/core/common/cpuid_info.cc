@@ -6,8 +6,11 @@
 #endif
 
 #if defined(PLATFORM_X86)
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <mutex>
+#include <sstream>
 
 #if defined(_MSC_VER)
 #include <intrin.h>
@@ -17,6 +20,7 @@
 #endif
 
 #include "core/common/cpuid_info.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime {
 
@@ -29,6 +33,14 @@ static inline void GetCPUID(int function_id, int data[4]) {  // NOLINT
 #endif
 }
 
+static inline void GetCPUID(int function_id, int subfunction_id, int data[4]) {  // NOLINT
+#if defined(_MSC_VER)
+  __cpuidex(reinterpret_cast<int*>(data), function_id, subfunction_id);
+#elif defined(__GNUC__)
+  __cpuid_count(function_id, subfunction_id, data[0], data[1], data[2], data[3]);
+#endif
+}
+
 static inline int XGETBV() {
 #if defined(_MSC_VER)
   return static_cast<int>(_xgetbv(0));
@@ -40,6 +52,89 @@ static inline int XGETBV() {
   return eax;
 #endif
 }
+
+static std::string GetSignatureX86() {
+  int data[4] = {-1};
+  char vendor[13] = {};
+  GetCPUID(0, data);
+  memcpy(vendor, &data[1], 4);
+  memcpy(vendor + 4, &data[3], 4);
+  memcpy(vendor + 8, &data[2], 4);
+
+  int family = 0, model = 0, stepping = 0;
+  if (data[0] >= 1) {
+    GetCPUID(1, data);
+    family = (data[0] >> 8) & 0xF;
+    model = (data[0] >> 4) & 0xF;
+    stepping = data[0] & 0xF;
+    if (family == 0xF) {
+      family += (data[0] >> 20) & 0xFF;
+    }
+    if (family == 0x6 || family >= 0xF) {
+      model += ((data[0] >> 16) & 0xF) << 4;
+    }
+  }
+
+  std::string brand;
+  GetCPUID(0x80000000, data);
+  if (static_cast<unsigned int>(data[0]) >= 0x80000004) {
+    char brand_string[49] = {};
+    for (int i = 0; i < 3; ++i) {
+      GetCPUID(0x80000002 + i, data);
+      memcpy(brand_string + i * 16, data, 16);
+    }
+    brand = brand_string;
+    brand.erase(0, brand.find_first_not_of(' '));
+    brand.erase(brand.find_last_not_of(' ') + 1);
+  }
+
+  std::ostringstream signature;
+  signature << vendor << " " << family << "-" << model << "-" << stepping;
+  if (!brand.empty()) {
+    signature << " " << brand;
+  }
+  return signature.str();
+}
+
+// Walks the deterministic cache parameters (leaf 4 on Intel, leaf 0x8000001D on AMD) and returns the size of the
+// largest data or unified cache.
+static size_t GetLastLevelCacheSizeX86() {
+  int data[4] = {-1};
+  GetCPUID(0, data);
+  int cache_leaf = 0;
+  if (data[0] >= 4 && data[1] == 0x756e6547) {  // "Genu"ineIntel
+    cache_leaf = 4;
+  } else {
+    GetCPUID(0x80000000, data);
+    if (static_cast<unsigned int>(data[0]) >= 0x8000001D) {
+      GetCPUID(0x80000001, data);
+      if (data[2] & (1 << 22)) {  // topology extensions
+        cache_leaf = 0x8000001D;
+      }
+    }
+  }
+  if (cache_leaf == 0) {
+    return 0;
+  }
+
+  size_t cache_size = 0;
+  for (int index = 0; index < 16; ++index) {
+    GetCPUID(cache_leaf, index, data);
+    int cache_type = data[0] & 0x1F;
+    if (cache_type == 0) {
+      break;
+    }
+    if (cache_type == 2) {  // instruction cache
+      continue;
+    }
+    size_t ways = ((static_cast<unsigned int>(data[1]) >> 22) & 0x3FF) + 1;
+    size_t partitions = ((data[1] >> 12) & 0x3FF) + 1;
+    size_t line_size = (data[1] & 0xFFF) + 1;
+    size_t sets = static_cast<size_t>(static_cast<unsigned int>(data[2])) + 1;
+    cache_size = std::max(cache_size, ways * partitions * line_size * sets);
+  }
+  return cache_size;
+}
 #endif  // PLATFORM_X86
 
 CPUIDInfo::CPUIDInfo() noexcept {
@@ -72,6 +167,12 @@ CPUIDInfo::CPUIDInfo() noexcept {
       }
     }
   }
+
+  signature_ = GetSignatureX86();
+  last_level_cache_size_ = GetLastLevelCacheSizeX86();
+#else
+  // There is no CPUID hybrid flag elsewhere, e.g. on ARM big.LITTLE, so ask the OS whether the cores differ.
+  is_hybrid_ = !Env::Default().GetPerformanceCoreThreadAffinityMasks().empty();
 #endif
 }
 
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <string>
+
 namespace onnxruntime {
 
 class CPUIDInfo {
@@ -18,8 +21,16 @@ class CPUIDInfo {
   bool HasAVX512Skylake() const { return has_avx512_skylake_; }
   bool HasF16C() const { return has_f16c_; }
   bool HasSSE3() const { return has_sse3_; }
+  // True if the CPU has cores of different types, e.g. P-cores and E-cores, or ARM big.LITTLE.
   bool IsHybrid() const { return is_hybrid_; }
 
+  // Identifies the CPU model (vendor, family/model/stepping and brand string on x86) so that
+  // per-CPU tuning results can be cached and looked up again.
+  const std::string& GetSignature() const { return signature_; }
+
+  // Size in bytes of the largest (last level) data or unified cache, or 0 if it could not be determined.
+  size_t GetLastLevelCacheSize() const { return last_level_cache_size_; }
+
  private:
   CPUIDInfo() noexcept;
   bool has_avx_{false};
@@ -29,6 +40,8 @@ class CPUIDInfo {
   bool has_f16c_{false};
   bool has_sse3_{false};
   bool is_hybrid_{false};
+  std::string signature_{"unknown"};
+  size_t last_level_cache_size_{0};
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#include <sstream>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+
+constexpr uint64_t kCacheLineBytes = 64;
+
+#ifdef __linux__
+int OpenCounter(uint32_t type, uint64_t config, int os_thread_id) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // the counters are multiplexed when the PMU runs out of registers, the times are used to scale the counts
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, os_thread_id, -1, -1, 0));
+}
+#endif
+
+}  // namespace
+
+HardwareCounters::HardwareCounters(int os_thread_id) {
+  for (int i = 0; i < MAX_COUNTER; ++i) {
+    fds_[i] = -1;
+  }
+#ifdef __linux__
+  fds_[CYCLES] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, os_thread_id);
+  fds_[INSTRUCTIONS] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, os_thread_id);
+  fds_[LLC_MISSES] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, os_thread_id);
+  fds_[LLC_READ_MISSES] = OpenCounter(PERF_TYPE_HW_CACHE,
+                                      PERF_COUNT_HW_CACHE_LL |
+                                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                                      os_thread_id);
+#else
+  ORT_UNUSED_PARAMETER(os_thread_id);
+#endif
+  Start();
+}
+
+HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+  for (int i = 0; i < MAX_COUNTER; ++i) {
+    if (fds_[i] >= 0) {
+      close(fds_[i]);
+    }
+  }
+#endif
+}
+
+bool HardwareCounters::IsAvailable() const {
+  for (int i = 0; i < MAX_COUNTER; ++i) {
+    if (fds_[i] >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t HardwareCounters::Read(Counter counter) const {
+#ifdef __linux__
+  uint64_t values[3];  // value, time enabled, time running
+  if (fds_[counter] < 0 || read(fds_[counter], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) {
+    return 0;
+  }
+  if (values[2] == 0) {
+    return 0;
+  }
+  if (values[2] < values[1]) {
+    return static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+  }
+  return values[0];
+#else
+  ORT_UNUSED_PARAMETER(counter);
+  return 0;
+#endif
+}
+
+void HardwareCounters::Start() {
+  for (int i = 0; i < MAX_COUNTER; ++i) {
+    start_[i] = Read(static_cast<Counter>(i));
+  }
+}
+
+std::string HardwareCounters::Stop() {
+  if (!IsAvailable()) {
+    return {};
+  }
+
+  uint64_t counts[MAX_COUNTER];
+  for (int i = 0; i < MAX_COUNTER; ++i) {
+    const uint64_t now = Read(static_cast<Counter>(i));
+    // a scaled count can go slightly backward
+    counts[i] = now > start_[i] ? now - start_[i] : 0;
+  }
+
+  std::stringstream ss;
+  ss << "{";
+  const char* separator = "";
+  if (fds_[CYCLES] >= 0) {
+    ss << separator << "\"cycles\": " << counts[CYCLES];
+    separator = ", ";
+  }
+  if (fds_[INSTRUCTIONS] >= 0) {
+    ss << separator << "\"instructions\": " << counts[INSTRUCTIONS];
+    separator = ", ";
+  }
+  if (fds_[LLC_MISSES] >= 0) {
+    ss << separator << "\"llc_misses\": " << counts[LLC_MISSES];
+    separator = ", ";
+  }
+  if (fds_[LLC_READ_MISSES] >= 0) {
+    ss << separator << "\"dram_read_bytes\": " << counts[LLC_READ_MISSES] * kCacheLineBytes;
+  }
+  ss << "}";
+  return ss.str();
+}
+
+int HardwareCounters::GetCurrentOsThreadId() {
+#ifdef __linux__
+  return static_cast<int>(syscall(SYS_gettid));
+#else
+  return 0;
+#endif
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
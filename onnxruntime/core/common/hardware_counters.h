@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+/**
+ * Hardware performance counters of a single thread, sampled with the perf_event interface on Linux.
+ * The counters are opened when the object is created and keep counting until it is destroyed.
+ * On other platforms, or when the kernel refuses access (see /proc/sys/kernel/perf_event_paranoid),
+ * IsAvailable() returns false and Stop() returns an empty string.
+ */
+class HardwareCounters {
+ public:
+  enum Counter {
+    CYCLES = 0,
+    INSTRUCTIONS,
+    LLC_MISSES,
+    LLC_READ_MISSES,
+    MAX_COUNTER
+  };
+
+  /*
+  Opens the counters of the thread with the given OS thread id, 0 for the calling thread.
+  */
+  explicit HardwareCounters(int os_thread_id = 0);
+  ~HardwareCounters();
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HardwareCounters);
+
+  bool IsAvailable() const;
+
+  /*
+  Record the current counts as the starting point.
+  */
+  void Start();
+
+  /*
+  Return the events counted since the last call to Start() as a JSON object, e.g.
+  {"cycles": 1000, "instructions": 2000, "llc_misses": 10, "dram_read_bytes": 512}.
+  dram_read_bytes is estimated from the last level cache read misses and the cache line size.
+  Counters that are not supported by the CPU are left out.
+  */
+  std::string Stop();
+
+  /*
+  Return the OS id of the calling thread, which can be passed to the constructor from another thread.
+  */
+  static int GetCurrentOsThreadId();
+
+ private:
+  uint64_t Read(Counter counter) const;
+
+  int fds_[MAX_COUNTER];
+  uint64_t start_[MAX_COUNTER] = {};
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
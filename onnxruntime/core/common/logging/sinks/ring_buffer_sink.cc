@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/sinks/ring_buffer_sink.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace onnxruntime {
+namespace logging {
+
+// Identifies the sinks in the rings cached by each thread, as a new sink may reuse the address of a destroyed one.
+static std::atomic<uint64_t> next_ring_buffer_sink_id{0};
+
+RingBufferSink::RingBufferSink(std::unique_ptr<ISink> sink, size_t capacity)
+    : sink_{std::move(sink)}, capacity_{std::max<size_t>(capacity, 1)}, id_{next_ring_buffer_sink_id++} {
+  thread_ = std::thread([this]() { DrainLoop(); });
+}
+
+RingBufferSink::~RingBufferSink() {
+  {
+    std::lock_guard<OrtMutex> lock(wake_mutex_);
+    done_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+
+  std::lock_guard<OrtMutex> drain_lock(drain_mutex_);
+  Drain();
+  std::lock_guard<OrtMutex> lock(rings_mutex_);
+  for (auto& ring : rings_) {
+    ring->closed.store(true, std::memory_order_relaxed);
+  }
+}
+
+RingBufferSink::Ring& RingBufferSink::ThreadRing() {
+  // The rings this thread logs to, by sink id. The sinks keep the rings alive after the thread exits, until
+  // the messages have been passed on.
+  thread_local std::unordered_map<uint64_t, std::shared_ptr<Ring>> thread_rings;
+
+  auto it = thread_rings.find(id_);
+  if (it != thread_rings.end()) {
+    return *it->second;
+  }
+
+  // Forget the rings of the destroyed sinks before caching a new one.
+  for (auto ring_it = thread_rings.begin(); ring_it != thread_rings.end();) {
+    if (ring_it->second->closed.load(std::memory_order_relaxed)) {
+      ring_it = thread_rings.erase(ring_it);
+    } else {
+      ++ring_it;
+    }
+  }
+
+  auto ring = std::make_shared<Ring>(capacity_);
+  {
+    std::lock_guard<OrtMutex> lock(rings_mutex_);
+    rings_.push_back(ring);
+  }
+  return *thread_rings.emplace(id_, std::move(ring)).first->second;
+}
+
+void RingBufferSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  Ring& ring = ThreadRing();
+  const size_t head = ring.head.load(std::memory_order_relaxed);
+  if (head - ring.tail.load(std::memory_order_acquire) == capacity_) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // Assigning the strings reuses the memory of the record from the previous time around the ring.
+  Record& record = ring.records[head % capacity_];
+  record.timestamp = timestamp;
+  record.logger_id.assign(logger_id);
+  record.severity = message.Severity();
+  record.category = message.Category();
+  record.data_type = message.DataType();
+  record.file_and_path.assign(message.Location().file_and_path);
+  record.line_num = message.Location().line_num;
+  record.function.assign(message.Location().function);
+  record.message = message.Message();
+  ring.head.store(head + 1, std::memory_order_release);
+
+  if (message.Severity() >= Severity::kERROR) {
+    Flush();
+  }
+}
+
+void RingBufferSink::Flush() {
+  std::lock_guard<OrtMutex> lock(drain_mutex_);
+  Drain();
+}
+
+void RingBufferSink::Drain() {
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<OrtMutex> lock(rings_mutex_);
+    // Drop the rings of the threads that have exited once they are empty. Only the sink holds them then.
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                [](const std::shared_ptr<Ring>& ring) {
+                                  return ring.use_count() == 1 &&
+                                         ring->tail.load(std::memory_order_relaxed) ==
+                                             ring->head.load(std::memory_order_acquire);
+                                }),
+                 rings_.end());
+    rings = rings_;
+  }
+
+  for (auto& ring : rings) {
+    const size_t head = ring->head.load(std::memory_order_acquire);
+    for (size_t tail = ring->tail.load(std::memory_order_relaxed); tail != head; ++tail) {
+      const Record& record = ring->records[tail % capacity_];
+      Capture capture(record.severity, record.category, record.data_type,
+                      CodeLocation(record.file_and_path.c_str(), record.line_num, record.function.c_str()));
+      capture.Stream() << record.message;
+      sink_->Send(record.timestamp, record.logger_id, capture);
+      ring->tail.store(tail + 1, std::memory_order_release);
+    }
+  }
+}
+
+void RingBufferSink::DrainLoop() {
+  std::unique_lock<OrtMutex> lock(wake_mutex_);
+  while (!done_) {
+    wake_.wait_for(lock, std::chrono::milliseconds(10));
+    lock.unlock();
+    {
+      std::lock_guard<OrtMutex> drain_lock(drain_mutex_);
+      Drain();
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace logging
+}  // namespace onnxruntime
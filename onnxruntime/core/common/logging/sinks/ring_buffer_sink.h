@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/logging/capture.h"
+#include "core/common/logging/isink.h"
+#include "core/common/logging/logging.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace logging {
+/// <summary>
+/// ISink that hands the messages to a background thread, which passes them on to another sink.
+/// Each logging thread appends its messages to a ring buffer of its own without taking a lock, so logging on
+/// the hot path of a Run does not wait for the formatting and output of the other sink, e.g. on the lock of
+/// std::clog or on a slow custom logging function. The buffered copies of the strings reuse their memory once
+/// a ring buffer has wrapped around.
+/// Messages are dropped, and counted, when the ring buffer of a thread is full. Messages of Severity::kERROR and
+/// above are flushed before SendImpl returns, so they are not lost if the process ends.
+/// </summary>
+/// <seealso cref="ISink" />
+class RingBufferSink : public ISink {
+ public:
+  /// <summary>
+  /// Initializes a new instance of the <see cref="RingBufferSink"/> class.
+  /// </summary>
+  /// <param name="sink">The sink to pass the messages to, from the background thread.</param>
+  /// <param name="capacity">The number of messages buffered per logging thread.</param>
+  explicit RingBufferSink(std::unique_ptr<ISink> sink, size_t capacity = 1024);
+
+  /// <summary>
+  /// Passes the remaining messages to the sink and stops the background thread.
+  /// </summary>
+  ~RingBufferSink() override;
+
+  /// <summary>
+  /// Passes the messages buffered so far to the sink before returning.
+  /// </summary>
+  void Flush();
+
+  /// <summary>
+  /// The number of messages dropped because the ring buffer of the logging thread was full.
+  /// </summary>
+  uint64_t DroppedMessages() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  void SendProfileEvent(profiling::EventRecord& event_record) const override {
+    sink_->SendProfileEvent(event_record);
+  }
+
+ private:
+  struct Record {
+    Timestamp timestamp;
+    std::string logger_id;
+    Severity severity;
+    const char* category;  // the categories are string literals
+    DataType data_type;
+    std::string file_and_path;
+    int line_num;
+    std::string function;
+    std::string message;
+  };
+
+  // Single producer, single consumer queue of the messages of one logging thread.
+  struct Ring {
+    explicit Ring(size_t capacity) : records(capacity) {}
+    std::vector<Record> records;
+    std::atomic<size_t> head{0};         // next record to write, advanced by the logging thread
+    std::atomic<size_t> tail{0};         // next record to pass on, advanced under drain_mutex_
+    std::atomic<bool> closed{false};     // set when the sink is destroyed
+  };
+
+  void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
+
+  Ring& ThreadRing();
+  void DrainLoop();
+  // Passes the buffered messages to the sink. Requires drain_mutex_.
+  void Drain();
+
+  std::unique_ptr<ISink> sink_;
+  const size_t capacity_;
+  const uint64_t id_;
+
+  // Guards rings_. Taken by the logging threads only for their first message.
+  OrtMutex rings_mutex_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+
+  // Serializes the consumers of the rings, i.e. the background thread and Flush.
+  OrtMutex drain_mutex_;
+
+  OrtMutex wake_mutex_;
+  OrtCondVar wake_;
+  bool done_ = false;  // guarded by wake_mutex_
+
+  std::atomic<uint64_t> dropped_{0};
+  std::thread thread_;
+};
+}  // namespace logging
+}  // namespace onnxruntime
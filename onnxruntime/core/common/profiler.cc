@@ -3,11 +3,20 @@
 
 #include "profiler.h"
 #include <cmath>
+#include "core/common/hardware_counters.h"
+#include "core/platform/threadpool.h"
 
 #ifdef USE_CUDA
 #include <cupti.h>
 #endif
 
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#elif !defined(__wasm__)
+#include <sys/resource.h>
+#endif
+
 namespace onnxruntime {
 namespace profiling {
 using namespace std::chrono;
@@ -16,7 +25,11 @@ class DeviceProfiler {
  public:
   static DeviceProfiler* GetDeviceProfiler();
   virtual void StartProfiling(TimePoint start_time, int pid, int tid) = 0;
-  virtual std::vector<EventRecord> EndProfiling() = 0;
+  // Events are given the name of their correlation id in correlation_names as their "node_name" argument.
+  virtual std::vector<EventRecord> EndProfiling(const std::unordered_map<uint64_t, std::string>& correlation_names) = 0;
+  // Attribute the device activities launched by the calling thread to the correlation id until PopCorrelation().
+  virtual void PushCorrelation(uint64_t correlation_id) = 0;
+  virtual void PopCorrelation() = 0;
   virtual ~DeviceProfiler() = default;
 };
 
@@ -33,11 +46,14 @@ class CudaProfiler final: public DeviceProfiler {
   ~CudaProfiler() = default;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudaProfiler);
   void StartProfiling(TimePoint start_time, int pid, int tid) override;
-  std::vector<EventRecord> EndProfiling() override;
+  std::vector<EventRecord> EndProfiling(const std::unordered_map<uint64_t, std::string>& correlation_names) override;
+  void PushCorrelation(uint64_t correlation_id) override;
+  void PopCorrelation() override;
  private:
   CudaProfiler() = default;
   static void CUPTIAPI BufferRequested(uint8_t**, size_t*, size_t*);
   static void CUPTIAPI BufferCompleted(CUcontext, uint32_t, uint8_t*, size_t, size_t);
+  // a kernel, or a memory copy if bytes_ is not negative
   struct KernelStat {
     std::string name_ = {};
     uint32_t stream_ = 0;
@@ -49,11 +65,17 @@ class CudaProfiler final: public DeviceProfiler {
     int32_t block_z_ = 0;
     int64_t start_ = 0;
     int64_t stop_ = 0;
+    uint32_t correlation_id_ = 0;
+    int64_t bytes_ = -1;
   };
   static OrtMutex mutex_;
   static std::vector<KernelStat> stats_;
+  // CUPTI correlation id of the launching API call -> correlation id pushed by PushCorrelation()
+  static std::unordered_map<uint32_t, uint64_t> external_ids_;
   bool initialized_ = false;
   TimePoint start_time_;
+  // CUPTI timestamp at start_time_, as the device timestamps are not on the host clock
+  uint64_t cupti_start_time_ = 0;
   int pid_ = 0;
   int tid_ = 0;
   static std::atomic_flag enabled_;
@@ -61,8 +83,24 @@ class CudaProfiler final: public DeviceProfiler {
 
 OrtMutex CudaProfiler::mutex_;
 std::vector<CudaProfiler::KernelStat> CudaProfiler::stats_;
+std::unordered_map<uint32_t, uint64_t> CudaProfiler::external_ids_;
 std::atomic_flag CudaProfiler::enabled_;
 
+static const char* MemcpyKindName(uint8_t kind) {
+  switch (kind) {
+    case CUPTI_ACTIVITY_MEMCPY_KIND_HTOD:
+      return "Memcpy HtoD";
+    case CUPTI_ACTIVITY_MEMCPY_KIND_DTOH:
+      return "Memcpy DtoH";
+    case CUPTI_ACTIVITY_MEMCPY_KIND_DTOD:
+      return "Memcpy DtoD";
+    case CUPTI_ACTIVITY_MEMCPY_KIND_PTOP:
+      return "Memcpy PtoP";
+    default:
+      return "Memcpy";
+  }
+}
+
 void CUPTIAPI CudaProfiler::BufferRequested(uint8_t** buffer, size_t* size, size_t* maxNumRecords) {
   uint8_t* bfr = (uint8_t*)malloc(BUF_SIZE + ALIGN_SIZE);
   ORT_ENFORCE(bfr, "Failed to allocate memory for cuda kernel profiling.");
@@ -79,13 +117,25 @@ void CUPTIAPI CudaProfiler::BufferCompleted(CUcontext, uint32_t, uint8_t* buffer
     do {
       status = cuptiActivityGetNextRecord(buffer, validSize, &record);
       if (status == CUPTI_SUCCESS) {
-        if (CUPTI_ACTIVITY_KIND_KERNEL == record->kind) {
+        if (CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL == record->kind) {
           CUpti_ActivityKernel4* kernel = (CUpti_ActivityKernel4*)record;
           stats_.push_back({kernel->name, kernel->streamId,
                             kernel->gridX, kernel->gridY, kernel->gridZ,
                             kernel->blockX, kernel->blockY, kernel->blockZ,
                             static_cast<int64_t>(kernel->start),
-                            static_cast<int64_t>(kernel->end)});
+                            static_cast<int64_t>(kernel->end),
+                            kernel->correlationId});
+        } else if (CUPTI_ACTIVITY_KIND_MEMCPY == record->kind) {
+          CUpti_ActivityMemcpy* copy = (CUpti_ActivityMemcpy*)record;
+          stats_.push_back({MemcpyKindName(copy->copyKind), copy->streamId,
+                            0, 0, 0, 0, 0, 0,
+                            static_cast<int64_t>(copy->start),
+                            static_cast<int64_t>(copy->end),
+                            copy->correlationId,
+                            static_cast<int64_t>(copy->bytes)});
+        } else if (CUPTI_ACTIVITY_KIND_EXTERNAL_CORRELATION == record->kind) {
+          CUpti_ActivityExternalCorrelation* correlation = (CUpti_ActivityExternalCorrelation*)record;
+          external_ids_[correlation->correlationId] = correlation->externalId;
         }
       } else if (status == CUPTI_ERROR_MAX_LIMIT_REACHED) {
         break;
@@ -100,31 +150,67 @@ void CudaProfiler::StartProfiling(TimePoint start_time, int pid, int tid) {
     start_time_ = start_time;
     pid_ = pid;
     tid_ = tid;
-    if (cuptiActivityEnable(CUPTI_ACTIVITY_KIND_KERNEL) == CUPTI_SUCCESS &&
-        cuptiActivityRegisterCallbacks(BufferRequested, BufferCompleted) == CUPTI_SUCCESS) {
+    // CONCURRENT_KERNEL, unlike KERNEL, does not serialize the kernels of different streams
+    if (cuptiActivityEnable(CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL) == CUPTI_SUCCESS &&
+        cuptiActivityEnable(CUPTI_ACTIVITY_KIND_MEMCPY) == CUPTI_SUCCESS &&
+        cuptiActivityEnable(CUPTI_ACTIVITY_KIND_EXTERNAL_CORRELATION) == CUPTI_SUCCESS &&
+        cuptiActivityRegisterCallbacks(BufferRequested, BufferCompleted) == CUPTI_SUCCESS &&
+        cuptiGetTimestamp(&cupti_start_time_) == CUPTI_SUCCESS) {
       initialized_ = true;
     }
   }
 }
 
-std::vector<EventRecord> CudaProfiler::EndProfiling() {
+void CudaProfiler::PushCorrelation(uint64_t correlation_id) {
+  if (initialized_) {
+    cuptiActivityPushExternalCorrelationId(CUPTI_EXTERNAL_CORRELATION_KIND_CUSTOM0, correlation_id);
+  }
+}
+
+void CudaProfiler::PopCorrelation() {
+  if (initialized_) {
+    uint64_t correlation_id;
+    cuptiActivityPopExternalCorrelationId(CUPTI_EXTERNAL_CORRELATION_KIND_CUSTOM0, &correlation_id);
+  }
+}
+
+std::vector<EventRecord> CudaProfiler::EndProfiling(
+    const std::unordered_map<uint64_t, std::string>& correlation_names) {
   std::vector<EventRecord> events;
   if (enabled_.test_and_set()) {
     if (initialized_) {
       cuptiActivityFlushAll(1);
+      cuptiActivityDisable(CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL);
+      cuptiActivityDisable(CUPTI_ACTIVITY_KIND_MEMCPY);
+      cuptiActivityDisable(CUPTI_ACTIVITY_KIND_EXTERNAL_CORRELATION);
       std::unique_lock<OrtMutex> lock(mutex_);
-      int64_t profiling_start = std::chrono::duration_cast<nanoseconds>(start_time_.time_since_epoch()).count();
+      const int64_t profiling_start = static_cast<int64_t>(cupti_start_time_);
       for (const auto& stat : stats_) {
-        std::initializer_list<std::pair<std::string, std::string>> args = {{"stream", std::to_string(stat.stream_)},
-                                                                           {"grid_x", std::to_string(stat.grid_x_)},
-                                                                           {"grid_y", std::to_string(stat.grid_y_)},
-                                                                           {"grid_z", std::to_string(stat.grid_z_)},
-                                                                           {"block_x", std::to_string(stat.block_x_)},
-                                                                           {"block_y", std::to_string(stat.block_y_)},
-                                                                           {"block_z", std::to_string(stat.block_z_)}};
-        events.push_back({EventCategory::KERNEL_EVENT, pid_, tid_, stat.name_, DUR(profiling_start, stat.stop_), DUR(stat.start_, stat.stop_), {args.begin(), args.end()}});
+        std::unordered_map<std::string, std::string> args;
+        args.emplace("stream", std::to_string(stat.stream_));
+        if (stat.bytes_ >= 0) {
+          args.emplace("bytes", std::to_string(stat.bytes_));
+        } else {
+          args.emplace("grid_x", std::to_string(stat.grid_x_));
+          args.emplace("grid_y", std::to_string(stat.grid_y_));
+          args.emplace("grid_z", std::to_string(stat.grid_z_));
+          args.emplace("block_x", std::to_string(stat.block_x_));
+          args.emplace("block_y", std::to_string(stat.block_y_));
+          args.emplace("block_z", std::to_string(stat.block_z_));
+        }
+        auto external_id = external_ids_.find(stat.correlation_id_);
+        if (external_id != external_ids_.end()) {
+          auto name = correlation_names.find(external_id->second);
+          if (name != correlation_names.end()) {
+            args.emplace("node_name", name->second);
+          }
+        }
+        events.push_back({EventCategory::KERNEL_EVENT, pid_, tid_, stat.name_, DUR(profiling_start, stat.start_),
+                          DUR(stat.start_, stat.stop_), std::move(args)});
       }
       stats_.clear();
+      external_ids_.clear();
+      initialized_ = false;
     } else {
       std::initializer_list<std::pair<std::string, std::string>> args;
       events.push_back({EventCategory::KERNEL_EVENT, pid_, tid_, "not_available_due_to_cupti_error", 0, 0, {args.begin(), args.end()}});
@@ -145,6 +231,7 @@ DeviceProfiler* DeviceProfiler::GetDeviceProfiler() {
 }
 
 std::atomic<size_t> Profiler::global_max_num_events_{1000 * 1000};
+std::atomic<uint64_t> Profiler::next_device_correlation_id_{1};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
 Profiler* Profiler::instance_ = nullptr;
@@ -210,7 +297,17 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      const std::initializer_list<std::pair<std::string, std::string>>& event_args,
                                      bool sync_gpu) {
   EndTimeAndRecordEvent(category, event_name, TimeDiffMicroSeconds(start_time, end_time),
-                        TimeDiffMicroSeconds(profiling_start_time_, start_time), event_args, sync_gpu);
+                        TimeDiffMicroSeconds(profiling_start_time_, start_time),
+                        {event_args.begin(), event_args.end()}, sync_gpu);
+}
+
+void Profiler::EndTimeAndRecordEvent(EventCategory category,
+                                     const std::string& event_name,
+                                     const TimePoint& start_time, const TimePoint& end_time,
+                                     std::unordered_map<std::string, std::string>&& event_args,
+                                     bool sync_gpu) {
+  EndTimeAndRecordEvent(category, event_name, TimeDiffMicroSeconds(start_time, end_time),
+                        TimeDiffMicroSeconds(profiling_start_time_, start_time), std::move(event_args), sync_gpu);
 }
 
 void Profiler::EndTimeAndRecordEvent(EventCategory category,
@@ -219,24 +316,28 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      const std::initializer_list<std::pair<std::string, std::string>>& event_args,
                                      bool sync_gpu) {
   EndTimeAndRecordEvent(category, event_name, TimeDiffMicroSeconds(start_time),
-                        TimeDiffMicroSeconds(profiling_start_time_, start_time), event_args, sync_gpu);
+                        TimeDiffMicroSeconds(profiling_start_time_, start_time),
+                        {event_args.begin(), event_args.end()}, sync_gpu);
 }
 
 void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      const std::string& event_name,
                                      long long duration,         //duration of the op
                                      long long time_from_start,  //time difference between op start time and profiler start time
-                                     const std::initializer_list<std::pair<std::string, std::string>>& event_args,
+                                     std::unordered_map<std::string, std::string>&& event_args,
                                      bool /*sync_gpu*/) {
-  EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, time_from_start, duration, {event_args.begin(), event_args.end()});
+  RecordEvent(EventRecord(category, logging::GetProcessId(), logging::GetThreadId(), event_name, time_from_start,
+                          duration, std::move(event_args)));
+}
+
+void Profiler::RecordEvent(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
   } else {
     //TODO: sync_gpu if needed.
     std::lock_guard<OrtMutex> lock(mutex_);
     if (events_.size() < max_num_events_) {
-      events_.emplace_back(event);
+      events_.emplace_back(std::move(event));
     } else {
       if (session_logger_ && !max_events_reached) {
         LOGS(*session_logger_, ERROR)
@@ -247,6 +348,114 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   }
 }
 
+void Profiler::EndTimeAndRecordPhase(const std::string& phase_name,
+                                     const TimePoint& start_time,
+                                     std::unordered_map<std::string, std::string>&& event_args) {
+  event_args["peak_rss"] = std::to_string(GetPeakResidentSetSize());
+  EndTimeAndRecordEvent(SESSION_EVENT, phase_name, start_time, Now(), std::move(event_args));
+}
+
+void Profiler::RecordThreadPoolTasks(const std::string& node_name,
+                                     const std::vector<concurrency::ThreadPoolTaskRecord>& tasks) {
+  const int pid = logging::GetProcessId();
+  const int node_tid = static_cast<int>(logging::GetThreadId());
+  for (const auto& task : tasks) {
+    std::unordered_map<std::string, std::string> event_args = {
+        {"worker", std::to_string(task.worker)},
+        {"stolen", task.stolen ? "1" : "0"},
+        {"queue_time_us", std::to_string(TimeDiffMicroSeconds(task.enqueue_time, task.start_time))},
+    };
+    if (task.is_loop_block) {
+      event_args.emplace("iterations", MakeString(task.first, "-", task.last));
+    }
+    const int task_tid = static_cast<int>(task.thread_id);
+    RecordEvent(EventRecord(NODE_EVENT, pid, task_tid, node_name + (task.is_loop_block ? "_loop_block" : "_work_item"),
+                            TimeDiffMicroSeconds(profiling_start_time_, task.start_time),
+                            TimeDiffMicroSeconds(task.start_time, task.end_time), std::move(event_args)));
+    if (task_tid != node_tid) {
+      RecordFlow(node_tid, task.enqueue_time, task_tid, task.start_time);
+    }
+  }
+}
+
+void Profiler::RecordFlow(int from_thread_id, const TimePoint& from_time, int to_thread_id, const TimePoint& to_time) {
+  if (profile_with_logger_) {
+    return;
+  }
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (flows_.size() < max_num_events_) {
+    flows_.push_back({from_thread_id, TimeDiffMicroSeconds(profiling_start_time_, from_time), to_thread_id,
+                      TimeDiffMicroSeconds(profiling_start_time_, to_time)});
+  }
+}
+
+size_t Profiler::GetPeakResidentSetSize() {
+#if defined(_WIN32)
+  // resolves to K32GetProcessMemoryInfo in kernel32 on Windows 7 and later, so psapi.lib is not needed
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize;
+  }
+  return 0;
+#elif !defined(__wasm__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  // bytes on macOS, kilobytes elsewhere
+  return static_cast<size_t>(usage.ru_maxrss);
+#else
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+void Profiler::StartDeviceCorrelation(const std::string& event_name) {
+  DeviceProfiler* device_profiler = DeviceProfiler::GetDeviceProfiler();
+  if (device_profiler == nullptr || profile_with_logger_) {
+    return;
+  }
+
+  // ids are unique across the sessions as the device profiler is shared by them
+  const uint64_t correlation_id = next_device_correlation_id_++;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (device_correlation_names_.size() < max_num_events_) {
+      device_correlation_names_.emplace(correlation_id, event_name);
+    }
+  }
+  device_profiler->PushCorrelation(correlation_id);
+}
+
+void Profiler::EndDeviceCorrelation() {
+  DeviceProfiler* device_profiler = DeviceProfiler::GetDeviceProfiler();
+  if (device_profiler == nullptr || profile_with_logger_) {
+    return;
+  }
+
+  device_profiler->PopCorrelation();
+}
+
+static HardwareCounters& GetThreadHardwareCounters() {
+  // the counters belong to the thread, so they are shared by the profilers of all the sessions
+  static thread_local std::unique_ptr<HardwareCounters> counters;
+  if (!counters) {
+    counters.reset(new HardwareCounters());
+  }
+  return *counters;
+}
+
+void Profiler::StartHardwareCounters() {
+  GetThreadHardwareCounters().Start();
+}
+
+std::string Profiler::StopHardwareCounters() {
+  return GetThreadHardwareCounters().Stop();
+}
+
 std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
@@ -265,7 +474,8 @@ std::string Profiler::EndProfiling() {
 
   DeviceProfiler* device_profiler = DeviceProfiler::GetDeviceProfiler();
   if (device_profiler) {
-    std::vector<EventRecord> device_events = device_profiler->EndProfiling();
+    std::vector<EventRecord> device_events = device_profiler->EndProfiling(device_correlation_names_);
+    device_correlation_names_.clear();
     std::copy(device_events.begin(), device_events.end(), std::back_inserter(events_));
   }
 
@@ -290,12 +500,25 @@ std::string Profiler::EndProfiling() {
       is_first_arg = false;
     }
     profile_stream_ << "}";
-    if (i == events_.size() - 1) {
+    if (i == events_.size() - 1 && flows_.empty()) {
       profile_stream_ << "}\n";
     } else {
       profile_stream_ << "},\n";
     }
   }
+
+  // A flow is a pair of events, the start binds to the enclosing event of its thread and the end ("bp" : "e") to
+  // the event of its thread starting at its time.
+  const int pid = logging::GetProcessId();
+  for (size_t i = 0; i < flows_.size(); ++i) {
+    const auto& flow = flows_[i];
+    profile_stream_ << R"({"cat" : "Flow","pid" :)" << pid << ",\"tid\" :" << flow.from_tid << ",\"ts\" :"
+                    << flow.from_ts << R"(,"ph" : "s","id" :)" << i << R"(,"name" :"flow"},)" << "\n";
+    profile_stream_ << R"({"cat" : "Flow","pid" :)" << pid << ",\"tid\" :" << flow.to_tid << ",\"ts\" :"
+                    << flow.to_ts << R"(,"ph" : "f","bp" : "e","id" :)" << i << R"(,"name" :"flow"})"
+                    << (i == flows_.size() - 1 ? "\n" : ",\n");
+  }
+  flows_.clear();
   profile_stream_ << "]\n";
   profile_stream_.close();
   enabled_ = false;  // will not collect profile after writing.
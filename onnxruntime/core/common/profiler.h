@@ -8,12 +8,18 @@
 #include <initializer_list>
 #include <iostream>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include "core/common/logging/logging.h"
 #include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
+namespace concurrency {
+struct ThreadPoolTaskRecord;
+}
+
 namespace profiling {
 
 // uncomment the macro below, or use -DENABLE_STATIC_PROFILER_INSTANCE for debugging
@@ -59,6 +65,77 @@ class Profiler {
   bool IsEnabled() const {
     return enabled_;
   }
+
+  /*
+  Sample the hardware performance counters of each kernel and thread pool worker while profiling.
+  Only supported on Linux, the counters are left out of the trace if they can't be opened.
+  */
+  void EnableHardwareCounters(bool enable) {
+    hardware_counters_enabled_ = enable;
+  }
+
+  bool HardwareCountersEnabled() const {
+    return enabled_ && hardware_counters_enabled_;
+  }
+
+  /*
+  Attribute the tensors allocated during an execution to the nodes while profiling. Each node gets a "_memory" event
+  with the bytes allocated, freed and live per location after it ran, and each execution a "memory_peak" event with
+  the tensors live at the peak of each location and the nodes producing them.
+  */
+  void EnableMemoryProfiling(bool enable) {
+    memory_profiling_enabled_ = enable;
+  }
+
+  bool MemoryProfilingEnabled() const {
+    return enabled_ && memory_profiling_enabled_;
+  }
+
+  /*
+  Record the phases of the session creation, e.g. the parsing of the model, each graph transformer and the kernel
+  creation, as session events while profiling. See EndTimeAndRecordPhase.
+  */
+  void EnableSessionCreationProfiling(bool enable) {
+    session_creation_profiling_enabled_ = enable;
+  }
+
+  bool SessionCreationProfilingEnabled() const {
+    return enabled_ && session_creation_profiling_enabled_;
+  }
+
+  /*
+  Record each task that the intra-op thread pool runs for a node, i.e. each block of iterations of its parallel loops
+  and each work item running them, as an event of the thread that ran it with a flow arrow from the node. The
+  parallel executor also links each node to the node that made it ready with a flow arrow. See RecordThreadPoolTasks.
+  */
+  void EnableThreadPoolTaskTracing(bool enable) {
+    thread_pool_task_tracing_enabled_ = enable;
+  }
+
+  bool ThreadPoolTaskTracingEnabled() const {
+    return enabled_ && thread_pool_task_tracing_enabled_;
+  }
+
+  /*
+  Start counting the hardware events of the calling thread.
+  */
+  void StartHardwareCounters();
+
+  /*
+  Return the hardware events counted on the calling thread since StartHardwareCounters() as a JSON object,
+  or an empty string if the counters are not available.
+  */
+  std::string StopHardwareCounters();
+
+  /*
+  Attribute the device activities, such as the CUDA kernels and memory copies, launched by the calling thread
+  until EndDeviceCorrelation() to the named event, e.g. the node being computed. The device events are merged
+  into the trace with the name in their "node_name" argument. Does nothing without a device profiler.
+  */
+  void StartDeviceCorrelation(const std::string& event_name);
+
+  void EndDeviceCorrelation();
+
   /*
   Return the stored start time of profiler.
   On some platforms, this timer may not be as precise as nanoseconds
@@ -84,6 +161,43 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  void EndTimeAndRecordEvent(EventCategory category,
+                             const std::string& event_name,
+                             const TimePoint& start_time, const TimePoint& end_time,
+                             std::unordered_map<std::string, std::string>&& event_args,
+                             bool sync_gpu = false);
+
+  /*
+  Record a phase of the session creation, e.g. parsing the model, applying a graph transformer or creating the kernels,
+  as a session event. Callers check SessionCreationProfilingEnabled() before timing the phase. The peak resident set size of the process at the end of the phase is added in bytes as the
+  "peak_rss" argument, so the phases that grow the memory of the process can be told apart.
+  */
+  void EndTimeAndRecordPhase(const std::string& phase_name,
+                             const TimePoint& start_time,
+                             std::unordered_map<std::string, std::string>&& event_args = {});
+
+  /*
+  Record the tasks run by a thread pool for the node computed by the calling thread as "<node_name>_loop_block" and
+  "<node_name>_work_item" events of the threads that ran them. Each event has the "worker" index of its thread in the
+  pool (-1 for the thread computing the node), whether the task was "stolen" from another worker, and the
+  "queue_time_us" between the start of its loop, or the queueing of the work item, and its start. The loop blocks
+  also have their "iterations". The tasks run by other threads get a flow arrow from the node.
+  */
+  void RecordThreadPoolTasks(const std::string& node_name,
+                             const std::vector<concurrency::ThreadPoolTaskRecord>& tasks);
+
+  /*
+  Record a flow arrow, drawn by the trace viewers, from the event of thread from_thread_id that encloses from_time to
+  the event of thread to_thread_id that starts at to_time. The flows are only written to the profile file, they are
+  not sent to a custom logger.
+  */
+  void RecordFlow(int from_thread_id, const TimePoint& from_time, int to_thread_id, const TimePoint& to_time);
+
+  /*
+  Return the peak resident set size of the process in bytes, or 0 if it is not available on this platform.
+  */
+  static size_t GetPeakResidentSetSize();
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -119,9 +233,12 @@ class Profiler {
                              const std::string& event_name,
                              long long duration,         //duration of the op
                              long long time_from_start,  //time difference between op start time and profiler start time
-                             const std::initializer_list<std::pair<std::string, std::string>>& event_args,
+                             std::unordered_map<std::string, std::string>&& event_args,
                              bool sync_gpu = false);
 
+  // Send the event to the custom logger, or store it until EndProfiling.
+  void RecordEvent(EventRecord&& event);
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
   /**
@@ -131,6 +248,10 @@ class Profiler {
    */
   static std::atomic<size_t> global_max_num_events_;
 
+  // The next id of StartDeviceCorrelation, and the event names of the ids used by this profiler.
+  static std::atomic<uint64_t> next_device_correlation_id_;
+  std::unordered_map<uint64_t, std::string> device_correlation_names_;
+
   // Mutex controlling access to profiler data
   OrtMutex mutex_;
   bool enabled_{false};
@@ -140,8 +261,20 @@ class Profiler {
   const logging::Logger* custom_logger_{nullptr};
   TimePoint profiling_start_time_;
   std::vector<EventRecord> events_;
+  // the flow arrows between the events, the id of a flow is its index
+  struct FlowRecord {
+    int from_tid;
+    long long from_ts;
+    int to_tid;
+    long long to_ts;
+  };
+  std::vector<FlowRecord> flows_;
   bool max_events_reached{false};
   bool profile_with_logger_{false};
+  bool hardware_counters_enabled_{false};
+  bool memory_profiling_enabled_{false};
+  bool session_creation_profiling_enabled_{false};
+  bool thread_pool_task_tracing_enabled_{false};
   const size_t max_num_events_{global_max_num_events_.load()};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
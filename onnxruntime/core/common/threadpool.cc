@@ -13,12 +13,15 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <memory>
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
 #include "core/common/eigen_common_wrapper.h"
+#include "core/common/hardware_counters.h"
+#include "core/common/logging/logging.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 #if !defined(ORT_MINIMAL_BUILD)
@@ -44,6 +47,7 @@ namespace concurrency {
 #if !defined(ORT_MINIMAL_BUILD)
 ThreadPoolProfiler::ThreadPoolProfiler(int num_threads, const CHAR_TYPE* thread_pool_name) : num_threads_(num_threads) {
   child_thread_stats_.assign(num_threads, {});
+  child_thread_counters_.resize(num_threads);
   if (thread_pool_name) {
 #ifdef _WIN32
     using convert_type = std::codecvt_utf8<wchar_t>;
@@ -61,7 +65,22 @@ ThreadPoolProfiler::~ThreadPoolProfiler() {
   enabled_ = false;
 }
 
-void ThreadPoolProfiler::Start() {
+void ThreadPoolProfiler::Start(bool with_hardware_counters, bool with_task_trace) {
+  hardware_counters_enabled_ = with_hardware_counters;
+  task_trace_enabled_ = with_task_trace;
+  if (with_hardware_counters) {
+    // the counters of a worker are opened from the profiling thread once the worker has logged its id
+    std::lock_guard<OrtMutex> lock(counters_mutex_);
+    for (int i = 0; i < num_threads_; ++i) {
+      auto& counters = child_thread_counters_[i];
+      if (!counters && child_thread_stats_[i].os_thread_id_ != 0) {
+        counters = std::make_unique<profiling::HardwareCounters>(child_thread_stats_[i].os_thread_id_);
+      }
+      if (counters) {
+        counters->Start();
+      }
+    }
+  }
   enabled_ = true;
 }
 
@@ -86,6 +105,31 @@ std::string ThreadPoolProfiler::Stop() {
   return ss.str();
 }
 
+// Bounds the memory of the tasks logged for threads that never take them, e.g. the threads of another session
+// sharing the pool.
+static constexpr size_t kMaxTasks = 1 << 20;
+
+void ThreadPoolProfiler::LogTask(std::thread::id origin, const ThreadPoolTaskRecord& task) {
+  std::lock_guard<OrtMutex> lock(tasks_mutex_);
+  if (tasks_.size() < kMaxTasks) {
+    tasks_.emplace_back(origin, task);
+    tasks_.back().second.thread_id = logging::GetThreadId();
+  }
+}
+
+void ThreadPoolProfiler::TakeTasks(std::vector<ThreadPoolTaskRecord>& tasks) {
+  const auto origin = std::this_thread::get_id();
+  std::lock_guard<OrtMutex> lock(tasks_mutex_);
+  auto others = std::partition(tasks_.begin(), tasks_.end(),
+                               [origin](const std::pair<std::thread::id, ThreadPoolTaskRecord>& entry) {
+                                 return entry.first != origin;
+                               });
+  for (auto it = others; it != tasks_.end(); ++it) {
+    tasks.push_back(it->second);
+  }
+  tasks_.erase(others, tasks_.end());
+}
+
 void ThreadPoolProfiler::LogStartAndCoreAndBlock(std::ptrdiff_t block_size) {
   if (enabled_) {
     MainThreadStat& stat = GetMainThreadStat();
@@ -196,6 +240,7 @@ const char* ThreadPoolProfiler::GetEventName(ThreadPoolEvent event) {
 
 void ThreadPoolProfiler::LogThreadId(int thread_idx) {
   child_thread_stats_[thread_idx].thread_id_ = std::this_thread::get_id();
+  child_thread_stats_[thread_idx].os_thread_id_ = profiling::HardwareCounters::GetCurrentOsThreadId();
 }
 
 void ThreadPoolProfiler::LogRun(int thread_idx) {
@@ -226,11 +271,15 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
 
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
   std::stringstream ss;
+  std::lock_guard<OrtMutex> lock(counters_mutex_);
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
-       << "\"core\": " << child_thread_stats_[i].core_ << "}"
-       << (i == num_threads_ - 1 ? "" : ",");
+       << "\"core\": " << child_thread_stats_[i].core_;
+    if (hardware_counters_enabled_ && child_thread_counters_[i] && child_thread_counters_[i]->IsAvailable()) {
+      ss << ", \"hardware_counters\": " << child_thread_counters_[i]->Stop();
+    }
+    ss << "}" << (i == num_threads_ - 1 ? "" : ",");
   }
   return ss.str();
 }
@@ -303,6 +352,15 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
     return idx % _num_shards;
   }
 
+  // Variant of GetHomeShard that gives consecutive work items adjacent
+  // shards.  The NUMA-aware thread pool runs consecutive work items on
+  // the same node, so each node then works on a contiguous range of the
+  // iteration space.
+
+  unsigned GetContiguousHomeShard(unsigned idx, unsigned num_work_items) const {
+    return static_cast<unsigned>((static_cast<uint64_t>(idx) * _num_shards) / num_work_items);
+  }
+
   // Attempt to claim iterations from the sharded counter.  The function either
   // returns true, along with a block of exactly block_size iterations, or it returns false
   // if all of the iterations have been claimed.
@@ -362,6 +420,48 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
   const unsigned _num_shards;
 };
 
+// Counter for guided self-scheduling.  Unlike LoopCounter there is a
+// single shared counter: the size of each block depends on the number
+// of iterations that remain overall, which sharding would hide.  Each
+// claim takes 1/(GuidedFactor * d_of_p) of the remaining iterations,
+// but at least min_block_size, so threads claim few large blocks early
+// on and many small blocks at the end, which balances irregular
+// iteration costs at a low count of atomic operations.
+class alignas(CACHE_LINE_BYTES) GuidedLoopCounter {
+ public:
+  GuidedLoopCounter(uint64_t num_iterations,
+                    uint64_t d_of_p,
+                    uint64_t min_block_size) : _end(num_iterations),
+                                               _divisor(d_of_p * GuidedFactor),
+                                               _min_block_size(min_block_size) {
+  }
+
+  // Attempt to claim iterations from the counter.  The function either
+  // returns true, along with a block of at least min_block_size
+  // iterations (fewer for the final block), or it returns false if all
+  // of the iterations have been claimed.
+  bool ClaimIterations(uint64_t& my_start, uint64_t& my_end) {
+    uint64_t start = _next.load(::std::memory_order_relaxed);
+    while (start < _end) {
+      const uint64_t end = std::min(_end, start + std::max(_min_block_size, (_end - start) / _divisor));
+      if (_next.compare_exchange_weak(start, end)) {
+        my_start = start;
+        my_end = end;
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  static constexpr uint64_t GuidedFactor = 2;
+
+  alignas(CACHE_LINE_BYTES) ::std::atomic<uint64_t> _next{0};
+  const uint64_t _end;
+  const uint64_t _divisor;
+  const uint64_t _min_block_size;
+};
+
 #ifdef _MSC_VER
 #pragma warning(pop) /* Padding added in LoopCounterShard, LoopCounter */
 #endif
@@ -388,6 +488,101 @@ ThreadPool::ThreadPool(Env* env,
   }
 }
 
+namespace {
+
+// Forwards the work of a ThreadPool to an ExternalExecutor.  The
+// executor distributes the iterations of each loop, so parallel
+// sections carry no state here, and there are no workers of ours to
+// profile or to keep hot.
+class ExternalThreadPool final : public ExtendedThreadPoolInterface {
+ public:
+  explicit ExternalThreadPool(const ExternalExecutor& executor) : executor_(executor) {}
+
+  void Schedule(std::function<void()> fn) override {
+    scheduled_tasks_.fetch_add(1, std::memory_order_relaxed);
+    executor_.schedule(std::move(fn));
+  }
+
+  std::unique_ptr<ThreadPoolParallelSection, void (*)(ThreadPoolParallelSection*)> AllocateParallelSection() override {
+    return std::unique_ptr<ThreadPoolParallelSection, void (*)(ThreadPoolParallelSection*)>(
+        new ThreadPoolParallelSection,
+        [](ThreadPoolParallelSection* tps) {
+          delete tps;
+        });
+  }
+
+  void StartParallelSection(ThreadPoolParallelSection&) override {}
+
+  void EndParallelSection(ThreadPoolParallelSection&) override {}
+
+  void RunInParallelSection(ThreadPoolParallelSection&, std::function<void(unsigned idx)> fn,
+                            unsigned n, std::ptrdiff_t block_size) override {
+    RunInParallel(std::move(fn), n, block_size);
+  }
+
+  void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t) override {
+    if (n <= 1) {
+      fn(0);
+      return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    executor_.parallel_for(fn, n);
+    parallel_loops_.fetch_add(1, std::memory_order_relaxed);
+    parallel_loop_ns_.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                          std::chrono::steady_clock::now() - start)
+                                                          .count()),
+                                std::memory_order_relaxed);
+  }
+
+  // The threads of the executor other than the caller.
+  int NumThreads() const override {
+    return executor_.degree_of_parallelism - 1;
+  }
+
+  // The threads of the executor are not known to the pool.
+  int CurrentThreadId() const override {
+    return -1;
+  }
+
+  void StartProfiling(bool, bool) override {}
+
+  std::string StopProfiling(std::vector<ThreadPoolTaskRecord>*) override {
+    return {};
+  }
+
+  bool TaskTraceEnabled() const override {
+    return false;
+  }
+
+  void LogTask(std::thread::id, const ThreadPoolTaskRecord&) override {}
+
+  void GetUtilization(ThreadPoolUtilization& utilization) const override {
+    utilization.parallel_loops = parallel_loops_.load(std::memory_order_relaxed);
+    utilization.parallel_loop_ns = parallel_loop_ns_.load(std::memory_order_relaxed);
+    utilization.scheduled_tasks = scheduled_tasks_.load(std::memory_order_relaxed);
+  }
+
+  void StartKeepWorkersHot() override {}
+
+  void EndKeepWorkersHot() override {}
+
+ private:
+  const ExternalExecutor executor_;
+  std::atomic<uint64_t> parallel_loops_{0};
+  std::atomic<uint64_t> parallel_loop_ns_{0};
+  std::atomic<uint64_t> scheduled_tasks_{0};
+};
+
+}  // namespace
+
+ThreadPool::ThreadPool(const ExternalExecutor& executor) {
+  assert(executor.degree_of_parallelism >= 1);
+  if (executor.degree_of_parallelism >= 2) {
+    external_threadpool_ = std::make_unique<ExternalThreadPool>(executor);
+    underlying_threadpool_ = external_threadpool_.get();
+  }
+}
+
 ThreadPool::~ThreadPool() = default;
 
 // Base case for parallel loops, running iterations 0..total, divided into blocks
@@ -412,13 +607,23 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   assert(num_work_items > 0);
 
   LoopCounter lc(total, d_of_p, block_size);
+  const bool numa_aware = !thread_options_.numa_node.empty();
+  const bool trace = underlying_threadpool_ && underlying_threadpool_->TaskTraceEnabled();
+  const auto origin = std::this_thread::get_id();
+  const auto loop_start = trace ? std::chrono::high_resolution_clock::now() : TimePoint();
   std::function<void(unsigned)> run_work = [&](unsigned idx) {
-    unsigned my_home_shard = lc.GetHomeShard(idx);
+    unsigned my_home_shard = numa_aware ? lc.GetContiguousHomeShard(idx, static_cast<unsigned>(num_work_items))
+                                        : lc.GetHomeShard(idx);
     unsigned my_shard = my_home_shard;
     uint64_t my_iter_start, my_iter_end;
     while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end)) {
+      const auto block_start = trace ? std::chrono::high_resolution_clock::now() : TimePoint();
       fn(static_cast<std::ptrdiff_t>(my_iter_start),
          static_cast<std::ptrdiff_t>(my_iter_end));
+      if (trace) {
+        LogLoopBlock(origin, loop_start, block_start, static_cast<std::ptrdiff_t>(my_iter_start),
+                     static_cast<std::ptrdiff_t>(my_iter_end), my_shard != my_home_shard);
+      }
     }
   };
 
@@ -428,6 +633,45 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   RunInParallel(run_work, num_work_items, block_size);
 }
 
+void ThreadPool::ParallelForGuidedScheduling(const std::ptrdiff_t total,
+                                             const std::ptrdiff_t min_block_size,
+                                             const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+  if (total <= 0)
+    return;
+
+  if (total <= min_block_size) {
+    fn(0, total);
+    return;
+  }
+
+  // As in ParallelForFixedBlockSizeScheduling, one work item per thread claims blocks until the
+  // counter is exhausted.
+  auto d_of_p = DegreeOfParallelism(this);
+  auto num_blocks = Eigen::divup(total, min_block_size);
+  int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(d_of_p), num_blocks));
+  assert(num_work_items > 0);
+
+  GuidedLoopCounter lc(total, d_of_p, min_block_size);
+  const bool trace = underlying_threadpool_ && underlying_threadpool_->TaskTraceEnabled();
+  const auto origin = std::this_thread::get_id();
+  const auto loop_start = trace ? std::chrono::high_resolution_clock::now() : TimePoint();
+  std::function<void(unsigned)> run_work = [&](unsigned) {
+    uint64_t my_iter_start, my_iter_end;
+    while (lc.ClaimIterations(my_iter_start, my_iter_end)) {
+      const auto block_start = trace ? std::chrono::high_resolution_clock::now() : TimePoint();
+      fn(static_cast<std::ptrdiff_t>(my_iter_start),
+         static_cast<std::ptrdiff_t>(my_iter_end));
+      if (trace) {
+        // the blocks are claimed from a single counter, so none is stolen
+        LogLoopBlock(origin, loop_start, block_start, static_cast<std::ptrdiff_t>(my_iter_start),
+                     static_cast<std::ptrdiff_t>(my_iter_end), false);
+      }
+    }
+  };
+
+  RunInParallel(run_work, num_work_items, min_block_size);
+}
+
 void ThreadPool::SimpleParallelFor(std::ptrdiff_t total, const std::function<void(std::ptrdiff_t)>& fn) {
   ParallelForFixedBlockSizeScheduling(total, 1, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
     for (std::ptrdiff_t idx = first; idx < last; idx++) {
@@ -444,20 +688,43 @@ void ThreadPool::Schedule(std::function<void()> fn) {
   }
 }
 
-void ThreadPool::StartProfiling() {
+void ThreadPool::StartProfiling(bool with_hardware_counters, bool with_task_trace) {
   if (underlying_threadpool_) {
-    underlying_threadpool_->StartProfiling();
+    underlying_threadpool_->StartProfiling(with_hardware_counters, with_task_trace);
   }
 }
 
-std::string ThreadPool::StopProfiling() {
+std::string ThreadPool::StopProfiling(std::vector<ThreadPoolTaskRecord>* tasks) {
   if (underlying_threadpool_) {
-    return underlying_threadpool_->StopProfiling();
+    return underlying_threadpool_->StopProfiling(tasks);
   } else {
     return {};
   }
 }
 
+void ThreadPool::LogLoopBlock(std::thread::id origin, const TimePoint& loop_start, const TimePoint& block_start,
+                              std::ptrdiff_t first, std::ptrdiff_t last, bool stolen) {
+  ThreadPoolTaskRecord task;
+  task.is_loop_block = true;
+  task.enqueue_time = loop_start;
+  task.start_time = block_start;
+  task.end_time = std::chrono::high_resolution_clock::now();
+  task.worker = CurrentThreadId();
+  task.stolen = stolen;
+  task.first = first;
+  task.last = last;
+  underlying_threadpool_->LogTask(origin, task);
+}
+
+ThreadPoolUtilization ThreadPool::GetUtilization(const concurrency::ThreadPool* tp) {
+  ThreadPoolUtilization utilization;
+  if (tp && tp->underlying_threadpool_) {
+    tp->underlying_threadpool_->GetUtilization(utilization);
+    utilization.num_threads = tp->underlying_threadpool_->NumThreads();
+  }
+  return utilization;
+}
+
 thread_local ThreadPool::ParallelSection* ThreadPool::ParallelSection::current_parallel_section{nullptr};
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
@@ -488,6 +755,25 @@ ThreadPool::ParallelSection::~ParallelSection() {
 #endif
 }
 
+ThreadPool::KeepWorkersHot::KeepWorkersHot(ThreadPool* tp) {
+#ifdef _OPENMP
+  ORT_UNUSED_PARAMETER(tp);
+#else
+  tp_ = tp;
+  if (tp_ && tp_->underlying_threadpool_) {
+    tp_->underlying_threadpool_->StartKeepWorkersHot();
+  }
+#endif
+}
+
+ThreadPool::KeepWorkersHot::~KeepWorkersHot() {
+#ifndef _OPENMP
+  if (tp_ && tp_->underlying_threadpool_) {
+    tp_->underlying_threadpool_->EndKeepWorkersHot();
+  }
+#endif
+}
+
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
     if (ThreadPool::ParallelSection::current_parallel_section) {
@@ -599,6 +885,24 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
   ParallelForFixedBlockSizeScheduling(n, block, f);
 }
 
+void ThreadPool::GuidedParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
+                                   const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& f) {
+  ORT_ENFORCE(n >= 0);
+  Eigen::TensorOpCost cost{c.bytes_loaded, c.bytes_stored, c.compute_cycles};
+  auto d_of_p = DegreeOfParallelism(this);
+  if ((!ShouldParallelizeLoop(n)) ||
+      CostModel::numThreads(static_cast<double>(n), cost, d_of_p) == 1) {
+    f(0, n);
+    return;
+  }
+
+  // The smallest block worth its scheduling overhead, as in CalculateParallelForBlock
+  const double min_block_size_f = 1.0 / CostModel::taskSize(1, cost);
+  const ptrdiff_t min_block_size = Eigen::numext::mini(
+      n, Eigen::numext::maxi<ptrdiff_t>(1, static_cast<ptrdiff_t>(min_block_size_f)));
+  ParallelForGuidedScheduling(n, min_block_size, f);
+}
+
 void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn) {
   ParallelFor(total, TensorOpCost{0, 0, static_cast<double>(cost_per_unit)}, fn);
@@ -631,15 +935,15 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
 #endif
 }
 
-void ThreadPool::StartProfiling(concurrency::ThreadPool* tp) {
+void ThreadPool::StartProfiling(concurrency::ThreadPool* tp, bool with_hardware_counters, bool with_task_trace) {
   if (tp) {
-    tp->StartProfiling();
+    tp->StartProfiling(with_hardware_counters, with_task_trace);
   }
 }
 
-std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
+std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp, std::vector<ThreadPoolTaskRecord>* tasks) {
   if (tp) {
-    return tp->StopProfiling();
+    return tp->StopProfiling(tasks);
   } else {
     return {};
   }
@@ -712,5 +1016,45 @@ void ThreadPool::TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t tota
 #endif
 }
 
+void ThreadPool::TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                                LoopScheduling scheduling,
+                                const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  if (scheduling == LoopScheduling::FixedBlockSize) {
+    TryParallelFor(tp, total, cost_per_unit, fn);
+    return;
+  }
+
+#ifdef _OPENMP
+  ORT_ENFORCE(total >= 0);
+  if (total == 0) {
+    return;
+  }
+
+  Eigen::TensorOpCost cost{cost_per_unit.bytes_loaded, cost_per_unit.bytes_stored, cost_per_unit.compute_cycles};
+  auto d_of_p = DegreeOfParallelism(tp);
+  if (total == 1 || CostModel::numThreads(static_cast<double>(total), cost, d_of_p) == 1) {
+    fn(0, total);
+    return;
+  }
+
+  // OpenMP's guided schedule shrinks the chunks of blocks in the same way
+  const ptrdiff_t min_block_size = Eigen::numext::mini(
+      total, Eigen::numext::maxi<ptrdiff_t>(1, static_cast<ptrdiff_t>(1.0 / CostModel::taskSize(1, cost))));
+  const ptrdiff_t block_count = Eigen::divup(total, min_block_size);
+
+#pragma omp parallel for schedule(guided, 1)
+  for (std::ptrdiff_t i = 0; i < block_count; i++) {
+    const auto start = i * min_block_size;
+    fn(start, std::min(start + min_block_size, total));
+  }
+#else  //!_OPENMP
+  if (tp == nullptr) {
+    fn(0, total);
+    return;
+  }
+  tp->GuidedParallelFor(total, cost_per_unit, fn);
+#endif
+}
+
 }  // namespace concurrency
 }  // namespace onnxruntime
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/eager/ort_kernel_invoker.h"
+
+#include <algorithm>
+
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/common/logging/logging.h"
 #include "core/graph/model.h"
@@ -10,37 +13,101 @@
 
 namespace onnxruntime {
 
-common::Status ORTInvoker::Invoke(const std::string& op_name,
-                                  //optional inputs / outputs?
-                                  const std::vector<OrtValue>& inputs,
-                                  std::vector<OrtValue>& outputs,
-                                  const NodeAttributes* attributes,
-                                  const std::string& domain,
-                                  const int /*version*/) {
+struct ORTInvoker::CachedKernel {
+  // The node of the kernel is owned by the graph of the model.
+  std::unique_ptr<Model> model;
+  std::unique_ptr<OptimizerExecutionFrame::Info> info;
+  std::unique_ptr<const OpKernel> kernel;
+  std::vector<int> feed_mlvalue_idxs;
+  std::vector<int> fetch_mlvalue_idxs;
+  // Frames not used by a call at the moment, taken and given back under kernels_mutex_.
+  std::vector<std::unique_ptr<OptimizerExecutionFrame>> frames;
+};
+
+namespace {
+
+std::string GetKernelKey(const std::string& op_name,
+                         const std::vector<OrtValue>& inputs,
+                         size_t output_count,
+                         const NodeAttributes* attributes,
+                         const std::string& domain,
+                         int version) {
+  std::string key = op_name;
+  key += '\n';
+  key += domain;
+  key += '\n';
+  key += std::to_string(version);
+  key += '\n';
+  for (const auto& input : inputs) {
+    key += std::to_string(input.Get<Tensor>().GetElementType());
+    key += ',';
+  }
+  key += '\n';
+  key += std::to_string(output_count);
+
+  if (attributes != nullptr) {
+    // NodeAttributes is unordered, so the attributes are added sorted by name.
+    std::vector<const std::pair<const std::string, ONNX_NAMESPACE::AttributeProto>*> sorted_attributes;
+    sorted_attributes.reserve(attributes->size());
+    for (const auto& attribute : *attributes) {
+      sorted_attributes.push_back(&attribute);
+    }
+    std::sort(sorted_attributes.begin(), sorted_attributes.end(),
+              [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+    for (const auto* attribute : sorted_attributes) {
+      key += '\n';
+      key += attribute->first;
+      key += '=';
+      key += attribute->second.SerializeAsString();
+    }
+  }
+
+  return key;
+}
+
+}  // namespace
+
+ORTInvoker::~ORTInvoker() = default;
+
+common::Status ORTInvoker::CreateKernel(const std::string& op_name,
+                                        const std::vector<OrtValue>& inputs,
+                                        size_t output_count,
+                                        const NodeAttributes* attributes,
+                                        const std::string& domain,
+                                        int version,
+                                        std::unique_ptr<CachedKernel>& cached_kernel) {
+  auto created = std::make_unique<CachedKernel>();
+
   //create a graph
-  Model model("test", false, logger_);
+  std::unordered_map<std::string, int> domain_to_version;
+  if (version > 0) {
+    domain_to_version[domain] = version;
+  }
+  created->model = std::make_unique<Model>("test", false, ModelMetaData(), PathString(),
+                                           IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                           std::vector<ONNX_NAMESPACE::FunctionProto>(), logger_);
 
   std::vector<onnxruntime::NodeArg*> input_args;
   std::vector<onnxruntime::NodeArg*> output_args;
 
   input_args.reserve(inputs.size());
-  output_args.reserve(outputs.size());
+  output_args.reserve(output_count);
 
-  Graph& graph = model.MainGraph();
-  std::unordered_map<std::string, OrtValue> initializer_map;
+  Graph& graph = created->model->MainGraph();
   size_t i = 0;
 
-  for (auto input : inputs) {
+  // The inputs are fed to the kernel rather than made initializers, as a kernel created for constant inputs could
+  // not be re-used for other values.
+  for (const auto& input : inputs) {
     std::string name = "I" + std::to_string(i++);
     const Tensor& input_tensor = input.Get<Tensor>();
     ONNX_NAMESPACE::TypeProto input_tensor_type;
     input_tensor_type.mutable_tensor_type()->set_elem_type(input_tensor.GetElementType());
     auto& arg = graph.GetOrCreateNodeArg(name, &input_tensor_type);
     input_args.push_back(&arg);
-    initializer_map[name] = input;
   }
 
-  for (i = 0; i < outputs.size(); ++i) {
+  for (i = 0; i < output_count; ++i) {
     auto& arg = graph.GetOrCreateNodeArg("O" + std::to_string(i), nullptr);
     output_args.push_back(&arg);
   }
@@ -49,24 +116,74 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
   ORT_RETURN_IF_ERROR(graph.Resolve());
 
   node.SetExecutionProviderType(execution_provider_->Type());
-  std::vector<const Node*> frame_nodes{&node};
 
-  OptimizerExecutionFrame::Info info({&node}, initializer_map, graph.ModelPath(), *execution_provider_);
-  auto kernel = info.CreateKernel(&node);
-  if (!kernel) {
+  created->info = std::make_unique<OptimizerExecutionFrame::Info>(
+      std::vector<const Node*>{&node}, std::unordered_map<std::string, OrtValue>(), graph.ModelPath(),
+      *execution_provider_);
+  created->kernel = created->info->CreateKernel(&node);
+  if (!created->kernel) {
     ORT_THROW("Could not find kernel");
   }
 
-  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node_in : node.InputDefs()) {
+    created->feed_mlvalue_idxs.push_back(created->info->GetMLValueIndex(node_in->Name()));
+  }
   for (const auto* node_out : node.OutputDefs()) {
-    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+    created->fetch_mlvalue_idxs.push_back(created->info->GetMLValueIndex(node_out->Name()));
+  }
+
+  cached_kernel = std::move(created);
+  return Status::OK();
+}
+
+common::Status ORTInvoker::Invoke(const std::string& op_name,
+                                  //optional inputs / outputs?
+                                  const std::vector<OrtValue>& inputs,
+                                  std::vector<OrtValue>& outputs,
+                                  const NodeAttributes* attributes,
+                                  const std::string& domain,
+                                  const int version) {
+  const std::string key = GetKernelKey(op_name, inputs, outputs.size(), attributes, domain, version);
+
+  CachedKernel* cached_kernel = nullptr;
+  std::unique_ptr<OptimizerExecutionFrame> frame;
+  {
+    std::lock_guard<std::mutex> lock(kernels_mutex_);
+    auto it = kernels_.find(key);
+    if (it == kernels_.end()) {
+      std::unique_ptr<CachedKernel> created;
+      ORT_RETURN_IF_ERROR(CreateKernel(op_name, inputs, outputs.size(), attributes, domain, version, created));
+      it = kernels_.emplace(key, std::move(created)).first;
+    }
+
+    cached_kernel = it->second.get();
+    if (!cached_kernel->frames.empty()) {
+      frame = std::move(cached_kernel->frames.back());
+      cached_kernel->frames.pop_back();
+    }
   }
 
-  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs, outputs);
-  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger_);
-  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+  if (frame) {
+    frame->Reset(cached_kernel->feed_mlvalue_idxs, inputs, outputs);
+  } else {
+    frame = std::make_unique<OptimizerExecutionFrame>(*cached_kernel->info, cached_kernel->feed_mlvalue_idxs, inputs,
+                                                      cached_kernel->fetch_mlvalue_idxs, outputs);
+  }
+
+  OpKernelContext op_kernel_context(frame.get(), cached_kernel->kernel.get(), nullptr, logger_);
+  Status status = cached_kernel->kernel->Compute(&op_kernel_context);
+  if (status.IsOK()) {
+    status = frame->GetOutputs(outputs);
+  }
+
+  // don't keep the inputs and outputs alive until the next call
+  frame->ReleaseValues();
+  {
+    std::lock_guard<std::mutex> lock(kernels_mutex_);
+    cached_kernel->frames.push_back(std::move(frame));
+  }
 
-  return frame.GetOutputs(outputs);
+  return status;
 }
 
 }  // namespace onnxruntime
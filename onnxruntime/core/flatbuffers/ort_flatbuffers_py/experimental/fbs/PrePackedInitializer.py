@@ -0,0 +1,79 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class PrePackedInitializer(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAsPrePackedInitializer(cls, buf, offset):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = PrePackedInitializer()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def PrePackedInitializerBufferHasIdentifier(cls, buf, offset, size_prefixed=False):
+        return flatbuffers.util.BufferHasIdentifier(buf, offset, b"\x4F\x52\x54\x4D", size_prefixed=size_prefixed)
+
+    # PrePackedInitializer
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # PrePackedInitializer
+    def NodeIndex(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # PrePackedInitializer
+    def InputIndex(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # PrePackedInitializer
+    def KernelDefHash(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, o + self._tab.Pos)
+        return 0
+
+    # PrePackedInitializer
+    def Buffers(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            x = self._tab.Vector(o)
+            x += flatbuffers.number_types.UOffsetTFlags.py_type(j) * 4
+            x = self._tab.Indirect(x)
+            from ort_flatbuffers_py.experimental.fbs.PrePackedBuffer import PrePackedBuffer
+            obj = PrePackedBuffer()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # PrePackedInitializer
+    def BuffersLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # PrePackedInitializer
+    def BuffersIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        return o == 0
+
+def PrePackedInitializerStart(builder): builder.StartObject(4)
+def PrePackedInitializerAddNodeIndex(builder, nodeIndex): builder.PrependUint32Slot(0, nodeIndex, 0)
+def PrePackedInitializerAddInputIndex(builder, inputIndex): builder.PrependInt32Slot(1, inputIndex, 0)
+def PrePackedInitializerAddKernelDefHash(builder, kernelDefHash): builder.PrependUint64Slot(2, kernelDefHash, 0)
+def PrePackedInitializerAddBuffers(builder, buffers): builder.PrependUOffsetTRelativeSlot(3, flatbuffers.number_types.UOffsetTFlags.py_type(buffers), 0)
+def PrePackedInitializerStartBuffersVector(builder, numElems): return builder.StartVector(4, numElems, 4)
+def PrePackedInitializerEnd(builder): return builder.EndObject()
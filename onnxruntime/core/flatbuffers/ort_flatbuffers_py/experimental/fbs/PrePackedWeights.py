@@ -0,0 +1,63 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class PrePackedWeights(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAsPrePackedWeights(cls, buf, offset):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = PrePackedWeights()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def PrePackedWeightsBufferHasIdentifier(cls, buf, offset, size_prefixed=False):
+        return flatbuffers.util.BufferHasIdentifier(buf, offset, b"\x4F\x52\x54\x4D", size_prefixed=size_prefixed)
+
+    # PrePackedWeights
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # PrePackedWeights
+    def Isa(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.String(o + self._tab.Pos)
+        return None
+
+    # PrePackedWeights
+    def Initializers(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            x = self._tab.Vector(o)
+            x += flatbuffers.number_types.UOffsetTFlags.py_type(j) * 4
+            x = self._tab.Indirect(x)
+            from ort_flatbuffers_py.experimental.fbs.PrePackedInitializer import PrePackedInitializer
+            obj = PrePackedInitializer()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # PrePackedWeights
+    def InitializersLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # PrePackedWeights
+    def InitializersIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        return o == 0
+
+def PrePackedWeightsStart(builder): builder.StartObject(2)
+def PrePackedWeightsAddIsa(builder, isa): builder.PrependUOffsetTRelativeSlot(0, flatbuffers.number_types.UOffsetTFlags.py_type(isa), 0)
+def PrePackedWeightsAddInitializers(builder, initializers): builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(initializers), 0)
+def PrePackedWeightsStartInitializersVector(builder, numElems): return builder.StartVector(4, numElems, 4)
+def PrePackedWeightsEnd(builder): return builder.EndObject()
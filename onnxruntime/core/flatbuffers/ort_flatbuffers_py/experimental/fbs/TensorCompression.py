@@ -0,0 +1,9 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+class TensorCompression(object):
+    Uncompressed = 0
+    Lz4 = 1
+    ByteShuffleLz4 = 2
+
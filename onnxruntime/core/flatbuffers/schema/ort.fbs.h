@@ -66,6 +66,15 @@ struct KernelCreateInfosBuilder;
 struct SubGraphSessionState;
 struct SubGraphSessionStateBuilder;
 
+struct PrePackedBuffer;
+struct PrePackedBufferBuilder;
+
+struct PrePackedInitializer;
+struct PrePackedInitializerBuilder;
+
+struct PrePackedWeights;
+struct PrePackedWeightsBuilder;
+
 struct SessionState;
 struct SessionStateBuilder;
 
@@ -328,6 +337,39 @@ template<> struct TypeInfoValueTraits<onnxruntime::experimental::fbs::MapType> {
 bool VerifyTypeInfoValue(flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type);
 bool VerifyTypeInfoValueVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types);
 
+enum class TensorCompression : int8_t {
+  Uncompressed = 0,
+  Lz4 = 1,
+  ByteShuffleLz4 = 2,
+  MIN = Uncompressed,
+  MAX = ByteShuffleLz4
+};
+
+inline const TensorCompression (&EnumValuesTensorCompression())[3] {
+  static const TensorCompression values[] = {
+    TensorCompression::Uncompressed,
+    TensorCompression::Lz4,
+    TensorCompression::ByteShuffleLz4
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesTensorCompression() {
+  static const char * const names[4] = {
+    "Uncompressed",
+    "Lz4",
+    "ByteShuffleLz4",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameTensorCompression(TensorCompression e) {
+  if (flatbuffers::IsOutRange(e, TensorCompression::Uncompressed, TensorCompression::ByteShuffleLz4)) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesTensorCompression()[index];
+}
+
 FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) EdgeEnd FLATBUFFERS_FINAL_CLASS {
  private:
   uint32_t node_index_;
@@ -1244,7 +1286,8 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_DIMS = 8,
     VT_DATA_TYPE = 10,
     VT_RAW_DATA = 12,
-    VT_STRING_DATA = 14
+    VT_STRING_DATA = 14,
+    VT_COMPRESSION = 16
   };
   const flatbuffers::String *name() const {
     return GetPointer<const flatbuffers::String *>(VT_NAME);
@@ -1264,6 +1307,9 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *string_data() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_STRING_DATA);
   }
+  onnxruntime::experimental::fbs::TensorCompression compression() const {
+    return static_cast<onnxruntime::experimental::fbs::TensorCompression>(GetField<int8_t>(VT_COMPRESSION, 0));
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_NAME) &&
@@ -1278,6 +1324,7 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_STRING_DATA) &&
            verifier.VerifyVector(string_data()) &&
            verifier.VerifyVectorOfStrings(string_data()) &&
+           VerifyField<int8_t>(verifier, VT_COMPRESSION) &&
            verifier.EndTable();
   }
 };
@@ -1304,6 +1351,9 @@ struct TensorBuilder {
   void add_string_data(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data) {
     fbb_.AddOffset(Tensor::VT_STRING_DATA, string_data);
   }
+  void add_compression(onnxruntime::experimental::fbs::TensorCompression compression) {
+    fbb_.AddElement<int8_t>(Tensor::VT_COMPRESSION, static_cast<int8_t>(compression), 0);
+  }
   explicit TensorBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1323,7 +1373,8 @@ inline flatbuffers::Offset<Tensor> CreateTensor(
     flatbuffers::Offset<flatbuffers::Vector<int64_t>> dims = 0,
     onnxruntime::experimental::fbs::TensorDataType data_type = onnxruntime::experimental::fbs::TensorDataType::UNDEFINED,
     flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data = 0,
+    onnxruntime::experimental::fbs::TensorCompression compression = onnxruntime::experimental::fbs::TensorCompression::Uncompressed) {
   TensorBuilder builder_(_fbb);
   builder_.add_string_data(string_data);
   builder_.add_raw_data(raw_data);
@@ -1331,6 +1382,7 @@ inline flatbuffers::Offset<Tensor> CreateTensor(
   builder_.add_dims(dims);
   builder_.add_doc_string(doc_string);
   builder_.add_name(name);
+  builder_.add_compression(compression);
   return builder_.Finish();
 }
 
@@ -1341,7 +1393,8 @@ inline flatbuffers::Offset<Tensor> CreateTensorDirect(
     const std::vector<int64_t> *dims = nullptr,
     onnxruntime::experimental::fbs::TensorDataType data_type = onnxruntime::experimental::fbs::TensorDataType::UNDEFINED,
     const std::vector<uint8_t> *raw_data = nullptr,
-    const std::vector<flatbuffers::Offset<flatbuffers::String>> *string_data = nullptr) {
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *string_data = nullptr,
+    onnxruntime::experimental::fbs::TensorCompression compression = onnxruntime::experimental::fbs::TensorCompression::Uncompressed) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
   auto doc_string__ = doc_string ? _fbb.CreateString(doc_string) : 0;
   auto dims__ = dims ? _fbb.CreateVector<int64_t>(*dims) : 0;
@@ -1354,7 +1407,8 @@ inline flatbuffers::Offset<Tensor> CreateTensorDirect(
       dims__,
       data_type,
       raw_data__,
-      string_data__);
+      string_data__,
+      compression);
 }
 
 struct SparseTensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -2103,11 +2157,220 @@ inline flatbuffers::Offset<SubGraphSessionState> CreateSubGraphSessionStateDirec
       session_state);
 }
 
+struct PrePackedBuffer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PrePackedBufferBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_DATA = 4
+  };
+  const flatbuffers::Vector<uint8_t> *data() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_DATA);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_DATA) &&
+           verifier.VerifyVector(data()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PrePackedBufferBuilder {
+  typedef PrePackedBuffer Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_data(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data) {
+    fbb_.AddOffset(PrePackedBuffer::VT_DATA, data);
+  }
+  explicit PrePackedBufferBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  PrePackedBufferBuilder &operator=(const PrePackedBufferBuilder &);
+  flatbuffers::Offset<PrePackedBuffer> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PrePackedBuffer>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PrePackedBuffer> CreatePrePackedBuffer(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data = 0) {
+  PrePackedBufferBuilder builder_(_fbb);
+  builder_.add_data(data);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PrePackedBuffer> CreatePrePackedBufferDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<uint8_t> *data = nullptr) {
+  auto data__ = data ? _fbb.CreateVector<uint8_t>(*data) : 0;
+  return onnxruntime::experimental::fbs::CreatePrePackedBuffer(
+      _fbb,
+      data__);
+}
+
+struct PrePackedInitializer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PrePackedInitializerBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NODE_INDEX = 4,
+    VT_INPUT_INDEX = 6,
+    VT_KERNEL_DEF_HASH = 8,
+    VT_BUFFERS = 10
+  };
+  uint32_t node_index() const {
+    return GetField<uint32_t>(VT_NODE_INDEX, 0);
+  }
+  int32_t input_index() const {
+    return GetField<int32_t>(VT_INPUT_INDEX, 0);
+  }
+  uint64_t kernel_def_hash() const {
+    return GetField<uint64_t>(VT_KERNEL_DEF_HASH, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>> *buffers() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>> *>(VT_BUFFERS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_NODE_INDEX) &&
+           VerifyField<int32_t>(verifier, VT_INPUT_INDEX) &&
+           VerifyField<uint64_t>(verifier, VT_KERNEL_DEF_HASH) &&
+           VerifyOffset(verifier, VT_BUFFERS) &&
+           verifier.VerifyVector(buffers()) &&
+           verifier.VerifyVectorOfTables(buffers()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PrePackedInitializerBuilder {
+  typedef PrePackedInitializer Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_node_index(uint32_t node_index) {
+    fbb_.AddElement<uint32_t>(PrePackedInitializer::VT_NODE_INDEX, node_index, 0);
+  }
+  void add_input_index(int32_t input_index) {
+    fbb_.AddElement<int32_t>(PrePackedInitializer::VT_INPUT_INDEX, input_index, 0);
+  }
+  void add_kernel_def_hash(uint64_t kernel_def_hash) {
+    fbb_.AddElement<uint64_t>(PrePackedInitializer::VT_KERNEL_DEF_HASH, kernel_def_hash, 0);
+  }
+  void add_buffers(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>>> buffers) {
+    fbb_.AddOffset(PrePackedInitializer::VT_BUFFERS, buffers);
+  }
+  explicit PrePackedInitializerBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  PrePackedInitializerBuilder &operator=(const PrePackedInitializerBuilder &);
+  flatbuffers::Offset<PrePackedInitializer> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PrePackedInitializer>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PrePackedInitializer> CreatePrePackedInitializer(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t node_index = 0,
+    int32_t input_index = 0,
+    uint64_t kernel_def_hash = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>>> buffers = 0) {
+  PrePackedInitializerBuilder builder_(_fbb);
+  builder_.add_kernel_def_hash(kernel_def_hash);
+  builder_.add_buffers(buffers);
+  builder_.add_input_index(input_index);
+  builder_.add_node_index(node_index);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PrePackedInitializer> CreatePrePackedInitializerDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t node_index = 0,
+    int32_t input_index = 0,
+    uint64_t kernel_def_hash = 0,
+    const std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>> *buffers = nullptr) {
+  auto buffers__ = buffers ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>>(*buffers) : 0;
+  return onnxruntime::experimental::fbs::CreatePrePackedInitializer(
+      _fbb,
+      node_index,
+      input_index,
+      kernel_def_hash,
+      buffers__);
+}
+
+struct PrePackedWeights FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PrePackedWeightsBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ISA = 4,
+    VT_INITIALIZERS = 6
+  };
+  const flatbuffers::String *isa() const {
+    return GetPointer<const flatbuffers::String *>(VT_ISA);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedInitializer>> *initializers() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedInitializer>> *>(VT_INITIALIZERS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_ISA) &&
+           verifier.VerifyString(isa()) &&
+           VerifyOffset(verifier, VT_INITIALIZERS) &&
+           verifier.VerifyVector(initializers()) &&
+           verifier.VerifyVectorOfTables(initializers()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PrePackedWeightsBuilder {
+  typedef PrePackedWeights Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_isa(flatbuffers::Offset<flatbuffers::String> isa) {
+    fbb_.AddOffset(PrePackedWeights::VT_ISA, isa);
+  }
+  void add_initializers(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedInitializer>>> initializers) {
+    fbb_.AddOffset(PrePackedWeights::VT_INITIALIZERS, initializers);
+  }
+  explicit PrePackedWeightsBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  PrePackedWeightsBuilder &operator=(const PrePackedWeightsBuilder &);
+  flatbuffers::Offset<PrePackedWeights> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PrePackedWeights>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PrePackedWeights> CreatePrePackedWeights(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> isa = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedInitializer>>> initializers = 0) {
+  PrePackedWeightsBuilder builder_(_fbb);
+  builder_.add_initializers(initializers);
+  builder_.add_isa(isa);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PrePackedWeights> CreatePrePackedWeightsDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *isa = nullptr,
+    const std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedInitializer>> *initializers = nullptr) {
+  auto isa__ = isa ? _fbb.CreateString(isa) : 0;
+  auto initializers__ = initializers ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedInitializer>>(*initializers) : 0;
+  return onnxruntime::experimental::fbs::CreatePrePackedWeights(
+      _fbb,
+      isa__,
+      initializers__);
+}
+
 struct SessionState FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef SessionStateBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_KERNELS = 4,
-    VT_SUB_GRAPH_SESSION_STATES = 6
+    VT_SUB_GRAPH_SESSION_STATES = 6,
+    VT_PREPACKED_WEIGHTS = 8
   };
   const onnxruntime::experimental::fbs::KernelCreateInfos *kernels() const {
     return GetPointer<const onnxruntime::experimental::fbs::KernelCreateInfos *>(VT_KERNELS);
@@ -2115,6 +2378,9 @@ struct SessionState FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>> *sub_graph_session_states() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>> *>(VT_SUB_GRAPH_SESSION_STATES);
   }
+  const onnxruntime::experimental::fbs::PrePackedWeights *prepacked_weights() const {
+    return GetPointer<const onnxruntime::experimental::fbs::PrePackedWeights *>(VT_PREPACKED_WEIGHTS);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_KERNELS) &&
@@ -2122,6 +2388,8 @@ struct SessionState FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_SUB_GRAPH_SESSION_STATES) &&
            verifier.VerifyVector(sub_graph_session_states()) &&
            verifier.VerifyVectorOfTables(sub_graph_session_states()) &&
+           VerifyOffset(verifier, VT_PREPACKED_WEIGHTS) &&
+           verifier.VerifyTable(prepacked_weights()) &&
            verifier.EndTable();
   }
 };
@@ -2136,6 +2404,9 @@ struct SessionStateBuilder {
   void add_sub_graph_session_states(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>>> sub_graph_session_states) {
     fbb_.AddOffset(SessionState::VT_SUB_GRAPH_SESSION_STATES, sub_graph_session_states);
   }
+  void add_prepacked_weights(flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeights> prepacked_weights) {
+    fbb_.AddOffset(SessionState::VT_PREPACKED_WEIGHTS, prepacked_weights);
+  }
   explicit SessionStateBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -2151,8 +2422,10 @@ struct SessionStateBuilder {
 inline flatbuffers::Offset<SessionState> CreateSessionState(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<onnxruntime::experimental::fbs::KernelCreateInfos> kernels = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>>> sub_graph_session_states = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>>> sub_graph_session_states = 0,
+    flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeights> prepacked_weights = 0) {
   SessionStateBuilder builder_(_fbb);
+  builder_.add_prepacked_weights(prepacked_weights);
   builder_.add_sub_graph_session_states(sub_graph_session_states);
   builder_.add_kernels(kernels);
   return builder_.Finish();
@@ -2161,12 +2434,14 @@ inline flatbuffers::Offset<SessionState> CreateSessionState(
 inline flatbuffers::Offset<SessionState> CreateSessionStateDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<onnxruntime::experimental::fbs::KernelCreateInfos> kernels = 0,
-    std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>> *sub_graph_session_states = nullptr) {
+    std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>> *sub_graph_session_states = nullptr,
+    flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeights> prepacked_weights = 0) {
   auto sub_graph_session_states__ = sub_graph_session_states ? _fbb.CreateVectorOfSortedTables<onnxruntime::experimental::fbs::SubGraphSessionState>(sub_graph_session_states) : 0;
   return onnxruntime::experimental::fbs::CreateSessionState(
       _fbb,
       kernels,
-      sub_graph_session_states__);
+      sub_graph_session_states__,
+      prepacked_weights);
 }
 
 struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
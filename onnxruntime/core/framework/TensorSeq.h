@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "core/framework/ml_value.h"
 #include "core/framework/tensor.h"
+#include <iterator>
 #include <vector>
 #include <utility>
 
@@ -17,12 +19,42 @@ class TensorSeq {
     SetType(elem_type);
   }
 
-  using const_iterator = std::vector<Tensor>::const_iterator;
+  // Iterates over the tensors of the sequence
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Tensor;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Tensor*;
+    using reference = const Tensor&;
+
+    explicit const_iterator(std::vector<OrtValue>::const_iterator it) noexcept : it_(it) {}
+
+    reference operator*() const { return it_->Get<Tensor>(); }
+    pointer operator->() const { return &it_->Get<Tensor>(); }
+
+    const_iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator tmp = *this;
+      ++it_;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& o) const noexcept { return it_ == o.it_; }
+    bool operator!=(const const_iterator& o) const noexcept { return it_ != o.it_; }
+
+   private:
+    std::vector<OrtValue>::const_iterator it_;
+  };
 
   // Sets the element type after construction.
   // Expects sequence to be empty at the time.
   void SetType(MLDataType elem_type) {
-    assert(tensors_.empty());
+    assert(ort_values_.empty());
     elem_type_ = elem_type->AsPrimitiveDataType();
     ORT_ENFORCE(elem_type_ != nullptr, "Tensor sequence must contain only primitive types");
   }
@@ -31,8 +63,33 @@ class TensorSeq {
     // The caller of this method ensures that :
     // (1) `elem_type` is set before invoking this method
     // (2) All tensors contain elements of the same primitive data type
-    assert(tensors_.empty());
-    tensors_ = std::move(tensors);
+    assert(ort_values_.empty());
+    ort_values_.reserve(tensors.size());
+    for (auto& tensor : tensors) {
+      Add(std::move(tensor));
+    }
+  }
+
+  // Same as above, with the tensors held by OrtValues that may be shared with other sequences.
+  void SetElements(std::vector<OrtValue>&& ort_values) {
+    assert(ort_values_.empty());
+    ort_values_ = std::move(ort_values);
+  }
+
+  // Appends a tensor, taking ownership of it
+  void Add(Tensor&& tensor) {
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    OrtValue ort_value;
+    ort_value.Init(new Tensor(std::move(tensor)), ml_tensor, ml_tensor->GetDeleteFunc());
+    ort_values_.push_back(std::move(ort_value));
+  }
+
+  // Appends a tensor that is shared with the given OrtValue.
+  // Tensors in a sequence are never modified, so sequences can share them instead of copying.
+  // The tensor must own its buffer, so that it outlives the execution frame that created it.
+  void Add(const OrtValue& ort_value) {
+    ORT_ENFORCE(ort_value.IsTensor(), "Tensor sequence must contain only tensors");
+    ort_values_.push_back(ort_value);
   }
 
   MLDataType DataType() const noexcept { return elem_type_; }
@@ -45,21 +102,26 @@ class TensorSeq {
     return elem_type_ == o.DataType()->AsPrimitiveDataType();
   }
 
-  size_t Size() const noexcept { return tensors_.size(); }
+  size_t Size() const noexcept { return ort_values_.size(); }
 
   // Suitable for for range loop
   const_iterator begin() const noexcept {
-    return tensors_.cbegin();
+    return const_iterator(ort_values_.cbegin());
   }
 
   const_iterator end() const noexcept {
-    return tensors_.cend();
+    return const_iterator(ort_values_.cend());
   }
 
   // Get by index
   const Tensor& Get(size_t i) const {
-    ORT_ENFORCE(i < tensors_.size());
-    return tensors_[i];
+    return GetOrtValue(i).Get<Tensor>();
+  }
+
+  // Get the OrtValue holding the tensor at the index, to share the tensor with another sequence
+  const OrtValue& GetOrtValue(size_t i) const {
+    ORT_ENFORCE(i < ort_values_.size());
+    return ort_values_[i];
   }
 
  private:
@@ -72,7 +134,8 @@ class TensorSeq {
 
   // TODO: optimization opportunity - if all tensors in the seq are scalars, we can potentially represent them
   // as vector<primitive type>
-  std::vector<Tensor> tensors_;
+  // The tensors are reference counted, so sequence ops can share them between their input and output sequences.
+  std::vector<OrtValue> ort_values_;
 };
 
 }  // namespace onnxruntime
@@ -542,8 +542,11 @@ class PlannerImpl {
 
       // if sync is needed, mark allocation plan as create_fence_if_async=true
       // note that the input arg may come from an execution provider (i.e. CPU) that does not support async,
-      // in which case create_fence_if_async would be ignored when creating MLValue
-      if (p_kernel_def->ExecQueueId() != 0) {
+      // in which case create_fence_if_async would be ignored when creating MLValue.
+      // values of providers with multiple compute queues always need a fence, as the buffer of a value released
+      // on one queue may be handed out by the allocator to a node on another queue.
+      if (p_kernel_def->ExecQueueId() != 0 ||
+          (!plan_.node_exec_queue_ids.empty() && exec_provider->GetComputeQueueIds().size() > 1)) {
         pnode->ForEachDef([this](const onnxruntime::NodeArg& arg, bool /*is_input*/) {
           OrtValueIndex index = Index(arg.Name());
           AllocPlan(index).create_fence_if_async = true;
@@ -925,6 +928,117 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // Assign the nodes of execution providers with more than one compute queue to those queues.
+  // A node continues the queue of one of its producers if that producer is the last node assigned to the queue,
+  // so chains of dependent nodes stay on one queue. Any other node starts a new chain on the next queue in
+  // round robin order, which lets independent branches of the graph run concurrently.
+  // Nodes whose kernel requests a specific exec queue keep it. Subgraphs and nodes with subgraphs are not
+  // distributed, as control flow nodes copy values between the outer graph and their subgraphs on the default queue.
+  Status ComputeExecQueueIds() {
+    if (parent_node_ != nullptr) {
+      return Status::OK();
+    }
+
+    bool has_multiple_queues = false;
+    for (const auto& step : plan_.execution_plan) {
+      const auto* pnode = graph_viewer_.GetNode(step.node_index);
+      if (pnode == nullptr) return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Can not find the node ", step.node_index);
+      const auto* exec_provider = execution_providers_.Get(*pnode);
+      if (exec_provider != nullptr && exec_provider->GetComputeQueueIds().size() > 1) {
+        has_multiple_queues = true;
+        break;
+      }
+    }
+
+    if (!has_multiple_queues) {
+      return Status::OK();
+    }
+
+    struct ProviderQueues {
+      std::vector<int> queue_ids;
+      // index into queue_ids of the queue the next new chain is started on
+      size_t next_queue = 0;
+      // last node assigned to each queue, keyed by exec queue id
+      std::unordered_map<int, NodeIndex> queue_tails;
+    };
+    std::unordered_map<const IExecutionProvider*, ProviderQueues> provider_queues;
+
+    plan_.node_exec_queue_ids.assign(graph_viewer_.MaxNodeIndex(), 0);
+    for (const auto& step : plan_.execution_plan) {
+      const auto* pnode = graph_viewer_.GetNode(step.node_index);
+      const KernelCreateInfo& kernel_create_info = GetKernelCreateInfo(kernel_create_info_map_, step.node_index);
+      const int kernel_def_queue_id = kernel_create_info.kernel_def->ExecQueueId();
+      plan_.node_exec_queue_ids[step.node_index] = kernel_def_queue_id;
+
+      const auto* exec_provider = execution_providers_.Get(*pnode);
+      if (exec_provider == nullptr || kernel_def_queue_id != 0 || pnode->ContainsSubgraph()) continue;
+
+      auto queues_it = provider_queues.find(exec_provider);
+      if (queues_it == provider_queues.end()) {
+        queues_it = provider_queues.emplace(exec_provider, ProviderQueues{exec_provider->GetComputeQueueIds()}).first;
+      }
+      auto& queues = queues_it->second;
+      if (queues.queue_ids.size() <= 1) continue;
+
+      bool assigned = false;
+      for (auto it = pnode->InputNodesBegin(), end = pnode->InputNodesEnd(); it != end && !assigned; ++it) {
+        const NodeIndex input_node_index = it->Index();
+        if (execution_providers_.Get(*it) != exec_provider) continue;
+
+        const int input_queue_id = plan_.node_exec_queue_ids[input_node_index];
+        auto tail = queues.queue_tails.find(input_queue_id);
+        if (tail != queues.queue_tails.end() && tail->second == input_node_index) {
+          plan_.node_exec_queue_ids[step.node_index] = input_queue_id;
+          assigned = true;
+        }
+      }
+
+      if (!assigned) {
+        plan_.node_exec_queue_ids[step.node_index] = queues.queue_ids[queues.next_queue];
+        queues.next_queue = (queues.next_queue + 1) % queues.queue_ids.size();
+      }
+
+      queues.queue_tails[plan_.node_exec_queue_ids[step.node_index]] = step.node_index;
+    }
+
+    return Status::OK();
+  }
+
+  // Build the static node dependency graph used by the ParallelExecutor so that it does not have to be
+  // derived from the graph's edges on every Run. Multiple edges between the same pair of nodes are collapsed
+  // so each completed upstream node decrements a downstream node's count exactly once.
+  Status ComputeParallelExecutionDependencies() {
+    const auto max_node_index = graph_viewer_.MaxNodeIndex();
+    plan_.node_dependency_counts.assign(max_node_index, 0);
+    plan_.node_downstream_nodes.assign(max_node_index, {});
+    plan_.parallel_root_nodes.clear();
+
+    for (const auto& step : plan_.execution_plan) {
+      const auto* pnode = graph_viewer_.GetNode(step.node_index);
+      if (pnode == nullptr) return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Can not find the node ", step.node_index);
+
+      auto& downstream_nodes = plan_.node_downstream_nodes[step.node_index];
+      for (auto it = pnode->OutputNodesBegin(), end = pnode->OutputNodesEnd(); it != end; ++it) {
+        downstream_nodes.push_back(it->Index());
+      }
+
+      std::sort(downstream_nodes.begin(), downstream_nodes.end());
+      downstream_nodes.erase(std::unique(downstream_nodes.begin(), downstream_nodes.end()), downstream_nodes.end());
+
+      for (auto downstream_node_index : downstream_nodes) {
+        ++plan_.node_dependency_counts[downstream_node_index];
+      }
+    }
+
+    for (const auto& step : plan_.execution_plan) {
+      if (plan_.node_dependency_counts[step.node_index] == 0) {
+        plan_.parallel_root_nodes.push_back(step.node_index);
+      }
+    }
+
+    return Status::OK();
+  }
+
   // Convert information in a freelist (about which ml-value becomes free when) into
   // a deallocation plan in the format required in an ExecutionPlan
   void GenerateDeallocationPlan() {
@@ -1012,6 +1126,12 @@ Status PlannerImpl::CreatePlan() {
     plan_.execution_plan.emplace_back(n);
   }
 
+  // assign nodes to the compute queues of their execution providers. This needs to be done before ComputeUseCounts
+  // as values used by nodes on multi-queue providers need fences.
+  if (!context_.IsParallelExecutionEnabled()) {
+    ORT_RETURN_IF_ERROR(ComputeExecQueueIds());
+  }
+
   // compute use counts for all ml-values
   ORT_RETURN_IF_ERROR(ComputeUseCounts());
 
@@ -1021,6 +1141,10 @@ Status PlannerImpl::CreatePlan() {
   // Determine nodes that need fence check. This needs to be done after ComputeUseCounts and ComputeReusePlan.
   ORT_RETURN_IF_ERROR(ComputeFenceCheck());
 
+  if (context_.IsParallelExecutionEnabled()) {
+    ORT_RETURN_IF_ERROR(ComputeParallelExecutionDependencies());
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   //Adjust the allocate and lifetime intervals for all ml-values, based on their allocation kind.
   AdjustInplaceLifeIntervals();
@@ -3,8 +3,10 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/huge_page_allocator.h"
 #include "core/framework/mimalloc_arena.h"
 #include "core/common/logging/logging.h"
+#include <cstring>
 #include <mutex>
 #include <sstream>
 #include <unordered_map>
@@ -23,6 +25,20 @@ inline int MakeKey(int id, OrtMemType mem_type) {
 AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
   auto device_allocator = std::unique_ptr<IAllocator>(info.device_alloc_factory(info.device_id));
 
+  // only pageable host memory can be backed by huge pages
+  if (info.arena_cfg.huge_pages != static_cast<int>(HugePageMode::kNone)) {
+    const OrtMemoryInfo& device_info = device_allocator->Info();
+    if (info.arena_cfg.huge_pages < static_cast<int>(HugePageMode::kNone) ||
+        info.arena_cfg.huge_pages > static_cast<int>(HugePageMode::kHugeTlb1GB)) {
+      LOGS_DEFAULT(ERROR) << "Received invalid value of huge_pages " << info.arena_cfg.huge_pages;
+      return nullptr;
+    }
+    if (strcmp(device_info.name, CPU) == 0 && device_info.mem_type == OrtMemTypeDefault) {
+      device_allocator = std::make_unique<HugePageAllocator>(std::move(device_allocator),
+                                                             static_cast<HugePageMode>(info.arena_cfg.huge_pages));
+    }
+  }
+
   if (info.use_arena) {
     size_t max_mem = info.arena_cfg.max_mem == 0 ? BFCArena::DEFAULT_MAX_MEM : info.arena_cfg.max_mem;
     int initial_chunk_size_bytes = info.arena_cfg.initial_chunk_size_bytes == -1
@@ -58,7 +74,11 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                    arena_extend_str,
                                    initial_chunk_size_bytes,
                                    max_dead_bytes_per_chunk,
-                                   initial_regrowth_chunk_size_bytes));
+                                   initial_regrowth_chunk_size_bytes,
+                                   info.arena_cfg.idle_release_ms,
+                                   info.arena_cfg.idle_release_watermark_bytes,
+                                   info.arena_cfg.decommit_chunk_bytes,
+                                   info.arena_cfg.thread_cache_max_bytes));
 #endif
   }
 
@@ -9,6 +9,8 @@
 #include "core/framework/allocator.h"
 
 namespace onnxruntime {
+struct AllocatorStats;
+
 // The interface for arena which manage memory allocations
 // Arena will hold a pool of pre-allocate memories and manage their lifecycle.
 // Need an underline IResourceAllocator to allocate memories.
@@ -32,6 +34,7 @@ class IArenaAllocator : public IAllocator {
   virtual Status Shrink() = 0;
   virtual size_t Used() const = 0;
   virtual size_t Max() const = 0;
+  virtual void GetStats(AllocatorStats* stats) = 0;
   // allocate host pinned memory?
 };
 
@@ -43,6 +46,8 @@ struct AllocatorStats {
   int64_t num_reserves;           // Number of reserves. (Number of calls to Reserve() in arena-based allocators)
   int64_t num_arena_extensions;   // Number of arena extensions (Relevant only for arena based allocators)
   int64_t num_arena_shrinkages;   // Number of arena shrinkages (Relevant only for arena based allocators)
+  int64_t num_decommits;          // Number of free chunks whose pages were returned to the OS (Relevant only for arena based allocators)
+  int64_t num_thread_cache_hits;  // Number of allocations served by a thread cache (Relevant only for arena based allocators)
   int64_t bytes_in_use;           // Number of bytes in use.
   int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
   int64_t max_bytes_in_use;       // The maximum bytes in use.
@@ -59,6 +64,8 @@ struct AllocatorStats {
     this->num_reserves = 0;
     this->num_arena_extensions = 0;
     this->num_arena_shrinkages = 0;
+    this->num_decommits = 0;
+    this->num_thread_cache_hits = 0;
     this->bytes_in_use = 0;
     this->max_bytes_in_use = 0;
     this->max_alloc_size = 0;
@@ -76,6 +83,8 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
+       << "NumDecommits:             " << this->num_decommits << "\n"
+       << "NumThreadCacheHits:       " << this->num_thread_cache_hits << "\n"
        << "MaxAllocSize:             " << this->max_alloc_size << "\n";
     return ss.str();
   }
@@ -2,15 +2,32 @@
 // Licensed under the MIT License.
 
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <type_traits>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace onnxruntime {
+static uint64_t NextArenaId() {
+  static std::atomic<uint64_t> next_arena_id{0};
+  return next_arena_id++;
+}
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
-                   int initial_regrowth_chunk_size_bytes)
+                   int initial_regrowth_chunk_size_bytes,
+                   int idle_release_ms,
+                   size_t idle_release_watermark_bytes,
+                   size_t decommit_chunk_bytes,
+                   size_t thread_cache_max_bytes)
     : IArenaAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                     OrtAllocatorType::OrtArenaAllocator,
                                     resource_allocator->Info().device,
@@ -21,13 +38,34 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       next_allocation_id_(1),
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
-      initial_regrowth_chunk_size_bytes_(initial_regrowth_chunk_size_bytes) {
+      initial_regrowth_chunk_size_bytes_(initial_regrowth_chunk_size_bytes),
+      idle_release_ms_(idle_release_ms),
+      idle_release_watermark_bytes_(idle_release_watermark_bytes),
+      decommit_chunk_bytes_(decommit_chunk_bytes),
+      thread_cache_max_bytes_(thread_cache_max_bytes),
+      arena_id_(NextArenaId()) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_regrowth_chunk_size_bytes: " << initial_regrowth_chunk_size_bytes_
                      << " memory limit: " << total_memory
-                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
+                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy)
+                     << " idle_release_ms: " << idle_release_ms_
+                     << " idle_release_watermark_bytes: " << idle_release_watermark_bytes_
+                     << " decommit_chunk_bytes: " << decommit_chunk_bytes_
+                     << " thread_cache_max_bytes: " << thread_cache_max_bytes_;
+
+  // Only pageable host memory can be handed back with madvise. Pinned memory and device memory
+  // must stay committed while the arena owns it.
+#ifdef __linux__
+  const OrtMemoryInfo& device_info = device_allocator_->Info();
+  if (strcmp(device_info.name, CPU) != 0 || device_info.mem_type != OrtMemTypeDefault) {
+    decommit_chunk_bytes_ = 0;
+  }
+#else
+  decommit_chunk_bytes_ = 0;
+#endif
+  last_idle_release_check_ = std::chrono::steady_clock::now();
 
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
@@ -202,6 +240,9 @@ Status BFCArena::Extend(size_t rounded_bytes) {
   c->allocation_id = -1;
   c->prev = kInvalidChunkHandle;
   c->next = kInvalidChunkHandle;
+  c->freed_time = std::chrono::steady_clock::now();
+  c->decommitted = false;
+  c->thread_cached = false;
 
   region_manager_.set_handle(c->ptr, h);
 
@@ -243,9 +284,124 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (thread_cache_max_bytes_ != 0 && size != 0 && BinNumForSize(RoundedBytes(size)) < kNumThreadCacheBins) {
+    return AllocateFromThreadCache(size);
+  }
   return AllocateRawInternal(size, false);
 }
 
+BFCArena::ThreadCache& BFCArena::GetThreadCache() {
+  // arena ids are never reused, so the entries of destroyed arenas are never looked up
+  thread_local std::unordered_map<uint64_t, ThreadCache*> thread_caches;
+  auto it = thread_caches.find(arena_id_);
+  if (it != thread_caches.end()) {
+    return *it->second;
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  thread_caches_.push_back(std::make_unique<ThreadCache>());
+  ThreadCache* cache = thread_caches_.back().get();
+  thread_caches.emplace(arena_id_, cache);
+  return *cache;
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t num_bytes) {
+  const size_t rounded_bytes = RoundedBytes(num_bytes);
+  ThreadCache& cache = GetThreadCache();
+  {
+    std::lock_guard<OrtMutex> lock(cache.mutex);
+    // the chunks of a bin are smaller than twice the size of any request of the bin, so the best fit is what
+    // FindChunkPtr would return without splitting it.
+    auto& free_chunks = cache.free_chunks[BinNumForSize(rounded_bytes)];
+    auto best = free_chunks.end();
+    for (auto it = free_chunks.begin(); it != free_chunks.end(); ++it) {
+      if (it->second >= rounded_bytes && (best == free_chunks.end() || it->second < best->second)) {
+        best = it;
+      }
+    }
+
+    if (best != free_chunks.end()) {
+      const auto chunk = *best;
+      *best = free_chunks.back();
+      free_chunks.pop_back();
+      cache.free_bytes -= chunk.second;
+      cache.allocated.emplace(chunk.first, chunk.second);
+      ++cache.num_hits;
+      return chunk.first;
+    }
+  }
+
+  size_t chunk_size = 0;
+  void* ptr = AllocateRawInternal(num_bytes, false, &chunk_size);
+  std::lock_guard<OrtMutex> lock(cache.mutex);
+  cache.allocated.emplace(ptr, chunk_size);
+  return ptr;
+}
+
+bool BFCArena::FreeToThreadCache(void* p) {
+  ThreadCache& cache = GetThreadCache();
+  std::vector<void*> flushed_chunks;
+  {
+    std::lock_guard<OrtMutex> lock(cache.mutex);
+    auto it = cache.allocated.find(p);
+    if (it == cache.allocated.end()) {
+      return false;
+    }
+
+    const size_t size = it->second;
+    cache.allocated.erase(it);
+    const BinNum bin_num = BinNumForSize(size);
+    if (bin_num < kNumThreadCacheBins) {
+      cache.free_chunks[bin_num].emplace_back(p, size);
+      cache.free_bytes += size;
+      if (cache.free_bytes > thread_cache_max_bytes_) {
+        TakeFreeChunks(cache, flushed_chunks);
+      }
+    } else {
+      // the chunk was not split as it was too small to, and is larger than the chunks cached
+      flushed_chunks.push_back(p);
+    }
+  }
+
+  if (!flushed_chunks.empty()) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    ReturnThreadCachedChunks(flushed_chunks);
+    if (idle_release_ms_ >= 0) {
+      MaybeReleaseIdleMemory();
+    }
+  }
+
+  return true;
+}
+
+// static
+void BFCArena::TakeFreeChunks(ThreadCache& cache, std::vector<void*>& chunks) {
+  for (auto& free_chunks : cache.free_chunks) {
+    for (const auto& chunk : free_chunks) {
+      chunks.push_back(chunk.first);
+    }
+    free_chunks.clear();
+  }
+  cache.free_bytes = 0;
+}
+
+void BFCArena::ReturnThreadCachedChunks(const std::vector<void*>& chunks) {
+  for (void* p : chunks) {
+    Chunk* c = ChunkFromHandle(region_manager_.get_handle(p));
+    c->thread_cached = false;
+    DeallocateRawInternal(p);
+  }
+}
+
+void BFCArena::FlushThreadCaches() {
+  std::vector<void*> chunks;
+  for (auto& cache : thread_caches_) {
+    std::lock_guard<OrtMutex> lock(cache->mutex);
+    TakeFreeChunks(*cache, chunks);
+  }
+  ReturnThreadCachedChunks(chunks);
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
@@ -283,7 +439,8 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 }
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
-                                    bool dump_log_on_failure) {
+                                    bool dump_log_on_failure,
+                                    size_t* thread_cached_chunk_size) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(VERBOSE) << "tried to allocate 0 bytes";
     return nullptr;
@@ -297,9 +454,19 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
   std::lock_guard<OrtMutex> lock(lock_);
+
+  auto mark_thread_cached = [this, thread_cached_chunk_size](void* ptr) {
+    if (thread_cached_chunk_size != nullptr) {
+      Chunk* c = ChunkFromHandle(region_manager_.get_handle(ptr));
+      c->thread_cached = true;
+      *thread_cached_chunk_size = c->size;
+    }
+    return ptr;
+  };
+
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   if (ptr != nullptr) {
-    return ptr;
+    return mark_thread_cached(ptr);
   }
 
   LOGS_DEFAULT(INFO) << "Extending BFCArena for " << device_allocator_->Info().name
@@ -310,7 +477,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   if (status.IsOK()) {
     ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
     if (ptr != nullptr) {
-      return ptr;
+      return mark_thread_cached(ptr);
     } else {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                                "Failed to find a free memory block despite calling Extend. rounded_bytes=",
@@ -333,6 +500,10 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  for (auto& cache : thread_caches_) {
+    std::lock_guard<OrtMutex> cache_lock(cache->mutex);
+    stats->num_thread_cache_hits += cache->num_hits;
+  }
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -399,6 +570,9 @@ void BFCArena::SplitChunk(BFCArena::ChunkHandle h, size_t num_bytes) {
 
   // The new chunk is not in use.
   new_chunk->allocation_id = -1;
+  new_chunk->freed_time = c->freed_time;
+  new_chunk->decommitted = c->decommitted;
+  new_chunk->thread_cached = false;
 
   // Maintain the pointers.
   // c <-> c_neighbor becomes
@@ -420,6 +594,9 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (thread_cache_max_bytes_ != 0 && FreeToThreadCache(p)) {
+    return;
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -428,12 +605,28 @@ void BFCArena::Free(void* p) {
     stats_.total_allocated_bytes -= it->second;
     reserved_chunks_.erase(it);
   } else {
+    Chunk* c = ChunkFromHandle(region_manager_.get_handle(p));
+    if (c->thread_cached) {
+      // handed out by the cache of another thread
+      for (auto& cache : thread_caches_) {
+        std::lock_guard<OrtMutex> cache_lock(cache->mutex);
+        if (cache->allocated.erase(p) != 0) {
+          break;
+        }
+      }
+      c->thread_cached = false;
+    }
     DeallocateRawInternal(p);
   }
+
+  if (idle_release_ms_ >= 0) {
+    MaybeReleaseIdleMemory();
+  }
 }
 
 Status BFCArena::Shrink() {
   std::lock_guard<OrtMutex> lock(lock_);
+  FlushThreadCaches();
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
   std::vector<size_t> region_sizes;
@@ -464,26 +657,7 @@ Status BFCArena::Shrink() {
     }
 
     if (deallocate_region) {
-      auto shrink_size = region_sizes[i];
-      stats_.num_arena_shrinkages += 1;
-      stats_.total_allocated_bytes -= shrink_size;
-
-      LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
-                            << shrink_size << " bytes. "
-                            << " The total allocated bytes is now " << stats_.total_allocated_bytes;
-
-      h = region_begin_chunk;
-      ChunkHandle temp = region_begin_chunk;
-      while (h != kInvalidChunkHandle) {
-        const Chunk* c = ChunkFromHandle(h);
-        temp = c->next;
-        RemoveFreeChunkFromBin(h);
-        DeleteChunk(h);
-        h = temp;
-      }
-
-      device_allocator_->Free(region_ptr);
-      region_manager_.RemoveAllocationRegion(region_ptr);
+      ReleaseRegion(region_ptr, region_sizes[i]);
     }
 
     ++i;
@@ -496,6 +670,93 @@ Status BFCArena::Shrink() {
   return Status::OK();
 }
 
+void BFCArena::ReleaseRegion(void* region_ptr, size_t region_size) {
+  stats_.num_arena_shrinkages += 1;
+  stats_.total_allocated_bytes -= region_size;
+
+  LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
+                        << region_size << " bytes. "
+                        << " The total allocated bytes is now " << stats_.total_allocated_bytes;
+
+  ChunkHandle h = region_manager_.get_handle(region_ptr);
+  while (h != kInvalidChunkHandle) {
+    const Chunk* c = ChunkFromHandle(h);
+    ChunkHandle temp = c->next;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    h = temp;
+  }
+
+  device_allocator_->Free(region_ptr);
+  region_manager_.RemoveAllocationRegion(region_ptr);
+}
+
+void BFCArena::MaybeReleaseIdleMemory() {
+  const auto now = std::chrono::steady_clock::now();
+  const auto idle_time = std::chrono::milliseconds(idle_release_ms_);
+
+  // Scanning the regions and the large bins is cheap, but not cheap enough to do on every Free.
+  if (now - last_idle_release_check_ < idle_time / 2) {
+    return;
+  }
+  last_idle_release_check_ = now;
+
+  // A completely free region is a single free chunk as neighbouring free chunks are always coalesced.
+  std::vector<std::pair<void*, size_t>> idle_regions;
+  for (const auto& region : region_manager_.regions()) {
+    if (!consider_first_allocation_region_for_shrinkage_ && region.id() == 0) {
+      continue;
+    }
+    const Chunk* c = ChunkFromHandle(region_manager_.get_handle(region.ptr()));
+    if (!c->in_use() && c->size == region.memory_size() && now - c->freed_time >= idle_time) {
+      idle_regions.emplace_back(region.ptr(), region.memory_size());
+    }
+  }
+
+  // Release the largest regions first so the watermark keeps the small ones.
+  std::sort(idle_regions.begin(), idle_regions.end(),
+            [](const std::pair<void*, size_t>& a, const std::pair<void*, size_t>& b) { return a.second > b.second; });
+  bool released = false;
+  for (const auto& region : idle_regions) {
+    if (static_cast<size_t>(stats_.total_allocated_bytes) < region.second + idle_release_watermark_bytes_) {
+      continue;
+    }
+    ReleaseRegion(region.first, region.second);
+    released = true;
+  }
+
+  if (released) {
+    // Same as Shrink(), do not grow straight back to the peak size on the next extension.
+    curr_region_allocation_bytes_ = initial_regrowth_chunk_size_bytes_;
+  }
+
+#ifdef __linux__
+  if (decommit_chunk_bytes_ == 0) {
+    return;
+  }
+
+  const auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+  for (BinNum b = BinNumForSize(decommit_chunk_bytes_); b < kNumBins; b++) {
+    for (const ChunkHandle h : BinFromIndex(b)->free_chunks) {
+      Chunk* c = ChunkFromHandle(h);
+      if (c->decommitted || c->size < decommit_chunk_bytes_ || now - c->freed_time < idle_time) {
+        continue;
+      }
+
+      // Only whole pages inside the chunk can be handed back.
+      const auto begin = reinterpret_cast<std::uintptr_t>(c->ptr);
+      const auto page_begin = (begin + page_size - 1) & ~(page_size - 1);
+      const auto page_end = (begin + c->size) & ~(page_size - 1);
+      if (page_end > page_begin &&
+          madvise(reinterpret_cast<void*>(page_begin), page_end - page_begin, MADV_DONTNEED) == 0) {
+        stats_.num_decommits += 1;
+      }
+      c->decommitted = true;
+    }
+  }
+#endif
+}
+
 void BFCArena::DeallocateRawInternal(void* ptr) {
   // Find the chunk from the ptr.
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
@@ -616,6 +877,12 @@ void BFCArena::FreeAndMaybeCoalesce(BFCArena::ChunkHandle h) {
     }
   }
 
+  if (idle_release_ms_ >= 0) {
+    c = ChunkFromHandle(chunk_to_reassign);
+    c->freed_time = std::chrono::steady_clock::now();
+    c->decommitted = false;
+  }
+
   InsertFreeChunkIntoBin(chunk_to_reassign);
 }
 
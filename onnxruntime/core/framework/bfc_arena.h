@@ -16,9 +16,13 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
@@ -57,13 +61,33 @@ class BFCArena : public IArenaAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_REGROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
-
+  static const int DEFAULT_IDLE_RELEASE_MS = -1;
+  static const size_t DEFAULT_IDLE_RELEASE_WATERMARK_BYTES = 0;
+  static const size_t DEFAULT_DECOMMIT_CHUNK_BYTES = 0;
+  static const size_t DEFAULT_THREAD_CACHE_MAX_BYTES = 0;
+
+  // idle_release_ms: if >= 0, allocation regions that have been completely free for this long are
+  // returned to the device allocator, as Shrink() would do, while the arena is otherwise used.
+  // idle_release_watermark_bytes: idle regions are not released if that would bring the memory held
+  // by the arena below this many bytes.
+  // decommit_chunk_bytes: if > 0 (CPU arenas on Linux only), the pages of free chunks of at least
+  // this size that have been idle for idle_release_ms are returned to the OS with madvise while the
+  // chunks stay in the arena. They are faulted back in, zero-filled, when the chunk is used again.
+  // thread_cache_max_bytes: if > 0, each thread allocating from the arena gets a cache of the chunks
+  // smaller than 1 MB that it freed, from which its next allocations of the same bin are served
+  // without taking the arena lock. The chunks stay in use as far as the arena is concerned while
+  // they are cached. A cache holding more than this many bytes of free chunks, and all the caches
+  // on Shrink(), are flushed back to the arena.
   BFCArena(std::unique_ptr<IAllocator> resource_allocator,
            size_t total_memory,
            ArenaExtendStrategy arena_extend_strategy = DEFAULT_ARENA_EXTEND_STRATEGY,
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
-           int initial_regrowth_chunk_size_bytes = DEFAULT_INITIAL_REGROWTH_CHUNK_SIZE_BYTES);
+           int initial_regrowth_chunk_size_bytes = DEFAULT_INITIAL_REGROWTH_CHUNK_SIZE_BYTES,
+           int idle_release_ms = DEFAULT_IDLE_RELEASE_MS,
+           size_t idle_release_watermark_bytes = DEFAULT_IDLE_RELEASE_WATERMARK_BYTES,
+           size_t decommit_chunk_bytes = DEFAULT_DECOMMIT_CHUNK_BYTES,
+           size_t thread_cache_max_bytes = DEFAULT_THREAD_CACHE_MAX_BYTES);
 
   ~BFCArena() override;
 
@@ -98,14 +122,15 @@ class BFCArena : public IArenaAllocator {
     return device_allocator_->CreateFence(session_state);
   }
 
-  void GetStats(AllocatorStats* stats);
+  void GetStats(AllocatorStats* stats) override;
 
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
 
  private:
-  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  // if thread_cached_chunk_size is not null the chunk is marked as owned by a thread cache and its size is returned.
+  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure, size_t* thread_cached_chunk_size = nullptr);
   void DeallocateRawInternal(void* ptr);
 
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
@@ -151,6 +176,14 @@ class BFCArena : public IArenaAllocator {
     // What bin are we in?
     BinNum bin_num = kInvalidBinNum;
 
+    // When the chunk last became free, and whether its pages have been returned to the OS since.
+    // Only maintained when the idle release policy is enabled.
+    std::chrono::steady_clock::time_point freed_time;
+    bool decommitted = false;
+
+    // Whether the chunk is owned by a thread cache, either handed out by it or free in it.
+    bool thread_cached = false;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -379,6 +412,43 @@ class BFCArena : public IArenaAllocator {
   // Removes the chunk metadata represented by 'h'.
   void DeleteChunk(ChunkHandle h);
 
+  // Deletes the chunks of a completely free allocation region and returns its memory
+  // to the device allocator.
+  void ReleaseRegion(void* region_ptr, size_t region_size);
+
+  // Applies the idle release policy (see the constructor) if it has not been applied recently.
+  void MaybeReleaseIdleMemory();
+
+  // The chunks freed by a thread that are kept for its next allocations, by bin. The mutex is only
+  // contended when the arena flushes the cache or a chunk handed out by it is freed by another thread.
+  static const int kNumThreadCacheBins = 12;  // chunks smaller than 1 MB
+  struct ThreadCache {
+    OrtMutex mutex;
+    // the chunks handed out by the cache, and their sizes
+    std::unordered_map<void*, size_t> allocated;
+    std::array<std::vector<std::pair<void*, size_t>>, kNumThreadCacheBins> free_chunks;
+    size_t free_bytes = 0;
+    int64_t num_hits = 0;
+  };
+
+  // Returns the cache of the calling thread, creating it on first use.
+  ThreadCache& GetThreadCache();
+
+  void* AllocateFromThreadCache(size_t num_bytes);
+
+  // Returns false if the chunk was not handed out by the cache of the calling thread.
+  bool FreeToThreadCache(void* p);
+
+  // Moves the free chunks of a thread cache to chunks. The cache mutex must be held.
+  static void TakeFreeChunks(ThreadCache& cache, std::vector<void*>& chunks);
+
+  // Returns chunks owned by thread caches to the arena, removing them from the cache that handed
+  // them out if needed. lock_ must be held.
+  void ReturnThreadCachedChunks(const std::vector<void*>& chunks);
+
+  // Returns the free chunks of all the thread caches to the arena. lock_ must be held.
+  void FlushThreadCaches();
+
   void DumpMemoryLog(size_t num_bytes);
 
   ChunkHandle AllocateChunk();
@@ -482,6 +552,18 @@ class BFCArena : public IArenaAllocator {
   // is to be considered for shrinkage or not.
   bool consider_first_allocation_region_for_shrinkage_;
 
+  // Idle release policy. See the constructor.
+  const int idle_release_ms_;
+  const size_t idle_release_watermark_bytes_;
+  size_t decommit_chunk_bytes_;
+  std::chrono::steady_clock::time_point last_idle_release_check_;
+
+  // Thread caches. See the constructor. arena_id_ is unique across arenas so the threads can look
+  // up their cache without keeping them alive.
+  const size_t thread_cache_max_bytes_;
+  const uint64_t arena_id_;
+  std::vector<std::unique_ptr<ThreadCache>> thread_caches_;  // GUARDED_BY(lock_)
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
@@ -25,6 +25,24 @@ const IDataTransfer* DataTransferManager::GetDataTransfer(const OrtDevice& src_d
   return nullptr;
 }
 
+void DataTransferManager::RecordCopy(const Tensor& src, const Tensor& dst) const {
+  const bool src_is_host = src.Location().device.Type() == OrtDevice::CPU;
+  const bool dst_is_host = dst.Location().device.Type() == OrtDevice::CPU;
+  if (src_is_host && dst_is_host) {
+    return;
+  }
+  auto& bytes = src_is_host ? host_to_device_bytes_ : (dst_is_host ? device_to_host_bytes_ : device_to_device_bytes_);
+  bytes.fetch_add(src.SizeInBytes(), std::memory_order_relaxed);
+}
+
+DataTransferStats DataTransferManager::GetStats() const {
+  DataTransferStats stats;
+  stats.host_to_device_bytes = host_to_device_bytes_.load(std::memory_order_relaxed);
+  stats.device_to_host_bytes = device_to_host_bytes_.load(std::memory_order_relaxed);
+  stats.device_to_device_bytes = device_to_device_bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
 Status DataTransferManager::CopyTensor(const Tensor& src, Tensor& dst) const {
   return CopyTensor(src, dst, 0);
 }
@@ -39,6 +57,7 @@ Status DataTransferManager::CopyTensor(const Tensor& src, Tensor& dst, int exec_
       continue;
     }
 
+    RecordCopy(src, dst);
     return data_transfer->CopyTensor(src, dst, exec_queue_id);
   }
 
@@ -84,6 +103,9 @@ common::Status DataTransferManager::CopyTensors(const std::vector<IDataTransfer:
 
   // all copies are between the same devices so we can do them all at once
   if (all_same) {
+    for (const auto& pair : src_dst_pairs) {
+      RecordCopy(pair.src, pair.dst);
+    }
     return first_dt->CopyTensors(src_dst_pairs);
   }
 
@@ -92,6 +114,7 @@ common::Status DataTransferManager::CopyTensors(const std::vector<IDataTransfer:
   // batch as much as possible.
 
   // copy the first one as we already did the IDataTransfer lookup
+  RecordCopy(first_pair.src, first_pair.dst);
   ORT_RETURN_IF_ERROR(first_dt->CopyTensor(first_pair.src.get(), first_pair.dst.get(), first_pair.exec_queue_id));
 
   for (auto cur_pair = src_dst_pairs.cbegin() + 1, end_pair = src_dst_pairs.cend(); cur_pair != end_pair; ++cur_pair) {
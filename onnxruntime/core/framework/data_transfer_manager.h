@@ -3,12 +3,21 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "core/common/status.h"
 #include "core/framework/data_transfer.h"
 #include "core/framework/tensor.h"
 
 namespace onnxruntime {
 
+// Bytes copied between the host (CPU) and the devices by a DataTransferManager.
+struct DataTransferStats {
+  uint64_t host_to_device_bytes = 0;
+  uint64_t device_to_host_bytes = 0;
+  uint64_t device_to_device_bytes = 0;
+};
+
 // Data transfer manager, which has all functions registered to copy tensors with different location.
 // It's not thread-safe.
 class DataTransferManager {
@@ -24,10 +33,19 @@ class DataTransferManager {
   common::Status CopyTensor(const Tensor& src, Tensor& dst, int exec_queue_id) const;
   common::Status CopyTensors(const std::vector<IDataTransfer::SrcDstPair>& src_dst_pairs) const;
 
+  // Returns the bytes copied by CopyTensor and CopyTensors since the manager was created.
+  DataTransferStats GetStats() const;
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DataTransferManager);
 
   // It's assumed that data transfers in this array have no overlap in terms of copying functionality.
   std::vector<std::unique_ptr<IDataTransfer>> datatransfers_;
+
+  void RecordCopy(const Tensor& src, const Tensor& dst) const;
+
+  mutable std::atomic<uint64_t> host_to_device_bytes_{0};
+  mutable std::atomic<uint64_t> device_to_host_bytes_{0};
+  mutable std::atomic<uint64_t> device_to_device_bytes_{0};
 };
 }  // namespace onnxruntime
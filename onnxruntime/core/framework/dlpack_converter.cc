@@ -1,10 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include "python/dlpack/dlpack_converter.h"
+#include "core/framework/dlpack_converter.h"
+
+#include <dlpack/dlpack.h>
+
+#include "core/framework/tensor.h"
 
 namespace onnxruntime {
-namespace python {
+namespace dlpack {
 
 namespace {
 
@@ -227,12 +231,12 @@ OrtValue DlpackToOrtValue(DLManagedTensor* dlpack, bool is_bool_tensor) {
   OrtMemoryInfo info(GetOrtDeviceName(device), OrtDeviceAllocator, device, device.Id());
   std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(
       data_type, TensorShape(dlpack->dl_tensor.shape, static_cast<size_t>(dlpack->dl_tensor.ndim)),
-      dlpack->dl_tensor.data, info);
+      static_cast<char*>(dlpack->dl_tensor.data) + dlpack->dl_tensor.byte_offset, info);
 
   OrtValue ort_value;
   ort_value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(), deleter);
   return ort_value;
 }
 
-}  // namespace python
+}  // namespace dlpack
 }  // namespace onnxruntime
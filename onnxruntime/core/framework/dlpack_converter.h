@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/ml_value.h"
+
+// Defined in <dlpack/dlpack.h>, only the translation units that read or build one need the definition.
+struct DLManagedTensor;
+
+// These converters share the buffer of a tensor between an OrtValue and a DLPack tensor without copying it,
+// on CPU and on GPU.
+
+namespace onnxruntime {
+namespace dlpack {
+
+// The returned DLManagedTensor holds a reference to the buffer of ort_value.
+// The consumer must invoke its deleter when it is done with the tensor.
+DLManagedTensor* OrtValueToDlpack(OrtValue& ort_value);
+
+// The returned OrtValue takes the ownership of dlpack, its deleter is invoked when the OrtValue is released.
+// Only contiguous (row major) DLPack tensors can be imported without a copy, any other throws.
+// DLPack uses same config for both bool and unit8. Parameter is_bool_tensor is to
+// tell ORT the data type when creating OrtValue.
+OrtValue DlpackToOrtValue(DLManagedTensor* dlpack, bool is_bool_tensor = false);
+
+}  // namespace dlpack
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "core/framework/execution_frame.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
@@ -11,6 +12,7 @@
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/node_index_info.h"
+#include "core/framework/node_memory_tracker.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
 #include "core/framework/TensorSeq.h"
@@ -23,6 +25,9 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
+// size of the blocks the small tensors are allocated from
+static constexpr size_t kSmallTensorBlockSize = 64 * 1024;
+
 IExecutionFrame::IExecutionFrame(const OrtValueNameIdxMap& ort_value_idx_map,
                                  const NodeIndexInfo& node_index_info,
                                  const std::vector<int>& fetch_mlvalue_idxs)
@@ -202,6 +207,10 @@ int IExecutionFrame::GetNodeIdxToMLValueIdx(int index) const {
   return ort_value_idx;
 }
 
+void IExecutionFrame::ClearValues() {
+  std::fill(all_values_.begin(), all_values_.end(), OrtValue());
+}
+
 void IExecutionFrame::Init(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
                            const std::unordered_map<int, OrtValue>& initializers,
                            const std::vector<OrtValue>& fetches) {
@@ -303,11 +312,66 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
       session_state_(session_state),
       mem_patterns_(nullptr),
       planner_(nullptr) {
+  if (session_state.Profiler().MemoryProfilingEnabled()) {
+    memory_tracker_ = std::make_unique<NodeMemoryTracker>();
+  }
+
   Init(feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(), fetches);
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryInfo::IncreaseIteration();
 #endif
 
+  SetupCustomAllocators(fetch_mlvalue_idxs, fetch_allocators);
+  SetupMemoryPatterns(feed_mlvalue_idxs, feeds);
+}
+
+void ExecutionFrame::Reset(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                           const std::vector<OrtValue>& fetches,
+                           const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  // profiling may have been started or stopped since the previous execution
+  if (!session_state_.Profiler().MemoryProfilingEnabled()) {
+    memory_tracker_.reset();
+  } else if (memory_tracker_) {
+    memory_tracker_->Reset();
+  } else {
+    memory_tracker_ = std::make_unique<NodeMemoryTracker>();
+  }
+
+  ClearValues();
+  Init(feed_mlvalue_idxs, feeds, session_state_.GetInitializedTensors(), fetches);
+#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
+  MemoryInfo::IncreaseIteration();
+#endif
+
+  custom_allocators_.clear();
+  SetupCustomAllocators(GetFetchMLValueIdxs(), fetch_allocators);
+
+  dynamic_activation_memory_sizes_in_byte_.clear();
+
+  // the small tensors were released with the values
+  small_tensor_block_ = 0;
+  small_tensor_offset_ = 0;
+
+  // keep the memory patterns and their buffers if the input shapes are the same. if the previous execution traced
+  // its allocations the patterns it generated are now cached, so look them up again with a new planner.
+  if (mem_patterns_ && planner_ == nullptr && MemoryPatternsMatchFeeds(feeds)) {
+    return;
+  }
+
+  mem_patterns_ = nullptr;
+  planner_ = nullptr;
+  mem_patterns_too_small_ = false;
+  buffers_.clear();
+  inferred_shapes_.clear();
+  mem_patterns_feed_shapes_.clear();
+  static_activation_memory_sizes_in_byte_.clear();
+
+  SetupMemoryPatterns(feed_mlvalue_idxs, feeds);
+}
+
+void ExecutionFrame::SetupCustomAllocators(
+    const std::vector<int>& fetch_mlvalue_idxs,
+    const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
   // map the custom allocators to ort_value_idx entries
   if (!fetch_allocators.empty()) {
     for (size_t idx = 0, end = fetch_mlvalue_idxs.size(); idx < end; ++idx) {
@@ -319,6 +383,25 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
       }
     }
   }
+}
+
+bool ExecutionFrame::MemoryPatternsMatchFeeds(const std::vector<OrtValue>& feeds) const {
+  if (feeds.size() != mem_patterns_feed_shapes_.size()) {
+    return false;
+  }
+
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    if (!feeds[i].IsTensor() || feeds[i].Get<Tensor>().Shape() != mem_patterns_feed_shapes_[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void ExecutionFrame::SetupMemoryPatterns(const std::vector<int>& feed_mlvalue_idxs,
+                                         const std::vector<OrtValue>& feeds) {
+  const SessionState& session_state = session_state_;
 
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
@@ -341,9 +424,17 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
     if (all_tensors) {
       mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes, feed_mlvalue_idxs, inferred_shapes_);
       // if no existing patterns, generate one in this executionframe
-      if (!mem_patterns_) {
-        planner_ = std::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan());
-      } else {
+      if (!mem_patterns_ || session_state.GetEnableMemoryPatternShapeBucketing()) {
+        planner_ = std::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan(), false,
+                                                            session_state.GetEnableMemoryPatternLifetimePacking());
+      }
+
+      if (mem_patterns_) {
+        mem_patterns_feed_shapes_.reserve(input_shapes.size());
+        for (const TensorShape& shape : input_shapes) {
+          mem_patterns_feed_shapes_.push_back(shape);
+        }
+
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
         for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
@@ -418,6 +509,25 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBuffer(OrtValue& ort_value, i
                                                   create_fence);
 }
 
+void* ExecutionFrame::AllocateSmallTensorBuffer(const OrtMemoryInfo& location, size_t size) {
+  // the parallel executor may allocate from several threads
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (small_tensor_block_ < small_tensor_blocks_.size() && small_tensor_offset_ + size > kSmallTensorBlockSize) {
+    ++small_tensor_block_;
+    small_tensor_offset_ = 0;
+  }
+
+  if (small_tensor_block_ == small_tensor_blocks_.size()) {
+    auto alloc = GetAllocator(location);
+    small_tensor_blocks_.emplace_back(alloc->Alloc(kSmallTensorBlockSize), BufferDeleter(alloc));
+  }
+
+  void* buffer = static_cast<char*>(small_tensor_blocks_[small_tensor_block_].get()) + small_tensor_offset_;
+  small_tensor_offset_ += size;
+  return buffer;
+}
+
 Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_value, int ort_value_index,
                                                                 MLDataType element_type,
                                                                 const OrtMemoryInfo& location,
@@ -463,14 +573,24 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is not correct, log message then fall back to default behavior.
+          // with shape bucketing the memory pattern may be for smaller shapes, so a larger block can be used.
+          const bool bucketing = session_state_.GetEnableMemoryPatternShapeBucketing();
+          if (block->size_ == size || (bucketing && block->size_ > size)) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
                 shape);
+            if (status.IsOK()) {
+              TraceAllocate(ort_value_index, size);
+              TrackAllocate(ort_value_index, location, size, true);
+            }
             return status;
           } else {
+            if (bucketing && block->size_ < size) {
+              mem_patterns_too_small_ = true;
+            }
+
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
             // fed in, so use VERBOSE as the log level as it's expected.
             // TODO: Should we re-use the block if the size is large enough? Would probably need to allow it
@@ -486,6 +606,21 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
     }
   }
 
+  // small CPU tensors that don't outlive the execution are placed in the blocks of the frame
+  const size_t small_tensor_max_bytes = session_state_.GetSmallTensorMaxBytes();
+  if (small_tensor_max_bytes != 0 && static_cast<size_t>(len) * element_type->Size() <= small_tensor_max_bytes &&
+      size <= kSmallTensorBlockSize && per_alloc_plan.alloc_kind != AllocKind::kAllocateOutput &&
+      location.device.Type() == OrtDevice::CPU && location.device.MemType() == OrtDevice::MemType::DEFAULT &&
+      !utils::IsDataTypeString(element_type)) {
+    auto status = AllocateTensorWithPreAllocateBufferHelper(ort_value, AllocateSmallTensorBuffer(location, size),
+                                                            element_type, location, shape);
+    if (status.IsOK()) {
+      TraceAllocate(ort_value_index, size);
+      TrackAllocate(ort_value_index, location, size, false);
+    }
+    return status;
+  }
+
   //no memory pattern, or the pattern is not correct.
   if (!alloc) alloc = GetAllocator(location);
   std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type, shape, alloc);
@@ -501,6 +636,7 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   if (!utils::IsDataTypeString(element_type)) {
     TraceAllocate(ort_value_index, size);
   }
+  TrackAllocate(ort_value_index, location, size, false);
 
   {
     // This code block is not thread-safe.
@@ -730,6 +866,9 @@ void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+  if (memory_tracker_) {
+    memory_tracker_->Free(ort_value_idx);
+  }
   return Status::OK();
 }
 
@@ -757,6 +896,12 @@ void ExecutionFrame::TraceAllocate(int ort_value_idx, size_t size) {
   }
 }
 
+void ExecutionFrame::TrackAllocate(int ort_value_idx, const OrtMemoryInfo& location, size_t size, bool planned) {
+  if (memory_tracker_) {
+    memory_tracker_->Allocate(ort_value_idx, MakeString(location.name, ":", location.id), size, planned);
+  }
+}
+
 void ExecutionFrame::TraceFree(int ort_value_idx) {
   // don't trace free on output tensors.
   if (planner_ && !IsOutput(ort_value_idx)) {
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <unordered_map>
@@ -24,6 +26,7 @@ class OrtValueNameIdxMap;
 class OrtValuePatternPlanner;
 struct MemoryPatternGroup;
 class NodeIndexInfo;
+class NodeMemoryTracker;
 
 class IExecutionFrame {
  protected:
@@ -37,6 +40,11 @@ class IExecutionFrame {
             const std::unordered_map<int, OrtValue>& initializers,
             const std::vector<OrtValue>& fetches);
 
+  // Release all values from the previous execution so Init can be called again for the same fetches.
+  void ClearValues();
+
+  const std::vector<int>& GetFetchMLValueIdxs() const { return fetch_mlvalue_idxs_; }
+
  public:
   virtual ~IExecutionFrame();
 
@@ -135,6 +143,20 @@ class ExecutionFrame final : public IExecutionFrame {
 
   ~ExecutionFrame() override;
 
+  // Reset the frame so it can be used for another execution with the same fetches. This is cheaper than creating
+  // a new frame when the same subgraph is executed repeatedly, e.g. by each iteration of a Loop, as the values
+  // vector is re-used, and the memory patterns and their buffers are kept if the input shapes have not changed.
+  // The fetches of the previous execution must not be using memory pattern buffers, which is the case as graph
+  // outputs are always allocated separately.
+  void Reset(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+             const std::vector<OrtValue>& fetches,
+             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // Returns true if the frame was created for the given fetches, so Reset can be used with them.
+  bool CanReset(const std::vector<int>& fetch_mlvalue_idxs) const {
+    return GetFetchMLValueIdxs() == fetch_mlvalue_idxs;
+  }
+
   // TODO: These two AllocateMLValue... methods are in the API purely for unit test usage.
   // Fix the unit tests so they set an execution plan that results in these methods being called by
   // GetOrCreateNodeOutputMLValue instead
@@ -149,8 +171,11 @@ class ExecutionFrame final : public IExecutionFrame {
   // thread-safe
   Status GeneratePatterns(MemoryPatternGroup* out) const;
 
+  // Returns true if the allocations of this execution were traced and the generated memory patterns should be cached.
+  // That is the case if no memory patterns were cached for the input shapes, or if the cached memory patterns were
+  // generated for smaller shapes in the same bucket and some allocations didn't fit.
   bool HasMemoryPatternPlanner() const {
-    return planner_ != nullptr;
+    return planner_ != nullptr && (mem_patterns_ == nullptr || mem_patterns_too_small_);
   }
 
   // This function try retrieve the inferred shapes for the given NodeArg index.
@@ -177,6 +202,9 @@ class ExecutionFrame final : public IExecutionFrame {
     return static_activation_memory_sizes_in_byte_;
   }
 
+  // Return the tracker attributing the allocated tensors to the nodes, or nullptr if memory profiling is disabled.
+  NodeMemoryTracker* GetMemoryTracker() const { return memory_tracker_.get(); }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
@@ -189,6 +217,15 @@ class ExecutionFrame final : public IExecutionFrame {
   common::Status AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_value_index, const TensorShape* shape,
                                              size_t nnz);
 
+  void SetupCustomAllocators(const std::vector<int>& fetch_mlvalue_idxs,
+                             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // lookup the memory patterns for the input shapes and allocate their buffers
+  void SetupMemoryPatterns(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds);
+
+  // returns true if the feeds have the shapes that the current memory patterns were setup for
+  bool MemoryPatternsMatchFeeds(const std::vector<OrtValue>& feeds) const;
+
   Status AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_value, int ort_value_index, MLDataType element_type,
                                                   const OrtMemoryInfo& location, const TensorShape& shape,
                                                   bool create_fence);
@@ -196,9 +233,16 @@ class ExecutionFrame final : public IExecutionFrame {
   Status AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_value, void* pBuffer, MLDataType element_type,
                                                    const OrtMemoryInfo& location, const TensorShape& shape);
 
+  // get 'size' bytes from small_tensor_blocks_, adding a block if needed. 'size' must be a multiple of
+  // kAllocAlignment and no larger than a block.
+  void* AllocateSmallTensorBuffer(const OrtMemoryInfo& location, size_t size);
+
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
+  // record the allocation in memory_tracker_ if memory profiling is enabled
+  void TrackAllocate(int ort_value_idx, const OrtMemoryInfo& location, size_t size, bool planned);
+
   const AllocPlanPerValue& GetAllocationPlan(int ort_value_idx);
 
   bool IsAllocatedExternally(int ort_value_idx) override;
@@ -211,21 +255,36 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
+  // If memory pattern shape bucketing is enabled we also trace when using a cached memory pattern, so it can be
+  // regenerated if it's too small for the current input shapes.
   std::unique_ptr<OrtValuePatternPlanner> planner_;
 
+  // set if a block in mem_patterns_ was too small for an allocation
+  std::atomic<bool> mem_patterns_too_small_{false};
+
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtMemoryInfo, BufferUniquePtr> buffers_;
 
+  // Blocks the small CPU tensors are allocated from, one after the other. The tensors don't own their buffer, and are
+  // all released at the end of the execution so the blocks are re-used from the start by Reset.
+  // small_tensor_block_ is the block currently allocated from and small_tensor_offset_ the offset of the free space.
+  std::vector<BufferUniquePtr> small_tensor_blocks_;
+  size_t small_tensor_block_ = 0;
+  size_t small_tensor_offset_ = 0;
+
   // Given the input shapes of the executed graph, ExecutionFrame tries inferring
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
   // inferred_shapes_ is generated together with mem_patterns_.
   std::unordered_map<int, TensorShape> inferred_shapes_;
 
+  // The input shapes mem_patterns_ and inferred_shapes_ were setup for.
+  std::vector<TensorShape> mem_patterns_feed_shapes_;
+
   // Size of virtual memory allocated before any kernel execution.
   // This field is not physical memory size.
   // static_activation_memory_sizes_in_byte_[location] is the static memory consumption on "location".
@@ -237,6 +296,9 @@ class ExecutionFrame final : public IExecutionFrame {
   // dynamic_activation_memory_sizes_in_byte_[location] is the dynamic memory consumption on "location".
   std::unordered_map<std::string, size_t> dynamic_activation_memory_sizes_in_byte_;
 
+  // Attributes the allocations of each execution to the nodes when memory profiling is enabled.
+  std::unique_ptr<NodeMemoryTracker> memory_tracker_;
+
   // Mutex which should be acquired when executing non-thread-safe member functions.
   // A current example is the tracker of dynamic memory allocation.
   mutable std::mutex mtx_;
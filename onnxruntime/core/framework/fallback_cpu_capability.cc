@@ -125,6 +125,45 @@ std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewe
         }));
   }
 
+  // Nodes that no EP has claimed and the target EP can't run will fall back to CPU. Their int64 outputs are usually
+  // shapes, e.g. from an op with no kernel on the target EP inside a shape computation, so they are CPU tensors as well.
+  // Without this, the consumers of such a tensor stay on the target EP, and their results are copied back to the
+  // host with a stream synchronization when they reach a CPU input such as the shape of a Reshape.
+  for (const NodeIndex node_id : ordered_nodes) {
+    if (provider_nodes.count(node_id) != 0) {
+      continue;
+    }
+
+    const Node* node = graph.GetNode(node_id);
+    if (node == nullptr || !node->GetExecutionProviderType().empty()) {
+      continue;
+    }
+
+    const KernelCreateInfo* kernel_info = nullptr;
+    for (auto registry : cpu_kernel_registries) {
+      if (registry->TryFindKernel(*node, kCpuExecutionProvider, &kernel_info).IsOK()) {
+        break;
+      }
+    }
+    if (kernel_info == nullptr) {
+      continue;
+    }
+
+    for (const auto* output : node->OutputDefs()) {
+      const auto* type_proto = output->TypeAsProto();
+      if (!output->Exists() || type_proto == nullptr || !type_proto->has_tensor_type() ||
+          type_proto->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_INT64) {
+        continue;
+      }
+
+      cpu_args.insert(output);
+      for (const auto* consumer_node : graph.GetConsumerNodes(output->Name())) {
+        candidates_fw.push(consumer_node->Index());
+        LOGS_DEFAULT(INFO) << "Candidate for fallback CPU execution in forward trace: " << consumer_node->Name();
+      }
+    }
+  }
+
   const std::vector<const NodeArg*>& graph_inputs = graph.GetInputs();
   std::unordered_set<NodeIndex> cpu_nodes;
   // The algo below is trying to identity a subgraph that only depends on cpu tensors.
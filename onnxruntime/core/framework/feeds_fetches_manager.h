@@ -73,6 +73,9 @@ class FeedsFetchesManager {
   const DeviceCopyChecks& GetDeviceCopyChecks() const { return device_copy_checks_; }
   void SetDeviceCopyChecks(DeviceCopyCheck input_copy_needed, DeviceCopyCheck output_copy_needed);
 
+  // reset the device copy info to the defaults so the manager can be reused by a run with other feeds and fetches
+  void ResetDeviceCopyInfo();
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(FeedsFetchesManager);
 
@@ -12,6 +12,7 @@
 #include "core/framework/execution_providers.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/func_kernel.h"
+#include "core/framework/partitioning_cost_model.h"
 
 // uncomment this line to count non-CUDA ops in ONNX domain
 //#define COUNT_NON_CUDA_OPS
@@ -387,6 +388,24 @@ Status GraphPartitioner::PartitionOnnxFormatModel(Graph& graph, bool export_dll,
   return Status::OK();
 }
 
+void GraphPartitioner::MoveIslandsCheaperOnCpu(Graph& graph) const {
+  if (providers_.Get(kCpuExecutionProvider) == nullptr) {
+    return;
+  }
+
+  std::vector<NodeIndex> cpu_nodes;
+  {
+    GraphViewer graph_viewer(graph);
+    cpu_nodes = GetIslandsCheaperOnCpu(graph_viewer, PartitioningCostModel{}, [this](const Node& node) {
+      return KernelRegistryManager::HasImplementationOf(kernel_registry_mgr_, node, kCpuExecutionProvider);
+    });
+  }
+
+  for (auto node_index : cpu_nodes) {
+    graph.GetNode(node_index)->SetExecutionProviderType(kCpuExecutionProvider);
+  }
+}
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 static Status PartitionOrtFormatModelImpl(Graph& graph, FuncManager& func_mgr,
@@ -538,6 +557,10 @@ Status GraphPartitioner::Partition(Graph& graph, bool export_dll, FuncManager& f
 #if !defined(ORT_MINIMAL_BUILD)
     ORT_RETURN_IF_ERROR(PartitionOnnxFormatModel(graph, export_dll, func_mgr, *fused_kernel_registry, mode,
                                                  fused_node_unique_id));
+
+    if (cost_based_partitioning_ && mode == Mode::kNormal) {
+      MoveIslandsCheaperOnCpu(graph);
+    }
 #else
     ORT_UNUSED_PARAMETER(export_dll);
     ORT_THROW("Not supported in this build.");
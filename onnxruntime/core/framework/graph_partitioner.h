@@ -25,9 +25,13 @@ class GraphPartitioner {
   };
 
   //The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  //If cost_based_partitioning is true, small islands of device nodes that are cheaper on CPU once the copies around
+  //them are counted are moved to the CPU execution provider after the nodes are assigned.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   bool cost_based_partitioning = false)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        cost_based_partitioning_(cost_based_partitioning) {
   }
 
   // Run partitioning. Provide compiled_kernel_hashes if mode is kOrtFormatLoad.
@@ -41,6 +45,8 @@ class GraphPartitioner {
 #if !defined(ORT_MINIMAL_BUILD)
   Status PartitionOnnxFormatModel(Graph& graph, bool export_dll, FuncManager& func_mgr,
                                   KernelRegistry& fused_kernel_registry, Mode mode, int& fused_node_unique_id) const;
+
+  void MoveIslandsCheaperOnCpu(Graph& graph) const;
 #endif
 
   Status PartitionOrtFormatModel(Graph& graph, FuncManager& func_mgr, KernelRegistry& fused_kernel_registry,
@@ -49,6 +55,7 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  const bool cost_based_partitioning_;
 };
 }  // namespace onnxruntime
 
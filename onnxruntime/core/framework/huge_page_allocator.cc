@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include <cstdint>
+
+#include "core/common/logging/logging.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace onnxruntime {
+
+#ifdef __linux__
+namespace {
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+#if defined(MAP_HUGE_1GB)
+constexpr size_t kGiganticPageSize = 1024 * 1024 * 1024;
+#endif
+}  // namespace
+#endif
+
+HugePageAllocator::HugePageAllocator(std::unique_ptr<IAllocator> allocator, HugePageMode mode)
+    : IAllocator(allocator->Info()), allocator_(std::move(allocator)), mode_(mode) {
+#ifndef __linux__
+  if (mode_ != HugePageMode::kNone) {
+    LOGS_DEFAULT(WARNING) << "Huge pages are only supported on Linux and will not be used.";
+    mode_ = HugePageMode::kNone;
+  }
+#endif
+}
+
+HugePageAllocator::~HugePageAllocator() {
+#ifdef __linux__
+  for (const auto& mapping : mappings_) {
+    munmap(mapping.first, mapping.second);
+  }
+#endif
+}
+
+void* HugePageAllocator::MapHugePages(size_t size, size_t& mapped_size) const {
+#ifdef __linux__
+  auto round_up = [size](size_t page_size) { return (size + page_size - 1) & ~(page_size - 1); };
+
+#if defined(MAP_HUGETLB)
+#if defined(MAP_HUGE_1GB)
+  if (mode_ == HugePageMode::kHugeTlb1GB && size >= kGiganticPageSize) {
+    mapped_size = round_up(kGiganticPageSize);
+    void* p = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_1GB, -1, 0);
+    if (p != MAP_FAILED) {
+      return p;
+    }
+  }
+#endif
+
+  if (mode_ == HugePageMode::kHugeTlb2MB || mode_ == HugePageMode::kHugeTlb1GB) {
+    // the pages are reserved by mmap, so it fails if the pool doesn't have enough free pages
+    mapped_size = round_up(kHugePageSize);
+    void* p = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) {
+      return p;
+    }
+
+    LOGS_DEFAULT(VERBOSE) << "Could not map " << mapped_size
+                          << " bytes of hugetlbfs pages, falling back to transparent huge pages.";
+  }
+#endif
+
+  // map one more huge page to be able to align the mapping, and unmap what's outside of the aligned range
+  mapped_size = round_up(kHugePageSize);
+  const size_t unaligned_size = mapped_size + kHugePageSize;
+  void* p = mmap(nullptr, unaligned_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    return nullptr;
+  }
+
+  const auto begin = reinterpret_cast<std::uintptr_t>(p);
+  const auto aligned_begin = (begin + kHugePageSize - 1) & ~static_cast<std::uintptr_t>(kHugePageSize - 1);
+  const auto end = begin + unaligned_size;
+  const auto aligned_end = aligned_begin + mapped_size;
+  if (aligned_begin > begin) {
+    munmap(p, aligned_begin - begin);
+  }
+  if (end > aligned_end) {
+    munmap(reinterpret_cast<void*>(aligned_end), end - aligned_end);
+  }
+
+  // not fatal if transparent huge pages are disabled, the mapping is still usable with regular pages
+  void* aligned = reinterpret_cast<void*>(aligned_begin);
+  madvise(aligned, mapped_size, MADV_HUGEPAGE);
+  return aligned;
+#else
+  ORT_UNUSED_PARAMETER(size);
+  mapped_size = 0;
+  return nullptr;
+#endif
+}
+
+void* HugePageAllocator::Alloc(size_t size) {
+#ifdef __linux__
+  if (mode_ != HugePageMode::kNone && size >= kHugePageSize) {
+    size_t mapped_size = 0;
+    void* p = MapHugePages(size, mapped_size);
+    if (p != nullptr) {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      mappings_.emplace(p, mapped_size);
+      return p;
+    }
+  }
+#endif
+
+  return allocator_->Alloc(size);
+}
+
+void HugePageAllocator::Free(void* p) {
+#ifdef __linux__
+  if (mode_ != HugePageMode::kNone && p != nullptr) {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    auto it = mappings_.find(p);
+    if (it != mappings_.end()) {
+      const size_t mapped_size = it->second;
+      mappings_.erase(it);
+      lock.unlock();
+      munmap(p, mapped_size);
+      return;
+    }
+  }
+#endif
+
+  allocator_->Free(p);
+}
+
+}  // namespace onnxruntime
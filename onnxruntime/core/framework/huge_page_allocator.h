@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// How large CPU allocations are backed by huge pages. The values are those of OrtArenaCfg::huge_pages.
+enum class HugePageMode : int {
+  kNone = 0,
+  // transparent huge pages: 2 MB aligned anonymous mappings marked with madvise(MADV_HUGEPAGE)
+  kTransparent = 1,
+  // pages of the 2 MB or 1 GB hugetlbfs pool, mapped with MAP_HUGETLB. falls back to transparent huge pages when the
+  // pool doesn't have enough free pages.
+  kHugeTlb2MB = 2,
+  kHugeTlb1GB = 3,
+};
+
+// HugePageAllocator backs the allocations of at least 2 MB with huge pages, to reduce the TLB misses of large working
+// sets such as the regions of a CPU arena and the initializers. Each allocation is mapped separately and its size
+// rounded up to a whole number of huge pages (1 GB pages are only used for allocations of at least 1 GB). Smaller
+// allocations, and the ones for which no huge pages can be mapped, are made by the wrapped allocator.
+// Linux only. Elsewhere every allocation is made by the wrapped allocator.
+// Thread-safe.
+class HugePageAllocator : public IAllocator {
+ public:
+  HugePageAllocator(std::unique_ptr<IAllocator> allocator, HugePageMode mode);
+  ~HugePageAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+  // map size bytes rounded up to whole huge pages. returns nullptr if that fails.
+  void* MapHugePages(size_t size, size_t& mapped_size) const;
+
+  std::unique_ptr<IAllocator> allocator_;
+  HugePageMode mode_;
+
+  OrtMutex mutex_;
+  // the huge page mappings and their sizes
+  std::unordered_map<void*, size_t> mappings_;  // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/inference_result_cache.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iterator>
+
+#include "core/framework/ml_value.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Hashes a sequence of buffers, each hash seeding the next one.
+class RunHasher {
+ public:
+  void Add(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    do {
+      // MurmurHash3 takes an int length
+      const int len = static_cast<int>(std::min<size_t>(size, INT_MAX));
+      uint32_t out[4];
+      MurmurHash3::x86_128(bytes, len, seed_, out);
+      seed_ = out[0];
+      hash_ = (hash_ * 0x100000001b3ULL) ^ ((static_cast<uint64_t>(out[1]) << 32) | out[2]);
+      bytes += len;
+      size -= len;
+    } while (size > 0);
+  }
+
+  void Add(const std::string& str) {
+    Add(str.data(), str.size());
+  }
+
+  uint64_t Get() const { return hash_; }
+
+ private:
+  uint32_t seed_ = 0;
+  uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+}  // namespace
+
+InferenceResultCache::InferenceResultCache(size_t max_bytes, std::chrono::milliseconds ttl)
+    : max_bytes_(max_bytes), ttl_(ttl) {
+}
+
+bool InferenceResultCache::IsCacheable(const std::vector<OrtValue>& values) {
+  return std::all_of(values.cbegin(), values.cend(), [](const OrtValue& value) {
+    return value.IsAllocated() && value.IsTensor() && !value.Get<Tensor>().IsDataTypeString() &&
+           value.Get<Tensor>().Location().device.Type() == OrtDevice::CPU;
+  });
+}
+
+uint64_t InferenceResultCache::Hash(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                    const std::vector<std::string>& output_names) {
+  RunHasher hasher;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const auto& tensor = feeds[i].Get<Tensor>();
+    const auto& dims = tensor.Shape().GetDims();
+    const int32_t element_type = tensor.GetElementType();
+    hasher.Add(feed_names[i]);
+    hasher.Add(&element_type, sizeof(element_type));
+    hasher.Add(dims.data(), dims.size() * sizeof(int64_t));
+    hasher.Add(tensor.DataRaw(), tensor.SizeInBytes());
+  }
+  for (const auto& name : output_names) {
+    hasher.Add(name);
+  }
+  return hasher.Get();
+}
+
+bool InferenceResultCache::Matches(const Entry& entry, const std::vector<std::string>& feed_names,
+                                   const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names) {
+  if (entry.feed_names != feed_names || entry.output_names != output_names) {
+    return false;
+  }
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const auto& tensor = feeds[i].Get<Tensor>();
+    const auto& cached = entry.feeds[i];
+    if (cached.element_type != tensor.DataType() || cached.shape != tensor.Shape() ||
+        cached.data.size() != tensor.SizeInBytes() ||
+        (!cached.data.empty() && memcmp(cached.data.data(), tensor.DataRaw(), cached.data.size()) != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool InferenceResultCache::Lookup(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                  const std::vector<std::string>& output_names, const AllocatorPtr& allocator,
+                                  std::vector<OrtValue>& fetches) {
+  const uint64_t hash = Hash(feed_names, feeds, output_names);
+  const auto now = std::chrono::steady_clock::now();
+
+  std::shared_ptr<const std::vector<CachedTensor>> cached_fetches;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto range = index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      auto entry = it->second;
+      if (!Matches(*entry, feed_names, feeds, output_names)) {
+        continue;
+      }
+
+      if (ttl_.count() > 0 && now - entry->insertion_time > ttl_) {
+        Erase(entry);
+        break;
+      }
+
+      entries_.splice(entries_.begin(), entries_, entry);
+      cached_fetches = entry->fetches;
+      break;
+    }
+
+    if (cached_fetches == nullptr) {
+      ++stats_.misses;
+      return false;
+    }
+    ++stats_.hits;
+  }
+
+  // the outputs are copied as the caller may modify them
+  fetches.clear();
+  fetches.reserve(cached_fetches->size());
+  for (const auto& cached : *cached_fetches) {
+    auto tensor = std::make_unique<Tensor>(cached.element_type, cached.shape, allocator);
+    if (!cached.data.empty()) {
+      memcpy(tensor->MutableDataRaw(), cached.data.data(), cached.data.size());
+    }
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    fetches.emplace_back();
+    fetches.back().Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  }
+  return true;
+}
+
+void InferenceResultCache::Insert(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                  const std::vector<std::string>& output_names,
+                                  const std::vector<OrtValue>& fetches) {
+  if (fetches.size() != output_names.size() || !IsCacheable(fetches)) {
+    return;
+  }
+
+  size_t bytes = 0;
+  for (const auto* values : {&feeds, &fetches}) {
+    for (const auto& value : *values) {
+      bytes += value.Get<Tensor>().SizeInBytes();
+    }
+  }
+  if (bytes > max_bytes_) {
+    return;
+  }
+
+  auto copy = [](const OrtValue& value) {
+    const auto& tensor = value.Get<Tensor>();
+    const auto* data = static_cast<const uint8_t*>(tensor.DataRaw());
+    return CachedTensor{tensor.DataType(), tensor.Shape(), std::vector<uint8_t>(data, data + tensor.SizeInBytes())};
+  };
+
+  Entry entry;
+  entry.hash = Hash(feed_names, feeds, output_names);
+  entry.insertion_time = std::chrono::steady_clock::now();
+  entry.feed_names = feed_names;
+  entry.output_names = output_names;
+  entry.bytes = bytes;
+  entry.feeds.reserve(feeds.size());
+  std::transform(feeds.cbegin(), feeds.cend(), std::back_inserter(entry.feeds), copy);
+  auto cached_fetches = std::make_shared<std::vector<CachedTensor>>();
+  cached_fetches->reserve(fetches.size());
+  std::transform(fetches.cbegin(), fetches.cend(), std::back_inserter(*cached_fetches), copy);
+  entry.fetches = std::move(cached_fetches);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  // concurrent Runs with the same feeds may both miss, keep a single entry
+  auto range = index_.equal_range(entry.hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (Matches(*it->second, feed_names, feeds, output_names)) {
+      Erase(it->second);
+      break;
+    }
+  }
+
+  while (!entries_.empty() && stats_.bytes + bytes > max_bytes_) {
+    Erase(std::prev(entries_.end()));
+    ++stats_.evictions;
+  }
+
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front().hash, entries_.begin());
+  stats_.bytes += bytes;
+  ++stats_.entries;
+}
+
+void InferenceResultCache::Erase(std::list<Entry>::iterator entry) {
+  auto range = index_.equal_range(entry->hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == entry) {
+      index_.erase(it);
+      break;
+    }
+  }
+  stats_.bytes -= entry->bytes;
+  --stats_.entries;
+  entries_.erase(entry);
+}
+
+InferenceResultCache::Stats InferenceResultCache::GetStats() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace onnxruntime
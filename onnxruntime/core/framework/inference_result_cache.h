@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/data_types.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+struct OrtValue;
+
+namespace onnxruntime {
+
+// InferenceResultCache memoizes the outputs of the Runs of a session by the content of their feeds, for models that
+// see the same inputs repeatedly (e.g. the same user and items scored by a recommendation model within a short time).
+// A Run is cached only if its feeds and fetches are all non-string tensors in CPU memory. The feeds are kept along
+// with the outputs, so a hit is checked byte for byte and hash collisions never serve wrong outputs.
+// The least recently used entries are evicted to keep the feeds and outputs of all the entries under max_bytes, and
+// an entry older than ttl is not served anymore. Thread-safe.
+class InferenceResultCache {
+ public:
+  // ttl of zero means entries don't expire
+  InferenceResultCache(size_t max_bytes, std::chrono::milliseconds ttl);
+
+  // Whether values can be part of a cached Run.
+  static bool IsCacheable(const std::vector<OrtValue>& values);
+
+  // Returns true and sets fetches to copies, allocated with allocator, of the outputs of a cached Run with the same
+  // feeds and output names.
+  bool Lookup(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+              const std::vector<std::string>& output_names, const AllocatorPtr& allocator,
+              std::vector<OrtValue>& fetches);
+
+  // Cache the fetches of a Run. Ignored if the fetches are not cacheable or the Run alone is larger than max_bytes.
+  void Insert(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+              const std::vector<std::string>& output_names, const std::vector<OrtValue>& fetches);
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t bytes = 0;
+    size_t entries = 0;
+  };
+
+  Stats GetStats() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InferenceResultCache);
+
+  struct CachedTensor {
+    MLDataType element_type;
+    TensorShape shape;
+    std::vector<uint8_t> data;
+  };
+
+  struct Entry {
+    uint64_t hash;
+    std::chrono::steady_clock::time_point insertion_time;
+    std::vector<std::string> feed_names;
+    std::vector<CachedTensor> feeds;
+    std::vector<std::string> output_names;
+    // shared with the Lookups copying them outside of the lock
+    std::shared_ptr<const std::vector<CachedTensor>> fetches;
+    size_t bytes;
+  };
+
+  static uint64_t Hash(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                       const std::vector<std::string>& output_names);
+
+  static bool Matches(const Entry& entry, const std::vector<std::string>& feed_names,
+                      const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names);
+
+  void Erase(std::list<Entry>::iterator entry);  // EXCLUSIVE_LOCKS_REQUIRED(mutex_)
+
+  const size_t max_bytes_;
+  const std::chrono::milliseconds ttl_;
+
+  mutable OrtMutex mutex_;
+  // most recently used first
+  std::list<Entry> entries_;
+  std::unordered_multimap<uint64_t, std::list<Entry>::iterator> index_;
+  Stats stats_;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/framework/kernel_registry.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 
@@ -12,6 +13,61 @@
 using namespace ::onnxruntime::common;
 namespace onnxruntime {
 
+namespace {
+const std::string& NormalizeDomain(const std::string& domain) {
+  static const std::string onnx_domain_alias(kOnnxDomainAlias);
+  return domain.empty() ? onnx_domain_alias : domain;
+}
+
+bool IsKernelFor(const KernelDef& kernel_def,
+                 const std::string& op_name, const std::string& domain, const std::string& provider) {
+  return kernel_def.OpName() == op_name &&
+         kernel_def.Provider() == provider &&
+         NormalizeDomain(kernel_def.Domain()) == NormalizeDomain(domain);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+// the ideal check is kernel_start_version >= node_version && kernel_start_version <= until_version.
+// see VerifyKernelDef.
+bool IsVersionMatch(int kernel_start_version, int kernel_end_version, int node_since_version) {
+  return kernel_start_version == node_since_version ||
+         (kernel_start_version < node_since_version && kernel_end_version != INT_MAX &&
+          kernel_end_version >= node_since_version);
+}
+#endif
+}  // namespace
+
+uint64_t KernelRegistry::GetIndexKey(const std::string& op_name, const std::string& domain,
+                                     const std::string& provider) {
+  std::hash<std::string> hasher;
+  uint64_t key = hasher(op_name);
+  for (const auto* str : {&NormalizeDomain(domain), &provider}) {
+    key ^= static_cast<uint64_t>(hasher(*str)) + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+  }
+  return key;
+}
+
+const std::vector<KernelRegistry::IndexEntry>* KernelRegistry::FindIndexEntries(const Node& node,
+                                                                               const std::string& provider) const {
+  auto it = kernel_index_.find(GetIndexKey(node.OpType(), node.Domain(), provider));
+  return it == kernel_index_.cend() ? nullptr : &it->second;
+}
+
+void KernelRegistry::AddToIndex(const KernelCreateInfo& create_info) {
+  const KernelDef& kernel_def = *create_info.kernel_def;
+  IndexEntry entry{};
+  kernel_def.SinceVersion(&entry.start_version, &entry.end_version);
+  entry.create_info = &create_info;
+
+  // keep the registration order for kernels with the same start version
+  auto& entries = kernel_index_[GetIndexKey(kernel_def.OpName(), kernel_def.Domain(), kernel_def.Provider())];
+  auto pos = std::upper_bound(entries.begin(), entries.end(), entry.start_version,
+                              [](int start_version, const IndexEntry& e) { return start_version < e.start_version; });
+  entries.insert(pos, entry);
+
+  kernel_def_hash_index_.emplace(kernel_def.GetHash(), &create_info);
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 namespace {
 // Traverses the node's formal parameters and calls TraverseFn with the formal
@@ -137,9 +193,7 @@ bool KernelRegistry::VerifyKernelDef(const onnxruntime::Node& node,
   // As a trade off, we will temporary require kernel definition to have the same since version as schema definition.
   // so kernel_def Since(6) will become invalid now.
   // After ONNX add "until version" on the schema object, we will update this place
-  bool valid_version = kernel_start_version == node_since_version  // the idea case this branch should be kernel_start_version >= node_version && kernel_start_version <= until_version
-                       || (kernel_start_version < node_since_version && kernel_end_version != INT_MAX && kernel_end_version >= node_since_version);
-  if (!valid_version) {
+  if (!IsVersionMatch(kernel_start_version, kernel_end_version, node_since_version)) {
     std::ostringstream ostr;
     ostr << "Op with name (" << node.Name() << ")"
          << " and type (" << node.OpType() << ")"
@@ -249,15 +303,26 @@ Status KernelRegistry::TryFindKernel(const onnxruntime::Node& node,
   const auto& node_provider = node.GetExecutionProviderType();
   const auto& expected_provider = (node_provider.empty() ? exec_provider : node_provider);
 
-  auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
   *out = nullptr;
 
   // if we have a hash (ORT format model) use only that.
   if (kernel_def_hash != 0) {
-    for (auto i = range.first; i != range.second; ++i) {
-      if (i->second.kernel_def->GetHash() == kernel_def_hash) {
-        *out = &i->second;
-        return Status::OK();
+    auto hash_it = kernel_def_hash_index_.find(kernel_def_hash);
+    if (hash_it != kernel_def_hash_index_.cend() &&
+        IsKernelFor(*hash_it->second->kernel_def, node.OpType(), node.Domain(), expected_provider)) {
+      *out = hash_it->second;
+      return Status::OK();
+    }
+
+    // hashes are not required to be unique across ops, so fall back to the kernels for the node
+    const auto* entries = FindIndexEntries(node, expected_provider);
+    if (entries != nullptr) {
+      for (const auto& entry : *entries) {
+        if (entry.create_info->kernel_def->GetHash() == kernel_def_hash &&
+            IsKernelFor(*entry.create_info->kernel_def, node.OpType(), node.Domain(), expected_provider)) {
+          *out = entry.create_info;
+          return Status::OK();
+        }
       }
     }
 
@@ -271,29 +336,62 @@ Status KernelRegistry::TryFindKernel(const onnxruntime::Node& node,
   }
 #if !defined(ORT_MINIMAL_BUILD)
   else {
-    std::vector<std::string> verify_kernel_def_error_strs;
+    const auto* entries = FindIndexEntries(node, expected_provider);
+    if (entries == nullptr) {
+      return Status(ONNXRUNTIME, FAIL, "Kernel not found");
+    }
+
+    // only verify the type constraints of the kernels whose version range matches.
+    // the entries are sorted by start version, so the later ones cannot match.
+    const int node_since_version = node.SinceVersion();
+    for (const auto& entry : *entries) {
+      if (entry.start_version > node_since_version) {
+        break;
+      }
+
+      // the index key is a hash, so also check the names
+      if (!IsVersionMatch(entry.start_version, entry.end_version, node_since_version) ||
+          !IsKernelFor(*entry.create_info->kernel_def, node.OpType(), node.Domain(), expected_provider)) {
+        continue;
+      }
+
+      // common case of a single kernel for all types
+      if (entry.create_info->kernel_def->EnabledTypeConstraints().empty()) {
+        *out = entry.create_info;
+        return Status::OK();
+      }
 
-    for (auto i = range.first; i != range.second; ++i) {
       std::string error_str;
-      if (VerifyKernelDef(node, *i->second.kernel_def, error_str)) {
-        *out = &i->second;
+      if (VerifyKernelDef(node, *entry.create_info->kernel_def, error_str)) {
+        *out = entry.create_info;
         return Status::OK();
       }
-      verify_kernel_def_error_strs.push_back(error_str);
     }
 
-    if (!verify_kernel_def_error_strs.empty()) {
-      std::ostringstream oss;
-      oss << "Op with name (" << node.Name() << ")"
-          << " and type (" << node.OpType() << ")"
-          << " kernel is not supported in " << expected_provider << "."
-          << " Encountered following errors: (" << ToString(verify_kernel_def_error_strs) << ")";
+    // no match. produce the detailed errors for all the kernels of the op.
+    std::vector<std::string> verify_kernel_def_error_strs;
+    for (const auto& entry : *entries) {
+      if (!IsKernelFor(*entry.create_info->kernel_def, node.OpType(), node.Domain(), expected_provider)) {
+        continue;
+      }
+
+      std::string error_str;
+      VerifyKernelDef(node, *entry.create_info->kernel_def, error_str);
+      verify_kernel_def_error_strs.push_back(error_str);
+    }
 
-      return Status(ONNXRUNTIME, FAIL, oss.str());
+    if (verify_kernel_def_error_strs.empty()) {
+      return Status(ONNXRUNTIME, FAIL, "Kernel not found");
     }
-  }
 
-  return Status(ONNXRUNTIME, FAIL, "Kernel not found");
+    std::ostringstream oss;
+    oss << "Op with name (" << node.Name() << ")"
+        << " and type (" << node.OpType() << ")"
+        << " kernel is not supported in " << expected_provider << "."
+        << " Encountered following errors: (" << ToString(verify_kernel_def_error_strs) << ")";
+
+    return Status(ONNXRUNTIME, FAIL, oss.str());
+  }
 #else
   ORT_THROW("Kernel hash must be provided in minimal build.");
 #endif
@@ -322,7 +420,8 @@ Status KernelRegistry::Register(KernelCreateInfo&& create_info) {
 
   // Register the kernel.
   // Ownership of the KernelDef is transferred to the map.
-  kernel_creator_fn_map_.emplace(key, std::move(create_info));
+  auto it = kernel_creator_fn_map_.emplace(key, std::move(create_info));
+  AddToIndex(it->second);
   return Status::OK();
 }
 
@@ -11,6 +11,7 @@
 #include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
+struct ConfigOptions;
 struct KernelCreateInfo;
 class ExecutionProviders;
 class IExecutionProvider;
@@ -78,7 +79,8 @@ class KernelRegistryManager {
   std::unique_ptr<OpKernel> CreateKernel(const onnxruntime::Node& node,
                                          const IExecutionProvider& execution_provider,
                                          const SessionState& session_state,
-                                         const KernelCreateInfo& kernel_create_info) const ORT_MUST_USE_RESULT;
+                                         const KernelCreateInfo& kernel_create_info,
+                                         const ConfigOptions& config_options) const ORT_MUST_USE_RESULT;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelRegistryManager);
 
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_planner.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+
+bool MemPatternPlanner::PackLifetimes(MemoryPattern& pattern) const {
+  std::vector<size_t> order;
+  order.reserve(allocs_.size());
+  for (size_t i = 0; i < allocs_.size(); ++i) {
+    if (allocs_[i].block_.size_ > 0) {
+      order.push_back(i);
+    }
+  }
+
+  // largest first, and in trace order for equal sizes so the result is deterministic
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    if (allocs_[a].block_.size_ != allocs_[b].block_.size_) {
+      return allocs_[a].block_.size_ > allocs_[b].block_.size_;
+    }
+    return allocs_[a].alloc_step_ < allocs_[b].alloc_step_;
+  });
+
+  auto overlapping_lifetimes = [this](size_t a, size_t b) {
+    return allocs_[a].alloc_step_ < allocs_[b].free_step_ && allocs_[b].alloc_step_ < allocs_[a].free_step_;
+  };
+
+  std::vector<size_t> offsets(allocs_.size(), 0);
+  // the placed allocations, sorted in order of their offset
+  std::vector<size_t> placed;
+  placed.reserve(order.size());
+  SafeInt<size_t> peak_size = 0;
+
+  for (size_t index : order) {
+    const size_t size = allocs_[index].block_.size_;
+
+    size_t current = 0;
+    size_t waste_bytes = std::numeric_limits<size_t>::max();
+    size_t best_offset = 0;
+    bool best_offset_found = false;
+
+    for (size_t other : placed) {
+      if (!overlapping_lifetimes(index, other)) {
+        continue;
+      }
+
+      if (offsets[other] >= current) {
+        const size_t gap = offsets[other] - current;
+        if (gap >= size && (gap - size) < waste_bytes) {
+          waste_bytes = gap - size;
+          best_offset = current;
+          best_offset_found = true;
+        }
+      }
+
+      current = std::max(current, offsets[other] + allocs_[other].block_.size_);
+    }
+
+    if (!best_offset_found) {
+      best_offset = current;
+    }
+
+    offsets[index] = best_offset;
+    peak_size = std::max(peak_size, SafeInt<size_t>(best_offset) + size);
+
+    auto position = std::upper_bound(placed.begin(), placed.end(), best_offset,
+                                     [&offsets](size_t offset, size_t other) { return offset < offsets[other]; });
+    placed.insert(position, index);
+  }
+
+  if (static_cast<size_t>(peak_size) >= static_cast<size_t>(buffer_size_)) {
+    return false;
+  }
+
+  pattern.peak_size_ = peak_size;
+  for (size_t i = 0; i < allocs_.size(); ++i) {
+    pattern.patterns_[allocs_[i].index_] = MemoryBlock(offsets[i], allocs_[i].block_.size_);
+  }
+
+  return true;
+}
+
+}  // namespace onnxruntime
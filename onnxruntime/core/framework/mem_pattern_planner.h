@@ -16,6 +16,7 @@ limitations under the License.
 // Licensed under the MIT License.
 
 #pragma once
+#include <limits>
 #include <list>
 #include "core/common/safeint.h"
 #include "core/framework/mem_pattern.h"
@@ -29,8 +30,11 @@ namespace onnxruntime {
 // Thread-safe.
 class MemPatternPlanner {
  public:
-  // only the Training code currently uses the program counter based logic
-  MemPatternPlanner(bool using_counters) : using_counters_{using_counters} {}
+  // only the Training code currently uses the program counter based logic.
+  // if pack_lifetimes is true, GenerateMemPattern also assigns the offsets once all the allocations and frees
+  // of the iteration are known, and uses them if the peak is lower than with the offsets assigned while tracing.
+  MemPatternPlanner(bool using_counters, bool pack_lifetimes = false)
+      : using_counters_{using_counters}, pack_lifetimes_{pack_lifetimes} {}
 
 #ifdef ENABLE_TRAINING
   // TODO: OverlappingTimeSchedules should be private
@@ -175,6 +179,7 @@ class MemPatternPlanner {
     // the maximum size of the buffer.
     buffer_size_ = std::max(buffer_size_, SafeInt<size_t>(best_offset) + size);
     allocs_.emplace_back(ml_value_idx, MemoryBlock(best_offset, size));
+    allocs_.back().alloc_step_ = trace_step_++;
     std::list<int>::iterator best_fit_it = blocks_.end();
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].block_.offset_ < best_offset)
@@ -194,6 +199,7 @@ class MemPatternPlanner {
 
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].index_ == ml_value_index) {
+        allocs_[*it].free_step_ = trace_step_++;
         blocks_.erase(it);
         break;
       }
@@ -234,6 +240,10 @@ class MemPatternPlanner {
 #endif
 
     MemoryPattern pattern;
+    if (pack_lifetimes_ && !using_counters_ && PackLifetimes(pattern)) {
+      return pattern;
+    }
+
     pattern.peak_size_ = buffer_size_;
     for (auto& alloc : allocs_) {
       pattern.patterns_[alloc.index_] = alloc.block_;
@@ -243,11 +253,20 @@ class MemPatternPlanner {
   }
 
  private:
+  // Assigns the offsets of the traced allocations as a whole, treating each one as an interval of trace steps
+  // (from its allocation to its free) with a size. The allocations are placed largest first, each one at the
+  // best fitting gap between the already placed allocations whose lifetimes overlap with it. Returns false,
+  // leaving the pattern untouched, if this does not lower the peak of the offsets assigned while tracing.
+  bool PackLifetimes(MemoryPattern& pattern) const;
+
   struct OrtValueAllocationBlock {
     int index_{-1};
     MemoryBlock block_;
     const AllocPlanPerValue::ProgramCounter* counter_{nullptr};
     bool reuse_{false};
+    // trace steps of the allocation and of the free, which is never if the value is not freed in the iteration
+    size_t alloc_step_{0};
+    size_t free_step_{std::numeric_limits<size_t>::max()};
     OrtValueAllocationBlock() = default;
     OrtValueAllocationBlock(int index, const MemoryBlock& block) : index_(index), block_(block), reuse_{false} {}
     OrtValueAllocationBlock(int index, const AllocPlanPerValue::ProgramCounter& counter, const MemoryBlock& block)
@@ -259,7 +278,9 @@ class MemPatternPlanner {
   // blocks_ the list of currently allocated memory blocks, sorted in order of their offset
   std::list<int> blocks_;
   SafeInt<size_t> buffer_size_{0};
+  size_t trace_step_{0};
   bool using_counters_;
+  bool pack_lifetimes_;
   mutable OrtMutex lock_;
 };
 
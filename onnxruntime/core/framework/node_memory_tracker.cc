@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_memory_tracker.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/framework/ort_value_name_idx_map.h"
+
+namespace onnxruntime {
+
+template <typename T>
+static T& GetLocationStats(std::vector<std::pair<std::string, T>>& locations, const std::string& location) {
+  auto it = std::find_if(locations.begin(), locations.end(),
+                         [&location](const std::pair<std::string, T>& entry) { return entry.first == location; });
+  if (it == locations.end()) {
+    locations.emplace_back(location, T{});
+    return locations.back().second;
+  }
+  return it->second;
+}
+
+void NodeMemoryTracker::BeginNode(const std::string& node_name) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  current_node_ = node_name;
+  for (auto& entry : locations_) {
+    entry.second.planned_bytes = 0;
+    entry.second.dynamic_bytes = 0;
+    entry.second.freed_bytes = 0;
+  }
+}
+
+void NodeMemoryTracker::Allocate(int ort_value_idx, const std::string& location, size_t size, bool planned) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  // a value of a subgraph executed repeatedly by the same frame may be allocated again
+  FreeLocked(ort_value_idx);
+
+  auto& stats = GetLocationStats(locations_, location);
+  (planned ? stats.planned_bytes : stats.dynamic_bytes) += size;
+  stats.live_bytes += size;
+  live_values_[ort_value_idx] = Allocation{location, size, planned, current_node_};
+
+  if (stats.live_bytes > stats.peak_bytes) {
+    stats.peak_bytes = stats.live_bytes;
+    stats.peak_values.clear();
+    for (const auto& value : live_values_) {
+      if (value.second.location == location) {
+        stats.peak_values.emplace_back(value.first, value.second);
+      }
+    }
+  }
+}
+
+void NodeMemoryTracker::Free(int ort_value_idx) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  FreeLocked(ort_value_idx);
+}
+
+void NodeMemoryTracker::FreeLocked(int ort_value_idx) {
+  auto it = live_values_.find(ort_value_idx);
+  if (it == live_values_.end()) {
+    return;
+  }
+
+  auto& stats = GetLocationStats(locations_, it->second.location);
+  stats.freed_bytes += it->second.size;
+  stats.live_bytes -= it->second.size;
+  live_values_.erase(it);
+}
+
+std::string NodeMemoryTracker::EndNode() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  std::ostringstream ss;
+  ss << "{";
+  for (size_t i = 0; i < locations_.size(); ++i) {
+    const auto& stats = locations_[i].second;
+    ss << (i == 0 ? "" : ",") << "\"" << locations_[i].first << "\":{"
+       << "\"planned_bytes\":" << stats.planned_bytes << ","
+       << "\"dynamic_bytes\":" << stats.dynamic_bytes << ","
+       << "\"freed_bytes\":" << stats.freed_bytes << ","
+       << "\"live_bytes\":" << stats.live_bytes << "}";
+  }
+  ss << "}";
+  current_node_.clear();
+  return ss.str();
+}
+
+std::string NodeMemoryTracker::PeakReport(const OrtValueNameIdxMap& ort_value_name_idx_map) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  std::ostringstream ss;
+  ss << "{";
+  for (size_t i = 0; i < locations_.size(); ++i) {
+    const auto& stats = locations_[i].second;
+
+    // largest tensors first
+    auto peak_values = stats.peak_values;
+    std::sort(peak_values.begin(), peak_values.end(),
+              [](const std::pair<int, Allocation>& a, const std::pair<int, Allocation>& b) {
+                return a.second.size > b.second.size || (a.second.size == b.second.size && a.first < b.first);
+              });
+
+    ss << (i == 0 ? "" : ",") << "\"" << locations_[i].first << "\":{"
+       << "\"peak_bytes\":" << stats.peak_bytes << ","
+       << "\"live_tensors\":{";
+    for (size_t j = 0; j < peak_values.size(); ++j) {
+      std::string name;
+      if (!ort_value_name_idx_map.GetName(peak_values[j].first, name).IsOK()) {
+        name = std::to_string(peak_values[j].first);
+      }
+      const auto& allocation = peak_values[j].second;
+      ss << (j == 0 ? "" : ",") << "\"" << name << "\":{"
+         << "\"bytes\":" << allocation.size << ","
+         << "\"planned\":" << (allocation.planned ? "true" : "false") << ","
+         << "\"producer\":\"" << allocation.producer << "\"}";
+    }
+    ss << "}}";
+  }
+  ss << "}";
+  return ss.str();
+}
+
+void NodeMemoryTracker::Reset() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  current_node_.clear();
+  live_values_.clear();
+  locations_.clear();
+}
+
+}  // namespace onnxruntime
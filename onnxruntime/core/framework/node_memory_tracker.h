@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class OrtValueNameIdxMap;
+
+// NodeMemoryTracker attributes the tensors allocated by an execution frame to the node being executed, for the
+// memory profiling mode of the session profiler (kOrtSessionOptionsConfigProfileMemory).
+// For each location it counts the bytes placed in the buffers of a memory pattern (planned) and the bytes allocated
+// otherwise (dynamic), the bytes freed and the bytes live, and remembers the tensors live at the peak.
+// Only the tensors created by the frame are tracked, the feeds and initializers are not.
+// Thread-safe.
+class NodeMemoryTracker {
+ public:
+  NodeMemoryTracker() = default;
+
+  // Attribute the following allocations and frees to the named node.
+  void BeginNode(const std::string& node_name);
+
+  void Allocate(int ort_value_idx, const std::string& location, size_t size, bool planned);
+
+  // Does nothing if the value was not allocated by Allocate.
+  void Free(int ort_value_idx);
+
+  // Return the bytes allocated and freed since BeginNode and the bytes live after them, per location, as a JSON
+  // object: {"<location>":{"planned_bytes":..,"dynamic_bytes":..,"freed_bytes":..,"live_bytes":..},...}
+  std::string EndNode();
+
+  // Return the peak of the live bytes of each location and the tensors live at that point as a JSON object:
+  // {"<location>":{"peak_bytes":..,"live_tensors":{"<name>":{"bytes":..,"planned":..,"producer":"<node>"},...}},...}
+  std::string PeakReport(const OrtValueNameIdxMap& ort_value_name_idx_map) const;
+
+  // Forget all the values and counters, for the next execution.
+  void Reset();
+
+ private:
+  struct Allocation {
+    std::string location;
+    size_t size;
+    bool planned;
+    std::string producer;
+  };
+
+  struct LocationStats {
+    size_t planned_bytes = 0;
+    size_t dynamic_bytes = 0;
+    size_t freed_bytes = 0;
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+    // the values live at the peak, with their allocations as they may be freed since
+    std::vector<std::pair<int, Allocation>> peak_values;
+  };
+
+  void FreeLocked(int ort_value_idx);
+
+  mutable OrtMutex mutex_;
+  std::string current_node_;
+  std::unordered_map<int, Allocation> live_values_;
+  // ordered by first use so the report is stable
+  std::vector<std::pair<std::string, LocationStats>> locations_;
+};
+
+}  // namespace onnxruntime
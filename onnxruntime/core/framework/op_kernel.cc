@@ -151,6 +151,10 @@ int OpKernelContext::GetOutputArgIndex(int index) const {
   return node_output_start_index_ + index;
 }
 
+int OpKernelContext::GetExecQueueId() const {
+  return kernel_->KernelDef().ExecQueueId();
+}
+
 onnxruntime::NodeIndex OpKernelContext::GetNodeIndex() const {
   return kernel_->Node().Index();
 }
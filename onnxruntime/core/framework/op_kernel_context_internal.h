@@ -5,6 +5,7 @@
 
 #include <functional>
 #include "core/framework/op_kernel.h"
+#include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
 #include "core/session/onnxruntime_c_api.h"
 
@@ -41,6 +42,12 @@ class OpKernelContextInternal : public OpKernelContext {
     return session_state_.GetUseDeterministicCompute();
   }
 
+  int GetExecQueueId() const override {
+    const auto* plan = session_state_.GetExecutionPlan();
+    return plan ? plan->NodeExecQueueId(GetNodeIndex(), OpKernelContext::GetExecQueueId())
+                : OpKernelContext::GetExecQueueId();
+  }
+
   const SessionState* SubgraphSessionState(const std::string& attribute_name) {
     return session_state_.GetSubgraphSessionState(GetNodeIndex(), attribute_name);
   }
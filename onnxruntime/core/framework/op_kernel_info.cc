@@ -14,7 +14,8 @@ OpKernelInfo::OpKernelInfo(const onnxruntime::Node& node,
                            const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                            const OrtValueNameIdxMap& ort_value_name_idx_map,
                            const FuncManager& funcs_mgr,
-                           const DataTransferManager& data_transfer_mgr)
+                           const DataTransferManager& data_transfer_mgr,
+                           const ConfigOptions* config_options)
     : OpNodeProtoHelper(&proto_helper_context_),
       node_(node),
       kernel_def_(kernel_def),
@@ -23,6 +24,7 @@ OpKernelInfo::OpKernelInfo(const onnxruntime::Node& node,
       ort_value_name_idx_map_(ort_value_name_idx_map),
       funcs_mgr_(funcs_mgr),
       data_transfer_mgr_(data_transfer_mgr),
+      config_options_(config_options),
       proto_helper_context_(node) {}
 
 OpKernelInfo::OpKernelInfo(const OpKernelInfo& other)
@@ -55,6 +57,11 @@ const onnxruntime::Node& OpKernelInfo::node() const noexcept {
   return node_;
 }
 
+const ConfigOptions& OpKernelInfo::GetConfigOptions() const noexcept {
+  static const ConfigOptions empty_config_options;
+  return config_options_ != nullptr ? *config_options_ : empty_config_options;
+}
+
 bool OpKernelInfo::TryGetConstantInput(int input_index, const Tensor** constant_input_value) const {
   if (input_index < 0 || input_index >= gsl::narrow_cast<int>(node_.InputDefs().size())) {
     return false;
@@ -226,6 +226,11 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
       continue;
     }
 
+    // the subgraphs may be finalized on first use, see kOrtSessionOptionsConfigLazySubgraphInitialization
+    if (node.ContainsSubgraph()) {
+      ORT_RETURN_IF_ERROR(session_state.FinalizeDeferredSubgraphSessionStates(node_index));
+    }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
     LARGE_INTEGER kernel_start;
     QueryPerformanceCounter(&kernel_start);
@@ -239,7 +244,7 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
     }
 
     // sync before compute
-    int queue_id = p_op_kernel->KernelDef().ExecQueueId();
+    int queue_id = seq_exec_plan.NodeExecQueueId(node_index, p_op_kernel->KernelDef().ExecQueueId());
     if (seq_exec_plan.NodeHasFence(node_index)) {
       for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
         Fence_t fence = op_kernel_context.InputFence(input_index);
@@ -289,6 +294,7 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
       // call compute on the kernel
       VLOGS(logger, 1) << "Computing kernel: " << node_name_for_profiling;
 
+      session_state.Profiler().StartDeviceCorrelation(node_name_for_profiling);
       kernel_begin_time = session_state.Profiler().Now();
 
       // Calculate total input sizes for this operation.
@@ -325,6 +331,10 @@ Status PartialExecutor::Execute(const SessionState& session_state, const std::ve
 #endif
     }
 
+    if (is_profiler_enabled) {
+      session_state.Profiler().EndDeviceCorrelation();
+    }
+
     if (!compute_status.IsOK()) {
       std::ostringstream ss;
       ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
@@ -3,6 +3,7 @@
 
 #include "core/framework/parallel_executor.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -19,11 +20,20 @@
 namespace onnxruntime {
 
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
-  const auto& graph_viewer = session_state.GetGraphViewer();
-  node_refs_.resize(graph_viewer.MaxNodeIndex());
-  for (auto& node : graph_viewer.Nodes()) {
-    node_refs_[node.Index()] = node.GetInputEdgesCount();
+    : out_standings_(0),
+      has_errors_(false),
+      terminate_flag_(terminate_flag),
+      executor_pool_(session_state.GetInterOpThreadPool()) {
+  const auto& node_dependency_counts = session_state.GetExecutionPlan()->node_dependency_counts;
+  ORT_ENFORCE(node_dependency_counts.size() == session_state.GetGraphViewer().MaxNodeIndex(),
+              "The execution plan was not created for parallel execution.");
+
+  node_refs_ = std::make_unique<std::atomic<int>[]>(node_dependency_counts.size());
+  for (size_t i = 0, end = node_dependency_counts.size(); i < end; ++i) {
+    node_refs_[i].store(node_dependency_counts[i], std::memory_order_relaxed);
+  }
+  if (session_state.Profiler().ThreadPoolTaskTracingEnabled()) {
+    node_ready_ = std::make_unique<NodeReady[]>(node_dependency_counts.size());
   }
 }
 
@@ -40,20 +50,21 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
 
   root_frame_ = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                          fetch_allocators, session_state);
-  //std::cout << "start nodes:" << std::endl;
-  for (auto node_index : session_state.GetGraphViewer().GetRootNodes()) {
+  for (auto node_index : session_state.GetExecutionPlan()->parallel_root_nodes) {
     auto p_op_kernel = session_state.GetKernel(node_index);
     if (!p_op_kernel)
       continue;
 
-    //std::cout << "\t" << p_op_kernel->Node().Name() << std::endl;
+    if (node_ready_) {
+      node_ready_[node_index].time = tp;
+    }
     EnqueueNode(node_index, session_state, logger);
   }
 
   // Wait for finish.
   {
     std::unique_lock<OrtMutex> lock(complete_mutex_);
-    while (out_standings_ > 0) complete_cv_.wait(lock);
+    while (out_standings_.load(std::memory_order_acquire) > 0) complete_cv_.wait(lock);
   }
 
   Status status = Status::OK();
@@ -120,6 +131,7 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time, kernel_end_time;
   const bool f_profiler_enabled = session_state.Profiler().IsEnabled();
+  const bool trace_tasks = f_profiler_enabled && node_ready_ != nullptr;
   const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
 
   // Avoid context switching if possible.
@@ -139,6 +151,11 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       ORT_THROW("Got nullptr from GetKernel for node: ", node.Name());
     }
 
+    // the subgraphs may be finalized on first use, see kOrtSessionOptionsConfigLazySubgraphInitialization
+    if (node.ContainsSubgraph()) {
+      ORT_THROW_IF_ERROR(session_state.FinalizeDeferredSubgraphSessionStates(node_index));
+    }
+
     OpKernelContextInternal op_kernel_context(session_state, *root_frame_, *p_op_kernel, logger, terminate_flag_);
 
     if (f_profiler_enabled) {
@@ -182,7 +199,8 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
                                                      node.Name() + "_fence_before",
                                                      sync_time_begin,
                                                      {{"op_name", p_op_kernel->KernelDef().OpName()}});
-      concurrency::ThreadPool::StartProfiling(session_state.GetThreadPool());
+      concurrency::ThreadPool::StartProfiling(session_state.GetThreadPool(), false, trace_tasks);
+      session_state.Profiler().StartDeviceCorrelation(node.Name());
       kernel_begin_time = session_state.Profiler().Now();
     }
 
@@ -205,6 +223,10 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       });
     }
 
+    if (f_profiler_enabled) {
+      session_state.Profiler().EndDeviceCorrelation();
+    }
+
     if (!status.IsOK()) {
       std::ostringstream ss;
       ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
@@ -217,12 +239,28 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
 
     if (f_profiler_enabled) {
       kernel_end_time = session_state.Profiler().Now();
+      std::vector<concurrency::ThreadPoolTaskRecord> thread_pool_tasks;
+      std::unordered_map<std::string, std::string> event_args = {
+          {"op_name", p_op_kernel->KernelDef().OpName()},
+          {"provider", p_op_kernel->KernelDef().Provider()},
+          {"thread_scheduling_stats",
+           concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool(), &thread_pool_tasks)}};
+      if (trace_tasks) {
+        const NodeReady& ready = node_ready_[node_index];
+        event_args.emplace("ready_time_us", std::to_string(TimeDiffMicroSeconds(ready.time, kernel_begin_time)));
+      }
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      node.Name() + "_kernel_time",
                                                      kernel_begin_time, kernel_end_time,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()},
-                                                      {"provider", p_op_kernel->KernelDef().Provider()},
-                                                      {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())}});
+                                                     std::move(event_args));
+      if (trace_tasks) {
+        const NodeReady& ready = node_ready_[node_index];
+        if (ready.thread_id != -1) {
+          session_state.Profiler().RecordFlow(ready.thread_id, ready.upstream_end_time,
+                                              static_cast<int>(logging::GetThreadId()), kernel_begin_time);
+        }
+        session_state.Profiler().RecordThreadPoolTasks(node.Name(), thread_pool_tasks);
+      }
 
       sync_time_begin = session_state.Profiler().Now();
     }
@@ -260,42 +298,43 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
 
     keep_running = false;
 
-    // Checking which output nodes ready for running.
-    {
-      auto begin = node.OutputEdgesBegin();
-      auto end = node.OutputEdgesEnd();
-
-      std::lock_guard<OrtMutex> lock(ref_mutex_);
-      for (auto it = begin; it != end; it++) {
-        auto idx = (*it).GetNode().Index();
-        if ((--node_refs_[idx]) == 0) {
-          if (!keep_running) {
-            node_index = idx;
-            keep_running = true;
-          } else {
-            EnqueueNode(idx, session_state, logger);
-          }
+    // Checking which downstream nodes are ready for running.
+    // The first ready node is run inline on this thread as a continuation; the rest are scheduled so
+    // idle inter-op threads can pick them up.
+    for (auto idx : exec_plan.node_downstream_nodes[node_index]) {
+      if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (trace_tasks) {
+          // the flow starts inside the kernel event of this node, which the viewers bind it to
+          NodeReady& ready = node_ready_[idx];
+          ready.thread_id = static_cast<int>(logging::GetThreadId());
+          ready.time = session_state.Profiler().Now();
+          ready.upstream_end_time = std::max<TimePoint>(kernel_begin_time,
+                                                        kernel_end_time - std::chrono::microseconds(1));
+        }
+        if (!keep_running) {
+          node_index = idx;
+          keep_running = true;
+        } else {
+          EnqueueNode(idx, session_state, logger);
         }
-
-        // std::cout << "handle output, current name: " << node.Name() << ", current index: "
-        // << p_node_index << ", output name: " << (*it)->GetNode().Name() << ", output index: "
-        // << (*it)->GetNode().Index() << ", after -- output ref: " << node_refs_[idx] << std::endl;
       }
     }
+
+    // stop the continuation chain early if another node failed
+    if (keep_running && has_errors_.load(std::memory_order_relaxed)) {
+      keep_running = false;
+    }
   }
 
   return status;
 }
 
 void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
-  {
-    std::unique_lock<OrtMutex> lock(complete_mutex_);
-    // if there are errors there's no point queuing more work
-    if (!errors_.empty())
-      return;
+  // if there are errors there's no point queuing more work
+  if (has_errors_.load(std::memory_order_relaxed))
+    return;
 
-    out_standings_++;
-  }
+  out_standings_.fetch_add(1, std::memory_order_relaxed);
 
   onnxruntime::concurrency::ThreadPool::Schedule(executor_pool_, [this, p_node_index, &session_state, &logger]() {
     auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -36,28 +37,37 @@ class ParallelExecutor : public IExecutor {
   void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
   void FinishNodeRun(const Status& status) {
-    bool finished = false;
-    {
-      //Because we have a mutex here, it's not possible another thread is doing the test("while (out_standings_ > 0)"
-      std::lock_guard<OrtMutex> lock(complete_mutex_);
-      finished = --out_standings_ == 0;
-      if (!status.IsOK())
-        errors_.push_back(status);
+    if (!status.IsOK()) {
+      std::lock_guard<OrtMutex> lock(error_mutex_);
+      errors_.push_back(status);
+      has_errors_.store(true, std::memory_order_relaxed);
     }
 
-    if (finished) {
-      //std::cout << "all out standing nodes are completed." << std::endl;
+    if (out_standings_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      // take the mutex so the notification can't be lost between the waiter's check and its wait
+      std::lock_guard<OrtMutex> lock(complete_mutex_);
       complete_cv_.notify_all();
     }
   }
 
   std::unique_ptr<ExecutionFrame> root_frame_;
-  std::vector<size_t> node_refs_;
-  OrtMutex ref_mutex_;
-  int out_standings_;  //protected by complete_mutex_
+  // number of upstream nodes still to complete for each node, indexed by node index.
+  // decremented lock-free by the thread that completes an upstream node.
+  std::unique_ptr<std::atomic<int>[]> node_refs_;
+  // when each node was made ready and by which thread, only while tracing the thread pool tasks, see
+  // profiling::Profiler::EnableThreadPoolTaskTracing. Written by the thread making the node ready.
+  struct NodeReady {
+    int thread_id = -1;  // -1 for the root nodes
+    TimePoint time;
+    TimePoint upstream_end_time;
+  };
+  std::unique_ptr<NodeReady[]> node_ready_;
+  std::atomic<int> out_standings_;
   OrtMutex complete_mutex_;
   OrtCondVar complete_cv_;
-  std::vector<Status> errors_;
+  std::atomic<bool> has_errors_;
+  OrtMutex error_mutex_;
+  std::vector<Status> errors_;  // protected by error_mutex_
 
   const bool& terminate_flag_;
   // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
@@ -0,0 +1,348 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/framework/partitioning_cost_model.h"
+
+#include <algorithm>
+#include <queue>
+#include <unordered_set>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/data_types.h"
+#include "core/graph/constants.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool TryGetElementCount(const NodeArg& arg, double& count) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  count = 1.0;
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value() || dim.dim_value() < 0) {
+      return false;
+    }
+
+    count *= static_cast<double>(dim.dim_value());
+  }
+
+  return true;
+}
+
+bool TryGetTensorBytes(const NodeArg& arg, double& bytes) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() ||
+      type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+    return false;
+  }
+
+  double count;
+  if (!TryGetElementCount(arg, count)) {
+    return false;
+  }
+
+  bytes = count * static_cast<double>(DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())
+                                          ->GetElementType()
+                                          ->Size());
+  return true;
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto& attributes = node.GetAttributes();
+  auto entry = attributes.find(name);
+  return entry != attributes.cend() && entry->second.has_i() ? entry->second.i() : default_value;
+}
+
+// Estimate the floating point operations of the compute bound operators. Returns false if the node is compute bound
+// but the estimate is not possible, and sets flops to 0 for memory bound operators.
+bool TryGetFlops(const Node& node, double& flops) {
+  flops = 0.0;
+
+  const auto& op_type = node.OpType();
+  const auto& inputs = node.InputDefs();
+  const auto& outputs = node.OutputDefs();
+
+  static const std::unordered_set<std::string> unsupported_compute_bound_ops{
+      "LSTM", "GRU", "RNN", "Attention", "Einsum", "MatMulInteger", "ConvInteger", "QLinearConv", "QLinearMatMul",
+      "DynamicQuantizeMatMul", "MatMulIntegerToFloat", "Loop", "Scan", "If"};
+
+  if (unsupported_compute_bound_ops.count(op_type) != 0) {
+    return false;
+  }
+
+  double output_elements;
+  if (op_type == "MatMul" || op_type == "FusedMatMul" || op_type == "Gemm") {
+    const auto* shape = inputs[0]->Shape();
+    if (shape == nullptr || shape->dim_size() == 0 || !TryGetElementCount(*outputs[0], output_elements)) {
+      return false;
+    }
+
+    int k_axis = shape->dim_size() - 1;
+    if (op_type == "Gemm" && GetIntAttribute(node, "transA", 0) != 0) {
+      k_axis = 0;
+    } else if (op_type == "FusedMatMul" && GetIntAttribute(node, "transA", 0) != 0 && shape->dim_size() >= 2) {
+      k_axis = shape->dim_size() - 2;
+    }
+
+    const auto& k_dim = shape->dim(k_axis);
+    if (!k_dim.has_dim_value()) {
+      return false;
+    }
+
+    flops = 2.0 * output_elements * static_cast<double>(k_dim.dim_value());
+  } else if (op_type == "Conv" || op_type == "FusedConv" || op_type == "ConvTranspose") {
+    // each output (input for ConvTranspose) value is combined with one filter of the weights
+    const auto* weight_shape = inputs.size() > 1 ? inputs[1]->Shape() : nullptr;
+    double weight_elements;
+    if (weight_shape == nullptr || weight_shape->dim_size() == 0 || !weight_shape->dim(0).has_dim_value() ||
+        weight_shape->dim(0).dim_value() == 0 || !TryGetElementCount(*inputs[1], weight_elements)) {
+      return false;
+    }
+
+    double elements;
+    if (!TryGetElementCount(op_type == "ConvTranspose" ? *inputs[0] : *outputs[0], elements)) {
+      return false;
+    }
+
+    flops = 2.0 * elements * weight_elements / static_cast<double>(weight_shape->dim(0).dim_value());
+  }
+
+  return true;
+}
+
+// The execution time of a node on CPU and on the device.
+bool TryEstimateNodeCost(const Node& node, const PartitioningCostModel& cost_model, double& cpu_us,
+                         double& device_us) {
+  double flops;
+  if (!TryGetFlops(node, flops)) {
+    return false;
+  }
+
+  double bytes = 0.0;
+  for (const auto* defs : {&node.InputDefs(), &node.OutputDefs()}) {
+    for (const auto* arg : *defs) {
+      if (!arg->Exists()) {
+        continue;
+      }
+
+      double arg_bytes;
+      if (!TryGetTensorBytes(*arg, arg_bytes)) {
+        return false;
+      }
+
+      bytes += arg_bytes;
+    }
+  }
+
+  cpu_us = cost_model.cpu_overhead_us +
+           std::max(flops / cost_model.cpu_flops_per_us, bytes / cost_model.cpu_bytes_per_us);
+  device_us = cost_model.device_launch_us +
+              std::max(flops / cost_model.device_flops_per_us, bytes / cost_model.device_bytes_per_us);
+  return true;
+}
+
+bool IsCpu(const std::string& provider_type) {
+  return provider_type.empty() || provider_type == kCpuExecutionProvider;
+}
+
+class IslandCostEstimator {
+ public:
+  IslandCostEstimator(const GraphViewer& graph, const PartitioningCostModel& cost_model)
+      : graph_(graph), cost_model_(cost_model) {
+    for (const auto* input : graph.GetInputs()) {
+      graph_inputs_.insert(input);
+    }
+
+    for (const auto* output : graph.GetOutputs()) {
+      graph_outputs_.insert(output);
+    }
+  }
+
+  // Returns true if the island is cheaper on CPU than on its device.
+  bool IsCheaperOnCpu(const std::vector<const Node*>& island) const {
+    const std::string& provider_type = island.front()->GetExecutionProviderType();
+    std::unordered_set<NodeIndex> island_nodes;
+    for (const auto* node : island) {
+      island_nodes.insert(node->Index());
+    }
+
+    double cpu_us = 0.0;
+    double device_us = 0.0;
+
+    for (const auto* node : island) {
+      double node_cpu_us;
+      double node_device_us;
+      if (!TryEstimateNodeCost(*node, cost_model_, node_cpu_us, node_device_us)) {
+        return false;
+      }
+
+      cpu_us += node_cpu_us;
+      device_us += node_device_us;
+    }
+
+    // the copies of the values read by the island. a value read by several nodes is only copied once.
+    std::unordered_set<const NodeArg*> inputs;
+    for (const auto* node : island) {
+      for (const auto* arg : node->InputDefs()) {
+        if (!arg->Exists() || !inputs.insert(arg).second) {
+          continue;
+        }
+
+        const Node* producer = graph_.GetProducerNode(arg->Name());
+        if (producer != nullptr && island_nodes.count(producer->Index()) != 0) {
+          continue;
+        }
+
+        std::string source_provider_type;
+        if (producer != nullptr) {
+          source_provider_type = producer->GetExecutionProviderType();
+        } else if (graph_inputs_.count(arg) == 0) {
+          // an initializer is copied to the device once when the session is created
+          continue;
+        }
+
+        double copy_us;
+        if (!TryEstimateCopyCost(*arg, copy_us)) {
+          return false;
+        }
+
+        AddCopyCost(source_provider_type, provider_type, copy_us, cpu_us, device_us);
+      }
+    }
+
+    // the copies of the values written by the island, for each device they are read on
+    for (const auto* node : island) {
+      for (const auto* arg : node->OutputDefs()) {
+        if (!arg->Exists()) {
+          continue;
+        }
+
+        std::unordered_set<std::string> target_provider_types;
+        for (const auto* consumer : graph_.GetConsumerNodes(arg->Name())) {
+          if (island_nodes.count(consumer->Index()) == 0) {
+            target_provider_types.insert(IsCpu(consumer->GetExecutionProviderType())
+                                             ? kCpuExecutionProvider
+                                             : consumer->GetExecutionProviderType());
+          }
+        }
+
+        if (graph_outputs_.count(arg) != 0) {
+          target_provider_types.insert(kCpuExecutionProvider);
+        }
+
+        if (target_provider_types.empty()) {
+          continue;
+        }
+
+        double copy_us;
+        if (!TryEstimateCopyCost(*arg, copy_us)) {
+          return false;
+        }
+
+        for (const auto& target_provider_type : target_provider_types) {
+          AddCopyCost(target_provider_type, provider_type, copy_us, cpu_us, device_us);
+        }
+      }
+    }
+
+    return cpu_us < device_us;
+  }
+
+ private:
+  bool TryEstimateCopyCost(const NodeArg& arg, double& copy_us) const {
+    double bytes;
+    if (!TryGetTensorBytes(arg, bytes)) {
+      return false;
+    }
+
+    copy_us = cost_model_.copy_latency_us + bytes / cost_model_.copy_bytes_per_us;
+    return true;
+  }
+
+  // add the cost of exchanging a value with a neighbour on 'other_provider_type', for the island running on CPU and
+  // on 'island_provider_type'
+  static void AddCopyCost(const std::string& other_provider_type, const std::string& island_provider_type,
+                          double copy_us, double& cpu_us, double& device_us) {
+    if (!IsCpu(other_provider_type)) {
+      cpu_us += copy_us;
+    }
+
+    if (other_provider_type != island_provider_type) {
+      device_us += copy_us;
+    }
+  }
+
+  const GraphViewer& graph_;
+  const PartitioningCostModel& cost_model_;
+  std::unordered_set<const NodeArg*> graph_inputs_;
+  std::unordered_set<const NodeArg*> graph_outputs_;
+};
+
+}  // namespace
+
+std::vector<NodeIndex> GetIslandsCheaperOnCpu(const GraphViewer& graph, const PartitioningCostModel& cost_model,
+                                              const std::function<bool(const Node&)>& can_run_on_cpu) {
+  std::vector<NodeIndex> cpu_nodes;
+  std::unordered_set<NodeIndex> visited;
+  IslandCostEstimator estimator(graph, cost_model);
+
+  for (auto node_index : graph.GetNodesInTopologicalOrder()) {
+    const Node* start = graph.GetNode(node_index);
+    if (start == nullptr || visited.count(node_index) != 0 || IsCpu(start->GetExecutionProviderType())) {
+      continue;
+    }
+
+    // collect the nodes connected to 'start' that are assigned to the same execution provider
+    const std::string& provider_type = start->GetExecutionProviderType();
+    std::vector<const Node*> island;
+    bool movable = true;
+
+    std::queue<const Node*> to_visit;
+    to_visit.push(start);
+    visited.insert(node_index);
+
+    while (!to_visit.empty()) {
+      const Node* node = to_visit.front();
+      to_visit.pop();
+
+      island.push_back(node);
+      movable = movable && island.size() <= cost_model.max_island_size && !node->ContainsSubgraph() &&
+                node->NodeType() != Node::Type::Fused && can_run_on_cpu(*node);
+
+      auto visit = [&](const Node& neighbour) {
+        if (neighbour.GetExecutionProviderType() == provider_type && visited.insert(neighbour.Index()).second) {
+          to_visit.push(&neighbour);
+        }
+      };
+
+      for (auto it = node->InputNodesBegin(), end = node->InputNodesEnd(); it != end; ++it) {
+        visit(*it);
+      }
+
+      for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); it != end; ++it) {
+        visit(*it);
+      }
+    }
+
+    if (movable && estimator.IsCheaperOnCpu(island)) {
+      for (const auto* node : island) {
+        LOGS_DEFAULT(INFO) << "Cost based partitioning moved node " << node->Name() << " (" << node->OpType()
+                           << ") from " << provider_type << " to CPU as the copies around its island of "
+                           << island.size() << " node(s) cost more than the device saves.";
+        cpu_nodes.push_back(node->Index());
+      }
+    }
+  }
+
+  return cpu_nodes;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <functional>
+#include <vector>
+
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+/**
+  Rough estimates of the execution time of a node on CPU and on a device execution provider, and of the time to copy
+  a tensor between them. The values are deliberately simple: they only need to tell a few small kernels surrounded
+  by copies apart from work that is worth sending to the device.
+  */
+struct PartitioningCostModel {
+  // fixed cost in microseconds of launching a kernel on the device
+  double device_launch_us = 5.0;
+  // fixed cost in microseconds of running a kernel on CPU
+  double cpu_overhead_us = 0.5;
+  // fixed cost in microseconds of a copy between CPU and device, including the synchronization
+  double copy_latency_us = 10.0;
+
+  // throughput in bytes per microsecond of memory bound kernels and of copies
+  double device_bytes_per_us = 200000.0;
+  double cpu_bytes_per_us = 10000.0;
+  double copy_bytes_per_us = 10000.0;
+
+  // throughput in floating point operations per microsecond of compute bound kernels (MatMul, Gemm, Conv)
+  double device_flops_per_us = 5000000.0;
+  double cpu_flops_per_us = 50000.0;
+
+  // only islands of up to this many nodes are considered for moving to CPU
+  size_t max_island_size = 8;
+};
+
+/**
+  Returns the nodes that should be moved from a device execution provider to the CPU execution provider.
+
+  The nodes assigned to the same non-CPU execution provider are grouped into islands of connected nodes. For each
+  small island the cost of running it on the device, including the copies of the values exchanged with CPU nodes,
+  graph inputs and graph outputs, is compared with the cost of running it on CPU, including the copies of the values
+  exchanged with the device nodes. The island is moved if CPU is cheaper.
+
+  Islands are left where they are if the shape of any value they read or write is not known, if a node has no
+  estimate (e.g. an RNN), contains a subgraph, was fused by the execution provider, or if can_run_on_cpu returns false
+  for a node.
+  @param graph Graph viewer with the nodes assigned to execution providers.
+  @param cost_model The cost estimates to use.
+  @param can_run_on_cpu Returns true if the CPU execution provider has a kernel for the node.
+  */
+std::vector<NodeIndex> GetIslandsCheaperOnCpu(const GraphViewer& graph, const PartitioningCostModel& cost_model,
+                                              const std::function<bool(const Node&)>& can_run_on_cpu);
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_container.h"
+
+namespace onnxruntime {
+
+const PrePackedWeights& PrepackedWeightsContainer::GetOrAddWeight(const std::string& key,
+                                                                  PrePackedWeights&& packed_weights,
+                                                                  bool& added) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto result = prepacked_weights_map_.emplace(key, PrePackedWeights());
+  added = result.second;
+  if (added) {
+    result.first->second = std::move(packed_weights);
+  }
+  return result.first->second;
+}
+
+bool PrepackedWeightsContainer::HasWeight(const std::string& key) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return prepacked_weights_map_.find(key) != prepacked_weights_map_.end();
+}
+
+size_t PrepackedWeightsContainer::GetNumberOfElements() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return prepacked_weights_map_.size();
+}
+
+}  // namespace onnxruntime
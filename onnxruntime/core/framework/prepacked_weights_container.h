@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// The buffers created by OpKernel::PrePack for one initializer.
+struct PrePackedWeights {
+  std::vector<BufferUniquePtr> buffers_;
+};
+
+// Holds the buffers created by OpKernel::PrePack so that kernels of different sessions that pack the same
+// initializer in the same way can share a single copy. The container owns the buffers and must outlive the
+// sessions using it. Each key is built by the SessionState from the kernel type, the node attributes and the
+// content of the initializer.
+class PrepackedWeightsContainer final {
+ public:
+  PrepackedWeightsContainer() = default;
+
+  // Stores packed_weights for key unless buffers are stored for key already, and returns the stored buffers.
+  // 'added' is set to true if packed_weights was stored, in which case its buffers are moved out.
+  const PrePackedWeights& GetOrAddWeight(const std::string& key, PrePackedWeights&& packed_weights, bool& added);
+
+  bool HasWeight(const std::string& key) const;
+
+  size_t GetNumberOfElements() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
+
+  mutable OrtMutex mutex_;
+  // references to the entries stay valid when the map is rehashed
+  std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+};
+
+}  // namespace onnxruntime
@@ -58,3 +58,32 @@ ORT_API_STATUS_IMPL(OrtApis::AddRunConfigEntry, _Inout_ OrtRunOptions* options,
                     _In_z_ const char* config_key, _In_z_ const char* config_value) {
   return onnxruntime::ToOrtStatus(options->config_options.AddConfigEntry(config_key, config_value));
 }
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetOutputBuffer, _Inout_ OrtRunOptions* options, _In_z_ const char* output_name,
+                    _In_opt_ void* buffer, size_t buffer_size, _In_opt_ const OrtMemoryInfo* memory_info) {
+  API_IMPL_BEGIN
+  if (output_name == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output_name must not be null");
+  }
+
+  if (buffer == nullptr) {
+    options->output_buffers.erase(output_name);
+    return nullptr;
+  }
+
+  if (memory_info == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "memory_info must not be null when a buffer is set");
+  }
+
+  auto& output_buffer = options->output_buffers[output_name];
+  output_buffer.data = buffer;
+  output_buffer.size = buffer_size;
+  output_buffer.memory_info = *memory_info;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsClearOutputBuffers, _Inout_ OrtRunOptions* options) {
+  options->output_buffers.clear();
+  return nullptr;
+}
@@ -115,9 +115,21 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // Records whether a given node has fence on its input or output, key is node index.
   std::vector<bool> node_has_fence;
 
+  // Exec queue of each node, key is node index. Only populated when an execution provider has more than one
+  // compute queue, in which case independent branches of the graph are assigned to different queues.
+  std::vector<int> node_exec_queue_ids;
+
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<OrtValueIndex> to_be_freed;
 
+  // Static dependency graph used by the ParallelExecutor. Only populated when parallel execution is enabled.
+  // node_dependency_counts[node index] is the number of distinct upstream nodes that must complete before the node
+  // can run, and node_downstream_nodes[node index] are the distinct nodes that consume its outputs.
+  // parallel_root_nodes are the nodes without upstream dependencies, in execution plan order.
+  std::vector<int> node_dependency_counts;
+  std::vector<std::vector<onnxruntime::NodeIndex>> node_downstream_nodes;
+  std::vector<onnxruntime::NodeIndex> parallel_root_nodes;
+
   const OrtMemoryInfo& GetLocation(size_t ort_value_index) const override {
     return allocation_plan[ort_value_index].location;
   }
@@ -138,6 +150,11 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   bool NodeHasFence(onnxruntime::NodeIndex node_index) const {
     return node_has_fence[node_index];
   }
+
+  // Exec queue that a given node runs on. kernel_def_queue_id is the queue id of the node's kernel definition.
+  int NodeExecQueueId(onnxruntime::NodeIndex node_index, int kernel_def_queue_id) const {
+    return node_index < node_exec_queue_ids.size() ? node_exec_queue_ids[node_index] : kernel_def_queue_id;
+  }
 };
 
 // Output details of an execution plan:
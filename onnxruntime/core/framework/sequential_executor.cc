@@ -11,7 +11,9 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/node_memory_tracker.h"
 #include "core/framework/session_state.h"
+#include "core/framework/tensor_calibration_collector.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
 
@@ -119,9 +121,97 @@ static void CalculateTotalInputSizes(const OpKernelContextInternal* op_kernel_co
 
 static Status ReleaseNodeMLValues(ExecutionFrame& frame,
                                   const SequentialExecutionPlan& seq_exec_plan,
-                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const SessionState::ExecutionStep& step,
                                   const logging::Logger& logger);
 
+// Add the outputs of a node to the calibration data.
+static Status CollectCalibrationData(TensorCalibrationCollector& collector, OpKernelContextInternal& op_kernel_context,
+                                     const Node& node, concurrency::ThreadPool* thread_pool) {
+  const auto& output_defs = node.OutputDefs();
+  for (int i = 0; i < op_kernel_context.OutputCount(); ++i) {
+    const OrtValue* value = op_kernel_context.GetOutputMLValue(i);
+    if (value != nullptr && value->IsAllocated() && collector.ShouldCollect(output_defs[i]->Name())) {
+      ORT_RETURN_IF_ERROR(collector.Collect(output_defs[i]->Name(), *value, thread_pool));
+    }
+  }
+
+  return Status::OK();
+}
+
+static Status ComputeErrorStatus(const Node& node, const Status& compute_status, const logging::Logger& logger) {
+  std::ostringstream ss;
+  ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
+     << "' Status Message: " << compute_status.ErrorMessage();
+  //If the computation failed, we still can record the memory consumption
+#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
+  MemoryInfo::MemoryInfoProfile::CreateEvents("dynamic activations_" + std::to_string(MemoryInfo::GetIteration()),
+                                              MemoryInfo::MemoryInfoProfile::GetAndIncreasePid(), MemoryInfo::MapType::DynamicActivation, "", 0);
+#endif
+  const auto msg_string = ss.str();
+  LOGS(logger, ERROR) << msg_string;
+  return Status(compute_status.Category(), compute_status.Code(), msg_string);
+}
+
+// the per node instrumentation is only done by the loop in SequentialExecutor::Execute
+#if defined(CONCURRENCY_VISUALIZER) || defined(ENABLE_NVTX_PROFILE) || defined(ONNXRUNTIME_ENABLE_INSTRUMENT) || \
+    defined(DEBUG_NODE_INPUTS_OUTPUTS)
+static constexpr bool kNodeInstrumentationEnabled = true;
+#else
+static constexpr bool kNodeInstrumentationEnabled = false;
+#endif
+
+// Execute the steps without profiling, fences or instrumentation. This is the common case so it only does the
+// minimum per node.
+static Status ExecuteStepsWithoutProfiling(const SessionState& session_state, ExecutionFrame& frame,
+                                           const std::unordered_set<NodeIndex>* to_be_executed_nodes,
+                                           const bool& terminate_flag, const logging::Logger& logger) {
+  const auto& to_be_freed = session_state.GetExecutionPlan()->to_be_freed;
+
+  for (const auto& step : session_state.GetExecutionSteps()) {
+    if (terminate_flag) {
+      LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    }
+
+    if (to_be_executed_nodes != nullptr && to_be_executed_nodes->count(step.node_index) == 0) {
+      continue;
+    }
+
+    if (step.contains_subgraph) {
+      ORT_RETURN_IF_ERROR(session_state.FinalizeDeferredSubgraphSessionStates(step.node_index));
+    }
+
+    const OpKernel& kernel = *step.kernel;
+    OpKernelContextInternal op_kernel_context(session_state, frame, kernel, logger, terminate_flag);
+
+    Status compute_status;
+    ORT_TRY {
+#ifdef ENABLE_TRAINING
+      if (kernel.KernelDef().AllocateInputsContiguously()) {
+        ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
+      }
+#endif
+
+      compute_status = kernel.Compute(&op_kernel_context);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    if (!compute_status.IsOK()) {
+      return ComputeErrorStatus(kernel.Node(), compute_status, logger);
+    }
+
+    for (auto i = step.free_from_index; i <= step.free_to_index; ++i) {
+      ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(to_be_freed[i]));
+    }
+  }
+
+  return Status::OK();
+}
+
 Status SequentialExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
                                    const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -139,7 +229,21 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     tp = session_state.Profiler().Now();
   }
 
-  ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
+  std::unique_ptr<ExecutionFrame> new_frame;
+  ExecutionFrame* p_frame = nullptr;
+  if (cached_frame_ != nullptr && *cached_frame_ != nullptr && (*cached_frame_)->CanReset(fetch_mlvalue_idxs)) {
+    p_frame = cached_frame_->get();
+    p_frame->Reset(feed_mlvalue_idxs, feeds, fetches, fetch_allocators);
+  } else {
+    new_frame = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
+                                                 fetch_allocators, session_state);
+    p_frame = new_frame.get();
+    if (cached_frame_ != nullptr) {
+      *cached_frame_ = std::move(new_frame);
+    }
+  }
+
+  ExecutionFrame& frame = *p_frame;
   const std::unordered_set<NodeIndex>* to_be_executed_nodes = nullptr;
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -164,9 +268,9 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   std::cout << std::make_pair(&seq_exec_plan, &session_state) << std::endl;
 #endif
 
+#ifdef CONCURRENCY_VISUALIZER
   const auto& graph_viewer = session_state.GetGraphViewer();
 
-#ifdef CONCURRENCY_VISUALIZER
   // need unique name for the series. number of nodes should be good enough for a subgraph
   char series_name[MaxSeriesNameLengthInChars] = "MainGraph";
   if (graph_viewer->IsSubgraph()) {
@@ -188,241 +292,288 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       profile::Color::Black);
 #endif
 
-  for (const auto& node_exec_plan : exec_plan_vec) {
-    if (terminate_flag_) {
-      LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+  // the graph inputs are calibrated too as they are inputs of the nodes to quantize
+  TensorCalibrationCollector* calibration_collector = session_state.GetCalibrationCollector();
+  if (calibration_collector != nullptr) {
+    for (size_t i = 0; i < feeds.size(); ++i) {
+      std::string name;
+      ORT_RETURN_IF_ERROR(session_state.GetOrtValueNameIdxMap().GetName(feed_mlvalue_idxs[i], name));
+      if (calibration_collector->ShouldCollect(name)) {
+        ORT_RETURN_IF_ERROR(calibration_collector->Collect(name, feeds[i], session_state.GetThreadPool()));
+      }
     }
+  }
 
-    auto node_index = node_exec_plan.node_index;
+  if (!kNodeInstrumentationEnabled && !is_profiler_enabled && !session_state.ExecutionStepsHaveFence() &&
+      calibration_collector == nullptr) {
+    ORT_RETURN_IF_ERROR(ExecuteStepsWithoutProfiling(session_state, frame,
+                                                     only_execute_path_to_fetches ? to_be_executed_nodes : nullptr,
+                                                     terminate_flag_, logger));
+  } else {
+    for (const auto& step : session_state.GetExecutionSteps()) {
+      if (terminate_flag_) {
+        LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      }
 
-    // If it is not necessary to execute the node.
-    if (only_execute_path_to_fetches && to_be_executed_nodes->count(node_index) == 0) {
-      continue;
-    }
+      auto node_index = step.node_index;
+
+      // If it is not necessary to execute the node.
+      if (only_execute_path_to_fetches && to_be_executed_nodes->count(node_index) == 0) {
+        continue;
+      }
 
-    const auto& node = *graph_viewer.GetNode(node_exec_plan.node_index);
+      const auto& node = step.kernel->Node();
 
 #ifdef CONCURRENCY_VISUALIZER
-    series.write_flag(node.Name().c_str());
+      series.write_flag(node.Name().c_str());
 #endif
 
 #ifdef ENABLE_NVTX_PROFILE
-    if (node.Description() != "Backward pass" && !forward_range.IsBeginCalled()) {
-      // Start timing forward pass when encountering the first forward node.
-      forward_range.Begin();
-    } else if (node.Description() == "Backward pass" && !backward_range.IsBeginCalled() && forward_range.IsBeginCalled()) {
-      // Start timing backward pass when encountering the first backward node.
-      // In the meanwhile, forward range ends.
-      forward_range.End();
-      backward_range.Begin();
-    }
+      if (node.Description() != "Backward pass" && !forward_range.IsBeginCalled()) {
+        // Start timing forward pass when encountering the first forward node.
+        forward_range.Begin();
+      } else if (node.Description() == "Backward pass" && !backward_range.IsBeginCalled() && forward_range.IsBeginCalled()) {
+        // Start timing backward pass when encountering the first backward node.
+        // In the meanwhile, forward range ends.
+        forward_range.End();
+        backward_range.Begin();
+      }
 #endif
 
-    auto p_op_kernel = session_state.GetKernel(node_index);
+      const OpKernel* p_op_kernel = step.kernel;
 
-    // if a kernel has been added in the session state, it better be NON-null.
-    if (p_op_kernel == nullptr)
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
-                             node.Name());
+      // the subgraphs may be finalized on first use, see kOrtSessionOptionsConfigLazySubgraphInitialization
+      if (step.contains_subgraph) {
+        ORT_RETURN_IF_ERROR(session_state.FinalizeDeferredSubgraphSessionStates(node_index));
+      }
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-    LARGE_INTEGER kernel_start;
-    QueryPerformanceCounter(&kernel_start);
+      LARGE_INTEGER kernel_start;
+      QueryPerformanceCounter(&kernel_start);
 #endif
-    // construct OpKernelContext
-    // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_);
-    // TODO: log kernel outputs?
-    if (is_profiler_enabled) {
-      sync_time_begin = session_state.Profiler().Now();
-    }
+      // construct OpKernelContext
+      // TODO: log kernel inputs?
+      OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_);
+      // TODO: log kernel outputs?
+      if (is_profiler_enabled) {
+        sync_time_begin = session_state.Profiler().Now();
+      }
 
-    // sync before compute
-    int queue_id = p_op_kernel->KernelDef().ExecQueueId();
-    if (seq_exec_plan.NodeHasFence(node_index)) {
-      for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
-        Fence_t fence = op_kernel_context.InputFence(input_index);
-        if (fence) {
-          auto execution_provider_type = p_op_kernel->Node().GetExecutionProviderType();
-          if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
-            execution_provider_type = kCpuExecutionProvider;
+      // sync before compute
+      int queue_id = step.exec_queue_id;
+      if (step.has_fence) {
+        for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.InputFence(input_index);
+          if (fence) {
+            auto execution_provider_type = p_op_kernel->Node().GetExecutionProviderType();
+            if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+              execution_provider_type = kCpuExecutionProvider;
+            }
+            fence->BeforeUsingAsInput(execution_provider_type, queue_id);
           }
-          fence->BeforeUsingAsInput(execution_provider_type, queue_id);
         }
-      }
 
-      for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
-        Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
-        if (fence) {
-          auto execution_provider_type = p_op_kernel->Node().GetExecutionProviderType();
-          if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
-            execution_provider_type = kCpuExecutionProvider;
+        for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+          if (fence) {
+            auto execution_provider_type = p_op_kernel->Node().GetExecutionProviderType();
+            if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+              execution_provider_type = kCpuExecutionProvider;
+            }
+            fence->BeforeUsingAsInput(execution_provider_type, queue_id);
           }
-          fence->BeforeUsingAsInput(execution_provider_type, queue_id);
         }
-      }
 
-      for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
-        Fence_t fence = op_kernel_context.OutputFence(output_index);
-        if (fence) {
-          fence->BeforeUsingAsOutput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+        for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+          Fence_t fence = op_kernel_context.OutputFence(output_index);
+          if (fence) {
+            fence->BeforeUsingAsOutput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+          }
         }
       }
-    }
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
-    utils::DumpNodeInputs(op_kernel_context, p_op_kernel->Node(), session_state);
+      utils::DumpNodeInputs(op_kernel_context, p_op_kernel->Node(), session_state);
 #endif
 
-    const std::string node_name_for_profiling = [&]() -> std::string {
-      if (!is_profiler_enabled) return {};
-      // Derive something meaningful for profile traces and logs if node name field is blank in execution graph
-      return node.Name().empty() ? MakeString(node.OpType(), "_", node_index) : node.Name();
-    }();
-
-    if (is_profiler_enabled) {
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     node_name_for_profiling + "_fence_before",
-                                                     sync_time_begin,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}});
-      concurrency::ThreadPool::StartProfiling(session_state.GetThreadPool());
-      // call compute on the kernel
-      VLOGS(logger, 1) << "Computing kernel: " << node_name_for_profiling;
-
-      // Calculate total input sizes for this operation.
-      CalculateTotalInputSizes(&op_kernel_context, p_op_kernel,
-                               input_activation_sizes, input_parameter_sizes, node_name_for_profiling);
-      kernel_begin_time = session_state.Profiler().Now();
-    }
+      const std::string node_name_for_profiling = [&]() -> std::string {
+        if (!is_profiler_enabled) return {};
+        // Derive something meaningful for profile traces and logs if node name field is blank in execution graph
+        return node.Name().empty() ? MakeString(node.OpType(), "_", node_index) : node.Name();
+      }();
+
+      if (is_profiler_enabled) {
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name_for_profiling + "_fence_before",
+                                                       sync_time_begin,
+                                                       {{"op_name", p_op_kernel->KernelDef().OpName()}});
+        concurrency::ThreadPool::StartProfiling(session_state.GetThreadPool(),
+                                                session_state.Profiler().HardwareCountersEnabled(),
+                                                session_state.Profiler().ThreadPoolTaskTracingEnabled());
+        // call compute on the kernel
+        VLOGS(logger, 1) << "Computing kernel: " << node_name_for_profiling;
+
+        // Calculate total input sizes for this operation.
+        CalculateTotalInputSizes(&op_kernel_context, p_op_kernel,
+                                 input_activation_sizes, input_parameter_sizes, node_name_for_profiling);
+        if (session_state.Profiler().HardwareCountersEnabled()) {
+          session_state.Profiler().StartHardwareCounters();
+        }
+        if (frame.GetMemoryTracker()) {
+          frame.GetMemoryTracker()->BeginNode(node_name_for_profiling);
+        }
+        session_state.Profiler().StartDeviceCorrelation(node_name_for_profiling);
+        kernel_begin_time = session_state.Profiler().Now();
+      }
 
-    Status compute_status;
-    {
+      Status compute_status;
+      {
 #ifdef CONCURRENCY_VISUALIZER
-      diagnostic::span span(series, "%s.%d", node.OpType().c_str(), node.Index());
+        diagnostic::span span(series, "%s.%d", node.OpType().c_str(), node.Index());
 #endif
 #ifdef ENABLE_NVTX_PROFILE
-      profile::NvtxRangeCreator node_compute_range(
-          MakeString(node.OpType(), ".", node.Index(), "(", node.Name(), ")"), profile::Color::Yellow);
-      node_compute_range.Begin();
+        profile::NvtxRangeCreator node_compute_range(
+            MakeString(node.OpType(), ".", node.Index(), "(", node.Name(), ")"), profile::Color::Yellow);
+        node_compute_range.Begin();
 #endif
-      ORT_TRY {
+        ORT_TRY {
 #ifdef ENABLE_TRAINING
-        if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
-          ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
-        }
+          if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
+            ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
+          }
 #endif
 
-        compute_status = p_op_kernel->Compute(&op_kernel_context);
-      }
-      ORT_CATCH(const std::exception& ex) {
-        ORT_HANDLE_EXCEPTION([&]() {
-          compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
-        });
-      }
+          compute_status = p_op_kernel->Compute(&op_kernel_context);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+          });
+        }
 
 #ifdef ENABLE_NVTX_PROFILE
-      node_compute_range.End();
+        node_compute_range.End();
 #endif
-    }
+      }
 
-    if (!compute_status.IsOK()) {
-      std::ostringstream ss;
-      ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
-         << "' Status Message: " << compute_status.ErrorMessage();
-      //If the computation failed, we still can record the memory consumption
-#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
-      MemoryInfo::MemoryInfoProfile::CreateEvents("dynamic activations_" + std::to_string(MemoryInfo::GetIteration()),
-                                                  MemoryInfo::MemoryInfoProfile::GetAndIncreasePid(), MemoryInfo::MapType::DynamicActivation, "", 0);
-#endif
-      const auto msg_string = ss.str();
-      LOGS(logger, ERROR) << msg_string;
-      return Status(compute_status.Category(), compute_status.Code(), msg_string);
-    }
+      if (is_profiler_enabled) {
+        session_state.Profiler().EndDeviceCorrelation();
+      }
 
-    if (is_profiler_enabled) {
-      kernel_end_time = session_state.Profiler().Now();
-      // Calculate total output sizes for this operation.
-      CalculateTotalOutputSizes(&op_kernel_context, total_output_sizes, node_name_for_profiling);
+      if (!compute_status.IsOK()) {
+        return ComputeErrorStatus(node, compute_status, logger);
+      }
+
+      if (calibration_collector != nullptr) {
+        ORT_RETURN_IF_ERROR(CollectCalibrationData(*calibration_collector, op_kernel_context, node,
+                                                   session_state.GetThreadPool()));
+      }
+
+      if (is_profiler_enabled) {
+        kernel_end_time = session_state.Profiler().Now();
+        const std::string hardware_counters = session_state.Profiler().HardwareCountersEnabled()
+                                                  ? session_state.Profiler().StopHardwareCounters()
+                                                  : std::string();
+        // Calculate total output sizes for this operation.
+        CalculateTotalOutputSizes(&op_kernel_context, total_output_sizes, node_name_for_profiling);
 
 #if defined(TRACE_EXECUTION)
-      // Trace execution step.
-      const Node& node = p_op_kernel->Node();
-      std::cout << "Executed op kernel node " << node_name_for_profiling
-                << " Index=" << node.Index()
-                << " OpType=" << node.OpType()
-                << " Name=" << node.Name()
-                << " Activation_Size=" << input_activation_sizes
-                << " Parameter_Size=" << input_parameter_sizes
-                << " Output_Size=" << total_output_sizes
-                << "\n";
+        // Trace execution step.
+        const Node& node = p_op_kernel->Node();
+        std::cout << "Executed op kernel node " << node_name_for_profiling
+                  << " Index=" << node.Index()
+                  << " OpType=" << node.OpType()
+                  << " Name=" << node.Name()
+                  << " Activation_Size=" << input_activation_sizes
+                  << " Parameter_Size=" << input_parameter_sizes
+                  << " Output_Size=" << total_output_sizes
+                  << "\n";
 #endif
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     node_name_for_profiling + "_kernel_time",
-                                                     kernel_begin_time, kernel_end_time,
-                                                     // Log additional operation args / info.
-                                                     {
-                                                         {"op_name", p_op_kernel->KernelDef().OpName()},
-                                                         {"provider", p_op_kernel->KernelDef().Provider()},
-                                                         {"graph_index", std::to_string(p_op_kernel->Node().Index())},
-                                                         {"exec_plan_index", std::to_string(node_index)},
-                                                         {"activation_size", std::to_string(input_activation_sizes)},
-                                                         {"parameter_size", std::to_string(input_parameter_sizes)},
-                                                         {"output_size", std::to_string(total_output_sizes)},
-                                                         {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())},
-                                                     });
-      sync_time_begin = session_state.Profiler().Now();
-    }
-
-    // sync after compute for outputs
-    if (seq_exec_plan.NodeHasFence(node_index)) {
-      for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
-        Fence_t fence = op_kernel_context.InputFence(input_index);
-        if (fence) {
-          fence->AfterUsedAsInput(queue_id);
+        // Log additional operation args / info.
+        std::vector<concurrency::ThreadPoolTaskRecord> thread_pool_tasks;
+        std::unordered_map<std::string, std::string> event_args = {
+            {"op_name", p_op_kernel->KernelDef().OpName()},
+            {"provider", p_op_kernel->KernelDef().Provider()},
+            {"graph_index", std::to_string(p_op_kernel->Node().Index())},
+            {"exec_plan_index", std::to_string(node_index)},
+            {"activation_size", std::to_string(input_activation_sizes)},
+            {"parameter_size", std::to_string(input_parameter_sizes)},
+            {"output_size", std::to_string(total_output_sizes)},
+            {"thread_scheduling_stats",
+             concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool(), &thread_pool_tasks)},
+        };
+        if (!hardware_counters.empty()) {
+          event_args.emplace("hardware_counters", hardware_counters);
+        }
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name_for_profiling + "_kernel_time",
+                                                       kernel_begin_time, kernel_end_time,
+                                                       std::move(event_args));
+        if (!thread_pool_tasks.empty()) {
+          session_state.Profiler().RecordThreadPoolTasks(node_name_for_profiling, thread_pool_tasks);
         }
+        sync_time_begin = session_state.Profiler().Now();
       }
 
-      for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
-        Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
-        if (fence) {
-          fence->AfterUsedAsInput(queue_id);
+      // sync after compute for outputs
+      if (step.has_fence) {
+        for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.InputFence(input_index);
+          if (fence) {
+            fence->AfterUsedAsInput(queue_id);
+          }
+        }
+
+        for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+          if (fence) {
+            fence->AfterUsedAsInput(queue_id);
+          }
         }
-      }
 
-      for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
-        Fence_t fence = op_kernel_context.OutputFence(output_index);
-        if (fence) {
-          fence->AfterUsedAsOutput(queue_id);
+        for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+          Fence_t fence = op_kernel_context.OutputFence(output_index);
+          if (fence) {
+            fence->AfterUsedAsOutput(queue_id);
+          }
         }
       }
-    }
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-    LARGE_INTEGER kernel_stop;
-    QueryPerformanceCounter(&kernel_stop);
-    LARGE_INTEGER elapsed;
-    elapsed.QuadPart = kernel_stop.QuadPart - kernel_start.QuadPart;
-    elapsed.QuadPart *= 1000000;
-    elapsed.QuadPart /= perf_freq.QuadPart;
-    // Log an event
-    TraceLoggingWrite(telemetry_provider_handle,  // handle to my provider
-                      "OpEnd",                    // Event Name that should uniquely identify your event.
-                      TraceLoggingValue(p_op_kernel->KernelDef().OpName().c_str(), "op_name"),
-                      TraceLoggingValue(elapsed.QuadPart, "time"));
+      LARGE_INTEGER kernel_stop;
+      QueryPerformanceCounter(&kernel_stop);
+      LARGE_INTEGER elapsed;
+      elapsed.QuadPart = kernel_stop.QuadPart - kernel_start.QuadPart;
+      elapsed.QuadPart *= 1000000;
+      elapsed.QuadPart /= perf_freq.QuadPart;
+      // Log an event
+      TraceLoggingWrite(telemetry_provider_handle,  // handle to my provider
+                        "OpEnd",                    // Event Name that should uniquely identify your event.
+                        TraceLoggingValue(p_op_kernel->KernelDef().OpName().c_str(), "op_name"),
+                        TraceLoggingValue(elapsed.QuadPart, "time"));
 #endif
-    if (is_profiler_enabled) {
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     node_name_for_profiling + "_fence_after",
-                                                     sync_time_begin,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}});
-    }
+      if (is_profiler_enabled) {
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name_for_profiling + "_fence_after",
+                                                       sync_time_begin,
+                                                       {{"op_name", p_op_kernel->KernelDef().OpName()}});
+      }
 
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
-    utils::DumpNodeOutputs(op_kernel_context, p_op_kernel->Node(), session_state);
+      utils::DumpNodeOutputs(op_kernel_context, p_op_kernel->Node(), session_state);
 #endif
 
-    // free ml-values corresponding to this node
-    VLOGS(logger, 1) << "Releasing node ML values.";
-    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+      // free ml-values corresponding to this node
+      VLOGS(logger, 1) << "Releasing node ML values.";
+      ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, step, logger));
+
+      if (is_profiler_enabled && frame.GetMemoryTracker()) {
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name_for_profiling + "_memory",
+                                                       session_state.Profiler().Now(),
+                                                       {{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                        {"memory", frame.GetMemoryTracker()->EndNode()}});
+      }
+    }
   }
 
 #ifdef ENABLE_NVTX_PROFILE
@@ -447,6 +598,12 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
   VLOGS(logger, 1) << "Done with execution.";
 
+  if (is_profiler_enabled && frame.GetMemoryTracker()) {
+    session_state.Profiler().EndTimeAndRecordEvent(
+        profiling::SESSION_EVENT, "memory_peak", session_state.Profiler().Now(),
+        {{"memory", frame.GetMemoryTracker()->PeakReport(session_state.GetOrtValueNameIdxMap())}});
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryInfo::MemoryInfoProfile::CreateEvents("dynamic activations_" + std::to_string(MemoryInfo::GetIteration()),
                                               MemoryInfo::MemoryInfoProfile::GetAndIncreasePid(), MemoryInfo::MapType::DynamicActivation, "", 0);
@@ -491,9 +648,9 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 
 static Status ReleaseNodeMLValues(ExecutionFrame& frame,
                                   const SequentialExecutionPlan& seq_exec_plan,
-                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const SessionState::ExecutionStep& step,
                                   const logging::Logger& logger) {
-  for (auto i = node_exec_plan.free_from_index; i <= node_exec_plan.free_to_index; ++i) {
+  for (auto i = step.free_from_index; i <= step.free_to_index; ++i) {
     auto ort_value_idx = seq_exec_plan.to_be_freed[i];
     VLOGS(logger, 1) << "Releasing ort_value with index: " << ort_value_idx;
     ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(ort_value_idx));
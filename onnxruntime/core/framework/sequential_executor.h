@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <unordered_map>
 #include "core/common/common.h"
@@ -16,11 +17,17 @@
 #include "core/framework/op_kernel_context_internal.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
+
 class SequentialExecutor : public IExecutor {
  public:
   SequentialExecutor(const bool& terminate_flag = false, const bool only_execute_path_to_fetches = false)
       : terminate_flag_{terminate_flag}, only_execute_path_to_fetches_(only_execute_path_to_fetches) {}
 
+  // Keep the ExecutionFrame in 'cached_frame' after execution, and reset the frame already there (if any) instead
+  // of creating a new one. Used when the same subgraph is executed repeatedly.
+  void SetCachedFrame(std::unique_ptr<ExecutionFrame>* cached_frame) { cached_frame_ = cached_frame; }
+
   common::Status Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
                          const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
                          std::vector<OrtValue>& fetches,
@@ -31,5 +38,6 @@ class SequentialExecutor : public IExecutor {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SequentialExecutor);
   const bool& terminate_flag_;
   const bool only_execute_path_to_fetches_;
+  std::unique_ptr<ExecutionFrame>* cached_frame_ = nullptr;
 };
 }  // namespace onnxruntime
@@ -3,12 +3,17 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
+#include "core/common/cpuid_info.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -165,7 +170,8 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
-Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
+Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager,
+                                   const SessionOptions& session_options) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
     size_t max_nodeid = 0;
@@ -182,7 +188,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       onnxruntime::ProviderType exec_provider_name = node.GetExecutionProviderType();
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
-      auto op_kernel = kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci);
+      auto op_kernel = kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci,
+                                                            session_options.config_options);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
       session_kernels_[node.Index()] = op_kernel.release();
@@ -194,6 +201,36 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
 
 const SequentialExecutionPlan* SessionState::GetExecutionPlan() const { return p_seq_exec_plan_.get(); }
 
+Status SessionState::CreateExecutionSteps() {
+  const auto& exec_plan_vec = p_seq_exec_plan_->execution_plan;
+  execution_steps_.clear();
+  execution_steps_.reserve(exec_plan_vec.size());
+  execution_steps_have_fence_ = false;
+
+  for (const auto& node_exec_plan : exec_plan_vec) {
+    const auto node_index = node_exec_plan.node_index;
+    const OpKernel* kernel = GetKernel(node_index);
+
+    // if a kernel has been added in the session state, it better be NON-null.
+    if (kernel == nullptr) {
+      const auto* node = graph_viewer_->GetNode(node_index);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
+                             node != nullptr ? node->Name() : std::to_string(node_index));
+    }
+
+    const bool has_fence = p_seq_exec_plan_->NodeHasFence(node_index);
+    execution_steps_have_fence_ = execution_steps_have_fence_ || has_fence;
+
+    execution_steps_.push_back(
+        ExecutionStep{kernel, node_index,
+                      p_seq_exec_plan_->NodeExecQueueId(node_index, kernel->KernelDef().ExecQueueId()),
+                      has_fence, kernel->Node().ContainsSubgraph(),
+                      node_exec_plan.free_from_index, node_exec_plan.free_to_index});
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::AddInitializedTensor(int ort_value_index, const OrtValue& ort_value, const OrtCallback* d,
                                           bool constant) {
   auto p = initialized_tensors_.insert({ort_value_index, ort_value});
@@ -258,7 +295,153 @@ void SessionState::CleanInitializedTensorsFromGraph() {
   graph_.CleanAllInitializedTensors();
 }
 
+// Builds the key of the buffers the kernel prepacked for the initializer at input_idx.
+// Kernels of the same type with the same attributes pack the same initializer in the same way.
+static std::string GetPrepackedWeightsKey(const OpKernel& kernel, const Tensor& tensor, int input_idx) {
+  std::ostringstream key;
+  key << kernel.KernelDef().Provider() << ':' << kernel.KernelDef().GetHash() << ':' << input_idx << ':';
+
+  std::map<std::string, const ONNX_NAMESPACE::AttributeProto*> attributes;
+  for (const auto& attribute : kernel.Node().GetAttributes()) {
+    attributes.emplace(attribute.first, &attribute.second);
+  }
+  uint32_t attributes_hash[4] = {0, 0, 0, 0};
+  for (const auto& attribute : attributes) {
+    const std::string serialized = attribute.second->SerializeAsString();
+    MurmurHash3::x86_128(serialized.data(), static_cast<int>(serialized.size()), attributes_hash[0], &attributes_hash);
+  }
+  key << std::hex << attributes_hash[0] << attributes_hash[1] << attributes_hash[2] << attributes_hash[3] << std::dec;
+
+  key << ':' << DataTypeImpl::ToString(tensor.DataType()) << ':' << tensor.Shape().ToString() << ':';
+
+  // hash the content in chunks as MurmurHash3 takes an int length
+  constexpr size_t kChunkSize = size_t{1} << 30;
+  uint32_t content_hash[4] = {0, 0, 0, 0};
+  const auto* data = static_cast<const uint8_t*>(tensor.DataRaw());
+  for (size_t offset = 0, size = tensor.SizeInBytes(); offset < size; offset += kChunkSize) {
+    const int len = static_cast<int>(std::min(kChunkSize, size - offset));
+    MurmurHash3::x86_128(data + offset, len, content_hash[0], &content_hash);
+  }
+  key << std::hex << content_hash[0] << content_hash[1] << content_hash[2] << content_hash[3];
+
+  return key.str();
+}
+
+// Moves the buffers the kernel packed for the tensor at input_idx into the shared container, or drops them if the
+// container already holds the same buffers, and lets the kernel use the buffers in the container instead.
+static Status ShareKernelPrepackedWeights(OpKernel& kernel, const Tensor& tensor, int input_idx,
+                                          PrepackedWeightsContainer& prepacked_weights_container) {
+  if (tensor.IsDataTypeString()) {
+    return Status::OK();
+  }
+
+  PrePackedWeights packed_weights;
+  ORT_RETURN_IF_ERROR(kernel.TransferPrePackedBuffers(input_idx, packed_weights.buffers_));
+  if (packed_weights.buffers_.empty()) {
+    // the kernel does not support sharing the buffers and keeps them
+    return Status::OK();
+  }
+
+  bool added = false;
+  const PrePackedWeights& shared_weights = prepacked_weights_container.GetOrAddWeight(
+      GetPrepackedWeightsKey(kernel, tensor, input_idx), std::move(packed_weights), added);
+  ORT_RETURN_IF_NOT(added || shared_weights.buffers_.size() == packed_weights.buffers_.size(),
+                    "The number of prepacked buffers of node ", kernel.Node().Name(),
+                    " does not match the shared prepacked buffers.");
+
+  // the container keeps ownership of the memory
+  std::vector<BufferUniquePtr> shared_buffers;
+  shared_buffers.reserve(shared_weights.buffers_.size());
+  for (const auto& buffer : shared_weights.buffers_) {
+    shared_buffers.emplace_back(buffer.get(), BufferDeleter(nullptr));
+  }
+
+  bool used_shared_buffers = false;
+  ORT_RETURN_IF_ERROR(kernel.UseSharedPrePackedBuffers(shared_buffers, input_idx, used_shared_buffers));
+  ORT_RETURN_IF_NOT(used_shared_buffers, "Node ", kernel.Node().Name(),
+                    " transferred its prepacked buffers but did not use the shared buffers.");
+
+  return Status::OK();
+}
+
+#if !defined(ORT_MINIMAL_BUILD) || defined(ENABLE_ORT_FORMAT_LOAD)
+// Identifies the instruction sets the kernels choose their packed layouts from. The prepacked buffers saved in an
+// ORT format model are only used on a CPU with the same value.
+static std::string GetPrePackedWeightsIsa() {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  std::ostringstream isa;
+#if defined(_M_AMD64) || defined(__x86_64__)
+  isa << "x86_64";
+#elif defined(_M_IX86) || defined(__i386__)
+  isa << "x86";
+#elif defined(_M_ARM64) || defined(__aarch64__)
+  isa << "arm64";
+#elif defined(_M_ARM) || defined(__arm__)
+  isa << "arm";
+#else
+  isa << "unknown";
+#endif
+  if (cpuid_info.HasSSE3()) isa << ",sse3";
+  if (cpuid_info.HasAVX()) isa << ",avx";
+  if (cpuid_info.HasF16C()) isa << ",f16c";
+  if (cpuid_info.HasAVX2()) isa << ",avx2";
+  if (cpuid_info.HasAVX512f()) isa << ",avx512f";
+  if (cpuid_info.HasAVX512Skylake()) isa << ",avx512skylake";
+  return isa.str();
+}
+#endif
+
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+// Lets the kernel use the buffers saved in the ORT format model for the tensor at input_idx instead of packing it.
+static Status UseSavedPrePackedBuffers(OpKernel& kernel, const Tensor& tensor, int input_idx,
+                                       const fbs::PrePackedInitializer& saved, bool& is_packed) {
+  is_packed = false;
+  if (saved.kernel_def_hash() != kernel.KernelDef().GetHash()) {
+    return Status::OK();
+  }
+
+  std::vector<gsl::span<const uint8_t>> buffers;
+  if (saved.buffers() != nullptr) {
+    buffers.reserve(saved.buffers()->size());
+    for (const auto* buffer : *saved.buffers()) {
+      ORT_RETURN_IF(nullptr == buffer, "Prepacked buffer is null. Invalid ORT format model.");
+      const auto* data = buffer->data();
+      buffers.push_back(data ? gsl::make_span(data->data(), data->size()) : gsl::span<const uint8_t>());
+    }
+  }
+
+  return kernel.UseSavedPrePackedBuffers(tensor, input_idx, buffers, is_packed);
+}
+
+void SessionState::ClearSavedPrePackedWeights() {
+  saved_prepacked_weights_ = nullptr;
+  for (auto& node_to_subgraph_ss : subgraph_session_states_) {
+    for (auto& attr_to_subgraph_ss : node_to_subgraph_ss.second) {
+      attr_to_subgraph_ss.second->ClearSavedPrePackedWeights();
+    }
+  }
+}
+#endif
+
 Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count) {
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  // the buffers saved with the model, by node index and input index
+  std::map<std::pair<NodeIndex, int>, const fbs::PrePackedInitializer*> saved_prepacked_initializers;
+  if (saved_prepacked_weights_ != nullptr && saved_prepacked_weights_->initializers() != nullptr) {
+    const auto* isa = saved_prepacked_weights_->isa();
+    if (isa != nullptr && isa->str() == GetPrePackedWeightsIsa()) {
+      for (const auto* saved : *saved_prepacked_weights_->initializers()) {
+        ORT_RETURN_IF(nullptr == saved, "Prepacked initializer is null. Invalid ORT format model.");
+        saved_prepacked_initializers.emplace(std::make_pair(NodeIndex{saved->node_index()}, saved->input_index()),
+                                             saved);
+      }
+    } else {
+      LOGS(logger_, INFO) << "The prepacked weights in the ORT format model were created for a different CPU ("
+                          << (isa ? isa->str() : "") << ") and will be packed again.";
+    }
+  }
+#endif
+
   for (auto& node : GetGraphViewer().Nodes()) {
     auto kernel = GetMutableKernel(node.Index());
     int input_idx = 0;
@@ -275,7 +458,21 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
             if (constant_initialized_tensors.count(ort_value_idx)) {
               bool is_packed = false;
               const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-              ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, is_packed));
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+              auto saved = saved_prepacked_initializers.find(std::make_pair(node.Index(), input_idx));
+              if (saved != saved_prepacked_initializers.cend()) {
+                ORT_RETURN_IF_ERROR(UseSavedPrePackedBuffers(*kernel, const_initialized_tensor, input_idx,
+                                                             *saved->second, is_packed));
+              }
+              if (!is_packed)
+#endif
+              {
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, is_packed));
+              }
+              if (is_packed && prepacked_weights_container_ != nullptr) {
+                ORT_RETURN_IF_ERROR(ShareKernelPrepackedWeights(*kernel, const_initialized_tensor, input_idx,
+                                                                *prepacked_weights_container_));
+              }
               if (is_packed && constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
                 // release the constant initialized tensor
                 st->initialized_tensors_.erase(ort_value_idx);
@@ -299,11 +496,33 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
   return Status::OK();
 }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
-  int64_t key = 0;
+// round dim up to the next power of two
+static int64_t GetMemoryPatternBucket(int64_t dim) {
+  if (dim <= 1) {
+    return dim;
+  }
+
+  int64_t bucket = 1;
+  while (bucket < dim && bucket <= std::numeric_limits<int64_t>::max() / 2) {
+    bucket <<= 1;
+  }
+
+  return bucket < dim ? dim : bucket;
+}
+
+SessionState::MemoryPatternKey SessionState::CalculateMemoryPatternsKey(
+    const std::vector<std::reference_wrapper<const TensorShape>>& shapes) const {
+  // bucketing every dim is equivalent to only bucketing the symbolic ones, as a fixed dim always maps to the same
+  // bucket.
+  MemoryPatternKey key;
   for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
+    const auto& dims = shape.get().GetDims();
+    key.push_back(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) {
+      key.push_back(enable_mem_pattern_shape_bucketing_ ? GetMemoryPatternBucket(dim) : dim);
+    }
   }
+
   return key;
 }
 
@@ -526,10 +745,25 @@ Status SessionState::GeneratePatternGroupCache(const std::vector<std::reference_
 }
 #endif
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
-                                                              const std::vector<int>& feed_mlvalue_idxs,
-                                                              std::unordered_map<int, TensorShape>& inferred_shapes) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+    const std::vector<int>& feed_mlvalue_idxs,
+    std::unordered_map<int, TensorShape>& inferred_shapes) const {
+  // the tensor sizes are evaluated for the input shapes, so the patterns don't need to be cached. the shapes of the
+  // activations are not returned in inferred_shapes as they are only needed by the training kernels.
+  if (symbolic_mem_plan_) {
+    auto mem_patterns = std::make_shared<MemoryPatternGroup>();
+    auto status = symbolic_mem_plan_->GeneratePatterns(*p_seq_exec_plan_, input_shapes, feed_mlvalue_idxs,
+                                                       enable_mem_pattern_lifetime_packing_, *mem_patterns);
+    if (status.IsOK()) {
+      return mem_patterns;
+    }
+
+    LOGS(logger_, VERBOSE) << "Memory pattern could not be generated from the symbolic memory plan, "
+                           << "falling back to tracing. " << status.ErrorMessage();
+  }
+
+  const MemoryPatternKey key = CalculateMemoryPatternsKey(input_shapes);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
@@ -537,11 +771,7 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<
 #ifdef ENABLE_TRAINING
     auto mem_patterns = std::make_unique<MemoryPatternGroup>();
     if (GeneratePatternGroupCache(input_shapes, feed_mlvalue_idxs, mem_patterns.get(), inferred_shapes).IsOK()) {
-      key = CalculateMemoryPatternsKey(input_shapes);
-      auto ptr = mem_patterns.get();
-      mem_patterns_[key] = std::move(mem_patterns);
-      shape_patterns_[key] = inferred_shapes;
-      return ptr;
+      return AddMemoryPatternGroupToCache(key, std::move(mem_patterns), inferred_shapes);
     }
     return nullptr;
 #else
@@ -550,8 +780,52 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<
 #endif
   }
 
-  inferred_shapes = shape_patterns_[key];
-  return it->second.get();
+  // move to the front of the LRU list
+  mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+
+  inferred_shapes = it->second.inferred_shapes;
+  return it->second.mem_patterns;
+}
+
+std::shared_ptr<const MemoryPatternGroup> SessionState::AddMemoryPatternGroupToCache(
+    const MemoryPatternKey& key, std::unique_ptr<MemoryPatternGroup> mem_patterns,
+    const std::unordered_map<int, TensorShape>& inferred_shapes) const {
+  size_t size_in_bytes = 0;
+  for (const auto& pattern : mem_patterns->patterns) {
+    size_in_bytes += pattern.PeakSize();
+  }
+
+  std::shared_ptr<const MemoryPatternGroup> result{std::move(mem_patterns)};
+
+  // replace any existing entry
+  auto existing = mem_patterns_.find(key);
+  if (existing != mem_patterns_.end()) {
+    mem_patterns_cache_bytes_ -= existing->second.size_in_bytes;
+    mem_patterns_lru_.erase(existing->second.lru_position);
+    mem_patterns_.erase(existing);
+  }
+
+  if (mem_patterns_cache_max_bytes_ != 0 && size_in_bytes > mem_patterns_cache_max_bytes_) {
+    LOGS(logger_, VERBOSE) << "Memory pattern with peak size of " << size_in_bytes
+                           << " bytes exceeds the memory pattern cache limit of " << mem_patterns_cache_max_bytes_
+                           << " bytes and will not be cached.";
+    return result;
+  }
+
+  // evict the least recently used entries until the new entry fits
+  while (mem_patterns_cache_max_bytes_ != 0 && !mem_patterns_lru_.empty() &&
+         mem_patterns_cache_bytes_ + size_in_bytes > mem_patterns_cache_max_bytes_) {
+    auto lru = mem_patterns_.find(mem_patterns_lru_.back());
+    mem_patterns_cache_bytes_ -= lru->second.size_in_bytes;
+    mem_patterns_.erase(lru);
+    mem_patterns_lru_.pop_back();
+  }
+
+  mem_patterns_lru_.push_front(key);
+  mem_patterns_cache_bytes_ += size_in_bytes;
+  mem_patterns_[key] = MemoryPatternCacheEntry{result, inferred_shapes, size_in_bytes, mem_patterns_lru_.begin()};
+
+  return result;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -567,13 +841,10 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
                                                    std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+  const MemoryPatternKey key = CalculateMemoryPatternsKey(input_shapes);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
-  }
+  AddMemoryPatternGroupToCache(key, std::move(mem_patterns), {});
 
   return Status::OK();
 }
@@ -787,7 +1058,40 @@ Status SessionState::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   ORT_RETURN_IF_ERROR(
       GetSubGraphSessionStatesOrtFormat(builder, subgraph_session_states_, sub_graph_session_states));
 
-  fbs_session_state = fbs::CreateSessionStateDirect(builder, kernels, &sub_graph_session_states);
+  // Buffers the kernels prepacked from constant initializers
+  std::vector<flatbuffers::Offset<fbs::PrePackedInitializer>> prepacked_initializers;
+  for (const auto& kvp : kernel_create_info_map_) {
+    const OpKernel* kernel = GetKernel(kvp.first);
+    if (kernel == nullptr) {
+      continue;
+    }
+
+    const int num_inputs = static_cast<int>(kernel->Node().InputDefs().size());
+    for (int input_idx = 0; input_idx < num_inputs; ++input_idx) {
+      std::vector<gsl::span<const uint8_t>> buffers;
+      ORT_RETURN_IF_ERROR(kernel->GetPrePackedBuffers(input_idx, buffers));
+      if (buffers.empty()) {
+        continue;
+      }
+
+      std::vector<flatbuffers::Offset<fbs::PrePackedBuffer>> fbs_buffers;
+      fbs_buffers.reserve(buffers.size());
+      for (const auto& buffer : buffers) {
+        fbs_buffers.push_back(fbs::CreatePrePackedBuffer(builder, builder.CreateVector(buffer.data(), buffer.size())));
+      }
+      prepacked_initializers.push_back(
+          fbs::CreatePrePackedInitializerDirect(builder, gsl::narrow<uint32_t>(kvp.first), input_idx,
+                                                kvp.second->kernel_def->GetHash(), &fbs_buffers));
+    }
+  }
+
+  flatbuffers::Offset<fbs::PrePackedWeights> prepacked_weights = 0;
+  if (!prepacked_initializers.empty()) {
+    prepacked_weights = fbs::CreatePrePackedWeightsDirect(builder, GetPrePackedWeightsIsa().c_str(),
+                                                          &prepacked_initializers);
+  }
+
+  fbs_session_state = fbs::CreateSessionStateDirect(builder, kernels, &sub_graph_session_states, prepacked_weights);
   return Status::OK();
 }
 
@@ -810,7 +1114,8 @@ Status SessionState::CreateSubgraphSessionState() {
       auto subgraph_session_state =
           std::make_unique<SessionState>(*subgraph, execution_providers_, enable_mem_pattern_,
                                          thread_pool_, inter_op_thread_pool_, data_transfer_mgr_,
-                                         logger_, profiler_);
+                                         logger_, profiler_, use_deterministic_compute_, enable_mem_reuse_,
+                                         prepacked_weights_container_);
 
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
@@ -840,6 +1145,8 @@ Status SessionState::LoadFromOrtFormat(const fbs::SessionState& fbs_session_stat
                     "Size mismatch for kernel create info node indexes and hashes. Invalid ORT format model.",
                     node_indices->size(), " != ", kernel_def_hashes->size());
 
+  saved_prepacked_weights_ = fbs_session_state.prepacked_weights();
+
   auto add_kernel_by_hash =
       [&kernel_registry_manager, this](const Node& node, uint64_t hash) {
         const KernelCreateInfo* kci = nullptr;
@@ -949,6 +1256,11 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
   // so also do it recursively when calling PopulateKernelCreateInfo for consistency.
   ORT_RETURN_IF_ERROR(CreateSubgraphSessionState());
 
+  TimePoint tp;
+  if (profiler_.SessionCreationProfilingEnabled()) {
+    tp = profiler_.Now();
+  }
+
   if (serialized_session_state) {
 #if defined(ENABLE_ORT_FORMAT_LOAD)
     ORT_RETURN_IF_ERROR(LoadFromOrtFormat(*serialized_session_state, kernel_registry_manager));
@@ -971,10 +1283,20 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
 #endif
   }
 
+  if (profiler_.SessionCreationProfilingEnabled()) {
+    profiler_.EndTimeAndRecordPhase("kernel_lookup", tp);
+  }
+
   std::unordered_map<std::string, size_t> constant_initializers_use_count;
   ComputeConstantInitializerUseCount(graph_, constant_initializers_use_count);
-  return FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, session_options,
-                                  remove_initializers, constant_initializers_use_count);
+  auto status = FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, session_options,
+                                         remove_initializers, constant_initializers_use_count, saving_ort_format);
+
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  ClearSavedPrePackedWeights();
+#endif
+
+  return status;
 }
 
 Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
@@ -982,9 +1304,45 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                               _In_opt_ const Node* parent_node,
                                               const SessionOptions& session_options,
                                               bool remove_initializers,
-                                              std::unordered_map<std::string, size_t>& constant_initializers_use_count) {
+                                              std::unordered_map<std::string, size_t>& constant_initializers_use_count,
+                                              bool saving_ort_format) {
   CreateGraphInfo();
 
+  const std::string mem_pattern_cache_max_bytes =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheMaxBytes, "0");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(mem_pattern_cache_max_bytes, mem_patterns_cache_max_bytes_),
+                    "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternCacheMaxBytes, ": ",
+                    mem_pattern_cache_max_bytes);
+
+  enable_mem_pattern_shape_bucketing_ =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternShapeBucketing, "0") == "1";
+  enable_mem_pattern_lifetime_packing_ =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternLifetimePacking, "0") == "1";
+
+  const std::string small_tensor_max_bytes =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSmallTensorMaxBytes, "0");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(small_tensor_max_bytes, small_tensor_max_bytes_),
+                    "Invalid value for ", kOrtSessionOptionsConfigSmallTensorMaxBytes, ": ", small_tensor_max_bytes);
+#ifdef ENABLE_TRAINING
+  // memory patterns are generated from the exact input shapes together with the inferred shapes of the activations,
+  // so they can't be shared between shapes.
+  if (enable_mem_pattern_shape_bucketing_) {
+    LOGS(logger_, WARNING) << kOrtSessionOptionsConfigMemoryPatternShapeBucketing
+                           << " is not supported in a training build and will be ignored.";
+    enable_mem_pattern_shape_bucketing_ = false;
+  }
+#endif
+  const bool enable_mem_pattern_symbolic_planning =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternSymbolicPlanning,
+                                                        "0") == "1";
+#ifdef ENABLE_TRAINING
+  // the training build already generates memory patterns from the inferred shapes, using the program counters.
+  if (enable_mem_pattern_symbolic_planning) {
+    LOGS(logger_, WARNING) << kOrtSessionOptionsConfigMemoryPatternSymbolicPlanning
+                           << " is not supported in a training build and will be ignored.";
+  }
+#endif
+
   // ignore any outer scope args we don't know about. this can happen if a node contains multiple subgraphs.
   std::vector<const NodeArg*> valid_outer_scope_node_args;
   if (parent_node) {
@@ -1000,11 +1358,36 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                   });
   }
 
+  // the phases are recorded for the subgraphs as well, with the name of their parent node
+  const bool profiling = profiler_.SessionCreationProfilingEnabled();
+  std::unordered_map<std::string, std::string> phase_args;
+  if (parent_node) {
+    phase_args["parent_node"] = parent_node->Name();
+  }
+  auto record_phase = [this, profiling, &phase_args](const std::string& phase_name, const TimePoint& start_time) {
+    if (profiling) {
+      profiler_.EndTimeAndRecordPhase(phase_name, start_time, std::unordered_map<std::string, std::string>(phase_args));
+    }
+  };
+
+  TimePoint tp;
+  if (profiling) {
+    tp = profiler_.Now();
+  }
+
   SequentialPlannerContext context(session_options.execution_mode, session_options.execution_order, session_options.enable_mem_reuse);
   ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
                                                     execution_providers_, kernel_create_info_map_,
                                                     ort_value_name_idx_map_, context, p_seq_exec_plan_));
   //Record the allocation plan
+#ifndef ENABLE_TRAINING
+  if (enable_mem_pattern_ && enable_mem_pattern_symbolic_planning) {
+    symbolic_mem_plan_ = SymbolicMemoryPlan::Create(*graph_viewer_, *p_seq_exec_plan_, GetNodeIndexInfo(),
+                                                    ort_value_name_idx_map_);
+  }
+#endif
+
+  record_phase("execution_planning", tp);
 
   // Uncomment the below to dump the allocation plan to std::cout
   // LOGS(logger_, VERBOSE) << std::make_pair(p_seq_exec_plan_.get(), this);
@@ -1036,6 +1419,10 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   const auto& initializer_allocation_order = p_seq_exec_plan_->initializer_allocation_order;
 
+  if (profiling) {
+    tp = profiler_.Now();
+  }
+
   // move initializers from TensorProto instances in Graph to OrtValue instances in SessionState
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
@@ -1045,7 +1432,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
           [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant) -> Status {
             return AddInitializedTensor(idx, value, &d, constant);
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options, thread_pool_));
+  record_phase("initializer_copy", tp);
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   //Record Weight allocation info on device
   MemoryInfo::RecordInitializerAllocInfo(GetInitializedTensors());
@@ -1058,14 +1446,25 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  if (profiling) {
+    tp = profiler_.Now();
+  }
+
+  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager, session_options));
+  ORT_RETURN_IF_ERROR(CreateExecutionSteps());
+  record_phase("kernel_creation", tp);
 
 #ifndef ENABLE_TRAINING
   const auto disable_prepacking =
       session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0");
 
   if (disable_prepacking != "1") {
+    if (profiling) {
+      tp = profiler_.Now();
+    }
+
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count));
+    record_phase("prepacking", tp);
   }
 #endif
 
@@ -1079,31 +1478,151 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SessionOptions subgraph_session_options(session_options);
   subgraph_session_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
 
+  // The subgraphs are finalized when their node is first executed if that is enabled. All of them are needed to save
+  // the ORT format model.
+  const bool defer_subgraphs =
+      !saving_ort_format && !subgraph_session_states_.empty() &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazySubgraphInitialization, "0") == "1";
+
+  if (defer_subgraphs) {
+    deferred_subgraphs_info_ = std::make_unique<DeferredSubgraphsInfo>(
+        DeferredSubgraphsInfo{graph_location, &kernel_registry_manager, subgraph_session_options, remove_initializers});
+
+    for (const auto& node_to_subgraph_ss : subgraph_session_states_) {
+      deferred_subgraph_nodes_[node_to_subgraph_ss.first].store(false);
+    }
+
+    return Status::OK();
+  }
+
   for (const auto& node_to_subgraph_ss : subgraph_session_states_) {
-    Node& node = *graph_.GetNode(node_to_subgraph_ss.first);
+    ORT_RETURN_IF_ERROR(FinalizeSubgraphSessionStates(node_to_subgraph_ss.first, graph_location,
+                                                      kernel_registry_manager, subgraph_session_options,
+                                                      remove_initializers, constant_initializers_use_count,
+                                                      saving_ort_format));
+  }
+
+  return Status::OK();
+}
 
-    for (const auto& attr_subgraph_pair : node.GetAttributeNameToMutableSubgraphMap()) {
-      auto& attr_name = attr_subgraph_pair.first;
-      auto entry = node_to_subgraph_ss.second.find(attr_name);
-      // CreateSubgraphSessionState should ensure all these entries are created
-      ORT_ENFORCE(entry != node_to_subgraph_ss.second.cend(),
-                  "Missing session state for subgraph. Node:'", node.Name(),
-                  "' OpType:", node.OpType(), " Index:", node.Index(), " Attribute:", attr_name);
+Status SessionState::FinalizeSubgraphSessionStates(onnxruntime::NodeIndex index,
+                                                   const std::basic_string<PATH_CHAR_TYPE>& graph_location,
+                                                   KernelRegistryManager& kernel_registry_manager,
+                                                   const SessionOptions& subgraph_session_options,
+                                                   bool remove_initializers,
+                                                   std::unordered_map<std::string, size_t>& constant_initializers_use_count,
+                                                   bool saving_ort_format) {
+  Node& node = *graph_.GetNode(index);
+  const auto& attr_to_subgraph_ss = subgraph_session_states_[index];
+
+  for (const auto& attr_subgraph_pair : node.GetAttributeNameToMutableSubgraphMap()) {
+    auto& attr_name = attr_subgraph_pair.first;
+    auto entry = attr_to_subgraph_ss.find(attr_name);
+    // CreateSubgraphSessionState should ensure all these entries are created
+    ORT_ENFORCE(entry != attr_to_subgraph_ss.cend(),
+                "Missing session state for subgraph. Node:'", node.Name(),
+                "' OpType:", node.OpType(), " Index:", node.Index(), " Attribute:", attr_name);
+
+    SessionState& subgraph_session_state = *entry->second;
+
+    // recurse
+    ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
+        graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
+        constant_initializers_use_count, saving_ort_format));
+
+    // setup all the info for handling the feeds and fetches used in subgraph execution
+    auto* p_op_kernel = GetMutableKernel(node.Index());
+    ORT_ENFORCE(p_op_kernel);
+
+    // Downcast is safe, since only control flow nodes have subgraphs
+    // (node.GetAttributeNameToMutableSubgraphMap() is non-empty)
+    auto& control_flow_kernel = static_cast<controlflow::IControlFlowKernel&>(*p_op_kernel);
+    ORT_RETURN_IF_ERROR(control_flow_kernel.SetupSubgraphExecutionInfo(*this, attr_name, subgraph_session_state));
+  }
 
-      SessionState& subgraph_session_state = *entry->second;
+  return Status::OK();
+}
 
-      // recurse
-      ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
-          graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers, constant_initializers_use_count));
+Status SessionState::FinalizeDeferredSubgraphSessionStates(onnxruntime::NodeIndex index) const {
+  auto entry = deferred_subgraph_nodes_.find(index);
+  if (entry == deferred_subgraph_nodes_.cend() || entry->second.load(std::memory_order_acquire)) {
+    return Status::OK();
+  }
+
+  std::lock_guard<OrtMutex> lock(deferred_subgraphs_lock_);
+  if (entry->second.load(std::memory_order_relaxed)) {
+    return Status::OK();
+  }
+
+  // only the initializers of the subgraphs can be released once prepacked. the ones from the outer scope may be in use
+  // by a concurrent Run, so they are left out of the use counts.
+  std::unordered_map<std::string, size_t> constant_initializers_use_count;
+  for (const auto& attr_to_subgraph_ss : subgraph_session_states_.at(index)) {
+    const Graph& subgraph = attr_to_subgraph_ss.second->graph_;
+    std::unordered_map<std::string, size_t> subgraph_use_count;
+    ComputeConstantInitializerUseCount(subgraph, subgraph_use_count);
+    for (const auto& initializer : subgraph.GetAllInitializedTensors()) {
+      auto use_count = subgraph_use_count.find(initializer.first);
+      if (use_count != subgraph_use_count.cend()) {
+        constant_initializers_use_count[initializer.first] += use_count->second;
+      }
+    }
+  }
+
+  const DeferredSubgraphsInfo& info = *deferred_subgraphs_info_;
+  ORT_RETURN_IF_ERROR(const_cast<SessionState*>(this)->FinalizeSubgraphSessionStates(
+      index, info.graph_location, *info.kernel_registry_manager, info.session_options, info.remove_initializers,
+      constant_initializers_use_count, false));
+
+  entry->second.store(true, std::memory_order_release);
+  return Status::OK();
+}
+
+static bool ContainsAnyNode(const Graph& graph, const std::unordered_set<std::string>& node_names) {
+  for (const auto& node : graph.Nodes()) {
+    if (node_names.count(node.Name()) != 0) {
+      return true;
+    }
+
+    if (node.ContainsSubgraph()) {
+      for (const auto& subgraph : node.GetSubgraphs()) {
+        if (ContainsAnyNode(*subgraph, node_names)) {
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+Status SessionState::FinalizeDeferredSubgraphSessionStates(const std::unordered_set<std::string>& node_names,
+                                                           std::unordered_set<std::string>& found_node_names) const {
+  for (const auto& node : graph_.Nodes()) {
+    if (node_names.count(node.Name()) != 0) {
+      found_node_names.insert(node.Name());
+    }
+  }
+
+  for (const auto& node_to_subgraph_ss : subgraph_session_states_) {
+    const Node& node = *graph_.GetNode(node_to_subgraph_ss.first);
+
+    // a requested node may be nested in a subgraph, in which case all the subgraphs containing it are finalized
+    bool finalize = node_names.empty() || node_names.count(node.Name()) != 0;
+    for (auto it = node_to_subgraph_ss.second.cbegin(), end = node_to_subgraph_ss.second.cend();
+         !finalize && it != end; ++it) {
+      finalize = ContainsAnyNode(it->second->graph_, node_names);
+    }
+
+    if (!finalize) {
+      continue;
+    }
 
-      // setup all the info for handling the feeds and fetches used in subgraph execution
-      auto* p_op_kernel = GetMutableKernel(node.Index());
-      ORT_ENFORCE(p_op_kernel);
+    ORT_RETURN_IF_ERROR(FinalizeDeferredSubgraphSessionStates(node.Index()));
 
-      // Downcast is safe, since only control flow nodes have subgraphs
-      // (node.GetAttributeNameToMutableSubgraphMap() is non-empty)
-      auto& control_flow_kernel = static_cast<controlflow::IControlFlowKernel&>(*p_op_kernel);
-      ORT_RETURN_IF_ERROR(control_flow_kernel.SetupSubgraphExecutionInfo(*this, attr_name, subgraph_session_state));
+    for (const auto& attr_to_subgraph_ss : node_to_subgraph_ss.second) {
+      ORT_RETURN_IF_ERROR(attr_to_subgraph_ss.second->FinalizeDeferredSubgraphSessionStates(node_names,
+                                                                                           found_node_names));
     }
   }
 
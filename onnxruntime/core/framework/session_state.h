@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "gsl/gsl"
@@ -26,6 +29,8 @@
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/framework/symbolic_memory_plan.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/platform/ort_mutex.h"
@@ -46,6 +51,7 @@ namespace onnxruntime {
 namespace experimental {
 namespace fbs {
 struct SessionState;
+struct PrePackedWeights;
 }  // namespace fbs
 }  // namespace experimental
 
@@ -55,6 +61,7 @@ class OpKernel;
 class NodeIndexInfo;
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
+class TensorCalibrationCollector;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
@@ -87,7 +94,8 @@ class SessionState {
                const logging::Logger& logger,
                profiling::Profiler& profiler,
                bool use_deterministic_compute = false,
-               bool enable_mem_reuse = true)
+               bool enable_mem_reuse = true,
+               PrepackedWeightsContainer* prepacked_weights_container = nullptr)
       : graph_(graph),
         execution_providers_(execution_providers),
         logger_(logger),
@@ -97,7 +105,8 @@ class SessionState {
         inter_op_thread_pool_(inter_op_thread_pool),
         data_transfer_mgr_(data_transfer_mgr),
         use_deterministic_compute_(use_deterministic_compute),
-        enable_mem_reuse_(enable_mem_reuse) {
+        enable_mem_reuse_(enable_mem_reuse),
+        prepacked_weights_container_(prepacked_weights_container) {
     SetupAllocators();
   }
 
@@ -180,6 +189,28 @@ class SessionState {
 
   // execution plan. nullptr until FinalizeSessionState is called
   const SequentialExecutionPlan* GetExecutionPlan() const;
+
+  /**
+    A node of the execution plan with what is needed to execute it, resolved when the session state is finalized so
+    the executor does not need to look it up for every node in every run.
+    */
+  struct ExecutionStep {
+    const OpKernel* kernel;
+    onnxruntime::NodeIndex node_index;
+    int exec_queue_id;
+    bool has_fence;
+    bool contains_subgraph;
+    // the OrtValue's to release after the node is executed are
+    // SequentialExecutionPlan::to_be_freed[free_from_index, free_to_index]
+    int free_from_index;
+    int free_to_index;
+  };
+
+  // the execution plan as ExecutionStep's, in execution order. empty until FinalizeSessionState is called
+  const std::vector<ExecutionStep>& GetExecutionSteps() const noexcept { return execution_steps_; }
+
+  // true if any of the execution steps has a fence
+  bool ExecutionStepsHaveFence() const noexcept { return execution_steps_have_fence_; }
   /**
   Get the logger for this session.
   Falls back to returning Logging::LoggingManager::DefaultLogger if SetLogger has not been called.
@@ -193,15 +224,16 @@ class SessionState {
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
   /**
-  Get cached memory pattern based on input shapes
+  Get cached memory pattern based on input shapes.
+  The returned pattern remains valid while it is held even if it is evicted from the cache.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
       const std::vector<int>& feed_mlvalue_idxs,
       std::unordered_map<int, TensorShape>& inferred_shapes) const;
 
   /**
-  Set generated memory pattern with a given input shapes.
+  Set generated memory pattern with a given input shapes, replacing any existing pattern for the same cache key.
   Const as it's an internal cache update only.
   */
   Status UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
@@ -214,6 +246,30 @@ class SessionState {
   */
   bool GetEnableMemoryPattern() const;
 
+  /**
+  Get memory pattern shape bucketing flag. If true, input shapes are rounded up into buckets when looking up
+  memory patterns, so a cached pattern may have been generated for smaller shapes than the current ones.
+  */
+  bool GetEnableMemoryPatternShapeBucketing() const { return enable_mem_pattern_shape_bucketing_; }
+
+  /**
+  Get memory pattern lifetime packing flag. If true, the offsets of a memory pattern are assigned once the lifetimes
+  of all the traced tensors are known, largest tensors first, which usually lowers the peak size of the pattern.
+  */
+  bool GetEnableMemoryPatternLifetimePacking() const { return enable_mem_pattern_lifetime_packing_; }
+
+  /**
+  Get memory pattern symbolic planning flag. If true, memory patterns are generated for each Run from the tensor sizes
+  derived from the input dims when the session was created, instead of being traced and cached.
+  */
+  bool GetEnableMemoryPatternSymbolicPlanning() const { return symbolic_mem_plan_ != nullptr; }
+
+  /**
+  Get the maximum size in bytes of the CPU tensors that the ExecutionFrame allocates from its own blocks instead of
+  the allocator. 0 if that is disabled.
+  */
+  size_t GetSmallTensorMaxBytes() const { return small_tensor_max_bytes_; }
+
   /**
   Get enable memory re-use flag.
   */
@@ -260,9 +316,32 @@ class SessionState {
   /// Return SessionState for the given Node index and attribute name if found.
   const SessionState* GetSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name) const;
 
+  /**
+  Finalize the SessionState instances of the subgraphs of a node if that was deferred because
+  kOrtSessionOptionsConfigLazySubgraphInitialization is enabled, and set up the execution info of the node's kernel.
+  Called by the executors before executing a node that contains subgraphs. Thread safe, and a no-op once done.
+  */
+  Status FinalizeDeferredSubgraphSessionStates(onnxruntime::NodeIndex index) const;
+
+  /**
+  Finalize the deferred subgraphs of the nodes named in node_names, and of the nodes containing them if they are
+  in a subgraph themselves, so the first Run that executes them doesn't pay for it.
+  All the deferred subgraphs are finalized if node_names is empty.
+  @param found_node_names The names in node_names that were found in this graph or its subgraphs are added to it.
+  */
+  Status FinalizeDeferredSubgraphSessionStates(const std::unordered_set<std::string>& node_names,
+                                               std::unordered_set<std::string>& found_node_names) const;
+
   concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
   concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
 
+  /**
+  Set the collector the executor adds the tensors produced by the nodes of this graph to, or nullptr to stop
+  collecting. Set by InferenceSession::StartCalibration and InferenceSession::EndCalibration, outside of Run calls.
+  */
+  void SetCalibrationCollector(TensorCalibrationCollector* collector) noexcept { calibration_collector_ = collector; }
+  TensorCalibrationCollector* GetCalibrationCollector() const noexcept { return calibration_collector_; }
+
   bool ExportDll() const noexcept { return export_fused_dll_; }
   void SetExportDllFlag(bool flag) noexcept { export_fused_dll_ = flag; }
 
@@ -311,7 +390,10 @@ class SessionState {
   void CreateGraphInfo();
 
   // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager, const SessionOptions& session_options);
+
+  // create execution_steps_ from the execution plan and the kernels
+  Status CreateExecutionSteps();
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -323,6 +405,11 @@ class SessionState {
   */
   Status PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count);
 
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  // The model bytes the saved prepacked weights point into may be released once the session is initialized
+  void ClearSavedPrePackedWeights();
+#endif
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
@@ -339,7 +426,17 @@ class SessionState {
                                   _In_opt_ const Node* parent_node,
                                   const SessionOptions& session_options,
                                   bool remove_initializers,
-                                  std::unordered_map<std::string, size_t>& constant_initializers_use_count);
+                                  std::unordered_map<std::string, size_t>& constant_initializers_use_count,
+                                  bool saving_ort_format);
+
+  // finalize the SessionState instances of the subgraphs of a node and set up the execution info of its kernel
+  Status FinalizeSubgraphSessionStates(onnxruntime::NodeIndex index,
+                                       const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
+                                       KernelRegistryManager& kernel_registry_manager,
+                                       const SessionOptions& subgraph_session_options,
+                                       bool remove_initializers,
+                                       std::unordered_map<std::string, size_t>& constant_initializers_use_count,
+                                       bool saving_ort_format);
 
 #ifdef ENABLE_TRAINING
   Status GeneratePatternGroupCache(
@@ -361,6 +458,11 @@ class SessionState {
   // We populate this map when doing the kernel compilation in GraphPartitioner, and use it in LoadFromOrtFormat.
   std::unordered_map<std::string, uint64_t> compiled_kernel_hashes_;
 
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  // The buffers the kernels prepacked when the ORT format model was saved. Only valid during FinalizeSessionState.
+  const onnxruntime::experimental::fbs::PrePackedWeights* saved_prepacked_weights_ = nullptr;
+#endif
+
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<OpKernel*> session_kernels_;
   Graph& graph_;
@@ -414,19 +516,58 @@ class SessionState {
   std::unordered_map<int, OrtCallback> deleter_for_initialized_tensors_;
   std::vector<BufferUniquePtr> weights_buffers_;
   std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan_ = nullptr;
+  std::vector<ExecutionStep> execution_steps_;
+  bool execution_steps_have_fence_ = false;
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
 
+  // not owned. the calibration mode is on if set.
+  TensorCalibrationCollector* calibration_collector_ = nullptr;
+
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  // round input dims up to a power of two when looking up mem_patterns_
+  bool enable_mem_pattern_shape_bucketing_ = false;
+
+  // assign the offsets of generated memory patterns over the lifetimes of the whole iteration
+  bool enable_mem_pattern_lifetime_packing_ = false;
+
+  // tensor sizes derived from the input dims to generate the memory pattern of each Run. null if not enabled.
+  std::unique_ptr<SymbolicMemoryPlan> symbolic_mem_plan_;
+
+  // maximum size of the tensors allocated from the blocks of the ExecutionFrame
+  size_t small_tensor_max_bytes_ = 0;
+
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
 
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
-  mutable std::map<int64_t, std::unordered_map<int, TensorShape>> shape_patterns_;
+  // key for mem_patterns_. the rank and (possibly bucketed) dims of each input shape.
+  using MemoryPatternKey = std::vector<int64_t>;
+
+  struct MemoryPatternCacheEntry {
+    std::shared_ptr<const MemoryPatternGroup> mem_patterns;
+    std::unordered_map<int, TensorShape> inferred_shapes;
+    size_t size_in_bytes;
+    std::list<MemoryPatternKey>::iterator lru_position;
+  };
+
+  MemoryPatternKey CalculateMemoryPatternsKey(
+      const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
+
+  // add an entry to mem_patterns_ and evict least recently used entries if the cache exceeds its size limit.
+  // mem_patterns_lock_ must be held.
+  std::shared_ptr<const MemoryPatternGroup> AddMemoryPatternGroupToCache(
+      const MemoryPatternKey& key, std::unique_ptr<MemoryPatternGroup> mem_patterns,
+      const std::unordered_map<int, TensorShape>& inferred_shapes) const;
+
+  // cache for the generated mem_patterns, bounded by the sum of the pattern peak sizes if
+  // mem_patterns_cache_max_bytes_ is not 0. mem_patterns_lru_ holds the keys with the most recently used first.
+  size_t mem_patterns_cache_max_bytes_ = 0;
+  mutable size_t mem_patterns_cache_bytes_ = 0;
+  mutable std::map<MemoryPatternKey, MemoryPatternCacheEntry> mem_patterns_;
+  mutable std::list<MemoryPatternKey> mem_patterns_lru_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -437,6 +578,20 @@ class SessionState {
       std::unordered_map<onnxruntime::NodeIndex, std::unordered_map<std::string, std::unique_ptr<SessionState>>>;
   SubgraphSessionStateMap subgraph_session_states_;
 
+  // what is needed to finalize the subgraph SessionState instances on first use if that is deferred
+  struct DeferredSubgraphsInfo {
+    std::basic_string<PATH_CHAR_TYPE> graph_location;
+    KernelRegistryManager* kernel_registry_manager;
+    SessionOptions session_options;
+    bool remove_initializers;
+  };
+  std::unique_ptr<DeferredSubgraphsInfo> deferred_subgraphs_info_;
+
+  // nodes whose subgraphs are finalized on first use, with whether that has been done.
+  // entries are only added by FinalizeSessionStateImpl so the map can be read without holding the lock.
+  mutable std::unordered_map<onnxruntime::NodeIndex, std::atomic<bool>> deferred_subgraph_nodes_;
+  mutable OrtMutex deferred_subgraphs_lock_;
+
   // either threadpool could be nullptr
   concurrency::ThreadPool* const thread_pool_{};
   concurrency::ThreadPool* const inter_op_thread_pool_{};
@@ -447,6 +602,8 @@ class SessionState {
 
   bool use_deterministic_compute_;
   bool enable_mem_reuse_;
+  // container shared with other sessions for the weights prepacked by the kernels. nullptr if not shared.
+  PrepackedWeightsContainer* const prepacked_weights_container_{};
   std::unique_ptr<NodeIndexInfo> node_index_info_;
   std::multimap<int, std::unique_ptr<FeedsFetchesManager>> cached_feeds_fetches_managers_;
 
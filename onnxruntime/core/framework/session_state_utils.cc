@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/session_state_utils.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <core/common/status.h>
@@ -25,6 +26,8 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -60,7 +63,8 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
                                              const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer* m,
                                              const AllocatorPtr& alloc, const AllocatorPtr& default_cpu_alloc,
                                              OrtValue& ort_value, const DataTransferManager& data_transfer_mgr,
-                                             bool use_device_allocator_for_initializers = false) {
+                                             bool use_device_allocator_for_initializers = false,
+                                             OrtMutex* data_transfer_mutex = nullptr) {
   if (bool(alloc) == (m != nullptr)) {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
@@ -113,7 +117,16 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
     ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_deserialize_tensor));
     // TODO!! Need a temp buffer allocator for non-escape buffers that maybe too big for stack allocation.
 
+    // when initializers are deserialized concurrently, the copies to the device are serialized as not every
+    // data transfer implementation is thread safe. other threads keep reading and unpacking in the meantime.
+    std::unique_lock<OrtMutex> copy_lock;
+    if (data_transfer_mutex != nullptr) {
+      copy_lock = std::unique_lock<OrtMutex>(*data_transfer_mutex);
+    }
     Status copy_status = data_transfer_mgr.CopyTensor(*p_deserialize_tensor, *p_tensor);
+    if (copy_lock.owns_lock()) {
+      copy_lock.unlock();
+    }
     if (!copy_status.IsOK()) {
       if (copy_status.ErrorMessage().empty()) {
         // The windows execution provider does not return any error message today for CopyTensor since it is
@@ -138,7 +151,8 @@ common::Status SaveInitializedTensors(
     const std::function<Status(int idx, const OrtValue& value, const OrtCallback& d, bool constant)>& save_tensor_func,
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
-    const SessionOptions& session_options) {
+    const SessionOptions& session_options,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -171,15 +185,49 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  // Determine if an initializer refers to data that is already in memory (e.g. the bytes of a memory mapped ORT format
+  // model) and can be used in place. This requires the initializer to be planned on CPU, and the data to be suitably
+  // aligned for the element type. Otherwise the data is copied into a buffer from the planner as usual.
+  auto use_initializer_data_in_place =
+      [&exec_plan](int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto, void*& data) -> bool {
+    const void* data_in_memory = nullptr;
+    size_t data_in_memory_length = 0;
+    if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        !utils::GetExternalDataMemoryAddress(tensor_proto, data_in_memory, data_in_memory_length)) {
+      return false;
+    }
+
+    if (strcmp(exec_plan.GetLocation(ort_value_index).name, CPU) != 0) {
+      return false;
+    }
+
+    size_t expected_length = 0;
+    const size_t element_size =
+        DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType()->Size();
+    if (!utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &expected_length).IsOK() ||
+        expected_length != data_in_memory_length ||
+        reinterpret_cast<uintptr_t>(data_in_memory) % element_size != 0) {
+      return false;
+    }
+
+    // the data is only read from so the const_cast is safe
+    data = const_cast<void*>(data_in_memory);
+    return true;
+  };
+
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   std::set<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  std::unordered_map<int, void*> in_place_initializer_data;  // ort value id to data for initializers used in place
   for (const auto& entry : initialized_tensor_set) {
     int ort_value_index;
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
+    void* data_in_place = nullptr;
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (use_initializer_data_in_place(ort_value_index, *entry.second, data_in_place)) {
+      in_place_initializer_data[ort_value_index] = data_in_place;
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -187,6 +235,12 @@ common::Status SaveInitializedTensors(
   // tensors requiring a specific allocation order are traced first, to ensure they are allocated in order
   auto initialized_tensors_to_allocate = id_to_initialized_tensor;
   for (int ort_value_index : initializer_allocation_order) {
+    // the memory of initializers used in place is not planned
+    if (in_place_initializer_data.find(ort_value_index) != in_place_initializer_data.end()) {
+      initialized_tensors_to_allocate.erase(ort_value_index);
+      continue;
+    }
+
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     // can not trace string tensor
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end() && entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING);
@@ -195,8 +249,10 @@ common::Status SaveInitializedTensors(
   }
 
   for (const auto& entry : initialized_tensors_to_allocate) {
-    // We don't want to trace shared initializers since their memory is provided by the user
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    // We don't want to trace shared initializers since their memory is provided by the user, or initializers that
+    // are used in place
+    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+        in_place_initializer_data.find(entry.first) != in_place_initializer_data.end()) {
       continue;
     }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
@@ -225,37 +281,89 @@ common::Status SaveInitializedTensors(
   OrtCallback deleter{nullptr, nullptr};
 
   //3. create weight tensors based on weights buffer
-  for (const auto& entry : id_to_initialized_tensor) {
-    int ort_value_index = entry.first;
-    const char* name = (entry.second->name().empty()) ? "" : entry.second->name().c_str();
+  // The planner is not thread safe, so the buffers are obtained up front. The initializers that need to be
+  // deserialized are then unpacked (including any reads of external data) in parallel, and finally saved in order.
+  struct InitializerToSave {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
     OrtValue ort_value;
+    std::unique_ptr<MemBuffer> m;
+    AllocatorPtr alloc;
+    size_t size_in_bytes{0};
+    Status status;
+  };
+
+  std::vector<InitializerToSave> initializers_to_save;
+  initializers_to_save.reserve(id_to_initialized_tensor.size());
+  std::vector<InitializerToSave*> initializers_to_deserialize;
+
+  for (const auto& entry : id_to_initialized_tensor) {
+    initializers_to_save.push_back(InitializerToSave{entry.first, entry.second, OrtValue{}, nullptr, nullptr});
+  }
+
+  for (auto& initializer : initializers_to_save) {
+    int ort_value_index = initializer.ort_value_index;
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *initializer.tensor_proto;
+    const char* name = (tensor_proto.name().empty()) ? "" : tensor_proto.name().c_str();
+    OrtValue& ort_value = initializer.ort_value;
 
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    if (user_supplied_initializer_ids.find(ort_value_index) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (in_place_initializer_data.find(ort_value_index) != in_place_initializer_data.end()) {
+      TensorShape tensor_shape{utils::GetTensorShapeFromTensorProto(tensor_proto)};
+      const DataTypeImpl* const type =
+          DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+      auto p_tensor = std::make_unique<Tensor>(type, tensor_shape, in_place_initializer_data[ort_value_index],
+                                               exec_plan.GetLocation(ort_value_index));
+      auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+      ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+      VLOGS(logger, 1) << "Using initializer data in place for " << name;
     } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
-      std::unique_ptr<MemBuffer> m;
-      AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, m.get(), alloc, default_cpu_alloc, ort_value,
-                                         data_transfer_mgr, use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.m, initializer.alloc));
+      if (!utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &initializer.size_in_bytes).IsOK()) {
+        initializer.size_in_bytes = 0;
       }
+      initializers_to_deserialize.push_back(&initializer);
+    }
+  }
+
+  // start with the largest initializers so that a single large one does not end up last on one thread
+  std::stable_sort(initializers_to_deserialize.begin(), initializers_to_deserialize.end(),
+                   [](const InitializerToSave* a, const InitializerToSave* b) {
+                     return a->size_in_bytes > b->size_in_bytes;
+                   });
+
+  bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+  OrtMutex data_transfer_mutex;
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(initializers_to_deserialize.size()),
+      [&](std::ptrdiff_t i) {
+        InitializerToSave& initializer = *initializers_to_deserialize[i];
+        initializer.status = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto, initializer.m.get(),
+                                                    initializer.alloc, default_cpu_alloc, initializer.ort_value,
+                                                    data_transfer_mgr, use_device_allocator_for_initializers,
+                                                    &data_transfer_mutex);
+      });
+
+  for (auto& initializer : initializers_to_save) {
+    int ort_value_index = initializer.ort_value_index;
+    const char* name = (initializer.tensor_proto->name().empty()) ? "" : initializer.tensor_proto->name().c_str();
+
+    const Status& st = initializer.status;
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
     }
 
     // any outer scope value is shadowed by a local value and can't override it.
     // due to that check_outer_scope is false
     bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
-    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant));
+    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, initializer.ort_value, deleter, constant));
 
     VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << ort_value_index;
   }
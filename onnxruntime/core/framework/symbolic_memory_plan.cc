@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/symbolic_memory_plan.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
+#include "core/framework/data_types.h"
+#include "core/framework/node_index_info.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+// Split the size of a tensor into the product of its fixed dims and its symbolic dims.
+// Returns false if the shape is unknown, or has a dim that is unknown or not bound to an input dim.
+static bool TryGetSymbolicSize(const ONNX_NAMESPACE::TensorShapeProto* shape,
+                               const std::unordered_map<std::string, size_t>& symbolic_dim_indexes,
+                               int64_t& fixed_size, std::vector<size_t>& symbolic_dims) {
+  if (shape == nullptr) {
+    return false;
+  }
+
+  fixed_size = 1;
+  for (const auto& dim : shape->dim()) {
+    if (dim.has_dim_param()) {
+      auto it = symbolic_dim_indexes.find(dim.dim_param());
+      if (it == symbolic_dim_indexes.end()) {
+        return false;
+      }
+      symbolic_dims.push_back(it->second);
+    } else if (dim.has_dim_value() && dim.dim_value() > 0) {
+      if (dim.dim_value() > std::numeric_limits<int64_t>::max() / fixed_size) {
+        return false;
+      }
+      fixed_size *= dim.dim_value();
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::unique_ptr<SymbolicMemoryPlan> SymbolicMemoryPlan::Create(const GraphViewer& graph_viewer,
+                                                               const SequentialExecutionPlan& execution_plan,
+                                                               const NodeIndexInfo& node_index_info,
+                                                               const OrtValueNameIdxMap& ort_value_name_idx_map) {
+  std::unique_ptr<SymbolicMemoryPlan> plan{new SymbolicMemoryPlan()};
+
+  // bind the symbolic dims to the input dims they appear in
+  std::unordered_map<std::string, size_t> symbolic_dim_indexes;
+  for (const auto* input : graph_viewer.GetInputs()) {
+    const auto* shape = input->Shape();
+    int ort_value_idx;
+    if (shape == nullptr || !ort_value_name_idx_map.GetIdx(input->Name(), ort_value_idx).IsOK()) {
+      continue;
+    }
+
+    for (int axis = 0, rank = shape->dim_size(); axis < rank; ++axis) {
+      const auto& dim = shape->dim(axis);
+      if (!dim.has_dim_param()) {
+        continue;
+      }
+
+      auto result = symbolic_dim_indexes.emplace(dim.dim_param(), plan->symbolic_dims_.size());
+      if (result.second) {
+        plan->symbolic_dims_.emplace_back();
+      }
+      plan->symbolic_dims_[result.first->second].push_back(
+          InputDim{ort_value_idx, static_cast<size_t>(rank), static_cast<size_t>(axis)});
+    }
+  }
+
+  // record the allocations and releases in the order of the execution plan, as an ExecutionFrame traces them
+  for (const auto& node_plan : execution_plan.execution_plan) {
+    const auto* node = graph_viewer.GetNode(node_plan.node_index);
+    const int output_start = node_index_info.GetNodeOffset(node_plan.node_index) +
+                             static_cast<int>(node->InputDefs().size()) +
+                             static_cast<int>(node->ImplicitInputDefs().size());
+
+    for (int i = 0, end = static_cast<int>(node->OutputDefs().size()); i < end; ++i) {
+      const int ort_value_idx = node_index_info.GetMLValueIndex(output_start + i);
+      if (ort_value_idx == NodeIndexInfo::kInvalidEntry) {
+        continue;
+      }
+
+      const auto& value_plan = execution_plan.allocation_plan[ort_value_idx];
+      if (value_plan.alloc_kind != AllocKind::kAllocate || value_plan.value_type == nullptr ||
+          !value_plan.value_type->IsTensorType()) {
+        continue;
+      }
+
+      const auto* element_type = static_cast<const TensorTypeBase*>(value_plan.value_type)->GetElementType();
+      if (element_type == DataTypeImpl::GetType<std::string>()) {
+        continue;
+      }
+
+      TensorSize tensor_size{ort_value_idx, element_type->Size(), 1, {}};
+      if (TryGetSymbolicSize(node->OutputDefs()[i]->Shape(), symbolic_dim_indexes, tensor_size.fixed_size,
+                             tensor_size.symbolic_dims)) {
+        plan->steps_.push_back(Step{static_cast<int>(plan->tensor_sizes_.size()), ort_value_idx});
+        plan->tensor_sizes_.push_back(std::move(tensor_size));
+      }
+    }
+
+    for (int index = node_plan.free_from_index; index <= node_plan.free_to_index; ++index) {
+      plan->steps_.push_back(Step{-1, execution_plan.to_be_freed[index]});
+    }
+  }
+
+  if (plan->tensor_sizes_.empty()) {
+    return nullptr;
+  }
+
+  return plan;
+}
+
+Status SymbolicMemoryPlan::GeneratePatterns(const SequentialExecutionPlan& execution_plan,
+                                            const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+                                            const std::vector<int>& feed_mlvalue_idxs, bool pack_lifetimes,
+                                            MemoryPatternGroup& output) const {
+  // -1 if the symbolic dim is only bound to inputs that are not fed, e.g. optional inputs with an initializer
+  std::vector<int64_t> dim_values(symbolic_dims_.size(), -1);
+  for (size_t i = 0; i < symbolic_dims_.size(); ++i) {
+    for (const auto& input_dim : symbolic_dims_[i]) {
+      auto it = std::find(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end(), input_dim.ort_value_idx);
+      if (it == feed_mlvalue_idxs.end()) {
+        continue;
+      }
+
+      const TensorShape& shape = input_shapes[it - feed_mlvalue_idxs.begin()];
+      ORT_RETURN_IF_NOT(shape.NumDimensions() == input_dim.rank,
+                        "Input with OrtValue index ", input_dim.ort_value_idx, " has rank ", shape.NumDimensions(),
+                        " but ", input_dim.rank, " was expected by the symbolic memory plan.");
+
+      const int64_t value = shape[input_dim.axis];
+      ORT_RETURN_IF_NOT(dim_values[i] == -1 || dim_values[i] == value,
+                        "Inputs bound to the same symbolic dim have different dims: ", dim_values[i], " and ", value);
+      dim_values[i] = value;
+    }
+  }
+
+  OrtValuePatternPlanner planner(execution_plan, /*trace_using_counters*/ false, pack_lifetimes);
+  for (const auto& step : steps_) {
+    if (step.index < 0) {
+      ORT_RETURN_IF_ERROR(planner.TraceFree(step.ort_value_idx));
+      continue;
+    }
+
+    const auto& tensor_size = tensor_sizes_[step.index];
+    SafeInt<size_t> len = tensor_size.fixed_size;
+    bool resolved = true;
+    for (size_t dim : tensor_size.symbolic_dims) {
+      if (dim_values[dim] < 0) {
+        resolved = false;
+        break;
+      }
+      len *= dim_values[dim];
+    }
+
+    // empty tensors and the ones depending on dims that are not fed are allocated when they're produced
+    if (!resolved || len == 0) {
+      continue;
+    }
+
+    size_t size = 0;
+    if (!IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(len, tensor_size.element_size, &size)) {
+      return Status(ONNXRUNTIME, FAIL, "Size overflow");
+    }
+
+    ORT_RETURN_IF_ERROR(planner.TraceAllocation(tensor_size.ort_value_idx, size));
+  }
+
+  return planner.GeneratePatterns(&output);
+}
+
+}  // namespace onnxruntime
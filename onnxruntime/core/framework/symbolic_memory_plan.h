@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class NodeIndexInfo;
+class OrtValueNameIdxMap;
+struct SequentialExecutionPlan;
+
+// SymbolicMemoryPlan derives a memory pattern for any input shapes from the shapes inferred for the graph, so a graph
+// with symbolic input dims (e.g. "batch" and "seq") doesn't need a Run to trace its allocations for every new shape.
+// When the session is created it records, for each tensor planned to be allocated, its size as the product of the
+// fixed dims and the symbolic dims bound to an input dim (e.g. batch * seq * 768 * 4 bytes), together with the order
+// in which the tensors are allocated and released by the execution plan. For a Run only the input dims are looked up,
+// the sizes evaluated, and the recorded allocations and releases replayed through an OrtValuePatternPlanner.
+// Tensors whose shape has a dim that is unknown or not bound to an input dim (e.g. the output of NonZero) are not
+// part of the pattern and are allocated when they're produced.
+class SymbolicMemoryPlan {
+ public:
+  // Returns nullptr if no tensor planned to be allocated has a size that can be derived from the input shapes.
+  static std::unique_ptr<SymbolicMemoryPlan> Create(const GraphViewer& graph_viewer,
+                                                    const SequentialExecutionPlan& execution_plan,
+                                                    const NodeIndexInfo& node_index_info,
+                                                    const OrtValueNameIdxMap& ort_value_name_idx_map);
+
+  // Generate the memory patterns for the input shapes, feed_mlvalue_idxs being the OrtValue indexes of the inputs.
+  // Fails if an input dim a pattern depends on doesn't match the rank of the input or the other inputs bound to
+  // the same symbolic dim.
+  Status GeneratePatterns(const SequentialExecutionPlan& execution_plan,
+                          const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+                          const std::vector<int>& feed_mlvalue_idxs, bool pack_lifetimes,
+                          MemoryPatternGroup& output) const;
+
+ private:
+  SymbolicMemoryPlan() = default;
+
+  // where the value of a symbolic dim is read from
+  struct InputDim {
+    int ort_value_idx;
+    size_t rank;
+    size_t axis;
+  };
+
+  struct TensorSize {
+    int ort_value_idx;
+    size_t element_size;
+    // product of the fixed dims
+    int64_t fixed_size;
+    // indexes in symbolic_dims_ of the symbolic dims, once for each time they appear in the shape
+    std::vector<size_t> symbolic_dims;
+  };
+
+  // an allocation of tensor_sizes_[index], or the release of the OrtValue at ort_value_idx if index is -1
+  struct Step {
+    int index;
+    int ort_value_idx;
+  };
+
+  // the input dims each symbolic dim is bound to
+  std::vector<std::vector<InputDim>> symbolic_dims_;
+  std::vector<TensorSize> tensor_sizes_;
+  std::vector<Step> steps_;
+};
+
+}  // namespace onnxruntime
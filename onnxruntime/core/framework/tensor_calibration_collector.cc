@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tensor_calibration_collector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/framework/ml_value.h"
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// the smallest number of values scanned by a thread
+static constexpr std::ptrdiff_t kMinValuesPerBatch = 16384;
+
+static std::ptrdiff_t GetNumBatches(size_t count, concurrency::ThreadPool* thread_pool) {
+  const std::ptrdiff_t max_batches = static_cast<std::ptrdiff_t>(count) / kMinValuesPerBatch;
+  return std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool), max_batches));
+}
+
+// Find the min and max of the finite values. Returns false if there are none.
+static bool FindFiniteMinMax(const float* data, size_t count, concurrency::ThreadPool* thread_pool,
+                             float& min, float& max) {
+  const std::ptrdiff_t num_batches = GetNumBatches(count, thread_pool);
+  const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(count);
+  std::vector<float> batch_min(num_batches);
+  std::vector<float> batch_max(num_batches);
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool, num_batches,
+      [&](std::ptrdiff_t batch) {
+        const auto work = concurrency::ThreadPool::PartitionWork(batch, num_batches, total);
+        MlasFindMinMaxElement(data + work.start, &batch_min[batch], &batch_max[batch],
+                              static_cast<size_t>(work.end - work.start));
+      },
+      num_batches);
+
+  min = *std::min_element(batch_min.begin(), batch_min.end());
+  max = *std::max_element(batch_max.begin(), batch_max.end());
+  if (std::isfinite(min) && std::isfinite(max)) {
+    return true;
+  }
+
+  // the vectorized min/max let NaN and infinite values through, rescan skipping them
+  min = std::numeric_limits<float>::max();
+  max = std::numeric_limits<float>::lowest();
+  for (size_t i = 0; i < count; ++i) {
+    if (std::isfinite(data[i])) {
+      min = std::min(min, data[i]);
+      max = std::max(max, data[i]);
+    }
+  }
+  return min <= max;
+}
+
+// Add the values in [-threshold, threshold] to histogram, whose bins are spread evenly over that range.
+// All the values go to the middle bin when threshold is 0, as numpy.histogram does.
+static void AddToHistogram(const float* data, size_t count, float threshold, std::vector<int64_t>& histogram,
+                           concurrency::ThreadPool* thread_pool) {
+  const std::ptrdiff_t num_bins = static_cast<std::ptrdiff_t>(histogram.size());
+  const float scale = threshold > 0.f ? static_cast<float>(num_bins) / (2.f * threshold) : 0.f;
+  const std::ptrdiff_t zero_bin = threshold > 0.f ? 0 : num_bins / 2;
+
+  const std::ptrdiff_t num_batches = GetNumBatches(count, thread_pool);
+  const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(count);
+  std::vector<std::vector<int64_t>> batch_histograms(num_batches, std::vector<int64_t>(num_bins));
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool, num_batches,
+      [&](std::ptrdiff_t batch) {
+        const auto work = concurrency::ThreadPool::PartitionWork(batch, num_batches, total);
+        int64_t* bins = batch_histograms[batch].data();
+        for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+          const float value = data[i];
+          if (!(value >= -threshold && value <= threshold)) {
+            continue;
+          }
+          const auto bin = zero_bin + static_cast<std::ptrdiff_t>((value + threshold) * scale);
+          ++bins[std::min(bin, num_bins - 1)];
+        }
+      },
+      num_batches);
+
+  for (const auto& batch_histogram : batch_histograms) {
+    for (std::ptrdiff_t i = 0; i < num_bins; ++i) {
+      histogram[i] += batch_histogram[i];
+    }
+  }
+}
+
+TensorCalibrationCollector::TensorCalibrationCollector(const std::vector<std::string>& tensor_names,
+                                                       size_t num_bins)
+    : tensor_names_(tensor_names.begin(), tensor_names.end()), num_bins_(num_bins) {
+}
+
+bool TensorCalibrationCollector::ShouldCollect(const std::string& name) const {
+  return tensor_names_.empty() || tensor_names_.count(name) != 0;
+}
+
+Status TensorCalibrationCollector::Collect(const std::string& name, const OrtValue& value,
+                                           concurrency::ThreadPool* thread_pool) {
+  if (!value.IsTensor()) {
+    return Status::OK();
+  }
+
+  const Tensor& tensor = value.Get<Tensor>();
+  const size_t count = static_cast<size_t>(tensor.Shape().Size());
+  if (tensor.Location().device.Type() != OrtDevice::CPU || count == 0) {
+    return Status::OK();
+  }
+
+  const float* data;
+  std::vector<float> converted;
+  if (tensor.IsDataType<float>()) {
+    data = tensor.Data<float>();
+  } else if (tensor.IsDataType<MLFloat16>()) {
+    converted.resize(count);
+    MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(tensor.Data<MLFloat16>()),
+                                 converted.data(), count);
+    data = converted.data();
+  } else {
+    return Status::OK();
+  }
+
+  float min;
+  float max;
+  if (!FindFiniteMinMax(data, count, thread_pool, min, max)) {
+    return Status::OK();
+  }
+  const float threshold = std::max(std::abs(min), std::abs(max));
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = stats_.find(name);
+  if (it == stats_.end()) {
+    TensorStats& stats = stats_[name];
+    stats.min = min;
+    stats.max = max;
+    stats.threshold = threshold;
+    stats.histogram.resize(num_bins_);
+    AddToHistogram(data, count, threshold, stats.histogram, thread_pool);
+    return Status::OK();
+  }
+
+  TensorStats& stats = it->second;
+  stats.min = std::min(stats.min, min);
+  stats.max = std::max(stats.max, max);
+
+  if (threshold <= stats.threshold) {
+    AddToHistogram(data, count, stats.threshold, stats.histogram, thread_pool);
+    return Status::OK();
+  }
+
+  const size_t old_num_bins = stats.histogram.size();
+  std::vector<int64_t> histogram;
+  float new_threshold = threshold;
+  if (stats.threshold == 0.f) {
+    // all the previous values were 0
+    histogram.resize(old_num_bins);
+    int64_t old_count = 0;
+    for (int64_t bin_count : stats.histogram) {
+      old_count += bin_count;
+    }
+    histogram[old_num_bins / 2] += old_count;
+  } else {
+    // keep the old bins and add bins of the same width on both sides
+    const float old_stride = 2.f * stats.threshold / static_cast<float>(old_num_bins);
+    const size_t half_increased_bins = static_cast<size_t>((threshold - stats.threshold) / old_stride) + 1;
+    new_threshold = static_cast<float>(half_increased_bins) * old_stride + stats.threshold;
+    histogram.resize(old_num_bins + 2 * half_increased_bins);
+    std::copy(stats.histogram.begin(), stats.histogram.end(), histogram.begin() + half_increased_bins);
+  }
+
+  AddToHistogram(data, count, new_threshold, histogram, thread_pool);
+  stats.histogram = std::move(histogram);
+  stats.threshold = new_threshold;
+  return Status::OK();
+}
+
+std::unordered_map<std::string, TensorCalibrationCollector::TensorStats> TensorCalibrationCollector::GetStats() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace onnxruntime
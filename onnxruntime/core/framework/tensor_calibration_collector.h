@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/status.h"
+#include "core/platform/ort_mutex.h"
+
+struct OrtValue;
+
+namespace onnxruntime {
+
+namespace concurrency {
+class ThreadPool;
+}
+
+// TensorCalibrationCollector accumulates the range and histogram of the tensors produced while a session runs in
+// calibration mode (InferenceSession::StartCalibration), so the static quantization tools don't need to make every
+// tensor to calibrate a graph output and copy it out of each Run.
+// For each tensor it keeps the min and max of the values and a histogram with its bins spread evenly over
+// [-threshold, threshold], threshold being the largest absolute value. The histograms are merged across Run calls
+// like HistogramCollector in python/tools/quantization/calibrate.py does: when a larger threshold is seen the
+// histogram grows on both sides by whole bins of its original width.
+// Only float and float16 tensors in CPU memory are collected. NaN and infinite values are ignored.
+// Thread-safe.
+class TensorCalibrationCollector {
+ public:
+  struct TensorStats {
+    float min = 0.f;
+    float max = 0.f;
+    float threshold = 0.f;
+    std::vector<int64_t> histogram;
+  };
+
+  // Collect the named tensors, or all the tensors if tensor_names is empty.
+  // num_bins is the number of bins of the histogram of a tensor when it is first collected.
+  TensorCalibrationCollector(const std::vector<std::string>& tensor_names, size_t num_bins);
+
+  bool ShouldCollect(const std::string& name) const;
+
+  // Add the values of a tensor. Does nothing if the value is not a float or float16 tensor in CPU memory, or has no
+  // finite values. The values are scanned in parallel on thread_pool.
+  Status Collect(const std::string& name, const OrtValue& value, concurrency::ThreadPool* thread_pool);
+
+  // Return what was collected by tensor name.
+  std::unordered_map<std::string, TensorStats> GetStats() const;
+
+ private:
+  const std::unordered_set<std::string> tensor_names_;
+  const size_t num_bins_;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, TensorStats> stats_;  // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,308 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tensor_compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Large enough for the matches to reach the whole 64KB LZ4 window in most of the chunk, and small enough for the
+// temporary buffer undoing the byte shuffle to stay in the L2 cache.
+constexpr size_t kChunkSize = 256 * 1024;
+constexpr size_t kHeaderFields = 2;
+
+// LZ4 block format
+constexpr size_t kMinMatch = 4;
+// The last bytes of a block are always literals, and the last match starts at least kMatchFindLimit bytes before the
+// end of the block.
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashLog = 14;
+
+inline uint32_t Read32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t HashSequence(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - kHashLog);
+}
+
+// Writes the part of a literal or match length that does not fit in the 4 bits of the token.
+inline void WriteLengthExtension(uint8_t*& out, size_t length) {
+  for (; length >= 255; length -= 255) {
+    *out++ = 255;
+  }
+  *out++ = static_cast<uint8_t>(length);
+}
+
+// Writes literals followed by a match, or only literals if match_length is 0 (the last sequence of a block).
+// Returns false if the sequence does not fit before out_end.
+bool WriteSequence(uint8_t*& out, const uint8_t* out_end, const uint8_t* literals, size_t literal_length,
+                   size_t offset, size_t match_length) {
+  const size_t max_sequence_size = 1 + (literal_length / 255 + 1) + literal_length + 2 + (match_length / 255 + 1);
+  if (static_cast<size_t>(out_end - out) < max_sequence_size) {
+    return false;
+  }
+
+  uint8_t* token = out++;
+  *token = static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4);
+  if (literal_length >= 15) {
+    WriteLengthExtension(out, literal_length - 15);
+  }
+  memcpy(out, literals, literal_length);
+  out += literal_length;
+
+  if (match_length > 0) {
+    *out++ = static_cast<uint8_t>(offset & 0xff);
+    *out++ = static_cast<uint8_t>(offset >> 8);
+    const size_t length = match_length - kMinMatch;
+    *token |= static_cast<uint8_t>(std::min<size_t>(length, 15));
+    if (length >= 15) {
+      WriteLengthExtension(out, length - 15);
+    }
+  }
+  return true;
+}
+
+// Greedy LZ4 compression of a block. Returns the compressed size, or 0 if it does not fit in capacity bytes.
+size_t Lz4CompressBlock(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity,
+                        std::vector<uint32_t>& hash_table) {
+  std::fill(hash_table.begin(), hash_table.end(), 0);
+  uint8_t* out = dst;
+  const uint8_t* out_end = dst + capacity;
+  size_t anchor = 0;
+
+  if (size > kMatchFindLimit) {
+    const size_t match_start_limit = size - kMatchFindLimit;
+    const size_t match_end_limit = size - kLastLiterals;
+    size_t pos = 0;
+    while (pos < match_start_limit) {
+      const uint32_t sequence = Read32(src + pos);
+      uint32_t& entry = hash_table[HashSequence(sequence)];
+      const size_t candidate = entry;
+      entry = static_cast<uint32_t>(pos);
+
+      if (candidate < pos && pos - candidate <= kMaxOffset && Read32(src + candidate) == sequence) {
+        size_t match_length = kMinMatch;
+        while (pos + match_length < match_end_limit && src[candidate + match_length] == src[pos + match_length]) {
+          ++match_length;
+        }
+        if (!WriteSequence(out, out_end, src + anchor, pos - anchor, pos - candidate, match_length)) {
+          return 0;
+        }
+        pos += match_length;
+        anchor = pos;
+      } else {
+        // step faster through data that does not compress
+        pos += 1 + ((pos - anchor) >> 6);
+      }
+    }
+  }
+
+  if (!WriteSequence(out, out_end, src + anchor, size - anchor, 0, 0)) {
+    return 0;
+  }
+  return static_cast<size_t>(out - dst);
+}
+
+// Decompresses an LZ4 block that must decompress to exactly size bytes. Returns false if the block is malformed.
+bool Lz4DecompressBlock(const uint8_t* src, size_t src_size, uint8_t* dst, size_t size) {
+  const uint8_t* in = src;
+  const uint8_t* const in_end = src + src_size;
+  uint8_t* out = dst;
+  uint8_t* const out_end = dst + size;
+
+  auto read_length_extension = [&](size_t& length) {
+    uint8_t byte;
+    do {
+      if (in == in_end) {
+        return false;
+      }
+      byte = *in++;
+      length += byte;
+    } while (byte == 255);
+    return true;
+  };
+
+  while (in < in_end) {
+    const uint8_t token = *in++;
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !read_length_extension(literal_length)) {
+      return false;
+    }
+    if (static_cast<size_t>(in_end - in) < literal_length || static_cast<size_t>(out_end - out) < literal_length) {
+      return false;
+    }
+    memcpy(out, in, literal_length);
+    in += literal_length;
+    out += literal_length;
+
+    // the last sequence has no match
+    if (in == in_end) {
+      break;
+    }
+
+    if (in_end - in < 2) {
+      return false;
+    }
+    const size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+    in += 2;
+
+    size_t match_length = token & 15;
+    if (match_length == 15 && !read_length_extension(match_length)) {
+      return false;
+    }
+    match_length += kMinMatch;
+    if (offset == 0 || offset > static_cast<size_t>(out - dst) ||
+        static_cast<size_t>(out_end - out) < match_length) {
+      return false;
+    }
+
+    const uint8_t* match = out - offset;
+    if (offset >= match_length) {
+      memcpy(out, match, match_length);
+      out += match_length;
+    } else {
+      // the match overlaps the output, repeating its last offset bytes
+      for (size_t i = 0; i < match_length; ++i) {
+        *out++ = *match++;
+      }
+    }
+  }
+
+  return out == out_end;
+}
+
+void ShuffleBytes(const uint8_t* src, size_t size, size_t element_size, uint8_t* dst) {
+  const size_t count = size / element_size;
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t b = 0; b < element_size; ++b) {
+      dst[b * count + i] = src[i * element_size + b];
+    }
+  }
+}
+
+void UnshuffleBytes(const uint8_t* src, size_t size, size_t element_size, uint8_t* dst) {
+  const size_t count = size / element_size;
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t b = 0; b < element_size; ++b) {
+      dst[i * element_size + b] = src[b * count + i];
+    }
+  }
+}
+
+}  // namespace
+
+bool CompressTensorData(const void* data, size_t size, size_t element_size, TensorCompression compression,
+                        std::vector<uint8_t>& compressed) {
+  if (compression == TensorCompression::None || element_size == 0 || size % element_size != 0) {
+    return false;
+  }
+
+  const bool shuffle = compression == TensorCompression::ByteShuffleLz4 && element_size > 1;
+  const size_t num_chunks = (size + kChunkSize - 1) / kChunkSize;
+  if (num_chunks > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+  const size_t header_size = (kHeaderFields + num_chunks) * sizeof(uint32_t);
+  const size_t max_compressed_size = size - size / 8;
+  if (header_size >= max_compressed_size) {
+    return false;
+  }
+
+  compressed.resize(max_compressed_size);
+  const uint32_t header[kHeaderFields] = {static_cast<uint32_t>(kChunkSize), static_cast<uint32_t>(num_chunks)};
+  memcpy(compressed.data(), header, sizeof(header));
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  std::vector<uint8_t> shuffled(shuffle ? std::min(size, kChunkSize) : 0);
+  std::vector<uint32_t> hash_table(size_t{1} << kHashLog);
+  size_t offset = header_size;
+
+  for (size_t i = 0; i < num_chunks; ++i) {
+    const size_t chunk_length = std::min(kChunkSize, size - i * kChunkSize);
+    const uint8_t* chunk = bytes + i * kChunkSize;
+    if (shuffle) {
+      ShuffleBytes(chunk, chunk_length, element_size, shuffled.data());
+      chunk = shuffled.data();
+    }
+
+    uint8_t* out = compressed.data() + offset;
+    const size_t remaining = max_compressed_size - offset;
+    size_t stored_length = Lz4CompressBlock(chunk, chunk_length, out, std::min(chunk_length - 1, remaining),
+                                            hash_table);
+    if (stored_length == 0) {
+      // store the chunk as is
+      if (remaining < chunk_length) {
+        return false;
+      }
+      memcpy(out, chunk, chunk_length);
+      stored_length = chunk_length;
+    }
+
+    const uint32_t stored_length_field = static_cast<uint32_t>(stored_length);
+    memcpy(compressed.data() + (kHeaderFields + i) * sizeof(uint32_t), &stored_length_field, sizeof(uint32_t));
+    offset += stored_length;
+  }
+
+  compressed.resize(offset);
+  return true;
+}
+
+Status DecompressTensorData(const void* compressed, size_t compressed_size, size_t element_size,
+                            TensorCompression compression, void* data, size_t size) {
+  ORT_RETURN_IF_NOT(compression == TensorCompression::Lz4 || compression == TensorCompression::ByteShuffleLz4,
+                    "Unsupported tensor compression: ", static_cast<int>(compression));
+  ORT_RETURN_IF(element_size == 0 || size % element_size != 0, "Invalid element size for compressed tensor data.");
+
+  const auto* in = static_cast<const uint8_t*>(compressed);
+  uint32_t header[kHeaderFields];
+  ORT_RETURN_IF(compressed_size < sizeof(header), "Invalid compressed tensor data.");
+  memcpy(header, in, sizeof(header));
+  const size_t chunk_size = header[0];
+  const size_t num_chunks = header[1];
+  const size_t header_size = (kHeaderFields + num_chunks) * sizeof(uint32_t);
+  const bool shuffle = compression == TensorCompression::ByteShuffleLz4 && element_size > 1;
+  ORT_RETURN_IF(chunk_size == 0 || chunk_size % element_size != 0 ||
+                    num_chunks != (size + chunk_size - 1) / chunk_size || compressed_size < header_size,
+                "Invalid compressed tensor data.");
+
+  auto* bytes = static_cast<uint8_t*>(data);
+  std::vector<uint8_t> shuffled(shuffle ? std::min(size, chunk_size) : 0);
+  size_t offset = header_size;
+
+  for (size_t i = 0; i < num_chunks; ++i) {
+    uint32_t stored_length;
+    memcpy(&stored_length, in + (kHeaderFields + i) * sizeof(uint32_t), sizeof(uint32_t));
+    ORT_RETURN_IF(stored_length > compressed_size - offset, "Invalid compressed tensor data.");
+
+    const size_t chunk_length = std::min(chunk_size, size - i * chunk_size);
+    uint8_t* out = bytes + i * chunk_size;
+    uint8_t* target = shuffle ? shuffled.data() : out;
+    if (stored_length == chunk_length) {
+      memcpy(target, in + offset, chunk_length);
+    } else {
+      ORT_RETURN_IF_NOT(Lz4DecompressBlock(in + offset, stored_length, target, chunk_length),
+                        "Invalid compressed tensor data.");
+    }
+    if (shuffle) {
+      UnshuffleBytes(shuffled.data(), chunk_length, element_size, out);
+    }
+    offset += stored_length;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
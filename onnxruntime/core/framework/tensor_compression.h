@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/common/status.h"
+
+namespace onnxruntime {
+
+// The compressions of the raw data of tensors in an ORT format model. The values match fbs::TensorCompression.
+enum class TensorCompression : uint8_t {
+  None = 0,
+  // LZ4 block format
+  Lz4 = 1,
+  // The bytes of the elements are grouped by significance before the LZ4 compression, so the sign and exponent bytes
+  // of floating point values, which vary little, form long runs.
+  ByteShuffleLz4 = 2,
+};
+
+// The data is split into chunks compressed independently, so it can be decompressed directly into the final buffer
+// with only a chunk sized temporary buffer to undo the byte shuffle. The compressed data is
+//   uint32 chunk size, uint32 number of chunks, uint32 compressed size of each chunk, the compressed chunks
+// A chunk whose compressed size equals its uncompressed size is stored as is (after the byte shuffle).
+
+// Compresses 'size' bytes of elements of 'element_size' bytes. Returns false if the compression would not save at
+// least an eighth of the size, in which case the data should be stored uncompressed.
+bool CompressTensorData(const void* data, size_t size, size_t element_size, TensorCompression compression,
+                        std::vector<uint8_t>& compressed);
+
+// Decompresses data compressed by CompressTensorData into 'data', which must be exactly the uncompressed size.
+// Fails if the compressed data is malformed.
+common::Status DecompressTensorData(const void* compressed, size_t compressed_size, size_t element_size,
+                                    TensorCompression compression, void* data, size_t size);
+
+}  // namespace onnxruntime
@@ -5,6 +5,8 @@
 
 #include <memory>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <gsl/gsl>
 
@@ -157,6 +159,25 @@ static Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tenso
                                         const ORTCHAR_T* tensor_proto_dir,
                                         std::unique_ptr<unsigned char[]>& unpacked_tensor,
                                         SafeInt<size_t>& tensor_byte_size) {
+  if (onnxruntime::utils::HasCompressedExternalData(tensor_proto)) {
+    ORT_RETURN_IF_ERROR(onnxruntime::utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &tensor_byte_size));
+    unpacked_tensor.reset(new unsigned char[*&tensor_byte_size]);
+    return onnxruntime::utils::ReadCompressedExternalData(tensor_proto, unpacked_tensor.get(), tensor_byte_size);
+  }
+
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (onnxruntime::utils::GetExternalDataMemoryAddress(tensor_proto, data_in_memory, data_in_memory_length)) {
+    ORT_RETURN_IF_ERROR(onnxruntime::utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &tensor_byte_size));
+    ORT_RETURN_IF_NOT(data_in_memory_length == tensor_byte_size,
+                      "TensorProto external data size mismatch. Computed size: ", *&tensor_byte_size,
+                      ", external_data.length: ", data_in_memory_length);
+
+    unpacked_tensor.reset(new unsigned char[*&tensor_byte_size]);
+    std::memcpy(unpacked_tensor.get(), data_in_memory, data_in_memory_length);
+    return Status::OK();
+  }
+
   std::basic_string<ORTCHAR_T> external_file_path;
   onnxruntime::FileOffsetType file_offset;
   ORT_RETURN_IF_ERROR(GetExternalDataInfo(
@@ -397,12 +418,114 @@ Status UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor, const void* raw_d
   return Status::OK();
 }
 
+void SetExternalDataMemoryAddress(ONNX_NAMESPACE::TensorProto& ten_proto, const void* data, size_t length) {
+  ten_proto.clear_raw_data();
+  ten_proto.clear_external_data();
+  ten_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+
+  auto* location = ten_proto.add_external_data();
+  location->set_key("location");
+  location->set_value(kTensorProtoMemoryAddressTag);
+
+  auto* offset = ten_proto.add_external_data();
+  offset->set_key("offset");
+  offset->set_value(std::to_string(reinterpret_cast<uintptr_t>(data)));
+
+  auto* len = ten_proto.add_external_data();
+  len->set_key("length");
+  len->set_value(std::to_string(length));
+}
+
+static bool ParseExternalDataMemoryAddress(const ONNX_NAMESPACE::TensorProto& ten_proto, const void*& data,
+                                           size_t& length, TensorCompression& compression) {
+  if (!HasExternalData(ten_proto)) {
+    return false;
+  }
+
+  bool in_memory = false;
+  uintptr_t address = 0;
+  size_t num_bytes = 0;
+  compression = TensorCompression::None;
+  for (const auto& entry : ten_proto.external_data()) {
+    if (entry.key() == "location") {
+      in_memory = entry.value() == kTensorProtoMemoryAddressTag;
+    } else if (entry.key() == "offset") {
+      address = static_cast<uintptr_t>(std::strtoull(entry.value().c_str(), nullptr, 10));
+    } else if (entry.key() == "length") {
+      num_bytes = static_cast<size_t>(std::strtoull(entry.value().c_str(), nullptr, 10));
+    } else if (entry.key() == "compression") {
+      compression = static_cast<TensorCompression>(std::strtoul(entry.value().c_str(), nullptr, 10));
+    }
+  }
+
+  if (!in_memory) {
+    return false;
+  }
+
+  data = reinterpret_cast<const void*>(address);
+  length = num_bytes;
+  return true;
+}
+
+bool GetExternalDataMemoryAddress(const ONNX_NAMESPACE::TensorProto& ten_proto, const void*& data, size_t& length) {
+  TensorCompression compression;
+  return ParseExternalDataMemoryAddress(ten_proto, data, length, compression) &&
+         compression == TensorCompression::None;
+}
+
+void SetCompressedExternalDataMemoryAddress(ONNX_NAMESPACE::TensorProto& ten_proto, const void* data, size_t length,
+                                            TensorCompression compression) {
+  SetExternalDataMemoryAddress(ten_proto, data, length);
+
+  auto* compression_entry = ten_proto.add_external_data();
+  compression_entry->set_key("compression");
+  compression_entry->set_value(std::to_string(static_cast<int>(compression)));
+}
+
+bool HasCompressedExternalData(const ONNX_NAMESPACE::TensorProto& ten_proto) {
+  const void* data;
+  size_t length;
+  TensorCompression compression;
+  return ParseExternalDataMemoryAddress(ten_proto, data, length, compression) &&
+         compression != TensorCompression::None;
+}
+
+Status ReadCompressedExternalData(const ONNX_NAMESPACE::TensorProto& ten_proto, void* data, size_t length) {
+  const void* compressed = nullptr;
+  size_t compressed_length = 0;
+  TensorCompression compression;
+  ORT_RETURN_IF_NOT(ParseExternalDataMemoryAddress(ten_proto, compressed, compressed_length, compression) &&
+                        compression != TensorCompression::None,
+                    "TensorProto does not have compressed external data.");
+  ORT_RETURN_IF(ten_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING,
+                "String tensors can not be compressed.");
+
+  size_t tensor_byte_size = 0;
+  ORT_RETURN_IF_ERROR(GetSizeInBytesFromTensorProto<0>(ten_proto, &tensor_byte_size));
+  ORT_RETURN_IF_NOT(tensor_byte_size == length, "TensorProto compressed data size mismatch. Computed size: ",
+                    tensor_byte_size, ", buffer size: ", length);
+
+  const size_t element_size =
+      DataTypeImpl::TensorTypeFromONNXEnum(ten_proto.data_type())->GetElementType()->Size();
+  return DecompressTensorData(compressed, compressed_length, element_size, compression, data, length);
+}
+
 // UnpackTensor from raw data, external data or the type specific data field.
 // Uses the model path to construct the full path for loading external data. In case when model_path is empty
 // it uses current directory.
 template <typename T>
 Status UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor, const Path& model_path,
                     /*out*/ T* p_data, size_t expected_num_elements) {
+  if (HasCompressedExternalData(tensor)) {
+    return ReadCompressedExternalData(tensor, p_data, expected_num_elements * sizeof(T));
+  }
+
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (GetExternalDataMemoryAddress(tensor, data_in_memory, data_in_memory_length)) {
+    return UnpackTensor(tensor, data_in_memory, data_in_memory_length, p_data, expected_num_elements);
+  }
+
 #if !defined(ORT_MINIMAL_BUILD)
   if (HasExternalData(tensor)) {
     return UnpackTensorWithExternalData(
@@ -611,12 +734,25 @@ Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
                            " can not be writen into Tensor type ", DataTypeImpl::ToString(tensor.DataType()));
   }
 
+  // decompress straight into the tensor, e.g. the buffer planned for an initializer
+  if (utils::HasCompressedExternalData(tensor_proto)) {
+    ORT_RETURN_IF_NOT(source_type == tensor.DataType(),
+                      "TensorProtoToTensor() compressed data requires the same tensor type.");
+    return utils::ReadCompressedExternalData(tensor_proto, tensor.MutableDataRaw(), tensor.SizeInBytes());
+  }
+
   // find raw data in proto buf
   void* raw_data = nullptr;
   SafeInt<size_t> raw_data_len = 0;
   AutoDelete deleter_for_file_data;
-
-  if (utils::HasExternalData(tensor_proto)) {
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+
+  if (utils::GetExternalDataMemoryAddress(tensor_proto, data_in_memory, data_in_memory_length)) {
+    // the data is read only so the const_cast is safe
+    raw_data = const_cast<void*>(data_in_memory);
+    raw_data_len = data_in_memory_length;
+  } else if (utils::HasExternalData(tensor_proto)) {
     // Get the external data info
     std::basic_string<ORTCHAR_T> external_data_file_path;
     FileOffsetType file_offset;
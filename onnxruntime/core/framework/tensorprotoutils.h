@@ -13,6 +13,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/mem_buffer.h"
+#include "core/framework/tensor_compression.h"
 #include "core/framework/tensor_external_data_info.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/platform/env.h"
@@ -141,6 +142,31 @@ inline bool HasExternalData(const ONNX_NAMESPACE::TensorProto& ten_proto) {
          ten_proto.data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL;
 }
 
+// Value of the external data 'location' used to indicate the data is already in memory at the address given by
+// 'offset'. e.g. initializers that refer directly to the bytes of a memory mapped ORT format model.
+constexpr const char* kTensorProtoMemoryAddressTag = "*/_ORT_MEM_ADDR_/*";
+
+// Set the external data of ten_proto to refer to 'length' bytes at 'data'. The memory must outlive ten_proto and
+// anything that reads the data from it.
+void SetExternalDataMemoryAddress(ONNX_NAMESPACE::TensorProto& ten_proto, const void* data, size_t length);
+
+// Returns true, and sets 'data' and 'length', if the external data of ten_proto is in memory rather than in a file.
+// Returns false for compressed data in memory, which can not be used as is.
+bool GetExternalDataMemoryAddress(const ONNX_NAMESPACE::TensorProto& ten_proto, const void*& data, size_t& length);
+
+// Set the external data of ten_proto to refer to 'length' bytes at 'data' holding the data of the tensor compressed
+// with 'compression'. The data is decompressed whenever it is read, e.g. directly into the buffer of the initializer
+// when the session state is created. The memory must outlive ten_proto and anything that reads the data from it.
+void SetCompressedExternalDataMemoryAddress(ONNX_NAMESPACE::TensorProto& ten_proto, const void* data, size_t length,
+                                            TensorCompression compression);
+
+// Returns true if the external data of ten_proto is compressed data in memory.
+bool HasCompressedExternalData(const ONNX_NAMESPACE::TensorProto& ten_proto);
+
+// Decompress the compressed external data of ten_proto into 'data', which must be 'length' bytes, the size of the
+// tensor.
+common::Status ReadCompressedExternalData(const ONNX_NAMESPACE::TensorProto& ten_proto, void* data, size_t length);
+
 inline bool HasDataType(const ONNX_NAMESPACE::TensorProto& ten_proto) {
   return ten_proto.data_type() != ONNX_NAMESPACE::TensorProto::UNDEFINED;
 }
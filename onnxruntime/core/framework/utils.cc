@@ -462,10 +462,16 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
                                        const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                        const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                                        ExecutionMode execution_mode, const bool& terminate_flag,
-                                       const logging::Logger& logger, const bool only_execute_path_to_fetches = false) {
+                                       const logging::Logger& logger, const bool only_execute_path_to_fetches = false,
+                                       SubgraphExecutionCache* cache = nullptr) {
   std::unique_ptr<IExecutor> p_exec;
   if (execution_mode == ExecutionMode::ORT_SEQUENTIAL) {
-    p_exec = std::unique_ptr<IExecutor>(new SequentialExecutor(terminate_flag, only_execute_path_to_fetches));
+    auto* sequential_executor = new SequentialExecutor(terminate_flag, only_execute_path_to_fetches);
+    if (cache != nullptr) {
+      sequential_executor->SetCachedFrame(&cache->frame);
+    }
+
+    p_exec = std::unique_ptr<IExecutor>(sequential_executor);
   } else if (execution_mode == ExecutionMode::ORT_PARALLEL) {
     auto* p_inter_op_thread_pool = session_state.GetInterOpThreadPool();
     if (!p_inter_op_thread_pool) {
@@ -535,12 +541,22 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                             ExecutionMode execution_mode, const bool& terminate_flag,
                             const logging::Logger& logger, bool only_execute_path_to_fetches) {
+  return ExecuteGraph(session_state, feeds_fetches_manager, feeds, fetches, {},
+                      execution_mode, terminate_flag, logger, only_execute_path_to_fetches);
+}
+
+common::Status ExecuteGraph(const SessionState& session_state,
+                            FeedsFetchesManager& feeds_fetches_manager,
+                            const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                            ExecutionMode execution_mode, const bool& terminate_flag,
+                            const logging::Logger& logger, bool only_execute_path_to_fetches) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
 
-  auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                                  execution_mode, terminate_flag, logger, only_execute_path_to_fetches);
 
   return status;
@@ -609,12 +625,18 @@ common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetch
 }
 #endif
 
+SubgraphExecutionCache::SubgraphExecutionCache() = default;
+
+// defined here so 'frame' can be destroyed using the full ExecutionFrame definition
+SubgraphExecutionCache::~SubgraphExecutionCache() = default;
+
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
-                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger) {
+                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                               SubgraphExecutionCache* cache) {
   auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
-                                 execution_mode, terminate_flag, logger);
+                                 execution_mode, terminate_flag, logger, false, cache);
   return status;
 }
 
@@ -21,6 +21,7 @@ std::ostream& operator<<(std::ostream& out, const TensorProto& tensor_proto);
 }  // namespace ONNX_NAMESPACE
 
 namespace onnxruntime {
+class ExecutionFrame;
 class ExecutionProviders;
 struct FeedsFetchesInfo;
 class FeedsFetchesManager;
@@ -74,18 +75,42 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
                             ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
                             bool only_execute_path_to_fetches = false);
 
+// Execute the main graph, allocating the fetches at the indexes in fetch_allocators with the custom allocators when
+// they are not pre-allocated.
+common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
+                            const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                            ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                            bool only_execute_path_to_fetches = false);
+
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                                    const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                    const logging::Logger& logger, PartialGraphExecutionState& state);
 #endif
 
+// State that is re-used when the same subgraph is executed repeatedly by a control flow node, e.g. once per
+// iteration of a Loop or Scan. The ExecutionFrame is reset instead of being re-created for each execution.
+// An instance must only be used with a single FeedsFetchesManager and must not be shared between concurrent
+// executions, so it should be scoped to a single Compute call of the control flow kernel.
+struct SubgraphExecutionCache {
+  SubgraphExecutionCache();
+  ~SubgraphExecutionCache();
+
+  std::unique_ptr<ExecutionFrame> frame;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SubgraphExecutionCache);
+};
+
 // Execute a subgraph. The feeds_fetches_manager should have been finalized prior to calling this function.
 // See IControlFlowNode::SetupSubgraphExecutionInfo usage in the control flow kernels.
+// If cache is provided it is used to avoid re-creating the execution state when the subgraph is executed repeatedly.
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
-                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger);
+                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                               SubgraphExecutionCache* cache = nullptr);
 
 template <typename T>
 constexpr ONNXTensorElementDataType GetONNXTensorElementDataType() {
@@ -316,7 +316,10 @@ void AttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int p
           fail_shape_inference("Inputs 4 shall be 5 dimensions");
         }
 
-        if (past_dims[3].has_dim_value() && input_dims[1].has_dim_value()) {
+        if (getAttribute(ctx, "past_present_share_buffer", static_cast<int64_t>(0)) != 0) {
+          // present shares the max sequence length buffer of past
+          propagateShapeFromInputToOutput(ctx, past_input_index, 1);
+        } else if (past_dims[3].has_dim_value() && input_dims[1].has_dim_value()) {
           auto all_sequence_length = past_shape.dim(3).dim_value() + input_shape.dim(1).dim_value();
 
           ONNX_NAMESPACE::TensorShapeProto present_shape;
@@ -342,6 +345,11 @@ where value of each element is the end position, or valid length of actual seque
 left-side padding, mask_index has shape (2 * batch_size), where the values are the exclusive end positions followed by
 the inclusive start positions. When unidirectional is 1, and each token only attend to previous tokens. For GPT-2, both past
 and present state are optional. Present state could appear in output even when past state is not in input.
+
+When past_present_share_buffer is 1, past and present are buffers with shape (2, batch_size, num_heads, max_sequence_length, head_size)
+and the number of valid positions in past is given by the past_sequence_length input. Only the key and value of the new tokens
+are written to present, after the past_sequence_length positions. Present can be the same buffer as past (for example by binding
+both to the same OrtValue with IOBinding), so that a decoding step does not copy the previous keys and values.
 )DOC";
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(Attention)
@@ -353,14 +361,22 @@ and present state are optional. Present state could appear in output even when p
             "Whether every token can only attend to previous tokens. Default value is 0.",
             AttributeProto::INT,
             static_cast<int64_t>(0))
+      .Attr("past_present_share_buffer",
+            "Whether past and present share a buffer of max_sequence_length positions. Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, input_hidden_size)", "T")
       .Input(1, "weight", "2D input tensor with shape (input_hidden_size, 3 * hidden_size), where hidden_size = num_heads * head_size", "T")
       .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
       .Input(3, "mask_index", "Attention mask with shape (batch_size, 1, max_sequence_length, max_sequence_length), (batch_size, past_sequence_length + sequence_length)"
                 "or (batch_size, sequence_length, past_sequence_length + sequence_length), or index with shape (batch_size) or (2 * batch_size).", "M", OpSchema::Optional)
-      .Input(4, "past", "past state for key and value with shape (2, batch_size, num_heads, past_sequence_length, head_size).", "T", OpSchema::Optional)
+      .Input(4, "past", "past state for key and value with shape (2, batch_size, num_heads, past_sequence_length, head_size)"
+                " or (2, batch_size, num_heads, max_sequence_length, head_size) when past_present_share_buffer is 1.", "T", OpSchema::Optional)
+      .Input(5, "past_sequence_length", "Scalar with the number of valid positions in past. Required when past_present_share_buffer is 1.",
+             "M", OpSchema::Optional)
       .Output(0, "output", "3D output tensor with shape (batch_size, append_length, hidden_size)", "T")
-      .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)", "T", OpSchema::Optional)
+      .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)"
+                " or the shape of past when past_present_share_buffer is 1.", "T", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
       .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask index to integer types")
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
@@ -377,6 +393,11 @@ and present state are optional. Present state could appear in output even when p
             "Whether every token can only attend to previous tokens. Default value is 0.",
             AttributeProto::INT,
             static_cast<int64_t>(0))
+      .Attr("quantize_attention",
+            "Whether to quantize Q, K, V and the attention probs to 8 bits, and compute the attention with integer "
+            "matrix multiplications. It is faster but less accurate, and ignored with past state. Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(
           0,
           "input",
@@ -597,17 +618,220 @@ GELU (Gaussian Error Linear Unit) approximation: Y=0.5*X*(1+tanh(0.797885*X+0.03
       .SinceVersion(1)
       .SetDoc("Skip and Layer Normalization Fusion")
       .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, kDefaultSkipLayerNormEpsilon)
-      .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, hidden_size)", "T")
-      .Input(1, "skip", "3D skip tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+      .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, hidden_size), or 2D with shape (token_count, hidden_size)"
+                " when the padding has been removed by RemovePadding", "T")
+      .Input(1, "skip", "skip tensor with the shape of input", "T")
       .Input(2, "gamma", "1D input tensor with shape (hidden_size)", "T")
       .Input(3, "beta", "1D skip tensor with shape (hidden_size", "T", OpSchema::Optional)
       .Input(4, "bias", "1D bias tensor with shape (hidden_size", "T", OpSchema::Optional)
-      .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+      .Output(0, "output", "output tensor with the shape of input", "T")
       .Output(1, "mean", "Saved mean used during training to speed up gradient computation", "U", OpSchema::Optional)
       .Output(2, "inv_std_var", "Saved inverse standard variance used during training to speed up gradient computation.", "U", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float or half tensors.")
       .TypeConstraint("U", {"tensor(float)"}, "Constrain mean and inv_std_var to float tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
+  static const char* RemovePadding_ver1_doc = R"DOC(
+Removes the padding of a batch with right-side padding, so that the following token-wise operators (MatMul, SkipLayerNormalization,
+FastGelu and so on) and PackedAttention compute only on the tokens of the sequences. The number of tokens of each sequence is given
+by sequence_token_count, like the mask_index output of EmbedLayerNormalization.
+The token_offset output lists the positions (b * sequence_length + s) of the token_count tokens of the batch in order, followed by
+those of the padding, and is used by RestorePadding to get back the padded layout. The cumulative_sequence_length output holds the
+index of the first token of each sequence in the output, with token_count at the end.
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(RemovePadding)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(RemovePadding_ver1_doc)
+      .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+      .Input(1, "sequence_token_count", "1D tensor with shape (batch_size) with the number of tokens of each sequence", "M")
+      .Output(0, "output", "2D output tensor with shape (token_count, hidden_size)", "T")
+      .Output(1, "token_offset", "2D tensor with shape (batch_size, sequence_length)", "M")
+      .Output(2, "cumulative_sequence_length", "1D tensor with shape (batch_size + 1)", "M")
+      .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("M", {"tensor(int32)"}, "Constrain sequence_token_count and the offsets to integer types")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        propagateElemTypeFromInputToOutput(ctx, 1, 1);
+        propagateElemTypeFromInputToOutput(ctx, 1, 2);
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        auto& input_shape = getInputShape(ctx, 0);
+        if (input_shape.dim_size() != 3) {
+          fail_shape_inference("input shall be 3 dimensions");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        output_shape.add_dim();
+        *output_shape.add_dim() = input_shape.dim(2);
+        updateOutputShape(ctx, 0, output_shape);
+
+        ONNX_NAMESPACE::TensorShapeProto token_offset_shape;
+        *token_offset_shape.add_dim() = input_shape.dim(0);
+        *token_offset_shape.add_dim() = input_shape.dim(1);
+        updateOutputShape(ctx, 1, token_offset_shape);
+
+        ONNX_NAMESPACE::TensorShapeProto cumulative_shape;
+        auto* cumulative_dim = cumulative_shape.add_dim();
+        if (input_shape.dim(0).has_dim_value()) {
+          cumulative_dim->set_dim_value(input_shape.dim(0).dim_value() + 1);
+        }
+        updateOutputShape(ctx, 2, cumulative_shape);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(RestorePadding)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc("Restores the padded layout of a tensor from which RemovePadding removed the padding. The padding is filled with zeros.")
+      .Input(0, "input", "2D input tensor with shape (token_count, hidden_size)", "T")
+      .Input(1, "token_offset", "2D tensor with shape (batch_size, sequence_length) output by RemovePadding", "M")
+      .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+      .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("M", {"tensor(int32)"}, "Constrain token_offset to integer types")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+          return;
+        }
+
+        auto& input_shape = getInputShape(ctx, 0);
+        auto& token_offset_shape = getInputShape(ctx, 1);
+        if (input_shape.dim_size() != 2 || token_offset_shape.dim_size() != 2) {
+          fail_shape_inference("input and token_offset shall be 2 dimensions");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        *output_shape.add_dim() = token_offset_shape.dim(0);
+        *output_shape.add_dim() = token_offset_shape.dim(1);
+        *output_shape.add_dim() = input_shape.dim(1);
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
+  static const char* PackedAttention_ver1_doc = R"DOC(
+Bidirectional Multi-Head Self Attention of a batch without padding, like Attention with a 1D mask_index of the sequence lengths.
+The input holds the token_count tokens of the batch one after the other, as output by RemovePadding, and no compute is spent on
+the padding. token_offset and cumulative_sequence_length are the outputs of RemovePadding.
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(PackedAttention)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(PackedAttention_ver1_doc)
+      .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+      .Input(0, "input", "2D input tensor with shape (token_count, input_hidden_size)", "T")
+      .Input(1, "weight", "2D input tensor with shape (input_hidden_size, 3 * hidden_size), where hidden_size = num_heads * head_size", "T")
+      .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
+      .Input(3, "token_offset", "2D tensor with shape (batch_size, sequence_length)", "M")
+      .Input(4, "cumulative_sequence_length", "1D tensor with shape (batch_size + 1)", "M")
+      .Output(0, "output", "2D output tensor with shape (token_count, hidden_size)", "T")
+      .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("M", {"tensor(int32)"}, "Constrain the offsets to integer types")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 2)) {
+          return;
+        }
+
+        auto& input_shape = getInputShape(ctx, 0);
+        auto& bias_shape = getInputShape(ctx, 2);
+        if (input_shape.dim_size() != 2 || bias_shape.dim_size() != 1) {
+          fail_shape_inference("input shall be 2 dimensions and bias shall be 1 dimension");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        *output_shape.add_dim() = input_shape.dim(0);
+        auto* hidden_dim = output_shape.add_dim();
+        if (bias_shape.dim(0).has_dim_value()) {
+          hidden_dim->set_dim_value(bias_shape.dim(0).dim_value() / 3);
+        }
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
+  static const char* BeamSearch_ver1_doc = R"DOC(
+Beam search for text generation with a GPT-2 style decoder. The decoder subgraph is run once per generated token
+within a single call, and its past state stays on the device it is consumed on between the steps.
+Greedy search is beam search with num_beams of 1.
+
+The decoder subgraph has the inputs input_ids, position_ids and attention_mask (int32 tensors with shape
+(batch_size * num_beams, sequence_length), or (batch_size * num_beams, past_sequence_length + sequence_length) for
+attention_mask) followed by the past state of each layer (float tensor with shape
+(2, batch_size * num_beams, num_heads, past_sequence_length, head_size), with known num_heads and head_size).
+Its outputs are logits (float tensor with shape (batch_size * num_beams, sequence_length, vocab_size)) followed by
+the present state of each layer.
+
+The scores of the next tokens are log_softmax(logits / temperature), with end of sentence banned before min_length,
+the repetition penalty applied to the tokens already generated and the tokens that would repeat an n-gram of
+no_repeat_ngram_size banned. A finished hypothesis is scored by its sum of log probabilities divided by
+length ^ length_penalty.
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(BeamSearch)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(BeamSearch_ver1_doc)
+      .Attr("eos_token_id", "The id of the end-of-sequence token", AttributeProto::INT)
+      .Attr("pad_token_id", "The id of the padding token", AttributeProto::INT)
+      .Attr("no_repeat_ngram_size", "no repeat ngrams size. Default value is 0.", AttributeProto::INT,
+            static_cast<int64_t>(0))
+      .Attr("early_stopping",
+            "Whether to stop a batch entry once it has num_beams finished hypotheses. Default value is 0.",
+            AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("decoder", "The GPT-2 style decoder subgraph run for each generated token.", AttributeProto::GRAPH)
+      .Input(0, "input_ids", "The sequence used as a prompt for the generation, with shape (batch_size, sequence_length)", "I")
+      .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
+      .Input(2, "min_length", "The minimum length below which the end of sentence cannot be generated. Shape is (1)", "I", OpSchema::Optional)
+      .Input(3, "num_beams", "Number of beams for beam search. 1 means no beam search. Shape is (1)", "I")
+      .Input(4, "num_return_sequences", "The number of returned sequences in the batch, not greater than num_beams. Shape is (1)", "I")
+      .Input(5, "temperature", "The value used to module the next token probabilities. Default value is 1. Shape is (1)", "T", OpSchema::Optional)
+      .Input(6, "length_penalty", "Exponential penalty to the length. Default value is 1. Shape is (1)", "T", OpSchema::Optional)
+      .Input(7, "repetition_penalty", "The parameter for repetition penalty. 1.0 means no penalty. Default value is 1. Shape is (1)", "T", OpSchema::Optional)
+      .Output(0, "sequences", "Word IDs of generated sequences with shape (batch_size, num_return_sequences, max_length)", "I")
+      .Output(1, "sequences_scores", "Final beam score of the generated sequences with shape (batch_size, num_return_sequences)", "T", OpSchema::Optional)
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain scores and penalties to float tensors.")
+      .TypeConstraint("I", {"tensor(int32)"}, "Constrain token ids and lengths to integer tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // run inferencing on the decoder subgraph with the types it declares for its inputs
+        auto* graph_inferencer = ctx.getGraphAttributeInferencer("decoder");
+        const auto* decoder = ctx.getAttribute("decoder");
+        if (graph_inferencer != nullptr && decoder != nullptr && decoder->has_g()) {
+          std::vector<const TypeProto*> subgraph_input_types;
+          for (const auto& input : decoder->g().input()) {
+            subgraph_input_types.push_back(&input.type());
+          }
+          std::vector<const TensorProto*> input_data(subgraph_input_types.size(), nullptr);
+          graph_inferencer->doInferencing(subgraph_input_types, input_data);
+        }
+
+        updateOutputElemType(ctx, 0, TensorProto::INT32);
+        if (ctx.getNumOutputs() > 1) {
+          updateOutputElemType(ctx, 1, TensorProto::FLOAT);
+        }
+
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        auto& input_ids_shape = getInputShape(ctx, 0);
+        if (input_ids_shape.dim_size() != 2) {
+          fail_shape_inference("Inputs 0 shall be 2 dimensions");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto sequences_shape;
+        *sequences_shape.add_dim() = input_ids_shape.dim(0);
+        sequences_shape.add_dim();
+        sequences_shape.add_dim();
+        updateOutputShape(ctx, 0, sequences_shape);
+
+        if (ctx.getNumOutputs() > 1) {
+          ONNX_NAMESPACE::TensorShapeProto sequences_scores_shape;
+          *sequences_scores_shape.add_dim() = input_ids_shape.dim(0);
+          sequences_scores_shape.add_dim();
+          updateOutputShape(ctx, 1, sequences_scores_shape);
+        }
+      });
 }
 
 void RegisterContribSchemas() {
@@ -1699,6 +1923,96 @@ Matrix product that behaves like numpy.matmul: https://docs.scipy.org/doc/numpy-
         FusedMatMulShapeInference(ctx);
       });
 
+  static const char* GroupedMatMul_doc = R"DOC(
+Computes Y_i = MatMul(A, B_i) for a list of 2-D matrices B_i that share the same input A.
+All the matrix products are dispatched to the thread pool together, which is faster than
+running them as separate MatMul nodes when the individual products are small.
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GroupedMatMul)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Input(0, "A", "N-dimensional matrix A", "T")
+      .Input(1, "B", "2-dimensional matrices B_i, all with the same number of rows", "T", OpSchema::Variadic)
+      .Output(0, "Y", "Matrix multiply results, one for each B_i", "T", OpSchema::Variadic)
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .SetDoc(GroupedMatMul_doc)
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        if (ctx.getNumOutputs() != ctx.getNumInputs() - 1) {
+          fail_shape_inference("GroupedMatMul must have one output for each input B");
+        }
+        for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+          propagateElemTypeFromInputToOutput(ctx, 0, i);
+        }
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+        const auto& a_shape = getInputShape(ctx, 0);
+        if (a_shape.dim_size() < 1) {
+          fail_shape_inference("Input A must have at least 1 dimension");
+        }
+        for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+          if (!hasInputShape(ctx, i + 1)) {
+            continue;
+          }
+          const auto& b_shape = getInputShape(ctx, i + 1);
+          if (b_shape.dim_size() != 2) {
+            fail_shape_inference("Input B must be 2-dimensional");
+          }
+          const auto& k_dim = a_shape.dim(a_shape.dim_size() - 1);
+          if (k_dim.has_dim_value() && b_shape.dim(0).has_dim_value() &&
+              k_dim.dim_value() != b_shape.dim(0).dim_value()) {
+            fail_shape_inference("Incompatible dimensions for matrix multiplication");
+          }
+          ONNX_NAMESPACE::TensorShapeProto y_shape;
+          for (int d = 0; d < a_shape.dim_size() - 1; ++d) {
+            *y_shape.add_dim() = a_shape.dim(d);
+          }
+          *y_shape.add_dim() = b_shape.dim(1);
+          updateOutputShape(ctx, i, y_shape);
+        }
+      });
+
+  static const char* FusedElementwise_doc = R"DOC(
+Computes a fused graph of elementwise operators in a single pass over the output.
+The inputs are broadcast to the output shape following the numpy broadcasting rules.
+The values of the program are numbered: the inputs come first, followed by the result of
+each operator in `ops`. Operator i reads the values `operands[2 * i]` and, if it is a binary
+operator, `operands[2 * i + 1]`, and the output Y is the result of the last operator.
+Supported operators: Add, Sub, Mul, Div, Abs, Erf, Exp, Log, Neg, Reciprocal, Relu, Sigmoid,
+Sqrt and Tanh.
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr("ops", "The elementwise operators, in evaluation order.", AttributeProto::STRINGS)
+      .Attr("operands", "The indices of the two values each operator reads. The second index of a unary operator is ignored.",
+            AttributeProto::INTS)
+      .Input(0, "inputs", "The inputs of the fused operators.", "T", OpSchema::Variadic)
+      .Output(0, "Y", "The result of the last operator.", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(float16)", "tensor(float)"},
+          "Constrain input and output types to float or half tensors.")
+      .SetDoc(FusedElementwise_doc)
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        std::vector<const ONNX_NAMESPACE::TensorShapeProto*> shapes;
+        for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+          if (!hasInputShape(ctx, i)) {
+            return;
+          }
+          shapes.push_back(&getInputShape(ctx, i));
+        }
+        multidirectionalBroadcastShapeInference(
+            shapes,
+            *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(MurmurHash3)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1801,6 +2115,63 @@ Example 4:
   output  = [[[2,3]],[[4,5]]]
 )DOC");
 
+  static const char* EmbeddingBag_doc = R"DOC(
+Looks up the rows of `data` selected by `indices` and sums or averages them over the last axis of `indices`,
+without materializing the gathered rows. It computes the same result as Gather(data, indices, axis=0)
+followed by ReduceSum or ReduceMean over axis q - 1, where q is the rank of `indices`, and is used for the
+embedding bags of recommendation models.
+Example:
+  data    = [[1,2],[3,4],[5,6]]
+  indices = [[0,2],[1,1]]
+  mode    = "sum"
+  output  = [[6,8],[6,8]]
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(EmbeddingBag)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr("mode", "How the rows of a bag are combined, 'sum' or 'mean'.", AttributeProto::STRING,
+            std::string("sum"))
+      .Attr("keepdims", "Keep the reduced axis of `indices` with size 1 in the output.", AttributeProto::INT,
+            static_cast<int64_t>(0))
+      .Input(0, "data", "Embedding table of rank r >= 1.", "T")
+      .Input(1, "indices", "Tensor of rank q >= 1 holding the rows of each bag along its last axis.", "Tind")
+      .Output(0, "output",
+              "Tensor of rank q - 1 + r, or q + r if keepdims is set, with shape "
+              "indices.shape[:-1] + data.shape[1:].",
+              "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .TypeConstraint(
+          "Tind",
+          {"tensor(int32)", "tensor(int64)"},
+          "Constrain indice type to int32 or int64")
+      .SetDoc(EmbeddingBag_doc)
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasNInputShapes(ctx, 2)) {
+          return;
+        }
+        const auto& data_shape = getInputShape(ctx, 0);
+        const auto& indices_shape = getInputShape(ctx, 1);
+        if (data_shape.dim_size() < 1 || indices_shape.dim_size() < 1) {
+          fail_shape_inference("both data and indices tensor need to have rank larger than zero.");
+        }
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+          *output_shape.add_dim() = indices_shape.dim(i);
+        }
+        if (getAttribute(ctx, "keepdims", 0) != 0) {
+          output_shape.add_dim()->set_dim_value(1);
+        }
+        for (int i = 1; i < data_shape.dim_size(); ++i) {
+          *output_shape.add_dim() = data_shape.dim(i);
+        }
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(WordConvEmbedding)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
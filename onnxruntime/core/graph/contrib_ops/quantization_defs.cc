@@ -28,6 +28,13 @@ using ONNX_NAMESPACE::InferenceContext;
 using ONNX_NAMESPACE::OpSchema;
 using ONNX_NAMESPACE::OPTIONAL_VALUE;
 
+void convPoolShapeInferenceNhwc(
+    ONNX_NAMESPACE::InferenceContext& ctx,
+    bool use_dilation,
+    bool require_kernel_shape,
+    int input1Idx,
+    int input2Idx);
+
 void ValidateTypeAndShapeForScaleAndZP(ONNX_NAMESPACE::InferenceContext& ctx, int index, ::google::protobuf::int32 expectedType, bool isScalar, int expectedTensorSize = 0) {
   if (ctx.getNumInputs() > static_cast<size_t>(index)) {
     auto data_type = ctx.getInputType(index);
@@ -333,6 +340,12 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
   ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeMatMul)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
+      .Attr("block_size",
+            "If set, B is quantized block-wise along K: 'b_scale' and 'b_zero_point' have the shape "
+            "[ceil(K / block_size), N] and hold the quantization parameters of each block of block_size rows "
+            "of each column of B, e.g. 32, 64 or 128 rows. B must be 2-D.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "A", "N-dimensional matrix A", "T1")
       .Input(1, "B", "N-dimensional matrix B", "T2")
       .Input(
@@ -340,14 +353,16 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
           "b_scale",
           "Scale of quantized input 'B'. It could be a scalar or a 1-D tensor, "
           "which means a per-tensor or per-column quantization. If it's a 1-D tensor, its number "
-          "of elements should be equal to the number of columns of input 'B'.",
+          "of elements should be equal to the number of columns of input 'B'. "
+          "If block_size is set, it is a 2-D tensor with a scale for each block of rows of each column.",
           "T1")
       .Input(
           3,
           "b_zero_point",
           "Zero point tensor for input 'B'. It's optional and default value is 0.  It could be a scalar or a 1-D tensor, "
           "which means a per-tensor or per-column quantization. If it's a 1-D tensor, its number "
-          "of elements should be equal to the number of columns of input 'B'.",
+          "of elements should be equal to the number of columns of input 'B'. "
+          "Otherwise it has the same shape as 'b_scale'.",
           "T2",
           OpSchema::Optional)
       .Input(4,
@@ -372,6 +387,12 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
   ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulIntegerToFloat)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
+      .Attr("block_size",
+            "If set, B is quantized block-wise along K: 'b_scale' and 'b_zero_point' have the shape "
+            "[ceil(K / block_size), N] and hold the quantization parameters of each block of block_size rows "
+            "of each column of B, e.g. 32, 64 or 128 rows. B must be 2-D.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "A", "N-dimensional matrix A", "T1")
       .Input(1, "B", "N-dimensional matrix B", "T2")
       .Input(
@@ -386,7 +407,8 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
           "b_scale",
           "Scale of quantized input 'B'. It could be a scalar or a 1-D tensor, "
           "which means a per-tensor or per-column quantization. If it's a 1-D tensor, its number "
-          "of elements should be equal to the number of columns of input 'B'.",
+          "of elements should be equal to the number of columns of input 'B'. "
+          "If block_size is set, it is a 2-D tensor with a scale for each block of rows of each column.",
           "T3")
       .Input(
           4,
@@ -401,7 +423,8 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
           "b_zero_point",
           "Zero point tensor for input 'B'. It's optional and default value is 0.  It could be a scalar or a 1-D tensor, "
           "which means a per-tensor or per-column quantization. If it's a 1-D tensor, its number "
-          "of elements should be equal to the number of columns of input 'B'.",
+          "of elements should be equal to the number of columns of input 'B'. "
+          "Otherwise it has the same shape as 'b_scale'.",
           "T2",
           OpSchema::Optional)
       .Input(
@@ -428,6 +451,64 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
         ONNX_NAMESPACE::matmulShapeInference(ctx, 0, 1);
       });
 
+  static const char* MatMulNBits_ver1_doc = R"DOC(
+MatMulNBits computes Y = A * dequantize(B) + bias, where the weight B of shape [K, N] is quantized to 'bits' bits
+block-wise along K. Only weights are quantized, A and Y stay in floating point, which cuts the memory traffic
+of the weights of large models to a fraction of their float size.
+
+B is stored column by column, each column of K values split into blocks of 'block_size' rows that share a scale
+and a zero point:
+  B: [N, ceil(K / block_size), block_size * bits / 8] bytes, two 4-bit values per byte, the even row in the
+     low nibble. The last block of a column is padded.
+  scales: [N * ceil(K / block_size)] values, dequantized B = (quantized B - zero point) * scale.
+  zero_points: [N * ceil(ceil(K / block_size) * bits / 8)] bytes, two 4-bit zero points per byte, the even
+     block in the low nibble. If absent, the zero point is 2^(bits - 1).
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulNBits)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(MatMulNBits_ver1_doc)
+      .Attr("K", "Number of rows of the weight B, the size of the last dimension of A.", AttributeProto::INT)
+      .Attr("N", "Number of columns of the weight B, the size of the last dimension of Y.", AttributeProto::INT)
+      .Attr("bits", "Number of bits of each quantized value of B. Only 4 is supported.", AttributeProto::INT,
+            static_cast<int64_t>(4))
+      .Attr("block_size",
+            "Number of rows of B in each quantization block. A power of 2 and at least 16, e.g. 32, 64 or 128.",
+            AttributeProto::INT)
+      .Input(0, "A", "The input tensor, whose last dimension is K.", "T1")
+      .Input(1, "B", "1-D or 3-D quantized weight tensor with the layout described above.", "T2")
+      .Input(2, "scales", "Scale of each block of B.", "T1")
+      .Input(3, "zero_points", "Packed zero point of each block of B.", "T2", OpSchema::Optional)
+      .Input(4, "bias", "1D bias tensor of size N.", "T1", OpSchema::Optional)
+      .Output(0, "Y", "Tensor with the shape of A, except for a last dimension of N.", "T1")
+      .TypeConstraint("T1", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized weight types to uint8.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+        const int64_t bits = getAttribute(ctx, "bits", 4);
+        if (bits != 4) {
+          fail_shape_inference("MatMulNBits only supports 4 bits, got ", bits);
+        }
+
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        const auto& a_shape = getInputShape(ctx, 0);
+        if (a_shape.dim_size() == 0) {
+          fail_shape_inference("Input A of MatMulNBits must not be a scalar");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto y_shape;
+        for (int i = 0; i < a_shape.dim_size() - 1; ++i) {
+          *y_shape.add_dim() = a_shape.dim(i);
+        }
+        y_shape.add_dim()->set_dim_value(getAttribute(ctx, "N", -1));
+        updateOutputShape(ctx, 0, y_shape);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(QLinearAdd)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -625,6 +706,11 @@ Output = Dequantize(Input) -> AveragePool on fp32 data -> Quantize(output)
           "Whether to use ceil or floor (default) to compute the output shape.",
           AttributeProto::INT,
           static_cast<int64_t>(0))
+      .Attr(
+          "channels_last",
+          "Works on NHWC layout or not? Default not.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
       .Input(
           0,
           "X",
@@ -688,7 +774,11 @@ Output = Dequantize(Input) -> AveragePool on fp32 data -> Quantize(output)
         ValidateTypeAndShapeForScaleAndZP(ctx, 3, ONNX_NAMESPACE::TensorProto::FLOAT, true);
         ValidateTypeAndShapeForScaleAndZP(ctx, 4, data_type->tensor_type().elem_type(), true);
 
-        ONNX_NAMESPACE::convPoolShapeInference(ctx, false, true, 0, 5);
+        if (getAttribute(ctx, "channels_last", 0) == 0) {
+          ONNX_NAMESPACE::convPoolShapeInference(ctx, false, true, 0, 5);
+        } else {
+          convPoolShapeInferenceNhwc(ctx, false, true, 0, 5);
+        }
       });
 
   const char* QLinearLeakyReluDoc_ver1 = R"DOC(
@@ -751,6 +841,41 @@ Wwhere the function `Sigmoid(x) = 1 / (1 + exp(-x))` )DOC";
           "Constrain input and output types to 8 bit tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 
+  const char* QLinearSoftmaxDoc_ver1 = R"DOC(
+QLinearSoftmax takes quantized input data (Tensor), and quantize parameter for output, and produces one output data
+(Tensor<T>) where the function `f(x) = quantize(Softmax(dequantize(x)))` is computed along the axis `axis`,
+with the semantics of Softmax-13: each slice of the input along the axis is normalized separately.
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(QLinearSoftmax)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(QLinearSoftmaxDoc_ver1)
+      .Attr("axis",
+            "The dimension Softmax will be performed on. "
+            "Negative value means counting dimensions from the back. "
+            "Accepted range is [-r, r-1] where r = rank(input).",
+            AttributeProto::INT, static_cast<int64_t>(-1))
+      .Input(0, "X", "Input tensor", "T")
+      .Input(1, "X_scale",
+             "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(2, "X_zero_point",
+             "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Input(3, "Y_scale",
+             "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(4, "Y_zero_point",
+             "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Output(0, "Y", "Output tensor", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(uint8)", "tensor(int8)"},
+          "Constrain input and output types to 8 bit tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeLSTM)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -928,6 +1053,159 @@ Wwhere the function `Sigmoid(x) = 1 / (1 + exp(-x))` )DOC";
           "Constrain weights types to 8 bit tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::RNNShapeInference);
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeGRU)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "direction",
+          "Specify if the RNN is forward, reverse, or bidirectional. "
+          "Must be one of forward (default), reverse, or bidirectional.",
+          AttributeProto::STRING,
+          std::string("forward"))
+      .Attr(
+          "hidden_size",
+          "Number of neurons in the hidden layer",
+          AttributeProto::INT,
+          OPTIONAL_VALUE)
+      .Attr(
+          "activation_alpha",
+          "Optional scaling values used by some activation functions. The values "
+          "are consumed in the order of activation functions, for example (f, g) "
+          "in GRU. Default values are the same as of corresponding ONNX operators."
+          "For example with LeakyRelu, the default alpha is 0.01.",
+          AttributeProto::FLOATS,
+          OPTIONAL_VALUE)
+      .Attr(
+          "activation_beta",
+          "Optional scaling values used by some activation functions. The values "
+          "are consumed in the order of activation functions, for example (f, g) "
+          "in GRU. Default values are the same as of corresponding ONNX operators.",
+          AttributeProto::FLOATS,
+          OPTIONAL_VALUE)
+      .Attr(
+          "clip",
+          "Cell clip threshold. Clipping bounds the elements of a tensor "
+          "in the range of [-threshold, +threshold] and is applied to the input "
+          "of activations. No clip if not specified.",
+          AttributeProto::FLOAT,
+          OPTIONAL_VALUE)
+      .Attr(
+          "activations",
+          "A list of 2 (or 4 if bidirectional) activation functions "
+          "for update, reset, and hidden gates. The activation functions must "
+          "be one of the activation functions specified above. Optional: See the equations "
+          "for default if not specified.",
+          AttributeProto::STRINGS,
+          OPTIONAL_VALUE)
+      .Attr(
+          "linear_before_reset",
+          "When computing the output of the hidden gate, "
+          "apply the linear transformation before multiplying by the output of the "
+          "reset gate.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Input(
+          0,
+          "X",
+          "The input sequences packed (and potentially padded) into one 3-D "
+          "tensor with the shape of `[seq_length, batch_size, input_size]`.",
+          "T")
+      .Input(
+          1,
+          "W",
+          "The weight tensor for the gates. Concatenation of `W[zrh]` and "
+          "`WB[zrh]` (if bidirectional) along dimension 0. The tensor has shape "
+          "`[num_directions, input_size, 3*hidden_size]`.",
+          "T2")
+      .Input(
+          2,
+          "R",
+          "The recurrence weight tensor. Concatenation of `R[zrh]` and "
+          "`RB[zrh]` (if bidirectional) along dimension 0. This tensor has shape "
+          "`[num_directions, hidden_size, 3*hidden_size]`.",
+          "T2")
+      .Input(
+          3,
+          "B",
+          "The bias tensor for the gates. Concatenation of `[Wb[zrh], Rb[zrh]]` and "
+          "`[WBb[zrh], RBb[zrh]]` (if bidirectional) along dimension 0. This tensor "
+          "has shape `[num_directions, 6*hidden_size]`. Optional: If not specified "
+          "- assumed to be 0",
+          "T",
+          OpSchema::Optional)
+      .Input(
+          4,
+          "sequence_lens",
+          "Optional tensor specifying lengths of the sequences in a batch. "
+          "If not specified - assumed all sequences in the batch to have "
+          "length `seq_length`. It has shape `[batch_size]`.",
+          "T1",
+          OpSchema::Optional)
+      .Input(
+          5,
+          "initial_h",
+          "Optional initial value of the hidden. If not specified - assumed "
+          "to be 0. It has shape `[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .Input(
+          6,
+          "W_scale",
+          "W's scale. Its size is [num_directions] for per-tensor/layer quantization, "
+          "or [num_directions, 3*hidden_size] for per-channel quantization on the axis input_size.",
+          "T")
+      .Input(
+          7,
+          "W_zero_point",
+          "W's zero point. Its size is [num_directions] for per-tensor/layer quantization, "
+          "or [num_directions, 3*hidden_size] for per-channel quantization on the axis input_size.",
+          "T2")
+      .Input(
+          8,
+          "R_scale",
+          "R's scale. Its size is [num_directions] for per-tensor/layer quantization, "
+          "or [num_directions, 3*hidden_size] for per-channel quantization on the axis input_size.",
+          "T")
+      .Input(
+          9,
+          "R_zero_point",
+          "R's zero point. Its size is [num_directions] for per-tensor/layer quantization, "
+          "or [num_directions, 3*hidden_size] for per-channel quantization on the axis input_size.",
+          "T2")
+      .Output(
+          0,
+          "Y",
+          "A tensor that concats all the intermediate output values of the hidden. "
+          "It has shape `[seq_length, num_directions, batch_size, hidden_size]`. ",
+          "T",
+          OpSchema::Optional,
+          true,
+          1,
+          OpSchema::Differentiable)
+      .Output(
+          1,
+          "Y_h",
+          "The last output value of the hidden. It has shape "
+          "`[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional,
+          true,
+          1,
+          OpSchema::Differentiable)
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .TypeConstraint(
+          "T1",
+          {"tensor(int32)"},
+          "Constrain seq_lens to integer tensor.")
+      .TypeConstraint(
+          "T2",
+          {"tensor(uint8)", "tensor(int8)"},
+          "Constrain weights types to 8 bit tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::RNNShapeInference);
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(QLinearConcat)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -6,6 +6,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <atomic>
 #include <cassert>
 #include <fstream>
 #include <iostream>
@@ -135,8 +136,15 @@ static TypeProto TypeProtoFromTensorProto(const TensorProto& tensor) {
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+// Versions are unique across all NodeArgs, so a version identifies both the NodeArg and the state of its type.
+static size_t NextNodeArgTypeVersion() {
+  static std::atomic<size_t> version{0};
+  return ++version;
+}
+
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
-NodeArg::NodeArg(const std::string& name, const TypeProto* p_node_arg_type) {
+NodeArg::NodeArg(const std::string& name, const TypeProto* p_node_arg_type)
+    : type_version_(NextNodeArgTypeVersion()) {
   node_arg_info_.set_name(name);
   // If the name is empty, it means the arg does not exist.
   exists_ = !(name.empty());
@@ -154,7 +162,8 @@ NodeArg::NodeArg(const std::string& name, const TypeProto* p_node_arg_type) {
 }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
-NodeArg::NodeArg(NodeArgInfo&& node_arg_info) {
+NodeArg::NodeArg(NodeArgInfo&& node_arg_info)
+    : type_version_(NextNodeArgTypeVersion()) {
   node_arg_info_ = std::move(node_arg_info);
 
   exists_ = !node_arg_info_.name().empty();
@@ -227,15 +236,43 @@ bool NodeArg::HasTensorOrScalarShape() const {
 }
 
 #if !defined(ORT_MINIMAL_BUILD)
+static bool ShapesEqual(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
+  if (shape1.dim_size() != shape2.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0, end = shape1.dim_size(); i < end; ++i) {
+    const auto& dim1 = shape1.dim(i);
+    const auto& dim2 = shape2.dim(i);
+    if (dim1.value_case() != dim2.value_case() || dim1.denotation() != dim2.denotation() ||
+        (utils::HasDimValue(dim1) && dim1.dim_value() != dim2.dim_value()) ||
+        (utils::HasDimParam(dim1) && dim1.dim_param() != dim2.dim_param())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void NodeArg::SetShape(const TensorShapeProto& shape) {
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
-    case TypeProto::kTensorType:
-      *(node_arg_info_.mutable_type()->mutable_tensor_type()->mutable_shape()) = shape;
+    case TypeProto::kTensorType: {
+      auto& tensor_type = *node_arg_info_.mutable_type()->mutable_tensor_type();
+      if (!utils::HasShape(tensor_type) || !ShapesEqual(tensor_type.shape(), shape)) {
+        *tensor_type.mutable_shape() = shape;
+        type_version_ = NextNodeArgTypeVersion();
+      }
       break;
-    case TypeProto::kSparseTensorType:
-      *(node_arg_info_.mutable_type()->mutable_sparse_tensor_type()->mutable_shape()) = shape;
+    }
+    case TypeProto::kSparseTensorType: {
+      auto& tensor_type = *node_arg_info_.mutable_type()->mutable_sparse_tensor_type();
+      if (!utils::HasShape(tensor_type) || !ShapesEqual(tensor_type.shape(), shape)) {
+        *tensor_type.mutable_shape() = shape;
+        type_version_ = NextNodeArgTypeVersion();
+      }
       break;
+    }
     case TypeProto::kSequenceType:
     case TypeProto::kMapType:
     case TypeProto::kOpaqueType:
@@ -249,10 +286,16 @@ void NodeArg::ClearShape() {
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
-      node_arg_info_.mutable_type()->mutable_tensor_type()->clear_shape();
+      if (utils::HasShape(node_arg_info_.type().tensor_type())) {
+        node_arg_info_.mutable_type()->mutable_tensor_type()->clear_shape();
+        type_version_ = NextNodeArgTypeVersion();
+      }
       break;
     case TypeProto::kSparseTensorType:
-      node_arg_info_.mutable_type()->mutable_sparse_tensor_type()->clear_shape();
+      if (utils::HasShape(node_arg_info_.type().sparse_tensor_type())) {
+        node_arg_info_.mutable_type()->mutable_sparse_tensor_type()->clear_shape();
+        type_version_ = NextNodeArgTypeVersion();
+      }
       break;
     case TypeProto::kSequenceType:
     case TypeProto::kMapType:
@@ -268,6 +311,7 @@ common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& inpu
   if (!utils::HasType(node_arg_info_)) {
     *node_arg_info_.mutable_type() = input_type;
     type_ = DataTypeUtils::ToType(node_arg_info_.type());
+    type_version_ = NextNodeArgTypeVersion();
     return Status::OK();
   }
 
@@ -307,9 +351,14 @@ common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& inpu
       if (utils::HasShape(input_tensor_type)) {
         auto& current_tensor_type = *current_type.mutable_tensor_type();
         if (utils::HasShape(current_tensor_type)) {
+          const TensorShapeProto current_shape = current_tensor_type.shape();
           ORT_RETURN_IF_ERROR(MergeShapeInfo(Name(), input_tensor_type, current_tensor_type, strict, logger));
+          if (!utils::HasShape(current_tensor_type) || !ShapesEqual(current_shape, current_tensor_type.shape())) {
+            type_version_ = NextNodeArgTypeVersion();
+          }
         } else {
           current_tensor_type = input_tensor_type;
+          type_version_ = NextNodeArgTypeVersion();
         }
       }
 
@@ -345,6 +394,7 @@ common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& inpu
           // mergeInShapeInfo(input_tensor_type, current_tensor_type);
         } else {
           current_tensor_type = input_tensor_type;
+          type_version_ = NextNodeArgTypeVersion();
         }
       }
     } break;
@@ -375,11 +425,13 @@ void NodeArg::SetType(DataType p_type) {
 
   type_ = p_type;
   *(node_arg_info_.mutable_type()) = DataTypeUtils::ToTypeProto(p_type);
+  type_version_ = NextNodeArgTypeVersion();
 }
 
 void NodeArg::SetType(const TypeProto& type_proto) {
   type_ = DataTypeUtils::ToType(type_proto);
   *(node_arg_info_.mutable_type()) = type_proto;
+  type_version_ = NextNodeArgTypeVersion();
 }
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -677,6 +729,17 @@ void Node::Init(const std::string& name,
                 const std::vector<NodeArg*>& output_args,
                 const NodeAttributes* attributes,
                 const std::string& domain) {
+  Init(name, op_type, description, input_args, output_args,
+       attributes != nullptr ? NodeAttributes(*attributes) : NodeAttributes(), domain);
+}
+
+void Node::Init(const std::string& name,
+                const std::string& op_type,
+                const std::string& description,
+                const std::vector<NodeArg*>& input_args,
+                const std::vector<NodeArg*>& output_args,
+                NodeAttributes&& attributes,
+                const std::string& domain) {
   name_ = name;
   op_type_ = op_type;
   description_ = description;
@@ -693,17 +756,15 @@ void Node::Init(const std::string& name,
   // information.
   definitions_.input_arg_count.assign(input_args.size(), 1);
 
-  if (attributes) {
-    attributes_ = *attributes;
+  attributes_ = std::move(attributes);
 
-    for (auto& name_to_attr : attributes_) {
-      if (utils::HasGraph(name_to_attr.second)) {
+  for (auto& name_to_attr : attributes_) {
+    if (utils::HasGraph(name_to_attr.second)) {
 #if !defined(ORT_MINIMAL_BUILD)
-        CreateSubgraph(name_to_attr.first);
+      CreateSubgraph(name_to_attr.first);
 #else
-        ORT_THROW("Creating node with a subgraph via AddNode is not supported in this build.");
+      ORT_THROW("Creating node with a subgraph via AddNode is not supported in this build.");
 #endif
-      }
     }
   }
 }
@@ -740,6 +801,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 void Node::AddAttribute(const std::string& attr_name, const AttributeProto& value) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  verified_type_versions_.clear();
   attributes_[attr_name] = value;
 }
 
@@ -747,6 +809,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
+    verified_type_versions_.clear();                                         \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
     a.set_type(enumType);                                                    \
@@ -758,6 +821,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
+    verified_type_versions_.clear();                                         \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
     a.set_type(enumType);                                                    \
@@ -770,6 +834,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
                           const std::vector<type>& values) { \
     graph_->SetGraphResolveNeeded();                         \
     graph_->SetGraphProtoSyncNeeded();                       \
+    verified_type_versions_.clear();                         \
     AttributeProto a;                                        \
     a.set_name(attr_name);                                   \
     a.set_type(enumType);                                    \
@@ -782,6 +847,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
 void Node::AddAttribute(const std::string& attr_name, const GraphProto& value) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  verified_type_versions_.clear();
   AttributeProto a;
   a.set_name(attr_name);
   a.set_type(AttributeProto_AttributeType::AttributeProto_AttributeType_GRAPH);
@@ -810,6 +876,7 @@ ADD_LIST_ATTR_IMPL(SparseTensorProto, AttributeProto_AttributeType::AttributePro
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  verified_type_versions_.clear();
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -1096,8 +1163,21 @@ Graph::Graph(const Model& owning_model,
     }
   }
 
-  for (const auto& node_proto : graph_proto_->node()) {
-    AddNode(node_proto, name_to_type_map);
+  if (parent_graph_ == nullptr && graph_proto_->node_size() > 0) {
+    // The NodeProtos of the main graph are moved into the nodes instead of being copied, as their attributes can be
+    // large and a model can have hundreds of thousands of nodes. They are regenerated from the nodes if the
+    // GraphProto is requested. Subgraphs keep them as the ONNX checker reads the subgraph from the node attribute.
+    RepeatedPtrField<NodeProto> node_protos;
+    node_protos.Swap(graph_proto_->mutable_node());
+    node_protos_released_ = true;
+
+    for (auto& node_proto : node_protos) {
+      AddNode(std::move(node_proto), name_to_type_map);
+    }
+  } else {
+    for (const auto& node_proto : graph_proto_->node()) {
+      AddNode(node_proto, name_to_type_map);
+    }
   }
 
   if (is_loaded_from_model_file_) {
@@ -2284,17 +2364,30 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   // and need to call Resolve
   lsc.output_names.insert(outer_scope_node_arg_names_.cbegin(), outer_scope_node_arg_names_.cend());
 
+  // Accumulate output names of the iterated Node
+  auto add_output_names = [&lsc](const Node& node) {
+    for (const auto* output_def : node.OutputDefs()) {
+      lsc.output_names.insert(output_def->Name());
+    }
+  };
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
-    NodeProto node_proto;
-    node.ToProto(node_proto);
+    // only infer the types of the nodes that may have changed since the last Resolve
+    if (NodeTypesAreUpToDate(node)) {
+      add_output_names(node);
+      continue;
+    }
+
     auto& node_name = node.Name();
     auto& domain = node.Domain();
 
     if (!node.Op()) {
       {
+        NodeProto node_proto;
+        node.ToProto(node_proto);
         auto status = Status::OK();
         ORT_TRY {
           checker::check_node(node_proto, ctx, lsc);
@@ -2356,15 +2449,59 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
 
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
 
-    // Accumulate output names of the iterated Node
-    for (auto& output_name : node_proto.output()) {
-      lsc.output_names.insert(output_name);
-    }
+    SetNodeTypesUpToDate(node);
+    add_output_names(node);
   }
 
   return Status::OK();
 }
 
+bool Graph::NodeTypesAreUpToDate(const Node& node) const {
+  const auto& versions = node.verified_type_versions_;
+  const auto& input_defs = node.InputDefs();
+  const auto& output_defs = node.OutputDefs();
+  if (versions.empty() || versions.size() != 1 + input_defs.size() + output_defs.size() ||
+      versions[0] != input_defs.size()) {
+    return false;
+  }
+
+  // the versions are unique across all NodeArgs, so equal versions also mean the NodeArgs are the same
+  size_t i = 1;
+  for (const auto* input_def : input_defs) {
+    if (versions[i++] != input_def->type_version_ || modified_initializer_names_.count(input_def->Name()) != 0) {
+      return false;
+    }
+  }
+
+  for (const auto* output_def : output_defs) {
+    if (versions[i++] != output_def->type_version_) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Graph::SetNodeTypesUpToDate(Node& node) const {
+  auto& versions = node.verified_type_versions_;
+  versions.clear();
+
+  // subgraphs and nodes containing them depend on outer scope values, so they're always inferred
+  if (parent_graph_ != nullptr || node.ContainsSubgraph()) {
+    return;
+  }
+
+  versions.reserve(1 + node.InputDefs().size() + node.OutputDefs().size());
+  versions.push_back(node.InputDefs().size());
+  for (const auto* input_def : node.InputDefs()) {
+    versions.push_back(input_def->type_version_);
+  }
+
+  for (const auto* output_def : node.OutputDefs()) {
+    versions.push_back(output_def->type_version_);
+  }
+}
+
 void Graph::InitFunctionBodyForNode(Node& node) {
   if (node.op_ && (node.op_->HasFunction() || node.op_->HasContextDependentFunction())) {
     onnx::FunctionProto onnx_function_proto;
@@ -2537,11 +2674,13 @@ Status Graph::Resolve(const ResolveOptions& options) {
   // perform the final steps for this graph and all subgraphs
   auto finalize_func = [&options](Graph& graph) {
             graph.CleanUnusedInitializers(options.initializer_names_to_preserve);
+            graph.modified_initializer_names_.clear();
             graph.GraphResolveNeeded(false);
 
             // if we are resolving immediately after loading from a GraphProto, we don't need to
             // do a proto sync
-            if (options.no_proto_sync_required) {
+            // unless the NodeProtos were moved into the nodes when loading.
+            if (options.no_proto_sync_required && !graph.node_protos_released_) {
                 graph.GraphProtoSyncNeeded(false);
             }
 
@@ -2565,6 +2704,7 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   const gsl::not_null<TensorProto*> tensor_added{graph_proto_->add_initializer()};
   *(tensor_added) = tensor;
   name_to_initial_tensor_[tensor.name()] = tensor_added;
+  modified_initializer_names_.insert(tensor.name());
   SetGraphResolveNeeded();
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
@@ -2625,6 +2765,9 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
   if (found) {
     name_to_initial_tensor_.erase(iter);
     sparse_tensor_names_.erase(tensor_name);
+#if !defined(ORT_MINIMAL_BUILD)
+    modified_initializer_names_.insert(tensor_name);
+#endif
     SetGraphResolveNeeded();
   } else {
     ORT_ENFORCE(sparse_tensor_names_.count(tensor_name) == 0, "sparse_tensor_names_ not in sync with name_to_initial_tensor_");
@@ -2676,6 +2819,7 @@ Status Graph::ReplaceInitializedTensor(const ONNX_NAMESPACE::TensorProto& new_in
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
   **existing_entry = new_initializer;
+  modified_initializer_names_.insert(initializer_name);
 
   return Status::OK();
 }
@@ -2796,6 +2940,32 @@ Node& Graph::AddNode(const NodeProto& node_proto,
                  node_proto.domain());
 }
 
+Node& Graph::AddNode(NodeProto&& node_proto,
+                     const ArgNameToTypeMap& name_to_type_map) {
+  auto input_defs = CreateNodeArgs(node_proto.input(), name_to_type_map);
+  auto output_defs = CreateNodeArgs(node_proto.output(), name_to_type_map);
+
+  const int num_attributes = node_proto.attribute_size();
+  NodeAttributes attributes;
+  attributes.reserve(num_attributes);
+
+  for (int i = 0; i < num_attributes; ++i) {
+    auto& attr = *node_proto.mutable_attribute(i);
+    const std::string attr_name = attr.name();
+    attributes[attr_name] = std::move(attr);
+  }
+
+  // CreateNodeArgs has already added the NodeArgs to the graph so they can be used directly
+  const gsl::not_null<Node*> node = AllocateNode();
+  node->Init(node_proto.name(), node_proto.op_type(), node_proto.doc_string(), input_defs, output_defs,
+             std::move(attributes), node_proto.domain());
+  if (0 != node_proto.op_type().compare(kNoOp)) {
+    GraphProtoSyncNeeded(true);
+  }
+
+  return *node;
+}
+
 std::string Graph::GenerateNodeArgName(const std::string& base_name) {
   std::string new_name = base_name;
   // Check if new_name has been used in as any of node_args_' names.
@@ -2824,7 +2994,8 @@ SaveInputsOutputsToOrtFormat(flatbuffers::FlatBufferBuilder& builder, const std:
 }
 
 common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                      flatbuffers::Offset<fbs::Graph>& fbs_graph) const {
+                                      flatbuffers::Offset<fbs::Graph>& fbs_graph,
+                                      bool compress_initializers) const {
   auto inputs = SaveInputsOutputsToOrtFormat(builder, graph_inputs_including_initializers_);
   auto outputs = SaveInputsOutputsToOrtFormat(builder, graph_outputs_);
 
@@ -2841,7 +3012,8 @@ common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     if (sparse_tensor_names_.find(pair.first) == sparse_end) {
       flatbuffers::Offset<fbs::Tensor> fbs_tensor;
       ORT_RETURN_IF_ERROR(
-          experimental::utils::SaveInitializerOrtFormat(builder, *pair.second, model_path, fbs_tensor));
+          experimental::utils::SaveInitializerOrtFormat(builder, *pair.second, model_path, fbs_tensor,
+                                                        compress_initializers));
       initializers_data.push_back(fbs_tensor);
     } else {
       SparseTensorProto sparse_initializer;
@@ -3011,6 +3183,7 @@ const ONNX_NAMESPACE::GraphProto& Graph::ToGraphProto() {
   ToGraphProtoInternal(*graph_proto_);
 
   GraphProtoSyncNeeded(false);
+  node_protos_released_ = false;
 
   return *graph_proto_;
 }
@@ -3646,6 +3819,15 @@ Status Graph::InlineFunction(Node& node) {
 }
 
 void Graph::SetInputs(const std::vector<const NodeArg*>& inputs) {
+  // an initializer that is also a graph input can be overridden, so isn't a constant for the type inferencing
+  for (const auto* input : graph_inputs_including_initializers_) {
+    modified_initializer_names_.insert(input->Name());
+  }
+
+  for (const auto* input : inputs) {
+    modified_initializer_names_.insert(input->Name());
+  }
+
   if (is_loaded_from_model_file_) {
     // graph loaded from model file
     graph_inputs_including_initializers_ = inputs;
@@ -3728,6 +3910,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
 #if !defined(ORT_MINIMAL_BUILD)
                                 IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
+                                bool use_ort_format_bytes_for_initializers,
                                 const logging::Logger& logger, std::unique_ptr<Graph>& graph) {
   // can't use make_unique as we're calling a private ctor
   graph.reset(new Graph(owning_model, domain_to_version,
@@ -3736,7 +3919,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
 #endif
                         nullptr, nullptr, logger));
 
-  ORT_RETURN_IF_ERROR(graph->LoadFromOrtFormat(fbs_graph));
+  ORT_RETURN_IF_ERROR(graph->LoadFromOrtFormat(fbs_graph, use_ort_format_bytes_for_initializers));
 
 #if !defined(ORT_MINIMAL_BUILD)
   // in a full build we need to run Resolve to fully populate ResolveContext and Node::op_,
@@ -3762,7 +3945,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
                         &parent_graph, &parent_node,
                         logger));
 
-  return graph->LoadFromOrtFormat(fbs_graph);
+  return graph->LoadFromOrtFormat(fbs_graph, parent_graph.use_ort_format_bytes_for_initializers_);
 }
 
 Graph::Graph(const Model& owning_model,
@@ -3785,7 +3968,10 @@ Graph::Graph(const Model& owning_model,
       is_loaded_from_model_file_(true) {  // true as the Graph isn't manually constructed from scratch
 }
 
-common::Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs_graph) {
+common::Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs_graph,
+                                        bool use_ort_format_bytes_for_initializers) {
+  use_ort_format_bytes_for_initializers_ = use_ort_format_bytes_for_initializers;
+
   // We deserialize the graph from ORT format in the following order:
   // 1. Deserialize the initializers and sparse initializers. Convert sparse to dense.
   // 2. Deserialize the NodeArgs
@@ -3810,7 +3996,8 @@ common::Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Gr
     for (const auto* fbs_tensor : *fbs_initializers) {
       ORT_RETURN_IF(nullptr == fbs_tensor, "Initializer tensor is missing. Invalid ORT format model.");
       TensorProto* initializer = deserialized_proto_data_.add_initializer();
-      ORT_RETURN_IF_ERROR(experimental::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer));
+      ORT_RETURN_IF_ERROR(experimental::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer,
+                                                                        use_ort_format_bytes_for_initializers));
       auto p = name_to_initial_tensor_.emplace(initializer->name(), initializer);
       if (!p.second) {
         LOGS(logger_, WARNING) << "Duplicate initializer (dense or ConstantNode): '" << initializer->name()
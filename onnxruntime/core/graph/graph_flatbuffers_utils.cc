@@ -4,6 +4,8 @@
 #include <core/graph/graph.h>
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
+#include "core/framework/data_types.h"
+#include "core/framework/tensor_compression.h"
 #include "core/framework/tensorprotoutils.h"
 #include "graph_flatbuffers_utils.h"
 #include "flatbuffers/flatbuffers.h"
@@ -29,13 +31,15 @@ SaveDims(flatbuffers::FlatBufferBuilder& builder, const DimsFieldType& dims) {
 Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                 const TensorProto& initializer,
                                 const Path& model_path,
-                                flatbuffers::Offset<fbs::Tensor>& fbs_tensor) {
+                                flatbuffers::Offset<fbs::Tensor>& fbs_tensor,
+                                bool compress) {
   auto name = SaveStringToOrtFormat(builder, initializer.has_name(), initializer.name());
   auto doc_string = SaveStringToOrtFormat(builder, initializer.has_doc_string(), initializer.doc_string());
   auto dims = SaveDims(builder, initializer.dims());
 
   flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data;
   flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data;
+  auto compression = fbs::TensorCompression::Uncompressed;
 
   auto src_type = initializer.data_type();
   const bool has_string_data = src_type == ONNX_NAMESPACE::TensorProto_DataType_STRING;
@@ -48,7 +52,20 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     size_t tensor_byte_size = 0;
     ORT_RETURN_IF_ERROR(
         onnxruntime::utils::UnpackInitializerData(initializer, model_path, unpacked_tensor, tensor_byte_size));
-    raw_data = builder.CreateVector(unpacked_tensor.get(), tensor_byte_size);
+
+    const size_t element_size = DataTypeImpl::TensorTypeFromONNXEnum(src_type)->GetElementType()->Size();
+    const auto tensor_compression = element_size > 1 ? TensorCompression::ByteShuffleLz4 : TensorCompression::Lz4;
+    std::vector<uint8_t> compressed;
+    if (compress && tensor_byte_size >= kOrtFormatMinCompressedInitializerSize &&
+        CompressTensorData(unpacked_tensor.get(), tensor_byte_size, element_size, tensor_compression, compressed)) {
+      compression = static_cast<fbs::TensorCompression>(tensor_compression);
+      builder.PreAlign(compressed.size(), kOrtFormatRawDataAlignment);
+      raw_data = builder.CreateVector(compressed.data(), compressed.size());
+    } else {
+      // align the data so that a memory mapped model can use it directly for tensors of any element type
+      builder.PreAlign(tensor_byte_size, kOrtFormatRawDataAlignment);
+      raw_data = builder.CreateVector(unpacked_tensor.get(), tensor_byte_size);
+    }
   }
 
   fbs::TensorBuilder tb(builder);
@@ -60,6 +77,8 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     tb.add_string_data(string_data);
   else
     tb.add_raw_data(raw_data);
+  if (compression != fbs::TensorCompression::Uncompressed)
+    tb.add_compression(compression);
   fbs_tensor = tb.Finish();
   return Status::OK();
 }
@@ -178,7 +197,8 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 
 Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
-                                TensorProto& initializer) {
+                                TensorProto& initializer,
+                                bool use_ort_format_bytes) {
   initializer.Clear();
 
   LOAD_STR_FROM_ORT_FORMAT(initializer, name, fbs_tensor.name());
@@ -202,8 +222,32 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
     const auto* fbs_raw_data = fbs_tensor.raw_data();
     ORT_RETURN_IF(nullptr == fbs_raw_data, "Missing raw data for initializer. Invalid ORT format model.");
 
+    const auto compression = fbs_tensor.compression();
+    ORT_RETURN_IF(flatbuffers::IsOutRange(compression, fbs::TensorCompression::MIN, fbs::TensorCompression::MAX),
+                  "Unsupported compression of initializer. Invalid ORT format model.");
+
     // fbs_raw_data is uint8_t vector, so the size is byte size
-    initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
+    if (compression != fbs::TensorCompression::Uncompressed) {
+      if (use_ort_format_bytes) {
+        onnxruntime::utils::SetCompressedExternalDataMemoryAddress(initializer, fbs_raw_data->Data(),
+                                                                   fbs_raw_data->size(),
+                                                                   static_cast<TensorCompression>(compression));
+      } else {
+        size_t tensor_byte_size = 0;
+        ORT_RETURN_IF_ERROR(onnxruntime::utils::GetSizeInBytesFromTensorProto<0>(initializer, &tensor_byte_size));
+        const size_t element_size =
+            DataTypeImpl::TensorTypeFromONNXEnum(initializer.data_type())->GetElementType()->Size();
+        std::string decompressed(tensor_byte_size, '\0');
+        ORT_RETURN_IF_ERROR(DecompressTensorData(fbs_raw_data->Data(), fbs_raw_data->size(), element_size,
+                                                 static_cast<TensorCompression>(compression), &decompressed[0],
+                                                 tensor_byte_size));
+        initializer.set_raw_data(std::move(decompressed));
+      }
+    } else if (use_ort_format_bytes && fbs_raw_data->size() > 0) {
+      onnxruntime::utils::SetExternalDataMemoryAddress(initializer, fbs_raw_data->Data(), fbs_raw_data->size());
+    } else {
+      initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
+    }
   }
 
   return Status::OK();
@@ -34,10 +34,17 @@ struct Tensor;
 
 namespace utils {
 
+// Alignment in bytes of the raw data of initializers in an ORT format model.
+constexpr size_t kOrtFormatRawDataAlignment = 16;
+
+// Initializers smaller than this are not compressed, as the few bytes saved are not worth decompressing them.
+constexpr size_t kOrtFormatMinCompressedInitializerSize = 64 * 1024;
+
+// If compress is true, the raw data is compressed if it saves enough space (see CompressTensorData).
 // TODO, add ORT_MUST_USE_RESULT when it is moved to a different header
 onnxruntime::common::Status SaveInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::TensorProto& initializer,
-    const Path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor);
+    const Path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor, bool compress = false);
 
 onnxruntime::common::Status SaveSparseInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::SparseTensorProto& initializer,
@@ -54,8 +61,11 @@ onnxruntime::common::Status SaveAttributeOrtFormat(
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 
+// If use_ort_format_bytes is true the raw data is not copied. Instead the external data of initializer refers to the
+// address of the data in fbs_tensor, so the ORT format bytes must outlive initializer. Compressed raw data is then
+// only decompressed when it is read, otherwise it is decompressed into the raw data of initializer.
 onnxruntime::common::Status LoadInitializerOrtFormat(
-    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer);
+    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer, bool use_ort_format_bytes = false);
 
 onnxruntime::common::Status LoadSparseInitializerOrtFormat(const fbs::SparseTensor& fbs_sparse_tensor,
                                                            ONNX_NAMESPACE::SparseTensorProto& initializer);
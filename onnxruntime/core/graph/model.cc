@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
 #include <memory>
 #include "core/common/logging/logging.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
@@ -536,6 +537,201 @@ Status Model::LoadFromBytes(int count, void* p_bytes, const PathString& model_pa
   return Status::OK();
 }
 
+namespace {
+
+// Minimal reader of the protobuf wire format, used to find the raw data of the initializers without parsing them.
+class WireFormatReader {
+ public:
+  explicit WireFormatReader(gsl::span<const uint8_t> bytes) : cur_(bytes.data()), end_(bytes.data() + bytes.size()) {}
+
+  bool Done() const { return cur_ == end_; }
+  const uint8_t* Position() const { return cur_; }
+
+  bool ReadVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && cur_ < end_; shift += 7) {
+      const uint8_t byte = *cur_++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Reads the next field. 'payload' is set to the bytes of a length delimited field.
+  bool ReadField(uint32_t& field_number, uint32_t& wire_type, gsl::span<const uint8_t>& payload) {
+    uint64_t tag;
+    if (!ReadVarint(tag)) {
+      return false;
+    }
+
+    field_number = static_cast<uint32_t>(tag >> 3);
+    wire_type = static_cast<uint32_t>(tag & 7);
+    uint64_t value;
+    switch (wire_type) {
+      case 0:  // varint
+        return ReadVarint(value);
+      case 1:  // fixed64
+        return Skip(8);
+      case 2:  // length delimited
+        if (!ReadVarint(value) || value > static_cast<uint64_t>(end_ - cur_)) {
+          return false;
+        }
+        payload = gsl::make_span(cur_, static_cast<size_t>(value));
+        cur_ += value;
+        return true;
+      case 5:  // fixed32
+        return Skip(4);
+      default:  // groups are not used by ONNX
+        return false;
+    }
+  }
+
+ private:
+  bool Skip(size_t num_bytes) {
+    if (num_bytes > static_cast<size_t>(end_ - cur_)) {
+      return false;
+    }
+    cur_ += num_bytes;
+    return true;
+  }
+
+  const uint8_t* cur_;
+  const uint8_t* end_;
+};
+
+constexpr uint32_t kWireTypeLengthDelimited = 2;
+// field numbers in onnx.proto
+constexpr uint32_t kModelProtoGraph = 7;
+constexpr uint32_t kGraphProtoInitializer = 5;
+constexpr uint32_t kTensorProtoRawData = 9;
+
+void AppendVarint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void AppendLengthDelimitedField(std::string& out, uint32_t field_number, const std::string& payload) {
+  AppendVarint(out, (static_cast<uint64_t>(field_number) << 3) | kWireTypeLengthDelimited);
+  AppendVarint(out, payload.size());
+  out.append(payload);
+}
+
+// Copies the fields of 'message' to 'out', calling 'rewrite' for the length delimited fields. 'rewrite' returns
+// false if the field is malformed, and sets 'copy' to false if it has written the field itself.
+template <typename Rewrite>
+bool RewriteMessage(gsl::span<const uint8_t> message, std::string& out, Rewrite rewrite) {
+  WireFormatReader reader(message);
+  while (!reader.Done()) {
+    const uint8_t* field_start = reader.Position();
+    uint32_t field_number;
+    uint32_t wire_type;
+    gsl::span<const uint8_t> payload;
+    if (!reader.ReadField(field_number, wire_type, payload)) {
+      return false;
+    }
+
+    bool copy = true;
+    if (wire_type == kWireTypeLengthDelimited && !rewrite(field_number, payload, copy)) {
+      return false;
+    }
+
+    if (copy) {
+      out.append(reinterpret_cast<const char*>(field_start), static_cast<size_t>(reader.Position() - field_start));
+    }
+  }
+
+  return true;
+}
+
+// Copies the model to 'out' without the raw data of the main graph initializers of at least 'min_bytes'. The raw
+// data of each initializer is added to 'raw_data', or an empty span if it was kept.
+bool StripInitializerRawData(gsl::span<const uint8_t> model, size_t min_bytes, std::string& out,
+                             std::vector<gsl::span<const uint8_t>>& raw_data) {
+  bool graph_seen = false;
+  return RewriteMessage(model, out, [&](uint32_t model_field, gsl::span<const uint8_t> graph, bool& copy_graph) {
+    if (model_field != kModelProtoGraph) {
+      return true;
+    }
+
+    // protobuf merges repeated occurrences of a message field, which the initializer indexes can't follow
+    if (graph_seen) {
+      return false;
+    }
+
+    graph_seen = true;
+    copy_graph = false;
+    std::string stripped_graph;
+    const bool graph_ok = RewriteMessage(
+        graph, stripped_graph, [&](uint32_t graph_field, gsl::span<const uint8_t> tensor, bool& copy_tensor) {
+          if (graph_field != kGraphProtoInitializer) {
+            return true;
+          }
+
+          gsl::span<const uint8_t> tensor_raw_data;
+          std::string stripped_tensor;
+          const bool tensor_ok = RewriteMessage(
+              tensor, stripped_tensor, [&](uint32_t tensor_field, gsl::span<const uint8_t> data, bool& copy_data) {
+                if (tensor_field == kTensorProtoRawData) {
+                  tensor_raw_data = data;
+                  copy_data = false;
+                }
+                return true;
+              });
+
+          if (!tensor_ok) {
+            return false;
+          }
+
+          if (tensor_raw_data.size() >= min_bytes && !tensor_raw_data.empty()) {
+            AppendLengthDelimitedField(stripped_graph, kGraphProtoInitializer, stripped_tensor);
+            copy_tensor = false;
+            raw_data.push_back(tensor_raw_data);
+          } else {
+            raw_data.push_back({});
+          }
+
+          return true;
+        });
+
+    if (graph_ok) {
+      AppendLengthDelimitedField(out, kModelProtoGraph, stripped_graph);
+    }
+
+    return graph_ok;
+  });
+}
+
+}  // namespace
+
+Status Model::LoadReferencingInitializerData(gsl::span<const uint8_t> bytes, size_t min_referenced_bytes,
+                                             /*out*/ ONNX_NAMESPACE::ModelProto& model_proto) {
+  std::string stripped_model;
+  std::vector<gsl::span<const uint8_t>> raw_data;
+  if (!StripInitializerRawData(bytes, min_referenced_bytes, stripped_model, raw_data) ||
+      stripped_model.size() > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+      !model_proto.ParseFromArray(stripped_model.data(), static_cast<int>(stripped_model.size()))) {
+    return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed.");
+  }
+
+  auto& initializers = *model_proto.mutable_graph()->mutable_initializer();
+  ORT_RETURN_IF_NOT(static_cast<size_t>(initializers.size()) == raw_data.size(),
+                    "Unexpected number of initializers after parsing the model.");
+
+  for (int i = 0; i < initializers.size(); ++i) {
+    if (!raw_data[i].empty()) {
+      utils::SetExternalDataMemoryAddress(*initializers.Mutable(i), raw_data[i].data(), raw_data[i].size());
+    }
+  }
+
+  return Status::OK();
+}
+
 using ::google::protobuf::io::CodedInputStream;
 using ::google::protobuf::io::FileInputStream;
 using ::google::protobuf::io::ZeroCopyInputStream;
@@ -630,7 +826,8 @@ Status Model::SaveWithExternalInitializers(Model& model,
 }
 
 common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                      flatbuffers::Offset<fbs::Model>& fbs_model) const {
+                                      flatbuffers::Offset<fbs::Model>& fbs_model,
+                                      bool compress_initializers) const {
   auto producer_name = experimental::utils::SaveStringToOrtFormat(
       builder, model_proto_.has_producer_name(), model_proto_.producer_name());
   auto producer_version = experimental::utils::SaveStringToOrtFormat(
@@ -653,7 +850,7 @@ common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   auto op_set_ids = builder.CreateVector(op_set_ids_vec);
 
   flatbuffers::Offset<fbs::Graph> fbs_graph;
-  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph));
+  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph, compress_initializers));
 
   fbs::ModelBuilder mb(builder);
   mb.add_ir_version(model_proto_.ir_version());
@@ -682,6 +879,7 @@ common::Status Model::LoadFromOrtFormat(const fbs::Model& fbs_model,
 #if !defined(ORT_MINIMAL_BUILD)
                                         const IOnnxRuntimeOpSchemaRegistryList* local_registries,
 #endif
+                                        bool use_ort_format_bytes_for_initializers,
                                         const logging::Logger& logger,
                                         std::unique_ptr<Model>& model) {
   model.reset(new Model());
@@ -720,10 +918,11 @@ common::Status Model::LoadFromOrtFormat(const fbs::Model& fbs_model,
   ORT_RETURN_IF(nullptr == fbs_graph, "Graph is null. Invalid ORT format model.");
 
 #if !defined(ORT_MINIMAL_BUILD)
-  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, schema_registry, logger,
-                                               model->graph_));
+  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, schema_registry,
+                                               use_ort_format_bytes_for_initializers, logger, model->graph_));
 #else
-  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, logger, model->graph_));
+  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version,
+                                               use_ort_format_bytes_for_initializers, logger, model->graph_));
 #endif
   return Status::OK();
 }
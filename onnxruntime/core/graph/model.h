@@ -237,6 +237,12 @@ class Model {
                                       const IOnnxRuntimeOpSchemaRegistryList* local_registries,
                                       const logging::Logger& logger);
 
+  // Parse the ModelProto in 'bytes' without copying the raw data of the main graph initializers of at least
+  // 'min_referenced_bytes'. These initializers refer to the raw data in 'bytes' as in-memory external data, so
+  // 'bytes' must outlive model_proto and everything created from it.
+  static common::Status LoadReferencingInitializerData(gsl::span<const uint8_t> bytes, size_t min_referenced_bytes,
+                                                       /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
+
   static common::Status Load(const ONNX_NAMESPACE::ModelProto& model_proto, /*out*/ std::shared_ptr<Model>& p_model,
                              const IOnnxRuntimeOpSchemaRegistryList* local_registries,
                              const logging::Logger& logger);
@@ -258,16 +264,22 @@ class Model {
                              const IOnnxRuntimeOpSchemaRegistryList* local_registries,
                              const logging::Logger& logger);
 
+  // If compress_initializers is true, the raw data of the large initializers of the main graph is compressed when it
+  // saves enough space.
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                 flatbuffers::Offset<onnxruntime::experimental::fbs::Model>& model) const;
+                                 flatbuffers::Offset<onnxruntime::experimental::fbs::Model>& model,
+                                 bool compress_initializers = false) const;
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
+  // If use_ort_format_bytes_for_initializers is true the initializers refer to the data in fbs_model instead of
+  // copying it, so the ORT format bytes must remain valid for the lifetime of the Model and anything created from it.
   static common::Status LoadFromOrtFormat(const onnxruntime::experimental::fbs::Model& fbs_model,
 #if !defined(ORT_MINIMAL_BUILD)
                                           const IOnnxRuntimeOpSchemaRegistryList* local_registries,
 #endif
+                                          bool use_ort_format_bytes_for_initializers,
                                           const logging::Logger& logger,
                                           std::unique_ptr<Model>& model);
 #endif
@@ -324,6 +324,97 @@ MlasGemm(
                   M, N, K, &DataParams, 1, ThreadPool);
 }
 
+/**
+ * @brief Supply one problem of a grouped single precision gemm operation
+ */
+struct MLAS_SGEMM_GROUPED_PROBLEM {
+    CBLAS_TRANSPOSE TransA = CblasNoTrans; /**< Supplies the transpose operation for matrix A. */
+    CBLAS_TRANSPOSE TransB = CblasNoTrans; /**< Supplies the transpose operation for matrix B. */
+    size_t M = 0;                          /**< Supplies the number of rows of matrix A and matrix C. */
+    size_t N = 0;                          /**< Supplies the number of columns of matrix B and matrix C. */
+    size_t K = 0;                          /**< Supplies the number of columns of matrix A and rows of matrix B. */
+    MLAS_SGEMM_DATA_PARAMS Data;           /**< Supplies the matrices data parameters. */
+};
+
+/**
+ * @brief  Grouped single precision matrix/matrix multiply operation (SGEMM)
+ *
+ * Unlike MlasGemmBatch, every problem has its own transpose operations and
+ * shape. The work of all the problems is split across the thread pool in a
+ * single round, in proportion to the complexity of each problem, so that
+ * many small multiplications do not each pay for a thread pool dispatch.
+ *
+ * @param Problems      Supplies the array of problems.
+ * @param ProblemCount  Supplies the number of problems.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr if the
+                        base library threading support should be used.
+ */
+void
+MLASCALL
+MlasGemmGrouped(
+    const MLAS_SGEMM_GROUPED_PROBLEM* Problems,
+    size_t ProblemCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Blocking and threading parameters of the single precision matrix
+ *        multiply (SGEMM) routines.
+ *
+ * The defaults suit most processors, but the best values depend on the cache
+ * sizes and core count. Use MlasSgemmAutoTune to find the best values for
+ * the current processor.
+ */
+struct MLAS_SGEMM_TUNING_PARAMETERS {
+    size_t StrideN = 0;           /**< Supplies the number of columns of matrix B packed at a time. */
+    size_t StrideK = 0;           /**< Supplies the number of rows of matrix B packed at a time. */
+    size_t ThreadComplexity = 0;  /**< Supplies the multiply-add count that warrants another thread. */
+};
+
+/**
+ * @brief  Returns the SGEMM tuning parameters in use.
+ */
+void
+MLASCALL
+MlasSgemmGetTuningParameters(
+    MLAS_SGEMM_TUNING_PARAMETERS* Parameters
+    );
+
+/**
+ * @brief  Sets the SGEMM tuning parameters for the process. Call this before
+ *         any SGEMM runs, e.g. while a session is created.
+ *
+ * @param Parameters  Supplies the parameters. StrideN and StrideK must be
+ *                    powers of two of at least 16 whose product does not
+ *                    exceed the default StrideN * StrideK, and
+ *                    ThreadComplexity must be non-zero.
+ *
+ * @return false if the parameters are not valid, in which case the parameters
+ *         in use are unchanged.
+ */
+bool
+MLASCALL
+MlasSgemmSetTuningParameters(
+    const MLAS_SGEMM_TUNING_PARAMETERS* Parameters
+    );
+
+/**
+ * @brief  Benchmarks the supported SGEMM blocking and threading choices on a
+ *         set of typical problem shapes, and applies the fastest. This takes
+ *         up to a few seconds.
+ *
+ * @param ThreadPool  Supplies the thread pool the threading choice is tuned
+ *                    for, else nullptr if the base library threading support
+ *                    should be used.
+ * @param Parameters  Receives the parameters that were applied.
+ */
+void
+MLASCALL
+MlasSgemmAutoTune(
+    MLAS_THREADPOOL* ThreadPool,
+    MLAS_SGEMM_TUNING_PARAMETERS* Parameters
+    );
+
 
 /**
  * @brief Supply matrices data information to double precision gemm functions
@@ -522,10 +613,17 @@ private:
     MLAS_QUANTIZATION_GRANULARITY QuantGran_;
 };
 
+//
+// Matrix A is unsigned data unless AIsSigned is set, in which case matrix A
+// and ZeroPointA are reinterpreted as signed data. Matrix B and ZeroPointB are
+// likewise controlled by BIsSigned.
+//
+
 struct MLAS_GEMM_U8X8_SHAPE_PARAMS {
     size_t M = 0;
     size_t N = 0;
     size_t K = 0;
+    bool AIsSigned = false;
     bool BIsSigned = false;
 };
 
@@ -555,7 +653,7 @@ MlasGemm(
 /**
  * @brief Batched GEMM, for multiplying multiple pairs of matrices.
  * Note:  We only support uniform batching, so shapes and types of the
- *        input must be same: M, N, K, BIsSigned must be the
+ *        input must be same: M, N, K, AIsSigned, BIsSigned must be the
  *        same across all parameter blocks.
  *
  * @param [IN]  Shape        A single shape descriptor for all the multiplications
@@ -613,6 +711,33 @@ MlasGemmPackB(
     void* PackedB
     );
 
+//
+// The packed format of matrix B depends on the signedness of matrix A, so
+// matrix B must be packed with the same AIsSigned value that is later supplied
+// in MLAS_GEMM_U8X8_SHAPE_PARAMS. The overloads above assume unsigned A.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K,
+    bool AIsSigned,
+    bool BIsSigned
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool AIsSigned,
+    bool BIsSigned,
+    void* PackedB
+    );
+
 //
 // Convolution routines.
 //
@@ -701,6 +826,36 @@ MlasConvDepthwise(
     size_t KernelSize
     );
 
+void
+MLASCALL
+MlasConvDepthwise(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const uint8_t* Filter,
+    uint8_t FilterZeroPoint,
+    bool FilterIsSigned,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerChannelScale,
+    uint8_t OutputZeroPoint,
+    uint8_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Pooling routines.
 //
@@ -737,6 +892,42 @@ MlasMaximumPool(
     size_t KernelSize
     );
 
+void
+MLASCALL
+MlasMaximumPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+void
+MLASCALL
+MlasMaximumPool(
+    const int8_t* const* Input,
+    int8_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template<typename T8Bits>
+void
+MLASCALL
+MlasQLinearAveragePoolNhwc(
+    const T8Bits* const* Input,
+    float ScaleInput,
+    int32_t ZeroPointInput,
+    T8Bits* Output,
+    float ScaleOutput,
+    int32_t ZeroPointOutput,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const T8Bits* Padding
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -749,6 +940,14 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeFastErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
 void
 MLASCALL
 MlasComputeExp(
@@ -765,6 +964,14 @@ MlasComputeLogistic(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeFastLogistic(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
 void
 MLASCALL
 MlasComputeSoftmax(
@@ -776,6 +983,18 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasComputeSoftmaxStrided(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    size_t Stride,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -784,6 +1003,57 @@ MlasComputeTanh(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeFastTanh(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeMeanVariance(
+    const float* Input,
+    size_t N,
+    float* Mean,
+    float* Variance
+    );
+
+void
+MLASCALL
+MlasComputeAddMeanVariance(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float* Mean,
+    float* Variance
+    );
+
+void
+MLASCALL
+MlasComputeScaleShift(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    float Shift
+    );
+
+void
+MLASCALL
+MlasComputeNormalization(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev,
+    const float* Scale,
+    const float* Shift
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -797,6 +1067,346 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+//
+// Half precision and bfloat16 conversion routines. These are available on all
+// platforms and use the F16C, AVX512F or NEON instructions when the processor
+// supports them.
+//
+// N.B. The elements of the half precision buffers are the raw IEEE 754 binary16
+// bit patterns and the elements of the bfloat16 buffers are the upper 16 bits
+// of the IEEE 754 binary32 bit patterns. Conversions from single precision
+// round to nearest even.
+//
+
+typedef uint16_t MLAS_FP16;
+typedef uint16_t MLAS_BF16;
+
+void
+MLASCALL
+MlasConvertHalfToFloat(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloat(
+    const MLAS_BF16* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16(
+    const float* Source,
+    MLAS_BF16* Destination,
+    size_t Count
+    );
+
+//
+// Half precision matrix/matrix multiply routines.
+//
+
+/**
+ * @brief  Half precision matrix/matrix multiply operation (HGEMM)
+ *
+ *         C := alpha * op(A) * op(B) + beta * C
+ *
+ * @param TransA  Supplies the transpose operation for matrix A.
+ * @param TransB  Supplies the transpose operation for matrix B.
+ * @param M       Supplies the number of rows of matrix A and matrix C.
+ * @param N       Supplies the number of columns of matrix B and matrix C.
+ * @param K       Supplies the number of columns of matrix A and the number
+                  of rows of matrix B.
+ * @param alpha   Supplies the scalar alpha multiplier, applied in single precision.
+ * @param A       Supplies the address of matrix A
+ * @param lda     Supplies the first dimension of matrix A.
+ * @param B       Supplies the address of matrix B
+ * @param ldb     Supplies the first dimension of matrix B.
+ * @param beta    Supplies the scalar beta multiplier, applied in single precision.
+ * @param C       Supplies the address of matrix C
+ * @param ldc     Supplies the first dimension of matrix C.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                      base library threading support should be used.
+ */
+void
+MLASCALL
+MlasHalfGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_FP16* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    float beta,
+    MLAS_FP16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Returns whether MlasHalfGemm uses native half precision arithmetic
+ *         on this platform instead of converting the operands to single
+ *         precision.
+ */
+bool
+MLASCALL
+MlasHalfGemmIsNativeSupported(
+    void
+    );
+
+/**
+ * @brief  Returns whether the platform supports the single precision
+ *         matrix/matrix multiply operation that rounds the operands to
+ *         bfloat16 and accumulates in single precision (SBGEMM).
+ */
+bool
+MLASCALL
+MlasSBGemmIsSupported(
+    void
+    );
+
+/**
+ * @brief  Returns the size of the buffer needed to pack matrix B for
+ *         MlasSBGemmBatch, or zero if SBGEMM is not supported.
+ *
+ * @param N       Supplies the number of columns of matrix B.
+ * @param K       Supplies the number of rows of matrix B.
+ */
+size_t
+MLASCALL
+MlasSBGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief  Converts matrix B to bfloat16 and packs it for MlasSBGemmBatch.
+ *
+ * @param TransB  Supplies the transpose operation for matrix B.
+ * @param N       Supplies the number of columns of matrix B.
+ * @param K       Supplies the number of rows of matrix B.
+ * @param B       Supplies the address of matrix B.
+ * @param ldb     Supplies the first dimension of matrix B.
+ * @param PackedB Supplies the address of the buffer of MlasSBGemmPackBSize
+                  bytes to receive the packed matrix.
+ */
+void
+MLASCALL
+MlasSBGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation that
+ *         rounds the operands to bfloat16 and accumulates in single
+ *         precision. The B matrices must be packed by MlasSBGemmPackB: the
+ *         B member of each data parameter supplies the packed buffer and the
+ *         ldb and BIsPacked members are ignored.
+ *
+ *         Only use this routine when MlasSBGemmIsSupported returns true.
+ *
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       Supplies the array of matrices data parameters.
+ * @param BatchSize  Supplies the number of multiplications in this batch.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSBGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Returns the size of the buffer needed to pack the non-zero blocks of
+ *         matrix B for MlasSparseGemmBatch, or zero if storing the blocks
+ *         needs more than MaximumDensity of the values of matrix B. The
+ *         block shape (4x4, 16x1 or 1x4) that stores the fewest values is
+ *         selected; it must evenly divide matrix B.
+ *
+ * @param TransB         Supplies the transpose operation for matrix B.
+ * @param N              Supplies the number of columns of matrix B.
+ * @param K              Supplies the number of rows of matrix B.
+ * @param B              Supplies the address of matrix B.
+ * @param ldb            Supplies the first dimension of matrix B.
+ * @param ZeroThreshold  Supplies the magnitude at or below which a value is
+                         treated as zero.
+ * @param MaximumDensity Supplies the maximum fraction of the values of
+                         matrix B that may be stored.
+ */
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float ZeroThreshold,
+    float MaximumDensity
+    );
+
+/**
+ * @brief  Packs the non-zero blocks of matrix B for MlasSparseGemmBatch. The
+ *         arguments must match the MlasSparseGemmPackBSize call.
+ *
+ * @param PackedB Supplies the address of the buffer of
+                  MlasSparseGemmPackBSize bytes to receive the packed matrix.
+ */
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float ZeroThreshold,
+    float MaximumDensity,
+    void* PackedB
+    );
+
+/**
+ * @brief  Returns whether the buffer holds a matrix B with N columns and K
+ *         rows packed by MlasSparseGemmPackB, e.g. a buffer saved by an
+ *         earlier session.
+ */
+bool
+MLASCALL
+MlasSparseGemmIsPackedB(
+    const void* PackedB,
+    size_t PackedBSize,
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation with a
+ *         block sparse matrix B. The B member of each data parameter supplies
+ *         the buffer packed by MlasSparseGemmPackB (the same buffer for the
+ *         whole batch) and the ldb and BIsPacked members are ignored.
+ *
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       Supplies the array of matrices data parameters.
+ * @param BatchSize  Supplies the number of multiplications in this batch.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSparseGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Int4 block quantized weight matrix multiply routines.
+//
+// Matrix B is stored column by column: each column of K values is split into
+// blocks of BlockSize rows that share a float scale and a 4-bit zero point.
+// The quantized values are stored two per byte, the even rows in the low
+// nibble, and the last block of a column is padded to BlockSize values:
+//
+//     QuantBData       uint8_t[N][BlockCountK][BlockSize / 2]
+//     QuantBScale      float[N][BlockCountK]
+//     QuantBZeroPoint  uint8_t[N][(BlockCountK + 1) / 2], even blocks in the
+//                      low nibble, or nullptr for a zero point of 8
+//
+// where BlockCountK = (K + BlockSize - 1) / BlockSize.
+//
+
+/**
+ * @brief Supply matrices data information to the int4 weight GEMM functions
+ */
+struct MLAS_Q4_GEMM_DATA_PARAMS {
+    const float* A = nullptr;               /**< Supplies the address of matrix A */
+    size_t lda = 0;                         /**< Supplies the first dimension of matrix A. */
+    const uint8_t* QuantBData = nullptr;    /**< Supplies the quantized values of matrix B */
+    const float* QuantBScale = nullptr;     /**< Supplies the scale of each block of matrix B */
+    const uint8_t* QuantBZeroPoint = nullptr; /**< Supplies the zero point of each block of matrix B, optional */
+    const float* Bias = nullptr;            /**< Supplies the bias vector of N values added to matrix C, optional */
+    float* C = nullptr;                     /**< Supplies the address of matrix C */
+    size_t ldc = 0;                         /**< Supplies the first dimension of matrix C. */
+};
+
+/**
+ * @brief  Returns whether BlockSize is supported by MlasQ4GemmBatch: a
+ *         power of two from 16 to 256.
+ */
+bool
+MLASCALL
+MlasQ4GemmIsBlockSizeSupported(
+    size_t BlockSize
+    );
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation with an
+ *         int4 block quantized matrix B, C = A * dequantize(B) + Bias. The
+ *         blocks of matrix B are dequantized as they are multiplied, so the
+ *         float matrix B is never stored.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param BlockSize  Supplies the number of rows of matrix B in each
+                     quantization block.
+ * @param Data       Supplies the array of matrices data parameters.
+ * @param BatchSize  Supplies the number of multiplications in this batch.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasQ4GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlockSize,
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Transpose routines.
 //
@@ -810,6 +1420,15 @@ MlasTranspose(
     size_t N
     );
 
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N
+    );
+
 void
 MLASCALL
 MlasTranspose(
@@ -819,6 +1438,15 @@ MlasTranspose(
     size_t N
     );
 
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N
+    );
+
 void
 MLASCALL
 MlasTranspose(
@@ -828,6 +1456,55 @@ MlasTranspose(
     size_t N
     );
 
+//
+// Transposes a matrix whose rows are InputStride elements apart into a matrix
+// whose rows are OutputStride elements apart, e.g. a tile of a larger tensor.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    size_t InputStride,
+    uint8_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -936,6 +1613,18 @@ MlasNchwcUpsample(
     float* Output
     );
 
+void
+MLASCALL
+MlasNchwcUpsampleLinear(
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t OutputWidth,
+    float InterpolationHeight,
+    const float* InterpolationWidth,
+    const float* Input,
+    float* Output
+    );
+
 //
 // Linear quantization routines.
 //
@@ -0,0 +1,199 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    HalfGemmKernelNeon.cpp
+
+Abstract:
+
+    This module implements the kernel for the half precision matrix/matrix
+    multiply operation (HGEMM) using the ARMv8.2-A half precision vector
+    arithmetic instructions.
+
+    N.B. This module must be compiled with the FP16 extension enabled, for
+    example with -march=armv8.2-a+fp16.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelNeonRows(
+    const MLAS_FP16* A,
+    const MLAS_FP16* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of the output block. The products are
+    accumulated in half precision over the supplied CountK and then added to
+    or stored into the single precision output block.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A block. Each row contains
+        CountK elements.
+
+    B - Supplies the address of the packed matrix B block. Each panel of 16
+        columns contains CountK rows of 16 elements.
+
+    C - Supplies the address of the single precision output block.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    ldc - Supplies the first dimension of the output block.
+
+    ZeroMode - Supplies true if the output block should be initialized, else
+        false if the products should be accumulated into the output block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __fp16* a = reinterpret_cast<const __fp16*>(A);
+    const __fp16* b = reinterpret_cast<const __fp16*>(B);
+
+    while (CountN > 0) {
+
+        float16x8_t Accumulators[RowCount][2];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][0] = vdupq_n_f16(0);
+            Accumulators[r][1] = vdupq_n_f16(0);
+        }
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            const float16x8_t BElements0 = vld1q_f16(b);
+            const float16x8_t BElements1 = vld1q_f16(b + 8);
+            b += MLAS_HGEMM_PANELN;
+
+            for (size_t r = 0; r < RowCount; r++) {
+                const __fp16 AElement = a[r * CountK + k];
+                Accumulators[r][0] = vfmaq_n_f16(Accumulators[r][0], BElements0, AElement);
+                Accumulators[r][1] = vfmaq_n_f16(Accumulators[r][1], BElements1, AElement);
+            }
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float32x4_t Output[4];
+
+            Output[0] = vcvt_f32_f16(vget_low_f16(Accumulators[r][0]));
+            Output[1] = vcvt_high_f32_f16(Accumulators[r][0]);
+            Output[2] = vcvt_f32_f16(vget_low_f16(Accumulators[r][1]));
+            Output[3] = vcvt_high_f32_f16(Accumulators[r][1]);
+
+            float* c = C + r * ldc;
+
+            if (CountN >= MLAS_HGEMM_PANELN) {
+
+                for (size_t i = 0; i < 4; i++) {
+                    if (!ZeroMode) {
+                        Output[i] = vaddq_f32(Output[i], vld1q_f32(c + i * 4));
+                    }
+                    vst1q_f32(c + i * 4, Output[i]);
+                }
+
+            } else {
+
+                float Buffer[MLAS_HGEMM_PANELN];
+
+                for (size_t i = 0; i < 4; i++) {
+                    vst1q_f32(Buffer + i * 4, Output[i]);
+                }
+
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] = ZeroMode ? Buffer[n] : c[n] + Buffer[n];
+                }
+            }
+        }
+
+        if (CountN <= MLAS_HGEMM_PANELN) {
+            break;
+        }
+
+        C += MLAS_HGEMM_PANELN;
+        CountN -= MLAS_HGEMM_PANELN;
+    }
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernelNeon(
+    const MLAS_FP16* A,
+    const MLAS_FP16* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A block.
+
+    B - Supplies the address of the packed matrix B block.
+
+    C - Supplies the address of the single precision output block.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    ldc - Supplies the first dimension of the output block.
+
+    ZeroMode - Supplies true if the output block should be initialized, else
+        false if the products should be accumulated into the output block.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 4) {
+        MlasHalfGemmKernelNeonRows<4>(A, B, C, CountK, CountN, ldc, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasHalfGemmKernelNeonRows<2>(A, B, C, CountK, CountN, ldc, ZeroMode);
+        return 2;
+    }
+
+    MlasHalfGemmKernelNeonRows<1>(A, B, C, CountK, CountN, ldc, ZeroMode);
+    return 1;
+}
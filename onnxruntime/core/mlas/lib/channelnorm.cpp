@@ -0,0 +1,435 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    channelnorm.cpp
+
+Abstract:
+
+    This module implements the routines to normalize the channels of a tensor
+    as done by batch and instance normalization, and the rows of a tensor as
+    done by layer normalization.
+
+--*/
+
+#include "mlasi.h"
+
+template<bool AddInputs>
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasLoadSumFloat32x4(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine loads a vector of the input buffer. If AddInputs is true, the
+    skip and optional bias buffers are added to it and the sum is stored to
+    the output buffer.
+
+--*/
+{
+    MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + Index);
+
+    if (AddInputs) {
+        Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Skip + Index));
+        if (Bias != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + Index));
+        }
+        MlasStoreFloat32x4(Output + Index, Vector);
+    }
+
+    return Vector;
+}
+
+template<bool AddInputs>
+void
+MlasComputeMeanVarianceKernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float* Mean,
+    float* Variance
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the mean and the population variance of the input
+    buffer in a single pass using Welford's algorithm, which avoids the
+    cancellation of the sum of squares formula for inputs with a large mean.
+
+    Each of 16 vector lanes keeps its own running mean and sum of squared
+    differences over every 16th element, so that the reciprocal of the element
+    count is shared by a whole row of lanes. The lanes are then combined using
+    the pairwise update of Chan et al.
+
+    If AddInputs is true, the moments are those of the sum of the input, skip
+    and optional bias buffers, which is also stored to the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Skip - Supplies the buffer to add to the input if AddInputs is true.
+
+    Bias - Optionally supplies a buffer to add to the input if AddInputs is
+        true.
+
+    Output - Supplies the buffer to store the sum to if AddInputs is true.
+
+    N - Supplies the number of elements to process.
+
+    Mean - Returns the mean of the elements.
+
+    Variance - Returns the population variance of the elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t LaneCount = 16;
+
+    float MeanValue = 0.0f;
+    float M2Value = 0.0f;
+    size_t Count = 0;
+    size_t Index = 0;
+
+    if (N >= LaneCount) {
+
+        MLAS_FLOAT32X4 MeanVector0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 MeanVector1 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 MeanVector2 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 MeanVector3 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 M2Vector0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 M2Vector1 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 M2Vector2 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 M2Vector3 = MlasZeroFloat32x4();
+
+        size_t LaneElementCount = 0;
+
+        while (N - Index >= LaneCount) {
+
+            LaneElementCount++;
+            MLAS_FLOAT32X4 ReciprocalVector = MlasBroadcastFloat32x4(1.0f / float(LaneElementCount));
+
+            MLAS_FLOAT32X4 InputVector0 = MlasLoadSumFloat32x4<AddInputs>(Input, Skip, Bias, Output, Index);
+            MLAS_FLOAT32X4 InputVector1 = MlasLoadSumFloat32x4<AddInputs>(Input, Skip, Bias, Output, Index + 4);
+            MLAS_FLOAT32X4 InputVector2 = MlasLoadSumFloat32x4<AddInputs>(Input, Skip, Bias, Output, Index + 8);
+            MLAS_FLOAT32X4 InputVector3 = MlasLoadSumFloat32x4<AddInputs>(Input, Skip, Bias, Output, Index + 12);
+
+            MLAS_FLOAT32X4 Delta0 = MlasSubtractFloat32x4(InputVector0, MeanVector0);
+            MLAS_FLOAT32X4 Delta1 = MlasSubtractFloat32x4(InputVector1, MeanVector1);
+            MLAS_FLOAT32X4 Delta2 = MlasSubtractFloat32x4(InputVector2, MeanVector2);
+            MLAS_FLOAT32X4 Delta3 = MlasSubtractFloat32x4(InputVector3, MeanVector3);
+
+            MeanVector0 = MlasMultiplyAddFloat32x4(Delta0, ReciprocalVector, MeanVector0);
+            MeanVector1 = MlasMultiplyAddFloat32x4(Delta1, ReciprocalVector, MeanVector1);
+            MeanVector2 = MlasMultiplyAddFloat32x4(Delta2, ReciprocalVector, MeanVector2);
+            MeanVector3 = MlasMultiplyAddFloat32x4(Delta3, ReciprocalVector, MeanVector3);
+
+            M2Vector0 = MlasMultiplyAddFloat32x4(Delta0, MlasSubtractFloat32x4(InputVector0, MeanVector0), M2Vector0);
+            M2Vector1 = MlasMultiplyAddFloat32x4(Delta1, MlasSubtractFloat32x4(InputVector1, MeanVector1), M2Vector1);
+            M2Vector2 = MlasMultiplyAddFloat32x4(Delta2, MlasSubtractFloat32x4(InputVector2, MeanVector2), M2Vector2);
+            M2Vector3 = MlasMultiplyAddFloat32x4(Delta3, MlasSubtractFloat32x4(InputVector3, MeanVector3), M2Vector3);
+
+            Index += LaneCount;
+        }
+
+        //
+        // Every lane has seen the same number of elements, so the combined
+        // mean is the average of the lane means and the combined sum of
+        // squared differences adds the spread of the lane means.
+        //
+
+        MLAS_FLOAT32X4 MeanSum = MlasAddFloat32x4(MlasAddFloat32x4(MeanVector0, MeanVector1),
+                                                  MlasAddFloat32x4(MeanVector2, MeanVector3));
+        MeanValue = MlasReduceAddFloat32x4(MeanSum) / float(LaneCount);
+
+        MLAS_FLOAT32X4 MeanValueVector = MlasBroadcastFloat32x4(MeanValue);
+        MLAS_FLOAT32X4 Spread0 = MlasSubtractFloat32x4(MeanVector0, MeanValueVector);
+        MLAS_FLOAT32X4 Spread1 = MlasSubtractFloat32x4(MeanVector1, MeanValueVector);
+        MLAS_FLOAT32X4 Spread2 = MlasSubtractFloat32x4(MeanVector2, MeanValueVector);
+        MLAS_FLOAT32X4 Spread3 = MlasSubtractFloat32x4(MeanVector3, MeanValueVector);
+
+        MLAS_FLOAT32X4 SpreadSum = MlasMultiplyFloat32x4(Spread0, Spread0);
+        SpreadSum = MlasMultiplyAddFloat32x4(Spread1, Spread1, SpreadSum);
+        SpreadSum = MlasMultiplyAddFloat32x4(Spread2, Spread2, SpreadSum);
+        SpreadSum = MlasMultiplyAddFloat32x4(Spread3, Spread3, SpreadSum);
+
+        MLAS_FLOAT32X4 M2Sum = MlasAddFloat32x4(MlasAddFloat32x4(M2Vector0, M2Vector1),
+                                                MlasAddFloat32x4(M2Vector2, M2Vector3));
+
+        M2Value = MlasReduceAddFloat32x4(M2Sum) + float(LaneElementCount) * MlasReduceAddFloat32x4(SpreadSum);
+        Count = LaneElementCount * LaneCount;
+    }
+
+    //
+    // Process the remaining elements with the scalar form of the update.
+    //
+
+    for (; Index < N; Index++) {
+
+        Count++;
+
+        float Value = Input[Index];
+
+        if (AddInputs) {
+            Value += Skip[Index];
+            if (Bias != nullptr) {
+                Value += Bias[Index];
+            }
+            Output[Index] = Value;
+        }
+
+        float Delta = Value - MeanValue;
+        MeanValue += Delta / float(Count);
+        M2Value += Delta * (Value - MeanValue);
+    }
+
+    *Mean = MeanValue;
+    *Variance = (Count > 0) ? M2Value / float(Count) : 0.0f;
+}
+
+void
+MLASCALL
+MlasComputeMeanVariance(
+    const float* Input,
+    size_t N,
+    float* Mean,
+    float* Variance
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the mean and the population variance of the input
+    buffer in a single pass.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Mean - Returns the mean of the elements.
+
+    Variance - Returns the population variance of the elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeMeanVarianceKernel<false>(Input, nullptr, nullptr, nullptr, N, Mean, Variance);
+}
+
+void
+MLASCALL
+MlasComputeAddMeanVariance(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float* Mean,
+    float* Variance
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the skip and optional bias buffers to the input buffer
+    and computes the mean and the population variance of the sum in the same
+    pass, as done by the residual connection before a layer normalization.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Skip - Supplies the buffer to add to the input.
+
+    Bias - Optionally supplies a buffer to add to the input.
+
+    Output - Supplies the buffer to store the sum to. This may be the input
+        buffer.
+
+    N - Supplies the number of elements to process.
+
+    Mean - Returns the mean of the sum.
+
+    Variance - Returns the population variance of the sum.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeMeanVarianceKernel<true>(Input, Skip, Bias, Output, N, Mean, Variance);
+}
+
+void
+MLASCALL
+MlasComputeScaleShift(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    float Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Input * Scale + Shift for every element of the input
+    buffer, which applies the normalization of a channel once its moments have
+    been folded into the scale and shift.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the value to multiply the elements by.
+
+    Shift - Supplies the value to add to the scaled elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + 4);
+        MLAS_FLOAT32X4 Vector2 = MlasLoadFloat32x4(Input + 8);
+        MLAS_FLOAT32X4 Vector3 = MlasLoadFloat32x4(Input + 12);
+
+        MlasStoreFloat32x4(Output, MlasMultiplyAddFloat32x4(Vector0, ScaleVector, ShiftVector));
+        MlasStoreFloat32x4(Output + 4, MlasMultiplyAddFloat32x4(Vector1, ScaleVector, ShiftVector));
+        MlasStoreFloat32x4(Output + 8, MlasMultiplyAddFloat32x4(Vector2, ScaleVector, ShiftVector));
+        MlasStoreFloat32x4(Output + 12, MlasMultiplyAddFloat32x4(Vector3, ScaleVector, ShiftVector));
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input), ScaleVector, ShiftVector));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = *Input++ * Scale + Shift;
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeNormalization(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev,
+    const float* Scale,
+    const float* Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine computes (Input - Mean) * InvStdDev * Scale + Shift for every
+    element of the input buffer, with a scale and optional shift per element
+    as done by layer normalization.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. This may be the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Mean - Supplies the mean of the elements.
+
+    InvStdDev - Supplies the inverse of the standard deviation of the elements.
+
+    Scale - Supplies the buffer of values to multiply the normalized elements
+        by.
+
+    Shift - Optionally supplies the buffer of values to add to the scaled
+        elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+    MLAS_FLOAT32X4 ZeroVector = MlasZeroFloat32x4();
+
+    size_t Index = 0;
+
+    //
+    // The mean is subtracted before scaling rather than folded into a shift,
+    // which would cancel out for inputs with a large mean.
+    //
+
+    while (N - Index >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + Index);
+        Vector = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Vector, MeanVector), InvStdDevVector);
+
+        MLAS_FLOAT32X4 ShiftVector = (Shift != nullptr) ? MlasLoadFloat32x4(Shift + Index) : ZeroVector;
+        Vector = MlasMultiplyAddFloat32x4(Vector, MlasLoadFloat32x4(Scale + Index), ShiftVector);
+
+        MlasStoreFloat32x4(Output + Index, Vector);
+
+        Index += 4;
+    }
+
+    for (; Index < N; Index++) {
+
+        float Value = (Input[Index] - Mean) * InvStdDev * Scale[Index];
+
+        if (Shift != nullptr) {
+            Value += Shift[Index];
+        }
+
+        Output[Index] = Value;
+    }
+}
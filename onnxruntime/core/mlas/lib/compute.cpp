@@ -989,3 +989,404 @@ Return Value:
 
     MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
 }
+
+//
+// Define the parameters to execute segments of a strided softmax operation on
+// worker threads.
+//
+
+struct MLAS_SOFTMAX_STRIDED_WORK_BLOCK {
+    ptrdiff_t ThreadCount;
+    bool LogSoftmax;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+    size_t Stride;
+    size_t BlockCountPerRow;
+};
+
+//
+// Define the number of columns processed by a single unit of work of a
+// strided softmax operation.
+//
+
+constexpr size_t MLAS_SOFTMAX_STRIDED_BLOCK_COLUMNS = 64;
+
+template<size_t VectorCount>
+void
+MlasComputeSoftmaxStridedColumns(
+    const float* Input,
+    float* Output,
+    size_t D,
+    size_t Stride,
+    bool LogSoftmax
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function over the D
+    dimension for 4 * VectorCount adjacent columns.
+
+    The maximum and the sum of the exponential functions are computed in a
+    single pass over the input (the "online" softmax formulation): when a new
+    maximum is found, the running sum is rescaled by exp(OldMaximum -
+    NewMaximum). Computing exp(-|Input - Maximum|) selects either the rescale
+    factor or the term to add, so only one exponential is evaluated per
+    element.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    D - Supplies the number of elements to reduce over.
+
+    Stride - Supplies the distance in elements between consecutive elements of
+        the D dimension.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 OneVector = MlasBroadcastFloat32x4(1.0f);
+    const MLAS_FLOAT32X4 ZeroVector = MlasZeroFloat32x4();
+
+    MLAS_FLOAT32X4 Maximum[VectorCount];
+    MLAS_FLOAT32X4 Accumulation[VectorCount];
+
+    for (size_t i = 0; i < VectorCount; i++) {
+        Maximum[i] = MlasLoadFloat32x4(Input + i * 4);
+        Accumulation[i] = OneVector;
+    }
+
+    const float* input = Input + Stride;
+
+    for (size_t d = 1; d < D; d++) {
+
+        for (size_t i = 0; i < VectorCount; i++) {
+
+            MLAS_FLOAT32X4 InputVector = MlasLoadFloat32x4(input + i * 4);
+            MLAS_FLOAT32X4 Delta = MlasSubtractFloat32x4(InputVector, Maximum[i]);
+            MLAS_FLOAT32X4 Greater = MlasGreaterThanFloat32x4(Delta, ZeroVector);
+
+            MLAS_FLOAT32X4 ExpVector = MlasComputeExpVector(
+                MlasMinimumFloat32x4(Delta, MlasSubtractFloat32x4(ZeroVector, Delta)));
+
+            Accumulation[i] = MlasBlendFloat32x4(MlasAddFloat32x4(Accumulation[i], ExpVector),
+                MlasMultiplyAddFloat32x4(Accumulation[i], ExpVector, OneVector), Greater);
+            Maximum[i] = MlasMaximumFloat32x4(Maximum[i], InputVector);
+        }
+
+        input += Stride;
+    }
+
+    MLAS_FLOAT32X4 Parameter[VectorCount];
+
+    if (LogSoftmax) {
+
+        //
+        // The output is Input - (Maximum + log(Accumulation)).
+        //
+
+        for (size_t i = 0; i < VectorCount; i++) {
+
+            float Values[4];
+            MlasStoreFloat32x4(Values, Accumulation[i]);
+
+            for (size_t j = 0; j < 4; j++) {
+                Values[j] = std::log(Values[j]);
+            }
+
+            Parameter[i] = MlasAddFloat32x4(Maximum[i], MlasLoadFloat32x4(Values));
+        }
+
+        for (size_t d = 0; d < D; d++) {
+
+            for (size_t i = 0; i < VectorCount; i++) {
+                MlasStoreFloat32x4(Output + i * 4,
+                    MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i * 4), Parameter[i]));
+            }
+
+            Input += Stride;
+            Output += Stride;
+        }
+
+    } else {
+
+        //
+        // The output is exp(Input - Maximum) / Accumulation.
+        //
+
+        for (size_t i = 0; i < VectorCount; i++) {
+            Parameter[i] = MlasDivideFloat32x4(OneVector, Accumulation[i]);
+        }
+
+        for (size_t d = 0; d < D; d++) {
+
+            for (size_t i = 0; i < VectorCount; i++) {
+                MLAS_FLOAT32X4 ExpVector = MlasComputeExpVector(
+                    MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i * 4), Maximum[i]));
+                MlasStoreFloat32x4(Output + i * 4, MlasMultiplyFloat32x4(ExpVector, Parameter[i]));
+            }
+
+            Input += Stride;
+            Output += Stride;
+        }
+    }
+}
+
+void
+MlasComputeSoftmaxStridedColumn(
+    const float* Input,
+    float* Output,
+    size_t D,
+    size_t Stride,
+    bool LogSoftmax
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function over the D
+    dimension for a single column.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    D - Supplies the number of elements to reduce over.
+
+    Stride - Supplies the distance in elements between consecutive elements of
+        the D dimension.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Maximum = Input[0];
+    float Accumulation = 1.0f;
+
+    for (size_t d = 1; d < D; d++) {
+
+        float Value = Input[d * Stride];
+
+        if (Value > Maximum) {
+            Accumulation = Accumulation * std::exp(Maximum - Value) + 1.0f;
+            Maximum = Value;
+        } else {
+            Accumulation += std::exp(Value - Maximum);
+        }
+    }
+
+    if (LogSoftmax) {
+
+        float Parameter = Maximum + std::log(Accumulation);
+
+        for (size_t d = 0; d < D; d++) {
+            Output[d * Stride] = Input[d * Stride] - Parameter;
+        }
+
+    } else {
+
+        float Parameter = 1.0f / Accumulation;
+
+        for (size_t d = 0; d < D; d++) {
+            Output[d * Stride] = std::exp(Input[d * Stride] - Maximum) * Parameter;
+        }
+    }
+}
+
+void
+MlasComputeSoftmaxStridedThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    strided softmax or log softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SOFTMAX_STRIDED_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the blocks of columns of every row.
+    //
+
+    const size_t BlockCountPerRow = WorkBlock->BlockCountPerRow;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->N * BlockCountPerRow,
+        &WorkIndex, &WorkRemaining);
+
+    const size_t D = WorkBlock->D;
+    const size_t Stride = WorkBlock->Stride;
+    const bool LogSoftmax = WorkBlock->LogSoftmax;
+
+    while (WorkRemaining > 0) {
+
+        const size_t n = WorkIndex / BlockCountPerRow;
+        const size_t ColumnStart = (WorkIndex % BlockCountPerRow) * MLAS_SOFTMAX_STRIDED_BLOCK_COLUMNS;
+        size_t CountColumns = std::min(Stride - ColumnStart, MLAS_SOFTMAX_STRIDED_BLOCK_COLUMNS);
+
+        const float* Input = WorkBlock->Input + n * D * Stride + ColumnStart;
+        float* Output = WorkBlock->Output + n * D * Stride + ColumnStart;
+
+        while (CountColumns >= 16) {
+
+            MlasComputeSoftmaxStridedColumns<4>(Input, Output, D, Stride, LogSoftmax);
+
+            Input += 16;
+            Output += 16;
+            CountColumns -= 16;
+        }
+
+        while (CountColumns >= 4) {
+
+            MlasComputeSoftmaxStridedColumns<1>(Input, Output, D, Stride, LogSoftmax);
+
+            Input += 4;
+            Output += 4;
+            CountColumns -= 4;
+        }
+
+        while (CountColumns > 0) {
+
+            MlasComputeSoftmaxStridedColumn(Input, Output, D, Stride, LogSoftmax);
+
+            Input += 1;
+            Output += 1;
+            CountColumns -= 1;
+        }
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmaxStrided(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    size_t Stride,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function over the middle
+    dimension of a tensor with shape [N, D, Stride], which is the layout of a
+    softmax along any axis other than the innermost one. The innermost
+    dimension is processed directly with vectors of adjacent columns, so the
+    tensor does not need to be transposed.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of outer rows to process.
+
+    D - Supplies the number of elements to reduce over.
+
+    Stride - Supplies the number of columns per element of the D dimension.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0 || D == 0 || Stride == 0) {
+        return;
+    }
+
+    if (Stride == 1) {
+        MlasComputeSoftmax(Input, Output, N, D, LogSoftmax, ThreadPool);
+        return;
+    }
+
+    MLAS_SOFTMAX_STRIDED_WORK_BLOCK WorkBlock;
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.Stride = Stride;
+    WorkBlock.BlockCountPerRow =
+        (Stride + MLAS_SOFTMAX_STRIDED_BLOCK_COLUMNS - 1) / MLAS_SOFTMAX_STRIDED_BLOCK_COLUMNS;
+
+    //
+    // Compute the number of target threads using the same heuristic as the
+    // contiguous softmax operation, limited by the number of column blocks.
+    //
+
+    const size_t WorkCount = N * WorkBlock.BlockCountPerRow;
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > WorkCount) {
+        ThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D * Stride) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCount = ThreadCount;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxStridedThreaded, &WorkBlock, ThreadCount, ThreadPool);
+}
@@ -0,0 +1,329 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convert.cpp
+
+Abstract:
+
+    This module implements routines to convert buffers between single
+    precision and the half precision or bfloat16 formats.
+
+    The x86/x64 platforms select the AVX2 (with F16C) or AVX512F kernels at
+    runtime. ARM64 always has the NEON conversion instructions. Other platforms
+    use the portable kernels in this module.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a half precision buffer to single precision.
+
+Arguments:
+
+    Source - Supplies the half precision buffer.
+
+    Destination - Supplies the single precision buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(_M_AMD64) && !defined(_M_ARM64EC)
+
+    MlasConvertHalfToFloatBuffer(Source, Destination, Count);
+
+#else
+
+#if defined(MLAS_NEON64_INTRINSICS)
+
+    while (Count >= 8) {
+
+        uint16x8_t HalfVector = vld1q_u16(Source);
+
+        float32x4_t FloatVector0 = vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(HalfVector)));
+        float32x4_t FloatVector1 = vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(HalfVector)));
+
+        vst1q_f32(Destination, FloatVector0);
+        vst1q_f32(Destination + 4, FloatVector1);
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasHalfToFloat(Source[i]);
+    }
+
+#endif
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernel(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision buffer to half precision using
+    round to nearest even.
+
+Arguments:
+
+    Source - Supplies the single precision buffer.
+
+    Destination - Supplies the half precision buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+
+    while (Count >= 8) {
+
+        float16x4_t HalfVector0 = vcvt_f16_f32(vld1q_f32(Source));
+        float16x4_t HalfVector1 = vcvt_f16_f32(vld1q_f32(Source + 4));
+
+        vst1q_u16(Destination, vcombine_u16(vreinterpret_u16_f16(HalfVector0), vreinterpret_u16_f16(HalfVector1)));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToHalf(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatKernel(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a bfloat16 buffer to single precision.
+
+Arguments:
+
+    Source - Supplies the bfloat16 buffer.
+
+    Destination - Supplies the single precision buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+
+    while (Count >= 8) {
+
+        uint16x8_t BFloat16Vector = vld1q_u16(Source);
+
+        vst1q_f32(Destination, vreinterpretq_f32_u32(vshll_n_u16(vget_low_u16(BFloat16Vector), 16)));
+        vst1q_f32(Destination + 4, vreinterpretq_f32_u32(vshll_n_u16(vget_high_u16(BFloat16Vector), 16)));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#elif defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i ZeroVector = _mm_setzero_si128();
+
+    while (Count >= 8) {
+
+        __m128i BFloat16Vector = _mm_loadu_si128((const __m128i*)Source);
+
+        _mm_storeu_si128((__m128i*)Destination, _mm_unpacklo_epi16(ZeroVector, BFloat16Vector));
+        _mm_storeu_si128((__m128i*)(Destination + 4), _mm_unpackhi_epi16(ZeroVector, BFloat16Vector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasBFloat16ToFloat(Source[i]);
+    }
+}
+
+#if defined(MLAS_NEON64_INTRINSICS)
+
+MLAS_FORCEINLINE
+uint16x4_t
+MlasConvertFloatToBFloat16Vector(
+    float32x4_t FloatVector
+    )
+{
+    uint32x4_t Bits = vreinterpretq_u32_f32(FloatVector);
+
+    //
+    // Round to nearest even by adding 0x7FFF plus the lowest retained bit,
+    // then replace NaN values with the canonical quiet NaN.
+    //
+
+    uint32x4_t RoundingBias = vaddq_u32(vandq_u32(vshrq_n_u32(Bits, 16), vdupq_n_u32(1)), vdupq_n_u32(0x7FFF));
+    uint32x4_t Rounded = vaddq_u32(Bits, RoundingBias);
+    uint32x4_t QuietNaN = vorrq_u32(vandq_u32(Bits, vdupq_n_u32(0x80000000)), vdupq_n_u32(0x7FC00000));
+
+    Rounded = vbslq_u32(vceqq_f32(FloatVector, FloatVector), Rounded, QuietNaN);
+
+    return vshrn_n_u32(Rounded, 16);
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Kernel(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision buffer to bfloat16 using round
+    to nearest even.
+
+Arguments:
+
+    Source - Supplies the single precision buffer.
+
+    Destination - Supplies the bfloat16 buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+
+    while (Count >= 8) {
+
+        uint16x4_t BFloat16Vector0 = MlasConvertFloatToBFloat16Vector(vld1q_f32(Source));
+        uint16x4_t BFloat16Vector1 = MlasConvertFloatToBFloat16Vector(vld1q_f32(Source + 4));
+
+        vst1q_u16(Destination, vcombine_u16(BFloat16Vector0, BFloat16Vector1));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToBFloat16(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloat(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertHalfToFloatKernel(Source, Destination, Count);
+#else
+    MlasConvertHalfToFloatKernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertFloatToHalfKernel(Source, Destination, Count);
+#else
+    MlasConvertFloatToHalfKernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloat(
+    const MLAS_BF16* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertBFloat16ToFloatKernel(Source, Destination, Count);
+#else
+    MlasConvertBFloat16ToFloatKernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16(
+    const float* Source,
+    MLAS_BF16* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertFloatToBFloat16Kernel(Source, Destination, Count);
+#else
+    MlasConvertFloatToBFloat16Kernel(Source, Destination, Count);
+#endif
+}
@@ -267,3 +267,134 @@ Return Value:
     MlasErfKernel(Input, Output, N);
 #endif
 }
+
+//
+// Constants of the fast approximation, formula 7.1.27 of Abramowitz and
+// Stegun:
+//
+//     erf(x) = 1 - 1 / (1 + a1 * x + a2 * x^2 + a3 * x^3 + a4 * x^4)^4
+//
+// for x >= 0, extended to negative inputs by symmetry.
+//
+
+const MLAS_FAST_ERF_CONSTANTS MlasFastErfConstants = {
+    0.078108f,
+    0.000972f,
+    0.230389f,
+    0.278393f,
+    1.0f,
+    -0.0f,
+};
+
+void
+MLASCALL
+MlasFastErfKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the fast approximation of
+    the error function.
+
+    The absolute error is below 5e-4 over the whole input range, compared to
+    about 1e-7 for MlasErfKernel.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 NegZero = MlasBroadcastFloat32x4(MlasFastErfConstants.NegZero);
+        MLAS_FLOAT32X4 SignMask = MlasAndFloat32x4(Value, NegZero);
+        MLAS_FLOAT32X4 AbsValue = MlasAndNotFloat32x4(NegZero, Value);
+        MLAS_FLOAT32X4 One = MlasBroadcastFloat32x4(MlasFastErfConstants.one);
+
+        MLAS_FLOAT32X4 d;
+        d = MlasMultiplyAddFloat32x4(AbsValue, MlasBroadcastFloat32x4(MlasFastErfConstants.a4),
+            MlasBroadcastFloat32x4(MlasFastErfConstants.a3));
+        d = MlasMultiplyAddFloat32x4(d, AbsValue, MlasBroadcastFloat32x4(MlasFastErfConstants.a2));
+        d = MlasMultiplyAddFloat32x4(d, AbsValue, MlasBroadcastFloat32x4(MlasFastErfConstants.a1));
+        d = MlasMultiplyAddFloat32x4(d, AbsValue, One);
+        d = MlasMultiplyFloat32x4(d, d);
+        d = MlasMultiplyFloat32x4(d, d);
+
+        MLAS_FLOAT32X4 y = MlasSubtractFloat32x4(One, MlasDivideFloat32x4(One, d));
+
+        MlasStoreFloat32x4(Output, MlasOrFloat32x4(y, SignMask));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+        float AbsValue = fabsf(Value);
+
+        float d;
+        d = AbsValue * MlasFastErfConstants.a4 + MlasFastErfConstants.a3;
+        d = d * AbsValue + MlasFastErfConstants.a2;
+        d = d * AbsValue + MlasFastErfConstants.a1;
+        d = d * AbsValue + MlasFastErfConstants.one;
+        d = d * d;
+        d = d * d;
+
+        float y = MlasFastErfConstants.one - MlasFastErfConstants.one / d;
+
+        *Output++ = (Value < 0.0f) ? -y : y;
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeFastErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a fast approximation of the error function, see
+    MlasFastErfKernel for the error bound.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.FastErfKernelRoutine(Input, Output, N);
+#else
+    MlasFastErfKernel(Input, Output, N);
+#endif
+}
@@ -0,0 +1,653 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.cpp
+
+Abstract:
+
+    This module implements the half precision matrix/matrix multiply
+    operation (HGEMM).
+
+    Platforms with native half precision vector arithmetic use a blocked
+    kernel that multiplies the half precision elements directly. The products
+    are accumulated in half precision over a block of MLAS_HGEMM_STRIDEK and
+    the partial sums are accumulated in single precision to bound the rounding
+    error for large K.
+
+    Other platforms convert the operands to single precision and use the
+    single precision matrix/matrix multiply operation (SGEMM).
+
+--*/
+
+#include "mlasi.h"
+#include <memory>
+
+//
+// Define the parameters to execute segments of a HGEMM operation on worker
+// threads.
+//
+
+struct MLAS_HGEMM_WORK_BLOCK {
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    const MLAS_FP16* A;
+    size_t lda;
+    const MLAS_FP16* B;
+    size_t ldb;
+    MLAS_FP16* C;
+    size_t ldc;
+    float alpha;
+    float beta;
+};
+
+void
+MlasHalfGemmConvertHalfToFloat(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    MlasConvertHalfToFloat(Source, Destination, Count);
+}
+
+void
+MlasHalfGemmConvertMatrix(
+    const MLAS_FP16* Source,
+    size_t ldSource,
+    float* Destination,
+    size_t Rows,
+    size_t Columns
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a half precision matrix to a dense single precision
+    matrix.
+
+Arguments:
+
+    Source - Supplies the address of the half precision matrix.
+
+    ldSource - Supplies the first dimension of the half precision matrix.
+
+    Destination - Supplies the address of the single precision matrix. The
+        first dimension of the matrix is Columns.
+
+    Rows - Supplies the number of rows to convert.
+
+    Columns - Supplies the number of columns to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t r = 0; r < Rows; r++) {
+        MlasHalfGemmConvertHalfToFloat(Source + r * ldSource, Destination + r * Columns, Columns);
+    }
+}
+
+void
+MlasHalfGemmFallback(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_FP16* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    float beta,
+    MLAS_FP16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the half precision matrix/matrix multiply
+    operation for platforms without native half precision arithmetic by
+    converting the operands to single precision and using the SGEMM
+    operation.
+
+Arguments:
+
+    See MlasHalfGemm.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t RowsA = (TransA == CblasNoTrans) ? M : K;
+    const size_t ColumnsA = (TransA == CblasNoTrans) ? K : M;
+    const size_t RowsB = (TransB == CblasNoTrans) ? K : N;
+    const size_t ColumnsB = (TransB == CblasNoTrans) ? N : K;
+
+    std::unique_ptr<float[]> FloatA(new float[RowsA * ColumnsA]);
+    std::unique_ptr<float[]> FloatB(new float[RowsB * ColumnsB]);
+    std::unique_ptr<float[]> FloatC(new float[M * N]);
+
+    MlasHalfGemmConvertMatrix(A, lda, FloatA.get(), RowsA, ColumnsA);
+    MlasHalfGemmConvertMatrix(B, ldb, FloatB.get(), RowsB, ColumnsB);
+
+    if (beta != 0.0f) {
+        MlasHalfGemmConvertMatrix(C, ldc, FloatC.get(), M, N);
+    }
+
+    MlasGemm(TransA, TransB, M, N, K, alpha, FloatA.get(), ColumnsA,
+        FloatB.get(), ColumnsB, beta, FloatC.get(), N, ThreadPool);
+
+    for (size_t m = 0; m < M; m++) {
+        MlasConvertFloatToHalf(FloatC.get() + m * N, C + m * ldc, N);
+    }
+}
+
+#if defined(MLAS_TARGET_ARM64)
+
+void
+MlasHalfGemmCopyPackA(
+    MLAS_FP16* D,
+    const MLAS_FP16* A,
+    size_t lda,
+    CBLAS_TRANSPOSE TransA,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a block of op(A) to a buffer where each of the CountM
+    rows is stored contiguously.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer.
+
+    A - Supplies the address of the first element of the block of op(A).
+
+    lda - Supplies the first dimension of matrix A.
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    CountM - Supplies the number of rows of op(A) to copy.
+
+    CountK - Supplies the number of columns of op(A) to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t m = 0; m < CountM; m++) {
+
+        if (TransA == CblasNoTrans) {
+            std::copy_n(A + m * lda, CountK, D);
+        } else {
+            for (size_t k = 0; k < CountK; k++) {
+                D[k] = A[k * lda + m];
+            }
+        }
+
+        D += CountK;
+    }
+}
+
+void
+MlasHalfGemmCopyPackB(
+    MLAS_FP16* D,
+    const MLAS_FP16* B,
+    size_t ldb,
+    CBLAS_TRANSPOSE TransB,
+    size_t CountK,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a block of op(B) to a buffer of panels. Each panel
+    stores MLAS_HGEMM_PANELN columns for each of the CountK rows. Columns
+    beyond CountN in the last panel are zero filled.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer.
+
+    B - Supplies the address of the first element of the block of op(B).
+
+    ldb - Supplies the first dimension of matrix B.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    CountK - Supplies the number of rows of op(B) to copy.
+
+    CountN - Supplies the number of columns of op(B) to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < CountN; n += MLAS_HGEMM_PANELN) {
+
+        const size_t CountColumns = std::min(CountN - n, size_t(MLAS_HGEMM_PANELN));
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            for (size_t c = 0; c < CountColumns; c++) {
+                D[c] = (TransB == CblasNoTrans) ? B[k * ldb + n + c] : B[(n + c) * ldb + k];
+            }
+
+            std::fill_n(D + CountColumns, MLAS_HGEMM_PANELN - CountColumns, MLAS_FP16(0));
+
+            D += MLAS_HGEMM_PANELN;
+        }
+    }
+}
+
+void
+MlasHalfGemmOperation(
+    const MLAS_HGEMM_WORK_BLOCK* WorkBlock,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the half precision matrix/matrix multiply
+    operation for a segment of the output matrix using the native half
+    precision kernel.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    RangeStartM - Supplies the starting row index to output.
+
+    RangeCountM - Supplies the number of rows to output.
+
+    RangeStartN - Supplies the starting column index to output.
+
+    RangeCountN - Supplies the number of columns to output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(MLAS_FP16 PanelA[4 * MLAS_HGEMM_STRIDEK], 16);
+    MLAS_DECLSPEC_ALIGN(MLAS_FP16 PanelB[MLAS_HGEMM_STRIDEN * MLAS_HGEMM_STRIDEK], 16);
+    MLAS_DECLSPEC_ALIGN(float Accumulators[MLAS_HGEMM_STRIDEM * MLAS_HGEMM_STRIDEN], 16);
+
+    MLAS_HALF_GEMM_KERNEL* HalfGemmKernel = MlasPlatform.HalfGemmKernel;
+
+    const CBLAS_TRANSPOSE TransA = WorkBlock->TransA;
+    const CBLAS_TRANSPOSE TransB = WorkBlock->TransB;
+    const size_t K = WorkBlock->K;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldb = WorkBlock->ldb;
+    const size_t ldc = WorkBlock->ldc;
+    const float alpha = WorkBlock->alpha;
+    const float beta = WorkBlock->beta;
+
+    size_t CountN;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeCountN - n, size_t(MLAS_HGEMM_STRIDEN));
+
+        const size_t StartN = RangeStartN + n;
+
+        size_t CountM;
+
+        for (size_t m = 0; m < RangeCountM; m += CountM) {
+
+            CountM = std::min(RangeCountM - m, size_t(MLAS_HGEMM_STRIDEM));
+
+            const size_t StartM = RangeStartM + m;
+
+            size_t CountK;
+
+            for (size_t k = 0; k < K; k += CountK) {
+
+                CountK = std::min(K - k, size_t(MLAS_HGEMM_STRIDEK));
+
+                const MLAS_FP16* b = (TransB == CblasNoTrans) ?
+                    WorkBlock->B + k * ldb + StartN : WorkBlock->B + StartN * ldb + k;
+
+                MlasHalfGemmCopyPackB(PanelB, b, ldb, TransB, CountK, CountN);
+
+                size_t RowsPacked;
+
+                for (size_t mm = 0; mm < CountM; mm += RowsPacked) {
+
+                    RowsPacked = std::min(CountM - mm, size_t(4));
+
+                    const MLAS_FP16* a = (TransA == CblasNoTrans) ?
+                        WorkBlock->A + (StartM + mm) * lda + k : WorkBlock->A + k * lda + StartM + mm;
+
+                    MlasHalfGemmCopyPackA(PanelA, a, lda, TransA, RowsPacked, CountK);
+
+                    const MLAS_FP16* pa = PanelA;
+                    float* c = Accumulators + mm * MLAS_HGEMM_STRIDEN;
+                    size_t RowsRemaining = RowsPacked;
+
+                    while (RowsRemaining > 0) {
+
+                        size_t RowsHandled = HalfGemmKernel(pa, PanelB, c, CountK,
+                            RowsRemaining, CountN, MLAS_HGEMM_STRIDEN, k == 0);
+
+                        pa += RowsHandled * CountK;
+                        c += RowsHandled * MLAS_HGEMM_STRIDEN;
+                        RowsRemaining -= RowsHandled;
+                    }
+                }
+            }
+
+            //
+            // Apply the alpha and beta scaling and store the output block in
+            // half precision.
+            //
+
+            for (size_t r = 0; r < CountM; r++) {
+
+                const float* c = Accumulators + r * MLAS_HGEMM_STRIDEN;
+                MLAS_FP16* Output = WorkBlock->C + (StartM + r) * ldc + StartN;
+
+                for (size_t i = 0; i < CountN; i++) {
+
+                    float Value = alpha * c[i];
+
+                    if (beta != 0.0f) {
+                        Value += beta * MlasHalfToFloat(Output[i]);
+                    }
+
+                    Output[i] = MlasFloatToHalf(Value);
+                }
+            }
+        }
+    }
+}
+
+void
+MlasHalfGemmThreaded(
+    const MLAS_HGEMM_WORK_BLOCK* WorkBlock,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    HGEMM operation.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / WorkBlock->ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % WorkBlock->ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, WorkBlock->ThreadCountM, WorkBlock->M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t N = WorkBlock->N;
+
+    const size_t BlockedN = (N + MLAS_HGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_HGEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, WorkBlock->ThreadCountN, BlockedN,
+        &RangeStartN, &RangeCountN);
+
+    RangeStartN *= MLAS_HGEMM_STRIDEN_THREAD_ALIGN;
+    RangeCountN *= MLAS_HGEMM_STRIDEN_THREAD_ALIGN;
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    MlasHalfGemmOperation(WorkBlock, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+}
+
+#endif
+
+bool
+MLASCALL
+MlasHalfGemmIsNativeSupported(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether the half precision matrix/matrix multiply
+    operation is executed with native half precision arithmetic on this
+    platform.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns true if a native half precision kernel is available, else false
+    if the operation converts the operands to single precision.
+
+--*/
+{
+#if defined(MLAS_TARGET_ARM64)
+    return MlasPlatform.HalfGemmKernel != nullptr;
+#else
+    return false;
+#endif
+}
+
+void
+MLASCALL
+MlasHalfGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_FP16* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    float beta,
+    MLAS_FP16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the half precision matrix/matrix multiply
+    operation (HGEMM).
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar multiplier (see HGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier (see HGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    //
+    // An empty inner dimension only scales the output matrix.
+    //
+
+    if (K == 0) {
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                MLAS_FP16* Output = C + m * ldc + n;
+                *Output = (beta == 0.0f) ? MLAS_FP16(0) : MlasFloatToHalf(beta * MlasHalfToFloat(*Output));
+            }
+        }
+
+        return;
+    }
+
+#if defined(MLAS_TARGET_ARM64)
+
+    if (MlasPlatform.HalfGemmKernel != nullptr) {
+
+        MLAS_HGEMM_WORK_BLOCK WorkBlock;
+
+        WorkBlock.TransA = TransA;
+        WorkBlock.TransB = TransB;
+        WorkBlock.M = M;
+        WorkBlock.N = N;
+        WorkBlock.K = K;
+        WorkBlock.A = A;
+        WorkBlock.lda = lda;
+        WorkBlock.B = B;
+        WorkBlock.ldb = ldb;
+        WorkBlock.C = C;
+        WorkBlock.ldc = ldc;
+        WorkBlock.alpha = alpha;
+        WorkBlock.beta = beta;
+
+        //
+        // Compute the number of target threads given the complexity of the
+        // HGEMM operation. Small requests should run using the single threaded
+        // path.
+        //
+
+        const double Complexity = double(M) * double(N) * double(K);
+
+        ptrdiff_t TargetThreadCount;
+
+        if (Complexity < double(MLAS_HGEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+            TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_HGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            TargetThreadCount = MlasPlatform.MaximumThreadCount;
+        }
+
+        ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (TargetThreadCount >= MaximumThreadCount) {
+            TargetThreadCount = MaximumThreadCount;
+        }
+
+        //
+        // Segment the operation across multiple threads.
+        //
+        // N.B. Currently, the operation is segmented as a 1D partition, which
+        // works okay for operations involving skinny matrices.
+        //
+
+        if (N > M) {
+
+            const size_t BlockedN = (N + MLAS_HGEMM_STRIDEN_THREAD_ALIGN - 1) /
+                MLAS_HGEMM_STRIDEN_THREAD_ALIGN;
+
+            if (size_t(TargetThreadCount) > BlockedN) {
+                TargetThreadCount = ptrdiff_t(BlockedN);
+            }
+
+            WorkBlock.ThreadCountM = 1;
+            WorkBlock.ThreadCountN = TargetThreadCount;
+
+        } else {
+
+            if (size_t(TargetThreadCount) > M) {
+                TargetThreadCount = ptrdiff_t(M);
+            }
+
+            WorkBlock.ThreadCountM = TargetThreadCount;
+            WorkBlock.ThreadCountN = 1;
+        }
+
+        MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+            MlasHalfGemmThreaded(&WorkBlock, tid);
+        });
+
+        return;
+    }
+
+#endif
+
+    MlasHalfGemmFallback(TransA, TransB, M, N, K, alpha, A, lda, B, ldb,
+        beta, C, ldc, ThreadPool);
+}
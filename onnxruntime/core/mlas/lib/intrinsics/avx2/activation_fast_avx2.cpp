@@ -0,0 +1,159 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    activation_fast_avx2.cpp
+
+Abstract:
+
+    This module implements the fast approximations of the hyperbolic tangent,
+    logistic and error functions with AVX2 and FMA3 instructions.
+
+    The kernels evaluate the same approximations as the generic kernels in
+    tanh.cpp, logistic.cpp and erf.cpp, eight elements at a time.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasFastTanhKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    const __m256 LowerRange = _mm256_set1_ps(MlasFastTanhConstants.LowerRange);
+    const __m256 UpperRange = _mm256_set1_ps(MlasFastTanhConstants.UpperRange);
+    const __m256 alpha_6 = _mm256_set1_ps(MlasFastTanhConstants.alpha_6);
+    const __m256 alpha_4 = _mm256_set1_ps(MlasFastTanhConstants.alpha_4);
+    const __m256 alpha_2 = _mm256_set1_ps(MlasFastTanhConstants.alpha_2);
+    const __m256 beta_6 = _mm256_set1_ps(MlasFastTanhConstants.beta_6);
+    const __m256 beta_4 = _mm256_set1_ps(MlasFastTanhConstants.beta_4);
+    const __m256 beta_2 = _mm256_set1_ps(MlasFastTanhConstants.beta_2);
+    const __m256 one = _mm256_set1_ps(MlasFastTanhConstants.one);
+
+    while (N >= 8) {
+
+        __m256 Value = _mm256_loadu_ps(Input);
+
+        Value = _mm256_min_ps(UpperRange, _mm256_max_ps(LowerRange, Value));
+
+        __m256 ValueSquared = _mm256_mul_ps(Value, Value);
+
+        __m256 p = _mm256_fmadd_ps(ValueSquared, alpha_6, alpha_4);
+        p = _mm256_fmadd_ps(p, ValueSquared, alpha_2);
+        p = _mm256_fmadd_ps(p, ValueSquared, one);
+        p = _mm256_mul_ps(p, Value);
+
+        __m256 q = _mm256_fmadd_ps(ValueSquared, beta_6, beta_4);
+        q = _mm256_fmadd_ps(q, ValueSquared, beta_2);
+        q = _mm256_fmadd_ps(q, ValueSquared, one);
+
+        _mm256_storeu_ps(Output, _mm256_div_ps(p, q));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N > 0) {
+        MlasFastTanhKernel(Input, Output, N);
+    }
+}
+
+void
+MLASCALL
+MlasFastLogisticKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    const __m256 LowerRange = _mm256_set1_ps(MlasFastLogisticConstants.LowerRange);
+    const __m256 UpperRange = _mm256_set1_ps(MlasFastLogisticConstants.UpperRange);
+    const __m256 alpha_6 = _mm256_set1_ps(MlasFastLogisticConstants.alpha_6);
+    const __m256 alpha_4 = _mm256_set1_ps(MlasFastLogisticConstants.alpha_4);
+    const __m256 alpha_2 = _mm256_set1_ps(MlasFastLogisticConstants.alpha_2);
+    const __m256 beta_6 = _mm256_set1_ps(MlasFastLogisticConstants.beta_6);
+    const __m256 beta_4 = _mm256_set1_ps(MlasFastLogisticConstants.beta_4);
+    const __m256 beta_2 = _mm256_set1_ps(MlasFastLogisticConstants.beta_2);
+    const __m256 one = _mm256_set1_ps(MlasFastLogisticConstants.one);
+    const __m256 one_quarter = _mm256_set1_ps(MlasFastLogisticConstants.one_quarter);
+    const __m256 one_half = _mm256_set1_ps(MlasFastLogisticConstants.one_half);
+
+    while (N >= 8) {
+
+        __m256 Value = _mm256_loadu_ps(Input);
+
+        Value = _mm256_min_ps(UpperRange, _mm256_max_ps(LowerRange, Value));
+
+        __m256 ValueSquared = _mm256_mul_ps(Value, Value);
+
+        __m256 p = _mm256_fmadd_ps(ValueSquared, alpha_6, alpha_4);
+        p = _mm256_fmadd_ps(p, ValueSquared, alpha_2);
+        p = _mm256_fmadd_ps(p, ValueSquared, one);
+        p = _mm256_mul_ps(p, _mm256_mul_ps(Value, one_quarter));
+
+        __m256 q = _mm256_fmadd_ps(ValueSquared, beta_6, beta_4);
+        q = _mm256_fmadd_ps(q, ValueSquared, beta_2);
+        q = _mm256_fmadd_ps(q, ValueSquared, one);
+
+        _mm256_storeu_ps(Output, _mm256_add_ps(_mm256_div_ps(p, q), one_half));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N > 0) {
+        MlasFastLogisticKernel(Input, Output, N);
+    }
+}
+
+void
+MLASCALL
+MlasFastErfKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    const __m256 a4 = _mm256_set1_ps(MlasFastErfConstants.a4);
+    const __m256 a3 = _mm256_set1_ps(MlasFastErfConstants.a3);
+    const __m256 a2 = _mm256_set1_ps(MlasFastErfConstants.a2);
+    const __m256 a1 = _mm256_set1_ps(MlasFastErfConstants.a1);
+    const __m256 one = _mm256_set1_ps(MlasFastErfConstants.one);
+    const __m256 NegZero = _mm256_set1_ps(MlasFastErfConstants.NegZero);
+
+    while (N >= 8) {
+
+        __m256 Value = _mm256_loadu_ps(Input);
+        __m256 SignMask = _mm256_and_ps(Value, NegZero);
+        __m256 AbsValue = _mm256_andnot_ps(NegZero, Value);
+
+        __m256 d = _mm256_fmadd_ps(AbsValue, a4, a3);
+        d = _mm256_fmadd_ps(d, AbsValue, a2);
+        d = _mm256_fmadd_ps(d, AbsValue, a1);
+        d = _mm256_fmadd_ps(d, AbsValue, one);
+        d = _mm256_mul_ps(d, d);
+        d = _mm256_mul_ps(d, d);
+
+        __m256 y = _mm256_sub_ps(one, _mm256_div_ps(one, d));
+
+        _mm256_storeu_ps(Output, _mm256_or_ps(y, SignMask));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N > 0) {
+        MlasFastErfKernel(Input, Output, N);
+    }
+}
@@ -0,0 +1,191 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convert_avx2.cpp
+
+Abstract:
+
+    This module implements routines to convert buffers between single
+    precision and the half precision or bfloat16 formats with AVX2 and F16C
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernelAvx2(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m128i HalfVector0 = _mm_loadu_si128((const __m128i*)Source);
+        __m128i HalfVector1 = _mm_loadu_si128((const __m128i*)(Source + 8));
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(HalfVector0));
+        _mm256_storeu_ps(Destination + 8, _mm256_cvtph_ps(HalfVector1));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)Source)));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasHalfToFloat(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernelAvx2(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m128i HalfVector0 = _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        __m128i HalfVector1 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + 8), _MM_FROUND_TO_NEAREST_INT);
+
+        _mm_storeu_si128((__m128i*)Destination, HalfVector0);
+        _mm_storeu_si128((__m128i*)(Destination + 8), HalfVector1);
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        _mm_storeu_si128((__m128i*)Destination, _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToHalf(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatKernelAvx2(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m256i BFloat16Vector = _mm256_loadu_si256((const __m256i*)Source);
+
+        __m256i FloatVector0 = _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(BFloat16Vector)), 16);
+        __m256i FloatVector1 = _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(BFloat16Vector, 1)), 16);
+
+        _mm256_storeu_si256((__m256i*)Destination, FloatVector0);
+        _mm256_storeu_si256((__m256i*)(Destination + 8), FloatVector1);
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasBFloat16ToFloat(Source[i]);
+    }
+}
+
+MLAS_FORCEINLINE
+__m256i
+MlasConvertFloatToBFloat16Avx2(
+    __m256 FloatVector
+    )
+/*++
+
+Routine Description:
+
+    This routine rounds eight single precision values to bfloat16 using round
+    to nearest even. The results are returned in the low 16 bits of each 32-bit
+    lane.
+
+    AVX512_BF16 has a native conversion instruction, but it flushes denormal
+    inputs to zero, so the rounding is done with integer operations to match
+    the scalar conversion exactly.
+
+Arguments:
+
+    FloatVector - Supplies the single precision values.
+
+Return Value:
+
+    Returns the bfloat16 values.
+
+--*/
+{
+    const __m256i Bits = _mm256_castps_si256(FloatVector);
+
+    __m256i Lsb = _mm256_and_si256(_mm256_srli_epi32(Bits, 16), _mm256_set1_epi32(1));
+    __m256i Rounded = _mm256_add_epi32(Bits, _mm256_add_epi32(Lsb, _mm256_set1_epi32(0x7FFF)));
+
+    __m256i QuietNaN = _mm256_or_si256(_mm256_and_si256(Bits, _mm256_set1_epi32(int32_t(0x80000000))),
+                                       _mm256_set1_epi32(0x7FC00000));
+    __m256 IsNaN = _mm256_cmp_ps(FloatVector, FloatVector, _CMP_UNORD_Q);
+
+    Rounded = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(Rounded), _mm256_castsi256_ps(QuietNaN), IsNaN));
+
+    return _mm256_srli_epi32(Rounded, 16);
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16KernelAvx2(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m256i BFloat16Vector0 = MlasConvertFloatToBFloat16Avx2(_mm256_loadu_ps(Source));
+        __m256i BFloat16Vector1 = MlasConvertFloatToBFloat16Avx2(_mm256_loadu_ps(Source + 8));
+
+        //
+        // The pack instruction interleaves the 128-bit lanes of the two
+        // sources, so restore the element order with a permute.
+        //
+
+        __m256i BFloat16Vector = _mm256_packus_epi32(BFloat16Vector0, BFloat16Vector1);
+        BFloat16Vector = _mm256_permute4x64_epi64(BFloat16Vector, 0xD8);
+
+        _mm256_storeu_si256((__m256i*)Destination, BFloat16Vector);
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToBFloat16(Source[i]);
+    }
+}
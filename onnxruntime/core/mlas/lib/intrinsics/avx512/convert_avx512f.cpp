@@ -0,0 +1,179 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convert_avx512f.cpp
+
+Abstract:
+
+    This module implements routines to convert buffers between single
+    precision and the half precision or bfloat16 formats with AVX512F
+    instructions.
+
+    The AVX512F half precision conversions are used rather than AVX512_FP16,
+    which is only needed for half precision arithmetic and is not available on
+    most processors.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernelAvx512F(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 32) {
+
+        __m256i HalfVector0 = _mm256_loadu_si256((const __m256i*)Source);
+        __m256i HalfVector1 = _mm256_loadu_si256((const __m256i*)(Source + 16));
+
+        _mm512_storeu_ps(Destination, _mm512_cvtph_ps(HalfVector0));
+        _mm512_storeu_ps(Destination + 16, _mm512_cvtph_ps(HalfVector1));
+
+        Source += 32;
+        Destination += 32;
+        Count -= 32;
+    }
+
+    if (Count >= 16) {
+
+        _mm512_storeu_ps(Destination, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)Source)));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasHalfToFloat(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernelAvx512F(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 32) {
+
+        __m256i HalfVector0 = _mm512_cvtps_ph(_mm512_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        __m256i HalfVector1 = _mm512_cvtps_ph(_mm512_loadu_ps(Source + 16), _MM_FROUND_TO_NEAREST_INT);
+
+        _mm256_storeu_si256((__m256i*)Destination, HalfVector0);
+        _mm256_storeu_si256((__m256i*)(Destination + 16), HalfVector1);
+
+        Source += 32;
+        Destination += 32;
+        Count -= 32;
+    }
+
+    if (Count >= 16) {
+
+        _mm256_storeu_si256((__m256i*)Destination, _mm512_cvtps_ph(_mm512_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToHalf(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatKernelAvx512F(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m512i FloatVector = _mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)Source)), 16);
+
+        _mm512_storeu_si512(Destination, FloatVector);
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasBFloat16ToFloat(Source[i]);
+    }
+}
+
+MLAS_FORCEINLINE
+__m256i
+MlasConvertFloatToBFloat16Avx512F(
+    __m512 FloatVector
+    )
+/*++
+
+Routine Description:
+
+    This routine rounds sixteen single precision values to bfloat16 using
+    round to nearest even.
+
+    AVX512_BF16 has a native conversion instruction, but it flushes denormal
+    inputs to zero, so the rounding is done with integer operations to match
+    the scalar conversion exactly.
+
+Arguments:
+
+    FloatVector - Supplies the single precision values.
+
+Return Value:
+
+    Returns the bfloat16 values.
+
+--*/
+{
+    const __m512i Bits = _mm512_castps_si512(FloatVector);
+
+    __m512i Lsb = _mm512_and_si512(_mm512_srli_epi32(Bits, 16), _mm512_set1_epi32(1));
+    __m512i Rounded = _mm512_add_epi32(Bits, _mm512_add_epi32(Lsb, _mm512_set1_epi32(0x7FFF)));
+
+    __m512i QuietNaN = _mm512_or_si512(_mm512_and_si512(Bits, _mm512_set1_epi32(int32_t(0x80000000))),
+                                       _mm512_set1_epi32(0x7FC00000));
+    __mmask16 IsNaN = _mm512_cmp_ps_mask(FloatVector, FloatVector, _CMP_UNORD_Q);
+
+    Rounded = _mm512_mask_mov_epi32(Rounded, IsNaN, QuietNaN);
+
+    return _mm512_cvtepi32_epi16(_mm512_srli_epi32(Rounded, 16));
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16KernelAvx512F(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        _mm256_storeu_si256((__m256i*)Destination, MlasConvertFloatToBFloat16Avx512F(_mm512_loadu_ps(Source)));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToBFloat16(Source[i]);
+    }
+}
@@ -0,0 +1,313 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with bfloat16 operands (SBGEMM) using AMX instructions.
+
+    The kernel computes up to 32 rows by 32 columns of the output matrix per
+    iteration using four 16x16 single precision accumulator tiles. Tiles 4
+    and 5 hold 16 rows by 32 elements of matrix A and tiles 6 and 7 hold 16
+    pairs of rows of a panel of matrix B, which is exactly the layout produced
+    by MlasSBGemmPackB.
+
+    Rows of matrix A beyond CountM are read from the zero filled stride of the
+    A buffer and the corresponding output rows are discarded.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the tile configuration structure consumed by ldtilecfg.
+//
+
+struct MLAS_AMX_TILE_CONFIG {
+    uint8_t PaletteId;
+    uint8_t StartRow;
+    uint8_t Reserved[14];
+    uint16_t ColumnBytes[16];
+    uint8_t Rows[16];
+};
+
+//
+// Skinny matrices do not fill the 16 rows of an A tile, so the AVX512_BF16
+// kernel is used below this threshold.
+//
+
+#define MLAS_SBGEMM_AMX_MINIMUM_ROWS                8
+
+MLAS_FORCEINLINE
+void
+MlasSBGemmConfigureTilesAmx(
+    void
+    )
+{
+    MLAS_DECLSPEC_ALIGN(MLAS_AMX_TILE_CONFIG TileConfig, 64) = {};
+
+    TileConfig.PaletteId = 1;
+
+    for (size_t t = 0; t < 8; t++) {
+        TileConfig.ColumnBytes[t] = 64;
+        TileConfig.Rows[t] = 16;
+    }
+
+    _tile_loadconfig(&TileConfig);
+}
+
+MLAS_FORCEINLINE
+void
+MlasSBGemmStoreTileAmx(
+    const float* Tile,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the alpha and beta scaling to a 16x16 accumulator
+    tile stored in memory and stores the valid elements to the output matrix.
+
+Arguments:
+
+    Tile - Supplies the address of the accumulator tile.
+
+    C - Supplies the address of the output block.
+
+    CountM - Supplies the number of valid rows of the tile.
+
+    CountN - Supplies the number of valid columns of the tile.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __m512 AlphaBroadcast = _mm512_set1_ps(alpha);
+    const __m512 BetaBroadcast = _mm512_set1_ps(beta);
+    const __mmask16 Mask = __mmask16((uint32_t(1) << std::min(CountN, size_t(16))) - 1);
+
+    for (size_t r = 0; r < std::min(CountM, size_t(16)); r++) {
+
+        float* c = C + r * ldc;
+        __m512 Result = _mm512_mul_ps(_mm512_load_ps(Tile + r * 16), AlphaBroadcast);
+
+        if (beta != 0.0f) {
+            Result = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(Mask, c), BetaBroadcast, Result);
+        }
+
+        _mm512_mask_storeu_ps(c, Mask, Result);
+    }
+}
+
+template<bool TwoRowTiles, bool TwoColumnTiles>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelBlockAmx(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of up to 32 rows by 32 columns of the output
+    matrix.
+
+Arguments:
+
+    A - Supplies the address of the first row of the block of matrix A.
+
+    B - Supplies the address of the first packed panel of matrix B.
+
+    C - Supplies the address of the first element of the output block.
+
+    CountK - Supplies the padded number of columns of matrix A and the number
+        of rows of matrix B.
+
+    CountM - Supplies the number of valid rows of the output block.
+
+    CountN - Supplies the number of valid columns of the output block.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Tile[16 * 16], 64);
+
+    const size_t StrideA = CountK * sizeof(uint16_t);
+    const size_t PanelStride = CountK * MLAS_SBGEMM_PANELN;
+
+    _tile_zero(0);
+    if (TwoColumnTiles) _tile_zero(1);
+    if (TwoRowTiles) _tile_zero(2);
+    if (TwoRowTiles && TwoColumnTiles) _tile_zero(3);
+
+    for (size_t k = 0; k < CountK; k += MLAS_SBGEMM_ALIGNK) {
+
+        _tile_loadd(4, A + k, StrideA);
+        _tile_loadd(6, B + k * MLAS_SBGEMM_PANELN, 64);
+        _tile_dpbf16ps(0, 4, 6);
+
+        if (TwoColumnTiles) {
+            _tile_loadd(7, B + PanelStride + k * MLAS_SBGEMM_PANELN, 64);
+            _tile_dpbf16ps(1, 4, 7);
+        }
+
+        if (TwoRowTiles) {
+            _tile_loadd(5, A + 16 * CountK + k, StrideA);
+            _tile_dpbf16ps(2, 5, 6);
+
+            if (TwoColumnTiles) {
+                _tile_dpbf16ps(3, 5, 7);
+            }
+        }
+    }
+
+    _tile_stored(0, Tile, 64);
+    MlasSBGemmStoreTileAmx(Tile, C, CountM, CountN, ldc, alpha, beta);
+
+    if (TwoColumnTiles) {
+        _tile_stored(1, Tile, 64);
+        MlasSBGemmStoreTileAmx(Tile, C + 16, CountM, CountN - 16, ldc, alpha, beta);
+    }
+
+    if (TwoRowTiles) {
+        _tile_stored(2, Tile, 64);
+        MlasSBGemmStoreTileAmx(Tile, C + 16 * ldc, CountM - 16, CountN, ldc, alpha, beta);
+
+        if (TwoColumnTiles) {
+            _tile_stored(3, Tile, 64);
+            MlasSBGemmStoreTileAmx(Tile, C + 16 * ldc + 16, CountM - 16, CountN - 16, ldc, alpha, beta);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSBGemmKernelAmx(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute a block of the SBGEMM
+    operation.
+
+Arguments:
+
+    A - Supplies the address of matrix A converted to bfloat16. The rows are
+        stored with a stride of CountK elements. The buffer is readable for
+        CountM rows rounded up to a multiple of 16.
+
+    B - Supplies the address of the first panel of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the padded number of columns of matrix A and the number
+        of rows of matrix B. The value is a multiple of MLAS_SBGEMM_ALIGNK.
+
+    CountM - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition). The
+        existing contents of matrix C are ignored if beta is zero.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (CountM < MLAS_SBGEMM_AMX_MINIMUM_ROWS) {
+        MlasSBGemmKernelAvx512Bf16(A, B, C, CountK, CountM, CountN, ldc, alpha, beta);
+        return;
+    }
+
+    //
+    // The tile configuration is thread state, so load the configuration for
+    // each call as the kernel may run on any thread of the thread pool.
+    //
+
+    MlasSBGemmConfigureTilesAmx();
+
+    const size_t PanelStride = CountK * MLAS_SBGEMM_PANELN;
+
+    for (size_t m = 0; m < CountM; m += 32) {
+
+        const size_t RowsRemaining = CountM - m;
+        const uint16_t* a = A + m * CountK;
+
+        for (size_t n = 0; n < CountN; n += 32) {
+
+            const size_t ColumnsRemaining = CountN - n;
+            const uint16_t* b = B + (n / MLAS_SBGEMM_PANELN) * PanelStride;
+            float* c = C + m * ldc + n;
+
+            if (RowsRemaining > 16) {
+                if (ColumnsRemaining > 16) {
+                    MlasSBGemmKernelBlockAmx<true, true>(a, b, c, CountK, RowsRemaining, ColumnsRemaining, ldc, alpha, beta);
+                } else {
+                    MlasSBGemmKernelBlockAmx<true, false>(a, b, c, CountK, RowsRemaining, ColumnsRemaining, ldc, alpha, beta);
+                }
+            } else {
+                if (ColumnsRemaining > 16) {
+                    MlasSBGemmKernelBlockAmx<false, true>(a, b, c, CountK, RowsRemaining, ColumnsRemaining, ldc, alpha, beta);
+                } else {
+                    MlasSBGemmKernelBlockAmx<false, false>(a, b, c, CountK, RowsRemaining, ColumnsRemaining, ldc, alpha, beta);
+                }
+            }
+        }
+    }
+
+    _tile_release();
+}
@@ -0,0 +1,232 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with bfloat16 operands (SBGEMM) using AVX512_BF16
+    instructions.
+
+    The kernel computes up to four rows by two panels of the output matrix
+    per iteration. Each iteration of the inner loop broadcasts a pair of
+    adjacent K elements from a row of matrix A and multiplies the pair with
+    the packed pairs of the 16 columns of a panel of matrix B.
+
+--*/
+
+#include "mlasi.h"
+#include <cstring>
+
+template<size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelBlockAvx512Bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of RowCount rows by PanelCount panels of the
+    output matrix.
+
+Arguments:
+
+    A - Supplies the address of the first row of the block of matrix A. The
+        rows are stored with a stride of CountK elements.
+
+    B - Supplies the address of the first packed panel of matrix B.
+
+    C - Supplies the address of the first element of the output block.
+
+    CountK - Supplies the padded number of columns of matrix A and the number
+        of rows of matrix B.
+
+    CountN - Supplies the number of columns of the output block.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_ps();
+        }
+    }
+
+    const size_t PanelStride = CountK * MLAS_SBGEMM_PANELN;
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        __m512i BElements[PanelCount];
+
+        for (size_t p = 0; p < PanelCount; p++) {
+            BElements[p] = _mm512_loadu_si512(B + p * PanelStride + k * MLAS_SBGEMM_PANELN);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t APair;
+            std::memcpy(&APair, A + r * CountK + k, sizeof(APair));
+
+            const __m512i ABroadcast = _mm512_set1_epi32(APair);
+
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_dpbf16_ps(Accumulators[r][p],
+                    (__m512bh)ABroadcast, (__m512bh)BElements[p]);
+            }
+        }
+    }
+
+    //
+    // Apply the alpha and beta scaling and store the output block.
+    //
+
+    const __m512 AlphaBroadcast = _mm512_set1_ps(alpha);
+    const __m512 BetaBroadcast = _mm512_set1_ps(beta);
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        const size_t CountColumns = std::min(CountN - p * MLAS_SBGEMM_PANELN, size_t(MLAS_SBGEMM_PANELN));
+        const __mmask16 Mask = __mmask16((uint32_t(1) << CountColumns) - 1);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c = C + r * ldc + p * MLAS_SBGEMM_PANELN;
+            __m512 Result = _mm512_mul_ps(Accumulators[r][p], AlphaBroadcast);
+
+            if (beta != 0.0f) {
+                Result = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(Mask, c), BetaBroadcast, Result);
+            }
+
+            _mm512_mask_storeu_ps(c, Mask, Result);
+        }
+    }
+}
+
+template<size_t PanelCount>
+MLAS_FORCEINLINE
+size_t
+MlasSBGemmKernelRowsAvx512Bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+{
+    if (CountM >= 4) {
+        MlasSBGemmKernelBlockAvx512Bf16<4, PanelCount>(A, B, C, CountK, CountN, ldc, alpha, beta);
+        return 4;
+    } else if (CountM == 3) {
+        MlasSBGemmKernelBlockAvx512Bf16<3, PanelCount>(A, B, C, CountK, CountN, ldc, alpha, beta);
+    } else if (CountM == 2) {
+        MlasSBGemmKernelBlockAvx512Bf16<2, PanelCount>(A, B, C, CountK, CountN, ldc, alpha, beta);
+    } else {
+        MlasSBGemmKernelBlockAvx512Bf16<1, PanelCount>(A, B, C, CountK, CountN, ldc, alpha, beta);
+    }
+
+    return CountM;
+}
+
+void
+MLASCALL
+MlasSBGemmKernelAvx512Bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute a block of the SBGEMM
+    operation.
+
+Arguments:
+
+    A - Supplies the address of matrix A converted to bfloat16. The rows are
+        stored with a stride of CountK elements.
+
+    B - Supplies the address of the first panel of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the padded number of columns of matrix A and the number
+        of rows of matrix B. The value is a multiple of MLAS_SBGEMM_ALIGNK.
+
+    CountM - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition). The
+        existing contents of matrix C are ignored if beta is zero.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t PanelStride = CountK * MLAS_SBGEMM_PANELN;
+
+    for (size_t n = 0; n < CountN; n += 2 * MLAS_SBGEMM_PANELN) {
+
+        const size_t CountColumns = std::min(CountN - n, size_t(2 * MLAS_SBGEMM_PANELN));
+        const uint16_t* b = B + (n / MLAS_SBGEMM_PANELN) * PanelStride;
+
+        size_t RowsHandled;
+
+        for (size_t m = 0; m < CountM; m += RowsHandled) {
+
+            const uint16_t* a = A + m * CountK;
+            float* c = C + m * ldc + n;
+
+            if (CountColumns > MLAS_SBGEMM_PANELN) {
+                RowsHandled = MlasSBGemmKernelRowsAvx512Bf16<2>(a, b, c, CountK, CountM - m,
+                    CountColumns, ldc, alpha, beta);
+            } else {
+                RowsHandled = MlasSBGemmKernelRowsAvx512Bf16<1>(a, b, c, CountK, CountM - m,
+                    CountColumns, ldc, alpha, beta);
+            }
+        }
+    }
+}
@@ -178,3 +178,144 @@ Return Value:
     MlasLogisticKernel(Input, Output, N);
 #endif
 }
+
+//
+// Constants of the fast approximation. The logistic function is computed as
+// 0.5 + 0.5 * tanh(x / 2), where tanh is the [7/6] Pade approximant used by
+// MlasFastTanhKernel with the coefficients scaled for the halved input.
+//
+
+const MLAS_FAST_LOGISTIC_CONSTANTS MlasFastLogisticConstants = {
+    -9.6f,
+    9.6f,
+    1.156251156e-07f,
+    1.748251748e-04f,
+    3.205128205e-02f,
+    3.237503238e-06f,
+    1.456876457e-03f,
+    1.153846154e-01f,
+    1.0f,
+    0.25f,
+    0.5f,
+};
+
+void
+MLASCALL
+MlasFastLogisticKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the fast approximation of
+    the logistic function.
+
+    The absolute error is below 4e-5 over the whole input range, compared to
+    about 1e-7 for MlasLogisticKernel.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+
+        Value = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasFastLogisticConstants.LowerRange), Value);
+        Value = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasFastLogisticConstants.UpperRange), Value);
+
+        MLAS_FLOAT32X4 ValueSquared = MlasMultiplyFloat32x4(Value, Value);
+
+        MLAS_FLOAT32X4 p;
+        p = MlasMultiplyAddFloat32x4(ValueSquared, MlasBroadcastFloat32x4(MlasFastLogisticConstants.alpha_6),
+            MlasBroadcastFloat32x4(MlasFastLogisticConstants.alpha_4));
+        p = MlasMultiplyAddFloat32x4(p, ValueSquared, MlasBroadcastFloat32x4(MlasFastLogisticConstants.alpha_2));
+        p = MlasMultiplyAddFloat32x4(p, ValueSquared, MlasBroadcastFloat32x4(MlasFastLogisticConstants.one));
+        p = MlasMultiplyFloat32x4(p, MlasMultiplyFloat32x4(Value, MlasBroadcastFloat32x4(MlasFastLogisticConstants.one_quarter)));
+
+        MLAS_FLOAT32X4 q;
+        q = MlasMultiplyAddFloat32x4(ValueSquared, MlasBroadcastFloat32x4(MlasFastLogisticConstants.beta_6),
+            MlasBroadcastFloat32x4(MlasFastLogisticConstants.beta_4));
+        q = MlasMultiplyAddFloat32x4(q, ValueSquared, MlasBroadcastFloat32x4(MlasFastLogisticConstants.beta_2));
+        q = MlasMultiplyAddFloat32x4(q, ValueSquared, MlasBroadcastFloat32x4(MlasFastLogisticConstants.one));
+
+        MlasStoreFloat32x4(Output, MlasAddFloat32x4(MlasDivideFloat32x4(p, q),
+            MlasBroadcastFloat32x4(MlasFastLogisticConstants.one_half)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        Value = std::min(MlasFastLogisticConstants.UpperRange, std::max(MlasFastLogisticConstants.LowerRange, Value));
+
+        float ValueSquared = Value * Value;
+
+        float p;
+        p = ValueSquared * MlasFastLogisticConstants.alpha_6 + MlasFastLogisticConstants.alpha_4;
+        p = p * ValueSquared + MlasFastLogisticConstants.alpha_2;
+        p = p * ValueSquared + MlasFastLogisticConstants.one;
+        p = p * (Value * MlasFastLogisticConstants.one_quarter);
+
+        float q;
+        q = ValueSquared * MlasFastLogisticConstants.beta_6 + MlasFastLogisticConstants.beta_4;
+        q = q * ValueSquared + MlasFastLogisticConstants.beta_2;
+        q = q * ValueSquared + MlasFastLogisticConstants.one;
+
+        *Output++ = (p / q) + MlasFastLogisticConstants.one_half;
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeFastLogistic(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a fast approximation of the logistic function, see
+    MlasFastLogisticKernel for the error bound.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.FastLogisticKernelRoutine(Input, Output, N);
+#else
+    MlasFastLogisticKernel(Input, Output, N);
+#endif
+}
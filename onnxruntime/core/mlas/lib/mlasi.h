@@ -125,6 +125,13 @@ Abstract:
 #define MLAS_SGEMM_PACKED_STRIDEK                   256
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
+#define MLAS_HGEMM_STRIDEM                          64
+#define MLAS_HGEMM_STRIDEN                          32
+#define MLAS_HGEMM_STRIDEK                          128
+#define MLAS_HGEMM_PANELN                           16
+#define MLAS_SBGEMM_STRIDEM                         32
+#define MLAS_SBGEMM_PANELN                          16
+#define MLAS_SBGEMM_ALIGNK                          32
 
 //
 // Define the alignment for segmenting a GEMM operation across multiple
@@ -138,6 +145,17 @@ Abstract:
 #define MLAS_SGEMM_STRIDEN_THREAD_ALIGN             16
 #define MLAS_DGEMM_STRIDEN_THREAD_ALIGN             8
 #define MLAS_QGEMM_STRIDEN_THREAD_ALIGN             16
+#define MLAS_HGEMM_STRIDEN_THREAD_ALIGN             16
+#define MLAS_SBGEMM_STRIDEN_THREAD_ALIGN            32
+
+//
+// Define the largest M for which a SGEMM operation is also segmented along
+// the K dimension when the N dimension does not provide enough blocks for the
+// target number of threads. The K dimension is segmented in units of the
+// packed K stride, so that the slices of a packed matrix B stay contiguous.
+//
+
+#define MLAS_SGEMM_SPLITK_MAXIMUM_M                 8
 
 //
 // Define the prototypes of the platform optimized routines.
@@ -219,6 +237,33 @@ void
     bool ZeroMode
     );
 
+typedef
+size_t
+(MLASCALL MLAS_HALF_GEMM_KERNEL)(
+    const MLAS_FP16* A,
+    const MLAS_FP16* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    );
+
+typedef
+void
+(MLASCALL MLAS_SBGEMM_KERNEL)(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    );
+
 typedef
 void
 (MLASCALL MLAS_SGEMM_KERNEL_M1_ROUTINE)(
@@ -465,6 +510,22 @@ void
     int8_t ZeroPoint
     );
 
+typedef
+void
+(MLASCALL MLAS_CONVERT_TO_FLOAT_KERNEL)(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_FROM_FLOAT_KERNEL)(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
 template<typename FilterType>
 struct MLAS_U8X8_KERNEL
 {
@@ -511,6 +572,15 @@ extern "C" {
     MLAS_GEMV_FLOAT_KERNEL MlasGemvFloatKernel;
 #endif
 
+#if defined(MLAS_TARGET_ARM64)
+    MLAS_HALF_GEMM_KERNEL MlasHalfGemmKernelNeon;
+#endif
+
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_SBGEMM_KERNEL MlasSBGemmKernelAvx512Bf16;
+    MLAS_SBGEMM_KERNEL MlasSBGemmKernelAmx;
+#endif
+
 #if defined(MLAS_TARGET_AMD64)
     MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE MlasSgemmTransposePackB16x4Sse;
     MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE MlasSgemmTransposePackB16x4Avx;
@@ -569,6 +639,9 @@ extern "C" {
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32Kernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasLogisticKernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasTanhKernel;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasFastErfKernel;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasFastLogisticKernel;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasFastTanhKernel;
     MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32Kernel;
     MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeSoftmaxOutputF32Kernel;
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeLogSoftmaxOutputF32Kernel;
@@ -576,12 +649,19 @@ extern "C" {
     MLAS_QLINEAR_BINARY_OP_U8_KERNEL MlasQLinearAddU8Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL MlasQuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL MlasQuantizeLinearU8Kernel;
+    MLAS_CONVERT_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernel;
+    MLAS_CONVERT_FROM_FLOAT_KERNEL MlasConvertFloatToHalfKernel;
+    MLAS_CONVERT_TO_FLOAT_KERNEL MlasConvertBFloat16ToFloatKernel;
+    MLAS_CONVERT_FROM_FLOAT_KERNEL MlasConvertFloatToBFloat16Kernel;
 #if defined(MLAS_TARGET_AMD64)
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasErfKernelFma3;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32KernelFma3;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32KernelAvx512F;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeLogisticF32KernelFma3;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeTanhF32KernelFma3;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasFastErfKernelFma3;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasFastLogisticKernelFma3;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasFastTanhKernelFma3;
     MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32KernelFma3;
     MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32KernelAvx512F;
     MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeSoftmaxOutputF32KernelAvx;
@@ -590,6 +670,14 @@ extern "C" {
     MLAS_QLINEAR_BINARY_OP_U8_KERNEL MlasQLinearAddU8KernelAvx2;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL MlasQuantizeLinearS8KernelAvx512F;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL MlasQuantizeLinearU8KernelAvx512F;
+    MLAS_CONVERT_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernelAvx2;
+    MLAS_CONVERT_FROM_FLOAT_KERNEL MlasConvertFloatToHalfKernelAvx2;
+    MLAS_CONVERT_TO_FLOAT_KERNEL MlasConvertBFloat16ToFloatKernelAvx2;
+    MLAS_CONVERT_FROM_FLOAT_KERNEL MlasConvertFloatToBFloat16KernelAvx2;
+    MLAS_CONVERT_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernelAvx512F;
+    MLAS_CONVERT_FROM_FLOAT_KERNEL MlasConvertFloatToHalfKernelAvx512F;
+    MLAS_CONVERT_TO_FLOAT_KERNEL MlasConvertBFloat16ToFloatKernelAvx512F;
+    MLAS_CONVERT_FROM_FLOAT_KERNEL MlasConvertFloatToBFloat16KernelAvx512F;
 #endif
 
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32Kernel;
@@ -601,6 +689,50 @@ extern "C" {
 
 }
 
+//
+// Constants of the fast approximations of the activation functions, shared by
+// the generic kernels and the kernels for newer instruction sets.
+//
+
+struct MLAS_FAST_TANH_CONSTANTS {
+    float LowerRange;
+    float UpperRange;
+    float alpha_6;
+    float alpha_4;
+    float alpha_2;
+    float beta_6;
+    float beta_4;
+    float beta_2;
+    float one;
+};
+
+struct MLAS_FAST_LOGISTIC_CONSTANTS {
+    float LowerRange;
+    float UpperRange;
+    float alpha_6;
+    float alpha_4;
+    float alpha_2;
+    float beta_6;
+    float beta_4;
+    float beta_2;
+    float one;
+    float one_quarter;
+    float one_half;
+};
+
+struct MLAS_FAST_ERF_CONSTANTS {
+    float a4;
+    float a3;
+    float a2;
+    float a1;
+    float one;
+    float NegZero;
+};
+
+extern const MLAS_FAST_TANH_CONSTANTS MlasFastTanhConstants;
+extern const MLAS_FAST_LOGISTIC_CONSTANTS MlasFastLogisticConstants;
+extern const MLAS_FAST_ERF_CONSTANTS MlasFastErfConstants;
+
 //
 // Define the default preferred byte alignment for buffers.
 //
@@ -626,6 +758,10 @@ extern "C" {
 #define MLAS_SGEMM_THREAD_COMPLEXITY                (64 * 1024)
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (64 * 1024)
 #define MLAS_QGEMM_THREAD_COMPLEXITY                (64 * 1024)
+#define MLAS_HGEMM_THREAD_COMPLEXITY                (64 * 1024)
+#define MLAS_SBGEMM_THREAD_COMPLEXITY               (64 * 1024)
+#define MLAS_SPARSE_GEMM_THREAD_COMPLEXITY          (64 * 1024)
+#define MLAS_Q4_GEMM_THREAD_COMPLEXITY              (64 * 1024)
 
 //
 // Single-threaded single precision matrix/matrix multiply operation.
@@ -660,7 +796,12 @@ extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8S8DispatchAvx2;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8U8DispatchAvx2;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchNeon;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchUdot;
+extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchWasmSimd;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchDefault;
+extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchAvx2;
+extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchVnni;
+extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchSdot;
+extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchDefault;
 
 //
 // Quantized depthwise convolution kernels.
@@ -716,6 +857,7 @@ struct MLAS_PLATFORM {
     MLAS_GEMV_U8S8_KERNEL* GemvU8S8Kernel;
     const MLAS_GEMM_U8X8_DISPATCH* GemmU8U8Dispatch;
     MLAS_GEMM_U8U8_KERNEL* GemmU8U8Kernel;
+    const MLAS_GEMM_U8X8_DISPATCH* GemmS8S8Dispatch;
     MLAS_CONV_FLOAT_KERNEL* ConvNchwFloatKernel;
     MLAS_CONV_FLOAT_KERNEL* ConvNchwcFloatKernel;
     MLAS_CONV_DEPTHWISE_FLOAT_KERNEL* ConvDepthwiseFloatKernel;
@@ -729,6 +871,9 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* ComputeExpF32Kernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* LogisticKernelRoutine;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* TanhKernelRoutine;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* FastErfKernelRoutine;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* FastLogisticKernelRoutine;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* FastTanhKernelRoutine;
     MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL* ComputeSumExpF32Kernel;
     MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeSoftmaxOutputF32Kernel;
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
@@ -736,6 +881,11 @@ struct MLAS_PLATFORM {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
+    MLAS_CONVERT_TO_FLOAT_KERNEL* ConvertHalfToFloatKernel;
+    MLAS_CONVERT_FROM_FLOAT_KERNEL* ConvertFloatToHalfKernel;
+    MLAS_CONVERT_TO_FLOAT_KERNEL* ConvertBFloat16ToFloatKernel;
+    MLAS_CONVERT_FROM_FLOAT_KERNEL* ConvertFloatToBFloat16Kernel;
+    MLAS_SBGEMM_KERNEL* SBGemmKernel;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
     int32_t MaximumThreadCount;
@@ -745,7 +895,17 @@ struct MLAS_PLATFORM {
 
 #if defined(MLAS_TARGET_ARM64)
     const MLAS_GEMM_U8X8_DISPATCH* GemmU8X8Dispatch;
+    const MLAS_GEMM_U8X8_DISPATCH* GemmS8S8Dispatch;
+    MLAS_HALF_GEMM_KERNEL* HalfGemmKernel;
 #endif
+
+    //
+    // SGEMM blocking and threading parameters, see MlasSgemmSetTuningParameters.
+    //
+
+    size_t SgemmStrideN;
+    size_t SgemmStrideK;
+    size_t SgemmThreadComplexity;
 };
 
 extern MLAS_PLATFORM MlasPlatform;
@@ -865,8 +1025,183 @@ MlasFp32FromBits(
     return u.FloatValue;
 }
 
+MLAS_FORCEINLINE
+float
+MlasHalfToFloat(
+    MLAS_FP16 Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a half precision value to single precision.
+
+Arguments:
+
+    Value - Supplies the half precision value.
+
+Return Value:
+
+    Returns the single precision value.
+
+--*/
+{
+    const uint32_t Sign = uint32_t(Value & 0x8000) << 16;
+    uint32_t Exponent = (Value >> 10) & 0x1F;
+    uint32_t Mantissa = Value & 0x3FF;
+
+    if (Exponent == 0x1F) {
+
+        //
+        // Infinity or NaN.
+        //
+
+        return MlasFp32FromBits(Sign | 0x7F800000 | (Mantissa << 13));
+    }
+
+    if (Exponent == 0) {
+
+        if (Mantissa == 0) {
+            return MlasFp32FromBits(Sign);
+        }
+
+        //
+        // Normalize the denormal value.
+        //
+
+        Exponent = 1;
+
+        while ((Mantissa & 0x400) == 0) {
+            Mantissa <<= 1;
+            Exponent--;
+        }
+
+        Mantissa &= 0x3FF;
+    }
+
+    return MlasFp32FromBits(Sign | ((Exponent + (127 - 15)) << 23) | (Mantissa << 13));
+}
+
+MLAS_FORCEINLINE
+MLAS_FP16
+MlasFloatToHalf(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision value to half precision using
+    round to nearest even.
+
+Arguments:
+
+    Value - Supplies the single precision value.
+
+Return Value:
+
+    Returns the half precision value.
+
+--*/
+{
+    constexpr uint32_t Fp32Infinity = 255 << 23;
+    constexpr uint32_t Fp16Maximum = (127 + 16) << 23;
+    constexpr uint32_t DenormalMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+    uint32_t Bits = MlasBitsOfFp32(Value);
+    const uint32_t Sign = (Bits >> 16) & 0x8000;
+    uint32_t Result;
+
+    Bits &= 0x7FFFFFFF;
+
+    if (Bits >= Fp16Maximum) {
+
+        //
+        // Values that overflow map to infinity and NaN values stay NaN.
+        //
+
+        Result = (Bits > Fp32Infinity) ? 0x7E00 : 0x7C00;
+
+    } else if (Bits < (113 << 23)) {
+
+        //
+        // Denormal or zero: let the floating point addition round the
+        // mantissa into place.
+        //
+
+        Result = MlasBitsOfFp32(MlasFp32FromBits(Bits) + MlasFp32FromBits(DenormalMagic)) - DenormalMagic;
+
+    } else {
+
+        const uint32_t MantissaOdd = (Bits >> 13) & 1;
+
+        Bits += (uint32_t(15 - 127) << 23) + 0xFFF;
+        Bits += MantissaOdd;
+        Result = Bits >> 13;
+    }
+
+    return MLAS_FP16(Result | Sign);
+}
+
+MLAS_FORCEINLINE
+float
+MlasBFloat16ToFloat(
+    MLAS_BF16 Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a bfloat16 value to single precision.
+
+Arguments:
+
+    Value - Supplies the bfloat16 value.
+
+Return Value:
+
+    Returns the single precision value.
+
+--*/
+{
+    return MlasFp32FromBits(uint32_t(Value) << 16);
+}
+
+MLAS_FORCEINLINE
+MLAS_BF16
+MlasFloatToBFloat16(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision value to bfloat16 using round to
+    nearest even. NaN values map to the canonical quiet NaN of the same sign.
+
+Arguments:
+
+    Value - Supplies the single precision value.
+
+Return Value:
+
+    Returns the bfloat16 value.
+
+--*/
+{
+    uint32_t Bits = MlasBitsOfFp32(Value);
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return MLAS_BF16((Bits >> 16) & 0x8000) | 0x7FC0;
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+
+    return MLAS_BF16(Bits >> 16);
+}
+
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_TARGET_WASM)
 
 void
 MLASCALL
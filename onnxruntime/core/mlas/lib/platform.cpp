@@ -31,9 +31,20 @@ Abstract:
 #ifndef HWCAP_ASIMDDP
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
+#ifndef HWCAP_FPHP
+#define HWCAP_FPHP (1 << 9)
+#endif
+#ifndef HWCAP_ASIMDHP
+#define HWCAP_ASIMDHP (1 << 10)
+#endif
 #endif
 #endif // MLAS_TARGET_ARM64
 
+#if defined(MLAS_TARGET_AMD64) && defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 //
 // Stores the platform information.
 //
@@ -97,6 +108,33 @@ MlasReadExtendedControlRegister(
 #endif
 }
 
+#if defined(MLAS_TARGET_AMD64) && !defined(MLAS_SBGEMM_AMX_UNSUPPORTED)
+
+//
+// Requests permission from the operating system to use the AMX tile data
+// state.
+//
+
+static
+bool
+MlasRequestAmxTileData(
+    void
+    )
+{
+#if defined(_WIN32)
+    return true;
+#elif defined(__linux__)
+    constexpr unsigned long ArchRequestXCompPerm = 0x1023;
+    constexpr unsigned long XFeatureXTileData = 18;
+
+    return syscall(SYS_arch_prctl, ArchRequestXCompPerm, XFeatureXTileData) == 0;
+#else
+    return false;
+#endif
+}
+
+#endif
+
 #endif
 
 MLAS_PLATFORM::MLAS_PLATFORM(
@@ -118,6 +156,9 @@ Return Value:
 
 --*/
 {
+    this->SgemmStrideN = MLAS_SGEMM_STRIDEN;
+    this->SgemmStrideK = MLAS_SGEMM_STRIDEK;
+    this->SgemmThreadComplexity = MLAS_SGEMM_THREAD_COMPLEXITY;
 
 #if defined(MLAS_TARGET_AMD64_IX86)
 
@@ -133,6 +174,7 @@ Return Value:
     this->GemmDoubleKernel = MlasGemmDoubleKernelSse;
     this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchSse;
     this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchSse;
+    this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchDefault;
     this->ConvNchwFloatKernel = MlasConvNchwFloatKernelSse;
     this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelSse;
     this->ConvDepthwiseFloatKernel = MlasConvDepthwiseFloatKernelSse;
@@ -144,6 +186,9 @@ Return Value:
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
     this->ErfKernelRoutine = MlasErfKernel;
+    this->FastErfKernelRoutine = MlasFastErfKernel;
+    this->FastLogisticKernelRoutine = MlasFastLogisticKernel;
+    this->FastTanhKernelRoutine = MlasFastTanhKernel;
     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32Kernel;
     this->ComputeSoftmaxOutputF32Kernel = MlasComputeSoftmaxOutputF32Kernel;
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
@@ -153,9 +198,15 @@ Return Value:
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8Kernel;
+    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernel;
+    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernel;
+    this->ConvertBFloat16ToFloatKernel = MlasConvertBFloat16ToFloatKernel;
+    this->ConvertFloatToBFloat16Kernel = MlasConvertFloatToBFloat16Kernel;
     this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernel<int8_t>;
     this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t>;
 
+    this->SBGemmKernel = nullptr;
+
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
 
@@ -234,6 +285,7 @@ Return Value:
                 this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx2;
                 this->GemmU8U8Dispatch = &MlasGemmU8U8DispatchAvx2;
                 this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx2;
+                this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchAvx2;
 
                 this->GemmFloatKernel = MlasGemmFloatKernelFma3;
                 this->GemmDoubleKernel = MlasGemmDoubleKernelFma3;
@@ -245,11 +297,26 @@ Return Value:
                 this->LogisticKernelRoutine = MlasComputeLogisticF32KernelFma3;
                 this->TanhKernelRoutine = MlasComputeTanhF32KernelFma3;
                 this->ErfKernelRoutine = MlasErfKernelFma3;
+                this->FastErfKernelRoutine = MlasFastErfKernelFma3;
+                this->FastLogisticKernelRoutine = MlasFastLogisticKernelFma3;
+                this->FastTanhKernelRoutine = MlasFastTanhKernelFma3;
                 this->QLinearAddS8Kernel = MlasQLinearAddS8KernelAvx2;
                 this->QLinearAddU8Kernel = MlasQLinearAddU8KernelAvx2;
                 this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t>;
                 this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->ConvertBFloat16ToFloatKernel = MlasConvertBFloat16ToFloatKernelAvx2;
+                this->ConvertFloatToBFloat16Kernel = MlasConvertFloatToBFloat16KernelAvx2;
+
+                //
+                // Check if the processor supports the F16C half precision
+                // conversion instructions.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernelAvx2;
+                    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernelAvx2;
+                }
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -273,6 +340,7 @@ Return Value:
                 if ((Cpuid7_1[0] & 0x10) != 0) {
 
                     this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
+                    this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchVnni;
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
                     this->GemvU8S8Kernel = MlasGemvU8S8KernelAvxVnni;
                 }
@@ -303,6 +371,10 @@ Return Value:
 #if !defined(MLAS_AVX512F_INTRINSICS_UNSUPPORTED)
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernelAvx512F;
+                    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernelAvx512F;
+                    this->ConvertBFloat16ToFloatKernel = MlasConvertBFloat16ToFloatKernelAvx512F;
+                    this->ConvertFloatToBFloat16Kernel = MlasConvertFloatToBFloat16KernelAvx512F;
 #endif
 
                     //
@@ -325,9 +397,41 @@ Return Value:
                         if ((Cpuid7[2] & 0x800) != 0) {
 
                             this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
+                            this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchVnni;
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                         }
+
+#if !defined(MLAS_SBGEMM_AVX512BF16_UNSUPPORTED)
+
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->SBGemmKernel = MlasSBGemmKernelAvx512Bf16;
+
+#if !defined(MLAS_SBGEMM_AMX_UNSUPPORTED)
+
+                            //
+                            // Check if the processor supports AMX-TILE and
+                            // AMX-BF16 and the operating system supports
+                            // saving the tile state.
+                            //
+
+                            if (((Cpuid7[3] & 0x1400000) == 0x1400000) &&
+                                ((xcr0 & 0x60000) == 0x60000) &&
+                                MlasRequestAmxTileData()) {
+
+                                this->SBGemmKernel = MlasSBGemmKernelAmx;
+                            }
+
+#endif // MLAS_SBGEMM_AMX_UNSUPPORTED
+
+                        }
+
+#endif // MLAS_SBGEMM_AVX512BF16_UNSUPPORTED
                     }
 
 #endif // MLAS_AVX512CORE_UNSUPPORTED
@@ -348,6 +452,7 @@ Return Value:
 #if defined(MLAS_TARGET_ARM64)
 
     this->GemmU8X8Dispatch = &MlasGemmU8X8DispatchNeon;
+    this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchDefault;
 
     //
     // Check if the processor supports ASIMD dot product instructions.
@@ -365,7 +470,24 @@ Return Value:
 
     if (HasDotProductInstructions) {
         this->GemmU8X8Dispatch = &MlasGemmU8X8DispatchUdot;
+        this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchSdot;
+    }
+
+    //
+    // Check if the processor supports ASIMD half precision arithmetic
+    // instructions. The half precision kernel is only built when the compiler
+    // supports the ARMv8.2-A FP16 extension.
+    //
+
+    this->HalfGemmKernel = nullptr;
+
+#if defined(__linux__) && !defined(MLAS_F16VEC_INTRINSICS_UNSUPPORTED)
+    const unsigned long HalfPrecisionCaps = HWCAP_FPHP | HWCAP_ASIMDHP;
+
+    if ((getauxval(AT_HWCAP) & HalfPrecisionCaps) == HalfPrecisionCaps) {
+        this->HalfGemmKernel = MlasHalfGemmKernelNeon;
     }
+#endif
 
 #endif // MLAS_TARGET_ARM64
 
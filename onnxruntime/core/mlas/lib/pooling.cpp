@@ -1490,3 +1490,506 @@ Return Value:
         OutputCount -= 1;
     }
 }
+
+void
+MLASCALL
+MlasMaximumPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the maximum pooling operation for single precision
+    tensors in channels last format.
+
+    The input is supplied as an indirection buffer, see the uint8_t variant of
+    this routine. The padding vector referenced by the indirection buffer must
+    hold the lowest float value so that it never contributes to the maximum.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (OutputCount > 0) {
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 8) {
+
+            MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+                MLAS_FLOAT32X4 InputVector1 = MlasLoadFloat32x4(&Input[k][ChannelOffset + 4]);
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, InputVector0);
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, InputVector1);
+            }
+
+            MlasStoreFloat32x4(&Output[0], MaximumVector0);
+            MlasStoreFloat32x4(&Output[4], MaximumVector1);
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+        if (c >= 4) {
+
+            MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, InputVector0);
+            }
+
+            MlasStoreFloat32x4(&Output[0], MaximumVector0);
+            Output += 4;
+
+            ChannelOffset += 4;
+            c -= 4;
+        }
+
+        while (c > 0) {
+
+            float MaximumValue = std::numeric_limits<float>::lowest();
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                MaximumValue = std::max(MaximumValue, Input[k][ChannelOffset]);
+            }
+
+            *Output++ = MaximumValue;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasMaximumPool(
+    const int8_t* const* Input,
+    int8_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the maximum pooling operation for signed 8-bit
+    tensors in channels last format.
+
+    The input is supplied as an indirection buffer, see the uint8_t variant of
+    this routine. The padding vector referenced by the indirection buffer must
+    hold the lowest int8_t value so that it never contributes to the maximum.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    //
+    // SSE2 only has an unsigned byte maximum, so flip the sign bits to map the
+    // signed values to unsigned values of the same order.
+    //
+
+    const __m128i SignBitVector = _mm_set1_epi8(-128);
+
+#endif
+
+    while (OutputCount > 0) {
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+        while (c >= 16) {
+
+            __m128i MaximumVector0 = _mm_setzero_si128();
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                __m128i InputVector0 = _mm_loadu_si128((const __m128i*)&Input[k][ChannelOffset]);
+
+                MaximumVector0 = _mm_max_epu8(MaximumVector0, _mm_xor_si128(InputVector0, SignBitVector));
+            }
+
+            _mm_storeu_si128((__m128i*)&Output[0], _mm_xor_si128(MaximumVector0, SignBitVector));
+            Output += 16;
+
+            ChannelOffset += 16;
+            c -= 16;
+        }
+
+        if (c >= 8) {
+
+            __m128i MaximumVector0 = _mm_setzero_si128();
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                __m128i InputVector0 = _mm_loadl_epi64((const __m128i*)&Input[k][ChannelOffset]);
+
+                MaximumVector0 = _mm_max_epu8(MaximumVector0, _mm_xor_si128(InputVector0, SignBitVector));
+            }
+
+            _mm_storel_epi64((__m128i*)&Output[0], _mm_xor_si128(MaximumVector0, SignBitVector));
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+        while (c >= 16) {
+
+            int8x16_t MaximumVector0 = vdupq_n_s8(std::numeric_limits<int8_t>::lowest());
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                int8x16_t InputVector0 = vld1q_s8(&Input[k][ChannelOffset]);
+
+                MaximumVector0 = vmaxq_s8(MaximumVector0, InputVector0);
+            }
+
+            vst1q_s8(&Output[0], MaximumVector0);
+            Output += 16;
+
+            ChannelOffset += 16;
+            c -= 16;
+        }
+
+        if (c >= 8) {
+
+            int8x8_t MaximumVector0 = vdup_n_s8(std::numeric_limits<int8_t>::lowest());
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                int8x8_t InputVector0 = vld1_s8(&Input[k][ChannelOffset]);
+
+                MaximumVector0 = vmax_s8(MaximumVector0, InputVector0);
+            }
+
+            vst1_s8(&Output[0], MaximumVector0);
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+#endif
+
+        while (c > 0) {
+
+            int32_t MaximumValue = std::numeric_limits<int8_t>::lowest();
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                MaximumValue = std::max(MaximumValue, int32_t(Input[k][ChannelOffset]));
+            }
+
+            *Output++ = int8_t(MaximumValue);
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
+
+template<typename T8Bits>
+MLAS_FORCEINLINE
+void
+MlasQLinearAveragePoolAccumulate8(
+    const T8Bits* const* Input,
+    size_t KernelSize,
+    const T8Bits* Padding,
+    size_t ChannelOffset,
+    int32_t* Accumulators
+    )
+/*++
+
+Routine Description:
+
+    This routine sums 8 channels of the kernel elements of an output of the
+    quantized average pooling operation, skipping the elements that reference
+    the padding vector if one is supplied.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i ZeroVector = _mm_setzero_si128();
+    __m128i AccumulatorLow = ZeroVector;
+    __m128i AccumulatorHigh = ZeroVector;
+
+    for (size_t k = 0; k < KernelSize; k++) {
+
+        if (Input[k] == Padding) {
+            continue;
+        }
+
+        __m128i InputVector = _mm_loadl_epi64((const __m128i*)&Input[k][ChannelOffset]);
+        __m128i InputLow;
+        __m128i InputHigh;
+
+        if (std::is_signed<T8Bits>::value) {
+            __m128i InputVector16 = _mm_srai_epi16(_mm_unpacklo_epi8(InputVector, InputVector), 8);
+            InputLow = _mm_srai_epi32(_mm_unpacklo_epi16(InputVector16, InputVector16), 16);
+            InputHigh = _mm_srai_epi32(_mm_unpackhi_epi16(InputVector16, InputVector16), 16);
+        } else {
+            __m128i InputVector16 = _mm_unpacklo_epi8(InputVector, ZeroVector);
+            InputLow = _mm_unpacklo_epi16(InputVector16, ZeroVector);
+            InputHigh = _mm_unpackhi_epi16(InputVector16, ZeroVector);
+        }
+
+        AccumulatorLow = _mm_add_epi32(AccumulatorLow, InputLow);
+        AccumulatorHigh = _mm_add_epi32(AccumulatorHigh, InputHigh);
+    }
+
+    _mm_storeu_si128((__m128i*)&Accumulators[0], AccumulatorLow);
+    _mm_storeu_si128((__m128i*)&Accumulators[4], AccumulatorHigh);
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+    int32x4_t AccumulatorLow = vdupq_n_s32(0);
+    int32x4_t AccumulatorHigh = vdupq_n_s32(0);
+
+    for (size_t k = 0; k < KernelSize; k++) {
+
+        if (Input[k] == Padding) {
+            continue;
+        }
+
+        int16x8_t InputVector16;
+
+        if (std::is_signed<T8Bits>::value) {
+            InputVector16 = vmovl_s8(vld1_s8(reinterpret_cast<const int8_t*>(&Input[k][ChannelOffset])));
+        } else {
+            InputVector16 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(reinterpret_cast<const uint8_t*>(&Input[k][ChannelOffset]))));
+        }
+
+        AccumulatorLow = vaddw_s16(AccumulatorLow, vget_low_s16(InputVector16));
+        AccumulatorHigh = vaddw_s16(AccumulatorHigh, vget_high_s16(InputVector16));
+    }
+
+    vst1q_s32(&Accumulators[0], AccumulatorLow);
+    vst1q_s32(&Accumulators[4], AccumulatorHigh);
+
+#else
+
+    std::fill_n(Accumulators, 8, 0);
+
+    for (size_t k = 0; k < KernelSize; k++) {
+
+        if (Input[k] == Padding) {
+            continue;
+        }
+
+        for (size_t i = 0; i < 8; i++) {
+            Accumulators[i] += int32_t(Input[k][ChannelOffset + i]);
+        }
+    }
+
+#endif
+}
+
+template<typename T8Bits>
+void
+MLASCALL
+MlasQLinearAveragePoolNhwc(
+    const T8Bits* const* Input,
+    float ScaleInput,
+    int32_t ZeroPointInput,
+    T8Bits* Output,
+    float ScaleOutput,
+    int32_t ZeroPointOutput,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const T8Bits* Padding
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized average pooling operation for 8-bit
+    tensors in channels last format.
+
+    The input is supplied as an indirection buffer, see MlasMaximumPool.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    ScaleInput - Supplies the quantization scale of the input tensor.
+
+    ZeroPointInput - Supplies the quantization zero point of the input tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    ScaleOutput - Supplies the quantization scale of the output tensor.
+
+    ZeroPointOutput - Supplies the quantization zero point of the output tensor.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+    Padding - Supplies the padding vector referenced by the indirection
+        buffer when the kernel elements in the padding are excluded from the
+        averages, else nullptr, in which case the padding vector must hold
+        ZeroPointInput.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr int32_t MinimumValue = std::numeric_limits<T8Bits>::lowest();
+    constexpr int32_t MaximumValue = std::numeric_limits<T8Bits>::max();
+
+    int32_t Accumulators[8];
+
+    while (OutputCount > 0) {
+
+        size_t ValidCount = KernelSize;
+
+        if (Padding != nullptr) {
+            ValidCount = 0;
+            for (size_t k = 0; k < KernelSize; k++) {
+                ValidCount += (Input[k] != Padding) ? 1 : 0;
+            }
+        }
+
+        const float Scale = (ValidCount > 0) ? ScaleInput / (ScaleOutput * float(ValidCount)) : 0.0f;
+        const int32_t Bias = -ZeroPointInput * int32_t(ValidCount);
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c > 0) {
+
+            const size_t ChannelCount = std::min(c, size_t{8});
+
+            if (ChannelCount == 8) {
+
+                MlasQLinearAveragePoolAccumulate8(Input, KernelSize, Padding, ChannelOffset, Accumulators);
+
+            } else {
+
+                std::fill_n(Accumulators, ChannelCount, 0);
+
+                for (size_t k = 0; k < KernelSize; k++) {
+
+                    if (Input[k] == Padding) {
+                        continue;
+                    }
+
+                    for (size_t i = 0; i < ChannelCount; i++) {
+                        Accumulators[i] += int32_t(Input[k][ChannelOffset + i]);
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < ChannelCount; i++) {
+                int32_t Value = int32_t(std::nearbyintf(float(Accumulators[i] + Bias) * Scale)) + ZeroPointOutput;
+                *Output++ = T8Bits(std::min(std::max(Value, MinimumValue), MaximumValue));
+            }
+
+            ChannelOffset += ChannelCount;
+            c -= ChannelCount;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
+
+template
+void
+MLASCALL
+MlasQLinearAveragePoolNhwc<uint8_t>(
+    const uint8_t* const* Input,
+    float ScaleInput,
+    int32_t ZeroPointInput,
+    uint8_t* Output,
+    float ScaleOutput,
+    int32_t ZeroPointOutput,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const uint8_t* Padding
+    );
+
+template
+void
+MLASCALL
+MlasQLinearAveragePoolNhwc<int8_t>(
+    const int8_t* const* Input,
+    float ScaleInput,
+    int32_t ZeroPointInput,
+    int8_t* Output,
+    float ScaleOutput,
+    int32_t ZeroPointOutput,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const int8_t* Padding
+    );
@@ -0,0 +1,553 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with an int4 block quantized matrix B, for weight-only
+    quantized models whose weights are too large to stream as floats.
+
+    Small numbers of rows, such as the single row of a decoder step, are
+    computed by kernels that dequantize one block of four columns of matrix
+    B into a small buffer and immediately multiply it with the rows of matrix
+    A, so matrix B is read from memory once at half a byte per value. Larger numbers of rows dequantize a panel of matrix B and reuse it
+    across the rows with the SGEMM kernels.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the range of supported quantization block sizes.
+//
+
+#define MLAS_Q4_GEMM_MINIMUM_BLOCK_SIZE             16
+#define MLAS_Q4_GEMM_MAXIMUM_BLOCK_SIZE             256
+
+//
+// Define the number of rows and columns processed by the direct kernels at a
+// time.
+//
+
+#define MLAS_Q4_GEMM_STRIDEM                        4
+#define MLAS_Q4_GEMM_STRIDEN                        4
+
+//
+// Define the dimensions of the dequantized panels of matrix B multiplied with
+// the SGEMM kernels, and the number of rows of matrix A at which the panels
+// are used instead of the direct kernels.
+//
+
+#define MLAS_Q4_GEMM_PANEL_N                        16
+#define MLAS_Q4_GEMM_PANEL_K                        256
+#define MLAS_Q4_GEMM_PANEL_MINIMUM_M                16
+
+//
+// Define the zero point of the blocks when no zero points are supplied.
+//
+
+#define MLAS_Q4_GEMM_DEFAULT_ZERO_POINT             8
+
+struct MLAS_Q4_GEMM_SHAPE {
+    size_t K;
+    size_t BlockSize;
+    size_t BlockCountK;
+};
+
+bool
+MLASCALL
+MlasQ4GemmIsBlockSizeSupported(
+    size_t BlockSize
+    )
+{
+    return BlockSize >= MLAS_Q4_GEMM_MINIMUM_BLOCK_SIZE &&
+        BlockSize <= MLAS_Q4_GEMM_MAXIMUM_BLOCK_SIZE &&
+        (BlockSize & (BlockSize - 1)) == 0;
+}
+
+void
+MlasQ4GemmDequantizeBlock(
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    const MLAS_Q4_GEMM_SHAPE& Shape,
+    size_t n,
+    size_t BlockIndex,
+    size_t CountK,
+    float* Buffer,
+    size_t BufferStride
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes values of one block of one column of matrix B.
+
+Arguments:
+
+    Data - Supplies the matrices data parameters.
+
+    Shape - Supplies the shape of matrix B.
+
+    n - Supplies the column of matrix B.
+
+    BlockIndex - Supplies the block of the column.
+
+    CountK - Supplies the number of rows of the block to dequantize.
+
+    Buffer - Supplies the address of the first dequantized value.
+
+    BufferStride - Supplies the distance between dequantized values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockIdx = n * Shape.BlockCountK + BlockIndex;
+    const float Scale = Data->QuantBScale[BlockIdx];
+
+    int32_t ZeroPoint = MLAS_Q4_GEMM_DEFAULT_ZERO_POINT;
+
+    if (Data->QuantBZeroPoint != nullptr) {
+        const uint8_t ZeroPointPair =
+            Data->QuantBZeroPoint[n * ((Shape.BlockCountK + 1) / 2) + BlockIndex / 2];
+        ZeroPoint = (BlockIndex & 1) ? (ZeroPointPair >> 4) : (ZeroPointPair & 0x0F);
+    }
+
+    //
+    // A block has only 16 distinct values, so map the nibbles through a
+    // table instead of converting each one.
+    //
+
+    float Values[16];
+
+    for (int32_t q = 0; q < 16; q++) {
+        Values[q] = float(q - ZeroPoint) * Scale;
+    }
+
+    const uint8_t* QuantData = Data->QuantBData + BlockIdx * (Shape.BlockSize / 2);
+
+    size_t k = 0;
+
+    for (; k + 2 <= CountK; k += 2) {
+        const uint8_t Pair = QuantData[k / 2];
+        Buffer[k * BufferStride] = Values[Pair & 0x0F];
+        Buffer[(k + 1) * BufferStride] = Values[Pair >> 4];
+    }
+
+    if (k < CountK) {
+        Buffer[k * BufferStride] = Values[QuantData[k / 2] & 0x0F];
+    }
+}
+
+template<size_t RowCount>
+void
+MlasQ4GemmKernel(
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    const MLAS_Q4_GEMM_SHAPE& Shape,
+    const float* A,
+    float* C,
+    size_t StartN,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to four columns of up to four rows of matrix C,
+    dequantizing one block of matrix B at a time into a buffer that stays in
+    the L1 cache.
+
+Arguments:
+
+    Data - Supplies the matrices data parameters.
+
+    Shape - Supplies the shape of matrix B.
+
+    A - Supplies the address of the first row of matrix A.
+
+    C - Supplies the address of the first row of matrix C.
+
+    StartN - Supplies the first column of matrix B.
+
+    CountN - Supplies the number of columns of matrix B, at most four.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_Q4_GEMM_MAXIMUM_BLOCK_SIZE * MLAS_Q4_GEMM_STRIDEN], 16);
+
+    if (CountN < MLAS_Q4_GEMM_STRIDEN) {
+        std::fill_n(PanelB, Shape.BlockSize * MLAS_Q4_GEMM_STRIDEN, 0.0f);
+    }
+
+    MLAS_FLOAT32X4 Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r] = MlasZeroFloat32x4();
+    }
+
+    for (size_t b = 0; b < Shape.BlockCountK; b++) {
+
+        const size_t StartK = b * Shape.BlockSize;
+        const size_t CountK = std::min(Shape.BlockSize, Shape.K - StartK);
+
+        for (size_t j = 0; j < CountN; j++) {
+            MlasQ4GemmDequantizeBlock(Data, Shape, StartN + j, b, CountK, PanelB + j, MLAS_Q4_GEMM_STRIDEN);
+        }
+
+        const float* a = A + StartK;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            const MLAS_FLOAT32X4 BElements = MlasLoadFloat32x4(PanelB + k * MLAS_Q4_GEMM_STRIDEN);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                Accumulators[r] = MlasMultiplyAddFloat32x4(BElements, a[r * Data->lda + k], Accumulators[r]);
+            }
+        }
+    }
+
+    MLAS_FLOAT32X4 BiasElements = MlasZeroFloat32x4();
+
+    if (Data->Bias != nullptr) {
+        if (CountN == MLAS_Q4_GEMM_STRIDEN) {
+            BiasElements = MlasLoadFloat32x4(Data->Bias + StartN);
+        } else {
+            float Bias[MLAS_Q4_GEMM_STRIDEN] = {};
+            std::copy_n(Data->Bias + StartN, CountN, Bias);
+            BiasElements = MlasLoadFloat32x4(Bias);
+        }
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float* c = C + r * Data->ldc + StartN;
+        const MLAS_FLOAT32X4 Result = MlasAddFloat32x4(Accumulators[r], BiasElements);
+
+        if (CountN == MLAS_Q4_GEMM_STRIDEN) {
+            MlasStoreFloat32x4(c, Result);
+        } else {
+            float Output[MLAS_Q4_GEMM_STRIDEN];
+            MlasStoreFloat32x4(Output, Result);
+            std::copy_n(Output, CountN, c);
+        }
+    }
+}
+
+void
+MlasQ4GemmDirectOperation(
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    const MLAS_Q4_GEMM_SHAPE& Shape,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a segment of matrix C with the direct kernels.
+
+Arguments:
+
+    Data - Supplies the matrices data parameters.
+
+    Shape - Supplies the shape of matrix B.
+
+    RangeStartM - Supplies the starting row index to output.
+
+    RangeCountM - Supplies the number of rows to output.
+
+    RangeStartN - Supplies the starting column index to output.
+
+    RangeCountN - Supplies the number of columns to output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t CountN;
+
+    for (size_t n = RangeStartN; n < RangeStartN + RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeStartN + RangeCountN - n, size_t(MLAS_Q4_GEMM_STRIDEN));
+
+        size_t CountM;
+
+        for (size_t m = RangeStartM; m < RangeStartM + RangeCountM; m += CountM) {
+
+            CountM = std::min(RangeStartM + RangeCountM - m, size_t(MLAS_Q4_GEMM_STRIDEM));
+
+            const float* a = Data->A + m * Data->lda;
+            float* c = Data->C + m * Data->ldc;
+
+            switch (CountM) {
+                case 4:
+                    MlasQ4GemmKernel<4>(Data, Shape, a, c, n, CountN);
+                    break;
+                case 3:
+                    MlasQ4GemmKernel<3>(Data, Shape, a, c, n, CountN);
+                    break;
+                case 2:
+                    MlasQ4GemmKernel<2>(Data, Shape, a, c, n, CountN);
+                    break;
+                default:
+                    MlasQ4GemmKernel<1>(Data, Shape, a, c, n, CountN);
+                    break;
+            }
+        }
+    }
+}
+
+void
+MlasQ4GemmPanelOperation(
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    const MLAS_Q4_GEMM_SHAPE& Shape,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a segment of matrix C by dequantizing panels of
+    matrix B and multiplying them with the single threaded SGEMM kernels.
+
+Arguments:
+
+    Data - Supplies the matrices data parameters.
+
+    Shape - Supplies the shape of matrix B.
+
+    RangeStartM - Supplies the starting row index to output.
+
+    RangeCountM - Supplies the number of rows to output.
+
+    RangeStartN - Supplies the starting column index to output.
+
+    RangeCountN - Supplies the number of columns to output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_Q4_GEMM_PANEL_K * MLAS_Q4_GEMM_PANEL_N], 64);
+
+    const float* a = Data->A + RangeStartM * Data->lda;
+    float* c = Data->C + RangeStartM * Data->ldc;
+
+    size_t CountN;
+
+    for (size_t n = RangeStartN; n < RangeStartN + RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeStartN + RangeCountN - n, size_t(MLAS_Q4_GEMM_PANEL_N));
+
+        size_t CountK;
+
+        for (size_t k = 0; k < Shape.K; k += CountK) {
+
+            CountK = std::min(Shape.K - k, size_t(MLAS_Q4_GEMM_PANEL_K));
+
+            //
+            // The panel depth is a multiple of the block size, so the panel
+            // holds whole blocks except for the last block of a column.
+            //
+
+            for (size_t kk = 0; kk < CountK; kk += Shape.BlockSize) {
+                const size_t BlockCountK = std::min(CountK - kk, Shape.BlockSize);
+                for (size_t j = 0; j < CountN; j++) {
+                    MlasQ4GemmDequantizeBlock(Data, Shape, n + j, (k + kk) / Shape.BlockSize,
+                        BlockCountK, PanelB + kk * CountN + j, CountN);
+                }
+            }
+
+            MlasGemm(CblasNoTrans, CblasNoTrans, RangeCountM, CountN, CountK, 1.0f, a + k, Data->lda,
+                PanelB, CountN, (k == 0) ? 0.0f : 1.0f, c + n, Data->ldc, nullptr);
+        }
+
+        if (Data->Bias != nullptr) {
+            for (size_t m = 0; m < RangeCountM; m++) {
+                float* c_row = c + m * Data->ldc + n;
+                for (size_t j = 0; j < CountN; j++) {
+                    c_row[j] += Data->Bias[n + j];
+                }
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlockSize,
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the batched single precision matrix/matrix
+    multiply operation with an int4 block quantized matrix B.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    BlockSize - Supplies the number of rows of matrix B in each quantization
+        block.
+
+    Data - Supplies the array of matrices data parameters.
+
+    BatchSize - Supplies the number of multiplications in this batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    MLAS_Q4_GEMM_SHAPE Shape;
+    Shape.K = K;
+    Shape.BlockSize = BlockSize;
+    Shape.BlockCountK = (K + BlockSize - 1) / BlockSize;
+
+    if (K == 0) {
+        for (size_t GemmIdx = 0; GemmIdx < BatchSize; GemmIdx++) {
+            for (size_t m = 0; m < M; m++) {
+                float* c = Data[GemmIdx].C + m * Data[GemmIdx].ldc;
+                if (Data[GemmIdx].Bias != nullptr) {
+                    std::copy_n(Data[GemmIdx].Bias, N, c);
+                } else {
+                    std::fill_n(c, N, 0.0f);
+                }
+            }
+        }
+        return;
+    }
+
+    const bool UsePanels = M >= MLAS_Q4_GEMM_PANEL_MINIMUM_M;
+    const size_t StrideM = UsePanels ? MLAS_Q4_GEMM_PANEL_MINIMUM_M : MLAS_Q4_GEMM_STRIDEM;
+    const size_t StrideN = UsePanels ? MLAS_Q4_GEMM_PANEL_N : MLAS_Q4_GEMM_STRIDEN;
+
+    //
+    // Compute the number of target threads given the number of multiplies
+    // of the operation. Small requests should run using the single threaded
+    // path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_Q4_GEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_Q4_GEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MlasPlatform.MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across the columns, which splits the reads of
+    // matrix B between the threads, unless there are more blocks of rows
+    // than blocks of columns.
+    //
+
+    const size_t BlockedM = (M + StrideM - 1) / StrideM;
+    const size_t BlockedN = (N + StrideN - 1) / StrideN;
+
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (BlockedN >= BlockedM) {
+
+        if (size_t(TargetThreadCount) > BlockedN) {
+            TargetThreadCount = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = TargetThreadCount;
+
+    } else {
+
+        if (size_t(TargetThreadCount) > BlockedM) {
+            TargetThreadCount = ptrdiff_t(BlockedM);
+        }
+
+        ThreadCountM = TargetThreadCount;
+        ThreadCountN = 1;
+    }
+
+    const ptrdiff_t ThreadsPerGemm = ThreadCountM * ThreadCountN;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * ptrdiff_t(BatchSize), [&](ptrdiff_t tid) {
+
+        const ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        const ptrdiff_t ThreadId = tid % ThreadsPerGemm;
+
+        size_t RangeStartM;
+        size_t RangeCountM;
+
+        MlasPartitionWork(ThreadId / ThreadCountN, ThreadCountM, BlockedM, &RangeStartM, &RangeCountM);
+
+        RangeStartM *= StrideM;
+        RangeCountM = std::min(M - std::min(M, RangeStartM), RangeCountM * StrideM);
+
+        size_t RangeStartN;
+        size_t RangeCountN;
+
+        MlasPartitionWork(ThreadId % ThreadCountN, ThreadCountN, BlockedN, &RangeStartN, &RangeCountN);
+
+        RangeStartN *= StrideN;
+        RangeCountN = std::min(N - std::min(N, RangeStartN), RangeCountN * StrideN);
+
+        if (RangeCountM == 0 || RangeCountN == 0) {
+            return;
+        }
+
+        if (UsePanels) {
+            MlasQ4GemmPanelOperation(&Data[GemmIdx], Shape, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        } else {
+            MlasQ4GemmDirectOperation(&Data[GemmIdx], Shape, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        }
+    });
+}
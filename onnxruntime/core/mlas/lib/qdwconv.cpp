@@ -15,6 +15,7 @@ Abstract:
 --*/
 
 #include "mlasi.h"
+#include <memory>
 
 template<typename FilterType>
 void
@@ -275,3 +276,368 @@ Return Value:
             KernelSize);
     }
 }
+
+#if defined(MLAS_NEON64_INTRINSICS)
+
+template<typename FilterType>
+MLAS_FORCEINLINE
+int16x8_t
+MlasConvDepthwiseWidenFilter(
+    uint8x8_t FilterVector,
+    uint8x8_t FilterZeroPointVector
+    )
+{
+    if (std::is_signed<FilterType>::value) {
+        return vsubl_s8(vreinterpret_s8_u8(FilterVector), vreinterpret_s8_u8(FilterZeroPointVector));
+    } else {
+        return vreinterpretq_s16_u16(vsubl_u8(FilterVector, FilterZeroPointVector));
+    }
+}
+
+MLAS_FORCEINLINE
+uint8x8_t
+MlasConvDepthwiseRequantize(
+    int32x4_t Accumulator0,
+    int32x4_t Accumulator1,
+    const float* Scale,
+    float32x4_t PerTensorScaleVector,
+    int16x8_t OutputZeroPointVector
+    )
+{
+    float32x4_t ScaleVector0 = PerTensorScaleVector;
+    float32x4_t ScaleVector1 = PerTensorScaleVector;
+
+    if (Scale != nullptr) {
+        ScaleVector0 = vld1q_f32(&Scale[0]);
+        ScaleVector1 = vld1q_f32(&Scale[4]);
+    }
+
+    //
+    // Convert the float values to integer using "round to nearest even" and
+    // saturate to unsigned bytes exactly as MlasRequantizeOutput does.
+    //
+
+    int32x4_t IntegerVector0 = vcvtnq_s32_f32(vmulq_f32(vcvtq_f32_s32(Accumulator0), ScaleVector0));
+    int32x4_t IntegerVector1 = vcvtnq_s32_f32(vmulq_f32(vcvtq_f32_s32(Accumulator1), ScaleVector1));
+
+    int16x8_t WordVector = vqmovn_high_s32(vqmovn_s32(IntegerVector0), IntegerVector1);
+    WordVector = vqaddq_s16(WordVector, OutputZeroPointVector);
+
+    return vqmovun_s16(WordVector);
+}
+
+template<typename FilterType, size_t KernelSizeT>
+void
+MlasConvDepthwiseRequantizeKernelNeon(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerChannelScale,
+    uint8_t OutputZeroPoint,
+    uint8_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the depthwise convolution with the requantization
+    of the accumulators fused in, so that the int32_t accumulators never leave
+    the NEON registers.
+
+    KernelSizeT is non-zero for the common 3x3 and 5x5 kernels, which lets the
+    compiler fully unroll the loop over the kernel elements.
+
+    N.B. The dot product instructions reduce adjacent bytes, which are
+    adjacent channels in the HW1O filter layout, so the kernel elements are
+    instead accumulated with widening multiply-accumulates over 16 channels
+    at a time to keep four independent accumulator chains in flight.
+
+Arguments:
+
+    See MlasConvDepthwise.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t KernelCount = (KernelSizeT != 0) ? KernelSizeT : KernelSize;
+
+    const uint8x8_t InputZeroPointVector = vdup_n_u8(InputZeroPoint);
+    const uint8x8_t FilterZeroPointVector = vdup_n_u8(uint8_t(FilterZeroPoint));
+    const float32x4_t PerTensorScaleVector = vld1q_dup_f32(Scale);
+    const int16x8_t OutputZeroPointVector = vdupq_n_s16(OutputZeroPoint);
+    const float MinimumValue = float(0 - OutputZeroPoint);
+    const float MaximumValue = float(255 - OutputZeroPoint);
+
+    while (OutputCount > 0) {
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 16) {
+
+            int32x4_t Accumulator0 = vdupq_n_s32(0);
+            int32x4_t Accumulator1 = vdupq_n_s32(0);
+            int32x4_t Accumulator2 = vdupq_n_s32(0);
+            int32x4_t Accumulator3 = vdupq_n_s32(0);
+
+            if (Bias != nullptr) {
+                Accumulator0 = vld1q_s32(&Bias[ChannelOffset]);
+                Accumulator1 = vld1q_s32(&Bias[ChannelOffset + 4]);
+                Accumulator2 = vld1q_s32(&Bias[ChannelOffset + 8]);
+                Accumulator3 = vld1q_s32(&Bias[ChannelOffset + 12]);
+            }
+
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelCount; k++) {
+
+                uint8x16_t InputVector = vld1q_u8(&Input[k][ChannelOffset]);
+                uint8x16_t FilterVector = vld1q_u8(reinterpret_cast<const uint8_t*>(&Filter[ChannelKernelOffset]));
+
+                int16x8_t InputVector0 = vreinterpretq_s16_u16(vsubl_u8(vget_low_u8(InputVector), InputZeroPointVector));
+                int16x8_t InputVector1 = vreinterpretq_s16_u16(vsubl_u8(vget_high_u8(InputVector), InputZeroPointVector));
+                int16x8_t FilterVector0 = MlasConvDepthwiseWidenFilter<FilterType>(vget_low_u8(FilterVector), FilterZeroPointVector);
+                int16x8_t FilterVector1 = MlasConvDepthwiseWidenFilter<FilterType>(vget_high_u8(FilterVector), FilterZeroPointVector);
+
+                Accumulator0 = vmlal_s16(Accumulator0, vget_low_s16(InputVector0), vget_low_s16(FilterVector0));
+                Accumulator1 = vmlal_high_s16(Accumulator1, InputVector0, FilterVector0);
+                Accumulator2 = vmlal_s16(Accumulator2, vget_low_s16(InputVector1), vget_low_s16(FilterVector1));
+                Accumulator3 = vmlal_high_s16(Accumulator3, InputVector1, FilterVector1);
+
+                ChannelKernelOffset += Channels;
+            }
+
+            const float* scale = PerChannelScale ? &Scale[ChannelOffset] : nullptr;
+
+            uint8x8_t OutputVector0 = MlasConvDepthwiseRequantize(Accumulator0, Accumulator1, scale,
+                PerTensorScaleVector, OutputZeroPointVector);
+            uint8x8_t OutputVector1 = MlasConvDepthwiseRequantize(Accumulator2, Accumulator3,
+                (scale != nullptr) ? scale + 8 : nullptr, PerTensorScaleVector, OutputZeroPointVector);
+
+            vst1q_u8(Output, vcombine_u8(OutputVector0, OutputVector1));
+            Output += 16;
+
+            ChannelOffset += 16;
+            c -= 16;
+        }
+
+        if (c >= 8) {
+
+            int32x4_t Accumulator0 = vdupq_n_s32(0);
+            int32x4_t Accumulator1 = vdupq_n_s32(0);
+
+            if (Bias != nullptr) {
+                Accumulator0 = vld1q_s32(&Bias[ChannelOffset]);
+                Accumulator1 = vld1q_s32(&Bias[ChannelOffset + 4]);
+            }
+
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelCount; k++) {
+
+                uint8x8_t InputVector = vld1_u8(&Input[k][ChannelOffset]);
+                uint8x8_t FilterVector = vld1_u8(reinterpret_cast<const uint8_t*>(&Filter[ChannelKernelOffset]));
+
+                int16x8_t InputVector16 = vreinterpretq_s16_u16(vsubl_u8(InputVector, InputZeroPointVector));
+                int16x8_t FilterVector16 = MlasConvDepthwiseWidenFilter<FilterType>(FilterVector, FilterZeroPointVector);
+
+                Accumulator0 = vmlal_s16(Accumulator0, vget_low_s16(InputVector16), vget_low_s16(FilterVector16));
+                Accumulator1 = vmlal_high_s16(Accumulator1, InputVector16, FilterVector16);
+
+                ChannelKernelOffset += Channels;
+            }
+
+            vst1_u8(Output, MlasConvDepthwiseRequantize(Accumulator0, Accumulator1,
+                PerChannelScale ? &Scale[ChannelOffset] : nullptr, PerTensorScaleVector, OutputZeroPointVector));
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+        while (c > 0) {
+
+            int32_t Accumulator = (Bias != nullptr) ? Bias[ChannelOffset] : 0;
+            size_t ChannelKernelOffset = ChannelOffset;
+
+            for (size_t k = 0; k < KernelCount; k++) {
+
+                int32_t InputValue = int32_t(Input[k][ChannelOffset]) - InputZeroPoint;
+                int32_t FilterValue = int32_t(Filter[ChannelKernelOffset]) - FilterZeroPoint;
+
+                Accumulator += InputValue * FilterValue;
+                ChannelKernelOffset += Channels;
+            }
+
+            float FloatValue = float(Accumulator) * (PerChannelScale ? Scale[ChannelOffset] : Scale[0]);
+            FloatValue = std::max(FloatValue, MinimumValue);
+            FloatValue = std::min(FloatValue, MaximumValue);
+
+            int32_t IntegerValue = int32_t(MlasBitsOfFp32(FloatValue + MLAS_ROUNDING_BIAS_MAGIC)) -
+                MLAS_ROUNDING_BIAS_MAGIC_BITS;
+
+            *Output++ = uint8_t(IntegerValue + OutputZeroPoint);
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelCount;
+        OutputCount -= 1;
+    }
+}
+
+template<typename FilterType>
+void
+MlasConvDepthwiseRequantizeNeon(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerChannelScale,
+    uint8_t OutputZeroPoint,
+    uint8_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    if (KernelSize == 9) {
+        MlasConvDepthwiseRequantizeKernelNeon<FilterType, 9>(Input, InputZeroPoint, Filter, FilterZeroPoint,
+            Bias, Scale, PerChannelScale, OutputZeroPoint, Output, Channels, OutputCount, KernelSize);
+    } else if (KernelSize == 25) {
+        MlasConvDepthwiseRequantizeKernelNeon<FilterType, 25>(Input, InputZeroPoint, Filter, FilterZeroPoint,
+            Bias, Scale, PerChannelScale, OutputZeroPoint, Output, Channels, OutputCount, KernelSize);
+    } else {
+        MlasConvDepthwiseRequantizeKernelNeon<FilterType, 0>(Input, InputZeroPoint, Filter, FilterZeroPoint,
+            Bias, Scale, PerChannelScale, OutputZeroPoint, Output, Channels, OutputCount, KernelSize);
+    }
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const uint8_t* const* Input,
+    uint8_t InputZeroPoint,
+    const uint8_t* Filter,
+    uint8_t FilterZeroPoint,
+    bool FilterIsSigned,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerChannelScale,
+    uint8_t OutputZeroPoint,
+    uint8_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the depthwise convolution operation followed by
+    the requantization of the results to the output type, as done by
+    MlasRequantizeOutput, without writing the int32_t accumulators for the
+    whole output to memory.
+
+    The input and filter are organized as for the int32_t output variant of
+    MlasConvDepthwise.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    InputZeroPoint - Supplies the zero point offset of the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    FilterZeroPoint - Supplies the zero point offset of the filter tensor.
+
+    FilterIsSigned - Supplies true if the filter tensor is signed data, else
+        false if the filter tensor is unsigned data.
+
+    Bias - Supplies the optional bias vector of length Channels.
+
+    Scale - Supplies the requantization scale.
+
+    PerChannelScale - Supplies true if the requantization scale has Channels
+        values, else false if a single scale applies to every channel.
+
+    OutputZeroPoint - Supplies the zero point offset of the output tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+
+    if (FilterIsSigned) {
+        MlasConvDepthwiseRequantizeNeon<int8_t>(Input, InputZeroPoint, reinterpret_cast<const int8_t*>(Filter),
+            static_cast<int8_t>(FilterZeroPoint), Bias, Scale, PerChannelScale, OutputZeroPoint, Output,
+            Channels, OutputCount, KernelSize);
+    } else {
+        MlasConvDepthwiseRequantizeNeon<uint8_t>(Input, InputZeroPoint, Filter, FilterZeroPoint, Bias, Scale,
+            PerChannelScale, OutputZeroPoint, Output, Channels, OutputCount, KernelSize);
+    }
+
+#else
+
+    //
+    // Compute a block of outputs that fits in a stack buffer at a time, so
+    // that the accumulators are requantized while still in the L1 cache.
+    //
+
+    constexpr size_t AccumulatorBufferSize = 1024;
+    MLAS_DECLSPEC_ALIGN(int32_t AccumulatorBuffer[AccumulatorBufferSize], 64);
+
+    std::unique_ptr<int32_t[]> LargeAccumulatorBuffer;
+    int32_t* Accumulators = AccumulatorBuffer;
+    size_t OutputBlockCount = AccumulatorBufferSize / Channels;
+
+    if (OutputBlockCount == 0) {
+        LargeAccumulatorBuffer.reset(new int32_t[Channels]);
+        Accumulators = LargeAccumulatorBuffer.get();
+        OutputBlockCount = 1;
+    }
+
+    while (OutputCount > 0) {
+
+        const size_t OutputThisIteration = std::min(OutputBlockCount, OutputCount);
+
+        MlasConvDepthwise(Input, InputZeroPoint, Filter, FilterZeroPoint, FilterIsSigned, Accumulators,
+            Channels, OutputThisIteration, KernelSize);
+        MlasRequantizeOutput(Accumulators, Output, Bias, OutputThisIteration, Channels, Scale,
+            PerChannelScale, OutputZeroPoint);
+
+        Input += OutputThisIteration * KernelSize;
+        Output += OutputThisIteration * Channels;
+        OutputCount -= OutputThisIteration;
+    }
+
+#endif
+}
@@ -54,6 +54,7 @@ struct MLAS_GEMM_U8X8_DISPATCH {
 
 const MLAS_GEMM_U8X8_DISPATCH*
 MlasGemmU8X8GetDispatch(
+    bool AIsSigned,
     bool BIsSigned
     )
 {
@@ -61,6 +62,19 @@ MlasGemmU8X8GetDispatch(
 
     MLAS_UNREFERENCED_PARAMETER(BIsSigned);
 
+    //
+    // Signed matrix A data is handled by a separate set of kernels that accept
+    // either signed or unsigned matrix B data.
+    //
+
+    if (AIsSigned) {
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_NEON64_INTRINSICS)
+        return MlasPlatform.GemmS8S8Dispatch;
+#else
+        return &MlasGemmS8S8DispatchDefault;
+#endif
+    }
+
 #if defined(MLAS_TARGET_AMD64)
     if (BIsSigned) {
         GemmU8X8Dispatch = MlasPlatform.GemmU8S8Dispatch;
@@ -73,6 +87,8 @@ MlasGemmU8X8GetDispatch(
     GemmU8X8Dispatch = MlasPlatform.GemmU8X8Dispatch;
 #elif defined(MLAS_NEON32_INTRINSICS) && !defined(_MSC_VER)
     GemmU8X8Dispatch = &MlasGemmU8X8DispatchNeon;
+#elif defined(MLAS_TARGET_WASM_SIMD)
+    GemmU8X8Dispatch = &MlasGemmU8X8DispatchWasmSimd;
 #else
     GemmU8X8Dispatch = &MlasGemmU8X8DispatchDefault;
 #endif
@@ -149,6 +165,16 @@ MlasGemmU8X8TryGemvKernel(
     return false;
 }
 
+template<typename KernelType>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointA(
+    int32_t ZeroPointA
+    )
+{
+    return ZeroPointA;
+}
+
 template<typename KernelType>
 int32_t
 MlasGemmU8X8FixupZeroPointB(
@@ -290,7 +316,7 @@ Return Value:
     const uint8_t* PackedZeroPointB = Data->PerColumnZeroPoints ?
         Data->ZeroPointB + RangeStartN : nullptr;
 
-    int32_t ZeroPointA = Data->ZeroPointA;
+    int32_t ZeroPointA = typename KernelType::OffsetAType(Data->ZeroPointA);
     int32_t ZeroPointB = typename KernelType::OffsetBType(*Data->ZeroPointB);
 
     //
@@ -305,6 +331,13 @@ Return Value:
         }
     }
 
+    //
+    // Fixup the zero point offset of matrix A if the kernel implementation
+    // stores matrix A in a different format than the source data.
+    //
+
+    ZeroPointA = MlasGemmU8X8FixupZeroPointA<KernelType>(ZeroPointA);
+
     //
     // Fixup the sign bit of the per-matrix zero point offset of matrix B if the
     // data is the opposite format of the kernel implementation. This value is
@@ -514,9 +547,16 @@ Return Value:
     const uint8_t* PackedZeroPointB = Data->PerColumnZeroPoints ?
         Data->ZeroPointB + RangeStartN : nullptr;
 
-    int32_t ZeroPointA = Data->ZeroPointA;
+    int32_t ZeroPointA = typename KernelType::OffsetAType(Data->ZeroPointA);
     int32_t ZeroPointB = typename KernelType::OffsetBType(*Data->ZeroPointB);
 
+    //
+    // Fixup the zero point offset of matrix A if the kernel implementation
+    // stores matrix A in a different format than the source data.
+    //
+
+    ZeroPointA = MlasGemmU8X8FixupZeroPointA<KernelType>(ZeroPointA);
+
     //
     // Fixup the sign bit of the per-matrix zero point offset of matrix B if the
     // data is the opposite format of the kernel implementation. This value is
@@ -682,6 +722,7 @@ struct MLAS_GEMM_U8X8_KERNEL_SSE
 {
     typedef int16_t PackedAType;
     typedef int16_t PackedBType;
+    typedef uint8_t OffsetAType;
     typedef int8_t OffsetBType;
 
     static constexpr size_t PackedK = 2;
@@ -1152,29 +1193,48 @@ const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchSse = {
 
 #endif
 
-// N.B. MSVC does not require turning on SSE 4.1 intrinsics and the current use
-// for this code is Windows only, so restrict this kernel to that environment.
-#if defined(MLAS_SSE2_INTRINSICS) && defined(_MSC_VER)
+#if defined(MLAS_TARGET_WASM_SIMD)
 
-struct MLAS_GEMM_U8S8_KERNEL_SSE41
+//
+// The WebAssembly SIMD kernel follows the SSE2 kernel: matrix A is zero
+// extended and matrix B is sign extended to 16-bit values, and pairs of these
+// values are multiplied and added to the 32-bit accumulators by the
+// i32x4.dot_i16x8_s instruction.
+//
+
+struct MLAS_GEMM_U8X8_KERNEL_WASMSIMD
 {
-    typedef uint8_t PackedAType;
-    typedef uint8_t PackedBType;
+    typedef int16_t PackedAType;
+    typedef int16_t PackedBType;
+    typedef uint8_t OffsetAType;
     typedef int8_t OffsetBType;
 
-    static constexpr size_t PackedK = 4;
-    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{24, 128, 128};
-    static constexpr MLAS_GEMM_U8X8_STRIDES PackedStrides{24, 128, 128};
+    static constexpr size_t PackedK = 2;
+    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{12, 128, 128};
 };
 
-constexpr size_t MLAS_GEMM_U8S8_KERNEL_SSE41::PackedK;
-constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8S8_KERNEL_SSE41::Strides;
-constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8S8_KERNEL_SSE41::PackedStrides;
+constexpr size_t MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedK;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8X8_KERNEL_WASMSIMD::Strides;
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointB<MLAS_GEMM_U8X8_KERNEL_WASMSIMD>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    if (!BIsSigned) {
+        ZeroPointB = MLAS_GEMM_U8X8_KERNEL_WASMSIMD::OffsetBType(ZeroPointB ^ 0x80);
+    }
+
+    return ZeroPointB;
+}
 
 template<>
 void
-MlasGemmU8X8CopyPackA<MLAS_GEMM_U8S8_KERNEL_SSE41>(
-    MLAS_GEMM_U8S8_KERNEL_SSE41::PackedAType* D,
+MlasGemmU8X8CopyPackA<MLAS_GEMM_U8X8_KERNEL_WASMSIMD>(
+    MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedAType* D,
     const uint8_t* A,
     size_t lda,
     size_t CountM,
@@ -1182,8 +1242,9 @@ MlasGemmU8X8CopyPackA<MLAS_GEMM_U8S8_KERNEL_SSE41>(
     int32_t* RowSumBuffer
     )
 {
-    const __m128i ZeroVector = _mm_setzero_si128();
-    const __m128i OnesWordBroadcast = _mm_set1_epi16(1);
+    const v128_t ZeroVector = wasm_i64x2_const(0, 0);
+    const v128_t OnesWordBroadcast = wasm_i16x8_splat(1);
+    uint8_t PaddedMatrixAData[8] = { 0 };
 
     //
     // Process a single row of matrix A in a loop.
@@ -1193,24 +1254,29 @@ MlasGemmU8X8CopyPackA<MLAS_GEMM_U8S8_KERNEL_SSE41>(
 
         const uint8_t* a = A;
         size_t k = CountK;
-        __m128i ReductionVector = ZeroVector;
+        v128_t ReductionVector = ZeroVector;
 
         //
-        // Copy the source bytes to the packed buffer.
+        // Zero extend the source bytes to 16-bits and write to the packed
+        // buffer.
         //
         // The packed buffer has the same data ordering as the source bytes,
-        // but CountK is aligned up to a multiple of 4 to maintain 32-bit
+        // but CountK is aligned up to a multiple of 2 to maintain 32-bit
         // alignment. All extra bytes are zero-padded.
         //
+        // These 16-bit values are also accumulated into an intermediate per-row
+        // accumulator. CountK cannot be greater than 128 to avoid overflowing
+        // these signed 16-bit accumulators.
+        //
 
         while (k >= 8) {
 
-            __m128i Bytes = _mm_loadl_epi64((const __m128i*)&a[0]);
+            v128_t Bytes = wasm_v64x2_load_splat(&a[0]);
+            v128_t Words = wasm_i16x8_widen_low_u8x16(Bytes);
 
-            __m128i Words = _mm_unpacklo_epi8(Bytes, ZeroVector);
-            ReductionVector = _mm_add_epi32(ReductionVector, _mm_madd_epi16(Words, OnesWordBroadcast));
+            ReductionVector = wasm_i16x8_add(ReductionVector, Words);
 
-            _mm_storel_epi64((__m128i*)&D[0], Bytes);
+            wasm_v128_store(&D[0], Words);
 
             a += 8;
             D += 8;
@@ -1223,25 +1289,43 @@ MlasGemmU8X8CopyPackA<MLAS_GEMM_U8S8_KERNEL_SSE41>(
             // Copy the remaining bytes to the zero padded stack buffer.
             //
 
-            _mm_storel_epi64((__m128i*)&D[0], ZeroVector);
+            uint8_t* padded = PaddedMatrixAData;
+            uint8_t* padded_end = padded + k;
 
-            std::copy_n(&a[0], k, &D[0]);
+            do {
+                padded[0] = a[0];
+                padded++;
+                a++;
+            } while (padded < padded_end);
 
-            __m128i Bytes = _mm_loadl_epi64((__m128i*)&D[0]);
-            D += (k + 3) & ~3;
+            v128_t Bytes = wasm_v64x2_load_splat(PaddedMatrixAData);
+            v128_t Words = wasm_i16x8_widen_low_u8x16(Bytes);
 
-            __m128i Words = _mm_unpacklo_epi8(Bytes, ZeroVector);
-            ReductionVector = _mm_add_epi32(ReductionVector, _mm_madd_epi16(Words, OnesWordBroadcast));
+            ReductionVector = wasm_i16x8_add(ReductionVector, Words);
+
+            //
+            // Copy pairs of 16-bit values from the vector to the packed
+            // buffer and rotate the vector for the next iteration.
+            //
+
+            for (size_t pairs = (k + 1) / 2; pairs > 0; pairs--) {
+                *((int32_t*)D) = wasm_i32x4_extract_lane(Words, 0);
+                D += 2;
+                Words = wasm_v32x4_shuffle(Words, Words, 1, 2, 3, 0);
+            }
         }
 
         //
         // Reduce the partial accumulators.
         //
 
-        ReductionVector = _mm_hadd_epi32(ReductionVector, ReductionVector);
-        ReductionVector = _mm_hadd_epi32(ReductionVector, ReductionVector);
+        ReductionVector = wasm_i32x4_dot_i16x8(ReductionVector, OnesWordBroadcast);
+        ReductionVector = wasm_i32x4_add(ReductionVector,
+            wasm_v32x4_shuffle(ReductionVector, ReductionVector, 2, 3, 2, 3));
+        ReductionVector = wasm_i32x4_add(ReductionVector,
+            wasm_v32x4_shuffle(ReductionVector, ReductionVector, 1, 0, 1, 0));
 
-        *RowSumBuffer++ = _mm_cvtsi128_si32(ReductionVector);
+        *RowSumBuffer++ = wasm_i32x4_extract_lane(ReductionVector, 0);
 
         A += lda;
         CountM -= 1;
@@ -1250,37 +1334,33 @@ MlasGemmU8X8CopyPackA<MLAS_GEMM_U8S8_KERNEL_SSE41>(
 
 MLAS_FORCEINLINE
 void
-MlasGemmU8X8CopyPackBProcessSse41(
-    MLAS_GEMM_U8S8_KERNEL_SSE41::PackedBType* D,
-    __m128i BytesRows[4],
-    __m128i OnesByteBroadcast,
-    __m128i OnesWordBroadcast,
-    __m128i ColumnSums[2]
+MlasGemmU8X8CopyPackBProcessWasmSimd(
+    MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedBType* D,
+    v128_t BytesRow0,
+    v128_t BytesRow1,
+    v128_t BitFlipVector,
+    v128_t ColumnSums[2]
     )
 {
-    __m128i PairsInterleaved0 = _mm_unpacklo_epi8(BytesRows[0], BytesRows[1]);
-    __m128i PairsInterleaved1 = _mm_unpacklo_epi8(BytesRows[2], BytesRows[3]);
-
-    __m128i QuadsInterleaved0 = _mm_unpacklo_epi16(PairsInterleaved0, PairsInterleaved1);
-    __m128i QuadsInterleaved1 = _mm_unpackhi_epi16(PairsInterleaved0, PairsInterleaved1);
+    v128_t BytesInterleaved = wasm_v8x16_shuffle(BytesRow0, BytesRow1,
+        0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
 
-    __m128i PairwiseAdd0 = _mm_maddubs_epi16(OnesByteBroadcast, QuadsInterleaved0);
-    __m128i PairwiseAdd1 = _mm_maddubs_epi16(OnesByteBroadcast, QuadsInterleaved1);
+    BytesInterleaved = wasm_v128_xor(BytesInterleaved, BitFlipVector);
 
-    PairwiseAdd0 = _mm_madd_epi16(PairwiseAdd0, OnesWordBroadcast);
-    PairwiseAdd1 = _mm_madd_epi16(PairwiseAdd1, OnesWordBroadcast);
+    v128_t WordsInterleaved0 = wasm_i16x8_widen_low_i8x16(BytesInterleaved);
+    v128_t WordsInterleaved1 = wasm_i16x8_widen_high_i8x16(BytesInterleaved);
 
-    ColumnSums[0] = _mm_add_epi32(ColumnSums[0], PairwiseAdd0);
-    ColumnSums[1] = _mm_add_epi32(ColumnSums[1], PairwiseAdd1);
+    ColumnSums[0] = wasm_i16x8_add(ColumnSums[0], WordsInterleaved0);
+    ColumnSums[1] = wasm_i16x8_add(ColumnSums[1], WordsInterleaved1);
 
-    _mm_storeu_si128((__m128i*)&D[0], QuadsInterleaved0);
-    _mm_storeu_si128((__m128i*)&D[16], QuadsInterleaved1);
+    wasm_v128_store(&D[0], WordsInterleaved0);
+    wasm_v128_store(&D[8], WordsInterleaved1);
 }
 
 template<>
 void
-MlasGemmU8X8CopyPackB<MLAS_GEMM_U8S8_KERNEL_SSE41>(
-    MLAS_GEMM_U8S8_KERNEL_SSE41::PackedBType* D,
+MlasGemmU8X8CopyPackB<MLAS_GEMM_U8X8_KERNEL_WASMSIMD>(
+    MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedBType* D,
     const uint8_t* B,
     size_t ldb,
     size_t CountN,
@@ -1289,11 +1369,8 @@ MlasGemmU8X8CopyPackB<MLAS_GEMM_U8S8_KERNEL_SSE41>(
     bool BIsSigned
     )
 {
-    const __m128i OnesByteBroadcast = _mm_set1_epi8(1);
-    const __m128i OnesWordBroadcast = _mm_set1_epi16(1);
-    __m128i BytesRows[4];
-
-    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+    const v128_t OnesWordBroadcast = wasm_i16x8_splat(1);
+    const v128_t BitFlipVector = wasm_i32x4_splat(BIsSigned ? 0 : 0x80808080);
 
     //
     // Process 8 columns of matrix B in a loop.
@@ -1303,51 +1380,45 @@ MlasGemmU8X8CopyPackB<MLAS_GEMM_U8S8_KERNEL_SSE41>(
 
         const uint8_t* b = B;
         size_t k = CountK;
-        __m128i ColumnSums[2];
+        v128_t ColumnSums[2];
 
-        ColumnSums[0] = _mm_setzero_si128();
-        ColumnSums[1] = _mm_setzero_si128();
+        ColumnSums[0] = wasm_i64x2_const(0, 0);
+        ColumnSums[1] = wasm_i64x2_const(0, 0);
 
         //
         // Interleave rows of matrix B and write to the packed buffer.
         //
+        // These values are also sign-extended and accumulated into an
+        // intermediate per-column accumulator. CountK cannot be greater than
+        // 128 to avoid overflowing these signed 16-bit accumulators.
+        //
 
-        while (k >= MLAS_GEMM_U8S8_KERNEL_SSE41::PackedK) {
+        while (k >= MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedK) {
 
-            BytesRows[0] = _mm_loadl_epi64((const __m128i*)&b[ldb * 0]);
-            BytesRows[1] = _mm_loadl_epi64((const __m128i*)&b[ldb * 1]);
-            BytesRows[2] = _mm_loadl_epi64((const __m128i*)&b[ldb * 2]);
-            BytesRows[3] = _mm_loadl_epi64((const __m128i*)&b[ldb * 3]);
+            v128_t BytesRow0 = wasm_v64x2_load_splat(&b[0]);
+            v128_t BytesRow1 = wasm_v64x2_load_splat(&b[ldb]);
 
-            MlasGemmU8X8CopyPackBProcessSse41(D, BytesRows, OnesByteBroadcast, OnesWordBroadcast, ColumnSums);
+            MlasGemmU8X8CopyPackBProcessWasmSimd(D, BytesRow0, BytesRow1, BitFlipVector, ColumnSums);
 
-            b += ldb * 4;
-            D += 32;
-            k -= 4;
+            b += ldb * 2;
+            D += 16;
+            k -= 2;
         }
 
         if (k > 0) {
 
-            BytesRows[0] = _mm_loadl_epi64((const __m128i*)&b[ldb * 0]);
-            BytesRows[1] = _mm_setzero_si128();
-            BytesRows[2] = _mm_setzero_si128();
-            BytesRows[3] = _mm_setzero_si128();
-
-            if (k >= 2) {
-                BytesRows[1] = _mm_loadl_epi64((const __m128i*)&b[ldb * 1]);
-            }
-
-            if (k >= 3) {
-                BytesRows[2] = _mm_loadl_epi64((const __m128i*)&b[ldb * 2]);
-            }
+            v128_t BytesRow0 = wasm_v64x2_load_splat(&b[0]);
 
-            MlasGemmU8X8CopyPackBProcessSse41(D, BytesRows, OnesByteBroadcast, OnesWordBroadcast, ColumnSums);
+            MlasGemmU8X8CopyPackBProcessWasmSimd(D, BytesRow0, BitFlipVector, BitFlipVector, ColumnSums);
 
-            D += 32;
+            D += 16;
         }
 
-        _mm_storeu_si128((__m128i*)&ColumnSumBuffer[0], ColumnSums[0]);
-        _mm_storeu_si128((__m128i*)&ColumnSumBuffer[4], ColumnSums[1]);
+        ColumnSums[0] = wasm_i32x4_dot_i16x8(ColumnSums[0], OnesWordBroadcast);
+        ColumnSums[1] = wasm_i32x4_dot_i16x8(ColumnSums[1], OnesWordBroadcast);
+
+        wasm_v128_store(&ColumnSumBuffer[0], ColumnSums[0]);
+        wasm_v128_store(&ColumnSumBuffer[4], ColumnSums[1]);
         ColumnSumBuffer += 8;
 
         B += 8;
@@ -1360,73 +1431,89 @@ MlasGemmU8X8CopyPackB<MLAS_GEMM_U8S8_KERNEL_SSE41>(
 
     if (CountN > 0) {
 
-        const __m128i ZeroVector = _mm_setzero_si128();
-
-        __m128i ColumnSums[2];
-        uint8_t PaddedMatrixBData[32];
+        const uint8_t* b = B;
+        size_t k = CountK;
+        v128_t ColumnSums[2];
+        uint8_t PaddedMatrixBData[16];
 
-        ColumnSums[0] = _mm_setzero_si128();
-        ColumnSums[1] = _mm_setzero_si128();
+        wasm_v128_store(PaddedMatrixBData, BitFlipVector);
 
-        while (CountK > 0) {
+        ColumnSums[0] = wasm_i64x2_const(0, 0);
+        ColumnSums[1] = wasm_i64x2_const(0, 0);
 
-            size_t k = std::min(CountK, MLAS_GEMM_U8S8_KERNEL_SSE41::PackedK);
-            CountK -= k;
+        //
+        // Interleave rows of matrix B using an intermediate zero padded stack
+        // buffer and write to the packed buffer.
+        //
 
-            _mm_storeu_si128((__m128i*)&PaddedMatrixBData[0], ZeroVector);
-            _mm_storeu_si128((__m128i*)&PaddedMatrixBData[16], ZeroVector);
+        while (k >= MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedK) {
 
+            const uint8_t* bcopy = b;
             uint8_t* padded = PaddedMatrixBData;
+            uint8_t* padded_end = padded + CountN;
 
             do {
+                padded[0] = bcopy[0];
+                padded[8] = bcopy[ldb];
+                padded++;
+                bcopy++;
+            } while (padded < padded_end);
 
-                std::copy_n(B, CountN, padded);
+            v128_t BytesRow0 = wasm_v64x2_load_splat(&PaddedMatrixBData[0]);
+            v128_t BytesRow1 = wasm_v64x2_load_splat(&PaddedMatrixBData[8]);
 
-                padded += 8;
-                B += ldb;
-                k -= 1;
+            MlasGemmU8X8CopyPackBProcessWasmSimd(D, BytesRow0, BytesRow1, BitFlipVector, ColumnSums);
 
-            } while (k > 0);
+            b += ldb * 2;
+            D += 16;
+            k -= 2;
+        }
 
-            BytesRows[0] = _mm_loadl_epi64((__m128i*)&PaddedMatrixBData[0]);
-            BytesRows[1] = _mm_loadl_epi64((__m128i*)&PaddedMatrixBData[8]);
-            BytesRows[2] = _mm_loadl_epi64((__m128i*)&PaddedMatrixBData[16]);
-            BytesRows[3] = _mm_loadl_epi64((__m128i*)&PaddedMatrixBData[24]);
+        if (k > 0) {
 
-            MlasGemmU8X8CopyPackBProcessSse41(D, BytesRows, OnesByteBroadcast, OnesWordBroadcast, ColumnSums);
+            const uint8_t* bcopy = b;
+            uint8_t* padded = PaddedMatrixBData;
+            uint8_t* padded_end = padded + CountN;
 
-            D += 32;
+            do {
+                padded[0] = bcopy[0];
+                padded++;
+                bcopy++;
+            } while (padded < padded_end);
+
+            v128_t BytesRow0 = wasm_v64x2_load_splat(&PaddedMatrixBData[0]);
+
+            MlasGemmU8X8CopyPackBProcessWasmSimd(D, BytesRow0, BitFlipVector, BitFlipVector, ColumnSums);
         }
 
-        _mm_storeu_si128((__m128i*)&ColumnSumBuffer[0], ColumnSums[0]);
-        _mm_storeu_si128((__m128i*)&ColumnSumBuffer[4], ColumnSums[1]);
+        ColumnSums[0] = wasm_i32x4_dot_i16x8(ColumnSums[0], OnesWordBroadcast);
+        ColumnSums[1] = wasm_i32x4_dot_i16x8(ColumnSums[1], OnesWordBroadcast);
+
+        wasm_v128_store(&ColumnSumBuffer[0], ColumnSums[0]);
+        wasm_v128_store(&ColumnSumBuffer[4], ColumnSums[1]);
     }
 }
 
 MLAS_FORCEINLINE
 void
-MlasGemmU8X8MultiplyAccumulateRowSse41(
-    __m128i ABroadcast,
-    const MLAS_GEMM_U8S8_KERNEL_SSE41::PackedBType* B,
-    __m128i OnesWordBroadcast,
-    __m128i Accumulators[2]
+MlasGemmU8X8MultiplyAccumulateRowWasmSimd(
+    v128_t ABroadcast,
+    const int16_t* B,
+    v128_t Accumulators[2]
     )
 {
-    __m128i BElements0 = _mm_load_si128((__m128i*)&B[0]);
-    __m128i BElements1 = _mm_load_si128((__m128i*)&B[16]);
-
-    __m128i Intermediate0 = _mm_maddubs_epi16(ABroadcast, BElements0);
-    __m128i Intermediate1 = _mm_maddubs_epi16(ABroadcast, BElements1);
+    v128_t BElements0 = wasm_v128_load(&B[0]);
+    v128_t BElements1 = wasm_v128_load(&B[8]);
 
-    Accumulators[0] = _mm_add_epi32(Accumulators[0], _mm_madd_epi16(Intermediate0, OnesWordBroadcast));
-    Accumulators[1] = _mm_add_epi32(Accumulators[1], _mm_madd_epi16(Intermediate1, OnesWordBroadcast));
+    Accumulators[0] = wasm_i32x4_add(Accumulators[0], wasm_i32x4_dot_i16x8(BElements0, ABroadcast));
+    Accumulators[1] = wasm_i32x4_add(Accumulators[1], wasm_i32x4_dot_i16x8(BElements1, ABroadcast));
 }
 
 template<>
 size_t
-MlasGemmU8X8Kernel<MLAS_GEMM_U8S8_KERNEL_SSE41>(
-    const MLAS_GEMM_U8S8_KERNEL_SSE41::PackedAType* A,
-    const MLAS_GEMM_U8S8_KERNEL_SSE41::PackedBType* B,
+MlasGemmU8X8Kernel<MLAS_GEMM_U8X8_KERNEL_WASMSIMD>(
+    const MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedAType* A,
+    const MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedBType* B,
     int32_t* C,
     size_t PackedCountK,
     size_t CountM,
@@ -1438,35 +1525,475 @@ MlasGemmU8X8Kernel<MLAS_GEMM_U8S8_KERNEL_SSE41>(
     bool ZeroMode
     )
 {
-    const __m128i OnesWordBroadcast = _mm_set1_epi16(1);
-
     MLAS_UNREFERENCED_PARAMETER(CountM);
     MLAS_UNREFERENCED_PARAMETER(ldc);
 
     while (CountN > 0) {
 
-        __m128i Accumulators[2];
+        v128_t Accumulators[2];
 
         //
         // Initialize the accumulators with the row and column sums.
         //
 
-        Accumulators[0] = _mm_set1_epi32(RowSumBuffer[0]);
-        Accumulators[1] = Accumulators[0];
+        int32_t RowSumValue = RowSumBuffer[0];
 
         if (ZeroPointB != nullptr) {
-            Accumulators[0] = _mm_mullo_epi32(Accumulators[0], _mm_loadu_si128((const __m128i*)&ZeroPointB[0]));
-            Accumulators[1] = _mm_mullo_epi32(Accumulators[1], _mm_loadu_si128((const __m128i*)&ZeroPointB[4]));
+
+            int32_t ScaledRowSumBuffer[8];
+
+            for (size_t i = 0; i < 8; i++) {
+                ScaledRowSumBuffer[i] = RowSumValue * ZeroPointB[i];
+            }
+
             ZeroPointB += 8;
+
+            Accumulators[0] = wasm_v128_load(&ScaledRowSumBuffer[0]);
+            Accumulators[1] = wasm_v128_load(&ScaledRowSumBuffer[4]);
+
+        } else {
+
+            Accumulators[0] = wasm_i32x4_splat(RowSumValue);
+            Accumulators[1] = Accumulators[0];
         }
 
-        Accumulators[0] = _mm_add_epi32(Accumulators[0], _mm_loadu_si128((const __m128i*)&ColumnSumBuffer[0]));
-        Accumulators[1] = _mm_add_epi32(Accumulators[1], _mm_loadu_si128((const __m128i*)&ColumnSumBuffer[4]));
+        Accumulators[0] = wasm_i32x4_add(Accumulators[0], wasm_v128_load(&ColumnSumBuffer[0]));
+        Accumulators[1] = wasm_i32x4_add(Accumulators[1], wasm_v128_load(&ColumnSumBuffer[4]));
         ColumnSumBuffer += 8;
 
         //
-        // Broadcast each quad of 8-bit values from the matrix A and multiply
-        // with the quad of 8-bit values from matrix B, and add the 32-bit
+        // Broadcast each pair of 16-bit values from the matrix A and multiply
+        // with the pair of 16-bit values from matrix B, and add the 32-bit
+        // intermediate into the accumulator registers.
+        //
+
+        const int16_t* a = A;
+        size_t k = PackedCountK;
+
+        while (k >= 4) {
+
+            v128_t AElements = wasm_v128_load(a);
+            v128_t ABroadcast;
+
+            ABroadcast = wasm_v32x4_shuffle(AElements, AElements, 0, 0, 0, 0);
+            MlasGemmU8X8MultiplyAccumulateRowWasmSimd(ABroadcast, &B[0], Accumulators);
+
+            ABroadcast = wasm_v32x4_shuffle(AElements, AElements, 1, 1, 1, 1);
+            MlasGemmU8X8MultiplyAccumulateRowWasmSimd(ABroadcast, &B[16], Accumulators);
+
+            ABroadcast = wasm_v32x4_shuffle(AElements, AElements, 2, 2, 2, 2);
+            MlasGemmU8X8MultiplyAccumulateRowWasmSimd(ABroadcast, &B[32], Accumulators);
+
+            ABroadcast = wasm_v32x4_shuffle(AElements, AElements, 3, 3, 3, 3);
+            MlasGemmU8X8MultiplyAccumulateRowWasmSimd(ABroadcast, &B[48], Accumulators);
+
+            a += 4 * 2;
+            B += 4 * 16;
+            k -= 4;
+        }
+
+        while (k > 0) {
+
+            v128_t ABroadcast = wasm_i32x4_splat(*((int32_t*)a));
+            MlasGemmU8X8MultiplyAccumulateRowWasmSimd(ABroadcast, &B[0], Accumulators);
+
+            a += 2;
+            B += 16;
+            k -= 1;
+        }
+
+        //
+        // Output the accumulator block after optionally accumulating the values
+        // from matrix C.
+        //
+
+        if (CountN >= 8) {
+
+            if (!ZeroMode) {
+                Accumulators[0] = wasm_i32x4_add(Accumulators[0], wasm_v128_load(&C[0]));
+                Accumulators[1] = wasm_i32x4_add(Accumulators[1], wasm_v128_load(&C[4]));
+            }
+
+            wasm_v128_store(&C[0], Accumulators[0]);
+            wasm_v128_store(&C[4], Accumulators[1]);
+
+            C += 8;
+            CountN -= 8;
+
+        } else {
+
+            //
+            // Output the remaining partial output block.
+            //
+
+            if ((CountN & 4) != 0) {
+
+                if (!ZeroMode) {
+                    Accumulators[0] = wasm_i32x4_add(Accumulators[0], wasm_v128_load(&C[0]));
+                }
+
+                wasm_v128_store(&C[0], Accumulators[0]);
+                C += 4;
+
+                Accumulators[0] = Accumulators[1];
+            }
+
+            if ((CountN & 2) != 0) {
+
+                if (!ZeroMode) {
+                    Accumulators[0] = wasm_i32x4_add(Accumulators[0], wasm_i64x2_make(*((int64_t*)&C[0]), 0));
+                }
+
+                *((int64_t*)&C[0]) = wasm_i64x2_extract_lane(Accumulators[0], 0);
+                C += 2;
+
+                Accumulators[0] = wasm_v32x4_shuffle(Accumulators[0], Accumulators[0], 2, 3, 2, 3);
+            }
+
+            if ((CountN & 1) != 0) {
+
+                int32_t AccumulatorValue = wasm_i32x4_extract_lane(Accumulators[0], 0);
+
+                if (!ZeroMode) {
+                    AccumulatorValue += C[0];
+                }
+
+                C[0] = AccumulatorValue;
+            }
+
+            CountN = 0;
+        }
+    }
+
+    return 1;
+}
+
+const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchWasmSimd = {
+    MlasGemmU8X8Operation<MLAS_GEMM_U8X8_KERNEL_WASMSIMD>,
+    nullptr,
+    nullptr,
+    MLAS_GEMM_U8X8_KERNEL_WASMSIMD::PackedK,
+    0,
+};
+
+#endif
+
+// N.B. MSVC does not require turning on SSE 4.1 intrinsics and the current use
+// for this code is Windows only, so restrict this kernel to that environment.
+#if defined(MLAS_SSE2_INTRINSICS) && defined(_MSC_VER)
+
+struct MLAS_GEMM_U8S8_KERNEL_SSE41
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef uint8_t OffsetAType;
+    typedef int8_t OffsetBType;
+
+    static constexpr size_t PackedK = 4;
+    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{24, 128, 128};
+    static constexpr MLAS_GEMM_U8X8_STRIDES PackedStrides{24, 128, 128};
+};
+
+constexpr size_t MLAS_GEMM_U8S8_KERNEL_SSE41::PackedK;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8S8_KERNEL_SSE41::Strides;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8S8_KERNEL_SSE41::PackedStrides;
+
+template<>
+void
+MlasGemmU8X8CopyPackA<MLAS_GEMM_U8S8_KERNEL_SSE41>(
+    MLAS_GEMM_U8S8_KERNEL_SSE41::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    const __m128i ZeroVector = _mm_setzero_si128();
+    const __m128i OnesWordBroadcast = _mm_set1_epi16(1);
+
+    //
+    // Process a single row of matrix A in a loop.
+    //
+
+    while (CountM > 0) {
+
+        const uint8_t* a = A;
+        size_t k = CountK;
+        __m128i ReductionVector = ZeroVector;
+
+        //
+        // Copy the source bytes to the packed buffer.
+        //
+        // The packed buffer has the same data ordering as the source bytes,
+        // but CountK is aligned up to a multiple of 4 to maintain 32-bit
+        // alignment. All extra bytes are zero-padded.
+        //
+
+        while (k >= 8) {
+
+            __m128i Bytes = _mm_loadl_epi64((const __m128i*)&a[0]);
+
+            __m128i Words = _mm_unpacklo_epi8(Bytes, ZeroVector);
+            ReductionVector = _mm_add_epi32(ReductionVector, _mm_madd_epi16(Words, OnesWordBroadcast));
+
+            _mm_storel_epi64((__m128i*)&D[0], Bytes);
+
+            a += 8;
+            D += 8;
+            k -= 8;
+        }
+
+        if (k > 0) {
+
+            //
+            // Copy the remaining bytes to the zero padded stack buffer.
+            //
+
+            _mm_storel_epi64((__m128i*)&D[0], ZeroVector);
+
+            std::copy_n(&a[0], k, &D[0]);
+
+            __m128i Bytes = _mm_loadl_epi64((__m128i*)&D[0]);
+            D += (k + 3) & ~3;
+
+            __m128i Words = _mm_unpacklo_epi8(Bytes, ZeroVector);
+            ReductionVector = _mm_add_epi32(ReductionVector, _mm_madd_epi16(Words, OnesWordBroadcast));
+        }
+
+        //
+        // Reduce the partial accumulators.
+        //
+
+        ReductionVector = _mm_hadd_epi32(ReductionVector, ReductionVector);
+        ReductionVector = _mm_hadd_epi32(ReductionVector, ReductionVector);
+
+        *RowSumBuffer++ = _mm_cvtsi128_si32(ReductionVector);
+
+        A += lda;
+        CountM -= 1;
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8CopyPackBProcessSse41(
+    MLAS_GEMM_U8S8_KERNEL_SSE41::PackedBType* D,
+    __m128i BytesRows[4],
+    __m128i OnesByteBroadcast,
+    __m128i OnesWordBroadcast,
+    __m128i ColumnSums[2]
+    )
+{
+    __m128i PairsInterleaved0 = _mm_unpacklo_epi8(BytesRows[0], BytesRows[1]);
+    __m128i PairsInterleaved1 = _mm_unpacklo_epi8(BytesRows[2], BytesRows[3]);
+
+    __m128i QuadsInterleaved0 = _mm_unpacklo_epi16(PairsInterleaved0, PairsInterleaved1);
+    __m128i QuadsInterleaved1 = _mm_unpackhi_epi16(PairsInterleaved0, PairsInterleaved1);
+
+    __m128i PairwiseAdd0 = _mm_maddubs_epi16(OnesByteBroadcast, QuadsInterleaved0);
+    __m128i PairwiseAdd1 = _mm_maddubs_epi16(OnesByteBroadcast, QuadsInterleaved1);
+
+    PairwiseAdd0 = _mm_madd_epi16(PairwiseAdd0, OnesWordBroadcast);
+    PairwiseAdd1 = _mm_madd_epi16(PairwiseAdd1, OnesWordBroadcast);
+
+    ColumnSums[0] = _mm_add_epi32(ColumnSums[0], PairwiseAdd0);
+    ColumnSums[1] = _mm_add_epi32(ColumnSums[1], PairwiseAdd1);
+
+    _mm_storeu_si128((__m128i*)&D[0], QuadsInterleaved0);
+    _mm_storeu_si128((__m128i*)&D[16], QuadsInterleaved1);
+}
+
+template<>
+void
+MlasGemmU8X8CopyPackB<MLAS_GEMM_U8S8_KERNEL_SSE41>(
+    MLAS_GEMM_U8S8_KERNEL_SSE41::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    const __m128i OnesByteBroadcast = _mm_set1_epi8(1);
+    const __m128i OnesWordBroadcast = _mm_set1_epi16(1);
+    __m128i BytesRows[4];
+
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+
+    //
+    // Process 8 columns of matrix B in a loop.
+    //
+
+    while (CountN >= 8) {
+
+        const uint8_t* b = B;
+        size_t k = CountK;
+        __m128i ColumnSums[2];
+
+        ColumnSums[0] = _mm_setzero_si128();
+        ColumnSums[1] = _mm_setzero_si128();
+
+        //
+        // Interleave rows of matrix B and write to the packed buffer.
+        //
+
+        while (k >= MLAS_GEMM_U8S8_KERNEL_SSE41::PackedK) {
+
+            BytesRows[0] = _mm_loadl_epi64((const __m128i*)&b[ldb * 0]);
+            BytesRows[1] = _mm_loadl_epi64((const __m128i*)&b[ldb * 1]);
+            BytesRows[2] = _mm_loadl_epi64((const __m128i*)&b[ldb * 2]);
+            BytesRows[3] = _mm_loadl_epi64((const __m128i*)&b[ldb * 3]);
+
+            MlasGemmU8X8CopyPackBProcessSse41(D, BytesRows, OnesByteBroadcast, OnesWordBroadcast, ColumnSums);
+
+            b += ldb * 4;
+            D += 32;
+            k -= 4;
+        }
+
+        if (k > 0) {
+
+            BytesRows[0] = _mm_loadl_epi64((const __m128i*)&b[ldb * 0]);
+            BytesRows[1] = _mm_setzero_si128();
+            BytesRows[2] = _mm_setzero_si128();
+            BytesRows[3] = _mm_setzero_si128();
+
+            if (k >= 2) {
+                BytesRows[1] = _mm_loadl_epi64((const __m128i*)&b[ldb * 1]);
+            }
+
+            if (k >= 3) {
+                BytesRows[2] = _mm_loadl_epi64((const __m128i*)&b[ldb * 2]);
+            }
+
+            MlasGemmU8X8CopyPackBProcessSse41(D, BytesRows, OnesByteBroadcast, OnesWordBroadcast, ColumnSums);
+
+            D += 32;
+        }
+
+        _mm_storeu_si128((__m128i*)&ColumnSumBuffer[0], ColumnSums[0]);
+        _mm_storeu_si128((__m128i*)&ColumnSumBuffer[4], ColumnSums[1]);
+        ColumnSumBuffer += 8;
+
+        B += 8;
+        CountN -= 8;
+    }
+
+    //
+    // Process the remaining columns of matrix B.
+    //
+
+    if (CountN > 0) {
+
+        const __m128i ZeroVector = _mm_setzero_si128();
+
+        __m128i ColumnSums[2];
+        uint8_t PaddedMatrixBData[32];
+
+        ColumnSums[0] = _mm_setzero_si128();
+        ColumnSums[1] = _mm_setzero_si128();
+
+        while (CountK > 0) {
+
+            size_t k = std::min(CountK, MLAS_GEMM_U8S8_KERNEL_SSE41::PackedK);
+            CountK -= k;
+
+            _mm_storeu_si128((__m128i*)&PaddedMatrixBData[0], ZeroVector);
+            _mm_storeu_si128((__m128i*)&PaddedMatrixBData[16], ZeroVector);
+
+            uint8_t* padded = PaddedMatrixBData;
+
+            do {
+
+                std::copy_n(B, CountN, padded);
+
+                padded += 8;
+                B += ldb;
+                k -= 1;
+
+            } while (k > 0);
+
+            BytesRows[0] = _mm_loadl_epi64((__m128i*)&PaddedMatrixBData[0]);
+            BytesRows[1] = _mm_loadl_epi64((__m128i*)&PaddedMatrixBData[8]);
+            BytesRows[2] = _mm_loadl_epi64((__m128i*)&PaddedMatrixBData[16]);
+            BytesRows[3] = _mm_loadl_epi64((__m128i*)&PaddedMatrixBData[24]);
+
+            MlasGemmU8X8CopyPackBProcessSse41(D, BytesRows, OnesByteBroadcast, OnesWordBroadcast, ColumnSums);
+
+            D += 32;
+        }
+
+        _mm_storeu_si128((__m128i*)&ColumnSumBuffer[0], ColumnSums[0]);
+        _mm_storeu_si128((__m128i*)&ColumnSumBuffer[4], ColumnSums[1]);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8MultiplyAccumulateRowSse41(
+    __m128i ABroadcast,
+    const MLAS_GEMM_U8S8_KERNEL_SSE41::PackedBType* B,
+    __m128i OnesWordBroadcast,
+    __m128i Accumulators[2]
+    )
+{
+    __m128i BElements0 = _mm_load_si128((__m128i*)&B[0]);
+    __m128i BElements1 = _mm_load_si128((__m128i*)&B[16]);
+
+    __m128i Intermediate0 = _mm_maddubs_epi16(ABroadcast, BElements0);
+    __m128i Intermediate1 = _mm_maddubs_epi16(ABroadcast, BElements1);
+
+    Accumulators[0] = _mm_add_epi32(Accumulators[0], _mm_madd_epi16(Intermediate0, OnesWordBroadcast));
+    Accumulators[1] = _mm_add_epi32(Accumulators[1], _mm_madd_epi16(Intermediate1, OnesWordBroadcast));
+}
+
+template<>
+size_t
+MlasGemmU8X8Kernel<MLAS_GEMM_U8S8_KERNEL_SSE41>(
+    const MLAS_GEMM_U8S8_KERNEL_SSE41::PackedAType* A,
+    const MLAS_GEMM_U8S8_KERNEL_SSE41::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    const __m128i OnesWordBroadcast = _mm_set1_epi16(1);
+
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+
+    while (CountN > 0) {
+
+        __m128i Accumulators[2];
+
+        //
+        // Initialize the accumulators with the row and column sums.
+        //
+
+        Accumulators[0] = _mm_set1_epi32(RowSumBuffer[0]);
+        Accumulators[1] = Accumulators[0];
+
+        if (ZeroPointB != nullptr) {
+            Accumulators[0] = _mm_mullo_epi32(Accumulators[0], _mm_loadu_si128((const __m128i*)&ZeroPointB[0]));
+            Accumulators[1] = _mm_mullo_epi32(Accumulators[1], _mm_loadu_si128((const __m128i*)&ZeroPointB[4]));
+            ZeroPointB += 8;
+        }
+
+        Accumulators[0] = _mm_add_epi32(Accumulators[0], _mm_loadu_si128((const __m128i*)&ColumnSumBuffer[0]));
+        Accumulators[1] = _mm_add_epi32(Accumulators[1], _mm_loadu_si128((const __m128i*)&ColumnSumBuffer[4]));
+        ColumnSumBuffer += 8;
+
+        //
+        // Broadcast each quad of 8-bit values from the matrix A and multiply
+        // with the quad of 8-bit values from matrix B, and add the 32-bit
         // intermediate into the accumulator registers.
         //
 
@@ -1646,6 +2173,7 @@ struct MLAS_GEMM_U8S8_KERNEL_AVX2
 {
     typedef uint8_t PackedAType;
     typedef uint8_t PackedBType;
+    typedef uint8_t OffsetAType;
     typedef int8_t OffsetBType;
 
     static constexpr size_t PackedK = 4;
@@ -1757,6 +2285,7 @@ struct MLAS_GEMM_U8U8_KERNEL_AVX2
 {
     typedef int16_t PackedAType;
     typedef uint8_t PackedBType;
+    typedef uint8_t OffsetAType;
     typedef uint8_t OffsetBType;
 
     static constexpr size_t PackedK = 2;
@@ -1830,6 +2359,355 @@ const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8U8DispatchAvx2 = {
     MLAS_GEMM_U8U8_KERNEL_AVX2::PackedStrides.K,
 };
 
+//
+// Without VNNI support, signed matrix A and signed matrix B are both converted
+// to unsigned data by flipping the sign bit and the exact U8U8 kernels are used.
+// The biased zero point offsets are absorbed by the row and column sum
+// adjustments that are always applied.
+//
+
+struct MLAS_GEMM_S8S8_KERNEL_AVX2
+{
+    typedef int16_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef int8_t OffsetAType;
+    typedef uint8_t OffsetBType;
+
+    static constexpr size_t PackedK = 2;
+    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{24, 256, 128};
+    static constexpr MLAS_GEMM_U8X8_STRIDES PackedStrides{48, 256, 384};
+};
+
+constexpr size_t MLAS_GEMM_S8S8_KERNEL_AVX2::PackedK;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_S8S8_KERNEL_AVX2::Strides;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_S8S8_KERNEL_AVX2::PackedStrides;
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointA<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    int32_t ZeroPointA
+    )
+{
+    return ZeroPointA + 0x80;
+}
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointB<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    if (BIsSigned) {
+        ZeroPointB = MLAS_GEMM_S8S8_KERNEL_AVX2::OffsetBType(ZeroPointB ^ 0x80);
+    }
+
+    return ZeroPointB;
+}
+
+template<>
+void
+MlasGemmU8X8CopyPackA<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    const size_t AlignedCountK =
+        (CountK + MLAS_GEMM_S8S8_KERNEL_AVX2::PackedK - 1) & ~(MLAS_GEMM_S8S8_KERNEL_AVX2::PackedK - 1);
+    const __m128i BitFlipVector = _mm_set1_epi32(0x80808080);
+    const __m128i ZeroVector = _mm_setzero_si128();
+
+    //
+    // Process a single row of matrix A in a loop.
+    //
+    // The buffer is packed in the same format as MlasGemmU8U8CopyPackAAvx2:
+    // each row is zero extended to 16-bits, stored contiguously, and zero
+    // padded to a multiple of PackedK.
+    //
+
+    while (CountM-- > 0) {
+
+        const uint8_t* a = A;
+        int16_t* d = D;
+        size_t k = CountK;
+        __m128i RowSums = ZeroVector;
+
+        while (k >= 16) {
+
+            __m128i Bytes = _mm_xor_si128(_mm_loadu_si128((const __m128i*)a), BitFlipVector);
+            _mm_storeu_si128((__m128i*)&d[0], _mm_unpacklo_epi8(Bytes, ZeroVector));
+            _mm_storeu_si128((__m128i*)&d[8], _mm_unpackhi_epi8(Bytes, ZeroVector));
+
+            RowSums = _mm_add_epi32(RowSums, _mm_sad_epu8(Bytes, ZeroVector));
+
+            a += 16;
+            d += 16;
+            k -= 16;
+        }
+
+        RowSums = _mm_add_epi32(RowSums, _mm_shuffle_epi32(RowSums, _MM_SHUFFLE(1, 0, 3, 2)));
+        int32_t RowSum = _mm_cvtsi128_si32(RowSums);
+
+        while (k > 0) {
+
+            uint8_t a0 = *a++ ^ 0x80;
+            *d++ = a0;
+
+            RowSum += a0;
+            k -= 1;
+        }
+
+        for (size_t kk = CountK; kk < AlignedCountK; kk++) {
+            *d++ = 0;
+        }
+
+        *RowSumBuffer++ = RowSum;
+
+        A += lda;
+        D += AlignedCountK;
+    }
+}
+
+template<>
+void
+MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    if (!BIsSigned) {
+        MlasGemmU8U8CopyPackBAvx2(D, B, ldb, CountN, CountK, ColumnSumBuffer);
+        return;
+    }
+
+    //
+    // MlasGemmU8U8CopyPackBAvx2 packs matrix B as blocks of 16 columns, so the
+    // sign bit of each block is flipped into a local buffer and then packed.
+    //
+
+    MLAS_DECLSPEC_ALIGN(uint8_t FlippedB[16 * MLAS_GEMM_S8S8_KERNEL_AVX2::PackedStrides.K], 64);
+
+    const size_t AlignedCountK =
+        (CountK + MLAS_GEMM_S8S8_KERNEL_AVX2::PackedK - 1) & ~(MLAS_GEMM_S8S8_KERNEL_AVX2::PackedK - 1);
+
+    while (CountN > 0) {
+
+        const size_t CountNN = std::min(CountN, size_t(16));
+
+        for (size_t k = 0; k < CountK; k++) {
+            for (size_t n = 0; n < CountNN; n++) {
+                FlippedB[k * 16 + n] = B[k * ldb + n] ^ 0x80;
+            }
+        }
+
+        MlasGemmU8U8CopyPackBAvx2(D, FlippedB, 16, CountNN, CountK, ColumnSumBuffer);
+
+        B += 16;
+        D += 16 * AlignedCountK;
+        ColumnSumBuffer += 16;
+        CountN -= CountNN;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmU8X8Kernel<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    const MLAS_GEMM_S8S8_KERNEL_AVX2::PackedAType* A,
+    const MLAS_GEMM_S8S8_KERNEL_AVX2::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasPlatform.GemmU8U8Kernel(A, B, C, PackedCountK, CountM, CountN, ldc,
+        RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchAvx2 = {
+    MlasGemmU8X8Operation<MLAS_GEMM_S8S8_KERNEL_AVX2>,
+    MlasGemmU8X8PackedOperation<MLAS_GEMM_S8S8_KERNEL_AVX2>,
+    MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_AVX2>,
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedStrides.K,
+};
+
+//
+// The VNNI instructions multiply unsigned by signed bytes, so signed matrix A
+// data is converted to unsigned data by flipping the sign bit as the panel is
+// packed. The zero point offset of matrix A is biased to match, which is
+// absorbed by the row and column sum adjustments that are always applied. This
+// shares the U8S8 kernels and the U8S8 packed format of matrix B.
+//
+// N.B. This kernel type is only selected when VNNI is available. The AVX2 and
+// AVX512 core U8S8 kernels use VPMADDUBSW, which saturates the intermediate
+// 16-bit sums for the full range of flipped matrix A values.
+//
+
+struct MLAS_GEMM_S8S8_KERNEL_VNNI
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef int8_t OffsetAType;
+    typedef int8_t OffsetBType;
+
+    static constexpr size_t PackedK = 4;
+    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{24, 256, 128};
+    static constexpr MLAS_GEMM_U8X8_STRIDES PackedStrides{48, 256, 384};
+};
+
+constexpr size_t MLAS_GEMM_S8S8_KERNEL_VNNI::PackedK;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_S8S8_KERNEL_VNNI::Strides;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_S8S8_KERNEL_VNNI::PackedStrides;
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointA<MLAS_GEMM_S8S8_KERNEL_VNNI>(
+    int32_t ZeroPointA
+    )
+{
+    return ZeroPointA + 0x80;
+}
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointB<MLAS_GEMM_S8S8_KERNEL_VNNI>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    return MlasGemmU8X8FixupZeroPointB<MLAS_GEMM_U8S8_KERNEL_AVX2>(ZeroPointB, BIsSigned);
+}
+
+template<>
+void
+MlasGemmU8X8CopyPackA<MLAS_GEMM_S8S8_KERNEL_VNNI>(
+    MLAS_GEMM_S8S8_KERNEL_VNNI::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    const size_t AlignedCountK =
+        (CountK + MLAS_GEMM_S8S8_KERNEL_VNNI::PackedK - 1) & ~(MLAS_GEMM_S8S8_KERNEL_VNNI::PackedK - 1);
+    const __m128i BitFlipVector = _mm_set1_epi32(0x80808080);
+    const __m128i ZeroVector = _mm_setzero_si128();
+
+    //
+    // Process a single row of matrix A in a loop.
+    //
+    // The buffer is packed in the same format as MlasGemmU8S8CopyPackAAvx2:
+    // each row is stored contiguously and zero padded to a multiple of PackedK.
+    //
+
+    while (CountM-- > 0) {
+
+        const uint8_t* a = A;
+        uint8_t* d = D;
+        size_t k = CountK;
+        __m128i RowSums = ZeroVector;
+
+        while (k >= 16) {
+
+            __m128i Bytes = _mm_xor_si128(_mm_loadu_si128((const __m128i*)a), BitFlipVector);
+            _mm_storeu_si128((__m128i*)d, Bytes);
+
+            RowSums = _mm_add_epi32(RowSums, _mm_sad_epu8(Bytes, ZeroVector));
+
+            a += 16;
+            d += 16;
+            k -= 16;
+        }
+
+        RowSums = _mm_add_epi32(RowSums, _mm_shuffle_epi32(RowSums, _MM_SHUFFLE(1, 0, 3, 2)));
+        int32_t RowSum = _mm_cvtsi128_si32(RowSums);
+
+        while (k > 0) {
+
+            uint8_t a0 = *a++ ^ 0x80;
+            *d++ = a0;
+
+            RowSum += a0;
+            k -= 1;
+        }
+
+        for (size_t kk = CountK; kk < AlignedCountK; kk++) {
+            *d++ = 0;
+        }
+
+        *RowSumBuffer++ = RowSum;
+
+        A += lda;
+        D += AlignedCountK;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_VNNI>(
+    MLAS_GEMM_S8S8_KERNEL_VNNI::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MlasGemmU8S8CopyPackBAvx2(D, B, ldb, CountN, CountK, ColumnSumBuffer, BIsSigned);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmU8X8Kernel<MLAS_GEMM_S8S8_KERNEL_VNNI>(
+    const MLAS_GEMM_S8S8_KERNEL_VNNI::PackedAType* A,
+    const MLAS_GEMM_S8S8_KERNEL_VNNI::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasPlatform.GemmU8S8Kernel(A, B, C, PackedCountK, CountM, CountN, ldc,
+        RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchVnni = {
+    MlasGemmU8X8Operation<MLAS_GEMM_S8S8_KERNEL_VNNI>,
+    MlasGemmU8X8PackedOperation<MLAS_GEMM_S8S8_KERNEL_VNNI>,
+    MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_VNNI>,
+    MLAS_GEMM_S8S8_KERNEL_VNNI::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_VNNI::PackedStrides.K,
+};
+
 #endif
 
 #if defined(MLAS_NEON64_INTRINSICS) || (defined(MLAS_NEON32_INTRINSICS) && !defined(_MSC_VER))
@@ -1863,6 +2741,7 @@ struct MLAS_GEMM_U8X8_KERNEL_NEON
 {
     typedef uint8_t PackedAType;
     typedef uint8_t PackedBType;
+    typedef uint8_t OffsetAType;
     typedef uint8_t OffsetBType;
 
     static constexpr size_t PackedK = 4;
@@ -2357,6 +3236,7 @@ struct MLAS_GEMM_U8X8_KERNEL_UDOT
 {
     typedef uint8_t PackedAType;
     typedef uint8_t PackedBType;
+    typedef uint8_t OffsetAType;
     typedef uint8_t OffsetBType;
 
     static constexpr size_t PackedK = 8;
@@ -2898,12 +3778,198 @@ const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchUdot = {
     MLAS_GEMM_U8X8_KERNEL_UDOT::PackedStrides.K,
 };
 
+//
+// Define the prototypes of the NEON SDOT routines written in assembly.
+//
+
+extern "C" {
+
+    size_t
+    MLASCALL
+    MlasGemmS8S8KernelSdot(
+        const uint8_t* A,
+        const uint8_t* B,
+        int32_t* C,
+        size_t PackedCountK,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc,
+        const int32_t* RowSumVector,
+        const int32_t* ColumnSumVector,
+        const int32_t* ZeroPointB,
+        bool ZeroMode
+        );
+}
+
+//
+// The SDOT kernel uses the same packed layouts as the UDOT kernel, but the
+// packed buffers hold signed data. Unsigned matrix B data is converted to
+// signed data in order to share a common kernel.
+//
+
+struct MLAS_GEMM_S8S8_KERNEL_SDOT
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef int8_t OffsetAType;
+    typedef int8_t OffsetBType;
+
+    static constexpr size_t PackedK = 8;
+    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{24, 128, 256};
+    static constexpr MLAS_GEMM_U8X8_STRIDES PackedStrides{24, 128, 384};
+};
+
+constexpr size_t MLAS_GEMM_S8S8_KERNEL_SDOT::PackedK;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_S8S8_KERNEL_SDOT::Strides;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_S8S8_KERNEL_SDOT::PackedStrides;
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointB<MLAS_GEMM_S8S8_KERNEL_SDOT>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    if (!BIsSigned) {
+        ZeroPointB = MLAS_GEMM_S8S8_KERNEL_SDOT::OffsetBType(ZeroPointB ^ 0x80);
+    }
+
+    return ZeroPointB;
+}
+
+template<>
+void
+MlasGemmU8X8CopyPackA<MLAS_GEMM_S8S8_KERNEL_SDOT>(
+    MLAS_GEMM_S8S8_KERNEL_SDOT::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    //
+    // The interleaving of matrix A is independent of the data type, so reuse
+    // the UDOT packing routine and then replace its unsigned row sums.
+    //
+
+    MlasGemmU8X8CopyPackA<MLAS_GEMM_U8X8_KERNEL_UDOT>(D, A, lda, CountM, CountK, RowSumBuffer);
+
+    while (CountM-- > 0) {
+
+        const int8_t* a = reinterpret_cast<const int8_t*>(A);
+        size_t k = CountK;
+        int32x4_t RowSums = vmovq_n_s32(0);
+
+        while (k >= 16) {
+
+            RowSums = vpadalq_s16(RowSums, vpaddlq_s8(vld1q_s8(a)));
+
+            a += 16;
+            k -= 16;
+        }
+
+        RowSums = vpaddq_s32(RowSums, RowSums);
+        RowSums = vpaddq_s32(RowSums, RowSums);
+
+        int32_t RowSum = vgetq_lane_s32(RowSums, 0);
+
+        while (k > 0) {
+            RowSum += *a++;
+            k -= 1;
+        }
+
+        *RowSumBuffer++ = RowSum;
+
+        A += lda;
+    }
+}
+
+template<>
+void
+MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_SDOT>(
+    MLAS_GEMM_S8S8_KERNEL_SDOT::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    //
+    // The UDOT packing routine flips the sign bit of the requested format, so
+    // request the opposite format to produce a signed packed buffer. The
+    // unsigned column sums are then replaced by summing the packed buffer,
+    // which is laid out as blocks of eight columns where each pair of 16 byte
+    // vectors holds four rows and the padding is zero filled.
+    //
+
+    MlasGemmU8X8CopyPackB<MLAS_GEMM_U8X8_KERNEL_UDOT>(D, B, ldb, CountN, CountK,
+        ColumnSumBuffer, !BIsSigned);
+
+    const size_t AlignedCountK =
+        (CountK + MLAS_GEMM_S8S8_KERNEL_SDOT::PackedK - 1) & ~(MLAS_GEMM_S8S8_KERNEL_SDOT::PackedK - 1);
+    const int8_t* d = reinterpret_cast<const int8_t*>(D);
+
+    for (size_t n = 0; n < CountN; n += 8) {
+
+        int32x4_t ColumnSums[2];
+
+        ColumnSums[0] = vmovq_n_s32(0);
+        ColumnSums[1] = vmovq_n_s32(0);
+
+        for (size_t k = 0; k < AlignedCountK; k += 4) {
+
+            ColumnSums[0] = vpadalq_s16(ColumnSums[0], vpaddlq_s8(vld1q_s8(&d[0])));
+            ColumnSums[1] = vpadalq_s16(ColumnSums[1], vpaddlq_s8(vld1q_s8(&d[16])));
+
+            d += 32;
+        }
+
+        vst1q_s32(&ColumnSumBuffer[0], ColumnSums[0]);
+        vst1q_s32(&ColumnSumBuffer[4], ColumnSums[1]);
+        ColumnSumBuffer += 8;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmU8X8Kernel<MLAS_GEMM_S8S8_KERNEL_SDOT>(
+    const MLAS_GEMM_S8S8_KERNEL_SDOT::PackedAType* A,
+    const MLAS_GEMM_S8S8_KERNEL_SDOT::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasGemmS8S8KernelSdot(A, B, C, PackedCountK, CountM, CountN, ldc,
+        RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchSdot = {
+    MlasGemmU8X8Operation<MLAS_GEMM_S8S8_KERNEL_SDOT>,
+    MlasGemmU8X8PackedOperation<MLAS_GEMM_S8S8_KERNEL_SDOT>,
+    MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_SDOT>,
+    MLAS_GEMM_S8S8_KERNEL_SDOT::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_SDOT::PackedStrides.K,
+};
+
 #endif
 
 struct MLAS_GEMM_U8X8_KERNEL_DEFAULT
 {
     typedef uint8_t PackedAType;
     typedef uint8_t PackedBType;
+    typedef uint8_t OffsetAType;
     typedef uint8_t OffsetBType;
 
     static constexpr size_t PackedK = 4;
@@ -3082,6 +4148,131 @@ const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchDefault = {
     0,
 };
 
+//
+// The portable signed matrix A implementation converts matrix A to unsigned
+// data as the panel is packed and then shares the portable U8X8 kernel.
+//
+
+struct MLAS_GEMM_S8S8_KERNEL_DEFAULT
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef int8_t OffsetAType;
+    typedef uint8_t OffsetBType;
+
+    static constexpr size_t PackedK = 4;
+    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{16, 128, 128};
+    static constexpr MLAS_GEMM_U8X8_STRIDES PackedStrides{16, 128, 128};
+};
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointA<MLAS_GEMM_S8S8_KERNEL_DEFAULT>(
+    int32_t ZeroPointA
+    )
+{
+    return ZeroPointA + 0x80;
+}
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmU8X8FixupZeroPointB<MLAS_GEMM_S8S8_KERNEL_DEFAULT>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    return MlasGemmU8X8FixupZeroPointB<MLAS_GEMM_U8X8_KERNEL_DEFAULT>(ZeroPointB, BIsSigned);
+}
+
+template<>
+void
+MlasGemmU8X8CopyPackA<MLAS_GEMM_S8S8_KERNEL_DEFAULT>(
+    MLAS_GEMM_S8S8_KERNEL_DEFAULT::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    const size_t AlignedCountK =
+        (CountK + MLAS_GEMM_S8S8_KERNEL_DEFAULT::PackedK - 1) & ~(MLAS_GEMM_S8S8_KERNEL_DEFAULT::PackedK - 1);
+
+    //
+    // Process a single row of matrix A in a loop.
+    //
+
+    while (CountM-- > 0) {
+
+        int32_t RowSum = 0;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            uint8_t a0 = A[k] ^ 0x80;
+            D[k] = a0;
+
+            RowSum += a0;
+        }
+
+        for (size_t k = CountK; k < AlignedCountK; k++) {
+            D[k] = 0;
+        }
+
+        *RowSumBuffer++ = RowSum;
+
+        A += lda;
+        D += AlignedCountK;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_DEFAULT>(
+    MLAS_GEMM_S8S8_KERNEL_DEFAULT::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MlasGemmU8X8CopyPackB<MLAS_GEMM_U8X8_KERNEL_DEFAULT>(D, B, ldb, CountN, CountK,
+        ColumnSumBuffer, BIsSigned);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmU8X8Kernel<MLAS_GEMM_S8S8_KERNEL_DEFAULT>(
+    const MLAS_GEMM_S8S8_KERNEL_DEFAULT::PackedAType* A,
+    const MLAS_GEMM_S8S8_KERNEL_DEFAULT::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasGemmU8X8Kernel<MLAS_GEMM_U8X8_KERNEL_DEFAULT>(A, B, C, PackedCountK, CountM,
+        CountN, ldc, RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchDefault = {
+    MlasGemmU8X8Operation<MLAS_GEMM_S8S8_KERNEL_DEFAULT>,
+    nullptr,
+    nullptr,
+    MLAS_GEMM_S8S8_KERNEL_DEFAULT::PackedK,
+    0,
+};
+
 
 void
 MlasGemmU8X8Threaded(
@@ -3151,7 +4342,7 @@ Return Value:
     // Dispatch the partitioned operation.
     //
 
-    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(Shape->BIsSigned);
+    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(Shape->AIsSigned, Shape->BIsSigned);
     MLAS_GEMM_U8X8_OPERATION* GemmU8X8Operation;
 
     if (Data->BIsPacked) {
@@ -3280,6 +4471,18 @@ MlasGemmPackBSize(
     size_t K,
     bool BIsSigned
     )
+{
+    return MlasGemmPackBSize(N, K, false, BIsSigned);
+}
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K,
+    bool AIsSigned,
+    bool BIsSigned
+    )
 /*++
 
 Routine Description:
@@ -3293,6 +4496,9 @@ Arguments:
 
     K - Supplies the the number of rows of matrix B.
 
+    AIsSigned - Supplies true if the packed matrix will be multiplied by signed
+        matrix A data, else false if matrix A is unsigned data.
+
     BIsSigned - Supplies true if matrix B is signed data, else false if matrix
         B is unsigned data.
 
@@ -3307,7 +4513,7 @@ Return Value:
     // Retrieve the packing parameters.
     //
 
-    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(BIsSigned);
+    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(AIsSigned, BIsSigned);
 
     size_t PackedK = GemmU8X8Dispatch->PackedK;
     size_t PackedStrideK = GemmU8X8Dispatch->PackedStrideK;
@@ -3343,6 +4549,21 @@ MlasGemmPackB(
     bool BIsSigned,
     void* PackedB
     )
+{
+    MlasGemmPackB(N, K, B, ldb, false, BIsSigned, PackedB);
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool AIsSigned,
+    bool BIsSigned,
+    void* PackedB
+    )
 /*++
 
 Routine Description:
@@ -3360,6 +4581,9 @@ Arguments:
 
     ldb - Supplies the first dimension of matrix B.
 
+    AIsSigned - Supplies true if the packed matrix will be multiplied by signed
+        matrix A data, else false if matrix A is unsigned data.
+
     BIsSigned - Supplies true if matrix B is signed data, else false if matrix
         B is unsigned data.
 
@@ -3375,7 +4599,7 @@ Return Value:
     // Retrieve the packing parameters.
     //
 
-    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(BIsSigned);
+    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(AIsSigned, BIsSigned);
 
     size_t PackedK = GemmU8X8Dispatch->PackedK;
     size_t PackedStrideK = GemmU8X8Dispatch->PackedStrideK;
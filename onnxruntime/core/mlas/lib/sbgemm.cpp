@@ -0,0 +1,546 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation that rounds the operands to bfloat16 and accumulates the
+    products in single precision (SBGEMM).
+
+    Matrix B is converted once by MlasSBGemmPackB to panels of
+    MLAS_SBGEMM_PANELN columns. Each panel stores the rows of B as pairs of
+    adjacent K elements for every column, which is the operand layout of both
+    the AVX512_BF16 dot product instruction and the AMX tile multiply
+    instruction. The K dimension is padded with zeros to a multiple of
+    MLAS_SBGEMM_ALIGNK so that the AMX kernel only sees complete tiles.
+
+    Matrix A is converted to bfloat16 per block of MLAS_SBGEMM_STRIDEM rows
+    while executing the operation.
+
+--*/
+
+#include "mlasi.h"
+#include <memory>
+
+MLAS_FORCEINLINE
+size_t
+MlasSBGemmAlignK(
+    size_t K
+    )
+{
+    return (K + MLAS_SBGEMM_ALIGNK - 1) & ~size_t(MLAS_SBGEMM_ALIGNK - 1);
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBfloat16(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision value to bfloat16 using round to
+    nearest even.
+
+Arguments:
+
+    Value - Supplies the single precision value.
+
+Return Value:
+
+    Returns the bfloat16 value.
+
+--*/
+{
+    uint32_t Bits = MlasBitsOfFp32(Value);
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+
+        //
+        // Keep NaN values as quiet NaN values.
+        //
+
+        return uint16_t((Bits >> 16) | 0x0040);
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+
+    return uint16_t(Bits >> 16);
+}
+
+#if defined(MLAS_TARGET_AMD64)
+
+//
+// Define the parameters to execute segments of a SBGEMM operation on worker
+// threads.
+//
+
+struct MLAS_SBGEMM_WORK_BLOCK {
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+    CBLAS_TRANSPOSE TransA;
+    size_t M;
+    size_t N;
+    size_t K;
+    const MLAS_SGEMM_DATA_PARAMS* Data;
+};
+
+void
+MlasSBGemmCopyPackA(
+    uint16_t* D,
+    const float* A,
+    size_t lda,
+    CBLAS_TRANSPOSE TransA,
+    size_t CountM,
+    size_t CountK,
+    size_t CountKPadded
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a block of op(A) to bfloat16 and stores each of the
+    CountM rows contiguously with a stride of CountKPadded elements. Columns
+    beyond CountK are zero filled.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer.
+
+    A - Supplies the address of the first element of the block of op(A).
+
+    lda - Supplies the first dimension of matrix A.
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    CountM - Supplies the number of rows of op(A) to copy.
+
+    CountK - Supplies the number of columns of op(A) to copy.
+
+    CountKPadded - Supplies the padded number of columns of the destination.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t m = 0; m < CountM; m++) {
+
+        if (TransA == CblasNoTrans) {
+            for (size_t k = 0; k < CountK; k++) {
+                D[k] = MlasFloatToBfloat16(A[m * lda + k]);
+            }
+        } else {
+            for (size_t k = 0; k < CountK; k++) {
+                D[k] = MlasFloatToBfloat16(A[k * lda + m]);
+            }
+        }
+
+        std::fill_n(D + CountK, CountKPadded - CountK, uint16_t(0));
+
+        D += CountKPadded;
+    }
+}
+
+void
+MlasSBGemmOperation(
+    const MLAS_SBGEMM_WORK_BLOCK* WorkBlock,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SBGEMM operation for a segment of the output
+    matrix.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    Data - Supplies the matrices data parameters.
+
+    RangeStartM - Supplies the starting row index to output.
+
+    RangeCountM - Supplies the number of rows to output.
+
+    RangeStartN - Supplies the starting column index to output. The index is
+        a multiple of MLAS_SBGEMM_PANELN.
+
+    RangeCountN - Supplies the number of columns to output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t K = WorkBlock->K;
+    const size_t KPadded = MlasSBGemmAlignK(K);
+
+    //
+    // The kernels may read the A buffer in blocks of 16 rows, so allocate and
+    // zero fill a full stride of rows.
+    //
+
+    std::unique_ptr<uint16_t[]> PanelA(new uint16_t[MLAS_SBGEMM_STRIDEM * KPadded]());
+
+    const uint16_t* PackedB = reinterpret_cast<const uint16_t*>(Data->B) + RangeStartN * KPadded;
+
+    size_t CountM;
+
+    for (size_t m = 0; m < RangeCountM; m += CountM) {
+
+        CountM = std::min(RangeCountM - m, size_t(MLAS_SBGEMM_STRIDEM));
+
+        const size_t StartM = RangeStartM + m;
+
+        const float* a = (WorkBlock->TransA == CblasNoTrans) ?
+            Data->A + StartM * Data->lda : Data->A + StartM;
+
+        MlasSBGemmCopyPackA(PanelA.get(), a, Data->lda, WorkBlock->TransA, CountM, K, KPadded);
+
+        MlasPlatform.SBGemmKernel(PanelA.get(), PackedB, Data->C + StartM * Data->ldc + RangeStartN,
+            KPadded, CountM, RangeCountN, Data->ldc, Data->alpha, Data->beta);
+    }
+}
+
+void
+MlasSBGemmThreaded(
+    const MLAS_SBGEMM_WORK_BLOCK* WorkBlock,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    SBGEMM operation.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadsPerGemm = WorkBlock->ThreadCountM * WorkBlock->ThreadCountN;
+
+    const ptrdiff_t GemmIdx = ThreadId / ThreadsPerGemm;
+    ThreadId = ThreadId % ThreadsPerGemm;
+
+    const ptrdiff_t ThreadIdM = ThreadId / WorkBlock->ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % WorkBlock->ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, WorkBlock->ThreadCountM, WorkBlock->M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t N = WorkBlock->N;
+
+    const size_t BlockedN = (N + MLAS_SBGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SBGEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, WorkBlock->ThreadCountN, BlockedN,
+        &RangeStartN, &RangeCountN);
+
+    RangeStartN *= MLAS_SBGEMM_STRIDEN_THREAD_ALIGN;
+    RangeCountN *= MLAS_SBGEMM_STRIDEN_THREAD_ALIGN;
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    if (RangeCountM == 0 || RangeCountN == 0) {
+        return;
+    }
+
+    MlasSBGemmOperation(WorkBlock, &WorkBlock->Data[GemmIdx], RangeStartM, RangeCountM,
+        RangeStartN, RangeCountN);
+}
+
+#endif
+
+bool
+MLASCALL
+MlasSBGemmIsSupported(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether the SBGEMM operation is supported on this
+    platform.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns true if a bfloat16 kernel is available, else false.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    return MlasPlatform.SBGemmKernel != nullptr;
+#else
+    return false;
+#endif
+}
+
+size_t
+MLASCALL
+MlasSBGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer, or zero if the
+    operation is not supported.
+
+--*/
+{
+    if (!MlasSBGemmIsSupported()) {
+        return 0;
+    }
+
+    const size_t AlignedN = (N + MLAS_SBGEMM_PANELN - 1) & ~size_t(MLAS_SBGEMM_PANELN - 1);
+
+    return AlignedN * MlasSBGemmAlignK(K) * sizeof(uint16_t);
+}
+
+void
+MLASCALL
+MlasSBGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine converts matrix B to bfloat16 and packs the result to a
+    buffer of panels. Each panel stores pairs of adjacent rows for the
+    MLAS_SBGEMM_PANELN columns of the panel. Rows beyond K and columns beyond
+    N are zero filled.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t KPadded = MlasSBGemmAlignK(K);
+
+    uint16_t* D = reinterpret_cast<uint16_t*>(PackedB);
+
+    for (size_t n = 0; n < N; n += MLAS_SBGEMM_PANELN) {
+
+        const size_t CountN = std::min(N - n, size_t(MLAS_SBGEMM_PANELN));
+
+        for (size_t k = 0; k < KPadded; k += 2) {
+
+            for (size_t c = 0; c < MLAS_SBGEMM_PANELN; c++) {
+
+                for (size_t kk = 0; kk < 2; kk++) {
+
+                    float Value = 0.0f;
+
+                    if (c < CountN && k + kk < K) {
+                        Value = (TransB == CblasNoTrans) ?
+                            B[(k + kk) * ldb + n + c] : B[(n + c) * ldb + k + kk];
+                    }
+
+                    D[c * 2 + kk] = MlasFloatToBfloat16(Value);
+                }
+            }
+
+            D += MLAS_SBGEMM_PANELN * 2;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSBGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the batched SBGEMM operation.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies the array of matrices data parameters. The B member
+        supplies the buffer packed by MlasSBGemmPackB.
+
+    BatchSize - Supplies the number of multiplications in this batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    MLAS_SBGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.Data = Data;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // SBGEMM operation. Small requests should run using the single threaded
+    // path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SBGEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SBGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MlasPlatform.MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads.
+    //
+    // N.B. Currently, the operation is segmented as a 1D partition, which
+    // works okay for operations involving skinny matrices.
+    //
+
+    if (N > M) {
+
+        const size_t BlockedN = (N + MLAS_SBGEMM_STRIDEN_THREAD_ALIGN - 1) /
+            MLAS_SBGEMM_STRIDEN_THREAD_ALIGN;
+
+        if (size_t(TargetThreadCount) > BlockedN) {
+            TargetThreadCount = ptrdiff_t(BlockedN);
+        }
+
+        WorkBlock.ThreadCountM = 1;
+        WorkBlock.ThreadCountN = TargetThreadCount;
+
+    } else {
+
+        if (size_t(TargetThreadCount) > M) {
+            TargetThreadCount = ptrdiff_t(M);
+        }
+
+        WorkBlock.ThreadCountM = TargetThreadCount;
+        WorkBlock.ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount * ptrdiff_t(BatchSize), [&](ptrdiff_t tid) {
+        MlasSBGemmThreaded(&WorkBlock, tid);
+    });
+
+#else
+
+    MLAS_UNREFERENCED_PARAMETER(TransA);
+    MLAS_UNREFERENCED_PARAMETER(M);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(Data);
+    MLAS_UNREFERENCED_PARAMETER(BatchSize);
+    MLAS_UNREFERENCED_PARAMETER(ThreadPool);
+
+#endif
+}
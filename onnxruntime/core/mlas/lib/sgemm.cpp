@@ -17,6 +17,10 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <chrono>
+#include <memory>
+#include <vector>
+
 //
 // Define the number of rows from matrix A to transpose to a local buffer.
 //
@@ -1217,13 +1221,31 @@ Return Value:
     //
     // Compute the strides to step through slices of the input matrices.
     //
+    // Start from the tuned strides, falling back to the defaults if they do
+    // not fit the B panel, e.g. when read while the parameters are being
+    // changed. The A panel used for transposing only holds the default K
+    // stride, so trade a larger K stride for a larger N stride in that case.
+    //
     // Expand the N stride if K is small or expand the K stride if N is small
     // for better utilization of the B panel. Avoid changing the K stride if
     // the A panel needs to be used for transposing.
     //
 
-    size_t StrideN = MLAS_SGEMM_STRIDEN;
-    size_t StrideK = MLAS_SGEMM_STRIDEK;
+    size_t StrideN = MlasPlatform.SgemmStrideN;
+    size_t StrideK = MlasPlatform.SgemmStrideK;
+
+    if (StrideN * StrideK > MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK) {
+        StrideN = MLAS_SGEMM_STRIDEN;
+        StrideK = MLAS_SGEMM_STRIDEK;
+    }
+
+    if (TransA != CblasNoTrans) {
+
+        while (StrideK > MLAS_SGEMM_STRIDEK) {
+            StrideN *= 2;
+            StrideK /= 2;
+        }
+    }
 
     if (N >= K) {
 
@@ -1556,30 +1578,163 @@ Return Value:
 }
 
 void
-MLASCALL
-MlasGemmBatch(
-    CBLAS_TRANSPOSE TransA,
-    CBLAS_TRANSPOSE TransB,
-    size_t M,
-    size_t N,
-    size_t K,
-    const MLAS_SGEMM_DATA_PARAMS* Data,
-    size_t BatchSize,
+MlasSgemmSplitK(
+    const ptrdiff_t ThreadCountN,
+    const ptrdiff_t ThreadCountK,
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* DataParams,
     MLAS_THREADPOOL* ThreadPool
     )
+/*++
+
+Routine Description:
+
+    This routine executes a SGEMM operation with a small M by segmenting it
+    along both the N and K dimensions. This keeps more threads busy when the
+    output has too few columns to split, such as for the matrix/vector
+    products of batch one inference with a large K.
+
+    The first K segment accumulates into matrix C, applying beta. The other
+    segments compute their products into a temporary buffer, which is then
+    added to matrix C.
+
+Arguments:
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    ThreadCountK - Supplies the total thread partition on the K dimension.
+
+    TransA - Supplies the transpose operation on A matrix
+
+    TransB - Supplies the transpose operation on B matrix
+
+    M, N, K - Supplies the shape of the multiplication
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
 {
+    const size_t BlockedK = (K + MLAS_SGEMM_PACKED_STRIDEK - 1) /
+        MLAS_SGEMM_PACKED_STRIDEK;
+    const size_t AlignedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    std::unique_ptr<float[]> PartialC(new float[size_t(ThreadCountK - 1) * M * N]);
+    float* PartialBuffer = PartialC.get();
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCountN * ThreadCountK, [&](ptrdiff_t tid)
+    {
+        const ptrdiff_t ThreadIdK = tid / ThreadCountN;
+        const ptrdiff_t ThreadIdN = tid % ThreadCountN;
+
+        size_t RangeStartK;
+        size_t RangeCountK;
+
+        MlasPartitionWork(ThreadIdK, ThreadCountK, BlockedK, &RangeStartK,
+            &RangeCountK);
+
+        RangeStartK *= MLAS_SGEMM_PACKED_STRIDEK;
+        RangeCountK *= MLAS_SGEMM_PACKED_STRIDEK;
+
+        RangeCountK = std::min(K - RangeStartK, RangeCountK);
+
+        MLAS_SGEMM_DATA_PARAMS Params = *DataParams;
+
+        Params.A += RangeStartK * ((TransA == CblasNoTrans) ? 1 : Params.lda);
+
+        if (Params.BIsPacked) {
+            Params.B += RangeStartK * AlignedN;
+        } else {
+            Params.B += RangeStartK * ((TransB == CblasNoTrans) ? Params.ldb : 1);
+        }
+
+        if (ThreadIdK > 0) {
+            Params.C = PartialBuffer + size_t(ThreadIdK - 1) * M * N;
+            Params.ldc = N;
+            Params.beta = 0.0f;
+        }
+
+        MlasSgemmThreaded(1, ThreadCountN, TransA, TransB, M, N, RangeCountK,
+            &Params, ThreadIdN);
+    });
 
     //
-    // Compute the number of target threads given the complexity of the SGEMM
-    // operation. Small requests should run using the single threaded path.
+    // Reduce the products of the other K segments into matrix C.
     //
 
-    const double Complexity = double(M) * double(N) * double(K);
+    MlasTrySimpleParallel(ThreadPool, ThreadCountN, [&](ptrdiff_t tid)
+    {
+        size_t RangeStartN;
+        size_t RangeCountN;
+
+        MlasPartitionWork(tid, ThreadCountN, AlignedN / MLAS_SGEMM_STRIDEN_THREAD_ALIGN,
+            &RangeStartN, &RangeCountN);
+
+        RangeStartN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+        RangeCountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+        RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+        for (size_t m = 0; m < M; m++) {
+
+            float* c = DataParams->C + m * DataParams->ldc + RangeStartN;
+            const float* p = PartialBuffer + m * N + RangeStartN;
+
+            for (ptrdiff_t k = 1; k < ThreadCountK; k++) {
+
+                for (size_t n = 0; n < RangeCountN; n++) {
+                    c[n] += p[n];
+                }
+
+                p += M * N;
+            }
+        }
+    });
+}
+
+ptrdiff_t
+MlasSgemmTargetThreadCount(
+    double Complexity,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of target threads given the complexity
+    of a SGEMM operation. Small requests should run using the single threaded
+    path.
+
+Arguments:
+
+    Complexity - Supplies the number of multiply/accumulate operations.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns the number of target threads.
 
+--*/
+{
     ptrdiff_t TargetThreadCount;
 
-    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
-        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    const double ThreadComplexity = double(MlasPlatform.SgemmThreadComplexity);
+
+    if (Complexity < ThreadComplexity * MlasPlatform.MaximumThreadCount) {
+        TargetThreadCount = ptrdiff_t(Complexity / ThreadComplexity) + 1;
     } else {
         TargetThreadCount = MlasPlatform.MaximumThreadCount;
     }
@@ -1590,17 +1745,44 @@ MlasGemmBatch(
         TargetThreadCount = MaximumThreadCount;
     }
 
-    //
-    // Segment the operation across multiple threads.
-    //
-    // N.B. Currently, the operation is segmented as a 1D partition, which
-    // works okay for operations involving skinny matrices.
-    //
+    return TargetThreadCount;
+}
 
-    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
-    ptrdiff_t ThreadCountM;
-    ptrdiff_t ThreadCountN;
+ptrdiff_t
+MlasSgemmPartitionThreads(
+    size_t M,
+    size_t N,
+    ptrdiff_t ThreadsPerGemm,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine segments a single SGEMM operation across the requested
+    number of threads.
+
+    N.B. Currently, the operation is segmented as a 1D partition, which
+    works okay for operations involving skinny matrices.
+
+Arguments:
 
+    M, N - Supplies the shape of the output matrix.
+
+    ThreadsPerGemm - Supplies the requested number of threads.
+
+    ThreadCountM - Receives the thread partition on the M dimension.
+
+    ThreadCountN - Receives the thread partition on the N dimension.
+
+Return Value:
+
+    Returns the number of threads used by the partition, which may be less
+    than the requested number for small matrices.
+
+--*/
+{
     if (N > M) {
 
         const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
@@ -1610,8 +1792,8 @@ MlasGemmBatch(
             ThreadsPerGemm = ptrdiff_t(BlockedN);
         }
 
-        ThreadCountM = 1;
-        ThreadCountN = ThreadsPerGemm;
+        *ThreadCountM = 1;
+        *ThreadCountN = ThreadsPerGemm;
 
     } else {
 
@@ -1619,8 +1801,64 @@ MlasGemmBatch(
             ThreadsPerGemm = ptrdiff_t(M);
         }
 
-        ThreadCountM = ThreadsPerGemm;
-        ThreadCountN = 1;
+        *ThreadCountM = ThreadsPerGemm;
+        *ThreadCountN = 1;
+    }
+
+    return ThreadsPerGemm;
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+
+    //
+    // Compute the number of target threads given the complexity of the SGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount = MlasSgemmTargetThreadCount(Complexity, ThreadPool);
+
+    //
+    // Segment the operation across multiple threads.
+    //
+
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    const ptrdiff_t ThreadsPerGemm = MlasSgemmPartitionThreads(M, N,
+        (TargetThreadCount + BatchSize - 1) / BatchSize, &ThreadCountM, &ThreadCountN);
+
+    //
+    // Segment a single operation with a small M along the K dimension as well
+    // if the N dimension is too narrow to use the target number of threads.
+    //
+
+    if (BatchSize == 1 && M <= MLAS_SGEMM_SPLITK_MAXIMUM_M && ThreadCountM == 1) {
+
+        const size_t BlockedK = (K + MLAS_SGEMM_PACKED_STRIDEK - 1) /
+            MLAS_SGEMM_PACKED_STRIDEK;
+
+        const ptrdiff_t ThreadCountK = std::min(TargetThreadCount / ThreadsPerGemm,
+            ptrdiff_t(BlockedK));
+
+        if (ThreadCountK > 1) {
+            MlasSgemmSplitK(ThreadCountN, ThreadCountK, TransA, TransB, M, N, K,
+                Data, ThreadPool);
+            return;
+        }
     }
 
     MlasTrySimpleParallel(ThreadPool, 
@@ -1634,6 +1872,129 @@ MlasGemmBatch(
     });
 }
 
+void
+MLASCALL
+MlasGemmGrouped(
+    const MLAS_SGEMM_GROUPED_PROBLEM* Problems,
+    size_t ProblemCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a group of single precision matrix/matrix
+    multiply operations with independent shapes in one thread pool round.
+
+Arguments:
+
+    Problems - Supplies the array of problems.
+
+    ProblemCount - Supplies the number of problems.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    double TotalComplexity = 0.0;
+
+    for (size_t i = 0; i < ProblemCount; i++) {
+        const MLAS_SGEMM_GROUPED_PROBLEM& Problem = Problems[i];
+        TotalComplexity += double(Problem.M) * double(Problem.N) * double(Problem.K);
+    }
+
+    const ptrdiff_t TargetThreadCount = MlasSgemmTargetThreadCount(TotalComplexity, ThreadPool);
+
+    //
+    // Problems with an empty output are skipped. Problems with K == 0 still
+    // scale the output by beta, so they get a nominal complexity to be
+    // assigned to a thread.
+    //
+
+    auto ProblemComplexity = [](const MLAS_SGEMM_GROUPED_PROBLEM& Problem) {
+        if (Problem.M == 0 || Problem.N == 0) {
+            return 0.0;
+        }
+        return std::max(double(Problem.M) * double(Problem.N) * double(Problem.K), 1.0);
+    };
+
+    if (size_t(TargetThreadCount) <= ProblemCount) {
+
+        //
+        // Assign whole problems to threads. Each thread runs a contiguous
+        // range of problems of about the same total complexity.
+        //
+
+        double Complexity = 0.0;
+        for (size_t i = 0; i < ProblemCount; i++) {
+            Complexity += ProblemComplexity(Problems[i]);
+        }
+
+        if (Complexity == 0.0) {
+            return;
+        }
+
+        MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [=](ptrdiff_t tid) {
+            double Prefix = 0.0;
+            for (size_t i = 0; i < ProblemCount; i++) {
+                const MLAS_SGEMM_GROUPED_PROBLEM& Problem = Problems[i];
+                const double Current = ProblemComplexity(Problem);
+                if (Current == 0.0) {
+                    continue;
+                }
+                const ptrdiff_t Owner = std::min(TargetThreadCount - 1,
+                    ptrdiff_t((Prefix + Current / 2) * double(TargetThreadCount) / Complexity));
+                Prefix += Current;
+                if (Owner == tid) {
+                    MlasSgemmThreaded(1, 1, Problem.TransA, Problem.TransB,
+                        Problem.M, Problem.N, Problem.K, &Problem.Data, 0);
+                } else if (Owner > tid) {
+                    break;
+                }
+            }
+        });
+
+        return;
+    }
+
+    //
+    // Split each problem across a share of the threads in proportion to its
+    // complexity, then run all the segments in a single round.
+    //
+
+    std::vector<ptrdiff_t> FirstThread(ProblemCount + 1);
+    std::vector<ptrdiff_t> ThreadCountM(ProblemCount);
+    std::vector<ptrdiff_t> ThreadCountN(ProblemCount);
+
+    ptrdiff_t ThreadCount = 0;
+    for (size_t i = 0; i < ProblemCount; i++) {
+        const MLAS_SGEMM_GROUPED_PROBLEM& Problem = Problems[i];
+        FirstThread[i] = ThreadCount;
+        const double Current = ProblemComplexity(Problem);
+        if (Current == 0.0) {
+            continue;
+        }
+        const ptrdiff_t Threads = std::max(ptrdiff_t(1),
+            ptrdiff_t(Current * double(TargetThreadCount) / TotalComplexity + 0.5));
+        ThreadCount += MlasSgemmPartitionThreads(Problem.M, Problem.N, Threads,
+            &ThreadCountM[i], &ThreadCountN[i]);
+    }
+    FirstThread[ProblemCount] = ThreadCount;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        const size_t i = size_t(std::upper_bound(FirstThread.begin(), FirstThread.end(), tid) -
+            FirstThread.begin()) - 1;
+        const MLAS_SGEMM_GROUPED_PROBLEM& Problem = Problems[i];
+        MlasSgemmThreaded(ThreadCountM[i], ThreadCountN[i], Problem.TransA, Problem.TransB,
+            Problem.M, Problem.N, Problem.K, &Problem.Data, tid - FirstThread[i]);
+    });
+}
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
@@ -1734,3 +2095,248 @@ Return Value:
         PackedB = (float*)PackedB + AlignedN * CountK;
     }
 }
+
+void
+MLASCALL
+MlasSgemmGetTuningParameters(
+    MLAS_SGEMM_TUNING_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the SGEMM blocking and threading parameters in use.
+
+Arguments:
+
+    Parameters - Receives the parameters.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    Parameters->StrideN = MlasPlatform.SgemmStrideN;
+    Parameters->StrideK = MlasPlatform.SgemmStrideK;
+    Parameters->ThreadComplexity = MlasPlatform.SgemmThreadComplexity;
+}
+
+bool
+MLASCALL
+MlasSgemmSetTuningParameters(
+    const MLAS_SGEMM_TUNING_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine sets the SGEMM blocking and threading parameters.
+
+Arguments:
+
+    Parameters - Supplies the parameters.
+
+Return Value:
+
+    Returns false if the strides are not powers of two of at least 16 that fit
+    the B panel or the thread complexity is zero.
+
+--*/
+{
+    const size_t StrideN = Parameters->StrideN;
+    const size_t StrideK = Parameters->StrideK;
+
+    auto IsValidStride = [](size_t Stride) {
+        return Stride >= 16 && Stride <= MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK / 16 &&
+            (Stride & (Stride - 1)) == 0;
+    };
+
+    if (!IsValidStride(StrideN) || !IsValidStride(StrideK) ||
+        StrideN * StrideK > MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK ||
+        Parameters->ThreadComplexity == 0) {
+        return false;
+    }
+
+    MlasPlatform.SgemmStrideN = StrideN;
+    MlasPlatform.SgemmStrideK = StrideK;
+    MlasPlatform.SgemmThreadComplexity = Parameters->ThreadComplexity;
+
+    return true;
+}
+
+//
+// Describes a problem that SGEMM tuning benchmarks.
+//
+
+struct MLAS_SGEMM_TUNING_SHAPE {
+    size_t M;
+    size_t N;
+    size_t K;
+    size_t Iterations;
+};
+
+static
+double
+MlasSgemmTuningBenchmark(
+    const MLAS_SGEMM_TUNING_SHAPE* Shapes,
+    size_t ShapeCount,
+    std::vector<float>& A,
+    std::vector<float>& B,
+    std::vector<float>& C,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the time taken by the current SGEMM parameters to run
+    a set of problems, using the best of several repetitions of each problem.
+
+--*/
+{
+    double TotalSeconds = 0.0;
+
+    for (size_t i = 0; i < ShapeCount; i++) {
+
+        const MLAS_SGEMM_TUNING_SHAPE& Shape = Shapes[i];
+
+        A.resize(std::max(A.size(), Shape.M * Shape.K), 0.5f);
+        B.resize(std::max(B.size(), Shape.K * Shape.N), 0.25f);
+        C.resize(std::max(C.size(), Shape.M * Shape.N));
+
+        MLAS_SGEMM_DATA_PARAMS Data;
+        Data.A = A.data();
+        Data.lda = Shape.K;
+        Data.B = B.data();
+        Data.ldb = Shape.N;
+        Data.C = C.data();
+        Data.ldc = Shape.N;
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, Shape.M, Shape.N, Shape.K, Data, ThreadPool);
+
+        double BestSeconds = std::numeric_limits<double>::max();
+
+        for (size_t repetition = 0; repetition < 3; repetition++) {
+
+            const auto Start = std::chrono::steady_clock::now();
+
+            for (size_t iteration = 0; iteration < Shape.Iterations; iteration++) {
+                MlasGemm(CblasNoTrans, CblasNoTrans, Shape.M, Shape.N, Shape.K, Data, ThreadPool);
+            }
+
+            const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+            BestSeconds = std::min(BestSeconds, Elapsed.count());
+        }
+
+        TotalSeconds += BestSeconds;
+    }
+
+    return TotalSeconds;
+}
+
+void
+MLASCALL
+MlasSgemmAutoTune(
+    MLAS_THREADPOOL* ThreadPool,
+    MLAS_SGEMM_TUNING_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine benchmarks the supported SGEMM blocking and threading choices
+    and applies the fastest.
+
+    The strides are tuned single threaded on problems large enough to stream
+    through the caches. The thread complexity is then tuned with the supplied
+    thread pool on smaller problems, where the choice of thread count matters.
+
+Arguments:
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+    Parameters - Receives the parameters that were applied.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static const MLAS_SGEMM_TUNING_SHAPE BlockingShapes[] = {
+        {64, 1024, 1024, 1},
+        {256, 256, 256, 2},
+        {128, 3072, 768, 1},
+        {512, 64, 576, 2},
+    };
+
+    static const MLAS_SGEMM_TUNING_SHAPE ThreadingShapes[] = {
+        {16, 64, 64, 200},
+        {32, 256, 128, 50},
+        {64, 256, 256, 20},
+        {128, 512, 256, 5},
+    };
+
+    static const size_t StrideCandidates[][2] = {
+        {MLAS_SGEMM_STRIDEN, MLAS_SGEMM_STRIDEK},
+        {MLAS_SGEMM_STRIDEN * 2, MLAS_SGEMM_STRIDEK / 2},
+        {MLAS_SGEMM_STRIDEN / 2, MLAS_SGEMM_STRIDEK * 2},
+        {MLAS_SGEMM_STRIDEN, MLAS_SGEMM_STRIDEK / 2},
+        {MLAS_SGEMM_STRIDEN / 2, MLAS_SGEMM_STRIDEK},
+    };
+
+    static const size_t ThreadComplexityCandidates[] = {
+        MLAS_SGEMM_THREAD_COMPLEXITY,
+        MLAS_SGEMM_THREAD_COMPLEXITY / 4,
+        MLAS_SGEMM_THREAD_COMPLEXITY / 2,
+        MLAS_SGEMM_THREAD_COMPLEXITY * 2,
+        MLAS_SGEMM_THREAD_COMPLEXITY * 4,
+    };
+
+    std::vector<float> A;
+    std::vector<float> B;
+    std::vector<float> C;
+
+    MLAS_SGEMM_TUNING_PARAMETERS Candidate;
+    Candidate.ThreadComplexity = MLAS_SGEMM_THREAD_COMPLEXITY;
+
+    MLAS_SGEMM_TUNING_PARAMETERS Best;
+    double BestSeconds = std::numeric_limits<double>::max();
+
+    for (const auto& Strides : StrideCandidates) {
+
+        Candidate.StrideN = Strides[0];
+        Candidate.StrideK = Strides[1];
+        MlasSgemmSetTuningParameters(&Candidate);
+
+        const double Seconds = MlasSgemmTuningBenchmark(BlockingShapes,
+            sizeof(BlockingShapes) / sizeof(BlockingShapes[0]), A, B, C, nullptr);
+
+        if (Seconds < BestSeconds) {
+            BestSeconds = Seconds;
+            Best = Candidate;
+        }
+    }
+
+    Candidate = Best;
+    BestSeconds = std::numeric_limits<double>::max();
+
+    for (size_t ThreadComplexity : ThreadComplexityCandidates) {
+
+        Candidate.ThreadComplexity = ThreadComplexity;
+        MlasSgemmSetTuningParameters(&Candidate);
+
+        const double Seconds = MlasSgemmTuningBenchmark(ThreadingShapes,
+            sizeof(ThreadingShapes) / sizeof(ThreadingShapes[0]), A, B, C, ThreadPool);
+
+        if (Seconds < BestSeconds) {
+            BestSeconds = Seconds;
+            Best = Candidate;
+        }
+    }
+
+    MlasSgemmSetTuningParameters(&Best);
+    *Parameters = Best;
+}
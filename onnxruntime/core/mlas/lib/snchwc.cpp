@@ -1511,6 +1511,99 @@ Return Value:
     }
 }
 
+void
+MLASCALL
+MlasNchwcUpsampleLinear(
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t OutputWidth,
+    float InterpolationHeight,
+    const float* InterpolationWidth,
+    const float* Input,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the NCHWc upsample linear operation for a single
+    output row of a single channel block.
+
+Arguments:
+
+    InputHeight - Supplies the input height.
+
+    InputWidth - Supplies the input width.
+
+    OutputWidth - Supplies the output width.
+
+    InterpolationHeight - Supplies the input coordinate of the output row.
+        Coordinates outside of the input are clamped to the border.
+
+    InterpolationWidth - Supplies the input coordinate of each output column.
+        Coordinates outside of the input are clamped to the border.
+
+    Input - Supplies the input channel block.
+
+    Output - Supplies the output row of the channel block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    //
+    // Compute the two input rows and their weights for the output row.
+    //
+
+    InterpolationHeight = std::min(std::max(InterpolationHeight, 0.0f), float(InputHeight - 1));
+
+    const size_t InputY1 = size_t(InterpolationHeight);
+    const size_t InputY2 = std::min(InputY1 + 1, InputHeight - 1);
+    const float dy = InterpolationHeight - float(InputY1);
+
+    const float* InputRow1 = Input + InputY1 * InputWidth * BlockSize;
+    const float* InputRow2 = Input + InputY2 * InputWidth * BlockSize;
+
+    for (size_t ow = 0; ow < OutputWidth; ow++) {
+
+        float InterpolationX = std::min(std::max(InterpolationWidth[ow], 0.0f), float(InputWidth - 1));
+
+        const size_t InputX1 = size_t(InterpolationX);
+        const size_t InputX2 = std::min(InputX1 + 1, InputWidth - 1);
+        const float dx = InterpolationX - float(InputX1);
+
+        const MLAS_FLOAT32X4 Weight11 = MlasBroadcastFloat32x4((1.0f - dy) * (1.0f - dx));
+        const MLAS_FLOAT32X4 Weight12 = MlasBroadcastFloat32x4((1.0f - dy) * dx);
+        const MLAS_FLOAT32X4 Weight21 = MlasBroadcastFloat32x4(dy * (1.0f - dx));
+        const MLAS_FLOAT32X4 Weight22 = MlasBroadcastFloat32x4(dy * dx);
+
+        const float* Input11 = InputRow1 + InputX1 * BlockSize;
+        const float* Input12 = InputRow1 + InputX2 * BlockSize;
+        const float* Input21 = InputRow2 + InputX1 * BlockSize;
+        const float* Input22 = InputRow2 + InputX2 * BlockSize;
+
+        //
+        // Every channel of the block shares the weights of the output pixel.
+        //
+
+        for (size_t bc = 0; bc < BlockSize; bc += 4) {
+
+            MLAS_FLOAT32X4 v = MlasMultiplyFloat32x4(Weight11, MlasLoadFloat32x4(Input11 + bc));
+            v = MlasMultiplyAddFloat32x4(Weight12, MlasLoadFloat32x4(Input12 + bc), v);
+            v = MlasMultiplyAddFloat32x4(Weight21, MlasLoadFloat32x4(Input21 + bc), v);
+            v = MlasMultiplyAddFloat32x4(Weight22, MlasLoadFloat32x4(Input22 + bc), v);
+
+            MlasStoreFloat32x4(Output + bc, v);
+        }
+
+        Output += BlockSize;
+    }
+}
+
 #if !defined(MLAS_TARGET_AMD64)
 
 //
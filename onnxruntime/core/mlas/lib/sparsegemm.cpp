@@ -0,0 +1,906 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a block sparse matrix B, for weights that have been
+    pruned to blocks of zeros.
+
+    Matrix B is split into blocks of BlockK rows by BlockN columns. The
+    packed buffer stores the blocks that contain a non-zero value, grouped by
+    column of blocks (block compressed sparse column):
+
+        MLAS_SPARSE_GEMM_PACKED_HEADER
+        uint32_t ColumnStart[N / BlockN + 1]   first block of each column
+        uint32_t BlockRow[BlockCount]          row of blocks of each block
+        float Values[BlockCount][BlockK][BlockN]
+
+    The supported block shapes are 4x4, 16x1 and 1x4. The packing routine
+    selects the shape that stores the fewest values among the shapes that
+    evenly divide matrix B.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the signature of a packed sparse matrix B.
+//
+
+#define MLAS_SPARSE_GEMM_SIGNATURE                  0x53505342  // "BSPS"
+
+//
+// Define the alignment of the values of a packed sparse matrix B.
+//
+
+#define MLAS_SPARSE_GEMM_VALUES_ALIGNMENT           64
+
+//
+// Define the number of rows of matrix A processed by the kernels at a time.
+//
+
+#define MLAS_SPARSE_GEMM_STRIDEM                    4
+
+struct MLAS_SPARSE_GEMM_PACKED_HEADER {
+    uint32_t Signature;
+    uint32_t BlockK;
+    uint32_t BlockN;
+    uint32_t K;
+    uint32_t N;
+    uint32_t BlockCount;
+    uint32_t Reserved[2];
+};
+
+struct MLAS_SPARSE_GEMM_BLOCK_SHAPE {
+    size_t BlockK;
+    size_t BlockN;
+};
+
+//
+// Define the supported block shapes in the order of preference when they
+// store the same number of values.
+//
+
+constexpr MLAS_SPARSE_GEMM_BLOCK_SHAPE MlasSparseGemmBlockShapes[] = {
+    {4, 4},
+    {16, 1},
+    {1, 4},
+};
+
+struct MLAS_SPARSE_GEMM_PACKED_B {
+    const MLAS_SPARSE_GEMM_PACKED_HEADER* Header;
+    const uint32_t* ColumnStart;
+    const uint32_t* BlockRow;
+    const float* Values;
+};
+
+MLAS_FORCEINLINE
+size_t
+MlasSparseGemmValuesOffset(
+    size_t N,
+    size_t BlockN,
+    size_t BlockCount
+    )
+{
+    size_t Offset = sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER) +
+        (N / BlockN + 1 + BlockCount) * sizeof(uint32_t);
+
+    return (Offset + MLAS_SPARSE_GEMM_VALUES_ALIGNMENT - 1) &
+        ~size_t(MLAS_SPARSE_GEMM_VALUES_ALIGNMENT - 1);
+}
+
+MLAS_FORCEINLINE
+bool
+MlasSparseGemmIsZero(
+    float Value,
+    float ZeroThreshold
+    )
+{
+    return Value == 0.0f || std::fabs(Value) <= ZeroThreshold;
+}
+
+bool
+MlasSparseGemmIsZeroBlock(
+    CBLAS_TRANSPOSE TransB,
+    const float* B,
+    size_t ldb,
+    size_t StartK,
+    size_t StartN,
+    const MLAS_SPARSE_GEMM_BLOCK_SHAPE& Shape,
+    float ZeroThreshold
+    )
+{
+    for (size_t k = StartK; k < StartK + Shape.BlockK; k++) {
+        for (size_t n = StartN; n < StartN + Shape.BlockN; n++) {
+            float Value = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+            if (!MlasSparseGemmIsZero(Value, ZeroThreshold)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+size_t
+MlasSparseGemmCountBlocks(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    const MLAS_SPARSE_GEMM_BLOCK_SHAPE& Shape,
+    float ZeroThreshold
+    )
+{
+    size_t BlockCount = 0;
+
+    for (size_t n = 0; n < N; n += Shape.BlockN) {
+        for (size_t k = 0; k < K; k += Shape.BlockK) {
+            if (!MlasSparseGemmIsZeroBlock(TransB, B, ldb, k, n, Shape, ZeroThreshold)) {
+                BlockCount++;
+            }
+        }
+    }
+
+    return BlockCount;
+}
+
+bool
+MlasSparseGemmSelectBlockShape(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float ZeroThreshold,
+    float MaximumDensity,
+    MLAS_SPARSE_GEMM_BLOCK_SHAPE* SelectedShape,
+    size_t* SelectedBlockCount
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the block shape that stores the fewest values for
+    matrix B.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    ZeroThreshold - Supplies the magnitude at or below which a value is
+        treated as zero.
+
+    MaximumDensity - Supplies the maximum fraction of the values of matrix B
+        that may be stored.
+
+    SelectedShape - Receives the selected block shape.
+
+    SelectedBlockCount - Receives the number of non-zero blocks.
+
+Return Value:
+
+    Returns true if a block shape stores no more than MaximumDensity of the
+    values of matrix B, else false.
+
+--*/
+{
+    if (N == 0 || K == 0 || N > UINT32_MAX || K > UINT32_MAX) {
+        return false;
+    }
+
+    bool Selected = false;
+    size_t SelectedValueCount = 0;
+
+    for (const auto& Shape : MlasSparseGemmBlockShapes) {
+
+        if ((K % Shape.BlockK) != 0 || (N % Shape.BlockN) != 0) {
+            continue;
+        }
+
+        const size_t BlockCount = MlasSparseGemmCountBlocks(TransB, N, K, B, ldb, Shape, ZeroThreshold);
+        const size_t ValueCount = BlockCount * Shape.BlockK * Shape.BlockN;
+
+        if (!Selected || ValueCount < SelectedValueCount) {
+            Selected = true;
+            SelectedValueCount = ValueCount;
+            *SelectedShape = Shape;
+            *SelectedBlockCount = BlockCount;
+        }
+    }
+
+    return Selected &&
+        double(SelectedValueCount) <= double(MaximumDensity) * double(N) * double(K) &&
+        *SelectedBlockCount <= UINT32_MAX;
+}
+
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float ZeroThreshold,
+    float MaximumDensity
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed sparse matrix B
+    buffer.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    ZeroThreshold - Supplies the magnitude at or below which a value is
+        treated as zero.
+
+    MaximumDensity - Supplies the maximum fraction of the values of matrix B
+        that may be stored.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer, or zero if
+    matrix B is not sparse enough to be packed.
+
+--*/
+{
+    MLAS_SPARSE_GEMM_BLOCK_SHAPE Shape;
+    size_t BlockCount;
+
+    if (!MlasSparseGemmSelectBlockShape(TransB, N, K, B, ldb, ZeroThreshold, MaximumDensity, &Shape, &BlockCount)) {
+        return 0;
+    }
+
+    return MlasSparseGemmValuesOffset(N, Shape.BlockN, BlockCount) +
+        BlockCount * Shape.BlockK * Shape.BlockN * sizeof(float);
+}
+
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float ZeroThreshold,
+    float MaximumDensity,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the non-zero blocks of matrix B. The arguments must
+    match the arguments of the MlasSparseGemmPackBSize call that computed the
+    size of the buffer.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    ZeroThreshold - Supplies the magnitude at or below which a value is
+        treated as zero. Values in stored blocks are kept as is.
+
+    MaximumDensity - Supplies the maximum fraction of the values of matrix B
+        that may be stored.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SPARSE_GEMM_BLOCK_SHAPE Shape;
+    size_t BlockCount;
+
+    if (!MlasSparseGemmSelectBlockShape(TransB, N, K, B, ldb, ZeroThreshold, MaximumDensity, &Shape, &BlockCount)) {
+        return;
+    }
+
+    auto* Header = reinterpret_cast<MLAS_SPARSE_GEMM_PACKED_HEADER*>(PackedB);
+
+    Header->Signature = MLAS_SPARSE_GEMM_SIGNATURE;
+    Header->BlockK = uint32_t(Shape.BlockK);
+    Header->BlockN = uint32_t(Shape.BlockN);
+    Header->K = uint32_t(K);
+    Header->N = uint32_t(N);
+    Header->BlockCount = uint32_t(BlockCount);
+    Header->Reserved[0] = 0;
+    Header->Reserved[1] = 0;
+
+    uint32_t* ColumnStart = reinterpret_cast<uint32_t*>(Header + 1);
+    uint32_t* BlockRow = ColumnStart + N / Shape.BlockN + 1;
+    float* Values = reinterpret_cast<float*>(static_cast<uint8_t*>(PackedB) +
+        MlasSparseGemmValuesOffset(N, Shape.BlockN, BlockCount));
+
+    uint32_t Block = 0;
+
+    for (size_t n = 0; n < N; n += Shape.BlockN) {
+
+        *ColumnStart++ = Block;
+
+        for (size_t k = 0; k < K; k += Shape.BlockK) {
+
+            if (MlasSparseGemmIsZeroBlock(TransB, B, ldb, k, n, Shape, ZeroThreshold)) {
+                continue;
+            }
+
+            BlockRow[Block++] = uint32_t(k / Shape.BlockK);
+
+            for (size_t kk = 0; kk < Shape.BlockK; kk++) {
+                for (size_t nn = 0; nn < Shape.BlockN; nn++) {
+                    *Values++ = (TransB == CblasNoTrans) ?
+                        B[(k + kk) * ldb + n + nn] : B[(n + nn) * ldb + k + kk];
+                }
+            }
+        }
+    }
+
+    *ColumnStart = Block;
+}
+
+bool
+MLASCALL
+MlasSparseGemmIsPackedB(
+    const void* PackedB,
+    size_t PackedBSize,
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether the buffer holds a sparse matrix B of the
+    given shape packed by MlasSparseGemmPackB, for example when the packed
+    buffer was saved by an earlier session.
+
+Arguments:
+
+    PackedB - Supplies the address of the buffer.
+
+    PackedBSize - Supplies the size of the buffer in bytes.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns true if the buffer is a packed sparse matrix B, else false.
+
+--*/
+{
+    if (PackedBSize < sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER)) {
+        return false;
+    }
+
+    const auto* Header = reinterpret_cast<const MLAS_SPARSE_GEMM_PACKED_HEADER*>(PackedB);
+
+    if (Header->Signature != MLAS_SPARSE_GEMM_SIGNATURE || Header->N != N || Header->K != K) {
+        return false;
+    }
+
+    bool ShapeSupported = false;
+
+    for (const auto& Shape : MlasSparseGemmBlockShapes) {
+        if (Shape.BlockK == Header->BlockK && Shape.BlockN == Header->BlockN) {
+            ShapeSupported = true;
+        }
+    }
+
+    if (!ShapeSupported || (K % Header->BlockK) != 0 || (N % Header->BlockN) != 0) {
+        return false;
+    }
+
+    const size_t BlockCount = Header->BlockCount;
+
+    if (PackedBSize != MlasSparseGemmValuesOffset(N, Header->BlockN, BlockCount) +
+            BlockCount * Header->BlockK * Header->BlockN * sizeof(float)) {
+        return false;
+    }
+
+    //
+    // Validate the indices so that the kernels cannot read out of bounds.
+    //
+
+    const uint32_t* ColumnStart = reinterpret_cast<const uint32_t*>(Header + 1);
+    const size_t ColumnCount = N / Header->BlockN;
+    const uint32_t* BlockRow = ColumnStart + ColumnCount + 1;
+
+    if (ColumnStart[0] != 0 || ColumnStart[ColumnCount] != BlockCount) {
+        return false;
+    }
+
+    for (size_t c = 0; c < ColumnCount; c++) {
+        if (ColumnStart[c] > ColumnStart[c + 1]) {
+            return false;
+        }
+    }
+
+    for (size_t b = 0; b < BlockCount; b++) {
+        if (size_t(BlockRow[b]) >= K / Header->BlockK) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+MLAS_FORCEINLINE
+MLAS_SPARSE_GEMM_PACKED_B
+MlasSparseGemmUnpackHeader(
+    const void* PackedB
+    )
+{
+    MLAS_SPARSE_GEMM_PACKED_B Packed;
+
+    Packed.Header = reinterpret_cast<const MLAS_SPARSE_GEMM_PACKED_HEADER*>(PackedB);
+    Packed.ColumnStart = reinterpret_cast<const uint32_t*>(Packed.Header + 1);
+    Packed.BlockRow = Packed.ColumnStart + Packed.Header->N / Packed.Header->BlockN + 1;
+    Packed.Values = reinterpret_cast<const float*>(static_cast<const uint8_t*>(PackedB) +
+        MlasSparseGemmValuesOffset(Packed.Header->N, Packed.Header->BlockN, Packed.Header->BlockCount));
+
+    return Packed;
+}
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasSparseGemmLoadA(
+    const float* A,
+    size_t StrideK
+    )
+{
+    if (StrideK == 1) {
+        return MlasLoadFloat32x4(A);
+    }
+
+    float Elements[4] = {A[0], A[StrideK], A[StrideK * 2], A[StrideK * 3]};
+
+    return MlasLoadFloat32x4(Elements);
+}
+
+template<size_t BlockK, size_t RowCount>
+void
+MlasSparseGemmKernelN4(
+    const MLAS_SPARSE_GEMM_PACKED_B& Packed,
+    const float* A,
+    size_t StrideM,
+    size_t StrideK,
+    float* C,
+    size_t ldc,
+    size_t StartColumn,
+    size_t CountColumn,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of the output for a range of columns
+    of blocks of 4 columns. Each non-zero value of a block row is multiplied
+    by the broadcast value of matrix A and accumulated across the 4 columns.
+
+Arguments:
+
+    Packed - Supplies the packed matrix B.
+
+    A - Supplies the address of the first row of matrix A.
+
+    StrideM - Supplies the distance between rows of op(A).
+
+    StrideK - Supplies the distance between columns of op(A).
+
+    C - Supplies the address of the first row of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    StartColumn - Supplies the first column of blocks.
+
+    CountColumn - Supplies the number of columns of blocks.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t c = StartColumn; c < StartColumn + CountColumn; c++) {
+
+        MLAS_FLOAT32X4 Accumulators[RowCount];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = MlasZeroFloat32x4();
+        }
+
+        for (uint32_t b = Packed.ColumnStart[c]; b < Packed.ColumnStart[c + 1]; b++) {
+
+            const size_t StartK = size_t(Packed.BlockRow[b]) * BlockK;
+            const float* Values = Packed.Values + size_t(b) * BlockK * 4;
+
+            for (size_t kk = 0; kk < BlockK; kk++) {
+
+                MLAS_FLOAT32X4 BElements = MlasLoadFloat32x4(Values + kk * 4);
+                const float* a = A + (StartK + kk) * StrideK;
+
+                for (size_t r = 0; r < RowCount; r++) {
+                    Accumulators[r] = MlasMultiplyAddFloat32x4(BElements, a[r * StrideM], Accumulators[r]);
+                }
+            }
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c_out = C + r * ldc + c * 4;
+            MLAS_FLOAT32X4 Result = MlasMultiplyFloat32x4(Accumulators[r], MlasBroadcastFloat32x4(alpha));
+
+            if (beta != 0.0f) {
+                Result = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(c_out), beta, Result);
+            }
+
+            MlasStoreFloat32x4(c_out, Result);
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasSparseGemmKernelK16(
+    const MLAS_SPARSE_GEMM_PACKED_B& Packed,
+    const float* A,
+    size_t StrideM,
+    size_t StrideK,
+    float* C,
+    size_t ldc,
+    size_t StartColumn,
+    size_t CountColumn,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of the output for a range of columns
+    with blocks of 16 rows by 1 column. Each block is a dot product of 16
+    values of a row of matrix A with 16 values of a column of matrix B.
+
+Arguments:
+
+    See MlasSparseGemmKernelN4.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t c = StartColumn; c < StartColumn + CountColumn; c++) {
+
+        MLAS_FLOAT32X4 Accumulators[RowCount];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = MlasZeroFloat32x4();
+        }
+
+        for (uint32_t b = Packed.ColumnStart[c]; b < Packed.ColumnStart[c + 1]; b++) {
+
+            const size_t StartK = size_t(Packed.BlockRow[b]) * 16;
+            const float* Values = Packed.Values + size_t(b) * 16;
+
+            for (size_t kk = 0; kk < 16; kk += 4) {
+
+                MLAS_FLOAT32X4 BElements = MlasLoadFloat32x4(Values + kk);
+                const float* a = A + (StartK + kk) * StrideK;
+
+                for (size_t r = 0; r < RowCount; r++) {
+                    Accumulators[r] = MlasMultiplyAddFloat32x4(MlasSparseGemmLoadA(a + r * StrideM, StrideK),
+                        BElements, Accumulators[r]);
+                }
+            }
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c_out = C + r * ldc + c;
+            float Result = MlasReduceAddFloat32x4(Accumulators[r]) * alpha;
+
+            if (beta != 0.0f) {
+                Result += *c_out * beta;
+            }
+
+            *c_out = Result;
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasSparseGemmKernel(
+    const MLAS_SPARSE_GEMM_PACKED_B& Packed,
+    const float* A,
+    size_t StrideM,
+    size_t StrideK,
+    float* C,
+    size_t ldc,
+    size_t StartColumn,
+    size_t CountColumn,
+    float alpha,
+    float beta
+    )
+{
+    const size_t BlockK = Packed.Header->BlockK;
+
+    if (Packed.Header->BlockN == 1) {
+        MlasSparseGemmKernelK16<RowCount>(Packed, A, StrideM, StrideK, C, ldc,
+            StartColumn, CountColumn, alpha, beta);
+    } else if (BlockK == 4) {
+        MlasSparseGemmKernelN4<4, RowCount>(Packed, A, StrideM, StrideK, C, ldc,
+            StartColumn, CountColumn, alpha, beta);
+    } else {
+        MlasSparseGemmKernelN4<1, RowCount>(Packed, A, StrideM, StrideK, C, ldc,
+            StartColumn, CountColumn, alpha, beta);
+    }
+}
+
+void
+MlasSparseGemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartColumn,
+    size_t RangeCountColumn
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the sparse GEMM operation for a segment of the
+    output matrix.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    Data - Supplies the matrices data parameters.
+
+    RangeStartM - Supplies the starting row index to output.
+
+    RangeCountM - Supplies the number of rows to output.
+
+    RangeStartColumn - Supplies the starting column of blocks to output.
+
+    RangeCountColumn - Supplies the number of columns of blocks to output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SPARSE_GEMM_PACKED_B Packed = MlasSparseGemmUnpackHeader(Data->B);
+
+    const size_t StrideM = (TransA == CblasNoTrans) ? Data->lda : 1;
+    const size_t StrideK = (TransA == CblasNoTrans) ? 1 : Data->lda;
+
+    size_t CountM;
+
+    for (size_t m = RangeStartM; m < RangeStartM + RangeCountM; m += CountM) {
+
+        CountM = std::min(RangeStartM + RangeCountM - m, size_t(MLAS_SPARSE_GEMM_STRIDEM));
+
+        const float* a = Data->A + m * StrideM;
+        float* c = Data->C + m * Data->ldc;
+
+        switch (CountM) {
+            case 4:
+                MlasSparseGemmKernel<4>(Packed, a, StrideM, StrideK, c, Data->ldc,
+                    RangeStartColumn, RangeCountColumn, Data->alpha, Data->beta);
+                break;
+            case 3:
+                MlasSparseGemmKernel<3>(Packed, a, StrideM, StrideK, c, Data->ldc,
+                    RangeStartColumn, RangeCountColumn, Data->alpha, Data->beta);
+                break;
+            case 2:
+                MlasSparseGemmKernel<2>(Packed, a, StrideM, StrideK, c, Data->ldc,
+                    RangeStartColumn, RangeCountColumn, Data->alpha, Data->beta);
+                break;
+            default:
+                MlasSparseGemmKernel<1>(Packed, a, StrideM, StrideK, c, Data->ldc,
+                    RangeStartColumn, RangeCountColumn, Data->alpha, Data->beta);
+                break;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the batched single precision matrix/matrix
+    multiply operation with a block sparse matrix B.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies the array of matrices data parameters. The B member
+        supplies the buffer packed by MlasSparseGemmPackB.
+
+    BatchSize - Supplies the number of multiplications in this batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    MLAS_UNREFERENCED_PARAMETER(K);
+
+    //
+    // All of the multiplications share the packed matrix B.
+    //
+
+    const MLAS_SPARSE_GEMM_PACKED_B Packed = MlasSparseGemmUnpackHeader(Data[0].B);
+    const size_t ColumnCount = N / Packed.Header->BlockN;
+    const size_t ValueCount = size_t(Packed.Header->BlockCount) * Packed.Header->BlockK * Packed.Header->BlockN;
+
+    //
+    // Compute the number of target threads given the number of multiplies
+    // of the operation. Small requests should run using the single threaded
+    // path.
+    //
+
+    const double Complexity = double(M) * double(ValueCount);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SPARSE_GEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SPARSE_GEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MlasPlatform.MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across the columns of blocks, which keeps the
+    // blocks of matrix B used by a thread together, or across the rows if
+    // there are more rows than columns of blocks.
+    //
+
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (ColumnCount >= M) {
+
+        if (size_t(TargetThreadCount) > ColumnCount) {
+            TargetThreadCount = ptrdiff_t(ColumnCount);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = TargetThreadCount;
+
+    } else {
+
+        const size_t BlockedM = (M + MLAS_SPARSE_GEMM_STRIDEM - 1) / MLAS_SPARSE_GEMM_STRIDEM;
+
+        if (size_t(TargetThreadCount) > BlockedM) {
+            TargetThreadCount = ptrdiff_t(BlockedM);
+        }
+
+        ThreadCountM = TargetThreadCount;
+        ThreadCountN = 1;
+    }
+
+    const ptrdiff_t ThreadsPerGemm = ThreadCountM * ThreadCountN;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * ptrdiff_t(BatchSize), [&](ptrdiff_t tid) {
+
+        const ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        const ptrdiff_t ThreadId = tid % ThreadsPerGemm;
+
+        //
+        // Partition the rows in multiples of the kernel stride so that only
+        // the last partition has a partial stride.
+        //
+
+        const size_t BlockedM = (M + MLAS_SPARSE_GEMM_STRIDEM - 1) / MLAS_SPARSE_GEMM_STRIDEM;
+
+        size_t RangeStartM;
+        size_t RangeCountM;
+
+        MlasPartitionWork(ThreadId / ThreadCountN, ThreadCountM, BlockedM, &RangeStartM, &RangeCountM);
+
+        RangeStartM *= MLAS_SPARSE_GEMM_STRIDEM;
+        RangeCountM = std::min(M - std::min(M, RangeStartM), RangeCountM * MLAS_SPARSE_GEMM_STRIDEM);
+
+        size_t RangeStartColumn;
+        size_t RangeCountColumn;
+
+        MlasPartitionWork(ThreadId % ThreadCountN, ThreadCountN, ColumnCount, &RangeStartColumn, &RangeCountColumn);
+
+        if (RangeCountM == 0 || RangeCountColumn == 0) {
+            return;
+        }
+
+        MlasSparseGemmOperation(TransA, &Data[GemmIdx], RangeStartM, RangeCountM,
+            RangeStartColumn, RangeCountColumn);
+    });
+}
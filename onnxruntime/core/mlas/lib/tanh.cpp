@@ -176,3 +176,141 @@ Return Value:
     MlasTanhKernel(Input, Output, N);
 #endif
 }
+
+//
+// Constants of the fast approximation, the [7/6] Pade approximant of the
+// hyperbolic tangent normalized to a unit constant term. The input range is
+// limited to where the approximant is closest to 1.
+//
+
+const MLAS_FAST_TANH_CONSTANTS MlasFastTanhConstants = {
+    -4.8f,
+    4.8f,
+    7.400007400e-06f,
+    2.797202797e-03f,
+    1.282051282e-01f,
+    2.072002072e-04f,
+    2.331002331e-02f,
+    4.615384615e-01f,
+    1.0f,
+};
+
+void
+MLASCALL
+MlasFastTanhKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the fast approximation of
+    the hyperbolic tangent function.
+
+    The absolute error is below 7.5e-5 over the whole input range, compared to
+    about 1e-7 for MlasTanhKernel.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+
+        Value = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasFastTanhConstants.LowerRange), Value);
+        Value = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasFastTanhConstants.UpperRange), Value);
+
+        MLAS_FLOAT32X4 ValueSquared = MlasMultiplyFloat32x4(Value, Value);
+
+        MLAS_FLOAT32X4 p;
+        p = MlasMultiplyAddFloat32x4(ValueSquared, MlasBroadcastFloat32x4(MlasFastTanhConstants.alpha_6),
+            MlasBroadcastFloat32x4(MlasFastTanhConstants.alpha_4));
+        p = MlasMultiplyAddFloat32x4(p, ValueSquared, MlasBroadcastFloat32x4(MlasFastTanhConstants.alpha_2));
+        p = MlasMultiplyAddFloat32x4(p, ValueSquared, MlasBroadcastFloat32x4(MlasFastTanhConstants.one));
+        p = MlasMultiplyFloat32x4(p, Value);
+
+        MLAS_FLOAT32X4 q;
+        q = MlasMultiplyAddFloat32x4(ValueSquared, MlasBroadcastFloat32x4(MlasFastTanhConstants.beta_6),
+            MlasBroadcastFloat32x4(MlasFastTanhConstants.beta_4));
+        q = MlasMultiplyAddFloat32x4(q, ValueSquared, MlasBroadcastFloat32x4(MlasFastTanhConstants.beta_2));
+        q = MlasMultiplyAddFloat32x4(q, ValueSquared, MlasBroadcastFloat32x4(MlasFastTanhConstants.one));
+
+        MlasStoreFloat32x4(Output, MlasDivideFloat32x4(p, q));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        Value = std::min(MlasFastTanhConstants.UpperRange, std::max(MlasFastTanhConstants.LowerRange, Value));
+
+        float ValueSquared = Value * Value;
+
+        float p;
+        p = ValueSquared * MlasFastTanhConstants.alpha_6 + MlasFastTanhConstants.alpha_4;
+        p = p * ValueSquared + MlasFastTanhConstants.alpha_2;
+        p = p * ValueSquared + MlasFastTanhConstants.one;
+        p = p * Value;
+
+        float q;
+        q = ValueSquared * MlasFastTanhConstants.beta_6 + MlasFastTanhConstants.beta_4;
+        q = q * ValueSquared + MlasFastTanhConstants.beta_2;
+        q = q * ValueSquared + MlasFastTanhConstants.one;
+
+        *Output++ = (p / q);
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeFastTanh(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a fast approximation of the hyperbolic tangent
+    function, see MlasFastTanhKernel for the error bound.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.FastTanhKernelRoutine(Input, Output, N);
+#else
+    MlasFastTanhKernel(Input, Output, N);
+#endif
+}
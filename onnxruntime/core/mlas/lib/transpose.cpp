@@ -95,6 +95,70 @@ MlasTranspose8x8Block(
     _mm_storeh_pi((__m64*)&Output[OutputStride * 7], d3);
 }
 
+MLAS_FORCEINLINE
+void
+MlasTranspose8x8Block(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride
+    )
+{
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+    __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+
+    __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 2]);
+    __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 3]);
+    __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+
+    __m128i a4 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 4]);
+    __m128i a5 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 5]);
+    __m128i b4 = _mm_unpacklo_epi16(a4, a5);
+    __m128i b5 = _mm_unpackhi_epi16(a4, a5);
+
+    __m128i a6 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 6]);
+    __m128i a7 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 7]);
+    __m128i b6 = _mm_unpacklo_epi16(a6, a7);
+    __m128i b7 = _mm_unpackhi_epi16(a6, a7);
+
+    __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+    __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+    __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+    __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+    __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+    __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+    __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+    __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(c0, c4));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(c0, c4));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 2], _mm_unpacklo_epi64(c1, c5));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 3], _mm_unpackhi_epi64(c1, c5));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 4], _mm_unpacklo_epi64(c2, c6));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 5], _mm_unpackhi_epi64(c2, c6));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 6], _mm_unpacklo_epi64(c3, c7));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 7], _mm_unpackhi_epi64(c3, c7));
+}
+
+MLAS_FORCEINLINE
+void
+MlasTranspose2x2Block(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+{
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(a0, a1));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(a0, a1));
+}
+
 #elif defined(MLAS_NEON_INTRINSICS)
 
 MLAS_FORCEINLINE
@@ -168,48 +232,181 @@ MlasTranspose8x8Block(
     vst1_u8(&Output[OutputStride * 7], vreinterpret_u8_u32(d3.val[1]));
 }
 
+MLAS_FORCEINLINE
+void
+MlasTranspose8x8Block(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride
+    )
+{
+    uint16x8_t a0 = vld1q_u16(&Input[InputStride * 0]);
+    uint16x8_t a1 = vld1q_u16(&Input[InputStride * 1]);
+    uint16x8x2_t b0 = vzipq_u16(a0, a1);
+
+    uint16x8_t a2 = vld1q_u16(&Input[InputStride * 2]);
+    uint16x8_t a3 = vld1q_u16(&Input[InputStride * 3]);
+    uint16x8x2_t b1 = vzipq_u16(a2, a3);
+
+    uint16x8_t a4 = vld1q_u16(&Input[InputStride * 4]);
+    uint16x8_t a5 = vld1q_u16(&Input[InputStride * 5]);
+    uint16x8x2_t b2 = vzipq_u16(a4, a5);
+
+    uint16x8_t a6 = vld1q_u16(&Input[InputStride * 6]);
+    uint16x8_t a7 = vld1q_u16(&Input[InputStride * 7]);
+    uint16x8x2_t b3 = vzipq_u16(a6, a7);
+
+    uint32x4x2_t c0 = vzipq_u32(vreinterpretq_u32_u16(b0.val[0]), vreinterpretq_u32_u16(b1.val[0]));
+    uint32x4x2_t c1 = vzipq_u32(vreinterpretq_u32_u16(b0.val[1]), vreinterpretq_u32_u16(b1.val[1]));
+    uint32x4x2_t c2 = vzipq_u32(vreinterpretq_u32_u16(b2.val[0]), vreinterpretq_u32_u16(b3.val[0]));
+    uint32x4x2_t c3 = vzipq_u32(vreinterpretq_u32_u16(b2.val[1]), vreinterpretq_u32_u16(b3.val[1]));
+
+    uint64x2_t d0 = vreinterpretq_u64_u32(c0.val[0]);
+    uint64x2_t d1 = vreinterpretq_u64_u32(c0.val[1]);
+    uint64x2_t d2 = vreinterpretq_u64_u32(c1.val[0]);
+    uint64x2_t d3 = vreinterpretq_u64_u32(c1.val[1]);
+    uint64x2_t d4 = vreinterpretq_u64_u32(c2.val[0]);
+    uint64x2_t d5 = vreinterpretq_u64_u32(c2.val[1]);
+    uint64x2_t d6 = vreinterpretq_u64_u32(c3.val[0]);
+    uint64x2_t d7 = vreinterpretq_u64_u32(c3.val[1]);
+
+    vst1q_u16(&Output[OutputStride * 0], vreinterpretq_u16_u64(vcombine_u64(vget_low_u64(d0), vget_low_u64(d4))));
+    vst1q_u16(&Output[OutputStride * 1], vreinterpretq_u16_u64(vcombine_u64(vget_high_u64(d0), vget_high_u64(d4))));
+    vst1q_u16(&Output[OutputStride * 2], vreinterpretq_u16_u64(vcombine_u64(vget_low_u64(d1), vget_low_u64(d5))));
+    vst1q_u16(&Output[OutputStride * 3], vreinterpretq_u16_u64(vcombine_u64(vget_high_u64(d1), vget_high_u64(d5))));
+    vst1q_u16(&Output[OutputStride * 4], vreinterpretq_u16_u64(vcombine_u64(vget_low_u64(d2), vget_low_u64(d6))));
+    vst1q_u16(&Output[OutputStride * 5], vreinterpretq_u16_u64(vcombine_u64(vget_high_u64(d2), vget_high_u64(d6))));
+    vst1q_u16(&Output[OutputStride * 6], vreinterpretq_u16_u64(vcombine_u64(vget_low_u64(d3), vget_low_u64(d7))));
+    vst1q_u16(&Output[OutputStride * 7], vreinterpretq_u16_u64(vcombine_u64(vget_high_u64(d3), vget_high_u64(d7))));
+}
+
+MLAS_FORCEINLINE
+void
+MlasTranspose2x2Block(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+{
+    uint64x2_t a0 = vld1q_u64(&Input[InputStride * 0]);
+    uint64x2_t a1 = vld1q_u64(&Input[InputStride * 1]);
+
+    vst1q_u64(&Output[OutputStride * 0], vcombine_u64(vget_low_u64(a0), vget_low_u64(a1)));
+    vst1q_u64(&Output[OutputStride * 1], vcombine_u64(vget_high_u64(a0), vget_high_u64(a1)));
+}
+
 #endif
 
-template<typename ElementType>
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+
 MLAS_FORCEINLINE
 void
-MlasTranspose4xNVector(
-    const ElementType* Input,
+MlasTranspose4x4Block(
+    const uint64_t* Input,
     size_t InputStride,
-    ElementType* Output,
+    uint64_t* Output,
     size_t OutputStride
     )
 {
-    ElementType a0 = Input[InputStride * 0];
-    ElementType a1 = Input[InputStride * 1];
-    ElementType a2 = Input[InputStride * 2];
-    ElementType a3 = Input[InputStride * 3];
-
-    Output[OutputStride * 0] = a0;
-    Output[OutputStride * 1] = a1;
-    Output[OutputStride * 2] = a2;
-    Output[OutputStride * 3] = a3;
+    MlasTranspose2x2Block(&Input[0], InputStride, &Output[0], OutputStride);
+    MlasTranspose2x2Block(&Input[2], InputStride, &Output[OutputStride * 2], OutputStride);
+    MlasTranspose2x2Block(&Input[InputStride * 2], InputStride, &Output[2], OutputStride);
+    MlasTranspose2x2Block(&Input[InputStride * 2 + 2], InputStride, &Output[OutputStride * 2 + 2], OutputStride);
 }
 
+//
+// Dispatches to the block kernel for the element type. Elements of 1 or 2
+// bytes are transposed in 8x8 blocks, elements of 4 or 8 bytes in 4x4 blocks.
+//
+
+MLAS_FORCEINLINE
+void
+MlasTransposeBlock(
+    const uint8_t* Input,
+    size_t InputStride,
+    uint8_t* Output,
+    size_t OutputStride
+    )
+{
+    MlasTranspose8x8Block(Input, InputStride, Output, OutputStride);
+}
+
+MLAS_FORCEINLINE
+void
+MlasTransposeBlock(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride
+    )
+{
+    MlasTranspose8x8Block(Input, InputStride, Output, OutputStride);
+}
+
+MLAS_FORCEINLINE
+void
+MlasTransposeBlock(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride
+    )
+{
+    MlasTranspose4x4Block(Input, InputStride, Output, OutputStride);
+}
+
+MLAS_FORCEINLINE
+void
+MlasTransposeBlock(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+{
+    MlasTranspose4x4Block(Input, InputStride, Output, OutputStride);
+}
+
+#endif
+
+template<typename ElementType>
+struct MLAS_TRANSPOSE_BLOCK_SIZE
+{
+    static constexpr size_t Value = (sizeof(ElementType) <= 2) ? 8 : 4;
+};
+
 template<typename ElementType>
 MLAS_FORCEINLINE
 void
-MlasTranspose8xNVector(
+MlasTransposeVector(
     const ElementType* Input,
     size_t InputStride,
     ElementType* Output,
     size_t OutputStride
     )
 {
-    MlasTranspose4xNVector(&Input[InputStride * 0], InputStride, &Output[OutputStride * 0], OutputStride);
-    MlasTranspose4xNVector(&Input[InputStride * 4], InputStride, &Output[OutputStride * 4], OutputStride);
+    constexpr size_t BlockSize = MLAS_TRANSPOSE_BLOCK_SIZE<ElementType>::Value;
+
+    ElementType v[BlockSize];
+
+    for (size_t i = 0; i < BlockSize; i++) {
+        v[i] = Input[InputStride * i];
+    }
+
+    for (size_t i = 0; i < BlockSize; i++) {
+        Output[OutputStride * i] = v[i];
+    }
 }
 
+template<typename ElementType>
 void
-MLASCALL
-MlasTranspose(
-    const uint32_t* Input,
-    uint32_t* Output,
+MlasTransposeStrided(
+    const ElementType* Input,
+    size_t InputStride,
+    ElementType* Output,
+    size_t OutputStride,
     size_t M,
     size_t N
     )
@@ -224,8 +421,14 @@ Arguments:
 
     Input - Supplies the input buffer.
 
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
     Output - Supplies the output buffer.
 
+    OutputStride - Supplies the number of elements between rows of the output
+        matrix.
+
     M - Supplies the number of rows for the input matrix and the number of
         columns for the output matrix.
 
@@ -238,44 +441,46 @@ Return Value:
 
 --*/
 {
+    constexpr size_t BlockSize = MLAS_TRANSPOSE_BLOCK_SIZE<ElementType>::Value;
+
     size_t n = N;
 
     //
-    // Transpose elements from the input matrix to the output matrix 4 columns
-    // at a time.
+    // Transpose elements from the input matrix to the output matrix BlockSize
+    // columns at a time.
     //
 
-    while (n >= 4) {
+    while (n >= BlockSize) {
 
-        const uint32_t* s = Input;
-        uint32_t* d = Output;
+        const ElementType* s = Input;
+        ElementType* d = Output;
         size_t m = M;
 
 #if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
 
-        while (m >= 4) {
+        while (m >= BlockSize) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTransposeBlock(s, InputStride, d, OutputStride);
 
-            s += N * 4;
-            d += 4;
-            m -= 4;
+            s += InputStride * BlockSize;
+            d += BlockSize;
+            m -= BlockSize;
         }
 
 #endif
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTransposeVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
-        Input += 4;
-        Output += M * 4;
-        n -= 4;
+        Input += BlockSize;
+        Output += OutputStride * BlockSize;
+        n -= BlockSize;
     }
 
     //
@@ -285,34 +490,82 @@ Return Value:
 
     while (n > 0) {
 
-        const uint32_t* s = Input;
-        uint32_t* d = Output;
+        const ElementType* s = Input;
+        ElementType* d = Output;
         size_t m = M;
 
-        while (m >= 4) {
+        while (m >= BlockSize) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTransposeVector(s, InputStride, d, 1);
 
-            s += N * 4;
-            d += 4;
-            m -= 4;
+            s += InputStride * BlockSize;
+            d += BlockSize;
+            m -= BlockSize;
         }
 
         while (m > 0) {
 
             d[0] = s[0];
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += OutputStride;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeStrided(Input, N, Output, M, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeStrided(Input, N, Output, M, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeStrided(Input, N, Output, M, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeStrided(Input, N, Output, M, M, N);
+}
+
 void
 MLASCALL
 MlasTranspose(
@@ -333,106 +586,54 @@ void
 MLASCALL
 MlasTranspose(
     const uint8_t* Input,
+    size_t InputStride,
     uint8_t* Output,
+    size_t OutputStride,
     size_t M,
     size_t N
     )
-/*++
-
-Routine Description:
-
-    This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
-
-Arguments:
-
-    Input - Supplies the input buffer.
-
-    Output - Supplies the output buffer.
-
-    M - Supplies the number of rows for the input matrix and the number of
-        columns for the output matrix.
-
-    N - Supplies the number of columns for the input matrix and the number of
-        rows for the output matrix.
-
-Return Value:
-
-    None.
-
---*/
 {
-    size_t n = N;
-
-    //
-    // Transpose elements from the input matrix to the output matrix 8 columns
-    // at a time.
-    //
-
-    while (n >= 8) {
-
-        const uint8_t* s = Input;
-        uint8_t* d = Output;
-        size_t m = M;
-
-#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
-
-        while (m >= 8) {
-
-            MlasTranspose8x8Block(s, N, d, M);
-
-            s += N * 8;
-            d += 8;
-            m -= 8;
-        }
-
-#endif
-
-        while (m > 0) {
-
-            MlasTranspose8xNVector(s, 1, d, M);
-
-            s += N;
-            d += 1;
-            m -= 1;
-        }
-
-        Input += 8;
-        Output += M * 8;
-        n -= 8;
-    }
-
-    //
-    // Transpose elements from the input matrix to the output matrix for the
-    // remaining columns.
-    //
-
-    while (n > 0) {
-
-        const uint8_t* s = Input;
-        uint8_t* d = Output;
-        size_t m = M;
-
-        while (m >= 8) {
-
-            MlasTranspose8xNVector(s, N, d, 1);
-
-            s += N * 8;
-            d += 8;
-            m -= 8;
-        }
-
-        while (m > 0) {
+    MlasTransposeStrided(Input, InputStride, Output, OutputStride, M, N);
+}
 
-            d[0] = s[0];
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeStrided(Input, InputStride, Output, OutputStride, M, N);
+}
 
-            s += N;
-            d += 1;
-            m -= 1;
-        }
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeStrided(Input, InputStride, Output, OutputStride, M, N);
+}
 
-        Input += 1;
-        Output += M;
-        n -= 1;
-    }
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeStrided(Input, InputStride, Output, OutputStride, M, N);
 }
@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/activation_storage_compression.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns true if the NodeArg is a float tensor with a static shape of at least min_bytes.
+bool IsLargeFloatTensor(const NodeArg& node_arg, size_t min_bytes) {
+  const auto* type = node_arg.TypeAsProto();
+  const auto* shape = node_arg.Shape();
+  if (type == nullptr || !type->has_tensor_type() ||
+      type->tensor_type().elem_type() != TensorProto_DataType_FLOAT || shape == nullptr) {
+    return false;
+  }
+
+  size_t bytes = sizeof(float);
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value() || dim.dim_value() < 0) {
+      return false;
+    }
+    bytes *= static_cast<size_t>(dim.dim_value());
+  }
+  return bytes >= min_bytes;
+}
+
+}  // namespace
+
+Status ActivationStorageCompression::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                               const logging::Logger& logger) const {
+  // Cast supports bfloat16 since opset 13
+  const auto& domain_to_version = graph.DomainToVersionMap();
+  const auto onnx_version = domain_to_version.find(kOnnxDomain);
+  if (storage_type_ == TensorProto_DataType_BFLOAT16 &&
+      (onnx_version == domain_to_version.end() || onnx_version->second < 13)) {
+    LOGS(logger, VERBOSE) << "Activations can only be stored as bfloat16 in models importing opset 13 or later.";
+    return Status::OK();
+  }
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::unordered_map<NodeIndex, size_t> positions;
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    positions[node_topology_list[i]] = i;
+  }
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    // the outputs of Cast nodes are either already compressed or restored for a consumer
+    if (node.OpType() == "Cast" ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const auto graph_outputs = graph.GetNodeOutputsInGraphOutputs(node);
+    for (size_t i = 0; i < node.OutputDefs().size(); ++i) {
+      NodeArg* activation = node.MutableOutputDefs()[i];
+      if (!activation->Exists() || !IsLargeFloatTensor(*activation, min_bytes_) ||
+          std::find(graph_outputs.begin(), graph_outputs.end(), static_cast<int>(i)) != graph_outputs.end()) {
+        continue;
+      }
+
+      const auto edges = graph_utils::GraphEdge::GetNodeOutputEdges(node, i);
+      bool compressible = !edges.empty();
+      size_t last_use = 0;
+      for (const auto& edge : edges) {
+        const Node& consumer = *graph.GetNode(edge.dst_node);
+        // implicit inputs of subgraphs are read by the nodes of the subgraph
+        if (consumer.OpType() == "Cast" ||
+            consumer.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+            static_cast<size_t>(edge.dst_arg_index) >= consumer.InputDefs().size()) {
+          compressible = false;
+          break;
+        }
+        last_use = std::max(last_use, positions[edge.dst_node]);
+      }
+
+      // an activation only read by the next node is released before storing it in 16 bits would pay off
+      if (!compressible || last_use <= positions[node_index] + 1) {
+        continue;
+      }
+
+      graph_utils::GraphEdge::RemoveGraphEdges(graph, edges);
+
+      TypeProto stored_type(*activation->TypeAsProto());
+      stored_type.mutable_tensor_type()->set_elem_type(storage_type_);
+      NodeArg& stored = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(activation->Name() + "_stored"),
+                                                 &stored_type);
+      Node& compress = graph.AddNode(graph.GenerateNodeName(activation->Name() + "_compress"), "Cast",
+                                     "store the activation in 16 bits", {activation}, {&stored});
+      compress.AddAttribute("to", static_cast<int64_t>(storage_type_));
+      compress.SetExecutionProviderType(node.GetExecutionProviderType());
+      graph.AddEdge(node_index, compress.Index(), static_cast<int>(i), 0);
+
+      // restore the activation once per consumer, right before it runs
+      std::unordered_map<NodeIndex, Node*> restore_nodes;
+      for (const auto& edge : edges) {
+        auto restore = restore_nodes.find(edge.dst_node);
+        if (restore == restore_nodes.end()) {
+          NodeArg& restored = graph.GetOrCreateNodeArg(
+              graph.GenerateNodeArgName(activation->Name() + "_restored"), activation->TypeAsProto());
+          Node& restore_node = graph.AddNode(graph.GenerateNodeName(activation->Name() + "_restore"), "Cast",
+                                             "restore the activation stored in 16 bits", {&stored}, {&restored});
+          restore_node.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+          restore_node.SetExecutionProviderType(node.GetExecutionProviderType());
+          graph.AddEdge(compress.Index(), restore_node.Index(), 0, 0);
+          restore = restore_nodes.emplace(edge.dst_node, &restore_node).first;
+        }
+
+        Node& consumer = *graph.GetNode(edge.dst_node);
+        graph_utils::ReplaceNodeInput(consumer, edge.dst_arg_index, *restore->second->MutableOutputDefs()[0]);
+        graph.AddEdge(restore->second->Index(), edge.dst_node, 0, edge.dst_arg_index);
+      }
+
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ActivationStorageCompression
+
+Stores the large float activations that stay alive while other nodes run as float16 or bfloat16,
+halving the memory they take in the arena and the bandwidth spent writing and reading them:
+
+  X = Producer(...), Consumer_0(X, ...), ..., Consumer_n(X, ...)
+    -> X = Producer(...), X_16 = Cast(X),
+       Consumer_0(Cast(X_16), ...), ..., Consumer_n(Cast(X_16), ...)
+
+X_16 is converted back to float right before each consumer, so the float copies are short lived
+and the kernels still compute in single precision. Only activations with a static shape of at
+least min_bytes, whose producer and consumers all run on the compatible execution providers and
+that are not graph outputs, are compressed. The conversions round the activations, which changes
+the results, so this is only enabled on request.
+*/
+class ActivationStorageCompression : public GraphTransformer {
+ public:
+  ActivationStorageCompression(ONNX_NAMESPACE::TensorProto_DataType storage_type, size_t min_bytes,
+                               const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ActivationStorageCompression", compatible_execution_providers),
+        storage_type_(storage_type),
+        min_bytes_(min_bytes) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  // TensorProto_DataType_FLOAT16 or TensorProto_DataType_BFLOAT16
+  ONNX_NAMESPACE::TensorProto_DataType storage_type_;
+  size_t min_bytes_;
+};
+
+}  // namespace onnxruntime
@@ -18,6 +18,8 @@ class BiasDropoutFusion : public GraphTransformer {
   BiasDropoutFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("BiasDropoutFusion", compatible_execution_providers) {}
 
+  bool SupportsParallelSubgraphs() const override { return true; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -16,6 +16,8 @@ class BiasSoftmaxFusion : public GraphTransformer {
   BiasSoftmaxFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("BiasSoftmaxFusion", compatible_execution_providers) {}
 
+  bool SupportsParallelSubgraphs() const override { return true; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -2,11 +2,17 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/constant_folding.h"
+
+#include <atomic>
+#include <fstream>
+
+#include "core/common/path.h"
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 using namespace onnxruntime::common;
 
@@ -15,11 +21,101 @@ namespace onnxruntime {
 ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  bool skip_dequantize_linear,
                                  const std::unordered_set<std::string>& compatible_execution_providers,
-                                 const std::unordered_set<std::string>& excluded_initializers) noexcept
+                                 const std::unordered_set<std::string>& excluded_initializers,
+                                 float max_output_to_input_ratio,
+                                 const std::string& spill_directory,
+                                 size_t spill_threshold_bytes) noexcept
     : GraphTransformer("ConstantFolding", compatible_execution_providers),
       skip_dequantize_linear_(skip_dequantize_linear),
       excluded_initializers_(excluded_initializers),
-      execution_provider_(execution_provider) {
+      execution_provider_(execution_provider),
+      max_output_to_input_ratio_(max_output_to_input_ratio),
+      spill_directory_(spill_directory),
+      spill_threshold_bytes_(spill_threshold_bytes) {
+}
+
+// Returns the total size of the node's outputs if their types and shapes have been inferred, or 0 if unknown.
+static size_t EstimateOutputBytes(const Node& node) {
+  size_t total_bytes = 0;
+  for (const auto* output_def : node.OutputDefs()) {
+    if (!output_def->Exists()) {
+      continue;
+    }
+
+    const auto* type = output_def->TypeAsProto();
+    const auto* shape = output_def->Shape();
+    if (type == nullptr || !utils::HasTensorType(*type) || shape == nullptr) {
+      return 0;
+    }
+
+    ONNX_NAMESPACE::TensorProto output_proto;
+    output_proto.set_data_type(type->tensor_type().elem_type());
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim)) {
+        return 0;
+      }
+      output_proto.add_dims(dim.dim_value());
+    }
+
+    size_t output_bytes = 0;
+    if (output_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        !utils::GetSizeInBytesFromTensorProto<0>(output_proto, &output_bytes).IsOK()) {
+      return 0;
+    }
+
+    total_bytes += output_bytes;
+  }
+
+  return total_bytes;
+}
+
+bool ConstantFolding::ExceedsOutputSizeLimit(size_t input_bytes, size_t output_bytes) const {
+  return max_output_to_input_ratio_ > 0.f &&
+         output_bytes >= kMinLimitedOutputBytes &&
+         static_cast<double>(output_bytes) > static_cast<double>(max_output_to_input_ratio_) * input_bytes;
+}
+
+// Adds the folded value as an initializer. If spilling is enabled and the value is large, it is written to a file
+// in spill_directory_ and the initializer refers to the memory mapped file, so the data is paged in from the file
+// when used instead of being held in the heap by the TensorProto.
+Status ConstantFolding::AddFoldedInitializer(Graph& graph, const Tensor& tensor, const std::string& name) const {
+  const size_t num_bytes = tensor.SizeInBytes();
+  if (spill_directory_.empty() || num_bytes == 0 || num_bytes < spill_threshold_bytes_ || tensor.IsDataTypeString()) {
+    graph.AddInitializedTensor(utils::TensorToTensorProto(tensor, name));
+    return Status::OK();
+  }
+
+  static std::atomic<uint64_t> spill_file_count{0};
+  const std::string file_name = "ort_constant_folding_" + std::to_string(Env::Default().GetSelfPid()) + "_" +
+                                std::to_string(spill_file_count++) + ".bin";
+
+  Path directory, file;
+  ORT_RETURN_IF_ERROR(Path::Parse(ToPathString(spill_directory_), directory));
+  ORT_RETURN_IF_ERROR(Path::Parse(ToPathString(file_name), file));
+  const PathString file_path = (directory / file).ToPathString();
+
+  {
+    std::ofstream spill_file(file_path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    ORT_RETURN_IF_NOT(spill_file.is_open(), "Failed to create constant folding spill file in ", spill_directory_);
+    spill_file.write(static_cast<const char*>(tensor.DataRaw()), static_cast<std::streamsize>(num_bytes));
+    ORT_RETURN_IF_NOT(spill_file.good(), "Failed to write constant folding spill file in ", spill_directory_);
+  }
+
+  Env::MappedMemoryPtr mapped_data;
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(file_path.c_str(), 0, num_bytes, mapped_data));
+
+  ONNX_NAMESPACE::TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(tensor.GetElementType());
+  for (auto dim : tensor.Shape().GetDims()) {
+    tensor_proto.add_dims(dim);
+  }
+
+  utils::SetExternalDataMemoryAddress(tensor_proto, mapped_data.get(), num_bytes);
+  spilled_data_.push_back(std::move(mapped_data));
+  graph.AddInitializedTensor(tensor_proto);
+
+  return Status::OK();
 }
 
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
@@ -57,117 +153,190 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
   return is_concrete_shape;  // convert to constant if this is true
 }
 
-Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
-  bool have_updated_nodes = false;
-  GraphViewer graph_viewer(graph);
-  auto& order = graph_viewer.GetNodesInTopologicalOrder();
-
-  for (NodeIndex i : order) {
-    auto* node = graph.GetNode(i);
-    if (!node) {
-      continue;
+// Computes the outputs of a node whose inputs are all constant.
+// outputs is left empty if the node cannot be folded.
+Status ConstantFolding::ComputeConstantNode(const Graph& graph, Node& node, const InitializedTensorSet& constant_inputs,
+                                            const logging::Logger& logger, std::vector<OrtValue>& outputs) const {
+  size_t input_bytes = 0;
+  if (max_output_to_input_ratio_ > 0.f) {
+    for (const auto& constant_input : constant_inputs) {
+      size_t num_bytes = 0;
+      if (utils::GetSizeInBytesFromTensorProto<0>(*constant_input.second, &num_bytes).IsOK()) {
+        input_bytes += num_bytes;
+      }
     }
 
-    // avoid to constant fold DequantizeLinear for QDQ format
-    if (skip_dequantize_linear_ && node->OpType().compare("DequantizeLinear") == 0) {
-      continue;
+    // check the inferred output shapes first to avoid computing outputs that will be discarded
+    if (ExceedsOutputSizeLimit(input_bytes, EstimateOutputBytes(node))) {
+      LOGS(logger, INFO) << "Not constant folding " << node.OpType() << " node '" << node.Name()
+                         << "' as its outputs would be much larger than its inputs";
+      return Status::OK();
     }
+  }
 
-    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+  // Create execution frame for executing constant nodes.
+  OptimizerExecutionFrame::Info info({&node}, constant_inputs, graph.ModelPath(), execution_provider_);
 
-    // Updating a node may allow shape inferencing to infer output shapes of following nodes,
-    // so re-run the shape inferencing. use have_updated_nodes as that only applies to this Graph
-    // (vs. 'modified' which is passed into subgraphs and applies to the main graph and all subgraphs)
-    // Ignore any control flow node containing subgraphs as UpdateShapeInference is not intended to be used on it.
-    if (have_updated_nodes && !node->ContainsSubgraph()) {
-      ORT_RETURN_IF_ERROR(graph.UpdateShapeInference(*node));
-    }
+  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node_out : node.OutputDefs()) {
+    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+  }
 
-    bool converted_to_constant = false;
-    if (node->OpType().compare("Shape") == 0) {
-      converted_to_constant = ConstantFoldShapeNode(graph, *node);
-    } else {
-      InitializedTensorSet constant_inputs;
-
-      // we currently constant fold using the CPU EP only.
-      // if the node is assigned to a different EP we can run it if it's an ONNX op as we have CPU based
-      // implementations for all ONNX ops. If the node/op is from a different op domain or if the CPU implementation
-      // does not support the specific input type(s) required by the node (currently we only support a subset of
-      // types in some CPU kernels) then we can't proceed with constant folding for the node.
-      auto ep_type = node->GetExecutionProviderType();
-      bool cpu_ep = ep_type == kCpuExecutionProvider;
-      if (!cpu_ep && node->Domain() != kOnnxDomain) {
-        continue;
-      }
+  // override the EP assigned to the node so that it will use the CPU kernel for Compute.
+  auto ep_type = node.GetExecutionProviderType();
+  bool cpu_ep = ep_type == kCpuExecutionProvider;
+  if (!cpu_ep) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
 
-      // Check if constant folding can be applied on this node.
-      if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) ||
-          !optimizer_utils::IsOperationDeterministic(node->Domain(), node->OpType()) ||
-          // constant folding does not support executing a node that includes subgraphs (control flow operators,
-          // such as If/Loop/Scan, fall into this category). individual nodes in the subgraph will be processed
-          // by the Recurse call above
-          node->ContainsSubgraph() || !graph_utils::AllNodeInputsAreConstant(graph, *node, constant_inputs, excluded_initializers_)) {
-        continue;
-      }
+  auto kernel = info.CreateKernel(&node);
 
-      // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_);
+  // undo the EP change to the value that was assigned at graph partitioning time
+  if (!cpu_ep) {
+    node.SetExecutionProviderType(ep_type);
+  }
 
-      std::vector<int> fetch_mlvalue_idxs;
-      for (const auto* node_out : node->OutputDefs()) {
-        fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
-      }
+  if (kernel == nullptr) {
+    LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
+                          << "can't constant fold " << node.OpType() << " node '" << node.Name() << "'";
 
-      // override the EP assigned to the node so that it will use the CPU kernel for Compute.
-      if (!cpu_ep) {
-        node->SetExecutionProviderType(kCpuExecutionProvider);
-      }
+    // Move on to the next candidate node
+    return Status::OK();
+  }
 
-      auto kernel = info.CreateKernel(node);
+  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
 
-      // undo the EP change to the value that was assigned at graph partitioning time
-      if (!cpu_ep) {
-        node->SetExecutionProviderType(ep_type);
-      }
+  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger);
+  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
 
-      if (kernel == nullptr) {
-        LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
-                              << "can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
+  // Go over all output node args and substitute them with the newly computed tensors, which will be
+  // added to the graph as initializers.
+  ORT_ENFORCE(fetches.size() == node.OutputDefs().size());
+  size_t output_bytes = 0;
+  for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+    OrtValue& ort_value = fetches[fetch_idx];
+
+    if (!ort_value.IsTensor()) {
+      LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
+                            << ". Can't constant fold " << node.OpType() << " node '" << node.Name() << "'";
+      return Status::OK();
+    }
+
+    output_bytes += ort_value.Get<Tensor>().SizeInBytes();
+  }
+
+  if (ExceedsOutputSizeLimit(input_bytes, output_bytes)) {
+    LOGS(logger, INFO) << "Not constant folding " << node.OpType() << " node '" << node.Name() << "' as its "
+                       << output_bytes << " bytes of outputs are much larger than its " << input_bytes
+                       << " bytes of inputs";
+    return Status::OK();
+  }
 
-        // Move on to the next candidate node
+  outputs = std::move(fetches);
+  return Status::OK();
+}
+
+Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  // Without a thread pool each constant node is computed when the topological traversal reaches it, so a chain of
+  // constant nodes is folded in a single pass.
+  // With a thread pool, the nodes whose inputs are all constant are collected instead. They are independent of each
+  // other, so they are computed concurrently and folded in the next pass, which may make their consumers constant.
+  // Passes are repeated until no more nodes can be folded.
+  concurrency::ThreadPool* thread_pool = GetThreadPool();
+  const bool compute_concurrently = concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1;
+
+  // outputs computed concurrently, by node. empty for nodes that cannot be folded.
+  std::unordered_map<NodeIndex, std::vector<OrtValue>> computed_outputs;
+
+  // initializers added by folding, with the number of consumers that have not been folded yet.
+  // an initializer is removed when its last consumer is folded so intermediate values do not stay in the graph
+  // until the next CleanUnusedInitializers call. graph outputs are not tracked as they must be kept.
+  std::unordered_map<std::string, size_t> pending_consumers;
+
+  for (bool first_pass = true;; first_pass = false) {
+    std::vector<std::pair<NodeIndex, InitializedTensorSet>> candidates;
+    bool have_updated_nodes = false;
+    GraphViewer graph_viewer(graph);
+    auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+    for (NodeIndex i : order) {
+      auto* node = graph.GetNode(i);
+      if (!node) {
         continue;
       }
 
-      OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
+      // avoid to constant fold DequantizeLinear for QDQ format
+      if (skip_dequantize_linear_ && node->OpType().compare("DequantizeLinear") == 0) {
+        continue;
+      }
 
-      OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger);
-      ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+      if (first_pass) {
+        ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+      }
 
-      std::vector<OrtValue> fetches;
-      ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
+      // Updating a node may allow shape inferencing to infer output shapes of following nodes,
+      // so re-run the shape inferencing. use have_updated_nodes as that only applies to this Graph
+      // (vs. 'modified' which is passed into subgraphs and applies to the main graph and all subgraphs)
+      // Ignore any control flow node containing subgraph as UpdateShapeInference is not intended to be used on it.
+      if (have_updated_nodes && !node->ContainsSubgraph()) {
+        ORT_RETURN_IF_ERROR(graph.UpdateShapeInference(*node));
+      }
 
-      // Go over all output node args and substitute them with the newly computed tensors, which will be
-      // added to the graph as initializers.
-      ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
-      converted_to_constant = true;
-      for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-        OrtValue& ort_value = fetches[fetch_idx];
+      bool converted_to_constant = false;
+      if (node->OpType().compare("Shape") == 0) {
+        converted_to_constant = ConstantFoldShapeNode(graph, *node);
+      } else {
+        InitializedTensorSet constant_inputs;
+
+        // we currently constant fold using the CPU EP only.
+        // if the node is assigned to a different EP we can run it if it's an ONNX op as we have CPU based
+        // implementations for all ONNX ops. If the node/op is from a different op domain or if the CPU
+        // implementation does not support the specific input type(s) required by the node (currently we only
+        // support a subset of types in some CPU kernels) then we can't proceed with constant folding for the node.
+        auto ep_type = node->GetExecutionProviderType();
+        bool cpu_ep = ep_type == kCpuExecutionProvider;
+        if (!cpu_ep && node->Domain() != kOnnxDomain) {
+          continue;
+        }
 
-        if (!ort_value.IsTensor()) {
-          LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
-                                << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
-          converted_to_constant = false;
-          break;
+        // Check if constant folding can be applied on this node.
+        if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) ||
+            !optimizer_utils::IsOperationDeterministic(node->Domain(), node->OpType()) ||
+            // constant folding does not support executing a node that includes subgraphs (control flow operators,
+            // such as If/Loop/Scan, fall into this category). individual nodes in the subgraph will be processed
+            // by the Recurse call above
+            node->ContainsSubgraph() ||
+            !graph_utils::AllNodeInputsAreConstant(graph, *node, constant_inputs, excluded_initializers_)) {
+          continue;
         }
-      }
 
-      if (converted_to_constant) {
+        std::vector<OrtValue> fetches;
+        auto computed = computed_outputs.find(i);
+        if (computed != computed_outputs.end()) {
+          fetches = std::move(computed->second);
+          if (fetches.empty()) {
+            continue;
+          }
+          computed_outputs.erase(computed);
+        } else if (compute_concurrently) {
+          candidates.emplace_back(i, std::move(constant_inputs));
+          continue;
+        } else {
+          ORT_RETURN_IF_ERROR(ComputeConstantNode(graph, *node, constant_inputs, logger, fetches));
+          if (fetches.empty()) {
+            continue;
+          }
+        }
+
+        converted_to_constant = true;
         for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
           OrtValue& ort_value = fetches[fetch_idx];
           // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
           auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
           const Tensor& out_tensor = ort_value.Get<Tensor>();
-          ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
 
           ONNX_NAMESPACE::TensorShapeProto result_shape;
           for (auto& dim : out_tensor.Shape().GetDims()) {
@@ -175,28 +344,88 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
           }
 
           constant_arg_out->SetShape(result_shape);
-          graph.AddInitializedTensor(out_tensorproto);
+          ORT_RETURN_IF_ERROR(AddFoldedInitializer(graph, out_tensor, constant_arg_out->Name()));
+
+          // release the computed value now that the initializer holds the data
+          ort_value = OrtValue();
+
+          if (!graph.IsOutput(constant_arg_out)) {
+            size_t num_consumers = 0;
+            for (auto edge = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); edge != end; ++edge) {
+              if (edge->GetSrcArgIndex() == static_cast<int>(fetch_idx)) {
+                ++num_consumers;
+              }
+            }
+
+            pending_consumers[constant_arg_out->Name()] = num_consumers;
+          }
+        }
+      }
+
+      if (converted_to_constant) {
+        // Remove the initializers produced by earlier folds that have no consumers left once this node is removed
+        for (const auto* input_def : node->InputDefs()) {
+          auto pending = pending_consumers.find(input_def->Name());
+          if (pending != pending_consumers.end() && --pending->second == 0) {
+            graph.RemoveInitializedTensor(pending->first);
+            pending_consumers.erase(pending);
+          }
+        }
+
+        // Remove single-output node chain for inputs of the node
+        auto p_ip_node = node->InputNodesBegin();
+        const auto p_ip_node_end = node->InputNodesEnd();
+        while (p_ip_node != p_ip_node_end) {
+          const auto& input_node = *p_ip_node;
+          // Update the node iterator before removing the corresponding node because removing
+          // the node will invalidate the node iterator
+          ++p_ip_node;
+          graph_utils::RemoveNodesWithOneOutputBottomUp(graph, input_node);
         }
+
+        // Remove the output edges of the constant node and then remove the node itself.
+        graph_utils::RemoveNodeOutputEdges(graph, *node);
+        graph.RemoveNode(node->Index());
+        modified = true;
+        have_updated_nodes = true;
       }
     }
 
-    if (converted_to_constant) {
-      // Remove single-output node chain for inputs of the node
-      auto p_ip_node = node->InputNodesBegin();
-      const auto p_ip_node_end = node->InputNodesEnd();
-      while (p_ip_node != p_ip_node_end) {
-        const auto& input_node = *p_ip_node;
-        // Update the node iterator before removing the corresponding node because removing
-        // the node will invalidate the node iterator
-        ++p_ip_node;
-        graph_utils::RemoveNodesWithOneOutputBottomUp(graph, input_node);
+    // folding a Shape node may have removed the candidate producing its input
+    std::vector<std::pair<Node*, const InitializedTensorSet*>> nodes_to_compute;
+    for (const auto& candidate : candidates) {
+      auto* node = graph.GetNode(candidate.first);
+      if (node != nullptr) {
+        nodes_to_compute.emplace_back(node, &candidate.second);
       }
+    }
+
+    if (nodes_to_compute.empty()) {
+      break;
+    }
+
+    const auto num_nodes = nodes_to_compute.size();
+    std::vector<Status> statuses(num_nodes);
+    std::vector<std::vector<OrtValue>> outputs(num_nodes);
+    concurrency::ThreadPool::TryBatchParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(num_nodes),
+        [&](std::ptrdiff_t n) {
+          ORT_TRY {
+            statuses[n] = ComputeConstantNode(graph, *nodes_to_compute[n].first, *nodes_to_compute[n].second, logger,
+                                              outputs[n]);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              statuses[n] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Constant folding of node '",
+                                            nodes_to_compute[n].first->Name(), "' failed: ", ex.what());
+            });
+          }
+        },
+        0);
 
-      // Remove the output edges of the constant node and then remove the node itself.
-      graph_utils::RemoveNodeOutputEdges(graph, *node);
-      graph.RemoveNode(node->Index());
-      modified = true;
-      have_updated_nodes = true;
+    for (size_t n = 0; n < num_nodes; ++n) {
+      ORT_RETURN_IF_ERROR(statuses[n]);
+      computed_outputs[nodes_to_compute[n].first->Index()] = std::move(outputs[n]);
     }
   }
 
@@ -6,7 +6,9 @@
 #include "core/optimizer/graph_transformer.h"
 #include "core/framework/ml_value.h"
 #include <memory>
+#include <vector>
 #include "core/framework/execution_provider.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime {
 
@@ -15,24 +17,55 @@ namespace onnxruntime {
 
 Transformer that traverses the graph top-down and performs constant folding, i.e.,
 it statically computes parts of the graph that rely only on constant initializers.
+If Apply is given a thread pool, independent constant nodes are computed concurrently.
+
+The memory used by the folded initializers can be bounded. Nodes whose outputs are much larger than their inputs
+(e.g. Expand or Tile of a small constant) can be left in the graph, initializers that were only consumed by other
+folded nodes are removed as soon as their last consumer is folded, and large folded initializers can be written to
+files that are memory mapped instead of being kept in the process heap.
 */
 class ConstantFolding : public GraphTransformer {
  public:
   /*! Constant folding will not be applied to nodes that have one of initializers from excluded_initializers as input.
       For pre-training, the trainable weights are those initializers to be excluded.
       \param execution_provider Execution provider instance to execute constant folding.
+      \param max_output_to_input_ratio If greater than 0, a node is not folded if its outputs are larger than this
+      many times the size of its inputs and larger than kMinLimitedOutputBytes.
+      \param spill_directory If not empty, folded initializers of at least spill_threshold_bytes bytes are written to
+      files in this directory and the graph refers to the memory mapped files. The mappings are owned by this
+      instance, so it must outlive the graph and any session state created from it.
   */
   ConstantFolding(const IExecutionProvider& execution_provider,
                   bool skip_dequantize_linear,
                   const std::unordered_set<std::string>& compatible_execution_providers = {},
-                  const std::unordered_set<std::string>& excluded_initializers = {}) noexcept;
+                  const std::unordered_set<std::string>& excluded_initializers = {},
+                  float max_output_to_input_ratio = 0.f,
+                  const std::string& spill_directory = {},
+                  size_t spill_threshold_bytes = 0) noexcept;
+
+  // Outputs smaller than this are always folded regardless of max_output_to_input_ratio, so that e.g. a
+  // ConstantOfShape producing a small tensor from a scalar is still folded.
+  static constexpr size_t kMinLimitedOutputBytes = 1024 * 1024;
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
+  Status ComputeConstantNode(const Graph& graph, Node& node, const InitializedTensorSet& constant_inputs,
+                             const logging::Logger& logger, std::vector<OrtValue>& outputs) const;
+
+  bool ExceedsOutputSizeLimit(size_t input_bytes, size_t output_bytes) const;
+
+  Status AddFoldedInitializer(Graph& graph, const Tensor& tensor, const std::string& name) const;
+
   bool skip_dequantize_linear_;
   const std::unordered_set<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
+  const float max_output_to_input_ratio_;
+  const std::string spill_directory_;
+  const size_t spill_threshold_bytes_;
+
+  // memory mapped files holding the spilled initializers. the graph refers to their data in place.
+  mutable std::vector<Env::MappedMemoryPtr> spilled_data_;
 };
 
 }  // namespace onnxruntime
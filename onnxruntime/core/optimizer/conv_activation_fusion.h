@@ -12,6 +12,8 @@ class ConvActivationFusion : public GraphTransformer {
   ConvActivationFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("ConvActivationFusion", compatible_execution_providers) {}
 
+  bool SupportsParallelSubgraphs() const override { return true; }
+
  private:
   Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
@@ -0,0 +1,260 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include <map>
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// limits of the FusedElementwise kernel
+constexpr size_t kMaxFusedInputs = 8;
+constexpr size_t kMaxFusedNodes = 16;
+
+struct FusableOp {
+  std::vector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+  bool is_binary;
+};
+
+const std::unordered_map<std::string, FusableOp>& FusableOps() {
+  static const std::unordered_map<std::string, FusableOp> ops = {
+      {"Add", {{7, 13, 14}, true}},
+      {"Sub", {{7, 13, 14}, true}},
+      {"Mul", {{7, 13, 14}, true}},
+      {"Div", {{7, 13, 14}, true}},
+      {"Abs", {{6, 13}, false}},
+      {"Erf", {{9, 13}, false}},
+      {"Exp", {{6, 13}, false}},
+      {"Log", {{6, 13}, false}},
+      {"Neg", {{6, 13}, false}},
+      {"Reciprocal", {{6, 13}, false}},
+      {"Relu", {{6, 13, 14}, false}},
+      {"Sigmoid", {{6, 13}, false}},
+      {"Sqrt", {{6, 13}, false}},
+      {"Tanh", {{6, 13}, false}},
+  };
+  return ops;
+}
+
+int32_t GetElemType(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return TensorProto_DataType_UNDEFINED;
+  }
+  return type->tensor_type().elem_type();
+}
+
+// Returns the element type of the node if it is an elementwise node that can be fused, else UNDEFINED.
+int32_t GetFusableElemType(const Node& node, const std::unordered_set<std::string>& compatible_providers) {
+  const auto op = FusableOps().find(node.OpType());
+  if (op == FusableOps().end() ||
+      !graph_utils::MatchesOpSetDomain(node, kOnnxDomain) ||
+      !graph_utils::MatchesOpSinceVersion(node, op->second.versions) ||
+      !graph_utils::IsSupportedProvider(node, compatible_providers) ||
+      node.OutputDefs().size() != 1) {
+    return TensorProto_DataType_UNDEFINED;
+  }
+
+  const int32_t elem_type = GetElemType(*node.OutputDefs()[0]);
+  if (elem_type != TensorProto_DataType_FLOAT &&
+      (elem_type != TensorProto_DataType_FLOAT16 || node.GetExecutionProviderType() == kCpuExecutionProvider)) {
+    return TensorProto_DataType_UNDEFINED;
+  }
+  for (const NodeArg* input : node.InputDefs()) {
+    if (GetElemType(*input) != elem_type) {
+      return TensorProto_DataType_UNDEFINED;
+    }
+  }
+  return elem_type;
+}
+
+// Checks that the result of the last of the first length nodes of the group is the only value of these nodes
+// used outside of them.
+bool HasSingleResult(const Graph& graph, const std::vector<const Node*>& group, size_t length) {
+  std::unordered_set<NodeIndex> members;
+  for (size_t i = 0; i < length; ++i) {
+    members.insert(group[i]->Index());
+  }
+
+  for (size_t i = 0; i + 1 < length; ++i) {
+    if (!graph.GetNodeOutputsInGraphOutputs(*group[i]).empty()) {
+      return false;
+    }
+    for (auto it = group[i]->OutputNodesBegin(); it != group[i]->OutputNodesEnd(); ++it) {
+      if (members.count(it->Index()) == 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_map<NodeIndex, size_t> topological_positions;
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    topological_positions[node_topology_list[i]] = i;
+  }
+
+  // The groups are all found on the original graph before any of them is fused, as whether the inputs of a node
+  // depend on a group is decided from the edges between the nodes.
+  std::unordered_set<NodeIndex> claimed;
+  std::vector<std::vector<const Node*>> groups;
+
+  for (size_t seed_position = 0; seed_position < node_topology_list.size(); ++seed_position) {
+    auto* node_ptr = graph.GetNode(node_topology_list[seed_position]);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (claimed.count(node.Index()) != 0) {
+      continue;
+    }
+
+    const int32_t elem_type = GetFusableElemType(node, GetCompatibleExecutionProviders());
+    if (elem_type == TensorProto_DataType_UNDEFINED) {
+      continue;
+    }
+
+    // grow the group from the node by adding consumers of its values
+    std::vector<const Node*> group{&node};
+    std::unordered_set<NodeIndex> members{node.Index()};
+    std::unordered_set<const NodeArg*> values{node.OutputDefs()[0]};
+    std::unordered_set<const NodeArg*> inputs(node.InputDefs().begin(), node.InputDefs().end());
+
+    while (group.size() < kMaxFusedNodes) {
+      std::map<size_t, const Node*> consumers;
+      for (const Node* member : group) {
+        for (auto it = member->OutputNodesBegin(); it != member->OutputNodesEnd(); ++it) {
+          if (members.count(it->Index()) == 0) {
+            consumers.emplace(topological_positions[it->Index()], &*it);
+          }
+        }
+      }
+
+      const Node* next = nullptr;
+      for (const auto& entry : consumers) {
+        const Node& consumer = *entry.second;
+        if (claimed.count(consumer.Index()) != 0 ||
+            consumer.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+            GetFusableElemType(consumer, GetCompatibleExecutionProviders()) != elem_type) {
+          continue;
+        }
+
+        // The other inputs of the consumer must not depend on the group, or the fused node would be part of a
+        // cycle. This is certain when the consumer is the only one outside of the group, or when the inputs are
+        // produced before the first node of the group.
+        bool independent = true;
+        std::unordered_set<const NodeArg*> new_inputs;
+        for (const NodeArg* input : consumer.InputDefs()) {
+          if (values.count(input) != 0 || inputs.count(input) != 0) {
+            continue;
+          }
+          new_inputs.insert(input);
+          const Node* producer = graph.GetProducerNode(input->Name());
+          if (consumers.size() > 1 && producer != nullptr) {
+            const auto position = topological_positions.find(producer->Index());
+            independent = independent && position != topological_positions.end() && position->second < seed_position;
+          }
+        }
+
+        if (independent && inputs.size() + new_inputs.size() <= kMaxFusedInputs) {
+          inputs.insert(new_inputs.begin(), new_inputs.end());
+          next = &consumer;
+          break;
+        }
+      }
+
+      if (next == nullptr) {
+        break;
+      }
+      group.push_back(next);
+      members.insert(next->Index());
+      values.insert(next->OutputDefs()[0]);
+    }
+
+    // keep the longest part of the group that only has one result
+    size_t length = group.size();
+    while (length >= 2 && !HasSingleResult(graph, group, length)) {
+      --length;
+    }
+    if (length < 2) {
+      continue;
+    }
+
+    group.resize(length);
+    for (const Node* member : group) {
+      claimed.insert(member->Index());
+    }
+    groups.push_back(std::move(group));
+  }
+
+  for (const auto& group : groups) {
+    std::unordered_set<const NodeArg*> results;
+    for (const Node* member : group) {
+      results.insert(member->OutputDefs()[0]);
+    }
+
+    // the inputs are the first values of the program, followed by the result of each node
+    std::vector<NodeArg*> input_defs;
+    std::unordered_map<const NodeArg*, int64_t> value_indices;
+    for (const Node* member : group) {
+      for (const NodeArg* input : member->InputDefs()) {
+        if (results.count(input) == 0 && value_indices.count(input) == 0) {
+          value_indices[input] = static_cast<int64_t>(input_defs.size());
+          input_defs.push_back(graph.GetNodeArg(input->Name()));
+        }
+      }
+    }
+
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    for (const Node* member : group) {
+      const auto& member_inputs = member->InputDefs();
+      const int64_t first = value_indices.at(member_inputs[0]);
+      const int64_t second = FusableOps().at(member->OpType()).is_binary ? value_indices.at(member_inputs[1]) : first;
+      ops.push_back(member->OpType());
+      operands.push_back(first);
+      operands.push_back(second);
+      value_indices[member->OutputDefs()[0]] = static_cast<int64_t>(input_defs.size() + ops.size() - 1);
+    }
+
+    Node* last = graph.GetNode(group.back()->Index());
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused elementwise nodes ending with " + last->Name(),
+                                     input_defs,
+                                     {last->MutableOutputDefs()[0]},
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+
+    // Assign provider to this new node. Provider should be same as the provider for old nodes.
+    fused_node.SetExecutionProviderType(last->GetExecutionProviderType());
+
+    for (const Node* member : group) {
+      Node* node = graph.GetNode(member->Index());
+      graph_utils::RemoveNodeOutputEdges(graph, *node);
+      graph.RemoveNode(node->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseFusion
+
+Fuses connected float or float16 elementwise nodes (Add, Sub, Mul, Div and the unary math and activation ops)
+into a single FusedElementwise node, whose kernel reads each input once and writes only the final result
+instead of making a full pass over memory for every node:
+
+  Add(X, B) -> Sigmoid -> Mul(Add output, Sigmoid output) -> Mul(., S)
+    -> FusedElementwise(X, B, S)
+
+The fused nodes may have any number of consumers inside the group, but only the result of the last node may be
+used outside of it. On the CPU execution provider only float nodes are fused.
+
+The CPU instance runs after the layout transformers of Level3, which fuse Add and Relu into NCHWc convolutions,
+so it is registered under its own name.
+*/
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const std::unordered_set<std::string>& compatible_execution_providers = {},
+                    const std::string& name = "ElementwiseFusion") noexcept
+      : GraphTransformer(name, compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
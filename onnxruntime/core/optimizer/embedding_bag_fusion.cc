@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the single axis the Reduce node reduces over, or false if it reduces over none or several axes.
+bool GetSingleReduceAxis(const Graph& graph, const Node& reduce_node, int64_t& axis) {
+  std::vector<int64_t> axes;
+  if (reduce_node.SinceVersion() >= 13 && reduce_node.OpType() == "ReduceSum") {
+    // opset 13 ReduceSum takes the axes as an optional input
+    const auto& input_defs = reduce_node.InputDefs();
+    if (input_defs.size() < 2 || !input_defs[1]->Exists() ||
+        !optimizer_utils::AppendTensorFromInitializer(graph, *input_defs[1], axes, true)) {
+      return false;
+    }
+  } else if (!graph_utils::GetRepeatedNodeAttributeValues(reduce_node, "axes", axes)) {
+    return false;
+  }
+
+  if (axes.size() != 1) {
+    return false;
+  }
+
+  axis = axes[0];
+  return true;
+}
+
+}  // namespace
+
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& gather_node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(gather_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(gather_node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(gather_node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, gather_node, 1)) {
+      continue;
+    }
+
+    const auto* axis_attr = graph_utils::GetNodeAttribute(gather_node, "axis");
+    if (axis_attr != nullptr && axis_attr->i() != 0) {
+      continue;
+    }
+
+    const NodeArg* data_def = gather_node.InputDefs()[0];
+    const TypeProto* data_type = data_def->TypeAsProto();
+    if (data_type == nullptr || data_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+      continue;
+    }
+
+    // the rank of the indices tells which output axis holds the rows of a bag
+    const TensorShapeProto* indices_shape = gather_node.InputDefs()[1]->Shape();
+    if (indices_shape == nullptr || indices_shape->dim_size() < 1) {
+      continue;
+    }
+    const int64_t bag_axis = indices_shape->dim_size() - 1;
+
+    Node& reduce_node = *graph.GetNode(gather_node.OutputNodesBegin()->Index());
+    const bool is_sum = graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {1, 11, 13});
+    if ((!is_sum && !graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMean", {1, 11, 13})) ||
+        reduce_node.GetExecutionProviderType() != gather_node.GetExecutionProviderType() ||
+        reduce_node.InputDefs()[0] != gather_node.OutputDefs()[0]) {
+      continue;
+    }
+
+    int64_t reduce_axis = 0;
+    if (!GetSingleReduceAxis(graph, reduce_node, reduce_axis)) {
+      continue;
+    }
+    if (reduce_axis < 0) {
+      // the output rank of Gather is q + r - 1
+      const TensorShapeProto* data_shape = data_def->Shape();
+      if (data_shape == nullptr) {
+        continue;
+      }
+      reduce_axis += indices_shape->dim_size() + data_shape->dim_size() - 1;
+    }
+    if (reduce_axis != bag_axis) {
+      continue;
+    }
+
+    const auto* keepdims_attr = graph_utils::GetNodeAttribute(reduce_node, "keepdims");
+    const int64_t keepdims = keepdims_attr != nullptr ? keepdims_attr->i() : 1;
+
+    Node& embedding_bag_node = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"),
+                                             "EmbeddingBag",
+                                             "fused Gather and " + reduce_node.OpType(),
+                                             gather_node.MutableInputDefs(),
+                                             {},
+                                             {},
+                                             kMSDomain);
+    embedding_bag_node.AddAttribute("mode", std::string(is_sum ? "sum" : "mean"));
+    embedding_bag_node.AddAttribute("keepdims", keepdims);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    embedding_bag_node.SetExecutionProviderType(reduce_node.GetExecutionProviderType());
+
+    // move output definitions and edges from reduce_node to embedding_bag_node, delete gather_node and reduce_node
+    graph_utils::FinalizeNodeFusion(graph, {gather_node, reduce_node}, embedding_bag_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
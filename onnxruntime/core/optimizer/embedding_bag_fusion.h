@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class EmbeddingBagFusion
+
+Fuses a Gather of float rows along axis 0 followed by a ReduceSum or ReduceMean over the last axis of
+the indices into a single EmbeddingBag node:
+
+  ReduceSum(Gather(data, indices), axes=[q - 1]) -> EmbeddingBag(data, indices, mode="sum")
+
+This is the embedding bag lookup of recommendation models. The fused kernel accumulates the looked up
+rows directly into the output instead of writing the gathered tensor, which is the size of the whole
+bag of rows, and reading it back.
+*/
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -21,6 +21,8 @@ class GeluFusion : public GraphTransformer {
   GeluFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("GeluFusion", compatible_execution_providers) {}
 
+  bool SupportsParallelSubgraphs() const override { return true; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
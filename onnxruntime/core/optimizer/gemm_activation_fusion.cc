@@ -36,6 +36,19 @@ bool IsFusableActivation(const Node& node) {
 #endif
          IsSupportedOptypeVersionAndDomain(node, "ThresholdedRelu", {1, 10}, kOnnxDomain);
 }
+
+// The CUDA FusedGemm applies the activation in the epilogue of the cuBLASLt matrix multiplication, which supports
+// Relu and the tanh approximation of Gelu for float and float16.
+bool IsCudaFusableActivation(const Node& gemm_node, const Node& node) {
+  const auto elem_type = gemm_node.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (elem_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT &&
+      elem_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT16) {
+    return false;
+  }
+
+  return IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13}, kOnnxDomain) ||
+         (IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain) && node.InputDefs().size() == 1);
+}
 }  // namespace
 
 Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
@@ -57,7 +70,11 @@ Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
     }
 
     const Node& next_node = *(node.OutputNodesBegin());
-    if (!IsFusableActivation(next_node) || next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    if (next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      continue;
+    }
+    if (node.GetExecutionProviderType() == kCudaExecutionProvider ? !IsCudaFusableActivation(node, next_node)
+                                                                   : !IsFusableActivation(next_node)) {
       continue;
     }
 
@@ -3,16 +3,73 @@
 
 #include "core/optimizer/graph_transformer.h"
 
+#include "core/platform/threadpool.h"
+
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 
-Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logger& logger) const {
+#if !defined(ORT_MINIMAL_BUILD)
+Status GraphTransformer::ApplyToSubgraphsInParallel(Graph& graph, bool& modified,
+                                                    const logging::Logger& logger) const {
+  std::vector<Graph*> subgraphs;
+  for (auto& node : graph.Nodes()) {
+    for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
+      subgraphs.push_back(entry.second);
+    }
+  }
+
+  // leave a single subgraph to Recurse
+  if (subgraphs.size() < 2) {
+    return Status::OK();
+  }
+
+  const auto num_subgraphs = subgraphs.size();
+  std::vector<Status> statuses(num_subgraphs);
+  std::unique_ptr<bool[]> subgraph_modified(new bool[num_subgraphs]());
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool_, static_cast<std::ptrdiff_t>(num_subgraphs),
+      [&](std::ptrdiff_t i) {
+        ORT_TRY {
+          statuses[i] = ApplyImpl(*subgraphs[i], subgraph_modified[i], 1, logger);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, Name(), " failed on a subgraph: ", ex.what());
+          });
+        }
+      },
+      0);
+
+  for (size_t i = 0; i < num_subgraphs; ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    modified = modified || subgraph_modified[i];
+  }
+
+  main_graph_subgraphs_applied_ = true;
+  return Status::OK();
+}
+#endif
+
+Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logger& logger,
+                               concurrency::ThreadPool* thread_pool) const {
   // the Graph should be in a good state prior this being called, so there should be no need to call Resolve here
   // ORT_RETURN_IF_ERROR(graph.Resolve());
 
 #if !defined(ORT_MINIMAL_BUILD)
-  auto status = ApplyImpl(graph, modified, 0, logger);
+  thread_pool_ = thread_pool;
+  main_graph_subgraphs_applied_ = false;
+  auto reset_apply_state = gsl::finally([this]() {
+    thread_pool_ = nullptr;
+    main_graph_subgraphs_applied_ = false;
+  });
+
+  Status status;
+  if (SupportsParallelSubgraphs() && concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1) {
+    ORT_RETURN_IF_ERROR(ApplyToSubgraphsInParallel(graph, modified, logger));
+  }
+
+  status = ApplyImpl(graph, modified, 0, logger);
   ORT_RETURN_IF_ERROR(status);
 
   // At least currently, some transformers (InsertCastTransformer and MemcpyTransformer) need this to be called
@@ -24,6 +81,7 @@ Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logg
   ORT_UNUSED_PARAMETER(graph);
   ORT_UNUSED_PARAMETER(modified);
   ORT_UNUSED_PARAMETER(logger);
+  ORT_UNUSED_PARAMETER(thread_pool);
   Status status(ONNXRUNTIME, FAIL, "Transformers are not supported in this build");
 #endif
   return status;
@@ -19,7 +19,11 @@ common::Status GraphTransformerManager::GetSteps(unsigned& steps) const {
   return Status::OK();
 }
 
-common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const {
+common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger,
+                                                          concurrency::ThreadPool* thread_pool,
+                                                          profiling::Profiler* profiler) const {
+  const bool profiling = profiler != nullptr && profiler->SessionCreationProfilingEnabled();
+
   const auto& transformers = level_to_transformer_map_.find(level);
   if (transformers == level_to_transformer_map_.end()) {
     return Status::OK();
@@ -31,8 +35,20 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      TimePoint tp;
+      if (profiling) {
+        tp = profiler->Now();
+      }
+
       bool modified = false;
-      ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+      ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger, thread_pool));
+
+      if (profiling) {
+        profiler->EndTimeAndRecordPhase("graph_transformer_" + transformer->Name(), tp,
+                                        {{"level", std::to_string(static_cast<int>(level))},
+                                         {"step", std::to_string(step)},
+                                         {"modified", modified ? "1" : "0"}});
+      }
       graph_changed = graph_changed || modified;
     }
     if (!graph_changed) {
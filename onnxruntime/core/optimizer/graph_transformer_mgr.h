@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/logging/logging.h"
+#include "core/common/profiler.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/rewrite_rule.h"
@@ -26,8 +27,13 @@ class GraphTransformerManager {
   // Register a transformer with a level.
   common::Status Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level);
 
-  // Apply all transformers registered for the given level on the given graph
-  common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
+  // Apply all transformers registered for the given level on the given graph.
+  // If a thread pool is provided, transformers that support it transform independent subgraphs in parallel.
+  // If a profiler is provided, each application of a transformer is recorded as a phase of the session creation
+  // when the profiling of the session creation is enabled.
+  common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger,
+                                   concurrency::ThreadPool* thread_pool = nullptr,
+                                   profiling::Profiler* profiler = nullptr) const;
 
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
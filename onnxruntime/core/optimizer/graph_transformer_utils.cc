@@ -2,8 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_utils.h"
+#include "core/common/parse_string.h"
 
 #include "core/mlas/inc/mlas.h"
+#include "core/optimizer/activation_storage_compression.h"
 #include "core/optimizer/attention_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
@@ -17,7 +19,9 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
@@ -25,6 +29,7 @@
 #include "core/optimizer/gelu_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
 #include "core/optimizer/gemm_transpose_fusion.h"
+#include "core/optimizer/grouped_matmul_fusion.h"
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/layer_norm_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
@@ -39,6 +44,7 @@
 #include "core/optimizer/shape_to_initializer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
@@ -48,6 +54,10 @@
 #include "core/optimizer/matmul_transpose_fusion.h"
 #include "core/optimizer/bias_dropout_fusion.h"
 
+#ifdef ENABLE_TRAINING
+#include "orttraining/core/optimizer/megatron_transformer.h"
+#endif
+
 namespace onnxruntime {
 class IExecutionProvider;
 
@@ -136,13 +146,80 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
   bool disable_quant_qdq = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsDisableQuantQDQ, "0") == "1";
 #ifndef DISABLE_CONTRIB_OPS
   bool enable_gelu_approximation = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
+  bool enable_float_nhwc = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableFloatNhwc, "0") == "1";
+  bool enable_cpu_elementwise_fusion =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableCpuElementwiseFusion, "0") == "1";
+  bool nchwc_autotune = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsNchwcAutotune, "0") == "1";
+  std::string nchwc_tuning_file = session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsNchwcTuningFile, "");
 #endif
 
+  float constant_folding_max_output_ratio = 0.f;
+  const auto max_output_ratio_str = session_options.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigConstantFoldingMaxOutputToInputRatio, "0");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(max_output_ratio_str, constant_folding_max_output_ratio),
+              "Invalid value for ", kOrtSessionOptionsConfigConstantFoldingMaxOutputToInputRatio, ": ",
+              max_output_ratio_str);
+
+  // the saved optimized model could not refer to the memory mapped spill files, so only spill when not saving it
+  std::string constant_folding_spill_directory;
+  size_t constant_folding_spill_threshold = 0;
+  if (session_options.optimized_model_filepath.empty()) {
+    constant_folding_spill_directory = session_options.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigConstantFoldingSpillDirectory, "");
+    const auto spill_threshold_str = session_options.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigConstantFoldingSpillThresholdBytes, "1048576");
+    ORT_ENFORCE(TryParseStringWithClassicLocale(spill_threshold_str, constant_folding_spill_threshold),
+                "Invalid value for ", kOrtSessionOptionsConfigConstantFoldingSpillThresholdBytes, ": ",
+                spill_threshold_str);
+  }
+
+  ONNX_NAMESPACE::TensorProto_DataType cpu_activation_storage_type = ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+  size_t cpu_activation_storage_min_bytes = 0;
+  const auto cpu_activation_storage_type_str = session_options.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigCpuActivationStorageType, "");
+  if (!cpu_activation_storage_type_str.empty()) {
+    if (cpu_activation_storage_type_str == "float16") {
+      cpu_activation_storage_type = ONNX_NAMESPACE::TensorProto_DataType_FLOAT16;
+    } else if (cpu_activation_storage_type_str == "bfloat16") {
+      cpu_activation_storage_type = ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16;
+    } else {
+      ORT_THROW("Invalid value for ", kOrtSessionOptionsConfigCpuActivationStorageType, ": ",
+                cpu_activation_storage_type_str);
+    }
+    const auto min_bytes_str = session_options.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigCpuActivationStorageMinBytes, "1048576");
+    ORT_ENFORCE(TryParseStringWithClassicLocale(min_bytes_str, cpu_activation_storage_min_bytes),
+                "Invalid value for ", kOrtSessionOptionsConfigCpuActivationStorageMinBytes, ": ", min_bytes_str);
+  }
+
   switch (level) {
     case TransformerLevel::Level1: {
+#ifdef ENABLE_TRAINING
+      // partition the weights first, the patterns matched are those of the unoptimized graph
+      int32_t tensor_parallel_size = 1;
+      const auto tensor_parallel_size_str = session_options.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsConfigTensorParallelSize, "1");
+      ORT_ENFORCE(TryParseStringWithClassicLocale(tensor_parallel_size_str, tensor_parallel_size) &&
+                      tensor_parallel_size > 0,
+                  "Invalid value for ", kOrtSessionOptionsConfigTensorParallelSize, ": ", tensor_parallel_size_str);
+      if (tensor_parallel_size > 1) {
+        transformers.emplace_back(CreateMegatronInferenceTransformer(tensor_parallel_size, execution_provider));
+      }
+#else
+      ORT_ENFORCE(session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelSize,
+                                                                    "1") == "1",
+                  kOrtSessionOptionsConfigTensorParallelSize, " is only supported in training builds.");
+#endif
+
       // no filtering on execution provider for L1 optimizations as they only use official ONNX operators
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
-      transformers.emplace_back(std::make_unique<ConstantFolding>(execution_provider, !disable_quant_qdq));
+      transformers.emplace_back(std::make_unique<ConstantFolding>(execution_provider, !disable_quant_qdq,
+                                                                  std::unordered_set<std::string>{},
+                                                                  std::unordered_set<std::string>{},
+                                                                  constant_folding_max_output_ratio,
+                                                                  constant_folding_spill_directory,
+                                                                  constant_folding_spill_threshold));
+      transformers.emplace_back(std::make_unique<TransposeOptimizer>());
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
@@ -158,8 +235,11 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       rule_transformer = GenerateRuleBasedGraphTransformer(level, rules_and_transformers_to_disable, cpu_ep);
 
 #ifndef DISABLE_CONTRIB_OPS
+      const std::unordered_set<std::string> cuda_ep = {onnxruntime::kCudaExecutionProvider};
       const std::unordered_set<std::string> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
                                                              onnxruntime::kRocmExecutionProvider};
+      const std::unordered_set<std::string> cpu_cuda_eps = {onnxruntime::kCpuExecutionProvider,
+                                                            onnxruntime::kCudaExecutionProvider};
       const std::unordered_set<std::string> cpu_cuda_rocm_eps = {onnxruntime::kCpuExecutionProvider,
                                                                  onnxruntime::kCudaExecutionProvider,
                                                                  onnxruntime::kRocmExecutionProvider};
@@ -175,7 +255,7 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         transformers.emplace_back(std::make_unique<QDQTransformer>());
       }
 
-      transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_cuda_eps));
       transformers.emplace_back(std::make_unique<MatMulIntegerToFloatFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulFusion>(cpu_ep));
 
@@ -186,6 +266,7 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<SimplifiedLayerNormFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<AttentionFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(cpu_ep));
 
       transformers.emplace_back(std::make_unique<BiasDropoutFusion>(cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<MatmulTransposeFusion>(cpu_cuda_rocm_eps));
@@ -197,6 +278,12 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
       transformers.emplace_back(std::make_unique<MatMulScaleFusion>(cpu_cuda_rocm_eps));
 
+      // run after the other MatMul fusions so that only the remaining plain MatMul nodes are grouped
+      transformers.emplace_back(std::make_unique<GroupedMatMulFusion>(cpu_ep));
+
+      // run after the other fusions so that only the elementwise nodes they leave are fused
+      transformers.emplace_back(std::make_unique<ElementwiseFusion>(cuda_ep));
+
       // GeluApproximation has side effects which may change results. It needs to be manually enabled,
       // or alternatively the model can be updated offline using a model conversion script
       //   e.g. fusion_gelu_approximation function used by onnxruntime/python/tools/transformers/onnx_model_bert.py
@@ -209,13 +296,34 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
     case TransformerLevel::Level3: {
 #ifndef DISABLE_CONTRIB_OPS
+      // The NHWC layout transformer runs first if enabled for float convolutions,
+      // so that the NCHWc layout transformer only handles the nodes left over.
+      if (enable_float_nhwc) {
+        transformers.emplace_back(std::make_unique<NhwcTransformer>(true));
+      }
+
       // Register the NCHWc layout transformer if supported by the platform.
       if (MlasNchwcGetBlockSize() > 1) {
-        transformers.emplace_back(std::make_unique<NchwcTransformer>());
+        transformers.emplace_back(std::make_unique<NchwcTransformer>(nchwc_autotune, nchwc_tuning_file));
       }
 
-      transformers.emplace_back(std::make_unique<NhwcTransformer>());
+      if (!enable_float_nhwc) {
+        transformers.emplace_back(std::make_unique<NhwcTransformer>());
+      }
+
+      // fuse the elementwise nodes left on CPU once the layout transformers have fused theirs into convolutions
+      if (enable_cpu_elementwise_fusion) {
+        transformers.emplace_back(std::make_unique<ElementwiseFusion>(
+            std::unordered_set<std::string>{onnxruntime::kCpuExecutionProvider}, "CpuElementwiseFusion"));
+      }
 #endif
+
+      // run last so that only the activations left between the fused nodes are stored in 16 bits
+      if (cpu_activation_storage_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+        transformers.emplace_back(std::make_unique<ActivationStorageCompression>(
+            cpu_activation_storage_type, cpu_activation_storage_min_bytes,
+            std::unordered_set<std::string>{onnxruntime::kCpuExecutionProvider}));
+      }
     } break;
 
     default:
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/grouped_matmul_fusion.h"
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the number of rows of B if the node is a float MatMul with a constant 2-D initializer B
+// that can be run by the GroupedMatMul kernel, else -1.
+int64_t GetGroupableMatMulK(const Graph& graph, const Node& node,
+                            const std::unordered_set<std::string>& compatible_providers) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13}) ||
+      !graph_utils::IsSupportedProvider(node, compatible_providers)) {
+    return -1;
+  }
+
+  const TensorProto* b_proto = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name(), false);
+  if (b_proto == nullptr ||
+      b_proto->data_type() != TensorProto_DataType_FLOAT ||
+      b_proto->dims_size() != 2) {
+    return -1;
+  }
+
+  return b_proto->dims(0);
+}
+
+}  // namespace
+
+Status GroupedMatMulFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::unordered_set<NodeIndex> visited;
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (visited.count(node_index) != 0) {
+      continue;
+    }
+
+    const int64_t k = GetGroupableMatMulK(graph, node, GetCompatibleExecutionProviders());
+    if (k < 0) {
+      continue;
+    }
+
+    // collect the sibling MatMul nodes that multiply the same A with a compatible B
+    NodeArg* a_def = node.MutableInputDefs()[0];
+    std::vector<Node*> group;
+    for (const Node* consumer : graph.GetConsumerNodes(a_def->Name())) {
+      if (consumer == nullptr ||
+          visited.count(consumer->Index()) != 0 ||
+          consumer->InputDefs()[0] != a_def ||
+          consumer->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          GetGroupableMatMulK(graph, *consumer, GetCompatibleExecutionProviders()) != k) {
+        continue;
+      }
+      group.push_back(graph.GetNode(consumer->Index()));
+    }
+
+    if (group.size() < 2) {
+      continue;
+    }
+
+    std::vector<NodeArg*> input_defs{a_def};
+    std::vector<NodeArg*> output_defs;
+    for (Node* matmul : group) {
+      visited.insert(matmul->Index());
+      input_defs.push_back(matmul->MutableInputDefs()[1]);
+      output_defs.push_back(matmul->MutableOutputDefs()[0]);
+    }
+
+    Node& grouped_node = graph.AddNode(graph.GenerateNodeName("GroupedMatMul"),
+                                       "GroupedMatMul",
+                                       "fused MatMul nodes sharing input " + a_def->Name(),
+                                       input_defs,
+                                       output_defs,
+                                       nullptr,
+                                       kMSDomain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old nodes.
+    grouped_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    for (Node* matmul : group) {
+      graph_utils::RemoveNodeOutputEdges(graph, *matmul);
+      graph.RemoveNode(matmul->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
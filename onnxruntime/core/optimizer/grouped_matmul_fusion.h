@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class GroupedMatMulFusion
+
+Fuses sibling MatMul nodes that share the same input A and multiply it with constant
+2-D initializers into a single GroupedMatMul node, so that all the matrix products
+are dispatched to the thread pool at once:
+
+  MatMul(A, B_0), MatMul(A, B_1), ..., MatMul(A, B_n)
+    -> GroupedMatMul(A, B_0, B_1, ..., B_n)
+
+This is common for the per-head or the Q/K/V projections of attention layers, and
+for the expert projections of mixture-of-experts models.
+*/
+class GroupedMatMulFusion : public GraphTransformer {
+ public:
+  GroupedMatMulFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("GroupedMatMulFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
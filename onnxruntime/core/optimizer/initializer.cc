@@ -18,6 +18,27 @@ Status Initializer::ReadExternalRawData(
           tensor_proto.data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING,
       "External data type must not be UNDEFINED or STRING.");
 
+  size_t actual_tensor_data_length;
+  ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(
+      tensor_proto, &actual_tensor_data_length));
+
+  if (utils::HasCompressedExternalData(tensor_proto)) {
+    raw_data.resize(actual_tensor_data_length);
+    return utils::ReadCompressedExternalData(tensor_proto, raw_data.data(), raw_data.size());
+  }
+
+  // e.g. initializers in a memory mapped ORT format model or spilled by constant folding
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (utils::GetExternalDataMemoryAddress(tensor_proto, data_in_memory, data_in_memory_length)) {
+    ORT_RETURN_IF_NOT(data_in_memory_length == actual_tensor_data_length,
+                      "TensorProto external data size mismatch. Computed size: ", actual_tensor_data_length,
+                      ", external_data.length: ", data_in_memory_length);
+    const auto* data = static_cast<const char*>(data_in_memory);
+    raw_data.assign(data, data + data_in_memory_length);
+    return Status::OK();
+  }
+
   ORT_RETURN_IF(
       model_path.IsEmpty(),
       "model_path must not be empty. Ensure that a path is provided when the model is created or loaded.");
@@ -25,9 +46,6 @@ Status Initializer::ReadExternalRawData(
   std::unique_ptr<ExternalDataInfo> external_data{};
   ORT_RETURN_IF_ERROR(ExternalDataInfo::Create(tensor_proto.external_data(), external_data));
 
-  size_t actual_tensor_data_length;
-  ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(
-      tensor_proto, &actual_tensor_data_length));
   const size_t external_data_length = external_data->GetLength();
 
   ORT_RETURN_IF_NOT(
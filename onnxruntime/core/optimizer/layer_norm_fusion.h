@@ -21,6 +21,8 @@ class LayerNormFusion : public GraphTransformer {
   LayerNormFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("LayerNormFusion", compatible_execution_providers) {}
 
+  bool SupportsParallelSubgraphs() const override { return true; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -40,6 +42,8 @@ class SimplifiedLayerNormFusion : public GraphTransformer {
       : GraphTransformer("SimplifiedLayerNormFusion", compatible_execution_providers),
         allow_precision_change_(allow_precision_change) {}
 
+  bool SupportsParallelSubgraphs() const override { return true; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
  private:
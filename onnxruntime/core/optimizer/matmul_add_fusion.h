@@ -12,6 +12,8 @@ class MatMulAddFusion : public GraphTransformer {
   MatMulAddFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept 
       : GraphTransformer("MatMulAddFusion", compatible_execution_providers) {}
 
+  bool SupportsParallelSubgraphs() const override { return true; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
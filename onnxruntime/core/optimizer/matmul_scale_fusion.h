@@ -32,6 +32,8 @@ class MatMulScaleFusion : public GraphTransformer {
         excluded_initializer_names_{excluded_initializer_names} {
   }
 
+  bool SupportsParallelSubgraphs() const override { return true; }
+
  private:
   Status ApplyImpl(
       Graph& graph, bool& modified,
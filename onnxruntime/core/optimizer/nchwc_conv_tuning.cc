@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/nchwc_conv_tuning.h"
+
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/cpuid_info.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+std::string NchwcConvCandidate::Signature() const {
+  std::ostringstream signature;
+  signature << "N=" << batch_count << " C=" << input_channels << " M=" << output_channels << " G=" << group_count
+            << " in=" << input_shape[0] << "x" << input_shape[1] << " out=" << output_shape[0] << "x" << output_shape[1]
+            << " k=" << kernel_shape[0] << "x" << kernel_shape[1] << " d=" << dilations[0] << "x" << dilations[1]
+            << " p=" << pads[0] << "," << pads[1] << "," << pads[2] << "," << pads[3] << " s=" << strides[0] << "x"
+            << strides[1] << " reorder=" << reorder_input << reorder_output;
+  return signature.str();
+}
+
+// The best time of a few runs of fn, after a warm up run.
+template <typename TFunc>
+static double MeasureSeconds(TFunc fn) {
+  constexpr int kIterations = 5;
+  fn();
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < kIterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+static bool BenchmarkNchwcConv(const NchwcConvCandidate& conv) {
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const int64_t nchwc_input_channels =
+      conv.reorder_input ? (conv.input_channels + block_size - 1) & ~(block_size - 1) : conv.input_channels;
+  const int64_t nchwc_output_channels = (conv.output_channels + block_size - 1) & ~(block_size - 1);
+  const int64_t input_size = conv.input_shape[0] * conv.input_shape[1];
+  const int64_t output_size = conv.output_shape[0] * conv.output_shape[1];
+  const int64_t kernel_size = conv.kernel_shape[0] * conv.kernel_shape[1];
+  const int64_t N = conv.batch_count;
+
+  // the timings don't depend on the values, only avoid denormals
+  std::vector<float> input(static_cast<size_t>(N * conv.input_channels * input_size), 0.1f);
+  std::vector<float> output(static_cast<size_t>(N * conv.output_channels * output_size));
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  std::vector<float> filter(
+      static_cast<size_t>(conv.output_channels * (conv.input_channels / conv.group_count) * kernel_size), 0.01f);
+  MLAS_CONV_PARAMETERS parameters;
+  size_t working_buffer_size;
+  MlasConvPrepare(&parameters, 2, static_cast<size_t>(N), static_cast<size_t>(conv.group_count),
+                  static_cast<size_t>(conv.input_channels / conv.group_count), conv.input_shape, conv.kernel_shape,
+                  conv.dilations, conv.pads, conv.strides, conv.output_shape,
+                  static_cast<size_t>(conv.output_channels / conv.group_count), &activation, &working_buffer_size,
+                  nullptr);
+  std::vector<float> working_buffer(working_buffer_size);
+  const double nchw_seconds = MeasureSeconds([&]() {
+    MlasConv(&parameters, input.data(), filter.data(), nullptr, working_buffer.data(), output.data(), nullptr);
+  });
+
+  std::vector<float> nchwc_filter(static_cast<size_t>(nchwc_output_channels * conv.filter_input_channels * kernel_size),
+                                  0.01f);
+  std::vector<float> nchwc_input(conv.reorder_input ? static_cast<size_t>(N * nchwc_input_channels * input_size) : 0);
+  std::vector<float> nchwc_output(static_cast<size_t>(N * nchwc_output_channels * output_size));
+  const int64_t nchwc_input_shape[] = {N, nchwc_input_channels, conv.input_shape[0], conv.input_shape[1]};
+  const int64_t nchwc_output_shape[] = {N, nchwc_output_channels, conv.output_shape[0], conv.output_shape[1]};
+  const int64_t nchw_output_shape[] = {N, conv.output_channels, conv.output_shape[0], conv.output_shape[1]};
+  const double nchwc_seconds = MeasureSeconds([&]() {
+    const float* conv_input = input.data();
+    if (conv.reorder_input) {
+      for (int64_t n = 0; n < N; ++n) {
+        MlasReorderInputNchw(input.data() + n * conv.input_channels * input_size,
+                             nchwc_input.data() + n * nchwc_input_channels * input_size,
+                             static_cast<size_t>(conv.input_channels), static_cast<size_t>(input_size));
+      }
+      conv_input = nchwc_input.data();
+    }
+    MlasNchwcConv(nchwc_input_shape, conv.kernel_shape, conv.dilations, conv.pads, conv.strides, nchwc_output_shape,
+                  static_cast<size_t>(conv.nchwc_group_count), conv_input, nchwc_filter.data(), nullptr,
+                  nchwc_output.data(), &activation, true, nullptr);
+    if (conv.reorder_output) {
+      MlasReorderOutputNchw(nchw_output_shape, nchwc_output.data(), output.data());
+    }
+  });
+
+  return nchwc_seconds < nchw_seconds;
+}
+
+static bool FindNchwcConvTuning(const std::string& tuning_file, const std::string& signature, bool& nchwc_is_faster) {
+  std::ifstream infile(tuning_file);
+  std::string line;
+  while (std::getline(infile, line)) {
+    auto tab = line.find('\t');
+    if (tab == std::string::npos || line.compare(0, tab, signature) != 0 || tab != signature.size()) {
+      continue;
+    }
+    int value;
+    if (std::istringstream(line.substr(tab + 1)) >> value) {
+      nchwc_is_faster = value != 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsNchwcConvFaster(const NchwcConvCandidate& conv, const std::string& tuning_file, const logging::Logger& logger) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, bool> results;
+
+  const std::string signature = CPUIDInfo::GetCPUIDInfo().GetSignature() + " " + conv.Signature();
+
+  // sessions created concurrently benchmark one at a time, so that they don't skew each other's timings
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = results.find(signature);
+  if (it != results.end()) {
+    return it->second;
+  }
+
+  bool nchwc_is_faster;
+  if (tuning_file.empty() || !FindNchwcConvTuning(tuning_file, signature, nchwc_is_faster)) {
+    nchwc_is_faster = BenchmarkNchwcConv(conv);
+    LOGS(logger, VERBOSE) << "Benchmarked Conv '" << conv.Signature() << "': "
+                          << (nchwc_is_faster ? "NCHWc" : "NCHW") << " is faster";
+
+    if (!tuning_file.empty()) {
+      std::ofstream outfile(tuning_file, std::ofstream::out | std::ofstream::app);
+      outfile << signature << "\t" << (nchwc_is_faster ? 1 : 0) << "\n";
+      if (!outfile.good()) {
+        LOGS(logger, WARNING) << "Failed to save the NCHWc Conv tuning to " << tuning_file;
+      }
+    }
+  }
+
+  results.emplace(signature, nchwc_is_faster);
+  return nchwc_is_faster;
+}
+
+}  // namespace onnxruntime
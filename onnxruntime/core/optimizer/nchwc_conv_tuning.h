@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+
+// A 2D float Conv that the NchwcTransformer can run in the NCHWc layout, with the parameters of both forms.
+struct NchwcConvCandidate {
+  int64_t batch_count;
+  int64_t input_channels;
+  int64_t output_channels;
+  int64_t group_count;
+  int64_t input_shape[2];
+  int64_t output_shape[2];
+  int64_t kernel_shape[2];
+  int64_t dilations[2];
+  int64_t pads[4];
+  int64_t strides[2];
+
+  // The NCHWc form. The NCHW input is used directly if it is not reordered.
+  bool reorder_input;
+  int64_t nchwc_group_count;
+  int64_t filter_input_channels;
+  // Whether the output is reordered back to NCHW right after the Conv, i.e. no consumer can stay in NCHWc.
+  bool reorder_output;
+
+  std::string Signature() const;
+};
+
+// Returns whether the NCHWc Conv, including the reorders of its input and output, runs faster on this CPU than the
+// NCHW Conv (im2col and SGEMM). Both forms are benchmarked on a single thread the first time a Conv signature is seen
+// in the process. If tuning_file is not empty, the results are also looked up in it and appended to it, one line
+// per Conv, '<CPU signature> <Conv signature>\t<1 if NCHWc is faster, else 0>'.
+bool IsNchwcConvFaster(const NchwcConvCandidate& conv, const std::string& tuning_file, const logging::Logger& logger);
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include <deque>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
+#include "core/optimizer/nchwc_conv_tuning.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/mlas/inc/mlas.h"
 
@@ -13,7 +14,9 @@ namespace onnxruntime {
 
 class NchwcTransformerImpl {
  public:
-  NchwcTransformerImpl(Graph& graph) noexcept : graph_(graph) {}
+  NchwcTransformerImpl(Graph& graph, bool autotune, const std::string& tuning_file,
+                       const logging::Logger& logger) noexcept
+      : graph_(graph), autotune_(autotune), tuning_file_(tuning_file), logger_(logger) {}
 
   void Transform(Node& node);
   void Finalize(bool& modified);
@@ -114,6 +117,8 @@ class NchwcTransformerImpl {
                               const ONNX_NAMESPACE::TensorProto* filter_shape);
   Node& InsertReshape(NodeArg* input_arg, NodeArg* output_arg, int64_t channels, bool split_channels);
 
+  bool IsNchwcConvFaster(const Node& node, int64_t group_count, bool do_reorder_input,
+                         int64_t nchwc_group_count, int64_t filter_input_channels);
   void TransformConv(Node& node);
   void TransformPool(Node& node);
   void TransformBinary(Node& node, bool add_node);
@@ -126,6 +131,11 @@ class NchwcTransformerImpl {
 
   Graph& graph_;
 
+  // Whether a Conv taking an NCHW input is only converted if benchmarking shows that the NCHWc Conv is faster.
+  const bool autotune_;
+  const std::string& tuning_file_;
+  const logging::Logger& logger_;
+
   // Stores a queue of nodes to be removed after walking through the graph.
   std::deque<NodeIndex> removed_nodes_;
 
@@ -315,6 +325,90 @@ void NchwcTransformerImpl::ConvPoolShapeInference(const Node& node,
   }
 }
 
+bool NchwcTransformerImpl::IsNchwcConvFaster(const Node& node, int64_t group_count, bool do_reorder_input,
+                                             int64_t nchwc_group_count, int64_t filter_input_channels) {
+  const auto& input_defs = node.InputDefs();
+  const auto& output_defs = node.OutputDefs();
+
+  // Benchmarking requires the channel and spatial dimensions, otherwise keep
+  // converting the Conv as without autotuning.
+  const auto* input_shape = input_defs[0]->Shape();
+  const auto* output_shape = output_defs[0]->Shape();
+  if (input_shape == nullptr || input_shape->dim_size() != kNchwcDims ||
+      output_shape == nullptr || output_shape->dim_size() != kNchwcDims) {
+    return true;
+  }
+  for (int i = 1; i < kNchwcDims; i++) {
+    if (!utils::HasDimValue(input_shape->dim(i)) || !utils::HasDimValue(output_shape->dim(i))) {
+      return true;
+    }
+  }
+
+  const ONNX_NAMESPACE::TensorProto* conv_W_tensor_proto = nullptr;
+  graph_.GetInitializedTensor(input_defs[1]->Name(), conv_W_tensor_proto);
+
+  NchwcConvCandidate conv;
+  conv.batch_count = utils::HasDimValue(input_shape->dim(0)) ? input_shape->dim(0).dim_value() : 1;
+  conv.input_channels = input_shape->dim(1).dim_value();
+  conv.output_channels = output_shape->dim(1).dim_value();
+  conv.group_count = group_count;
+  for (int i = 0; i < kNchwcSpatialDims; i++) {
+    conv.input_shape[i] = input_shape->dim(kNchwcBatchChannelDims + i).dim_value();
+    conv.output_shape[i] = output_shape->dim(kNchwcBatchChannelDims + i).dim_value();
+    conv.kernel_shape[i] = conv_W_tensor_proto->dims(kNchwcBatchChannelDims + i);
+    conv.dilations[i] = 1;
+    conv.strides[i] = 1;
+    conv.pads[i] = 0;
+    conv.pads[i + kNchwcSpatialDims] = 0;
+  }
+
+  const auto* dilations_attr = graph_utils::GetNodeAttribute(node, "dilations");
+  if (dilations_attr != nullptr && dilations_attr->ints_size() == kNchwcSpatialDims) {
+    std::copy_n(dilations_attr->ints().begin(), kNchwcSpatialDims, conv.dilations);
+  }
+  const auto* strides_attr = graph_utils::GetNodeAttribute(node, "strides");
+  if (strides_attr != nullptr && strides_attr->ints_size() == kNchwcSpatialDims) {
+    std::copy_n(strides_attr->ints().begin(), kNchwcSpatialDims, conv.strides);
+  }
+
+  const auto* auto_pad_attr = graph_utils::GetNodeAttribute(node, "auto_pad");
+  const auto* pads_attr = graph_utils::GetNodeAttribute(node, "pads");
+  if (auto_pad_attr != nullptr && utils::HasString(*auto_pad_attr) &&
+      (auto_pad_attr->s() == "SAME_UPPER" || auto_pad_attr->s() == "SAME_LOWER")) {
+    for (int i = 0; i < kNchwcSpatialDims; i++) {
+      const int64_t total_padding = std::max<int64_t>(
+          0, (conv.output_shape[i] - 1) * conv.strides[i] + (conv.kernel_shape[i] - 1) * conv.dilations[i] + 1 -
+                 conv.input_shape[i]);
+      const int64_t small_padding = total_padding / 2;
+      const int64_t large_padding = total_padding - small_padding;
+      const bool same_upper = auto_pad_attr->s() == "SAME_UPPER";
+      conv.pads[i] = same_upper ? small_padding : large_padding;
+      conv.pads[i + kNchwcSpatialDims] = same_upper ? large_padding : small_padding;
+    }
+  } else if (pads_attr != nullptr && pads_attr->ints_size() == 2 * kNchwcSpatialDims &&
+             (auto_pad_attr == nullptr || auto_pad_attr->s() != "VALID")) {
+    std::copy_n(pads_attr->ints().begin(), 2 * kNchwcSpatialDims, conv.pads);
+  }
+
+  conv.reorder_input = do_reorder_input;
+  conv.nchwc_group_count = nchwc_group_count;
+  conv.filter_input_channels = filter_input_channels;
+
+  // The output stays in NCHWc if any consumer is a Conv or pooling node, the
+  // common case for the nodes that can continue an NCHWc chain.
+  conv.reorder_output = true;
+  for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+    const auto& op_type = it->OpType();
+    if (op_type == "Conv" || op_type == "FusedConv" || op_type == "MaxPool" || op_type == "AveragePool" ||
+        op_type == "GlobalMaxPool" || op_type == "GlobalAveragePool") {
+      conv.reorder_output = false;
+      break;
+    }
+  }
+
+  return onnxruntime::IsNchwcConvFaster(conv, tuning_file_, logger_);
+}
+
 void NchwcTransformerImpl::TransformConv(Node& node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -389,6 +483,14 @@ void NchwcTransformerImpl::TransformConv(Node& node) {
     }
   }
 
+  // With autotuning, a Conv that starts an NCHWc chain is left in NCHW if the
+  // NCHW Conv is faster than the NCHWc Conv with its reorders. A Conv whose
+  // input is already in NCHWc is always converted.
+  if (autotune_ && (!do_reorder_input || nchwc_args_.find(input_defs[0]) == nchwc_args_.end()) &&
+      !IsNchwcConvFaster(node, group_count, do_reorder_input, nchwc_group_count, filter_input_channels)) {
+    return;
+  }
+
   // Check if the filter has already been converted to the target format.
   std::unordered_map<NodeArg*, NodeArg*>* filters_map;
   if (reorder_filter_OIHWBo) {
@@ -982,14 +1084,19 @@ void NchwcTransformerImpl::TransformResize(Node& node) {
   }
   auto* nchwc_input = it->second.get();
 
-  // Only support the nearest interpolation mode (the default value).
+  // Support the nearest (the default value) and the linear interpolation modes.
+  std::string mode = "nearest";
   const auto* mode_attr = graph_utils::GetNodeAttribute(node, "mode");
   if (mode_attr != nullptr && utils::HasString(*mode_attr)) {
-    if (mode_attr->s() != "nearest") {
+    mode = mode_attr->s();
+    if (mode != "nearest" && mode != "linear") {
       return;
     }
   }
 
+  // Resize-10 and Upsample always use the asymmetric coordinate transformation mode.
+  std::string transformation_mode = "asymmetric";
+
   NodeArg* sizes_arg = nullptr;
   NodeArg* scales_arg = nullptr;
 
@@ -1001,20 +1108,31 @@ void NchwcTransformerImpl::TransformResize(Node& node) {
       scales_arg = input_defs[2];
     }
 
-    // Only support the asymmetric coordinate transformation mode.
+    transformation_mode = "half_pixel";
     const auto* transform_mode_attr = graph_utils::GetNodeAttribute(node, "coordinate_transformation_mode");
-    if ((transform_mode_attr == nullptr) ||
-        !utils::HasString(*transform_mode_attr) ||
-        (transform_mode_attr->s() != "asymmetric")) {
-      return;
+    if (transform_mode_attr != nullptr && utils::HasString(*transform_mode_attr)) {
+      transformation_mode = transform_mode_attr->s();
     }
 
-    // Only support the floor rounding mode.
-    const auto* nearest_mode_attr = graph_utils::GetNodeAttribute(node, "nearest_mode");
-    if ((nearest_mode_attr == nullptr) ||
-        !utils::HasString(*nearest_mode_attr) ||
-        (nearest_mode_attr->s() != "floor")) {
-      return;
+    if (mode == "nearest") {
+      // Only support the asymmetric coordinate transformation mode.
+      if (transformation_mode != "asymmetric") {
+        return;
+      }
+
+      // Only support the floor rounding mode.
+      const auto* nearest_mode_attr = graph_utils::GetNodeAttribute(node, "nearest_mode");
+      if ((nearest_mode_attr == nullptr) ||
+          !utils::HasString(*nearest_mode_attr) ||
+          (nearest_mode_attr->s() != "floor")) {
+        return;
+      }
+    } else {
+      // Only support the transformation modes that do not extrapolate.
+      if (transformation_mode != "asymmetric" && transformation_mode != "align_corners" &&
+          transformation_mode != "half_pixel" && transformation_mode != "pytorch_half_pixel") {
+        return;
+      }
     }
   } else {
     scales_arg = input_defs[1];
@@ -1099,6 +1217,10 @@ void NchwcTransformerImpl::TransformResize(Node& node) {
                                     kMSNchwcDomain);
   nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
   nchwc_node.AddAttribute("scales", scales_attr);
+  if (mode != "nearest") {
+    nchwc_node.AddAttribute("mode", mode);
+    nchwc_node.AddAttribute("coordinate_transformation_mode", transformation_mode);
+  }
 
   nchwc_input->remaining_original_uses_--;
 
@@ -1209,7 +1331,7 @@ void NchwcTransformerImpl::Finalize(bool& modified) {
 }
 
 Status NchwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
-  NchwcTransformerImpl impl(graph);
+  NchwcTransformerImpl impl(graph, autotune_, tuning_file_, logger);
   GraphViewer graph_viewer(graph);
 
   for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
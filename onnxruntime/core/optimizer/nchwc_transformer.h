@@ -16,10 +16,17 @@ and inserts nodes to reorder tensors as needed.
 */
 class NchwcTransformer : public GraphTransformer {
  public:
-  NchwcTransformer() noexcept : GraphTransformer("NchwcTransformer") {}
+  // If autotune is set, a Conv taking an NCHW input is only converted if the NCHWc Conv, including the reorders
+  // of its input and output, is faster than the NCHW Conv on this CPU. The results of the benchmarks are shared
+  // by the sessions of the process and, if tuning_file is not empty, saved to it for later processes.
+  NchwcTransformer(bool autotune = false, std::string tuning_file = {}) noexcept
+      : GraphTransformer("NchwcTransformer"), autotune_(autotune), tuning_file_(std::move(tuning_file)) {}
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  const bool autotune_;
+  const std::string tuning_file_;
 };
 
 }  // namespace onnxruntime
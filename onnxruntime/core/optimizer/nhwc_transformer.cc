@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <deque>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
@@ -13,7 +14,8 @@ namespace onnxruntime {
 
 class NhwcTransformerImpl {
  public:
-  NhwcTransformerImpl(Graph& graph) noexcept : graph_(graph) {}
+  NhwcTransformerImpl(Graph& graph, bool enable_float_nhwc) noexcept
+      : graph_(graph), enable_float_nhwc_(enable_float_nhwc) {}
 
   void Transform(Node& node);
   void Finalize(bool& modified);
@@ -44,17 +46,26 @@ class NhwcTransformerImpl {
   void CreateNhwcArgument(Node& node, Node& nhwc_node, int rank, size_t output_index);
   void CreateNhwcArgument(Node& node, Node& nhwc_node, int rank);
   void InsertReorderInput(Node& node, int rank);
+  NodeArg* PermuteInitializer(NodeArg* input_arg, int rank);
 
   void TransformQLinearConv(Node& node);
-  void TransformQLinearBinary(Node& node);
-  void TransformQLinearActivation(Node& node);
+  void TransformConv(Node& node);
+  void TransformBinary(Node& node, size_t input_index_a, size_t input_index_b);
+  void TransformActivation(Node& node);
   void TransformQLinearGlobalAveragePool(Node& node);
+  void TransformGlobalAveragePool(Node& node);
   void TransformMaxPool(Node& node);
   void TransformSplit(Node& node);
+  void TransformConcat(Node& node);
   void TransformPad(Node& node);
+  void TransformResize(Node& node);
+  void TransformTranspose(Node& node);
 
   Graph& graph_;
 
+  // Also transform the float operators to use NHWC tensors.
+  const bool enable_float_nhwc_;
+
   // Stores a mapping from the original NodeArg outputs to the NHWC variants
   // created inside this graph transform.
   std::unordered_map<NodeArg*, std::unique_ptr<NhwcArgument>> nhwc_args_;
@@ -65,8 +76,66 @@ class NhwcTransformerImpl {
 
   // Stores a queue of nodes to be removed after walking through the graph.
   std::deque<NodeIndex> removed_nodes_;
+
+  // Stores the Transpose nodes converting NHWC tensors to NCHW that have been
+  // bypassed by a node now reading the NHWC tensor. These are removed if they
+  // have no remaining uses after walking through the graph.
+  std::deque<NodeIndex> bypassed_transposes_;
 };
 
+// Returns the permute vector of a Transpose from NCHW to NHWC, example: {0, 2, 3, 1}
+static std::vector<int64_t> NchwToNhwcPerm(int rank) {
+  std::vector<int64_t> perm(static_cast<size_t>(rank));
+  perm[rank - 1] = 1;
+  for (auto r = 2; r < rank; r++) {
+    perm[r - 1] = r;
+  }
+  return perm;
+}
+
+// Returns the permute vector of a Transpose from NHWC to NCHW, example: {0, 3, 1, 2}
+static std::vector<int64_t> NhwcToNchwPerm(int rank) {
+  std::vector<int64_t> perm(static_cast<size_t>(rank));
+  perm[1] = rank - 1;
+  for (auto r = 2; r < rank; r++) {
+    perm[r] = r - 1;
+  }
+  return perm;
+}
+
+static bool IsTransposeWithPerm(const Node& node, const std::vector<int64_t>& perm) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1, 13})) {
+    return false;
+  }
+  const auto* perm_attr = graph_utils::GetNodeAttribute(node, "perm");
+  if (perm_attr == nullptr || perm_attr->ints_size() != static_cast<int>(perm.size())) {
+    return false;
+  }
+  return std::equal(perm.begin(), perm.end(), perm_attr->ints().begin());
+}
+
+static bool IsFloatTensor(const NodeArg* arg) {
+  const auto* type_proto = arg->TypeAsProto();
+  return type_proto != nullptr && type_proto->has_tensor_type() &&
+         type_proto->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+// Maps an NCHW axis to the NHWC axis, returns false for an invalid axis.
+static bool NhwcAxis(int64_t& axis, int rank) {
+  if (axis < -rank || axis >= rank) {
+    return false;
+  }
+  if (axis < 0) {
+    axis = axis + rank;
+  }
+  if (axis == 1) {
+    axis = rank - 1;
+  } else if (axis > 1) {
+    axis = axis - 1;
+  }
+  return true;
+}
+
 // Remove node's output edge starting from specified index, return number of edges removed.
 // If output at specified index for the node is graph output, inc the count returned.
 size_t NhwcTransformerImpl::RemoveOutputEdge(Node& node, size_t output_index) {
@@ -108,6 +177,18 @@ void NhwcTransformerImpl::InsertReorderInput(Node& node, int rank) {
   auto* input_original_arg = input_defs[0];
 
   auto it = reorder_inputs_.find(input_original_arg);
+  if (it == reorder_inputs_.end() && enable_float_nhwc_) {
+    // Read the NHWC tensor directly if the input is produced by a Transpose
+    // from NHWC to NCHW.
+    const Node* producer = graph_.GetProducerNode(input_original_arg->Name());
+    if (producer != nullptr && IsTransposeWithPerm(*producer, NhwcToNchwPerm(rank))) {
+      auto* input_nhwc_arg = producer->InputDefs()[0];
+      reorder_inputs_[input_original_arg] = input_nhwc_arg;
+      bypassed_transposes_.push_back(producer->Index());
+      input_defs[0] = input_nhwc_arg;
+      return;
+    }
+  }
   if (it == reorder_inputs_.end()) {
     std::string input_reorder_def_name = graph_.GenerateNodeArgName("reorder");
     auto* input_nhwc_arg = &graph_.GetOrCreateNodeArg(input_reorder_def_name, nullptr);
@@ -119,14 +200,7 @@ void NhwcTransformerImpl::InsertReorderInput(Node& node, int rank) {
                                               {input_nhwc_arg},
                                               nullptr);
     reorder_input_node.SetExecutionProviderType(kCpuExecutionProvider);
-
-    // Build the permute vector, example: {0, 2, 3, 1}
-    std::vector<int64_t> perm(static_cast<size_t>(rank));
-    perm[rank - 1] = 1;
-    for (auto r = 2; r < rank; r++) {
-      perm[r - 1] = r;
-    }
-    reorder_input_node.AddAttribute("perm", perm);
+    reorder_input_node.AddAttribute("perm", NchwToNhwcPerm(rank));
 
     input_defs[0] = input_nhwc_arg;
   } else {
@@ -134,6 +208,59 @@ void NhwcTransformerImpl::InsertReorderInput(Node& node, int rank) {
   }
 }
 
+// Permutes the elements of a constant initializer of a tensor dimension
+// attribute (such as the scales of Resize) from NCHW to NHWC order, example:
+// {1, 1, 2, 2} becomes {1, 2, 2, 1}. An initializer holding two values per
+// dimension (such as the roi of Resize) permutes each half. Returns nullptr if
+// the initializer is not supported.
+template <typename T>
+static void PermuteDimensionValues(const T* nchw_data, T* nhwc_data, int rank) {
+  nhwc_data[0] = nchw_data[0];
+  std::copy_n(nchw_data + 2, rank - 2, nhwc_data + 1);
+  nhwc_data[rank - 1] = nchw_data[1];
+}
+
+NodeArg* NhwcTransformerImpl::PermuteInitializer(NodeArg* input_arg, int rank) {
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph_, input_arg->Name());
+  if (tensor_proto == nullptr || tensor_proto->dims_size() != 1) {
+    return nullptr;
+  }
+
+  const int64_t count = tensor_proto->dims(0);
+  if (count == 0) {
+    return input_arg;
+  }
+  if (count != rank && count != rank * 2) {
+    return nullptr;
+  }
+
+  Initializer initializer{*tensor_proto, graph_.ModelPath()};
+  ONNX_NAMESPACE::TensorProto nhwc_tensor_proto;
+  nhwc_tensor_proto.set_data_type(tensor_proto->data_type());
+  nhwc_tensor_proto.set_name(graph_.GenerateNodeArgName("nhwc_permutated_" + input_arg->Name()));
+  nhwc_tensor_proto.add_dims(count);
+
+  if (tensor_proto->data_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    const float* nchw_data = initializer.data<float>();
+    std::vector<float> nhwc_data(static_cast<size_t>(count));
+    for (int64_t offset = 0; offset < count; offset += rank) {
+      PermuteDimensionValues(nchw_data + offset, nhwc_data.data() + offset, rank);
+    }
+    nhwc_tensor_proto.set_raw_data(nhwc_data.data(), nhwc_data.size() * sizeof(float));
+  } else if (tensor_proto->data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT64) {
+    const int64_t* nchw_data = initializer.data<int64_t>();
+    std::vector<int64_t> nhwc_data(static_cast<size_t>(count));
+    for (int64_t offset = 0; offset < count; offset += rank) {
+      PermuteDimensionValues(nchw_data + offset, nhwc_data.data() + offset, rank);
+    }
+    nhwc_tensor_proto.set_raw_data(nhwc_data.data(), nhwc_data.size() * sizeof(int64_t));
+  } else {
+    return nullptr;
+  }
+
+  return &graph_utils::AddInitializer(graph_, nhwc_tensor_proto);
+}
+
 void NhwcTransformerImpl::TransformQLinearConv(Node& node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -180,39 +307,101 @@ void NhwcTransformerImpl::TransformQLinearConv(Node& node) {
   removed_nodes_.push_front(node.Index());
 }
 
-void NhwcTransformerImpl::TransformQLinearBinary(Node& node) {
+void NhwcTransformerImpl::TransformConv(Node& node) {
   auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
 
-  auto* input_def_a = input_defs[0];
-  auto* input_def_b = input_defs[3];
+  // Skip FusedConv with the optional sum input.
+  if (input_defs.size() > 3 || !IsFloatTensor(input_defs[0])) {
+    return;
+  }
+
+  // Require that the weights tensor have a shape so that the necessary
+  // Transpose nodes can be inserted into the graph.
+  auto* weights_shape = input_defs[1]->Shape();
+  if (weights_shape == nullptr || weights_shape->dim_size() < 3) {
+    return;
+  }
+
+  // Create the replacement node.
+  std::string nhwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nhwc");
+  Node& nhwc_node = graph_.AddNode(nhwc_node_name,
+                                   "NhwcConv",
+                                   nhwc_node_name,
+                                   input_defs,
+                                   output_defs,
+                                   &node.GetAttributes(),
+                                   kMSDomain);
+  nhwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+  auto* nhwc_input = LookupNhwcArgument(input_defs[0]);
+  if (nhwc_input == nullptr) {
+    InsertReorderInput(nhwc_node, weights_shape->dim_size());
+  } else {
+    nhwc_node.MutableInputDefs()[0] = nhwc_input->nhwc_arg_;
+    nhwc_input->remaining_original_uses_--;
+  }
+
+  CreateNhwcArgument(node, nhwc_node, weights_shape->dim_size());
+  removed_nodes_.push_front(node.Index());
+}
+
+void NhwcTransformerImpl::TransformBinary(Node& node, size_t input_index_a, size_t input_index_b) {
+  auto& input_defs = node.MutableInputDefs();
+
+  auto* input_def_a = input_defs[input_index_a];
+  auto* input_def_b = input_defs[input_index_b];
 
-  // For simplicity, require that both inputs have the same tensor rank.
   auto* input_shape_a = input_def_a->Shape();
   auto* input_shape_b = input_def_b->Shape();
   if (input_shape_a == nullptr || input_shape_b == nullptr) {
     return;
   }
-  if (input_shape_a->dim_size() != input_shape_b->dim_size()) {
-    return;
-  }
 
   auto* nhwc_input_a = LookupNhwcArgument(input_def_a);
   auto* nhwc_input_b = LookupNhwcArgument(input_def_b);
+
   if (nhwc_input_a == nullptr || nhwc_input_b == nullptr) {
+    // The float operators may broadcast a tensor with all dimensions equal to
+    // one (such as a scalar) to a single NHWC input, the result does not
+    // depend on the layout of the NHWC tensor.
+    if (!enable_float_nhwc_ || (nhwc_input_a == nullptr && nhwc_input_b == nullptr)) {
+      return;
+    }
+    auto* nhwc_input = (nhwc_input_a != nullptr) ? nhwc_input_a : nhwc_input_b;
+    auto* other_shape = (nhwc_input_a != nullptr) ? input_shape_b : input_shape_a;
+    if (other_shape->dim_size() > nhwc_input->rank_) {
+      return;
+    }
+    for (const auto& dim : other_shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() != 1) {
+        return;
+      }
+    }
+
+    input_defs[(nhwc_input_a != nullptr) ? input_index_a : input_index_b] = nhwc_input->nhwc_arg_;
+    nhwc_input->remaining_original_uses_--;
+
+    CreateNhwcArgument(node, node, nhwc_input->rank_);
+    return;
+  }
+
+  // For simplicity, require that both inputs have the same tensor rank.
+  if (input_shape_a->dim_size() != input_shape_b->dim_size()) {
     return;
   }
 
   // Update the node to directly use the NHWC inputs and decrement the original
   // use counts of the NHWC inputs.
-  input_defs[0] = nhwc_input_a->nhwc_arg_;
+  input_defs[input_index_a] = nhwc_input_a->nhwc_arg_;
   nhwc_input_a->remaining_original_uses_--;
-  input_defs[3] = nhwc_input_b->nhwc_arg_;
+  input_defs[input_index_b] = nhwc_input_b->nhwc_arg_;
   nhwc_input_b->remaining_original_uses_--;
 
   CreateNhwcArgument(node, node, nhwc_input_a->rank_);
 }
 
-void NhwcTransformerImpl::TransformQLinearActivation(Node& node) {
+void NhwcTransformerImpl::TransformActivation(Node& node) {
   auto& input_defs = node.MutableInputDefs();
 
   auto* nhwc_input = LookupNhwcArgument(input_defs[0]);
@@ -251,6 +440,41 @@ void NhwcTransformerImpl::TransformQLinearGlobalAveragePool(Node& node) {
   CreateNhwcArgument(node, node, nhwc_input->rank_);
 }
 
+void NhwcTransformerImpl::TransformGlobalAveragePool(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  auto* nhwc_input = LookupNhwcArgument(input_defs[0]);
+  if (nhwc_input == nullptr || nhwc_input->rank_ < 3) {
+    return;
+  }
+
+  // Create the replacement node, which reduces the spatial dimensions of the
+  // NHWC tensor.
+  std::vector<int64_t> axes;
+  for (int64_t axis = 1; axis < nhwc_input->rank_ - 1; axis++) {
+    axes.push_back(axis);
+  }
+
+  std::string nhwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nhwc");
+  Node& nhwc_node = graph_.AddNode(nhwc_node_name,
+                                   "ReduceMean",
+                                   nhwc_node_name,
+                                   input_defs,
+                                   output_defs);
+  nhwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+  nhwc_node.AddAttribute("axes", axes);
+  nhwc_node.AddAttribute("keepdims", static_cast<int64_t>(1));
+
+  // Update the node to directly use the NHWC inputs and decrement the original
+  // use counts of the NHWC inputs.
+  nhwc_node.MutableInputDefs()[0] = nhwc_input->nhwc_arg_;
+  nhwc_input->remaining_original_uses_--;
+
+  CreateNhwcArgument(node, nhwc_node, nhwc_input->rank_);
+  removed_nodes_.push_front(node.Index());
+}
+
 void NhwcTransformerImpl::TransformMaxPool(Node& node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -265,6 +489,17 @@ void NhwcTransformerImpl::TransformMaxPool(Node& node) {
     return;
   }
 
+  // NhwcMaxPool is implemented for uint8_t and float tensors.
+  const auto* type_proto = input_defs[0]->TypeAsProto();
+  if (type_proto == nullptr || !type_proto->has_tensor_type()) {
+    return;
+  }
+  const auto elem_type = type_proto->tensor_type().elem_type();
+  if (elem_type != ONNX_NAMESPACE::TensorProto_DataType_UINT8 &&
+      elem_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return;
+  }
+
   // Create the replacement node.
   std::string nhwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nhwc");
   Node& nhwc_node = graph_.AddNode(nhwc_node_name,
@@ -300,18 +535,10 @@ void NhwcTransformerImpl::TransformSplit(Node& node) {
   const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
   if (axis_attr != nullptr && utils::HasInt(*axis_attr)) {
     int64_t axis = axis_attr->i();
-    if (axis < -nhwc_input->rank_ || axis >= nhwc_input->rank_) {
+    if (!NhwcAxis(axis, nhwc_input->rank_)) {
       // direct return on invalid axis
       return;
     }
-    if (axis < 0) {
-      axis = axis + nhwc_input->rank_;
-    }
-    if (axis == 1) {
-      axis = nhwc_input->rank_ - 1;
-    } else if (axis > 1) {
-      axis = axis - 1;
-    }
     node.AddAttribute("axis", axis);
   }
 
@@ -323,6 +550,40 @@ void NhwcTransformerImpl::TransformSplit(Node& node) {
   CreateNhwcArgument(node, node, nhwc_input->rank_);
 }
 
+void NhwcTransformerImpl::TransformConcat(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+
+  // Require that all of the inputs are NHWC tensors of the same rank.
+  std::vector<NhwcArgument*> nhwc_inputs;
+  for (auto* input_def : input_defs) {
+    auto* nhwc_input = LookupNhwcArgument(input_def);
+    if (nhwc_input == nullptr || nhwc_input->rank_ != LookupNhwcArgument(input_defs[0])->rank_) {
+      return;
+    }
+    nhwc_inputs.push_back(nhwc_input);
+  }
+
+  const int rank = nhwc_inputs[0]->rank_;
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis_attr == nullptr || !utils::HasInt(*axis_attr)) {
+    return;
+  }
+  int64_t axis = axis_attr->i();
+  if (!NhwcAxis(axis, rank)) {
+    return;
+  }
+  node.AddAttribute("axis", axis);
+
+  // Update the node to directly use the NHWC inputs and decrement the original
+  // use counts of the NHWC inputs.
+  for (size_t i = 0; i < input_defs.size(); i++) {
+    input_defs[i] = nhwc_inputs[i]->nhwc_arg_;
+    nhwc_inputs[i]->remaining_original_uses_--;
+  }
+
+  CreateNhwcArgument(node, node, rank);
+}
+
 void NhwcTransformerImpl::TransformPad(Node& node) {
   auto& input_defs = node.MutableInputDefs();
 
@@ -366,23 +627,132 @@ void NhwcTransformerImpl::TransformPad(Node& node) {
   CreateNhwcArgument(node, node, nhwc_input->rank_);
 }
 
+void NhwcTransformerImpl::TransformResize(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+
+  auto* nhwc_input = LookupNhwcArgument(input_defs[0]);
+  if (nhwc_input == nullptr || !IsFloatTensor(input_defs[0])) {
+    return;
+  }
+
+  // The CPU kernel resizes NHWC tensors in the nearest mode, and in the linear
+  // mode for 4D tensors that are not resized along the batch and channels.
+  const auto* mode_attr = graph_utils::GetNodeAttribute(node, "mode");
+  const std::string mode = (mode_attr != nullptr && utils::HasString(*mode_attr)) ? mode_attr->s() : "nearest";
+  if (mode == "linear") {
+    if (nhwc_input->rank_ != 4 || input_defs.size() < 3 || !input_defs[2]->Exists()) {
+      return;
+    }
+    const auto* scales_proto = graph_utils::GetConstantInitializer(graph_, input_defs[2]->Name());
+    if (scales_proto == nullptr ||
+        scales_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+        scales_proto->dims_size() != 1 || scales_proto->dims(0) != 4) {
+      return;
+    }
+    Initializer scales{*scales_proto, graph_.ModelPath()};
+    if (scales.data<float>()[0] != 1.0f || scales.data<float>()[1] != 1.0f) {
+      return;
+    }
+  } else if (mode != "nearest") {
+    return;
+  }
+
+  // Permute the roi, scales and sizes inputs to the NHWC order.
+  std::vector<NodeArg*> nhwc_input_defs(input_defs.begin(), input_defs.end());
+  for (size_t i = 1; i < input_defs.size(); i++) {
+    if (!input_defs[i]->Exists()) {
+      continue;
+    }
+    nhwc_input_defs[i] = PermuteInitializer(input_defs[i], nhwc_input->rank_);
+    if (nhwc_input_defs[i] == nullptr) {
+      return;
+    }
+  }
+
+  // Update the node to directly use the NHWC inputs and decrement the original
+  // use counts of the NHWC inputs.
+  for (size_t i = 1; i < input_defs.size(); i++) {
+    input_defs[i] = nhwc_input_defs[i];
+  }
+  input_defs[0] = nhwc_input->nhwc_arg_;
+  nhwc_input->remaining_original_uses_--;
+
+  CreateNhwcArgument(node, node, nhwc_input->rank_);
+}
+
+void NhwcTransformerImpl::TransformTranspose(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+
+  // A Transpose from NCHW to NHWC of a tensor that is already available in the
+  // NHWC format is replaced by the NHWC tensor.
+  auto* nhwc_input = LookupNhwcArgument(input_defs[0]);
+  if (nhwc_input == nullptr || !IsTransposeWithPerm(node, NchwToNhwcPerm(nhwc_input->rank_))) {
+    return;
+  }
+  if (!graph_.GetNodeOutputsInGraphOutputs(node).empty()) {
+    return;
+  }
+  for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+    if (static_cast<size_t>(it->GetDstArgIndex()) >= it->GetNode().InputDefs().size()) {
+      return;
+    }
+  }
+
+  std::vector<std::pair<NodeIndex, int>> consumers;
+  for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+    consumers.emplace_back(it->GetNode().Index(), it->GetDstArgIndex());
+  }
+  graph_utils::RemoveNodeOutputEdges(graph_, node);
+  for (const auto& consumer : consumers) {
+    graph_utils::ReplaceNodeInput(*graph_.GetNode(consumer.first), consumer.second, *nhwc_input->nhwc_arg_);
+  }
+
+  nhwc_input->remaining_original_uses_--;
+  removed_nodes_.push_front(node.Index());
+}
+
 void NhwcTransformerImpl::Transform(Node& node) {
   if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearConv", {10})) {
     TransformQLinearConv(node);
   } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearAdd", {1}, kMSDomain) ||
              graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearMul", {1}, kMSDomain)) {
-    TransformQLinearBinary(node);
+    TransformBinary(node, 0, 3);
   } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearLeakyRelu", {1}, kMSDomain) ||
              graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearSigmoid", {1}, kMSDomain)) {
-    TransformQLinearActivation(node);
+    TransformActivation(node);
   } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearGlobalAveragePool", {1}, kMSDomain)) {
     TransformQLinearGlobalAveragePool(node);
-  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", {12})) {
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", {8, 10, 11, 12})) {
     TransformMaxPool(node);
   } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Split", {2, 11, 13})) {
     TransformSplit(node);
   } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Pad", {11, 13})) {
     TransformPad(node);
+  } else if (enable_float_nhwc_) {
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain)) {
+      TransformConv(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14})) {
+      TransformBinary(node, 0, 1);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", {6}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "HardSigmoid", {6}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Clip", {6, 11, 12, 13})) {
+      TransformActivation(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "GlobalAveragePool", {1})) {
+      TransformGlobalAveragePool(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Concat", {4, 11, 13})) {
+      TransformConcat(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Resize", {11, 13})) {
+      TransformResize(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1, 13})) {
+      TransformTranspose(node);
+    }
   }
 }
 
@@ -401,14 +771,7 @@ void NhwcTransformerImpl::Finalize(bool& modified) {
                                                  {output_original_arg},
                                                  nullptr);
       reorder_output_node.SetExecutionProviderType(kCpuExecutionProvider);
-
-      // Build the permute vector, example: {0, 3, 1, 2}
-      std::vector<int64_t> perm(static_cast<size_t>(rank));
-      perm[1] = rank - 1;
-      for (auto r = 2; r < rank; r++) {
-        perm[r] = r - 1;
-      }
-      reorder_output_node.AddAttribute("perm", perm);
+      reorder_output_node.AddAttribute("perm", NhwcToNchwPerm(rank));
     }
   }
 
@@ -419,10 +782,20 @@ void NhwcTransformerImpl::Finalize(bool& modified) {
   if (!removed_nodes_.empty()) {
     modified = true;
   }
+
+  // Remove the bypassed Transpose nodes that are no longer used.
+  for (auto index : bypassed_transposes_) {
+    Node* node = graph_.GetNode(index);
+    if (node != nullptr && node->GetOutputEdgesCount() == 0 &&
+        graph_.GetNodeOutputsInGraphOutputs(*node).empty()) {
+      graph_.RemoveNode(index);
+      modified = true;
+    }
+  }
 }
 
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
-  NhwcTransformerImpl impl(graph);
+  NhwcTransformerImpl impl(graph, enable_float_nhwc_);
   GraphViewer graph_viewer(graph);
 
   for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
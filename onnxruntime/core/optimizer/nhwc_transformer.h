@@ -13,13 +13,22 @@ namespace onnxruntime {
 
 Transformer that optimizes the graph by using NHWC nodes instead of NCHW nodes
 and inserts nodes to transpose tensors as needed.
+
+If enable_float_nhwc is set, float Conv/FusedConv nodes are also replaced by
+NhwcConv and the NHWC tensors are propagated through the float operators that
+are layout agnostic (or that can be adapted by permuting their attributes and
+constant inputs). Transpose nodes that convert the NHWC data of a node to NCHW
+(or back) are folded into the NHWC graph.
 */
 class NhwcTransformer : public GraphTransformer {
  public:
-  NhwcTransformer() noexcept : GraphTransformer("NhwcTransformer") {}
+  explicit NhwcTransformer(bool enable_float_nhwc = false) noexcept
+      : GraphTransformer("NhwcTransformer"), enable_float_nhwc_(enable_float_nhwc) {}
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool enable_float_nhwc_;
 };
 
 }  // namespace onnxruntime
@@ -120,6 +120,22 @@ OptimizerExecutionFrame::OptimizerExecutionFrame(const Info& info,
   Init(std::vector<int>(), std::vector<OrtValue>(), info.GetInitializers(), fetches);
 }
 
+OptimizerExecutionFrame::OptimizerExecutionFrame(const Info& info,
+                                                 const std::vector<int>& feed_mlvalue_idxs,
+                                                 const std::vector<OrtValue>& feeds,
+                                                 const std::vector<int>& fetch_mlvalue_idxs,
+                                                 const std::vector<OrtValue>& fetches)
+    : IExecutionFrame(info.GetMLValueNameIdxMap(), info.GetNodeIndexInfo(), fetch_mlvalue_idxs),
+      info_(info) {
+  Init(feed_mlvalue_idxs, feeds, info.GetInitializers(), fetches);
+}
+
+void OptimizerExecutionFrame::Reset(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                                    const std::vector<OrtValue>& fetches) {
+  ClearValues();
+  Init(feed_mlvalue_idxs, feeds, info_.GetInitializers(), fetches);
+}
+
 AllocatorPtr OptimizerExecutionFrame::GetAllocatorImpl(const OrtMemoryInfo& info) const {
   return info_.GetAllocator(info);
 }
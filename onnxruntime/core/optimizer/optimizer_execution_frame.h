@@ -83,8 +83,21 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
                           const std::vector<int>& fetch_mlvalue_idxs,
                           const std::vector<OrtValue>& fetches = {});
 
+  OptimizerExecutionFrame(const Info& info,
+                          const std::vector<int>& feed_mlvalue_idxs,
+                          const std::vector<OrtValue>& feeds,
+                          const std::vector<int>& fetch_mlvalue_idxs,
+                          const std::vector<OrtValue>& fetches);
+
   ~OptimizerExecutionFrame() override = default;
 
+  // Reset the frame so it can be used for another execution with the same fetches.
+  void Reset(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+             const std::vector<OrtValue>& fetches);
+
+  // Release the values of the last execution, so a frame kept for re-use does not hold on to them.
+  void ReleaseValues() { ClearValues(); }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OptimizerExecutionFrame);
 
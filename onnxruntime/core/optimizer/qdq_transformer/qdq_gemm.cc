@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "core/graph/graph.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/qdq_transformer/qdq_op_transformer.h"
+#include "core/optimizer/qdq_transformer/qdq_util.h"
+#include "core/optimizer/qdq_transformer/registry.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+// Gemm without bias and scaling is a MatMul, so it is fused to QLinearMatMul. A transposed B must be a constant
+// initializer, which is transposed into a new initializer.
+class QDQGemmTransformer : public QDQOperatorTransformer {
+ public:
+  QDQGemmTransformer(Node& node, Graph& graph) : QDQOperatorTransformer(node, graph) {}
+
+  bool TransformImpl(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) override {
+    std::vector<NodeArg*> input_defs(graph_.GetNode(dq_nodes[0]->Index())->MutableInputDefs());
+    Node* b = graph_.GetNode(dq_nodes[1]->Index());
+    input_defs.insert(input_defs.end(), b->MutableInputDefs().begin(), b->MutableInputDefs().end());
+    if (IsTransB()) {
+      input_defs[3] = &TransposeInitializer(*b->InputDefs()[0]);
+    }
+
+    Node* q = graph_.GetNode(q_nodes[0]->Index());
+    input_defs.push_back(q->MutableInputDefs()[1]);
+    input_defs.push_back(q->MutableInputDefs()[2]);
+
+    graph_.AddNode(node_.Name(),
+                   "QLinearMatMul",
+                   node_.Description(),
+                   input_defs,
+                   q->MutableOutputDefs(),
+                   nullptr,
+                   kOnnxDomain)
+        .SetExecutionProviderType(kCpuExecutionProvider);
+    return true;
+  }
+
+  bool Check(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) const override {
+    constexpr size_t DQCount = 2;
+    if (DQCount != dq_nodes.size() ||
+        !QDQOperatorTransformer::Check(dq_nodes, q_nodes) ||
+        q_nodes.size() != 1) {
+      return false;
+    }
+
+    const auto* alpha = graph_utils::GetNodeAttribute(node_, "alpha");
+    const auto* trans_a = graph_utils::GetNodeAttribute(node_, "transA");
+    if ((alpha != nullptr && alpha->f() != 1.0f) ||
+        (trans_a != nullptr && trans_a->i() != 0)) {
+      return false;
+    }
+
+    // QLinearMatMul only supports per-tensor quantization
+    for (const Node* qdq_node : {dq_nodes[0], dq_nodes[1], q_nodes[0]}) {
+      const auto& qdq_input_defs = qdq_node->InputDefs();
+      if (!optimizer_utils::IsScalar(*qdq_input_defs[QDQ::QDQInputIndex::SCALE_ID]) ||
+          (qdq_input_defs.size() == QDQ::QDQInputIndex::TOTAL_COUNT &&
+           !optimizer_utils::IsScalar(*qdq_input_defs[QDQ::QDQInputIndex::ZERO_POINT_ID]))) {
+        return false;
+      }
+    }
+
+    if (IsTransB()) {
+      const auto* b_tensor_proto = graph_utils::GetConstantInitializer(graph_, dq_nodes[1]->InputDefs()[0]->Name());
+      if (b_tensor_proto == nullptr || b_tensor_proto->dims_size() != 2) {
+        return false;
+      }
+    }
+
+    // Currently Quant MatMul only support activation type uint8_t
+    int32_t dt = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+    return dt == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8;
+  }
+
+ private:
+  bool IsTransB() const {
+    const auto* trans_b = graph_utils::GetNodeAttribute(node_, "transB");
+    return trans_b != nullptr && trans_b->i() != 0;
+  }
+
+  NodeArg& TransposeInitializer(const NodeArg& b_arg) {
+    const auto* b_tensor_proto = graph_utils::GetConstantInitializer(graph_, b_arg.Name());
+    Initializer b(*b_tensor_proto, graph_.ModelPath());
+    const int64_t rows = b_tensor_proto->dims(0);
+    const int64_t cols = b_tensor_proto->dims(1);
+
+    Initializer b_transposed(static_cast<ONNX_NAMESPACE::TensorProto_DataType>(b_tensor_proto->data_type()),
+                             graph_.GenerateNodeArgName(b_arg.Name() + "_transposed"),
+                             {cols, rows});
+    // both uint8_t and int8_t elements are moved as bytes
+    const uint8_t* src = b.data<uint8_t>();
+    uint8_t* dst = b_transposed.data<uint8_t>();
+    for (int64_t r = 0; r < rows; ++r) {
+      for (int64_t c = 0; c < cols; ++c) {
+        dst[c * rows + r] = src[r * cols + c];
+      }
+    }
+
+    ONNX_NAMESPACE::TensorProto b_transposed_tensor_proto;
+    b_transposed.ToProto(b_transposed_tensor_proto);
+    return graph_utils::AddInitializer(graph_, b_transposed_tensor_proto);
+  }
+};
+
+DEFINE_QDQ_CREATOR(Gemm, QDQGemmTransformer)
+}  // namespace onnxruntime
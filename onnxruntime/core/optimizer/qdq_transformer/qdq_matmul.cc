@@ -17,7 +17,8 @@ class QDQMatMulTransformer : public QDQOperatorTransformer {
     if (q_nodes.size() == 1) {
       return FuseQLinearMatMul(dq_nodes, q_nodes);
     }
-    if (q_nodes.size() == 0) {
+    // MatMulIntegerToFloat only has a CPU kernel.
+    if (q_nodes.size() == 0 && node_.GetExecutionProviderType() == kCpuExecutionProvider) {
       return FuseMatMulIntegerToFloat(dq_nodes);
     }
     return false;
@@ -57,7 +58,7 @@ class QDQMatMulTransformer : public QDQOperatorTransformer {
                    q->MutableOutputDefs(),
                    &node_.GetAttributes(),
                    kOnnxDomain)
-        .SetExecutionProviderType(kCpuExecutionProvider);
+        .SetExecutionProviderType(node_.GetExecutionProviderType());
     return true;
   }
 
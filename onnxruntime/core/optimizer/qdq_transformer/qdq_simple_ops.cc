@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "core/graph/graph.h"
+#include "core/graph/graph_utils.h"
 #include "core/optimizer/qdq_transformer/qdq_op_transformer.h"
 #include "core/optimizer/qdq_transformer/qdq_util.h"
 #include "core/optimizer/qdq_transformer/registry.h"
@@ -31,6 +32,7 @@ class QDQSimpleTransformer : public QDQOperatorTransformer {
   bool Check(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) const override {
     if (1 != dq_nodes.size() ||  // check that input *data* is output of DequantizeLinear
         1 != q_nodes.size() ||
+        dq_nodes[0]->OutputDefs()[0] != node_.InputDefs()[0] ||
         !optimizer_utils::CheckOutputEdges(graph_, node_, 1)) {
       return false;
     }
@@ -39,8 +41,66 @@ class QDQSimpleTransformer : public QDQOperatorTransformer {
   }
 };
 
+// Resize only has uint8_t kernels for the quantized data.
+class QDQResizeTransformer : public QDQSimpleTransformer {
+ public:
+  QDQResizeTransformer(Node& node, Graph& graph) : QDQSimpleTransformer(node, graph) {}
+
+ protected:
+  bool Check(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) const override {
+    if (!QDQSimpleTransformer::Check(dq_nodes, q_nodes)) {
+      return false;
+    }
+
+    int32_t dt = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+    return dt == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8;
+  }
+};
+
+// Pad takes the padding value as an input of the data type since opset 11, so the quantized Pad uses the zero
+// point, which is the quantized 0. Padding with another constant value is not fused.
+class QDQPadTransformer : public QDQSimpleTransformer {
+ public:
+  QDQPadTransformer(Node& node, Graph& graph) : QDQSimpleTransformer(node, graph) {}
+
+ protected:
+  bool TransformImpl(const std::vector<const Node*>& parents, const std::vector<const Node*>& children) override {
+    QDQSimpleTransformer::TransformImpl(parents, children);
+
+    Node* q = graph_.GetNode(children[0]->Index());
+    NodeArg* zero_point = q->MutableInputDefs()[QDQ::QDQInputIndex::ZERO_POINT_ID];
+    std::vector<NodeArg*>& input_defs = node_.MutableInputDefs();
+    if (input_defs.size() > 2) {
+      input_defs[2] = zero_point;
+    } else {
+      input_defs.push_back(zero_point);
+    }
+    return true;
+  }
+
+  bool Check(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) const override {
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node_, "Pad", {11, 13}) ||
+        !QDQSimpleTransformer::Check(dq_nodes, q_nodes)) {
+      return false;
+    }
+
+    // the padding value is ignored by the other modes
+    const auto* mode = graph_utils::GetNodeAttribute(node_, "mode");
+    if (mode != nullptr && mode->s() != "constant") {
+      return true;
+    }
+
+    const auto& input_defs = node_.InputDefs();
+    return input_defs.size() < 3 ||
+           !input_defs[2]->Exists() ||
+           optimizer_utils::IsInitializerWithExpectedValue(graph_, *input_defs[2], 0.0f, true);
+  }
+};
+
 DEFINE_QDQ_CREATOR(MaxPool, QDQSimpleTransformer)
 DEFINE_QDQ_CREATOR(Reshape, QDQSimpleTransformer)
 DEFINE_QDQ_CREATOR(Gather, QDQSimpleTransformer)
 DEFINE_QDQ_CREATOR(Transpose, QDQSimpleTransformer)
+DEFINE_QDQ_CREATOR(Resize, QDQResizeTransformer)
+DEFINE_QDQ_CREATOR(Pad, QDQPadTransformer)
 }  // namespace onnxruntime
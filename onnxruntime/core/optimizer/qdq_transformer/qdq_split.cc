@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "core/graph/graph.h"
+#include "core/optimizer/qdq_transformer/qdq_op_transformer.h"
+#include "core/optimizer/qdq_transformer/qdq_util.h"
+#include "core/optimizer/qdq_transformer/registry.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+// Split moves quantized values like the simple ops, but has a QuantizeLinear on each of its outputs.
+class QDQSplitTransformer : public QDQOperatorTransformer {
+ public:
+  QDQSplitTransformer(Node& node, Graph& graph) : QDQOperatorTransformer(node, graph) {}
+
+ protected:
+  bool TransformImpl(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) override {
+    graph_.RemoveEdge(dq_nodes[0]->Index(), node_.Index(), 0, 0);
+    node_.MutableInputDefs()[0] = graph_.GetNode(dq_nodes[0]->Index())->MutableInputDefs()[0];
+
+    for (size_t i = 0; i < q_nodes.size(); ++i) {
+      graph_.RemoveEdge(node_.Index(), q_nodes[i]->Index(), static_cast<int>(i), 0);
+      node_.MutableOutputDefs()[i] = graph_.GetNode(q_nodes[i]->Index())->MutableOutputDefs()[0];
+    }
+    return true;
+  }
+
+  bool KeepNode() const override {
+    return true;
+  }
+
+  bool Check(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) const override {
+    const auto& output_defs = node_.OutputDefs();
+    if (1 != dq_nodes.size() ||  // check that input *data* is output of DequantizeLinear
+        dq_nodes[0]->OutputDefs()[0] != node_.InputDefs()[0] ||
+        output_defs.size() != q_nodes.size() ||
+        !optimizer_utils::CheckOutputEdges(graph_, node_, q_nodes.size())) {
+      return false;
+    }
+
+    // Split only has uint8_t kernels for the quantized data
+    int32_t dt = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+    if (dt != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8) {
+      return false;
+    }
+
+    // q_nodes are sorted by output index, each output needs to flow to exactly one of them
+    for (size_t i = 0; i < q_nodes.size(); ++i) {
+      if (q_nodes[i]->InputDefs()[0] != output_defs[i] ||
+          !QDQ::IsQDQPairSupported(graph_, *q_nodes[i], *dq_nodes[0])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+DEFINE_QDQ_CREATOR(Split, QDQSplitTransformer)
+}  // namespace onnxruntime
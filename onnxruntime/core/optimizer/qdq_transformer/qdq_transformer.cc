@@ -83,7 +83,9 @@ Status QDQTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
   for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
     auto& node = *graph.GetNode(index);
     ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
-    if (node.GetExecutionProviderType() == kCpuExecutionProvider) {
+    // The CUDA EP has a QLinearMatMul kernel, the other fused operators only run on CPU.
+    if (node.GetExecutionProviderType() == kCpuExecutionProvider ||
+        (node.GetExecutionProviderType() == kCudaExecutionProvider && node.OpType() == "MatMul")) {
       impl.Transform(node);
     }
   }
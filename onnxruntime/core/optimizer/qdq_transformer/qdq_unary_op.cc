@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <vector>
+
+#include "core/graph/graph.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/qdq_transformer/qdq_op_transformer.h"
+#include "core/optimizer/qdq_transformer/registry.h"
+
+namespace onnxruntime {
+// Replace the unary ops that have a QLinear version taking X, X_scale, X_zero_point, Y_scale and Y_zero_point.
+class QDQUnaryOpTransformer : public QDQOperatorTransformer {
+ public:
+  QDQUnaryOpTransformer(Node& node, Graph& graph) : QDQOperatorTransformer(node, graph) {}
+
+ protected:
+  bool TransformImpl(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) override {
+    std::vector<NodeArg*> input_defs(graph_.GetNode(dq_nodes[0]->Index())->MutableInputDefs());
+
+    Node* q = graph_.GetNode(q_nodes[0]->Index());
+    input_defs.push_back(q->MutableInputDefs()[1]);
+    input_defs.push_back(q->MutableInputDefs()[2]);
+
+    graph_.AddNode(node_.Name(),
+                   "QLinear" + node_.OpType(),
+                   node_.Description(),
+                   input_defs,
+                   q->MutableOutputDefs(),
+                   &node_.GetAttributes(),
+                   kMSDomain)
+        .SetExecutionProviderType(kCpuExecutionProvider);
+    return true;
+  }
+};
+
+// Before opset 13 Softmax flattens the input to 2D at axis, it only matches QLinearSoftmax when axis is the last one.
+class QDQSoftmaxTransformer : public QDQUnaryOpTransformer {
+ public:
+  QDQSoftmaxTransformer(Node& node, Graph& graph) : QDQUnaryOpTransformer(node, graph) {}
+
+ protected:
+  bool Check(const std::vector<const Node*>& dq_nodes, const std::vector<const Node*>& q_nodes) const override {
+    if (!QDQUnaryOpTransformer::Check(dq_nodes, q_nodes)) {
+      return false;
+    }
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node_, "Softmax", {1, 11})) {
+      return true;
+    }
+
+    const auto* shape = node_.InputDefs()[0]->Shape();
+    if (shape == nullptr) {
+      return false;
+    }
+
+    const int64_t rank = shape->dim_size();
+    const auto* axis_attr = graph_utils::GetNodeAttribute(node_, "axis");
+    int64_t axis = axis_attr != nullptr ? axis_attr->i() : 1;
+    if (axis < 0) {
+      axis += rank;
+    }
+    return axis == rank - 1;
+  }
+};
+
+DEFINE_QDQ_CREATOR(Sigmoid, QDQUnaryOpTransformer)
+DEFINE_QDQ_CREATOR(LeakyRelu, QDQUnaryOpTransformer)
+DEFINE_QDQ_CREATOR(Softmax, QDQSoftmaxTransformer)
+}  // namespace onnxruntime
@@ -14,6 +14,13 @@ DECLARE_QDQ_CREATOR(Mul, QDQBinaryOpTransformer);
 DECLARE_QDQ_CREATOR(MatMul, QDQMatMulTransformer);
 DECLARE_QDQ_CREATOR(AveragePool, QDQAveragePoolTransformer);
 DECLARE_QDQ_CREATOR(Concat, QDQConcatTransformer);
+DECLARE_QDQ_CREATOR(Resize, QDQResizeTransformer);
+DECLARE_QDQ_CREATOR(Pad, QDQPadTransformer);
+DECLARE_QDQ_CREATOR(Split, QDQSplitTransformer);
+DECLARE_QDQ_CREATOR(Sigmoid, QDQUnaryOpTransformer);
+DECLARE_QDQ_CREATOR(LeakyRelu, QDQUnaryOpTransformer);
+DECLARE_QDQ_CREATOR(Softmax, QDQSoftmaxTransformer);
+DECLARE_QDQ_CREATOR(Gemm, QDQGemmTransformer);
 
 std::unordered_map<std::string, QDQRegistry::QDQTransformerCreator> QDQRegistry::qdqtransformer_creators_{
     REGISTER_QDQ_CREATOR(Conv, QDQConvTransformer),
@@ -26,5 +33,12 @@ std::unordered_map<std::string, QDQRegistry::QDQTransformerCreator> QDQRegistry:
     REGISTER_QDQ_CREATOR(MatMul, QDQMatMulTransformer),
     REGISTER_QDQ_CREATOR(AveragePool, QDQAveragePoolTransformer),
     REGISTER_QDQ_CREATOR(Concat, QDQConcatTransformer),
+    REGISTER_QDQ_CREATOR(Resize, QDQResizeTransformer),
+    REGISTER_QDQ_CREATOR(Pad, QDQPadTransformer),
+    REGISTER_QDQ_CREATOR(Split, QDQSplitTransformer),
+    REGISTER_QDQ_CREATOR(Sigmoid, QDQUnaryOpTransformer),
+    REGISTER_QDQ_CREATOR(LeakyRelu, QDQUnaryOpTransformer),
+    REGISTER_QDQ_CREATOR(Softmax, QDQSoftmaxTransformer),
+    REGISTER_QDQ_CREATOR(Gemm, QDQGemmTransformer),
 };
 }  // namespace onnxruntime
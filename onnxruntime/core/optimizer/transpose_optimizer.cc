@@ -0,0 +1,899 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/transpose_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+using Permutation = std::vector<int64_t>;
+
+// Describes how a node changes when a Transpose with permutation 'perm' is moved from its inputs to its outputs,
+// i.e. Op(Transpose(x, perm), ...) is rewritten to Transpose(Op'(x, ...), output_perm).
+struct PushPlan {
+  // inputs that are transposed with the inverse permutation
+  std::vector<int> inputs;
+
+  // if true the inputs are broadcast, so inputs with a lower rank than perm are valid
+  bool broadcast_inputs{false};
+
+  // permutation of the Transpose added after each output. an empty permutation means the output is unchanged.
+  std::vector<Permutation> output_perms;
+
+  std::unordered_map<std::string, int64_t> int_attributes;
+  std::unordered_map<std::string, std::vector<int64_t>> ints_attributes;
+
+  // constant inputs that are replaced, e.g. the pads of Pad
+  std::vector<std::pair<int, TensorProto>> new_constant_inputs;
+};
+
+using PushHandler = bool (*)(Graph& graph, const Node& node, const Permutation& perm, PushPlan& plan);
+
+Permutation InvertPermutation(const Permutation& perm) {
+  Permutation inverse(perm.size());
+  for (size_t i = 0; i < perm.size(); ++i) {
+    inverse[static_cast<size_t>(perm[i])] = static_cast<int64_t>(i);
+  }
+  return inverse;
+}
+
+// Transpose(Transpose(x, first), second) == Transpose(x, ComposePermutations(first, second))
+Permutation ComposePermutations(const Permutation& first, const Permutation& second) {
+  Permutation result(second.size());
+  for (size_t i = 0; i < second.size(); ++i) {
+    result[i] = first[static_cast<size_t>(second[i])];
+  }
+  return result;
+}
+
+bool IsIdentityPermutation(const Permutation& perm) {
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (perm[i] != static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsValidPermutation(const Permutation& perm) {
+  std::vector<bool> seen(perm.size(), false);
+  for (auto axis : perm) {
+    if (axis < 0 || axis >= static_cast<int64_t>(perm.size()) || seen[static_cast<size_t>(axis)]) {
+      return false;
+    }
+    seen[static_cast<size_t>(axis)] = true;
+  }
+  return true;
+}
+
+bool GetTransposePermutation(const Node& transpose, Permutation& perm) {
+  if (!graph_utils::GetRepeatedNodeAttributeValues(transpose, "perm", perm)) {
+    // the default permutation reverses the dimensions, which requires the rank of the input
+    const auto* shape = transpose.InputDefs()[0]->Shape();
+    if (shape == nullptr) {
+      return false;
+    }
+    perm.resize(shape->dim_size());
+    std::iota(perm.rbegin(), perm.rend(), int64_t{0});
+  }
+
+  return IsValidPermutation(perm);
+}
+
+bool IsOnnxTranspose(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1, 13});
+}
+
+// Returns the rank of the value, or -1 if unknown.
+int GetRank(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  return shape == nullptr ? -1 : shape->dim_size();
+}
+
+// Returns the number of elements of the value, or -1 if unknown.
+int64_t GetNumElements(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return -1;
+  }
+
+  int64_t num_elements = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return -1;
+    }
+    num_elements *= dim.dim_value();
+  }
+  return num_elements;
+}
+
+// Normalizes a possibly negative axis. Returns false if it is out of range.
+bool NormalizeAxis(int64_t& axis, int64_t rank) {
+  if (axis < 0) {
+    axis += rank;
+  }
+  return axis >= 0 && axis < rank;
+}
+
+void SetTransposedShape(NodeArg& arg, const NodeArg& base, const Permutation& perm) {
+  const auto* base_shape = base.Shape();
+  if (base_shape == nullptr || base_shape->dim_size() != static_cast<int>(perm.size())) {
+    arg.ClearShape();
+    return;
+  }
+
+  TensorShapeProto shape;
+  for (auto axis : perm) {
+    *shape.add_dim() = base_shape->dim(static_cast<int>(axis));
+  }
+  arg.SetShape(shape);
+}
+
+// Creates a copy of a constant with its dimensions permuted. A constant with a lower rank than perm is first
+// extended with leading dimensions of 1 as if it was broadcast.
+bool TransposeConstant(Graph& graph, const TensorProto& tensor, const Permutation& perm, TensorProto& result) {
+  const size_t rank = perm.size();
+  if (tensor.data_type() == TensorProto_DataType_STRING || static_cast<size_t>(tensor.dims_size()) > rank) {
+    return false;
+  }
+
+  std::unique_ptr<unsigned char[]> data;
+  size_t num_bytes = 0;
+  if (!utils::UnpackInitializerData(tensor, graph.ModelPath(), data, num_bytes).IsOK()) {
+    return false;
+  }
+
+  std::vector<int64_t> dims(rank - tensor.dims_size(), 1);
+  dims.insert(dims.end(), tensor.dims().begin(), tensor.dims().end());
+
+  const int64_t num_elements = std::accumulate(dims.begin(), dims.end(), int64_t{1}, std::multiplies<int64_t>());
+  if (num_elements <= 0 || num_bytes % static_cast<size_t>(num_elements) != 0) {
+    return false;
+  }
+  const size_t element_size = num_bytes / static_cast<size_t>(num_elements);
+
+  std::vector<int64_t> strides(rank, 1);
+  for (size_t i = rank; i-- > 1;) {
+    strides[i - 1] = strides[i] * dims[i];
+  }
+
+  std::vector<int64_t> new_dims(rank);
+  std::vector<int64_t> new_strides(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    new_dims[i] = dims[static_cast<size_t>(perm[i])];
+    new_strides[i] = strides[static_cast<size_t>(perm[i])];
+  }
+
+  std::string transposed(num_bytes, '\0');
+  std::vector<int64_t> index(rank, 0);
+  int64_t source_offset = 0;
+  for (int64_t n = 0; n < num_elements; ++n) {
+    std::memcpy(&transposed[static_cast<size_t>(n) * element_size],
+                data.get() + static_cast<size_t>(source_offset) * element_size, element_size);
+
+    // advance the output index, tracking the matching offset in the source
+    for (size_t i = rank; i-- > 0;) {
+      source_offset += new_strides[i];
+      if (++index[i] < new_dims[i]) {
+        break;
+      }
+      source_offset -= new_strides[i] * new_dims[i];
+      index[i] = 0;
+    }
+  }
+
+  result.set_name(graph.GenerateNodeArgName(tensor.name() + "_transposed"));
+  result.set_data_type(tensor.data_type());
+  for (auto dim : new_dims) {
+    result.add_dims(dim);
+  }
+  result.set_raw_data(std::move(transposed));
+  return true;
+}
+
+bool HasSingleElement(const NodeArg& arg) {
+  return GetNumElements(arg) == 1;
+}
+
+//
+// Handlers
+//
+
+bool PushThroughElementwise(Graph& /*graph*/, const Node& node, const Permutation& perm, PushPlan& plan) {
+  for (int i = 0, end = static_cast<int>(node.InputDefs().size()); i < end; ++i) {
+    plan.inputs.push_back(i);
+  }
+  plan.broadcast_inputs = true;
+  plan.output_perms.assign(node.OutputDefs().size(), perm);
+  return true;
+}
+
+// Quantize and dequantize ops are elementwise if the scale and zero point are per tensor
+bool PushThroughQuantizeLinear(Graph& /*graph*/, const Node& node, const Permutation& perm, PushPlan& plan) {
+  const auto& inputs = node.InputDefs();
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    if (inputs[i]->Exists() && !HasSingleElement(*inputs[i])) {
+      return false;
+    }
+  }
+
+  plan.inputs.push_back(0);
+  plan.output_perms.assign(node.OutputDefs().size(), perm);
+  return true;
+}
+
+bool PushThroughConcat(Graph& /*graph*/, const Node& node, const Permutation& perm, PushPlan& plan) {
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  int64_t axis = axis_attr == nullptr ? 0 : axis_attr->i();
+  if (!NormalizeAxis(axis, static_cast<int64_t>(perm.size()))) {
+    return false;
+  }
+
+  for (int i = 0, end = static_cast<int>(node.InputDefs().size()); i < end; ++i) {
+    plan.inputs.push_back(i);
+  }
+  plan.int_attributes["axis"] = perm[static_cast<size_t>(axis)];
+  plan.output_perms.assign(node.OutputDefs().size(), perm);
+  return true;
+}
+
+bool PushThroughSplit(Graph& /*graph*/, const Node& node, const Permutation& perm, PushPlan& plan) {
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  int64_t axis = axis_attr == nullptr ? 0 : axis_attr->i();
+  if (!NormalizeAxis(axis, static_cast<int64_t>(perm.size()))) {
+    return false;
+  }
+
+  plan.inputs.push_back(0);
+  plan.int_attributes["axis"] = perm[static_cast<size_t>(axis)];
+  plan.output_perms.assign(node.OutputDefs().size(), perm);
+  return true;
+}
+
+// Softmax, LogSoftmax and Hardmax from opset 13 operate on a single axis. Earlier versions coerce the input to 2D.
+bool PushThroughSoftmax(Graph& /*graph*/, const Node& node, const Permutation& perm, PushPlan& plan) {
+  if (node.SinceVersion() < 13) {
+    return false;
+  }
+
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  int64_t axis = axis_attr == nullptr ? -1 : axis_attr->i();
+  if (!NormalizeAxis(axis, static_cast<int64_t>(perm.size()))) {
+    return false;
+  }
+
+  plan.inputs.push_back(0);
+  plan.int_attributes["axis"] = perm[static_cast<size_t>(axis)];
+  plan.output_perms.push_back(perm);
+  return true;
+}
+
+// Sets the permutation of the reduced output. Without keepdims the reduced axes are removed and the remaining axes
+// keep their relative order in the original input.
+void SetReducedOutputPermutation(const Permutation& perm, const std::vector<int64_t>& axes, bool keepdims,
+                                 PushPlan& plan) {
+  if (keepdims) {
+    plan.output_perms.push_back(perm);
+    return;
+  }
+
+  const size_t rank = perm.size();
+  std::vector<bool> reduced(rank, false);
+  for (auto axis : axes) {
+    reduced[static_cast<size_t>(axis)] = true;
+  }
+
+  // position of each kept input axis in the output of the rewritten node
+  std::vector<int64_t> output_position(rank, -1);
+  int64_t position = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    if (!reduced[i]) {
+      output_position[i] = position++;
+    }
+  }
+
+  Permutation output_perm;
+  for (size_t i = 0; i < rank; ++i) {
+    if (!reduced[static_cast<size_t>(perm[i])]) {
+      output_perm.push_back(output_position[static_cast<size_t>(perm[i])]);
+    }
+  }
+
+  plan.output_perms.push_back(IsIdentityPermutation(output_perm) ? Permutation{} : output_perm);
+}
+
+bool PushThroughReduce(Graph& /*graph*/, const Node& node, const Permutation& perm, PushPlan& plan) {
+  // ReduceSum from opset 13 takes the axes as an input
+  if (node.InputDefs().size() > 1) {
+    return false;
+  }
+
+  const int64_t rank = static_cast<int64_t>(perm.size());
+  const auto* keepdims_attr = graph_utils::GetNodeAttribute(node, "keepdims");
+  const bool keepdims = keepdims_attr == nullptr || keepdims_attr->i() != 0;
+
+  std::vector<int64_t> axes;
+  if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes) || axes.empty()) {
+    const auto* noop_attr = graph_utils::GetNodeAttribute(node, "noop_with_empty_axes");
+    if (noop_attr != nullptr && noop_attr->i() != 0) {
+      return false;
+    }
+
+    // all axes are reduced, so the output has no dimension other than 1 and does not need a Transpose
+    plan.inputs.push_back(0);
+    plan.output_perms.emplace_back();
+    return true;
+  }
+
+  std::vector<int64_t> new_axes;
+  for (auto axis : axes) {
+    if (!NormalizeAxis(axis, rank)) {
+      return false;
+    }
+    new_axes.push_back(perm[static_cast<size_t>(axis)]);
+  }
+
+  plan.inputs.push_back(0);
+  plan.ints_attributes["axes"] = new_axes;
+  SetReducedOutputPermutation(perm, new_axes, keepdims, plan);
+  return true;
+}
+
+bool PushThroughArgMinMax(Graph& /*graph*/, const Node& node, const Permutation& perm, PushPlan& plan) {
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  int64_t axis = axis_attr == nullptr ? 0 : axis_attr->i();
+  if (!NormalizeAxis(axis, static_cast<int64_t>(perm.size()))) {
+    return false;
+  }
+
+  const auto* keepdims_attr = graph_utils::GetNodeAttribute(node, "keepdims");
+  const bool keepdims = keepdims_attr == nullptr || keepdims_attr->i() != 0;
+  const int64_t new_axis = perm[static_cast<size_t>(axis)];
+
+  plan.inputs.push_back(0);
+  plan.int_attributes["axis"] = new_axis;
+  SetReducedOutputPermutation(perm, {new_axis}, keepdims, plan);
+  return true;
+}
+
+// pads holds the start values of all axes followed by the end values
+std::vector<int64_t> PermutePads(const std::vector<int64_t>& pads, const Permutation& perm) {
+  const size_t rank = perm.size();
+  std::vector<int64_t> new_pads(pads.size());
+  for (size_t i = 0; i < rank; ++i) {
+    new_pads[static_cast<size_t>(perm[i])] = pads[i];
+    new_pads[rank + static_cast<size_t>(perm[i])] = pads[rank + i];
+  }
+  return new_pads;
+}
+
+bool PushThroughPad(Graph& graph, const Node& node, const Permutation& perm, PushPlan& plan) {
+  const size_t rank = perm.size();
+
+  if (node.SinceVersion() < 11) {
+    std::vector<int64_t> pads;
+    if (!graph_utils::GetRepeatedNodeAttributeValues(node, "pads", pads) || pads.size() != 2 * rank) {
+      return false;
+    }
+    plan.ints_attributes["pads"] = PermutePads(pads, perm);
+  } else {
+    // the pads are an input from opset 11, so they have to be constant
+    const auto& inputs = node.InputDefs();
+    if (inputs.size() < 2 || !inputs[1]->Exists()) {
+      return false;
+    }
+
+    const auto* pads_tensor = graph_utils::GetConstantInitializer(graph, inputs[1]->Name());
+    if (pads_tensor == nullptr || pads_tensor->data_type() != TensorProto_DataType_INT64) {
+      return false;
+    }
+
+    std::vector<int64_t> pads(2 * rank);
+    if (pads_tensor->dims_size() != 1 || pads_tensor->dims(0) != static_cast<int64_t>(pads.size()) ||
+        !utils::UnpackTensor(*pads_tensor, graph.ModelPath(), pads.data(), pads.size()).IsOK()) {
+      return false;
+    }
+
+    const auto new_pads = PermutePads(pads, perm);
+    TensorProto new_pads_tensor(*pads_tensor);
+    new_pads_tensor.set_name(graph.GenerateNodeArgName(pads_tensor->name() + "_transposed"));
+    new_pads_tensor.clear_int64_data();
+    new_pads_tensor.clear_external_data();
+    new_pads_tensor.clear_data_location();
+    new_pads_tensor.set_raw_data(new_pads.data(), new_pads.size() * sizeof(int64_t));
+    plan.new_constant_inputs.emplace_back(1, std::move(new_pads_tensor));
+  }
+
+  plan.inputs.push_back(0);
+  plan.output_perms.push_back(perm);
+  return true;
+}
+
+const std::unordered_map<std::string, PushHandler>& GetPushHandlers() {
+  static const std::unordered_map<std::string, PushHandler> handlers = {
+      {"Abs", PushThroughElementwise},
+      {"Add", PushThroughElementwise},
+      {"And", PushThroughElementwise},
+      {"Cast", PushThroughElementwise},
+      {"Ceil", PushThroughElementwise},
+      {"Clip", PushThroughElementwise},
+      {"Div", PushThroughElementwise},
+      {"Elu", PushThroughElementwise},
+      {"Equal", PushThroughElementwise},
+      {"Erf", PushThroughElementwise},
+      {"Exp", PushThroughElementwise},
+      {"Floor", PushThroughElementwise},
+      {"Greater", PushThroughElementwise},
+      {"GreaterOrEqual", PushThroughElementwise},
+      {"HardSigmoid", PushThroughElementwise},
+      {"Identity", PushThroughElementwise},
+      {"LeakyRelu", PushThroughElementwise},
+      {"Less", PushThroughElementwise},
+      {"LessOrEqual", PushThroughElementwise},
+      {"Log", PushThroughElementwise},
+      {"Max", PushThroughElementwise},
+      {"Mean", PushThroughElementwise},
+      {"Min", PushThroughElementwise},
+      {"Mul", PushThroughElementwise},
+      {"Neg", PushThroughElementwise},
+      {"Not", PushThroughElementwise},
+      {"Or", PushThroughElementwise},
+      {"Pow", PushThroughElementwise},
+      {"PRelu", PushThroughElementwise},
+      {"Reciprocal", PushThroughElementwise},
+      {"Relu", PushThroughElementwise},
+      {"Round", PushThroughElementwise},
+      {"Selu", PushThroughElementwise},
+      {"Sigmoid", PushThroughElementwise},
+      {"Sign", PushThroughElementwise},
+      {"Softplus", PushThroughElementwise},
+      {"Softsign", PushThroughElementwise},
+      {"Sqrt", PushThroughElementwise},
+      {"Sub", PushThroughElementwise},
+      {"Sum", PushThroughElementwise},
+      {"Tanh", PushThroughElementwise},
+      {"Where", PushThroughElementwise},
+      {"Xor", PushThroughElementwise},
+      {"QuantizeLinear", PushThroughQuantizeLinear},
+      {"DequantizeLinear", PushThroughQuantizeLinear},
+      {"Concat", PushThroughConcat},
+      {"Split", PushThroughSplit},
+      {"Softmax", PushThroughSoftmax},
+      {"LogSoftmax", PushThroughSoftmax},
+      {"Hardmax", PushThroughSoftmax},
+      {"ReduceL1", PushThroughReduce},
+      {"ReduceL2", PushThroughReduce},
+      {"ReduceLogSum", PushThroughReduce},
+      {"ReduceLogSumExp", PushThroughReduce},
+      {"ReduceMax", PushThroughReduce},
+      {"ReduceMean", PushThroughReduce},
+      {"ReduceMin", PushThroughReduce},
+      {"ReduceProd", PushThroughReduce},
+      {"ReduceSum", PushThroughReduce},
+      {"ReduceSumSquare", PushThroughReduce},
+      {"ArgMax", PushThroughArgMinMax},
+      {"ArgMin", PushThroughArgMinMax},
+      {"Pad", PushThroughPad},
+  };
+  return handlers;
+}
+
+//
+// Graph editing
+//
+
+// Returns the Transpose node producing the input if it can be bypassed, i.e. if the input is Transpose(x, perm).
+Node* GetInputTranspose(Graph& graph, const Node& node, int input_idx, const Permutation& perm) {
+  const Node* producer = graph_utils::GetInputNode(node, input_idx);
+  if (producer == nullptr || !IsOnnxTranspose(*producer)) {
+    return nullptr;
+  }
+
+  Permutation producer_perm;
+  if (!GetTransposePermutation(*producer, producer_perm) || producer_perm != perm) {
+    return nullptr;
+  }
+
+  return graph.GetNode(producer->Index());
+}
+
+// Returns true if all the consumers of the Transpose output are inputs of 'node', so it can be removed once they
+// are bypassed.
+bool IsOnlyConsumer(const Graph& graph, const Node& transpose, const Node& node) {
+  if (graph.IsOutput(transpose.OutputDefs()[0])) {
+    return false;
+  }
+
+  for (auto edge = transpose.OutputEdgesBegin(), end = transpose.OutputEdgesEnd(); edge != end; ++edge) {
+    if (edge->GetNode().Index() != node.Index()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Returns true if every consumer of the output is a Transpose that cancels 'perm'.
+bool OutputTransposesCancel(const Graph& graph, const Node& node, int output_idx, const Permutation& perm) {
+  if (graph.IsOutput(node.OutputDefs()[output_idx])) {
+    return false;
+  }
+
+  bool has_consumer = false;
+  for (auto edge = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); edge != end; ++edge) {
+    if (edge->GetSrcArgIndex() != output_idx) {
+      continue;
+    }
+
+    Permutation consumer_perm;
+    const Node& consumer = edge->GetNode();
+    if (!IsOnnxTranspose(consumer) || !GetTransposePermutation(consumer, consumer_perm) ||
+        consumer_perm.size() != perm.size() || !IsIdentityPermutation(ComposePermutations(perm, consumer_perm))) {
+      return false;
+    }
+    has_consumer = true;
+  }
+
+  return has_consumer;
+}
+
+// Changes the input of 'node' to the value produced by output src_idx of 'src', or to a graph input or
+// initializer if src is nullptr.
+void ReplaceInput(Graph& graph, Node& node, int input_idx, NodeArg& new_input, const Node* src, int src_idx) {
+  const Node::EdgeEnd* edge = graph_utils::GetInputEdge(node, input_idx);
+  if (edge != nullptr) {
+    graph.RemoveEdge(edge->GetNode().Index(), node.Index(), edge->GetSrcArgIndex(), input_idx);
+  }
+
+  node.MutableInputDefs()[input_idx] = &new_input;
+  if (src != nullptr) {
+    graph.AddEdge(src->Index(), node.Index(), src_idx, input_idx);
+  }
+}
+
+NodeAttributes MakePermAttribute(const Permutation& perm) {
+  AttributeProto perm_attr;
+  perm_attr.set_name("perm");
+  perm_attr.set_type(AttributeProto_AttributeType_INTS);
+  for (auto axis : perm) {
+    perm_attr.add_ints(axis);
+  }
+
+  NodeAttributes attributes;
+  attributes["perm"] = perm_attr;
+  return attributes;
+}
+
+// Inserts Transpose(input, perm) in front of the input of 'node'
+void InsertTransposeBefore(Graph& graph, Node& node, int input_idx, const Permutation& perm) {
+  NodeArg* input = node.MutableInputDefs()[input_idx];
+  NodeArg& transposed = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(input->Name() + "_transposed"),
+                                                 input->TypeAsProto());
+  SetTransposedShape(transposed, *input, perm);
+
+  const auto attributes = MakePermAttribute(perm);
+  Node& transpose = graph.AddNode(graph.GenerateNodeName("Transpose"), "Transpose", "Added by TransposeOptimizer",
+                                  {input}, {&transposed}, &attributes, kOnnxDomain);
+  transpose.SetExecutionProviderType(node.GetExecutionProviderType());
+
+  const Node::EdgeEnd* edge = graph_utils::GetInputEdge(node, input_idx);
+  if (edge != nullptr) {
+    const NodeIndex src = edge->GetNode().Index();
+    const int src_idx = edge->GetSrcArgIndex();
+    graph.RemoveEdge(src, node.Index(), src_idx, input_idx);
+    graph.AddEdge(src, transpose.Index(), src_idx, 0);
+  }
+
+  node.MutableInputDefs()[input_idx] = &transposed;
+  graph.AddEdge(transpose.Index(), node.Index(), 0, input_idx);
+}
+
+// Inserts a Transpose with 'perm' after the output of 'node'. The Transpose produces the original value so the
+// consumers and graph outputs are unchanged.
+void InsertTransposeAfter(Graph& graph, Node& node, int output_idx, const Permutation& perm) {
+  NodeArg* output = node.MutableOutputDefs()[output_idx];
+  NodeArg& untransposed = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name() + "_untransposed"),
+                                                   output->TypeAsProto());
+  SetTransposedShape(untransposed, *output, InvertPermutation(perm));
+
+  const auto attributes = MakePermAttribute(perm);
+  Node& transpose = graph.AddNode(graph.GenerateNodeName("Transpose"), "Transpose", "Added by TransposeOptimizer",
+                                  {&untransposed}, {output}, &attributes, kOnnxDomain);
+  transpose.SetExecutionProviderType(node.GetExecutionProviderType());
+
+  std::vector<Node::EdgeEnd> output_edges;
+  for (auto edge = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); edge != end; ++edge) {
+    if (edge->GetSrcArgIndex() == output_idx) {
+      output_edges.push_back(*edge);
+    }
+  }
+
+  for (const auto& edge : output_edges) {
+    graph.RemoveEdge(node.Index(), edge.GetNode().Index(), output_idx, edge.GetDstArgIndex());
+    graph.AddEdge(transpose.Index(), edge.GetNode().Index(), 0, edge.GetDstArgIndex());
+  }
+
+  node.MutableOutputDefs()[output_idx] = &untransposed;
+  graph.AddEdge(node.Index(), transpose.Index(), output_idx, 0);
+}
+
+// Replaces the input of 'node' produced by 'transpose' with the input of 'transpose'
+void BypassTranspose(Graph& graph, Node& node, int input_idx, Node& transpose) {
+  const Node::EdgeEnd* source = graph_utils::GetInputEdge(transpose, 0);
+  ReplaceInput(graph, node, input_idx, *transpose.MutableInputDefs()[0],
+               source == nullptr ? nullptr : &source->GetNode(), source == nullptr ? 0 : source->GetSrcArgIndex());
+}
+
+void RemoveIfUnused(Graph& graph, Node& node) {
+  if (node.GetOutputEdgesCount() == 0 && !graph.IsOutput(node.OutputDefs()[0])) {
+    graph.RemoveNode(node.Index());
+  }
+}
+
+// Accumulates the cost of the Transpose nodes added and removed by a rewrite. The cost of a Transpose is the number
+// of elements it moves. If any of the sizes is unknown every Transpose counts as 1.
+class TransposeCost {
+ public:
+  void Add(const NodeArg& arg) { Update(arg, 1); }
+  void Remove(const NodeArg& arg) { Update(arg, -1); }
+
+  bool IsBeneficial() const {
+    return sizes_known_ ? elements_ <= 0 : count_ <= 0;
+  }
+
+ private:
+  void Update(const NodeArg& arg, int64_t sign) {
+    const int64_t num_elements = GetNumElements(arg);
+    if (num_elements < 0) {
+      sizes_known_ = false;
+    }
+    elements_ += sign * num_elements;
+    count_ += sign;
+  }
+
+  bool sizes_known_{true};
+  int64_t elements_{0};
+  int64_t count_{0};
+};
+
+enum class InputAction {
+  kNone,       // the input has a single element, so it is not affected
+  kBypass,     // the input is produced by a matching Transpose, which is bypassed
+  kConstant,   // the input is constant and is replaced by a transposed copy
+  kTranspose,  // a Transpose with the inverse permutation is added
+};
+
+// Tries to move the Transpose producing input 'input_idx' of 'node' to its outputs. Returns true if the graph
+// was modified.
+bool TryPushTranspose(Graph& graph, Node& node, const Permutation& perm, PushHandler handler) {
+  PushPlan plan;
+  if (!handler(graph, node, perm, plan)) {
+    return false;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  const auto inverse_perm = InvertPermutation(perm);
+  const int rank = static_cast<int>(perm.size());
+
+  TransposeCost cost;
+  std::vector<InputAction> actions;
+  std::vector<Node*> bypassed;
+  for (int input_idx : plan.inputs) {
+    const NodeArg& input = *input_defs[input_idx];
+    if (!input.Exists()) {
+      actions.push_back(InputAction::kNone);
+      continue;
+    }
+
+    Node* input_transpose = GetInputTranspose(graph, node, input_idx, perm);
+    if (input_transpose != nullptr) {
+      actions.push_back(InputAction::kBypass);
+      if (std::find(bypassed.begin(), bypassed.end(), input_transpose) == bypassed.end()) {
+        bypassed.push_back(input_transpose);
+        if (IsOnlyConsumer(graph, *input_transpose, node)) {
+          cost.Remove(input);
+        }
+      }
+      continue;
+    }
+
+    const int input_rank = GetRank(input);
+    if (HasSingleElement(input) && (input_rank == rank || (plan.broadcast_inputs && input_rank < rank))) {
+      actions.push_back(InputAction::kNone);
+    } else if (graph_utils::IsConstantInitializer(graph, input.Name()) && input_rank >= 0 &&
+               (input_rank == rank || (plan.broadcast_inputs && input_rank < rank))) {
+      actions.push_back(InputAction::kConstant);
+    } else if (input_rank == rank) {
+      actions.push_back(InputAction::kTranspose);
+      cost.Add(input);
+    } else {
+      // a lower rank input would need an Unsqueeze before it can be transposed
+      return false;
+    }
+  }
+
+  for (int output_idx = 0, end = static_cast<int>(plan.output_perms.size()); output_idx < end; ++output_idx) {
+    const auto& output_perm = plan.output_perms[output_idx];
+    const NodeArg& output = *node.OutputDefs()[output_idx];
+    if (output_perm.empty() || !output.Exists()) {
+      continue;
+    }
+
+    if (OutputTransposesCancel(graph, node, output_idx, output_perm)) {
+      // the Transpose nodes consuming the output are removed when they are merged with the one added
+      cost.Remove(output);
+    } else {
+      cost.Add(output);
+    }
+  }
+
+  if (!cost.IsBeneficial()) {
+    return false;
+  }
+
+  // the transposed constants are created first as that can still fail
+  std::vector<TensorProto> constants(plan.inputs.size());
+  for (size_t i = 0; i < plan.inputs.size(); ++i) {
+    if (actions[i] == InputAction::kConstant) {
+      const auto* tensor = graph_utils::GetConstantInitializer(graph, input_defs[plan.inputs[i]]->Name());
+      if (tensor == nullptr || !TransposeConstant(graph, *tensor, inverse_perm, constants[i])) {
+        return false;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < plan.inputs.size(); ++i) {
+    const int input_idx = plan.inputs[i];
+    switch (actions[i]) {
+      case InputAction::kBypass:
+        BypassTranspose(graph, node, input_idx, *GetInputTranspose(graph, node, input_idx, perm));
+        break;
+      case InputAction::kConstant:
+        ReplaceInput(graph, node, input_idx, graph_utils::AddInitializer(graph, constants[i]), nullptr, 0);
+        break;
+      case InputAction::kTranspose:
+        InsertTransposeBefore(graph, node, input_idx, inverse_perm);
+        break;
+      case InputAction::kNone:
+        break;
+    }
+  }
+
+  for (auto& new_input : plan.new_constant_inputs) {
+    ReplaceInput(graph, node, new_input.first, graph_utils::AddInitializer(graph, new_input.second), nullptr, 0);
+  }
+
+  for (const auto& attr : plan.int_attributes) {
+    node.AddAttribute(attr.first, attr.second);
+  }
+  for (const auto& attr : plan.ints_attributes) {
+    node.AddAttribute(attr.first, attr.second);
+  }
+
+  for (int output_idx = 0, end = static_cast<int>(plan.output_perms.size()); output_idx < end; ++output_idx) {
+    if (!plan.output_perms[output_idx].empty() && node.OutputDefs()[output_idx]->Exists()) {
+      InsertTransposeAfter(graph, node, output_idx, plan.output_perms[output_idx]);
+    }
+  }
+
+  for (Node* transpose : bypassed) {
+    RemoveIfUnused(graph, *transpose);
+  }
+
+  return true;
+}
+
+// Merges a Transpose with the Transpose producing its input. Returns true if the graph was modified.
+bool TryMergeTranspose(Graph& graph, Node& transpose) {
+  const Node* producer = graph_utils::GetInputNode(transpose, 0);
+  if (producer == nullptr || !IsOnnxTranspose(*producer)) {
+    return false;
+  }
+
+  Permutation first, second;
+  if (!GetTransposePermutation(*producer, first) || !GetTransposePermutation(transpose, second) ||
+      first.size() != second.size()) {
+    return false;
+  }
+
+  Node& first_transpose = *graph.GetNode(producer->Index());
+  const auto merged = ComposePermutations(first, second);
+  NodeArg* output = transpose.MutableOutputDefs()[0];
+
+  // implicit inputs of subgraphs refer to the value by name, so their consumers can't be rewired
+  bool has_implicit_consumer = false;
+  for (auto edge = transpose.OutputEdgesBegin(), end = transpose.OutputEdgesEnd(); edge != end; ++edge) {
+    if (edge->GetDstArgIndex() >= static_cast<int>(edge->GetNode().InputDefs().size())) {
+      has_implicit_consumer = true;
+    }
+  }
+
+  if (IsIdentityPermutation(merged) && !graph.IsOutput(output) && !has_implicit_consumer) {
+    // the consumers use the input of the first Transpose directly
+    NodeArg* input = first_transpose.MutableInputDefs()[0];
+    const Node::EdgeEnd* source = graph_utils::GetInputEdge(first_transpose, 0);
+
+    std::vector<Node::EdgeEnd> output_edges(transpose.OutputEdgesBegin(), transpose.OutputEdgesEnd());
+    for (const auto& edge : output_edges) {
+      Node& consumer = *graph.GetNode(edge.GetNode().Index());
+      graph.RemoveEdge(transpose.Index(), consumer.Index(), 0, edge.GetDstArgIndex());
+      graph_utils::ReplaceNodeInput(consumer, edge.GetDstArgIndex(), *input);
+      if (source != nullptr) {
+        graph.AddEdge(source->GetNode().Index(), consumer.Index(), source->GetSrcArgIndex(), edge.GetDstArgIndex());
+      }
+    }
+
+    graph.RemoveNode(transpose.Index());
+  } else {
+    BypassTranspose(graph, transpose, 0, first_transpose);
+    transpose.AddAttribute("perm", merged);
+  }
+
+  RemoveIfUnused(graph, first_transpose);
+  return true;
+}
+
+}  // namespace
+
+Status TransposeOptimizer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  const auto& handlers = GetPushHandlers();
+
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+  for (NodeIndex i : order) {
+    auto* node = graph.GetNode(i);
+    if (!node) {
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) ||
+        node->Domain() != kOnnxDomain) {
+      continue;
+    }
+
+    if (IsOnnxTranspose(*node)) {
+      if (TryMergeTranspose(graph, *node)) {
+        modified = true;
+      }
+      continue;
+    }
+
+    auto handler = handlers.find(node->OpType());
+    if (handler == handlers.end()) {
+      continue;
+    }
+
+    // move the first Transpose input that can be moved. that brings the other inputs along with it.
+    for (int input_idx = 0, end = static_cast<int>(node->InputDefs().size()); input_idx < end; ++input_idx) {
+      const Node* producer = graph_utils::GetInputNode(*node, input_idx);
+      Permutation perm;
+      if (producer == nullptr || !IsOnnxTranspose(*producer) || !GetTransposePermutation(*producer, perm)) {
+        continue;
+      }
+
+      if (TryPushTranspose(graph, *node, perm, handler->second)) {
+        modified = true;
+        break;
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
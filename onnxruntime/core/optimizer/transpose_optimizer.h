@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TransposeOptimizer
+
+Transformer that pushes Transpose nodes down the graph through the ops that can operate on transposed data
+(elementwise ops, reductions, Concat, Split, Pad, Softmax, ...) so that they meet and cancel with other Transpose
+nodes or end up where they transpose less data. Models exported from frameworks using a channels last layout often
+contain Transpose pairs separated by such ops.
+
+Each op type has a handler that describes how its inputs, attributes and outputs change when a Transpose is moved
+from its input to its outputs. A Transpose is only moved if the cost model, which counts the number of elements
+transposed (or the number of Transpose nodes if the shapes are unknown), does not increase. Consecutive Transpose
+nodes are merged, and removed if they cancel.
+*/
+class TransposeOptimizer : public GraphTransformer {
+ public:
+  TransposeOptimizer(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TransposeOptimizer", compatible_execution_providers) {}
+
+  bool SupportsParallelSubgraphs() const override { return true; }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
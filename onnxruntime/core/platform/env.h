@@ -67,6 +67,11 @@ struct ThreadOptions {
 
   // Set or unset denormal as zero.
   bool set_denormal_as_zero = false;
+
+  // NUMA node of each thread. Index is thread index, value is a node index starting from zero. If the vector is not
+  // empty, the thread pool keeps work on the node it was scheduled on: idle threads steal from threads of the same
+  // node before other nodes, and parallel loops assign contiguous ranges of iterations to the threads of one node.
+  std::vector<int> numa_node;
 };
 /// \brief An interface used by the onnxruntime implementation to
 /// access operating system functionality like the filesystem etc.
@@ -110,6 +115,19 @@ class Env {
   // This function doesn't support systems with more than 64 logical processors
   virtual std::vector<size_t> GetThreadAffinityMasks() const = 0;
 
+  // Returns the processors of each NUMA node, in the same format as GetThreadAffinityMasks().
+  // Returns an empty vector if the system has a single NUMA node or its topology is unknown.
+  virtual std::vector<std::vector<size_t>> GetNumaNodeThreadAffinityMasks() const {
+    return {};
+  }
+
+  // Returns the performance cores (e.g. the P-cores of a hybrid Intel CPU, or the big cores of an ARM big.LITTLE
+  // CPU), in the same format as GetThreadAffinityMasks(). Returns an empty vector if the processors the process
+  // may run on are all of one type, or their types are unknown.
+  virtual std::vector<size_t> GetPerformanceCoreThreadAffinityMasks() const {
+    return {};
+  }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
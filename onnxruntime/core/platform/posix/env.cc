@@ -27,6 +27,7 @@ limitations under the License.
 #include <dlfcn.h>
 #include <ftw.h>
 #include <string.h>
+#include <algorithm>
 #include <thread>
 #include <utility>  // for std::forward
 #include <vector>
@@ -59,6 +60,56 @@ static void UnmapFile(void* param) noexcept {
   delete p;
 }
 
+#if defined(__linux__)
+// Parses a sysfs CPU list such as "0-3,8,10-11". Returns false if the file cannot be read.
+static bool ReadCpuList(const std::string& path, std::vector<size_t>& cpus) {
+  FILE* f = fopen(path.c_str(), "r");
+  if (f == nullptr) {
+    return false;
+  }
+  char buffer[4096];
+  const bool ok = fgets(buffer, sizeof(buffer), f) != nullptr;
+  fclose(f);
+  if (!ok) {
+    return false;
+  }
+
+  const char* p = buffer;
+  while (*p >= '0' && *p <= '9') {
+    char* end;
+    const size_t first = strtoul(p, &end, 10);
+    size_t last = first;
+    if (*end == '-') {
+      last = strtoul(end + 1, &end, 10);
+    }
+    for (size_t cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+    p = *end == ',' ? end + 1 : end;
+  }
+  return true;
+}
+
+// Reads a sysfs file holding a single unsigned number. Returns false if the file cannot be read or parsed.
+static bool ReadSysfsNumber(const std::string& path, unsigned long& value) {
+  FILE* f = fopen(path.c_str(), "r");
+  if (f == nullptr) {
+    return false;
+  }
+  const bool ok = fscanf(f, "%lu", &value) == 1;
+  fclose(f);
+  return ok;
+}
+
+// Returns true if cpu is the first logical processor of its physical core, or if that is unknown.
+static bool IsFirstThreadSibling(size_t cpu) {
+  std::vector<size_t> siblings;
+  return !ReadCpuList("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list",
+                      siblings) ||
+         siblings.empty() || siblings.front() == cpu;
+}
+#endif
+
 struct FileDescriptorTraits {
   using Handle = int;
   static Handle GetInvalidHandleValue() { return -1; }
@@ -195,6 +246,95 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  std::vector<std::vector<size_t>> GetNumaNodeThreadAffinityMasks() const override {
+    std::vector<std::vector<size_t>> ret;
+#if defined(__linux__) && !defined(__ANDROID__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+      return ret;
+    }
+
+    for (int node = 0;; node++) {
+      std::vector<size_t> node_cpus;
+      if (!ReadCpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", node_cpus)) {
+        break;
+      }
+
+      // Use one logical processor per physical core, like GetThreadAffinityMasks().
+      std::vector<size_t> cores;
+      for (size_t cpu : node_cpus) {
+        if (cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed) || !IsFirstThreadSibling(cpu)) {
+          continue;
+        }
+        cores.push_back(cpu);
+      }
+      if (!cores.empty()) {
+        ret.push_back(std::move(cores));
+      }
+    }
+
+    if (ret.size() < 2) {
+      ret.clear();
+    }
+#endif
+    return ret;
+  }
+
+  std::vector<size_t> GetPerformanceCoreThreadAffinityMasks() const override {
+    std::vector<size_t> ret;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+      return ret;
+    }
+    std::vector<size_t> online;
+    if (!ReadCpuList("/sys/devices/system/cpu/online", online)) {
+      return ret;
+    }
+
+    // Hybrid Intel CPUs list their performance cores under the cpu_core PMU. Otherwise, e.g. on ARM big.LITTLE,
+    // the performance cores are those with the highest capacity reported by the scheduler.
+    std::vector<size_t> performance_cpus;
+    if (!ReadCpuList("/sys/devices/cpu_core/cpus", performance_cpus)) {
+      std::vector<unsigned long> capacities;
+      unsigned long max_capacity = 0;
+      for (size_t cpu : online) {
+        unsigned long capacity = 0;
+        if (!ReadSysfsNumber("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpu_capacity", capacity)) {
+          return ret;
+        }
+        capacities.push_back(capacity);
+        max_capacity = std::max(max_capacity, capacity);
+      }
+      for (size_t i = 0; i < online.size(); i++) {
+        if (capacities[i] == max_capacity) {
+          performance_cpus.push_back(online[i]);
+        }
+      }
+    }
+
+    // Use one logical processor per physical core, like GetThreadAffinityMasks(), and report nothing unless the
+    // allowed processors include cores of both kinds.
+    bool has_other_cores = false;
+    for (size_t cpu : online) {
+      if (cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed)) {
+        continue;
+      }
+      if (std::find(performance_cpus.begin(), performance_cpus.end(), cpu) == performance_cpus.end()) {
+        has_other_cores = true;
+      } else if (IsFirstThreadSibling(cpu)) {
+        ret.push_back(cpu);
+      }
+    }
+    if (!has_other_cores) {
+      ret.clear();
+    }
+#endif
+    return ret;
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
@@ -172,6 +172,75 @@ class WindowsEnv : public Env {
     return ret;
   }
 
+  std::vector<std::vector<size_t>> GetNumaNodeThreadAffinityMasks() const override {
+    std::vector<std::vector<size_t>> ret;
+    ULONG highest_node = 0;
+    if (GetNumaHighestNodeNumber(&highest_node) == FALSE || highest_node == 0) {
+      return ret;
+    }
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION buffer[256];
+    DWORD returnLength = sizeof(buffer);
+    if (GetLogicalProcessorInformation(buffer, &returnLength) == FALSE) {
+      return ret;
+    }
+    int count = (int)(returnLength / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    for (ULONG node = 0; node <= highest_node; ++node) {
+      ULONGLONG node_mask = 0;
+      if (GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &node_mask) == FALSE || node_mask == 0) {
+        continue;
+      }
+      std::vector<size_t> cores;
+      for (int i = 0; i != count; ++i) {
+        if (buffer[i].Relationship == RelationProcessorCore && (buffer[i].ProcessorMask & node_mask) != 0) {
+          cores.push_back(buffer[i].ProcessorMask);
+        }
+      }
+      if (!cores.empty()) {
+        ret.push_back(std::move(cores));
+      }
+    }
+    if (ret.size() < 2)
+      ret.clear();
+    return ret;
+  }
+
+  std::vector<size_t> GetPerformanceCoreThreadAffinityMasks() const override {
+    std::vector<size_t> ret;
+    DWORD returnLength = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &returnLength);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+      return ret;
+    }
+    std::vector<char> buffer(returnLength);
+    auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+    if (GetLogicalProcessorInformationEx(RelationProcessorCore, info, &returnLength) == FALSE) {
+      return ret;
+    }
+
+    // Like GetThreadAffinityMasks(), only the cores of the first processor group are used. A higher efficiency
+    // class means a faster core, and all cores are in class 0 unless the CPU is hybrid.
+    std::vector<std::pair<BYTE, size_t>> cores;
+    BYTE max_class = 0;
+    for (DWORD offset = 0; offset < returnLength;) {
+      const auto* core = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+      const auto& group_mask = core->Processor.GroupMask[0];
+      if (group_mask.Group == 0 && group_mask.Mask != 0) {
+        cores.emplace_back(core->Processor.EfficiencyClass, static_cast<size_t>(group_mask.Mask));
+        if (core->Processor.EfficiencyClass > max_class)
+          max_class = core->Processor.EfficiencyClass;
+      }
+      offset += core->Size;
+    }
+    for (const auto& core : cores) {
+      if (core.first == max_class) {
+        ret.push_back(core.second);
+      }
+    }
+    if (ret.size() == cores.size())
+      ret.clear();
+    return ret;
+  }
+
   static WindowsEnv& Instance() {
     static WindowsEnv default_env;
     return default_env;
@@ -2,13 +2,17 @@
 // Licensed under the MIT License.
 
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <core/common/safeint.h>
 
 #include "model_builder.h"
 #include "helper.h"
 #include "op_builder_factory.h"
 
+#include "core/framework/murmurhash3.h"
 #include "core/providers/common.h"
+#include "core/providers/coreml/coreml_provider_factory.h"
 #include "core/providers/coreml/model/model.h"
 #include "core/providers/coreml/model/host_utils.h"
 #include "core/providers/coreml/builders/impl/builder_utils.h"
@@ -198,7 +202,7 @@ Status ModelBuilder::RegisterModelOutputs() {
 
 Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& path) {
   ORT_RETURN_IF_ERROR(SaveCoreMLModel(path));
-  model.reset(new Model(path, logger_, coreml_flags_));
+  model.reset(new Model(path, model_hash_, logger_, coreml_flags_));
   model->SetScalarOutputs(std::move(scalar_outputs_));
   model->SetInputOutputInfo(std::move(input_output_info_));
   return model->LoadModel();
@@ -206,8 +210,22 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& p
 
 Status ModelBuilder::SaveCoreMLModel(const std::string& path) {
   ORT_RETURN_IF_ERROR(Initialize());
+  std::string serialized_model;
+  ORT_RETURN_IF_NOT(coreml_model_->SerializeToString(&serialized_model), "Save the CoreML model failed");
   std::ofstream stream(path, std::ofstream::out | std::ofstream::binary);
-  ORT_RETURN_IF_NOT(coreml_model_->SerializeToOstream(&stream), "Save the CoreML model failed");
+  ORT_RETURN_IF_NOT(stream.write(serialized_model.data(), serialized_model.size()), "Save the CoreML model failed");
+
+  // The hash of the converted model is the key of its compiled model in the cache
+  if (coreml_flags_ & COREML_FLAG_CACHE_COMPILED_MODEL) {
+    uint32_t hash[4] = {0, 0, 0, 0};
+    MurmurHash3::x86_128(serialized_model.data(), gsl::narrow<int>(serialized_model.size()), 0, hash);
+    std::ostringstream hash_stream;
+    hash_stream << std::hex << std::setfill('0');
+    for (const auto h : hash) {
+      hash_stream << std::setw(8) << h;
+    }
+    model_hash_ = hash_stream.str();
+  }
 
   // TODO, Delete, debug only
   if (const char* path = std::getenv("ORT_COREML_EP_CONVERTED_MODEL_PATH")) {
@@ -44,6 +44,8 @@ class ModelBuilder {
   uint32_t coreml_flags_;
 
   std::unique_ptr<CoreML::Specification::Model> coreml_model_;
+  // Hash of the serialized CoreML model, empty if the compiled model is not cached
+  std::string model_hash_;
   std::unordered_set<std::string> scalar_outputs_;
   std::unordered_map<std::string, OnnxTensorInfo> input_output_info_;
 
@@ -56,7 +56,8 @@ class Model {
 
   OrtMutex mutex_;
 
-  Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  // A non-empty cache_key caches the compiled model under that key, see COREML_FLAG_CACHE_COMPILED_MODEL
+  Model(const std::string& path, const std::string& cache_key, const logging::Logger& logger, uint32_t coreml_flags);
   onnxruntime::common::Status LoadModel();
 
   void SetInputOutputInfo(std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info) {
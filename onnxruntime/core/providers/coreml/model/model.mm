@@ -39,15 +39,19 @@
 @interface CoreMLExecution : NSObject {
   NSString* coreml_model_path_;
   NSString* compiled_model_path_;
+  NSString* cache_key_;
   const onnxruntime::logging::Logger* logger_;
   uint32_t coreml_flags_;
 }
 
 - (instancetype)initWithPath:(const std::string&)path
+                   cache_key:(const std::string&)cache_key
                       logger:(const onnxruntime::logging::Logger&)logger
                 coreml_flags:(uint32_t)coreml_flags;
 - (void)cleanup;
 - (void)dealloc;
+- (NSURL*)cachedModelURL;
+- (NSURL*)compileModel:(NSError**)error;
 - (onnxruntime::common::Status)loadModel API_AVAILABLE_OS_VERSIONS;
 - (onnxruntime::common::Status)
     predict:(const std::unordered_map<std::string, onnxruntime::coreml::OnnxTensorData>&)inputs
@@ -133,10 +137,12 @@
 @implementation CoreMLExecution
 
 - (instancetype)initWithPath:(const std::string&)path
+                   cache_key:(const std::string&)cache_key
                       logger:(const onnxruntime::logging::Logger&)logger
                 coreml_flags:(uint32_t)coreml_flags {
   if (self = [super init]) {
     coreml_model_path_ = [NSString stringWithUTF8String:path.c_str()];
+    cache_key_ = cache_key.empty() ? nil : [NSString stringWithUTF8String:cache_key.c_str()];
     logger_ = &logger;
     coreml_flags_ = coreml_flags;
   }
@@ -169,20 +175,81 @@
   [self cleanup];
 }
 
-- (onnxruntime::common::Status)loadModel {
-  NSError* error = nil;
+// The compiled models are kept in <caches directory>/onnxruntime/coreml, the OS version is part of the name
+// since the compiled model may differ between the versions of CoreML
+- (NSURL*)cachedModelURL {
+  NSURL* caches_url = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory
+                                                              inDomains:NSUserDomainMask] firstObject];
+  if (caches_url == nil) {
+    return nil;
+  }
+
+  NSString* os_version = [[[NSProcessInfo processInfo] operatingSystemVersionString]
+      stringByReplacingOccurrencesOfString:@" "
+                                withString:@"_"];
+  NSString* name = [NSString stringWithFormat:@"%@_%@.mlmodelc", cache_key_, os_version];
+  return [[caches_url URLByAppendingPathComponent:@"onnxruntime/coreml" isDirectory:YES]
+      URLByAppendingPathComponent:name
+                      isDirectory:YES];
+}
+
+// Compile the CoreML model, and move the compiled model to the cache if caching is enabled
+- (NSURL*)compileModel:(NSError**)error {
   NSURL* modelUrl = [NSURL URLWithString:coreml_model_path_];
-  NSURL* compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
+  NSURL* compileUrl = [MLModel compileModelAtURL:modelUrl error:error];
+  if (compileUrl == nil) {
+    return nil;
+  }
 
-  if (error != nil) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Error compiling model ",
-                           [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding]);
+  NSURL* cached_url = cache_key_ != nil ? [self cachedModelURL] : nil;
+  if (cached_url != nil) {
+    NSFileManager* file_manager = [NSFileManager defaultManager];
+    NSError* cache_error = nil;
+    [file_manager createDirectoryAtURL:[cached_url URLByDeletingLastPathComponent]
+           withIntermediateDirectories:YES
+                            attributes:nil
+                                 error:&cache_error];
+    if (cache_error == nil && [file_manager moveItemAtURL:compileUrl toURL:cached_url error:&cache_error]) {
+      return cached_url;
+    }
+
+    // Another session may have cached the same model meanwhile, keep using the temporary compiled model
+    LOGS(*logger_, WARNING) << "Failed caching the compiled model: " << [[cached_url path] UTF8String]
+                            << ", error message: " << [[cache_error localizedDescription] UTF8String];
   }
 
   compiled_model_path_ = [compileUrl path];
+  return compileUrl;
+}
 
-  MLModelConfiguration* config = [MLModelConfiguration alloc];
+- (onnxruntime::common::Status)loadModel {
+  NSError* error = nil;
+  MLModelConfiguration* config = [[MLModelConfiguration alloc] init];
   config.computeUnits = MLComputeUnitsAll;
+  if (coreml_flags_ & COREML_FLAG_ALLOW_LOW_PRECISION_ACCUMULATION_ON_GPU) {
+    config.allowLowPrecisionAccumulationOnGPU = YES;
+  }
+
+  NSURL* cached_url = cache_key_ != nil ? [self cachedModelURL] : nil;
+  if (cached_url != nil && [[NSFileManager defaultManager] fileExistsAtPath:[cached_url path]]) {
+    _model = [MLModel modelWithContentsOfURL:cached_url configuration:config error:&error];
+    if (_model != nil) {
+      return onnxruntime::common::Status::OK();
+    }
+
+    // The cached model is not usable, replace it by a newly compiled one
+    LOGS(*logger_, WARNING) << "Failed loading the cached model: " << [[cached_url path] UTF8String]
+                            << ", error message: " << [[error localizedDescription] UTF8String];
+    [[NSFileManager defaultManager] removeItemAtURL:cached_url error:nil];
+    error = nil;
+  }
+
+  NSURL* compileUrl = [self compileModel:&error];
+  if (compileUrl == nil) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Error compiling model ",
+                           [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding]);
+  }
+
   _model = [MLModel modelWithContentsOfURL:compileUrl configuration:config error:&error];
 
   if (error != NULL) {
@@ -267,7 +334,8 @@ namespace coreml {
 // This class will bridge Model (c++) with CoreMLExecution (objective c++)
 class Execution {
  public:
-  Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  Execution(const std::string& path, const std::string& cache_key, const logging::Logger& logger,
+            uint32_t coreml_flags);
   ~Execution(){};
 
   Status LoadModel();
@@ -279,8 +347,10 @@ class Execution {
   CoreMLExecution* execution_;
 };
 
-Execution::Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags) {
+Execution::Execution(const std::string& path, const std::string& cache_key, const logging::Logger& logger,
+                     uint32_t coreml_flags) {
   execution_ = [[CoreMLExecution alloc] initWithPath:path
+                                           cache_key:cache_key
                                               logger:logger
                                         coreml_flags:coreml_flags];
 }
@@ -310,8 +380,9 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
   return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Execution::LoadModel requires macos 10.15+ or ios 13+ ");
 }
 
-Model::Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags)
-    : execution_(std::make_unique<Execution>(path, logger, coreml_flags)) {
+Model::Model(const std::string& path, const std::string& cache_key, const logging::Logger& logger,
+             uint32_t coreml_flags)
+    : execution_(std::make_unique<Execution>(path, cache_key, logger, coreml_flags)) {
 }
 
 Model::~Model() {}
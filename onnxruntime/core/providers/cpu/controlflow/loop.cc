@@ -12,8 +12,11 @@
 #include "core/providers/cpu/controlflow/loop.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include <array>
+
 #include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/iexecutor.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
@@ -192,6 +195,18 @@ class LoopImpl {
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
   void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
 
+  // setup the fetches and custom allocators so that the subgraph writes its outputs directly to the buffers
+  // owned by the Loop where possible
+  void SetupFetches(const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                    std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // stop re-using any loop carried variable buffer that the subgraph also returned in another output
+  void ReleaseSharedLoopCarriedBuffers(const std::vector<OrtValue>& fetches);
+
+  // create an OrtValue for the slice of a pre-allocated scan output that is written by the given iteration
+  OrtValue GetScanOutputSlice(int scan_output_index, int64_t iteration) const;
+  Status WriteScanOutput(const OrtValue& per_iteration_output, int scan_output_index, int64_t iteration);
+
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
@@ -211,6 +226,18 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // the two buffers used for each loop carried variable. the subgraph output for an iteration is written to the
+  // buffer that is not being read as the input, so once the shape is stable no allocations are required.
+  std::vector<std::array<OrtValue, 2>> loop_carried_buffers_;
+
+  // true if the loop runs for exactly max_trip_count_ iterations as the subgraph passes 'cond' through unchanged.
+  // in that case the scan outputs are allocated on the first iteration and each iteration writes to its slice.
+  bool trip_count_known_;
+  std::vector<Tensor*> scan_outputs_;
+
+  // the subgraph execution state is re-used by every iteration
+  utils::SubgraphExecutionCache subgraph_execution_cache_;
+
   const Loop::ConcatOutput& concat_output_func_;
   void* stream_;
 };
@@ -375,6 +402,9 @@ LoopImpl::LoopImpl(OpKernelContextInternal& context,
 
   auto cond_tensor = context.Input<Tensor>(1);
   condition_ = cond_tensor ? *cond_tensor->Data<bool>() : true;
+
+  trip_count_known_ = max_trip_count_tensor != nullptr &&
+                      info_.subgraph_output_names[0] == info_.subgraph_input_names[1];
 }
 
 Status LoopImpl::Initialize() {
@@ -416,6 +446,8 @@ Status LoopImpl::Initialize() {
   condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator, condition_, condition_rank);
 
   loop_output_tensors_.resize(info_.num_outputs - info_.num_loop_carried_vars);
+  loop_carried_buffers_.resize(info_.num_loop_carried_vars);
+  scan_outputs_.resize(info_.num_outputs - info_.num_loop_carried_vars, nullptr);
 
   return status;
 }
@@ -448,13 +480,163 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
     next_inputs[i] = last_outputs[i - 1];
   }
 
-  // save loop outputs as we have to concatenate at the end
+  // save loop outputs as we have to concatenate at the end. outputs that were written directly are already done.
   for (int j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
+    if (scan_outputs_[j - info_.num_loop_carried_vars] != nullptr) {
+      continue;
+    }
+
     ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
     loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
   }
 }
 
+void LoopImpl::SetupFetches(const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                            std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  auto iteration = *iter_num_mlvalue_.Get<Tensor>().Data<int64_t>();
+
+  fetches.clear();
+  fetch_allocators.clear();
+
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    const OrtValue& input = feeds[i + 2];  // skip iter_num and cond
+    if (!input.IsTensor()) {
+      continue;
+    }
+
+    // the subgraph output for the variable has the same type as the input. write it to whichever of our buffers
+    // is not the input for this iteration, re-allocating that buffer if the shape has changed.
+    fetch_allocators[i + 1] = [this, i, &input](const TensorShape& shape, const OrtMemoryInfo& location,
+                                                OrtValue& ort_value, bool& allocated) {
+      const Tensor& input_tensor = input.Get<Tensor>();
+      auto& buffers = loop_carried_buffers_[i];
+
+      OrtValue* spare = nullptr;
+      for (auto& buffer : buffers) {
+        if (buffer.IsAllocated() && buffer.Get<Tensor>().DataRaw() == input_tensor.DataRaw()) {
+          continue;
+        }
+
+        if (buffer.IsAllocated() && buffer.Get<Tensor>().Shape() == shape &&
+            buffer.Get<Tensor>().Location().device == location.device) {
+          ort_value = buffer;
+          allocated = true;
+          return Status::OK();
+        }
+
+        if (spare == nullptr) {
+          spare = &buffer;
+        }
+      }
+
+      AllocatorPtr allocator = session_state_.GetAllocator(location);
+      if (spare != nullptr && allocator) {
+        auto tensor = std::make_unique<Tensor>(input_tensor.DataType(), shape, allocator);
+        auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+        spare->Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+        ort_value = *spare;
+        allocated = true;
+      }
+
+      return Status::OK();
+    };
+  }
+
+  if (!trip_count_known_) {
+    return;
+  }
+
+  if (iteration == 0) {
+    // allocate the scan outputs with the per-iteration shape on the first iteration, and have the subgraph write
+    // the first slice directly.
+    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+      fetch_allocators[i + 1] = [this, i](const TensorShape& shape, const OrtMemoryInfo& location,
+                                          OrtValue& ort_value, bool& allocated) {
+        const auto& per_iteration_dims = shape.GetDims();
+        std::vector<int64_t> dims;
+        dims.reserve(1 + per_iteration_dims.size());
+        dims.push_back(max_trip_count_);
+        std::copy(per_iteration_dims.cbegin(), per_iteration_dims.cend(), std::back_inserter(dims));
+
+        Tensor* output = context_.Output(i, TensorShape(dims));
+        ORT_RETURN_IF(output == nullptr, "Failed to allocate output ", i, " of Loop.");
+
+        auto scan_output_index = i - info_.num_loop_carried_vars;
+        scan_outputs_[scan_output_index] = output;
+
+        // if the subgraph produces the value on a different device we leave 'allocated' as false and the
+        // slice is written by WriteScanOutput after the iteration completes
+        if (output->Location().device == location.device) {
+          ort_value = GetScanOutputSlice(scan_output_index, 0);
+          allocated = true;
+        }
+
+        return Status::OK();
+      };
+    }
+  } else {
+    fetches.resize(info_.num_subgraph_outputs);
+    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+      auto scan_output_index = i - info_.num_loop_carried_vars;
+      if (scan_outputs_[scan_output_index] != nullptr) {
+        fetches[i + 1] = GetScanOutputSlice(scan_output_index, iteration);
+      }
+    }
+  }
+}
+
+void LoopImpl::ReleaseSharedLoopCarriedBuffers(const std::vector<OrtValue>& fetches) {
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    for (auto& buffer : loop_carried_buffers_[i]) {
+      if (!buffer.IsAllocated()) {
+        continue;
+      }
+
+      const void* data = buffer.Get<Tensor>().DataRaw();
+      for (int j = 1; j < info_.num_subgraph_outputs; ++j) {
+        if (j != i + 1 && fetches[j].IsTensor() && fetches[j].Get<Tensor>().DataRaw() == data) {
+          // the value is also another loop carried variable or a scan output so it can't be overwritten.
+          // the fetch keeps the buffer alive.
+          buffer = OrtValue();
+          break;
+        }
+      }
+    }
+  }
+}
+
+OrtValue LoopImpl::GetScanOutputSlice(int scan_output_index, int64_t iteration) const {
+  Tensor& output = *scan_outputs_[scan_output_index];
+  const auto& output_shape = output.Shape();
+
+  auto bytes_per_iteration = output.SizeInBytes() / gsl::narrow<size_t>(output_shape[0]);
+  auto* data = static_cast<gsl::byte*>(output.MutableDataRaw()) + iteration * bytes_per_iteration;
+
+  auto slice = std::make_unique<Tensor>(output.DataType(), output_shape.Slice(1), data, output.Location());
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  return OrtValue{slice.release(), ml_tensor, ml_tensor->GetDeleteFunc()};
+}
+
+Status LoopImpl::WriteScanOutput(const OrtValue& per_iteration_output, int scan_output_index, int64_t iteration) {
+  ORT_RETURN_IF_NOT(per_iteration_output.IsTensor(), "All scan outputs MUST be tensors");
+
+  const auto& src = per_iteration_output.Get<Tensor>();
+  OrtValue slice = GetScanOutputSlice(scan_output_index, iteration);
+  auto& dst = *slice.GetMutable<Tensor>();
+
+  // nothing to do if the subgraph wrote to the slice
+  if (src.DataRaw() == dst.DataRaw()) {
+    return Status::OK();
+  }
+
+  if (src.SizeInBytes() != dst.SizeInBytes()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                           " Expected:", dst.Shape(), " Got:", src.Shape());
+  }
+
+  return session_state_.GetDataTransferMgr().CopyTensor(src, dst);
+}
+
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
   const auto& first_output = per_iteration_output.front().Get<Tensor>();
   const auto& per_iteration_dims = first_output.Shape().GetDims();
@@ -479,6 +661,7 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   std::vector<OrtValue> feeds;
   std::vector<OrtValue> fetches;
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
   CreateInitialFeeds(feeds);
 
@@ -487,14 +670,25 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       SaveOutputsAndUpdateFeeds(fetches, feeds);
-      fetches.clear();
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
-                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+    SetupFetches(feeds, fetches, fetch_allocators);
+
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
+                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
+                                    &subgraph_execution_cache_);
 
     ORT_RETURN_IF_ERROR(status);
 
+    ReleaseSharedLoopCarriedBuffers(fetches);
+
+    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+      auto scan_output_index = i - info_.num_loop_carried_vars;
+      if (scan_outputs_[scan_output_index] != nullptr) {
+        ORT_RETURN_IF_ERROR(WriteScanOutput(fetches[i + 1], scan_output_index, iter_num_value));  // skip cond
+      }
+    }
+
     condition_mlvalue_ = fetches[0];
 
     ++iter_num_value;
@@ -538,6 +732,10 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
     }
 
     for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+      if (scan_outputs_[i - info_.num_loop_carried_vars] != nullptr) {
+        continue;
+      }
+
       // add last output
       auto& per_iteration_outputs = loop_output_tensors_[i - info_.num_loop_carried_vars];
       per_iteration_outputs.push_back(fetches[i + 1]);  // skip cond
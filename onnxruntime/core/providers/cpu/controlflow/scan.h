@@ -37,6 +37,11 @@ struct DeviceHelpers {
   // (e.g. it is a pointer to a handle rather than the actual data)
   CreateConstSlicer create_const_slicer_func = OrtValueTensorSlicer<const OrtValue>::Create;
   CreateMutableSlicer create_mutable_slicer_func = OrtValueTensorSlicer<OrtValue>::Create;
+
+  // Whether independent executions of the subgraph (the batch entries for Scan 8, the iterations of a Scan 9
+  // without loop state variables) can run concurrently on the thread pool.
+  // Only the CPU implementation sets it, other devices order the executions on a single stream.
+  bool allow_concurrent_execution = false;
 };
 }  // namespace detail
 }  // namespace scan
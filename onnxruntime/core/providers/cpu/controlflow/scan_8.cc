@@ -16,6 +16,7 @@
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 #include "core/providers/cpu/tensor/utils.h"
 
@@ -113,6 +114,11 @@ class Scan8Impl {
   Status AllocateOutputTensors();
   Status CreateLoopStateVariables(std::vector<std::vector<LoopStateVariable>>& loop_state_variables);
 
+  // iterate the sequence of a batch entry, writing the scan outputs using output_iterators
+  Status ExecuteBatchEntry(int64_t batch, std::vector<LoopStateVariable>& loop_state_variables,
+                           std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                           const FeedsFetchesManager& ffm);
+
   using ConstTensorSlicerIterators = std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator>;
   using MutableTensorSlicerIterators = std::vector<OrtValueTensorSlicer<OrtValue>::Iterator>;
 
@@ -156,6 +162,8 @@ Scan<8>::Scan(const OpKernelInfo& info) : IControlFlowKernel(info) {
     memset(data, 0, size_in_bytes);
     return Status::OK();
   };
+
+  device_helpers_.allow_concurrent_execution = true;
 }
 
 template <>
@@ -401,46 +409,94 @@ Status Scan8Impl::Execute(const FeedsFetchesManager& ffm) {
   status = CreateLoopStateVariables(batch_loop_state_variables);
   ORT_RETURN_IF_ERROR(status);
 
-  for (int64_t b = 0; b < batch_size_; ++b) {
-    auto sequence_len = sequence_lens_[b];
-
-    // Setup input OrtValue streams
-    std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator> scan_input_stream_iterators;
-    scan_input_stream_iterators.reserve(info_.num_variadic_inputs - info_.num_loop_state_variables);
-
-    for (int i = info_.num_loop_state_variables, end = info_.num_variadic_inputs; i < end; ++i) {
-      const auto& ort_value = GetSubgraphInputMLValue(context_, i);
-
-      // forward
-      if (directions_[i - info_.num_loop_state_variables] == static_cast<int64_t>(ScanDirection::kForward)) {
-        // the iterator is self contained, so we don't need to keep the OrtValueTensorSlicer instance around
-        scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 1, b).begin());
-      } else {  // reverse
-        scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 1, b).rbegin());
-        // need to skip past the empty entries at the end of the input if sequence length is short
-        auto offset = max_sequence_len_ - sequence_len;
-        if (offset > 0) {
-          // reverse iterator so += moves backwards through the input
-          scan_input_stream_iterators.back() += offset;
-        }
+  auto* thread_pool = GetConcurrentExecutionThreadPool(context_, session_state_, device_helpers_);
+  int64_t first_concurrent_batch = 0;
+
+  if (thread_pool != nullptr && batch_size_ > 1) {
+    // a scan output with a symbolic dimension is allocated by the first execution of the subgraph,
+    // so the first batch entry needs to run before the others can write to their slice of the output
+    for (int output = info_.num_loop_state_variables; output < info_.num_outputs; ++output) {
+      if (!output_iterators_[output]->FinalOutputAllocated()) {
+        first_concurrent_batch = 1;
+        break;
+      }
+    }
+  } else {
+    first_concurrent_batch = batch_size_;
+  }
+
+  for (int64_t b = 0; b < first_concurrent_batch; ++b) {
+    status = ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators_, ffm);
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  if (first_concurrent_batch >= batch_size_) {
+    return status;
+  }
+
+  // the batch entries are independent. run them concurrently, each writing its own slice of the outputs.
+  const std::ptrdiff_t num_batches = static_cast<std::ptrdiff_t>(batch_size_ - first_concurrent_batch);
+  std::vector<Status> batch_status(num_batches);
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_batches, [&](std::ptrdiff_t i) {
+    const int64_t b = first_concurrent_batch + i;
+    std::vector<std::unique_ptr<OutputIterator>> output_iterators(info_.num_outputs);
+    for (int output = info_.num_loop_state_variables; output < info_.num_outputs; ++output) {
+      batch_status[i] = output_iterators_[output]->CreateSubIterator(b * max_sequence_len_, max_sequence_len_,
+                                                                     output_iterators[output]);
+      if (!batch_status[i].IsOK()) {
+        return;
       }
     }
 
-    // Call the subgraph for each item in the sequence
-    status = IterateSequence(context_, session_state_, batch_loop_state_variables[b], scan_input_stream_iterators,
-                             sequence_len, info_.num_loop_state_variables, info_.num_variadic_inputs, info_.num_outputs,
-                             implicit_inputs_, output_iterators_, ffm);
-
-    // zero out any remaining values in the sequence
-    for (int64_t i = sequence_len; i < max_sequence_len_; ++i) {
-      for (int output = info_.num_loop_state_variables; output < info_.num_outputs; ++output) {
-        auto& iterator = *output_iterators_[output];
-        iterator.ZeroOutCurrent();
-        ++iterator;
+    batch_status[i] = ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators, ffm);
+  });
+
+  for (const auto& s : batch_status) {
+    ORT_RETURN_IF_ERROR(s);
+  }
+
+  return status;
+}
+
+Status Scan8Impl::ExecuteBatchEntry(int64_t batch, std::vector<LoopStateVariable>& loop_state_variables,
+                                    std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                                    const FeedsFetchesManager& ffm) {
+  auto sequence_len = sequence_lens_[batch];
+
+  // Setup input OrtValue streams
+  std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator> scan_input_stream_iterators;
+  scan_input_stream_iterators.reserve(info_.num_variadic_inputs - info_.num_loop_state_variables);
+
+  for (int i = info_.num_loop_state_variables, end = info_.num_variadic_inputs; i < end; ++i) {
+    const auto& ort_value = GetSubgraphInputMLValue(context_, i);
+
+    // forward
+    if (directions_[i - info_.num_loop_state_variables] == static_cast<int64_t>(ScanDirection::kForward)) {
+      // the iterator is self contained, so we don't need to keep the OrtValueTensorSlicer instance around
+      scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 1, batch).begin());
+    } else {  // reverse
+      scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 1, batch).rbegin());
+      // need to skip past the empty entries at the end of the input if sequence length is short
+      auto offset = max_sequence_len_ - sequence_len;
+      if (offset > 0) {
+        // reverse iterator so += moves backwards through the input
+        scan_input_stream_iterators.back() += offset;
       }
     }
+  }
 
-    ORT_RETURN_IF_ERROR(status);
+  // Call the subgraph for each item in the sequence
+  auto status = IterateSequence(context_, session_state_, loop_state_variables, scan_input_stream_iterators,
+                                sequence_len, info_.num_loop_state_variables, info_.num_variadic_inputs,
+                                info_.num_outputs, implicit_inputs_, output_iterators, ffm);
+
+  // zero out any remaining values in the sequence
+  for (int64_t i = sequence_len; i < max_sequence_len_; ++i) {
+    for (int output = info_.num_loop_state_variables; output < info_.num_outputs; ++output) {
+      auto& iterator = *output_iterators[output];
+      iterator.ZeroOutCurrent();
+      ++iterator;
+    }
   }
 
   return status;
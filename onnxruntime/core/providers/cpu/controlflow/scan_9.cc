@@ -16,6 +16,7 @@
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -138,6 +139,12 @@ class ScanImpl {
   using ConstTensorSlicerIterators = std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator>;
   using MutableTensorSlicerIterators = std::vector<OrtValueTensorSlicer<OrtValue>::Iterator>;
 
+  // create the iterators for the scan inputs starting at iteration 'first'
+  void CreateScanInputIterators(int64_t first, ConstTensorSlicerIterators& scan_input_stream_iterators) const;
+
+  // without loop state variables the iterations are independent, so execute chunks of them concurrently
+  Status ExecuteConcurrently(const FeedsFetchesManager& ffm, concurrency::ThreadPool* thread_pool);
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const Scan<9>::Info& info_;
@@ -200,6 +207,8 @@ Scan<9>::Scan(const OpKernelInfo& info) : IControlFlowKernel(info) {
     memset(data, 0, size_in_bytes);
     return Status::OK();
   };
+
+  device_helpers_.allow_concurrent_execution = true;
 }
 
 // we need this to be in the .cc so 'unique_ptr<Info> info_' can be handled
@@ -433,15 +442,8 @@ Status ScanImpl::CreateLoopStateVariables(std::vector<LoopStateVariable>& loop_s
   return status;
 }
 
-Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
-  Status status = Status::OK();
-
-  std::vector<LoopStateVariable> loop_state_variables;
-  status = CreateLoopStateVariables(loop_state_variables);
-  ORT_RETURN_IF_ERROR(status);
-
-  // Setup input OrtValue streams
-  std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator> scan_input_stream_iterators;
+void ScanImpl::CreateScanInputIterators(int64_t first,
+                                        ConstTensorSlicerIterators& scan_input_stream_iterators) const {
   scan_input_stream_iterators.reserve(info_.num_inputs - info_.num_loop_state_variables);
 
   for (int i = 0, end = info_.num_scan_inputs; i < end; ++i) {
@@ -454,8 +456,33 @@ Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
     } else {  // reverse
       scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 0, 0).rbegin());
     }
+
+    if (first > 0) {
+      // for a reverse iterator += moves backwards through the input
+      scan_input_stream_iterators.back() += first;
+    }
+  }
+}
+
+Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
+  Status status = Status::OK();
+
+  auto* thread_pool = GetConcurrentExecutionThreadPool(context_, session_state_, device_helpers_);
+  if (thread_pool != nullptr && info_.num_loop_state_variables == 0 && sequence_len_ > 1) {
+    status = ExecuteConcurrently(ffm, thread_pool);
+    ORT_RETURN_IF_ERROR(status);
+
+    return TransposeOutput();
   }
 
+  std::vector<LoopStateVariable> loop_state_variables;
+  status = CreateLoopStateVariables(loop_state_variables);
+  ORT_RETURN_IF_ERROR(status);
+
+  // Setup input OrtValue streams
+  ConstTensorSlicerIterators scan_input_stream_iterators;
+  CreateScanInputIterators(0, scan_input_stream_iterators);
+
   // Call the subgraph for each item in the sequence
   status = IterateSequence(context_, session_state_, loop_state_variables, scan_input_stream_iterators,
                            sequence_len_, info_.num_loop_state_variables, info_.num_inputs, info_.num_outputs,
@@ -468,6 +495,59 @@ Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
   return status;
 }
 
+Status ScanImpl::ExecuteConcurrently(const FeedsFetchesManager& ffm, concurrency::ThreadPool* thread_pool) {
+  std::vector<LoopStateVariable> no_loop_state_variables;
+  int64_t first_concurrent_iteration = 0;
+
+  // a scan output with a symbolic dimension is allocated by the first execution of the subgraph,
+  // so the first iteration needs to run before the others can write to their slice of the output
+  for (int output = 0; output < info_.num_outputs; ++output) {
+    if (!output_iterators_[output]->FinalOutputAllocated()) {
+      ConstTensorSlicerIterators scan_input_stream_iterators;
+      CreateScanInputIterators(0, scan_input_stream_iterators);
+      ORT_RETURN_IF_ERROR(IterateSequence(context_, session_state_, no_loop_state_variables,
+                                          scan_input_stream_iterators, 1, 0, info_.num_inputs, info_.num_outputs,
+                                          implicit_inputs_, output_iterators_, ffm));
+      first_concurrent_iteration = 1;
+      break;
+    }
+  }
+
+  // each chunk re-uses the subgraph execution state across its iterations
+  const std::ptrdiff_t num_iterations = static_cast<std::ptrdiff_t>(sequence_len_ - first_concurrent_iteration);
+  const std::ptrdiff_t num_chunks = std::min<std::ptrdiff_t>(
+      num_iterations, concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+  std::vector<Status> chunk_status(num_chunks);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_chunks, [&](std::ptrdiff_t chunk) {
+    const auto work = concurrency::ThreadPool::PartitionWork(chunk, num_chunks, num_iterations);
+    const int64_t first = first_concurrent_iteration + work.start;
+    const int64_t count = work.end - work.start;
+
+    std::vector<std::unique_ptr<OutputIterator>> output_iterators(info_.num_outputs);
+    for (int output = 0; output < info_.num_outputs; ++output) {
+      chunk_status[chunk] = output_iterators_[output]->CreateSubIterator(first, count, output_iterators[output]);
+      if (!chunk_status[chunk].IsOK()) {
+        return;
+      }
+    }
+
+    ConstTensorSlicerIterators scan_input_stream_iterators;
+    CreateScanInputIterators(first, scan_input_stream_iterators);
+
+    std::vector<LoopStateVariable> loop_state_variables;
+    chunk_status[chunk] = IterateSequence(context_, session_state_, loop_state_variables,
+                                          scan_input_stream_iterators, count, 0, info_.num_inputs,
+                                          info_.num_outputs, implicit_inputs_, output_iterators, ffm);
+  });
+
+  for (const auto& status : chunk_status) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
 Status ScanImpl::TransposeOutput() {
   auto status = Status::OK();
 
@@ -198,6 +198,9 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
   std::vector<OrtValue> fetches;
   std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
+  // the subgraph execution state is re-used by every item in the sequence
+  utils::SubgraphExecutionCache subgraph_execution_cache;
+
   feeds.resize(num_inputs);
   fetches.resize(num_variadic_outputs);
 
@@ -270,7 +273,8 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
 
     // Create Executor and run graph.
     status = utils::ExecuteSubgraph(session_state, ffm, feeds, fetches, fetch_allocators,
-                                    ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(), context.Logger());
+                                    ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(), context.Logger(),
+                                    &subgraph_execution_cache);
 
     ORT_RETURN_IF_ERROR(status);
 
@@ -291,6 +295,17 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
   return status;
 }
 
+concurrency::ThreadPool* GetConcurrentExecutionThreadPool(const OpKernelContextInternal& context,
+                                                          const SessionState& session_state,
+                                                          const DeviceHelpers& device_helpers) {
+  if (!device_helpers.allow_concurrent_execution) {
+    return nullptr;
+  }
+
+  auto* thread_pool = session_state.GetInterOpThreadPool();
+  return thread_pool != nullptr ? thread_pool : context.GetOperatorThreadPool();
+}
+
 OrtValue AllocateTensorInMLValue(const MLDataType data_type, const TensorShape& shape, AllocatorPtr& allocator) {
   auto new_tensor = std::make_unique<Tensor>(data_type,
                                                      shape,
@@ -572,6 +587,42 @@ OutputIterator& OutputIterator::operator++() {
   return *this;
 }
 
+Status OutputIterator::CreateSubIterator(int64_t first, int64_t count,
+                                         std::unique_ptr<OutputIterator>& iterator) const {
+  ORT_RETURN_IF_NOT(!is_loop_state_var_, "Loop state variables are not written by iteration.");
+  ORT_RETURN_IF_NOT(is_concrete_shape_, "The final output must be allocated before creating a sub-iterator.");
+  ORT_RETURN_IF_NOT(first >= 0 && count >= 0 && first + count <= num_iterations_,
+                    "Invalid iterations [", first, ", ", first + count, ") for an output with ", num_iterations_,
+                    " iterations.");
+
+  // the copy shares the final output, and gets its own slicer positioned at 'first'
+  iterator.reset(new OutputIterator(*this));
+  iterator->slicer_iterators_.clear();
+
+  int64_t slice_dimension = 0;
+  int64_t dim0_offset = 0;
+  int64_t offset = first;
+  if (is_v8_) {
+    // slice on the sequence dimension of the batch entry
+    const int64_t sequence_len = final_shape_[1];
+    slice_dimension = 1;
+    dim0_offset = first / sequence_len;
+    offset = first % sequence_len;
+    ORT_RETURN_IF_NOT(offset + count <= sequence_len, "Iterations of a sub-iterator must be in one batch entry.");
+  }
+
+  iterator->slicer_iterators_.push_back(
+      (direction_ == ScanDirection::kForward)
+          ? create_slicer_func_(*final_output_mlvalue_, slice_dimension, dim0_offset).begin()
+          : create_slicer_func_(*final_output_mlvalue_, slice_dimension, dim0_offset).rbegin());
+  iterator->slicer_iterators_.back() += offset;
+  iterator->cur_slicer_iterator_ = iterator->slicer_iterators_.begin();
+  iterator->cur_iteration_ = first;
+  iterator->num_iterations_ = first + count;
+
+  return Status::OK();
+}
+
 }  // namespace detail
 }  // namespace scan
 }  // namespace onnxruntime
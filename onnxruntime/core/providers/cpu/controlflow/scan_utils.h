@@ -17,6 +17,9 @@
 namespace onnxruntime {
 class GraphViewer;
 class OrtValueNameIdxMap;
+namespace concurrency {
+class ThreadPool;
+}
 class OpKernelContextInternal;
 class Node;
 
@@ -138,6 +141,11 @@ class OutputIterator {
     return *final_output_mlvalue_;
   }
 
+  // create an iterator over the iterations [first, first + count) of this scan output so that independent
+  // executions of the subgraph can write to the output concurrently. the final output must be allocated.
+  // for v8 the iterations must be in a single batch entry.
+  Status CreateSubIterator(int64_t first, int64_t count, std::unique_ptr<OutputIterator>& iterator) const;
+
  private:
   OutputIterator(OpKernelContextInternal& context,
                  int output_index,
@@ -208,6 +216,15 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
                        std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
                        const FeedsFetchesManager& ffm);
 
+/**
+Get the thread pool to run independent executions of the subgraph concurrently on,
+or nullptr if they need to run sequentially.
+The inter-op thread pool is used if the session has one, otherwise the intra-op thread pool.
+*/
+concurrency::ThreadPool* GetConcurrentExecutionThreadPool(const OpKernelContextInternal& context,
+                                                          const SessionState& session_state,
+                                                          const DeviceHelpers& device_helpers);
+
 OrtValue AllocateTensorInMLValue(MLDataType data_type, const TensorShape& shape, AllocatorPtr& allocator);
 
 /**
@@ -12,6 +12,8 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // back the allocations of at least 2 MB with huge pages. see OrtArenaCfg::huge_pages for the values.
+  int huge_pages{0};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -40,8 +42,10 @@ class CPUExecutionProvider : public IExecutionProvider {
     create_arena = false;
 #endif
 
+    OrtArenaCfg arena_cfg;
+    arena_cfg.huge_pages = info.huge_pages;
     AllocatorCreationInfo device_info{[](int) { return std::make_unique<TAllocator>(); },
-                                      0, create_arena};
+                                      0, create_arena, arena_cfg};
 
     InsertAllocator(CreateAllocator(device_info));
   }
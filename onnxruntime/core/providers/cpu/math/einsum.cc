@@ -62,6 +62,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                        nullptr);
 
     // Set device specific methods (CPU methods) to be used during processing
+    einsum_compute_processor.SetContractionPlanCache(&contraction_plan_cache_);
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CpuDeviceHelpers::Transpose,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::MatMul<float>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::ReduceSum<float>,
@@ -75,6 +76,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                          nullptr);
 
     // Set device specific methods (CPU methods) to be used during processing
+    einsum_compute_processor.SetContractionPlanCache(&contraction_plan_cache_);
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CpuDeviceHelpers::Transpose,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::MatMul<int32_t>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::ReduceSum<int32_t>,
@@ -89,6 +91,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                         nullptr);
 
     // Set device specific methods (CPU methods) to be used during processing
+    einsum_compute_processor.SetContractionPlanCache(&contraction_plan_cache_);
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CpuDeviceHelpers::Transpose,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::MatMul<double>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::ReduceSum<double>,
@@ -101,6 +104,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                          einsum_compute_preprocessor,
                                                                          nullptr);
 
+    einsum_compute_processor.SetContractionPlanCache(&contraction_plan_cache_);
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CpuDeviceHelpers::Transpose,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::MatMul<int64_t>,
                                               EinsumOp::DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>,
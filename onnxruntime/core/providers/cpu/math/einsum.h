@@ -27,6 +27,9 @@ class Einsum : public OpKernel {
 
   std::string equation_;
   std::unique_ptr<EinsumEquationPreprocessor> einsum_equation_preprocessor_;
+
+  // Contraction orders already planned for the input shapes seen so far
+  mutable EinsumOp::ContractionPlanCache contraction_plan_cache_;
 };
 
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "einsum_auxiliary_ops.h"
+#include "core/mlas/inc/mlas.h"
 
 using namespace onnxruntime::common;
 
@@ -28,12 +29,10 @@ Status Transpose(const std::vector<size_t>& permutation, const Tensor& input,
   return TransposeBase::DoTranspose(permutation, input, output, input_shape_override);
 }
 
-// CPU specific MatMul helper
 template <typename T>
-Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
-              size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-              void* /*einsum_cuda_assets*/) {
+static void BatchedMatMul(const T* input_1_data, const T* input_2_data, T* output_data,
+                          size_t left_stride, size_t right_stride, size_t output_stride,
+                          size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp) {
   for (size_t i = 0; i < num_batches; ++i) {
     math::MatMul<T>(
         static_cast<int>(M),
@@ -43,6 +42,33 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
         input_2_data + i * right_stride,
         output_data + i * output_stride, tp);
   }
+}
+
+// All the batches in one MLAS call so that the thread pool is split across them
+// rather than each (possibly tiny) GEMM being parallelized on its own
+static void BatchedMatMul(const float* input_1_data, const float* input_2_data, float* output_data,
+                          size_t left_stride, size_t right_stride, size_t output_stride,
+                          size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp) {
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(num_batches);
+  for (size_t i = 0; i < num_batches; ++i) {
+    data[i].A = input_1_data + i * left_stride;
+    data[i].lda = K;
+    data[i].B = input_2_data + i * right_stride;
+    data[i].ldb = N;
+    data[i].C = output_data + i * output_stride;
+    data[i].ldc = N;
+  }
+  MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, data.data(), num_batches, tp);
+}
+
+// CPU specific MatMul helper
+template <typename T>
+Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
+              size_t left_stride, size_t right_stride, size_t output_stride,
+              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+              void* /*einsum_cuda_assets*/) {
+  BatchedMatMul(input_1_data, input_2_data, output_data, left_stride, right_stride, output_stride,
+                num_batches, M, K, N, tp);
 
   return Status::OK();
 }
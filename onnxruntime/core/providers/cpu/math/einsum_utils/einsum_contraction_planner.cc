@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "einsum_contraction_planner.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+using LabelDims = std::vector<int64_t>;
+
+// Multiply-adds of the batched MatMul contracting two operands:
+// the product of every dim that is non-trivial in either of them
+static double ContractionCost(const LabelDims& left, const LabelDims& right) {
+  double cost = 1.;
+  for (size_t label = 0; label < left.size(); ++label) {
+    int64_t dim = std::max(left[label], right[label]);
+    if (dim > 1) {
+      cost *= static_cast<double>(dim);
+    }
+  }
+  return cost;
+}
+
+// Finds the order with the least multiply-adds by enumerating every way of splitting every subset of operands in two.
+// The dims of the result of contracting a subset only depend on the subset: a non-trivial label survives
+// if it shows up in the output or in an operand outside of the subset.
+static ContractionPlan PlanOptimalContraction(const std::vector<LabelDims>& operands,
+                                              const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  const size_t num_operands = operands.size();
+  const size_t num_labels = subscript_indices_to_output_indices.size();
+  const uint32_t full = (1u << num_operands) - 1;
+
+  std::vector<LabelDims> subset_dims(full + 1, LabelDims(num_labels, 1));
+  for (uint32_t subset = 1; subset <= full; ++subset) {
+    for (size_t label = 0; label < num_labels; ++label) {
+      int64_t inside = 1;
+      bool outside = subscript_indices_to_output_indices[label] != -1;
+      for (size_t i = 0; i < num_operands; ++i) {
+        if (subset & (1u << i)) {
+          inside = std::max(inside, operands[i][label]);
+        } else if (operands[i][label] > 1) {
+          outside = true;
+        }
+      }
+      subset_dims[subset][label] = outside ? inside : 1;
+    }
+  }
+
+  std::vector<double> best_cost(full + 1, 0.);
+  std::vector<uint32_t> best_split(full + 1, 0);
+  for (uint32_t subset = 1; subset <= full; ++subset) {
+    if ((subset & (subset - 1)) == 0) {
+      continue;  // a single operand costs nothing
+    }
+    best_cost[subset] = std::numeric_limits<double>::max();
+    // Only the splits where `part` holds the lowest operand of the subset, the other half is the complement
+    uint32_t lowest = subset & (~subset + 1);
+    for (uint32_t part = (subset - 1) & subset; part != 0; part = (part - 1) & subset) {
+      if ((part & lowest) == 0) {
+        continue;
+      }
+      uint32_t rest = subset ^ part;
+      double cost = best_cost[part] + best_cost[rest] + ContractionCost(subset_dims[part], subset_dims[rest]);
+      if (cost < best_cost[subset]) {
+        best_cost[subset] = cost;
+        best_split[subset] = part;
+      }
+    }
+  }
+
+  // Replay the tree in post-order on the operand list to turn it into contraction steps
+  ContractionPlan plan;
+  plan.reserve(num_operands - 1);
+  std::vector<uint32_t> operand_list;
+  for (size_t i = 0; i < num_operands; ++i) {
+    operand_list.push_back(1u << i);
+  }
+
+  std::function<void(uint32_t)> emit = [&](uint32_t subset) {
+    if ((subset & (subset - 1)) == 0) {
+      return;
+    }
+    uint32_t part = best_split[subset];
+    uint32_t rest = subset ^ part;
+    emit(part);
+    emit(rest);
+    size_t left = std::find(operand_list.begin(), operand_list.end(), part) - operand_list.begin();
+    size_t right = std::find(operand_list.begin(), operand_list.end(), rest) - operand_list.begin();
+    if (left > right) {
+      std::swap(left, right);
+    }
+    plan.push_back({left, right});
+    operand_list.erase(operand_list.begin() + right);
+    operand_list.erase(operand_list.begin() + left);
+    operand_list.push_back(subset);
+  };
+  emit(full);
+
+  return plan;
+}
+
+// Repeatedly contracts the cheapest pair of the remaining operands
+static ContractionPlan PlanGreedyContraction(std::vector<LabelDims> operands,
+                                             const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  const size_t num_labels = subscript_indices_to_output_indices.size();
+  ContractionPlan plan;
+  plan.reserve(operands.size() - 1);
+
+  while (operands.size() > 1) {
+    size_t best_left = 0;
+    size_t best_right = 1;
+    double best_cost = std::numeric_limits<double>::max();
+    for (size_t left = 0; left < operands.size(); ++left) {
+      for (size_t right = left + 1; right < operands.size(); ++right) {
+        double cost = ContractionCost(operands[left], operands[right]);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_left = left;
+          best_right = right;
+        }
+      }
+    }
+
+    LabelDims result(num_labels, 1);
+    for (size_t label = 0; label < num_labels; ++label) {
+      bool needed = subscript_indices_to_output_indices[label] != -1;
+      for (size_t i = 0; i < operands.size() && !needed; ++i) {
+        needed = i != best_left && i != best_right && operands[i][label] > 1;
+      }
+      if (needed) {
+        result[label] = std::max(operands[best_left][label], operands[best_right][label]);
+      }
+    }
+
+    plan.push_back({best_left, best_right});
+    operands.erase(operands.begin() + best_right);
+    operands.erase(operands.begin() + best_left);
+    operands.push_back(std::move(result));
+  }
+
+  return plan;
+}
+
+ContractionPlan PlanContraction(const std::vector<TensorShape>& homogenized_input_dims,
+                                const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  const size_t num_operands = homogenized_input_dims.size();
+  ORT_ENFORCE(num_operands > 0, "Einsum op: There must be at least one operand to contract");
+
+  std::vector<LabelDims> operands;
+  operands.reserve(num_operands);
+  for (const auto& dims : homogenized_input_dims) {
+    ORT_ENFORCE(dims.NumDimensions() == subscript_indices_to_output_indices.size(),
+                "Einsum op: Operands must be homogenized before planning the contraction");
+    operands.push_back(dims.GetDims());
+  }
+
+  if (num_operands <= 2) {
+    return num_operands == 2 ? ContractionPlan{{0, 1}} : ContractionPlan{};
+  }
+
+  if (num_operands <= kMaxOperandsForOptimalContraction) {
+    return PlanOptimalContraction(operands, subscript_indices_to_output_indices);
+  }
+
+  return PlanGreedyContraction(std::move(operands), subscript_indices_to_output_indices);
+}
+
+ContractionPlan ContractionPlanCache::GetOrCreate(const std::vector<TensorShape>& homogenized_input_dims,
+                                                  const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  // The equation (hence the rank of every homogenized input) is fixed for a given kernel,
+  // so the concatenated dims identify the shapes
+  std::vector<int64_t> key;
+  for (const auto& dims : homogenized_input_dims) {
+    key.insert(key.end(), dims.GetDims().begin(), dims.GetDims().end());
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = plans_.find(key);
+    if (it != plans_.end()) {
+      return it->second;
+    }
+  }
+
+  ContractionPlan plan = PlanContraction(homogenized_input_dims, subscript_indices_to_output_indices);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (plans_.size() >= kMaxCachedPlans) {
+    plans_.clear();
+  }
+  plans_.emplace(std::move(key), plan);
+  return plan;
+}
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
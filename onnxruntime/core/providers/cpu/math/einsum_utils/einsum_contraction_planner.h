@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// This module hosts the following abstractions -
+
+// 1) PlanContraction - Picks the order in which the Einsum operands are contracted pair-wise
+// based on the actual (homogenized) input shapes. A contraction of N operands done strictly
+// left to right may create huge intermediates (and spend most of its time transposing them),
+// while another order of the same pair-wise contractions does a fraction of the work.
+
+// 2) ContractionPlanCache - Caches the plan per set of input shapes so repeated Compute() calls
+// with the same shapes don't have to plan again.
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+// Operands are kept in a list, a step contracts the operands at positions `left` and `right` (left < right),
+// removes both from the list and appends the result at its end (same convention as opt_einsum's contraction list).
+struct ContractionStep {
+  size_t left;
+  size_t right;
+};
+
+using ContractionPlan = std::vector<ContractionStep>;
+
+// Number of operands up to which the optimal order (least multiply-adds) is found by dynamic programming
+// over the subsets of operands. A greedy search is used beyond that.
+constexpr size_t kMaxOperandsForOptimalContraction = 8;
+
+// `homogenized_input_dims` - the input shapes after homogenization (one dim per subscript label, 1 if absent)
+// `subscript_indices_to_output_indices` - the output index of each subscript label (-1 if it is reduced)
+ContractionPlan PlanContraction(const std::vector<TensorShape>& homogenized_input_dims,
+                                const std::vector<int64_t>& subscript_indices_to_output_indices);
+
+class ContractionPlanCache {
+ public:
+  ContractionPlan GetOrCreate(const std::vector<TensorShape>& homogenized_input_dims,
+                              const std::vector<int64_t>& subscript_indices_to_output_indices);
+
+ private:
+  // Bounds the memory used by models feeding many different shapes
+  static constexpr size_t kMaxCachedPlans = 32;
+
+  OrtMutex mutex_;
+  std::map<std::vector<int64_t>, ContractionPlan> plans_;
+};
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
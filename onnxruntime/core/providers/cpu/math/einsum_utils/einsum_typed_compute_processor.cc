@@ -90,6 +90,60 @@ static bool IsTransposeReshapeForEinsum(const std::vector<size_t>& perm,
   return true;
 }
 
+// Number of operands PairwiseOperandProcess() has to actually transpose (rather than reshape)
+// given which one is the left operand. Mirrors how it classifies and permutes the dims.
+static int CountPairwiseTransposes(const std::vector<int64_t>& left_dims,
+                                   const std::vector<int64_t>& right_dims,
+                                   const std::vector<int64_t>& reduce_dims) {
+  const size_t rank = left_dims.size();
+  std::vector<size_t> lro, lo, ro, reduced;
+  // Dims to be reduced that only one of the operands has are summed up (i.e. become 1) before the permutations
+  std::vector<int64_t> left_view = left_dims;
+  std::vector<int64_t> right_view = right_dims;
+
+  size_t reduce_dims_iter = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    bool has_left_dim = left_dims[i] > 1;
+    bool has_right_dim = right_dims[i] > 1;
+    if (reduce_dims_iter < reduce_dims.size() && reduce_dims[reduce_dims_iter] == static_cast<int64_t>(i)) {
+      ++reduce_dims_iter;
+      reduced.push_back(i);
+      if (!has_left_dim || !has_right_dim) {
+        left_view[i] = 1;
+        right_view[i] = 1;
+      }
+    } else if (has_left_dim && has_right_dim) {
+      lro.push_back(i);
+    } else if (has_left_dim) {
+      lo.push_back(i);
+    } else {
+      ro.push_back(i);
+    }
+  }
+
+  std::vector<size_t> left_permutation(lro);
+  left_permutation.insert(left_permutation.end(), lo.begin(), lo.end());
+  left_permutation.insert(left_permutation.end(), reduced.begin(), reduced.end());
+  left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
+
+  std::vector<size_t> right_permutation(lro);
+  right_permutation.insert(right_permutation.end(), reduced.begin(), reduced.end());
+  right_permutation.insert(right_permutation.end(), ro.begin(), ro.end());
+  right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
+
+  int num_transposes = 0;
+  std::vector<int64_t> reshaped_dims;
+  if (EinsumOp::IsTransposeRequired(rank, left_permutation) &&
+      !IsTransposeReshapeForEinsum(left_permutation, left_view, reshaped_dims)) {
+    ++num_transposes;
+  }
+  if (EinsumOp::IsTransposeRequired(rank, right_permutation) &&
+      !IsTransposeReshapeForEinsum(right_permutation, right_view, reshaped_dims)) {
+    ++num_transposes;
+  }
+  return num_transposes;
+}
+
 template <typename T>
 std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(const Tensor& left,
                                                                                const TensorShape& left_shape_override,
@@ -141,6 +195,10 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   size_t reduce_dims_iter = 0;
   size_t reduce_dims_size = reduce_dims.size();
 
+  // Dims to be reduced that only one of the operands has are summed up before the MatMul
+  std::vector<int64_t> left_only_reduce_dims;
+  std::vector<int64_t> right_only_reduce_dims;
+
   for (int64_t i = 0; i < left_rank; ++i) {
     int64_t left_dim = left_dims[i];
     int64_t right_dim = right_dims[i];
@@ -157,11 +215,9 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
                     "Einsum op: Input dimensions must be equal along an axis to be reduced across all inputs");
         reduced_size *= left_dim;
       } else if (has_left_dim) {  // if it is only in one of left and right, we can reduce right away
-        current_left = EinsumOp::ReduceSum<T>(
-            left, left_dims, {i}, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+        left_only_reduce_dims.push_back(i);
       } else if (has_right_dim) {
-        current_right = EinsumOp::ReduceSum<T>(
-            right, right_dims, {i}, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+        right_only_reduce_dims.push_back(i);
       }
     } else {  // This dimension is not reduced (i.e.) it appears in the output after processing these 2 operands
       // Both the left and right operands have non-trivial dimension value along this axis
@@ -184,6 +240,15 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
     }
   }
 
+  if (!left_only_reduce_dims.empty()) {
+    current_left = EinsumOp::ReduceSum<T>(
+        left, left_dims, left_only_reduce_dims, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+  }
+  if (!right_only_reduce_dims.empty()) {
+    current_right = EinsumOp::ReduceSum<T>(
+        right, right_dims, right_only_reduce_dims, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+  }
+
   // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
   std::vector<int64_t> reshaped_dims;
   std::vector<size_t> left_permutation;
@@ -194,14 +259,17 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
   if (EinsumOp::IsTransposeRequired(current_left ? current_left->Shape().GetDims().size() : left_dims.size(),
                                     left_permutation)) {
-    if (current_left && IsTransposeReshapeForEinsum(left_permutation,
-                                                    current_left->Shape().GetDims(),
-                                                    reshaped_dims)) {
+    if (IsTransposeReshapeForEinsum(left_permutation,
+                                    current_left ? current_left->Shape().GetDims() : left_dims,
+                                    reshaped_dims)) {
       // This can be done because curent_* tensors (if they exist) and output tensors are
       // intermediate tensors and cannot be input tensors to the Einsum node itself
       // (which are immutable).
       // Covered by ExplicitEinsumAsTensorContractionReshapeLeft.
-      current_left->Reshape(reshaped_dims);
+      // An input tensor is left as is, the MatMul below only reads it through the [lro, lo, reduce_dims] view.
+      if (current_left) {
+        current_left->Reshape(reshaped_dims);
+      }
     } else {
       // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
       current_left = EinsumOp::Transpose(current_left ? *current_left : left,
@@ -220,12 +288,14 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
   if (EinsumOp::IsTransposeRequired(current_right ? current_right->Shape().GetDims().size() : right_dims.size(),
                                     right_permutation)) {
-    if (current_right && IsTransposeReshapeForEinsum(right_permutation,
-                                                     current_right->Shape().GetDims(),
-                                                     reshaped_dims)) {
+    if (IsTransposeReshapeForEinsum(right_permutation,
+                                    current_right ? current_right->Shape().GetDims() : right_dims,
+                                    reshaped_dims)) {
       // See note following the previous call of function IsTransposeReshapeForEinsum.
       // Covered by ExplicitEinsumAsBatchedMatmulWithBroadcasting_1, ExplicitEinsumAsMatmul_2, ...
-      current_right->Reshape(reshaped_dims);
+      if (current_right) {
+        current_right->Reshape(reshaped_dims);
+      }
     } else {
       // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
       current_right = EinsumOp::Transpose(current_right ? *current_right : right,
@@ -383,28 +453,70 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     }
   }
 
-  // Process the operands in a pair-wise fashion
+  // Process the operands in a pair-wise fashion, in the order picked by the contraction planner
   {
-    bool is_final_pair = false;
-    // Keep processing each input pair-wise
+    const auto& subscript_indices_to_output_indices =
+        einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+    EinsumOp::ContractionPlan plan =
+        contraction_plan_cache_
+            ? contraction_plan_cache_->GetOrCreate(homogenized_input_dims, subscript_indices_to_output_indices)
+            : EinsumOp::PlanContraction(homogenized_input_dims, subscript_indices_to_output_indices);
+
+    // Operands left to contract. Intermediate results are owned here until they are consumed.
+    struct Operand {
+      const Tensor* tensor;
+      TensorShape shape;
+      std::unique_ptr<const Tensor> owned;
+    };
+    std::vector<Operand> operands;
+    operands.reserve(num_inputs);
+
+    // The first input may already have been reduced above
+    operands.push_back({result ? result.get() : raw_inputs[0],
+                        result ? result->Shape() : homogenized_input_dims[0],
+                        std::move(result)});
     for (int input = 1; input < num_inputs; ++input) {
+      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
+      operands.push_back({preprocessed_inputs[input] ? preprocessed_inputs[input].get() : raw_inputs[input],
+                          homogenized_input_dims[input],
+                          nullptr});
+    }
+
+    for (const auto& step : plan) {
+      bool is_final_pair = operands.size() == 2;
+
       std::vector<int64_t> reduced_dims;
       reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[dim] == input) {
-          // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
+        if (subscript_indices_to_output_indices[dim] != -1) {
+          continue;
+        }
+        // This dimension doesn't occur in the output, reduce along it unless an operand yet to be contracted has it
+        bool is_needed_later = false;
+        for (size_t i = 0; i < operands.size() && !is_needed_later; ++i) {
+          is_needed_later = i != step.left && i != step.right && operands[i].shape[dim] > 1;
+        }
+        if (!is_needed_later) {
           reduced_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
-        is_final_pair = true;
+
+      // The contraction is symmetric, pick the operand order that needs fewer transposes
+      size_t left = step.left;
+      size_t right = step.right;
+      if (CountPairwiseTransposes(operands[right].shape.GetDims(), operands[left].shape.GetDims(), reduced_dims) <
+          CountPairwiseTransposes(operands[left].shape.GetDims(), operands[right].shape.GetDims(), reduced_dims)) {
+        std::swap(left, right);
       }
-      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
-                                      preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
-                                      homogenized_input_dims[input],
-                                      reduced_dims, is_final_pair);
+
+      std::unique_ptr<const Tensor> contracted = PairwiseOperandProcess(*operands[left].tensor, operands[left].shape,
+                                                                        *operands[right].tensor, operands[right].shape,
+                                                                        reduced_dims, is_final_pair);
+
+      operands.erase(operands.begin() + step.right);
+      operands.erase(operands.begin() + step.left);
+      const Tensor* contracted_tensor = contracted.get();
+      operands.push_back({contracted_tensor, contracted_tensor->Shape(), std::move(contracted)});
     }
   }
 
@@ -9,6 +9,7 @@
 
 #include "einsum_auxiliary_ops.h"
 #include "einsum_compute_preprocessor.h"
+#include "einsum_contraction_planner.h"
 
 namespace onnxruntime {
 
@@ -33,6 +34,12 @@ class EinsumTypedComputeProcessor {
                         const EinsumOp::DeviceHelpers::ReduceSum<T>& device_reduce_sum_func,
                         const EinsumOp::DeviceHelpers::DataCopy& device_data_copy_func);
 
+  // Re-use the contraction plans computed by previous Run() calls with the same shapes
+  // (the cache is owned by the kernel, a plan is computed on every Run() without it)
+  void SetContractionPlanCache(EinsumOp::ContractionPlanCache* contraction_plan_cache) {
+    contraction_plan_cache_ = contraction_plan_cache;
+  }
+
   Status Run();
 
  private:
@@ -67,6 +74,8 @@ class EinsumTypedComputeProcessor {
 
   // Holds EP-specific assets required for (auxiliary) ops that need to be executed on non-CPU EPs
   void* einsum_ep_assets_;
+
+  EinsumOp::ContractionPlanCache* contraction_plan_cache_ = nullptr;
 };
 
 }  // namespace onnxruntime
@@ -420,6 +420,11 @@ static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
 
 template <typename T>
 Status Add<T>::Compute(OpKernelContext* context) const {
+  // scalar, row, channel-wise and no broadcast inputs are processed in contiguous segments across threads
+  if (TryBroadcastRepeated<T>(*context, 1.0, [](const auto& x, const auto& y) { return x + y; })) {
+    return Status::OK();
+  }
+
   // BroadcastHelper received as argument may differ from 'helper' when parallelizing within a span
   ProcessBroadcastSpanFuncs funcs{
       [](BroadcastHelper& per_iter_bh) {
@@ -438,6 +443,10 @@ Status Add<T>::Compute(OpKernelContext* context) const {
 
 template <typename T>
 Status Sub<T>::Compute(OpKernelContext* context) const {
+  if (TryBroadcastRepeated<T>(*context, 1.0, [](const auto& x, const auto& y) { return x - y; })) {
+    return Status::OK();
+  }
+
   ProcessBroadcastSpanFuncs funcs{
       [](BroadcastHelper& per_iter_bh) {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.ScalarInput0<T>() - per_iter_bh.EigenInput1<T>().array();
@@ -455,6 +464,10 @@ Status Sub<T>::Compute(OpKernelContext* context) const {
 
 template <typename T>
 Status Mul<T>::Compute(OpKernelContext* context) const {
+  if (TryBroadcastRepeated<T>(*context, 1.0, [](const auto& x, const auto& y) { return x * y; })) {
+    return Status::OK();
+  }
+
   ProcessBroadcastSpanFuncs funcs{
       [](BroadcastHelper& per_iter_bh) {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.ScalarInput0<T>() * per_iter_bh.EigenInput1<T>().array();
@@ -472,6 +485,10 @@ Status Mul<T>::Compute(OpKernelContext* context) const {
 
 template <typename T>
 Status Div<T>::Compute(OpKernelContext* context) const {
+  if (TryBroadcastRepeated<T>(*context, 1.0, [](const auto& x, const auto& y) { return x / y; })) {
+    return Status::OK();
+  }
+
   ProcessBroadcastSpanFuncs funcs{
       [](BroadcastHelper& per_iter_bh) {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.ScalarInput0<T>() / per_iter_bh.EigenInput1<T>().array();
@@ -1813,6 +1830,55 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
   }
 }
 
+bool GetRepeatedBroadcast(const TensorShape& shape0, const TensorShape& shape1, RepeatedBroadcast& pattern) {
+  const auto& dims0 = shape0.GetDims();
+  const auto& dims1 = shape1.GetDims();
+  pattern.full_is_input0 = shape0.Size() >= shape1.Size();
+  const auto& full_dims = pattern.full_is_input0 ? dims0 : dims1;
+  const auto& repeated_dims = pattern.full_is_input0 ? dims1 : dims0;
+
+  const size_t rank = std::max(dims0.size(), dims1.size());
+  const size_t full_pad = rank - full_dims.size();
+  const size_t repeated_pad = rank - repeated_dims.size();
+  pattern.output_dims.resize(rank);
+
+  // the axes where the repeated input is not broadcast must be contiguous, ignoring axes of size 1
+  enum { kOuter, kMiddle, kInner } position = kOuter;
+  pattern.outer = pattern.middle = pattern.inner = 1;
+  for (size_t axis = 0; axis < rank; ++axis) {
+    const int64_t full_dim = axis < full_pad ? 1 : full_dims[axis - full_pad];
+    const int64_t repeated_dim = axis < repeated_pad ? 1 : repeated_dims[axis - repeated_pad];
+    if (full_dim == 0 || (repeated_dim != 1 && repeated_dim != full_dim)) {
+      return false;
+    }
+
+    pattern.output_dims[axis] = full_dim;
+    if (full_dim == 1) {
+      continue;
+    }
+
+    if (repeated_dim == full_dim) {
+      if (position == kInner) {
+        return false;
+      }
+      position = kMiddle;
+      pattern.middle *= full_dim;
+    } else if (position == kOuter) {
+      pattern.outer *= full_dim;
+    } else {
+      position = kInner;
+      pattern.inner *= full_dim;
+    }
+  }
+
+  // a scalar repeats along the inner dimension so segments are as long as possible
+  if (position == kOuter) {
+    std::swap(pattern.outer, pattern.inner);
+  }
+
+  return true;
+}
+
 // allocate_tensor should allocate a tensor of the output type with the given shape
 static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
                                      AllocateTensorFunc allocate_tensor,
@@ -966,6 +966,87 @@ void BroadcastLooper(TBroadcastHelper& helper, const ProcessBroadcastSpanFuncs&
   }
 }
 
+// Binary broadcast where one input has the full output shape and the other one repeats along the outer and inner
+// dimensions. Viewing the output as [outer, middle, inner], the repeated input is indexed by the middle index only.
+// This covers the no broadcast case (outer == inner == 1), a scalar (middle == 1), a row such as [N, C] with [C]
+// (inner == 1) and a channel-wise bias such as [N, C, H, W] with [C, 1, 1].
+struct RepeatedBroadcast {
+  bool full_is_input0{true};
+  std::ptrdiff_t outer{1};
+  std::ptrdiff_t middle{1};
+  std::ptrdiff_t inner{1};
+  std::vector<int64_t> output_dims;
+};
+
+// Classify the broadcast of two input shapes. Returns false if it is not a RepeatedBroadcast, or the output is empty,
+// in which case the generic UntypedBroadcastTwo path should be used.
+bool GetRepeatedBroadcast(const TensorShape& shape0, const TensorShape& shape1, RepeatedBroadcast& pattern);
+
+// Compute a binary op over a RepeatedBroadcast without the per span iterator bookkeeping of BroadcastLooper.
+// The output is split into element ranges across threads, and each range is processed in contiguous segments with
+// a constant repeated value (inner > 1) or a contiguous repeated row (inner == 1).
+// op is called with Eigen arrays and/or scalars of T, in input order, e.g. [](const auto& x, const auto& y) { return x + y; }
+template <typename T, typename Op>
+void BroadcastRepeated(const RepeatedBroadcast& pattern, const T* input0, const T* input1, T* output,
+                       concurrency::ThreadPool* tp, double unit_cost, const Op& op) {
+  const T* full = pattern.full_is_input0 ? input0 : input1;
+  const T* repeated = pattern.full_is_input0 ? input1 : input0;
+  const bool full_is_input0 = pattern.full_is_input0;
+  const std::ptrdiff_t middle = pattern.middle;
+  const std::ptrdiff_t inner = pattern.inner;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, pattern.outer * middle * inner,
+      TensorOpCost{static_cast<double>(2 * sizeof(T)), static_cast<double>(sizeof(T)), unit_cost},
+      [=, &op](std::ptrdiff_t first, std::ptrdiff_t last) {
+        if (inner > 1) {
+          for (std::ptrdiff_t i = first; i < last;) {
+            const std::ptrdiff_t row = i / inner;
+            const std::ptrdiff_t end = std::min(last, (row + 1) * inner);
+            const T value = repeated[row % middle];
+            ConstEigenVectorArrayMap<T> full_segment(full + i, end - i);
+            EigenVectorArrayMap<T> output_segment(output + i, end - i);
+            if (full_is_input0) {
+              output_segment = op(full_segment, value);
+            } else {
+              output_segment = op(value, full_segment);
+            }
+            i = end;
+          }
+        } else {
+          for (std::ptrdiff_t i = first; i < last;) {
+            const std::ptrdiff_t column = i % middle;
+            const std::ptrdiff_t end = std::min(last, i - column + middle);
+            ConstEigenVectorArrayMap<T> full_segment(full + i, end - i);
+            ConstEigenVectorArrayMap<T> repeated_segment(repeated + column, end - i);
+            EigenVectorArrayMap<T> output_segment(output + i, end - i);
+            if (full_is_input0) {
+              output_segment = op(full_segment, repeated_segment);
+            } else {
+              output_segment = op(repeated_segment, full_segment);
+            }
+            i = end;
+          }
+        }
+      });
+}
+
+// Run op with BroadcastRepeated if the inputs of the node are a RepeatedBroadcast. Returns false otherwise.
+template <typename T, typename Op>
+bool TryBroadcastRepeated(OpKernelContext& context, double unit_cost, const Op& op) {
+  const Tensor& input0 = *context.Input<Tensor>(0);
+  const Tensor& input1 = *context.Input<Tensor>(1);
+  RepeatedBroadcast pattern;
+  if (!GetRepeatedBroadcast(input0.Shape(), input1.Shape(), pattern)) {
+    return false;
+  }
+
+  Tensor& output = *context.Output(0, TensorShape(pattern.output_dims));
+  BroadcastRepeated<T>(pattern, input0.Data<T>(), input1.Data<T>(), output.MutableData<T>(),
+                       context.GetOperatorThreadPool(), unit_cost, op);
+  return true;
+}
+
 struct TensorAllocator {
   TensorAllocator(OpKernelContext& context) {
     auto status = context.GetTempSpaceAllocator(&allocator_);
@@ -6,6 +6,8 @@
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/common/parse_string.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -23,6 +25,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 
 // opset 9 added support for additional types (int32, uint32, int64, uint64), however we haven't enabled those yet.
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -39,6 +48,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    9,
+    10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 
 // opset 11 made bias input 'C' optional
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -55,6 +71,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 
 // opset 13 Adds BFloat16 support but we are not supporting it yet
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
@@ -69,6 +92,12 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 
 bool GemmPackBFp32(const OpKernelInfo& info,
                    const Tensor& tensor_b,
@@ -102,6 +131,118 @@ bool GemmPackBFp32(const OpKernelInfo& info,
   return true;
 }
 
+size_t GemmPackBFp32Size(const TensorShape& b_shape, bool trans_b) {
+  if (b_shape.NumDimensions() != 2) {
+    return 0;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+  return MlasGemmPackBSize(N, K);
+}
+
+bool GemmUseSavedPackBFp32(const OpKernelInfo& info,
+                           const Tensor& tensor_b,
+                           bool trans_b,
+                           gsl::span<const uint8_t> saved_packed_b,
+                           BufferUniquePtr& packed_b,
+                           TensorShape& b_shape) {
+  const size_t packed_b_size = GemmPackBFp32Size(tensor_b.Shape(), trans_b);
+  if (packed_b_size == 0 || static_cast<size_t>(saved_packed_b.size()) != packed_b_size) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  memcpy(packed_b_data, saved_packed_b.data(), packed_b_size);
+  return true;
+}
+
+bool GemmFastMathBf16Enabled(const OpKernelInfo& info) {
+  return info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigGemmFastMathBf16, "0") == "1" &&
+         MlasSBGemmIsSupported();
+}
+
+bool GemmPackBBf16(const OpKernelInfo& info,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  const size_t packed_b_size = MlasSBGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasSBGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                  N,
+                  K,
+                  tensor_b.Data<float>(),
+                  trans_b ? K : N,
+                  packed_b_data);
+  return true;
+}
+
+GemmSparseBConfig GemmGetSparseBConfig(const OpKernelInfo& info) {
+  const auto& config_options = info.GetConfigOptions();
+  GemmSparseBConfig config;
+
+  const std::string max_density = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGemmSparseMaxDensity,
+                                                                     "0.2");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(max_density, config.max_density) &&
+                  config.max_density >= 0.f && config.max_density <= 1.f,
+              "Invalid value for ", kOrtSessionOptionsConfigGemmSparseMaxDensity, ": ", max_density);
+
+  const std::string zero_threshold = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGemmSparseZeroThreshold,
+                                                                       "0");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(zero_threshold, config.zero_threshold) && config.zero_threshold >= 0.f,
+              "Invalid value for ", kOrtSessionOptionsConfigGemmSparseZeroThreshold, ": ", zero_threshold);
+
+  return config;
+}
+
+bool GemmPackBSparse(const OpKernelInfo& info,
+                     const GemmSparseBConfig& config,
+                     const Tensor& tensor_b,
+                     bool trans_b,
+                     BufferUniquePtr& packed_b,
+                     TensorShape& b_shape) {
+  if (config.max_density <= 0.f || tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const TensorShape& shape = tensor_b.Shape();
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  const CBLAS_TRANSPOSE trans = trans_b ? CblasTrans : CblasNoTrans;
+
+  const size_t packed_b_size = MlasSparseGemmPackBSize(trans, N, K, tensor_b.Data<float>(), trans_b ? K : N,
+                                                       config.zero_threshold, config.max_density);
+  if (packed_b_size == 0) {
+    return false;
+  }
+  b_shape = shape;
+
+  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasSparseGemmPackB(trans, N, K, tensor_b.Data<float>(), trans_b ? K : N,
+                      config.zero_threshold, config.max_density, packed_b_data);
+  return true;
+}
+
 template <typename T>
 static void GemmBroadcastBias(int64_t M, int64_t N, float beta,
                               const T* c_data, const TensorShape* c_shape,
@@ -126,6 +267,32 @@ static void GemmBroadcastBias(int64_t M, int64_t N, float beta,
   }
 }
 
+// Eigen does not support arithmetic on MLFloat16, so broadcast the bias with plain copies.
+static void GemmBroadcastBias(int64_t M, int64_t N, float beta,
+                              const MLFloat16* c_data, const TensorShape* c_shape,
+                              MLFloat16* y_data) {
+  if (beta != 0 && c_data != nullptr) {
+    ORT_ENFORCE(c_shape != nullptr, "c_shape is required if c_data is provided");
+    if (c_shape->Size() == 1) {
+      // C is (), (1,) or (1, 1), set the scalar
+      std::fill_n(y_data, M * N, *c_data);
+    } else if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
+      // C is (N,) or (1, N)
+      for (int64_t m = 0; m < M; ++m) {
+        std::copy_n(c_data, N, y_data + m * N);
+      }
+    } else if ((*c_shape)[1] == 1) {
+      // C is (M, 1)
+      for (int64_t m = 0; m < M; ++m) {
+        std::fill_n(y_data + m * N, N, c_data[m]);
+      }
+    } else {
+      // C is (M, N), no broadcast needed.
+      std::copy_n(c_data, M * N, y_data);
+    }
+  }
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
@@ -163,6 +330,37 @@ template void Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE
                                        float* y_data,
                                        concurrency::ThreadPool* thread_pool);
 
+template <>
+void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                                  int64_t M, int64_t N, int64_t K,
+                                  float alpha,
+                                  const MLFloat16* a_data, const MLFloat16* b_data,
+                                  float beta,
+                                  const MLFloat16* c_data, const TensorShape* c_shape,
+                                  MLFloat16* y_data,
+                                  concurrency::ThreadPool* thread_pool) {
+  // if input is empty tensor, return directly as nothing need to be calculated.
+  if (M == 0 || N == 0)
+    return;
+
+  // Broadcast the bias as needed if bias is given
+  GemmBroadcastBias(M, N, beta, c_data, c_shape, y_data);
+
+  MlasHalfGemm(trans_a, trans_b,
+               static_cast<size_t>(M),
+               static_cast<size_t>(N),
+               static_cast<size_t>(K),
+               alpha,
+               reinterpret_cast<const MLAS_FP16*>(a_data),
+               static_cast<size_t>(trans_a != CblasNoTrans ? M : K),
+               reinterpret_cast<const MLAS_FP16*>(b_data),
+               static_cast<size_t>(trans_b != CblasNoTrans ? K : N),
+               c_data != nullptr ? beta : 0.0f,
+               reinterpret_cast<MLAS_FP16*>(y_data),
+               static_cast<size_t>(N),
+               thread_pool);
+}
+
 template <typename T>
 Status Gemm<T>::PrePack(const Tensor& /* tensor */, int /* input_idx */, bool& is_packed) {
   is_packed = false;
@@ -175,7 +373,64 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed
 
   // only pack Matrix B
   if (input_idx == 1) {
-    is_packed = GemmPackBFp32(Info(), tensor, trans_B_ != CblasNoTrans, packed_b_, b_shape_);
+    if (use_fastmath_bf16_) {
+      is_packed = packed_b_bf16_ = GemmPackBBf16(Info(), tensor, trans_B_ != CblasNoTrans, packed_b_, b_shape_);
+    }
+    if (!is_packed) {
+      is_packed = GemmPackBFp32(Info(), tensor, trans_B_ != CblasNoTrans, packed_b_, b_shape_);
+    }
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) {
+  // the bfloat16 packed buffer is not shared as the sharing key does not distinguish it from the fp32 format
+  if (input_idx == 1 && packed_b_ && !packed_b_bf16_) {
+    prepacked_buffers.push_back(std::move(packed_b_));
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                          bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::GetPrePackedBuffers(int input_idx, std::vector<gsl::span<const uint8_t>>& prepacked_buffers) const {
+  if (input_idx == 1 && packed_b_ && !packed_b_bf16_) {
+    prepacked_buffers.push_back(gsl::make_span(static_cast<const uint8_t*>(packed_b_.get()),
+                                               GemmPackBFp32Size(b_shape_, trans_B_ != CblasNoTrans)));
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::UseSavedPrePackedBuffers(const Tensor& /* tensor */, int /* input_idx */,
+                                         const std::vector<gsl::span<const uint8_t>>& /* prepacked_buffers */,
+                                         bool& used_saved_buffers) {
+  used_saved_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UseSavedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                             const std::vector<gsl::span<const uint8_t>>& prepacked_buffers,
+                                             bool& used_saved_buffers) {
+  used_saved_buffers = false;
+
+  // the saved buffer is in the fp32 format, so let PrePack produce the bfloat16 one
+  if (input_idx == 1 && !use_fastmath_bf16_ && prepacked_buffers.size() == 1) {
+    used_saved_buffers = GemmUseSavedPackBFp32(Info(), tensor, trans_B_ != CblasNoTrans, prepacked_buffers[0],
+                                               packed_b_, b_shape_);
   }
   return Status::OK();
 }
@@ -266,6 +521,18 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   if (B) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
+  } else if (packed_b_bf16_) {
+    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+    data.B = static_cast<const float*>(packed_b_.get());
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.alpha = alpha_;
+    data.beta = c_data != nullptr ? beta_ : 0.0f;
+    MlasSBGemmBatch(trans_A_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                    &data, 1, thread_pool);
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
     MlasGemm(
@@ -7,6 +7,7 @@
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -23,12 +24,25 @@ class Gemm : public OpKernel {
 
     ORT_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+
+    use_fastmath_bf16_ = std::is_same<T, float>::value && GemmFastMathBf16Enabled(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
   Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
 
+  Status TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   bool& used_shared_buffers) override;
+
+  Status GetPrePackedBuffers(int input_idx, std::vector<gsl::span<const uint8_t>>& prepacked_buffers) const override;
+
+  Status UseSavedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                  const std::vector<gsl::span<const uint8_t>>& prepacked_buffers,
+                                  bool& used_saved_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
                           float alpha,
@@ -48,6 +62,10 @@ class Gemm : public OpKernel {
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
 
+  // B is packed to bfloat16 for MlasSBGemmBatch if the session enables kOrtSessionOptionsConfigGemmFastMathBf16
+  bool use_fastmath_bf16_{false};
+  bool packed_b_bf16_{false};
+
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
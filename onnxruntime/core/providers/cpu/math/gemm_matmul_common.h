@@ -13,4 +13,45 @@ bool GemmPackBFp32(const OpKernelInfo& info,
                    BufferUniquePtr& packed_b,
                    TensorShape& b_shape);
 
+// Returns the size of the buffer GemmPackBFp32 packs B with the given shape into.
+size_t GemmPackBFp32Size(const TensorShape& b_shape, bool trans_b);
+
+// Copies B packed by GemmPackBFp32 in an earlier session (e.g. saved in an ORT format model) into a new buffer.
+// Returns false if the saved buffer does not match the layout GemmPackBFp32 would produce for tensor_b.
+bool GemmUseSavedPackBFp32(const OpKernelInfo& info,
+                           const Tensor& tensor_b,
+                           bool trans_b,
+                           gsl::span<const uint8_t> saved_packed_b,
+                           BufferUniquePtr& packed_b,
+                           TensorShape& b_shape);
+
+// Returns true if the session enables kOrtSessionOptionsConfigGemmFastMathBf16 and the platform supports
+// the bfloat16 GEMM.
+bool GemmFastMathBf16Enabled(const OpKernelInfo& info);
+
+// Packs B for MlasSBGemmBatch. The buffer holds bfloat16 values, so it must not be shared with kernels that
+// expect the single precision packed format.
+bool GemmPackBBf16(const OpKernelInfo& info,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   TensorShape& b_shape);
+
+// Settings for packing a constant B into the block sparse format of MlasSparseGemmBatch, from the
+// kOrtSessionOptionsConfigGemmSparseMaxDensity and kOrtSessionOptionsConfigGemmSparseZeroThreshold session options.
+struct GemmSparseBConfig {
+  float max_density{0.f};  // 0 disables the block sparse format
+  float zero_threshold{0.f};
+};
+
+GemmSparseBConfig GemmGetSparseBConfig(const OpKernelInfo& info);
+
+// Packs the non-zero blocks of B for MlasSparseGemmBatch. Returns false if B is not sparse enough.
+bool GemmPackBSparse(const OpKernelInfo& info,
+                     const GemmSparseBConfig& config,
+                     const Tensor& tensor_b,
+                     bool trans_b,
+                     BufferUniquePtr& packed_b,
+                     TensorShape& b_shape);
+
 };  // namespace onnxruntime
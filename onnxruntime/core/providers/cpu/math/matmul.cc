@@ -24,6 +24,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 // opset 9 supports more types
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
@@ -41,6 +48,14 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     9,
@@ -73,6 +88,13 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     13,
@@ -131,7 +153,56 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_pack
 
   // only pack Matrix B
   if (input_idx == 1) {
-    is_packed = GemmPackBFp32(Info(), tensor, trans_b_attr_, packed_b_, b_shape_);
+    is_packed = packed_b_sparse_ = GemmPackBSparse(Info(), sparse_b_config_, tensor, trans_b_attr_ != 0,
+                                                   packed_b_, b_shape_);
+    if (!is_packed && use_fastmath_bf16_) {
+      is_packed = packed_b_bf16_ = GemmPackBBf16(Info(), tensor, trans_b_attr_, packed_b_, b_shape_);
+    }
+    if (!is_packed) {
+      is_packed = GemmPackBFp32(Info(), tensor, trans_b_attr_, packed_b_, b_shape_);
+    }
+  }
+  return Status::OK();
+}
+
+Status MatMul<float>::TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) {
+  // the bfloat16 and sparse packed buffers are not shared as the sharing key does not distinguish them from the
+  // fp32 format
+  if (input_idx == 1 && packed_b_ && !packed_b_bf16_ && !packed_b_sparse_) {
+    prepacked_buffers.push_back(std::move(packed_b_));
+  }
+  return Status::OK();
+}
+
+Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                                bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+Status MatMul<float>::GetPrePackedBuffers(int input_idx,
+                                          std::vector<gsl::span<const uint8_t>>& prepacked_buffers) const {
+  if (input_idx == 1 && packed_b_ && !packed_b_bf16_ && !packed_b_sparse_) {
+    prepacked_buffers.push_back(gsl::make_span(static_cast<const uint8_t*>(packed_b_.get()),
+                                               GemmPackBFp32Size(b_shape_, trans_b_attr_ != 0)));
+  }
+  return Status::OK();
+}
+
+Status MatMul<float>::UseSavedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                               const std::vector<gsl::span<const uint8_t>>& prepacked_buffers,
+                                               bool& used_saved_buffers) {
+  used_saved_buffers = false;
+
+  // the saved buffer is in the fp32 format, so let PrePack produce the bfloat16 one
+  if (input_idx == 1 && !use_fastmath_bf16_ && prepacked_buffers.size() == 1) {
+    used_saved_buffers = GemmUseSavedPackBFp32(Info(), tensor, trans_b_attr_ != 0, prepacked_buffers[0],
+                                               packed_b_, b_shape_);
   }
   return Status::OK();
 }
@@ -178,8 +249,14 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
     data[i].alpha = alpha_attr_;
     data[i].beta = 0.0f;
   }
-  MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
-      M, N, K, data.data(), max_len, thread_pool);
+  if (packed_b_sparse_) {
+    MlasSparseGemmBatch(trans_a ? CblasTrans : CblasNoTrans, M, N, K, data.data(), max_len, thread_pool);
+  } else if (packed_b_bf16_) {
+    MlasSBGemmBatch(trans_a ? CblasTrans : CblasNoTrans, M, N, K, data.data(), max_len, thread_pool);
+  } else {
+    MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
+        M, N, K, data.data(), max_len, thread_pool);
+  }
 
   return Status::OK();
 }
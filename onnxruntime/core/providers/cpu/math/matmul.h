@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -22,16 +23,38 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transA", &trans_a_attr_, 0);
     info.GetAttrOrDefault<int64_t>("transB", &trans_b_attr_, 0);
     info.GetAttrOrDefault<float>("alpha", &alpha_attr_, 1.0);
+    use_fastmath_bf16_ = GemmFastMathBf16Enabled(info);
+    sparse_b_config_ = GemmGetSparseBConfig(info);
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
 
+  Status TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   bool& used_shared_buffers) override;
+
+  Status GetPrePackedBuffers(int input_idx, std::vector<gsl::span<const uint8_t>>& prepacked_buffers) const override;
+
+  Status UseSavedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                  const std::vector<gsl::span<const uint8_t>>& prepacked_buffers,
+                                  bool& used_saved_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
 
+  // B is packed to bfloat16 for MlasSBGemmBatch if the session enables kOrtSessionOptionsConfigGemmFastMathBf16
+  bool use_fastmath_bf16_{false};
+  bool packed_b_bf16_{false};
+
+  // B is packed to the block sparse format of MlasSparseGemmBatch if enough of it is zero blocks,
+  // see kOrtSessionOptionsConfigGemmSparseMaxDensity
+  GemmSparseBConfig sparse_b_config_;
+  bool packed_b_sparse_{false};
+
   // For FusedMatMul contrib ops
   float alpha_attr_;
   int64_t trans_a_attr_;
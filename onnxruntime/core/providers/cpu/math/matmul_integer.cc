@@ -11,7 +11,11 @@ namespace onnxruntime {
 
 class MatMulInteger final : public MatMulIntegerBase {
  public:
-  MatMulInteger(const OpKernelInfo& info) : MatMulIntegerBase(info) {}
+  MatMulInteger(const OpKernelInfo& info) : MatMulIntegerBase(info) {
+    const auto* type_proto = info.node().InputDefs()[IN_A]->TypeAsProto();
+    a_is_signed_ = type_proto != nullptr &&
+                   type_proto->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_INT8;
+  }
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -40,6 +44,18 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     MatMulInteger);
 
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MatMulInteger,
+    kOnnxDomain,
+    10,
+    int8_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
+    MatMulInteger);
+
 Status MatMulInteger::Compute(OpKernelContext* ctx) const {
   MatMulComputeHelper helper;
   const auto* a = ctx->Input<Tensor>(IN_A);
@@ -71,26 +87,32 @@ Status MatMulInteger::Compute(OpKernelContext* ctx) const {
   // validate zero points
   uint8_t a_offset = 0;
   uint8_t b_offset = 0;
+  const uint8_t* b_offsets = &b_offset;
+  bool per_column_b_offsets = false;
   const auto* a_zero_point = ctx->Input<Tensor>(IN_A_ZERO_POINT);
   if (a_zero_point != nullptr) {
     ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point),
                 "MatmulInteger : input1 zero point must be a scalar or 1D tensor of size 1");
-    a_offset = *a_zero_point->template Data<uint8_t>();
+    a_offset = *static_cast<const uint8_t*>(a_zero_point->DataRaw());
   }
   const auto* b_zero_point = ctx->Input<Tensor>(IN_B_ZERO_POINT);
   if (b_zero_point != nullptr) {
-    ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point),
-                "MatmulInteger : input2 zero point must be a scalar or 1D tensor of size 1");
-    b_offset = *static_cast<const uint8_t*>(b_zero_point->DataRaw());
+    // per-column zero points hold one value for each column of B
+    per_column_b_offsets = !IsScalarOr1ElementVector(b_zero_point);
+    ORT_ENFORCE(!per_column_b_offsets ||
+                    (b_zero_point->Shape().NumDimensions() == 1 && b_zero_point->Shape()[0] == static_cast<int64_t>(helper.N())),
+                "MatmulInteger : input2 zero point must be a scalar or 1D tensor of size 1 or N");
+    b_offsets = static_cast<const uint8_t*>(b_zero_point->DataRaw());
   }
 
-  const auto* a_data = a->template Data<uint8_t>();
+  const auto* a_data = static_cast<const uint8_t*>(a->DataRaw());
   auto* y_data = y->template MutableData<int32_t>();
 
   MLAS_GEMM_U8X8_SHAPE_PARAMS gemm_shape;
   gemm_shape.M = static_cast<size_t>(helper.M());
   gemm_shape.N = static_cast<size_t>(helper.N());
   gemm_shape.K = static_cast<size_t>(helper.K());
+  gemm_shape.AIsSigned = a->IsDataType<int8_t>();
   gemm_shape.BIsSigned = b_is_signed;
 
   const size_t batch_size = helper.OutputOffsets().size();
@@ -101,7 +123,8 @@ Status MatMulInteger::Compute(OpKernelContext* ctx) const {
     gemm_params.lda = gemm_shape.K;
     gemm_params.ZeroPointA = a_offset;
     gemm_params.ldb = gemm_shape.N;
-    gemm_params.ZeroPointB = &b_offset;
+    gemm_params.ZeroPointB = b_offsets;
+    gemm_params.PerColumnZeroPoints = per_column_b_offsets;
     gemm_params.ldc = gemm_shape.N;
     gemm_params.BIsPacked = bool(packed_b_);
     gemm_params.A = a_data + helper.LeftOffsets()[batch];
@@ -29,7 +29,7 @@ class MatMulIntegerBase : public OpKernel {
       const auto* b_data = static_cast<const uint8_t*>(tensor.DataRaw());
       b_is_signed_ = tensor.IsDataType<int8_t>();
 
-      const size_t packed_b_size = MlasGemmPackBSize(N, K, b_is_signed_);
+      const size_t packed_b_size = MlasGemmPackBSize(N, K, a_is_signed_, b_is_signed_);
       if (packed_b_size == 0) {
         return Status::OK();
       }
@@ -37,7 +37,7 @@ class MatMulIntegerBase : public OpKernel {
       auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
       auto* packed_b_data = alloc->Alloc(packed_b_size);
       packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
-      MlasGemmPackB(N, K, b_data, N, b_is_signed_, packed_b_data);
+      MlasGemmPackB(N, K, b_data, N, a_is_signed_, b_is_signed_, packed_b_data);
       is_packed = true;
     }
     return Status::OK();
@@ -49,6 +49,9 @@ class MatMulIntegerBase : public OpKernel {
   */
   virtual int GetBIdx() = 0;
 
+  // The packed layout of matrix B depends on the signedness of matrix A, so
+  // derived kernels that accept int8 A must set this before prepacking.
+  bool a_is_signed_{false};
   bool b_is_signed_{true};
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/softmax.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/transpose.h"
 #include <vector>
 #include <numeric>
@@ -108,6 +110,75 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Softmax<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Softmax,
+    1,
+    10,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+// Opset 11 starts to support Neg Axis.
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Softmax,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+// Opset 13 changed the semantic meaning of the axis attribute.
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Softmax,
+    13,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    LogSoftmax,
+    1,
+    10,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+// Opset 11 starts to support Neg Axis.
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    LogSoftmax,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+// Opset 13 changed the semantic meaning of the axis attribute.
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    LogSoftmax,
+    13,
+    MLFloat16,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Softmax<MLFloat16>);
+
+namespace {
+
+// softmax over the middle dimension of an [N, D, Stride] tensor without transposing it.
+// returns false if there is no strided implementation for the type.
+template <typename T>
+bool SoftmaxStridedCPU(size_t /*N*/, size_t /*D*/, size_t /*stride*/, const T* /*X*/, T* /*Y*/, bool /*log_softmax*/,
+                       concurrency::ThreadPool* /*thread_pool*/) {
+  return false;
+}
+
+template <>
+bool SoftmaxStridedCPU<float>(size_t N, size_t D, size_t stride, const float* X, float* Y, bool log_softmax,
+                              concurrency::ThreadPool* thread_pool) {
+  MlasComputeSoftmaxStrided(X, Y, N, D, stride, log_softmax, thread_pool);
+  return true;
+}
+
+}  // namespace
+
 // opset-12 and below
 template <typename T>
 Status Softmax<T>::ComputeImpl(const Tensor& input, Tensor& output, size_t axis,
@@ -126,6 +197,15 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
   const auto& X_shape = input.Shape();
   size_t rank = X_shape.NumDimensions();
 
+  // Softmax along an outer axis reduces over columns that are `stride` elements apart, which the
+  // vectorized kernels handle directly without the transposes below.
+  if (axis != (rank - 1) &&
+      SoftmaxStridedCPU<T>(X_shape.SizeToDimension(axis), static_cast<size_t>(X_shape[axis]),
+                           X_shape.SizeFromDimension(axis + 1), input.template Data<T>(),
+                           output.template MutableData<T>(), log_softmax_, thread_pool)) {
+    return Status::OK();
+  }
+
   bool is_transpose_required = false;
   Tensor transposed_input;
   std::vector<int64_t> transposed_input_dims;
@@ -163,7 +243,7 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
     Tensor temp_input(input.DataType(), TensorShape(transposed_input_dims), alloc);
 
     // Perform the transpose
-    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(permutation, input, temp_input));
+    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(permutation, input, temp_input, nullptr, thread_pool));
     transposed_input = std::move(temp_input);
 
     // Allocate memory for the intermediate output
@@ -185,7 +265,8 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
       reverse_permutation[permutation[i]] = i;
     }
     // Perform the transpose to get the axes back to the original ordering
-    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(reverse_permutation, intermediate_output, output));
+    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(reverse_permutation, intermediate_output, output, nullptr,
+                                                   thread_pool));
   }
 
   return Status::OK();
@@ -214,4 +295,52 @@ Status Softmax<T>::Compute(OpKernelContext* ctx) const {
   }
 }
 
+// MLFloat16 is converted to float so that the vectorized float kernels compute the result
+template <>
+Status Softmax<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  const auto* X = ctx->Input<Tensor>(0);
+  const auto& X_shape = X->Shape();
+  size_t rank = X_shape.NumDimensions();
+  auto* Y = ctx->Output(0, X_shape);
+
+  // edge case. one or more dims with value of 0. nothing to do
+  if (X_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const size_t axis = static_cast<size_t>(HandleNegativeAxis(axis_, rank));
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(X_shape.Size());
+  auto buffer = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(count));
+  float* data = buffer.get();
+
+  const MLFloat16* X_data = X->Data<MLFloat16>();
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, count, TensorOpCost{static_cast<double>(sizeof(MLFloat16)), static_cast<double>(sizeof(float)), 1.0},
+      [X_data, data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        MlasConvertHalfToFloat(&X_data[first].val, data + first, static_cast<size_t>(last - first));
+      });
+
+  if (opset_ < 13) {
+    MlasComputeSoftmax(data, data, X_shape.SizeToDimension(axis), X_shape.SizeFromDimension(axis), log_softmax_,
+                       thread_pool);
+  } else {
+    MlasComputeSoftmaxStrided(data, data, X_shape.SizeToDimension(axis), static_cast<size_t>(X_shape[axis]),
+                              X_shape.SizeFromDimension(axis + 1), log_softmax_, thread_pool);
+  }
+
+  MLFloat16* Y_data = Y->MutableData<MLFloat16>();
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, count, TensorOpCost{static_cast<double>(sizeof(float)), static_cast<double>(sizeof(MLFloat16)), 1.0},
+      [data, Y_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        MlasConvertFloatToHalf(data + first, &Y_data[first].val, static_cast<size_t>(last - first));
+      });
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -48,4 +48,7 @@ class Softmax final : public OpKernel {
   bool log_softmax_;
 };
 
+template <>
+Status Softmax<MLFloat16>::Compute(OpKernelContext* ctx) const;
+
 }  // namespace onnxruntime
@@ -140,6 +140,137 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Selection of a small k over contiguous rows, e.g. sampling from the logits of a large vocabulary.
+// The running top k is kept as a sorted list, and the row is scanned in chunks against the current k-th value.
+// The count of values beating it in a chunk is branch free so the compiler can vectorize the scan, and only the
+// rare chunks with a hit are visited again to insert their values.
+static constexpr unsigned kSmallTopK = 16;
+static constexpr int64_t kSmallTopKChunk = 32;
+// rows shorter than this are not split across threads.
+static constexpr int64_t kSmallTopKMinSegment = 16 * 1024;
+
+// Inserts a value into the sorted list of the 'count' best values, dropping the last one if the list is full.
+// The index must be greater than the indices in the list, so an equal value goes after them.
+template <class Comparator>
+static inline void InsertSmallTopK(const Comparator& comparer, typename Comparator::DataType value, int64_t index,
+                                   unsigned count, unsigned k,
+                                   typename Comparator::DataType* top_values, int64_t* top_indices) {
+  unsigned l = std::min(count, k - 1);
+  for (; l > 0 && comparer.CompareValueOnly(value, top_values[l - 1]); --l) {
+    top_values[l] = top_values[l - 1];
+    top_indices[l] = top_indices[l - 1];
+  }
+  top_values[l] = value;
+  top_indices[l] = index;
+}
+
+// Selects the sorted top k of data[begin, end), which has at least k values.
+template <class Comparator>
+static void SelectSmallTopK(const Comparator& comparer, const typename Comparator::DataType* data,
+                            int64_t begin, int64_t end, unsigned k,
+                            typename Comparator::DataType* top_values, int64_t* top_indices) {
+  using T = typename Comparator::DataType;
+
+  int64_t l = begin;
+  for (unsigned count = 0; count < k; ++count, ++l) {
+    InsertSmallTopK(comparer, data[l], l, count, k, top_values, top_indices);
+  }
+
+  T threshold = top_values[k - 1];
+  for (; l + kSmallTopKChunk <= end; l += kSmallTopKChunk) {
+    const T* chunk = data + l;
+    int hits = 0;
+    for (int64_t c = 0; c < kSmallTopKChunk; ++c) {
+      hits += comparer.CompareValueOnly(chunk[c], threshold) ? 1 : 0;
+    }
+    if (hits == 0) {
+      continue;
+    }
+    for (int64_t c = 0; c < kSmallTopKChunk; ++c) {
+      if (comparer.CompareValueOnly(chunk[c], threshold)) {
+        InsertSmallTopK(comparer, chunk[c], l + c, k, k, top_values, top_indices);
+        threshold = top_values[k - 1];
+      }
+    }
+  }
+
+  for (; l < end; ++l) {
+    if (comparer.CompareValueOnly(data[l], threshold)) {
+      InsertSmallTopK(comparer, data[l], l, k, k, top_values, top_indices);
+      threshold = top_values[k - 1];
+    }
+  }
+}
+
+// Top k over the last axis for a small k. Rows are split into segments when there are fewer rows than threads,
+// and the sorted top k of the segments of a row are merged afterwards. The output is always sorted.
+template <class Comparator>
+static void FindSmallTopKElements(const typename Comparator::DataType* input_data, int64_t rows, int64_t cols,
+                                  const unsigned k, typename Comparator::DataType* values_data,
+                                  int64_t* indices_data, concurrency::ThreadPool* threadpool) {
+  using T = typename Comparator::DataType;
+  const Comparator comparer(input_data);
+
+  const int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+  int64_t segments = 1;
+  if (rows < tp_threads) {
+    segments = std::max(std::min((tp_threads + rows - 1) / rows, cols / kSmallTopKMinSegment),
+                        static_cast<int64_t>(1));
+  }
+  const int64_t segment_size = (cols + segments - 1) / segments;
+
+  if (segments == 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        threadpool, rows,
+        TensorOpCost{static_cast<double>(cols * sizeof(T)), static_cast<double>(k * (sizeof(T) + sizeof(int64_t))),
+                     static_cast<double>(cols)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const T* row = input_data + i * cols;
+            SelectSmallTopK(comparer, row, 0, cols, k, values_data + i * k, indices_data + i * k);
+          }
+        });
+    return;
+  }
+
+  // the last segment may be shorter, but always has at least k values as k <= kSmallTopK.
+  std::vector<T> partial_values(static_cast<size_t>(rows * segments * k));
+  std::vector<int64_t> partial_indices(static_cast<size_t>(rows * segments * k));
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, rows * segments,
+      TensorOpCost{static_cast<double>(segment_size * sizeof(T)),
+                   static_cast<double>(k * (sizeof(T) + sizeof(int64_t))), static_cast<double>(segment_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          const T* row = input_data + (n / segments) * cols;
+          const int64_t begin = (n % segments) * segment_size;
+          const int64_t end = std::min(begin + segment_size, cols);
+          SelectSmallTopK(comparer, row, begin, end, k, partial_values.data() + n * k,
+                          partial_indices.data() + n * k);
+        }
+      });
+
+  // segments are in index order, so on equal values the earlier segment wins.
+  std::vector<unsigned> heads(static_cast<size_t>(segments));
+  for (int64_t i = 0; i < rows; ++i) {
+    const T* row_values = partial_values.data() + i * segments * k;
+    const int64_t* row_indices = partial_indices.data() + i * segments * k;
+    std::fill(heads.begin(), heads.end(), 0u);
+    for (unsigned j = 0; j < k; ++j) {
+      int64_t best = -1;
+      for (int64_t s = 0; s < segments; ++s) {
+        if (heads[s] < k &&
+            (best < 0 || comparer.CompareValueOnly(row_values[s * k + heads[s]], row_values[best * k + heads[best]]))) {
+          best = s;
+        }
+      }
+      values_data[i * k + j] = row_values[best * k + heads[best]];
+      indices_data[i * k + j] = row_indices[best * k + heads[best]];
+      ++heads[best];
+    }
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -164,6 +295,11 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t num_blocks = input_shape[axis_parsed];
   const int64_t block_slice = reduced_cols / k;
 
+  if (block_slice == 1 && k <= kSmallTopK) {
+    FindSmallTopKElements<Comparator>(input_data, rows, cols, k, values_data, indices_data, threadpool);
+    return;
+  }
+
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
@@ -2,8 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/category_mapper.h"
-#include <algorithm>
-#include <gsl/gsl>
+#include "core/platform/threadpool.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -31,35 +30,37 @@ Status CategoryMapper::Compute(OpKernelContext* context) const {
     if (!Y.IsDataType<int64_t>())
       return Status(ONNXRUNTIME, FAIL, "Input of string must have output of int64");
 
-    auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
-    auto out = output.begin();
+    const std::string* input = X.template Data<std::string>();
+    int64_t* output = Y.template MutableData<int64_t>();
 
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
-    const auto map_end = string_to_int_map_.end();
-
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
-                  });
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), shape.Size(),
+        TensorOpCost{static_cast<double>(sizeof(std::string)), static_cast<double>(sizeof(int64_t)), 64.0},
+        [this, input, output](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const int64_t* map_to = string_to_int_map_.Find(input[i]);
+            output[i] = map_to == nullptr ? default_int_ : *map_to;
+          }
+        });
   } else {
     if (!Y.IsDataTypeString())
       return Status(ONNXRUNTIME, FAIL, "Input of int64 must have output of string ");
 
-    auto input = gsl::make_span(X.template Data<int64_t>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<std::string>(), shape.Size());
-    auto out = output.begin();
+    const int64_t* input = X.template Data<int64_t>();
+    std::string* output = Y.template MutableData<std::string>();
 
+    // map isn't going to change so get end() once instead of calling inside the loop
     const auto map_end = int_to_string_map_.end();
 
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const int64_t& value) {
-                    auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
-                    ++out;
-                  });
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), shape.Size(),
+        TensorOpCost{static_cast<double>(sizeof(int64_t)), static_cast<double>(sizeof(std::string)), 64.0},
+        [this, input, output, map_end](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            auto map_to = int_to_string_map_.find(input[i]);
+            output[i] = map_to == map_end ? default_string_ : map_to->second;
+          }
+        });
   }
 
   return Status::OK();
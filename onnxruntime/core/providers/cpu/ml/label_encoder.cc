@@ -2,8 +2,6 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/label_encoder.h"
-#include <algorithm>
-#include <gsl/gsl>
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -32,35 +30,34 @@ Status LabelEncoder::Compute(OpKernelContext* context) const {
     if (!Y.IsDataType<int64_t>())
       return Status(ONNXRUNTIME, FAIL, "Input of tensor(string) must have output of tensor(int64)");
 
-    auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
-    auto out = output.begin();
-
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
-    const auto map_end = string_to_int_map_.end();
-
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
-                  });
+    const std::string* input = X.template Data<std::string>();
+    int64_t* output = Y.template MutableData<int64_t>();
+
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), shape.Size(), LabelLookupCost<std::string, int64_t>(),
+        [this, input, output](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const int64_t* map_to = string_to_int_map_.Find(input[i]);
+            output[i] = map_to == nullptr ? default_int_ : *map_to;
+          }
+        });
   } else {
     if (!Y.IsDataTypeString())
       return Status(ONNXRUNTIME, FAIL, "Input of tensor(int64) must have output of tensor(string)");
 
-    auto input = gsl::make_span(X.template Data<int64_t>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<std::string>(), shape.Size());
-    auto out = output.begin();
-
-    const auto map_end = int_to_string_map_.end();
-
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const int64_t& value) {
-                    auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
-                    ++out;
-                  });
+    const int64_t* input = X.template Data<int64_t>();
+    std::string* output = Y.template MutableData<std::string>();
+
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), shape.Size(), LabelLookupCost<int64_t, std::string>(),
+        [this, input, output](std::ptrdiff_t first, std::ptrdiff_t last) {
+          const auto num_classes = static_cast<int64_t>(classes_.size());
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const int64_t value = input[i];
+            output[i] = value >= 0 && value < num_classes ? classes_[static_cast<size_t>(value)]
+                                                          : default_string_;
+          }
+        });
   }
 
   return Status::OK();
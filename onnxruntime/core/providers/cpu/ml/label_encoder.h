@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <numeric>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/ml/ml_common.h"
+#include "core/providers/cpu/ml/string_lookup_table.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -20,29 +24,45 @@ class LabelEncoder final : public OpKernel {
     ORT_ENFORCE(info.GetAttr<std::string>("default_string", &default_string_).IsOK());
     ORT_ENFORCE(info.GetAttr<int64_t>("default_int64", &default_int_).IsOK());
 
-    auto num_entries = string_classes.size();
-
-    string_to_int_map_.reserve(num_entries);
-    int_to_string_map_.reserve(num_entries);
+    std::vector<int64_t> indices(string_classes.size());
+    std::iota(indices.begin(), indices.end(), int64_t{0});
 
-    for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_classes[i];
+    string_to_int_map_ = StringLookupTable<int64_t>(string_classes, indices);
 
-      string_to_int_map_[str] = i;
-      int_to_string_map_[i] = str;
-    }
+    // the int64 -> string direction maps an index into classes_strings
+    classes_ = std::move(string_classes);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  StringLookupTable<int64_t> string_to_int_map_;
+  std::vector<std::string> classes_;
 
   std::string default_string_;
   int64_t default_int_;
 };
 
+// Rough per element cost of a lookup, used to decide how to split the input between threads.
+template <typename TKey, typename TValue>
+inline TensorOpCost LabelLookupCost() {
+  const bool string_key = std::is_same<TKey, std::string>::value;
+  const bool string_value = std::is_same<TValue, std::string>::value;
+  return TensorOpCost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)),
+                      string_key || string_value ? 64.0 : 16.0};
+}
+
+template <typename TKey, typename TValue>
+inline const TValue* FindLabel(const std::unordered_map<TKey, TValue>& map, const TKey& key) {
+  const auto found = map.find(key);
+  return found == map.end() ? nullptr : &found->second;
+}
+
+template <typename TValue>
+inline const TValue* FindLabel(const StringLookupTable<TValue>& map, const std::string& key) {
+  return map.Find(key);
+}
+
 template <typename TKey, typename TValue>
 class LabelEncoder_2 final : public OpKernel {
  public:
@@ -64,8 +84,7 @@ class LabelEncoder_2 final : public OpKernel {
                 "However, the number of key is ", num_keys, " and the number of ",
                 "values is ", num_values, ".");
 
-    for (size_t i = 0; i < num_keys; ++i)
-      _map[keys[i]] = values[i];
+    InitializeMap(keys, values);
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -75,16 +94,17 @@ class LabelEncoder_2 final : public OpKernel {
     const TensorShape& shape = X.Shape();
     Tensor& Y = *context->Output(0, shape);
 
-    auto input = X.template DataAsSpan<TKey>();
-    auto output = Y.template MutableDataAsSpan<TValue>();
+    const TKey* input = X.template Data<TKey>();
+    TValue* output = Y.template MutableData<TValue>();
 
-    for (int64_t i = 0; i < shape.Size(); ++i) {
-      const auto found = _map.find(input[i]);
-      if (found == _map.end())
-        output[i] = _default_value;
-      else
-        output[i] = found->second;
-    }
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), shape.Size(), LabelLookupCost<TKey, TValue>(),
+        [this, input, output](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const TValue* found = FindLabel(_map, input[i]);
+            output[i] = found == nullptr ? _default_value : *found;
+          }
+        });
 
     return Status::OK();
   }
@@ -95,10 +115,27 @@ class LabelEncoder_2 final : public OpKernel {
   // for other types can be found in ONNX spec.
   void InitializeSomeFields(const OpKernelInfo& info);
 
+  template <typename K = TKey>
+  typename std::enable_if<std::is_same<K, std::string>::value>::type
+  InitializeMap(const std::vector<K>& keys, const std::vector<TValue>& values) {
+    _map = StringLookupTable<TValue>(keys, values);
+  }
+
+  template <typename K = TKey>
+  typename std::enable_if<!std::is_same<K, std::string>::value>::type
+  InitializeMap(const std::vector<K>& keys, const std::vector<TValue>& values) {
+    _map.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+      _map[keys[i]] = values[i];
+  }
+
   // A collection of key-value pairs. Each (a_key, a_value) pair
   // means that the "a_key" in the input would be mapped to "a_value".
   // If _map doesn't contain "a_key", we use _default_value as its output.
-  std::unordered_map<TKey, TValue> _map;
+  // String keys are stored in a flat lookup table since vocabularies can be very large.
+  typename std::conditional<std::is_same<TKey, std::string>::value,
+                            StringLookupTable<TValue>,
+                            std::unordered_map<TKey, TValue>>::type _map;
   TValue _default_value;
   // ONNX attribute name to load keys.
   std::string _key_field_name;
@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "gsl/gsl"
+
+namespace onnxruntime {
+namespace ml {
+
+// Immutable string -> value map used by the ML kernels with large vocabularies.
+//
+// The keys are copied into one contiguous arena and indexed by a power-of-two open addressing table with
+// linear probing. Each slot holds the entry index and the upper bits of the hash, so a probe only touches the
+// arena when the tags match. Compared to std::unordered_map<std::string, TValue> this avoids one allocation per
+// key and keeps a lookup to a couple of cache lines, which matters for vocabularies with millions of entries.
+//
+// The table is built once by the constructor and is safe to query from multiple threads.
+template <typename TValue>
+class StringLookupTable {
+ public:
+  StringLookupTable() = default;
+
+  // Duplicate keys keep the last value, matching repeated assignment into a std::unordered_map.
+  StringLookupTable(gsl::span<const std::string> keys, gsl::span<const TValue> values) {
+    ORT_ENFORCE(keys.size() == values.size(), "Number of keys (", keys.size(),
+                ") does not match the number of values (", values.size(), ").");
+    ORT_ENFORCE(keys.size() < std::numeric_limits<uint32_t>::max(), "Too many keys: ", keys.size());
+
+    // keep the load factor at or below 3/4
+    size_t capacity = 16;
+    while (capacity * 3 < keys.size() * 4) {
+      capacity *= 2;
+    }
+    slots_.resize(capacity);
+    mask_ = capacity - 1;
+
+    size_t arena_size = 0;
+    for (const auto& key : keys) {
+      arena_size += key.size();
+    }
+    arena_.reserve(arena_size);
+    offsets_.reserve(keys.size() + 1);
+    offsets_.push_back(0);
+    values_.reserve(keys.size());
+
+    for (size_t i = 0, end = keys.size(); i < end; ++i) {
+      const std::string& key = keys[i];
+      const uint64_t hash = Hash(key);
+      const uint32_t tag = Tag(hash);
+
+      for (size_t pos = static_cast<size_t>(hash) & mask_;; pos = (pos + 1) & mask_) {
+        Slot& slot = slots_[pos];
+        if (slot.index == 0) {
+          arena_.append(key);
+          offsets_.push_back(arena_.size());
+          values_.push_back(values[i]);
+          slot.index = static_cast<uint32_t>(values_.size());
+          slot.tag = tag;
+          break;
+        }
+
+        if (slot.tag == tag && KeyEquals(slot.index - 1, key)) {
+          values_[slot.index - 1] = values[i];
+          break;
+        }
+      }
+    }
+
+    // duplicates leave unused capacity behind
+    arena_.shrink_to_fit();
+    offsets_.shrink_to_fit();
+    values_.shrink_to_fit();
+  }
+
+  // Returns the value for key, or nullptr if the key is not in the table.
+  const TValue* Find(const std::string& key) const {
+    if (values_.empty()) {
+      return nullptr;
+    }
+
+    const uint64_t hash = Hash(key);
+    const uint32_t tag = Tag(hash);
+
+    for (size_t pos = static_cast<size_t>(hash) & mask_;; pos = (pos + 1) & mask_) {
+      const Slot& slot = slots_[pos];
+      if (slot.index == 0) {
+        return nullptr;
+      }
+
+      if (slot.tag == tag && KeyEquals(slot.index - 1, key)) {
+        return &values_[slot.index - 1];
+      }
+    }
+  }
+
+  size_t Size() const { return values_.size(); }
+
+ private:
+  struct Slot {
+    uint32_t index = 0;  // entry index + 1, 0 for an empty slot
+    uint32_t tag = 0;
+  };
+
+  static uint64_t Hash(const std::string& key) {
+    return static_cast<uint64_t>(std::hash<std::string>{}(key));
+  }
+
+  // size_t may be 32 bits, so fold the hash instead of relying on the upper half alone
+  static uint32_t Tag(uint64_t hash) {
+    return static_cast<uint32_t>((hash >> 32) ^ (hash >> 7));
+  }
+
+  bool KeyEquals(size_t entry, const std::string& key) const {
+    const size_t begin = offsets_[entry];
+    const size_t length = offsets_[entry + 1] - begin;
+    return length == key.size() && std::memcmp(arena_.data() + begin, key.data(), length) == 0;
+  }
+
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+
+  // key i is arena_[offsets_[i], offsets_[i + 1])
+  std::string arena_;
+  std::vector<size_t> offsets_;
+  std::vector<TValue> values_;
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -150,6 +150,9 @@ Status SVMClassifier::Compute(OpKernelContext* ctx) const {
   return status;
 }
 
+// Number of batches (rows of X) scored together against the support vectors.
+static constexpr int64_t kBatchesPerBlock = 64;
+
 Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
                                   gsl::span<const float> x_data, const TensorShape& x_shape) const {
   concurrency::ThreadPool* threadpool = ctx.GetOperatorThreadPool();
@@ -183,16 +186,6 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
 
   auto final_scores = Z.MutableDataAsSpan<float>();
 
-  std::vector<float> kernels_data;
-  std::vector<int64_t> votes_data;
-
-  std::vector<float> classifier_scores_data;
-  std::vector<float> probsp2_data;
-
-  if (mode_ == SVM_TYPE::SVM_SVC && have_proba) {
-    probsp2_data.resize(num_batches * class_count_squared, 0.f);
-  }
-
   int write_additional_scores = -1;
   int64_t num_scores_per_batch = class_count_;
 
@@ -203,180 +196,190 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     }
   }
 
-  if (mode_ == SVM_TYPE::SVM_LINEAR) {
-    // scores_data.resize(num_batches * class_count_);
-    // auto out = gsl::make_span<float>(scores_data.data(), scores_data.size());
-
-    // combine the coefficients with the input data and apply the kernel type
-    batched_kernel_dot<float>(x_data, coefficients_, num_batches, class_count_, feature_count_, rho_[0], final_scores,
-                              threadpool);
-
-  } else {
-    gsl::span<float> classifier_scores;
-
-    // if we have one classifier, are writing directly to the final buffer,
-    // and will add an additional score in the results, leave a space between each classifier score so that
-    // we can parallelize the batch processing below.
-    int64_t num_slots_per_iteration = write_additional_scores >= 0 ? 2 : num_classifiers;
-
-    if (have_proba) {
-      // we will write num_batches * num_classifiers scores first, and transform those to num_batches * class_count_,
-      // so need to use a separate buffer for the first scoring.
-      classifier_scores_data.resize(num_batches * num_classifiers);
-      classifier_scores = gsl::make_span<float>(classifier_scores_data.data(), classifier_scores_data.size());
+  // if we have one classifier, are writing directly to the final buffer,
+  // and will add an additional score in the results, leave a space between each classifier score so that
+  // the final scores of each batch can be updated in place.
+  const int64_t num_slots_per_iteration = write_additional_scores >= 0 ? 2 : num_classifiers;
+
+  // The batches are processed in blocks. The kernels of a block against all the support vectors come from one GEMM,
+  // and are reduced to the classifier scores and finalized while they are still in cache. This also limits the
+  // kernels buffer to kBatchesPerBlock x vector_count_ instead of num_batches x vector_count_.
+  const int64_t num_blocks = (num_batches + kBatchesPerBlock - 1) / kBatchesPerBlock;
+
+  // with fewer blocks than threads, parallelize the GEMM of each block instead
+  const bool parallelize_blocks = num_blocks >= concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+  concurrency::ThreadPool* gemm_threadpool = parallelize_blocks ? nullptr : threadpool;
+
+  auto process_block = [&](std::ptrdiff_t block) {
+    const int64_t first_batch = block * kBatchesPerBlock;
+    const int64_t block_size = std::min<int64_t>(kBatchesPerBlock, num_batches - first_batch);
+    auto block_x = x_data.subspan(first_batch * feature_count_, block_size * feature_count_);
+
+    std::vector<float> classifier_scores_data;
+    std::vector<int64_t> votes_data;
+    std::vector<float> probsp2_data;
+
+    if (mode_ == SVM_TYPE::SVM_LINEAR) {
+      // combine the coefficients with the input data and apply the kernel type
+      batched_kernel_dot<float>(block_x, coefficients_, block_size, class_count_, feature_count_, rho_[0],
+                                final_scores.subspan(first_batch * class_count_, block_size * class_count_),
+                                gemm_threadpool);
     } else {
-      // we will write directly to the final scores buffer
-      // num_scores_per_batch = num_classifiers;
-      // assert(num_scores_per_batch == final_scores_per_batch);
-      classifier_scores = final_scores;
-    }
+      gsl::span<float> classifier_scores;
+
+      if (have_proba) {
+        // we will write block_size * num_classifiers scores first, and transform those to
+        // block_size * class_count_, so need to use a separate buffer for the first scoring.
+        classifier_scores_data.resize(block_size * num_classifiers);
+        classifier_scores = gsl::make_span<float>(classifier_scores_data.data(), classifier_scores_data.size());
+        probsp2_data.resize(class_count_squared, 0.f);
+      } else {
+        // we will write directly to the final scores buffer
+        classifier_scores = final_scores.subspan(first_batch * num_slots_per_iteration,
+                                                 block_size * num_slots_per_iteration);
+      }
 
-    kernels_data.resize(num_batches * vector_count_);
-    votes_data.resize(num_batches * class_count_, 0);
-
-    auto kernels_span = gsl::make_span<float>(kernels_data.data(), kernels_data.size());
-    auto votes_span = gsl::make_span<int64_t>(votes_data.data(), votes_data.size());
-
-    // combine the input data with the support vectors and apply the kernel type
-    // output is {num_batches, vector_count_}
-    batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
-                              threadpool);
-
-    for (int64_t n = 0; n < num_batches; n++) {
-      // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
-      // per class.
-      // coefficients: [num_classes - 1, vector_count_]
-      //
-      // e.g. say you have 3 classes, with 3 x 3 coefficients
-      //
-      // AA AB AC
-      // BA BB BC
-      // CA CB CC
-      //
-      // you can remove the diagonal line of items comparing a class with itself leaving one less row.
-      //
-      // BA AB AC
-      // CA CB BC
-      //
-      // for each class there is a coefficient per support vector, and a class has one or more support vectors.
-      //
-      // Combine the scores for the two combinations for two classes with their coefficient.
-      // e.g. AB combines with BA.
-      // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
-
-      auto cur_kernels = kernels_span.subspan(n * vector_count_, vector_count_);
-      auto cur_scores = classifier_scores.subspan(n * num_slots_per_iteration, num_classifiers);
-      auto cur_votes = votes_span.subspan(n * class_count_, class_count_);
-      auto scores_iter = cur_scores.begin();
-
-      int64_t classifier_idx = 0;
-      for (int64_t i = 0; i < class_count_ - 1; i++) {
-        int64_t start_index_i = starting_vector_[i];  // start of support vectors for class i
-        int64_t class_i_support_count = vectors_per_class_[i];
-        int64_t i_coeff_row_offset = vector_count_ * i;
-
-        for (int64_t j = i + 1; j < class_count_; j++) {
-          int64_t start_index_j = starting_vector_[j];  // start of support vectors for class j
-          int64_t class_j_support_count = vectors_per_class_[j];
-          int64_t j_coeff_row_offset = vector_count_ * (j - 1);
-
-          double sum = 0;
-
-          const float* val1 = &(coefficients_[j_coeff_row_offset + start_index_i]);
-          const float* val2 = &(cur_kernels[start_index_i]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[i_coeff_row_offset + start_index_j]);
-          val2 = &(cur_kernels[start_index_j]);
-
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          sum += rho_[classifier_idx++];
-
-          *scores_iter++ = static_cast<float>(sum);
-          ++(cur_votes[sum > 0 ? i : j]);
+      std::vector<float> kernels_data(block_size * vector_count_);
+      votes_data.resize(block_size * class_count_, 0);
+
+      auto kernels_span = gsl::make_span<float>(kernels_data.data(), kernels_data.size());
+      auto votes_span = gsl::make_span<int64_t>(votes_data.data(), votes_data.size());
+
+      // combine the input data with the support vectors and apply the kernel type
+      // output is {block_size, vector_count_}
+      batched_kernel_dot<float>(block_x, support_vectors_, block_size, vector_count_, feature_count_, 0.f,
+                                kernels_span, gemm_threadpool);
+
+      for (int64_t n = 0; n < block_size; n++) {
+        // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
+        // per class.
+        // coefficients: [num_classes - 1, vector_count_]
+        //
+        // e.g. say you have 3 classes, with 3 x 3 coefficients
+        //
+        // AA AB AC
+        // BA BB BC
+        // CA CB CC
+        //
+        // you can remove the diagonal line of items comparing a class with itself leaving one less row.
+        //
+        // BA AB AC
+        // CA CB BC
+        //
+        // for each class there is a coefficient per support vector, and a class has one or more support vectors.
+        //
+        // Combine the scores for the two combinations for two classes with their coefficient.
+        // e.g. AB combines with BA.
+        // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
+
+        auto cur_kernels = kernels_span.subspan(n * vector_count_, vector_count_);
+        auto cur_scores = classifier_scores.subspan(n * num_slots_per_iteration, num_classifiers);
+        auto cur_votes = votes_span.subspan(n * class_count_, class_count_);
+        auto scores_iter = cur_scores.begin();
+
+        int64_t classifier_idx = 0;
+        for (int64_t i = 0; i < class_count_ - 1; i++) {
+          int64_t start_index_i = starting_vector_[i];  // start of support vectors for class i
+          int64_t class_i_support_count = vectors_per_class_[i];
+          int64_t i_coeff_row_offset = vector_count_ * i;
+
+          for (int64_t j = i + 1; j < class_count_; j++) {
+            int64_t start_index_j = starting_vector_[j];  // start of support vectors for class j
+            int64_t class_j_support_count = vectors_per_class_[j];
+            int64_t j_coeff_row_offset = vector_count_ * (j - 1);
+
+            double sum = 0;
+
+            const float* val1 = &(coefficients_[j_coeff_row_offset + start_index_i]);
+            const float* val2 = &(cur_kernels[start_index_i]);
+            for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
+              sum += *val1 * *val2;
+
+            val1 = &(coefficients_[i_coeff_row_offset + start_index_j]);
+            val2 = &(cur_kernels[start_index_j]);
+
+            for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
+              sum += *val1 * *val2;
+
+            sum += rho_[classifier_idx++];
+
+            *scores_iter++ = static_cast<float>(sum);
+            ++(cur_votes[sum > 0 ? i : j]);
+          }
         }
       }
     }
-  }
 
-  auto finalize_batch = [this, &final_scores, final_scores_per_batch,
-                         have_proba, &probsp2_data, class_count_squared,
-                         &classifier_scores_data, num_classifiers, &votes_data, &Y,
-                         num_scores_per_batch, write_additional_scores](ptrdiff_t idx) {
-    int n = SafeInt<int32_t>(idx);  // convert to a usable sized type
-    auto cur_scores = final_scores.subspan(n * final_scores_per_batch, final_scores_per_batch);
-
-    if (mode_ == SVM_TYPE::SVM_SVC && have_proba) {
-      auto probsp2 = gsl::make_span<float>(probsp2_data.data() + (n * class_count_squared), class_count_squared);
-
-      float* classifier_scores = classifier_scores_data.data() + (n * num_classifiers);
-
-      int64_t index = 0;
-      for (int64_t i = 0; i < class_count_ - 1; ++i) {
-        int64_t p1 = i * class_count_ + i + 1;
-        int64_t p2 = (i + 1) * class_count_ + i;
-        for (int64_t j = i + 1; j < class_count_; ++j, ++index) {
-          float val1 = sigmoid_probability(classifier_scores[index], proba_[index], probb_[index]);
-          float val2 = std::max(val1, 1.0e-7f);
-          val2 = std::min(val2, 1 - 1.0e-7f);
-          probsp2[p1] = val2;
-          probsp2[p2] = 1 - val2;
-          ++p1;
-          p2 += class_count_;
+    for (int64_t block_n = 0; block_n < block_size; ++block_n) {
+      int n = SafeInt<int32_t>(first_batch + block_n);
+      auto cur_scores = final_scores.subspan(n * final_scores_per_batch, final_scores_per_batch);
+
+      if (mode_ == SVM_TYPE::SVM_SVC && have_proba) {
+        auto probsp2 = gsl::make_span<float>(probsp2_data.data(), class_count_squared);
+
+        float* classifier_scores = classifier_scores_data.data() + (block_n * num_classifiers);
+
+        // Platt scaling of the classifier scores
+        int64_t index = 0;
+        for (int64_t i = 0; i < class_count_ - 1; ++i) {
+          int64_t p1 = i * class_count_ + i + 1;
+          int64_t p2 = (i + 1) * class_count_ + i;
+          for (int64_t j = i + 1; j < class_count_; ++j, ++index) {
+            float val1 = sigmoid_probability(classifier_scores[index], proba_[index], probb_[index]);
+            float val2 = std::max(val1, 1.0e-7f);
+            val2 = std::min(val2, 1 - 1.0e-7f);
+            probsp2[p1] = val2;
+            probsp2[p2] = 1 - val2;
+            ++p1;
+            p2 += class_count_;
+          }
         }
-      }
 
-      // expand scores from num_classifiers to class_count_
-      multiclass_probability(class_count_, probsp2, cur_scores);
-    }
-
-    float max_weight = 0;
-    int64_t maxclass = -1;
-    if (votes_data.size() > 0) {
-      auto votes = gsl::make_span<int64_t>(votes_data.data() + (n * class_count_), class_count_);
-      auto it_maxvotes = std::max_element(votes.cbegin(), votes.cend());
-      maxclass = std::distance(votes.cbegin(), it_maxvotes);
-    } else {
-      auto it_max_weight = std::max_element(cur_scores.cbegin(), cur_scores.cend());
-      maxclass = std::distance(cur_scores.cbegin(), it_max_weight);
-      max_weight = *it_max_weight;
-    }
+        // expand scores from num_classifiers to class_count_
+        multiclass_probability(class_count_, probsp2, cur_scores);
+      }
 
-    // write top class
-    // onnx specs expects one column per class.
-    if (num_classifiers == 1) {  // binary case
-      if (using_strings_) {
-        ChooseClass<std::string>(Y, n, max_weight, maxclass, have_proba, weights_are_all_positive_,
-                                 classlabels_strings_, "1", "0");
+      float max_weight = 0;
+      int64_t maxclass = -1;
+      if (votes_data.size() > 0) {
+        auto votes = gsl::make_span<int64_t>(votes_data.data() + (block_n * class_count_), class_count_);
+        auto it_maxvotes = std::max_element(votes.cbegin(), votes.cend());
+        maxclass = std::distance(votes.cbegin(), it_maxvotes);
       } else {
-        ChooseClass<int64_t>(Y, n, max_weight, maxclass, have_proba, weights_are_all_positive_,
-                             classlabels_ints_, 1, 0);
+        auto it_max_weight = std::max_element(cur_scores.cbegin(), cur_scores.cend());
+        maxclass = std::distance(cur_scores.cbegin(), it_max_weight);
+        max_weight = *it_max_weight;
       }
-    } else {  //multiclass
-      if (using_strings_) {
-        Y.template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
-      } else {
-        Y.template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+
+      // write top class
+      // onnx specs expects one column per class.
+      if (num_classifiers == 1) {  // binary case
+        if (using_strings_) {
+          ChooseClass<std::string>(Y, n, max_weight, maxclass, have_proba, weights_are_all_positive_,
+                                   classlabels_strings_, "1", "0");
+        } else {
+          ChooseClass<int64_t>(Y, n, max_weight, maxclass, have_proba, weights_are_all_positive_,
+                               classlabels_ints_, 1, 0);
+        }
+      } else {  //multiclass
+        if (using_strings_) {
+          Y.template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
+        } else {
+          Y.template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+        }
       }
-    }
 
-    // write the score for this batch
-    // as we parallelize the batch processing we want to update the final scores for each batch in the separate threads
-    batched_update_scores_inplace<float>(cur_scores, 1, num_scores_per_batch, post_transform_,
-                                         write_additional_scores, true, nullptr);
+      // write the score for this batch
+      batched_update_scores_inplace<float>(cur_scores, 1, num_scores_per_batch, post_transform_,
+                                           write_additional_scores, true, nullptr);
+    }
   };
 
-  // TODO: Refine this rough metric to choose when to parallelize.
-  if (num_batches > 512) {
-    concurrency::ThreadPool::TryBatchParallelFor(threadpool, num_batches, finalize_batch, -1);
+  if (parallelize_blocks) {
+    concurrency::ThreadPool::TrySimpleParallelFor(threadpool, num_blocks, process_block);
   } else {
-    {
-      for (ptrdiff_t i = 0; i < num_batches; ++i) {
-        finalize_batch(i);
-      }
+    for (std::ptrdiff_t block = 0; block < num_blocks; ++block) {
+      process_block(block);
     }
   }
 
@@ -39,28 +39,26 @@ class SVMCommon {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
-
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
-
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
+      // |x - s|^2 = |x|^2 + |s|^2 - 2 x.s, with the dot products of all the pairs from a single GEMM
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        2.f, a.data(), b.data(), 0.f,
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
 
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
-          }
+      const Eigen::Array<T, Eigen::Dynamic, 1> support_vector_norms =
+          ConstEigenMatrixMapRowMajor<T>(b.data(), n, k).rowwise().squaredNorm().array();
 
-          *cur_out++ = std::exp(-gamma_ * sum);
-        }
+      for (int64_t batch = 0; batch < m; ++batch) {
+        const T input_norm = ConstEigenVectorMap<T>(a.data() + batch * k, k).squaredNorm();
+        auto cur_out = EigenVectorArrayMap<T>(out.data() + batch * n, n);
 
-        cur_batch += k;  // move to start of next batch
+        // rounding can leave a small negative distance for nearly identical vectors
+        cur_out = (cur_out - input_norm - support_vector_norms).min(T(0)) * gamma_;
       }
+
+      MlasComputeExp(out.data(), out.data(), out.size());
     } else {
       float alpha = 1.f;
       float beta = 1.f;
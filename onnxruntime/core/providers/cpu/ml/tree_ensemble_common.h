@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <limits>
 #include "tree_ensemble_aggregator.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
@@ -11,6 +12,11 @@ namespace onnxruntime {
 namespace ml {
 namespace detail {
 
+// number of rows going through a tree together in the batched traversal
+constexpr int64_t kTreeRowBlockSize = 16;
+// size of the rows fitting in cache when all the rows are evaluated by a tree before moving to the next tree
+constexpr int64_t kTreeRowCacheBytes = 256 * 1024;
+
 template <typename ITYPE, typename OTYPE>
 class TreeEnsembleCommon {
  public:
@@ -31,6 +37,20 @@ class TreeEnsembleCommon {
   int parallel_tree_;  // starts parallelizing the computing if n_tree >= parallel_tree_ and n_rows == 1
   int parallel_N_;     // starts parallelizing the computing if n_rows >= parallel_N_
 
+  // Breadth-first copy of the trees used to evaluate a block of rows at once.
+  // It is only built when all the nodes use the same mode, and is empty otherwise.
+  struct CompactTreeNode {
+    OTYPE value;
+    uint32_t feature_id;
+    uint32_t children[2];  // true and false children, a leaf points to itself
+    bool is_missing_track_true;
+  };
+  std::vector<CompactTreeNode> compact_nodes_;
+  std::vector<uint32_t> compact_roots_;
+  std::vector<int32_t> compact_depths_;
+  std::vector<const TreeNodeElement<OTYPE>*> compact_leaves_;  // original leaf of every compact node, null for a branch
+  NODE_MODE compact_mode_;
+
  public:
   TreeEnsembleCommon(int parallel_tree,
                      int parallel_N,
@@ -58,6 +78,23 @@ class TreeEnsembleCommon {
   TreeNodeElement<OTYPE>* ProcessTreeNodeLeave(
       TreeNodeElement<OTYPE>* root, const ITYPE* x_data) const;
 
+  void CompileTrees();
+
+  // Finds the leaves of tree j for the n_rows rows starting at x_data.
+  void ProcessTreeNodeLeaves(size_t j, const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                             const TreeNodeElement<OTYPE>** leaves) const;
+
+  template <NODE_MODE mode, bool has_missing_tracks>
+  void ProcessTreeNodeLeavesBlocked(size_t j, const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                                    const TreeNodeElement<OTYPE>** leaves) const;
+
+  // Number of rows evaluated by each tree before moving to the next tree.
+  int64_t GetRowChunkSize(int64_t N, int64_t stride) const;
+
+  // Rough cost of evaluating a block of kTreeRowBlockSize rows with all the trees. The paths taken through the
+  // trees vary with the rows, so the loops over row blocks use guided scheduling to balance the uneven blocks.
+  TensorOpCost GetRowBlockCost(int64_t stride) const;
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const;
 };
@@ -213,6 +250,97 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
       break;
     }
   }
+
+  CompileTrees();
+}
+
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::CompileTrees() {
+  compact_nodes_.clear();
+  compact_roots_.clear();
+  compact_depths_.clear();
+  compact_leaves_.clear();
+  compact_mode_ = NODE_MODE::LEAF;
+  if (!same_mode_) {
+    return;
+  }
+
+  // nodes shared by several parents are copied, give up if it makes the trees much larger
+  const size_t max_compact_nodes = std::min<size_t>(4 * static_cast<size_t>(n_nodes_) + 1,
+                                                    std::numeric_limits<uint32_t>::max());
+  std::vector<const TreeNodeElement<OTYPE>*> sources;
+  std::vector<int32_t> depths;
+  compact_nodes_.reserve(n_nodes_);
+  compact_roots_.reserve(roots_.size());
+  compact_depths_.reserve(roots_.size());
+
+  for (const auto* root : roots_) {
+    const auto base = static_cast<uint32_t>(compact_nodes_.size());
+    int32_t tree_depth = 0;
+    sources.assign(1, root);
+    depths.assign(1, 0);
+
+    // breadth-first order, the true child of a node is immediately followed by its false child
+    for (size_t k = 0; k < sources.size(); ++k) {
+      const auto* node = sources[k];
+      const auto index = base + static_cast<uint32_t>(k);
+      CompactTreeNode compact;
+      if (node->is_not_leaf) {
+        if (node->truenode == nullptr || node->falsenode == nullptr ||
+            base + sources.size() + 2 > max_compact_nodes || depths[k] >= max_tree_depth_) {
+          compact_nodes_.clear();
+          compact_roots_.clear();
+          compact_depths_.clear();
+          compact_leaves_.clear();
+          return;
+        }
+        compact.value = node->value;
+        compact.feature_id = static_cast<uint32_t>(node->feature_id);
+        compact.children[0] = base + static_cast<uint32_t>(sources.size());
+        compact.children[1] = compact.children[0] + 1;
+        compact.is_missing_track_true = node->is_missing_track_true;
+        compact_mode_ = node->mode;
+        sources.push_back(node->truenode);
+        sources.push_back(node->falsenode);
+        depths.push_back(depths[k] + 1);
+        depths.push_back(depths[k] + 1);
+        compact_leaves_.push_back(nullptr);
+      } else {
+        // rows reaching a leaf before the last level of the tree stay on it
+        compact.value = 0;
+        compact.feature_id = 0;
+        compact.children[0] = index;
+        compact.children[1] = index;
+        compact.is_missing_track_true = false;
+        compact_leaves_.push_back(node);
+        tree_depth = std::max(tree_depth, depths[k]);
+      }
+      compact_nodes_.push_back(compact);
+    }
+
+    compact_roots_.push_back(base);
+    compact_depths_.push_back(tree_depth);
+  }
+}
+
+template <typename ITYPE, typename OTYPE>
+int64_t TreeEnsembleCommon<ITYPE, OTYPE>::GetRowChunkSize(int64_t N, int64_t stride) const {
+  // tree-major: every tree goes through all the rows while the rows stay in cache.
+  // Otherwise the rows are split in chunks so that a chunk stays in cache while going through all the trees.
+  const int64_t row_bytes = std::max<int64_t>(1, stride * static_cast<int64_t>(sizeof(ITYPE)));
+  if (N * row_bytes <= kTreeRowCacheBytes) {
+    return N;
+  }
+  const int64_t chunk = std::max<int64_t>(kTreeRowBlockSize, kTreeRowCacheBytes / row_bytes);
+  return chunk - chunk % kTreeRowBlockSize;
+}
+
+template <typename ITYPE, typename OTYPE>
+TensorOpCost TreeEnsembleCommon<ITYPE, OTYPE>::GetRowBlockCost(int64_t stride) const {
+  return TensorOpCost{static_cast<double>(kTreeRowBlockSize * stride * static_cast<int64_t>(sizeof(ITYPE))),
+                      static_cast<double>(kTreeRowBlockSize * n_targets_or_classes_ *
+                                          static_cast<int64_t>(sizeof(OTYPE))),
+                      static_cast<double>(kTreeRowBlockSize * n_trees_) * 64.0};
 }
 
 template <typename ITYPE, typename OTYPE>
@@ -287,32 +415,45 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
       }
       agg.FinalizeScores1(z_data, score, label_data);
     } else if (N <= parallel_N_) { /* section C: 1 output, 2+ rows but not enough rows to parallelize */
-      ScoreValue<OTYPE> score;
+      ScoreValue<OTYPE> scores[kTreeRowBlockSize];
+      const TreeNodeElement<OTYPE>* leaves[kTreeRowBlockSize];
       size_t j;
 
-      for (int64_t i = 0; i < N; ++i) {
-        score = {0, 0};
+      for (int64_t begin = 0; begin < N; begin += kTreeRowBlockSize) {
+        const int64_t n_rows = std::min(kTreeRowBlockSize, N - begin);
+        std::fill(scores, scores + n_rows, ScoreValue<OTYPE>({0, 0}));
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+          ProcessTreeNodeLeaves(j, x_data + begin * stride, stride, n_rows, leaves);
+          for (int64_t r = 0; r < n_rows; ++r) {
+            agg.ProcessTreeNodePrediction1(scores[r], *leaves[r]);
+          }
         }
 
-        agg.FinalizeScores1(z_data + i, score,
-                            label_data == nullptr ? nullptr : (label_data + i));
+        for (int64_t r = 0; r < n_rows; ++r) {
+          agg.FinalizeScores1(z_data + begin + r, scores[r],
+                              label_data == nullptr ? nullptr : (label_data + begin + r));
+        }
       }
     } else if (n_trees_ > max_num_threads) { /* section D: 1 output, 2+ rows and enough trees to parallelize */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
       std::vector<ScoreValue<OTYPE>> scores(num_threads * N);
+      const int64_t chunk_size = GetRowChunkSize(N, stride);
       concurrency::ThreadPool::TrySimpleParallelFor(
           ttp,
           num_threads,
-          [this, &agg, &scores, num_threads, x_data, N, stride](ptrdiff_t batch_num) {
+          [this, &agg, &scores, num_threads, x_data, N, stride, chunk_size](ptrdiff_t batch_num) {
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, this->n_trees_);
+            std::vector<const TreeNodeElement<OTYPE>*> leaves(chunk_size);
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * N + i] = {0, 0};
             }
-            for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction1(scores[batch_num * N + i], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            for (int64_t begin = 0; begin < N; begin += chunk_size) {
+              const int64_t n_rows = std::min(chunk_size, N - begin);
+              for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + begin * stride, stride, n_rows, leaves.data());
+                for (int64_t i = 0; i < n_rows; ++i) {
+                  agg.ProcessTreeNodePrediction1(scores[batch_num * N + begin + i], *leaves[i]);
+                }
               }
             }
           });
@@ -330,20 +471,32 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
                                   label_data == nullptr ? nullptr : (label_data + i));
             }
           });
-    } else { /* section E: 1 output, 2+ rows, parallelization by rows */
-      concurrency::ThreadPool::TryBatchParallelFor(
+    } else { /* section E: 1 output, 2+ rows, parallelization by blocks of rows */
+      concurrency::ThreadPool::TryParallelFor(
           ttp,
-          SafeInt<int32_t>(N),
-          [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
-            ScoreValue<OTYPE> score = {0, 0};
-            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-            }
+          SafeInt<std::ptrdiff_t>((N + kTreeRowBlockSize - 1) / kTreeRowBlockSize),
+          GetRowBlockCost(stride),
+          concurrency::ThreadPool::LoopScheduling::Guided,
+          [this, &agg, x_data, z_data, stride, label_data, N](ptrdiff_t first_block, ptrdiff_t last_block) {
+            ScoreValue<OTYPE> scores[kTreeRowBlockSize];
+            const TreeNodeElement<OTYPE>* leaves[kTreeRowBlockSize];
+            for (ptrdiff_t block = first_block; block < last_block; ++block) {
+              const int64_t begin = block * kTreeRowBlockSize;
+              const int64_t n_rows = std::min(kTreeRowBlockSize, N - begin);
+              std::fill(scores, scores + n_rows, ScoreValue<OTYPE>({0, 0}));
+              for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+                ProcessTreeNodeLeaves(j, x_data + begin * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction1(scores[r], *leaves[r]);
+                }
+              }
 
-            agg.FinalizeScores1(z_data + i, score,
-                                label_data == nullptr ? nullptr : (label_data + i));
-          },
-          0);
+              for (int64_t r = 0; r < n_rows; ++r) {
+                agg.FinalizeScores1(z_data + begin + r, scores[r],
+                                    label_data == nullptr ? nullptr : (label_data + begin + r));
+              }
+            }
+          });
     }
   } else {
     if (N == 1) {                       /* section A2: 2+ outputs, 1 row, not enough trees to parallelize */
@@ -372,32 +525,47 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
         agg.FinalizeScores(scores[0], z_data, -1, label_data);
       }
     } else if (N <= parallel_N_) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
-      std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
+      std::vector<std::vector<ScoreValue<OTYPE>>> scores(kTreeRowBlockSize);
+      const TreeNodeElement<OTYPE>* leaves[kTreeRowBlockSize];
       size_t j;
 
-      for (int64_t i = 0; i < N; ++i) {
-        std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
+      for (int64_t begin = 0; begin < N; begin += kTreeRowBlockSize) {
+        const int64_t n_rows = std::min(kTreeRowBlockSize, N - begin);
+        for (int64_t r = 0; r < n_rows; ++r) {
+          scores[r].assign(n_targets_or_classes_, {0, 0});
+        }
         for (j = 0; j < roots_.size(); ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+          ProcessTreeNodeLeaves(j, x_data + begin * stride, stride, n_rows, leaves);
+          for (int64_t r = 0; r < n_rows; ++r) {
+            agg.ProcessTreeNodePrediction(scores[r], *leaves[r]);
+          }
         }
 
-        agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
-                           label_data == nullptr ? nullptr : (label_data + i));
+        for (int64_t r = 0; r < n_rows; ++r) {
+          agg.FinalizeScores(scores[r], z_data + (begin + r) * n_targets_or_classes_, -1,
+                             label_data == nullptr ? nullptr : (label_data + begin + r));
+        }
       }
     } else if (n_trees_ >= max_num_threads) { /* section: D2: 2+ outputs, 2+ rows, enough trees to parallelize*/
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
       std::vector<std::vector<ScoreValue<OTYPE>>> scores(num_threads * N);
+      const int64_t chunk_size = GetRowChunkSize(N, stride);
       concurrency::ThreadPool::TrySimpleParallelFor(
           ttp,
           num_threads,
-          [this, &agg, &scores, num_threads, x_data, N, stride](ptrdiff_t batch_num) {
+          [this, &agg, &scores, num_threads, x_data, N, stride, chunk_size](ptrdiff_t batch_num) {
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, this->n_trees_);
+            std::vector<const TreeNodeElement<OTYPE>*> leaves(chunk_size);
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * N + i].resize(n_targets_or_classes_, {0, 0});
             }
-            for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction(scores[batch_num * N + i], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            for (int64_t begin = 0; begin < N; begin += chunk_size) {
+              const int64_t n_rows = std::min(chunk_size, N - begin);
+              for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + begin * stride, stride, n_rows, leaves.data());
+                for (int64_t i = 0; i < n_rows; ++i) {
+                  agg.ProcessTreeNodePrediction(scores[batch_num * N + begin + i], *leaves[i]);
+                }
               }
             }
           });
@@ -415,25 +583,35 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
                                  label_data == nullptr ? nullptr : (label_data + i));
             }
           });
-    } else { /* section E2: 2+ outputs, 2+ rows, parallelization by rows */
-      auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
-      concurrency::ThreadPool::TrySimpleParallelFor(
+    } else { /* section E2: 2+ outputs, 2+ rows, parallelization by blocks of rows */
+      concurrency::ThreadPool::TryParallelFor(
           ttp,
-          num_threads,
-          [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+          SafeInt<std::ptrdiff_t>((N + kTreeRowBlockSize - 1) / kTreeRowBlockSize),
+          GetRowBlockCost(stride),
+          concurrency::ThreadPool::LoopScheduling::Guided,
+          [this, &agg, x_data, z_data, label_data, N, stride](ptrdiff_t first_block, ptrdiff_t last_block) {
             size_t j;
-            std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-            auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, N);
-
-            for (auto i = work.start; i < work.end; ++i) {
-              std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
+            std::vector<std::vector<ScoreValue<OTYPE>>> scores(kTreeRowBlockSize);
+            const TreeNodeElement<OTYPE>* leaves[kTreeRowBlockSize];
+            const int64_t end = std::min<int64_t>(N, last_block * kTreeRowBlockSize);
+
+            for (int64_t begin = first_block * kTreeRowBlockSize; begin < end; begin += kTreeRowBlockSize) {
+              const int64_t n_rows = std::min<int64_t>(kTreeRowBlockSize, end - begin);
+              for (int64_t r = 0; r < n_rows; ++r) {
+                scores[r].assign(n_targets_or_classes_, {0, 0});
+              }
               for (j = 0; j < roots_.size(); ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+                ProcessTreeNodeLeaves(j, x_data + begin * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction(scores[r], *leaves[r]);
+                }
               }
 
-              agg.FinalizeScores(scores,
-                                 z_data + i * n_targets_or_classes_, -1,
-                                 label_data == nullptr ? nullptr : (label_data + i));
+              for (int64_t r = 0; r < n_rows; ++r) {
+                agg.FinalizeScores(scores[r],
+                                   z_data + (begin + r) * n_targets_or_classes_, -1,
+                                   label_data == nullptr ? nullptr : (label_data + begin + r));
+              }
             }
           });
     }
@@ -546,6 +724,106 @@ TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeave(
   return root;
 }
 
+template <NODE_MODE mode, typename ITYPE, typename OTYPE>
+inline bool CompareTreeNodeValue(ITYPE val, OTYPE threshold) {
+  switch (mode) {
+    case NODE_MODE::BRANCH_LEQ:
+      return val <= threshold;
+    case NODE_MODE::BRANCH_LT:
+      return val < threshold;
+    case NODE_MODE::BRANCH_GTE:
+      return val >= threshold;
+    case NODE_MODE::BRANCH_GT:
+      return val > threshold;
+    case NODE_MODE::BRANCH_EQ:
+      return val == threshold;
+    case NODE_MODE::BRANCH_NEQ:
+      return val != threshold;
+    default:
+      return false;
+  }
+}
+
+template <typename ITYPE, typename OTYPE>
+template <NODE_MODE mode, bool has_missing_tracks>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeavesBlocked(
+    size_t j, const ITYPE* x_data, int64_t stride, int64_t n_rows, const TreeNodeElement<OTYPE>** leaves) const {
+  const CompactTreeNode* nodes = compact_nodes_.data();
+  const uint32_t root = compact_roots_[j];
+  const int32_t depth = compact_depths_[j];
+  uint32_t index[kTreeRowBlockSize];
+
+  for (int64_t begin = 0; begin < n_rows; begin += kTreeRowBlockSize) {
+    const int64_t block_rows = std::min(kTreeRowBlockSize, n_rows - begin);
+    const ITYPE* x = x_data + begin * stride;
+    for (int64_t r = 0; r < block_rows; ++r) {
+      index[r] = root;
+    }
+
+    // The rows of the block go down one level at a time without branching, which interleaves
+    // the node loads of the rows instead of waiting for each of them.
+    for (int32_t level = 0; level < depth; ++level) {
+      for (int64_t r = 0; r < block_rows; ++r) {
+        const CompactTreeNode& node = nodes[index[r]];
+        const ITYPE val = x[r * stride + node.feature_id];
+        bool cond = CompareTreeNodeValue<mode>(val, node.value);
+        if (has_missing_tracks) {
+          cond |= node.is_missing_track_true & _isnan_(val);
+        }
+        index[r] = node.children[cond ? 0 : 1];
+      }
+    }
+
+    for (int64_t r = 0; r < block_rows; ++r) {
+      leaves[begin + r] = compact_leaves_[index[r]];
+    }
+  }
+}
+
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeaves(
+    size_t j, const ITYPE* x_data, int64_t stride, int64_t n_rows, const TreeNodeElement<OTYPE>** leaves) const {
+#define TREE_PROCESS_LEAVES_BLOCKED(MODE)                                                    \
+  if (has_missing_tracks_) {                                                                 \
+    ProcessTreeNodeLeavesBlocked<MODE, true>(j, x_data, stride, n_rows, leaves);             \
+  } else {                                                                                   \
+    ProcessTreeNodeLeavesBlocked<MODE, false>(j, x_data, stride, n_rows, leaves);            \
+  }
+
+  if (compact_roots_.empty()) {
+    for (int64_t i = 0; i < n_rows; ++i) {
+      leaves[i] = ProcessTreeNodeLeave(roots_[j], x_data + i * stride);
+    }
+    return;
+  }
+
+  switch (compact_mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      TREE_PROCESS_LEAVES_BLOCKED(NODE_MODE::BRANCH_LEQ)
+      break;
+    case NODE_MODE::BRANCH_LT:
+      TREE_PROCESS_LEAVES_BLOCKED(NODE_MODE::BRANCH_LT)
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      TREE_PROCESS_LEAVES_BLOCKED(NODE_MODE::BRANCH_GTE)
+      break;
+    case NODE_MODE::BRANCH_GT:
+      TREE_PROCESS_LEAVES_BLOCKED(NODE_MODE::BRANCH_GT)
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      TREE_PROCESS_LEAVES_BLOCKED(NODE_MODE::BRANCH_EQ)
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      TREE_PROCESS_LEAVES_BLOCKED(NODE_MODE::BRANCH_NEQ)
+      break;
+    case NODE_MODE::LEAF:
+      // all the trees are leaves
+      ProcessTreeNodeLeavesBlocked<NODE_MODE::LEAF, false>(j, x_data, stride, n_rows, leaves);
+      break;
+  }
+#undef TREE_PROCESS_LEAVES_BLOCKED
+}
+
 template <typename ITYPE, typename OTYPE>
 class TreeEnsembleCommonClassifier : TreeEnsembleCommon<ITYPE, OTYPE> {
  private:
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
@@ -35,6 +36,48 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+// Create the map with all the keys, and return the input column for each entry in key order.
+// If a key is repeated the last column wins, as when assigning the values one by one.
+template <typename TKey>
+static std::vector<int64_t> InitializeMap(const std::vector<TKey>& keys, std::map<TKey, float>& key_map) {
+  std::map<TKey, int64_t> key_columns;
+  for (size_t j = 0; j < keys.size(); ++j) {
+    key_columns[keys[j]] = static_cast<int64_t>(j);
+  }
+
+  std::vector<int64_t> value_index;
+  value_index.reserve(key_columns.size());
+  for (const auto& key_column : key_columns) {
+    key_map.emplace_hint(key_map.end(), key_column.first, 0.f);
+    value_index.push_back(key_column.second);
+  }
+  return value_index;
+}
+
+template <typename TKey>
+static void ZipMaps(const std::map<TKey, float>& key_map, const std::vector<int64_t>& value_index,
+                    const float* x_data, int64_t batch_size, int64_t features_per_batch,
+                    std::vector<std::map<TKey, float>>& y_data, concurrency::ThreadPool* threadpool) {
+  y_data.resize(batch_size);
+
+  // building a map allocates a node per entry, which dominates the cost
+  const double entries = static_cast<double>(value_index.size());
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, batch_size,
+      TensorOpCost{entries * sizeof(float), entries * (sizeof(TKey) + sizeof(float)), entries * 64},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          const float* row = x_data + n * features_per_batch;
+          auto& y_map = y_data[n];
+          y_map = key_map;
+          auto entry = y_map.begin();
+          for (int64_t column : value_index) {
+            (entry++)->second = row[column];
+          }
+        }
+      });
+}
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +85,12 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+
+  if (using_strings_) {
+    value_index_ = InitializeMap(classlabels_strings_, string_map_);
+  } else {
+    value_index_ = InitializeMap(classlabels_int64s_, int64_map_);
+  }
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -77,17 +126,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
 
-    //auto* y_data = Y->template MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map1);
-    }
+    ZipMaps(string_map_, value_index_, x_data, batch_size, features_per_batch, *y_data,
+            context->GetOperatorThreadPool());
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -97,17 +137,9 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+
+    ZipMaps(int64_map_, value_index_, x_data, batch_size, features_per_batch, *y_data,
+            context->GetOperatorThreadPool());
   }
   return common::Status::OK();
 }
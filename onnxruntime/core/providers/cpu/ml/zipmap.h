@@ -4,6 +4,8 @@
 #pragma once
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+
+#include <map>
 namespace onnxruntime {
 namespace ml {
 
@@ -16,6 +18,12 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+
+  // Output maps are copies of these, with the values written in key order from the input column in value_index_.
+  // Copying an existing map avoids comparing the keys again for every row.
+  std::map<std::string, float> string_map_;
+  std::map<int64_t, float> int64_map_;
+  std::vector<int64_t> value_index_;
 };
 
 }  // namespace ml
@@ -24,6 +24,8 @@
 #include "core/framework/tensor.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/nn/batch_norm_helper.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include <safeint/SafeInt.hpp>
 
 namespace onnxruntime {
@@ -99,18 +101,20 @@ class BatchNorm : public OpKernel {
       EigenVectorArrayMap<T> saved_mean_arr(saved_mean->template MutableData<T>(), C);
       // We first calculate saved_var then later take inverse square root to get saved_inv_std
       EigenVectorArrayMap<T> saved_var_arr(saved_inv_std->template MutableData<T>(), C);
-      saved_mean_arr.setZero();
-      saved_var_arr.setZero();
 
-      for (size_t nc = 0; nc < N * C; ++nc) {
-        saved_mean_arr(nc % C) += X_arr.col(nc).sum();
-      }
-  
-      saved_mean_arr /= static_cast<T>(N * sample_size);
-      for (size_t nc = 0; nc < N * C; ++nc) {
-        saved_var_arr(nc % C) += (X_arr.col(nc) - saved_mean_arr(nc % C)).matrix().squaredNorm();
-      }
-      saved_var_arr /= static_cast<T>(N * sample_size);
+      // Each channel combines the moments of its N samples, so the channels
+      // are computed in parallel.
+      const T* x_data = X->template Data<T>();
+      concurrency::ThreadPool::TryParallelFor(
+          p_op_kernel_context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(C),
+          TensorOpCost{static_cast<double>(N * sample_size * sizeof(T)), static_cast<double>(2 * sizeof(T)),
+                       static_cast<double>(4 * N * sample_size)},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t c = first; c < last; ++c) {
+              ComputeChannelMoments(x_data + c * sample_size, N, sample_size_incl_all_channels, sample_size,
+                                    saved_mean_arr(c), saved_var_arr(c));
+            }
+          });
 
       // The running mean corresponds to the mean from all the batches
       // During inference this running mean is used as the mean for BN
@@ -163,9 +167,18 @@ class BatchNorm : public OpKernel {
                            is_spatial_ ? N * C : N);
 
     if (is_spatial_) {  // spatial == 1
-      for (size_t nc = 0; nc < N * C; ++nc) {
-        Y_arr.col(nc) = X_arr.col(nc) * new_scale(nc % C) + new_bias(nc % C);
-      }
+      const T* x_data = X->template Data<T>();
+      T* y_data = Y->template MutableData<T>();
+      concurrency::ThreadPool::TryParallelFor(
+          p_op_kernel_context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(N * C),
+          TensorOpCost{static_cast<double>(sample_size * sizeof(T)), static_cast<double>(sample_size * sizeof(T)),
+                       static_cast<double>(2 * sample_size)},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t nc = first; nc < last; ++nc) {
+              NormalizeChannel(x_data + nc * sample_size, y_data + nc * sample_size, sample_size,
+                               new_scale(nc % C), new_bias(nc % C));
+            }
+          });
     } else {  // spatial == 0
       for (size_t n = 0; n < N; ++n) {
         Y_arr.col(n) = X_arr.col(n) * new_scale.col(0) + new_bias.col(0);
@@ -174,6 +187,54 @@ class BatchNorm : public OpKernel {
     return Status::OK();
   }
 
+ private:
+  // Computes the mean and the population variance of the N samples of a
+  // channel, which are sample_stride elements apart.
+  static void ComputeChannelMoments(const float* x, size_t N, size_t sample_stride, size_t sample_size,
+                                    float& mean, float& var) {
+    // Combine the moments of the samples, which all have the same size, with
+    // the pairwise update of Chan et al.
+    float mean_sum = 0.0f;
+    float squared_difference_sum = 0.0f;
+    for (size_t n = 0; n < N; ++n) {
+      float sample_mean;
+      float sample_var;
+      MlasComputeMeanVariance(x + n * sample_stride, sample_size, &sample_mean, &sample_var);
+      if (n > 0) {
+        const float delta = sample_mean - mean_sum / static_cast<float>(n);
+        squared_difference_sum += delta * delta * static_cast<float>(n) / static_cast<float>(n + 1);
+      }
+      mean_sum += sample_mean;
+      squared_difference_sum += sample_var;
+    }
+    mean = mean_sum / static_cast<float>(N);
+    var = squared_difference_sum / static_cast<float>(N);
+  }
+
+  static void ComputeChannelMoments(const double* x, size_t N, size_t sample_stride, size_t sample_size,
+                                    double& mean, double& var) {
+    mean = 0.0;
+    for (size_t n = 0; n < N; ++n) {
+      mean += ConstEigenVectorArrayMap<double>(x + n * sample_stride, sample_size).sum();
+    }
+    mean /= static_cast<double>(N * sample_size);
+    var = 0.0;
+    for (size_t n = 0; n < N; ++n) {
+      var += (ConstEigenVectorArrayMap<double>(x + n * sample_stride, sample_size) - mean).matrix().squaredNorm();
+    }
+    var /= static_cast<double>(N * sample_size);
+  }
+
+  static void NormalizeChannel(const float* x, float* y, size_t sample_size, float scale, float bias) {
+    MlasComputeScaleShift(x, y, sample_size, scale, bias);
+  }
+
+  static void NormalizeChannel(const double* x, double* y, size_t sample_size, double scale, double bias) {
+    ConstEigenVectorArrayMap<double> x_arr(x, sample_size);
+    EigenVectorArrayMap<double> y_arr(y, sample_size);
+    y_arr = x_arr * scale + bias;
+  }
+
  protected:
   float epsilon_;
   float momentum_;
@@ -22,6 +22,60 @@
 
 namespace onnxruntime {
 
+namespace {
+
+// Im2col only moves elements, so MLFloat16 data is transformed using its raw bits.
+template <typename T>
+struct ConvIm2colType {
+  using type = T;
+};
+
+template <>
+struct ConvIm2colType<MLFloat16> {
+  using type = uint16_t;
+};
+
+// Computes Y = W * col for one group of the convolution.
+template <typename T>
+void ConvGemm(int64_t M, int64_t N, int64_t K, const T* W, const T* col, T* Y,
+              concurrency::ThreadPool* thread_pool) {
+  math::Gemm<T>(CblasNoTrans, CblasNoTrans, M, N, K, 1, W, col, 0, Y, thread_pool);
+}
+
+template <>
+void ConvGemm<MLFloat16>(int64_t M, int64_t N, int64_t K, const MLFloat16* W, const MLFloat16* col, MLFloat16* Y,
+                         concurrency::ThreadPool* thread_pool) {
+  MlasHalfGemm(CblasNoTrans, CblasNoTrans,
+               static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+               1.0f,
+               reinterpret_cast<const MLAS_FP16*>(W), static_cast<size_t>(K),
+               reinterpret_cast<const MLAS_FP16*>(col), static_cast<size_t>(N),
+               0.0f,
+               reinterpret_cast<MLAS_FP16*>(Y), static_cast<size_t>(N),
+               thread_pool);
+}
+
+// Adds the per output channel bias to the M x output_image_size output of one image.
+template <typename T>
+void ConvAddBias(T* Ydata, const T* Bdata, int64_t output_image_size, int64_t M) {
+  auto Ymatrix = EigenMatrixMap<T>(Ydata, output_image_size, M);
+  auto Bvec = ConstEigenVectorMap<T>(Bdata, M);
+  Ymatrix.rowwise() += Bvec.transpose();
+}
+
+template <>
+void ConvAddBias<MLFloat16>(MLFloat16* Ydata, const MLFloat16* Bdata, int64_t output_image_size, int64_t M) {
+  for (int64_t m = 0; m < M; ++m) {
+    const float bias = math::halfToFloat(Bdata[m].val);
+    MLFloat16* y = Ydata + m * output_image_size;
+    for (int64_t i = 0; i < output_image_size; ++i) {
+      y[i].val = math::floatToHalf(math::halfToFloat(y[i].val) + bias);
+    }
+  }
+}
+
+}  // namespace
+
 template <typename T>
 Status Conv<T>::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
@@ -84,6 +138,8 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 
   T* col_buffer_data = static_cast<T*>(col_buffer.get());
 
+  using Im2colT = typename ConvIm2colType<T>::type;
+
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
   const T* Xdata = X->template Data<T>();
@@ -93,8 +149,8 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     for (int group_id = 0; group_id < conv_attrs_.group; ++group_id) {
       if (col_buffer_data != nullptr) {
         if (kernel_rank == 2) {
-          math::Im2col<T, StorageOrder::NCHW>()(
-              Xdata + group_id * X_offset,
+          math::Im2col<Im2colT, StorageOrder::NCHW>()(
+              reinterpret_cast<const Im2colT*>(Xdata + group_id * X_offset),
               C / conv_attrs_.group,
               input_shape[0],
               input_shape[1],
@@ -108,10 +164,10 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
               pads[3],
               strides[0],
               strides[1],
-              col_buffer_data);
+              reinterpret_cast<Im2colT*>(col_buffer_data));
         } else {
-          math::Im2col<T, StorageOrder::NCHW>()(
-              Xdata + group_id * X_offset,
+          math::Im2col<Im2colT, StorageOrder::NCHW>()(
+              reinterpret_cast<const Im2colT*>(Xdata + group_id * X_offset),
               input_shape.GetDims().data(),
               output_shape.GetDims().data(),
               kernel_dim,
@@ -120,28 +176,22 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
               dilations.data(),
               pads.data(),
               static_cast<int>(kernel_shape.size()),
-              col_buffer_data);
+              reinterpret_cast<Im2colT*>(col_buffer_data));
         }
       }
 
-      math::Gemm<T>(
-          CblasNoTrans,
-          CblasNoTrans,
+      ConvGemm<T>(
           M / conv_attrs_.group,
           output_image_size,
           kernel_dim,
-          1,
           W->template Data<T>() + group_id * W_offset,
           col_buffer_data == nullptr ? Xdata + group_id * X_offset : col_buffer_data,
-          0,
           Ydata + group_id * Y_offset,
           thread_pool);
     }
 
     if (B != nullptr) {
-      auto Ymatrix = EigenMatrixMap<T>(Ydata, output_image_size, M);
-      auto Bvec = ConstEigenVectorMap<T>(B->template Data<T>(), M);
-      Ymatrix.rowwise() += Bvec.transpose();
+      ConvAddBias<T>(Ydata, B->template Data<T>(), output_image_size, M);
     }
 
     Xdata += X_offset * conv_attrs_.group;
@@ -292,4 +342,18 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Conv<float>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Conv,
+    1, 10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Conv<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Conv,
+    11,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Conv<MLFloat16>);
+
 }  // namespace onnxruntime
@@ -24,6 +24,233 @@
 
 namespace onnxruntime {
 
+namespace {
+
+// One spatial dimension of a phase of the output of a ConvTranspose. The outputs phase + stride * j of a phase
+// only depend on the kernel taps k with (phase + pad - k * dilation) % stride == 0, which makes the phase a stride 1
+// convolution of the input with those taps in reverse order.
+struct SubPixelPhase {
+  int64_t output_count;  // number of outputs of the phase
+  int64_t taps;          // number of kernel taps of the phase
+  int64_t last_tap;      // kernel index of the last tap, which is the first tap of the convolution
+  int64_t tap_step;      // distance between the kernel indices of consecutive taps
+  int64_t dilation;      // dilation of the convolution
+  int64_t pad_begin;     // padding of the convolution
+  int64_t pad_end;
+};
+
+// Returns false if the phase has outputs but can't be computed as a convolution with non-negative padding.
+bool ComputeSubPixelPhase(int64_t phase, int64_t stride, int64_t dilation, int64_t kernel, int64_t pad,
+                          int64_t input_size, int64_t output_size, SubPixelPhase& sp) {
+  sp.output_count = phase < output_size ? (output_size - phase + stride - 1) / stride : 0;
+  if (sp.output_count == 0) {
+    return true;
+  }
+
+  int64_t gcd = stride;
+  for (int64_t b = dilation; b != 0;) {
+    const int64_t t = gcd % b;
+    gcd = b;
+    b = t;
+  }
+  sp.tap_step = stride / gcd;
+  sp.dilation = dilation / gcd;
+
+  // the taps repeat every tap_step kernel indices
+  int64_t first_tap = 0;
+  while (first_tap < sp.tap_step && ((phase + pad - first_tap * dilation) % stride + stride) % stride != 0) {
+    ++first_tap;
+  }
+  if (first_tap == sp.tap_step || first_tap >= kernel) {
+    return false;
+  }
+
+  sp.taps = (kernel - 1 - first_tap) / sp.tap_step + 1;
+  sp.last_tap = first_tap + (sp.taps - 1) * sp.tap_step;
+  sp.pad_begin = -((phase + pad - sp.last_tap * dilation) / stride);
+  sp.pad_end = sp.output_count - input_size - sp.pad_begin + (sp.taps - 1) * sp.dilation;
+  return sp.pad_begin >= 0 && sp.pad_end >= 0;
+}
+
+// Gathers the taps of a phase from the ConvTranspose filter, a [C/group x (M/group * KH * KW)] matrix per group
+// (transposed if prepacked), into a convolution filter [M][C/group][taps_h][taps_w].
+void GatherSubPixelFilter(const float* filter, bool transposed, int64_t group, int64_t input_channels_per_group,
+                          int64_t output_channels_per_group, int64_t kernel_h, int64_t kernel_w,
+                          const SubPixelPhase& h, const SubPixelPhase& w, float* sub_filter) {
+  const int64_t K = input_channels_per_group;
+  const int64_t N = output_channels_per_group * kernel_h * kernel_w;
+  for (int64_t g = 0; g < group; ++g) {
+    const float* group_filter = filter + g * K * N;
+    for (int64_t co = 0; co < output_channels_per_group; ++co) {
+      for (int64_t ci = 0; ci < K; ++ci) {
+        for (int64_t th = 0; th < h.taps; ++th) {
+          for (int64_t tw = 0; tw < w.taps; ++tw) {
+            const int64_t kh = h.last_tap - th * h.tap_step;
+            const int64_t kw = w.last_tap - tw * w.tap_step;
+            const int64_t n = (co * kernel_h + kh) * kernel_w + kw;
+            *sub_filter++ = transposed ? group_filter[n * K + ci] : group_filter[ci * N + n];
+          }
+        }
+      }
+    }
+  }
+}
+
+// Computes a 2D ConvTranspose as one stride 1 MLAS convolution per phase of the output, the outputs with the same
+// position modulo the strides (sub-pixel decomposition). Unlike GEMM + Col2im, this needs no col buffer of
+// (M/group * KH * KW) x input_size, only a buffer for the output of a phase, and runs multithreaded end to end.
+// Returns false if the ConvTranspose can't be decomposed, e.g. when a phase has no kernel taps.
+bool TrySubPixelConvTranspose(const ConvTransposeAttributes::Prepare& p, int64_t group, const float* filter,
+                              bool filter_is_transposed, const AllocatorPtr& alloc,
+                              concurrency::ThreadPool* thread_pool) {
+  const int64_t input_h = p.input_shape[0];
+  const int64_t input_w = p.input_shape[1];
+  const int64_t output_h = p.Y->Shape()[2];
+  const int64_t output_w = p.Y->Shape()[3];
+  const int64_t stride_h = p.strides[0];
+  const int64_t stride_w = p.strides[1];
+
+  std::vector<SubPixelPhase> phases_h(static_cast<size_t>(stride_h));
+  std::vector<SubPixelPhase> phases_w(static_cast<size_t>(stride_w));
+  for (int64_t ph = 0; ph < stride_h; ++ph) {
+    if (!ComputeSubPixelPhase(ph, stride_h, p.dilations[0], p.kernel_shape[0], p.pads[0], input_h, output_h,
+                              phases_h[ph])) {
+      return false;
+    }
+  }
+  for (int64_t pw = 0; pw < stride_w; ++pw) {
+    if (!ComputeSubPixelPhase(pw, stride_w, p.dilations[1], p.kernel_shape[1], p.pads[1], input_w, output_w,
+                              phases_w[pw])) {
+      return false;
+    }
+  }
+
+  const int64_t input_channels_per_group = p.num_input_channels / group;
+  const int64_t output_channels_per_group = p.num_output_channels / group;
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  struct Phase {
+    MLAS_CONV_PARAMETERS parameters;
+    int64_t ph;
+    int64_t pw;
+    size_t filter_offset;
+  };
+  std::vector<Phase> phases;
+  size_t working_buffer_size = 0;
+  size_t filter_size = 0;
+  size_t phase_output_size = 0;
+  for (int64_t ph = 0; ph < stride_h; ++ph) {
+    for (int64_t pw = 0; pw < stride_w; ++pw) {
+      const SubPixelPhase& h = phases_h[ph];
+      const SubPixelPhase& w = phases_w[pw];
+      if (h.output_count == 0 || w.output_count == 0) {
+        continue;
+      }
+      const int64_t kernel_shape[] = {h.taps, w.taps};
+      const int64_t dilations[] = {h.dilation, w.dilation};
+      const int64_t pads[] = {h.pad_begin, w.pad_begin, h.pad_end, w.pad_end};
+      const int64_t strides[] = {1, 1};
+      const int64_t output_shape[] = {h.output_count, w.output_count};
+
+      Phase phase;
+      phase.ph = ph;
+      phase.pw = pw;
+      phase.filter_offset = filter_size;
+      size_t phase_working_buffer_size;
+      MlasConvPrepare(&phase.parameters,
+                      2,
+                      1,
+                      static_cast<size_t>(group),
+                      static_cast<size_t>(input_channels_per_group),
+                      p.input_shape.GetDims().data(),
+                      kernel_shape,
+                      dilations,
+                      pads,
+                      strides,
+                      output_shape,
+                      static_cast<size_t>(output_channels_per_group),
+                      &activation,
+                      &phase_working_buffer_size,
+                      thread_pool);
+      phases.push_back(phase);
+
+      working_buffer_size = std::max(working_buffer_size, phase_working_buffer_size);
+      filter_size += static_cast<size_t>(p.num_output_channels * input_channels_per_group * h.taps * w.taps);
+      phase_output_size = std::max(phase_output_size,
+                                   static_cast<size_t>(p.num_output_channels * h.output_count * w.output_count));
+    }
+  }
+
+  // with unit strides the only phase is the whole output
+  const bool direct_output = stride_h == 1 && stride_w == 1;
+
+  auto* filter_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * filter_size);
+  BufferUniquePtr filter_buffer(filter_data, BufferDeleter(alloc));
+  auto* sub_filters = static_cast<float*>(filter_buffer.get());
+  for (const Phase& phase : phases) {
+    GatherSubPixelFilter(filter, filter_is_transposed, group, input_channels_per_group, output_channels_per_group,
+                         p.kernel_shape[0], p.kernel_shape[1], phases_h[phase.ph], phases_w[phase.pw],
+                         sub_filters + phase.filter_offset);
+  }
+
+  auto* working_data = working_buffer_size > 0
+                           ? alloc->Alloc(SafeInt<size_t>(sizeof(float)) * working_buffer_size)
+                           : nullptr;
+  BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
+
+  auto* phase_output_data = direct_output ? nullptr : alloc->Alloc(SafeInt<size_t>(sizeof(float)) * phase_output_size);
+  BufferUniquePtr phase_output_buffer(phase_output_data, BufferDeleter(alloc));
+  auto* phase_output = static_cast<float*>(phase_output_buffer.get());
+
+  const float* Xdata = p.X->template Data<float>();
+  const float* Bdata = p.B != nullptr ? p.B->template Data<float>() : nullptr;
+  float* Ydata = p.Y->template MutableData<float>();
+  const int64_t X_offset = p.num_input_channels * input_h * input_w;
+  const int64_t Y_offset = p.num_output_channels * output_h * output_w;
+
+  for (int64_t image_id = 0; image_id < p.N; ++image_id) {
+    for (const Phase& phase : phases) {
+      MlasConv(&phase.parameters,
+               Xdata,
+               sub_filters + phase.filter_offset,
+               Bdata,
+               static_cast<float*>(working_buffer.get()),
+               direct_output ? Ydata : phase_output,
+               thread_pool);
+
+      if (!direct_output) {
+        // scatter the phase into every stride-th output of each channel
+        const int64_t count_h = phases_h[phase.ph].output_count;
+        const int64_t count_w = phases_w[phase.pw].output_count;
+        const double bytes = static_cast<double>(count_h * count_w * sizeof(float));
+        concurrency::ThreadPool::TryParallelFor(
+            thread_pool, static_cast<std::ptrdiff_t>(p.num_output_channels), TensorOpCost{bytes, bytes, 0},
+            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+              for (std::ptrdiff_t c = first; c < last; ++c) {
+                const float* src = phase_output + c * count_h * count_w;
+                float* dst = Ydata + c * output_h * output_w + phase.ph * output_w + phase.pw;
+                for (int64_t j = 0; j < count_h; ++j) {
+                  float* dst_row = dst + j * stride_h * output_w;
+                  for (int64_t i = 0; i < count_w; ++i) {
+                    dst_row[i * stride_w] = *src++;
+                  }
+                }
+              }
+            });
+      }
+    }
+
+    Xdata += X_offset;
+    Ydata += Y_offset;
+  }
+
+  return true;
+}
+
+}  // namespace
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     ConvTranspose,
     1, 10,
@@ -205,13 +432,18 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
+  const float* filter_data = p.F ? p.F->template Data<float>() : static_cast<float*>(transposed_filter_.get());
+  if (p.X->Shape().NumDimensions() == 4 &&
+      TrySubPixelConvTranspose(p, conv_transpose_attrs_.group, filter_data, p.F == nullptr, alloc, thread_pool)) {
+    return Status::OK();
+  }
+
   const int64_t col_buffer_size = kernel_dim * p.input_shape.Size();
   auto col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * col_buffer_size);
   BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
   float* col_buffer_data = static_cast<float*>(col_buffer.get());
 
   const float* Xdata = p.X->template Data<float>();
-  const float* filter_data = p.F ? p.F->template Data<float>() : static_cast<float*>(transposed_filter_.get());
   float* Ydata = p.Y->template MutableData<float>();
   TensorShape output_shape = p.Y->Shape().Slice(2);
 
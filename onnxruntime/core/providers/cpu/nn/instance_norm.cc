@@ -3,7 +3,8 @@
 
 #include "core/providers/cpu/nn/instance_norm.h"
 #include "core/providers/cpu/nn/instance_norm_helper.h"
-#include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -28,16 +29,31 @@ Status InstanceNorm<float>::Compute(OpKernelContext* p_op_kernel_context) const
   const TensorShape& x_shape = input->Shape();
   Tensor* Y = p_op_kernel_context->Output(0, x_shape);
 
-  for (auto i = 0; i < N * C; ++i) {
-    ConstEigenVectorArrayMap<float> Xi(input->template Data<float>() + W * i, W);
-    const float Xi_mean = Xi.mean();
-    const float squared_norm = (Xi - Xi_mean).matrix().squaredNorm();
-    const float inv_stdev = 1.0f / std::sqrt(squared_norm / W + epsilon_);
-    EigenVectorArrayMap<float> Yi(Y->template MutableData<float>() + W * i, W);
-    const float channel_scale = inv_stdev * scale->template Data<float>()[i % C];
-    const float channel_shift = B->template Data<float>()[i % C] - Xi_mean * channel_scale;
-    Yi = Xi * channel_scale + channel_shift;
-  }
+  const auto* input_data = input->template Data<float>();
+  const auto* scale_data = scale->template Data<float>();
+  const auto* bias_data = B->template Data<float>();
+  auto* output_data = Y->template MutableData<float>();
+
+  // Every instance reads its channel twice, once for the moments and once to
+  // normalize it, and the instances are independent of each other.
+  const TensorOpCost cost{static_cast<double>(2 * W * sizeof(float)),
+                          static_cast<double>(W * sizeof(float)),
+                          static_cast<double>(8 * W)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      p_op_kernel_context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(N * C), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          float mean;
+          float variance;
+          MlasComputeMeanVariance(input_data + W * i, static_cast<size_t>(W), &mean, &variance);
+          const float inv_stdev = 1.0f / std::sqrt(variance + epsilon_);
+          const float channel_scale = inv_stdev * scale_data[i % C];
+          const float channel_shift = bias_data[i % C] - mean * channel_scale;
+          MlasComputeScaleShift(input_data + W * i, output_data + W * i, static_cast<size_t>(W),
+                                channel_scale, channel_shift);
+        }
+      });
 
   return Status::OK();
 }
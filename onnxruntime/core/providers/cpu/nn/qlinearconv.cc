@@ -10,6 +10,7 @@
 #include "core/util/math_cpuonly.h"
 #include "core/util/qmath.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -41,6 +42,25 @@ class QLinearConv : public OpKernel {
     }
   }
 
+  // Offsets into a channels last image of the input vector read by every
+  // output position and kernel element, or -1 where the kernel reads the
+  // padding. The offsets only depend on the shapes, so the table is built
+  // once and shared by every image and every call with the same input shape.
+  struct IndirectionTable {
+    std::vector<int64_t> input_shape;
+    std::vector<int64_t> kernel_shape;
+    int64_t channels;
+    std::vector<int64_t> offsets;
+  };
+
+  std::shared_ptr<const IndirectionTable> GetIndirectionTable(const TensorShape& input_shape,
+                                                              const TensorShape& output_shape,
+                                                              const std::vector<int64_t>& kernel_shape,
+                                                              const std::vector<int64_t>& strides,
+                                                              const std::vector<int64_t>& dilations,
+                                                              const std::vector<int64_t>& pads,
+                                                              int64_t channels) const;
+
   ConvAttributes conv_attrs_;
   TensorShape W_shape_;
   BufferUniquePtr packed_W_buffer_;
@@ -49,6 +69,9 @@ class QLinearConv : public OpKernel {
   bool is_W_signed_;
   bool is_W_packed_;
   bool channels_last_;
+
+  mutable OrtMutex indirection_table_mutex_;
+  mutable std::shared_ptr<const IndirectionTable> indirection_table_;
 };
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -159,6 +182,71 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, bool& is_packed
   return Status::OK();
 }
 
+std::shared_ptr<const QLinearConv::IndirectionTable> QLinearConv::GetIndirectionTable(
+    const TensorShape& input_shape,
+    const TensorShape& output_shape,
+    const std::vector<int64_t>& kernel_shape,
+    const std::vector<int64_t>& strides,
+    const std::vector<int64_t>& dilations,
+    const std::vector<int64_t>& pads,
+    int64_t channels) const {
+  std::lock_guard<OrtMutex> lock(indirection_table_mutex_);
+
+  if (indirection_table_ != nullptr &&
+      indirection_table_->input_shape == input_shape.GetDims() &&
+      indirection_table_->kernel_shape == kernel_shape &&
+      indirection_table_->channels == channels) {
+    return indirection_table_;
+  }
+
+  const size_t kernel_rank = kernel_shape.size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  auto table = std::make_shared<IndirectionTable>();
+  table->input_shape = input_shape.GetDims();
+  table->kernel_shape = kernel_shape;
+  table->channels = channels;
+  table->offsets.resize(SafeInt<size_t>(output_image_size) * kernel_size);
+
+  int64_t* offsets = table->offsets.data();
+  std::vector<int64_t> output_position(kernel_rank, 0);
+  std::vector<int64_t> kernel_position(kernel_rank, 0);
+
+  for (int64_t output_index = 0; output_index < output_image_size; output_index++) {
+    for (int64_t kernel_index = 0; kernel_index < kernel_size; kernel_index++) {
+      int64_t input_index = 0;
+      for (size_t d = 0; d < kernel_rank; d++) {
+        const int64_t input_position = output_position[d] * strides[d] - pads[d] + kernel_position[d] * dilations[d];
+        if (input_position < 0 || input_position >= input_shape[d]) {
+          input_index = -1;
+          break;
+        }
+        input_index = input_index * input_shape[d] + input_position;
+      }
+      *offsets++ = input_index >= 0 ? input_index * channels : -1;
+
+      // Step to the next kernel element, the innermost dimension first.
+      for (size_t d = kernel_rank; d-- > 0;) {
+        if (++kernel_position[d] < kernel_shape[d]) {
+          break;
+        }
+        kernel_position[d] = 0;
+      }
+    }
+
+    for (size_t d = kernel_rank; d-- > 0;) {
+      if (++output_position[d] < output_shape[d]) {
+        break;
+      }
+      output_position[d] = 0;
+    }
+  }
+
+  indirection_table_ = std::move(table);
+  return indirection_table_;
+}
+
 Status QLinearConv::Compute(OpKernelContext* context) const {
   const Tensor* X = context->Input<Tensor>(0);
   const Tensor* W = is_W_packed_ ? nullptr : context->Input<Tensor>(3);
@@ -309,13 +397,6 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   const int64_t X_offset = C * input_image_size;
   const int64_t Y_offset = M * output_image_size;
   const int64_t kernel_dim = group_input_channels * kernel_size;
-  const int64_t col_buffer_size = kernel_dim * output_image_size;
-
-  // Use an intermediate int32_t buffer for the GEMM computation before
-  // requantizing to the output type.
-  auto* gemm_output_data = alloc->Alloc(SafeInt<size_t>(sizeof(int32_t)) * Y_offset);
-  BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
-  auto* gemm_output = static_cast<int32_t*>(gemm_output_buffer.get());
 
   const auto* Xdata = X->template Data<uint8_t>();
   const auto* Bdata = B != nullptr ? B->template Data<int32_t>() : nullptr;
@@ -332,21 +413,20 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
     transpose_output_buffer = BufferUniquePtr(transpose_output, BufferDeleter(alloc));
   }
 
-  BufferUniquePtr col_buffer;
+  // Pointwise convolutions can use the original input tensor in place,
+  // otherwise the input vectors are read through the indirection table
+  // instead of being copied to an im2col buffer for the whole image.
+  const bool use_input_in_place =
+      !is_depthwise_conv && kernel_size == 1 && conv_attrs_.HasStridesOneAndNoPadding();
+
+  std::shared_ptr<const IndirectionTable> indirection_table;
   std::vector<uint8_t> padding_data;
 
+  if (!use_input_in_place) {
+    indirection_table = GetIndirectionTable(input_shape, output_shape, kernel_shape, strides, dilations, pads, C);
+  }
   if (is_depthwise_conv) {
-    // Allocate indirection buffer pointers and prepare a padding vector for
-    // the im2col transform.
-    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(const uint8_t*)) * kernel_size * output_image_size);
-    col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
     padding_data.resize(static_cast<size_t>(C), X_zero_point_value);
-  } else if (kernel_size != 1 || !conv_attrs_.HasStridesOneAndNoPadding()) {
-    // Pointwise convolutions can use the original input tensor in place,
-    // otherwise a temporary buffer is required for the im2col transform.
-    int64_t group_col_buffer_size = (kernel_rank > 2) ? group_count * col_buffer_size : col_buffer_size;
-    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(uint8_t)) * group_col_buffer_size);
-    col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
   }
 
   // Replicate the logic from MlasGemmU8X8Schedule to control the number of
@@ -375,6 +455,31 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
   thread_count = std::min(thread_count, concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
 
+  // Every thread steps through its outputs a tile at a time, so that the
+  // gathered input rows and the int32_t GEMM results of a tile stay in the
+  // cache. The depthwise kernel requantizes its results in registers and only
+  // needs the input pointers of a tile.
+  constexpr int64_t depthwise_output_tile_size = 64;
+  constexpr int64_t gemm_tile_bytes = 64 * 1024;
+  constexpr int64_t minimum_gemm_output_tile_size = 16;
+
+  int64_t output_tile_size;
+  int64_t worker_buffer_size;
+  if (is_depthwise_conv) {
+    output_tile_size = std::min(depthwise_output_tile_size, output_image_size);
+    worker_buffer_size = output_tile_size * kernel_size * static_cast<int64_t>(sizeof(const uint8_t*));
+  } else {
+    const int64_t tile_row_bytes = (use_input_in_place ? 0 : kernel_dim) + M * static_cast<int64_t>(sizeof(int32_t));
+    output_tile_size = std::min(std::max(gemm_tile_bytes / tile_row_bytes, minimum_gemm_output_tile_size),
+                                output_image_size);
+    worker_buffer_size = output_tile_size * tile_row_bytes;
+  }
+  // Keep the buffer of every thread on its own cache lines.
+  worker_buffer_size = (worker_buffer_size + 63) & ~int64_t{63};
+
+  auto* worker_data = alloc->Alloc(SafeInt<size_t>(worker_buffer_size) * thread_count);
+  BufferUniquePtr worker_buffer(worker_data, BufferDeleter(alloc));
+
   for (int64_t image_id = 0; image_id < N; ++image_id) {
     const auto* input_data = Xdata;
     auto* output_data = Ydata;
@@ -390,114 +495,69 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
       output_data = static_cast<uint8_t*>(transpose_output_buffer.get());
     }
 
-    // Threaded implementation of ND convolution is not yet supported, so
-    // prepare all im2col transformations here.
-    if (!is_depthwise_conv && col_buffer && kernel_rank > 2) {
-      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
-        math::Im2col<uint8_t, StorageOrder::NHWC>()(
-            input_data + group_id * group_input_channels,
-            group_input_channels,
-            C,
-            input_shape.GetDims().data(),
-            output_shape.GetDims().data(),
-            kernel_shape.data(),
-            strides.data(),
-            dilations.data(),
-            pads.data(),
-            static_cast<int64_t>(kernel_rank),
-            static_cast<uint8_t*>(col_buffer.get()) + group_id * col_buffer_size,
-            X_zero_point_value);
-      }
-    }
-
     auto conv_worker = [&](ptrdiff_t batch) {
       auto work = concurrency::ThreadPool::PartitionWork(batch, thread_count, static_cast<ptrdiff_t>(output_image_size));
-      int64_t output_start = static_cast<int64_t>(work.start);
-      int64_t output_count = static_cast<int64_t>(work.end - work.start);
-
-      auto* worker_gemm_output = gemm_output + output_start * M;
-      auto* worker_requantize_output = output_data + output_start * M;
-
-      if (is_depthwise_conv) {
-        auto* worker_col_buffer = static_cast<uint8_t const**>(col_buffer.get()) + output_start * kernel_size;
-        math::Im2col<uint8_t, StorageOrder::NHWC>()(
-            input_data,
-            C,
-            input_shape.GetDims().data(),
-            output_shape.GetDims().data(),
-            kernel_shape.data(),
-            strides.data(),
-            dilations.data(),
-            pads.data(),
-            static_cast<ptrdiff_t>(kernel_rank),
-            output_start,
-            output_count,
-            worker_col_buffer,
-            padding_data.data());
-        MlasConvDepthwise(
-            worker_col_buffer,
-            X_zero_point_value,
-            reordered_W,
-            W_zero_point_value,
-            is_W_signed,
-            worker_gemm_output,
-            static_cast<size_t>(M),
-            static_cast<size_t>(output_count),
-            static_cast<size_t>(kernel_size));
-      } else {
+      const int64_t worker_end = static_cast<int64_t>(work.end);
+
+      auto* worker_tile_buffer = static_cast<uint8_t*>(worker_buffer.get()) + batch * worker_buffer_size;
+
+      for (int64_t output_start = static_cast<int64_t>(work.start); output_start < worker_end;
+           output_start += output_tile_size) {
+        const int64_t output_count = std::min(output_tile_size, worker_end - output_start);
+        const int64_t* tile_offsets =
+            indirection_table ? indirection_table->offsets.data() + output_start * kernel_size : nullptr;
+        auto* tile_requantize_output = output_data + output_start * M;
+
+        if (is_depthwise_conv) {
+          auto* tile_indirection = reinterpret_cast<const uint8_t**>(worker_tile_buffer);
+          for (int64_t i = 0; i < output_count * kernel_size; i++) {
+            tile_indirection[i] = tile_offsets[i] >= 0 ? input_data + tile_offsets[i] : padding_data.data();
+          }
+          MlasConvDepthwise(
+              tile_indirection,
+              X_zero_point_value,
+              reordered_W,
+              W_zero_point_value,
+              is_W_signed,
+              Bdata,
+              output_scales.data(),
+              output_scales.size() > 1,
+              Y_zero_point_value,
+              tile_requantize_output,
+              static_cast<size_t>(M),
+              static_cast<size_t>(output_count),
+              static_cast<size_t>(kernel_size));
+          continue;
+        }
+
+        // Use an intermediate int32_t buffer for the GEMM computation before
+        // requantizing to the output type.
+        auto* tile_gemm_output = reinterpret_cast<int32_t*>(worker_tile_buffer);
+        auto* tile_gemm_input_buffer = worker_tile_buffer + output_tile_size * M * static_cast<int64_t>(sizeof(int32_t));
+
         for (int64_t group_id = 0; group_id < group_count; ++group_id) {
-          // Prepare the im2col transformation or use the input buffer directly for
-          // pointwise convolutions.
-          const uint8_t* worker_gemm_input;
-          if (col_buffer) {
-            auto* worker_col_buffer = static_cast<uint8_t*>(col_buffer.get()) + output_start * kernel_dim;
-            if (kernel_rank == 2) {
-              math::Im2col<uint8_t, StorageOrder::NHWC>()(
-                  input_data + group_id * group_input_channels,
-                  group_input_channels,
-                  C,
-                  input_shape[0],
-                  input_shape[1],
-                  kernel_shape[0],
-                  kernel_shape[1],
-                  dilations[0],
-                  dilations[1],
-                  pads[0],
-                  pads[1],
-                  strides[0],
-                  strides[1],
-                  output_shape[1],
-                  output_start,
-                  output_count,
-                  worker_col_buffer,
-                  X_zero_point_value);
-            } else if (kernel_rank == 1) {
-              math::Im2col<uint8_t, StorageOrder::NHWC>()(
-                  input_data + group_id * group_input_channels,
-                  group_input_channels,
-                  C,
-                  1,
-                  input_shape[0],
-                  1,
-                  kernel_shape[0],
-                  1,
-                  dilations[0],
-                  0,
-                  pads[0],
-                  1,
-                  strides[0],
-                  output_shape[0],
-                  output_start,
-                  output_count,
-                  worker_col_buffer,
-                  X_zero_point_value);
-            } else {
-              // Use the im2col buffer prepared outside the thread, indexed by group.
-              worker_col_buffer += group_id * col_buffer_size;
-            }
-            worker_gemm_input = worker_col_buffer;
+          const uint8_t* group_input_data = input_data + group_id * group_input_channels;
+
+          const uint8_t* tile_gemm_input;
+          size_t tile_gemm_input_stride;
+          if (use_input_in_place) {
+            tile_gemm_input = group_input_data + output_start * C;
+            tile_gemm_input_stride = static_cast<size_t>(C);
           } else {
-            worker_gemm_input = input_data + output_start * kernel_dim;
+            // Gather the rows of the tile through the indirection table in
+            // place of the im2col transformation.
+            const size_t group_input_bytes = static_cast<size_t>(group_input_channels);
+            uint8_t* row = tile_gemm_input_buffer;
+            for (int64_t i = 0; i < output_count * kernel_size; i++) {
+              if (tile_offsets[i] >= 0) {
+                memcpy(row, group_input_data + tile_offsets[i], group_input_bytes);
+              } else {
+                memset(row, X_zero_point_value, group_input_bytes);
+              }
+              row += group_input_bytes;
+            }
+            tile_gemm_input = tile_gemm_input_buffer;
+            tile_gemm_input_stride = static_cast<size_t>(kernel_dim);
           }
 
           MLAS_GEMM_U8X8_SHAPE_PARAMS gemm_shape;
@@ -507,8 +567,8 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
           gemm_shape.BIsSigned = is_W_signed;
 
           MLAS_GEMM_U8X8_DATA_PARAMS gemm_params;
-          gemm_params.A = worker_gemm_input;
-          gemm_params.lda = static_cast<size_t>(kernel_dim);
+          gemm_params.A = tile_gemm_input;
+          gemm_params.lda = tile_gemm_input_stride;
           gemm_params.ZeroPointA = X_zero_point_value;
           if (packed_W_buffer_) {
             gemm_params.B = static_cast<const int8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_,
@@ -518,21 +578,21 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
             gemm_params.ldb = static_cast<size_t>(M);
           }
           gemm_params.ZeroPointB = &W_zero_point_value;
-          gemm_params.C = worker_gemm_output + group_id * group_output_channels;
+          gemm_params.C = tile_gemm_output + group_id * group_output_channels;
           gemm_params.ldc = static_cast<size_t>(M);
           MlasGemm(gemm_shape, gemm_params, nullptr);
         }
-      }
 
-      MlasRequantizeOutput(
-          worker_gemm_output,
-          worker_requantize_output,
-          Bdata,
-          static_cast<size_t>(output_count),
-          static_cast<size_t>(M),
-          output_scales.data(),
-          output_scales.size() > 1,
-          Y_zero_point_value);
+        MlasRequantizeOutput(
+            tile_gemm_output,
+            tile_requantize_output,
+            Bdata,
+            static_cast<size_t>(output_count),
+            static_cast<size_t>(M),
+            output_scales.data(),
+            output_scales.size() > 1,
+            Y_zero_point_value);
+      }
     };
 
     concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, thread_count, conv_worker);
@@ -4,6 +4,8 @@
 #include "string_normalizer.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #include <codecvt>
@@ -115,21 +117,38 @@ using Utf8Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
 #else
 
 // All others (Linux)
+// The conversion descriptors are opened once per converter, iconv_open is much more
+// expensive than the conversion of a short string.
 class Utf8Converter {
  public:
-  Utf8Converter(const std::string&, const std::wstring&) {}
+  Utf8Converter(const std::string&, const std::wstring&)
+      // Order of arguments is to, from
+      : from_utf8_(iconv_open("WCHAR_T", "UTF-8")),
+        to_utf8_(iconv_open("UTF-8", "WCHAR_T")) {
+  }
+
+  ~Utf8Converter() {
+    if (IsValid(from_utf8_)) {
+      iconv_close(from_utf8_);
+    }
+    if (IsValid(to_utf8_)) {
+      iconv_close(to_utf8_);
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Utf8Converter);
 
   std::wstring from_bytes(const std::string& s) const {
     std::wstring result;
     if (s.empty()) {
       return result;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("WCHAR_T", "UTF-8");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
+    if (!IsValid(from_utf8_)) {
       return wconv_error;
     }
+    auto icvt = from_utf8_;
+    // Reset the conversion state left by a previous failure
+    iconv(icvt, nullptr, nullptr, nullptr, nullptr);
 
     char* iconv_in = const_cast<char*>(s.c_str());
     size_t iconv_in_bytes = s.length();
@@ -147,7 +166,6 @@ class Utf8Converter {
       assert((converted_bytes % sizeof(wchar_t)) == 0);
       result.assign(reinterpret_cast<const wchar_t*>(buffer.get()), converted_bytes / sizeof(wchar_t));
     }
-    iconv_close(icvt);
     return result;
   }
 
@@ -156,12 +174,11 @@ class Utf8Converter {
     if (wstr.empty()) {
       return result;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("UTF-8", "WCHAR_T");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
+    if (!IsValid(to_utf8_)) {
       return conv_error;
     }
+    auto icvt = to_utf8_;
+    iconv(icvt, nullptr, nullptr, nullptr, nullptr);
 
     // I hope this does not modify the incoming buffer
     wchar_t* non_const_in = const_cast<wchar_t*>(wstr.c_str());
@@ -181,9 +198,17 @@ class Utf8Converter {
       size_t converted_len = buffer_len - iconv_out_bytes;
       result.assign(buffer.get(), converted_len);
     }
-    iconv_close(icvt);
     return result;
   }
+
+ private:
+  static bool IsValid(iconv_t icvt) {
+    // CentOS is not happy with -1
+    return std::numeric_limits<iconv_t>::max() != icvt;
+  }
+
+  iconv_t from_utf8_;
+  iconv_t to_utf8_;
 };
 
 #endif  // __APPLE__
@@ -192,10 +217,38 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS
 
 #endif  // MS_VER
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
+// Runs fn on the indices [0, count) in parallel. Each batch gets its own Utf8Converter
+// since the converters are not thread safe. As with a sequential loop, the error returned
+// is the one of the first failing index.
+Status ParallelConvert(OpKernelContext* ctx, size_t count,
+                       const std::function<Status(Utf8Converter& converter, size_t index)>& fn) {
+  // The utf8 conversions and the case change cost a few hundred cycles per string
+  constexpr double cost_per_string = 512.0;
+  OrtMutex error_mutex;
+  size_t error_index = count;
+  Status error;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(count), cost_per_string,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        Utf8Converter converter(conv_error, wconv_error);
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          Status status = fn(converter, static_cast<size_t>(i));
+          if (!status.IsOK()) {
+            std::lock_guard<OrtMutex> lock(error_mutex);
+            if (static_cast<size_t>(i) < error_index) {
+              error_index = static_cast<size_t>(i);
+              error = status;
+            }
+            return;
+          }
+        }
+      });
+  return error;
+}
+
+template <class RandomIter>
+Status CopyCaseAction(RandomIter first, RandomIter end, OpKernelContext* ctx,
                       const Locale& loc,
-                      Utf8Converter& converter,
                       size_t N, size_t C,
                       StringNormalizer::CaseAction caseaction) {
   std::vector<int64_t> output_dims;
@@ -218,23 +271,27 @@ Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->template MutableData<std::string>();
 
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
+  assert(static_cast<size_t>(end - first) == C);
+  if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
+    return ParallelConvert(ctx, C, [&](Utf8Converter& converter, size_t i) {
+      const std::string& s = first[i];
       std::wstring wstr = converter.from_bytes(s);
       if (wstr == wconv_error) {
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
+                      "Input contains invalid utf8 chars at: " + s);
       }
       // In place transform
       loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
-    } else {
-      assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
-    }
+      *(output_data + i) = converter.to_bytes(wstr);
+      return Status::OK();
+    });
+  }
+
+  assert(caseaction == StringNormalizer::NONE);
+  size_t output_idx = 0;
+  while (first != end) {
+    // Simple copy or move if the iterator points to a non-const string
+    *(output_data + output_idx) = std::move(*first);
     ++output_idx;
     ++first;
   }
@@ -320,7 +377,6 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
 
   Status status;
   Locale locale(locale_name_);
-  Utf8Converter converter(conv_error, wconv_error);
   auto const input_data = X->template Data<std::string>();
   using StrRef = std::reference_wrapper<const std::string>;
   if (is_case_sensitive_) {
@@ -336,11 +392,11 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
         }
         ++first;
       }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
+      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale,
                               N, filtered_strings.size(), case_change_action_);
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, N, C, case_change_action_);
     }
   } else {
     if (!wstopwords_.empty()) {
@@ -351,35 +407,43 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       std::vector<std::string> filtered_cased_strings;
       filtered_orignal_strings.reserve(C);
       filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
+      // The strings are converted in parallel, and those which are not stop words
+      // are collected in order afterwards
+      std::vector<std::string> cased_strings(case_change_action_ == NONE ? 0 : C);
+      std::unique_ptr<bool[]> is_stopword = std::make_unique<bool[]>(C);
+      ORT_RETURN_IF_ERROR(ParallelConvert(ctx, C, [&](Utf8Converter& converter, size_t i) {
+        const std::string& s = input_data[i];
         std::wstring wstr = converter.from_bytes(s);
         if (wstr == wconv_error) {
           return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                         "Input contains invalid utf8 chars at: " + s);
         }
         locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
+        is_stopword[i] = wstopwords_.count(wstr) != 0;
+        if (!is_stopword[i] && case_change_action_ != NONE) {
+          cased_strings[i] = converter.to_bytes(wstr);
+        }
+        return Status::OK();
+      }));
+      for (size_t i = 0; i < C; ++i) {
+        if (!is_stopword[i]) {
           if (case_change_action_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
+            filtered_orignal_strings.push_back(std::cref(input_data[i]));
           } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
+            filtered_cased_strings.push_back(std::move(cased_strings[i]));
           }
         }
-        ++first;
       }
       if (case_change_action_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
+        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale,
                                 N, filtered_orignal_strings.size(), NONE);
       } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
+        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale,
                                 N, filtered_cased_strings.size(), NONE);
       }
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, N, C, case_change_action_);
     }
   }
   return status;
@@ -5,9 +5,11 @@
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/ml/string_lookup_table.h"
 
-#include <functional>
-#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <numeric>
 
 namespace onnxruntime {
 
@@ -23,61 +25,96 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
+// NgramTrie is a flattened trie of the n-grams in the pool.
+// Nodes are numbered densely with the root at 0 and every edge (parent, item) -> child
+// lives in a single open addressing table, so walking an n-gram costs one probe into a
+// contiguous array per item instead of a chain of node based hash maps.
+// For (1,2,3) node 2 would be a child of 1 but have id == 0
 // because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
+// String pools are first mapped to token ids so both pool types share the same trie.
+class NgramTrie {
+ public:
+  static constexpr uint32_t kRoot = 0;
+
+  NgramTrie() : ids_(1, 0) {}
+
+  // Sizes the edge table for at most max_edges edges. Must be called before Emplace().
+  void Reserve(size_t max_edges) {
+    ORT_ENFORCE(max_edges < std::numeric_limits<uint32_t>::max(), "Too many n-gram items: ", max_edges);
+    // keep the load factor at or below 3/4
+    size_t capacity = 16;
+    while (capacity * 3 < max_edges * 4) {
+      capacity *= 2;
+    }
+    edges_.assign(capacity, Edge{});
+    mask_ = capacity - 1;
+    ids_.reserve(max_edges + 1);
+  }
 
-template <>
-struct NgramPart<int64_t>;
+  bool Empty() const { return ids_.size() == 1; }
 
-template <>
-struct NgramPart<std::string>;
+  // Returns the child of parent for item, kRoot if there is none.
+  uint32_t Find(uint32_t parent, int64_t item) const {
+    for (size_t pos = Hash(parent, item) & mask_;; pos = (pos + 1) & mask_) {
+      const Edge& edge = edges_[pos];
+      if (edge.child == kRoot || (edge.parent == parent && edge.item == item)) {
+        return edge.child;
+      }
+    }
+  }
 
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
+  // Returns the child of parent for item, adding it if it is not present.
+  uint32_t Emplace(uint32_t parent, int64_t item) {
+    for (size_t pos = Hash(parent, item) & mask_;; pos = (pos + 1) & mask_) {
+      Edge& edge = edges_[pos];
+      if (edge.child == kRoot) {
+        ORT_ENFORCE(ids_.size() < edges_.size(), "n-gram trie capacity exceeded");
+        edge.item = item;
+        edge.parent = parent;
+        edge.child = static_cast<uint32_t>(ids_.size());
+        ids_.push_back(0);
+        return edge.child;
+      }
+      if (edge.parent == parent && edge.item == item) {
+        return edge.child;
+      }
+    }
+  }
 
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
+  // 0 - means no entry, search for a bigger N
+  size_t Id(uint32_t node) const { return ids_[node]; }
+  void SetId(uint32_t node, size_t id) { ids_[node] = id; }
 
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+ private:
+  struct Edge {
+    int64_t item = 0;
+    uint32_t parent = 0;
+    uint32_t child = kRoot;  // the root is never a child, so kRoot marks an empty slot
+  };
 
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+  static size_t Hash(uint32_t parent, int64_t item) {
+    uint64_t h = static_cast<uint64_t>(item) * 0x9E3779B97F4A7C15ULL ^ (uint64_t{parent} * 0xC2B2AE3D27D4EB4FULL);
+    h ^= h >> 29;
+    return static_cast<size_t>(h);
+  }
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+  std::vector<Edge> edges_;
+  size_t mask_ = 0;
+  std::vector<size_t> ids_;
 };
 
 // Returns next ngram_id
-template <class K, class ForwardIter, class Map>
+template <class ForwardIter, class ItemFn>
 inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
+                            NgramTrie& trie, ItemFn item_of) {
   for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
+    uint32_t node = NgramTrie::kRoot;
+    for (size_t n = 0; n < ngram_size; ++n, ++first) {
+      node = trie.Emplace(node, item_of(*first));
     }
+    ORT_ENFORCE(trie.Id(node) == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+    trie.SetId(node, ngram_id);
+    ++ngram_id;
   }
   return ngram_id;
 }
@@ -89,9 +126,8 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
+// Rows shorter than twice this are never split between threads.
+constexpr size_t kMinStartPositionsPerBlock = 1024;
 
 // The weighting criteria.
 // "TF"(term frequency),
@@ -127,11 +163,11 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float>   weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // Maps pool_strings entries to the token ids stored in the trie
+  ml::StringLookupTable<int64_t> tokens_;
+  bool string_pool_ = false;
+  // Contains pool_strings or pool_int64s n-grams
+  NgramTrie trie_;
 
   size_t output_size_ = 0;
 
@@ -140,14 +176,47 @@ struct TfIdfVectorizer::Impl {
   Impl(const Impl&) = delete;
   Impl& operator=(const Impl&) = delete;
 
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
-    assert(ngram_id != 0);
-    --ngram_id;
-    assert(ngram_id < ngram_indexes_.size());
-    auto output_idx = row_num * output_size_ + ngram_indexes_[ngram_id];
-    assert(static_cast<size_t>(output_idx) < frequencies.size());
-    ++frequencies[output_idx];
+  // Counts the n-grams that start at [start_first, start_last) within a row
+  // and calls on_hit with the ngram_indexes_ entry of each one.
+  template <typename T, typename OnHit>
+  void ComputeRow(const T* row_begin, const T* row_end, size_t start_first, size_t start_last,
+                  OnHit&& on_hit) const {
+    const auto max_gram_length = max_gram_length_;
+    const auto max_skip_distance = max_skip_count_ + 1;  // Convert to distance
+    auto start_ngram_size = min_gram_length_;
+
+    for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+      for (const T* ngram_start = row_begin + start_first; ngram_start < row_begin + start_last; ++ngram_start) {
+        // We went far enough so no n-grams of any size can be gathered
+        if (row_end - ngram_start <= skip_distance * (start_ngram_size - 1)) {
+          break;
+        }
+
+        uint32_t node = NgramTrie::kRoot;
+        const T* ngram_item = ngram_start;
+        for (auto ngram_size = 1;
+             ngram_size <= max_gram_length;
+             ++ngram_size, ngram_item += skip_distance) {
+          node = trie_.Find(node, static_cast<int64_t>(*ngram_item));
+          if (node == NgramTrie::kRoot) {
+            break;
+          }
+          const size_t ngram_id = trie_.Id(node);
+          if (ngram_size >= start_ngram_size && ngram_id != 0) {
+            assert(ngram_id - 1 < ngram_indexes_.size());
+            on_hit(static_cast<size_t>(ngram_indexes_[ngram_id - 1]));
+          }
+          if (row_end - ngram_item <= skip_distance) {
+            break;
+          }
+        }
+      }
+      // We count UniGrams only once since they are not affected
+      // by skip distance
+      if (start_ngram_size == 1 && ++start_ngram_size > max_gram_length) {
+        break;
+      }
+    }
   }
 };
 
@@ -219,6 +288,19 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
   const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
+  impl_->trie_.Reserve(total_items);
+  impl_->string_pool_ = !pool_strings.empty();
+  if (impl_->string_pool_) {
+    // Identical strings share the token id of their last position in the pool
+    std::vector<std::string> pool(pool_strings.cbegin(), pool_strings.cend());
+    std::vector<int64_t> positions(pool.size());
+    std::iota(positions.begin(), positions.end(), int64_t{0});
+    impl_->tokens_ = ml::StringLookupTable<int64_t>(pool, positions);
+  }
+  const auto& tokens = impl_->tokens_;
+  auto token_of = [&tokens](const std::string& str) { return *tokens.Find(str); };
+  auto item_of = [](int64_t item) { return item; };
+
   size_t ngram_id = 1;  // start with 1, 0 - means no n-gram
   // Load into dictionary only required gram sizes
   const size_t min_gram_length = impl_->min_gram_length_;
@@ -234,12 +316,12 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       ORT_ENFORCE((items % ngram_size == 0),
                   "Number of items must compose whole ", std::to_string(ngram_size), "-grams");
       auto ngrams = items / ngram_size;
-      // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
+      // Skip loading into the trie ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->trie_, item_of);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = PopulateGrams(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->trie_, token_of);
         }
       } else {
         ngram_id += ngrams;
@@ -310,73 +392,56 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
   }
 }
 
-void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
+template <typename T>
+void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, const T* input, size_t num_rows, size_t row_size,
                                   std::vector<uint32_t>& frequencies) const {
-  auto X = ctx->Input<Tensor>(0);
-  const auto elem_size = X->DataType()->Size();
-
-  const void* const row_begin = AdvanceElementPtr(X->DataRaw(), row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
-
   const auto& impl = *impl_;
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
-
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
-      // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, skip_distance * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
-        break;
-      }
+  const size_t output_size = impl.output_size_;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // Rows are independent, so when there are enough of them each task owns whole rows and counts directly
+  // into its slice of frequencies. Otherwise long rows are also split by ngram start position; every block
+  // then records its hits separately and the hits are added to the row afterwards.
+  const size_t degree_of_parallelism = static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(tp));
+  size_t blocks_per_row = 1;
+  if (num_rows < degree_of_parallelism && row_size >= 2 * kMinStartPositionsPerBlock) {
+    blocks_per_row = std::min((degree_of_parallelism + num_rows - 1) / num_rows,
+                              row_size / kMinStartPositionsPerBlock);
+  }
 
-      auto ngram_item = ngram_start;
-      if (X->IsDataTypeString()) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          str_map = &hit->second->leafs_;
-        }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (X->IsDataType<int32_t>()) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          int_map = &hit->second->leafs_;
-        }
-      }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
-    }
-    // We count UniGrams only once since they are not affected
-    // by skip distance
-    if (start_ngram_size == 1 && ++start_ngram_size > max_gram_length) {
-      break;
+  if (blocks_per_row == 1) {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        tp, static_cast<ptrdiff_t>(num_rows),
+        [&impl, input, row_size, output_size, &frequencies](ptrdiff_t row_num) {
+          const T* row_begin = input + row_num * row_size;
+          uint32_t* row_frequencies = frequencies.data() + row_num * output_size;
+          impl.ComputeRow(row_begin, row_begin + row_size, 0, row_size,
+                          [row_frequencies](size_t output_idx) { ++row_frequencies[output_idx]; });
+        },
+        0);
+    return;
+  }
+
+  const size_t block_size = (row_size + blocks_per_row - 1) / blocks_per_row;
+  std::vector<std::vector<uint32_t>> block_hits(num_rows * blocks_per_row);
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, static_cast<ptrdiff_t>(block_hits.size()),
+      [&impl, input, row_size, blocks_per_row, block_size, &block_hits](ptrdiff_t block_num) {
+        const size_t row_num = block_num / blocks_per_row;
+        const size_t start_first = (block_num % blocks_per_row) * block_size;
+        const size_t start_last = std::min(start_first + block_size, row_size);
+        const T* row_begin = input + row_num * row_size;
+        auto& hits = block_hits[block_num];
+        impl.ComputeRow(row_begin, row_begin + row_size, start_first, start_last,
+                        [&hits](size_t output_idx) { hits.push_back(static_cast<uint32_t>(output_idx)); });
+      },
+      0);
+
+  for (size_t block_num = 0; block_num < block_hits.size(); ++block_num) {
+    uint32_t* row_frequencies = frequencies.data() + (block_num / blocks_per_row) * output_size;
+    for (auto output_idx : block_hits[block_num]) {
+      ++row_frequencies[output_idx];
     }
   }
 }
@@ -416,9 +481,7 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   std::vector<uint32_t> frequencies;
   frequencies.resize(num_rows * impl_->output_size_, 0);
 
-  if (total_items == 0 ||
-      (X->IsDataTypeString() && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+  if (total_items == 0 || impl_->trie_.Empty() || X->IsDataTypeString() != impl_->string_pool_) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
@@ -428,11 +491,26 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  std::function<void(ptrdiff_t)> fn = [this, ctx, C, &frequencies](ptrdiff_t row_num) {
-    ComputeImpl(ctx, row_num, C, frequencies);
-  };
-
-  concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), num_rows, std::move(fn), 0);
+  if (X->IsDataTypeString()) {
+    // Look up every string once. Strings that are not in the pool get an id that is never in the trie.
+    const auto& tokens = impl_->tokens_;
+    const std::string* input = X->Data<std::string>();
+    std::vector<int64_t> token_ids(total_items);
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), static_cast<ptrdiff_t>(total_items),
+        TensorOpCost{static_cast<double>(sizeof(std::string)), static_cast<double>(sizeof(int64_t)), 64.0},
+        [&tokens, input, &token_ids](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t i = first; i < last; ++i) {
+            const int64_t* token = tokens.Find(input[i]);
+            token_ids[i] = token == nullptr ? -1 : *token;
+          }
+        });
+    ComputeImpl(ctx, token_ids.data(), num_rows, C, frequencies);
+  } else if (X->IsDataType<int32_t>()) {
+    ComputeImpl(ctx, X->Data<int32_t>(), num_rows, C, frequencies);
+  } else {
+    ComputeImpl(ctx, X->Data<int64_t>(), num_rows, C, frequencies);
+  }
 
   OutputResult(ctx, B, frequencies);
 
@@ -13,8 +13,10 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
+#include "core/platform/threadpool.h"
 //TODO:fix the warnings
 #ifdef _MSC_VER
 #pragma warning(disable : 4244)
@@ -114,6 +116,148 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+// The corners and the area of the boxes of a batch in separate arrays (SoA), so the IoU of a box
+// against a run of other boxes is computed with contiguous loads that the compiler can vectorize.
+struct BoxCorners {
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+
+  void Resize(size_t count) {
+    x_min.resize(count);
+    y_min.resize(count);
+    x_max.resize(count);
+    y_max.resize(count);
+    area.resize(count);
+  }
+
+  // Same arithmetic as nms_helpers::SuppressByIOU, so the same boxes are suppressed.
+  void Set(size_t index, const float* box, int64_t center_point_box) {
+    float box_x_min{};
+    float box_y_min{};
+    float box_x_max{};
+    float box_y_max{};
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2]
+      MaxMin(box[1], box[3], box_x_min, box_x_max);
+      MaxMin(box[0], box[2], box_y_min, box_y_max);
+    } else {
+      // boxes data format [x_center, y_center, width, height]
+      float width_half = box[2] / 2;
+      float height_half = box[3] / 2;
+      box_x_min = box[0] - width_half;
+      box_x_max = box[0] + width_half;
+      box_y_min = box[1] - height_half;
+      box_y_max = box[1] + height_half;
+    }
+    x_min[index] = box_x_min;
+    y_min[index] = box_y_min;
+    x_max[index] = box_x_max;
+    y_max[index] = box_y_max;
+    area[index] = (box_x_max - box_x_min) * (box_y_max - box_y_min);
+  }
+
+  void Copy(size_t index, const BoxCorners& other, size_t other_index) {
+    x_min[index] = other.x_min[other_index];
+    y_min[index] = other.y_min[other_index];
+    x_max[index] = other.x_max[other_index];
+    y_max[index] = other.y_max[other_index];
+    area[index] = other.area[other_index];
+  }
+};
+
+// Number of selected boxes whose IoU with a candidate is computed before checking for suppression.
+constexpr size_t kIoUBlockSize = 16;
+
+// Returns true if any of the first `count` boxes of `selected` overlaps box `index` of `boxes` by more than
+// `iou_threshold`. The IoU is computed branch free against blocks of the selected boxes.
+bool SuppressedBySelected(const BoxCorners& boxes, size_t index, const BoxCorners& selected, size_t count,
+                          float iou_threshold) {
+  const float x_min = boxes.x_min[index];
+  const float y_min = boxes.y_min[index];
+  const float x_max = boxes.x_max[index];
+  const float y_max = boxes.y_max[index];
+  const float area = boxes.area[index];
+
+  for (size_t block_start = 0; block_start < count; block_start += kIoUBlockSize) {
+    const size_t block_end = std::min(count, block_start + kIoUBlockSize);
+    int suppressed = 0;
+    for (size_t i = block_start; i < block_end; ++i) {
+      const float intersection_width = std::min(x_max, selected.x_max[i]) - std::max(x_min, selected.x_min[i]);
+      const float intersection_height = std::min(y_max, selected.y_max[i]) - std::max(y_min, selected.y_min[i]);
+      const float intersection_area = intersection_width * intersection_height;
+      const float union_area = area + selected.area[i] - intersection_area;
+      suppressed |= static_cast<int>(intersection_width > .0f) & static_cast<int>(intersection_height > .0f) &
+                    static_cast<int>(intersection_area > .0f) & static_cast<int>(area > .0f) &
+                    static_cast<int>(selected.area[i] > .0f) & static_cast<int>(union_area > .0f) &
+                    static_cast<int>(intersection_area / union_area > iou_threshold);
+    }
+    if (suppressed) {
+      return true;
+    }
+  }
+  return false;
+}
+
+struct ScoreIndex {
+  float score_;
+  int64_t index_;
+};
+
+// Higher scores first, the lower box index first among equal scores.
+inline bool HigherScore(const ScoreIndex& lhs, const ScoreIndex& rhs) {
+  return lhs.score_ > rhs.score_ || (lhs.score_ == rhs.score_ && lhs.index_ < rhs.index_);
+}
+
+// Greedy selection for one (batch, class) pair. The candidates are ordered by score one block at a time
+// (nth_element to split off the block, then sorting only the block), so the candidates that can't be reached
+// once max_output_boxes_per_class boxes are selected are never sorted.
+void SelectBoxesOfClass(const float* class_scores, int64_t num_boxes, bool use_score_threshold, float score_threshold,
+                        int64_t max_output_boxes_per_class, float iou_threshold, const BoxCorners& boxes,
+                        int64_t batch_index, int64_t class_index, std::vector<SelectedIndex>& selected_indices) {
+  std::vector<ScoreIndex> candidates;
+  candidates.reserve(static_cast<size_t>(num_boxes));
+  for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+    if (!use_score_threshold || class_scores[box_index] > score_threshold) {
+      candidates.push_back({class_scores[box_index], box_index});
+    }
+  }
+
+  const size_t max_selected = static_cast<size_t>(std::min<int64_t>(max_output_boxes_per_class,
+                                                                    static_cast<int64_t>(candidates.size())));
+  BoxCorners selected;
+  selected.Resize(max_selected);
+  size_t num_selected = 0;
+
+  // The first block is sized for the case where few candidates are suppressed, later blocks double.
+  size_t block_size = std::max<size_t>(max_selected * 2, 64);
+  auto block_begin = candidates.begin();
+  while (block_begin != candidates.end() && num_selected < max_selected) {
+    auto block_end = block_begin + std::min<size_t>(block_size, candidates.end() - block_begin);
+    if (block_end != candidates.end()) {
+      std::nth_element(block_begin, block_end, candidates.end(), HigherScore);
+    }
+    std::sort(block_begin, block_end, HigherScore);
+
+    for (auto candidate = block_begin; candidate != block_end && num_selected < max_selected; ++candidate) {
+      const size_t box_index = static_cast<size_t>(candidate->index_);
+      if (!SuppressedBySelected(boxes, box_index, selected, num_selected, iou_threshold)) {
+        selected.Copy(num_selected++, boxes, box_index);
+        selected_indices.emplace_back(batch_index, class_index, candidate->index_);
+      }
+    }
+
+    block_begin = block_end;
+    block_size *= 2;
+  }
+}
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -131,75 +275,58 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
-
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
-
   const auto center_point_box = GetCenterPointBox();
+  const size_t num_boxes = static_cast<size_t>(pc.num_boxes_);
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
+  // The corners of the boxes of a batch are shared by all of its classes.
+  std::vector<BoxCorners> batch_boxes(static_cast<size_t>(pc.num_batches_));
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
-        }
+    auto& boxes = batch_boxes[batch_index];
+    boxes.Resize(num_boxes);
+    const float* batch_boxes_data = boxes_data + batch_index * num_boxes * 4;
+    for (size_t box_index = 0; box_index < num_boxes; ++box_index) {
+      boxes.Set(box_index, batch_boxes_data + box_index * 4, center_point_box);
+    }
+  }
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+  // The (batch, class) pairs are independent, each one selects into its own list and the lists are
+  // concatenated in order so the output doesn't depend on the threading.
+  const std::ptrdiff_t num_batch_classes = static_cast<std::ptrdiff_t>(pc.num_batches_ * pc.num_classes_);
+  std::vector<std::vector<SelectedIndex>> selected_per_batch_class(num_batch_classes);
+  const bool use_score_threshold = pc.score_threshold_ != nullptr;
+
+  // The work of a class depends on how many of its boxes pass the score threshold and survive the suppression,
+  // so the classes are handed out with guided scheduling. The cost is a rough estimate for sorting the scores and
+  // comparing the candidates.
+  const TensorOpCost batch_class_cost{static_cast<double>(pc.num_boxes_ * sizeof(float)),
+                                      0.0,
+                                      static_cast<double>(pc.num_boxes_) * 32.0};
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_batch_classes, batch_class_cost,
+      concurrency::ThreadPool::LoopScheduling::Guided,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t batch_class_index = first; batch_class_index < last; ++batch_class_index) {
+          const int64_t batch_index = batch_class_index / pc.num_classes_;
+          const int64_t class_index = batch_class_index % pc.num_classes_;
+          SelectBoxesOfClass(scores_data + batch_class_index * pc.num_boxes_, pc.num_boxes_, use_score_threshold,
+                             score_threshold, max_output_boxes_per_class, iou_threshold, batch_boxes[batch_index],
+                             batch_index, class_index, selected_per_batch_class[batch_class_index]);
         }
-        sorted_boxes.pop();
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+      });
+
+  size_t num_selected = 0;
+  for (const auto& selected : selected_per_batch_class) {
+    num_selected += selected.size();
+  }
 
   const auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (const auto& selected : selected_per_batch_class) {
+    output_data = std::copy(selected.cbegin(), selected.cend(), output_data);
+  }
 
   return Status::OK();
 }
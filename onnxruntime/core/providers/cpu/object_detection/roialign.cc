@@ -20,6 +20,8 @@
 #include <cmath>
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
@@ -136,100 +138,241 @@ static void PreCalcForBilinearInterpolate(const int64_t height, const int64_t wi
   }
 }
 
+// Where the samples of the bins of a ROI are taken.
 template <typename T>
-void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, float spatial_scale, int64_t height,
-                     int64_t width, int64_t sampling_ratio, const T* bottom_rois, int64_t num_roi_cols, T* top_data,
-                     RoiAlignMode mode, const int64_t* batch_indices_ptr, ThreadPool* ttp) {
+struct RoiGeometry {
+  int64_t batch_index;
+  T roi_start_h;
+  T roi_start_w;
+  T bin_size_h;
+  T bin_size_w;
+  int64_t roi_bin_grid_h;
+  int64_t roi_bin_grid_w;
+};
+
+template <typename T>
+RoiGeometry<T> GetRoiGeometry(const T* bottom_rois, int64_t num_roi_cols, const int64_t* batch_indices_ptr, int64_t n,
+                              float spatial_scale, int64_t pooled_height, int64_t pooled_width,
+                              int64_t sampling_ratio) {
+  const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+  RoiGeometry<T> roi;
+  roi.batch_index = batch_indices_ptr[n];
+
+  // Do not using rounding; this implementation detail is critical
+  roi.roi_start_w = offset_bottom_rois[0] * spatial_scale;
+  roi.roi_start_h = offset_bottom_rois[1] * spatial_scale;
+  T roi_end_w = offset_bottom_rois[2] * spatial_scale;
+  T roi_end_h = offset_bottom_rois[3] * spatial_scale;
+
+  // Force malformed ROIs to be 1x1
+  T roi_width = std::max(roi_end_w - roi.roi_start_w, (T)1.);
+  T roi_height = std::max(roi_end_h - roi.roi_start_h, (T)1.);
+  roi.bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
+  roi.bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
+
+  // We use roi_bin_grid to sample the grid and mimic integral
+  roi.roi_bin_grid_h = (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
+  roi.roi_bin_grid_w =
+      (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
+  return roi;
+}
+
+// Pools the channels [c_begin, c_end) of a ROI from NCHW input, one channel at a time.
+template <typename T>
+void RoiAlignChannelsFirst(const T* bottom_data, int64_t channels, int64_t height, int64_t width,
+                           int64_t pooled_height, int64_t pooled_width, const RoiGeometry<T>& roi,
+                           const std::vector<PreCalc<T>>& pre_calc, RoiAlignMode mode, int64_t c_begin, int64_t c_end,
+                           T* top_data_n) {
+  const int64_t roi_bin_grid_h = roi.roi_bin_grid_h;
+  const int64_t roi_bin_grid_w = roi.roi_bin_grid_w;
+
+  // We do average (integral) pooling inside a bin
+  const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
+
+  for (int64_t c = c_begin; c < c_end; c++) {
+    int64_t index_n_c = c * pooled_width * pooled_height;
+    const T* offset_bottom_data =
+        bottom_data + static_cast<int64_t>((roi.batch_index * channels + c) * height * width);
+    int64_t pre_calc_index = 0;
+
+    for (int64_t ph = 0; ph < pooled_height; ph++) {
+      for (int64_t pw = 0; pw < pooled_width; pw++) {
+        int64_t index = index_n_c + ph * pooled_width + pw;
+
+        T output_val = 0.;
+        if (mode == RoiAlignMode::avg) {  // avg pooling
+          for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
+            for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
+              const auto& pc = pre_calc[pre_calc_index];
+              output_val += pc.w1 * offset_bottom_data[pc.pos1] + pc.w2 * offset_bottom_data[pc.pos2] +
+                            pc.w3 * offset_bottom_data[pc.pos3] + pc.w4 * offset_bottom_data[pc.pos4];
+
+              pre_calc_index += 1;
+            }
+          }
+          output_val /= count;
+        } else {  // max pooling
+          bool max_flag = false;
+          for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
+            for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
+              const auto& pc = pre_calc[pre_calc_index];
+              T val = std::max(
+                  std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
+                           pc.w3 * offset_bottom_data[pc.pos3]),
+                  pc.w4 * offset_bottom_data[pc.pos4]);
+              if (!max_flag) {
+                output_val = val;
+                max_flag = true;
+              } else {
+                output_val = std::max(output_val, val);
+              }
+
+              pre_calc_index += 1;
+            }
+          }
+        }
+
+        top_data_n[index] = output_val;
+      }  // for pw
+    }    // for ph
+  }      // for c
+}
+
+// Pools the channels [c_begin, c_end) of a ROI from NHWC input, with each sample accumulated for all the channels
+// at once.
+template <typename T>
+void RoiAlignChannelsLast(const T* bottom_data_nhwc, int64_t channels, int64_t height, int64_t width,
+                          int64_t pooled_height, int64_t pooled_width, const RoiGeometry<T>& roi,
+                          const std::vector<PreCalc<T>>& pre_calc, RoiAlignMode mode, int64_t c_begin, int64_t c_end,
+                          T* output_buffer, T* top_data_n) {
+  const int64_t block_channels = c_end - c_begin;
+  const int64_t count = roi.roi_bin_grid_h * roi.roi_bin_grid_w;
+  const T* offset_bottom_data = bottom_data_nhwc + roi.batch_index * height * width * channels + c_begin;
+  EigenVectorArrayMap<T> output_val(output_buffer, block_channels);
+  const PreCalc<T>* pc = pre_calc.data();
+
+  for (int64_t ph = 0; ph < pooled_height; ph++) {
+    for (int64_t pw = 0; pw < pooled_width; pw++) {
+      if (mode == RoiAlignMode::avg) {  // avg pooling
+        output_val.setZero();
+        for (int64_t i = 0; i < count; i++, pc++) {
+          output_val += pc->w1 * ConstEigenVectorArrayMap<T>(offset_bottom_data + pc->pos1 * channels, block_channels) +
+                        pc->w2 * ConstEigenVectorArrayMap<T>(offset_bottom_data + pc->pos2 * channels, block_channels) +
+                        pc->w3 * ConstEigenVectorArrayMap<T>(offset_bottom_data + pc->pos3 * channels, block_channels) +
+                        pc->w4 * ConstEigenVectorArrayMap<T>(offset_bottom_data + pc->pos4 * channels, block_channels);
+        }
+        output_val /= static_cast<T>(count);
+      } else {  // max pooling
+        for (int64_t i = 0; i < count; i++, pc++) {
+          auto val = (pc->w1 * ConstEigenVectorArrayMap<T>(offset_bottom_data + pc->pos1 * channels, block_channels))
+                         .max(pc->w2 * ConstEigenVectorArrayMap<T>(offset_bottom_data + pc->pos2 * channels, block_channels))
+                         .max(pc->w3 * ConstEigenVectorArrayMap<T>(offset_bottom_data + pc->pos3 * channels, block_channels))
+                         .max(pc->w4 * ConstEigenVectorArrayMap<T>(offset_bottom_data + pc->pos4 * channels, block_channels));
+          if (i == 0) {
+            output_val = val;
+          } else {
+            output_val = output_val.max(val);
+          }
+        }
+      }
+
+      T* top_data = top_data_n + c_begin * pooled_height * pooled_width + ph * pooled_width + pw;
+      for (int64_t c = 0; c < block_channels; c++) {
+        top_data[c * pooled_height * pooled_width] = output_buffer[c];
+      }
+    }  // for pw
+  }    // for ph
+}
+
+// The channels of a ROI are pooled in blocks of this many channels, so that a few ROIs with many channels still
+// spread over the threads.
+constexpr int64_t kRoiAlignChannelBlock = 64;
+
+template <typename T>
+void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, int64_t batch_size, float spatial_scale,
+                     int64_t height, int64_t width, int64_t sampling_ratio, const T* bottom_rois,
+                     int64_t num_roi_cols, T* top_data, RoiAlignMode mode, const int64_t* batch_indices_ptr,
+                     const AllocatorPtr& allocator, ThreadPool* ttp) {
   int64_t n_rois = output_shape[0];
   int64_t channels = output_shape[1];
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
 
-  //100 is a random chosed value, need be tuned
-  double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
-
-  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
-    for (; n != end; ++n) {
-      int64_t index_n = n * channels * pooled_width * pooled_height;
-
-      const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
-      const auto roi_batch_ind = batch_indices_ptr[n];
-
-      // Do not using rounding; this implementation detail is critical
-      T roi_start_w = offset_bottom_rois[0] * spatial_scale;
-      T roi_start_h = offset_bottom_rois[1] * spatial_scale;
-      T roi_end_w = offset_bottom_rois[2] * spatial_scale;
-      T roi_end_h = offset_bottom_rois[3] * spatial_scale;
-
-      // Force malformed ROIs to be 1x1
-      T roi_width = std::max(roi_end_w - roi_start_w, (T)1.);
-      T roi_height = std::max(roi_end_h - roi_start_h, (T)1.);
-      T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
-      T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
-
-      // We use roi_bin_grid to sample the grid and mimic integral
-      int64_t roi_bin_grid_h = (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
-      int64_t roi_bin_grid_w =
-          (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
-
-      // We do average (integral) pooling inside a bin
-      const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
-
-      // we want to precalculate indices and weights shared by all channels,
-      // this is the key point of optimization
-      std::vector<PreCalc<T>> pre_calc(roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
-      PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
-                                    roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
-                                    roi_bin_grid_w, pre_calc);
-
-      for (int64_t c = 0; c < channels; c++) {
-        int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-        const T* offset_bottom_data =
-            bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-        int64_t pre_calc_index = 0;
-
-        for (int64_t ph = 0; ph < pooled_height; ph++) {
-          for (int64_t pw = 0; pw < pooled_width; pw++) {
-            int64_t index = index_n_c + ph * pooled_width + pw;
-
-            T output_val = 0.;
-            if (mode == RoiAlignMode::avg) {  // avg pooling
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[pre_calc_index];
-                  output_val += pc.w1 * offset_bottom_data[pc.pos1] + pc.w2 * offset_bottom_data[pc.pos2] +
-                                pc.w3 * offset_bottom_data[pc.pos3] + pc.w4 * offset_bottom_data[pc.pos4];
-
-                  pre_calc_index += 1;
-                }
-              }
-              output_val /= count;
-            } else {  // max pooling
-              bool max_flag = false;
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[pre_calc_index];
-                  T val = std::max(
-                      std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
-                               pc.w3 * offset_bottom_data[pc.pos3]),
-                      pc.w4 * offset_bottom_data[pc.pos4]);
-                  if (!max_flag) {
-                    output_val = val;
-                    max_flag = true;
-                  } else {
-                    output_val = std::max(output_val, val);
-                  }
-
-                  pre_calc_index += 1;
-                }
-              }
-            }
+  double samples = 0.;
+  for (int64_t n = 0; n < n_rois; n++) {
+    auto roi = GetRoiGeometry(bottom_rois, num_roi_cols, batch_indices_ptr, n, spatial_scale, pooled_height,
+                              pooled_width, sampling_ratio);
+    samples += static_cast<double>(roi.roi_bin_grid_h * roi.roi_bin_grid_w);
+  }
+  samples *= static_cast<double>(pooled_height * pooled_width);
+
+  // Each sample reads 4 values of every channel, which are contiguous in NHWC so that the samples can be
+  // accumulated for a block of channels at once. The input is transposed to NHWC when there are at least as many
+  // samples as input positions to make up for the copy.
+  const bool channels_last = channels > 1 && samples >= static_cast<double>(batch_size * height * width);
+  BufferUniquePtr nhwc_buffer;
+  const T* bottom_data_nhwc = nullptr;
+  if (channels_last) {
+    const int64_t image_size = height * width;
+    nhwc_buffer = BufferUniquePtr(allocator->Alloc(SafeInt<size_t>(batch_size) * image_size * channels * sizeof(T)),
+                                  BufferDeleter(allocator));
+    T* nhwc = static_cast<T*>(nhwc_buffer.get());
+    ThreadPool::TryParallelFor(
+        ttp, static_cast<ptrdiff_t>(batch_size * image_size),
+        TensorOpCost{static_cast<double>(channels * sizeof(T)), static_cast<double>(channels * sizeof(T)), 0.},
+        [&](ptrdiff_t first, ptrdiff_t last) {
+          while (first < last) {
+            const int64_t b = first / image_size;
+            const int64_t hw = first % image_size;
+            const int64_t len = std::min<int64_t>(last - first, image_size - hw);
+            EigenMatrixMapRowMajor<T>(nhwc + first * channels, len, channels) =
+                ConstEigenMatrixMapRowMajorOuterStride<T>(bottom_data + b * channels * image_size + hw, channels, len,
+                                                          Eigen::OuterStride<>(image_size))
+                    .transpose();
+            first += len;
+          }
+        });
+    bottom_data_nhwc = nhwc;
+  }
+
+  const int64_t block_size = channels_last ? kRoiAlignChannelBlock : channels;
+  const int64_t num_blocks = (channels + block_size - 1) / block_size;
+  const double cost = samples / static_cast<double>(n_rois) * static_cast<double>(std::min(block_size, channels)) * 8;
+
+  // Each range of (ROI, channel block) units computes the sampling table of a ROI once for all its blocks.
+  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois * num_blocks), cost, [&](ptrdiff_t first, ptrdiff_t last) {
+    std::vector<PreCalc<T>> pre_calc;
+    std::vector<T> output_buffer(channels_last ? static_cast<size_t>(std::min(block_size, channels)) : 0);
+    RoiGeometry<T> roi{};
+    int64_t pre_calc_n = -1;
+
+    for (ptrdiff_t unit = first; unit != last; ++unit) {
+      const int64_t n = unit / num_blocks;
+      const int64_t c_begin = (unit % num_blocks) * block_size;
+      const int64_t c_end = std::min(c_begin + block_size, channels);
+
+      if (n != pre_calc_n) {
+        roi = GetRoiGeometry(bottom_rois, num_roi_cols, batch_indices_ptr, n, spatial_scale, pooled_height,
+                             pooled_width, sampling_ratio);
+
+        // we want to precalculate indices and weights shared by all channels,
+        // this is the key point of optimization
+        pre_calc.resize(roi.roi_bin_grid_h * roi.roi_bin_grid_w * pooled_width * pooled_height);
+        PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi.roi_bin_grid_h,
+                                      roi.roi_bin_grid_w, roi.roi_start_h, roi.roi_start_w, roi.bin_size_h,
+                                      roi.bin_size_w, roi.roi_bin_grid_h, roi.roi_bin_grid_w, pre_calc);
+        pre_calc_n = n;
+      }
 
-            top_data[index] = output_val;
-          }  // for pw
-        }    // for ph
-      }      // for c
-    }        // for n
+      T* top_data_n = top_data + n * channels * pooled_width * pooled_height;
+      if (channels_last) {
+        RoiAlignChannelsLast(bottom_data_nhwc, channels, height, width, pooled_height, pooled_width, roi, pre_calc,
+                             mode, c_begin, c_end, output_buffer.data(), top_data_n);
+      } else {
+        RoiAlignChannelsFirst(bottom_data, channels, height, width, pooled_height, pooled_width, roi, pre_calc,
+                              mode, c_begin, c_end, top_data_n);
+      }
+    }
   });
 }
 }  // namespace
@@ -294,11 +437,18 @@ Status RoiAlign<T>::Compute(OpKernelContext* context) const {
 
   auto& Y = *context->Output(0, {num_rois, num_channels, this->output_height_, this->output_width_});
 
-  RoiAlignForward<T>(Y.Shape(), X_ptr->Data<T>(), this->spatial_scale_,
+  if (num_rois == 0 || num_channels == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  RoiAlignForward<T>(Y.Shape(), X_ptr->Data<T>(), x_dims[0], this->spatial_scale_,
                      x_dims[2],  // height
                      x_dims[3],  // width
                      this->sampling_ratio_, rois_ptr->Data<T>(), num_roi_cols, Y.template MutableData<T>(), this->mode_,
-                     batch_indices_ptr->Data<int64_t>(), context->GetOperatorThreadPool());
+                     batch_indices_ptr->Data<int64_t>(), allocator, context->GetOperatorThreadPool());
 
   return Status::OK();
 }
@@ -283,6 +283,31 @@ TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int64_t elemen
                       static_cast<double>(n_col * n_row * element_size * 2)};
 }
 
+// Below these sizes, splitting a fast reduction further costs more than it saves.
+static constexpr int64_t kFastReduceMinElementsToSplit = 16384;
+static constexpr int64_t kFastReduceMinRowsPerBlock = 16;
+static constexpr int64_t kFastReduceMinBytesPerBlock = 256;
+
+int64_t ParallelReduceFastRowBlocks(concurrency::ThreadPool* tp, int64_t n_rows, int64_t n_cols, int64_t element_size) {
+  int64_t dop = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  if (dop <= 1 || n_rows < 2 * kFastReduceMinRowsPerBlock || n_rows * n_cols < kFastReduceMinElementsToSplit)
+    return 1;
+  // Every thread already gets a wide enough slice of the kept columns.
+  if (n_cols * element_size >= dop * kFastReduceMinBytesPerBlock * 4)
+    return 1;
+  return std::min(dop, n_rows / kFastReduceMinRowsPerBlock);
+}
+
+int64_t ParallelReduceFastColumnBlocks(concurrency::ThreadPool* tp, int64_t n_outer, int64_t n_red,
+                                       int64_t n_cols, int64_t element_size) {
+  int64_t dop = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  if (dop <= 1 || n_outer >= dop || n_outer * n_red * n_cols < kFastReduceMinElementsToSplit)
+    return 1;
+  int64_t n_blocks = (dop + n_outer - 1) / n_outer;
+  return std::max(static_cast<int64_t>(1),
+                  std::min(n_blocks, n_cols * element_size / kFastReduceMinBytesPerBlock));
+}
+
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  const std::vector<int64_t>& reduced_axes,
                                  ResultsNoTransposePrepareForReduce& results) {
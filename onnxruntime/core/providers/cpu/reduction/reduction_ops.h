@@ -37,6 +37,131 @@ bool IsFastReduceKindAvailable(FastReduceKind scenario, FastReduceKind available
 /* Evaluate the cost of parallelized FastReduce implementations. */
 TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int64_t element_size);
 
+/* Number of blocks the reduced rows of a RK reduction are split into.
+   Splitting the kept columns alone starves the thread pool when they are few
+   (ReduceMean over N, H, W of a NHWC tensor), each block then produces a partial result. */
+int64_t ParallelReduceFastRowBlocks(concurrency::ThreadPool* tp, int64_t n_rows, int64_t n_cols, int64_t element_size);
+
+/* Number of blocks the inner kept dimension of a KRK reduction is split into
+   when the outer kept dimension is too small to occupy the thread pool. */
+int64_t ParallelReduceFastColumnBlocks(concurrency::ThreadPool* tp, int64_t n_outer, int64_t n_red,
+                                       int64_t n_cols, int64_t element_size);
+
+template <typename T>
+struct ReduceFastSumOp {
+  inline void operator()(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& v) const { acc += v; }
+};
+
+template <typename T>
+struct ReduceFastMaxOp {
+  inline void operator()(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& v) const { acc = acc.max(v); }
+};
+
+template <typename T>
+struct ReduceFastMinOp {
+  inline void operator()(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& v) const { acc = acc.min(v); }
+};
+
+/* RK reduction of a (n_rows, N) matrix, every row is accumulated into the output with a vectorized OP.
+   The kept columns are split across the thread pool and, when there are not enough of them,
+   the reduced rows as well. */
+template <typename T, typename OP>
+void CommonFastReduceRK(const T* data, int64_t n_rows, int64_t N, T* out, concurrency::ThreadPool* tp, OP op) {
+  int64_t n_blocks = ParallelReduceFastRowBlocks(tp, n_rows, N, sizeof(T));
+  if (n_blocks <= 1) {
+    memcpy(out, data, N * sizeof(T));
+    concurrency::ThreadPool::TryParallelFor(
+        tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T)),
+        [data, out, N, n_rows, op](ptrdiff_t begin, ptrdiff_t end) {
+          EigenVectorArrayMap<T> acc(out + begin, end - begin);
+          for (int64_t row = 1; row < n_rows; ++row) {
+            op(acc, ConstEigenVectorArrayMap<T>(data + row * N + begin, end - begin));
+          }
+        });
+    return;
+  }
+
+  std::vector<T> partial(SafeInt<size_t>(n_blocks) * N);
+  T* partial_data = partial.data();
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, n_blocks,
+      [data, partial_data, N, n_rows, n_blocks, op](ptrdiff_t b) {
+        auto work = concurrency::ThreadPool::PartitionWork(b, n_blocks, n_rows);
+        T* acc_data = partial_data + b * N;
+        memcpy(acc_data, data + work.start * N, N * sizeof(T));
+        EigenVectorArrayMap<T> acc(acc_data, N);
+        for (int64_t row = work.start + 1; row < work.end; ++row) {
+          op(acc, ConstEigenVectorArrayMap<T>(data + row * N, N));
+        }
+      });
+  memcpy(out, partial_data, N * sizeof(T));
+  EigenVectorArrayMap<T> acc(out, N);
+  for (int64_t b = 1; b < n_blocks; ++b) {
+    op(acc, ConstEigenVectorArrayMap<T>(partial_data + b * N, N));
+  }
+}
+
+/* KRK reduction tiled over both kept dimensions, fast_shape[0] * n_col_blocks tiles
+   are distributed on the thread pool, each one accumulates the reduced rows with a vectorized OP. */
+template <typename T, typename OP>
+void CommonFastReduceKRKTiled(const T* data, const std::vector<int64_t>& fast_shape, T* out,
+                              int64_t n_col_blocks, concurrency::ThreadPool* tp, OP op) {
+  int64_t n_red = fast_shape[1];
+  int64_t N = fast_shape[2];
+  int64_t stridei = n_red * N;
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, fast_shape[0] * n_col_blocks,
+      [data, out, n_red, N, stridei, n_col_blocks, op](ptrdiff_t i) {
+        int64_t d = i / n_col_blocks;
+        auto work = concurrency::ThreadPool::PartitionWork(i % n_col_blocks, n_col_blocks, N);
+        int64_t len = work.end - work.start;
+        const T* p = data + d * stridei + work.start;
+        T* o = out + d * N + work.start;
+        memcpy(o, p, len * sizeof(T));
+        EigenVectorArrayMap<T> acc(o, len);
+        for (int64_t r = 1; r < n_red; ++r) {
+          op(acc, ConstEigenVectorArrayMap<T>(p + r * N, len));
+        }
+      });
+}
+
+/* Width of the tiles of kept columns of CommonFastReduceArgKRK. */
+static constexpr int64_t kFastReduceArgTileSize = 128;
+
+/* ArgMax / ArgMin over the middle dimension of a (n_outer, n_red, N) tensor, RK being the case n_outer == 1.
+   The kept columns are processed in tiles distributed on the thread pool. Every reduced row is compared
+   with the best values of the tile at once, CMP(v, best) telling whether v replaces the best value,
+   and the index is selected with a mask rather than a branch so the compiler can vectorize the loop. */
+template <typename T, typename CMP>
+void CommonFastReduceArgKRK(const T* data, int64_t n_outer, int64_t n_red, int64_t N, int64_t* out,
+                            concurrency::ThreadPool* tp, CMP cmp) {
+  int64_t n_tiles = (N + kFastReduceArgTileSize - 1) / kFastReduceArgTileSize;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, n_outer * n_tiles, ParallelReduceFastCost(n_red, std::min(N, kFastReduceArgTileSize), sizeof(T)),
+      [data, n_red, N, n_tiles, out, cmp](ptrdiff_t first, ptrdiff_t last) {
+        T best[kFastReduceArgTileSize];
+        for (ptrdiff_t i = first; i < last; ++i) {
+          int64_t d = i / n_tiles;
+          int64_t start = (i % n_tiles) * kFastReduceArgTileSize;
+          int64_t len = std::min(kFastReduceArgTileSize, N - start);
+          const T* p = data + d * n_red * N + start;
+          int64_t* arg = out + d * N + start;
+          memcpy(best, p, len * sizeof(T));
+          std::fill(arg, arg + len, static_cast<int64_t>(0));
+          for (int64_t r = 1; r < n_red; ++r) {
+            const T* row = p + r * N;
+            for (int64_t c = 0; c < len; ++c) {
+              T v = row[c];
+              T b = best[c];
+              int64_t mask = -static_cast<int64_t>(cmp(v, b));
+              arg[c] = (arg[c] & ~mask) | (r & mask);
+              best[c] = cmp(v, b) ? v : b;
+            }
+          }
+        }
+      });
+}
+
 /**
   This only improves reduce function when reduced axes are contiguous:
   if len(shape) == 4, any single axis is ok, axes=(0, 1) or (1, 2) or (2, 3) is ok,
@@ -200,20 +325,8 @@ class ReduceAggregatorSum : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t N = fast_shape[1];
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-
-    int64_t n_rows = fast_shape[0];
-    memcpy(out, data, N * sizeof(T));
-    concurrency::ThreadPool::TryParallelFor(
-        tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T)),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          for (int64_t row = 1; row < n_rows; ++row) {
-            EigenVectorArrayMap<T>(out + begin, end - begin) += ConstEigenVectorArrayMap<T>(
-                data + row * N + begin, end - begin);
-          }
-        });
+    CommonFastReduceRK<T>(input.Data<T>(), fast_shape[0], fast_shape[1], output.MutableData<T>(), tp,
+                          ReduceFastSumOp<T>());
   }
 
   static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
@@ -223,6 +336,11 @@ class ReduceAggregatorSum : public ReduceAggregator<T, TVAL> {
     int64_t stridei = fast_shape[1] * fast_shape[2];
     int64_t strideo = fast_shape[2];
     T* out = output.MutableData<T>();
+    int64_t n_col_blocks = ParallelReduceFastColumnBlocks(tp, fast_shape[0], fast_shape[1], N, sizeof(T));
+    if (n_col_blocks > 1) {
+      CommonFastReduceKRKTiled<T>(data, fast_shape, out, n_col_blocks, tp, ReduceFastSumOp<T>());
+      return;
+    }
     std::vector<T> one(fast_shape[1], 1);
     concurrency::ThreadPool::TryParallelFor(
         tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T)),
@@ -259,40 +377,19 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T, TVAL> {
   static void FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
     ReduceAggregatorSum<T, TVAL>::FastReduceKR(input, fast_shape, output, tp);
-    // TODO: use MLAS or BLAS
-    T* out = output.MutableData<T>();
-    T* end = out + fast_shape[0];
-    for (; out != end; ++out) {
-      *out /= static_cast<T>(fast_shape[1]);
-    }
+    EigenVectorArrayMap<T>(output.MutableData<T>(), fast_shape[0]) /= static_cast<T>(fast_shape[1]);
   }
 
   static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
     ReduceAggregatorSum<T, TVAL>::FastReduceRK(input, fast_shape, output, tp);
-    // TODO: use MLAS or BLAS
-    T* out = output.MutableData<T>();
-    T* end = out + fast_shape[1];
-    for (; out != end; ++out) {
-      *out /= static_cast<T>(fast_shape[0]);
-    }
+    EigenVectorArrayMap<T>(output.MutableData<T>(), fast_shape[1]) /= static_cast<T>(fast_shape[0]);
   }
 
   static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
     ReduceAggregatorSum<T, TVAL>::FastReduceKRK(input, fast_shape, output, tp);
-    int64_t strideo = fast_shape[2];
-    T* out = output.MutableData<T>();
-    T* begin;
-    T* end;
-    T div = static_cast<T>(fast_shape[1]);
-    for (int64_t d = 0; d < fast_shape[0]; ++d) {
-      begin = out + strideo * d;
-      end = begin + strideo;
-      for (; begin != end; ++begin) {
-        *begin /= div;
-      }
-    }
+    EigenVectorArrayMap<T>(output.MutableData<T>(), fast_shape[0] * fast_shape[2]) /= static_cast<T>(fast_shape[1]);
   }
 };
 
@@ -327,29 +424,19 @@ class ReduceAggregatorMax : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t n_rows = fast_shape[0];
-    int64_t N = fast_shape[1];
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    memcpy(out, data, N * sizeof(T));
-
-    concurrency::ThreadPool::TryParallelFor(
-        tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T)),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          const T* p;
-          for (int64_t row = 1; row < n_rows; ++row) {
-            p = data + row * N;
-            for (int64_t j = begin; j < end; ++j) {
-              out[j] = out[j] > p[j] ? out[j] : p[j];
-            }
-          }
-        });
+    CommonFastReduceRK<T>(input.Data<T>(), fast_shape[0], fast_shape[1], output.MutableData<T>(), tp,
+                          ReduceFastMaxOp<T>());
   }
 
   static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
+    int64_t n_col_blocks = ParallelReduceFastColumnBlocks(tp, fast_shape[0], fast_shape[1], fast_shape[2], sizeof(T));
+    if (n_col_blocks > 1) {
+      CommonFastReduceKRKTiled<T>(data, fast_shape, out, n_col_blocks, tp, ReduceFastMaxOp<T>());
+      return;
+    }
     int64_t stridei = fast_shape[1] * fast_shape[2];
     int64_t strideo = fast_shape[2];
     concurrency::ThreadPool::TryParallelFor(
@@ -398,6 +485,22 @@ class ReduceAggregatorArgMax : public ReduceAggregatorArgMinMax<T, TVAL> {
     }
     ++this->index_;
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() { return FastReduceKind::kRK | FastReduceKind::kKRK; }
+
+  static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    CommonFastReduceArgKRK<T>(input.Data<T>(), 1, fast_shape[0], fast_shape[1], output.MutableData<int64_t>(), tp,
+                              [](const T& v, const T& best) { return v > best; });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    CommonFastReduceArgKRK<T>(input.Data<T>(), fast_shape[0], fast_shape[1], fast_shape[2],
+                              output.MutableData<int64_t>(), tp,
+                              [](const T& v, const T& best) { return v > best; });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -417,6 +520,22 @@ class ReduceAggregatorArgMaxLastIndex : public ReduceAggregatorArgMax<T, TVAL> {
     }
     ++this->index_;
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() { return FastReduceKind::kRK | FastReduceKind::kKRK; }
+
+  static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    CommonFastReduceArgKRK<T>(input.Data<T>(), 1, fast_shape[0], fast_shape[1], output.MutableData<int64_t>(), tp,
+                              [](const T& v, const T& best) { return v >= best; });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    CommonFastReduceArgKRK<T>(input.Data<T>(), fast_shape[0], fast_shape[1], fast_shape[2],
+                              output.MutableData<int64_t>(), tp,
+                              [](const T& v, const T& best) { return v >= best; });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -434,6 +553,22 @@ class ReduceAggregatorArgMin : public ReduceAggregatorArgMinMax<T, TVAL> {
     }
     ++this->index_;
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() { return FastReduceKind::kRK | FastReduceKind::kKRK; }
+
+  static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    CommonFastReduceArgKRK<T>(input.Data<T>(), 1, fast_shape[0], fast_shape[1], output.MutableData<int64_t>(), tp,
+                              [](const T& v, const T& best) { return v < best; });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    CommonFastReduceArgKRK<T>(input.Data<T>(), fast_shape[0], fast_shape[1], fast_shape[2],
+                              output.MutableData<int64_t>(), tp,
+                              [](const T& v, const T& best) { return v < best; });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -453,6 +588,22 @@ class ReduceAggregatorArgMinLastIndex : public ReduceAggregatorArgMin<T, TVAL> {
     }
     ++this->index_;
   }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() { return FastReduceKind::kRK | FastReduceKind::kKRK; }
+
+  static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    CommonFastReduceArgKRK<T>(input.Data<T>(), 1, fast_shape[0], fast_shape[1], output.MutableData<int64_t>(), tp,
+                              [](const T& v, const T& best) { return v <= best; });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    CommonFastReduceArgKRK<T>(input.Data<T>(), fast_shape[0], fast_shape[1], fast_shape[2],
+                              output.MutableData<int64_t>(), tp,
+                              [](const T& v, const T& best) { return v <= best; });
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -486,29 +637,19 @@ class ReduceAggregatorMin : public ReduceAggregator<T, TVAL> {
 
   static void FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t n_rows = fast_shape[0];
-    int64_t N = fast_shape[1];
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    memcpy(out, data, N * sizeof(T));
-
-    concurrency::ThreadPool::TryParallelFor(
-        tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T)),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          const T* p;
-          for (int64_t row = 1; row < n_rows; ++row) {
-            p = data + row * N;
-            for (int64_t j = begin; j < end; ++j) {
-              out[j] = out[j] < p[j] ? out[j] : p[j];
-            }
-          }
-        });
+    CommonFastReduceRK<T>(input.Data<T>(), fast_shape[0], fast_shape[1], output.MutableData<T>(), tp,
+                          ReduceFastMinOp<T>());
   }
 
   static void FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
+    int64_t n_col_blocks = ParallelReduceFastColumnBlocks(tp, fast_shape[0], fast_shape[1], fast_shape[2], sizeof(T));
+    if (n_col_blocks > 1) {
+      CommonFastReduceKRKTiled<T>(data, fast_shape, out, n_col_blocks, tp, ReduceFastMinOp<T>());
+      return;
+    }
     int64_t stridei = fast_shape[1] * fast_shape[2];
     int64_t strideo = fast_shape[2];
     concurrency::ThreadPool::TryParallelFor(
@@ -218,6 +218,29 @@ Status DeepCpuLstmOp::PrePack(const Tensor& tensor, int input_idx, bool& is_pack
   return Status::OK();
 }
 
+Status DeepCpuLstmOp::TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) {
+  if (input_idx == 1 && packed_W_.buffer_) {
+    prepacked_buffers.push_back(std::move(packed_W_.buffer_));
+  } else if (input_idx == 2 && packed_R_.buffer_) {
+    prepacked_buffers.push_back(std::move(packed_R_.buffer_));
+  }
+  return Status::OK();
+}
+
+Status DeepCpuLstmOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                                bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_.buffer_ = std::move(prepacked_buffers[0]);
+  } else if (input_idx == 2) {
+    used_shared_buffers = true;
+    packed_R_.buffer_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 Status DeepCpuLstmOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
@@ -19,6 +19,9 @@ class DeepCpuLstmOp final : public OpKernel, public LSTMBase {
   DeepCpuLstmOp(const OpKernelInfo& info) : OpKernel(info), LSTMBase(info) {}
 
   Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+  Status TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) override;
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   bool& used_shared_buffers) override;
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuLstmOp() override = default;
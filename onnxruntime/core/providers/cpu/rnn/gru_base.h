@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <limits>
+
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+
+/// The class represents the shared implementation of the GRU operator using DeepCPU
+/// for fast inference computation on CPU machines. It is used by both the float GRU
+/// operator and the quantized DynamicQuantizeGRU contrib operator.
+class GRUBase {
+ protected:
+  GRUBase(const OpKernelInfo& info) {
+    // required attributes
+    std::string direction;
+    ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
+
+    int64_t int64_value;
+    ORT_ENFORCE(info.GetAttr("linear_before_reset", &int64_value).IsOK());
+    linear_before_reset_ = gsl::narrow<int>(int64_value);
+
+    ORT_ENFORCE(info.GetAttr("hidden_size", &int64_value).IsOK() && int64_value > 0);
+    hidden_size_ = gsl::narrow<int>(int64_value);
+
+    // optional attributes
+    std::vector<std::string> activation_func_names = info.GetAttrsOrDefault<std::string>("activations");
+    std::vector<float> activation_func_alphas = info.GetAttrsOrDefault<float>("activation_alpha");
+    std::vector<float> activation_func_betas = info.GetAttrsOrDefault<float>("activation_beta");
+
+    clip_ = info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max());
+    ORT_ENFORCE(clip_ > 0.f);
+
+    use_fast_math_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigActivationFastMath, "0") == "1";
+
+    direction_ = rnn::detail::MakeDirection(direction);
+    num_directions_ = direction_ == rnn::detail::Direction::kBidirectional ? 2 : 1;
+
+    if (activation_func_names.empty()) {
+      for (int i = 0; i < num_directions_; ++i) {
+        activation_func_names.emplace_back("sigmoid");
+        activation_func_names.emplace_back("tanh");
+      }
+    }
+
+    ORT_ENFORCE(activation_func_names.size() == static_cast<size_t>(num_directions_) * 2);
+
+    activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
+                                                     activation_func_alphas,
+                                                     activation_func_betas);
+  }
+
+  ~GRUBase() = default;
+
+  // The recurrence weights are split into the R[zr] and R[h] parts as they are applied separately.
+  template <typename InputT, typename WeightT>
+  Status ComputeImpl(OpKernelContext& context,
+                     const rnn::detail::GemmWeights<WeightT>& W_1,
+                     const rnn::detail::GemmWeights<WeightT>& W_2,
+                     const rnn::detail::GemmWeights<WeightT>& R_zr_1,
+                     const rnn::detail::GemmWeights<WeightT>& R_zr_2,
+                     const rnn::detail::GemmWeights<WeightT>& R_h_1,
+                     const rnn::detail::GemmWeights<WeightT>& R_h_2) const;
+
+  Status ValidateInputs(const Tensor& X,
+                        const Tensor* B,
+                        const Tensor* sequence_lens,
+                        const Tensor* initial_h) const;
+
+  rnn::detail::Direction direction_;
+  int num_directions_;
+
+  int hidden_size_{};
+  float clip_;
+  int linear_before_reset_{};
+  bool use_fast_math_{};
+
+  rnn::detail::ActivationFuncs activation_funcs_;
+};
+
+}  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -30,6 +31,8 @@ class LSTMBase {
     if (info.GetAttr("input_forget", &int64_value).IsOK())
       input_forget_ = int64_value != 0;
 
+    use_fast_math_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigActivationFastMath, "0") == "1";
+
     direction_ = rnn::detail::MakeDirection(direction);
     num_directions_ = direction_ == rnn::detail::Direction::kBidirectional ? 2 : 1;
 
@@ -70,6 +73,7 @@ class LSTMBase {
   int hidden_size_ = 0;
   float clip_;
   bool input_forget_ = false;
+  bool use_fast_math_ = false;
 
   rnn::detail::ActivationFuncs activation_funcs_;
 };
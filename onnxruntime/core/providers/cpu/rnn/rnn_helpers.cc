@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iomanip>
@@ -300,7 +301,7 @@ void ComputeGemm(const int M,
   gemm_params.lda = static_cast<size_t>(K);
   gemm_params.ZeroPointA = a_zero_point;
   gemm_params.B = weights.buffer_;
-  gemm_params.ldb = static_cast<size_t>(N);
+  gemm_params.ldb = weights.ldb_ != 0 ? weights.ldb_ : static_cast<size_t>(N);
   gemm_params.ZeroPointB = &b_zero_point;
   gemm_params.BIsPacked = weights.is_prepacked_;
   gemm_params.C = C_buffer;
@@ -714,6 +715,204 @@ void gru_output_gate_sigmoid(float* ph, const float* pz, const float* ps, float*
   }
 }
 
+// Scalar forms of the polynomial sigmoid/tanh approximations above. These are used by the fused gate kernels
+// below so that bias, clip, activation and the state update for an element all happen in one pass.
+inline float sigmoid_approx(float v) {
+  v = std::min(std::max(v, -sigmoid_bound), sigmoid_bound);
+  float x = 0.5f * v;
+  float x2 = x * x;
+  float p = x2 * alpha_13 + alpha_11;
+  p = x2 * p + alpha_9;
+  p = x2 * p + alpha_7;
+  p = x2 * p + alpha_5;
+  p = x2 * p + alpha_3;
+  p = x2 * p + alpha_1;
+  p = x * p;
+  float q = x2 * beta_6 + beta_4;
+  q = x2 * q + beta_2;
+  q = x2 * q + beta_0;
+  return 0.5f * (1 + (p / q));
+}
+
+inline float tanh_approx(float x) {
+  x = std::min(std::max(x, -tanh_bound), tanh_bound);
+  float x2 = x * x;
+  float p = x2 * alpha_13 + alpha_11;
+  p = x2 * p + alpha_9;
+  p = x2 * p + alpha_7;
+  p = x2 * p + alpha_5;
+  p = x2 * p + alpha_3;
+  p = x2 * p + alpha_1;
+  p = x * p;
+  float q = x2 * beta_6 + beta_4;
+  q = x2 * q + beta_2;
+  q = x2 * q + beta_0;
+  return p / q;
+}
+
+// Scalar forms of MlasComputeFastLogistic/MlasComputeFastTanh, used by the fused gate kernels when the session
+// enables the fast activations. These are [7/6] Pade approximants with an absolute error below 4e-5 (sigmoid) and
+// 7.5e-5 (tanh).
+const float fast_alpha_2 = 1.282051282e-01f;
+const float fast_alpha_4 = 2.797202797e-03f;
+const float fast_alpha_6 = 7.400007400e-06f;
+
+const float fast_beta_2 = 4.615384615e-01f;
+const float fast_beta_4 = 2.331002331e-02f;
+const float fast_beta_6 = 2.072002072e-04f;
+
+const float fast_tanh_bound = 4.8f;
+
+inline float tanh_fast(float x) {
+  x = std::min(std::max(x, -fast_tanh_bound), fast_tanh_bound);
+  float x2 = x * x;
+  float p = x2 * fast_alpha_6 + fast_alpha_4;
+  p = x2 * p + fast_alpha_2;
+  p = x2 * p + 1.0f;
+  p = x * p;
+  float q = x2 * fast_beta_6 + fast_beta_4;
+  q = x2 * q + fast_beta_2;
+  q = x2 * q + 1.0f;
+  return p / q;
+}
+
+// sigmoid(v) = 0.5 * (1 + tanh(v / 2))
+inline float sigmoid_fast(float v) {
+  return 0.5f * (1.0f + tanh_fast(0.5f * v));
+}
+
+template <bool fast_math>
+inline float sigmoid_gate(float x) {
+  return fast_math ? sigmoid_fast(x) : sigmoid_approx(x);
+}
+
+template <bool fast_math>
+inline float tanh_gate(float x) {
+  return fast_math ? tanh_fast(x) : tanh_approx(x);
+}
+
+inline float clip_value(float b, float x) {
+  return std::min(std::max(x, -b), b);
+}
+
+template <bool has_bias, bool has_peephole, bool fast_math>
+static void lstm_gates_fused_impl(float clip, const float* pbi, const float* pbo, const float* pbf, const float* pbc,
+                                  const float* ppi, const float* ppo, const float* ppf,
+                                  const float* pi, const float* po, const float* pf, const float* pc,
+                                  float* pC, float* pH, int c) {
+  for (int i = 0; i < c; i++) {
+    const float c_prev = pC[i];
+
+    float xi = pi[i];
+    float xf = pf[i];
+    float xc = pc[i];
+    if (has_peephole) {
+      xi += c_prev * ppi[i];
+      xf += c_prev * ppf[i];
+    }
+    if (has_bias) {
+      xi += pbi[i];
+      xf += pbf[i];
+      xc += pbc[i];
+    }
+
+    const float it = sigmoid_gate<fast_math>(clip_value(clip, xi));
+    const float ft = sigmoid_gate<fast_math>(clip_value(clip, xf));
+    const float ct = tanh_gate<fast_math>(clip_value(clip, xc));
+
+    const float c_cur = c_prev * ft + it * ct;
+    pC[i] = c_cur;
+
+    float xo = po[i];
+    if (has_peephole) {
+      xo += c_cur * ppo[i];
+    }
+    if (has_bias) {
+      xo += pbo[i];
+    }
+
+    const float ot = sigmoid_gate<fast_math>(clip_value(clip, xo));
+    pH[i] = ot * tanh_gate<fast_math>(c_cur);
+  }
+}
+
+template <bool fast_math>
+static void lstm_gates_fused_dispatch(float clip, const float* pbi, const float* pbo, const float* pbf,
+                                      const float* pbc, const float* ppi, const float* ppo, const float* ppf,
+                                      const float* pi, const float* po, const float* pf, const float* pc,
+                                      float* pC, float* pH, int c) {
+  if (pbi != nullptr) {
+    if (ppi != nullptr)
+      lstm_gates_fused_impl<true, true, fast_math>(clip, pbi, pbo, pbf, pbc, ppi, ppo, ppf, pi, po, pf, pc, pC, pH, c);
+    else
+      lstm_gates_fused_impl<true, false, fast_math>(clip, pbi, pbo, pbf, pbc, ppi, ppo, ppf, pi, po, pf, pc, pC, pH, c);
+  } else {
+    if (ppi != nullptr)
+      lstm_gates_fused_impl<false, true, fast_math>(clip, pbi, pbo, pbf, pbc, ppi, ppo, ppf, pi, po, pf, pc, pC, pH, c);
+    else
+      lstm_gates_fused_impl<false, false, fast_math>(clip, pbi, pbo, pbf, pbc, ppi, ppo, ppf, pi, po, pf, pc, pC, pH,
+                                                     c);
+  }
+}
+
+void lstm_gates_fused(float clip, const float* pbi, const float* pbo, const float* pbf, const float* pbc,
+                      const float* ppi, const float* ppo, const float* ppf,
+                      const float* pi, const float* po, const float* pf, const float* pc,
+                      float* pC, float* pH, int c, bool fast_math) {
+  if (fast_math)
+    lstm_gates_fused_dispatch<true>(clip, pbi, pbo, pbf, pbc, ppi, ppo, ppf, pi, po, pf, pc, pC, pH, c);
+  else
+    lstm_gates_fused_dispatch<false>(clip, pbi, pbo, pbf, pbc, ppi, ppo, ppf, pi, po, pf, pc, pC, pH, c);
+}
+
+template <bool fast_math>
+static void gru_reset_gate_fused_impl(float clip, const float* pbr, const float* ps1, const float* pr, float* pd,
+                                      int c) {
+  if (pbr != nullptr) {
+    for (int i = 0; i < c; i++) {
+      pd[i] = ps1[i] * sigmoid_gate<fast_math>(clip_value(clip, pr[i] + pbr[i]));
+    }
+  } else {
+    for (int i = 0; i < c; i++) {
+      pd[i] = ps1[i] * sigmoid_gate<fast_math>(clip_value(clip, pr[i]));
+    }
+  }
+}
+
+template <bool fast_math>
+static void gru_output_gate_fused_impl(float clip, const float* pbz, const float* pbh, const float* pz,
+                                       const float* ph, const float* pprev, float* po, int c) {
+  if (pbz != nullptr) {
+    for (int i = 0; i < c; i++) {
+      const float zt = sigmoid_gate<fast_math>(clip_value(clip, pz[i] + pbz[i]));
+      const float ht = tanh_gate<fast_math>(clip_value(clip, ph[i] + pbh[i]));
+      po[i] = (1 - zt) * ht + zt * pprev[i];
+    }
+  } else {
+    for (int i = 0; i < c; i++) {
+      const float zt = sigmoid_gate<fast_math>(clip_value(clip, pz[i]));
+      const float ht = tanh_gate<fast_math>(clip_value(clip, ph[i]));
+      po[i] = (1 - zt) * ht + zt * pprev[i];
+    }
+  }
+}
+
+void gru_reset_gate_fused(float clip, const float* pbr, const float* ps1, const float* pr, float* pd, int c,
+                          bool fast_math) {
+  if (fast_math)
+    gru_reset_gate_fused_impl<true>(clip, pbr, ps1, pr, pd, c);
+  else
+    gru_reset_gate_fused_impl<false>(clip, pbr, ps1, pr, pd, c);
+}
+
+void gru_output_gate_fused(float clip, const float* pbz, const float* pbh, const float* pz, const float* ph,
+                           const float* pprev, float* po, int c, bool fast_math) {
+  if (fast_math)
+    gru_output_gate_fused_impl<true>(clip, pbz, pbh, pz, ph, pprev, po, c);
+  else
+    gru_output_gate_fused_impl<false>(clip, pbz, pbh, pz, ph, pprev, po, c);
+}
+
 void composed_activation_func(float* ps, int c, std::function<float(float, float, float)> func, float alpha,
                               float beta) {
   for (int i = 0; i < c; i++) {
@@ -216,6 +216,8 @@ struct GemmWeights {
   bool is_prepacked_{false};
   const void* buffer_{nullptr};
   QuantizationParameter* quant_para_{nullptr};
+  // leading dimension of unpacked quantized weights if they are a column slice of a wider matrix. 0 means N.
+  size_t ldb_{0};
 };
 
 void ComputeGemm(const int M,
@@ -350,6 +352,23 @@ void gru_output_gate_tanh(float* ph, const float* pz, const float* ps, float* po
 void gru_output_gate_sigmoid(float* ph, const float* pz, const float* ps, float* po, int c, float alpha, float beta);
 void gru_output_gate_relu(const float* ph, const float* pz, const float* ps, float* po, int c, float alpha, float beta);
 
+// Fused gate kernels for the default activations (f=sigmoid, g=tanh, h=tanh). Each makes a single pass over the
+// gate values produced by the GEMMs, adding the bias (nullptr if not used), clipping, applying the activations and
+// updating the state, instead of one pass per gate and per step. If fast_math is true the activations use the
+// approximations of MlasComputeFastLogistic and MlasComputeFastTanh.
+
+// pC contains Ct-1 on input and Ct on output. Peephole pointers are nullptr if peepholes are not used.
+void lstm_gates_fused(float clip, const float* pbi, const float* pbo, const float* pbf, const float* pbc,
+                      const float* ppi, const float* ppo, const float* ppf,
+                      const float* pi, const float* po, const float* pf, const float* pc,
+                      float* pC, float* pH, int c, bool fast_math);
+// pd = ps1 (.) sigmoid(clip(pr + pbr))
+void gru_reset_gate_fused(float clip, const float* pbr, const float* ps1, const float* pr, float* pd, int c,
+                          bool fast_math);
+// po = (1 - zt) (.) ht + zt (.) pprev, with zt = sigmoid(clip(pz + pbz)) and ht = tanh(clip(ph + pbh))
+void gru_output_gate_fused(float clip, const float* pbz, const float* pbh, const float* pz, const float* ph,
+                           const float* pprev, float* po, int c, bool fast_math);
+
 inline void elementwise_product(const float* op1, const float* op2, float* dest, int size) {
   for (int i = 0; i < size; i++)
     dest[i] += op1[i] * op2[i];
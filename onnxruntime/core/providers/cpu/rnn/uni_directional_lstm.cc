@@ -45,7 +45,8 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
     const gsl::span<const T>& bias, const gsl::span<const T>& peephole_weights,
     const gsl::span<const T>& initial_hidden_state, const gsl::span<const T>& initial_cell_state,
     const ActivationFuncs::Entry& activation_func_f, const ActivationFuncs::Entry& activation_func_g,
-    const ActivationFuncs::Entry& activation_func_h, const float clip, concurrency::ThreadPool* thread_pool)
+    const ActivationFuncs::Entry& activation_func_h, const float clip, const bool use_fast_math,
+    concurrency::ThreadPool* thread_pool)
     : allocator_(allocator),
       logger_(logger),
       seq_length_(seq_length),
@@ -57,6 +58,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
       clip_(clip),
       use_bias_(!bias.empty()),
       use_peepholes_(!peephole_weights.empty()),
+      use_fast_math_(use_fast_math),
       thread_pool_(thread_pool) {
   activation_f_ = {deepcpu::ActivationFuncByName(activation_func_f.name), activation_func_f.alpha,
                    activation_func_f.beta};
@@ -69,6 +71,10 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
+  // the default activations can be computed for all gates and the cell update in a single pass
+  use_fused_gates_ = activation_func_f.name == "sigmoid" && activation_func_g.name == "tanh" &&
+                     activation_func_h.name == "tanh" && !input_forget_;
+
   SetNumThreads();
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
@@ -437,6 +443,23 @@ void UniDirectionalLstm<T>::GateComputations(
     float* pCprev_hidden_size = SafeRawPointer<T>(C_prev + b * hidden_size_, C_prev_end, hidden_size_);
 #endif
 
+    if (use_fused_gates_) {
+      float* pH =
+          SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
+
+      // bias, clip, activations, Ct and Ht in one pass. Ct is updated in-place in pCprev_hidden_size.
+      deepcpu::lstm_gates_fused(clip_,
+                                use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr,
+                                use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr,
+                                use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr,
+                                use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, 0, hidden_size_) : nullptr,
+                                use_peepholes_ ? SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_) : nullptr,
+                                use_peepholes_ ? SafeRawConstPointer<const T>(peephole_o_, 0, hidden_size_) : nullptr,
+                                use_peepholes_ ? SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_) : nullptr,
+                                pi, po, pf, pc, pCprev_hidden_size, pH, hidden_size_, use_fast_math_);
+      continue;
+    }
+
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
     // Input Gate
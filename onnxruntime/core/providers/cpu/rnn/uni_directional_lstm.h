@@ -30,7 +30,8 @@ class UniDirectionalLstm {
                      const gsl::span<const T>& bias, const gsl::span<const T>& peephole_weights,
                      const gsl::span<const T>& initial_hidden_state, const gsl::span<const T>& initial_cell_state,
                      const ActivationFuncs::Entry& activation_func_f, const ActivationFuncs::Entry& activation_func_g,
-                     const ActivationFuncs::Entry& activation_func_h, float clip, concurrency::ThreadPool* thread_pool);
+                     const ActivationFuncs::Entry& activation_func_h, float clip, bool use_fast_math,
+                     concurrency::ThreadPool* thread_pool);
 
   template <typename WeightT>
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
@@ -74,6 +75,9 @@ class UniDirectionalLstm {
 
   bool use_bias_;
   bool use_peepholes_;
+  bool use_fused_gates_;
+  // the fused gate kernels use the fast approximations of sigmoid and tanh
+  bool use_fast_math_;
 
   int num_threads_ = -1;
 
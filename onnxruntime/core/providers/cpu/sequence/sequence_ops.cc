@@ -15,8 +15,9 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
-// TODO: The current implementation of sequence ops relies on tensor copies. Ideally we should try to avoid
-// these copies. This has been postponed due to lack of time.
+// Tensors already in a sequence own their buffers and are never modified, so the sequence ops share them between
+// the input and output sequences. Tensor inputs are copied into the sequence once, as their buffers belong to the
+// execution frame and may be reused for other values after the node runs.
 
 // SequenceLength
 ONNX_CPU_OPERATOR_KERNEL(
@@ -184,12 +185,12 @@ ONNX_CPU_OPERATOR_KERNEL(
                                  DataTypeImpl::GetTensorType<int64_t>()}),
     SequenceInsert);
 
-Status CreateCopyAndAppendCpuTensor(const Tensor& in_tensor, OpKernelContext* context, std::vector<Tensor>& tensors) {
+Status CreateCopyAndAppendCpuTensor(const Tensor& in_tensor, OpKernelContext* context, TensorSeq& tensors) {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
   Tensor tmp(in_tensor.DataType(), onnxruntime::TensorShape(in_tensor.Shape()), alloc);
   CopyCpuTensor(&in_tensor, &tmp);
-  tensors.push_back(std::move(tmp));
+  tensors.Add(std::move(tmp));
   return Status::OK();
 }
 
@@ -224,23 +225,17 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
 
   auto* Y = context->Output<TensorSeq>(0);
   ORT_ENFORCE(Y != nullptr, "SequenceInsert: Got nullptr for output sequence");
-  std::vector<Tensor> tensors;
-  tensors.reserve(num_tensors_input_seq + 1);
+  Y->SetType(S->DataType());
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
-      CreateCopyAndAppendCpuTensor(*X, context, tensors);
-      CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
-    } else {
-      CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
+      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, *Y));
     }
+    Y->Add(S->GetOrtValue(i));
   }
   if (input_seq_idx == num_tensors_input_seq) {
-    CreateCopyAndAppendCpuTensor(*X, context, tensors);
+    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, *Y));
   }
 
-  Y->SetType(S->DataType());
-  Y->SetElements(std::move(tensors));
-
   return Status::OK();
 }
 
@@ -277,15 +272,12 @@ Status SequenceErase::Compute(OpKernelContext* context) const {
   auto* Y = context->Output<TensorSeq>(0);
   ORT_ENFORCE(Y != nullptr, "SequenceErase: Got nullptr for output sequence");
   Y->SetType(S->DataType());
-  std::vector<Tensor> tensors;
-  tensors.reserve(num_tensors_input_seq - 1);
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
       continue;
     }
-    CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
+    Y->Add(S->GetOrtValue(i));
   }
-  Y->SetElements(std::move(tensors));
   return Status::OK();
 }
 
@@ -317,13 +309,10 @@ Status SequenceConstruct::Compute(OpKernelContext* context) const {
 
   // now copy the tensors to the output sequence
   Y->SetType(first_dtype);
-  std::vector<Tensor> tensors;
-  tensors.reserve(num_inputs);
   for (int input_idx = 0; input_idx < num_inputs; ++input_idx) {
     const auto* X = context->Input<Tensor>(input_idx);
-    CreateCopyAndAppendCpuTensor(*X, context, tensors);
+    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, *Y));
   }
-  Y->SetElements(std::move(tensors));
   return Status::OK();
 }
 
@@ -15,6 +15,8 @@
 #include "core/framework/data_types.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
@@ -22,10 +24,6 @@
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-#include "core/mlas/inc/mlas.h"
-#endif
-
 namespace onnxruntime {
 
 namespace op_kernel_type_control {
@@ -213,18 +211,60 @@ struct TensorCaster<std::string, DstType> {
   }
 };
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
+// specializations to use the vectorized MLAS conversion routines between float and the 16-bit float types
+
+// converts the elements with an MLAS routine, splitting large tensors across the operator thread pool
+template <typename SrcType, typename DstType, typename ConvertFn>
+void MlasConvertTensor(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out,
+                       ConvertFn convert) {
+  const auto* in_data = in.Data<SrcType>();
+  auto* out_data = out.MutableData<DstType>();
+  const std::ptrdiff_t shape_size = gsl::narrow<std::ptrdiff_t>(shape.Size());
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), shape_size,
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)), 1.0},
+      [in_data, out_data, convert](std::ptrdiff_t first, std::ptrdiff_t last) {
+        convert(in_data + first, out_data + first, static_cast<size_t>(last - first));
+      });
+}
 
 // tensor MLFloat16 -> float
 template <>
 struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = gsl::narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    MlasConvertTensor<MLFloat16, float>(context, shape, in, out, [](const MLFloat16* src, float* dst, size_t count) {
+      MlasConvertHalfToFloat(&src->val, dst, count);
+    });
+  }
+};
+
+// tensor float -> MLFloat16
+template <>
+struct TensorCaster<float, MLFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    MlasConvertTensor<float, MLFloat16>(context, shape, in, out, [](const float* src, MLFloat16* dst, size_t count) {
+      MlasConvertFloatToHalf(src, &dst->val, count);
+    });
+  }
+};
+
+// tensor BFloat16 -> float
+template <>
+struct TensorCaster<BFloat16, float> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    MlasConvertTensor<BFloat16, float>(context, shape, in, out, [](const BFloat16* src, float* dst, size_t count) {
+      MlasConvertBFloat16ToFloat(&src->val, dst, count);
+    });
+  }
+};
+
+// tensor float -> BFloat16
+template <>
+struct TensorCaster<float, BFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    MlasConvertTensor<float, BFloat16>(context, shape, in, out, [](const float* src, BFloat16* dst, size_t count) {
+      MlasConvertFloatToBFloat16(src, &dst->val, count);
+    });
   }
 };
 
@@ -260,7 +300,6 @@ struct TensorCaster<MLFloat16, std::string> {
     CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
   }
 };
-#endif
 
 class Cast final : public OpKernel {
  public:
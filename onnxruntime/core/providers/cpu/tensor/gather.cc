@@ -3,10 +3,14 @@
 
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
+
+#include <algorithm>
+
 #include "core/common/common.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
+#include "core/util/prefetch.h"
 
 namespace onnxruntime {
 
@@ -80,6 +84,53 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+namespace {
+
+// Copies the gathered blocks [first, last) of the M * N output blocks. The source block of a later index is
+// prefetched while the current one is copied, as the lookups of an embedding table are random accesses into
+// memory that is typically much larger than the caches.
+template <typename Tin, typename CopyBlock>
+void GatherBlocks(const Tin* indices_data, const uint8_t* src_base, uint8_t* dst_base, const int64_t block_size,
+                  const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
+                  const int64_t axis_dim_limit, ptrdiff_t first, ptrdiff_t last, CopyBlock copy_block) {
+  // (batch, index into indices) of the block being copied and of the block being prefetched
+  int64_t batch = first / N;
+  int64_t i = first % N;
+  int64_t prefetch_batch = batch;
+  int64_t prefetch_i = i;
+
+  const auto source_block = [&](int64_t b, int64_t j) {
+    int64_t idx = static_cast<int64_t>(indices_data[j]);
+    idx = idx < 0 ? idx + axis_dim_limit : idx;
+    return src_base + b * data_batch_bytes + idx * block_size;
+  };
+  const auto prefetch_next = [&]() {
+    PrefetchRead(source_block(prefetch_batch, prefetch_i), static_cast<size_t>(block_size));
+    if (++prefetch_i == N) {
+      prefetch_i = 0;
+      ++prefetch_batch;
+    }
+  };
+
+  const ptrdiff_t prefetch_end = std::min(last, static_cast<ptrdiff_t>(first + kGatherPrefetchDistance));
+  for (ptrdiff_t index = first; index < prefetch_end; ++index) {
+    prefetch_next();
+  }
+
+  for (ptrdiff_t index = first; index < last; ++index) {
+    if (index + kGatherPrefetchDistance < last) {
+      prefetch_next();
+    }
+    copy_block(dst_base + batch * gathered_batch_bytes + i * block_size, source_block(batch, i));
+    if (++i == N) {
+      i = 0;
+      ++batch;
+    }
+  }
+}
+
+}  // namespace
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
@@ -99,30 +150,37 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-  auto lambda = [&](int64_t index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
+  if (M * N == 0) {
+    return Status::OK();
+  }
 
+  auto work = [&](ptrdiff_t first, ptrdiff_t last) {
     if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
+      const size_t block_elements = static_cast<size_t>(block_size) / element_bytes;
+      GatherBlocks(indices_data, src_base, dst_base, block_size, N, data_batch_bytes, gathered_batch_bytes,
+                   axis_dim_limit, first, last, [block_elements](uint8_t* dst, const uint8_t* src) {
+                     std::copy_n(reinterpret_cast<const std::string*>(src), block_elements,
+                                 reinterpret_cast<std::string*>(dst));
+                   });
+    } else if (block_size == sizeof(uint32_t)) {
+      // single 4 byte elements, e.g. gathering token ids or scalar features
+      GatherBlocks(indices_data, src_base, dst_base, block_size, N, data_batch_bytes, gathered_batch_bytes,
+                   axis_dim_limit, first, last, [](uint8_t* dst, const uint8_t* src) {
+                     memcpy(dst, src, sizeof(uint32_t));
+                   });
+    } else if (block_size == sizeof(uint64_t)) {
+      GatherBlocks(indices_data, src_base, dst_base, block_size, N, data_batch_bytes, gathered_batch_bytes,
+                   axis_dim_limit, first, last, [](uint8_t* dst, const uint8_t* src) {
+                     memcpy(dst, src, sizeof(uint64_t));
+                   });
     } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
+      GatherBlocks(indices_data, src_base, dst_base, block_size, N, data_batch_bytes, gathered_batch_bytes,
+                   axis_dim_limit, first, last, [block_size](uint8_t* dst, const uint8_t* src) {
+                     memcpy(dst, src, static_cast<size_t>(block_size));
+                   });
     }
   };
-  concurrency::ThreadPool::TryParallelFor(tp, M * N, static_cast<double>(block_size),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
-                                              lambda(index);
-                                            }
-                                          });
+  concurrency::ThreadPool::TryParallelFor(tp, M * N, static_cast<double>(block_size), work);
 
   return Status::OK();
 }
@@ -240,6 +240,81 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
 #pragma GCC diagnostic pop
 #endif
 
+// Fast path for elements of 1, 2, 4 or 8 bytes. The rows of 'inner dimension' length are split across threads
+// and each element is copied with a single typed load and store instead of a memcpy call.
+template <typename T, typename Tin>
+static void GatherFixedSizeElements(const Tensor* input_tensor, const Tensor* indices_tensor,
+                                    Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* ttp) {
+  const T* input_data = reinterpret_cast<const T*>(input_tensor->DataRaw());
+  T* output_data = reinterpret_cast<T*>(output_tensor->MutableDataRaw());
+
+  const int64_t input_rank = static_cast<int64_t>(input_tensor->Shape().NumDimensions());
+  const TensorPitches input_shape_pitches(*input_tensor);
+  const auto& input_shape = input_tensor->Shape();
+  const TensorShape& indices_shape = indices_tensor->Shape();
+  const Tin* indices_data = indices_tensor->Data<Tin>();
+
+  const int64_t num_inner_dim = calculate_num_inner_dim(indices_shape);
+  const int64_t inner_dim_size = indices_shape[input_rank - 1];
+  const int64_t axis_dim = input_shape[axis];
+  const int64_t axis_pitch = input_shape_pitches[axis];
+  const bool processing_inner_dim = axis == input_rank - 1;
+
+  concurrency::ThreadPool::TryParallelFor(
+      ttp, num_inner_dim, static_cast<double>(inner_dim_size * sizeof(T)),
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        // coordinates of the first row of this range, the innermost one is unused
+        std::vector<int64_t> process_dims(input_rank, 0);
+        int64_t remaining = first;
+        for (int64_t i = input_rank - 2; i >= 0; --i) {
+          process_dims[i] = remaining % indices_shape[i];
+          remaining /= indices_shape[i];
+        }
+
+        for (ptrdiff_t row = first; row < last; ++row) {
+          const T* input_row = input_data + compute_base_offset(process_dims, input_shape_pitches, axis);
+          const Tin* indices_row = indices_data + row * inner_dim_size;
+          T* output_row = output_data + row * inner_dim_size;
+
+          if (processing_inner_dim) {
+            for (int64_t i = 0; i < inner_dim_size; ++i) {
+              const int64_t index = static_cast<int64_t>(indices_row[i]);
+              output_row[i] = input_row[index < 0 ? index + axis_dim : index];
+            }
+          } else {
+            for (int64_t i = 0; i < inner_dim_size; ++i) {
+              const int64_t index = static_cast<int64_t>(indices_row[i]);
+              output_row[i] = input_row[(index < 0 ? index + axis_dim : index) * axis_pitch + i];
+            }
+          }
+
+          increment_over_inner_dim(process_dims, indices_shape);
+        }
+      });
+}
+
+template <typename Tin>
+static void GatherNumericElements(const Tensor* input_tensor, const Tensor* indices_tensor,
+                                  Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* ttp) {
+  switch (input_tensor->DataType()->Size()) {
+    case sizeof(uint8_t):
+      GatherFixedSizeElements<uint8_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint16_t):
+      GatherFixedSizeElements<uint16_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint32_t):
+      GatherFixedSizeElements<uint32_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint64_t):
+      GatherFixedSizeElements<uint64_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    default:
+      core_impl<false, int8_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+  }
+}
+
 Status GatherElements::ValidateInputShapes(const TensorShape& input_data_shape,
                                            const TensorShape& indices_shape,
                                            int64_t axis) {
@@ -306,9 +381,9 @@ Status GatherElements::Compute(OpKernelContext* context) const {
       core_impl<true, std::string, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
   } else {
     if (indices_tensor->IsDataType<int32_t>())
-      core_impl<false, int8_t, int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      GatherNumericElements<int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
     else
-      core_impl<false, int8_t, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      GatherNumericElements<int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
   }
 
   return Status::OK();
@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "gather_nd.h"
+
+#include <algorithm>
+
 #include "core/platform/threadpool.h"
+#include "core/util/prefetch.h"
 
 namespace onnxruntime {
 
@@ -172,15 +176,22 @@ Status GatherND::Compute(OpKernelContext* context) const {
 }
 
 Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t slice_idx) {
-    memcpy(p.output_base + slice_idx * p.bytes_per_slice, p.input_base + p.slice_offsets[slice_idx] * p.element_bytes,
-           p.bytes_per_slice);
+  const auto slice_bytes = static_cast<size_t>(p.bytes_per_slice);
+  const auto source_slice = [&p](ptrdiff_t slice_idx) {
+    return p.input_base + p.slice_offsets[slice_idx] * p.element_bytes;
   };
   concurrency::ThreadPool::TryParallelFor(
       tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
-      [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
-          lambda(slice_idx);
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        // the slice offsets are known up front, so the slices needed next can be requested while copying
+        for (ptrdiff_t slice_idx = first; slice_idx < std::min(last, first + kGatherPrefetchDistance); ++slice_idx) {
+          PrefetchRead(source_slice(slice_idx), slice_bytes);
+        }
+        for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
+          if (slice_idx + kGatherPrefetchDistance < last) {
+            PrefetchRead(source_slice(slice_idx + kGatherPrefetchDistance), slice_bytes);
+          }
+          memcpy(p.output_base + slice_idx * p.bytes_per_slice, source_slice(slice_idx), slice_bytes);
         }
       });
   return Status::OK();
@@ -65,20 +65,10 @@ class IdentityOp final : public OpKernel {
       TensorSeq* output = context->Output<TensorSeq>(0);
       output->SetType(X->DataType());
 
-      AllocatorPtr alloc;
-      auto status = context->GetTempSpaceAllocator(&alloc);
-      if (!status.IsOK()) {
-        ORT_THROW("Unable to get an allocator");
+      // the tensors of a sequence are never modified, so the output shares them
+      for (size_t i = 0, end = X->Size(); i < end; ++i) {
+        output->Add(X->GetOrtValue(i));
       }
-      std::vector<Tensor> tensors;
-      for (auto it = X->begin(), end = X->end(); it != end; ++it) {
-        Tensor tmp(it->DataType(), onnxruntime::TensorShape(it->Shape()), alloc);
-        size_t bytes = it->SizeInBytes();
-        memcpy(tmp.MutableDataRaw(), it->DataRaw(), bytes);
-        tensors.push_back(std::move(tmp));
-      }
-
-      output->SetElements(std::move(tensors));
     }
 
     return Status::OK();
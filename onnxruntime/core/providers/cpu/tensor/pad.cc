@@ -199,6 +199,41 @@ static Status PadInputWithDimValueOfZero(OpKernelContext* ctx,
   return Status::OK();
 }
 
+// Fills the output outside of the box of size 'extents' that starts at the begin 'pads' with 'constant'.
+// For each axis the padding is one block before and one block after the box for every row of the outer axes
+// that lies inside the box; the inner axes of those blocks are padded in full.
+template <typename T>
+static void PadBordersConstant(T* output, const std::vector<int64_t>& pads, const std::vector<int64_t>& extents,
+                               const TensorPitches& output_pitches, T constant) {
+  const size_t dims_count = extents.size();
+  std::vector<int64_t> index(dims_count, 0);
+  for (size_t axis = 0; axis < dims_count; ++axis) {
+    const int64_t pitch = output_pitches[axis];
+    const int64_t pre_pad = pads[axis] * pitch;
+    const int64_t post_pad = pads[axis + dims_count] * pitch;
+    if (pre_pad == 0 && post_pad == 0)
+      continue;
+
+    std::fill(index.begin(), index.end(), 0);
+    while (true) {
+      int64_t offset = 0;
+      for (size_t i = 0; i < axis; ++i)
+        offset += (pads[i] + index[i]) * output_pitches[i];
+      PadAxisConstant(output + offset, constant, static_cast<size_t>(pre_pad));
+      PadAxisConstant(output + offset + pre_pad + extents[axis] * pitch, constant, static_cast<size_t>(post_pad));
+
+      size_t i = axis;
+      for (; i > 0; --i) {
+        if (++index[i - 1] < extents[i - 1])
+          break;
+        index[i - 1] = 0;
+      }
+      if (i == 0)
+        break;
+    }
+  }
+}
+
 // Flatten no padding inner most Axis, so one memcpy cover multiple Axis.
 // For example, for a shape of [1,224,224,3] with padding [0,3,3,0,0,3,3,0], can be flatten as
 // [1,224,224*3] with padding [0,3,3*3,0,3,3*3].
@@ -316,36 +351,20 @@ static Status PadImpl(OpKernelContext* ctx,
   ExtentAxisCounters input_counters(input_extents);
 
   switch (mode) {
-    case Mode::Constant:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value, prePad);
-          PadAxisConstant(output, value, postPad);
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxisConstant(axisStart - prePad * inner_pitch, value, prePad * inner_pitch);
-          PadAxisConstant(output, value, postPad * inner_pitch);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
-      }
+    case Mode::Constant: {
+      // Copy the input into the interior of the output in one (possibly multi-threaded) strided copy, then fill the
+      // padding around it
+      TensorPitches input_pitches(reshaped_input_dims);
+      int64_t input_offset = 0;
+      for (size_t i = 0; i < new_dims_count; i++)
+        input_offset += input_starts[i] * input_pitches[i];
+
+      StridedCopy(ctx->GetOperatorThreadPool(), output + alignSkip, output_pitches,
+                  reinterpret_cast<const T*>(input_tensor.DataRaw()) + input_offset, input_pitches,
+                  input_extents, sizeof(T));
+      PadBordersConstant(output, reshaped_pad, input_extents, output_pitches, value);
       break;
+    }
 
     case Mode::Edge:
       // Loop over the output tensor, writing out padding between the blocks of copied data
@@ -322,6 +322,30 @@ static Status SliceImpl(OpKernelContext* ctx,
   T* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
   const auto* output_end = output + output_tensor.Shape().Size();
 
+  if (!std::is_same<T, std::string>::value) {
+    // starts/steps have the rank of the flattened dims if the innermost dims were combined
+    std::vector<int64_t> input_dims(input_tensor.Shape().GetDims());
+    const auto& copy_dims = compute_metadata.p_flattened_output_dims_ ? *compute_metadata.p_flattened_output_dims_
+                                                                      : compute_metadata.output_dims_;
+    if (compute_metadata.p_flattened_output_dims_) {
+      input_dims.resize(copy_dims.size());
+      input_dims.back() = copy_dims.back();
+    }
+
+    TensorPitches input_pitches(input_dims);
+    std::vector<int64_t> input_strides(input_dims.size());
+    int64_t input_offset = 0;
+    for (size_t i = 0; i < input_dims.size(); ++i) {
+      input_strides[i] = compute_metadata.steps_[i] * input_pitches[i];
+      input_offset += compute_metadata.starts_[i] * input_pitches[i];
+    }
+
+    StridedCopy(ctx->GetOperatorThreadPool(), output, TensorPitches(copy_dims),
+                reinterpret_cast<const T*>(input_tensor.DataRaw()) + input_offset, input_strides,
+                copy_dims, sizeof(T));
+    return Status::OK();
+  }
+
   auto create_output = [&output, &output_end](SliceIterator<T>& input_iterator) {
     if (input_iterator.SolitaryInnerStep()) {
       while (output < output_end) {
@@ -8,6 +8,7 @@
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
+#include "core/providers/cpu/tensor/utils.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -174,16 +175,24 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
     T* output_data = output->template MutableData<T>();
 
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          copy_data<T>(src, dst, count);
-        });
+    if (input.IsDataTypeString()) {
+      ::onnxruntime::math::CopyMatrix<T>(
+          before_dims,                                       // M
+          split_size * after_dims_excluding_split,           // N
+          static_cast<const T*>(input_data + input_offset),  // A
+          after_dims_including_split_axis,                   // lda
+          static_cast<T*>(output_data),                      // B
+          split_size * after_dims_excluding_split,           // ldb
+          [](const T* src, T* dst, size_t count) {
+            copy_data<T>(src, dst, count);
+          });
+    } else {
+      const std::vector<int64_t> copy_shape{before_dims, split_size * after_dims_excluding_split};
+      const std::vector<int64_t> input_strides{after_dims_including_split_axis, 1};
+      const std::vector<int64_t> output_strides{split_size * after_dims_excluding_split, 1};
+      StridedCopy(context.GetOperatorThreadPool(), output_data, output_strides,
+                  input_data + input_offset, input_strides, copy_shape, sizeof(T));
+    }
 
     input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
   }
@@ -6,6 +6,7 @@
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
 #include "utils.h"
@@ -121,13 +122,6 @@ static inline void IncrementIndexAndComputeOffset(MultiIndex& mindex, const T*&
 
 // DoTransposeSingleBlock: specialization of DoTranspose for the num_blocks=1 case.
 // copies source tensor to target, transposing elements.
-static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const void* source, void* target,
-                                          size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  // copy
-  memcpy(target, source, blocksize);
-}
-
 static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::string* source, std::string* target) {
   const std::string* end = source + num_elts_in_block;
   std::copy(source, end, target);
@@ -135,22 +129,6 @@ static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::s
 
 // DoTranspose: copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
-static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
-                            size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
-                            const uint8_t* source, uint8_t* target, size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  MultiIndex mindex;
-  IncrementIndexAndComputeOffsetSetup(mindex, num_axes, target_dims, stride, element_size);
-
-  const uint8_t* local_source = source;
-  for (size_t i = 0; i < num_blocks; ++i) {
-    ORT_ENFORCE((local_source >= source) && (local_source < source + num_blocks * blocksize));
-    memcpy(target, local_source, blocksize);
-    IncrementIndexAndComputeOffset(mindex, local_source);
-    target += blocksize;
-  }
-}
-
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
                             const std::string* source, std::string* target) {
@@ -240,16 +218,14 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
   }
 }
 
+// Transpose of std::string data using the per element/block index walk.
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
-static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                 const TensorShape* input_shape_override = nullptr) {
+static Status DoStringTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                const TensorShape* input_shape_override = nullptr) {
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
 
-  const auto element_size = input.DataType()->Size();
-  const bool is_string_type = input.IsDataTypeString();
-
   std::vector<size_t> stride(rank);
   for (size_t i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
@@ -278,379 +254,278 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
   }
 
   Status status = Status::OK();
+  constexpr bool string_enabled = utils::HasType<EnabledDataTypes, std::string>();
 
-  if (is_string_type) {
-    constexpr bool string_enabled = utils::HasType<EnabledDataTypes, std::string>();
-
-    if (string_enabled) {
-      const auto* input_data = input.template Data<std::string>();
-      auto* output_data = output.template MutableData<std::string>();
-      if (1 == prefix_blocksize) {
-        DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
-      } else if (1 == suffix_blocksize) {
-        DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                           input_data, output_data);
-      } else {
-        DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                        input_data, output_data);
-      }
-    } else {
-      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transpose of std::string is not supported in this build.");
-    }
-  } else {
-    const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-    auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+  if (string_enabled) {
+    const auto* input_data = input.template Data<std::string>();
+    auto* output_data = output.template MutableData<std::string>();
     if (1 == prefix_blocksize) {
-      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
+      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
     } else if (1 == suffix_blocksize) {
-      // this may return a failed status if the data size is not supported in this build
-      status = DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                                  input_data, output_data, element_size);
+      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
+                         input_data, output_data);
     } else {
       DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
+                      input_data, output_data);
     }
+  } else {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transpose of std::string is not supported in this build.");
   }
 
   return status;
 }
 
 /*
-Optimizations for moving a single axis either inwards or outwards.
-
-If moving outwards we can use a single reader and multiple writers. The number of writers is equal to the value of
-the axis being moved.
-
-  e.g. if the input is NHWC with shape {N, 300, 300, 3}, we can transpose to NCHW by reading once and having
-       one writer for each of the 3 channels at a different offset in the output, updating the offset for each item
-       in the batch of N.
-
-Similarly if one axis is moving inwards we can use a single writer and multiple readers. The number of readers is equal
-to the value of the axis being moved.
-
-  e.g. if the input is NCHW with shape {N, 3, 300, 300}, we can transpose to NHWC by writing once using one reader for
-       each of the 3 channels at a different offset in the input, updating the read offset for each item in the batch
-       of N.
-
-This can be generalized for any input where only one axis is being moved, with the block size for each read/write
-being dependent on which axis is moving, what direction it's moving in, and where it's moving to.
-
-We use simple pointer arithmetic if the size of each read/write is a power of 2 and between 8 and 64 bits.
-We use memcpy if the block size is larger.
-
-We fall back to the default implementation in all other cases, and if the input is std::string.
+General N-D transpose for all types other than std::string.
+
+The permutation is first simplified: axes of size 1 are dropped and input axes that stay adjacent and in the same
+order in the output are merged. If the innermost input axis is still the innermost output axis, its rows are
+contiguous in both tensors and are copied as a single (larger) element. For example a {0, 2, 1, 3} transpose of an
+attention tensor with shape {B, S, H, D} becomes a {0, 2, 1} transpose of {B, S, H} elements of D values, and
+NCHW -> NHWC becomes a {0, 2, 1} transpose of {N, C, H*W}.
+
+What remains is a set of 2D transposes between the innermost input axis (the columns) and the input axis that
+becomes the innermost output axis (the rows), one for each index of the other (outer) axes. Each 2D transpose is
+split recursively along its larger dimension until a tile fits in the L1 cache, so the reads and the writes stay in
+cache without tuning the tile size for a specific cache (a cache-oblivious transpose). Tiles of 1, 2, 4 or 8 byte
+elements are transposed with the MLAS 8x8/4x4 SIMD micro-kernels and other element sizes are copied with memcpy.
+Strips of rows of the 2D transposes are distributed across the thread pool.
 */
 
 namespace {
 
-template <typename T>
-struct has_mlas_transpose : std::false_type {};
-
-template <>
-struct has_mlas_transpose<uint8_t> : std::true_type {};
-
-template <>
-struct has_mlas_transpose<uint32_t> : std::true_type {};
-
-// moving a single axis outwards where the read/write size is a power of 2 and between 8 and 64 bits.
-template <typename T>
-typename std::enable_if<!has_mlas_transpose<T>::value, void>::type
-SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                  int64_t num_loops, int64_t num_writers,
-                                  int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  const T* end;
-  for (int64_t l = 0; l < num_loops; ++l) {
-    T* output_for_first_writer = output_data;
-
-    for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-      T* output_for_current_writer = output_for_first_writer;
-
-      end = input_data + num_writers;
-      for (; input_data != end;) {
-        *output_for_current_writer = *input_data++;
-
-        // skip to output position for next writer
-        output_for_current_writer += writes_per_writer_per_loop;
-      }
+// Tiles of a 2D transpose are split until they have no more than this many bytes.
+constexpr size_t kTransposeTileBytes = 4096;
+
+// Elements at least this large are whole cache lines, so there is nothing to gain from tiling them.
+constexpr size_t kTransposeUntiledElementBytes = 64;
+
+// Number of rows of a 2D transpose in a unit of parallel work.
+constexpr size_t kTransposeRowsPerStrip = 64;
+
+struct BlockedTransposeParams {
+  size_t element_size;       // size in bytes of the (possibly merged) element
+  size_t rows;               // size of the input axis that becomes the innermost output axis
+  size_t cols;               // size of the innermost input axis
+  size_t input_row_stride;   // elements between consecutive rows in the input
+  size_t output_row_stride;  // elements between consecutive columns in the output
+  // the other axes, in output order
+  std::vector<size_t> outer_dims;
+  std::vector<size_t> outer_input_strides;
+  std::vector<size_t> outer_output_strides;
+};
 
-      ++output_for_first_writer;
+// Drops the axes of size 1 and merges input axes that stay adjacent and in order in the output.
+void MergeTransposeAxes(const std::vector<size_t>& permutations, const std::vector<int64_t>& input_dims,
+                        std::vector<size_t>& merged_dims, std::vector<size_t>& merged_perm) {
+  const size_t rank = input_dims.size();
+
+  // renumber the axes that are kept
+  std::vector<size_t> kept_axis(rank);
+  std::vector<size_t> kept_dims;
+  for (size_t axis = 0; axis < rank; ++axis) {
+    kept_axis[axis] = kept_dims.size();
+    if (input_dims[axis] != 1) {
+      kept_dims.push_back(static_cast<size_t>(input_dims[axis]));
     }
-
-    output_data += writes_per_loop;
-  }
-}
-
-template <typename T>
-typename std::enable_if<has_mlas_transpose<T>::value, void>::type
-SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                  int64_t num_loops, int64_t num_writers,
-                                  int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    MlasTranspose(input_data,
-                  output_data,
-                  static_cast<size_t>(writes_per_writer_per_loop),
-                  static_cast<size_t>(num_writers));
-    input_data += writes_per_loop;
-    output_data += writes_per_loop;
   }
-}
-
-//  `input_shape_override` overrides the shape of `input` for compute purposes.
-void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                 int64_t from, int64_t to, const TensorShape* input_shape_override = nullptr) {
-  ORT_UNUSED_PARAMETER(permutations);
-
-  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-
-  const auto element_size = input.DataType()->Size();
 
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-
-  auto num_loops = input_shape.SizeToDimension(to);
-  auto num_writers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(from + 1);
-  auto writes_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto writes_per_writer_per_loop = int64_t(writes_per_loop / num_writers);
-  const int64_t bytes_per_write = block_size * element_size;
-
-  switch (bytes_per_write) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisOutwards(input_data, output_data,
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
-                                        reinterpret_cast<uint16_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint32_t*>(input_data),
-                                        reinterpret_cast<uint32_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
+  std::vector<size_t> kept_perm;
+  for (size_t axis : permutations) {
+    if (input_dims[axis] != 1) {
+      kept_perm.push_back(kept_axis[axis]);
     }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint64_t*>(input_data),
-                                        reinterpret_cast<uint64_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        uint8_t* output_for_first_writer = output_data;
-
-        for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-          uint8_t* output_for_current_writer = output_for_first_writer;
-
-          for (int64_t w = 0; w < num_writers; ++w) {
-            memcpy(output_for_current_writer, input_data, bytes_per_write);
-            // skip to output position for next writer
-            output_for_current_writer += (writes_per_writer_per_loop * bytes_per_write);
-            input_data += bytes_per_write;
-          }
-
-          output_for_first_writer += bytes_per_write;
-        }
+  }
 
-        output_data += writes_per_loop * bytes_per_write;
-      }
+  // group the runs of consecutive input axes. group_of_first_axis maps the first kept axis of each group to the
+  // position of the group in the output.
+  const size_t num_kept = kept_perm.size();
+  std::vector<size_t> group_dims;
+  std::vector<size_t> group_of_first_axis(num_kept, std::numeric_limits<size_t>::max());
+  for (size_t i = 0; i < num_kept; ++i) {
+    if (i > 0 && kept_perm[i] == kept_perm[i - 1] + 1) {
+      group_dims.back() *= kept_dims[kept_perm[i]];
+    } else {
+      group_of_first_axis[kept_perm[i]] = group_dims.size();
+      group_dims.push_back(kept_dims[kept_perm[i]]);
     }
   }
-}
-
-template <typename T>
-typename std::enable_if<!has_mlas_transpose<T>::value, void>::type
-SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                 int64_t num_loops, int64_t num_readers,
-                                 int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  T* end;
-  for (int64_t l = 0; l < num_loops; ++l) {
-    const T* input_for_first_reader = input_data;
-
-    for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-      const T* input_for_current_reader = input_for_first_reader;
-
-      end = output_data + num_readers;
-      for (; output_data != end;) {
-        *output_data++ = *input_for_current_reader;
-        // skip to input position for next reader
-        input_for_current_reader += reads_per_reader_per_loop;
-      }
 
-      ++input_for_first_reader;
+  // the merged input axes are the groups in input order
+  merged_dims.resize(group_dims.size());
+  merged_perm.resize(group_dims.size());
+  size_t merged_axis = 0;
+  for (size_t axis = 0; axis < num_kept; ++axis) {
+    size_t group = group_of_first_axis[axis];
+    if (group != std::numeric_limits<size_t>::max()) {
+      merged_dims[merged_axis] = group_dims[group];
+      merged_perm[group] = merged_axis;
+      ++merged_axis;
     }
-
-    input_data += reads_per_loop;
   }
 }
 
-template <typename T>
-typename std::enable_if<has_mlas_transpose<T>::value, void>::type
-SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                 int64_t num_loops, int64_t num_readers,
-                                 int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    MlasTranspose(input_data,
-                  output_data,
-                  static_cast<size_t>(num_readers),
-                  static_cast<size_t>(reads_per_reader_per_loop));
-    input_data += reads_per_loop;
-    output_data += reads_per_loop;
+// Returns false if the transpose only copies the data.
+bool BuildBlockedTranspose(const std::vector<size_t>& permutations, const std::vector<int64_t>& input_dims,
+                           size_t element_size, BlockedTransposeParams& params) {
+  std::vector<size_t> dims;
+  std::vector<size_t> perm;
+  MergeTransposeAxes(permutations, input_dims, dims, perm);
+
+  size_t rank = perm.size();
+  if (rank > 0 && perm[rank - 1] == rank - 1) {
+    element_size *= dims[rank - 1];
+    dims.pop_back();
+    perm.pop_back();
+    --rank;
   }
-}
-
-// moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
-//  `input_shape_override` overrides the shape of `input` for compute purposes.
-void TransposeSingleAxisInwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                int64_t from, int64_t to, const TensorShape* input_shape_override = nullptr) {
-  ORT_UNUSED_PARAMETER(permutations);
 
-  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
-  const auto& input_dims = input_shape.GetDims();
+  if (rank < 2) {
+    return false;
+  }
 
-  const auto element_size = input.DataType()->Size();
+  std::vector<size_t> input_strides(rank);
+  std::vector<size_t> output_strides(rank);
+  input_strides[rank - 1] = 1;
+  output_strides[rank - 1] = 1;
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * dims[i];
+    output_strides[i - 1] = output_strides[i] * dims[perm[i]];
+  }
 
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+  const size_t row_axis = perm[rank - 1];
+  params.element_size = element_size;
+  params.rows = dims[row_axis];
+  params.cols = dims[rank - 1];
+  params.input_row_stride = input_strides[row_axis];
+  params.outer_dims.clear();
+  params.outer_input_strides.clear();
+  params.outer_output_strides.clear();
+
+  for (size_t i = 0; i < rank - 1; ++i) {
+    if (perm[i] == rank - 1) {
+      params.output_row_stride = output_strides[i];
+    } else {
+      params.outer_dims.push_back(dims[perm[i]]);
+      params.outer_input_strides.push_back(input_strides[perm[i]]);
+      params.outer_output_strides.push_back(output_strides[i]);
+    }
+  }
 
-  auto num_loops = input_shape.SizeToDimension(from);
-  auto num_readers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(to + 1);
-  auto reads_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto reads_per_reader_per_loop = int64_t(reads_per_loop / num_readers);
-  const int64_t bytes_per_read = block_size * element_size;
+  return true;
+}
 
-  switch (bytes_per_read) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisInwards(input_data, output_data,
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+void TransposeTileKernel(const BlockedTransposeParams& params, const uint8_t* input, uint8_t* output,
+                         size_t rows, size_t cols) {
+  switch (params.element_size) {
+    case sizeof(uint8_t):
+      MlasTranspose(input, params.input_row_stride, output, params.output_row_stride, rows, cols);
       break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
-                                       reinterpret_cast<uint16_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint16_t):
+      MlasTranspose(reinterpret_cast<const uint16_t*>(input), params.input_row_stride,
+                    reinterpret_cast<uint16_t*>(output), params.output_row_stride, rows, cols);
       break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint32_t*>(input_data),
-                                       reinterpret_cast<uint32_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint32_t):
+      MlasTranspose(reinterpret_cast<const uint32_t*>(input), params.input_row_stride,
+                    reinterpret_cast<uint32_t*>(output), params.output_row_stride, rows, cols);
       break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint64_t*>(input_data),
-                                       reinterpret_cast<uint64_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint64_t):
+      MlasTranspose(reinterpret_cast<const uint64_t*>(input), params.input_row_stride,
+                    reinterpret_cast<uint64_t*>(output), params.output_row_stride, rows, cols);
       break;
-    }
     default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        const uint8_t* input_for_first_reader = input_data;
-
-        for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          const uint8_t* input_for_current_reader = input_for_first_reader;
-
-          for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, input_for_current_reader, bytes_per_read);
-            output_data += bytes_per_read;
-
-            // skip to input position for next reader
-            input_for_current_reader += (reads_per_reader_per_loop * bytes_per_read);
-          }
-
-          input_for_first_reader += bytes_per_read;
+      const size_t element_size = params.element_size;
+      const size_t input_row_bytes = params.input_row_stride * element_size;
+      const size_t output_row_bytes = params.output_row_stride * element_size;
+      for (size_t r = 0; r < rows; ++r) {
+        const uint8_t* input_row = input + r * input_row_bytes;
+        uint8_t* output_col = output + r * element_size;
+        for (size_t c = 0; c < cols; ++c) {
+          memcpy(output_col + c * output_row_bytes, input_row + c * element_size, element_size);
         }
-
-        input_data += reads_per_loop * bytes_per_read;
       }
     }
   }
 }
 
-//  `input_shape_override` overrides the shape of `input` for compute purposes.
-void SingleAxisTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                         size_t from, size_t to, const TensorShape* input_shape_override = nullptr) {
-  if (from > to) {
-    TransposeSingleAxisOutwards(permutations, input, output, from, to, input_shape_override);
+// Split point of a tile dimension. Keep it a multiple of the 8x8 micro-kernel size when possible.
+inline size_t SplitTileDim(size_t n) {
+  size_t half = n / 2;
+  return half >= 8 ? half & ~size_t{7} : half;
+}
+
+void TransposeTile(const BlockedTransposeParams& params, const uint8_t* input, uint8_t* output,
+                   size_t rows, size_t cols) {
+  if (rows * cols * params.element_size <= kTransposeTileBytes || (rows == 1 && cols == 1)) {
+    TransposeTileKernel(params, input, output, rows, cols);
+  } else if (rows >= cols) {
+    size_t split = SplitTileDim(rows);
+    TransposeTile(params, input, output, split, cols);
+    TransposeTile(params, input + split * params.input_row_stride * params.element_size,
+                  output + split * params.element_size, rows - split, cols);
   } else {
-    TransposeSingleAxisInwards(permutations, input, output, from, to, input_shape_override);
+    size_t split = SplitTileDim(cols);
+    TransposeTile(params, input, output, rows, split);
+    TransposeTile(params, input + split * params.element_size,
+                  output + split * params.output_row_stride * params.element_size, rows, cols - split);
   }
 }
 
-bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t& from, size_t& to) {
-  // if a single axis moved to an outer dimension, the values should be one lower than the index until the slot the
-  // axis was moved from, and equal to the index after that.
-  // e.g. axis 3 moves out to 1 would be: 0, 3, 1, 2, 4
-  auto check_moved_outwards = [&permutations](size_t cur, size_t moved_from) {
-    // we start processing with the slot after the moved one, so the expected value is one less than the index
-    size_t expected = cur - 1;
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        return false;
-      }
-
-      // we are at the slot the axis moved from, so do an additional increment before checking the next value
-      if (cur == moved_from) {
-        ++expected;
-      }
+void DoBlockedTranspose(const BlockedTransposeParams& params, const uint8_t* input, uint8_t* output,
+                        concurrency::ThreadPool* tp) {
+  size_t outer_count = 1;
+  for (size_t dim : params.outer_dims) {
+    outer_count *= dim;
+  }
 
-      ++expected;
-    }
+  const size_t strips_per_transpose = (params.rows + kTransposeRowsPerStrip - 1) / kTransposeRowsPerStrip;
+  const size_t num_strips = outer_count * strips_per_transpose;
+  const size_t strip_elements = std::min(params.rows, kTransposeRowsPerStrip) * params.cols;
+  const double strip_bytes = static_cast<double>(strip_elements * params.element_size);
+  const bool tiled = params.element_size < kTransposeUntiledElementBytes;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_strips),
+      TensorOpCost{strip_bytes, strip_bytes, static_cast<double>(strip_elements)},
+      [&params, input, output, strips_per_transpose, tiled](std::ptrdiff_t first, std::ptrdiff_t last) {
+        const size_t num_outer_axes = params.outer_dims.size();
+        for (auto strip = static_cast<size_t>(first), end = static_cast<size_t>(last); strip < end; ++strip) {
+          size_t outer_index = strip / strips_per_transpose;
+          size_t row = (strip % strips_per_transpose) * kTransposeRowsPerStrip;
+          size_t rows = std::min(kTransposeRowsPerStrip, params.rows - row);
+
+          size_t input_offset = row * params.input_row_stride;
+          size_t output_offset = row;
+          for (size_t i = num_outer_axes; i > 0; --i) {
+            size_t index = outer_index % params.outer_dims[i - 1];
+            outer_index /= params.outer_dims[i - 1];
+            input_offset += index * params.outer_input_strides[i - 1];
+            output_offset += index * params.outer_output_strides[i - 1];
+          }
 
-    return true;
-  };
-
-  // if a single axis moved to an inner dimension, the values should be one higher than the index until the slot the
-  // axis was moved to, and equal to the index after that.
-  // e.g. axis 1 moves inwards to 3 would be: 0, 2, 3, 1, 4
-  auto check_moved_inwards = [&permutations](size_t cur, size_t& moved_to) {
-    size_t started_at = cur;
-    size_t expected = cur + 1;
-    moved_to = std::numeric_limits<size_t>::max();
-
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        // if a single axis moved it must have come from the location we started at
-        if (started_at != permutations[cur]) {
-          return false;
+          const uint8_t* strip_input = input + input_offset * params.element_size;
+          uint8_t* strip_output = output + output_offset * params.element_size;
+          if (tiled) {
+            TransposeTile(params, strip_input, strip_output, rows, params.cols);
+          } else {
+            TransposeTileKernel(params, strip_input, strip_output, rows, params.cols);
+          }
         }
+      });
+}
 
-        moved_to = cur;
-      } else {
-        ++expected;
-      }
-    }
-
-    return moved_to != std::numeric_limits<size_t>::max();
-  };
-
-  bool single_axis_moved = false;
-  // check axis moving outwards (earlier entry in permutations)
-  for (size_t i = 0, end = permutations.size(); i < end; ++i) {
-    size_t axis = permutations[i];
-
-    if (axis != i) {
-      if (check_moved_outwards(i + 1, axis)) {
-        single_axis_moved = true;
-        to = i;
-        from = axis;
-      } else if (check_moved_inwards(i, to)) {
-        single_axis_moved = true;
-        from = i;
-      }
+//  `input_shape_override` overrides the shape of `input` for compute purposes.
+void BlockedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                      const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
+  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
 
-      break;
-    }
+  BlockedTransposeParams params;
+  if (BuildBlockedTranspose(permutations, input_shape.GetDims(), input.DataType()->Size(), params)) {
+    DoBlockedTranspose(params, reinterpret_cast<const uint8_t*>(input.DataRaw()),
+                       reinterpret_cast<uint8_t*>(output.MutableDataRaw()), tp);
+  } else {
+    CopyCpuTensor(&input, &output);
   }
-
-  return single_axis_moved;
 }
 
 }  // namespace
@@ -671,7 +546,7 @@ bool IsTransposeReshape(const std::vector<size_t>& perm, const std::vector<int64
 
 //`input_shape_override` overrides the shape of `input` for compute purposes.
 Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                  const TensorShape* input_shape_override) {
+                                  const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -689,14 +564,10 @@ Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const
       return Status::OK();
     }
 
-    size_t from = 0, to = 0;
-    bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
-
-    if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to, input_shape_override);
+    if (input.IsDataTypeString()) {
+      status = DoStringTranspose(permutations, input, output, input_shape_override);
     } else {
-      // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output, input_shape_override);
+      BlockedTranspose(permutations, input, output, input_shape_override, tp);
     }
   }
 
@@ -731,14 +602,10 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
+  if (X.IsDataTypeString()) {
+    status = DoStringTranspose(*p_perm, X, Y);
   } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
+    BlockedTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
   }
 
   return status;
@@ -3,8 +3,14 @@
 
 #include "core/providers/cpu/tensor/unique.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <map>
+#include <numeric>
+#include <type_traits>
 #include "gsl/gsl"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
@@ -299,6 +305,280 @@ static void CreateOutput(OpKernelContext& context,
   }
 }
 
+// The flattened Unique of arithmetic types uses open addressing hash tables instead of a std::map.
+// Large inputs are radix partitioned on the high bits of the hash, and each partition is deduplicated by its own
+// thread. Only the unique values are sorted at the end, by value or by first occurrence.
+constexpr int64_t kUniqueParallelMinSize = 64 * 1024;
+constexpr int64_t kUniqueMinBlockSize = 16 * 1024;
+constexpr int kUniqueMaxPartitionBits = 8;
+
+// Bits to hash and compare a value by. 0.0 and -0.0 map to the same key, as they compare equal in the std::map.
+template <typename T>
+static inline typename std::enable_if<std::is_floating_point<T>::value, uint64_t>::type UniqueKey(T value) {
+  if (value == 0) {
+    value = 0;
+  }
+  typename std::conditional<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>::type bits;
+  static_assert(sizeof(bits) == sizeof(T), "Unexpected floating point size");
+  memcpy(&bits, &value, sizeof(T));
+  return bits;
+}
+
+template <typename T>
+static inline typename std::enable_if<std::is_integral<T>::value, uint64_t>::type UniqueKey(T value) {
+  return static_cast<uint64_t>(value);
+}
+
+static inline uint64_t UniqueHash(uint64_t key) {
+  // splitmix64 finalizer, so that all bits of the hash depend on all bits of the key
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ULL;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+  return key;
+}
+
+// Open addressing hash table with linear probing, from a key to the id of its unique value.
+class UniqueHashTable {
+ public:
+  UniqueHashTable() : keys_(kInitialCapacity), ids_(kInitialCapacity, -1) {}
+
+  // Returns the id of the key, inserting it with new_id if it is not in the table yet.
+  int64_t FindOrInsert(uint64_t key, uint64_t hash, int64_t new_id) {
+    if (2 * (size_ + 1) > ids_.size()) {
+      Grow();
+    }
+
+    const size_t mask = ids_.size() - 1;
+    for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+      if (ids_[slot] < 0) {
+        keys_[slot] = key;
+        ids_[slot] = new_id;
+        ++size_;
+        return new_id;
+      }
+      if (keys_[slot] == key) {
+        return ids_[slot];
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kInitialCapacity = 256;
+
+  void Grow() {
+    std::vector<uint64_t> keys(2 * keys_.size());
+    std::vector<int64_t> ids(2 * ids_.size(), -1);
+    const size_t mask = ids.size() - 1;
+    for (size_t i = 0; i < ids_.size(); ++i) {
+      if (ids_[i] >= 0) {
+        size_t slot = static_cast<size_t>(UniqueHash(keys_[i])) & mask;
+        while (ids[slot] >= 0) {
+          slot = (slot + 1) & mask;
+        }
+        keys[slot] = keys_[i];
+        ids[slot] = ids_[i];
+      }
+    }
+    keys_.swap(keys);
+    ids_.swap(ids);
+  }
+
+  std::vector<uint64_t> keys_;
+  std::vector<int64_t> ids_;
+  size_t size_{0};
+};
+
+// Unique values of one partition, in order of their first occurrence.
+struct UniquePartition {
+  std::vector<int64_t> first;
+  std::vector<int64_t> counts;
+
+  // Adds the elements at the given indices, which must be ascending. Writes the id of the unique value of each
+  // element, local to the partition, to local_ids if it is not null.
+  template <typename T, typename GetIndex>
+  void Add(const T* data, int64_t num_elements, GetIndex get_index, int64_t* local_ids) {
+    UniqueHashTable table;
+    for (int64_t n = 0; n < num_elements; ++n) {
+      const int64_t i = get_index(n);
+      const uint64_t key = UniqueKey(data[i]);
+      const int64_t new_id = static_cast<int64_t>(first.size());
+      const int64_t id = table.FindOrInsert(key, UniqueHash(key), new_id);
+      if (id == new_id) {
+        first.push_back(i);
+        counts.push_back(1);
+      } else {
+        ++counts[id];
+      }
+      if (local_ids != nullptr) {
+        local_ids[i] = id;
+      }
+    }
+  }
+};
+
+template <typename T>
+static typename std::enable_if<std::is_floating_point<T>::value, bool>::type HasNaN(gsl::span<const T> data) {
+  return std::any_of(data.cbegin(), data.cend(), [](T value) { return std::isnan(value); });
+}
+
+template <typename T>
+static typename std::enable_if<!std::is_floating_point<T>::value, bool>::type HasNaN(gsl::span<const T>) {
+  return false;
+}
+
+template <typename T>
+static typename std::enable_if<std::is_arithmetic<T>::value, bool>::type TryComputeFlattenedWithHash(
+    OpKernelContext& context, gsl::span<const T> data, bool sorted) {
+  // NaN does not compare equal to itself, so leave it to the std::map path to keep its behavior
+  if (HasNaN(data)) {
+    return false;
+  }
+
+  const int64_t num_elements = static_cast<int64_t>(data.size());
+  concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
+
+  int partition_bits = 0;
+  if (num_elements >= kUniqueParallelMinSize) {
+    // a few partitions per thread to balance the load, as the number of unique values differs between them
+    const int dop = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    while (partition_bits < kUniqueMaxPartitionBits && (1 << partition_bits) < 4 * dop) {
+      ++partition_bits;
+    }
+  }
+  const int num_partitions = 1 << partition_bits;
+  auto partition_of = [partition_bits](uint64_t hash) {
+    return partition_bits == 0 ? 0 : static_cast<int>(hash >> (64 - partition_bits));
+  };
+
+  // the inverse indices output holds the local ids until the global order of the unique values is known
+  Tensor* inverse_indices = context.Output(2, {num_elements});
+  int64_t* local_ids = inverse_indices != nullptr ? inverse_indices->MutableData<int64_t>() : nullptr;
+
+  std::vector<UniquePartition> partitions(num_partitions);
+  std::vector<uint8_t> element_partition;
+  if (num_partitions == 1) {
+    partitions[0].Add(data.data(), num_elements, [](int64_t n) { return n; }, local_ids);
+  } else {
+    // count the elements of each partition in each block, then scatter their indices grouped by partition.
+    // blocks are scanned in order, so the indices of each partition stay ascending.
+    const int64_t num_blocks = std::min<int64_t>(num_elements / kUniqueMinBlockSize,
+                                                 4 * concurrency::ThreadPool::DegreeOfParallelism(tp));
+    auto block_begin = [num_elements, num_blocks](int64_t b) { return num_elements * b / num_blocks; };
+
+    element_partition.resize(num_elements);
+    std::vector<int64_t> offsets(num_blocks * num_partitions, 0);
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t b) {
+      int64_t* block_counts = offsets.data() + b * num_partitions;
+      for (int64_t i = block_begin(b), end = block_begin(b + 1); i < end; ++i) {
+        const int p = partition_of(UniqueHash(UniqueKey(data[i])));
+        element_partition[i] = static_cast<uint8_t>(p);
+        ++block_counts[p];
+      }
+    });
+
+    std::vector<int64_t> partition_begin(num_partitions + 1, 0);
+    int64_t offset = 0;
+    for (int p = 0; p < num_partitions; ++p) {
+      partition_begin[p] = offset;
+      for (int64_t b = 0; b < num_blocks; ++b) {
+        const int64_t count = offsets[b * num_partitions + p];
+        offsets[b * num_partitions + p] = offset;
+        offset += count;
+      }
+    }
+    partition_begin[num_partitions] = offset;
+
+    std::vector<int64_t> partitioned_indices(num_elements);
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t b) {
+      int64_t* block_offsets = offsets.data() + b * num_partitions;
+      for (int64_t i = block_begin(b), end = block_begin(b + 1); i < end; ++i) {
+        partitioned_indices[block_offsets[element_partition[i]]++] = i;
+      }
+    });
+
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_partitions, [&](std::ptrdiff_t p) {
+      const int64_t* indices = partitioned_indices.data() + partition_begin[p];
+      partitions[p].Add(data.data(), partition_begin[p + 1] - partition_begin[p],
+                        [indices](int64_t n) { return indices[n]; }, local_ids);
+    });
+  }
+
+  // gather the unique values of all partitions, and order them by value or by first occurrence
+  std::vector<int64_t> partition_base(num_partitions + 1, 0);
+  for (int p = 0; p < num_partitions; ++p) {
+    partition_base[p + 1] = partition_base[p] + static_cast<int64_t>(partitions[p].first.size());
+  }
+  const int64_t num_unique = partition_base[num_partitions];
+
+  std::vector<int64_t> unique_first;
+  std::vector<int64_t> unique_counts;
+  unique_first.reserve(num_unique);
+  unique_counts.reserve(num_unique);
+  for (auto& partition : partitions) {
+    unique_first.insert(unique_first.end(), partition.first.cbegin(), partition.first.cend());
+    unique_counts.insert(unique_counts.end(), partition.counts.cbegin(), partition.counts.cend());
+    partition = UniquePartition();
+  }
+
+  std::vector<int64_t> order(num_unique);  // slot in unique_first of each output
+  if (sorted) {
+    std::vector<std::pair<T, int64_t>> values(num_unique);
+    for (int64_t slot = 0; slot < num_unique; ++slot) {
+      values[slot] = std::make_pair(data[unique_first[slot]], slot);
+    }
+    std::sort(values.begin(), values.end(),
+              [](const std::pair<T, int64_t>& a, const std::pair<T, int64_t>& b) { return a.first < b.first; });
+    for (int64_t output_idx = 0; output_idx < num_unique; ++output_idx) {
+      order[output_idx] = values[output_idx].second;
+    }
+  } else {
+    std::iota(order.begin(), order.end(), int64_t{0});
+    std::sort(order.begin(), order.end(),
+              [&unique_first](int64_t a, int64_t b) { return unique_first[a] < unique_first[b]; });
+  }
+
+  Tensor& Y = *context.Output(0, {num_unique});
+  Tensor* indices_out = context.Output(1, {num_unique});
+  Tensor* counts = context.Output(3, {num_unique});
+  T* Y_data = Y.MutableData<T>();
+  int64_t* indices_data = indices_out != nullptr ? indices_out->MutableData<int64_t>() : nullptr;
+  int64_t* counts_data = counts != nullptr ? counts->MutableData<int64_t>() : nullptr;
+
+  std::vector<int64_t> slot_to_output(num_unique);
+  for (int64_t output_idx = 0; output_idx < num_unique; ++output_idx) {
+    const int64_t slot = order[output_idx];
+    slot_to_output[slot] = output_idx;
+    Y_data[output_idx] = data[unique_first[slot]];
+    if (indices_data != nullptr) {
+      indices_data[output_idx] = unique_first[slot];
+    }
+    if (counts_data != nullptr) {
+      counts_data[output_idx] = unique_counts[slot];
+    }
+  }
+
+  if (local_ids != nullptr) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_elements, TensorOpCost{static_cast<double>(sizeof(int64_t) + 1), static_cast<double>(sizeof(int64_t)), 2.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const int64_t base = num_partitions == 1 ? 0 : partition_base[element_partition[i]];
+            local_ids[i] = slot_to_output[base + local_ids[i]];
+          }
+        });
+  }
+
+  return true;
+}
+
+template <typename T>
+static typename std::enable_if<!std::is_arithmetic<T>::value, bool>::type TryComputeFlattenedWithHash(
+    OpKernelContext&, gsl::span<const T>, bool) {
+  return false;
+}
+
 template <typename T>
 Status Unique::ComputeImpl(OpKernelContext& context) const {
   if (!utils::HasType<EnabledUniqueDataTypes, T>()) {
@@ -308,6 +588,10 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   const Tensor& input = *context.Input<Tensor>(0);
   auto data = input.DataAsSpan<T>();
 
+  if (flatten_ && TryComputeFlattenedWithHash<T>(context, data, sort_)) {
+    return Status::OK();
+  }
+
   if (flatten_) {
     std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
     std::vector<std::vector<int64_t>> indices;
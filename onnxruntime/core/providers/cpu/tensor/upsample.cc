@@ -5,6 +5,7 @@
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample.h"
 #include <sstream>
+#include <type_traits>
 
 using namespace onnxruntime::common;
 using namespace std;
@@ -297,148 +298,233 @@ Status UpsampleLinear(const T* input,
   return Status::OK();
 }
 
-// The following method supports a 4-D input in 'Linear mode'
-// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
-// the scale values for the outermost 2 dimensions are 1.
-// This is the common use-case where the 4-D input (batched multi-channel images)
-// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
-template <typename T>
-void UpsampleBilinear(int64_t batch_size,
-                      int64_t num_channels,
-                      int64_t input_height,
-                      int64_t input_width,
-                      int64_t output_height,
-                      int64_t output_width,
-                      float height_scale,
-                      float width_scale,
-                      const std::vector<float>& roi,
-                      bool use_extrapolation,
-                      float extrapolation_value,
-                      const T* XdataBase,
-                      T* YdataBase,
-                      AllocatorPtr& alloc,
-                      GetOriginalCoordinateFunc get_original_coordinate,
-                      concurrency::ThreadPool* tp) {
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  // For each index in the output height and output width, cache its corresponding indices in the input
-  // while multiplying it with the input stride for that dimension (cache because we don't have to re-compute
-  // each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> idx_buffer_size = SafeInt<size_t>(2) * sizeof(int64_t) * (output_height + output_width);
-
-  // For each index in the output height and output width, cache its corresponding "weights/scales" for its
-  // corresponding indices in the input which proportionately indicates how much they will influence the final
-  // pixel value in the output
-  // (cache because we don't have to re-compute each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> scale_buffer_size = SafeInt<size_t>(2) * sizeof(float_t) * (output_height + output_width);
-
-  // Limit number of allocations to just 1
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  BufferUniquePtr idx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
+// For each index in the output height and output width, compute its corresponding 2 indices in the input
+// and their "weights" which proportionately indicate how much they influence the final pixel value in the output
+static BilinearParams SetupUpsampleBilinear(int64_t input_height,
+                                            int64_t input_width,
+                                            int64_t output_height,
+                                            int64_t output_width,
+                                            float height_scale,
+                                            float width_scale,
+                                            float roi_y_start,
+                                            float roi_y_end,
+                                            float roi_x_start,
+                                            float roi_x_end,
+                                            const GetOriginalCoordinateFunc& get_original_coordinate) {
+  BilinearParams p;
+
+  p.in_y1.resize(output_height);
+  p.in_y2.resize(output_height);
+  p.dy1.resize(output_height);
+  p.dy2.resize(output_height);
+  p.y_outside.resize(output_height);
 
-  // Get pointers to appropriate memory locations in the scratch buffer
-  auto* idx_data = static_cast<int64_t*>(idx_scale_data_buffer_holder.get());
-
-  // input_width is the stride for the height dimension
-  int64_t* input_width_mul_y1 = idx_data;
-  int64_t* input_width_mul_y2 = input_width_mul_y1 + output_height;
-
-  // stride for width is 1 (no multiplication needed)
-  int64_t* in_x1 = input_width_mul_y1 + 2 * output_height;
-  int64_t* in_x2 = in_x1 + output_width;
-
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-
-  float* dy1 = scale_data;
-  float* dy2 = dy1 + output_height;
-
-  float* dx1 = dy1 + 2 * output_height;
-  float* dx2 = dx1 + output_width;
-
-  // Start processing
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
   for (int64_t y = 0; y < output_height; ++y) {
     float in_y = height_scale == 1 ? static_cast<float>(y)
                                    : get_original_coordinate(static_cast<float>(y), height_scale,
                                                              static_cast<float>(output_height),
                                                              static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
+                                                             roi_y_start, roi_y_end);
+    p.y_outside[y] = in_y < 0 || in_y > static_cast<float>(input_height - 1);
     in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
 
-    const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-    const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
-
-    if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
+    p.in_y1[y] = std::min(static_cast<int64_t>(in_y), input_height - 1);
+    p.in_y2[y] = std::min(p.in_y1[y] + 1, input_height - 1);
+    p.dy1[y] = std::fabs(in_y - p.in_y1[y]);
+    p.dy2[y] = std::fabs(in_y - p.in_y2[y]);
+    if (p.in_y1[y] == p.in_y2[y]) {
+      p.dy1[y] = 0.5f;
+      p.dy2[y] = 0.5f;
     }
-
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
   }
 
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
+  p.in_x1.resize(output_width);
+  p.in_x2.resize(output_width);
+  p.dx1.resize(output_width);
+  p.dx2.resize(output_width);
+  p.x_outside.resize(output_width);
+
   for (int64_t x = 0; x < output_width; ++x) {
     float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
+                                  : get_original_coordinate(static_cast<float>(x), width_scale,
                                                             static_cast<float>(output_width),
                                                             static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
+                                                            roi_x_start, roi_x_end);
+    p.x_outside[x] = in_x < 0 || in_x > static_cast<float>(input_width - 1);
     in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
 
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
-
-    dx1[x] = std::fabs(in_x - in_x1[x]);
-    dx2[x] = std::fabs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
+    p.in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
+    p.in_x2[x] = std::min(p.in_x1[x] + 1, input_width - 1);
+    p.dx1[x] = std::fabs(in_x - p.in_x1[x]);
+    p.dx2[x] = std::fabs(in_x - p.in_x2[x]);
+    if (p.in_x1[x] == p.in_x2[x]) {
+      p.dx1[x] = 0.5f;
+      p.dx2[x] = 0.5f;
     }
   }
-  
- for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_channels,
-                                                  [&](std::ptrdiff_t c) {
-                                                    const T* Xdata = XdataBase + (n * num_channels + c) * (input_height * input_width);
-                                                    T* Ydata = YdataBase + (n * num_channels + c) * (output_height * output_width);
-                                                    for (int64_t y = 0; y < output_height; ++y) {
-                                                      for (int64_t x = 0; x < output_width; ++x) {
-                                                        // when use_extrapolation is set and original index of x or y is out of the dim range
-                                                        // then use extrapolation_value as the output value.
-                                                        if (use_extrapolation &&
-                                                            ((y_original[y] < 0 || y_original[y] > static_cast<float>(input_height - 1)) ||
-                                                             (x_original[x] < 0 || x_original[x] > static_cast<float>(input_width - 1)))) {
-                                                          Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
-                                                          continue;
-                                                        }
 
-                                                        T X11 = Xdata[input_width_mul_y1[y] + in_x1[x]];
-                                                        T X21 = Xdata[input_width_mul_y1[y] + in_x2[x]];
-                                                        T X12 = Xdata[input_width_mul_y2[y] + in_x1[x]];
-                                                        T X22 = Xdata[input_width_mul_y2[y] + in_x2[x]];
+  return p;
+}
 
-                                                        Ydata[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
-                                                                                                     dx1[x] * dy2[y] * X21 +
-                                                                                                     dx2[x] * dy1[y] * X12 +
-                                                                                                     dx1[x] * dy1[y] * X22);
-                                                      }
-                                                    }
-                                                    Xdata += input_height * input_width;
-                                                    Ydata += output_width * output_height;
-                                                  });
+template <typename T>
+std::shared_ptr<const BilinearParams> Upsample<T>::GetBilinearParams(int64_t input_height, int64_t input_width,
+                                                                     int64_t output_height, int64_t output_width,
+                                                                     float height_scale, float width_scale,
+                                                                     float roi_y_start, float roi_y_end,
+                                                                     float roi_x_start, float roi_x_end) const {
+  std::vector<double> key{static_cast<double>(input_height), static_cast<double>(input_width),
+                          static_cast<double>(output_height), static_cast<double>(output_width),
+                          height_scale, width_scale, roi_y_start, roi_y_end, roi_x_start, roi_x_end};
+
+  {
+    std::lock_guard<OrtMutex> lock(bilinear_params_mutex_);
+    if (bilinear_params_ != nullptr && bilinear_params_->key == key) {
+      return bilinear_params_;
+    }
   }
+
+  auto params = std::make_shared<BilinearParams>(
+      SetupUpsampleBilinear(input_height, input_width, output_height, output_width, height_scale, width_scale,
+                            roi_y_start, roi_y_end, roi_x_start, roi_x_end, get_original_coordinate_));
+  params->key = std::move(key);
+
+  std::lock_guard<OrtMutex> lock(bilinear_params_mutex_);
+  bilinear_params_ = params;
+  return params;
+}
+
+// The following method supports a 4-D input in 'Linear mode'
+// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
+// the scale values for the outermost 2 dimensions are 1.
+// This is the common use-case where the 4-D input (batched multi-channel images)
+// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
+template <typename T>
+void UpsampleBilinear(int64_t batch_size,
+                      int64_t num_channels,
+                      int64_t input_height,
+                      int64_t input_width,
+                      int64_t output_height,
+                      int64_t output_width,
+                      const BilinearParams& p,
+                      bool use_extrapolation,
+                      float extrapolation_value,
+                      const T* XdataBase,
+                      T* YdataBase,
+                      concurrency::ThreadPool* tp) {
+  // Blending the 2 source rows first is a contiguous (vectorizable) pass that leaves 2 instead of 4 taps
+  // per output pixel, it pays off as long as the width is not downsampled.
+  // Only done for float as the different rounding could change the truncated value of integer outputs.
+  const bool blend_rows = std::is_same<T, float>::value && output_width >= input_width;
+
+  // Every output row of every channel is computed independently.
+  const double row_elements = static_cast<double>(output_width);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels * output_height),
+      TensorOpCost{row_elements * 2 * sizeof(T), row_elements * sizeof(T), row_elements * 8},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> blended_row(blend_rows ? input_width : 0);
+
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t nc = row / output_height;
+          const int64_t y = row % output_height;
+          T* Ydata = YdataBase + row * output_width;
+
+          // when use_extrapolation is set and original index of y is out of the dim range
+          // then use extrapolation_value as the output value of the whole row.
+          if (use_extrapolation && p.y_outside[y]) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          const T* Xdata = XdataBase + nc * input_height * input_width;
+          const T* X1 = Xdata + p.in_y1[y] * input_width;
+          const T* X2 = Xdata + p.in_y2[y] * input_width;
+          const float dy1 = p.dy1[y];
+          const float dy2 = p.dy2[y];
+
+          if (blend_rows) {
+            float* blended = blended_row.data();
+            for (int64_t x = 0; x < input_width; ++x) {
+              blended[x] = dy2 * X1[x] + dy1 * X2[x];
+            }
+            for (int64_t x = 0; x < output_width; ++x) {
+              Ydata[x] = static_cast<T>(p.dx2[x] * blended[p.in_x1[x]] + p.dx1[x] * blended[p.in_x2[x]]);
+            }
+          } else {
+            for (int64_t x = 0; x < output_width; ++x) {
+              T X11 = X1[p.in_x1[x]];
+              T X21 = X1[p.in_x2[x]];
+              T X12 = X2[p.in_x1[x]];
+              T X22 = X2[p.in_x2[x]];
+
+              Ydata[x] = static_cast<T>(p.dx2[x] * dy2 * X11 +
+                                        p.dx1[x] * dy2 * X21 +
+                                        p.dx2[x] * dy1 * X12 +
+                                        p.dx1[x] * dy1 * X22);
+            }
+          }
+
+          // when use_extrapolation is set and original index of x is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (p.x_outside[x]) {
+                Ydata[x] = static_cast<T>(extrapolation_value);
+              }
+            }
+          }
+        }
+      });
+}
+
+// The following method supports a 4-D input in 'Linear mode' laid out as [N, H, W, C]
+// (the scales are [1.0, height_scale, width_scale, 1.0]). The 2 input pixels of every output
+// pixel are shared by all the channels, which are contiguous, so one output row is computed at a time.
+template <typename T>
+void NhwcUpsampleBilinear(int64_t batch_size,
+                          int64_t num_channels,
+                          int64_t input_height,
+                          int64_t input_width,
+                          int64_t output_height,
+                          int64_t output_width,
+                          const BilinearParams& p,
+                          bool use_extrapolation,
+                          float extrapolation_value,
+                          const T* XdataBase,
+                          T* YdataBase,
+                          concurrency::ThreadPool* tp) {
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, batch_size * output_height,
+      [&](std::ptrdiff_t row) {
+        const int64_t n = row / output_height;
+        const int64_t y = row % output_height;
+        const T* Xdata = XdataBase + n * input_height * input_width * num_channels;
+        const T* X1 = Xdata + p.in_y1[y] * input_width * num_channels;
+        const T* X2 = Xdata + p.in_y2[y] * input_width * num_channels;
+        T* Ydata = YdataBase + row * output_width * num_channels;
+
+        for (int64_t x = 0; x < output_width; ++x, Ydata += num_channels) {
+          // when use_extrapolation is set and original index of x or y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation && (p.y_outside[y] || p.x_outside[x])) {
+            std::fill_n(Ydata, num_channels, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          const T* X11 = X1 + p.in_x1[x] * num_channels;
+          const T* X21 = X1 + p.in_x2[x] * num_channels;
+          const T* X12 = X2 + p.in_x1[x] * num_channels;
+          const T* X22 = X2 + p.in_x2[x] * num_channels;
+          const float w11 = p.dx2[x] * p.dy2[y];
+          const float w21 = p.dx1[x] * p.dy2[y];
+          const float w12 = p.dx2[x] * p.dy1[y];
+          const float w22 = p.dx1[x] * p.dy1[y];
+
+          for (int64_t c = 0; c < num_channels; ++c) {
+            Ydata[c] = static_cast<T>(w11 * X11[c] + w21 * X21[c] + w12 * X12[c] + w22 * X22[c]);
+          }
+        }
+      });
 }
 
 // The following method supports a 5-D input in 'Linear mode'
@@ -886,6 +972,18 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
     case UpsampleMode::LINEAR: {
       // Supports 'bilinear' and 'trilinear' sampling only
 
+      //'bilinear' == 4-D input laid out as NHWC, with outermost and innermost scales as 1
+      // roi is [start_0, start_1, start_2, start_3, end_0, end_1, end_2, end_3], H and W are the dims 1 and 2
+      if (dims.size() == 4 && !(scales[0] == 1 && scales[1] == 1)) {
+        auto params = GetBilinearParams(dims[1], dims[2], output_dims[1], output_dims[2], scales[1], scales[2],
+                                        roi[1], roi[5], roi[2], roi[6]);
+        NhwcUpsampleBilinear(dims[0], dims[3], dims[1], dims[2], output_dims[1], output_dims[2],
+                             *params, use_extrapolation_, extrapolation_value_,
+                             X->template Data<T>(), Y->template MutableData<T>(),
+                             output_dims[1] * output_dims[2] > 64 ? context->GetOperatorThreadPool() : nullptr);
+        return Status::OK();
+      }
+
       //'bilinear' == 2-D input or 4-D input with outermost 2 scales as 1
       if (dims.size() == 2 || dims.size() == 4) {
         bool is_2D = dims.size() == 2;
@@ -898,13 +996,15 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
         const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
-        AllocatorPtr alloc;
-        ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+        const size_t roi_y = roi.size() / 2 - 2;
+        const size_t roi_x = roi.size() / 2 - 1;
+        auto params = GetBilinearParams(input_height, input_width, output_height, output_width,
+                                        is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3],
+                                        roi[roi_y], roi[roi_y + dims.size()], roi[roi_x], roi[roi_x + dims.size()]);
         UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                         is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], roi,
-                         use_extrapolation_, extrapolation_value_, X->template Data<T>(),
-                         Y->template MutableData<T>(), alloc, get_original_coordinate_, 
-                         output_height*output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                         *params, use_extrapolation_, extrapolation_value_, X->template Data<T>(),
+                         Y->template MutableData<T>(),
+                         output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
         return Status::OK();
       } else if (dims.size() == 3 || dims.size() == 5) {
         //'trilinear' == 3-D input or 5-D input with outermost 2 scales as 1
@@ -4,7 +4,9 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 #include <cmath>
+#include <memory>
 
 namespace onnxruntime {
 
@@ -46,7 +48,13 @@ enum ResizeNearestMode {
 
 class UpsampleBase {
  protected:
-  UpsampleBase(OpKernelInfo info) : scales_cached_(false), roi_cached_(false), use_extrapolation_(false) {
+  // supports_channels_last_linear: the kernel can also resize 4-D inputs in 'Linear' mode
+  // when the scales of the outermost and the innermost dimensions are 1, i.e. images laid out as NHWC
+  UpsampleBase(OpKernelInfo info, bool supports_channels_last_linear = false)
+      : scales_cached_(false),
+        roi_cached_(false),
+        use_extrapolation_(false),
+        supports_channels_last_linear_(supports_channels_last_linear) {
     const auto& node = info.node();
     auto opset = node.SinceVersion();
     is_resize_ = (opset >= 10);
@@ -145,6 +153,7 @@ class UpsampleBase {
   bool roi_cached_;
   bool need_roi_input_;
   bool use_extrapolation_;
+  bool supports_channels_last_linear_;
   bool is_resize_ = false;
 
   int roi_input_idx_ = -1;
@@ -285,6 +294,7 @@ class UpsampleBase {
     if (UpsampleMode::LINEAR == mode) {
       ORT_ENFORCE(scales.size() == 2 ||
                       (scales.size() == 4 && scales[0] == 1 && scales[1] == 1) ||
+                      (supports_channels_last_linear_ && scales.size() == 4 && scales[0] == 1 && scales[3] == 1) ||
                       scales.size() == 3 ||
                       (scales.size() == 5 && scales[0] == 1 && scales[1] == 1),
                   "'Linear' mode only support 2-D inputs or 3-D inputs ('Bilinear', 'Trilinear') "
@@ -351,16 +361,46 @@ class UpsampleBase {
   }
 };  // UpsampleBase
 
+// The 2 source rows (columns) of every output row (column) of a bilinear resize and their weights.
+// They only depend on the sizes, the scales and the roi of the 2 spatial axes, which are kept in `key`.
+struct BilinearParams {
+  std::vector<double> key;
+
+  std::vector<int64_t> in_y1;
+  std::vector<int64_t> in_y2;
+  std::vector<float> dy1;
+  std::vector<float> dy2;
+  std::vector<bool> y_outside;
+
+  std::vector<int64_t> in_x1;
+  std::vector<int64_t> in_x2;
+  std::vector<float> dx1;
+  std::vector<float> dx2;
+  std::vector<bool> x_outside;
+};
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
-  Upsample(OpKernelInfo info) : UpsampleBase(info), OpKernel(info) {
+  Upsample(OpKernelInfo info) : UpsampleBase(info, true), OpKernel(info) {
   }
 
   Status Compute(OpKernelContext* context) const override;
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& roi, const std::vector<float>& scales,
                      const std::vector<int64_t>& output_dims) const;
+
+ private:
+  // Returns the bilinear tables of the spatial axes, the last ones are reused by the following
+  // calls as long as the sizes, the scales and the roi stay the same.
+  std::shared_ptr<const BilinearParams> GetBilinearParams(int64_t input_height, int64_t input_width,
+                                                          int64_t output_height, int64_t output_width,
+                                                          float height_scale, float width_scale,
+                                                          float roi_y_start, float roi_y_end,
+                                                          float roi_x_start, float roi_x_end) const;
+
+  mutable OrtMutex bilinear_params_mutex_;
+  mutable std::shared_ptr<const BilinearParams> bilinear_params_;
 };
 
 }  // namespace onnxruntime
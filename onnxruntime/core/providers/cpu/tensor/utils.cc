@@ -0,0 +1,234 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tensor/utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_AMD64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define STRIDED_COPY_NON_TEMPORAL
+#endif
+
+#include "core/common/cpuid_info.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// The copy is handed to the thread pool in blocks of about this many bytes.
+constexpr size_t kStridedCopyBlockBytes = 64 * 1024;
+
+// Used as the non-temporal threshold when the size of the last level cache is unknown.
+constexpr size_t kDefaultLastLevelCacheSize = 8 * 1024 * 1024;
+
+size_t NonTemporalThreshold() {
+  static const size_t threshold = []() {
+    size_t cache_size = CPUIDInfo::GetCPUIDInfo().GetLastLevelCacheSize();
+    return cache_size != 0 ? cache_size : kDefaultLastLevelCacheSize;
+  }();
+  return threshold;
+}
+
+void CopyBytes(uint8_t* dst, const uint8_t* src, size_t bytes, bool non_temporal) {
+#if defined(STRIDED_COPY_NON_TEMPORAL)
+  if (non_temporal && bytes >= 256) {
+    size_t head = (16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15;
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    bytes -= head;
+    for (; bytes >= 64; bytes -= 64, dst += 64, src += 64) {
+      __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+      __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+      __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+      __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst), v0);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), v1);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), v2);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), v3);
+    }
+  }
+#else
+  ORT_UNUSED_PARAMETER(non_temporal);
+#endif
+  memcpy(dst, src, bytes);
+}
+
+template <typename T>
+void CopyStridedElements(uint8_t* dst, int64_t dst_stride, const uint8_t* src, int64_t src_stride, size_t count) {
+  T* d = reinterpret_cast<T*>(dst);
+  const T* s = reinterpret_cast<const T*>(src);
+  for (size_t i = 0; i < count; ++i, d += dst_stride, s += src_stride) {
+    *d = *s;
+  }
+}
+
+// Iterates the rows (all axes but the innermost) of a strided copy, tracking the element offset of each row.
+struct StridedRowIterator {
+  StridedRowIterator(const std::vector<int64_t>& dims, const std::vector<int64_t>& dst_strides,
+                     const std::vector<int64_t>& src_strides, size_t row)
+      : dims_(dims), dst_strides_(dst_strides), src_strides_(src_strides), index_(dims.size(), 0) {
+    for (size_t i = dims_.size(); i-- > 0;) {
+      index_[i] = static_cast<int64_t>(row % static_cast<size_t>(dims_[i]));
+      row /= static_cast<size_t>(dims_[i]);
+      dst_offset += index_[i] * dst_strides_[i];
+      src_offset += index_[i] * src_strides_[i];
+    }
+  }
+
+  void Next() {
+    for (size_t i = dims_.size(); i-- > 0;) {
+      dst_offset += dst_strides_[i];
+      src_offset += src_strides_[i];
+      if (++index_[i] < dims_[i]) {
+        return;
+      }
+      dst_offset -= dims_[i] * dst_strides_[i];
+      src_offset -= dims_[i] * src_strides_[i];
+      index_[i] = 0;
+    }
+  }
+
+  int64_t dst_offset{0};
+  int64_t src_offset{0};
+
+ private:
+  const std::vector<int64_t>& dims_;
+  const std::vector<int64_t>& dst_strides_;
+  const std::vector<int64_t>& src_strides_;
+  std::vector<int64_t> index_;
+};
+
+}  // namespace
+
+void StridedCopy(concurrency::ThreadPool* thread_pool,
+                 void* dst, gsl::span<const int64_t> dst_strides,
+                 const void* src, gsl::span<const int64_t> src_strides,
+                 gsl::span<const int64_t> shape, size_t element_size) {
+  ORT_ENFORCE(dst_strides.size() == shape.size() && src_strides.size() == shape.size(),
+              "StridedCopy expects one source and destination stride per axis");
+
+  // Drop unit axes and merge each axis into its inner neighbour when both tensors are contiguous across them.
+  // The merged axes are collected innermost first.
+  std::vector<int64_t> dims, dst_pitches, src_pitches;
+  for (size_t i = shape.size(); i-- > 0;) {
+    if (shape[i] == 0) {
+      return;
+    }
+    if (shape[i] == 1) {
+      continue;
+    }
+    if (!dims.empty() &&
+        dst_strides[i] == dst_pitches.back() * dims.back() &&
+        src_strides[i] == src_pitches.back() * dims.back()) {
+      dims.back() *= shape[i];
+    } else {
+      dims.push_back(shape[i]);
+      dst_pitches.push_back(dst_strides[i]);
+      src_pitches.push_back(src_strides[i]);
+    }
+  }
+  if (dims.empty()) {
+    dims.push_back(1);
+    dst_pitches.push_back(1);
+    src_pitches.push_back(1);
+  }
+
+  const size_t row_size = static_cast<size_t>(dims.front());
+  const int64_t inner_dst_stride = dst_pitches.front();
+  const int64_t inner_src_stride = src_pitches.front();
+  const bool contiguous_rows = inner_dst_stride == 1 && inner_src_stride == 1;
+
+  // what remains are the row axes, outermost first
+  dims.erase(dims.begin());
+  dst_pitches.erase(dst_pitches.begin());
+  src_pitches.erase(src_pitches.begin());
+  std::reverse(dims.begin(), dims.end());
+  std::reverse(dst_pitches.begin(), dst_pitches.end());
+  std::reverse(src_pitches.begin(), src_pitches.end());
+
+  size_t num_rows = 1;
+  for (int64_t dim : dims) {
+    num_rows *= static_cast<size_t>(dim);
+  }
+
+  const size_t row_bytes = row_size * element_size;
+  const bool non_temporal = contiguous_rows && num_rows * row_bytes >= NonTemporalThreshold();
+
+  // Long rows are split into several blocks, short rows are grouped so that each block is about the same size.
+  size_t blocks_per_row = 1;
+  size_t rows_per_block = 1;
+  if (row_bytes >= kStridedCopyBlockBytes) {
+    blocks_per_row = (row_bytes + kStridedCopyBlockBytes - 1) / kStridedCopyBlockBytes;
+  } else {
+    rows_per_block = kStridedCopyBlockBytes / row_bytes;
+  }
+  const size_t columns_per_block = (row_size + blocks_per_row - 1) / blocks_per_row;
+  const size_t num_blocks = blocks_per_row > 1 ? num_rows * blocks_per_row
+                                               : (num_rows + rows_per_block - 1) / rows_per_block;
+
+  auto* dst_bytes = static_cast<uint8_t*>(dst);
+  const auto* src_bytes = static_cast<const uint8_t*>(src);
+  const auto element_bytes = static_cast<int64_t>(element_size);
+
+  auto copy_row = [&](const StridedRowIterator& row, size_t column_begin, size_t column_end) {
+    uint8_t* d = dst_bytes + (row.dst_offset + static_cast<int64_t>(column_begin) * inner_dst_stride) * element_bytes;
+    const uint8_t* s = src_bytes + (row.src_offset + static_cast<int64_t>(column_begin) * inner_src_stride) * element_bytes;
+    size_t count = column_end - column_begin;
+    if (contiguous_rows) {
+      CopyBytes(d, s, count * element_size, non_temporal);
+      return;
+    }
+    switch (element_size) {
+      case sizeof(uint8_t):
+        CopyStridedElements<uint8_t>(d, inner_dst_stride, s, inner_src_stride, count);
+        break;
+      case sizeof(uint16_t):
+        CopyStridedElements<uint16_t>(d, inner_dst_stride, s, inner_src_stride, count);
+        break;
+      case sizeof(uint32_t):
+        CopyStridedElements<uint32_t>(d, inner_dst_stride, s, inner_src_stride, count);
+        break;
+      case sizeof(uint64_t):
+        CopyStridedElements<uint64_t>(d, inner_dst_stride, s, inner_src_stride, count);
+        break;
+      default:
+        for (size_t i = 0; i < count; ++i) {
+          memcpy(d + i * inner_dst_stride * element_bytes, s + i * inner_src_stride * element_bytes, element_size);
+        }
+        break;
+    }
+  };
+
+  auto copy_blocks = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    if (blocks_per_row > 1) {
+      for (auto block = static_cast<size_t>(first); block < static_cast<size_t>(last); ++block) {
+        StridedRowIterator row(dims, dst_pitches, src_pitches, block / blocks_per_row);
+        size_t column_begin = (block % blocks_per_row) * columns_per_block;
+        copy_row(row, column_begin, std::min(row_size, column_begin + columns_per_block));
+      }
+    } else {
+      size_t row_begin = static_cast<size_t>(first) * rows_per_block;
+      size_t row_end = std::min(num_rows, static_cast<size_t>(last) * rows_per_block);
+      StridedRowIterator row(dims, dst_pitches, src_pitches, row_begin);
+      for (size_t r = row_begin; r < row_end; ++r, row.Next()) {
+        copy_row(row, 0, row_size);
+      }
+    }
+#if defined(STRIDED_COPY_NON_TEMPORAL)
+    if (non_temporal) {
+      // make the streaming stores visible before the caller (possibly on another thread) reads the output
+      _mm_sfence();
+    }
+#endif
+  };
+
+  const double block_bytes = static_cast<double>(std::min(row_bytes * rows_per_block, kStridedCopyBlockBytes));
+  concurrency::ThreadPool::TryParallelFor(thread_pool, static_cast<std::ptrdiff_t>(num_blocks),
+                                          TensorOpCost{block_bytes, block_bytes, 0}, copy_blocks);
+}
+
+}  // namespace onnxruntime
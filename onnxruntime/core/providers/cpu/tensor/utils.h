@@ -6,6 +6,9 @@
 #include "core/framework/utils.h"
 #include "core/common/safeint.h"
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 
 struct TensorPitches : std::vector<int64_t> {
   TensorPitches(const Tensor& tensor, size_t rank = 0) : TensorPitches(tensor.Shape(), rank) {}
@@ -372,6 +375,19 @@ inline void CopyCpuTensor(const Tensor* src, Tensor* tgt) {
   }
 }
 
+// Copies a strided region of a tensor of fixed size elements (not std::string). Element i0,...,iN of 'shape' is
+// read from src + sum(ik * src_strides[k]) and written to dst + sum(ik * dst_strides[k]), with strides given in
+// elements. Strides may be negative (reversed slices) or zero (broadcast/tiled inputs).
+//
+// Axes that are contiguous in both source and destination are merged first so the innermost copy is as long as
+// possible. Copies larger than a few blocks are split across 'thread_pool', and when the destination is larger than
+// the last level cache it is written with non-temporal stores so the copy does not evict the working set of the
+// kernels that run next.
+void StridedCopy(concurrency::ThreadPool* thread_pool,
+                 void* dst, gsl::span<const int64_t> dst_strides,
+                 const void* src, gsl::span<const int64_t> src_strides,
+                 gsl::span<const int64_t> shape, size_t element_size);
+
 // This provides easy sequential iteration over a subset of a tensor given a span of starts, extents & optionally steps
 template <typename T>
 struct WritableSliceIterator {
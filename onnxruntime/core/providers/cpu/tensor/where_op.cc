@@ -192,6 +192,186 @@ EnableIfEigenNotScalar<T, ProcessBroadcastSpanFuncs> MergeBroadcastFuncs() {
       }};
 }
 
+// Single pass selection, used when the output can be split in spans of contiguous elements over which each input
+// is either contiguous or a single broadcast value, e.g. masking attention scores:
+//   Where(mask[B, 1, S, S], scores[B, N, S, S], -inf)
+// Outside of the spans, the inputs are indexed with their broadcast strides.
+
+// the span must be long enough to amortize computing the input offsets at its start.
+constexpr int64_t kWhereMinSpanSize = 16;
+// elements per unit of work on the thread pool.
+constexpr int64_t kWhereBlockSize = 16384;
+
+// the condition is read as bytes, which lets the compiler vectorize the select.
+template <typename T, bool x_is_span, bool y_is_span>
+void SelectSpan(const uint8_t* condition, const T* X, const T* Y, T* output, int64_t count) {
+  for (int64_t i = 0; i < count; ++i) {
+    T x_value = X[x_is_span ? i : 0];
+    T y_value = Y[y_is_span ? i : 0];
+    output[i] = condition[i] != 0 ? x_value : y_value;
+  }
+}
+
+struct WhereInputLayout {
+  std::vector<int64_t> strides;  // per output dimension, 0 where the input is broadcast
+  bool is_span;                  // contiguous over the inner span, or a single value
+};
+
+// Computes the multidirectional broadcast of the three inputs and their layout over the largest inner span.
+// Returns false if the inputs can't be broadcast or the span is too short, the caller then uses the generic path.
+bool PlanSinglePassWhere(const std::vector<const TensorShape*>& shapes, std::vector<int64_t>& output_dims,
+                         std::vector<WhereInputLayout>& layouts, size_t& span_rank) {
+  size_t rank = 0;
+  for (const auto* shape : shapes) {
+    rank = std::max(rank, shape->NumDimensions());
+  }
+
+  // input dims right aligned to the output rank
+  std::vector<std::vector<int64_t>> dims(shapes.size(), std::vector<int64_t>(rank, 1));
+  output_dims.assign(rank, 1);
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    const auto& input_dims = shapes[i]->GetDims();
+    std::copy(input_dims.begin(), input_dims.end(), dims[i].begin() + (rank - input_dims.size()));
+  }
+  for (size_t d = 0; d < rank; ++d) {
+    for (size_t i = 0; i < shapes.size(); ++i) {
+      int64_t dim = dims[i][d];
+      if (dim == 1 || dim == output_dims[d]) {
+        continue;
+      }
+      if (output_dims[d] != 1) {
+        return false;
+      }
+      output_dims[d] = dim;
+    }
+  }
+
+  // the inner span covers the trailing dimensions over which no input switches between contiguous and broadcast.
+  // the first dimension of size 1 doesn't tell which, so the mode is set by the first dimension greater than 1.
+  std::vector<int> mode(shapes.size(), -1);  // -1: unknown, 0: broadcast, 1: contiguous
+  int64_t span_size = 1;
+  span_rank = 0;
+  for (size_t d = rank; d > 0; --d) {
+    int64_t output_dim = output_dims[d - 1];
+    bool extends = true;
+    for (size_t i = 0; i < shapes.size() && output_dim != 1; ++i) {
+      int dim_mode = dims[i][d - 1] == output_dim ? 1 : 0;
+      extends = extends && (mode[i] == -1 || mode[i] == dim_mode);
+    }
+    if (!extends) {
+      break;
+    }
+    for (size_t i = 0; i < shapes.size() && output_dim != 1; ++i) {
+      mode[i] = dims[i][d - 1] == output_dim ? 1 : 0;
+    }
+    span_size *= output_dim;
+    ++span_rank;
+  }
+
+  if (span_size < kWhereMinSpanSize) {
+    return false;
+  }
+
+  layouts.resize(shapes.size());
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    layouts[i].is_span = mode[i] == 1;
+    layouts[i].strides.assign(rank, 0);
+    int64_t stride = 1;
+    for (size_t d = rank; d > 0; --d) {
+      if (dims[i][d - 1] == output_dims[d - 1] && output_dims[d - 1] != 1) {
+        layouts[i].strides[d - 1] = stride;
+      }
+      stride *= dims[i][d - 1];
+    }
+  }
+  return true;
+}
+
+template <typename T>
+EnableIfEigenScalar<T, bool> TrySinglePassWhere(OpKernelContext& context) {
+  const auto& condition = *context.Input<Tensor>(0);
+  const auto& X = *context.Input<Tensor>(1);
+  const auto& Y = *context.Input<Tensor>(2);
+
+  std::vector<int64_t> output_dims;
+  std::vector<WhereInputLayout> layouts;
+  size_t span_rank = 0;
+  if (!PlanSinglePassWhere({&condition.Shape(), &X.Shape(), &Y.Shape()}, output_dims, layouts, span_rank)) {
+    return false;
+  }
+
+  Tensor& output = *context.Output(0, TensorShape(output_dims));
+  const int64_t output_size = output.Shape().Size();
+  if (output_size == 0) {
+    return true;
+  }
+
+  const size_t outer_rank = output_dims.size() - span_rank;
+  const int64_t span_size = output.Shape().SizeFromDimension(outer_rank);
+  const int64_t blocks_per_span = (span_size + kWhereBlockSize - 1) / kWhereBlockSize;
+  const int64_t num_blocks = (output_size / span_size) * blocks_per_span;
+
+  const auto* condition_data = reinterpret_cast<const uint8_t*>(condition.template Data<bool>());
+  const T* X_data = X.template Data<T>();
+  const T* Y_data = Y.template Data<T>();
+  T* output_data = output.template MutableData<T>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), num_blocks,
+      TensorOpCost{static_cast<double>(std::min(span_size, kWhereBlockSize) * (1 + 2 * sizeof(T))),
+                   static_cast<double>(std::min(span_size, kWhereBlockSize) * sizeof(T)),
+                   static_cast<double>(std::min(span_size, kWhereBlockSize))},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int64_t span = block / blocks_per_span;
+          const int64_t start = (block % blocks_per_span) * kWhereBlockSize;
+          const int64_t count = std::min(kWhereBlockSize, span_size - start);
+
+          // offsets of the span in the inputs
+          int64_t offsets[3] = {0, 0, 0};
+          int64_t index = span;
+          for (size_t d = outer_rank; d > 0 && index > 0; --d) {
+            const int64_t i = index % output_dims[d - 1];
+            index /= output_dims[d - 1];
+            for (size_t n = 0; n < 3; ++n) {
+              offsets[n] += i * layouts[n].strides[d - 1];
+            }
+          }
+          for (size_t n = 0; n < 3; ++n) {
+            offsets[n] += layouts[n].is_span ? start : 0;
+          }
+
+          const uint8_t* c = condition_data + offsets[0];
+          const T* x = X_data + offsets[1];
+          const T* y = Y_data + offsets[2];
+          T* out = output_data + span * span_size + start;
+          if (!layouts[0].is_span) {
+            const T* selected = *c != 0 ? x : y;
+            if (layouts[*c != 0 ? 1 : 2].is_span) {
+              std::copy(selected, selected + count, out);
+            } else {
+              std::fill(out, out + count, *selected);
+            }
+          } else if (layouts[1].is_span && layouts[2].is_span) {
+            SelectSpan<T, true, true>(c, x, y, out, count);
+          } else if (layouts[1].is_span) {
+            SelectSpan<T, true, false>(c, x, y, out, count);
+          } else if (layouts[2].is_span) {
+            SelectSpan<T, false, true>(c, x, y, out, count);
+          } else {
+            SelectSpan<T, false, false>(c, x, y, out, count);
+          }
+        }
+      });
+
+  return true;
+}
+
+template <typename T>
+EnableIfEigenNotScalar<T, bool> TrySinglePassWhere(OpKernelContext&) {
+  return false;
+}
+
 // function pointer to create typed tensor from type agnostic code whilst avoiding the overhead of std::function
 using AllocTensorFunc = std::unique_ptr<Tensor> (*)(const TensorAllocator& allocator, const TensorShape& shape);
 
@@ -230,6 +410,10 @@ static void UntypedMerge(OpKernelContext& context,
 
 template <typename T>
 Status Where<T>::Compute(OpKernelContext* context) const {
+  if (TrySinglePassWhere<T>(*context)) {
+    return Status::OK();
+  }
+
   // we use a func pointer to save the overhead of std::function, so we can't capture tensor_allocator here
   const auto typed_tensor_allocation = [](const TensorAllocator& allocator,
                                           const TensorShape& shape) {
@@ -239,7 +423,7 @@ Status Where<T>::Compute(OpKernelContext* context) const {
   TensorAllocator tensor_allocator{*context};
   ProcessBroadcastSpanFuncs funcs = SelectBroadcastFuncs<T>();
 
-  // The current implementation is limited to broadcasting over two tensors at once.
+  // The generic implementation is limited to broadcasting over two tensors at once.
   // So, we first broadcast over condition and X to select the values from X:
   //   X_selection = condition ? X : default value
   // Similarly, we broadcast over condition and Y to select the values from Y:
@@ -64,6 +64,48 @@ void CUDAAllocator::Free(void* p) {
   cudaFree(p);         // do not throw error since it's OK for cudaFree to fail during shutdown
 }
 
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, cudaStream_t stream,
+                                           size_t release_threshold)
+    : CUDAAllocator(device_id, name), stream_(stream) {
+#if CUDART_VERSION >= 11020
+  int pools_supported = 0;
+  CUDA_CALL_THROW(cudaDeviceGetAttribute(&pools_supported, cudaDevAttrMemoryPoolsSupported, device_id));
+  ORT_ENFORCE(pools_supported != 0, "CUDA device ", device_id, " does not support stream ordered memory pools.");
+
+  cudaMemPool_t pool;
+  CUDA_CALL_THROW(cudaDeviceGetDefaultMemPool(&pool, device_id));
+  uint64_t threshold = release_threshold;
+  CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+#else
+  ORT_UNUSED_PARAMETER(release_threshold);
+  ORT_THROW("The CUDA memory pool allocator requires CUDA 11.2 or later.");
+#endif
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  void* p = nullptr;
+#if CUDART_VERSION >= 11020
+  SetDevice(true);
+  CheckDevice(true);
+  if (size > 0) {
+    CUDA_CALL_THROW(cudaMallocAsync(&p, size, stream_));
+  }
+#else
+  ORT_UNUSED_PARAMETER(size);
+#endif
+  return p;
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+#if CUDART_VERSION >= 11020
+  SetDevice(false);
+  CheckDevice(false);           // ignore CUDA failure when free
+  cudaFreeAsync(p, stream_);  // do not throw error since it's OK for cudaFreeAsync to fail during shutdown
+#else
+  ORT_UNUSED_PARAMETER(p);
+#endif
+}
+
 void* CUDAExternalAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
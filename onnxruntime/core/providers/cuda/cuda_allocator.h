@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cuda_runtime_api.h>
+
 #include "core/framework/allocator.h"
 
 namespace onnxruntime {
@@ -18,11 +20,28 @@ class CUDAAllocator : public IAllocator {
   void Free(void* p) override;
   FencePtr CreateFence(const SessionState* session_state) override;
 
- private:
+ protected:
   void CheckDevice(bool throw_when_fail) const;
   void SetDevice(bool throw_when_fail) const;
 };
 
+// Allocates from the stream ordered memory pool of the device (cudaMallocAsync/cudaFreeAsync, CUDA 11.2+).
+// The allocations and frees are ordered on the given stream, so a freed block is only handed out again once the
+// work queued before the free has completed. The pool is shared by all the allocators of the device, including
+// the ones of other sessions, and keeps up to release_threshold bytes of freed memory reserved when the device
+// synchronizes. The threshold is an attribute of the pool, so the last allocator created sets it.
+class CUDAMemPoolAllocator : public CUDAAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, cudaStream_t stream,
+                       size_t release_threshold);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+  cudaStream_t stream_;
+};
+
 class CUDAExternalAllocator : public CUDAAllocator {
   typedef void* (*ExternalAlloc)(size_t size);
   typedef void (*ExternalFree)(void* p);
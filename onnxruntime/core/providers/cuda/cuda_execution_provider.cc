@@ -13,6 +13,7 @@
 #include "core/providers/cuda/cuda_fence.h"
 #include "core/providers/cuda/cuda_fwd.h"
 #include "core/providers/cuda/gpu_data_transfer.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 
 #ifndef DISABLE_CONTRIB_OPS
 #include "contrib_ops/cuda/cuda_contrib_kernels.h"
@@ -86,20 +87,53 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
   }
 }
 
-CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t gpu_mem_limit,
-                                                          ArenaExtendStrategy arena_extend_strategy, CUDAExecutionProviderExternalAllocatorInfo external_allocator_info,
-                                                          OrtArenaCfg* default_memory_arena_cfg) {
-  CUDA_CALL_THROW(cudaSetDevice(device_id));
+AllocatorPtr CUDAExecutionProvider::CreateCudaMemPoolAllocator(OrtDevice::DeviceId device_id, cudaStream_t stream,
+                                                               size_t release_threshold) {
+  AllocatorCreationInfo default_memory_info(
+      [stream, release_threshold](OrtDevice::DeviceId id) {
+        return std::make_unique<CUDAMemPoolAllocator>(id, CUDA, stream, release_threshold);
+      },
+      device_id,
+      false);
+
+  // the pool reuses freed memory itself, so no arena is needed
+  return CreateAllocator(default_memory_info);
+}
+
+CUDAExecutionProvider::PerThreadContext::PerThreadContext(cudaStream_t stream, const CUDAExecutionProviderInfo& info) {
+  CUDA_CALL_THROW(cudaSetDevice(info.device_id));
   stream_ = stream;
 
   CUBLAS_CALL_THROW(cublasCreate(&cublas_handle_));
   CUBLAS_CALL_THROW(cublasSetStream(cublas_handle_, stream));
 
+  CUBLAS_CALL_THROW(cublasLtCreate(&cublas_lt_handle_));
+
   CUDNN_CALL_THROW(cudnnCreate(&cudnn_handle_));
   CUDNN_CALL_THROW(cudnnSetStream(cudnn_handle_, stream));
 
-  // CUDA malloc/free is expensive so always use an arena
-  allocator_ = CreateCudaAllocator(device_id, gpu_mem_limit, arena_extend_strategy, external_allocator_info, default_memory_arena_cfg);
+  if (info.use_cuda_mem_pool) {
+    // the pool orders the scratch buffers of the kernels on this context's stream
+    allocator_ = CreateCudaMemPoolAllocator(info.device_id, stream, info.cuda_mem_pool_release_threshold);
+  } else {
+    // CUDA malloc/free is expensive so always use an arena
+    allocator_ = CreateCudaAllocator(info.device_id, info.gpu_mem_limit, info.arena_extend_strategy,
+                                     info.external_allocator_info, info.default_memory_arena_cfg);
+  }
+}
+
+CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::PerThreadContext::GetAuxContext(
+    size_t aux_stream_index, cudaStream_t stream, const CUDAExecutionProviderInfo& info) {
+  if (aux_contexts_.size() <= aux_stream_index) {
+    aux_contexts_.resize(aux_stream_index + 1);
+  }
+  auto& aux_context = aux_contexts_[aux_stream_index];
+  if (!aux_context) {
+    // the scratch buffers of kernels on different streams must not share an arena, as a block freed by a kernel
+    // on one stream may still be in use by the GPU when it is handed out to a kernel on another stream
+    aux_context = std::make_unique<PerThreadContext>(stream, info);
+  }
+  return *aux_context;
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -112,6 +146,12 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
     LOGS_DEFAULT(ERROR) << "cublasDestroy threw:" << ex.what();
   }
 
+  try {
+    CUBLAS_CALL(cublasLtDestroy(cublas_lt_handle_));
+  } catch (const std::exception& ex) {
+    LOGS_DEFAULT(ERROR) << "cublasLtDestroy threw:" << ex.what();
+  }
+
   try {
     CUDNN_CALL(cudnnDestroy(cudnn_handle_));
   } catch (const std::exception& ex) {
@@ -131,6 +171,14 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
   // This scenario is not supported.
   ORT_ENFORCE(!(info.has_user_compute_stream && info.external_allocator_info.UseExternalAllocator()));
 
+  ORT_ENFORCE(info.num_compute_streams >= 1, "Invalid number of compute streams: ", info.num_compute_streams);
+  ORT_ENFORCE(info.num_compute_streams == 1 || !info.enable_cuda_graph,
+              "CUDA graph capture cannot be enabled together with multiple compute streams.");
+  ORT_ENFORCE(!info.use_cuda_mem_pool || !info.external_allocator_info.UseExternalAllocator(),
+              "The CUDA memory pool cannot be used together with an external allocator.");
+  ORT_ENFORCE(!info.use_cuda_mem_pool || !info.enable_cuda_graph,
+              "The CUDA memory pool cannot be used together with CUDA graph capture.");
+
   if (info.has_user_compute_stream) {
     external_stream_ = true;
     stream_ = static_cast<cudaStream_t>(info.user_compute_stream);
@@ -142,6 +190,25 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
     }
   }
 
+  if (info.enable_cuda_graph) {
+    // capturing on the legacy default stream is not supported
+    ORT_ENFORCE(stream_ != nullptr, "CUDA graph capture cannot be enabled together with an external allocator.");
+    cuda_graph_.SetStream(stream_);
+  }
+
+  for (int i = 1; i < info.num_compute_streams; ++i) {
+    cudaStream_t aux_stream = nullptr;
+    CUDA_CALL_THROW(cudaStreamCreateWithFlags(&aux_stream, cudaStreamNonBlocking));
+    aux_streams_.push_back(aux_stream);
+    cudaEvent_t aux_stream_event = nullptr;
+    CUDA_CALL_THROW(cudaEventCreate(&aux_stream_event, cudaEventDisableTiming));
+    aux_stream_events_.push_back(aux_stream_event);
+  }
+
+  if (!info.cudnn_conv_algo_cache_file.empty()) {
+    cuda::CudnnConvAlgoCache::Instance().RegisterFile(info.cudnn_conv_algo_cache_file);
+  }
+
   size_t free = 0;
   size_t total = 0;
   CUDA_CALL_THROW(cudaMemGetInfo(&free, &total));
@@ -175,11 +242,52 @@ CUDAExecutionProvider::~CUDAExecutionProvider() {
     }
   }
 
+  for (auto aux_stream_event : aux_stream_events_) {
+    CUDA_CALL(cudaEventDestroy(aux_stream_event));
+  }
+  for (auto aux_stream : aux_streams_) {
+    CUDA_CALL(cudaStreamDestroy(aux_stream));
+  }
+
   if (!external_stream_ && stream_) {
     CUDA_CALL(cudaStreamDestroy(stream_));
   }
 }
 
+namespace {
+// exec queue id of the compute stream used by the kernels running on the current thread
+thread_local int current_compute_queue_id = kCudaStreamDefault;
+}  // namespace
+
+CUDAExecutionProvider::ComputeStreamScope::ComputeStreamScope(int queue_id)
+    : previous_queue_id_(current_compute_queue_id) {
+  current_compute_queue_id = queue_id >= kTotalCudaStreams ? queue_id : kCudaStreamDefault;
+}
+
+CUDAExecutionProvider::ComputeStreamScope::~ComputeStreamScope() {
+  current_compute_queue_id = previous_queue_id_;
+}
+
+int CUDAExecutionProvider::CurrentComputeQueueId() {
+  return current_compute_queue_id;
+}
+
+void* CUDAExecutionProvider::GetComputeStream() const {
+  const int queue_id = current_compute_queue_id;
+  if (queue_id >= kTotalCudaStreams && static_cast<size_t>(queue_id - kTotalCudaStreams) < aux_streams_.size()) {
+    return static_cast<void*>(aux_streams_[queue_id - kTotalCudaStreams]);
+  }
+  return static_cast<void*>(stream_);
+}
+
+std::vector<int> CUDAExecutionProvider::GetComputeQueueIds() const {
+  std::vector<int> queue_ids{kCudaStreamDefault};
+  for (size_t i = 0; i < aux_streams_.size(); ++i) {
+    queue_ids.push_back(kTotalCudaStreams + static_cast<int>(i));
+  }
+  return queue_ids;
+}
+
 CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadContext() const {
   const auto& per_thread_context_cache = PerThreadContextCache();
 
@@ -198,8 +306,7 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
 
     // get or create a context
     if (context_state_.retired_context_pool.empty()) {
-      context = std::make_shared<PerThreadContext>(info_.device_id, static_cast<cudaStream_t>(GetComputeStream()), info_.gpu_mem_limit,
-                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg);
+      context = std::make_shared<PerThreadContext>(stream_, info_);
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -218,6 +325,16 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
   return *context;
 }
 
+CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetComputeContext() const {
+  auto& context = GetPerThreadContext();
+  const int queue_id = current_compute_queue_id;
+  if (queue_id >= kTotalCudaStreams && static_cast<size_t>(queue_id - kTotalCudaStreams) < aux_streams_.size()) {
+    const size_t aux_stream_index = static_cast<size_t>(queue_id - kTotalCudaStreams);
+    return context.GetAuxContext(aux_stream_index, aux_streams_[aux_stream_index], info_);
+  }
+  return context;
+}
+
 void CUDAExecutionProvider::ReleasePerThreadContext() const {
   const auto& per_thread_context_cache = PerThreadContextCache();
 
@@ -240,7 +357,7 @@ AllocatorPtr CUDAExecutionProvider::GetAllocator(int id, OrtMemType mem_type) co
   // A hypothesis is that arena allocator is not aligned with CUDA output cache, and data from different kernel writes may
   // cause cacheline to contain dirty data.
   if (mem_type == OrtMemTypeDefault) {
-    return GetPerThreadContext().GetAllocator();
+    return GetComputeContext().GetAllocator();
   } else {
     return IExecutionProvider::GetAllocator(id, mem_type);
   }
@@ -291,14 +408,42 @@ Status CUDAExecutionProvider::OnRunStart() {
   auto& current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
   CUDA_RETURN_IF_ERROR(cudaEventCreate(&current_deferred_release_event, cudaEventDisableTiming));
   deferred_release_cpu_ptr_.emplace(current_deferred_release_event, DeferredReleaseCPUPtrs());
+
+  // the kernels on the additional compute streams must not start before the work queued on the default stream,
+  // such as the copies of the feeds
+  for (size_t i = 0; i < aux_streams_.size(); ++i) {
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(aux_stream_events_[i], stream_));
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(aux_streams_[i], aux_stream_events_[i], 0));
+  }
+
+  if (IsGraphCaptureEnabled() && IsGraphCaptureAllowed() && !IsGraphCaptured()) {
+    LOGS_DEFAULT(INFO) << "Capturing the cuda graph for this model";
+    ORT_RETURN_IF_ERROR(cuda_graph_.CaptureBegin());
+    is_capturing_graph_ = true;
+  }
   return Status::OK();
 }
 
 Status CUDAExecutionProvider::OnRunEnd() {
+  if (is_capturing_graph_) {
+    is_capturing_graph_ = false;
+    ORT_RETURN_IF_ERROR(cuda_graph_.CaptureEnd());
+    // the kernels were only recorded during capture, so run the graph once to produce this Run's outputs
+    ORT_RETURN_IF_ERROR(cuda_graph_.Replay());
+  } else if (IsGraphCaptureEnabled() && !IsGraphCaptured()) {
+    ++regular_run_count_before_graph_capture_;
+  }
+
+  // make the default stream wait for the kernels launched on the additional compute streams
+  for (size_t i = 0; i < aux_streams_.size(); ++i) {
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(aux_stream_events_[i], aux_streams_[i]));
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(stream_, aux_stream_events_[i], 0));
+  }
+
   // record deferred release event on default stream, and release per_thread_context
   auto current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
-  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, static_cast<cudaStream_t>(GetComputeStream())));
-  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(static_cast<cudaStream_t>(GetComputeStream())));
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, stream_));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream_));
   ReleasePerThreadContext();
   std::lock_guard<OrtMutex> lock(deferred_release_cpu_ptr_mutex_);
   deferred_release_cpu_ptr_[current_deferred_release_event].recorded = true;
@@ -306,14 +451,42 @@ Status CUDAExecutionProvider::OnRunEnd() {
   return Status::OK();
 }
 
+bool CUDAExecutionProvider::IsGraphCaptureEnabled() const {
+  return info_.enable_cuda_graph;
+}
+
+bool CUDAExecutionProvider::IsGraphCaptureAllowed() const {
+  return regular_run_count_before_graph_capture_ >= min_num_runs_before_cuda_graph_capture_;
+}
+
+bool CUDAExecutionProvider::IsGraphCaptured() const {
+  return cuda_graph_.IsCaptured();
+}
+
+Status CUDAExecutionProvider::ReplayGraph() {
+  // the captured graph reuses the same intermediate buffers, so replays must not overlap
+  std::lock_guard<OrtMutex> lock(cuda_graph_mutex_);
+  CUDA_RETURN_IF_ERROR(cudaSetDevice(GetDeviceId()));
+  return cuda_graph_.Replay();
+}
+
+void CUDAExecutionProvider::ResetGraph() {
+  std::lock_guard<OrtMutex> lock(cuda_graph_mutex_);
+  cuda_graph_.Reset();
+}
+
 Status CUDAExecutionProvider::SetComputeStream(void* stream) {
   if (stream != stream_) {
+    // the memory pool allocators are ordered on the current stream
+    ORT_RETURN_IF(info_.use_cuda_mem_pool, "The compute stream cannot be changed when the CUDA memory pool is used.");
+
     if (stream_) {
       CUDA_RETURN_IF_ERROR(cudaStreamDestroy(stream_));
     }
 
     external_stream_ = true;
     stream_ = static_cast<cudaStream_t>(stream);
+    cuda_graph_.SetStream(stream_);
   }
   return Status::OK();
 }
@@ -348,6 +521,7 @@ class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kO
 class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, double, MatMul);
 class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, MLFloat16, MatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, MatMulInteger);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, QLinearMatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, float, Elu);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, double, Elu);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, MLFloat16, Elu);
@@ -1109,6 +1283,7 @@ static Status RegisterCudaKernels(KernelRegistry& kernel_registry) {
     BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, double, MatMul)>,
     BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, MLFloat16, MatMul)>,
     BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, MatMulInteger)>,
+    BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, QLinearMatMul)>,
     BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, 10, float, Clip)>,
     BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, float, Elu)>,
     BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, double, Elu)>,
@@ -1991,7 +2166,7 @@ static bool CastNeedFallbackToCPU(const onnxruntime::Node& node) {
 }
 
 std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransfer() const {
-  return std::make_unique<onnxruntime::GPUDataTransfer>(static_cast<cudaStream_t>(GetComputeStream()), info_.do_copy_in_default_stream);
+  return std::make_unique<onnxruntime::GPUDataTransfer>(stream_, info_.do_copy_in_default_stream, aux_streams_);
 }
 
 std::vector<std::unique_ptr<ComputeCapability>>
@@ -2077,8 +2252,12 @@ void CUDAExecutionProvider::RegisterAllocator(std::shared_ptr<AllocatorManager>
   // Used to allocate CUDA device memory
   auto cuda_alloc = allocator_manager->GetAllocator(info_.device_id, OrtMemTypeDefault);
   if (nullptr == cuda_alloc) {
-    cuda_alloc = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                                     info_.external_allocator_info, info_.default_memory_arena_cfg);
+    if (info_.use_cuda_mem_pool) {
+      cuda_alloc = CreateCudaMemPoolAllocator(info_.device_id, stream_, info_.cuda_mem_pool_release_threshold);
+    } else {
+      cuda_alloc = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
+                                       info_.external_allocator_info, info_.default_memory_arena_cfg);
+    }
     allocator_manager->InsertAllocator(cuda_alloc);
   }
   TryInsertAllocator(cuda_alloc);
@@ -12,6 +12,7 @@
 #include "core/framework/execution_provider.h"
 #include "core/platform/ort_mutex.h"
 #include "core/providers/cuda/cuda_execution_provider_info.h"
+#include "core/providers/cuda/cuda_graph.h"
 #include "core/providers/cuda/cuda_pch.h"
 #include "core/providers/cuda/shared_inc/cuda_utils.h"
 #include "core/providers/cuda/shared_inc/cuda_call.h"
@@ -39,19 +40,43 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   Status SetComputeStream(void* stream) override;
 
-  void* GetComputeStream() const override { return static_cast<void*>(stream_); }
+  // Returns the stream of the exec queue the current thread is running kernels on, see ComputeStreamScope.
+  void* GetComputeStream() const override;
+
+  std::vector<int> GetComputeQueueIds() const override;
+
+  // Makes the kernels run by the current thread use the compute stream of an exec queue until it goes out of scope.
+  // Exec queue ids that are not one of the additional compute streams use the default compute stream.
+  class ComputeStreamScope {
+   public:
+    explicit ComputeStreamScope(int queue_id);
+    ~ComputeStreamScope();
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ComputeStreamScope);
+
+   private:
+    int previous_queue_id_;
+  };
+
+  // Returns the exec queue id set by the innermost ComputeStreamScope of the current thread, or
+  // kCudaStreamDefault if there is none.
+  static int CurrentComputeQueueId();
 
   cublasHandle_t PerThreadCublasHandle() {
-    return GetPerThreadContext().CublasHandle();
+    return GetComputeContext().CublasHandle();
+  }
+
+  cublasLtHandle_t PerThreadCublasLtHandle() {
+    return GetComputeContext().CublasLtHandle();
   }
 
   cudnnHandle_t PerThreadCudnnHandle() {
-    return GetPerThreadContext().CudnnHandle();
+    return GetComputeContext().CudnnHandle();
   }
 
   template <typename T>
   const T* GetConstOnes(size_t count) {
-    return GetPerThreadContext().template GetConstOnes<T>(count);
+    return GetComputeContext().template GetConstOnes<T>(count);
   }
 
   void AddDeferredReleaseCPUPtr(void* p);
@@ -80,14 +105,27 @@ class CUDAExecutionProvider : public IExecutionProvider {
   }
 
   void RegisterAllocator(std::shared_ptr<AllocatorManager> allocator_manager) override;
+
+  bool IsGraphCaptureEnabled() const override;
+  bool IsGraphCaptured() const override;
+  Status ReplayGraph() override;
+  void ResetGraph() override;
   static AllocatorPtr CreateCudaAllocator(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
                                           CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
 
+  // Creates an allocator for the stream ordered memory pool of the device, ordered on the given stream.
+  static AllocatorPtr CreateCudaMemPoolAllocator(OrtDevice::DeviceId device_id, cudaStream_t stream,
+                                                 size_t release_threshold);
+
  private:
   CUDAExecutionProviderInfo info_;
   cudaDeviceProp device_prop_;
   bool external_stream_ = false;
   cudaStream_t stream_ = nullptr;
+  // additional compute streams, used by exec queues kTotalCudaStreams and up
+  std::vector<cudaStream_t> aux_streams_;
+  // events used to order the additional compute streams with stream_ at the start and end of a Run
+  std::vector<cudaEvent_t> aux_stream_events_;
 
   struct DeferredReleaseCPUPtrs {
     bool recorded = false;
@@ -97,16 +135,29 @@ class CUDAExecutionProvider : public IExecutionProvider {
   std::unordered_map<cudaEvent_t, DeferredReleaseCPUPtrs> deferred_release_cpu_ptr_;
   OrtMutex deferred_release_cpu_ptr_mutex_;
 
+  // CUDA graph of the kernels launched on stream_ during one Run, replayed by later Runs.
+  // The first Runs execute normally so that the arena, cuDNN algorithm caches and cuBLAS workspaces
+  // are warmed up; no device memory may be allocated while capturing.
+  bool IsGraphCaptureAllowed() const;
+  CUDAGraph cuda_graph_;
+  bool is_capturing_graph_ = false;
+  int regular_run_count_before_graph_capture_ = 0;
+  const int min_num_runs_before_cuda_graph_capture_ = 1;  // required min regular runs before graph capture
+  OrtMutex cuda_graph_mutex_;
+
   class PerThreadContext final {
    public:
-    PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+    PerThreadContext(cudaStream_t stream, const CUDAExecutionProviderInfo& info);
     ~PerThreadContext();
 
     cublasHandle_t CublasHandle() const {
       return cublas_handle_;
     }
 
+    cublasLtHandle_t CublasLtHandle() const {
+      return cublas_lt_handle_;
+    }
+
     cudnnHandle_t CudnnHandle() const {
       return cudnn_handle_;
     }
@@ -148,9 +199,18 @@ class CUDAExecutionProvider : public IExecutionProvider {
       return allocator_;
     }
 
+    // Returns the context used by the kernels launched on an additional compute stream.
+    // It is created on first use, with its own handles and allocator.
+    PerThreadContext& GetAuxContext(size_t aux_stream_index, cudaStream_t stream,
+                                    const CUDAExecutionProviderInfo& info);
+
    private:
+    // contexts of the additional compute streams, indexed by aux stream index
+    std::vector<std::unique_ptr<PerThreadContext>> aux_contexts_;
+
     cudaStream_t stream_ = nullptr;
     cublasHandle_t cublas_handle_ = nullptr;
+    cublasLtHandle_t cublas_lt_handle_ = nullptr;
     cudnnHandle_t cudnn_handle_ = nullptr;
 
     // deferred release for temporary CPU pinned memory used in cudaMemcpyAsync
@@ -195,6 +255,8 @@ class CUDAExecutionProvider : public IExecutionProvider {
   mutable PerThreadContextState context_state_;
 
   PerThreadContext& GetPerThreadContext() const;
+  // Returns the PerThreadContext of the compute stream the current thread is running kernels on.
+  PerThreadContext& GetComputeContext() const;
   void ReleasePerThreadContext() const;
 };
 
@@ -18,6 +18,11 @@ constexpr const char* kCudnnConvAlgoSearch = "cudnn_conv_algo_search";
 constexpr const char* kDoCopyInDefaultStream = "do_copy_in_default_stream";
 constexpr const char* kGpuExternalAlloc = "gpu_external_alloc";
 constexpr const char* kGpuExternalFree = "gpu_external_free";
+constexpr const char* kEnableCudaGraph = "enable_cuda_graph";
+constexpr const char* kNumComputeStreams = "num_compute_streams";
+constexpr const char* kUseCudaMemPool = "use_cuda_mem_pool";
+constexpr const char* kCudaMemPoolReleaseThreshold = "cuda_mem_pool_release_threshold";
+constexpr const char* kCudnnConvAlgoCacheFile = "cudnn_conv_algo_cache_file";
 }  // namespace provider_option_names
 }  // namespace cuda
 
@@ -78,6 +83,21 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
               cuda::provider_option_names::kCudnnConvAlgoSearch,
               ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)
           .AddAssignmentToReference(cuda::provider_option_names::kDoCopyInDefaultStream, info.do_copy_in_default_stream)
+          .AddAssignmentToReference(cuda::provider_option_names::kEnableCudaGraph, info.enable_cuda_graph)
+          .AddValueParser(
+              cuda::provider_option_names::kNumComputeStreams,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.num_compute_streams));
+                ORT_RETURN_IF_NOT(
+                    info.num_compute_streams >= 1,
+                    "Invalid number of compute streams: ", info.num_compute_streams, ", must be at least 1.");
+                return Status::OK();
+              })
+          .AddAssignmentToReference(cuda::provider_option_names::kUseCudaMemPool, info.use_cuda_mem_pool)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+                                    info.cuda_mem_pool_release_threshold)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudnnConvAlgoCacheFile,
+                                    info.cudnn_conv_algo_cache_file)
           .Parse(options));
 
   CUDAExecutionProviderExternalAllocatorInfo alloc_info{alloc, free};
@@ -96,6 +116,12 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kCudnnConvAlgoSearch,
        EnumToName(ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)},
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
+      {cuda::provider_option_names::kEnableCudaGraph, MakeStringWithClassicLocale(info.enable_cuda_graph)},
+      {cuda::provider_option_names::kNumComputeStreams, MakeStringWithClassicLocale(info.num_compute_streams)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mem_pool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mem_pool_release_threshold)},
+      {cuda::provider_option_names::kCudnnConvAlgoCacheFile, info.cudnn_conv_algo_cache_file},
   };
 
   return options;
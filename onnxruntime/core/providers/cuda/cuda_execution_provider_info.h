@@ -4,6 +4,7 @@
 #pragma once
 
 #include <limits>
+#include <string>
 
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/ortdevice.h"
@@ -45,6 +46,25 @@ struct CUDAExecutionProviderInfo {
   // arena config.
   OrtArenaCfg* default_memory_arena_cfg{nullptr};
   CUDAExecutionProviderExternalAllocatorInfo external_allocator_info{};
+  // Capture the kernels launched by a Run into a CUDA graph and replay it on subsequent Runs.
+  // Only valid for static-shape models fully assigned to the CUDA EP whose inputs and outputs are bound
+  // to fixed CUDA device buffers via IOBinding.
+  bool enable_cuda_graph{false};
+  // Number of CUDA streams the kernels are launched on. With more than one stream, independent branches of the
+  // graph are assigned to different streams so their kernels can run concurrently.
+  // Only used with sequential execution, and cannot be combined with enable_cuda_graph.
+  int num_compute_streams{1};
+  // Allocate device memory from the stream ordered memory pool of the device (cudaMallocAsync, CUDA 11.2+)
+  // instead of a BFC arena. The pool is shared with the other sessions on the device, and gpu_mem_limit,
+  // arena_extend_strategy and default_memory_arena_cfg do not apply to it.
+  // Cannot be combined with an external allocator or enable_cuda_graph.
+  bool use_cuda_mem_pool{false};
+  // Bytes of freed memory the pool keeps reserved instead of releasing them to the device when it synchronizes.
+  size_t cuda_mem_pool_release_threshold{std::numeric_limits<size_t>::max()};
+  // File the cuDNN convolution algorithms found by the algorithm search are loaded from and appended to, so the
+  // search is not repeated by the sessions of later processes. The algorithms are shared by all the sessions of
+  // the process regardless of this option.
+  std::string cudnn_conv_algo_cache_file{};
 
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
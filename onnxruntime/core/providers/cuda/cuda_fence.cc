@@ -13,12 +13,13 @@ CUDAFence::CUDAFence(const GPUDataTransfer* data_transfer) : data_transfer_(data
   // NOTE: cudaEventBlockingSync may leads to longer wait time because of thread yield/switching in kernel
   // if lower CPU usage is more important than latency, we should use this flag to avoid spin-loop in WaitOnCPU
   int event_flags = /*cudaEventBlockingSync |*/ cudaEventDisableTiming;
-  CUDA_CALL_THROW(cudaEventCreate(&read_event_, event_flags));
   CUDA_CALL_THROW(cudaEventCreate(&write_event_, event_flags));
 }
 
 CUDAFence::~CUDAFence() {
-  CUDA_CALL_THROW(cudaEventDestroy(read_event_));
+  for (auto& read_event : read_events_) {
+    CUDA_CALL_THROW(cudaEventDestroy(read_event.second));
+  }
   CUDA_CALL_THROW(cudaEventDestroy(write_event_));
 }
 
@@ -36,24 +37,42 @@ void CUDAFence::BeforeUsingAsOutput(onnxruntime::ProviderType provider_type, int
   if (provider_type == onnxruntime::kCudaExecutionProvider) {
     // sync in GPU, the call is non-blocking on CPU
     cudaStream_t stream = data_transfer_->GetStream(queue_id);
-    CUDA_CALL_THROW(cudaStreamWaitEvent(stream, read_event_, 0));
+    std::lock_guard<OrtMutex> lock(read_events_mutex_);
+    for (auto& read_event : read_events_) {
+      CUDA_CALL_THROW(cudaStreamWaitEvent(stream, read_event.second, 0));
+    }
     CUDA_CALL_THROW(cudaStreamWaitEvent(stream, write_event_, 0));
   } else {
     // sync on CPU for all other providers, this is blocking
-    CUDA_CALL_THROW(cudaEventSynchronize(read_event_));
+    std::lock_guard<OrtMutex> lock(read_events_mutex_);
+    for (auto& read_event : read_events_) {
+      CUDA_CALL_THROW(cudaEventSynchronize(read_event.second));
+    }
     CUDA_CALL_THROW(cudaEventSynchronize(write_event_));
   }
 }
 
 bool CUDAFence::CanRelease() {
-  return cudaEventQuery(read_event_) == cudaSuccess &&
-         cudaEventQuery(write_event_) == cudaSuccess;
+  std::lock_guard<OrtMutex> lock(read_events_mutex_);
+  for (auto& read_event : read_events_) {
+    if (cudaEventQuery(read_event.second) != cudaSuccess) {
+      return false;
+    }
+  }
+  return cudaEventQuery(write_event_) == cudaSuccess;
 }
 
 void CUDAFence::AfterUsedAsInput(int queue_id) {
-  // update read fence
+  // update read fence of the queue
+  std::lock_guard<OrtMutex> lock(read_events_mutex_);
+  auto read_event = read_events_.find(queue_id);
+  if (read_event == read_events_.end()) {
+    cudaEvent_t event;
+    CUDA_CALL_THROW(cudaEventCreate(&event, cudaEventDisableTiming));
+    read_event = read_events_.emplace(queue_id, event).first;
+  }
   cudaStream_t stream = data_transfer_->GetStream(queue_id);
-  CUDA_CALL_THROW(cudaEventRecord(read_event_, stream));
+  CUDA_CALL_THROW(cudaEventRecord(read_event->second, stream));
 }
 
 void CUDAFence::AfterUsedAsOutput(int queue_id) {
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "core/framework/tensor.h"
 #include "core/graph/basic_types.h"
+#include "core/platform/ort_mutex.h"
 #include "core/providers/cuda/cuda_common.h"
 
 namespace onnxruntime {
@@ -21,7 +24,10 @@ class CUDAFence : public IFence {
   virtual bool CanRelease() override;
 
  private:
-  cudaEvent_t read_event_;
+  // read events keyed by exec queue id, as a value may be read on more than one compute stream
+  std::unordered_map<int, cudaEvent_t> read_events_;
+  // the parallel executor may read a value from multiple threads
+  OrtMutex read_events_mutex_;
   cudaEvent_t write_event_;
   const GPUDataTransfer* data_transfer_;
 };
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_graph.h"
+
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+
+CUDAGraph::CUDAGraph(cudaStream_t stream) : capture_stream_(stream) {
+}
+
+void CUDAGraph::SetStream(cudaStream_t stream) {
+  capture_stream_ = stream;
+}
+
+Status CUDAGraph::CaptureBegin() {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  ORT_RETURN_IF(has_graph_exec_,
+                "This CUDAGraph instance already owns a captured graph. "
+                "To capture a new graph, create a new instance or call Reset() first.");
+  // Capturing on the legacy default stream is not supported by CUDA.
+  ORT_RETURN_IF(capture_stream_ == nullptr, "CUDA graph capture requires a non-default compute stream.");
+
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(capture_stream_));
+  // cudaStreamCaptureModeGlobal is the most conservative option to
+  // prevent potentially unsafe CUDA API calls during capturing.
+  CUDA_RETURN_IF_ERROR(cudaStreamBeginCapture(capture_stream_, cudaStreamCaptureModeGlobal));
+  return Status::OK();
+#else
+  return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA graphs can only be used in Onnxruntime built with CUDA >= 10.0");
+#endif
+}
+
+Status CUDAGraph::CaptureEnd() {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  // end the capture even if it was invalidated by an unsupported call, so the stream is usable again
+  CUDA_RETURN_IF_ERROR(cudaStreamEndCapture(capture_stream_, &graph_));
+  ORT_RETURN_IF(graph_ == nullptr, "CUDAGraph::CaptureEnd: graph_ is NULL");
+  has_graph_ = true;
+
+  CUDA_RETURN_IF_ERROR(cudaGraphInstantiate(&graph_exec_, graph_, NULL, NULL, 0));
+  has_graph_exec_ = true;
+
+  // The executable graph holds everything needed for replay; the source graph can be released.
+  CUDA_RETURN_IF_ERROR(cudaGraphDestroy(graph_));
+  has_graph_ = false;
+  return Status::OK();
+#else
+  return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA graphs can only be used in Onnxruntime built with CUDA >= 10.0");
+#endif
+}
+
+Status CUDAGraph::Replay() {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  LOGS_DEFAULT(VERBOSE) << "Replaying CUDA graph on stream " << capture_stream_;
+  ORT_RETURN_IF_NOT(has_graph_exec_, "Replay() was called before a CUDA graph was captured.");
+  CUDA_RETURN_IF_ERROR(cudaGraphLaunch(graph_exec_, capture_stream_));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(capture_stream_));
+  return Status::OK();
+#else
+  return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA graphs can only be used in Onnxruntime built with CUDA >= 10.0");
+#endif
+}
+
+void CUDAGraph::Reset() {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  if (has_graph_) {
+    CUDA_CALL(cudaGraphDestroy(graph_));
+    has_graph_ = false;
+  }
+  if (has_graph_exec_) {
+    CUDA_CALL(cudaGraphExecDestroy(graph_exec_));
+    has_graph_exec_ = false;
+  }
+#endif
+}
+
+CUDAGraph::~CUDAGraph() {
+  Reset();
+}
+
+}  // namespace onnxruntime
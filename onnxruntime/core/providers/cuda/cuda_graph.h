@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/cuda/cuda_pch.h"
+
+namespace onnxruntime {
+
+// Wraps a CUDA graph captured from the work submitted to a single stream during one Run.
+// The captured graph bakes in kernel arguments, including device addresses, so it can only be
+// replayed while the session inputs/outputs and all intermediate buffers stay at the same addresses.
+struct CUDAGraph {
+  CUDAGraph() = default;
+  explicit CUDAGraph(cudaStream_t stream);
+  ~CUDAGraph();
+
+  void SetStream(cudaStream_t stream);
+  Status CaptureBegin();
+  Status CaptureEnd();
+  Status Replay();
+  void Reset();
+
+  bool IsCaptured() const { return has_graph_exec_; }
+
+ private:
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  cudaGraph_t graph_ = nullptr;
+  cudaGraphExec_t graph_exec_ = nullptr;
+#endif
+
+  bool has_graph_ = false;
+  bool has_graph_exec_ = false;
+
+  cudaStream_t capture_stream_ = nullptr;
+};
+
+}  // namespace onnxruntime
@@ -25,6 +25,8 @@ class CudaKernel : public OpKernel {
   }
 
   Status Compute(OpKernelContext* p_op_kernel_context) const override {
+    // launch the kernel on the compute stream of the exec queue the node was assigned to
+    CUDAExecutionProvider::ComputeStreamScope stream_scope(p_op_kernel_context->GetExecQueueId());
     auto s = ComputeInternal(p_op_kernel_context);
     // use this to precisely locate the node where CUDA failure comes from
     //  if (cudaSuccess != cudaDeviceSynchronize())
@@ -129,6 +131,10 @@ class CudaKernel : public OpKernel {
     return provider_->PerThreadCublasHandle();
   }
 
+  inline cublasLtHandle_t CublasLtHandle() const {
+    return provider_->PerThreadCublasLtHandle();
+  }
+
   inline cudnnHandle_t CudnnHandle() const {
     return provider_->PerThreadCudnnHandle();
   }
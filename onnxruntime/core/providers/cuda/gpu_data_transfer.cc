@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cuda/gpu_data_transfer.h"
+
+#include <algorithm>
+
+#include "core/providers/cuda/cuda_execution_provider.h"
 #include "cuda_common.h"
 
 // use default stream for copy for now, to avoid racing in BFC arena as in issue #4829
@@ -9,7 +13,9 @@
 // so we leave it as optional, in case user need the previous behavior
 // a full fix to BFC arena is being looked at, and once it's in, we can revert this change
 namespace onnxruntime {
-GPUDataTransfer::GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream) {
+GPUDataTransfer::GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream,
+                                 const std::vector<cudaStream_t>& aux_streams)
+    : aux_streams_(aux_streams), pinned_allocator_(DEFAULT_CPU_ALLOCATOR_DEVICE_ID, CUDA_PINNED) {
   // create streams, default is nullptr
   do_copy_in_default_stream_ = do_copy_in_default_stream;
   streams_[kCudaStreamDefault] = stream;
@@ -20,6 +26,9 @@ GPUDataTransfer::GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_st
     CUDA_CALL_THROW(cudaStreamCreateWithFlags(&streams_[kCudaStreamCopyIn], cudaStreamNonBlocking));
     CUDA_CALL_THROW(cudaStreamCreateWithFlags(&streams_[kCudaStreamCopyOut], cudaStreamNonBlocking));
   }
+  if (!aux_streams_.empty()) {
+    CUDA_CALL_THROW(cudaEventCreate(&aux_streams_event_, cudaEventDisableTiming));
+  }
 }
 
 GPUDataTransfer::~GPUDataTransfer() {
@@ -29,6 +38,55 @@ GPUDataTransfer::~GPUDataTransfer() {
   if (!do_copy_in_default_stream_ && streams_[kCudaStreamCopyOut] != nullptr) {
     CUDA_CALL(cudaStreamDestroy(streams_[kCudaStreamCopyOut]));
   }
+  if (aux_streams_event_ != nullptr) {
+    CUDA_CALL(cudaEventDestroy(aux_streams_event_));
+  }
+  for (auto& staging_buffer : staging_buffers_) {
+    if (staging_buffer.copy_done != nullptr) {
+      CUDA_CALL(cudaEventSynchronize(staging_buffer.copy_done));
+      CUDA_CALL(cudaEventDestroy(staging_buffer.copy_done));
+      CUDA_CALL(cudaEventDestroy(staging_buffer.compute_queued));
+    }
+    if (staging_buffer.data != nullptr) {
+      pinned_allocator_.Free(staging_buffer.data);
+    }
+  }
+}
+
+Status GPUDataTransfer::AcquireStagingBuffer(size_t bytes, StagingBuffer*& staging_buffer,
+                                             std::unique_lock<std::mutex>& lock) const {
+  staging_buffer = &staging_buffers_[next_staging_buffer_++ % kNumStagingBuffers];
+  lock = std::unique_lock<std::mutex>(staging_buffer->mutex);
+
+  if (staging_buffer->copy_done == nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaEventCreate(&staging_buffer->copy_done, cudaEventDisableTiming));
+    CUDA_RETURN_IF_ERROR(cudaEventCreate(&staging_buffer->compute_queued, cudaEventDisableTiming));
+  } else {
+    // the previous copy from or to the buffer may still be in flight
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(staging_buffer->copy_done));
+  }
+
+  if (staging_buffer->capacity < bytes) {
+    if (staging_buffer->data != nullptr) {
+      pinned_allocator_.Free(staging_buffer->data);
+      staging_buffer->data = nullptr;
+      staging_buffer->capacity = 0;
+    }
+    const size_t capacity = std::max(bytes, std::min(kMaxStagingBytes, staging_buffer->capacity * 2));
+    staging_buffer->data = pinned_allocator_.Alloc(capacity);
+    staging_buffer->capacity = capacity;
+  }
+
+  return Status::OK();
+}
+
+Status GPUDataTransfer::WaitForComputeStream(StagingBuffer& staging_buffer, cudaStream_t copy_stream,
+                                             cudaStream_t compute_stream) const {
+  if (copy_stream != compute_stream) {
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(staging_buffer.compute_queued, compute_stream));
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(copy_stream, staging_buffer.compute_queued, 0));
+  }
+  return Status::OK();
 }
 
 bool GPUDataTransfer::CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const {
@@ -44,6 +102,12 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
   auto& src_device = src.Location().device;
   auto& dst_device = dst.Location().device;
 
+  // copies issued by a kernel running on an additional compute stream go to that stream instead of the default one
+  const int compute_queue_id = CUDAExecutionProvider::CurrentComputeQueueId();
+  if (exec_queue_id == kCudaStreamDefault) {
+    exec_queue_id = compute_queue_id;
+  }
+
   if (dst_device.Type() == OrtDevice::GPU) {
     if (src_device.Type() == OrtDevice::CPU && src_device.MemType() == OrtDevice::MemType::CUDA_PINNED) {
       // copy from pinned memory to GPU, this is non-blocking
@@ -52,21 +116,63 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
       // copying between GPU, this is non-blocking
       // Copy only if the two addresses are different.
       if (dst_data != src_data) {
-        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice, GetStream(kCudaStreamDefault)));
+        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice, GetStream(compute_queue_id)));
+      }
+    } else if (bytes <= kMaxStagingBytes) {
+      // copy from other CPU memory to GPU through a pinned staging buffer on the copy-in stream, this is
+      // non-blocking. the copy waits for the work queued on the compute stream, which may still use the
+      // destination buffer, and the compute stream waits for the copy.
+      StagingBuffer* staging_buffer = nullptr;
+      std::unique_lock<std::mutex> lock;
+      ORT_RETURN_IF_ERROR(AcquireStagingBuffer(bytes, staging_buffer, lock));
+      memcpy(staging_buffer->data, src_data, bytes);
+
+      cudaStream_t copy_stream = GetStream(kCudaStreamCopyIn);
+      cudaStream_t compute_stream = GetStream(compute_queue_id);
+      ORT_RETURN_IF_ERROR(WaitForComputeStream(*staging_buffer, copy_stream, compute_stream));
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, staging_buffer->data, bytes, cudaMemcpyHostToDevice, copy_stream));
+      CUDA_RETURN_IF_ERROR(cudaEventRecord(staging_buffer->copy_done, copy_stream));
+      if (copy_stream != compute_stream) {
+        CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(compute_stream, staging_buffer->copy_done, 0));
       }
     } else {
       // copy from other CPU memory to GPU, this is blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, GetStream(kCudaStreamDefault)));
-      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(GetStream(kCudaStreamDefault)));
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, GetStream(compute_queue_id)));
+      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(GetStream(compute_queue_id)));
+    }
+
+    // values copied outside of the additional compute streams, such as the feeds of a Run, may be read by
+    // kernels on those streams, so make them wait for the copy
+    if (!aux_streams_.empty() && compute_queue_id == kCudaStreamDefault) {
+      const bool is_pinned_copy = src_device.Type() == OrtDevice::CPU &&
+                                  src_device.MemType() == OrtDevice::MemType::CUDA_PINNED;
+      CUDA_RETURN_IF_ERROR(cudaEventRecord(aux_streams_event_,
+                                           GetStream(is_pinned_copy ? exec_queue_id : compute_queue_id)));
+      for (auto aux_stream : aux_streams_) {
+        CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(aux_stream, aux_streams_event_, 0));
+      }
     }
   } else if (src_device.Type() == OrtDevice::GPU) {
     if (dst_device.Type() == OrtDevice::CPU && dst_device.MemType() == OrtDevice::MemType::CUDA_PINNED) {
       // copying from GPU to pinned memory, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, GetStream(exec_queue_id)));
+    } else if (bytes <= kMaxStagingBytes) {
+      // copying from GPU to CPU memory through a pinned staging buffer on the copy-out stream, this is blocking,
+      // but only waits for the work queued on the compute stream so far, not for the work queued meanwhile
+      StagingBuffer* staging_buffer = nullptr;
+      std::unique_lock<std::mutex> lock;
+      ORT_RETURN_IF_ERROR(AcquireStagingBuffer(bytes, staging_buffer, lock));
+
+      cudaStream_t copy_stream = GetStream(kCudaStreamCopyOut);
+      ORT_RETURN_IF_ERROR(WaitForComputeStream(*staging_buffer, copy_stream, GetStream(compute_queue_id)));
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(staging_buffer->data, src_data, bytes, cudaMemcpyDeviceToHost, copy_stream));
+      CUDA_RETURN_IF_ERROR(cudaEventRecord(staging_buffer->copy_done, copy_stream));
+      CUDA_RETURN_IF_ERROR(cudaEventSynchronize(staging_buffer->copy_done));
+      memcpy(dst_data, staging_buffer->data, bytes);
     } else {
       // copying from GPU to CPU memory, this is blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, GetStream(kCudaStreamDefault)));
-      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(GetStream(kCudaStreamDefault)));
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, GetStream(compute_queue_id)));
+      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(GetStream(compute_queue_id)));
     }
   } else {
     // copying between cpu memory
@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "cuda_pch.h"
 #include "core/framework/data_transfer.h"
+#include "core/providers/cuda/cuda_allocator.h"
 
 namespace onnxruntime {
 
@@ -17,7 +23,10 @@ enum CUDAStreamType : int {
 
 class GPUDataTransfer : public IDataTransfer {
  public:
-  GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream = true);
+  // aux_streams are the additional compute streams of the execution provider, used by exec queues
+  // kTotalCudaStreams and up.
+  GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream = true,
+                  const std::vector<cudaStream_t>& aux_streams = {});
   ~GPUDataTransfer();
 
   bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override;
@@ -27,13 +36,46 @@ class GPUDataTransfer : public IDataTransfer {
   common::Status CopyTensor(const Tensor& src, Tensor& dst, int exec_queue_id) const override;
 
   cudaStream_t GetStream(int queue_id) const {
-    ORT_ENFORCE(queue_id >= 0 && queue_id < kTotalCudaStreams);
+    if (queue_id >= kTotalCudaStreams) {
+      ORT_ENFORCE(static_cast<size_t>(queue_id - kTotalCudaStreams) < aux_streams_.size());
+      return aux_streams_[queue_id - kTotalCudaStreams];
+    }
+    ORT_ENFORCE(queue_id >= 0);
     return streams_[queue_id];
   }
 
  private:
+  // A pinned host buffer that stages a copy between pageable host memory and the GPU, so the copy runs
+  // asynchronously on a copy stream instead of blocking the compute stream.
+  struct StagingBuffer {
+    std::mutex mutex;
+    void* data = nullptr;
+    size_t capacity = 0;
+    cudaEvent_t copy_done = nullptr;      // recorded after the last copy from or to the buffer
+    cudaEvent_t compute_queued = nullptr;  // orders the copy after the work queued on the compute stream
+  };
+
+  // Copies larger than this are not staged.
+  static constexpr size_t kMaxStagingBytes = 64 * 1024 * 1024;
+  static constexpr size_t kNumStagingBuffers = 4;
+
+  // Takes the next buffer of the ring, once the previous copy using it has completed, and grows it to hold bytes.
+  common::Status AcquireStagingBuffer(size_t bytes, StagingBuffer*& staging_buffer,
+                                      std::unique_lock<std::mutex>& lock) const;
+
+  // Orders the work queued on copy_stream after the work queued on compute_stream.
+  common::Status WaitForComputeStream(StagingBuffer& staging_buffer, cudaStream_t copy_stream,
+                                      cudaStream_t compute_stream) const;
+
   bool do_copy_in_default_stream_;
   cudaStream_t streams_[kTotalCudaStreams];
+  std::vector<cudaStream_t> aux_streams_;
+  // orders the additional compute streams after copies issued on the other streams
+  cudaEvent_t aux_streams_event_ = nullptr;
+
+  mutable CUDAPinnedAllocator pinned_allocator_;
+  mutable std::array<StagingBuffer, kNumStagingBuffers> staging_buffers_;
+  mutable std::atomic<size_t> next_staging_buffer_{0};
 };
 
 }  // namespace onnxruntime
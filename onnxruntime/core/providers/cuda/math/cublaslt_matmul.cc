@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/math/cublaslt_matmul.h"
+
+#include <map>
+#include <vector>
+
+#include "core/platform/ort_mutex.h"
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+
+namespace onnxruntime {
+namespace cuda {
+
+namespace {
+cublasLtEpilogue_t ToCublasLtEpilogue(CublasLtEpilogue epilogue) {
+  switch (epilogue) {
+    case CublasLtEpilogue::kBias:
+      return CUBLASLT_EPILOGUE_BIAS;
+    case CublasLtEpilogue::kRelu:
+      return CUBLASLT_EPILOGUE_RELU;
+    case CublasLtEpilogue::kReluBias:
+      return CUBLASLT_EPILOGUE_RELU_BIAS;
+#if CUDA_VERSION >= 11040
+    case CublasLtEpilogue::kGelu:
+      return CUBLASLT_EPILOGUE_GELU;
+    case CublasLtEpilogue::kGeluBias:
+      return CUBLASLT_EPILOGUE_GELU_BIAS;
+    case CublasLtEpilogue::kReluAuxBias:
+      return CUBLASLT_EPILOGUE_RELU_AUX_BIAS;
+    case CublasLtEpilogue::kGeluAuxBias:
+      return CUBLASLT_EPILOGUE_GELU_AUX_BIAS;
+#endif
+    default:
+      return CUBLASLT_EPILOGUE_DEFAULT;
+  }
+}
+
+bool HasBias(CublasLtEpilogue epilogue) {
+  return epilogue == CublasLtEpilogue::kBias || epilogue == CublasLtEpilogue::kReluBias ||
+         epilogue == CublasLtEpilogue::kGeluBias || epilogue == CublasLtEpilogue::kReluAuxBias ||
+         epilogue == CublasLtEpilogue::kGeluAuxBias;
+}
+
+#if CUDA_VERSION >= 11040
+bool HasAux(CublasLtEpilogue epilogue) {
+  return epilogue == CublasLtEpilogue::kReluAuxBias || epilogue == CublasLtEpilogue::kGeluAuxBias;
+}
+#endif
+
+// Alignment of the pointer in bytes, up to the 256 bytes the cuBLASLt heuristic takes into account.
+int64_t Alignment(const void* p) {
+  const auto address = reinterpret_cast<uintptr_t>(p);
+  int64_t alignment = 256;
+  while (alignment > 1 && address % alignment != 0) {
+    alignment /= 2;
+  }
+  return alignment;
+}
+
+// Owns the cuBLASLt descriptors of one matrix multiplication.
+struct MatmulDescriptors {
+  cublasLtMatmulDesc_t op_desc{nullptr};
+  cublasLtMatrixLayout_t a_layout{nullptr};
+  cublasLtMatrixLayout_t b_layout{nullptr};
+  cublasLtMatrixLayout_t c_layout{nullptr};
+  cublasLtMatrixLayout_t d_layout{nullptr};
+  cublasLtMatmulPreference_t preference{nullptr};
+
+  MatmulDescriptors() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MatmulDescriptors);
+
+  ~MatmulDescriptors() {
+    if (preference) cublasLtMatmulPreferenceDestroy(preference);
+    if (d_layout) cublasLtMatrixLayoutDestroy(d_layout);
+    if (c_layout) cublasLtMatrixLayoutDestroy(c_layout);
+    if (b_layout) cublasLtMatrixLayoutDestroy(b_layout);
+    if (a_layout) cublasLtMatrixLayoutDestroy(a_layout);
+    if (op_desc) cublasLtMatmulDescDestroy(op_desc);
+  }
+};
+
+Status CreateLayout(cublasLtMatrixLayout_t& layout, cudaDataType_t data_type, int64_t rows, int64_t cols,
+                    int64_t ld, int64_t stride, int64_t batch_count) {
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&layout, data_type, rows, cols, ld));
+  if (batch_count > 1) {
+    const int32_t count = gsl::narrow<int32_t>(batch_count);
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutSetAttribute(layout, CUBLASLT_MATRIX_LAYOUT_BATCH_COUNT,
+                                                            &count, sizeof(count)));
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutSetAttribute(layout, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
+                                                            &stride, sizeof(stride)));
+  }
+  return Status::OK();
+}
+
+// The algorithms picked by the heuristic, by the device, data type and everything the heuristic looks at.
+OrtMutex algo_cache_mutex;
+std::map<std::vector<int64_t>, cublasLtMatmulAlgo_t> algo_cache;
+}  // namespace
+
+bool IsCublasLtEpilogueSupported(CublasLtEpilogue epilogue) {
+#if CUDA_VERSION >= 11040
+  ORT_UNUSED_PARAMETER(epilogue);
+  return true;
+#else
+  return epilogue == CublasLtEpilogue::kDefault || epilogue == CublasLtEpilogue::kBias ||
+         epilogue == CublasLtEpilogue::kRelu || epilogue == CublasLtEpilogue::kReluBias;
+#endif
+}
+
+Status CublasLtMatmul(cublasLtHandle_t handle, cudaStream_t stream, int device_id, cudaDataType_t data_type,
+                      const CublasLtMatmulArgs& args, void* workspace, size_t workspace_size) {
+  ORT_RETURN_IF_NOT(data_type == CUDA_R_32F || data_type == CUDA_R_16F || data_type == CUDA_R_16BF,
+                    "cuBLASLt is only used for float, float16 and bfloat16.");
+  ORT_RETURN_IF_NOT(IsCublasLtEpilogueSupported(args.epilogue), "The cuBLASLt epilogue is not supported.");
+  const void* c = args.beta != 0.0f ? args.c : args.d;
+  const int64_t ldc = args.beta != 0.0f ? args.ldc : args.ldd;
+  const int64_t stride_c = args.beta != 0.0f ? args.stride_c : args.stride_d;
+
+  MatmulDescriptors descriptors;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescCreate(&descriptors.op_desc, CUBLAS_COMPUTE_32F, CUDA_R_32F));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(descriptors.op_desc, CUBLASLT_MATMUL_DESC_TRANSA,
+                                                        &args.trans_a, sizeof(args.trans_a)));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(descriptors.op_desc, CUBLASLT_MATMUL_DESC_TRANSB,
+                                                        &args.trans_b, sizeof(args.trans_b)));
+  const cublasLtEpilogue_t epilogue = ToCublasLtEpilogue(args.epilogue);
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(descriptors.op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE,
+                                                        &epilogue, sizeof(epilogue)));
+  if (HasBias(args.epilogue)) {
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(descriptors.op_desc, CUBLASLT_MATMUL_DESC_BIAS_POINTER,
+                                                          &args.bias, sizeof(args.bias)));
+  }
+#if CUDA_VERSION >= 11040
+  if (HasAux(args.epilogue)) {
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(
+        descriptors.op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE_AUX_POINTER, &args.aux, sizeof(args.aux)));
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(
+        descriptors.op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE_AUX_LD, &args.ld_aux, sizeof(args.ld_aux)));
+    if (args.batch_count > 1) {
+      CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(
+          descriptors.op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE_AUX_BATCH_STRIDE,
+          &args.stride_aux, sizeof(args.stride_aux)));
+    }
+  }
+#endif
+
+  const bool trans_a = args.trans_a != CUBLAS_OP_N;
+  const bool trans_b = args.trans_b != CUBLAS_OP_N;
+  ORT_RETURN_IF_ERROR(CreateLayout(descriptors.a_layout, data_type, trans_a ? args.k : args.m,
+                                   trans_a ? args.m : args.k, args.lda, args.stride_a, args.batch_count));
+  ORT_RETURN_IF_ERROR(CreateLayout(descriptors.b_layout, data_type, trans_b ? args.n : args.k,
+                                   trans_b ? args.k : args.n, args.ldb, args.stride_b, args.batch_count));
+  ORT_RETURN_IF_ERROR(CreateLayout(descriptors.c_layout, data_type, args.m, args.n, ldc, stride_c,
+                                   args.batch_count));
+  ORT_RETURN_IF_ERROR(CreateLayout(descriptors.d_layout, data_type, args.m, args.n, args.ldd, args.stride_d,
+                                   args.batch_count));
+
+  const std::vector<int64_t> key{
+      device_id, static_cast<int64_t>(data_type), static_cast<int64_t>(args.trans_a),
+      static_cast<int64_t>(args.trans_b), args.m, args.n, args.k, args.lda, args.stride_a, args.ldb, args.stride_b,
+      ldc, stride_c, args.ldd, args.stride_d, args.batch_count, static_cast<int64_t>(args.epilogue),
+      args.ld_aux, args.stride_aux, static_cast<int64_t>(workspace_size), Alignment(args.a), Alignment(args.b),
+      Alignment(c), Alignment(args.d), Alignment(args.bias)};
+
+  cublasLtMatmulAlgo_t algo;
+  {
+    std::lock_guard<OrtMutex> lock(algo_cache_mutex);
+    auto it = algo_cache.find(key);
+    if (it == algo_cache.end()) {
+      const uint64_t max_workspace_size = workspace_size;
+      CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceCreate(&descriptors.preference));
+      CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceSetAttribute(
+          descriptors.preference, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+          &max_workspace_size, sizeof(max_workspace_size)));
+      // without these the heuristic may pick an algorithm that needs 256 byte aligned buffers
+      const cublasLtMatmulPreferenceAttributes_t alignment_attributes[] = {
+          CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES, CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES,
+          CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES, CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES};
+      const void* pointers[] = {args.a, args.b, c, args.d};
+      for (size_t i = 0; i < 4; ++i) {
+        const uint32_t alignment = static_cast<uint32_t>(Alignment(pointers[i]));
+        CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceSetAttribute(
+            descriptors.preference, alignment_attributes[i], &alignment, sizeof(alignment)));
+      }
+
+      cublasLtMatmulHeuristicResult_t result{};
+      int returned_results = 0;
+      CUBLAS_RETURN_IF_ERROR(cublasLtMatmulAlgoGetHeuristic(
+          handle, descriptors.op_desc, descriptors.a_layout, descriptors.b_layout, descriptors.c_layout,
+          descriptors.d_layout, descriptors.preference, 1, &result, &returned_results));
+      ORT_RETURN_IF_NOT(returned_results > 0, "cuBLASLt found no algorithm for the matrix multiplication.");
+      it = algo_cache.emplace(key, result.algo).first;
+    }
+    algo = it->second;
+  }
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmul(
+      handle, descriptors.op_desc,
+      &args.alpha, args.a, descriptors.a_layout, args.b, descriptors.b_layout,
+      &args.beta, c, descriptors.c_layout, args.d, descriptors.d_layout,
+      &algo, workspace, workspace_size, stream));
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_common.h"
+
+// The cuBLASLt matrix multiplication with epilogues, for CUDA 11.0 and above.
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+
+namespace onnxruntime {
+namespace cuda {
+
+// Work applied by cuBLASLt to the result of the matrix multiplication before it is written out, saving the
+// elementwise kernels that would otherwise read and write the whole output again.
+enum class CublasLtEpilogue {
+  kDefault,      // D = alpha * op(A) x op(B) + beta * C
+  kBias,         // adds the bias, a vector of m elements, to each column of D
+  kRelu,
+  kReluBias,
+  kGelu,         // the tanh approximation of Gelu, i.e. FastGelu
+  kGeluBias,
+  kReluAuxBias,  // kReluBias, also writing the ReLU mask to aux for the backward pass
+  kGeluAuxBias,  // kGeluBias, also writing the input of the Gelu to aux for the backward pass
+};
+
+// Whether cuBLASLt of this build supports the epilogue. The Gelu and aux epilogues need CUDA 11.4.
+bool IsCublasLtEpilogueSupported(CublasLtEpilogue epilogue);
+
+// Arguments of a strided batched matrix multiplication, column major as for cuBLAS:
+// D[i] = epilogue(alpha * op(A[i]) x op(B[i]) + beta * C[i]) for i in [0, batch_count), with D of shape (m, n).
+struct CublasLtMatmulArgs {
+  cublasOperation_t trans_a{CUBLAS_OP_N};
+  cublasOperation_t trans_b{CUBLAS_OP_N};
+  int64_t m{0};
+  int64_t n{0};
+  int64_t k{0};
+  const void* a{nullptr};
+  int64_t lda{0};
+  int64_t stride_a{0};
+  const void* b{nullptr};
+  int64_t ldb{0};
+  int64_t stride_b{0};
+  // Only read when beta is not 0. May be the same buffer as d.
+  const void* c{nullptr};
+  int64_t ldc{0};
+  int64_t stride_c{0};
+  void* d{nullptr};
+  int64_t ldd{0};
+  int64_t stride_d{0};
+  int64_t batch_count{1};
+  float alpha{1.0f};
+  float beta{0.0f};
+  CublasLtEpilogue epilogue{CublasLtEpilogue::kDefault};
+  const void* bias{nullptr};
+  void* aux{nullptr};
+  int64_t ld_aux{0};
+  int64_t stride_aux{0};
+};
+
+// Size of the scratch buffer passed to CublasLtMatmul. Some of the faster algorithms need a workspace.
+constexpr size_t kCublasLtWorkspaceSize = 4 * 1024 * 1024;
+
+// The cudaDataType_t of a CUDA element type, e.g. CudaDataType<half>::value is CUDA_R_16F.
+template <typename T>
+struct CudaDataType;
+
+template <>
+struct CudaDataType<float> {
+  static constexpr cudaDataType_t value = CUDA_R_32F;
+};
+
+template <>
+struct CudaDataType<double> {
+  static constexpr cudaDataType_t value = CUDA_R_64F;
+};
+
+template <>
+struct CudaDataType<half> {
+  static constexpr cudaDataType_t value = CUDA_R_16F;
+};
+
+template <>
+struct CudaDataType<nv_bfloat16> {
+  static constexpr cudaDataType_t value = CUDA_R_16BF;
+};
+
+// Runs the matrix multiplication with cublasLtMatmul. The algorithm is picked by the cuBLASLt heuristic the first
+// time a shape is seen, and cached for the process.
+// The data type of the matrices is CUDA_R_32F, CUDA_R_16F or CUDA_R_16BF; the products are accumulated in float.
+Status CublasLtMatmul(cublasLtHandle_t handle, cudaStream_t stream, int device_id, cudaDataType_t data_type,
+                      const CublasLtMatmulArgs& args, void* workspace, size_t workspace_size);
+
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif
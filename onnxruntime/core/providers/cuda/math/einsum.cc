@@ -44,6 +44,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                        einsum_compute_preprocessor,
                                                                        &einsum_cuda_assets);
 
+    einsum_compute_processor.SetContractionPlanCache(&contraction_plan_cache_);
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CudaDeviceHelpers::Transpose,
                                               EinsumOp::DeviceHelpers::CudaDeviceHelpers::MatMul<float>,
                                               EinsumOp::DeviceHelpers::CudaDeviceHelpers::ReduceSum<float>,
@@ -55,6 +56,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                         &einsum_cuda_assets);
 
     // Set device specific methods (CPU methods) to be used during processing
+    einsum_compute_processor.SetContractionPlanCache(&contraction_plan_cache_);
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CudaDeviceHelpers::Transpose,
                                               EinsumOp::DeviceHelpers::CudaDeviceHelpers::MatMul<double>,
                                               EinsumOp::DeviceHelpers::CudaDeviceHelpers::ReduceSum<double>,
@@ -65,6 +67,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                            einsum_compute_preprocessor,
                                                                            &einsum_cuda_assets);
 
+    einsum_compute_processor.SetContractionPlanCache(&contraction_plan_cache_);
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CudaDeviceHelpers::Transpose,
                                               EinsumOp::DeviceHelpers::CudaDeviceHelpers::MatMul<MLFloat16>,
                                               EinsumOp::DeviceHelpers::CudaDeviceHelpers::ReduceSum<MLFloat16>,
@@ -31,6 +31,7 @@ class Einsum final : public onnxruntime::Einsum {
   // Members of Einsum CUDA kernel
   using onnxruntime::Einsum::einsum_equation_preprocessor_;
   using onnxruntime::Einsum::equation_;
+  using onnxruntime::Einsum::contraction_plan_cache_;
 
   // We need to access to the CUDA EP instance to get the cublas/cudnn handles
   CUDAExecutionProvider* cuda_ep_;
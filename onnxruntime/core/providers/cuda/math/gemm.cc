@@ -4,6 +4,7 @@
 #include "core/providers/cuda/math/gemm.h"
 #include "core/providers/cpu/math/gemm_helper.h"
 #include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/math/cublaslt_matmul.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 
 namespace onnxruntime {
@@ -59,6 +60,12 @@ REGISTER_KERNEL_TYPED(BFloat16)
 
 template <typename T>
 Status Gemm<T>::ComputeInternal(OpKernelContext* ctx) const {
+  bool activation_applied = false;
+  return ComputeGemm(ctx, GemmActivation::kNone, activation_applied);
+}
+
+template <typename T>
+Status Gemm<T>::ComputeGemm(OpKernelContext* ctx, GemmActivation activation, bool& activation_applied) const {
   typedef typename ToCudaType<T>::MappedType CudaT;
 
   const auto* X = ctx->Input<Tensor>(0);
@@ -76,53 +83,62 @@ Status Gemm<T>::ComputeInternal(OpKernelContext* ctx) const {
   auto* Y = ctx->Output(0, {M, N});
   CudaT* out_data = reinterpret_cast<CudaT*>(Y->template MutableData<T>());
 
-  CudaT one = ToCudaType<T>::FromFloat(1.0f);
-  CudaT zero = ToCudaType<T>::FromFloat(0.0f);
-  auto& device_prop = GetDeviceProp();
+  activation_applied = activation == GemmActivation::kNone;
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+  // B is (N,) or (1, N) and can be added to each row of Y in the epilogue
+  const bool bias_per_column = B != nullptr && beta_ == 1.0f && B->Shape().Size() == N &&
+                               (B->Shape().NumDimensions() == 1 || B->Shape()[0] == 1);
+  if (!std::is_same<T, double>::value && M > 0 && N > 0 && K > 0 &&
+      (bias_per_column || activation != GemmActivation::kNone)) {
+    CublasLtEpilogue epilogue = bias_per_column ? CublasLtEpilogue::kBias : CublasLtEpilogue::kDefault;
+    if (activation == GemmActivation::kRelu) {
+      epilogue = bias_per_column ? CublasLtEpilogue::kReluBias : CublasLtEpilogue::kRelu;
+    } else if (activation == GemmActivation::kFastGelu) {
+      epilogue = bias_per_column ? CublasLtEpilogue::kGeluBias : CublasLtEpilogue::kGelu;
+    }
+
+    if (IsCublasLtEpilogueSupported(epilogue)) {
+      const bool bias_in_output = B != nullptr && beta_ != 0 && !bias_per_column;
+      if (bias_in_output) {
+        ORT_RETURN_IF_ERROR(BroadcastBias(*B, M, N, out_data));
+      }
+
+      // CUDA assumes col-major, so Y(N,M) = epilogue(alpha * op(W) x op(X) + beta * Y)
+      CublasLtMatmulArgs args;
+      args.trans_a = trans_B_ ? CUBLAS_OP_T : CUBLAS_OP_N;
+      args.trans_b = trans_A_ ? CUBLAS_OP_T : CUBLAS_OP_N;
+      args.m = N;
+      args.n = M;
+      args.k = K;
+      args.a = W->template Data<T>();
+      args.lda = trans_B_ ? K : N;
+      args.b = X->template Data<T>();
+      args.ldb = trans_A_ ? M : K;
+      args.c = out_data;
+      args.ldc = N;
+      args.d = out_data;
+      args.ldd = N;
+      args.alpha = alpha_;
+      args.beta = bias_in_output ? beta_ : 0.0f;
+      args.epilogue = epilogue;
+      args.bias = bias_per_column ? B->template Data<T>() : nullptr;
+
+      auto workspace = GetScratchBuffer<void>(kCublasLtWorkspaceSize);
+      ORT_RETURN_IF_ERROR(CublasLtMatmul(CublasLtHandle(), Stream(), GetDeviceId(), CudaDataType<CudaT>::value, args,
+                                         workspace.get(), kCublasLtWorkspaceSize));
+      activation_applied = true;
+      return Status::OK();
+    }
+  }
+#endif
+
   // broadcast bias if needed and is present
   if (beta_ != 0 && B != nullptr) {
-    auto& b_shape = B->Shape();
-    const CudaT* b_data = reinterpret_cast<const CudaT*>(B->template Data<T>());
-    if (b_shape.Size() == 1) {
-      // if B is (), (1,) or (1, 1), broadcast the scalar
-      CUBLAS_RETURN_IF_ERROR(cublasCopyHelper(
-          Stream(),
-          CublasHandle(),
-          M * N,
-          b_data,
-          0,
-          out_data,
-          1));
-    } else if (b_shape.NumDimensions() == 1 || b_shape[0] == 1) {
-      // B is (N,) or (1, N), broadcast using Y(N,M) = 1 * B(N,1) x ones(1,M) + 0 * Y
-      CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
-          CublasHandle(),
-          CUBLAS_OP_N,
-          CUBLAS_OP_N,
-          N, M, 1,
-          /*alpha*/ &one,
-          b_data, N,
-          GetConstOnes<CudaT>(M), 1,
-          /*beta*/ &zero,
-          out_data, N, device_prop));
-    } else if (b_shape.NumDimensions() == 2 && b_shape[1] == 1) {
-      // B is (M, 1), broadcast using Y(N,M) = 1 * ones(N,1) x B(1,M) + 0 * Y
-      CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
-          CublasHandle(),
-          CUBLAS_OP_N,
-          CUBLAS_OP_N,
-          N, M, 1,
-          /*alpha*/ &one,
-          GetConstOnes<CudaT>(N), N,
-          b_data, 1,
-          /*beta*/ &zero,
-          out_data, N, device_prop));
-    } else {
-      // B is (M, N), no broadcast needed.
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(out_data, b_data, M * N * sizeof(T), cudaMemcpyDeviceToDevice, Stream()));
-    }
+    ORT_RETURN_IF_ERROR(BroadcastBias(*B, M, N, out_data));
   }
 
+  CudaT zero = ToCudaType<T>::FromFloat(0.0f);
   CudaT alpha = ToCudaType<T>::FromFloat(alpha_);
   CudaT beta = ToCudaType<T>::FromFloat(beta_);
   // Gemm, note that CUDA assumes col-major, so Y(N,M) = alpha * op(W) x op(X) + beta * Y
@@ -139,8 +155,58 @@ Status Gemm<T>::ComputeInternal(OpKernelContext* ctx) const {
       // ideally we need to set the output buffer contents to 0 if bias is missing,
       // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
       B != nullptr ? &beta : &zero,
-      out_data, N, device_prop));
+      out_data, N, GetDeviceProp()));
+
+  return Status::OK();
+}
 
+template <typename T>
+Status Gemm<T>::BroadcastBias(const Tensor& B, int M, int N, typename ToCudaType<T>::MappedType* out_data) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  CudaT one = ToCudaType<T>::FromFloat(1.0f);
+  CudaT zero = ToCudaType<T>::FromFloat(0.0f);
+  auto& device_prop = GetDeviceProp();
+  auto& b_shape = B.Shape();
+  const CudaT* b_data = reinterpret_cast<const CudaT*>(B.template Data<T>());
+  if (b_shape.Size() == 1) {
+    // if B is (), (1,) or (1, 1), broadcast the scalar
+    CUBLAS_RETURN_IF_ERROR(cublasCopyHelper(
+        Stream(),
+        CublasHandle(),
+        M * N,
+        b_data,
+        0,
+        out_data,
+        1));
+  } else if (b_shape.NumDimensions() == 1 || b_shape[0] == 1) {
+    // B is (N,) or (1, N), broadcast using Y(N,M) = 1 * B(N,1) x ones(1,M) + 0 * Y
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        CublasHandle(),
+        CUBLAS_OP_N,
+        CUBLAS_OP_N,
+        N, M, 1,
+        /*alpha*/ &one,
+        b_data, N,
+        GetConstOnes<CudaT>(M), 1,
+        /*beta*/ &zero,
+        out_data, N, device_prop));
+  } else if (b_shape.NumDimensions() == 2 && b_shape[1] == 1) {
+    // B is (M, 1), broadcast using Y(N,M) = 1 * ones(N,1) x B(1,M) + 0 * Y
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        CublasHandle(),
+        CUBLAS_OP_N,
+        CUBLAS_OP_N,
+        N, M, 1,
+        /*alpha*/ &one,
+        GetConstOnes<CudaT>(N), N,
+        b_data, 1,
+        /*beta*/ &zero,
+        out_data, N, device_prop));
+  } else {
+    // B is (M, N), no broadcast needed.
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(out_data, b_data, M * N * sizeof(T), cudaMemcpyDeviceToDevice, Stream()));
+  }
   return Status::OK();
 }
 
@@ -7,8 +7,16 @@
 
 namespace onnxruntime {
 namespace cuda {
+
+// Activation applied to the output of Gemm by the FusedGemm contrib op.
+enum class GemmActivation {
+  kNone,
+  kRelu,
+  kFastGelu,
+};
+
 template <typename T>
-class Gemm final : public CudaKernel {
+class Gemm : public CudaKernel {
   using Base = CudaKernel;
 
  public:
@@ -26,7 +34,16 @@ class Gemm final : public CudaKernel {
 
   Status ComputeInternal(OpKernelContext* context) const override;
 
+ protected:
+  // Computes Y. The bias and the activation are applied in the epilogue of cublasLtMatmul where cuBLASLt supports
+  // them, saving the kernels that would read and write Y again; `activation_applied` tells whether the caller
+  // still has to apply the activation to Y.
+  Status ComputeGemm(OpKernelContext* context, GemmActivation activation, bool& activation_applied) const;
+
  private:
+  // Writes B, broadcast to (M, N), to Y.
+  Status BroadcastBias(const Tensor& B, int M, int N, typename ToCudaType<T>::MappedType* out_data) const;
+
   bool trans_A_;
   bool trans_B_;
   float alpha_;
@@ -127,5 +127,65 @@ Status OffsetOutput(cudaStream_t stream,
   return CUDA_CALL(cudaPeekAtLastError()) ? Status::OK() : Status(common::ONNXRUNTIME, common::FAIL);
 }
 
+__global__ void ConvertUint8ToInt8Kernel(const uint8_t* input, int8_t* output, CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+  output[id] = static_cast<int8_t>(input[id] ^ 0x80);
+}
+
+Status ConvertUint8ToInt8(cudaStream_t stream, const uint8_t* input, int8_t* output, size_t count) {
+  if (count == 0) {
+    return Status::OK();
+  }
+
+  int blocks_per_grid = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock));
+  ConvertUint8ToInt8Kernel<<<blocks_per_grid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      input, output, static_cast<CUDA_LONG>(count));
+
+  return CUDA_CALL(cudaPeekAtLastError()) ? Status::OK() : Status(common::ONNXRUNTIME, common::FAIL);
+}
+
+// One block per row of the output. The zero point corrections are applied in the same pass as the requantization.
+__global__ void RequantizeOutputKernel(const int32_t* gemm_output,
+                                       const int32_t* row_sum,
+                                       const int32_t* col_sum,
+                                       uint8_t* output,
+                                       int32_t K_A_B,
+                                       float multiplier,
+                                       int32_t output_offset,
+                                       int32_t N) {
+  const int32_t row_offset = K_A_B - (row_sum == nullptr ? 0 : row_sum[blockIdx.x]);
+  for (int32_t i = threadIdx.x; i < N; i += blockDim.x) {
+    int32_t value = *(gemm_output + blockIdx.x * N + i) + row_offset - (col_sum == nullptr ? 0 : col_sum[i]);
+    // __float2int_rn rounds half to even, as MlasRequantizeOutput does on CPU.
+    value = __float2int_rn(multiplier * static_cast<float>(value)) + output_offset;
+    *(output + blockIdx.x * N + i) = static_cast<uint8_t>(max(0, min(255, value)));
+  }
+}
+
+Status RequantizeOutput(cudaStream_t stream,
+                        const int32_t* gemm_output,
+                        const int32_t* row_sum,
+                        const int32_t* col_sum,
+                        uint8_t* output,
+                        const int8_t a_offset,
+                        const int8_t b_offset,
+                        const float multiplier,
+                        const uint8_t output_offset,
+                        const MatMulComputeHelper& helper) {
+  for (size_t batch = 0; batch < helper.OutputOffsets().size(); batch++) {
+    RequantizeOutputKernel<<<static_cast<int>(helper.M()), GridDim::maxThreadsPerBlock, 0, stream>>>(
+        gemm_output + batch * helper.M() * helper.N(),
+        row_sum == nullptr ? nullptr : row_sum + batch * helper.M(),
+        col_sum == nullptr ? nullptr : col_sum + batch * helper.N(),
+        output + helper.OutputOffsets()[batch],
+        static_cast<int32_t>(helper.K()) * a_offset * b_offset,
+        multiplier,
+        static_cast<int32_t>(output_offset),
+        static_cast<int32_t>(helper.N()));
+  }
+
+  return CUDA_CALL(cudaPeekAtLastError()) ? Status::OK() : Status(common::ONNXRUNTIME, common::FAIL);
+}
+
 }  // namespace cuda
 }  // namespace onnxruntime
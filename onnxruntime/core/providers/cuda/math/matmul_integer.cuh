@@ -21,5 +21,22 @@ Status OffsetOutput(cudaStream_t stream,
                     const int8_t b_offset,
                     const MatMulComputeHelper& helper);
 
+// Maps uint8 values to int8 by subtracting 128, which keeps (x - zero_point) when the zero point is shifted too.
+Status ConvertUint8ToInt8(cudaStream_t stream, const uint8_t* input, int8_t* output, size_t count);
+
+// Requantizes the int32 result of the GEMM of int8 matrices to uint8:
+// output = saturate(round(multiplier * (gemm_output + K * a_offset * b_offset - row_sum - col_sum)) + output_offset)
+// where row_sum and col_sum come from ReduceRowSumOnMatrixA and ReduceColSumOnMatrixB, and are null for a zero offset.
+Status RequantizeOutput(cudaStream_t stream,
+                        const int32_t* gemm_output,
+                        const int32_t* row_sum,
+                        const int32_t* col_sum,
+                        uint8_t* output,
+                        const int8_t a_offset,
+                        const int8_t b_offset,
+                        const float multiplier,
+                        const uint8_t output_offset,
+                        const MatMulComputeHelper& helper);
+
 }  // namespace cuda
 }  // namespace onnxruntime
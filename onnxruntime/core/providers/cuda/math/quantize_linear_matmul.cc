@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "quantize_linear_matmul.h"
+#include "matmul_integer.cuh"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cuda/shared_inc/integer_gemm.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    QLinearMatMul,
+    kOnnxDomain,
+    10,
+    kCudaExecutionProvider,
+    KernelDefBuilder()
+        .InputMemoryType<OrtMemTypeCPUInput>(QLinearMatMul::IN_A_SCALE)
+        .InputMemoryType<OrtMemTypeCPUInput>(QLinearMatMul::IN_A_ZERO_POINT)
+        .InputMemoryType<OrtMemTypeCPUInput>(QLinearMatMul::IN_B_SCALE)
+        .InputMemoryType<OrtMemTypeCPUInput>(QLinearMatMul::IN_B_ZERO_POINT)
+        .InputMemoryType<OrtMemTypeCPUInput>(QLinearMatMul::IN_Y_SCALE)
+        .InputMemoryType<OrtMemTypeCPUInput>(QLinearMatMul::IN_Y_ZERO_POINT)
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearMatMul);
+
+Status QLinearMatMul::ComputeInternal(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(IN_A);
+  const Tensor* b = ctx->Input<Tensor>(IN_B);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  // validate offsets
+  const Tensor* a_zero_point = ctx->Input<Tensor>(IN_A_ZERO_POINT);
+  const Tensor* b_zero_point = ctx->Input<Tensor>(IN_B_ZERO_POINT);
+  const Tensor* y_zero_point = ctx->Input<Tensor>(IN_Y_ZERO_POINT);
+  ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point),
+              "QLinearMatmul : input zero point must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point),
+              "QLinearMatmul : weight zero point must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(y_zero_point),
+              "QLinearMatmul : result zero point must be a scalar or 1D tensor of size 1");
+
+  // validate scale
+  const Tensor* a_scale = ctx->Input<Tensor>(IN_A_SCALE);
+  const Tensor* b_scale = ctx->Input<Tensor>(IN_B_SCALE);
+  const Tensor* y_scale = ctx->Input<Tensor>(IN_Y_SCALE);
+  ORT_ENFORCE(IsScalarOr1ElementVector(a_scale),
+              "QLinearMatmul : input scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(b_scale),
+              "QLinearMatmul : weight scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(y_scale),
+              "QLinearMatmul : result scale must be a scalar or 1D tensor of size 1");
+
+  const float real_multiplier =
+      (*a_scale->template Data<float>() * *b_scale->template Data<float>()) / *y_scale->template Data<float>();
+
+  // cuBLAS only multiplies int8 matrices, so uint8 values and zero points are shifted by -128.
+  auto a_int8 = GetScratchBuffer<int8_t>(a->Shape().Size());
+  ORT_RETURN_IF_ERROR(ConvertUint8ToInt8(Stream(), a->template Data<uint8_t>(), a_int8.get(), a->Shape().Size()));
+  const int8_t a_offset = static_cast<int8_t>(*a_zero_point->template Data<uint8_t>() ^ 0x80);
+
+  IAllocatorUniquePtr<int8_t> b_int8;
+  const int8_t* b_ptr = nullptr;
+  int8_t b_offset = 0;
+  if (b->IsDataType<int8_t>()) {
+    b_ptr = b->template Data<int8_t>();
+    b_offset = *b_zero_point->template Data<int8_t>();
+  } else {
+    b_int8 = GetScratchBuffer<int8_t>(b->Shape().Size());
+    ORT_RETURN_IF_ERROR(ConvertUint8ToInt8(Stream(), b->template Data<uint8_t>(), b_int8.get(), b->Shape().Size()));
+    b_ptr = b_int8.get();
+    b_offset = static_cast<int8_t>(*b_zero_point->template Data<uint8_t>() ^ 0x80);
+  }
+
+  // The row sums of A and column sums of B times the other offset, see MatMulInteger.
+  IAllocatorUniquePtr<int32_t> a_row_buf;
+  if (b_offset != 0) {
+    a_row_buf = GetScratchBuffer<int32_t>(helper.OutputShape().Size() / helper.N());
+    ORT_RETURN_IF_ERROR(ReduceRowSumOnMatrixA(Stream(), a_int8.get(), a_row_buf.get(), b_offset, helper));
+  }
+
+  IAllocatorUniquePtr<int32_t> b_col_buf;
+  if (a_offset != 0) {
+    b_col_buf = GetScratchBuffer<int32_t>(helper.OutputShape().Size() / helper.M());
+    ORT_RETURN_IF_ERROR(ReduceColSumOnMatrixB(Stream(), b_ptr, b_col_buf.get(), a_offset, helper));
+  }
+
+  auto gemm_output = GetScratchBuffer<int32_t>(helper.OutputShape().Size());
+  for (size_t batch = 0; batch < helper.OutputOffsets().size(); batch++) {
+    ORT_RETURN_IF_ERROR(GemmInt8(static_cast<int>(helper.M()),
+                                 static_cast<int>(helper.N()),
+                                 static_cast<int>(helper.K()),
+                                 1,
+                                 0,
+                                 a_int8.get() + helper.LeftOffsets()[batch],
+                                 static_cast<int>(helper.K()),
+                                 b_ptr + helper.RightOffsets()[batch],
+                                 static_cast<int>(helper.N()),
+                                 gemm_output.get() + helper.OutputOffsets()[batch],
+                                 static_cast<int>(helper.N()),
+                                 this));
+  }
+
+  return RequantizeOutput(Stream(),
+                          gemm_output.get(),
+                          a_row_buf.get(),
+                          b_col_buf.get(),
+                          y->template MutableData<uint8_t>(),
+                          a_offset,
+                          b_offset,
+                          real_multiplier,
+                          *y_zero_point->template Data<uint8_t>(),
+                          helper);
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// QLinearMatMul with uint8 A and Y and uint8 or int8 B, per tensor scales and zero points, like the CPU kernel.
+// The product is computed by the int8 GEMM of cuBLAS, and the zero point corrections and the requantization to Y
+// are done in one pass over its int32 result.
+class QLinearMatMul final : public CudaKernel {
+ public:
+  QLinearMatMul(const OpKernelInfo& info) : CudaKernel(info) {}
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+  enum InputTensors : int {
+    IN_A = 0,
+    IN_A_SCALE = 1,
+    IN_A_ZERO_POINT = 2,
+    IN_B = 3,
+    IN_B_SCALE = 4,
+    IN_B_ZERO_POINT = 5,
+    IN_Y_SCALE = 6,
+    IN_Y_ZERO_POINT = 7
+  };
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
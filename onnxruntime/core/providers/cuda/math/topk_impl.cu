@@ -416,6 +416,378 @@ __global__ void ExcludeOutput(int64_t* output_i, int64_t K, int64_t dimension) {
   }
 }
 
+// Multi pass radix select: the K-th key of each row is found one 8 bit digit at a time, from the most significant,
+// by counting the keys that share the digits found so far. Each pass reads the row once, split over several blocks,
+// and no key is moved until the K selected ones are gathered, so only these are sorted afterwards.
+constexpr int kRadixSelectBits = 8;
+constexpr int kRadixSelectBins = 1 << kRadixSelectBits;
+// the most keys of a row handled by one block
+constexpr int64_t kRadixSelectMaxItemsPerBlock = BT * 16;
+// the radix select is used for rows of at least this many keys per byte of the key type, as it launches two kernels
+// for each byte
+constexpr int64_t kRadixSelectMinDimensionPerByte = 8192;
+
+// maps the values to unsigned keys with the same order
+template <typename T>
+struct RadixSelectKey;
+
+#define RADIX_SELECT_UNSIGNED_KEY(T)                                          \
+  template <>                                                                 \
+  struct RadixSelectKey<T> {                                                  \
+    typedef T Bits;                                                           \
+    __device__ static Bits Convert(T value) { return value; }                 \
+  };
+
+#define RADIX_SELECT_SIGNED_KEY(T, U)                                         \
+  template <>                                                                 \
+  struct RadixSelectKey<T> {                                                  \
+    typedef U Bits;                                                           \
+    __device__ static Bits Convert(T value) {                                 \
+      return static_cast<Bits>(static_cast<Bits>(value) ^ (Bits(1) << (sizeof(Bits) * 8 - 1))); \
+    }                                                                         \
+  };
+
+// negative floats have the sign bit set and their other bits in reverse order
+#define RADIX_SELECT_FLOAT_KEY(T, U)                                          \
+  template <>                                                                 \
+  struct RadixSelectKey<T> {                                                  \
+    typedef U Bits;                                                           \
+    __device__ static Bits Convert(T value) {                                 \
+      const Bits sign = Bits(1) << (sizeof(Bits) * 8 - 1);                    \
+      const Bits bits = *reinterpret_cast<const Bits*>(&value);               \
+      return static_cast<Bits>((bits & sign) ? ~bits : (bits | sign));        \
+    }                                                                         \
+  };
+
+RADIX_SELECT_UNSIGNED_KEY(uint8_t)
+RADIX_SELECT_UNSIGNED_KEY(uint16_t)
+RADIX_SELECT_UNSIGNED_KEY(uint32_t)
+RADIX_SELECT_UNSIGNED_KEY(uint64_t)
+RADIX_SELECT_SIGNED_KEY(int8_t, uint8_t)
+RADIX_SELECT_SIGNED_KEY(int16_t, uint16_t)
+RADIX_SELECT_SIGNED_KEY(int32_t, uint32_t)
+RADIX_SELECT_SIGNED_KEY(int64_t, uint64_t)
+RADIX_SELECT_FLOAT_KEY(half, uint16_t)
+RADIX_SELECT_FLOAT_KEY(float, uint32_t)
+RADIX_SELECT_FLOAT_KEY(double, uint64_t)
+
+// the K smallest keys are selected, so the keys are reversed to select the largest values
+template <typename T>
+__device__ __inline__ typename RadixSelectKey<T>::Bits GetRadixSelectKey(T value, int64_t largest) {
+  typedef typename RadixSelectKey<T>::Bits Bits;
+  const Bits key = RadixSelectKey<T>::Convert(value);
+  return 1 == largest ? static_cast<Bits>(~key) : key;
+}
+
+template <typename Bits>
+struct RadixSelectState {
+  Bits prefix;  // the digits of the K-th key found so far
+  Bits mask;    // the bits of these digits
+  int64_t k;    // how many of the keys matching the prefix are selected
+  bool done;    // whether all the keys matching the prefix are selected
+};
+
+__device__ __inline__ void GetTopKRowDims(const TArray<int64_t>& elem_nums, size_t size, int32_t axis, int64_t row,
+                                          int64_t& left_dim, int64_t& mid_dim, int64_t& right_dim) {
+  mid_dim = axis == size - 1 ? 1 : elem_nums[axis + 1];
+  left_dim = row / mid_dim * elem_nums[axis];
+  right_dim = axis == size - 1 ? 0 : row % mid_dim;
+}
+
+template <typename Bits>
+__global__ void RadixSelectInit(RadixSelectState<Bits>* states, int64_t K, int64_t N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(row, N);
+  states[row].prefix = 0;
+  states[row].mask = 0;
+  states[row].k = K;
+  states[row].done = false;
+}
+
+// Counts the next digit of the keys matching the prefix, in the range of the row handled by the block.
+template <typename T>
+__global__ void RadixSelectHistogram(const T* X, const TArray<int64_t> elem_nums, size_t size, int32_t axis,
+                                     int64_t largest, int64_t dimension, int64_t blocks_per_row,
+                                     int64_t items_per_block, int shift,
+                                     const RadixSelectState<typename RadixSelectKey<T>::Bits>* states,
+                                     uint32_t* histograms) {
+  typedef typename RadixSelectKey<T>::Bits Bits;
+  __shared__ uint32_t H[kRadixSelectBins];
+  const int64_t row = blockIdx.x / blocks_per_row;
+  const RadixSelectState<Bits> state = states[row];
+  if (state.done) {
+    return;
+  }
+
+  for (int i = threadIdx.x; i < kRadixSelectBins; i += blockDim.x) {
+    H[i] = 0;
+  }
+  __syncthreads();
+
+  int64_t left_dim, mid_dim, right_dim;
+  GetTopKRowDims(elem_nums, size, axis, row, left_dim, mid_dim, right_dim);
+  const int64_t begin = (blockIdx.x % blocks_per_row) * items_per_block;
+  const int64_t end = LESS(begin + items_per_block, dimension);
+  for (int64_t x_i = begin + threadIdx.x; x_i < end; x_i += blockDim.x) {
+    const Bits key = GetRadixSelectKey(X[FROM(x_i)], largest);
+    if ((key & state.mask) == state.prefix) {
+      atomicAdd(&H[(key >> shift) & (kRadixSelectBins - 1)], 1);
+    }
+  }
+  __syncthreads();
+
+  for (int i = threadIdx.x; i < kRadixSelectBins; i += blockDim.x) {
+    if (H[i] > 0) {
+      atomicAdd(&histograms[row * kRadixSelectBins + i], H[i]);
+    }
+  }
+}
+
+// Finds the digit of the K-th key from the histogram of the row, and clears the histogram for the next digit.
+template <typename Bits>
+__global__ void RadixSelectDigit(int shift, RadixSelectState<Bits>* states, uint32_t* histograms) {
+  typedef BlockScan<uint32_t, kRadixSelectBins> BlockScan;
+  __shared__ typename BlockScan::TempStorage temp_storage;
+  const int64_t row = blockIdx.x;
+  const RadixSelectState<Bits> state = states[row];
+  if (state.done) {
+    return;
+  }
+
+  uint32_t* histogram = histograms + row * kRadixSelectBins;
+  const uint32_t count = histogram[threadIdx.x];
+  histogram[threadIdx.x] = 0;
+  uint32_t inclusive = 0;
+  BlockScan(temp_storage).InclusiveSum(count, inclusive);
+  const uint32_t exclusive = inclusive - count;
+  if (exclusive < state.k && state.k <= inclusive) {
+    RadixSelectState<Bits> next = state;
+    next.prefix |= static_cast<Bits>(static_cast<Bits>(threadIdx.x) << shift);
+    next.mask |= static_cast<Bits>(static_cast<Bits>(kRadixSelectBins - 1) << shift);
+    next.k = state.k - exclusive;
+    next.done = count == next.k;
+    states[row] = next;
+  }
+}
+
+// Counts the keys of the range of the block that are before the K-th key (high 32 bits) and that match its prefix
+// (low 32 bits).
+template <typename T>
+__global__ void RadixSelectCount(const T* X, const TArray<int64_t> elem_nums, size_t size, int32_t axis,
+                                 int64_t largest, int64_t dimension, int64_t blocks_per_row, int64_t items_per_block,
+                                 const RadixSelectState<typename RadixSelectKey<T>::Bits>* states,
+                                 uint64_t* block_counts) {
+  typedef typename RadixSelectKey<T>::Bits Bits;
+  typedef BlockReduce<uint64_t, BT> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  const int64_t row = blockIdx.x / blocks_per_row;
+  const RadixSelectState<Bits> state = states[row];
+
+  int64_t left_dim, mid_dim, right_dim;
+  GetTopKRowDims(elem_nums, size, axis, row, left_dim, mid_dim, right_dim);
+  const int64_t begin = (blockIdx.x % blocks_per_row) * items_per_block;
+  const int64_t end = LESS(begin + items_per_block, dimension);
+  uint64_t counts = 0;
+  for (int64_t x_i = begin + threadIdx.x; x_i < end; x_i += blockDim.x) {
+    const Bits key = static_cast<Bits>(GetRadixSelectKey(X[FROM(x_i)], largest) & state.mask);
+    counts += key < state.prefix ? (uint64_t(1) << 32) : (key == state.prefix ? 1 : 0);
+  }
+  counts = BlockReduce(temp_storage).Sum(counts);
+  if (0 == threadIdx.x) {
+    block_counts[blockIdx.x] = counts;
+  }
+}
+
+// Writes the selected keys of the range of the block and their indices in index order: first the keys before the
+// K-th key, then the first of the keys matching its prefix.
+template <typename T>
+__global__ void RadixSelectGather(const T* X, const TArray<int64_t> elem_nums, size_t size, int32_t axis,
+                                  int64_t K, int64_t largest, int64_t dimension, int64_t blocks_per_row,
+                                  int64_t items_per_block,
+                                  const RadixSelectState<typename RadixSelectKey<T>::Bits>* states,
+                                  const uint64_t* block_counts,
+                                  typename RadixSelectKey<T>::Bits* selected_keys, int64_t* selected_indices) {
+  typedef typename RadixSelectKey<T>::Bits Bits;
+  typedef BlockReduce<uint64_t, BT> BlockReduce;
+  typedef BlockScan<uint64_t, BT> BlockScan;
+  __shared__ union {
+    typename BlockReduce::TempStorage reduce;
+    typename BlockScan::TempStorage scan;
+  } temp_storage;
+  __shared__ uint64_t block_offset;
+  const int64_t row = blockIdx.x / blocks_per_row;
+  const int64_t block = blockIdx.x % blocks_per_row;
+  const RadixSelectState<Bits> state = states[row];
+
+  // the counts of the previous blocks of the row
+  uint64_t offset = 0;
+  for (int64_t b = threadIdx.x; b < block; b += blockDim.x) {
+    offset += block_counts[row * blocks_per_row + b];
+  }
+  offset = BlockReduce(temp_storage.reduce).Sum(offset);
+  if (0 == threadIdx.x) {
+    block_offset = offset;
+  }
+  __syncthreads();
+  offset = block_offset;
+
+  int64_t left_dim, mid_dim, right_dim;
+  GetTopKRowDims(elem_nums, size, axis, row, left_dim, mid_dim, right_dim);
+  const int64_t before_count = K - state.k;
+  Bits* row_keys = selected_keys + row * K;
+  int64_t* row_indices = selected_indices + row * K;
+  const int64_t begin = block * items_per_block;
+  const int64_t end = LESS(begin + items_per_block, dimension);
+  for (int64_t tile = begin; tile < end; tile += blockDim.x) {
+    const int64_t x_i = tile + threadIdx.x;
+    Bits key = 0;
+    uint64_t flags = 0;
+    if (x_i < end) {
+      key = GetRadixSelectKey(X[FROM(x_i)], largest);
+      const Bits masked = static_cast<Bits>(key & state.mask);
+      flags = masked < state.prefix ? (uint64_t(1) << 32) : (masked == state.prefix ? 1 : 0);
+    }
+    uint64_t rank = 0;
+    uint64_t aggregate = 0;
+    __syncthreads();
+    BlockScan(temp_storage.scan).ExclusiveSum(flags, rank, aggregate);
+    rank += offset;
+    offset += aggregate;
+
+    int64_t to = -1;
+    if (flags >> 32) {
+      to = static_cast<int64_t>(rank >> 32);
+    } else if (flags) {
+      const int64_t equal_rank = static_cast<int64_t>(rank & 0xffffffff);
+      if (equal_rank < state.k) {
+        to = before_count + equal_rank;
+      }
+    }
+    if (to >= 0) {
+      row_keys[to] = key;
+      row_indices[to] = x_i;
+    }
+  }
+}
+
+__global__ void RadixSelectSegmentOffsets(int* offsets, int64_t K, int64_t N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N + 1);
+  offsets[id] = static_cast<int>(id * K);
+}
+
+template <typename T>
+__global__ void RadixSelectOutput(const T* X, T* V, int64_t* I, const int64_t* selected_indices,
+                                  const TArray<int64_t> elem_nums, size_t size, int32_t axis, int64_t K,
+                                  int64_t dimension, int64_t count) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, count);
+  const int64_t row = id / K;
+  const int64_t k_i = id % K;
+  int64_t left_dim, mid_dim, right_dim;
+  GetTopKRowDims(elem_nums, size, axis, row, left_dim, mid_dim, right_dim);
+  const int64_t x_i = selected_indices[id];
+  V[TO(k_i)] = X[FROM(x_i)];
+  I[TO(k_i)] = x_i;
+}
+
+// Whether the multi pass radix select is faster than the single block radix TopK or the full sort of each row,
+// for N rows of dimension keys of type T.
+template <typename T>
+bool UseRadixSelectTopK(const cudaDeviceProp& prop, int64_t K, int64_t sorted, int64_t N, int64_t dimension) {
+  // the number of keys sorted afterwards must fit in the int counts of cub
+  if (1 == sorted && N * K > std::numeric_limits<int>::max()) {
+    return false;
+  }
+  // The full sort of each row is replaced when several rows are sorted one after the other, or when K is a small
+  // part of the row.
+  if (1 == sorted && K > BT * 16) {
+    return N > 1 || 2 * K <= dimension;
+  }
+  // The single block radix TopK runs one block per row, which leaves most of the SMs idle when there are only a
+  // few long rows.
+  return N < 2 * prop.multiProcessorCount &&
+         dimension >= kRadixSelectMinDimensionPerByte * static_cast<int64_t>(sizeof(T));
+}
+
+template <typename CudaT>
+Status RadixSelectTopK(const CudaKernel* kernel, const CudaT* input_x, CudaT* output_v, int64_t* output_i,
+                       const TArray<int64_t>& elem_nums, size_t size, int32_t axis, int64_t K, int64_t largest,
+                       int64_t sorted, int64_t N, int64_t dimension) {
+  typedef typename RadixSelectKey<CudaT>::Bits Bits;
+  cudaStream_t stream = kernel->Stream();
+
+  // split the rows so that there are a few blocks for each SM
+  const int64_t target_blocks = 4 * static_cast<int64_t>(kernel->GetDeviceProp().multiProcessorCount);
+  const int64_t blocks_per_row = std::max<int64_t>(
+      1, std::min(CeilDiv(dimension, kRadixSelectMaxItemsPerBlock), CeilDiv(target_blocks, N)));
+  const int64_t items_per_block = CeilDiv(CeilDiv(dimension, blocks_per_row), static_cast<int64_t>(BT)) * BT;
+  const int64_t num_blocks = N * blocks_per_row;
+
+  auto states_buffer = kernel->GetScratchBuffer<RadixSelectState<Bits>>(N);
+  auto histograms_buffer = kernel->GetScratchBuffer<uint32_t>(N * kRadixSelectBins);
+  auto block_counts_buffer = kernel->GetScratchBuffer<uint64_t>(num_blocks);
+  auto keys_buffer = kernel->GetScratchBuffer<Bits>(N * K);
+  auto indices_buffer = kernel->GetScratchBuffer<int64_t>(N * K);
+  auto* states = states_buffer.get();
+  auto* histograms = histograms_buffer.get();
+  auto* keys = keys_buffer.get();
+  auto* indices = indices_buffer.get();
+
+  const int blocks_per_grid_N = static_cast<int>(CeilDiv(N, static_cast<int64_t>(BT)));
+  RadixSelectInit<Bits><<<blocks_per_grid_N, BT, 0, stream>>>(states, K, N);
+  CUDA_RETURN_IF_ERROR(cudaMemsetAsync(histograms, 0, N * kRadixSelectBins * sizeof(uint32_t), stream));
+  for (int shift = static_cast<int>(sizeof(Bits)) * 8 - kRadixSelectBits; shift >= 0; shift -= kRadixSelectBits) {
+    RadixSelectHistogram<CudaT><<<static_cast<unsigned int>(num_blocks), BT, 0, stream>>>(
+        input_x, elem_nums, size, axis, largest, dimension, blocks_per_row, items_per_block, shift, states,
+        histograms);
+    RadixSelectDigit<Bits><<<static_cast<unsigned int>(N), kRadixSelectBins, 0, stream>>>(shift, states, histograms);
+  }
+
+  RadixSelectCount<CudaT><<<static_cast<unsigned int>(num_blocks), BT, 0, stream>>>(
+      input_x, elem_nums, size, axis, largest, dimension, blocks_per_row, items_per_block, states,
+      block_counts_buffer.get());
+  RadixSelectGather<CudaT><<<static_cast<unsigned int>(num_blocks), BT, 0, stream>>>(
+      input_x, elem_nums, size, axis, K, largest, dimension, blocks_per_row, items_per_block, states,
+      block_counts_buffer.get(), keys, indices);
+
+  // The selected keys are in index order within the keys before the K-th key and within the ones equal to it, and
+  // the radix sort is stable, so equal values keep the lower index first.
+  IAllocatorUniquePtr<int64_t> sorted_indices_buffer;
+  if (1 == sorted) {
+    const int num_items = static_cast<int>(N * K);
+    auto sorted_keys_buffer = kernel->GetScratchBuffer<Bits>(N * K);
+    sorted_indices_buffer = kernel->GetScratchBuffer<int64_t>(N * K);
+    size_t temp_bytes = 0;
+    if (1 == N) {
+      CUDA_RETURN_IF_ERROR(cub::DeviceRadixSort::SortPairs(nullptr, temp_bytes, keys, sorted_keys_buffer.get(),
+                                                           indices, sorted_indices_buffer.get(), num_items,
+                                                           0, sizeof(Bits) * 8, stream));
+      auto temp_storage_buffer = kernel->GetScratchBuffer<char>(temp_bytes);
+      CUDA_RETURN_IF_ERROR(cub::DeviceRadixSort::SortPairs(temp_storage_buffer.get(), temp_bytes, keys,
+                                                           sorted_keys_buffer.get(), indices,
+                                                           sorted_indices_buffer.get(), num_items,
+                                                           0, sizeof(Bits) * 8, stream));
+    } else {
+      auto offsets_buffer = kernel->GetScratchBuffer<int>(N + 1);
+      auto* offsets = offsets_buffer.get();
+      RadixSelectSegmentOffsets<<<static_cast<int>(CeilDiv(N + 1, static_cast<int64_t>(BT))), BT, 0, stream>>>(
+          offsets, K, N);
+      CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairs(
+          nullptr, temp_bytes, keys, sorted_keys_buffer.get(), indices, sorted_indices_buffer.get(), num_items,
+          static_cast<int>(N), offsets, offsets + 1, 0, sizeof(Bits) * 8, stream));
+      auto temp_storage_buffer = kernel->GetScratchBuffer<char>(temp_bytes);
+      CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairs(
+          temp_storage_buffer.get(), temp_bytes, keys, sorted_keys_buffer.get(), indices,
+          sorted_indices_buffer.get(), num_items, static_cast<int>(N), offsets, offsets + 1, 0, sizeof(Bits) * 8,
+          stream));
+    }
+    indices = sorted_indices_buffer.get();
+  }
+
+  const int64_t count = N * K;
+  RadixSelectOutput<CudaT><<<static_cast<int>(CeilDiv(count, static_cast<int64_t>(BT))), BT, 0, stream>>>(
+      input_x, output_v, output_i, indices, elem_nums, size, axis, K, dimension, count);
+  return Status::OK();
+}
+
 template <typename T>
 Status TopKImpl(const CudaKernel* kernel, const T* input_x, T* output_v, int64_t* output_i, const TArray<int64_t>& elem_nums, size_t size, int32_t axis, int64_t K, int64_t largest, int64_t sorted, int64_t N, int64_t dimension) {
   typedef typename ToCudaType<T>::MappedType CudaT;
@@ -427,6 +799,8 @@ Status TopKImpl(const CudaKernel* kernel, const T* input_x, T* output_v, int64_t
   auto aligned_dimension = ALIGN(dimension);
   if (aligned_dimension <= GridDim::maxThreadsPerBlock) {
     BitonicTopK<CudaT><<<N, GridDim::maxThreadsPerBlock, aligned_dimension * sizeof(KV<CudaT>), stream>>>(input_x_ptr, output_v_ptr, output_i, elem_nums, size, axis, K, aligned_K, largest, sorted, dimension, aligned_dimension, NumericLimits<T>::Lowest(), NumericLimits<T>::Max());
+  } else if (UseRadixSelectTopK<CudaT>(kernel->GetDeviceProp(), K, sorted, N, dimension)) {
+    return RadixSelectTopK<CudaT>(kernel, input_x_ptr, output_v_ptr, output_i, elem_nums, size, axis, K, largest, sorted, N, dimension);
   } else if (K <= BT*16 || 0 == sorted) {
     auto XPT = static_cast<int64_t>(ceil(static_cast<double>(dimension) / GridDim::maxThreadsPerBlock));
     if (BT*2 >= K || 0 == sorted) {
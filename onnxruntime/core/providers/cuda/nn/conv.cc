@@ -4,6 +4,7 @@
 #include "core/providers/common.h"
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/nn/conv.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "core/providers/cuda/tensor/slice.h"
 
@@ -249,59 +250,76 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
     }
 
     if (!s_.cached_benchmark_results.contains(x_dims_cudnn)) {
-      // set math type to tensor core before algorithm search
-      if (std::is_same<T, MLFloat16>::value)
-        CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
-
-      cudnnConvolutionFwdAlgoPerf_t perf;
-      int algo_count = 1;
       const CUDAExecutionProvider* cuda_ep = static_cast<const CUDAExecutionProvider*>(this->Info().GetExecutionProvider());
       int cudnn_conv_algo = cuda_ep->GetCudnnConvAlgo();
       ORT_ENFORCE(cudnn_conv_algo > -1 && cudnn_conv_algo < 3, "cudnn_conv_algo should be 0, 1 or 2, but got ", cudnn_conv_algo);
-      switch (cudnn_conv_algo) {
-        case 0: {
-          static constexpr int num_algos = CUDNN_CONVOLUTION_FWD_ALGO_COUNT;
-          size_t max_ws_size = getMaxWorkspaceSize(s_, kAllAlgos, num_algos);
-          IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(max_ws_size);
-
-          CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionForwardAlgorithmEx(
-              s_.handle,
-              s_.x_tensor,
-              s_.x_data,
-              s_.w_desc,
-              s_.w_data,
-              s_.conv_desc,
-              s_.y_tensor,
-              s_.y_data,
-              1,            // requestedAlgoCount
-              &algo_count,  // returnedAlgoCount
-              &perf,
-              algo_search_workspace.get(),
-              max_ws_size));
-          break;
-        }
-        case 1:
-          CUDNN_RETURN_IF_ERROR(cudnnGetConvolutionForwardAlgorithm_v7(
-              s_.handle,
-              s_.x_tensor,
-              s_.w_desc,
-              s_.conv_desc,
-              s_.y_tensor,
-              1,            // requestedAlgoCount
-              &algo_count,  // returnedAlgoCount
-              &perf));
-          break;
-
-        default:
-          perf.algo = kDefaultConvAlgo;
-          CUDNN_RETURN_IF_ERROR(getWorkspaceSize(s_, perf.algo, &perf.memory));
-          if (std::is_same<T, MLFloat16>::value) {
-            perf.mathType = CUDNN_TENSOR_OP_MATH;
-          } else {
-            perf.mathType = CUDNN_DEFAULT_MATH;
+
+      // The algorithms found by a search are shared with the other kernels, sessions and processes.
+      std::string algo_cache_key;
+      CudnnConvAlgoCache::Entry cached_algo;
+      if (cudnn_conv_algo != 2) {
+        algo_cache_key = CudnnConvAlgoCache::MakeKey(cuda_ep->GetDeviceProp(), "fwd", cudnn_conv_algo,
+                                                     CudnnTensor::GetDataType<CudaT>(), x_dims_cudnn, w_dims,
+                                                     pads, strides, dilations, conv_attrs_.group);
+      }
+      if (!algo_cache_key.empty() && CudnnConvAlgoCache::Instance().Lookup(algo_cache_key, cached_algo)) {
+        s_.cached_benchmark_results.insert(x_dims_cudnn, {static_cast<cudnnConvolutionFwdAlgo_t>(cached_algo.algo),
+                                                          cached_algo.memory, cached_algo.math_type});
+      } else {
+        // set math type to tensor core before algorithm search
+        if (std::is_same<T, MLFloat16>::value)
+          CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
+
+        cudnnConvolutionFwdAlgoPerf_t perf;
+        int algo_count = 1;
+        switch (cudnn_conv_algo) {
+          case 0: {
+            static constexpr int num_algos = CUDNN_CONVOLUTION_FWD_ALGO_COUNT;
+            size_t max_ws_size = getMaxWorkspaceSize(s_, kAllAlgos, num_algos);
+            IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(max_ws_size);
+
+            CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionForwardAlgorithmEx(
+                s_.handle,
+                s_.x_tensor,
+                s_.x_data,
+                s_.w_desc,
+                s_.w_data,
+                s_.conv_desc,
+                s_.y_tensor,
+                s_.y_data,
+                1,            // requestedAlgoCount
+                &algo_count,  // returnedAlgoCount
+                &perf,
+                algo_search_workspace.get(),
+                max_ws_size));
+            break;
           }
+          case 1:
+            CUDNN_RETURN_IF_ERROR(cudnnGetConvolutionForwardAlgorithm_v7(
+                s_.handle,
+                s_.x_tensor,
+                s_.w_desc,
+                s_.conv_desc,
+                s_.y_tensor,
+                1,            // requestedAlgoCount
+                &algo_count,  // returnedAlgoCount
+                &perf));
+            break;
+
+          default:
+            perf.algo = kDefaultConvAlgo;
+            CUDNN_RETURN_IF_ERROR(getWorkspaceSize(s_, perf.algo, &perf.memory));
+            if (std::is_same<T, MLFloat16>::value) {
+              perf.mathType = CUDNN_TENSOR_OP_MATH;
+            } else {
+              perf.mathType = CUDNN_DEFAULT_MATH;
+            }
+        }
+        s_.cached_benchmark_results.insert(x_dims_cudnn, {perf.algo, perf.memory, perf.mathType});
+        if (!algo_cache_key.empty()) {
+          CudnnConvAlgoCache::Instance().Insert(algo_cache_key, {perf.algo, perf.memory, perf.mathType});
+        }
       }
-      s_.cached_benchmark_results.insert(x_dims_cudnn, {perf.algo, perf.memory, perf.mathType});
     }
     const auto& perf = s_.cached_benchmark_results.at(x_dims_cudnn);
     CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, perf.mathType));
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/nn/conv_algo_cache.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace onnxruntime {
+namespace cuda {
+
+namespace {
+void AppendDims(std::ostringstream& key, const char* name, const std::vector<int64_t>& dims) {
+  key << ' ' << name << '=';
+  for (size_t i = 0; i < dims.size(); ++i) {
+    key << (i == 0 ? "" : ",") << dims[i];
+  }
+}
+}  // namespace
+
+CudnnConvAlgoCache& CudnnConvAlgoCache::Instance() {
+  static CudnnConvAlgoCache instance;
+  return instance;
+}
+
+std::string CudnnConvAlgoCache::MakeKey(const cudaDeviceProp& device_prop, const char* kind, int algo_search,
+                                        cudnnDataType_t data_type,
+                                        const std::vector<int64_t>& x_dims, const std::vector<int64_t>& w_dims,
+                                        const std::vector<int64_t>& pads, const std::vector<int64_t>& strides,
+                                        const std::vector<int64_t>& dilations, int64_t group) {
+  std::ostringstream key;
+  key << "GPU-" << std::hex << std::setfill('0');
+  for (char byte : device_prop.uuid.bytes) {
+    key << std::setw(2) << static_cast<int>(static_cast<unsigned char>(byte));
+  }
+  key << std::dec << " cudnn=" << cudnnGetVersion() << ' ' << kind << " search=" << algo_search
+      << " type=" << static_cast<int>(data_type);
+  AppendDims(key, "x", x_dims);
+  AppendDims(key, "w", w_dims);
+  AppendDims(key, "pads", pads);
+  AppendDims(key, "strides", strides);
+  AppendDims(key, "dilations", dilations);
+  key << " group=" << group;
+  return key.str();
+}
+
+// Each line of a cache file holds one entry: the key, a tab, then the algorithm, workspace size and math type.
+void CudnnConvAlgoCache::RegisterFile(const std::string& path) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!files_.insert(path).second) {
+    return;
+  }
+
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto tab = line.find('\t');
+    std::istringstream value(tab == std::string::npos ? std::string{} : line.substr(tab + 1));
+    int algo = 0;
+    size_t memory = 0;
+    int math_type = 0;
+    if (!(value >> algo >> memory >> math_type)) {
+      LOGS_DEFAULT(WARNING) << "Ignoring a malformed line of the cuDNN convolution algorithm cache " << path;
+      continue;
+    }
+    entries_[line.substr(0, tab)] = Entry{algo, memory, static_cast<cudnnMathType_t>(math_type)};
+  }
+}
+
+bool CudnnConvAlgoCache::Lookup(const std::string& key, Entry& entry) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  entry = it->second;
+  return true;
+}
+
+void CudnnConvAlgoCache::Insert(const std::string& key, const Entry& entry) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!entries_.emplace(key, entry).second) {
+    return;
+  }
+
+  for (const auto& path : files_) {
+    std::ofstream file(path, std::ios::app);
+    file << key << '\t' << entry.algo << ' ' << entry.memory << ' ' << static_cast<int>(entry.math_type) << '\n';
+    if (!file) {
+      LOGS_DEFAULT(WARNING) << "Failed to append to the cuDNN convolution algorithm cache " << path;
+    }
+  }
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
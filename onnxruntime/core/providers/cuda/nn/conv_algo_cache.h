@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Process-wide cache of the cuDNN convolution algorithms picked by the algorithm search, shared by the Conv and
+// ConvTranspose kernels of all sessions. The per kernel caches in CudnnConvState are consulted first, this one
+// only saves the search when a kernel sees a convolution for the first time.
+// The entries are keyed by the device (its UUID and the cuDNN version) and the full convolution, so a cache file
+// can be shared between the machines of a fleet: the entries of other GPUs or cuDNN versions are never used.
+// When a file is registered, the entries found in it are loaded and each new entry is appended to it, so the
+// exhaustive search of a convolution is paid once and not by every process that runs the model.
+class CudnnConvAlgoCache {
+ public:
+  struct Entry {
+    int algo;
+    size_t memory;
+    cudnnMathType_t math_type;
+  };
+
+  static CudnnConvAlgoCache& Instance();
+
+  // Builds the key of a convolution. `kind` distinguishes the cuDNN searches, e.g. "fwd" and "bwd_data", and
+  // `algo_search` is the cudnn_conv_algo_search of the execution provider, as the heuristic may pick another
+  // algorithm than the exhaustive search.
+  static std::string MakeKey(const cudaDeviceProp& device_prop, const char* kind, int algo_search,
+                             cudnnDataType_t data_type,
+                             const std::vector<int64_t>& x_dims, const std::vector<int64_t>& w_dims,
+                             const std::vector<int64_t>& pads, const std::vector<int64_t>& strides,
+                             const std::vector<int64_t>& dilations, int64_t group);
+
+  // Loads the entries of the file, if it exists, and appends the entries added from now on to it.
+  // Registering the same file again has no effect.
+  void RegisterFile(const std::string& path);
+
+  bool Lookup(const std::string& key, Entry& entry) const;
+  void Insert(const std::string& key, const Entry& entry);
+
+ private:
+  CudnnConvAlgoCache() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudnnConvAlgoCache);
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::unordered_set<std::string> files_;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "conv_transpose.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -126,29 +127,40 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
       y_data = reinterpret_cast<CudaT*>(p.Y->template MutableData<T>());
 
       if (!s_.cached_benchmark_results.contains(x_dims)) {
-        IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
-
-        // set math type to tensor core before algorithm search
-        if (std::is_same<T, MLFloat16>::value)
-          CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
-
-        cudnnConvolutionBwdDataAlgoPerf_t perf;
-        int algo_count = 1;
-        CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
-            CudnnHandle(),
-            s_.w_desc,
-            w_data,
-            s_.x_tensor,
-            x_data,
-            s_.conv_desc,
-            s_.y_tensor,
-            y_data,
-            1,
-            &algo_count,
-            &perf,
-            algo_search_workspace.get(),
-            AlgoSearchWorkspaceSize));
-        s_.cached_benchmark_results.insert(x_dims, {perf.algo, perf.memory, perf.mathType});
+        // The algorithms found by the search are shared with the other kernels, sessions and processes.
+        const std::string algo_cache_key = CudnnConvAlgoCache::MakeKey(
+            GetDeviceProp(), "bwd_data", OrtCudnnConvAlgoSearch::EXHAUSTIVE, CudnnTensor::GetDataType<CudaT>(),
+            x_dims, w_dims, p.pads, p.strides, p.dilations, conv_transpose_attrs_.group);
+        CudnnConvAlgoCache::Entry cached_algo;
+        if (CudnnConvAlgoCache::Instance().Lookup(algo_cache_key, cached_algo)) {
+          s_.cached_benchmark_results.insert(x_dims, {static_cast<cudnnConvolutionBwdDataAlgo_t>(cached_algo.algo),
+                                                      cached_algo.memory, cached_algo.math_type});
+        } else {
+          IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
+
+          // set math type to tensor core before algorithm search
+          if (std::is_same<T, MLFloat16>::value)
+            CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
+
+          cudnnConvolutionBwdDataAlgoPerf_t perf;
+          int algo_count = 1;
+          CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
+              CudnnHandle(),
+              s_.w_desc,
+              w_data,
+              s_.x_tensor,
+              x_data,
+              s_.conv_desc,
+              s_.y_tensor,
+              y_data,
+              1,
+              &algo_count,
+              &perf,
+              algo_search_workspace.get(),
+              AlgoSearchWorkspaceSize));
+          s_.cached_benchmark_results.insert(x_dims, {perf.algo, perf.memory, perf.mathType});
+          CudnnConvAlgoCache::Instance().Insert(algo_cache_key, {perf.algo, perf.memory, perf.mathType});
+        }
       }
 
       const auto& perf = s_.cached_benchmark_results.at(x_dims);
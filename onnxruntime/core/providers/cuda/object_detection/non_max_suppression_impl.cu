@@ -14,21 +14,16 @@ limitations under the License.
 ==============================================================================*/
 /* Modifications Copyright (c) Microsoft. */
 
-#include <thrust/device_vector.h>
-#include <thrust/execution_policy.h>
+#include <algorithm>
+#include <limits>
 
 #include "non_max_suppression_impl.h"
 #include "core/providers/cpu/object_detection/non_max_suppression_helper.h"
 #include "core/providers/cuda/cu_inc/common.cuh"
 #include "core/providers/cuda/cuda_common.h"
 
-#include "core/framework/tensor.h"
-
 #include <cub/cub.cuh>
-//TODO:fix the warnings
-#ifdef _MSC_VER
-#pragma warning(disable : 4244)
-#endif
+
 namespace onnxruntime {
 namespace cuda {
 
@@ -36,290 +31,145 @@ using namespace nms_helpers;
 
 namespace {
 
-struct __align__(16) Box {
-  float x1, y1, x2, y2;
-};
-
-// This is the width of the bitmask for masking boxes for each thread.
-// This needs to be a multiple of 2(a POD width usually) so that division and
-// modulo can be implemented as bit operations during host selection.
-constexpr int kNmsBoxesPerThread = 8 * sizeof(int);
-// Helper to calculate modulo mask and shift bits.
-// For kNmsBoxesPerThread=32 ModuloMask will be 31, i.e 0x1F thus
-// i % 32 == i & 31. Similarly ShiftBits will be 5 so that
-// i / 32 == i >> 5. Using these bit operations should reduce the stall on host
-// thread.
-__device__ constexpr int NumBits(int n) { return (n == 0) ? 0 : NumBits(n >> 1) + 1; }
-
-constexpr int kNmsBlockDim = 16;
-constexpr int kNmsBlockDimMax = 128;
-
-// Check whether two boxes have an IoU greater than threshold.
-template <typename T>
-__device__ inline bool OverThreshold(const Box* a, const Box* b,
-                                     const float a_area,
-                                     const T iou_threshold) {
-  const float b_area = (b->x2 - b->x1) * (b->y2 - b->y1);
-  if (a_area == 0.0f || b_area == 0.0f) return false;
-  const float xx1 = fmaxf(a->x1, b->x1);
-  const float yy1 = fmaxf(a->y1, b->y1);
-  const float xx2 = fminf(a->x2, b->x2);
-  const float yy2 = fminf(a->y2, b->y2);
-
-  // fdimf computes the positive difference between xx2+1 and xx1.
-  const float w = fdimf(xx2, xx1);
-  const float h = fdimf(yy2, yy1);
-  const float intersection = w * h;
-
-  // Testing for aa/bb > t
-  // eq with aa > bb*t (b is !=0)
-  // avoiding divisions.
-  const float aa = intersection;
-  const float bb = a_area + b_area - intersection;
-  const float bt = bb * iou_threshold;
-  return aa >= bt;
-}
-
-template <typename T>
-__device__ inline bool CheckBit(T* bit_mask, int bit) {
-  constexpr int kShiftLen = NumBits(8 * sizeof(T)) - 1;
-  constexpr int kRemainderMask = 8 * sizeof(T) - 1;
-  int bin = bit >> kShiftLen;
-  return (bit_mask[bin] >> (bit & kRemainderMask)) & 1;
-}
-
-// Produce a global bitmask (result_mask) of selected boxes from bitmask
-// generated by NMSKernel Abort early if max_boxes boxes are selected. Bitmask
-// is num_boxes*bit_mask_len bits indicating whether to keep or remove a box.
-__global__ void NMSReduce(const int* bitmask, const int bit_mask_len,
-                          const int num_boxes, const int max_boxes,
-                          char* result_mask) {
-  extern __shared__ int local[];
-
-  // set global mask to accept all boxes
-  for (int box = blockIdx.x * blockDim.x + threadIdx.x; box < bit_mask_len; box += blockDim.x * gridDim.x) {
-    local[box] = 0xFFFFFFFF;
-  }
-  __syncthreads();
-  int accepted_boxes = 0;
-  for (int box = 0; box < num_boxes - 1; ++box) {
-    // if current box is masked by an earlier box, skip it.
-    if (!CheckBit(local, box)) {
-      continue;
+// The (batch, class) pairs are processed together as segments of num_boxes boxes. The boxes of a segment are sorted
+// by score, and row i of its IoU matrix is a bitmask of 64-bit words, with bit j set when box i suppresses box j.
+constexpr int kNmsBoxesPerWord = 64;
+constexpr int kNmsReduceThreadsPerBlock = 256;
+// Upper bound of the IoU bitmasks held at a time. Segments are processed in chunks that fit in it, and in the
+// z dimension of the grid.
+constexpr size_t kNmsMaskBudgetBytes = 256 * 1024 * 1024;
+constexpr int kNmsMaxSegmentsPerChunk = 65535;
+
+__global__ void InitializeSortKernel(const int num_items, const int num_boxes, const int num_segments,
+                                     int* indices, int* segment_offsets) {
+  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx <= num_items; idx += blockDim.x * gridDim.x) {
+    if (idx < num_items) {
+      indices[idx] = idx % num_boxes;
     }
-    accepted_boxes += 1;
-    int offset = box * bit_mask_len;
-    // update global mask with current box's mask
-    for (int b = blockIdx.x * blockDim.x + threadIdx.x; b < bit_mask_len; b += blockDim.x * gridDim.x) {
-      local[b] &= ~bitmask[offset + b];
+    if (idx <= num_segments) {
+      segment_offsets[idx] = idx * num_boxes;
     }
-    __syncthreads();
-    if (accepted_boxes > max_boxes) break;
-  }
-  // copy global mask to result_max char array. char array is needed for
-  // cub::DeviceSelect later.
-  for (int box = blockIdx.x * blockDim.x + threadIdx.x; box < num_boxes; box += blockDim.x * gridDim.x) {
-    result_mask[box] = CheckBit(local, box);
   }
 }
 
-// For each box, compute a bitmask of boxes which has an overlap with given box
-// above threshold.
-//
-// Starting from highes scoring box, mark any box which has IoU>threshold with
-// given box. Each thread processes a kNmsBoxesPerThread boxes per stride, and
-// each box has bitmask of overlaps of length bit_mask_len.
-//
-__launch_bounds__(kNmsBlockDim* kNmsBlockDim, 4) __global__
-    void NMSKernel(
-        const int64_t center_point_box,
-        const Box* d_desc_sorted_boxes,
-        const int num_boxes,
-        const float iou_threshold,
-        const int bit_mask_len,
-        int* d_delete_mask) {
-  for (int i_block_offset = blockIdx.x * blockDim.x; i_block_offset < num_boxes;
-       i_block_offset += blockDim.x * gridDim.x) {
-    const int i = i_block_offset + threadIdx.x;
-    if (i < num_boxes) {
-      for (int j_thread_offset =
-               kNmsBoxesPerThread * (blockIdx.y * blockDim.y + threadIdx.y);
-           j_thread_offset < num_boxes;
-           j_thread_offset += kNmsBoxesPerThread * blockDim.y * gridDim.y) {
-        // Note : We can do everything using multiplication,
-        // and use fp16 - we are comparing against a low precision
-        // threshold.
-        int above_threshold = 0;
-        // Make sure that threads are within valid domain.
-        bool valid = false;
-        // Loop over the next kNmsBoxesPerThread boxes and set corresponding bit
-        // if it is overlapping with current box
-        for (int ib = 0; ib < kNmsBoxesPerThread; ++ib) {
-          // This thread will compare Box i and Box j.
-          const int j = j_thread_offset + ib;
-          if (i >= j || i >= num_boxes || j >= num_boxes) continue;
-          valid = true;
-          if (SuppressByIOU(reinterpret_cast<const float*>(d_desc_sorted_boxes),
-                            i, j, center_point_box, iou_threshold)) {
-            // we have score[j] <= score[i].
-            above_threshold |= (1U << ib);
-          }
-        }
-        if (valid) {
-          d_delete_mask[i * bit_mask_len + j_thread_offset / kNmsBoxesPerThread] =
-              above_threshold;
-        }
+// One thread per segment. Scores are sorted in descending order, so the boxes above the threshold are a prefix.
+__global__ void CountCandidatesKernel(const float* sorted_scores, const int num_boxes, const int num_segments,
+                                      const bool use_score_threshold, const float score_threshold,
+                                      int* candidate_counts) {
+  const int segment = blockIdx.x * blockDim.x + threadIdx.x;
+  if (segment >= num_segments) {
+    return;
+  }
+
+  int count = num_boxes;
+  if (use_score_threshold) {
+    const float* scores = sorted_scores + static_cast<int64_t>(segment) * num_boxes;
+    int low = 0;
+    while (low < count) {
+      const int mid = (low + count) / 2;
+      if (scores[mid] > score_threshold) {
+        low = mid + 1;
+      } else {
+        count = mid;
       }
     }
   }
-}
-// Variadic template helpers for Index selecting multiple arrays at the same
-// time
-template <typename Index>
-__device__ inline void SelectHelper(const Index i_selected,
-                                    const Index i_original) {}
-
-template <typename Index, typename T, typename... Args>
-__device__ inline void SelectHelper(const Index i_selected,
-                                    const Index i_original,
-                                    const T* original, T* selected,
-                                    Args... args) {
-  selected[i_selected] = original[i_original];
-  SelectHelper(i_selected, i_original, args...);
+  candidate_counts[segment] = count;
 }
 
-// Helper template to select elements from original arrays using the index
-// mapping and store into selected array. Each array sharing same mapping need
-// to be passed as pairs of pointers to original and selected arrays. For
-// selecting 2 arrays call would be
-// IndexMultiSelect(num_elements, indices, original1 ,selected1, original2,
-// selected2).
-template <typename Index, typename T, typename... Args>
-__global__ void IndexMultiSelect(const int num_elements, const Index* indices,
-                                 const T* original, T* selected, Args... args) {
-  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
-    SelectHelper(idx, indices[idx], original, selected, args...);
+// Grid (words, words, segments of the chunk), one thread per row of a 64 x 64 tile of the IoU matrix.
+// Only the tiles on and above the diagonal are computed: a box is only suppressed by the boxes of higher score.
+__global__ void NmsMaskKernel(const float* boxes, const int* sorted_indices, const int* candidate_counts,
+                              const int num_boxes, const int num_classes, const int64_t center_point_box,
+                              const float iou_threshold, const int segment_begin, uint64_t* masks) {
+  const int segment = segment_begin + blockIdx.z;
+  const int count = candidate_counts[segment];
+  const int row_begin = blockIdx.y * kNmsBoxesPerWord;
+  const int col_begin = blockIdx.x * kNmsBoxesPerWord;
+  if (blockIdx.x < blockIdx.y || row_begin >= count || col_begin >= count) {
+    return;
   }
-}
 
-template <typename T>
-__global__ void SetZero(const int count, T* __restrict__ ptr) {
-  // Check that the grid is one dimensional and index doesn't overflow.
-  assert(blockDim.y == 1);
-  assert(blockDim.z == 1);
-  assert(blockDim.x * gridDim.x / blockDim.x == gridDim.x);
-  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < count; i += blockDim.x * gridDim.x) {
-    ptr[i] = T(0);
+  const int words = CeilDiv(num_boxes, kNmsBoxesPerWord);
+  const float* batch_boxes = boxes + static_cast<int64_t>(segment / num_classes) * num_boxes * 4;
+  const int* indices = sorted_indices + static_cast<int64_t>(segment) * num_boxes;
+  const int col_count = min(count - col_begin, kNmsBoxesPerWord);
+
+  __shared__ int col_indices[kNmsBoxesPerWord];
+  if (threadIdx.x < col_count) {
+    col_indices[threadIdx.x] = indices[col_begin + threadIdx.x];
   }
-}
+  __syncthreads();
 
-template <typename T>
-__global__ void Iota(const int num_elements, const T offset, T* to_fill) {
-  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
-    to_fill[idx] = static_cast<T>(idx) + offset;
+  const int row = row_begin + threadIdx.x;
+  if (row < count) {
+    const int row_index = indices[row];
+    uint64_t bits = 0;
+    for (int j = 0; j < col_count; ++j) {
+      if (col_begin + j > row &&
+          SuppressByIOU(batch_boxes, row_index, col_indices[j], center_point_box, iou_threshold)) {
+        bits |= 1ULL << j;
+      }
+    }
+    masks[(static_cast<int64_t>(blockIdx.z) * num_boxes + row) * words + blockIdx.x] = bits;
   }
 }
 
-__global__ void NormalizeOutput(const int num_elements, const int* original, int64_t* to_normalize, int64_t batch_index, int64_t class_index) {
-  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
-    to_normalize[idx * 3] = batch_index;
-    to_normalize[idx * 3 + 1] = class_index;
-    to_normalize[idx * 3 + 2] = static_cast<int64_t>(original[idx]);
+// One block per segment of the chunk. The boxes are visited in score order, and the rows of the kept ones are
+// merged into the bitmask of removed boxes, until max_output_boxes_per_class boxes are kept.
+__global__ void NmsReduceKernel(const uint64_t* masks, const int* sorted_indices, const int* candidate_counts,
+                                const int num_boxes, const int max_output_boxes_per_class, const int segment_begin,
+                                int* selected_indices, int* selected_counts) {
+  extern __shared__ uint64_t removed[];
+
+  const int segment = segment_begin + blockIdx.x;
+  const int count = candidate_counts[segment];
+  const int words = CeilDiv(num_boxes, kNmsBoxesPerWord);
+  const int count_words = CeilDiv(count, kNmsBoxesPerWord);
+  for (int w = threadIdx.x; w < count_words; w += blockDim.x) {
+    removed[w] = 0;
   }
-}
+  __syncthreads();
 
-Status NmsGpu(cudaStream_t stream,
-              std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
-              const int64_t center_point_box,
-              const float* d_sorted_boxes_float_ptr,
-              const int num_boxes,
-              const float iou_threshold,
-              int* d_selected_indices,
-              int* h_nkeep,
-              const int max_boxes) {
-  // Making sure we respect the __align(16)__
-  // we promised to the compiler.
-  auto iptr = reinterpret_cast<std::uintptr_t>(d_sorted_boxes_float_ptr);
-  ORT_ENFORCE((iptr & 15) == 0);
-
-  const int bit_mask_len =
-      (num_boxes + kNmsBoxesPerThread - 1) / kNmsBoxesPerThread;
-  int max_nms_mask_size = num_boxes * bit_mask_len;
-
-  IAllocatorUniquePtr<void> d_nms_mask_ptr{allocator(max_nms_mask_size * sizeof(int))};
-  auto* d_nms_mask = static_cast<int*>(d_nms_mask_ptr.get());
-
-  int blocksPerGrid = (int)(ceil(static_cast<float>(max_nms_mask_size) / GridDim::maxThreadsPerBlock));
-  SetZero<int><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(max_nms_mask_size, d_nms_mask);
-
-  int* d_delete_mask = d_nms_mask;
-  int* h_selected_count = h_nkeep;
-  const Box* d_sorted_boxes =
-      reinterpret_cast<const Box*>(d_sorted_boxes_float_ptr);
-  dim3 block_dim, thread_block;
-  int num_blocks = (num_boxes + kNmsBlockDim - 1) / kNmsBlockDim;
-  num_blocks = std::max(std::min(num_blocks, kNmsBlockDimMax), 1);
-  block_dim.x = num_blocks;
-  block_dim.y = num_blocks;
-  block_dim.z = 1;
-  thread_block.x = kNmsBlockDim;
-  thread_block.y = kNmsBlockDim;
-  thread_block.z = 1;
-  NMSKernel<<<block_dim, thread_block, 0, stream>>>(center_point_box,
-                                         d_sorted_boxes,
-                                         num_boxes,
-                                         iou_threshold,
-                                         bit_mask_len,
-                                         d_delete_mask);
-
-  IAllocatorUniquePtr<void> d_selected_boxes_ptr{allocator(num_boxes * sizeof(char))};
-  auto* d_selected_boxes = static_cast<char*>(d_selected_boxes_ptr.get());
-  IAllocatorUniquePtr<void> d_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_indices = static_cast<int*>(d_indices_ptr.get());
+  const uint64_t* segment_masks = masks + static_cast<int64_t>(blockIdx.x) * num_boxes * words;
+  const int* indices = sorted_indices + static_cast<int64_t>(segment) * num_boxes;
+  int* selected = selected_indices + static_cast<int64_t>(segment) * max_output_boxes_per_class;
+  int num_selected = 0;
+  for (int i = 0; i < count && num_selected < max_output_boxes_per_class; ++i) {
+    // Every thread takes the same branch. Row i has no bit for box i, so the updates below don't change this test.
+    if ((removed[i / kNmsBoxesPerWord] >> (i % kNmsBoxesPerWord)) & 1) {
+      continue;
+    }
+    if (threadIdx.x == 0) {
+      selected[num_selected] = indices[i];
+    }
+    ++num_selected;
 
-  blocksPerGrid = (int)(ceil(static_cast<float>(num_boxes) / GridDim::maxThreadsPerBlock));
-  Iota<int><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_boxes, 0, d_indices);
-
-  NMSReduce<<<1, 1024, bit_mask_len * sizeof(int), stream>>>(d_delete_mask, bit_mask_len, num_boxes, max_boxes, d_selected_boxes);
-
-  size_t flagged_buffer_size = 0;
-  CUDA_RETURN_IF_ERROR(cub::DeviceSelect::Flagged(static_cast<void*>(nullptr),  // temp_storage
-                                                  flagged_buffer_size,
-                                                  static_cast<int*>(nullptr),   // input
-                                                  static_cast<char*>(nullptr),  // selection flag
-                                                  static_cast<int*>(nullptr),   // selected items
-                                                  static_cast<int*>(nullptr),   // num_selected
-                                                  num_boxes,
-                                                  stream));
-
-  IAllocatorUniquePtr<void> d_cub_scratch_buffer_ptr{allocator(flagged_buffer_size)};
-  auto* d_cub_scratch_buffer = static_cast<uint8_t*>(d_cub_scratch_buffer_ptr.get());
-  IAllocatorUniquePtr<void> d_num_selected_ptr{allocator(sizeof(int))};
-  auto* d_num_selected = static_cast<int*>(d_num_selected_ptr.get());
-
-  CUDA_RETURN_IF_ERROR(cub::DeviceSelect::Flagged(
-      d_cub_scratch_buffer,  // temp_storage
-      flagged_buffer_size,
-      d_indices,           // input
-      d_selected_boxes,    // selection flag
-      d_selected_indices,  // selected items
-      d_num_selected, num_boxes, stream));
-  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(h_selected_count, d_num_selected, sizeof(int), cudaMemcpyDeviceToHost, stream));
-  // cudaStreamSynchronize is needed since the value of h_selected_count will be used by host after this function.
-  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+    const uint64_t* row = segment_masks + static_cast<int64_t>(i) * words;
+    for (int w = i / kNmsBoxesPerWord + threadIdx.x; w < count_words; w += blockDim.x) {
+      removed[w] |= row[w];
+    }
+    __syncthreads();
+  }
 
-  return Status::OK();
+  if (threadIdx.x == 0) {
+    selected_counts[segment] = num_selected;
+  }
 }
 
-struct DeviceGreaterThan {
-  float threshold_;
-  __host__ __device__ __forceinline__ DeviceGreaterThan(float threshold)
-      : threshold_(threshold) {}
-
-  __host__ __device__ __forceinline__ bool operator()(const float& val) const {
-    return (val > threshold_);
+// One block per segment, writing its selected boxes at its offset in the output.
+__global__ void WriteOutputKernel(const int* selected_indices, const int* selected_counts, const int* output_offsets,
+                                  const int num_classes, const int max_output_boxes_per_class, int64_t* output) {
+  const int segment = blockIdx.x;
+  const int count = selected_counts[segment];
+  const int* selected = selected_indices + static_cast<int64_t>(segment) * max_output_boxes_per_class;
+  int64_t* segment_output = output + static_cast<int64_t>(output_offsets[segment]) * 3;
+  for (int k = threadIdx.x; k < count; k += blockDim.x) {
+    segment_output[k * 3] = segment / num_classes;
+    segment_output[k * 3 + 1] = segment % num_classes;
+    segment_output[k * 3 + 2] = selected[k];
   }
-};
+}
 
 }  // namespace
 
@@ -328,114 +178,119 @@ Status NonMaxSuppressionImpl(
     std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
     const PrepareContext& pc,
     const int64_t center_point_box,
-    int64_t batch_index,
-    int64_t class_index,
     int max_output_boxes_per_class,
     float iou_threshold,
     float score_threshold,
-    IAllocatorUniquePtr<void>& selected_indices,
-    int* h_number_selected) {
-  // STEP 1. Prepare data
-  int num_boxes = pc.num_boxes_;
-  const float* boxes_data = pc.boxes_data_ + batch_index * num_boxes * 4;
-  const float* scores_data = pc.scores_data_ + (batch_index * pc.num_classes_ + class_index) * num_boxes;
+    int* h_number_selected,
+    std::function<int64_t*(int)> output_allocator) {
+  const int num_boxes = pc.num_boxes_;
+  const int64_t num_items_64 = pc.num_batches_ * pc.num_classes_ * num_boxes;
+  ORT_RETURN_IF(num_items_64 > std::numeric_limits<int>::max(),
+                "NonMaxSuppression: the number of scores exceeds the int range supported on CUDA.");
+  const int num_segments = static_cast<int>(pc.num_batches_ * pc.num_classes_);
+  const int num_items = static_cast<int>(num_items_64);
+  if (num_items == 0) {
+    *h_number_selected = 0;
+    output_allocator(0);
+    return Status::OK();
+  }
+  const int words = CeilDiv(num_boxes, kNmsBoxesPerWord);
+  const size_t removed_bytes = static_cast<size_t>(words) * sizeof(uint64_t);
+  ORT_RETURN_IF(removed_bytes > 48 * 1024, "NonMaxSuppression: too many boxes for the CUDA kernel: ", num_boxes);
+  max_output_boxes_per_class = std::min(max_output_boxes_per_class, num_boxes);
 
-  // prepare temporary memory for sorting scores
+  // STEP 1. sort the scores of every (batch, class) pair
+  IAllocatorUniquePtr<void> d_indices_ptr{allocator(num_items * sizeof(int))};
+  auto* d_indices = static_cast<int*>(d_indices_ptr.get());
+  IAllocatorUniquePtr<void> d_sorted_indices_ptr{allocator(num_items * sizeof(int))};
+  auto* d_sorted_indices = static_cast<int*>(d_sorted_indices_ptr.get());
+  IAllocatorUniquePtr<void> d_sorted_scores_ptr{allocator(num_items * sizeof(float))};
+  auto* d_sorted_scores = static_cast<float*>(d_sorted_scores_ptr.get());
+  IAllocatorUniquePtr<void> d_segment_offsets_ptr{allocator((num_segments + 1) * sizeof(int))};
+  auto* d_segment_offsets = static_cast<int*>(d_segment_offsets_ptr.get());
+
+  int blocksPerGrid = static_cast<int>(CeilDiv(num_items + 1, GridDim::maxThreadsPerBlock));
+  InitializeSortKernel<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      num_items, num_boxes, num_segments, d_indices, d_segment_offsets);
 
-  // calculate temporary size that used for sorting
   size_t cub_sort_temp_storage_bytes = 0;
-  CUDA_RETURN_IF_ERROR(cub::DeviceRadixSort::SortPairsDescending(
+  CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairsDescending(
       nullptr, cub_sort_temp_storage_bytes,
       static_cast<float*>(nullptr),  // scores
       static_cast<float*>(nullptr),  // sorted scores
       static_cast<int*>(nullptr),    // input indices
       static_cast<int*>(nullptr),    // sorted indices
-      num_boxes,                     // num items
-      0, 8 * sizeof(float),           // sort all bits
+      num_items, num_segments,
+      static_cast<int*>(nullptr), static_cast<int*>(nullptr),  // segment begin and end offsets
+      0, 8 * sizeof(float),                                    // sort all bits
       stream));
-
-  // allocate temporary memory
   IAllocatorUniquePtr<void> d_cub_sort_buffer_ptr{allocator(cub_sort_temp_storage_bytes)};
-  auto* d_cub_sort_buffer = static_cast<uint8_t*>(d_cub_sort_buffer_ptr.get());
-  IAllocatorUniquePtr<void> d_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_indices = static_cast<int*>(d_indices_ptr.get());
-  IAllocatorUniquePtr<void> d_sorted_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_sorted_indices = static_cast<int*>(d_sorted_indices_ptr.get());
-  IAllocatorUniquePtr<void> d_selected_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_selected_indices = static_cast<int*>(d_selected_indices_ptr.get());
-  IAllocatorUniquePtr<void> d_sorted_scores_ptr{allocator(num_boxes * sizeof(float))};
-  auto* d_sorted_scores = static_cast<float*>(d_sorted_scores_ptr.get());
-  IAllocatorUniquePtr<void> d_sorted_boxes_ptr{allocator(num_boxes * 4 * sizeof(float))};
-  auto* d_sorted_boxes = static_cast<float*>(d_sorted_boxes_ptr.get());
-
-  // create sequense of indices
-  int blocksPerGrid = (int)(ceil(static_cast<float>(num_boxes) / GridDim::maxThreadsPerBlock));
-  Iota<int><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_boxes, 0, d_indices);
-  CUDA_RETURN_IF_ERROR(cudaGetLastError());
-
-  // sort scores
-  CUDA_RETURN_IF_ERROR(cub::DeviceRadixSort::SortPairsDescending(
-      d_cub_sort_buffer,
-      cub_sort_temp_storage_bytes,
-      scores_data,
-      d_sorted_scores,
-      d_indices,
-      d_sorted_indices,
-      num_boxes,
-      0,
-      8 * sizeof(float),  // sort all bits
+  CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairsDescending(
+      d_cub_sort_buffer_ptr.get(), cub_sort_temp_storage_bytes,
+      pc.scores_data_, d_sorted_scores,
+      d_indices, d_sorted_indices,
+      num_items, num_segments,
+      d_segment_offsets, d_segment_offsets + 1,
+      0, 8 * sizeof(float),
       stream));
 
-  // pick sorted scores
-  const Box* original_boxes = reinterpret_cast<const Box*>(boxes_data);
-  Box* sorted_boxes = reinterpret_cast<Box*>(d_sorted_boxes);
-  IndexMultiSelect<int, Box><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_boxes, d_sorted_indices, original_boxes, sorted_boxes);
-  CUDA_RETURN_IF_ERROR(cudaGetLastError());
+  // STEP 2. count the boxes above the score threshold
+  IAllocatorUniquePtr<void> d_candidate_counts_ptr{allocator(num_segments * sizeof(int))};
+  auto* d_candidate_counts = static_cast<int*>(d_candidate_counts_ptr.get());
+  blocksPerGrid = static_cast<int>(CeilDiv(num_segments, GridDim::maxThreadsPerBlock));
+  CountCandidatesKernel<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      d_sorted_scores, num_boxes, num_segments, pc.score_threshold_ != nullptr, score_threshold, d_candidate_counts);
 
-  // STEP 2. filter boxes by scores
-  int limited_num_boxes = num_boxes;
-  if (pc.score_threshold_ != nullptr) {
-    thrust::device_ptr<float> sorted_scores_device_ptr(d_sorted_scores);
-    limited_num_boxes = thrust::count_if(
-        thrust::cuda::par.on(stream),
-        sorted_scores_device_ptr,
-        sorted_scores_device_ptr + num_boxes,
-        DeviceGreaterThan(score_threshold));
-    CUDA_RETURN_IF_ERROR(cudaGetLastError());
-
-    if (limited_num_boxes == 0) {
-      *h_number_selected = 0;
-      return Status::OK();
-    }
+  // STEP 3. compute the IoU bitmasks and select the boxes, a chunk of segments at a time
+  IAllocatorUniquePtr<void> d_selected_indices_ptr{
+      allocator(static_cast<size_t>(num_segments) * max_output_boxes_per_class * sizeof(int))};
+  auto* d_selected_indices = static_cast<int*>(d_selected_indices_ptr.get());
+  IAllocatorUniquePtr<void> d_selected_counts_ptr{allocator(num_segments * sizeof(int))};
+  auto* d_selected_counts = static_cast<int*>(d_selected_counts_ptr.get());
+
+  const size_t segment_mask_bytes = static_cast<size_t>(num_boxes) * words * sizeof(uint64_t);
+  const int chunk_size = static_cast<int>(
+      std::max<size_t>(1, std::min<size_t>({static_cast<size_t>(num_segments),
+                                            static_cast<size_t>(kNmsMaxSegmentsPerChunk),
+                                            kNmsMaskBudgetBytes / segment_mask_bytes})));
+  IAllocatorUniquePtr<void> d_masks_ptr{allocator(static_cast<size_t>(chunk_size) * segment_mask_bytes)};
+  auto* d_masks = static_cast<uint64_t*>(d_masks_ptr.get());
+
+  for (int segment_begin = 0; segment_begin < num_segments; segment_begin += chunk_size) {
+    const int segments = std::min(chunk_size, num_segments - segment_begin);
+    const dim3 grid(words, words, segments);
+    NmsMaskKernel<<<grid, kNmsBoxesPerWord, 0, stream>>>(
+        pc.boxes_data_, d_sorted_indices, d_candidate_counts, num_boxes, static_cast<int>(pc.num_classes_),
+        center_point_box, iou_threshold, segment_begin, d_masks);
+    NmsReduceKernel<<<segments, kNmsReduceThreadsPerBlock, removed_bytes, stream>>>(
+        d_masks, d_sorted_indices, d_candidate_counts, num_boxes, max_output_boxes_per_class, segment_begin,
+        d_selected_indices, d_selected_counts);
   }
-
-  // STEP 3. launch NMS kernels
-  ORT_RETURN_IF_ERROR(NmsGpu(stream,
-                             allocator,
-                             center_point_box,
-                             d_sorted_boxes,
-                             limited_num_boxes,
-                             iou_threshold,
-                             d_selected_indices,
-                             h_number_selected,
-                             max_output_boxes_per_class));
   CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
-  // STEP 4. map back to sorted indices
-  *h_number_selected = std::min(*h_number_selected, max_output_boxes_per_class);
-  int num_to_keep = *h_number_selected;
-  if (num_to_keep > 0) {
-    IAllocatorUniquePtr<void> d_output_indices_ptr{allocator(num_to_keep * sizeof(int))};
-    auto* d_output_indices = static_cast<int*>(d_output_indices_ptr.get());
-    IAllocatorUniquePtr<void> d_normalized_output_indices_ptr{allocator(num_to_keep * 3 * sizeof(int64_t))};
-    auto* d_normalized_output_indices = static_cast<int64_t*>(d_normalized_output_indices_ptr.get());
-
-    blocksPerGrid = (int)(ceil(static_cast<float>(num_to_keep) / GridDim::maxThreadsPerBlock));
-    IndexMultiSelect<int, int><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_to_keep, d_selected_indices, d_sorted_indices, d_output_indices);
-    NormalizeOutput<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_to_keep, d_output_indices, d_normalized_output_indices, batch_index, class_index);
-    CUDA_RETURN_IF_ERROR(cudaGetLastError());
+  // STEP 4. compact the selected boxes of all segments into the output.
+  // The total count is the only value read back, as it is the shape of the output.
+  IAllocatorUniquePtr<void> d_output_offsets_ptr{allocator((num_segments + 1) * sizeof(int))};
+  auto* d_output_offsets = static_cast<int*>(d_output_offsets_ptr.get());
+  CUDA_RETURN_IF_ERROR(cudaMemsetAsync(d_output_offsets, 0, sizeof(int), stream));
+  size_t cub_scan_temp_storage_bytes = 0;
+  CUDA_RETURN_IF_ERROR(cub::DeviceScan::InclusiveSum(
+      nullptr, cub_scan_temp_storage_bytes, d_selected_counts, d_output_offsets + 1, num_segments, stream));
+  IAllocatorUniquePtr<void> d_cub_scan_buffer_ptr{allocator(cub_scan_temp_storage_bytes)};
+  CUDA_RETURN_IF_ERROR(cub::DeviceScan::InclusiveSum(
+      d_cub_scan_buffer_ptr.get(), cub_scan_temp_storage_bytes, d_selected_counts, d_output_offsets + 1, num_segments,
+      stream));
 
-    selected_indices = std::move(d_normalized_output_indices_ptr);
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(h_number_selected, d_output_offsets + num_segments, sizeof(int),
+                                       cudaMemcpyDeviceToHost, stream));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+
+  int64_t* output = output_allocator(*h_number_selected);
+  if (*h_number_selected > 0) {
+    WriteOutputKernel<<<num_segments, kNmsBoxesPerWord, 0, stream>>>(
+        d_selected_indices, d_selected_counts, d_output_offsets, static_cast<int>(pc.num_classes_),
+        max_output_boxes_per_class, output);
+    CUDA_RETURN_IF_ERROR(cudaGetLastError());
   }
 
   return Status::OK();
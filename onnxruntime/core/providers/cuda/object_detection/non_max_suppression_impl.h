@@ -13,18 +13,19 @@
 namespace onnxruntime {
 namespace cuda {
 
+// Runs NMS on all the (batch, class) pairs together on the device. The number of selected boxes is the only value
+// copied back, to h_number_selected in pinned memory; output_allocator is then called with it and returns the
+// device buffer of the [number_selected, 3] output.
 Status NonMaxSuppressionImpl(
     cudaStream_t stream,
     std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
     const PrepareContext& pc,
     const int64_t center_point_box,
-    int64_t batch_index,
-    int64_t class_index,
     int max_output_boxes_per_class,
     float iou_threshold,
     float score_threshold,
-    IAllocatorUniquePtr<void>& selected_indices,
-    int* h_number_selected);
+    int* h_number_selected,
+    std::function<int64_t*(int)> output_allocator);
 
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "cudnn_rnn_base.h"
 #include "rnn_impl.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
@@ -123,8 +125,11 @@ Status CudnnRnnBase<T>::CacheCudnnRnnWeights(const OpKernelInfo& info) {
   bool get_W = info.TryGetConstantInput(RNN_Input_Index::W, &W);
   bool get_R = info.TryGetConstantInput(RNN_Input_Index::R, &R);
   bool get_B = info.TryGetConstantInput(RNN_Input_Index::B, &B);
+  // A bias that is computed at run time can't be folded into the cached weights.
+  const auto& input_defs = info.node().InputDefs();
+  bool has_B = input_defs.size() > RNN_Input_Index::B && input_defs[RNN_Input_Index::B]->Exists();
 
-  if (get_W && get_R) {
+  if (get_W && get_R && (get_B || !has_B)) {
     CudnnRNN tmp_rnn_desc;
     ORT_RETURN_IF_ERROR(tmp_rnn_desc.Set(CudnnHandle(),
                                          hidden_size_,
@@ -224,6 +229,14 @@ Status CudnnRnnBase<T>::ComputeInternal(OpKernelContext* ctx) const {
 
   const int32_t* sequence_lens_data = (sequence_lens == nullptr) ? nullptr : sequence_lens->template Data<int32_t>();
 
+  // Sequences that all have the full length don't need the padded layout of cudnnRNNForwardInferenceEx.
+  bool full_sequences = nullptr == sequence_lens_data ||
+                        std::all_of(sequence_lens_data, sequence_lens_data + batch_size,
+                                    [seq_length](int32_t len) { return len == seq_length; });
+  bool use_padded_io = !(CUDNN_RNN_RELU == rnn_mode_ || CUDNN_RNN_TANH == rnn_mode_ || full_sequences);
+  // The persistent kernels only run on packed input.
+  bool use_persist_static = !use_padded_io && UsePersistStatic(batch_size);
+
   CudnnRNN rnn_desc;
   ORT_RETURN_IF_ERROR(rnn_desc.Set(CudnnHandle(),
                                    hidden_size_,
@@ -232,7 +245,8 @@ Status CudnnRnnBase<T>::ComputeInternal(OpKernelContext* ctx) const {
                                    cudnn_direction_mode_,
                                    rnn_mode_,
                                    CudnnTensor::GetDataType<CudaT>(),
-                                   GetDeviceProp()));
+                                   GetDeviceProp(),
+                                   use_persist_static ? CUDNN_RNN_ALGO_PERSIST_STATIC : CUDNN_RNN_ALGO_STANDARD));
 
   // Prepare the weight data
   IAllocatorUniquePtr<void> w_data;
@@ -244,36 +258,59 @@ Status CudnnRnnBase<T>::ComputeInternal(OpKernelContext* ctx) const {
     ORT_RETURN_IF_ERROR(ReorganizeWeights(&W, &R, B, w_data, w_desc, rnn_desc));
   }
 
-  // CUDNN_RNN_DATA_LAYOUT_SEQ_MAJOR_UNPACKED works with CUDNN_RNN_PADDED_IO_ENABLED, so that it will auto fill 0 for the shorter sequences
-  CUDNN_RETURN_IF_ERROR(cudnnSetRNNPaddingMode(rnn_desc, CUDNN_RNN_PADDED_IO_ENABLED));
+  if (use_padded_io) {
+    // CUDNN_RNN_DATA_LAYOUT_SEQ_MAJOR_UNPACKED works with CUDNN_RNN_PADDED_IO_ENABLED, so that it will auto fill 0 for the shorter sequences
+    CUDNN_RETURN_IF_ERROR(cudnnSetRNNPaddingMode(rnn_desc, CUDNN_RNN_PADDED_IO_ENABLED));
+  }
 
-  size_t workspace_bytes;
-  CUDNN_RETURN_IF_ERROR(cudnnGetRNNWorkspaceSize(CudnnHandle(), rnn_desc, gsl::narrow_cast<int>(seq_length), x_desc.data(), &workspace_bytes));
-  auto workspace_cuda = GetScratchBuffer<void>(workspace_bytes);
   int32_t zero_seq_count = 0;
   std::vector<int32_t> zero_seq_index_cache(batch_size, 0);
   int64_t zero_seq_index_cache_size = 0;
 
-  if (CUDNN_RNN_RELU == rnn_mode_ || CUDNN_RNN_TANH == rnn_mode_ || nullptr == sequence_lens_data) {
-    CUDNN_RETURN_IF_ERROR(cudnnRNNForwardInference(CudnnHandle(),
-                                                   rnn_desc,
-                                                   gsl::narrow_cast<int>(seq_length),
-                                                   x_desc.data(),
-                                                   x_data_input,
-                                                   hx_desc,
-                                                   hx_data,
-                                                   cx_desc,
-                                                   cx_data,
-                                                   weight_cached_ ? w_desc_cache_ : w_desc,
-                                                   weight_cached_ ? w_data_cache_.get() : w_data.get(),
-                                                   y_desc.data(),
-                                                   y_data,
-                                                   y_h_desc,
-                                                   y_h_data,
-                                                   y_c_desc,
-                                                   y_c_data,
-                                                   workspace_cuda.get(),
-                                                   workspace_bytes));
+  if (!use_padded_io) {
+    auto forward_inference = [&]() {
+      size_t workspace_bytes;
+      cudnnStatus_t status = cudnnGetRNNWorkspaceSize(CudnnHandle(), rnn_desc, gsl::narrow_cast<int>(seq_length), x_desc.data(), &workspace_bytes);
+      if (status != CUDNN_STATUS_SUCCESS) {
+        return status;
+      }
+      auto workspace_cuda = GetScratchBuffer<void>(workspace_bytes);
+      return cudnnRNNForwardInference(CudnnHandle(),
+                                      rnn_desc,
+                                      gsl::narrow_cast<int>(seq_length),
+                                      x_desc.data(),
+                                      x_data_input,
+                                      hx_desc,
+                                      hx_data,
+                                      cx_desc,
+                                      cx_data,
+                                      weight_cached_ ? w_desc_cache_ : w_desc,
+                                      weight_cached_ ? w_data_cache_.get() : w_data.get(),
+                                      y_desc.data(),
+                                      y_data,
+                                      y_h_desc,
+                                      y_h_data,
+                                      y_c_desc,
+                                      y_c_data,
+                                      workspace_cuda.get(),
+                                      workspace_bytes);
+    };
+
+    cudnnStatus_t status = forward_inference();
+    if (use_persist_static && status == CUDNN_STATUS_NOT_SUPPORTED) {
+      // The recurrent weights don't fit on chip, fall back to the standard algorithm from now on.
+      persist_static_unsupported_ = true;
+      ORT_RETURN_IF_ERROR(rnn_desc.Set(CudnnHandle(),
+                                       hidden_size_,
+                                       RNN_NUM_LAYERS,
+                                       cudnn_dropout_desc_,
+                                       cudnn_direction_mode_,
+                                       rnn_mode_,
+                                       CudnnTensor::GetDataType<CudaT>(),
+                                       GetDeviceProp()));
+      status = forward_inference();
+    }
+    CUDNN_RETURN_IF_ERROR(status);
   } else {
     // cudnn doesn't support 0 sequence inside the batch, find the 0 sequence and set it to 1
     // there's a ZeroMask kernel to reset the result to 0 for the 0 sequence
@@ -302,6 +339,10 @@ Status CudnnRnnBase<T>::ComputeInternal(OpKernelContext* ctx) const {
     CudnnDataTensor y_desc1;
     ORT_RETURN_IF_ERROR(y_desc1.Set(CudnnTensor::GetDataType<CudaT>(), seq_length, batch_size, hidden_size_ * num_directions_, seq_len_array.data()));
 
+    size_t workspace_bytes;
+    CUDNN_RETURN_IF_ERROR(cudnnGetRNNWorkspaceSize(CudnnHandle(), rnn_desc, gsl::narrow_cast<int>(seq_length), x_desc.data(), &workspace_bytes));
+    auto workspace_cuda = GetScratchBuffer<void>(workspace_bytes);
+
     CUDNN_RETURN_IF_ERROR(cudnnRNNForwardInferenceEx(CudnnHandle(),
                                                      rnn_desc,
                                                      x_desc1,
@@ -387,6 +428,15 @@ Status CudnnRnnBase<T>::ComputeInternal(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+template <typename T>
+bool CudnnRnnBase<T>::UsePersistStatic(int64_t batch_size) const {
+  // The persistent kernels need sm_60 and don't support double.
+  return !persist_static_unsupported_ &&
+         !std::is_same<T, double>::value &&
+         GetDeviceProp().major >= 6 &&
+         batch_size <= RNN_PERSIST_STATIC_MAX_BATCH_SIZE;
+}
+
 template <typename T>
 void CudnnRnnBase<T>::SetZeroSequences(const int64_t zero_seq_index_cache_size,
                                        const std::vector<int32_t> zero_seq_index_cache,
@@ -5,6 +5,7 @@
 
 #include "gsl/gsl"
 
+#include <atomic>
 #include <cudnn.h>
 
 #include "core/providers/cuda/cuda_kernel.h"
@@ -26,6 +27,10 @@ enum RNN_Input_Index {
 // Onnx RNN/GRU/LSTM only support 1 layer
 const int RNN_NUM_LAYERS = 1;
 
+// Largest batch for which the persistent RNN kernels are tried. They keep the recurrent weights on chip for the
+// whole sequence, which pays off when a step has too little work to hide its launch.
+const int64_t RNN_PERSIST_STATIC_MAX_BATCH_SIZE = 32;
+
 class CudnnRNN {
  public:
   CudnnRNN() : cudnn_rnn_desc_(nullptr) {
@@ -40,7 +45,8 @@ class CudnnRNN {
 
   Status Set(const cudnnHandle_t& cudnnHandle, int64_t hidden_size, int num_layers,
              cudnnDropoutDescriptor_t cudnn_dropout_desc, cudnnDirectionMode_t cudnn_direction_model,
-             cudnnRNNMode_t rnn_mode, cudnnDataType_t dataType, const cudaDeviceProp& prop) {
+             cudnnRNNMode_t rnn_mode, cudnnDataType_t dataType, const cudaDeviceProp& prop,
+             cudnnRNNAlgo_t algo = CUDNN_RNN_ALGO_STANDARD) {
     if (!cudnn_rnn_desc_)
       CUDNN_RETURN_IF_ERROR(cudnnCreateRNNDescriptor(&cudnn_rnn_desc_));
 
@@ -52,7 +58,7 @@ class CudnnRNN {
                                                 CUDNN_LINEAR_INPUT,  // We can also skip the input matrix transformation
                                                 cudnn_direction_model,
                                                 rnn_mode,
-                                                CUDNN_RNN_ALGO_STANDARD,  //CUDNN_RNN_ALGO_PERSIST_STATIC, CUDNN_RNN_ALGO_PERSIST_DYNAMIC
+                                                algo,
                                                 dataType));
 
     if (prop.major >= 7 && dataType == CUDNN_DATA_HALF) {
@@ -138,6 +144,9 @@ class CudnnRnnBase : public CudaKernel {
                      int& offset,
                      bool is_matrix) const;
 
+  // Whether to try CUDNN_RNN_ALGO_PERSIST_STATIC for a batch of sequences of full length.
+  bool UsePersistStatic(int64_t batch_size) const;
+
   void SetZeroSequences(const int64_t zero_seq_index_cache_size,
                         const std::vector<int32_t> zero_seq_index_cache,
                         T* y_data,
@@ -160,6 +169,8 @@ class CudnnRnnBase : public CudaKernel {
   CudnnFilterDescriptor w_desc_cache_;
   IAllocatorUniquePtr<void> w_data_cache_;
   bool weight_cached_;
+  // Set once cuDNN rejects the persistent kernels for this node, e.g. when hidden_size_ does not fit on chip.
+  mutable std::atomic<bool> persist_static_unsupported_{false};
 
   // cudnn_dropout_desc_ is a cache, never to be changed
   IAllocatorUniquePtr<void> state_buffer_;
@@ -49,6 +49,11 @@ namespace Dml
         , m_resourceFlags(resourceFlags)
         , m_initialState(initialState)
     {
+        // The heaps of the pool only hold buffers of DEFAULT heaps
+        if (m_heapProperties.Type == D3D12_HEAP_TYPE_DEFAULT && m_heapFlags == D3D12_HEAP_FLAG_NONE)
+        {
+            m_heapPool = BufferHeapPool::GetForDevice(device);
+        }
     }
 
     /*static*/ gsl::index BucketizedBufferAllocator::GetBucketIndexFromSize(uint64_t size)
@@ -71,6 +76,28 @@ namespace Dml
         return (1ull << (index + c_minResourceSizeExponent));
     }
 
+    ComPtr<ID3D12Resource> BucketizedBufferAllocator::CreateResource(uint64_t size)
+    {
+        ComPtr<ID3D12Resource> resource;
+        if (m_heapPool)
+        {
+            resource = m_heapPool->TryCreatePlacedBuffer(size, m_resourceFlags, m_initialState);
+        }
+
+        if (!resource)
+        {
+            THROW_IF_FAILED(m_device->CreateCommittedResource(
+                &m_heapProperties,
+                m_heapFlags,
+                &CD3DX12_RESOURCE_DESC::Buffer(size, m_resourceFlags),
+                m_initialState,
+                nullptr,
+                IID_PPV_ARGS(&resource)));
+        }
+
+        return resource;
+    }
+
     void* BucketizedBufferAllocator::Alloc(size_t size)
     {
         return Alloc(size, m_defaultRoundingMode);
@@ -105,13 +132,7 @@ namespace Dml
             if (bucket->resources.empty())
             {
                 // No more resources in this bucket - allocate a new one
-                THROW_IF_FAILED(m_device->CreateCommittedResource(
-                    &m_heapProperties,
-                    m_heapFlags,
-                    &CD3DX12_RESOURCE_DESC::Buffer(bucketSize, m_resourceFlags),
-                    m_initialState,
-                    nullptr,
-                    IID_PPV_ARGS(&resource)));
+                resource = CreateResource(bucketSize);
 
                 resourceId = ++m_currentResourceId;
             }
@@ -128,13 +149,7 @@ namespace Dml
             // The allocation will not be pooled.  Construct a new one
             bucketSize = (size + 3) & ~3;
 
-            THROW_IF_FAILED(m_device->CreateCommittedResource(
-                &m_heapProperties,
-                m_heapFlags,
-                &CD3DX12_RESOURCE_DESC::Buffer(bucketSize, m_resourceFlags),
-                m_initialState,
-                nullptr,
-                IID_PPV_ARGS(&resource)));
+            resource = CreateResource(bucketSize);
 
             resourceId = ++m_currentResourceId;        
         }
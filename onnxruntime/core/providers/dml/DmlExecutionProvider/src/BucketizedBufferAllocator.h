@@ -5,6 +5,7 @@
 
 #include "core/framework/allocator.h"
 #include "ExecutionContext.h"
+#include "BufferHeapPool.h"
 
 namespace Dml
 {
@@ -82,7 +83,8 @@ namespace Dml
     // Implements a Lotus allocator for D3D12 heap buffers, using a bucket allocation strategy. The allocator
     // maintains a set of fixed-size buckets, with each bucket containing one or more D3D12 buffers of that fixed size.
     // All requested allocation sizes are rounded up to the nearest bucket size, which ensures minimal fragmentation
-    // while providing an upper bound on the amount of memory "wasted" with each allocation.
+    // while providing an upper bound on the amount of memory "wasted" with each allocation. Buffers in DEFAULT heaps
+    // are placed in the heaps of the BufferHeapPool shared with the other allocators of the device when small enough.
     class BucketizedBufferAllocator : public onnxruntime::IAllocator
     {
     public:
@@ -137,11 +139,14 @@ namespace Dml
         friend class AllocationInfo;
         void FreeResource(void* p, uint64_t resourceId);
 
+        ComPtr<ID3D12Resource> CreateResource(uint64_t size);
+
         ComPtr<ID3D12Device> m_device;
         D3D12_HEAP_PROPERTIES m_heapProperties;
         D3D12_HEAP_FLAGS m_heapFlags;
         D3D12_RESOURCE_FLAGS m_resourceFlags;
         D3D12_RESOURCE_STATES m_initialState;
+        std::shared_ptr<BufferHeapPool> m_heapPool;
 
         std::vector<Bucket> m_pool;
         size_t m_currentAllocationId = 0;
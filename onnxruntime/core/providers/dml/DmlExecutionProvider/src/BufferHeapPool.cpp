@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "precomp.h"
+
+#include "BufferHeapPool.h"
+
+namespace Dml
+{
+    // Identifies the HeapRange attached to the placed resources as private data
+    static const GUID c_heapRangeGuid = { 0x2427be53, 0x5831, 0x47fa, { 0x8f, 0x60, 0xc2, 0xfe, 0x5f, 0x80, 0xa7, 0x73 } };
+
+    // The range of a heap used by a placed resource. It's attached to the resource as private data, which D3D12 releases
+    // when the resource is destroyed.
+    class BufferHeapPool::HeapRange : public Microsoft::WRL::RuntimeClass<
+        Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::ClassicCom>, IUnknown>
+    {
+    public:
+        HeapRange(std::shared_ptr<BufferHeapPool> pool, size_t heapIndex, uint64_t offset, uint64_t size)
+            : m_pool(std::move(pool))
+            , m_heapIndex(heapIndex)
+            , m_offset(offset)
+            , m_size(size)
+        {}
+
+        ~HeapRange()
+        {
+            m_pool->FreeRange(m_heapIndex, m_offset, m_size);
+        }
+
+    private:
+        // Keeps the heap alive, as placed resources don't
+        std::shared_ptr<BufferHeapPool> m_pool;
+        size_t m_heapIndex;
+        uint64_t m_offset;
+        uint64_t m_size;
+    };
+
+    /*static*/ std::shared_ptr<BufferHeapPool> BufferHeapPool::GetForDevice(ID3D12Device* device)
+    {
+        static std::mutex s_mutex;
+        static std::map<ID3D12Device*, std::weak_ptr<BufferHeapPool>> s_pools;
+
+        std::lock_guard<std::mutex> lock(s_mutex);
+
+        // A live pool holds a reference on its device, so the address can't have been reused by another device
+        std::shared_ptr<BufferHeapPool> pool = s_pools[device].lock();
+        if (!pool)
+        {
+            pool = std::make_shared<BufferHeapPool>(device);
+            s_pools[device] = pool;
+        }
+
+        return pool;
+    }
+
+    BufferHeapPool::BufferHeapPool(ID3D12Device* device)
+        : m_device(device)
+    {
+    }
+
+    ComPtr<ID3D12Resource> BufferHeapPool::TryCreatePlacedBuffer(
+        uint64_t size,
+        D3D12_RESOURCE_FLAGS resourceFlags,
+        D3D12_RESOURCE_STATES initialState)
+    {
+        if (size > c_maxPlacedBufferSize)
+        {
+            return nullptr;
+        }
+
+        const uint64_t alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        const uint64_t rangeSize = (size + alignment - 1) & ~(alignment - 1);
+
+        size_t heapIndex = 0;
+        uint64_t offset = 0;
+        ComPtr<ID3D12Heap> heap;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // First fit in the existing heaps
+            bool found = false;
+            for (; heapIndex < m_heaps.size() && !found; ++heapIndex)
+            {
+                auto& freeRanges = m_heaps[heapIndex].freeRanges;
+                for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+                {
+                    if (it->second >= rangeSize)
+                    {
+                        offset = it->first;
+                        if (it->second > rangeSize)
+                        {
+                            freeRanges[offset + rangeSize] = it->second - rangeSize;
+                        }
+                        freeRanges.erase(it);
+                        found = true;
+                        break;
+                    }
+                }
+            }
+
+            if (found)
+            {
+                --heapIndex;
+            }
+            else
+            {
+                Heap newHeap;
+                THROW_IF_FAILED(m_device->CreateHeap(
+                    &CD3DX12_HEAP_DESC(c_heapSize, D3D12_HEAP_TYPE_DEFAULT, alignment, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS),
+                    IID_PPV_ARGS(&newHeap.heap)));
+
+                newHeap.freeRanges[rangeSize] = c_heapSize - rangeSize;
+                m_heaps.push_back(std::move(newHeap));
+
+                heapIndex = m_heaps.size() - 1;
+                offset = 0;
+            }
+
+            heap = m_heaps[heapIndex].heap;
+        }
+
+        // Frees the range if creating the resource fails
+        ComPtr<HeapRange> range = wil::MakeOrThrow<HeapRange>(shared_from_this(), heapIndex, offset, rangeSize);
+
+        ComPtr<ID3D12Resource> resource;
+        THROW_IF_FAILED(m_device->CreatePlacedResource(
+            heap.Get(),
+            offset,
+            &CD3DX12_RESOURCE_DESC::Buffer(size, resourceFlags),
+            initialState,
+            nullptr,
+            IID_PPV_ARGS(&resource)));
+
+        THROW_IF_FAILED(resource->SetPrivateDataInterface(c_heapRangeGuid, range.Get()));
+
+        return resource;
+    }
+
+    void BufferHeapPool::FreeRange(size_t heapIndex, uint64_t offset, uint64_t size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto& freeRanges = m_heaps[heapIndex].freeRanges;
+        auto it = freeRanges.emplace(offset, size).first;
+
+        // Merge with the next range
+        auto next = std::next(it);
+        if (next != freeRanges.end() && it->first + it->second == next->first)
+        {
+            it->second += next->second;
+            freeRanges.erase(next);
+        }
+
+        // Merge with the previous range
+        if (it != freeRanges.begin())
+        {
+            auto prev = std::prev(it);
+            if (prev->first + prev->second == it->first)
+            {
+                prev->second += it->second;
+                freeRanges.erase(it);
+            }
+        }
+    }
+
+} // namespace Dml
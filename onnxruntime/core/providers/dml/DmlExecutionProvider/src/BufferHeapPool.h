@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+
+namespace Dml
+{
+    // A pool of large D3D12 heaps from which buffers are suballocated as placed resources, shared by the allocators of
+    // all the execution providers created on the same device. Placing a buffer in an existing heap is much cheaper
+    // than creating a committed resource, and the memory of the buffers released by a session can be reused by the
+    // other sessions of the process instead of being returned to the OS and committed again.
+    class BufferHeapPool : public std::enable_shared_from_this<BufferHeapPool>
+    {
+    public:
+        // Returns the pool of the device, creating one if no allocator of the device holds it anymore.
+        static std::shared_ptr<BufferHeapPool> GetForDevice(ID3D12Device* device);
+
+        explicit BufferHeapPool(ID3D12Device* device);
+
+        // Creates a DEFAULT heap buffer placed in one of the heaps of the pool, or returns nullptr if the buffer is too
+        // large to be suballocated. The range of the heap is returned to the pool when the resource is destroyed, so
+        // deferring its release until the GPU is done with it (see ExecutionContext::QueueReference) also defers the
+        // reuse of its memory.
+        ComPtr<ID3D12Resource> TryCreatePlacedBuffer(
+            uint64_t size,
+            D3D12_RESOURCE_FLAGS resourceFlags,
+            D3D12_RESOURCE_STATES initialState);
+
+    private:
+        static constexpr uint64_t c_heapSize = 64 * 1024 * 1024; // 64MB
+        static constexpr uint64_t c_maxPlacedBufferSize = 16 * 1024 * 1024; // 16MB
+
+        class HeapRange;
+
+        struct Heap
+        {
+            ComPtr<ID3D12Heap> heap;
+
+            // The unused ranges of the heap, as offset -> size. Adjacent ranges are always merged.
+            std::map<uint64_t, uint64_t> freeRanges;
+        };
+
+        void FreeRange(size_t heapIndex, uint64_t offset, uint64_t size);
+
+        ComPtr<ID3D12Device> m_device;
+
+        std::mutex m_mutex;
+        std::vector<Heap> m_heaps;
+    };
+
+} // namespace Dml
@@ -122,8 +122,12 @@ namespace Dml
                 dmlOutputEdges,
                 dmlIntermediateEdges);
 
+            // With persistent command lists, the command lists of all partitions are reused regardless of their size,
+            // as the CPU cost of recording them is what the mode is meant to remove.
+            const bool reuseCommandList = graphDesc.reuseCommandList || m_provider->PersistentCommandListsEnabled();
+
             DML_EXECUTION_FLAGS executionFlags = DML_EXECUTION_FLAG_NONE;
-            if (graphDesc.reuseCommandList)
+            if (reuseCommandList)
             {
                 executionFlags |= DML_EXECUTION_FLAG_DESCRIPTORS_VOLATILE;
             }
@@ -167,18 +171,25 @@ namespace Dml
                 [&](ComPtr<ID3D12Resource>& resource){ m_winmlProvider->QueueReference(resource.Get()); }
             );  
 
-            if (graphDesc.reuseCommandList)
+            if (reuseCommandList)
             {
-                BuildReusableCommandList();
+                // Keep several recorded command lists when they are persistent, so that one is available while the
+                // previous executions are still in flight on the GPU.
+                const uint32_t reusableCommandListCount = m_provider->PersistentCommandListsEnabled() ? c_persistentCommandListCount : 1;
+                m_reusableCommandLists.resize(reusableCommandListCount);
+                for (ReusableCommandList& commandList : m_reusableCommandLists)
+                {
+                    BuildReusableCommandList(commandList);
+                }
             }
         }
 
         onnxruntime::Status Compute(onnxruntime::OpKernelContext* kernelContext) const override
         {
-            // Only re-use the cached command list if its prior execution is complete on the GPU.
-            // This requirement can be avoided by mantaining ring buffers.
-            if (!m_graphicsCommandList || 
-                (m_fence != nullptr && m_fence->GetCompletedValue() < m_completionValue))
+            // Only re-use a cached command list if its prior execution is complete on the GPU, as its descriptors
+            // are updated in place.
+            ReusableCommandList* reusableCommandList = GetAvailableReusableCommandList();
+            if (!reusableCommandList)
             {
                 // Wrap tensors as required by Dml::IExecutionProvider::ExecuteOperator
                 OpKernelContextWrapper contextWrapper(
@@ -226,7 +237,7 @@ namespace Dml
             }
             else
             {
-                ExecuteReusableCommandList(kernelContext);
+                ExecuteReusableCommandList(kernelContext, *reusableCommandList);
             }
 
             return onnxruntime::Status::OK();
@@ -296,7 +307,46 @@ namespace Dml
             }
 
     private:
-        void BuildReusableCommandList()
+        // Command lists are recorded once with a binding table over their own descriptor heap, and resubmitted with
+        // only the changed bindings written to the heap.
+        struct ReusableCommandList
+        {
+            ComPtr<ID3D12GraphicsCommandList> graphicsCommandList;
+            ComPtr<ID3D12DescriptorHeap> heap;
+            ComPtr<IDMLBindingTable> bindingTable;
+
+            // Bindings from previous executions of the command list
+            std::vector<uint64_t> inputBindingAllocIds;
+            std::vector<uint64_t> outputBindingAllocIds;
+            uint64_t tempBindingAllocId = 0;
+
+            // Fence tracking the status of the command list's last execution, and whether its descriptor heap 
+            // can safely be updated.
+            ComPtr<ID3D12Fence> fence;
+            uint64_t completionValue = 0;
+        };
+
+        // Number of command lists recorded for each partition when persistent command lists are enabled
+        static constexpr uint32_t c_persistentCommandListCount = 3;
+
+        ReusableCommandList* GetAvailableReusableCommandList() const
+        {
+            // Try the command lists in the order they were submitted, starting after the last one
+            for (size_t i = 0; i < m_reusableCommandLists.size(); ++i)
+            {
+                const size_t index = (m_nextReusableCommandList + i) % m_reusableCommandLists.size();
+                ReusableCommandList& commandList = m_reusableCommandLists[index];
+                if (commandList.fence == nullptr || commandList.fence->GetCompletedValue() >= commandList.completionValue)
+                {
+                    m_nextReusableCommandList = (index + 1) % m_reusableCommandLists.size();
+                    return &commandList;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void BuildReusableCommandList(ReusableCommandList& reusableCommandList)
         {
             ComPtr<IDMLDevice> device;
             THROW_IF_FAILED(m_provider->GetDmlDevice(device.GetAddressOf()));
@@ -311,16 +361,16 @@ namespace Dml
             ComPtr<ID3D12Device> d3dDevice;
             THROW_IF_FAILED(m_provider->GetD3DDevice(d3dDevice.GetAddressOf()));
 
-            THROW_IF_FAILED(d3dDevice->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_heap)));
+            THROW_IF_FAILED(d3dDevice->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&reusableCommandList.heap)));
 
             // Create a binding table for execution.
             DML_BINDING_TABLE_DESC bindingTableDesc = {};
             bindingTableDesc.Dispatchable = m_compiledExecutionPlanOperator.Get();
-            bindingTableDesc.CPUDescriptorHandle = m_heap->GetCPUDescriptorHandleForHeapStart();
-            bindingTableDesc.GPUDescriptorHandle = m_heap->GetGPUDescriptorHandleForHeapStart();
+            bindingTableDesc.CPUDescriptorHandle = reusableCommandList.heap->GetCPUDescriptorHandleForHeapStart();
+            bindingTableDesc.GPUDescriptorHandle = reusableCommandList.heap->GetGPUDescriptorHandleForHeapStart();
             bindingTableDesc.SizeInDescriptors = execBindingProps.RequiredDescriptorCount;
 
-            THROW_IF_FAILED(device->CreateBindingTable(&bindingTableDesc, IID_PPV_ARGS(&m_bindingTable)));
+            THROW_IF_FAILED(device->CreateBindingTable(&bindingTableDesc, IID_PPV_ARGS(&reusableCommandList.bindingTable)));
 
             ComPtr<ID3D12CommandAllocator> allocator;
             THROW_IF_FAILED(d3dDevice->CreateCommandAllocator(
@@ -335,27 +385,27 @@ namespace Dml
                 nullptr,
                 IID_PPV_ARGS(&commandList)));
             
-            THROW_IF_FAILED(commandList.As(&m_graphicsCommandList));
+            THROW_IF_FAILED(commandList.As(&reusableCommandList.graphicsCommandList));
 
             if (m_persistentResource)
             {
                 DML_BINDING_DESC persistentResourceBindingDesc =
                     { DML_BINDING_TYPE_BUFFER, m_persistentResourceBinding ? &*m_persistentResourceBinding : nullptr };
-                m_bindingTable->BindPersistentResource(&persistentResourceBindingDesc);
+                reusableCommandList.bindingTable->BindPersistentResource(&persistentResourceBindingDesc);
             }
 
-            ID3D12DescriptorHeap* descriptorHeaps[] = { m_heap.Get() };
-            m_graphicsCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
+            ID3D12DescriptorHeap* descriptorHeaps[] = { reusableCommandList.heap.Get() };
+            reusableCommandList.graphicsCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
 
             ComPtr<IDMLCommandRecorder> recorder;
             THROW_IF_FAILED(device->CreateCommandRecorder(IID_PPV_ARGS(recorder.GetAddressOf())));
 
-            recorder->RecordDispatch(commandList.Get(), m_compiledExecutionPlanOperator.Get(), m_bindingTable.Get());
+            recorder->RecordDispatch(commandList.Get(), m_compiledExecutionPlanOperator.Get(), reusableCommandList.bindingTable.Get());
 
-            THROW_IF_FAILED(m_graphicsCommandList->Close());
+            THROW_IF_FAILED(reusableCommandList.graphicsCommandList->Close());
         }
 
-        void ExecuteReusableCommandList(onnxruntime::OpKernelContext* kernelContext) const
+        void ExecuteReusableCommandList(onnxruntime::OpKernelContext* kernelContext, ReusableCommandList& reusableCommandList) const
         {
             DML_BINDING_PROPERTIES execBindingProps = m_compiledExecutionPlanOperator->GetBindingProperties();
                 
@@ -370,7 +420,7 @@ namespace Dml
 
             // Populate input bindings, excluding those which were specified as owned by DML and provided 
             // at initialization instead.
-            m_inputBindingAllocIds.resize(inputBindings.size());
+            reusableCommandList.inputBindingAllocIds.resize(inputBindings.size());
             bool inputBindingsChanged = false;
 
             for (uint32_t i = 0; i < inputBindings.size(); ++i)
@@ -389,25 +439,25 @@ namespace Dml
 
                         uint64_t allocId;
                         GraphKernelHelper::UnwrapTensor(m_winmlProvider.Get(), tensor, &inputBindings[i].Buffer, &allocId);
-                        inputBindingsChanged = inputBindingsChanged || (!allocId || m_inputBindingAllocIds[i] != allocId);
+                        inputBindingsChanged = inputBindingsChanged || (!allocId || reusableCommandList.inputBindingAllocIds[i] != allocId);
                         inputBindings[i].Buffer->Release(); // Avoid holding an additional reference
                         inputBindings[i].SizeInBytes = GraphKernelHelper::AlignToPow2<size_t>(tensor->SizeInBytes(), 4);
                         inputBindingDescs[i] = {DML_BINDING_TYPE_BUFFER, &inputBindings[i]};
-                        m_inputBindingAllocIds[i] = allocId;
+                        reusableCommandList.inputBindingAllocIds[i] = allocId;
                     }
                 }
             }
                 
             if (inputBindingsChanged)
             {
-                m_bindingTable->BindInputs(gsl::narrow_cast<uint32_t>(inputBindingDescs.size()), inputBindingDescs.data());
+                reusableCommandList.bindingTable->BindInputs(gsl::narrow_cast<uint32_t>(inputBindingDescs.size()), inputBindingDescs.data());
             }
 
             // Populate Output bindings
             std::vector<DML_BUFFER_BINDING> outputBindings(kernelContext->OutputCount());
             std::vector<DML_BINDING_DESC> outputBindingDescs(kernelContext->OutputCount());
 
-            m_outputBindingAllocIds.resize(outputBindings.size());
+            reusableCommandList.outputBindingAllocIds.resize(outputBindings.size());
             bool outputBindingsChanged = false;
             
             for (uint32_t i = 0; i < outputBindings.size(); ++i)
@@ -426,16 +476,16 @@ namespace Dml
 
                 uint64_t allocId;
                 GraphKernelHelper::UnwrapTensor(m_winmlProvider.Get(), tensor, &outputBindings[i].Buffer, &allocId);
-                outputBindingsChanged = outputBindingsChanged || (!allocId || m_outputBindingAllocIds[i] != allocId);
+                outputBindingsChanged = outputBindingsChanged || (!allocId || reusableCommandList.outputBindingAllocIds[i] != allocId);
                 outputBindings[i].Buffer->Release(); // Avoid holding an additional reference
                 outputBindings[i].SizeInBytes = GraphKernelHelper::AlignToPow2<size_t>(tensor->SizeInBytes(), 4);
                 outputBindingDescs[i] = {DML_BINDING_TYPE_BUFFER, &outputBindings[i]};
-                m_outputBindingAllocIds[i] = allocId;
+                reusableCommandList.outputBindingAllocIds[i] = allocId;
             }
 
             if (outputBindingsChanged)
             {
-                m_bindingTable->BindOutputs(gsl::narrow_cast<uint32_t>(outputBindingDescs.size()), outputBindingDescs.data());
+                reusableCommandList.bindingTable->BindOutputs(gsl::narrow_cast<uint32_t>(outputBindingDescs.size()), outputBindingDescs.data());
             }
 
             if (execBindingProps.TemporaryResourceSize > 0)
@@ -455,26 +505,26 @@ namespace Dml
                 DML_BUFFER_BINDING tempBufferBinding = {tempResource.Get(), 0, execBindingProps.TemporaryResourceSize};
                 DML_BINDING_DESC tempBindingDesc = { DML_BINDING_TYPE_BUFFER, &tempBufferBinding };
 
-                if (!tempAllocId || m_tempBindingAllocId != tempAllocId)
+                if (!tempAllocId || reusableCommandList.tempBindingAllocId != tempAllocId)
                 {
-                    m_bindingTable->BindTemporaryResource(&tempBindingDesc);
+                    reusableCommandList.bindingTable->BindTemporaryResource(&tempBindingDesc);
                 }
             
-                m_tempBindingAllocId = tempAllocId;
+                reusableCommandList.tempBindingAllocId = tempAllocId;
             }
 
             // Execute the command list and if it succeeds, update the fence value at which this command may be
             // re-used.
             ComPtr<ID3D12Fence> fence;
             uint64_t completionValue;
-            THROW_IF_FAILED(m_provider->ExecuteCommandList(m_graphicsCommandList.Get(), fence.GetAddressOf(), &completionValue));
-            m_fence = fence;
-            m_completionValue = completionValue;
+            THROW_IF_FAILED(m_provider->ExecuteCommandList(reusableCommandList.graphicsCommandList.Get(), fence.GetAddressOf(), &completionValue));
+            reusableCommandList.fence = fence;
+            reusableCommandList.completionValue = completionValue;
 
             // Queue references to objects which must be kept alive until resulting GPU work completes
-            m_winmlProvider->QueueReference(m_graphicsCommandList.Get());
-            m_winmlProvider->QueueReference(m_heap.Get());
-            m_winmlProvider->QueueReference(m_bindingTable.Get());
+            m_winmlProvider->QueueReference(reusableCommandList.graphicsCommandList.Get());
+            m_winmlProvider->QueueReference(reusableCommandList.heap.Get());
+            m_winmlProvider->QueueReference(reusableCommandList.bindingTable.Get());
             m_winmlProvider->QueueReference(m_persistentResourceAllocatorUnk.Get());
         }
 
@@ -485,23 +535,14 @@ namespace Dml
         ComPtr<Dml::IExecutionProvider> m_provider;
         EdgeShapes m_outputShapes;
 
-        // Re-usable command list, supporting descriptor heap, and DML binding table to update that heap.
-        ComPtr<ID3D12GraphicsCommandList> m_graphicsCommandList;
-        ComPtr<ID3D12DescriptorHeap> m_heap;
-        ComPtr<IDMLBindingTable> m_bindingTable;
+        // Re-usable command lists, each with a supporting descriptor heap and DML binding table to update that heap.
+        // The command lists are used in turn; they are only changed by Compute through their bindings.
+        mutable std::vector<ReusableCommandList> m_reusableCommandLists;
+        mutable size_t m_nextReusableCommandList = 0;
         std::optional<DML_BUFFER_BINDING> m_persistentResourceBinding;
         ComPtr<ID3D12Resource> m_persistentResource;
         ComPtr<IUnknown> m_persistentResourceAllocatorUnk; // Controls when the persistent resource is returned to the allocator
-        
-        // Bindings from previous executions of a re-used command list
-        mutable std::vector<uint64_t> m_inputBindingAllocIds;
-        mutable std::vector<uint64_t> m_outputBindingAllocIds;
-        mutable uint64_t m_tempBindingAllocId = 0;
-
-        // Fence tracking the status of the command list's last execution, and whether its descriptor heap 
-        // can safely be updated.
-        mutable ComPtr<ID3D12Fence> m_fence;
-        mutable uint64_t m_completionValue = 0;
+
 
         std::vector<uint8_t> m_inputsConstant;
         std::vector<ComPtr<ID3D12Resource>> m_nonOwnedGraphInputsFromInitializers;
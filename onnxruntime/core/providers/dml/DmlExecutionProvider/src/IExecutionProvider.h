@@ -69,5 +69,6 @@ namespace Dml
 
         STDMETHOD_(bool, IsMcdmDevice)() const noexcept = 0;
         STDMETHOD_(bool, MetacommandsEnabled)() const noexcept = 0;
+        STDMETHOD_(bool, PersistentCommandListsEnabled)() const noexcept = 0;
     };
 } // namespace Dml
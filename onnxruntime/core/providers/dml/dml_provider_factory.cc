@@ -13,6 +13,7 @@ using Microsoft::WRL::ComPtr;
 #include "core/providers/dml/dml_provider_factory.h"
 #include "core/session/abi_session_options_impl.h"
 #include "core/session/ort_apis.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/error_code_helper.h"
 #include "DmlExecutionProvider/inc/DmlExecutionProvider.h"
 #include "core/platform/env.h"
@@ -29,16 +30,19 @@ struct DMLProviderFactory : IExecutionProviderFactory {
   void SetDefaultRoundingMode(AllocatorRoundingMode rounding_mode);
 
   void SetMetacommandsEnabled(bool metacommands_enabled);
+  void SetPersistentCommandListsEnabled(bool persistent_command_lists_enabled);
 
  private:
   ComPtr<IDMLDevice> dml_device_{};
   ComPtr<ID3D12CommandQueue> cmd_queue_{};
   AllocatorRoundingMode rounding_mode_ = AllocatorRoundingMode::Enabled;
   bool metacommands_enabled_ = true;
+  bool persistent_command_lists_enabled_ = false;
 };
 
 std::unique_ptr<IExecutionProvider> DMLProviderFactory::CreateProvider() {
-  auto provider = Dml::CreateExecutionProvider(dml_device_.Get(), cmd_queue_.Get(), metacommands_enabled_);
+  auto provider = Dml::CreateExecutionProvider(dml_device_.Get(), cmd_queue_.Get(), metacommands_enabled_,
+                                               persistent_command_lists_enabled_);
   Dml::SetDefaultRoundingMode(provider.get(), rounding_mode_);
   return provider;
 }
@@ -51,6 +55,10 @@ void DMLProviderFactory::SetMetacommandsEnabled(bool metacommands_enabled) {
   metacommands_enabled_ = metacommands_enabled;
 }
 
+void DMLProviderFactory::SetPersistentCommandListsEnabled(bool persistent_command_lists_enabled) {
+  persistent_command_lists_enabled_ = persistent_command_lists_enabled;
+}
+
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_DML(IDMLDevice* dml_device,
                                                                               ID3D12CommandQueue* cmd_queue) {
   // Validate that the D3D12 devices match between DML and the command queue. This specifically asks for IUnknown in
@@ -82,6 +90,17 @@ void DmlConfigureProviderFactoryMetacommandsEnabled(IExecutionProviderFactory* f
   dml_provider_factory->SetMetacommandsEnabled(metacommandsEnabled);
 }
 
+void DmlConfigureProviderFactoryPersistentCommandListsEnabled(IExecutionProviderFactory* factory, bool persistentCommandListsEnabled) {
+  auto dml_provider_factory = static_cast<DMLProviderFactory*>(factory);
+  dml_provider_factory->SetPersistentCommandListsEnabled(persistentCommandListsEnabled);
+}
+
+static void ConfigureProviderFactoryFromSessionOptions(IExecutionProviderFactory* factory, const OrtSessionOptions& options) {
+  const bool persistent_command_lists_enabled =
+      options.value.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDmlPersistentCommandLists, "0") == "1";
+  DmlConfigureProviderFactoryPersistentCommandListsEnabled(factory, persistent_command_lists_enabled);
+}
+
 
 bool IsSoftwareAdapter(IDXGIAdapter1* adapter) {
     DXGI_ADAPTER_DESC1 desc;
@@ -142,7 +161,9 @@ std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_DML(in
 
 ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_DML, _In_ OrtSessionOptions* options, int device_id) {
 API_IMPL_BEGIN
-  options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_DML(device_id));
+  auto factory = onnxruntime::CreateExecutionProviderFactory_DML(device_id);
+  onnxruntime::ConfigureProviderFactoryFromSessionOptions(factory.get(), *options);
+  options->provider_factories.push_back(factory);
 API_IMPL_END
   return nullptr;
 }
@@ -150,8 +171,9 @@ API_IMPL_END
 ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProviderEx_DML, _In_ OrtSessionOptions* options,
                     IDMLDevice* dml_device, ID3D12CommandQueue* cmd_queue) {
 API_IMPL_BEGIN
-  options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_DML(dml_device,
-                                                                                        cmd_queue));
+  auto factory = onnxruntime::CreateExecutionProviderFactory_DML(dml_device, cmd_queue);
+  onnxruntime::ConfigureProviderFactoryFromSessionOptions(factory.get(), *options);
+  options->provider_factories.push_back(factory);
 API_IMPL_END
   return nullptr;
 }
@@ -18,6 +18,7 @@
 #include "hip_allocator.h"
 #include "gpu_data_transfer.h"
 #include <fstream>
+#include <sstream>
 #include <algorithm>
 
 #if defined(_MSC_VER)
@@ -116,6 +117,18 @@ MIGraphXExecutionProvider::MIGraphXExecutionProvider(const MIGraphXExecutionProv
   if (!fp16_enable_env.empty()) {
     fp16_enable_ = (std::stoi(fp16_enable_env) == 0 ? false : true);
   }
+
+  // where to save and load the compiled programs
+  model_cache_path_ = env_instance.GetEnvironmentVar(migraphx_env_vars::kModelCachePath);
+
+  // number of programs kept for the different input shapes of a subgraph
+  const std::string program_cache_size_env = env_instance.GetEnvironmentVar(migraphx_env_vars::kProgramCacheSize);
+  if (!program_cache_size_env.empty()) {
+    program_cache_size_ = std::max(std::stoi(program_cache_size_env), 1);
+  }
+
+  // compiled programs are specific to the GPU architecture
+  gpu_arch_ = prop.gcnArchName;
 }
 
 AllocatorPtr MIGraphXExecutionProvider::GetAllocator(int id, OrtMemType mem_type) const {
@@ -966,6 +979,62 @@ bool get_input_output_names(std::string& onnx_buffer,
   return no_input_shape;
 }
 
+// Key of a program compiled for the given input shapes, sorted by input name.
+static std::string GetInputShapesKey(const std::map<std::string, std::vector<std::size_t>>& input_shapes) {
+  std::ostringstream key;
+  for (const auto& input_shape : input_shapes) {
+    key << input_shape.first << ':';
+    for (auto len : input_shape.second) {
+      key << len << ',';
+    }
+    key << ';';
+  }
+  return key.str();
+}
+
+// Parses and compiles the program, or loads it from the model cache path when it has been saved by a previous
+// session. Newly compiled programs are saved there.
+static migraphx::program CompileProgram(const std::string& onnx_string, const migraphx::onnx_options& options,
+                                        const migraphx::target& t, bool fp16_enable,
+                                        const std::string& model_cache_path, const std::string& program_key,
+                                        const std::string& shapes_key) {
+  std::string cache_file;
+  if (!model_cache_path.empty()) {
+    std::ostringstream file_name;
+    file_name << model_cache_path << "/migraphx_" << std::hex << std::hash<std::string>{}(program_key) << '_'
+              << std::hash<std::string>{}(shapes_key) << ".mxr";
+    cache_file = file_name.str();
+
+    if (std::ifstream(cache_file).good()) {
+      try {
+        migraphx::file_options file_options;
+        file_options.set_file_format("msgpack");
+        return migraphx::load(cache_file.c_str(), file_options);
+      } catch (const std::exception& ex) {
+        LOGS_DEFAULT(WARNING) << "MIGraphX: failed to load the compiled program " << cache_file << ": " << ex.what();
+      }
+    }
+  }
+
+  migraphx::program prog = migraphx::parse_onnx_buffer(onnx_string, options);
+  if (fp16_enable) {
+    migraphx::quantize_fp16(prog);
+  }
+  prog.compile(t);
+
+  if (!cache_file.empty()) {
+    try {
+      migraphx::file_options file_options;
+      file_options.set_file_format("msgpack");
+      migraphx::save(prog, cache_file.c_str(), file_options);
+    } catch (const std::exception& ex) {
+      LOGS_DEFAULT(WARNING) << "MIGraphX: failed to save the compiled program " << cache_file << ": " << ex.what();
+    }
+  }
+
+  return prog;
+}
+
 Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>& fused_nodes,
                                           std::vector<NodeComputeInfo>& node_compute_funcs) {
   migraphx::onnx_options options;
@@ -988,17 +1057,17 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
     std::vector<std::string> input_names, output_names;
     no_input_shape = no_input_shape or get_input_output_names(onnx_string_buffer, input_names, output_names);
 
+    // the name of a saved program depends on the subgraph, the precision and the GPU architecture
+    std::ostringstream program_key;
+    program_key << std::hash<std::string>{}(onnx_string_buffer) << '_' << (fp16_enable_ ? "fp16" : "fp32") << '_'
+                << gpu_arch_;
+
     // by parsing the model_proto, create a program corresponding to
     // the input fused_node
     migraphx::program prog;
 
     if (!no_input_shape) {
-      prog = migraphx::parse_onnx_buffer(onnx_string_buffer, options);
-      if (fp16_enable_) {
-        migraphx::quantize_fp16(prog);
-      }
-
-      prog.compile(t_);
+      prog = CompileProgram(onnx_string_buffer, options, t_, fp16_enable_, model_cache_path_, program_key.str(), "");
       auto prog_output_shapes = prog.get_output_shapes();
       for (std::size_t i = 0; i < output_names.size(); ++i) {
         auto out_len = prog_output_shapes[i].lengths();
@@ -1012,12 +1081,14 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
     map_onnx_string_[fused_node->Name()] = onnx_string_buffer;
     map_input_index_[fused_node->Name()] = input_name_index;
     map_no_input_shape_[fused_node->Name()] = no_input_shape;
+    map_program_key_[fused_node->Name()] = program_key.str();
     NodeComputeInfo compute_info;
     compute_info.create_state_func = [=](ComputeContext* context, FunctionState* state) {
       std::unique_ptr<MIGraphXFuncState> p = std::make_unique<MIGraphXFuncState>();
       *p = {context->allocate_func, context->release_func, context->allocator_handle, map_progs_[context->node_name],
             map_onnx_string_[context->node_name], options, t_, map_input_index_[context->node_name], &mgx_mu_,
-            map_no_input_shape_[context->node_name], fp16_enable_};
+            map_no_input_shape_[context->node_name], fp16_enable_, model_cache_path_,
+            map_program_key_[context->node_name], {}, program_cache_size_};
       *state = p.release();
       return 0;
     };
@@ -1042,6 +1113,8 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
       // from input data
       bool input_shape_match = true;
       migraphx::program_parameter_shapes param_shapes;
+      std::map<std::string, std::vector<std::size_t>> input_shapes;
+      std::map<std::string, std::vector<std::size_t>> program_shapes;
       if (no_input_shape) {
         for (auto& it : map_input_name_index) {
           auto& name = it.first;
@@ -1051,6 +1124,7 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
           const auto& tensor_shape = ort.GetTensorShape(tensor_info);
           std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
           cmp_options.set_input_parameter_shape(name, ort_lens);
+          input_shapes[name] = ort_lens;
           input_shape_match = false;
         }
       } else {
@@ -1066,6 +1140,7 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
               auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
               const auto& tensor_shape = ort.GetTensorShape(tensor_info);
               std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
+              input_shapes[name] = ort_lens;
 
               auto mgx_s = param_shapes[name];
               auto mgx_lens = mgx_s.lengths();
@@ -1074,6 +1149,7 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
                   mgx_strides.size() == 1 and mgx_strides[0] == 0) {
                 mgx_lens.clear();
               }
+              program_shapes[name] = mgx_lens;
 
               if (mgx_lens != ort_lens) {
                 cmp_options.set_input_parameter_shape(name, ort_lens);
@@ -1084,16 +1160,30 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
         }
       }
 
-      // input shapes are different, needs to re-parse onnx and
-      // re-compile the program
+      // input shapes are different, use the program compiled for these shapes if there is one, otherwise
+      // re-parse onnx and re-compile the program
       if (!input_shape_match) {
-        prog = migraphx::parse_onnx_buffer(onnx_string, cmp_options);
-        if (fp16_enable) {
-          migraphx::quantize_fp16(prog);
+        std::lock_guard<OrtMutex> lock(*(mgx_state->mgx_mu_ptr));
+        auto& programs = mgx_state->programs;
+        const std::string shapes_key = GetInputShapesKey(input_shapes);
+        auto it = std::find_if(programs.begin(), programs.end(),
+                               [&shapes_key](const auto& entry) { return entry.first == shapes_key; });
+        if (it != programs.end()) {
+          programs.splice(programs.begin(), programs, it);
+        } else {
+          // keep the program of the previous shapes, it may be used again
+          if (!no_input_shape && programs.empty()) {
+            programs.emplace_front(GetInputShapesKey(program_shapes), prog);
+          }
+          programs.emplace_front(shapes_key, CompileProgram(onnx_string, cmp_options, t, fp16_enable,
+                                                            mgx_state->model_cache_path, mgx_state->program_key,
+                                                            shapes_key));
+          while (programs.size() > mgx_state->program_cache_size) {
+            programs.pop_back();
+          }
         }
 
-        prog.compile(t);
-        mgx_state->prog = prog;
+        prog = programs.front().second;
         param_shapes = prog.get_parameter_shapes();
         no_input_shape = false;
       }
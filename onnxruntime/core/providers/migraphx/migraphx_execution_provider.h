@@ -5,6 +5,7 @@
 
 #include "core/framework/execution_provider.h"
 #include "core/platform/ort_mutex.h"
+#include <list>
 #include <map>
 #include "migraphx_inc.h"
 
@@ -12,6 +13,8 @@ namespace onnxruntime {
 
 namespace migraphx_env_vars {
 static const std::string kFP16Enable = "ORT_MIGRAPHX_FP16_ENABLE";
+static const std::string kModelCachePath = "ORT_MIGRAPHX_MODEL_CACHE_PATH";
+static const std::string kProgramCacheSize = "ORT_MIGRAPHX_PROGRAM_CACHE_SIZE";
 };
 
 // Information needed to construct amdmigraphx execution providers.
@@ -33,6 +36,13 @@ struct MIGraphXFuncState {
   OrtMutex* mgx_mu_ptr = nullptr;
   bool no_input_shape = false;
   bool fp16_enable = false;
+  // directory of the compiled programs saved on disk, none if empty
+  std::string model_cache_path;
+  // identifies the subgraph, precision and GPU architecture in the name of the saved programs
+  std::string program_key;
+  // programs compiled for the input shapes seen so far, most recently used first
+  std::list<std::pair<std::string, migraphx::program>> programs;
+  std::size_t program_cache_size = 0;
 };
 
 // Logical device representation.
@@ -54,6 +64,9 @@ class MIGraphXExecutionProvider : public IExecutionProvider {
 
 private:
   bool fp16_enable_ = false;
+  std::string model_cache_path_;
+  std::size_t program_cache_size_ = 8;
+  std::string gpu_arch_;
   int device_id_;
   migraphx::target t_; 
   OrtMutex mgx_mu_;
@@ -62,6 +75,7 @@ private:
   std::unordered_map<std::string, std::string> map_onnx_string_;
   std::unordered_map<std::string, std::unordered_map<std::string, std::size_t>> map_input_index_;
   std::unordered_map<std::string, bool> map_no_input_shape_;
+  std::unordered_map<std::string, std::string> map_program_key_;
 
   AllocatorPtr allocator_;
 };
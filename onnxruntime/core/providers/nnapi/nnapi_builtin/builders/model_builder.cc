@@ -594,6 +594,16 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model) {
           nnapi_model_->compilation_, static_cast<int32_t>(exe_pref_)),
       "on setPreference");
 
+  // Compilation caching is only supported on API 29+
+  if (!cache_dir_.empty() && GetAndroidSdkVer() >= 29 && nnapi_->ANeuralNetworksCompilation_setCaching) {
+    ORT_RETURN_IF_NOT(cache_token_.size() == ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN,
+                      "Invalid size of the NNAPI cache token: ", cache_token_.size());
+    RETURN_STATUS_ON_ERROR_WITH_NOTE(
+        nnapi_->ANeuralNetworksCompilation_setCaching(
+            nnapi_model_->compilation_, cache_dir_.c_str(), cache_token_.data()),
+        "on setCaching");
+  }
+
   RETURN_STATUS_ON_ERROR_WITH_NOTE(
       nnapi_->ANeuralNetworksCompilation_finish(nnapi_model_->compilation_),
       "on compilation finish");
@@ -80,10 +80,18 @@ class ModelBuilder {
   void SetTargetDeviceOption(TargetDeviceOption option) { target_device_option_ = option; }
 
   // Set NNAPI execution preference
-  // Default preference is PREFER_SUSTAINED_SPEED
+  // Default preference is PREFER_FAST_SINGLE_ANSWER
   void ExecutePreference(
       android::nn::wrapper::ExecutePreference pref) { exe_pref_ = pref; }
 
+  // Let NNAPI cache the compilation in cache_dir, under the given token of
+  // ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN bytes identifying the model
+  // It is only used on API 29+
+  void SetCaching(const std::string& cache_dir, const std::vector<uint8_t>& cache_token) {
+    cache_dir_ = cache_dir;
+    cache_token_ = cache_token;
+  }
+
   // Accessors for members
   Shaper& GetShaper() { return shaper_; }
 
@@ -124,6 +132,9 @@ class ModelBuilder {
   android::nn::wrapper::ExecutePreference exe_pref_{
       android::nn::wrapper::ExecutePreference::PREFER_FAST_SINGLE_ANSWER};
 
+  std::string cache_dir_;
+  std::vector<uint8_t> cache_token_;
+
   Shaper shaper_;
 
   std::unordered_map<std::string, uint32_t> operand_indices_;
@@ -543,6 +543,11 @@ bool PoolOpSupportChecker::IsOpSupportedImpl(const InitializedTensorSet& initial
       return false;
     }
 
+    if (is_qlinear_average_pool && helper.Get("channels_last", 0) != 0) {
+      LOGS_DEFAULT(VERBOSE) << "QLinearAveragePool with channels_last is not supported";
+      return false;
+    }
+
     if (helper.Get("kernel_shape", std::vector<int32_t>{1, 1}).size() != 2) {
       LOGS_DEFAULT(VERBOSE) << "Only pooling 2d is supported";
       return false;
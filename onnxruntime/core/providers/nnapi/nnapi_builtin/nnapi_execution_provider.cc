@@ -3,10 +3,13 @@
 
 #include "nnapi_execution_provider.h"
 
+#include <map>
+
 #include "builders/helper.h"
 #include "builders/op_support_checker.h"
 #include "core/framework/allocatormgr.h"
 #include "core/framework/compute_capability.h"
+#include "core/framework/murmurhash3.h"
 #include "core/graph/graph_viewer.h"
 #include "core/session/onnxruntime_cxx_api.h"
 #include "nnapi_lib/nnapi_implementation.h"
@@ -20,9 +23,10 @@ namespace onnxruntime {
 
 constexpr const char* NNAPI = "Nnapi";
 
-NnapiExecutionProvider::NnapiExecutionProvider(uint32_t nnapi_flags)
+NnapiExecutionProvider::NnapiExecutionProvider(uint32_t nnapi_flags, const std::string& cache_dir)
     : IExecutionProvider{onnxruntime::kNnapiExecutionProvider},
-      nnapi_flags_(nnapi_flags) {
+      nnapi_flags_(nnapi_flags),
+      cache_dir_(cache_dir) {
   AllocatorCreationInfo device_info(
       [](int) {
         return std::make_unique<CPUAllocator>(OrtMemoryInfo(NNAPI, OrtAllocatorType::OrtDeviceAllocator));
@@ -215,6 +219,56 @@ NnapiExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_view
 }
 
 #ifdef __ANDROID__
+// Computes the token under which NNAPI caches the compiled model of a partition, from everything the compilation
+// depends on: the nodes, initializers, inputs and outputs of the partition, and the NNAPI flags
+static std::vector<uint8_t> GetCacheToken(const GraphViewer& graph_viewer, uint32_t nnapi_flags) {
+  // Each value is hashed on its own so the initializers are not copied, and the token hashes all these hashes
+  std::string digest;
+  auto add = [&digest](const std::string& value) {
+    char hash[16];
+    MurmurHash3::x86_128(value.data(), gsl::narrow_cast<int32_t>(value.size()), 0, hash);
+    digest.append(hash, sizeof(hash));
+  };
+
+  add(std::to_string(nnapi_flags));
+  for (const auto* input : graph_viewer.GetInputs()) {
+    add(input->Name());
+    add(input->TypeAsProto() ? input->TypeAsProto()->SerializeAsString() : "");
+  }
+  for (const auto* output : graph_viewer.GetOutputs()) {
+    add(output->Name());
+  }
+
+  for (const auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const auto* node = graph_viewer.GetNode(node_index);
+    add(node->Domain() + ":" + node->OpType() + ":" + std::to_string(node->SinceVersion()));
+    for (const auto* input : node->InputDefs()) {
+      add(input->Name());
+    }
+    for (const auto* output : node->OutputDefs()) {
+      add(output->Name());
+    }
+    const std::map<std::string, ONNX_NAMESPACE::AttributeProto> attributes(node->GetAttributes().begin(),
+                                                                           node->GetAttributes().end());
+    for (const auto& attribute : attributes) {
+      add(attribute.second.SerializeAsString());
+    }
+  }
+
+  const auto& initializers = graph_viewer.GetAllInitializedTensors();
+  const std::map<std::string, const ONNX_NAMESPACE::TensorProto*> sorted_initializers(initializers.begin(),
+                                                                                      initializers.end());
+  for (const auto& initializer : sorted_initializers) {
+    add(initializer.first);
+    add(initializer.second->SerializeAsString());
+  }
+
+  std::vector<uint8_t> token(ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN);
+  MurmurHash3::x86_128(digest.data(), gsl::narrow_cast<int32_t>(digest.size()), 0, token.data());
+  MurmurHash3::x86_128(digest.data(), gsl::narrow_cast<int32_t>(digest.size()), 1, token.data() + 16);
+  return token;
+}
+
 static Status GetOutputBuffer(Ort::CustomOpApi& ort,
                               OrtKernelContext* context,
                               const nnapi::Model& model,
@@ -269,6 +323,12 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<FusedNodeAndGra
     if (nnapi_flags_ & NNAPI_FLAG_CPU_DISABLED) {
       builder.SetTargetDeviceOption(nnapi::ModelBuilder::TargetDeviceOption::CPU_DISABLED);
     }
+    if (nnapi_flags_ & NNAPI_FLAG_PREFER_SUSTAINED_SPEED) {
+      builder.ExecutePreference(ExecutePreference::PREFER_SUSTAINED_SPEED);
+    }
+    if (!cache_dir_.empty()) {
+      builder.SetCaching(cache_dir_, GetCacheToken(graph_viewer, nnapi_flags_));
+    }
 
     std::unique_ptr<nnapi::Model> nnapi_model;
     ORT_RETURN_IF_ERROR(builder.Compile(nnapi_model));
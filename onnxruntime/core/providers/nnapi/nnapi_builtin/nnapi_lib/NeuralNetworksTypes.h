@@ -162,6 +162,12 @@ enum {
   ANEURALNETWORKS_PREFER_SUSTAINED_SPEED = 2,
 };
 
+/**
+ * For {@link ANeuralNetworksCompilation_setCaching}, specify the size
+ * of the cache token required from the application. The size is in bytes.
+ */
+enum { ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN = 32 };
+
 /**
  * Result codes.
  */
@@ -9,6 +9,7 @@
 #include "core/codegen/common/target_info.h"
 
 #include "core/common/logging/logging.h"
+#include "core/framework/murmurhash3.h"
 #include "core/platform/env.h"
 #include "core/providers/common.h"
 #include "core/providers/nuphar/scripts/NUPHAR_CACHE_VERSION"
@@ -19,7 +20,9 @@
 #include <experimental/filesystem>
 #undef _SILENCE_EXPERIMENTAL_FILESYSTEM_DEPRECATION_WARNING
 #include <atomic>
+#include <cstdlib>
 #include <fstream>
+#include <iomanip>
 namespace fs = std::experimental::filesystem;
 
 namespace onnxruntime {
@@ -204,6 +207,110 @@ void SaveTVMModuleToCache(const std::string& filename, tvm::runtime::Module& mod
   }
 }
 
+static bool GetOrCreatePartitionCacheDirectory(fs::path& path, bool create) {
+  if (!GetOrCreateTVMModuleCacheDirectory(path, create))
+    return false;
+
+  path.append("partitions");
+  if (!create && !fs::is_directory(path))
+    return false;
+
+  if (!fs::is_directory(path))
+    if (!fs::create_directory(path)) {
+      throw std::runtime_error("Failed to create directory " + path.string());
+    }
+
+  return true;
+}
+
+std::string GetPartitionCacheKey(const tvm::Array<tvm::LoweredFunc>& lowered,
+                                 const std::string& func_name,
+                                 const tvm::Target& tvm_target,
+                                 const tvm::Target& tvm_host_target) {
+  std::ostringstream ir;
+  ir << tvm_target->str() << std::endl;
+  if (tvm_host_target.defined()) {
+    ir << tvm_host_target->str() << std::endl;
+  }
+  for (const auto& func : lowered) {
+    ir << func->args << std::endl
+       << func->body << std::endl;
+  }
+
+  // the func name shows up in the IR (e.g. in the compute scope), but depends on the order of compilation
+  std::string text = ir.str();
+  for (size_t pos = text.find(func_name); pos != std::string::npos; pos = text.find(func_name, pos)) {
+    text.replace(pos, func_name.size(), "$");
+  }
+
+  // hash the IR in chunks as MurmurHash3 takes an int length
+  constexpr size_t kChunkSize = size_t{1} << 30;
+  uint32_t hash[4] = {0, 0, 0, 0};
+  for (size_t offset = 0; offset < text.size(); offset += kChunkSize) {
+    const int len = static_cast<int>(std::min(kChunkSize, text.size() - offset));
+    MurmurHash3::x86_128(text.data() + offset, len, hash[0], &hash);
+  }
+
+  std::ostringstream key;
+  key << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    key << std::setw(8) << h;
+  }
+  return key.str();
+}
+
+bool LoadTVMPackedFuncFromPartitionCache(const std::string& key, tvm::runtime::PackedFunc& func) {
+  fs::path path;
+  if (!GetOrCreatePartitionCacheDirectory(path, /*create*/ false))
+    return false;
+
+  path.append(key + ".so");
+  if (!fs::is_regular_file(path))
+    return false;
+
+  tvm::runtime::Module module = tvm::runtime::Module::LoadFromFile(path.string());
+  // the symbol is named after the run that compiled it, so look it up through the module entry
+  func = module.GetFunction(tvm::runtime::symbol::tvm_module_main);
+  return func != nullptr;
+}
+
+void SaveTVMModuleToPartitionCache(const std::string& key, tvm::runtime::Module& module) {
+#ifdef _WIN32
+  // linking requires the MSVC toolchain, so on Windows the saved objects are linked by create_shared.cmd
+  ORT_UNUSED_PARAMETER(key);
+  ORT_UNUSED_PARAMETER(module);
+#else
+  fs::path path;
+
+  static std::mutex save_cache_mutex;
+  std::lock_guard<std::mutex> lock(save_cache_mutex);
+  if (!GetOrCreatePartitionCacheDirectory(path, /*create*/ true))
+    return;
+
+  fs::path so_path = path;
+  so_path.append(key + ".so");
+  if (fs::exists(so_path))
+    return;
+
+  // link into a file private to this process and rename it, so other processes never load a partial file
+  const std::string tmp_name = key + "." + std::to_string(Env::Default().GetSelfPid());
+  fs::path obj_path = path;
+  obj_path.append(tmp_name + ".o");
+  fs::path tmp_so_path = path;
+  tmp_so_path.append(tmp_name + ".so");
+
+  module->SaveToFile(obj_path.string(), "o");
+  const std::string link_cmd = "g++ -shared -fPIC -o \"" + tmp_so_path.string() + "\" \"" + obj_path.string() + "\"";
+  if (std::system(link_cmd.c_str()) == 0) {
+    fs::rename(tmp_so_path, so_path);
+  } else {
+    LOGS_DEFAULT(WARNING) << "Failed to link " << obj_path << " into the Nuphar partition cache";
+    fs::remove(tmp_so_path);
+  }
+  fs::remove(obj_path);
+#endif
+}
+
 std::string GetPackedFuncName(const nuphar::NupharSubgraphUnit& subgraph, const CodeGenTarget& codegen_target, int64_t parallel_min_workloads) {
   // in C, a function does not allow its name starting with a digit.
   return NormalizeCppName("_" + subgraph.UniqueId() + "_" + codegen_target.GetTargetName() + "_p" + std::to_string(parallel_min_workloads));
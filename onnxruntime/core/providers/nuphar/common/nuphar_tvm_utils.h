@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <tvm/build_module.h>
 #include <tvm/tvm.h>
 #include <string>
 
@@ -30,6 +31,16 @@ enum class CacheStatus {
 CacheStatus LoadTVMPackedFuncFromCache(const std::string& func_name, tvm::runtime::PackedFunc& func);
 void SaveTVMModuleToCache(const std::string& filename, tvm::runtime::Module& module);
 
+// Helper functions for the partition cache, which is used automatically when a cache path is set
+// and no linked dll has the function. Each compiled function is linked into its own shared object,
+// named by a hash of its lowered IR and target, so a later run with the same model loads it directly.
+std::string GetPartitionCacheKey(const tvm::Array<tvm::LoweredFunc>& lowered,
+                                 const std::string& func_name,
+                                 const tvm::Target& tvm_target,
+                                 const tvm::Target& tvm_host_target);
+bool LoadTVMPackedFuncFromPartitionCache(const std::string& key, tvm::runtime::PackedFunc& func);
+void SaveTVMModuleToPartitionCache(const std::string& key, tvm::runtime::Module& module);
+
 std::string GetPackedFuncName(const nuphar::NupharSubgraphUnit& subgraph, const CodeGenTarget& codegen_target, int64_t parallel_min_workloads);
 
 bool TryCreateConstantScalar(tvm::Expr& scalar, const Tensor* tensor);
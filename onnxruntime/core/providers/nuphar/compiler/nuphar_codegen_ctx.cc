@@ -62,10 +62,18 @@ static tvm::runtime::PackedFunc LowerLayoutFunc(const tvm_codegen::WeightLayout*
   if (cache_status != nuphar::CacheStatus::Found) {
     ORT_ENFORCE(cached_func == nullptr);
     auto lowered = tvm::lower(S, {inputs[0], outputs[0]}, func_name, {}, config);
+    std::string partition_key;
+    if (cache_status == nuphar::CacheStatus::Missing) {
+      partition_key = nuphar::GetPartitionCacheKey(lowered, func_name, tvm::target::llvm(), tvm::Target());
+      if (nuphar::LoadTVMPackedFuncFromPartitionCache(partition_key, cached_func)) {
+        return cached_func;
+      }
+    }
     auto module = tvm::build(lowered, tvm::target::llvm(), tvm::Target(), config);
     tvm_codegen::DumpTVMModuleToFile(func_name, module);
     if (cache_status == nuphar::CacheStatus::Missing) {
       nuphar::SaveTVMModuleToCache(func_name, module);
+      nuphar::SaveTVMModuleToPartitionCache(partition_key, module);
     }
     cached_func = module.GetFunction(func_name);
   }
@@ -166,6 +166,15 @@ tvm::runtime::PackedFunc NupharCompiler::GetLoweredPackedFunc(
     std::unordered_map<tvm::Tensor, tvm::Buffer> binds;
     tvm::Array<tvm::LoweredFunc> lowered = tvm::lower(tvm_schedule, tvm_args_, func_name, binds, config);
 
+    // without a linked cache dll, look up the object compiled for the same IR and target by an earlier run
+    std::string partition_key;
+    if (cache_status == nuphar::CacheStatus::Missing) {
+      partition_key = nuphar::GetPartitionCacheKey(lowered, func_name, tvm_target, tvm_host_target);
+      if (nuphar::LoadTVMPackedFuncFromPartitionCache(partition_key, cached_func)) {
+        return cached_func;
+      }
+    }
+
     if (settings.HasOption(codegen::CodeGenSettings::kCodeGenDumpLower)) {
       if (settings.OptionMatches(codegen::CodeGenSettings::kCodeGenDumpLower, "verbose") ||
           settings.OptionMatches(codegen::CodeGenSettings::kCodeGenDumpLower, subgraph_type)) {
@@ -183,6 +192,7 @@ tvm::runtime::PackedFunc NupharCompiler::GetLoweredPackedFunc(
     tvm_codegen::DumpTVMModuleToFile(func_name, module);
     if (cache_status == nuphar::CacheStatus::Missing) {
       nuphar::SaveTVMModuleToCache(func_name, module);
+      nuphar::SaveTVMModuleToPartitionCache(partition_key, module);
     }
     cached_func = module.GetFunction(func_name);
   }
@@ -205,26 +215,37 @@ static tvm::BuildConfig CreateConfig(const Node& node,
   return config;
 }
 
-// Lower compiles the tvm::Tensor to a function
-Status NupharCompiler::Lower(const nuphar::NupharSubgraphUnit& subgraph,
-                             tvm::Target tvm_target,
-                             tvm::Target tvm_host_target,
-                             NupharFuncInfo* func_info,
-                             nuphar::OrtSubgraphAllocationInfo* partition_info) {
+// Codegen compiles the tvm::Tensor to a function
+Status NupharCompiler::Codegen(const nuphar::NupharSubgraphUnit& subgraph,
+                               tvm::Target tvm_target,
+                               tvm::Target tvm_host_target) {
   const auto& codegen_handle = context_.GetCodeGenHandle();
   const auto& target_codegen = *codegen_handle->codegen_target;
-  std::string func_name = nuphar::GetPackedFuncName(subgraph, target_codegen, codegen_handle->parallel_min_workloads);
+  func_name_ = nuphar::GetPackedFuncName(subgraph, target_codegen, codegen_handle->parallel_min_workloads);
   tvm::BuildConfig config = CreateConfig(*subgraph.nodes.front(),
                                          context_.GetCodeGenHandle()->allow_unaligned_buffers);
 
   // using "subgraph" for type and name for now
   // TODO: change name
-  tvm::runtime::PackedFunc cached_func =
+  packed_func_ =
       GetLoweredPackedFunc(
-          func_name, tvm_target, tvm_host_target,
+          func_name_, tvm_target, tvm_host_target,
           config, "subgraph", "subgraph");
 
-  FillNupharFuncInfo(func_info, partition_info, subgraph, context_, tvm_target, cached_func, func_name);
+  return Status::OK();
+}
+
+// Lower fills in the func info of the compiled function
+Status NupharCompiler::Lower(const nuphar::NupharSubgraphUnit& subgraph,
+                             tvm::Target tvm_target,
+                             tvm::Target tvm_host_target,
+                             NupharFuncInfo* func_info,
+                             nuphar::OrtSubgraphAllocationInfo* partition_info) {
+  if (packed_func_ == nullptr) {
+    ORT_RETURN_IF_ERROR(Codegen(subgraph, tvm_target, tvm_host_target));
+  }
+
+  FillNupharFuncInfo(func_info, partition_info, subgraph, context_, tvm_target, packed_func_, func_name_);
 
   return Status::OK();
 }
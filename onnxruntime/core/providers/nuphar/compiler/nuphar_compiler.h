@@ -34,7 +34,13 @@ class NupharCompiler {
   // Build builds tvm IR and apply passes
   Status Build(const nuphar::NupharSubgraphUnit& subgraph);
 
-  // Lower lowers the built tvm IR to llvm ir and compiles it
+  // Codegen lowers the built tvm IR to llvm ir and compiles it, or loads it from the cache.
+  // It does not touch state shared with other subgraphs, so it may run concurrently across compilers.
+  Status Codegen(const nuphar::NupharSubgraphUnit& subgraph,
+                 tvm::Target tvm_target,
+                 tvm::Target tvm_host_target);
+
+  // Lower fills in the func info of the compiled function, calling Codegen first if it has not run yet
   Status Lower(const nuphar::NupharSubgraphUnit& subgraph,
                tvm::Target tvm_target,
                tvm::Target tvm_host_target,
@@ -59,6 +65,10 @@ class NupharCompiler {
 
   tvm::Array<tvm::Tensor> tvm_args_;
   tvm::Array<tvm::Tensor> tvm_outputs_;
+
+  // result of Codegen
+  std::string func_name_;
+  tvm::runtime::PackedFunc packed_func_;
 };
 
 }  // namespace nuphar
@@ -13,6 +13,10 @@
 #include "core/providers/nuphar/runtime/sequential/basic.h"
 #include "core/providers/nuphar/runtime/sequential/loop.h"
 
+#include <atomic>
+#include <exception>
+#include <thread>
+
 namespace onnxruntime {
 namespace nuphar {
 
@@ -35,11 +39,9 @@ NupharKernelState::NupharKernelState(
       subgraphs,
       [&](const std::string& name) { return provider_.GetConstantInitializer(name); });
 
-  for (auto& subgraph : subgraphs) {
-    Compile(subgraph);
-    if (!codegen_status_.IsOK()) {
-      return;  // early return
-    }
+  Compile(subgraphs);
+  if (!codegen_status_.IsOK()) {
+    return;  // early return
   }
 
   // Currently BuildExecBlocksAndCalls is inserted here
@@ -47,23 +49,66 @@ NupharKernelState::NupharKernelState(
   BuildExecBlocksAndCalls(subgraphs);
 }
 
-void NupharKernelState::Compile(const NupharSubgraphUnit& subgraph) {
+void NupharKernelState::Compile(const std::vector<NupharSubgraphUnit>& subgraphs) {
   // TODO: rename tvm_target to a proper name
   auto tvm_target = provider_.GetTVMTarget();
+  auto tvm_host_target = provider_.GetTVMHostTarget();
+
+  // Build shares generated initializers across subgraphs, so it runs sequentially
+  std::vector<std::unique_ptr<NupharCompiler>> compilers;
+  for (const auto& subgraph : subgraphs) {
+    compilers.push_back(std::make_unique<NupharCompiler>(subgraph,
+                                                         generated_initializers_,
+                                                         provider_.GetNupharCodeGenHandle()));
+    codegen_status_ = compilers.back()->Build(subgraph);
+    if (!codegen_status_.IsOK()) {
+      return;
+    }
+  }
 
-  NupharCompiler tvm_compiler(subgraph,
-                              generated_initializers_,
-                              provider_.GetNupharCodeGenHandle());
+  // Codegen of each subgraph is independent, and dominates the compile time, so spread it over threads
+  std::vector<Status> statuses(subgraphs.size());
+  std::vector<std::exception_ptr> exceptions(subgraphs.size());
+  std::atomic<size_t> next_subgraph{0};
+  auto codegen = [&]() {
+    for (size_t idx = next_subgraph++; idx < subgraphs.size(); idx = next_subgraph++) {
+      try {
+        statuses[idx] = compilers[idx]->Codegen(subgraphs[idx], tvm_target, tvm_host_target);
+      } catch (...) {
+        exceptions[idx] = std::current_exception();
+      }
+    }
+  };
 
-  codegen_status_ = tvm_compiler.Build(subgraph);
+  size_t num_threads = std::min<size_t>(subgraphs.size(), std::thread::hardware_concurrency());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(codegen);
+  }
+  codegen();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Lower assigns allocations in partition_info_, so it runs sequentially in subgraph order
+  for (size_t idx = 0; idx < subgraphs.size(); ++idx) {
+    if (exceptions[idx]) {
+      std::rethrow_exception(exceptions[idx]);
+    }
+    codegen_status_ = statuses[idx];
+    if (!codegen_status_.IsOK()) {
+      return;
+    }
 
-  if (codegen_status_.IsOK()) {
     func_infos_.emplace_back(std::make_unique<NupharFuncInfo>());
-    codegen_status_ = tvm_compiler.Lower(subgraph,
-                                         tvm_target,
-                                         provider_.GetTVMHostTarget(),
-                                         func_infos_.back().get(),
-                                         partition_info_.get());
+    codegen_status_ = compilers[idx]->Lower(subgraphs[idx],
+                                            tvm_target,
+                                            tvm_host_target,
+                                            func_infos_.back().get(),
+                                            partition_info_.get());
+    if (!codegen_status_.IsOK()) {
+      return;
+    }
   }
 }
 
@@ -240,6 +240,8 @@ void BackendManager::Compute(Ort::CustomOpApi api, OrtKernelContext* context) {
     std::vector<std::vector<int64_t>> tensor_shapes = GetInputTensorShapes(api, context);
     auto key = MakeMapKeyString(tensor_shapes, GetGlobalContext().device_type);
 
+    // Concurrent Runs share the backends, and run in parallel on their pools of infer requests
+    std::unique_lock<std::mutex> lock(backend_map_mutex_);
     if (GetGlobalContext().device_type.find("MYRIAD") != std::string::npos) {
       for (size_t i = 0; i < subgraph_context_.input_indexes.size(); i++) {
         if (tensor_shapes[i].size() != 4)
@@ -261,6 +263,7 @@ void BackendManager::Compute(Ort::CustomOpApi api, OrtKernelContext* context) {
     } else {
       dynamic_backend = search->second;
     }
+    lock.unlock();
 
     dynamic_backend->Infer(api, context);
   } else {
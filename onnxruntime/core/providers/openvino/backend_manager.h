@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <inference_engine.hpp>
 
 #include "contexts.h"
@@ -36,6 +37,8 @@ class BackendManager {
   std::unique_ptr<ONNX_NAMESPACE::ModelProto> model_proto_;
   std::shared_ptr<IBackend> concrete_backend_;
   std::map<std::string, std::shared_ptr<IBackend>> backend_map_;
+  // guards backend_map_ and subgraph_context_ for concurrent Runs
+  std::mutex backend_map_mutex_;
   SubGraphContext subgraph_context_;
 };
 
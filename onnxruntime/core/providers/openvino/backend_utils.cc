@@ -1,6 +1,8 @@
 // Copyright(C) 2019 Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
+#include <cctype>
 #include <map>
 #include <string>
 #include <memory>
@@ -92,6 +94,28 @@ void CreateDirectory(const std::string& ov_compiled_blobs_dir) {
 #endif
 }
 
+std::string GetCompiledBlobName(const ONNX_NAMESPACE::ModelProto& model_proto, const GlobalContext& global_context,
+                                const std::string& hw_target) {
+  // 64-bit FNV-1a, so that the names are the same across processes and platforms
+  const std::string key = model_proto.SerializeAsString() + "|" + hw_target + "|" + global_context.precision_str +
+                          "|" + std::to_string(global_context.enable_vpu_fast_compile) +
+                          "|" + std::to_string(global_context.num_streams);
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+
+  // the build number has separators like '/', keep it readable in the file name
+  std::string ov_version = InferenceEngine::GetInferenceEngineVersion()->buildNumber;
+  std::replace_if(
+      ov_version.begin(), ov_version.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '.'; }, '_');
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash << "_" << hw_target << "_ov_" << ov_version << ".blob";
+  return name.str();
+}
+
 struct static_cast_int64 {
   template <typename T1>  // T1 models type statically convertible to T
   int64_t operator()(const T1& x) const { return static_cast<int64_t>(x); }
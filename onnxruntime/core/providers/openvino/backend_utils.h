@@ -37,6 +37,11 @@ bool IsDirExists(const std::string& pathname);
 
 void CreateDirectory(const std::string& ov_compiled_blobs_dir);
 
+// Name of the file caching the network compiled for the subgraph, derived from a hash of the subgraph,
+// the target device, the options affecting the compilation and the OpenVINO build
+std::string GetCompiledBlobName(const ONNX_NAMESPACE::ModelProto& model_proto, const GlobalContext& global_context,
+                                const std::string& hw_target);
+
 void SetIODefs(const ONNX_NAMESPACE::ModelProto& model_proto,
                std::shared_ptr<InferenceEngine::CNNNetwork> network,
                std::unordered_map<std::string, int> output_names,
@@ -1,6 +1,8 @@
 // Copyright(C) 2019 Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
+#include <cstdio>
 #include <map>
 #include <string>
 #include <memory>
@@ -36,41 +38,32 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
                            const SubGraphContext& subgraph_context)
     : global_context_(global_context), subgraph_context_(subgraph_context) {
   std::string& hw_target = (global_context_.device_id != "") ? global_context_.device_id : global_context_.device_type;
-  bool vpu_status = false;
+  bool cached_blob_status = false;
   bool import_blob_status = false;
-  std::string model_blob_name;
-  std::ifstream blob_path;
-  std::string ov_compiled_blobs_dir = "";
+  std::string model_blob_path;
 
-  if(hw_target == "MYRIAD" && global_context_.use_compiled_network == true) {
-    if(!openvino_ep::backend_utils::UseCompiledNetwork()) {
-      std::size_t model_index = global_context_.onnx_model_path_name.find_last_of("/\\");
-      std::string model_name= global_context_.onnx_model_path_name.substr(model_index+1);
-      std::size_t model_extension_index = model_name.find_last_of(".");
-      if(openvino_ep::BackendManager::GetGlobalContext().is_wholly_supported_graph) {
-          model_blob_name = global_context_.onnx_model_name + "_" + "op_v_" + std::to_string(global_context_.onnx_opset_version) + "_" + model_name.substr(0,model_extension_index) + "_" + hw_target + "_" + subgraph_context_.subgraph_name + "_ov_" + "fully" + ".blob";
-      }
-      else {
-          model_blob_name = global_context_.onnx_model_name + "_" + "op_v_" + std::to_string(global_context_.onnx_opset_version) + "_" + model_name.substr(0,model_extension_index) + "_" + hw_target + "_" + subgraph_context_.subgraph_name + "_ov_" + "partially" + ".blob";
-      }
-      if(global_context_.blob_dump_path == "" || global_context_.blob_dump_path == "\"" || global_context_.blob_dump_path.empty()) {
-        ov_compiled_blobs_dir = openvino_ep::backend_utils::GetCurrentWorkingDir() + "/ov_compiled_blobs/";
-      } else {
-        ov_compiled_blobs_dir = global_context_.blob_dump_path + "/ov_compiled_blobs";
-      }
-      if(openvino_ep::backend_utils::IsDirExists(ov_compiled_blobs_dir)) {
-        LOGS_DEFAULT(INFO) << log_tag << "'ov_compiled_blobs' directory already exists at the executable path";
-      }
-      else {
-        CreateDirectory(ov_compiled_blobs_dir);
-      }
-      blob_path.open(ov_compiled_blobs_dir + "/" + model_blob_name);
-      if (!blob_path.is_open()) {
-          LOGS_DEFAULT(INFO) << log_tag << "Device specific Compiled blob doesn't exist for this model";
-      } else {
-          LOGS_DEFAULT(INFO) << log_tag << "Device specific Compiled blob already exists for this model";
-          vpu_status = true;
-      }
+  // Compiling a network takes from seconds to a minute on the MYRIAD, HDDL and GPU plugins, so the compiled networks
+  // are exported to the cache directory and imported by the later sessions creating the same subgraph
+  if (global_context_.use_compiled_network && !openvino_ep::backend_utils::UseCompiledNetwork()) {
+    std::string ov_compiled_blobs_dir;
+    if(global_context_.blob_dump_path == "" || global_context_.blob_dump_path == "\"" || global_context_.blob_dump_path.empty()) {
+      ov_compiled_blobs_dir = openvino_ep::backend_utils::GetCurrentWorkingDir() + "/ov_compiled_blobs/";
+    } else {
+      ov_compiled_blobs_dir = global_context_.blob_dump_path + "/ov_compiled_blobs";
+    }
+    if(openvino_ep::backend_utils::IsDirExists(ov_compiled_blobs_dir)) {
+      LOGS_DEFAULT(INFO) << log_tag << "'ov_compiled_blobs' directory already exists at the executable path";
+    }
+    else {
+      CreateDirectory(ov_compiled_blobs_dir);
+    }
+    model_blob_path = ov_compiled_blobs_dir + "/" + GetCompiledBlobName(model_proto, global_context_, hw_target);
+    std::ifstream blob_file(model_blob_path, std::ios::binary | std::ios::in);
+    if (!blob_file.is_open()) {
+        LOGS_DEFAULT(INFO) << log_tag << "Device specific Compiled blob doesn't exist for this subgraph";
+    } else {
+        LOGS_DEFAULT(INFO) << log_tag << "Device specific Compiled blob already exists for this subgraph";
+        cached_blob_status = true;
     }
   }
 
@@ -90,29 +83,36 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
     }
   }
 
-  if (vpu_status == true || openvino_ep::backend_utils::UseCompiledNetwork()) {
-    const std::string model_blob_path = ov_compiled_blobs_dir + "/" + model_blob_name;
+  if (cached_blob_status) {
+    try {
+      LOGS_DEFAULT(INFO) << log_tag << "Importing the pre-compiled blob for this subgraph which already exists in the directory 'ov_compiled_blobs'";
+      exe_network_ = global_context_.ie_core.ImportNetwork(model_blob_path, hw_target, {});
+      import_blob_status = true;
+    } catch (Exception &e) {
+      // a blob that can't be imported anymore, e.g. truncated by an interrupted export, is compiled and exported again
+      LOGS_DEFAULT(WARNING) << log_tag << "Could not import the cached blob " << model_blob_path << ": " << e.what();
+    } catch(...) {
+      LOGS_DEFAULT(WARNING) << log_tag << "Could not import the cached blob " << model_blob_path;
+    }
+  } else if (openvino_ep::backend_utils::UseCompiledNetwork()) {
     const std::string compiled_blob_path = onnxruntime::GetEnvironmentVar("OV_BLOB_PATH");
     try {
-      if(vpu_status == true) {
-        LOGS_DEFAULT(INFO) << log_tag << "Importing the pre-compiled blob for this model which already exists in the directory 'ov_compiled_blobs'";
-        exe_network_ = global_context_.ie_core.ImportNetwork(model_blob_path, hw_target, {});
-      } else {
-        LOGS_DEFAULT(INFO) << log_tag << "Importing the pre-compiled blob from the path set by the user";
-        if (compiled_blob_path.empty())
-          throw std::runtime_error("The compiled blob path is not set");
-        exe_network_ = global_context_.ie_core.ImportNetwork(compiled_blob_path, hw_target, {});
-      }
+      LOGS_DEFAULT(INFO) << log_tag << "Importing the pre-compiled blob from the path set by the user";
+      if (compiled_blob_path.empty())
+        throw std::runtime_error("The compiled blob path is not set");
+      exe_network_ = global_context_.ie_core.ImportNetwork(compiled_blob_path, hw_target, {});
     } catch (Exception &e) {
       ORT_THROW(log_tag + " Exception while Importing Network for graph: " + subgraph_context_.subgraph_name + ": " + e.what());
     } catch(...) {
       ORT_THROW(log_tag + " Exception while Importing Network for graph: " + subgraph_context_.subgraph_name);
     }
     import_blob_status = true;
+  }
+  if (import_blob_status) {
     LOGS_DEFAULT(INFO) << log_tag << "Succesfully Created an executable network from a previously exported network";
   }
 
-  if ((global_context_.use_compiled_network == true && import_blob_status == false) || vpu_status == false) {
+  if (!import_blob_status) {
     if(!openvino_ep::backend_utils::UseCompiledNetwork()) {
       ie_cnn_network_ = CreateCNNNetwork(model_proto, global_context_, subgraph_context_, const_outputs_map_);
       SetIODefs(model_proto, ie_cnn_network_, subgraph_context_.output_names, const_outputs_map_, global_context_.device_type);
@@ -153,6 +153,7 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
       config["MYRIAD_CHECK_PREPROCESSING_INSIDE_MODEL"] = CONFIG_VALUE(NO);
     #endif
       }
+      SetThroughputStreams(hw_target, config);
       try {
         exe_network_ = global_context_.ie_core.LoadNetwork(*ie_cnn_network_, hw_target, config);
       } catch (const Exception& e) {
@@ -161,16 +162,32 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
         ORT_THROW(log_tag + " Exception while Loading Network for graph " + subgraph_context_.subgraph_name);
       }
       LOGS_DEFAULT(INFO) << log_tag << "Loaded model to the plugin";
-      if(global_context_.use_compiled_network && hw_target == "MYRIAD") {
-        LOGS_DEFAULT(INFO) << log_tag << "Dumping the compiled blob for this model into the directory 'ov_compiled_blobs'";
-        std::ofstream compiled_blob_dump{ov_compiled_blobs_dir + "/" + model_blob_name};
-        exe_network_.Export(compiled_blob_dump);
+      if(!model_blob_path.empty()) {
+        LOGS_DEFAULT(INFO) << log_tag << "Dumping the compiled blob for this subgraph into the directory 'ov_compiled_blobs'";
+        try {
+          std::ofstream compiled_blob_dump{model_blob_path, std::ios::binary | std::ios::out};
+          exe_network_.Export(compiled_blob_dump);
+        } catch (...) {
+          // not every plugin can export its networks, which are then compiled by every session
+          LOGS_DEFAULT(WARNING) << log_tag << "Could not export the compiled blob for graph " << subgraph_context_.subgraph_name
+                                << " on " << hw_target;
+          std::remove(model_blob_path.c_str());
+        }
       }
     }
   }
   //The infer_requests_ pool will be intialized with a default value of 8 infer_request's
   //The nireq value can also be configured to any num_of_threads during runtime
   size_t nireq = global_context_.num_of_threads;
+  if (nireq == 0) {
+    //With throughput streams, the pool holds the number of requests the device needs to keep all its streams busy
+    nireq = global_context_.num_streams;
+    try {
+      nireq = std::max<size_t>(nireq, exe_network_.GetMetric(METRIC_KEY(OPTIMAL_NUMBER_OF_INFER_REQUESTS)).as<unsigned int>());
+    } catch (...) {
+      LOGS_DEFAULT(INFO) << log_tag << "The device does not report its optimal number of infer requests";
+    }
+  }
   LOGS_DEFAULT(INFO) << log_tag << "The value of nireq being used is: " << nireq;
 #ifndef NDEBUG
   if (openvino_ep::backend_utils::IsDebugEnabled()) {
@@ -180,6 +197,27 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
   inferRequestsQueue_ = std::unique_ptr<InferRequestsQueue>(new InferRequestsQueue(exe_network_, nireq));
 }
 
+// Splits the device into several streams, each running its own infer requests, so that concurrent Runs execute in
+// parallel instead of one after the other on the whole device.
+void BasicBackend::SetThroughputStreams(const std::string& hw_target, std::map<std::string, std::string>& config) const {
+  if (global_context_.num_streams == 0) {
+    return;
+  }
+  const std::string num_streams = std::to_string(global_context_.num_streams);
+  if (hw_target.find("CPU") != std::string::npos) {
+    config["CPU_THROUGHPUT_STREAMS"] = num_streams;
+  }
+  if (hw_target.find("GPU") != std::string::npos) {
+    config["GPU_THROUGHPUT_STREAMS"] = num_streams;
+  }
+#if !defined(OPENVINO_2020_3)
+  if (hw_target.find("MYRIAD") != std::string::npos) {
+    config["MYRIAD_THROUGHPUT_STREAMS"] = num_streams;
+  }
+#endif
+  LOGS_DEFAULT(INFO) << log_tag << "Using " << num_streams << " throughput streams";
+}
+
 // Starts an asynchronous inference request for data in slice indexed by batch_slice_idx on
 // an Infer Request indexed by infer_req_idx
 void BasicBackend::StartAsyncInference(Ort::CustomOpApi& ort, OrtKernelContext* context, std::shared_ptr<InferenceEngine::InferRequest> infer_request) {
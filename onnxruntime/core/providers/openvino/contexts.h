@@ -15,6 +15,7 @@ struct GlobalContext {
   bool enable_vpu_fast_compile = false;
   bool use_compiled_network = false;
   size_t num_of_threads;
+  size_t num_streams = 0;
   std::string device_type;
   std::string precision_str;
   std::string device_id;
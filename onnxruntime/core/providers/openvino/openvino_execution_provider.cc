@@ -21,8 +21,12 @@ OpenVINOExecutionProvider::OpenVINOExecutionProvider(const OpenVINOExecutionProv
   openvino_ep::BackendManager::GetGlobalContext().use_compiled_network = info.use_compiled_network_;
   openvino_ep::BackendManager::GetGlobalContext().blob_dump_path = info.blob_dump_path_;
 
+  openvino_ep::BackendManager::GetGlobalContext().num_streams = info.num_streams_;
+
+  // With throughput streams, the number of infer requests defaults to the optimal number reported by the device
+  // once the network is loaded.
   if ((int)info.num_of_threads_ <= 0) {
-    openvino_ep::BackendManager::GetGlobalContext().num_of_threads = 8;
+    openvino_ep::BackendManager::GetGlobalContext().num_of_threads = info.num_streams_ > 0 ? 0 : 8;
   } else {
     openvino_ep::BackendManager::GetGlobalContext().num_of_threads = info.num_of_threads_;
   }
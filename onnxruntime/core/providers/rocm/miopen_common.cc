@@ -5,10 +5,28 @@
 #include "gsl/gsl"
 #include "shared_inc/rocm_call.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/common/logging/logging.h"
+#include "core/platform/env.h"
+
+#include <cstdlib>
+#include <mutex>
 
 namespace onnxruntime {
 namespace rocm {
 
+void SetMiopenUserDbPath(const std::string& path) {
+  static std::once_flag once;
+  std::call_once(once, [&path]() {
+    const Status status = Env::Default().CreateFolder(path);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "MIOpen user db path " << path << " is not usable: " << status.ErrorMessage();
+      return;
+    }
+    setenv("MIOPEN_USER_DB_PATH", path.c_str(), 0);
+    setenv("MIOPEN_CUSTOM_CACHE_DIR", path.c_str(), 0);
+  });
+}
+
 MiopenTensor::MiopenTensor()
     : tensor_(nullptr) {
 }
@@ -8,6 +8,7 @@
 #include "rocm_common.h"
 #include "core/framework/tensor.h"
 #include <cfloat>
+#include <string>
 
 namespace onnxruntime {
 namespace rocm {
@@ -32,6 +33,12 @@ class MiopenTensor final {
   miopenTensorDescriptor_t tensor_;
 };
 
+// Makes MIOpen persist its find-db, perf-db and compiled kernels in the given directory, so that the
+// algorithm search and kernel compilation for a shape happen once instead of once per process. It must be called
+// before the first MIOpen handle is created. MIOpen keys these files by device architecture and compute unit
+// count, so devices of different kinds can share the directory. A location set in the environment is kept.
+void SetMiopenUserDbPath(const std::string& path);
+
 template <typename ElemType>
 struct Consts {
   static const ElemType Zero;
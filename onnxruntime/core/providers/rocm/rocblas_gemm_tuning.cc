@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/rocm/rocblas_gemm_tuning.h"
+
+#include <atomic>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "core/common/logging/logging.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/rocm/shared_inc/rocm_call.h"
+
+// rocblas_gemm_ex_get_solutions is part of the beta API of rocBLAS 2.44 and later.
+#if defined(ROCBLAS_BETA_FEATURES_API) && \
+    (ROCBLAS_VERSION_MAJOR > 2 || (ROCBLAS_VERSION_MAJOR == 2 && ROCBLAS_VERSION_MINOR >= 44))
+#define ORT_ROCBLAS_GEMM_SOLUTIONS
+#endif
+
+namespace onnxruntime {
+namespace rocm {
+
+namespace {
+
+std::atomic<bool> gemm_tuning_enabled{false};
+
+#ifdef ORT_ROCBLAS_GEMM_SOLUTIONS
+constexpr int kTuningIterations = 3;
+
+// device, transa, transb, m, n, k, lda, ldb, ldc, data type, compute type
+using GemmKey = std::tuple<int, int, int, int, int, int, int, int, int, int, int>;
+
+OrtMutex solution_cache_mutex;
+std::map<GemmKey, int> solution_cache;
+
+size_t DataTypeSize(rocblas_datatype data_type) {
+  return data_type == rocblas_datatype_f16_r ? 2 : 4;
+}
+
+// Returns the index of the fastest solution, or 0 for the default selection of rocBLAS.
+// The candidates write to a scratch buffer so that C keeps its content when beta is not zero.
+int FindFastestSolution(rocblas_handle handle, rocblas_operation transa, rocblas_operation transb,
+                        int m, int n, int k, const void* alpha, const void* A, int lda, const void* B, int ldb,
+                        const void* beta, const void* C, int ldc, rocblas_datatype data_type,
+                        rocblas_datatype compute_type) {
+  void* D = nullptr;
+  hipStream_t stream = nullptr;
+  hipEvent_t start = nullptr;
+  hipEvent_t stop = nullptr;
+  if (rocblas_get_stream(handle, &stream) != rocblas_status_success ||
+      hipMalloc(&D, static_cast<size_t>(ldc) * n * DataTypeSize(data_type)) != hipSuccess) {
+    return 0;
+  }
+
+  auto run = [&](rocblas_gemm_algo algo, int solution) {
+    return rocblas_gemm_ex(handle, transa, transb, m, n, k, alpha, A, data_type, lda, B, data_type, ldb, beta,
+                           C, data_type, ldc, D, data_type, ldc, compute_type, algo, solution, 0);
+  };
+
+  std::vector<rocblas_int> solutions;
+  rocblas_int solution_count = 0;
+  if (rocblas_gemm_ex_get_solutions(handle, transa, transb, m, n, k, alpha, A, data_type, lda, B, data_type, ldb,
+                                    beta, C, data_type, ldc, D, data_type, ldc, compute_type,
+                                    rocblas_gemm_algo_solution_index, 0, nullptr, &solution_count) ==
+          rocblas_status_success &&
+      solution_count > 0) {
+    solutions.resize(solution_count);
+    if (rocblas_gemm_ex_get_solutions(handle, transa, transb, m, n, k, alpha, A, data_type, lda, B, data_type, ldb,
+                                      beta, C, data_type, ldc, D, data_type, ldc, compute_type,
+                                      rocblas_gemm_algo_solution_index, 0, solutions.data(), &solution_count) !=
+        rocblas_status_success) {
+      solutions.clear();
+    }
+  }
+
+  int best_solution = 0;
+  float best_time = std::numeric_limits<float>::max();
+  if (!solutions.empty() && hipEventCreate(&start) == hipSuccess && hipEventCreate(&stop) == hipSuccess) {
+    // The default selection is timed first, and only a faster solution replaces it.
+    solutions.insert(solutions.begin(), 0);
+    for (rocblas_int solution : solutions) {
+      const rocblas_gemm_algo algo = solution == 0 ? rocblas_gemm_algo_standard : rocblas_gemm_algo_solution_index;
+      // The first run warms up the kernel and rules out the solutions that reject the problem.
+      if (run(algo, solution) != rocblas_status_success) {
+        continue;
+      }
+      hipEventRecord(start, stream);
+      for (int i = 0; i < kTuningIterations; i++) {
+        run(algo, solution);
+      }
+      hipEventRecord(stop, stream);
+      float elapsed = 0.f;
+      if (hipEventSynchronize(stop) == hipSuccess && hipEventElapsedTime(&elapsed, start, stop) == hipSuccess &&
+          elapsed < best_time) {
+        best_time = elapsed;
+        best_solution = solution;
+      }
+    }
+  }
+
+  if (start != nullptr) hipEventDestroy(start);
+  if (stop != nullptr) hipEventDestroy(stop);
+  hipStreamSynchronize(stream);
+  hipFree(D);
+  return best_solution;
+}
+#endif
+
+}  // namespace
+
+void SetRocblasGemmTuning(bool enable) {
+#ifdef ORT_ROCBLAS_GEMM_SOLUTIONS
+  gemm_tuning_enabled = enable;
+#else
+  if (enable) {
+    LOGS_DEFAULT(WARNING) << "rocblas_gemm_tuning requires rocBLAS 2.44 or later. The default GEMM selection is used.";
+  }
+#endif
+}
+
+rocblas_status RocblasGemmEx(rocblas_handle handle,
+                             rocblas_operation transa,
+                             rocblas_operation transb,
+                             int m, int n, int k,
+                             const void* alpha,
+                             const void* A, int lda,
+                             const void* B, int ldb,
+                             const void* beta,
+                             void* C, int ldc,
+                             rocblas_datatype data_type,
+                             rocblas_datatype compute_type) {
+  rocblas_gemm_algo algo = rocblas_gemm_algo_standard;
+  int solution = 0;
+#ifdef ORT_ROCBLAS_GEMM_SOLUTIONS
+  if (gemm_tuning_enabled) {
+    int device = 0;
+    HIP_CALL_THROW(hipGetDevice(&device));
+    const GemmKey key{device, transa, transb, m, n, k, lda, ldb, ldc, data_type, compute_type};
+    bool found = false;
+    {
+      std::lock_guard<OrtMutex> lock(solution_cache_mutex);
+      auto it = solution_cache.find(key);
+      if (it != solution_cache.end()) {
+        solution = it->second;
+        found = true;
+      }
+    }
+    if (!found) {
+      solution = FindFastestSolution(handle, transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc,
+                                     data_type, compute_type);
+      std::lock_guard<OrtMutex> lock(solution_cache_mutex);
+      solution_cache.emplace(key, solution);
+    }
+    if (solution != 0) {
+      algo = rocblas_gemm_algo_solution_index;
+    }
+  }
+#endif
+  return rocblas_gemm_ex(handle, transa, transb, m, n, k, alpha, A, data_type, lda, B, data_type, ldb, beta,
+                         C, data_type, ldc, C, data_type, ldc, compute_type, algo, solution, 0);
+}
+
+}  // namespace rocm
+}  // namespace onnxruntime
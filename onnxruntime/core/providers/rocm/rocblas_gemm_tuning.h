@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/rocm/rocm_pch.h"
+
+namespace onnxruntime {
+namespace rocm {
+
+// Enables the selection of the fastest rocBLAS solution for each GEMM shape. It applies to the whole process,
+// and is turned on by any ROCM execution provider created with the rocblas_gemm_tuning option.
+void SetRocblasGemmTuning(bool enable);
+
+// rocblas_gemm_ex with C as the output. When tuning is enabled, the solutions rocBLAS offers for a new shape
+// are timed once on the stream of the handle and the fastest one is cached for the shape and the device.
+rocblas_status RocblasGemmEx(rocblas_handle handle,
+                             rocblas_operation transa,
+                             rocblas_operation transb,
+                             int m, int n, int k,
+                             const void* alpha,
+                             const void* A, int lda,
+                             const void* B, int ldb,
+                             const void* beta,
+                             void* C, int ldc,
+                             rocblas_datatype data_type,
+                             rocblas_datatype compute_type);
+
+}  // namespace rocm
+}  // namespace onnxruntime
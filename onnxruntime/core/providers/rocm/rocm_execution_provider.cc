@@ -12,6 +12,8 @@
 #include "core/providers/rocm/rocm_fence.h"
 #include "core/providers/rocm/rocm_fwd.h"
 #include "core/providers/rocm/rocm_allocator.h"
+#include "core/providers/rocm/miopen_common.h"
+#include "core/providers/rocm/rocblas_gemm_tuning.h"
 
 #ifndef DISABLE_CONTRIB_OPS
 #include "contrib_ops/rocm/rocm_contrib_kernels.h"
@@ -137,6 +139,14 @@ ROCMExecutionProvider::ROCMExecutionProvider(const ROCMExecutionProviderInfo& in
   HIP_CALL_THROW(hipDeviceSynchronize());
   HIP_CALL_THROW(hipGetDeviceProperties(&device_prop_, info_.device_id));
 
+  // Both must be set before the per thread contexts create their MIOpen and rocBLAS handles.
+  if (!info_.miopen_user_db_path.empty()) {
+    rocm::SetMiopenUserDbPath(info_.miopen_user_db_path);
+  }
+  if (info_.rocblas_gemm_tuning) {
+    rocm::SetRocblasGemmTuning(true);
+  }
+
   if (info.has_user_compute_stream) {
     external_stream_ = true;
     stream_ = static_cast<hipStream_t>(info.user_compute_stream);
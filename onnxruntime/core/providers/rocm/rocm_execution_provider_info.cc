@@ -13,6 +13,8 @@ constexpr const char* kDeviceId = "device_id";
 constexpr const char* kMemLimit = "gpu_mem_limit";
 constexpr const char* kArenaExtendStrategy = "arena_extend_strategy";
 constexpr const char* kConvExhaustiveSearch = "conv_exhaustive_search";
+constexpr const char* kMiopenUserDbPath = "miopen_user_db_path";
+constexpr const char* kRocblasGemmTuning = "rocblas_gemm_tuning";
 constexpr const char* kGpuExternalAlloc = "gpu_external_alloc";
 constexpr const char* kGpuExternalFree = "gpu_external_free";
 }  // namespace provider_option_names
@@ -52,6 +54,8 @@ ROCMExecutionProviderInfo ROCMExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(rocm::provider_option_names::kDeviceId, info.device_id)
           .AddAssignmentToReference(rocm::provider_option_names::kMemLimit, info.gpu_mem_limit)
           .AddAssignmentToReference(rocm::provider_option_names::kConvExhaustiveSearch, info.miopen_conv_exhaustive_search)
+          .AddAssignmentToReference(rocm::provider_option_names::kMiopenUserDbPath, info.miopen_user_db_path)
+          .AddAssignmentToReference(rocm::provider_option_names::kRocblasGemmTuning, info.rocblas_gemm_tuning)
           .AddAssignmentToEnumReference(
               rocm::provider_option_names::kArenaExtendStrategy,
               arena_extend_strategy_mapping, info.arena_extend_strategy)
@@ -70,6 +74,8 @@ ProviderOptions ROCMExecutionProviderInfo::ToProviderOptions(const ROCMExecution
       {rocm::provider_option_names::kGpuExternalAlloc, MakeStringWithClassicLocale(reinterpret_cast<size_t>(info.external_allocator_info.alloc))},
       {rocm::provider_option_names::kGpuExternalFree, MakeStringWithClassicLocale(reinterpret_cast<size_t>(info.external_allocator_info.free))},
       {rocm::provider_option_names::kConvExhaustiveSearch, MakeStringWithClassicLocale(info.miopen_conv_exhaustive_search)},
+      {rocm::provider_option_names::kMiopenUserDbPath, info.miopen_user_db_path},
+      {rocm::provider_option_names::kRocblasGemmTuning, MakeStringWithClassicLocale(info.rocblas_gemm_tuning)},
       {rocm::provider_option_names::kArenaExtendStrategy,
        EnumToName(arena_extend_strategy_mapping, info.arena_extend_strategy)},
   };
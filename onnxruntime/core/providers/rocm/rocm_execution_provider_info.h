@@ -4,6 +4,7 @@
 #pragma once
 
 #include <limits>
+#include <string>
 
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/ortdevice.h"
@@ -35,6 +36,10 @@ struct ROCMExecutionProviderInfo {
   size_t gpu_mem_limit{std::numeric_limits<size_t>::max()};
   ArenaExtendStrategy arena_extend_strategy{ArenaExtendStrategy::kNextPowerOfTwo};
   bool miopen_conv_exhaustive_search{false};
+  // Directory in which MIOpen persists its find-db, perf-db and compiled kernels. The default location of MIOpen
+  // is kept when empty.
+  std::string miopen_user_db_path{};
+  bool rocblas_gemm_tuning{false};
   bool do_copy_in_default_stream{true};
   bool has_user_compute_stream{false};
   void* user_compute_stream{nullptr};
@@ -9,6 +9,10 @@
 #endif
 
 #include <hip/hip_runtime.h>
+// rocblas_gemm_ex_get_solutions is in the beta API of rocBLAS.
+#ifndef ROCBLAS_BETA_FEATURES_API
+#define ROCBLAS_BETA_FEATURES_API
+#endif
 #include <rocblas.h>
 #include <hipsparse.h>
 #include <hiprand.h>
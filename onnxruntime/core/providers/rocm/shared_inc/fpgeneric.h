@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/providers/rocm/rocm_common.h"
+#include "core/providers/rocm/rocblas_gemm_tuning.h"
 
 // Generalize library calls to be use in template functions
 
@@ -17,18 +18,17 @@ inline rocblas_status rocblasGemmHelper(rocblas_handle handle,
                                         const float* B, int ldb,
                                         const float* beta,
                                         float* C, int ldc) {
-  return rocblas_gemm_ex(handle,
-                         transa,
-                         transb,
-                         m, n, k,
-                         alpha,
-                         A, rocblas_datatype_f32_r, lda,
-                         B, rocblas_datatype_f32_r, ldb,
-                         beta,
-                         C, rocblas_datatype_f32_r, ldc,
-                         C, rocblas_datatype_f32_r, ldc,
-                         rocblas_datatype_f32_r,
-                         rocblas_gemm_algo_standard, 0, 0);
+  return onnxruntime::rocm::RocblasGemmEx(handle,
+                                          transa,
+                                          transb,
+                                          m, n, k,
+                                          alpha,
+                                          A, lda,
+                                          B, ldb,
+                                          beta,
+                                          C, ldc,
+                                          rocblas_datatype_f32_r,
+                                          rocblas_datatype_f32_r);
 }
 inline rocblas_status rocblasGemmHelper(rocblas_handle handle,
                                          rocblas_operation transa,
@@ -52,18 +52,17 @@ inline rocblas_status rocblasGemmHelper(rocblas_handle handle,
                                          half* C, int ldc) {
   float h_a = onnxruntime::math::halfToFloat(*reinterpret_cast<const uint16_t*>(alpha));
   float h_b = onnxruntime::math::halfToFloat(*reinterpret_cast<const uint16_t*>(beta));
-  return rocblas_gemm_ex(handle,
-                         transa,
-                         transb,
-                         m, n, k,
-                         &h_a,
-                         A, rocblas_datatype_f16_r, lda,
-                         B, rocblas_datatype_f16_r, ldb,
-                         &h_b,
-                         C, rocblas_datatype_f16_r, ldc,
-                         C, rocblas_datatype_f16_r, ldc,
-                         rocblas_datatype_f32_r,
-                         rocblas_gemm_algo_standard, 0, 0);
+  return onnxruntime::rocm::RocblasGemmEx(handle,
+                                          transa,
+                                          transb,
+                                          m, n, k,
+                                          &h_a,
+                                          A, lda,
+                                          B, ldb,
+                                          &h_b,
+                                          C, ldc,
+                                          rocblas_datatype_f16_r,
+                                          rocblas_datatype_f32_r);
 }
 
 // batched gemm
@@ -262,6 +262,167 @@ bool SetDynamicRange(nvinfer1::INetworkDefinition& network, std::unordered_map<s
   }
   return true;
 }
+
+/*
+* Set precision and DLA flags of the builder config
+* Low precisions and DLA the platform doesn't support are turned off. The returned suffix
+* encodes the settings in the engine name, so engines with different settings are cached separately.
+*/
+std::string SetPrecisionAndDLA(nvinfer1::IBuilder& trt_builder, nvinfer1::IBuilderConfig& trt_config,
+                               bool& fp16_enable, bool& int8_enable, bool& dla_enable, int& dla_core) {
+  // Check platform availability for low precision
+  if (fp16_enable) {
+    if (!trt_builder.platformHasFastFp16()) {
+      fp16_enable = false;
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_FP16_ENABLE is set, but platform doesn't support fast native fp16";
+    }
+  }
+
+  if (int8_enable) {
+    if (!trt_builder.platformHasFastInt8()) {
+      int8_enable = false;
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_INT8_ENABLE is set, but platform doesn't support fast native int8";
+    }
+  }
+
+  // Set precision flags
+  std::string suffix;
+  if (fp16_enable && int8_enable) {
+    trt_config.setFlags(1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kFP16) | 1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kINT8));
+    suffix += "_fp16_int8";
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] FP16 and INT8 mode is enabled";
+  } else if (fp16_enable) {
+    trt_config.setFlag(nvinfer1::BuilderFlag::kFP16);
+    suffix += "_fp16";
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] FP16 mode is enabled";
+  } else if (int8_enable) {
+    trt_config.setFlag(nvinfer1::BuilderFlag::kINT8);
+    suffix += "_int8";
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] INT8 mode is enabled";
+  }
+
+  // Set DLA
+  if (fp16_enable || int8_enable) {
+    if (dla_enable && dla_core >= 0) {  //DLA can only run with FP16 and INT8
+      int number_of_dla_core = trt_builder.getNbDLACores();
+      if (number_of_dla_core == 0) {
+        LOGS_DEFAULT(WARNING) << "[TensorRT EP] Try to use DLA core, but platform doesn't have any DLA core";
+        dla_enable = false;
+      } else {
+        if (dla_core >= number_of_dla_core) {
+          LOGS_DEFAULT(WARNING) << "[TensorRT EP] Try to use DLA core #" << dla_core << ", but it exceeds platform's maximum DLA core number " << number_of_dla_core << ". Use DLA core 0 instead.";
+          dla_core = 0;
+        }
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] use DLA core " << dla_core;
+        trt_config.setFlag(nvinfer1::BuilderFlag::kGPU_FALLBACK);
+        trt_config.setDefaultDeviceType(nvinfer1::DeviceType::kDLA);
+        trt_config.setDLACore(dla_core);
+        suffix += "_dlacore" + std::to_string(dla_core);
+      }
+    }
+  }
+  return suffix;
+}
+
+/*
+* Parse explicit optimization profile shapes
+* The shapes are a comma separated list of input name and shape pairs with dimensions separated by 'x', e.g.
+* "input_ids:1x1,attention_mask:1x1,input_ids:8x128,attention_mask:8x128". The n-th occurrence of an input
+* is its shape in the n-th optimization profile.
+*/
+bool ParseProfileShapes(const std::string& shapes_string, onnxruntime::ProfileShapes& profile_shapes) {
+  std::istringstream shapes_stream(shapes_string);
+  std::string entry;
+  while (std::getline(shapes_stream, entry, ',')) {
+    const auto pos = entry.rfind(':');
+    if (pos == std::string::npos || pos == 0 || pos == entry.size() - 1) {
+      return false;
+    }
+    std::vector<int64_t> shape;
+    std::istringstream dims_stream(entry.substr(pos + 1));
+    std::string dim;
+    while (std::getline(dims_stream, dim, 'x')) {
+      if (dim.empty() || dim.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+      }
+      shape.push_back(std::stoll(dim));
+    }
+    profile_shapes[entry.substr(0, pos)].push_back(shape);
+  }
+  return true;
+}
+
+/*
+* Add the explicit optimization profiles to the builder config
+* num_profiles is set to the number of profiles added. It is 0 when a dynamic shape input of the network has
+* no declared shapes, or is a shape tensor, and the profile has to be created from the input shapes seen at runtime.
+*/
+onnxruntime::common::Status AddExplicitProfiles(nvinfer1::IBuilder& trt_builder, nvinfer1::INetworkDefinition& trt_network,
+                                                nvinfer1::IBuilderConfig& trt_config, const onnxruntime::ProfileShapes& min_shapes,
+                                                const onnxruntime::ProfileShapes& max_shapes, const onnxruntime::ProfileShapes& opt_shapes,
+                                                int& num_profiles) {
+  num_profiles = 0;
+  std::vector<nvinfer1::ITensor*> dynamic_inputs;
+  for (int i = 0, end = trt_network.getNbInputs(); i < end; ++i) {
+    auto input = trt_network.getInput(i);
+    nvinfer1::Dims dims = input->getDimensions();
+    bool is_dynamic = input->isShapeTensor();
+    for (int j = 0, end = dims.nbDims; j < end; ++j) {
+      is_dynamic = is_dynamic || dims.d[j] == -1;
+    }
+    if (is_dynamic) {
+      if (input->isShapeTensor() || min_shapes.find(input->getName()) == min_shapes.end()) {
+        return onnxruntime::common::Status::OK();
+      }
+      dynamic_inputs.push_back(input);
+    }
+  }
+
+  // An input declared once uses the same shapes in every profile
+  int profile_count = 0;
+  for (const auto* input : dynamic_inputs) {
+    profile_count = std::max(profile_count, static_cast<int>(min_shapes.at(input->getName()).size()));
+  }
+  for (const auto* input : dynamic_inputs) {
+    const int input_profile_count = static_cast<int>(min_shapes.at(input->getName()).size());
+    if (input_profile_count != 1 && input_profile_count != profile_count) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP input " + std::string(input->getName()) + " has shapes for " +
+                                                       std::to_string(input_profile_count) + " optimization profiles, expected 1 or " +
+                                                       std::to_string(profile_count));
+    }
+  }
+
+  for (int k = 0; k < profile_count; ++k) {
+    auto trt_profile = trt_builder.createOptimizationProfile();
+    for (const auto* input : dynamic_inputs) {
+      const std::string input_name = input->getName();
+      const size_t index = min_shapes.at(input_name).size() == 1 ? 0 : k;
+      const auto& min_shape = min_shapes.at(input_name)[index];
+      const auto& max_shape = max_shapes.at(input_name)[index];
+      const auto opt_iter = opt_shapes.find(input_name);
+      const auto& opt_shape = opt_iter != opt_shapes.end() ? opt_iter->second[index] : max_shape;
+      nvinfer1::Dims dims_min = input->getDimensions(), dims_opt = dims_min, dims_max = dims_min;
+      if (static_cast<int>(min_shape.size()) != dims_min.nbDims) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP optimization profile shape of input " + input_name + " has rank " +
+                                                         std::to_string(min_shape.size()) + ", expected " + std::to_string(dims_min.nbDims));
+      }
+      for (int j = 0, end = dims_min.nbDims; j < end; ++j) {
+        dims_min.d[j] = static_cast<int>(min_shape[j]);
+        dims_opt.d[j] = static_cast<int>(opt_shape[j]);
+        dims_max.d[j] = static_cast<int>(max_shape[j]);
+      }
+      trt_profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kMIN, dims_min);
+      trt_profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
+      trt_profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+    }
+    if (trt_config.addOptimizationProfile(trt_profile) < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP optimization profile " + std::to_string(k) +
+                                                       " is invalid, check that min <= opt <= max for every input");
+    }
+  }
+  num_profiles = profile_count;
+  return onnxruntime::common::Status::OK();
+}
 }  // namespace
 
 namespace google {
@@ -383,6 +544,67 @@ TensorrtLogger& GetTensorrtLogger() {
   return trt_logger;
 }
 
+/**
+Engines of the subgraphs built when the session is created, i.e. without shapes profiled at runtime, are never
+rebuilt, so the providers of all the sessions in the process share them through this registry, keyed by device and
+engine cache path. Sessions of the same model then hold one copy of the engine weights on the device, each provider
+only creating its own execution contexts. An engine is released with the last provider using it. The engines are
+deserialized by one runtime per device, which they keep alive.
+*/
+class TensorrtEngineRegistry {
+ public:
+  static TensorrtEngineRegistry& Instance() {
+    static TensorrtEngineRegistry registry;
+    return registry;
+  }
+
+  /**Get the engine registered for the key, or nullptr if no provider uses it anymore*/
+  std::shared_ptr<nvinfer1::ICudaEngine> Find(const std::string& key) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = engines_.find(key);
+    return it == engines_.end() ? nullptr : it->second.lock();
+  }
+
+  /**Deserialize and register the engine for the key, unless another provider has registered it in the meantime*/
+  std::shared_ptr<nvinfer1::ICudaEngine> Deserialize(const std::string& key, int device_id, const void* data, size_t size) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto& registered = engines_[key];
+    auto engine = registered.lock();
+    if (engine != nullptr) {
+      return engine;
+    }
+
+    auto& runtime = runtimes_[device_id];
+    if (runtime == nullptr) {
+      runtime = std::shared_ptr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(GetTensorrtLogger()),
+                                                    tensorrt_ptr::TensorrtInferDeleter());
+    }
+    auto* trt_engine = runtime->deserializeCudaEngine(data, size, nullptr);
+    if (trt_engine == nullptr) {
+      return nullptr;
+    }
+    engine = std::shared_ptr<nvinfer1::ICudaEngine>(trt_engine, [runtime](nvinfer1::ICudaEngine* obj) {
+      obj->destroy();
+    });
+    registered = engine;
+    return engine;
+  }
+
+  /**Register an engine built by a provider, replacing the entry of an engine no provider uses anymore*/
+  void Register(const std::string& key, const std::shared_ptr<nvinfer1::ICudaEngine>& engine) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto& registered = engines_[key];
+    if (registered.expired()) {
+      registered = engine;
+    }
+  }
+
+ private:
+  OrtMutex mutex_;
+  std::unordered_map<int, std::shared_ptr<nvinfer1::IRuntime>> runtimes_;
+  std::unordered_map<std::string, std::weak_ptr<nvinfer1::ICudaEngine>> engines_;
+};
+
 TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProviderInfo& info)
     : IExecutionProvider{onnxruntime::kTensorrtExecutionProvider, true}, device_id_(info.device_id) {
   CUDA_CALL_THROW(cudaSetDevice(device_id_));
@@ -470,7 +692,18 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     engine_cache_enable_ = (std::stoi(engine_cache_enable_env) == 0 ? false : true);
   }
 
-  if (engine_cache_enable_ || int8_enable_) {
+  const std::string timing_cache_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kTimingCacheEnable);
+  if (!timing_cache_enable_env.empty()) {
+    timing_cache_enable_ = (std::stoi(timing_cache_enable_env) == 0 ? false : true);
+#if NV_TENSORRT_MAJOR < 8
+    if (timing_cache_enable_) {
+      timing_cache_enable_ = false;
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_TIMING_CACHE_ENABLE is set, but timing cache requires TensorRT 8.0 or newer";
+    }
+#endif
+  }
+
+  if (engine_cache_enable_ || int8_enable_ || timing_cache_enable_) {
     const std::string engine_cache_path = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineCachePath);
     cache_path_ = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kCachePath);
     if (!engine_cache_path.empty() && cache_path_.empty()) {
@@ -485,6 +718,13 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     runtime_ = tensorrt_ptr::unique_pointer<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(GetTensorrtLogger()));
   }
 
+  if (timing_cache_enable_) {
+    // Tactic timings are only valid for the GPU they were measured on, so keep one timing cache per compute capability
+    cudaDeviceProp prop;
+    CUDA_CALL_THROW(cudaGetDeviceProperties(&prop, device_id_));
+    timing_cache_path_ = GetCachePath(cache_path_, "TensorrtExecutionProvider_cache_sm" + std::to_string(prop.major) + std::to_string(prop.minor) + ".timing");
+  }
+
   const std::string engine_decryption_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kDecryptionEnable);
   if (!engine_decryption_enable_env.empty()) {
     engine_decryption_enable_ = (std::stoi(engine_decryption_enable_env) == 0 ? false : true);
@@ -500,6 +740,52 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     engine_decryption_ = (int (*)(const char*, char*, size_t*))LIBFUNC(handle, "decrypt");
   }
 
+  const std::string async_engine_build_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kAsyncEngineBuildEnable);
+  if (!async_engine_build_enable_env.empty()) {
+    async_engine_build_enable_ = (std::stoi(async_engine_build_enable_env) == 0 ? false : true);
+    // Engines built in the background are handed over to later sessions through the engine cache
+    if (async_engine_build_enable_ && (!engine_cache_enable_ || engine_decryption_enable_)) {
+      async_engine_build_enable_ = false;
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_ASYNC_ENGINE_BUILD_ENABLE is set, but it requires ORT_TENSORRT_ENGINE_CACHE_ENABLE without engine decryption";
+    }
+  }
+
+  std::string profile_min_shapes, profile_max_shapes, profile_opt_shapes;
+  if (info.has_trt_options) {
+    profile_min_shapes = info.profile_min_shapes;
+    profile_max_shapes = info.profile_max_shapes;
+    profile_opt_shapes = info.profile_opt_shapes;
+  } else {
+    profile_min_shapes = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfilesMinShapes);
+    profile_max_shapes = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfilesMaxShapes);
+    profile_opt_shapes = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfilesOptShapes);
+  }
+
+  if (!profile_min_shapes.empty() || !profile_max_shapes.empty() || !profile_opt_shapes.empty()) {
+    ORT_ENFORCE(ParseProfileShapes(profile_min_shapes, profile_min_shapes_) &&
+                    ParseProfileShapes(profile_max_shapes, profile_max_shapes_) &&
+                    ParseProfileShapes(profile_opt_shapes, profile_opt_shapes_),
+                "[TensorRT EP] Invalid optimization profile shapes, expected a list like 'input_ids:1x1,input_ids:8x128'");
+    ORT_ENFORCE(!profile_min_shapes_.empty() && profile_min_shapes_.size() == profile_max_shapes_.size(),
+                "[TensorRT EP] Optimization profile min and max shapes have to be declared for the same inputs");
+    for (const auto& min_shapes : profile_min_shapes_) {
+      const auto& input_name = min_shapes.first;
+      const auto max_iter = profile_max_shapes_.find(input_name);
+      const auto opt_iter = profile_opt_shapes_.find(input_name);
+      ORT_ENFORCE(max_iter != profile_max_shapes_.end() && max_iter->second.size() == min_shapes.second.size(),
+                  "[TensorRT EP] Input ", input_name, " has a different number of optimization profile min and max shapes");
+      ORT_ENFORCE(opt_iter == profile_opt_shapes_.end() || opt_iter->second.size() == min_shapes.second.size(),
+                  "[TensorRT EP] Input ", input_name, " has a different number of optimization profile min and opt shapes");
+      for (size_t k = 0; k < min_shapes.second.size(); ++k) {
+        ORT_ENFORCE(max_iter->second[k].size() == min_shapes.second[k].size() &&
+                        (opt_iter == profile_opt_shapes_.end() || opt_iter->second[k].size() == min_shapes.second[k].size()),
+                    "[TensorRT EP] Optimization profile shapes of input ", input_name, " have different ranks");
+      }
+    }
+    ORT_ENFORCE(profile_opt_shapes_.size() <= profile_min_shapes_.size(),
+                "[TensorRT EP] Optimization profile opt shapes are declared for an input without min and max shapes");
+  }
+
   if (fp16_enable_ || int8_enable_) { // DLA can only be enabled with FP16 or INT8
     const std::string dla_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kDLAEnable);
     if (!dla_enable_env.empty()) {
@@ -516,6 +802,11 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
+  // Background engine builds use the provider's settings and timing cache, so let them finish
+  for (auto& engine_build_thread : engine_build_threads_) {
+    engine_build_thread.join();
+  }
+
   if (!external_stream_ && stream_) {
     CUDA_CALL(cudaStreamDestroy(stream_));
   }
@@ -1014,12 +1305,16 @@ TensorrtExecutionProvider::GetCapability(const GraphViewer& graph,
   for (const auto& group : supported_nodes_vector) {
     if (!group.first.empty()) {
       std::unique_ptr<IndexedSubGraph> sub_graph = GetSubGraph(group, graph);
+      // Leave the subgraph to other execution providers while its engine is built in the background
+      if (async_engine_build_enable_ && BuildEngineAsync(*sub_graph, graph)) {
+        continue;
+      }
       result.push_back(ComputeCapability::Create(std::move(sub_graph)));
       number_of_trt_nodes += group.first.size();
     }
   }
 
-  const int number_of_subgraphs = supported_nodes_vector.size();
+  const int number_of_subgraphs = result.size();
   if (number_of_trt_nodes == 0) {
     LOGS_DEFAULT(WARNING) << "[TensorRT EP] No graph will run on TensorRT exeuction provider";
   } else if (number_of_trt_nodes == number_of_ort_nodes) {
@@ -1038,6 +1333,196 @@ std::unique_lock<OrtMutex> TensorrtExecutionProvider::GetEngineBuildLock() const
   return force_sequential_engine_build_ ? std::unique_lock<OrtMutex>(singleton) : std::unique_lock<OrtMutex>();
 }
 
+void TensorrtExecutionProvider::SetTimingCache(nvinfer1::IBuilderConfig& trt_config) const {
+#if NV_TENSORRT_MAJOR >= 8
+  if (!timing_cache_enable_) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(timing_cache_mu_);
+  if (timing_cache_ == nullptr) {
+    std::vector<char> timing_cache_buf;
+    std::ifstream timing_cache_file(timing_cache_path_, std::ios::binary | std::ios::in);
+    if (timing_cache_file) {
+      timing_cache_file.seekg(0, std::ios::end);
+      timing_cache_buf.resize(timing_cache_file.tellg());
+      timing_cache_file.seekg(0, std::ios::beg);
+      timing_cache_file.read(timing_cache_buf.data(), timing_cache_buf.size());
+      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + timing_cache_path_;
+    }
+    timing_cache_ = tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache>(
+        trt_config.createTimingCache(timing_cache_buf.data(), timing_cache_buf.size()));
+    if (timing_cache_ == nullptr && !timing_cache_buf.empty()) {
+      // Cache written by a different TensorRT version, start over with an empty one
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not deserialize timing cache " + timing_cache_path_ + ", it will be rebuilt";
+      timing_cache_ = tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache>(trt_config.createTimingCache(nullptr, 0));
+    }
+    if (timing_cache_ == nullptr) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not create timing cache";
+      return;
+    }
+  }
+  trt_config.setTimingCache(*timing_cache_, false);
+#else
+  ORT_UNUSED_PARAMETER(trt_config);
+#endif
+}
+
+void TensorrtExecutionProvider::SaveTimingCache() const {
+#if NV_TENSORRT_MAJOR >= 8
+  if (!timing_cache_enable_) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(timing_cache_mu_);
+  if (timing_cache_ != nullptr) {
+    nvinfer1::IHostMemory* serialized_timing_cache = timing_cache_->serialize();
+    std::ofstream file(timing_cache_path_, std::ios::binary | std::ios::out);
+    file.write(reinterpret_cast<char*>(serialized_timing_cache->data()), serialized_timing_cache->size());
+    serialized_timing_cache->destroy();
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + timing_cache_path_;
+  }
+#endif
+}
+
+bool TensorrtExecutionProvider::BuildEngineAsync(IndexedSubGraph& sub_graph, const GraphViewer& graph) const {
+  // Engines being built in this process, so a subgraph shared by several sessions is only built once
+  static OrtMutex pending_builds_mutex;
+  static std::unordered_set<std::string> pending_builds;
+
+  // Reconstruct the subgraph the fused node would be compiled from
+  const auto* meta_def = sub_graph.GetMetaDef();
+  auto model_build = graph.CreateModel(*GetLogger());
+  auto& graph_build = model_build->MainGraph();
+  for (const auto& index : sub_graph.Nodes()) {
+    const auto& node = graph.GetNode(index);
+    std::vector<onnxruntime::NodeArg*> inputs, outputs;
+    for (auto input : node->InputDefs()) {
+      auto& n_input = graph_build.GetOrCreateNodeArg(input->Name(), input->TypeAsProto());
+      inputs.push_back(&n_input);
+      const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+      if (graph.GetInitializedTensor(input->Name(), initializer)) {
+        const ONNX_NAMESPACE::TensorProto* subgraph_initializer = nullptr;
+        if (!graph_build.GetInitializedTensor(input->Name(), subgraph_initializer)) {
+          graph_build.AddInitializedTensor(*(initializer));
+        }
+      }
+    }
+    for (auto output : node->OutputDefs()) {
+      auto& n_output = graph_build.GetOrCreateNodeArg(output->Name(), output->TypeAsProto());
+      outputs.push_back(&n_output);
+    }
+    graph_build.AddNode(node->Name(), node->OpType(), node->Description(), inputs, outputs, &node->GetAttributes(), node->Domain());
+  }
+  ORT_ENFORCE(graph_build.Resolve().IsOK());
+
+  std::vector<const NodeArg*> subgraph_outputs;
+  for (const auto& name : meta_def->outputs()) {
+    auto output_arg = graph.GetNodeArg(name);
+    subgraph_outputs.push_back(&graph_build.GetOrCreateNodeArg(output_arg->Name(), output_arg->TypeAsProto()));
+  }
+  graph_build.SetOutputs(subgraph_outputs);
+  ORT_ENFORCE(graph_build.Resolve().IsOK());
+
+  auto graph_viewer = graph_build.CreateGraphViewer();
+  auto model = graph_viewer->CreateModel(*GetLogger());
+  auto model_proto = model->ToProto();
+  ToGraphProtoInternal(*graph_viewer, *model_proto->mutable_graph());
+  model_proto->set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  std::string string_buf;
+  model_proto->SerializeToString(string_buf);
+
+  TensorrtLogger& trt_logger = GetTensorrtLogger();
+  auto trt_builder = tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>(nvinfer1::createInferBuilder(trt_logger));
+  const auto explicitBatch = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
+  auto trt_network = tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>(trt_builder->createNetworkV2(explicitBatch));
+  auto trt_config = tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
+  auto trt_parser = tensorrt_ptr::unique_pointer<nvonnxparser::IParser>(nvonnxparser::createParser(*trt_network, trt_logger));
+  if (!trt_parser->parse(string_buf.data(), string_buf.size(), model_path_)) {
+    return false;
+  }
+  trt_config->setMaxWorkspaceSize(max_workspace_size_);
+
+  // Dynamic shape subgraphs are profiled with the input shapes seen at runtime
+  for (int i = 0, end = trt_network->getNbInputs(); i < end; ++i) {
+    auto input = trt_network->getInput(i);
+    if (input->isShapeTensor()) {
+      return false;
+    }
+    nvinfer1::Dims dims = input->getDimensions();
+    for (int j = 0, end = dims.nbDims; j < end; ++j) {
+      if (dims.d[j] == -1) {
+        return false;
+      }
+    }
+  }
+
+  bool fp16_enable = fp16_enable_;
+  bool int8_enable = int8_enable_;
+  bool dla_enable = dla_enable_;
+  int dla_core = dla_core_;
+  const std::string trt_node_name_with_precision = meta_def->name() +
+                                                   SetPrecisionAndDLA(*trt_builder, *trt_config, fp16_enable, int8_enable, dla_enable, dla_core);
+  const std::string engine_cache_path = GetCachePath(cache_path_, trt_node_name_with_precision) + ".engine";
+  if (std::ifstream(engine_cache_path, std::ios::binary | std::ios::in)) {
+    return false;
+  }
+
+  std::unordered_map<std::string, float> dynamic_range_map;
+  if (int8_enable) {
+    const std::string calibration_cache_path = GetCachePath(cache_path_, int8_calibration_cache_name_);
+    if (!ReadDynamicRange(calibration_cache_path, int8_use_native_tensorrt_calibration_table_, dynamic_range_map) ||
+        !SetDynamicRange(*trt_network, dynamic_range_map)) {
+      // let Compile report the calibration error
+      return false;
+    }
+    trt_config->setInt8Calibrator(nullptr);
+  }
+
+  std::lock_guard<OrtMutex> lock(pending_builds_mutex);
+  if (!pending_builds.insert(engine_cache_path).second) {
+    return true;
+  }
+
+  LOGS_DEFAULT(INFO) << "[TensorRT EP] Building engine " + engine_cache_path + " in the background";
+  // The parser owns the weights the network refers to, so it has to live until the engine is built
+  engine_build_threads_.emplace_back([this, engine_cache_path, trt_builder = std::move(trt_builder), trt_network = std::move(trt_network),
+                                      trt_config = std::move(trt_config), trt_parser = std::move(trt_parser)]() {
+    CUDA_CALL(cudaSetDevice(device_id_));
+    SetTimingCache(*trt_config);
+    tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> trt_engine;
+    {
+      auto lock = GetEngineBuildLock();
+      trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
+    }
+    if (trt_engine == nullptr) {
+      LOGS_DEFAULT(ERROR) << "[TensorRT EP] Could not build engine " + engine_cache_path + " in the background";
+    } else {
+      SaveTimingCache();
+
+      // Write to a temporary file first so a concurrent session never deserializes a partially written engine
+      const std::string temp_engine_cache_path = engine_cache_path + ".tmp";
+      nvinfer1::IHostMemory* serializedModel = trt_engine->serialize();
+      {
+        std::ofstream file(temp_engine_cache_path, std::ios::binary | std::ios::out);
+        file.write(reinterpret_cast<char*>(serializedModel->data()), serializedModel->size());
+      }
+      serializedModel->destroy();
+      std::error_code error_code;
+      fs::rename(temp_engine_cache_path, engine_cache_path, error_code);
+      if (error_code) {
+        LOGS_DEFAULT(ERROR) << "[TensorRT EP] Could not save engine " + engine_cache_path + ": " + error_code.message();
+      } else {
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
+      }
+    }
+
+    std::lock_guard<OrtMutex> lock(pending_builds_mutex);
+    pending_builds.erase(engine_cache_path);
+  });
+  return true;
+}
+
 common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fused_nodes,
                                                   std::vector<NodeComputeInfo>& node_compute_funcs) {
   for (const auto* fused_node : fused_nodes) {
@@ -1115,20 +1600,26 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
       }
     }
 
-    // Check platform availability for low precision
-    if (fp16_enable_) {
-      if (!trt_builder->platformHasFastFp16()) {
-        fp16_enable_ = false;
-        LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_FP16_ENABLE is set, but platform doesn't support fast native fp16";
+    // Build the engine with the optimization profiles declared in the provider options when they cover every
+    // dynamic shape input. The profile is then selected by the input shapes and the engine is never rebuilt at runtime.
+    bool has_explicit_profiles = false;
+    if (has_dynamic_shape && !profile_min_shapes_.empty()) {
+      int num_profiles = 0;
+      ORT_RETURN_IF_ERROR(AddExplicitProfiles(*trt_builder, *trt_network, *trt_config, profile_min_shapes_, profile_max_shapes_,
+                                              profile_opt_shapes_, num_profiles));
+      if (num_profiles > 0) {
+        has_explicit_profiles = true;
+        has_dynamic_shape = false;
+        input_shape_ranges.clear();
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] " << num_profiles << " explicit optimization profiles for fused node: " << fused_node->Name();
+      } else {
+        LOGS_DEFAULT(INFO) << "[TensorRT EP] Not every dynamic shape input of fused node " << fused_node->Name()
+                           << " has explicit optimization profile shapes, the profile will be created from runtime input shapes";
       }
     }
 
-    if (int8_enable_) {
-      if (!trt_builder->platformHasFastInt8()) {
-        int8_enable_ = false;
-        LOGS_DEFAULT(WARNING) << "[TensorRT EP] ORT_TENSORRT_INT8_ENABLE is set, but platform doesn't support fast native int8";
-      }
-    }
+    std::string trt_node_name_with_precision = fused_node->Name() +
+                                               SetPrecisionAndDLA(*trt_builder, *trt_config, fp16_enable_, int8_enable_, dla_enable_, dla_core_);
 
     // Load INT8 calibration table
     std::unordered_map<std::string, float> dynamic_range_map;
@@ -1139,58 +1630,27 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
       }
     }
 
-    // Set precision flags
-    std::string trt_node_name_with_precision = fused_node->Name();
-    if (fp16_enable_ && int8_enable_) {
-      trt_config->setFlags(1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kFP16) | 1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kINT8));
-      trt_node_name_with_precision += "_fp16_int8";
-      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] FP16 and INT8 mode is enabled";
-    } else if (fp16_enable_) {
-      trt_config->setFlag(nvinfer1::BuilderFlag::kFP16);
-      trt_node_name_with_precision += "_fp16";
-      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] FP16 mode is enabled";
-    } else if (int8_enable_) {
-      trt_config->setFlag(nvinfer1::BuilderFlag::kINT8);
-      trt_node_name_with_precision += "_int8";
-      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] INT8 mode is enabled";
-    }
-
-    // Set DLA
-    if (fp16_enable_ || int8_enable_) {
-      if (dla_enable_ && dla_core_ >= 0) {//DLA can only run with FP16 and INT8
-        int number_of_dla_core = trt_builder->getNbDLACores();
-        if (number_of_dla_core == 0) {
-          LOGS_DEFAULT(WARNING) << "[TensorRT EP] Try to use DLA core, but platform doesn't have any DLA core";
-		  dla_enable_ = false;
-        } else {
-          if (dla_core_ >= number_of_dla_core) {
-            LOGS_DEFAULT(WARNING) << "[TensorRT EP] Try to use DLA core #" << dla_core_ << ", but it exceeds platform's maximum DLA core number " << number_of_dla_core << ". Use DLA core 0 instead.";
-            dla_core_ = 0;
-          }
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] use DLA core " << dla_core_;
-          trt_config->setFlag(nvinfer1::BuilderFlag::kGPU_FALLBACK);
-          trt_config->setDefaultDeviceType(nvinfer1::DeviceType::kDLA);
-          trt_config->setDLACore(dla_core_);
-          trt_node_name_with_precision += "_dlacore" + std::to_string(dla_core_);
-		}
-      }
-    }
-
     // Build TRT engine here if the graph doesn't have dynamic shape input. Otherwise engine will
     // be built at runtime
-    tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> trt_engine;
+    std::shared_ptr<nvinfer1::ICudaEngine> trt_engine;
     tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext> trt_context;
     if (!has_dynamic_shape) {
       const std::string cache_path = GetCachePath(cache_path_, trt_node_name_with_precision);
       const std::string engine_cache_path = cache_path + ".engine";
+      const std::string engine_key = std::to_string(device_id_) + ":" + engine_cache_path;
+      if (engine_cache_enable_) {
+        trt_engine = TensorrtEngineRegistry::Instance().Find(engine_key);
+      }
       std::ifstream engine_file(engine_cache_path, std::ios::binary | std::ios::in);
-      if (engine_cache_enable_ && engine_file) {
+      if (trt_engine != nullptr) {
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Shared engine " + engine_cache_path;
+      } else if (engine_cache_enable_ && engine_file) {
         engine_file.seekg(0, std::ios::end);
         int engine_size = engine_file.tellg();
         engine_file.seekg(0, std::ios::beg);
         std::unique_ptr<char[]> engine_buf{new char[engine_size]};
         engine_file.read((char*)engine_buf.get(), engine_size);
-        trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
+        trt_engine = TensorrtEngineRegistry::Instance().Deserialize(engine_key, device_id_, engine_buf.get(), engine_size);
         LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
         if (trt_engine == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
@@ -1209,7 +1669,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
                                  "TensorRT EP could not call engine decryption function decrypt");
         }
         // Deserialize engine
-        trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
+        trt_engine = TensorrtEngineRegistry::Instance().Deserialize(engine_key, device_id_, engine_buf.get(), engine_size);
         LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
         if (trt_engine == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
@@ -1226,6 +1686,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         }
 
         // Build engine
+        SetTimingCache(*trt_config);
         {
           auto lock = GetEngineBuildLock();
           trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
@@ -1234,12 +1695,14 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                                  "TensorRT EP could not build engine for fused node: " + fused_node->Name());
         }
+        SaveTimingCache();
         if (engine_cache_enable_) {
           nvinfer1::IHostMemory* serializedModel = trt_engine->serialize();
           std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
           file.write(reinterpret_cast<char*>(serializedModel->data()), serializedModel->size());
           serializedModel->destroy();
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
+          TensorrtEngineRegistry::Instance().Register(engine_key, trt_engine);
         }
       }
 
@@ -1294,7 +1757,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
             &networks_[context->node_name], input_info_[context->node_name], output_info_[context->node_name],
             input_shape_ranges_[context->node_name], &tensorrt_mu_, fp16_enable_, int8_enable_, dla_enable_, 
             dla_core_, &max_workspace_size_, trt_node_name_with_precision, engine_cache_enable_, cache_path_, runtime_.get(), nullptr,
-            allocator_, dynamic_range_map, engine_decryption_enable_, engine_decryption_};
+            allocator_, dynamic_range_map, engine_decryption_enable_, engine_decryption_, has_explicit_profiles};
       *state = p.release();
       return 0;
     };
@@ -1560,6 +2023,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         }
 
         // Build engine
+        SetTimingCache(*trt_config);
         {
           auto lock = GetEngineBuildLock();
           *(trt_state->engine) = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(
@@ -1568,6 +2032,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         if (trt_state->engine == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
         }
+        SaveTimingCache();
         trt_engine = trt_state->engine->get();
         if (trt_state->engine_cache_enable) {
           // Serialize engine profile
@@ -1591,11 +2056,53 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         trt_context = trt_state->context->get();
       }
 
-      // Get input and output binding names
+      // Bindings are replicated for each optimization profile, the bindings of profile k are the ones of profile 0
+      // offset by k * bindings_per_profile
       int total_bindings = trt_engine->getNbBindings();
+      const int bindings_per_profile = total_bindings / trt_engine->getNbOptimizationProfiles();
+      int profile_index = 0;
+      if (trt_state->has_explicit_profiles) {
+        // Select the first explicit profile that covers the input shapes
+        profile_index = -1;
+        for (int k = 0, end = trt_engine->getNbOptimizationProfiles(); k < end && profile_index < 0; ++k) {
+          bool in_range = true;
+          for (int i = 0; i < bindings_per_profile && in_range; ++i) {
+            if (!trt_engine->bindingIsInput(i) || trt_engine->isShapeBinding(i)) {
+              continue;
+            }
+            int input_index = 0;
+            const auto& iter = input_indexes.find(trt_engine->getBindingName(i));
+            if (iter != input_indexes.end()) {
+              input_index = iter->second;
+            }
+            const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_index);
+            auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+            const auto& tensor_shapes = ort.GetTensorShape(tensor_info);
+            ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
+            nvinfer1::Dims dims_min = trt_engine->getProfileDimensions(i, k, nvinfer1::OptProfileSelector::kMIN);
+            nvinfer1::Dims dims_max = trt_engine->getProfileDimensions(i, k, nvinfer1::OptProfileSelector::kMAX);
+            for (int j = 0, end = dims_min.nbDims; j < end && in_range; ++j) {
+              in_range = tensor_shapes[j] >= dims_min.d[j] && tensor_shapes[j] <= dims_max.d[j];
+            }
+          }
+          if (in_range) {
+            profile_index = k;
+          }
+        }
+        if (profile_index < 0) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP input shapes are outside of every optimization profile of " +
+                                                           trt_state->trt_node_name_with_precision);
+        }
+        if (trt_context->getOptimizationProfile() != profile_index && !trt_context->setOptimizationProfile(profile_index)) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to select optimization profile " + std::to_string(profile_index));
+        }
+      }
+      const int binding_offset = profile_index * bindings_per_profile;
+
+      // Get input and output binding names
       std::vector<void*> buffers(total_bindings);
       std::vector<std::string> input_binding_names, output_binding_names;
-      for (int i = 0, end = total_bindings; i < end; ++i) {
+      for (int i = 0, end = bindings_per_profile; i < end; ++i) {
         if (trt_engine->bindingIsInput(i)) {
           input_binding_names.push_back(trt_engine->getBindingName(i));
         } else {
@@ -1611,6 +2118,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         if (binding_index == -1) {
           continue;
         }
+        binding_index += binding_offset;
 
         int input_index = 0;
         const auto& iter = input_indexes.find(input_name);
@@ -1727,6 +2235,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         if (binding_index == -1) {
           continue;
         }
+        binding_index += binding_offset;
 
         int output_index = 0;
         const auto& index_iter = output_indexes.find(output_name);
@@ -1836,7 +2345,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
       // Cast INT64 input to INT32 because TensorRT doesn't fully support INT64
       for (int i = 0, end = output_binding_names.size(); i < end; ++i) {
         const std::string& output_name = output_binding_names[i];
-        size_t binding_index = trt_engine->getBindingIndex(output_name.c_str());
+        size_t binding_index = trt_engine->getBindingIndex(output_name.c_str()) + binding_offset;
         int output_type = 0;
         const auto& iter = output_types.find(output_name);
         if (iter != output_types.end()) {
@@ -3,6 +3,7 @@
 
 #pragma once
 #include <ctime>
+#include <thread>
 #include "NvInfer.h"
 #include "NvOnnxParser.h"
 #include "core/platform/ort_mutex.h"
@@ -27,6 +28,11 @@ static const std::string kDecryptionEnable = "ORT_TENSORRT_ENGINE_DECRYPTION_ENA
 static const std::string kDecryptionLibPath = "ORT_TENSORRT_ENGINE_DECRYPTION_LIB_PATH";
 static const std::string kDLAEnable = "ORT_TENSORRT_DLA_ENABLE";
 static const std::string kDLACore = "ORT_TENSORRT_DLA_CORE";
+static const std::string kTimingCacheEnable = "ORT_TENSORRT_TIMING_CACHE_ENABLE";
+static const std::string kAsyncEngineBuildEnable = "ORT_TENSORRT_ASYNC_ENGINE_BUILD_ENABLE";
+static const std::string kProfilesMinShapes = "ORT_TENSORRT_PROFILE_MIN_SHAPES";
+static const std::string kProfilesMaxShapes = "ORT_TENSORRT_PROFILE_MAX_SHAPES";
+static const std::string kProfilesOptShapes = "ORT_TENSORRT_PROFILE_OPT_SHAPES";
 }  // namespace tensorrt_env_vars
 
 class TensorrtLogger : public nvinfer1::ILogger {
@@ -81,15 +87,21 @@ struct TensorrtExecutionProviderInfo {
   std::string int8_calibration_table_name{""};
   bool int8_use_native_calibration_table{false};
   bool force_sequential_engine_build{false};
+  std::string profile_min_shapes{""};
+  std::string profile_max_shapes{""};
+  std::string profile_opt_shapes{""};
 };
 
+// Shapes of an input in each explicit optimization profile, keyed by input name.
+using ProfileShapes = std::unordered_map<std::string, std::vector<std::vector<int64_t>>>;
+
 // Information to construct kernel function state.
 struct TensorrtFuncState {
   AllocateFunc test_allocate_func = nullptr;
   DestroyFunc test_release_func = nullptr;
   AllocatorHandle allocator = nullptr;
   tensorrt_ptr::unique_pointer<nvonnxparser::IParser>* parser = nullptr;
-  tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>* engine = nullptr;
+  std::shared_ptr<nvinfer1::ICudaEngine>* engine = nullptr;
   tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>* context = nullptr;
   tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>* builder = nullptr;
   tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>* network = nullptr;
@@ -111,6 +123,7 @@ struct TensorrtFuncState {
   std::unordered_map<std::string, float> dynamic_range_map;
   bool engine_decryption_enable;
   int (*engine_decryption)(const char*, char*, size_t*);
+  bool has_explicit_profiles = false;
 };
 
 // Logical device representation.
@@ -164,9 +177,21 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   mutable char model_path_[4096];  // Reserved for max path length
   bool engine_decryption_enable_ = false;
   int (*engine_decryption_)(const char*, char*, size_t*);
+  bool timing_cache_enable_ = false;
+  std::string timing_cache_path_;
+  mutable OrtMutex timing_cache_mu_;
+#if NV_TENSORRT_MAJOR >= 8
+  mutable tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache> timing_cache_ = nullptr;
+#endif
+  bool async_engine_build_enable_ = false;
+  mutable std::vector<std::thread> engine_build_threads_;
+  ProfileShapes profile_min_shapes_;
+  ProfileShapes profile_max_shapes_;
+  ProfileShapes profile_opt_shapes_;
 
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvonnxparser::IParser>> parsers_;
-  std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>> engines_;
+  // engines built when the session is created are shared with the other sessions of the process
+  std::unordered_map<std::string, std::shared_ptr<nvinfer1::ICudaEngine>> engines_;
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>> contexts_;
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>> builders_;
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>> networks_;
@@ -196,5 +221,24 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   Otherwise, the constructed unique_lock is not associated with any mutex therefore no locking/unlocking will happen.
   */
   std::unique_lock<OrtMutex> GetEngineBuildLock() const;
+
+  /**
+  Attach the timing cache shared by all engines built by this provider to the builder config. The cache is
+  loaded from the cache path the first time it is needed, so layer tactics timed by an earlier build, in this
+  process or a previous one, are not timed again. No-op unless the timing cache is enabled.
+  */
+  void SetTimingCache(nvinfer1::IBuilderConfig& trt_config) const;
+
+  /**Persist the timing cache after an engine build so that later builds and processes reuse it*/
+  void SaveTimingCache() const;
+
+  /**
+  Start building the engine of a static shape subgraph on a background thread when it isn't in the engine cache yet.
+  Returns true if the subgraph has no engine available, in which case it is left to other execution providers
+  for this session and picked up from the engine cache once the build has finished. Returns false if the
+  subgraph should be taken by TensorRT as usual, i.e. its engine is cached or has dynamic shape inputs that
+  can only be profiled at runtime.
+  */
+  bool BuildEngineAsync(IndexedSubGraph& sub_graph, const GraphViewer& graph) const;
 };
 }  // namespace onnxruntime
@@ -161,6 +161,17 @@ ORT_API_STATUS_IMPL(OrtApis::SetInterOpNumThreads, _Inout_ OrtSessionOptions* op
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionOptionsSetExternalExecutor, _Inout_ OrtSessionOptions* options,
+                    _In_ const OrtExternalExecutor* executor) {
+  if (!executor || !executor->Schedule || !executor->ParallelFor || !executor->DegreeOfParallelism) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "OrtExternalExecutor must set Schedule, ParallelFor and DegreeOfParallelism");
+  }
+  options->value.intra_op_param.external_executor = *executor;
+  options->value.inter_op_param.external_executor = *executor;
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtApis::AddFreeDimensionOverride, _Inout_ OrtSessionOptions* options,
                     _In_ const char* dim_denotation, _In_ int64_t dim_value) {
   options->value.free_dimension_overrides.push_back(
@@ -13,6 +13,8 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 #include "core/session/ort_apis.h"
+#include "core/platform/threadpool.h"
+#include <array>
 #include <type_traits>
 
 ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttribute_float, _In_ const OrtKernelInfo* info, _In_ const char* name, _Out_ float* out) {
@@ -50,6 +52,24 @@ ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetOutput, _Inout_ OrtKernelContext*
   return nullptr;
 };
 
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_ParallelFor, _In_ const OrtKernelContext* context,
+                    _In_ void(ORT_API_CALL* fn)(void* fn_param, size_t i), _In_opt_ void* fn_param, size_t n) {
+  API_IMPL_BEGIN
+  auto* tp = reinterpret_cast<const onnxruntime::OpKernelContextInternal*>(context)->GetOperatorThreadPool();
+  onnxruntime::concurrency::ThreadPool::TrySimpleParallelFor(tp, static_cast<std::ptrdiff_t>(n),
+                                                             [fn, fn_param](std::ptrdiff_t i) {
+                                                               fn(fn_param, static_cast<size_t>(i));
+                                                             });
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetDegreeOfParallelism, _In_ const OrtKernelContext* context, _Out_ int* out) {
+  auto* tp = reinterpret_cast<const onnxruntime::OpKernelContextInternal*>(context)->GetOperatorThreadPool();
+  *out = onnxruntime::concurrency::ThreadPool::DegreeOfParallelism(tp);
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttribute_string, _In_ const OrtKernelInfo* info, _In_ const char* name, _Out_ char* out, _Inout_ size_t* size) {
   std::string value;
   auto status = reinterpret_cast<const onnxruntime::OpKernelInfo*>(info)->GetAttr<std::string>(name, &value);
@@ -116,6 +136,19 @@ struct CustomOpKernel : OpKernel {
       ORT_THROW("Unsupported version '" + std::to_string(op_.version) + "' in custom op '" + op.GetName(&op));
     }
 
+    // Only since the ORT API version 8 does the OrtCustomOp interface have the KernelComputeV2 and
+    // GetOutputShapeSource callbacks.
+    if (op_.version >= 8 && op_.KernelComputeV2 != nullptr) {
+      compute_v2_ = op_.KernelComputeV2;
+      if (op_.GetOutputShapeSource != nullptr) {
+        const size_t output_count = op_.GetOutputTypeCount(&op_);
+        output_shape_sources_.reserve(output_count);
+        for (size_t i = 0; i < output_count; i++) {
+          output_shape_sources_.push_back(op_.GetOutputShapeSource(&op_, i));
+        }
+      }
+    }
+
     op_kernel_ = op_.CreateKernel(&op_, OrtGetApiBase()->GetApi(op_.version),
                                   reinterpret_cast<const OrtKernelInfo*>(&info));
   }
@@ -123,6 +156,10 @@ struct CustomOpKernel : OpKernel {
   ~CustomOpKernel() override { op_.KernelDestroy(op_kernel_); }
 
   Status Compute(OpKernelContext* ctx) const override {
+    if (compute_v2_ != nullptr) {
+      return ComputeV2(ctx);
+    }
+
     op_.KernelCompute(op_kernel_, reinterpret_cast<OrtKernelContext*>(ctx));
     return Status::OK();
   }
@@ -130,8 +167,68 @@ struct CustomOpKernel : OpKernel {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CustomOpKernel);
 
+  // Descriptors of up to this many inputs and outputs are built on the stack.
+  static constexpr size_t kMaxStackTensors = 16;
+
+  static void DescribeTensor(const Tensor* tensor, OrtCustomOpTensor& desc) {
+    if (tensor == nullptr) {
+      desc = OrtCustomOpTensor{nullptr, ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED, nullptr, 0};
+      return;
+    }
+
+    const auto& dims = tensor->Shape().GetDims();
+    desc.data = tensor->IsDataTypeString() ? nullptr : const_cast<void*>(tensor->DataRaw());
+    desc.type = static_cast<ONNXTensorElementDataType>(tensor->GetElementType());
+    desc.dims = dims.data();
+    desc.num_dims = dims.size();
+  }
+
+  Status ComputeV2(OpKernelContext* ctx) const {
+    const size_t input_count = static_cast<size_t>(ctx->InputCount());
+    const size_t output_count = static_cast<size_t>(ctx->OutputCount());
+
+    std::array<OrtCustomOpTensor, kMaxStackTensors> stack_tensors;
+    std::vector<OrtCustomOpTensor> heap_tensors;
+    OrtCustomOpTensor* inputs = stack_tensors.data();
+    if (input_count + output_count > kMaxStackTensors) {
+      heap_tensors.resize(input_count + output_count);
+      inputs = heap_tensors.data();
+    }
+    OrtCustomOpTensor* outputs = inputs + input_count;
+
+    for (size_t i = 0; i < input_count; i++) {
+      DescribeTensor(ctx->Input<Tensor>(static_cast<int>(i)), inputs[i]);
+    }
+
+    for (size_t i = 0; i < output_count; i++) {
+      const Tensor* output = nullptr;
+      const int source = i < output_shape_sources_.size() ? output_shape_sources_[i] : -1;
+      if (source >= 0 && static_cast<size_t>(source) < input_count) {
+        const Tensor* input = ctx->Input<Tensor>(source);
+        if (input != nullptr) {
+          output = ctx->Output(static_cast<int>(i), input->Shape());
+        }
+      }
+      DescribeTensor(output, outputs[i]);
+    }
+
+    OrtStatus* status = compute_v2_(op_kernel_, reinterpret_cast<OrtKernelContext*>(ctx),
+                                    inputs, input_count, outputs, output_count);
+    if (status == nullptr) {
+      return Status::OK();
+    }
+
+    Status result(common::ONNXRUNTIME, static_cast<common::StatusCode>(OrtApis::GetErrorCode(status)),
+                  OrtApis::GetErrorMessage(status));
+    OrtApis::ReleaseStatus(status);
+    return result;
+  }
+
   const OrtCustomOp& op_;
   void* op_kernel_;
+  decltype(OrtCustomOp::KernelComputeV2) compute_v2_ = nullptr;
+  // Index of the input whose shape each output is preallocated with, or -1.
+  std::vector<int> output_shape_sources_;
 };
 
 common::Status CreateCustomRegistry(const std::vector<OrtCustomOpDomain*>& op_domains,
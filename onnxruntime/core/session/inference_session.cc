@@ -4,7 +4,11 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <cstdio>
+#include <iomanip>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <unordered_set>
 #include <list>
@@ -16,6 +20,7 @@
 #include "core/common/parse_string.h"
 #include "core/framework/arena.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/data_types_internal.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/feeds_fetches_manager.h"
@@ -23,6 +28,7 @@
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
@@ -31,12 +37,14 @@
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/optimizer/transformer_memcpy.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/graph_transformer_utils.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/path_lib.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/controlflow/utils.h"
@@ -50,6 +58,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/util/mlas_tuning.h"
 #include "core/util/protobuf_parsing_utils.h"
 #include "core/util/thread_utils.h"
 
@@ -112,7 +121,9 @@ std::atomic<uint32_t> InferenceSession::global_session_id_{1};
 // Version 2 - add serialization/deserialization of sparse_initializer
 // Version 3 - add `graph_doc_string` to Model
 // Version 4 - update kernel def hashing to not depend on ordering of type constraint types (NOT BACKWARDS COMPATIBLE)
-static constexpr const char* kOrtModelVersion = "4";
+// Version 5 - add prepacked weights to SessionState
+// Version 6 - add optional compression of the raw data of initializers
+static constexpr const char* kOrtModelVersion = "6";
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 // Check if the given ort model version is supported in this build
@@ -120,6 +131,8 @@ static bool IsOrtModelVersionSupported(const std::string& ort_model_version) {
   // The ort model versions we will support in this build
   // This may contain more versions than the kOrtModelVersion, based on the compatibilities
   static const std::unordered_set<std::string> kSupportedOrtModelVersions{
+      std::string("4"),  // version 5 only adds an optional field
+      std::string("5"),  // version 6 only adds an optional field
       std::string(kOrtModelVersion),
   };
 
@@ -230,6 +243,9 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   }
 
   use_per_session_threads_ = session_options.use_per_session_threads;
+  use_unified_thread_pool_ =
+      session_options_.execution_mode == ExecutionMode::ORT_PARALLEL &&
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseUnifiedThreadPool, "0") == "1";
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
@@ -251,10 +267,21 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                              session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                              to.affinity_vec_len == 0;
       to.allow_spinning = allow_intra_op_spinning;
+      to.numa_aware =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAware, "0") == "1";
+      to.performance_cores_only =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpPerformanceCoresOnly,
+                                                             "0") == "1";
       thread_pool_ =
           concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
     }
-    if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
+    if (use_unified_thread_pool_) {
+      LOGS(*session_logger_, INFO) << "Running the nodes of the parallel executor on the intra-op thread pool";
+      if (thread_pool_ == nullptr) {
+        LOGS(*session_logger_, INFO) << "The unified thread pool has no threads, setting ExecutionMode to SEQUENTIAL";
+        session_options_.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+      }
+    } else if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
       bool allow_inter_op_spinning =
           session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAllowInterOpSpinning, "1") == "1";
       OrtThreadPoolParams to = session_options_.inter_op_param;
@@ -287,7 +314,21 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
   }
 
+  const std::string mlas_tuning_file =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMlasTuningFile, "");
+  if (!mlas_tuning_file.empty()) {
+    ApplyMlasSgemmTuning(mlas_tuning_file, GetIntraOpThreadPoolToUse(), *session_logger_);
+  }
+
   session_profiler_.Initialize(session_logger_);
+  session_profiler_.EnableHardwareCounters(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileHardwareCounters, "0") == "1");
+  session_profiler_.EnableMemoryProfiling(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileMemory, "0") == "1");
+  session_profiler_.EnableSessionCreationProfiling(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileSessionCreation, "0") == "1");
+  session_profiler_.EnableThreadPoolTaskTracing(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfileThreadPoolTasks, "0") == "1");
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -373,6 +414,11 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  {
+    std::unique_lock<onnxruntime::OrtMutex> l(async_runs_mutex_);
+    async_runs_done_.wait(l, [this]() { return num_async_runs_ == 0; });
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -456,6 +502,15 @@ common::Status InferenceSession::RegisterExecutionProvider(std::unique_ptr<IExec
     }
   }
 
+  // The memory pattern places values with disjoint lifetimes in the sequential order at overlapping offsets,
+  // which is not safe when the nodes run concurrently on multiple compute queues.
+  if (p_exec_provider->GetComputeQueueIds().size() > 1 && session_options_.enable_mem_pattern) {
+    LOGS(*session_logger_, WARNING)
+        << "Having memory pattern enabled is not supported while using multiple compute streams of the "
+        << provider_type << ". So disabling it for this session.";
+    session_options_.enable_mem_pattern = false;
+  }
+
   VLOGS(*session_logger_, 1) << "Adding execution provider of type: " << provider_type;
   auto p_data_xfr = p_exec_provider->GetDataTransfer();
   if (p_data_xfr) {
@@ -531,9 +586,12 @@ common::Status InferenceSession::SaveToOrtFormat(const std::basic_string<ORTCHAR
   flatbuffers::FlatBufferBuilder builder(fbs_buffer_size);
 
   auto ort_model_version = builder.CreateString(kOrtModelVersion);
+  const bool compress_initializers =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCompressOrtFormatInitializers,
+                                                         "0") == "1";
   flatbuffers::Offset<fbs::Model> model;
   ORT_RETURN_IF_ERROR(
-      model_->SaveToOrtFormat(builder, model));
+      model_->SaveToOrtFormat(builder, model, compress_initializers));
 
   flatbuffers::Offset<fbs::SessionState> session_state;
   ORT_RETURN_IF_ERROR(
@@ -604,6 +662,31 @@ common::Status InferenceSession::Load(std::function<common::Status(std::shared_p
   return status;
 }
 
+// Initializers smaller than this are copied into the ModelProto when the ONNX model is memory mapped, as the
+// optimizers frequently read small constants such as shapes and axes.
+static constexpr size_t kMinMappedInitializerBytes = 128;
+
+// Memory map the ONNX model file. Returns false if mapping is not possible so the caller can fall back to
+// parsing the file.
+bool InferenceSession::MapOnnxModelBytes(const std::basic_string<ORTCHAR_T>& model_location,
+                                         gsl::span<const uint8_t>& bytes) {
+  size_t num_bytes = 0;
+  auto status = Env::Default().GetFileLength(model_location.c_str(), num_bytes);
+  if (status.IsOK() && num_bytes > 0) {
+    status = Env::Default().MapFileIntoMemory(model_location.c_str(), 0, num_bytes, onnx_model_mapped_memory_);
+  }
+
+  if (!status.IsOK() || !onnx_model_mapped_memory_) {
+    LOGS(*session_logger_, WARNING) << "Unable to memory map ONNX model " << ToMBString(model_location)
+                                    << ". The model will be parsed from the file instead. " << status.ErrorMessage();
+    onnx_model_mapped_memory_.reset();
+    return false;
+  }
+
+  bytes = gsl::make_span(reinterpret_cast<const uint8_t*>(onnx_model_mapped_memory_.get()), num_bytes);
+  return true;
+}
+
 template <typename T>
 common::Status InferenceSession::Load(const std::basic_string<T>& model_uri) {
   model_location_ = ToWideString(model_uri);
@@ -614,8 +697,40 @@ common::Status InferenceSession::Load(const std::basic_string<T>& model_uri) {
       ORT_RETURN_IF_ERROR(AddCustomOpDomains({domain.get()}));
     }
 #endif
-    return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                    *session_logger_);
+    const bool map_model =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMapOnnxModelIntoMemory, "0") == "1";
+
+    // the parsing of the protobuf and the creation and resolution of the graph are separate phases
+    TimePoint tp;
+    if (session_profiler_.SessionCreationProfilingEnabled()) {
+      tp = session_profiler_.Now();
+    }
+
+    ModelProto model_proto;
+    gsl::span<const uint8_t> bytes;
+    // the optimized model can't be saved with initializers that refer to memory
+    if (map_model && session_options_.optimized_model_filepath.empty() && MapOnnxModelBytes(model_location_, bytes)) {
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::LoadReferencingInitializerData(bytes, kMinMappedInitializerBytes,
+                                                                              model_proto));
+    } else {
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::Load(model_location_, model_proto));
+    }
+
+    if (session_profiler_.SessionCreationProfilingEnabled()) {
+      session_profiler_.EndTimeAndRecordPhase("model_parse", tp);
+      tp = session_profiler_.Now();
+    }
+
+    ORT_RETURN_IF_ERROR(onnxruntime::Model::Load(std::move(model_proto), model_location_, model,
+                                                 HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                                                 *session_logger_));
+
+    if (session_profiler_.SessionCreationProfilingEnabled()) {
+      // includes the creation of the Graph from the ModelProto
+      session_profiler_.EndTimeAndRecordPhase("graph_resolve", tp);
+    }
+
+    return Status::OK();
   };
 
   common::Status st = Load(loader, "model_loading_uri");
@@ -838,7 +953,8 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
 
   // first apply global(execution provider independent),  level 1(default/system/basic) graph to graph optimizations
   ORT_RETURN_IF_ERROR_SESSIONID_(
-      graph_transformer_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *session_logger_));
+      graph_transformer_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *session_logger_,
+                                              GetIntraOpThreadPoolToUse(), &session_profiler_));
 
 #ifdef USE_DML
   // TODO: this is a temporary workaround to apply the DML EP's custom graph transformer prior to partitioning. This
@@ -865,15 +981,27 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
                                          : GraphPartitioner::Mode::kNormal;
 
   // Do partitioning based on execution providers' capability.
-  GraphPartitioner partitioner(kernel_registry_manager, providers);
+  const bool cost_based_partitioning =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCostBasedPartitioning, "0") == "1";
+  TimePoint tp;
+  if (session_profiler_.SessionCreationProfilingEnabled()) {
+    tp = session_profiler_.Now();
+  }
+
+  GraphPartitioner partitioner(kernel_registry_manager, providers, cost_based_partitioning);
   ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state.ExportDll(),
                                                        session_state.GetMutableFuncMgr(), mode));
 
+  if (session_profiler_.SessionCreationProfilingEnabled()) {
+    session_profiler_.EndTimeAndRecordPhase("graph_partitioning", tp);
+  }
+
   // apply transformers except default transformers
   // Default transformers are required for correctness and they are owned and run by inference session
   for (int i = static_cast<int>(TransformerLevel::Level1); i <= static_cast<int>(TransformerLevel::MaxLevel); i++) {
     ORT_RETURN_IF_ERROR_SESSIONID_(
-        graph_transformer_mgr.ApplyTransformers(graph, static_cast<TransformerLevel>(i), *session_logger_));
+        graph_transformer_mgr.ApplyTransformers(graph, static_cast<TransformerLevel>(i), *session_logger_,
+                                                GetIntraOpThreadPoolToUse(), &session_profiler_));
   }
 
   bool modified = false;
@@ -959,15 +1087,16 @@ Status InferenceSession::PartitionOrtFormatModel(onnxruntime::Graph& graph,
 template <typename T>
 static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
                                 std::basic_string<ORTCHAR_T>& model_location,
-                                std::vector<uint8_t>& bytes) {
+                                gsl::span<const uint8_t>& bytes,
+                                std::vector<uint8_t>& bytes_data_holder) {
   size_t num_bytes = 0;
   model_location = ToWideString(model_uri);
   ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location.c_str(), num_bytes));
 
-  bytes.resize(num_bytes);
+  bytes_data_holder.resize(num_bytes);
 
   std::ifstream bytes_stream(model_uri, std::ifstream::in | std::ifstream::binary);
-  bytes_stream.read(reinterpret_cast<char*>(bytes.data()), num_bytes);
+  bytes_stream.read(reinterpret_cast<char*>(bytes_data_holder.data()), num_bytes);
 
   if (!bytes_stream) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -975,13 +1104,52 @@ static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
                            bytes_stream.gcount(), "/", num_bytes, " bytes were able to be read.");
   }
 
+  bytes = gsl::make_span(bytes_data_holder.data(), bytes_data_holder.size());
+
   return Status::OK();
 }
 
+// Memory map the ORT format model file. Returns false if mapping is not possible so the caller can fall back to
+// reading the bytes into a heap buffer.
+template <typename T>
+static bool MapOrtModelBytes(const std::basic_string<T>& model_uri,
+                             std::basic_string<ORTCHAR_T>& model_location,
+                             gsl::span<const uint8_t>& bytes,
+                             Env::MappedMemoryPtr& mapped_memory,
+                             const logging::Logger& logger) {
+  size_t num_bytes = 0;
+  model_location = ToWideString(model_uri);
+  auto status = Env::Default().GetFileLength(model_location.c_str(), num_bytes);
+  if (status.IsOK() && num_bytes > 0) {
+    status = Env::Default().MapFileIntoMemory(model_location.c_str(), 0, num_bytes, mapped_memory);
+  }
+
+  if (!status.IsOK() || !mapped_memory) {
+    LOGS(logger, WARNING) << "Unable to memory map ORT format model " << ToMBString(model_uri)
+                          << ". The model will be read into memory instead. " << status.ErrorMessage();
+    mapped_memory.reset();
+    return false;
+  }
+
+  bytes = gsl::make_span(reinterpret_cast<const uint8_t*>(mapped_memory.get()), num_bytes);
+  return true;
+}
+
+template <typename T>
+Status InferenceSession::LoadOrtModelBytesFromFile(const std::basic_string<T>& model_uri) {
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMapOrtModelIntoMemory, "0") == "1" &&
+      MapOrtModelBytes(model_uri, model_location_, ort_format_model_bytes_, ort_format_model_mapped_memory_,
+                       *session_logger_)) {
+    return Status::OK();
+  }
+
+  return LoadOrtModelBytes(model_uri, model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_);
+}
+
 Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
   return LoadOrtModel(
       [&]() {
-        ORT_RETURN_IF_ERROR(LoadOrtModelBytes(model_uri, model_location_, ort_format_model_bytes_));
+        ORT_RETURN_IF_ERROR(LoadOrtModelBytesFromFile(model_uri));
         return Status::OK();
       });
 }
@@ -990,7 +1158,7 @@ Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
 Status InferenceSession::LoadOrtModel(const std::wstring& model_uri) {
   return LoadOrtModel(
       [&]() {
-        ORT_RETURN_IF_ERROR(LoadOrtModelBytes(model_uri, model_location_, ort_format_model_bytes_));
+        ORT_RETURN_IF_ERROR(LoadOrtModelBytesFromFile(model_uri));
         return Status::OK();
       });
 }
@@ -1002,8 +1170,11 @@ Status InferenceSession::LoadOrtModel(const void* model_data, int model_data_len
     //
     // TODO: Provide Load API where we can take ownership of memory to avoid the copy,
     // and/or a combined Load+Initialize where we don't need this temporary copy.
-    ort_format_model_bytes_.resize(model_data_len);
-    std::copy_n(reinterpret_cast<const uint8_t*>(model_data), model_data_len, ort_format_model_bytes_.data());
+    ort_format_model_bytes_data_holder_.resize(model_data_len);
+    std::copy_n(reinterpret_cast<const uint8_t*>(model_data), model_data_len,
+                ort_format_model_bytes_data_holder_.data());
+    ort_format_model_bytes_ = gsl::make_span(ort_format_model_bytes_data_holder_.data(),
+                                             ort_format_model_bytes_data_holder_.size());
 
     return Status::OK();
   });
@@ -1026,8 +1197,30 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
     return status;
   }
 
+  TimePoint tp;
+  if (session_profiler_.SessionCreationProfilingEnabled()) {
+    tp = session_profiler_.Now();
+  }
+
   ORT_RETURN_IF_ERROR(load_ort_format_model_bytes());
 
+  if (session_profiler_.SessionCreationProfilingEnabled()) {
+    session_profiler_.EndTimeAndRecordPhase("model_read", tp);
+    tp = session_profiler_.Now();
+  }
+
+  ORT_RETURN_IF_ERROR(CreateModelFromOrtFormatBytes());
+
+  if (session_profiler_.SessionCreationProfilingEnabled()) {
+    session_profiler_.EndTimeAndRecordPhase("model_parse", tp);
+  }
+
+  is_model_loaded_ = true;
+
+  return Status::OK();
+}
+
+Status InferenceSession::CreateModelFromOrtFormatBytes() {
   // Verify the ort_format_model_bytes_ is a valid InferenceSessionBuffer before we access the data
   flatbuffers::Verifier verifier(ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
   ORT_RETURN_IF_NOT(fbs::VerifyInferenceSessionBuffer(verifier), "ORT model verification failed.");
@@ -1045,28 +1238,201 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
   const auto* fbs_model = fbs_session->model();
   ORT_RETURN_IF(nullptr == fbs_model, "Missing Model. Invalid ORT format model.");
 
+  // if the model is memory mapped the initializers can refer to the ORT format bytes directly
+  const bool use_ort_format_bytes_for_initializers = ort_format_model_mapped_memory_ != nullptr;
+
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
 #if !defined(ORT_MINIMAL_BUILD)
   ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model,
                                                HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                                               use_ort_format_bytes_for_initializers,
                                                *session_logger_, tmp_model));
 
 #else
-  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, *session_logger_, tmp_model));
+  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, use_ort_format_bytes_for_initializers,
+                                               *session_logger_, tmp_model));
 #endif
 
-  ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
-  model_ = std::move(tmp_model);
-
-  // Initialize takes the session_mutex_ as well so we need to have released it prior to calling this
   const auto* fbs_sess_state = fbs_session->session_state();
   ORT_RETURN_IF(nullptr == fbs_sess_state, "SessionState is null. Invalid ORT format model.");
 
-  is_model_loaded_ = true;
+  ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
+  model_ = std::move(tmp_model);
 
   return Status::OK();
 }
+
+#if !defined(ORT_MINIMAL_BUILD)
+// Append the 128-bit hashes of the bytes to 'hashes'. MurmurHash3 takes an int length, so large buffers are hashed
+// in chunks.
+static void AppendModelCacheHashes(const uint8_t* data, size_t size, std::string& hashes) {
+  constexpr size_t kChunkSize = size_t{1} << 30;
+  do {
+    const size_t chunk_size = std::min(size, kChunkSize);
+    uint32_t hash[4];
+    MurmurHash3::x86_128(data, static_cast<int>(chunk_size), 0, hash);
+    hashes.append(reinterpret_cast<const char*>(hash), sizeof(hash));
+    data += chunk_size;
+    size -= chunk_size;
+  } while (size > 0);
+}
+
+static bool GraphHasExternalData(const Graph& graph) {
+  for (const auto& initializer : graph.GetAllInitializedTensors()) {
+    if (utils::HasExternalData(*initializer.second)) {
+      return true;
+    }
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    for (const Graph* subgraph : node.GetSubgraphs()) {
+      if (GraphHasExternalData(*subgraph)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+PathString InferenceSession::GetOptimizedModelCachePath() {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOptimizedModelCacheDir, "");
+  if (cache_dir.empty() || !ort_format_model_bytes_.empty() || !session_options_.optimized_model_filepath.empty()) {
+    return PathString();
+  }
+
+  // the cache key only covers the ONNX model itself, and custom ops may be implemented differently next time
+  if (HasLocalSchema() || GraphHasExternalData(model_->MainGraph())) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache is not used for models with external data or custom "
+                                    "op schemas.";
+    return PathString();
+  }
+
+  std::string hashes;
+  Env::MappedMemoryPtr mapped_model;
+  size_t num_bytes = 0;
+  if (!model_location_.empty() && Env::Default().GetFileLength(model_location_.c_str(), num_bytes).IsOK() &&
+      num_bytes > 0 &&
+      Env::Default().MapFileIntoMemory(model_location_.c_str(), 0, num_bytes, mapped_model).IsOK() && mapped_model) {
+    AppendModelCacheHashes(reinterpret_cast<const uint8_t*>(mapped_model.get()), num_bytes, hashes);
+  } else {
+    // the model was loaded from bytes or a ModelProto
+    const std::string model_bytes = model_->ToProto().SerializeAsString();
+    AppendModelCacheHashes(reinterpret_cast<const uint8_t*>(model_bytes.data()), model_bytes.size(), hashes);
+  }
+
+  // everything that changes the optimized model
+  std::ostringstream config;
+  config << "ort_version:" << ORT_VERSION << "\n";
+  config << "providers:";
+  for (const auto& provider_id : execution_providers_.GetIds()) {
+    config << provider_id << ";";
+  }
+  config << "\noptimization_level:" << static_cast<int>(session_options_.graph_optimization_level) << "\n";
+  config << "nchwc_block_size:" << MlasNchwcGetBlockSize() << "\n";
+  config << "disabled_optimizers:";
+  for (const auto& optimizer : std::set<std::string>(optimizers_to_disable_.begin(), optimizers_to_disable_.end())) {
+    config << optimizer << ";";
+  }
+  config << "\nfree_dimension_overrides:";
+  for (const auto& dim_override : session_options_.free_dimension_overrides) {
+    config << dim_override.dim_identifier << "," << static_cast<int>(dim_override.dim_identifer_type) << ","
+           << dim_override.dim_value << ";";
+  }
+  config << "\nconfig:";
+  for (const auto& entry : std::map<std::string, std::string>(session_options_.config_options.configurations.begin(),
+                                                              session_options_.config_options.configurations.end())) {
+    if (entry.first != kOrtSessionOptionsConfigOptimizedModelCacheDir) {
+      config << entry.first << "=" << entry.second << ";";
+    }
+  }
+  hashes += config.str();
+
+  uint32_t key[4];
+  MurmurHash3::x86_128(hashes.data(), static_cast<int>(hashes.size()), 0, key);
+  std::ostringstream file_name;
+  file_name << std::hex << std::setfill('0');
+  for (uint32_t word : key) {
+    file_name << std::setw(8) << word;
+  }
+  file_name << ".ort";
+
+  const PathString cache_dir_path = ToPathString(cache_dir);
+  if (!Env::Default().FolderExists(cache_dir_path)) {
+    auto status = Env::Default().CreateFolder(cache_dir_path);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Unable to create the optimized model cache directory " << cache_dir << ". "
+                                      << status.ErrorMessage();
+      return PathString();
+    }
+  }
+
+  return ConcatPathComponent<PathChar>(cache_dir_path, ToPathString(file_name.str()));
+}
+
+bool InferenceSession::LoadFromOptimizedModelCache(const PathString& model_cache_path) {
+  size_t num_bytes = 0;
+  if (!Env::Default().GetFileLength(model_cache_path.c_str(), num_bytes).IsOK() || num_bytes == 0) {
+    return false;
+  }
+
+  // the model location is used to resolve the paths of external data, keep the original one
+  const PathString model_location = model_location_;
+  auto status = LoadOrtModelBytesFromFile(model_cache_path);
+  model_location_ = model_location;
+  if (status.IsOK()) {
+    status = CreateModelFromOrtFormatBytes();
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Unable to load the optimized model " << ToMBString(model_cache_path)
+                                    << " from the cache, the model will be optimized again. " << status.ErrorMessage();
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ort_format_model_mapped_memory_.reset();
+    return false;
+  }
+
+  LOGS(*session_logger_, INFO) << "Loaded the optimized model " << ToMBString(model_cache_path) << " from the cache.";
+  return true;
+}
+
+void InferenceSession::SaveToOptimizedModelCache(const PathString& model_cache_path) {
+  if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+    LOGS(*session_logger_, INFO) << "The optimized model can't be cached as it contains compiled nodes.";
+    return;
+  }
+
+  // write to a temporary file first so other sessions never load a partially written model
+  const PathString temp_path = model_cache_path + ToPathString("." + std::to_string(Env::Default().GetSelfPid()) +
+                                                               ".tmp");
+  auto status = SaveToOrtFormat(temp_path);
+  if (status.IsOK()) {
+#ifdef _WIN32
+    const bool renamed = _wrename(temp_path.c_str(), model_cache_path.c_str()) == 0;
+#else
+    const bool renamed = std::rename(temp_path.c_str(), model_cache_path.c_str()) == 0;
+#endif
+    // another session may have saved the same model in the meantime
+    size_t num_bytes = 0;
+    if (!renamed && !Env::Default().GetFileLength(model_cache_path.c_str(), num_bytes).IsOK()) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to rename ", ToMBString(temp_path));
+    }
+  }
+
+#ifdef _WIN32
+  _wremove(temp_path.c_str());
+#else
+  std::remove(temp_path.c_str());
+#endif
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Unable to save the optimized model to the cache. " << status.ErrorMessage();
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
 #endif  // defined(ENABLE_ORT_FORMAT_LOAD)
 
 bool InferenceSession::IsInitialized() const {
@@ -1149,6 +1515,11 @@ common::Status InferenceSession::Initialize() {
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      const std::string huge_pages =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuHugePages, "0");
+      ORT_RETURN_IF_NOT(huge_pages.size() == 1 && huge_pages[0] >= '0' && huge_pages[0] <= '3',
+                        "Invalid value for ", kOrtSessionOptionsConfigCpuHugePages, ": ", huge_pages);
+      epi.huge_pages = huge_pages[0] - '0';
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
     }
@@ -1180,6 +1551,24 @@ common::Status InferenceSession::Initialize() {
     session_activity_started_ = true;
 #endif
 
+    PrepackedWeightsContainer* prepacked_weights_container = nullptr;
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvPrepackedWeights, "0") == "1") {
+      LOGS(*session_logger_, INFO) << "This session will share its prepacked weights with the environment.";
+      prepacked_weights_container = &environment_.GetPrepackedWeightsContainer();
+    }
+
+#if !defined(ORT_MINIMAL_BUILD) && defined(ENABLE_ORT_FORMAT_LOAD)
+    // on a hit the model is replaced by the optimized ORT format model. on a miss the optimized model is saved to
+    // model_cache_path once the session state is finalized.
+    PathString model_cache_path = GetOptimizedModelCachePath();
+    if (!model_cache_path.empty() && LoadFromOptimizedModelCache(model_cache_path)) {
+      model_cache_path.clear();
+    }
+    const bool caching_model = !model_cache_path.empty();
+#else
+    const bool caching_model = false;
+#endif
+
     // now that we have all the execution providers, create the session state
     session_state_ = std::make_unique<SessionState>(
         model_->MainGraph(),
@@ -1191,7 +1580,8 @@ common::Status InferenceSession::Initialize() {
         *session_logger_,
         session_profiler_,
         session_options_.use_deterministic_compute,
-        session_options_.enable_mem_reuse);
+        session_options_.enable_mem_reuse,
+        prepacked_weights_container);
 
     onnxruntime::Graph& graph = model_->MainGraph();
 
@@ -1229,8 +1619,17 @@ common::Status InferenceSession::Initialize() {
                                                     saving_ort_format));
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
+      TimePoint resolve_tp;
+      if (session_profiler_.SessionCreationProfilingEnabled()) {
+        resolve_tp = session_profiler_.Now();
+      }
+
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
 
+      if (session_profiler_.SessionCreationProfilingEnabled()) {
+        session_profiler_.EndTimeAndRecordPhase("graph_final_resolve", resolve_tp);
+      }
+
       // Update temporary copies of metadata, input- and output definitions to the same state as the resolved graph
       ORT_RETURN_IF_ERROR_SESSIONID_(SaveModelMetadata(*model_));
     } else
@@ -1242,8 +1641,17 @@ common::Status InferenceSession::Initialize() {
       //
       // We always have the CPU EP, so only need to run this if some other EP is enabled
       if (execution_providers_.NumProviders() > 1) {
+        TimePoint partitioning_tp;
+        if (session_profiler_.SessionCreationProfilingEnabled()) {
+          partitioning_tp = session_profiler_.Now();
+        }
+
         ORT_RETURN_IF_ERROR_SESSIONID_(PartitionOrtFormatModel(graph, execution_providers_, kernel_registry_manager_,
                                                                *session_state_));
+
+        if (session_profiler_.SessionCreationProfilingEnabled()) {
+          session_profiler_.EndTimeAndRecordPhase("graph_partitioning", partitioning_tp);
+        }
       }
 #endif
     }
@@ -1258,8 +1666,8 @@ common::Status InferenceSession::Initialize() {
                                              session_options_,
                                              serialized_session_state,
                                              // need to keep the initializers if saving the optimized model
-                                             !saving_model,
-                                             saving_ort_format));
+                                             !saving_model && !caching_model,
+                                             saving_ort_format || caching_model));
 
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
@@ -1285,13 +1693,25 @@ common::Status InferenceSession::Initialize() {
         ORT_RETURN_IF_ERROR_SESSIONID_(Model::Save(*model_, session_options_.optimized_model_filepath));
       }
     }
+
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+    if (caching_model) {
+      SaveToOptimizedModelCache(model_cache_path);
+    }
+#endif
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     session_state_->ResolveMemoryPatternFlag();
+    ORT_RETURN_IF_ERROR_SESSIONID_(SetupGraphCaptureProvider());
+    ORT_RETURN_IF_ERROR_SESSIONID_(SetupStreamingState());
+    ORT_RETURN_IF_ERROR_SESSIONID_(SetupResultCache());
     is_inited_ = true;
 
-    // we don't directly use the ORT format bytes currently, so free those now
-    std::vector<uint8_t>().swap(ort_format_model_bytes_);
+    // initializers only refer to the ORT format bytes if the model was memory mapped, so free the bytes otherwise
+    if (!ort_format_model_mapped_memory_) {
+      ort_format_model_bytes_ = gsl::span<const uint8_t>();
+      std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    }
 
     // and log telemetry
     bool model_has_fp16_inputs = ModelHasFP16Inputs(graph);
@@ -1367,6 +1787,29 @@ const DataTransferManager& InferenceSession::GetDataTransferManager() const {
   return data_transfer_mgr_;
 }
 
+common::Status InferenceSession::InitializeSubgraphs(const std::vector<std::string>& node_names) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  std::unordered_set<std::string> requested_node_names(node_names.cbegin(), node_names.cend());
+  std::unordered_set<std::string> found_node_names;
+  ORT_RETURN_IF_ERROR_SESSIONID_(
+      session_state_->FinalizeDeferredSubgraphSessionStates(requested_node_names, found_node_names));
+
+  for (const auto& node_name : requested_node_names) {
+    if (found_node_names.count(node_name) == 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Node '", node_name, "' was not found in the model.");
+    }
+  }
+
+  return Status::OK();
+}
+
 common::Status InferenceSession::CheckShapes(const std::string& input_name, const TensorShape& input_shape,
                                              const TensorShape& expected_shape) const {
   auto input_shape_sz = input_shape.NumDimensions();
@@ -1434,51 +1877,57 @@ common::Status InferenceSession::ValidateInputs(const std::vector<std::string>&
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
     }
 
-    auto expected_type = iter->second.ml_data_type;
-    auto& input_ml_value = feeds.at(i);
-    if (input_ml_value.IsTensor()) {
-      // check for type
-      if (!expected_type->IsTensorType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type tensor.");
-      }
-      auto expected_element_type = expected_type->AsTensorType()->GetElementType();
-      auto input_element_type = input_ml_value.Get<Tensor>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "tensor"));
-
-      // check for shape
-      const auto& expected_shape = iter->second.tensor_shape;
-      if (expected_shape.NumDimensions() > 0) {
-        const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
-      }
-    } else if (input_ml_value.IsSparseTensor()) {
-      if (!expected_type->IsSparseTensorType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type sparse tensor.");
-      }
-      auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
-      const SparseTensor& sparse_tensor = input_ml_value.Get<SparseTensor>();
-      auto input_element_type = sparse_tensor.Values().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "sparse_tensor"));
-      // Check shape
-      const auto& expected_shape = iter->second.tensor_shape;
-      if (expected_shape.NumDimensions() > 0) {
-        const auto& input_shape = sparse_tensor.Shape();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
-      }
-    } else if (input_ml_value.IsTensorSequence()) {
-      if (!expected_type->IsTensorSequenceType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type tensor sequence.");
-      }
-      auto expected_element_type = expected_type->AsSequenceTensorBase()->GetElementType();
-      auto input_element_type = input_ml_value.Get<TensorSeq>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "seq"));
-    } else {
-      auto input_type = input_ml_value.Type();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_type, expected_type, ""));
-    }
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInput(feed_name, iter->second, feeds[i]));
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::ValidateInput(const std::string& feed_name, const InputDefMetaData& input_def,
+                                               const OrtValue& input_ml_value) const {
+  auto expected_type = input_def.ml_data_type;
+  if (input_ml_value.IsTensor()) {
+    // check for type
+    if (!expected_type->IsTensorType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type tensor.");
+    }
+    auto expected_element_type = expected_type->AsTensorType()->GetElementType();
+    auto input_element_type = input_ml_value.Get<Tensor>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "tensor"));
+
+    // check for shape
+    const auto& expected_shape = input_def.tensor_shape;
+    if (expected_shape.NumDimensions() > 0) {
+      const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
+    }
+  } else if (input_ml_value.IsSparseTensor()) {
+    if (!expected_type->IsSparseTensorType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type sparse tensor.");
+    }
+    auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
+    const SparseTensor& sparse_tensor = input_ml_value.Get<SparseTensor>();
+    auto input_element_type = sparse_tensor.Values().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "sparse_tensor"));
+    // Check shape
+    const auto& expected_shape = input_def.tensor_shape;
+    if (expected_shape.NumDimensions() > 0) {
+      const auto& input_shape = sparse_tensor.Shape();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
+    }
+  } else if (input_ml_value.IsTensorSequence()) {
+    if (!expected_type->IsTensorSequenceType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type tensor sequence.");
+    }
+    auto expected_element_type = expected_type->AsSequenceTensorBase()->GetElementType();
+    auto input_element_type = input_ml_value.Get<TensorSeq>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "seq"));
+  } else {
+    auto input_type = input_ml_value.Type();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_type, expected_type, ""));
   }
 
   return Status::OK();
@@ -1512,6 +1961,78 @@ common::Status InferenceSession::ValidateOutputs(const std::vector<std::string>&
   return common::Status::OK();
 }
 
+common::Status InferenceSession::ValidatePreparedRun(const PreparedRun& prepared_run,
+                                                     const std::vector<OrtValue>& feeds,
+                                                     const std::vector<OrtValue>* p_fetches) const {
+  if (&prepared_run.session != this) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The prepared run was created by another session.");
+  }
+
+  const auto& info = prepared_run.feeds_fetches_manager->GetFeedsFetchesInfo();
+  if (info.feed_names.size() != feeds.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: the prepared run has ",
+                           info.feed_names.size(), " feeds, but feeds has ", feeds.size(), " elements.");
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInput(info.feed_names[i], *prepared_run.input_defs[i], feeds[i]));
+  }
+
+  if (p_fetches == nullptr) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Output vector pointer is NULL");
+  }
+
+  if (!p_fetches->empty() && (info.output_names.size() != p_fetches->size())) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output vector incorrectly sized: the prepared run has ",
+                           info.output_names.size(), " outputs, but p_fetches has ", p_fetches->size(),
+                           " elements.");
+  }
+
+  return common::Status::OK();
+}
+
+common::Status InferenceSession::PrepareRun(const std::vector<std::string>& feed_names,
+                                            const std::vector<std::string>& output_names,
+                                            std::unique_ptr<PreparedRun>& prepared_run) const {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  std::vector<const InputDefMetaData*> input_defs;
+  input_defs.reserve(feed_names.size());
+  for (const auto& feed_name : feed_names) {
+    auto iter = input_def_map_.find(feed_name);
+    if (input_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
+    }
+    input_defs.push_back(&iter->second);
+  }
+
+  const std::vector<OrtValue> no_fetches;
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, &no_fetches));
+
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager;
+  ORT_RETURN_IF_ERROR_SESSIONID_(FeedsFetchesManager::Create(feed_names, output_names,
+                                                              session_state_->GetOrtValueNameIdxMap(),
+                                                              feeds_fetches_manager));
+
+  prepared_run = std::make_unique<PreparedRun>(*this, std::move(input_defs), std::move(feeds_fetches_manager));
+  return Status::OK();
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches) {
+  const auto& info = prepared_run.feeds_fetches_manager->GetFeedsFetchesInfo();
+  if (!streaming_states_.empty()) {
+    // the streaming states add feeds and fetches to the run, so it can't use the prepared names
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidatePreparedRun(prepared_run, feeds, p_fetches));
+    return RunWithStreamingState(run_options, info.feed_names, feeds, info.output_names, p_fetches, nullptr);
+  }
+
+  return RunImpl(run_options, info.feed_names, feeds, info.output_names, p_fetches, nullptr, &prepared_run);
+}
+
 #ifdef ENABLE_TRAINING
 Status InferenceSession::PartialRun(onnxruntime::RunOptions& run_options,
                                     const std::vector<OrtValue>& feeds,
@@ -1583,6 +2104,328 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
                              const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  const std::string& micro_batch_size_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigMicroBatchSize, "");
+  if (!micro_batch_size_str.empty()) {
+    int64_t micro_batch_size = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(micro_batch_size_str, micro_batch_size) && micro_batch_size > 0,
+                      "Invalid value for ", kOrtRunOptionsConfigMicroBatchSize, ": ", micro_batch_size_str);
+    ORT_RETURN_IF(!streaming_states_.empty(), "Micro-batching is not supported for a streaming session.");
+    ORT_RETURN_IF(graph_capture_provider_ != nullptr, "Micro-batching is not supported with graph capture.");
+    return RunInMicroBatches(run_options, micro_batch_size, feed_names, feeds, output_names, p_fetches,
+                             p_fetches_device_info);
+  }
+
+  if (!streaming_states_.empty()) {
+    return RunWithStreamingState(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+
+  if (result_cache_ != nullptr) {
+    return RunWithResultCache(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+}
+
+Status InferenceSession::RunWithStreamingState(const RunOptions& run_options,
+                                               const std::vector<std::string>& feed_names,
+                                               const std::vector<OrtValue>& feeds,
+                                               const std::vector<std::string>& output_names,
+                                               std::vector<OrtValue>* p_fetches,
+                                               const std::vector<OrtDevice>* p_fetches_device_info) {
+  // the state of a Run depends on the previous one, so the Runs can't overlap
+  std::lock_guard<onnxruntime::OrtMutex> lock(streaming_state_mutex_);
+
+  if (run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigResetStreamingState, "0") == "1") {
+    for (auto& state : streaming_states_) {
+      state.value = OrtValue();
+    }
+  }
+
+  std::vector<std::string> state_feed_names(feed_names);
+  std::vector<OrtValue> state_feeds(feeds);
+  std::vector<std::string> state_output_names(output_names);
+  std::vector<OrtDevice> state_fetches_device_info =
+      p_fetches_device_info != nullptr ? *p_fetches_device_info : std::vector<OrtDevice>(output_names.size());
+  std::vector<size_t> state_fetch_indices;
+  state_fetch_indices.reserve(streaming_states_.size());
+
+  for (auto& state : streaming_states_) {
+    // a state input that is fed explicitly overrides the carried state
+    if (std::find(feed_names.cbegin(), feed_names.cend(), state.input_name) == feed_names.cend()) {
+      if (!state.value.IsAllocated()) {
+        const auto* input = model_->MainGraph().GetNodeArg(state.input_name);
+        const auto* shape = input->Shape();
+        ORT_RETURN_IF(shape == nullptr,
+                      "The initial value of the streaming state input '", state.input_name,
+                      "' must be fed as the model does not declare its shape.");
+        auto tensor_shape = utils::GetTensorShapeFromTensorShapeProto(*shape);
+        ORT_RETURN_IF(tensor_shape.Size() < 0,
+                      "The initial value of the streaming state input '", state.input_name,
+                      "' must be fed as the model declares a symbolic shape for it.");
+        const auto* element_type =
+            DataTypeImpl::TypeFromProto(*input->TypeAsProto())->AsTensorType()->GetElementType();
+        ORT_RETURN_IF(utils::IsDataTypeString(element_type),
+                      "The initial value of the streaming state input '", state.input_name, "' must be fed.");
+
+        auto tensor = std::make_unique<Tensor>(element_type, tensor_shape,
+                                              session_state_->GetAllocator(OrtDevice()));
+        memset(tensor->MutableDataRaw(), 0, tensor->SizeInBytes());
+        auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+        state.value.Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+      }
+
+      state_feed_names.push_back(state.input_name);
+      state_feeds.push_back(state.value);
+    }
+
+    auto output = std::find(output_names.cbegin(), output_names.cend(), state.output_name);
+    if (output == output_names.cend()) {
+      // keep the state on the device that produces it, the next Run consumes it there
+      state_fetch_indices.push_back(state_output_names.size());
+      state_output_names.push_back(state.output_name);
+      state_fetches_device_info.push_back(utils::FindMemoryInfoForValue(*session_state_, state.output_name).device);
+    } else {
+      state_fetch_indices.push_back(static_cast<size_t>(output - output_names.cbegin()));
+    }
+  }
+
+  std::vector<OrtValue> state_fetches(*p_fetches);
+  if (!state_fetches.empty()) {
+    state_fetches.resize(state_output_names.size());
+  }
+
+  ORT_RETURN_IF_ERROR_SESSIONID_(RunImpl(run_options, state_feed_names, state_feeds, state_output_names,
+                                         &state_fetches, &state_fetches_device_info));
+
+  for (size_t i = 0; i < streaming_states_.size(); ++i) {
+    streaming_states_[i].value = state_fetches[state_fetch_indices[i]];
+  }
+
+  state_fetches.resize(output_names.size());
+  *p_fetches = std::move(state_fetches);
+  return Status::OK();
+}
+
+// A tensor viewing the rows [start, start + rows) of the first dimension of the tensor in value.
+static OrtValue SliceBatch(const OrtValue& value, int64_t start, int64_t rows) {
+  const auto& tensor = value.Get<Tensor>();
+  TensorShape shape = tensor.Shape();
+  const int64_t row_size = shape.SizeFromDimension(1);
+  shape[0] = rows;
+  auto* data = static_cast<char*>(const_cast<void*>(tensor.DataRaw())) +
+               start * row_size * static_cast<int64_t>(tensor.DataType()->Size());
+  auto slice = std::make_unique<Tensor>(tensor.DataType(), shape, data, tensor.Location());
+  OrtValue slice_value;
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  slice_value.Init(slice.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  return slice_value;
+}
+
+Status InferenceSession::RunInMicroBatches(const RunOptions& run_options, int64_t micro_batch_size,
+                                           const std::vector<std::string>& feed_names,
+                                           const std::vector<OrtValue>& feeds,
+                                           const std::vector<std::string>& output_names,
+                                           std::vector<OrtValue>* p_fetches,
+                                           const std::vector<OrtDevice>* p_fetches_device_info) {
+  int64_t batch_size = -1;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF(!feeds[i].IsTensor() || feeds[i].Get<Tensor>().Shape().NumDimensions() == 0,
+                  "Micro-batching requires every feed to be a tensor with a batch dimension. Feed '", feed_names[i],
+                  "' is not.");
+    const int64_t rows = feeds[i].Get<Tensor>().Shape()[0];
+    ORT_RETURN_IF(batch_size != -1 && rows != batch_size,
+                  "Micro-batching requires every feed to have the same batch size. Feed '", feed_names[i],
+                  "' has a batch of ", rows, " while the previous feeds have a batch of ", batch_size, ".");
+    batch_size = rows;
+  }
+
+  if (batch_size <= micro_batch_size) {
+    return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+
+  // the full outputs, pre-allocated by the caller or allocated like the outputs of the first micro-batch
+  std::vector<OrtValue> outputs(*p_fetches);
+  outputs.resize(output_names.size());
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i].IsAllocated()) {
+      ORT_RETURN_IF(!outputs[i].IsTensor() || outputs[i].Get<Tensor>().Shape().NumDimensions() == 0 ||
+                        outputs[i].Get<Tensor>().Shape()[0] != batch_size,
+                    "The pre-allocated output '", output_names[i], "' must be a tensor with a batch of ", batch_size,
+                    " for micro-batching.");
+    }
+  }
+
+  const auto& data_transfer_mgr = session_state_->GetDataTransferMgr();
+  for (int64_t start = 0; start < batch_size; start += micro_batch_size) {
+    const int64_t rows = std::min(micro_batch_size, batch_size - start);
+
+    std::vector<OrtValue> micro_batch_feeds;
+    micro_batch_feeds.reserve(feeds.size());
+    for (const auto& feed : feeds) {
+      micro_batch_feeds.push_back(SliceBatch(feed, start, rows));
+    }
+
+    // the micro-batch writes straight into the slices of the full outputs once they're allocated
+    std::vector<OrtValue> micro_batch_fetches(outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      if (outputs[i].IsAllocated()) {
+        micro_batch_fetches[i] = SliceBatch(outputs[i], start, rows);
+      }
+    }
+
+    ORT_RETURN_IF_ERROR_SESSIONID_(RunImpl(run_options, feed_names, micro_batch_feeds, output_names,
+                                           &micro_batch_fetches, p_fetches_device_info));
+
+    if (start != 0) {
+      continue;
+    }
+
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      if (outputs[i].IsAllocated()) {
+        continue;
+      }
+
+      const auto& fetch = micro_batch_fetches[i];
+      ORT_RETURN_IF(!fetch.IsTensor() || fetch.Get<Tensor>().Shape().NumDimensions() == 0 ||
+                        fetch.Get<Tensor>().Shape()[0] != rows || fetch.Get<Tensor>().IsDataTypeString(),
+                    "Micro-batching requires every output to be a non-string tensor with the batch as its first "
+                    "dimension. Output '", output_names[i], "' is not.");
+      const auto& tensor = fetch.Get<Tensor>();
+      auto allocator = session_state_->GetAllocator(tensor.Location());
+      ORT_RETURN_IF(allocator == nullptr, "No allocator for the location of output '", output_names[i], "'.");
+
+      TensorShape shape = tensor.Shape();
+      shape[0] = batch_size;
+      auto output = std::make_unique<Tensor>(tensor.DataType(), shape, allocator);
+      auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+      outputs[i].Init(output.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+
+      OrtValue first_slice = SliceBatch(outputs[i], 0, rows);
+      ORT_RETURN_IF_ERROR_SESSIONID_(data_transfer_mgr.CopyTensor(tensor, *first_slice.GetMutable<Tensor>()));
+    }
+  }
+
+  *p_fetches = std::move(outputs);
+  return Status::OK();
+}
+
+Status InferenceSession::RunWithResultCache(const RunOptions& run_options,
+                                            const std::vector<std::string>& feed_names,
+                                            const std::vector<OrtValue>& feeds,
+                                            const std::vector<std::string>& output_names,
+                                            std::vector<OrtValue>* p_fetches,
+                                            const std::vector<OrtDevice>* p_fetches_device_info) {
+  // pre-allocated fetches and outputs requested on a device are written by the execution, which a hit skips
+  const bool fetches_to_cpu =
+      p_fetches_device_info == nullptr ||
+      std::all_of(p_fetches_device_info->cbegin(), p_fetches_device_info->cend(),
+                  [](const OrtDevice& device) { return device.Type() == OrtDevice::CPU; });
+  if (!p_fetches->empty() || !fetches_to_cpu || !InferenceResultCache::IsCacheable(feeds)) {
+    return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+
+  const auto run_start = std::chrono::steady_clock::now();
+  if (result_cache_->Lookup(feed_names, feeds, output_names, session_state_->GetAllocator(OrtDevice()), *p_fetches)) {
+    run_metrics_.Record(std::chrono::steady_clock::now() - run_start, true);
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR_SESSIONID_(RunImpl(run_options, feed_names, feeds, output_names, p_fetches,
+                                         p_fetches_device_info));
+  result_cache_->Insert(feed_names, feeds, output_names, *p_fetches);
+  return Status::OK();
+}
+
+constexpr double InferenceSession::RunMetrics::kLatencyBuckets[];
+
+void InferenceSession::RunMetrics::Record(std::chrono::steady_clock::duration latency, bool succeeded) {
+  const double seconds = std::chrono::duration<double>(latency).count();
+  size_t bucket = 0;
+  while (bucket + 1 < kNumLatencyBuckets && seconds > kLatencyBuckets[bucket]) {
+    ++bucket;
+  }
+  latency_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+  latency_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count(),
+                       std::memory_order_relaxed);
+  runs.fetch_add(1, std::memory_order_relaxed);
+  if (!succeeded) {
+    failed_runs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void InferenceSession::GetMetrics(const std::function<void(const std::string& name, double value)>& report) const {
+  report("onnxruntime_session_runs_total", static_cast<double>(run_metrics_.runs.load()));
+  report("onnxruntime_session_run_failures_total", static_cast<double>(run_metrics_.failed_runs.load()));
+  uint64_t cumulative_count = 0;
+  for (size_t i = 0; i < RunMetrics::kNumLatencyBuckets; ++i) {
+    cumulative_count += run_metrics_.latency_counts[i].load();
+    std::ostringstream bound;
+    if (i + 1 < RunMetrics::kNumLatencyBuckets) {
+      bound << RunMetrics::kLatencyBuckets[i];
+    } else {
+      bound << "+Inf";
+    }
+    report("onnxruntime_session_run_latency_seconds_bucket{le=\"" + bound.str() + "\"}",
+           static_cast<double>(cumulative_count));
+  }
+  report("onnxruntime_session_run_latency_seconds_sum", run_metrics_.latency_ns.load() * 1e-9);
+  report("onnxruntime_session_run_latency_seconds_count", static_cast<double>(cumulative_count));
+
+  if (result_cache_ != nullptr) {
+    const auto cache_stats = result_cache_->GetStats();
+    report("onnxruntime_session_result_cache_hits_total", static_cast<double>(cache_stats.hits));
+    report("onnxruntime_session_result_cache_misses_total", static_cast<double>(cache_stats.misses));
+    report("onnxruntime_session_result_cache_evictions_total", static_cast<double>(cache_stats.evictions));
+    report("onnxruntime_session_result_cache_bytes", static_cast<double>(cache_stats.bytes));
+    report("onnxruntime_session_result_cache_entries", static_cast<double>(cache_stats.entries));
+  }
+
+  auto report_thread_pool = [&report](const char* pool, const concurrency::ThreadPool* tp) {
+    if (tp == nullptr) {
+      return;
+    }
+    const auto utilization = concurrency::ThreadPool::GetUtilization(tp);
+    const std::string labels = std::string("{pool=\"") + pool + "\"}";
+    report("onnxruntime_thread_pool_threads" + labels, utilization.num_threads);
+    report("onnxruntime_thread_pool_parallel_loops_total" + labels, static_cast<double>(utilization.parallel_loops));
+    report("onnxruntime_thread_pool_parallel_loop_seconds_total" + labels, utilization.parallel_loop_ns * 1e-9);
+    report("onnxruntime_thread_pool_worker_busy_seconds_total" + labels, utilization.worker_busy_ns * 1e-9);
+    report("onnxruntime_thread_pool_scheduled_tasks_total" + labels, static_cast<double>(utilization.scheduled_tasks));
+    report("onnxruntime_thread_pool_task_queue_seconds_total" + labels, utilization.task_queue_ns * 1e-9);
+  };
+  report_thread_pool("intra_op", GetIntraOpThreadPoolToUse());
+  report_thread_pool("inter_op", GetInterOpThreadPoolToUse());
+
+  // allocators may be shared between execution providers
+  std::unordered_set<const IAllocator*> reported_arenas;
+  for (const auto& xp : execution_providers_) {
+    for (const auto& alloc : xp->GetAllocators()) {
+      if (alloc->Info().alloc_type != OrtAllocatorType::OrtArenaAllocator ||
+          !reported_arenas.insert(alloc.get()).second) {
+        continue;
+      }
+      AllocatorStats stats;
+      static_cast<IArenaAllocator*>(alloc.get())->GetStats(&stats);
+      std::ostringstream labels;
+      labels << "{allocator=\"" << alloc->Info().name << "\",device_id=\"" << alloc->Info().id << "\"}";
+      report("onnxruntime_arena_bytes_in_use" + labels.str(), static_cast<double>(stats.bytes_in_use));
+      report("onnxruntime_arena_max_bytes_in_use" + labels.str(), static_cast<double>(stats.max_bytes_in_use));
+    }
+  }
+
+  const auto transfers = data_transfer_mgr_.GetStats();
+  report("onnxruntime_host_to_device_bytes_total", static_cast<double>(transfers.host_to_device_bytes));
+  report("onnxruntime_device_to_host_bytes_total", static_cast<double>(transfers.device_to_host_bytes));
+  report("onnxruntime_device_to_device_bytes_total", static_cast<double>(transfers.device_to_device_bytes));
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                 const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 PreparedRun* prepared_run) {
+  const auto run_start = std::chrono::steady_clock::now();
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Now();
@@ -1610,8 +2453,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
     // log evaluation start to trace logging provider
     env.GetTelemetryProvider().LogEvaluationStart();
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+    if (prepared_run == nullptr) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+    } else {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidatePreparedRun(*prepared_run, feeds, p_fetches));
+    }
 
     // shrink certain default memory arenas if the user has requested for it
     const std::string& shrink_memory_arenas =
@@ -1621,8 +2468,18 @@ Status InferenceSession::Run(const RunOptions& run_options,
       ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
     }
 
-    FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-    FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+    std::unique_ptr<FeedsFetchesManager> owned_feeds_fetches_manager;
+    if (prepared_run == nullptr) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(FeedsFetchesManager::Create(feed_names, output_names,
+                                                                  session_state_->GetOrtValueNameIdxMap(),
+                                                                  owned_feeds_fetches_manager));
+    }
+    FeedsFetchesManager& feeds_fetches_manager =
+        prepared_run != nullptr ? *prepared_run->feeds_fetches_manager : *owned_feeds_fetches_manager;
+    if (prepared_run != nullptr) {
+      // the devices of the feeds and fetches of the previous run may differ
+      feeds_fetches_manager.ResetDeviceCopyInfo();
+    }
 
     if (p_fetches_device_info) {
       // populate the target device info. ignored if pre-allocated fetches are provided
@@ -1638,6 +2495,32 @@ Status InferenceSession::Run(const RunOptions& run_options,
       LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
     }
 
+    std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+    if (!run_options.output_buffers.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(
+          CreateOutputBufferAllocators(run_options, output_names, *p_fetches, fetch_allocators));
+    }
+
+    // A graph captured by the provider (e.g. a CUDA graph) bakes in the addresses of the feeds and fetches,
+    // so it is only replayed while the same buffers with the same shapes are used.
+    std::vector<std::pair<const void*, TensorShape>> graph_replay_io_signature;
+    if (graph_capture_provider_ != nullptr) {
+      ORT_RETURN_IF_NOT(p_fetches->size() == output_names.size(),
+                        "Graph capture requires all outputs to be pre-allocated, e.g. bound via IOBinding.");
+      ORT_RETURN_IF_ERROR_SESSIONID_(GetGraphReplayIoSignature(feeds, *p_fetches, graph_replay_io_signature));
+
+      if (graph_capture_provider_->IsGraphCaptured()) {
+        if (graph_replay_io_signature == graph_replay_io_signature_) {
+          LOGS(*session_logger_, VERBOSE) << "Replaying the captured graph for this model";
+          return graph_capture_provider_->ReplayGraph();
+        }
+
+        LOGS(*session_logger_, INFO) << "Feeds or fetches changed since the graph was captured. "
+                                     << "The graph will be captured again.";
+        graph_capture_provider_->ResetGraph();
+      }
+    }
+
     ++current_num_runs_;
 
     // scope of owned_run_logger is just the call to Execute.
@@ -1666,10 +2549,20 @@ Status InferenceSession::Run(const RunOptions& run_options,
     }
 #endif
 
+    std::unique_ptr<concurrency::ThreadPool::KeepWorkersHot> keep_workers_hot;
+    if (run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigKeepIntraOpWorkersHot, "0") == "1") {
+      keep_workers_hot = std::make_unique<concurrency::ThreadPool::KeepWorkersHot>(GetIntraOpThreadPoolToUse());
+    }
+
     // execute the graph
     ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
-                                                 session_options_.execution_mode, run_options.terminate, run_logger,
+                                                 fetch_allocators, session_options_.execution_mode,
+                                                 run_options.terminate, run_logger,
                                                  run_options.only_execute_path_to_fetches));
+
+    if (graph_capture_provider_ != nullptr) {
+      graph_replay_io_signature_ = std::move(graph_replay_io_signature);
+    }
   }
   ORT_CATCH(const std::exception& e) {
     ORT_HANDLE_EXCEPTION([&]() {
@@ -1692,6 +2585,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
   --current_num_runs_;
 
+  run_metrics_.Record(std::chrono::steady_clock::now() - run_start, retval.IsOK());
+
   // keep track of telemetry
   ++telemetry_.total_runs_since_last_;
   telemetry_.total_run_duration_since_last_ += TimeDiffMicroSeconds(tp);
@@ -1720,6 +2615,215 @@ Status InferenceSession::Run(const RunOptions& run_options,
   return retval;
 }
 
+common::Status InferenceSession::SetupGraphCaptureProvider() {
+  graph_capture_provider_ = nullptr;
+
+  for (auto& xp : execution_providers_) {
+    if (!xp->IsGraphCaptureEnabled()) {
+      continue;
+    }
+
+    ORT_RETURN_IF(graph_capture_provider_ != nullptr,
+                  "Graph capture can be enabled for at most one execution provider in a session.");
+    ORT_RETURN_IF(session_options_.execution_mode != ExecutionMode::ORT_SEQUENTIAL,
+                  "Graph capture requires the sequential execution mode.");
+
+    // the captured graph must cover the whole execution, so every node has to run on the capturing provider
+    // and there must be no control flow nodes whose subgraphs are executed on demand.
+    const auto& provider_type = xp->Type();
+    for (const auto& node : model_->MainGraph().Nodes()) {
+      ORT_RETURN_IF(node.GetExecutionProviderType() != provider_type,
+                    "Graph capture is enabled for ", provider_type, " but node '", node.Name(), "' (", node.OpType(),
+                    ") is assigned to ", node.GetExecutionProviderType(),
+                    ". All nodes must be assigned to the provider that captures the graph.");
+      ORT_RETURN_IF(node.ContainsSubgraph(),
+                    "Graph capture is not supported for models with control flow nodes. Node: ", node.Name());
+    }
+
+    graph_capture_provider_ = xp.get();
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::SetupStreamingState() {
+  streaming_states_.clear();
+
+  const std::string& state_pairs =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigStreamingState, "");
+  if (state_pairs.empty()) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF(graph_capture_provider_ != nullptr, "Graph capture is not supported for a streaming session.");
+
+  const auto& graph = model_->MainGraph();
+  const auto& graph_inputs = graph.GetInputs();
+  const auto& graph_outputs = graph.GetOutputs();
+
+  std::istringstream ss_1(state_pairs);
+  std::string state_pair;
+
+  while (std::getline(ss_1, state_pair, ';')) {
+    auto separator = state_pair.find(':');
+    ORT_RETURN_IF(separator == std::string::npos || state_pair.find(':', separator + 1) != std::string::npos,
+                  "Invalid streaming state '", state_pair, "'. It must be of the form 'state_input:state_output'.");
+
+    StreamingState state;
+    state.input_name = state_pair.substr(0, separator);
+    state.output_name = state_pair.substr(separator + 1);
+
+    auto input = std::find_if(graph_inputs.cbegin(), graph_inputs.cend(),
+                              [&state](const NodeArg* arg) { return arg->Name() == state.input_name; });
+    ORT_RETURN_IF(input == graph_inputs.cend(),
+                  "The streaming state input '", state.input_name, "' is not an input of the model.");
+    auto output = std::find_if(graph_outputs.cbegin(), graph_outputs.cend(),
+                               [&state](const NodeArg* arg) { return arg->Name() == state.output_name; });
+    ORT_RETURN_IF(output == graph_outputs.cend(),
+                  "The streaming state output '", state.output_name, "' is not an output of the model.");
+    ORT_RETURN_IF((*input)->Type() == nullptr || (*input)->Type() != (*output)->Type(),
+                  "The streaming state input '", state.input_name, "' and output '", state.output_name,
+                  "' must have the same type.");
+    ORT_RETURN_IF(!(*input)->TypeAsProto()->has_tensor_type(),
+                  "The streaming state input '", state.input_name, "' must be a tensor.");
+
+    for (const auto& existing : streaming_states_) {
+      ORT_RETURN_IF(existing.input_name == state.input_name,
+                    "The streaming state input '", state.input_name, "' is listed more than once.");
+    }
+
+    streaming_states_.push_back(std::move(state));
+  }
+
+  LOGS(*session_logger_, INFO) << "Streaming session carrying " << streaming_states_.size()
+                               << " state value(s) between Runs";
+  return Status::OK();
+}
+
+// Whether the graph or one of its subgraphs has a node whose outputs don't only depend on its inputs.
+static bool HasNondeterministicNode(const Graph& graph) {
+  static const std::unordered_set<std::string> nondeterministic_ops = {
+      "RandomNormal", "RandomNormalLike", "RandomUniform", "RandomUniformLike", "Multinomial", "Bernoulli"};
+
+  for (const auto& node : graph.Nodes()) {
+    if (nondeterministic_ops.count(node.OpType()) != 0) {
+      return true;
+    }
+    for (const auto& subgraph : node.GetSubgraphs()) {
+      if (HasNondeterministicNode(*subgraph)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+common::Status InferenceSession::SetupResultCache() {
+  result_cache_.reset();
+
+  const std::string& max_bytes_str =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigResultCacheMaxBytes, "0");
+  size_t max_bytes = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(max_bytes_str, max_bytes),
+                    "Invalid value for ", kOrtSessionOptionsConfigResultCacheMaxBytes, ": ", max_bytes_str);
+  if (max_bytes == 0) {
+    return Status::OK();
+  }
+
+  const std::string& ttl_str =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigResultCacheTtlMs, "0");
+  int64_t ttl_ms = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(ttl_str, ttl_ms) && ttl_ms >= 0,
+                    "Invalid value for ", kOrtSessionOptionsConfigResultCacheTtlMs, ": ", ttl_str);
+
+  if (!streaming_states_.empty()) {
+    LOGS(*session_logger_, WARNING) << "The result cache is not enabled as the outputs of a streaming session "
+                                    << "depend on the previous Runs.";
+    return Status::OK();
+  }
+
+  if (HasNondeterministicNode(model_->MainGraph())) {
+    LOGS(*session_logger_, WARNING) << "The result cache is not enabled as the model has random number generator "
+                                    << "operators.";
+    return Status::OK();
+  }
+
+  result_cache_ = std::make_unique<InferenceResultCache>(max_bytes, std::chrono::milliseconds(ttl_ms));
+  LOGS(*session_logger_, INFO) << "Caching the outputs of the Runs in up to " << max_bytes << " bytes";
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetGraphReplayIoSignature(
+    const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches,
+    std::vector<std::pair<const void*, TensorShape>>& signature) const {
+  signature.clear();
+  signature.reserve(feeds.size() + fetches.size());
+
+  for (const auto& feed : feeds) {
+    ORT_RETURN_IF_NOT(feed.IsTensor(), "Graph capture only supports tensor inputs.");
+    const auto& tensor = feed.Get<Tensor>();
+    ORT_RETURN_IF(tensor.Location().device.Type() == OrtDevice::CPU,
+                  "Graph capture requires all inputs to be bound to device memory.");
+    signature.emplace_back(tensor.DataRaw(), tensor.Shape());
+  }
+
+  for (const auto& fetch : fetches) {
+    ORT_RETURN_IF_NOT(fetch.IsAllocated() && fetch.IsTensor(),
+                      "Graph capture requires all outputs to be pre-allocated tensors, e.g. bound via IOBinding.");
+    const auto& tensor = fetch.Get<Tensor>();
+    ORT_RETURN_IF(tensor.Location().device.Type() == OrtDevice::CPU,
+                  "Graph capture requires all outputs to be bound to device memory.");
+    signature.emplace_back(tensor.DataRaw(), tensor.Shape());
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::CreateOutputBufferAllocators(
+    const RunOptions& run_options, const std::vector<std::string>& output_names,
+    const std::vector<OrtValue>& fetches,
+    std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) const {
+  for (size_t i = 0, end = output_names.size(); i < end; ++i) {
+    auto buffer_entry = run_options.output_buffers.find(output_names[i]);
+    if (buffer_entry == run_options.output_buffers.cend() || (!fetches.empty() && fetches[i].IsAllocated())) {
+      continue;
+    }
+
+    auto output_def = std::find_if(output_def_list_.cbegin(), output_def_list_.cend(),
+                                   [&output_names, i](const NodeArg* arg) { return arg->Name() == output_names[i]; });
+    ORT_RETURN_IF(output_def == output_def_list_.cend() || (*output_def)->TypeAsProto() == nullptr,
+                  "Unknown type for output ", output_names[i]);
+
+    const auto* tensor_type = DataTypeImpl::TypeFromProto(*(*output_def)->TypeAsProto())->AsTensorType();
+    if (tensor_type == nullptr || utils::IsDataTypeString(tensor_type->GetElementType())) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "An output buffer was set for output ", output_names[i],
+                             " which is not a tensor of a numeric type.");
+    }
+
+    MLDataType element_type = tensor_type->GetElementType();
+    const RunOptions::OutputBuffer buffer = buffer_entry->second;
+
+    // write the output into the caller's buffer if it fits and is on the device the output is produced on.
+    // otherwise leave 'allocated' false so the execution frame allocates it.
+    fetch_allocators[i] = [element_type, buffer](const TensorShape& shape, const OrtMemoryInfo& location,
+                                                 OrtValue& ort_value, bool& allocated) {
+      size_t size_in_bytes = 0;
+      if (buffer.memory_info.device == location.device &&
+          IAllocator::CalcMemSizeForArray(static_cast<size_t>(shape.Size()), element_type->Size(), &size_in_bytes) &&
+          size_in_bytes <= buffer.size) {
+        auto p_tensor = std::make_unique<Tensor>(element_type, shape, buffer.data, buffer.memory_info);
+        auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+        ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+        allocated = true;
+      }
+
+      return Status::OK();
+    };
+  }
+
+  return Status::OK();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
@@ -1818,6 +2922,56 @@ common::Status InferenceSession::Run(IOBinding& io_binding) {
   return Run(run_options, io_binding);
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions* run_options, const std::vector<std::string>& feed_names,
+                                          const std::vector<OrtValue>& feeds,
+                                          const std::vector<std::string>& output_names,
+                                          std::vector<OrtValue>&& fetches, RunAsyncCallback callback) {
+  ORT_RETURN_IF_NOT(callback, "RunAsync requires a callback.");
+
+  // prefer the inter-op threads so the async runs do not compete with the kernels for the intra-op threads
+  concurrency::ThreadPool* tp = GetInterOpThreadPoolToUse();
+  if (tp == nullptr || tp->NumThreads() == 0) {
+    tp = GetIntraOpThreadPoolToUse();
+  }
+  if (tp == nullptr || tp->NumThreads() == 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "RunAsync requires a thread pool with at least one thread. "
+                           "Set the number of intra-op or inter-op threads of the session above 1.");
+  }
+
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(async_runs_mutex_);
+    ++num_async_runs_;
+  }
+
+  tp->Schedule([this, run_options, feed_names, feeds, output_names, fetches = std::move(fetches),
+                callback = std::move(callback)]() mutable {
+    Status status;
+    ORT_TRY {
+      if (run_options) {
+        status = Run(*run_options, feed_names, feeds, output_names, &fetches);
+      } else {
+        RunOptions default_run_options;
+        status = Run(default_run_options, feed_names, feeds, output_names, &fetches);
+      }
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, e.what());
+      });
+    }
+
+    callback(fetches, status);
+
+    std::lock_guard<onnxruntime::OrtMutex> l(async_runs_mutex_);
+    if (--num_async_runs_ == 0) {
+      async_runs_done_.notify_all();
+    }
+  });
+
+  return Status::OK();
+}
+
 template <typename T>
 void InferenceSession::StartProfiling(const std::basic_string<T>& file_prefix) {
   std::basic_ostringstream<T> ss;
@@ -1856,6 +3010,42 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+common::Status InferenceSession::StartCalibration(const std::vector<std::string>& tensor_names, size_t num_bins) {
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session was not initialized");
+  }
+
+  if (session_options_.execution_mode != ExecutionMode::ORT_SEQUENTIAL) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Calibration requires the sequential execution mode.");
+  }
+
+  if (num_bins == 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The number of histogram bins must be positive.");
+  }
+
+  // restart from scratch if already started
+  calibration_collector_ = std::make_unique<TensorCalibrationCollector>(tensor_names, num_bins);
+  session_state_->SetCalibrationCollector(calibration_collector_.get());
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetCalibrationStats(
+    std::unordered_map<std::string, TensorCalibrationCollector::TensorStats>& stats) const {
+  if (calibration_collector_ == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Calibration was not started.");
+  }
+
+  stats = calibration_collector_->GetStats();
+  return Status::OK();
+}
+
+void InferenceSession::EndCalibration() {
+  if (calibration_collector_ != nullptr) {
+    session_state_->SetCalibrationCollector(nullptr);
+    calibration_collector_.reset();
+  }
+}
+
 AllocatorPtr InferenceSession::GetAllocator(const OrtMemoryInfo& mem_info) const {
   return session_state_->GetAllocator(mem_info);
 }
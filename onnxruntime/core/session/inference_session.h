@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 
@@ -11,14 +12,19 @@
 #include "core/common/profiler.h"
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
+#include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/iexecutor.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/session_state.h"
+#include "core/framework/inference_result_cache.h"
+#include "core/framework/tensor_calibration_collector.h"
 #include "core/graph/basic_types.h"
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
 #include "core/framework/session_options.h"
 #include "core/framework/allocatormgr.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
@@ -268,6 +274,16 @@ class InferenceSession {
     */
   common::Status Initialize() ORT_MUST_USE_RESULT;
 
+  /**
+    * Initializes the subgraphs of the given control flow nodes ahead of their first Run when the session defers that
+    * with kOrtSessionOptionsConfigLazySubgraphInitialization. A node can be in a subgraph, in which case the subgraphs
+    * containing it are initialized as well. Every subgraph is initialized if node_names is empty.
+    * Does nothing but check the node names when the subgraphs are not deferred.
+    * This API is thread-safe.
+    * @return OK if success, INVALID_ARGUMENT if a node is not found.
+    */
+  common::Status InitializeSubgraphs(const std::vector<std::string>& node_names) ORT_MUST_USE_RESULT;
+
   common::Status Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
                      const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
                      std::vector<OrtValue>* p_fetches,
@@ -295,6 +311,52 @@ class InferenceSession {
                      const std::vector<std::string>& output_names,
                      std::vector<OrtValue>* p_fetches) ORT_MUST_USE_RESULT;
 
+  /**
+   * Callback of RunAsync. Gets the fetches in the order of output_names and the status of the run.
+   */
+  using RunAsyncCallback = std::function<void(std::vector<OrtValue>& fetches, const common::Status& status)>;
+
+  /**
+    * Run a pre-loaded and pre-intialized model without blocking the calling thread.
+    * The run is scheduled on the inter-op thread pool of the session, or on the intra-op thread
+    * pool when there is no inter-op thread pool, and callback is invoked from the thread that ran it.
+    * Multiple threads are allowed to call this function; hence its thread-safe.
+    * @param run_options optional, must stay valid until callback is invoked so the run can be terminated.
+    * @param feed_names, feeds, output_names are copied, the memory of the feeds is not.
+    * @param fetches pre-allocated output values, or empty to let the session allocate them.
+    * @param callback must not release the session.
+    * @return an error if the session has no thread pool to run on. callback is not invoked then.
+    */
+  common::Status RunAsync(const RunOptions* run_options, const std::vector<std::string>& feed_names,
+                          const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                          std::vector<OrtValue>&& fetches, RunAsyncCallback callback) ORT_MUST_USE_RESULT;
+
+  /**
+   * The feeds and fetches of a Run resolved once by PrepareRun. See PrepareRun.
+   */
+  struct PreparedRun;
+
+  /**
+    * Resolves the names of the feeds and fetches to the values of the graph and looks up the type information of
+    * the feeds once, so that Run calls with the prepared_run skip the name lookups and the set up of the
+    * feeds/fetches manager. The types and shapes of the feeds are still checked by each Run.
+    * A prepared run belongs to this session. It must not be used by concurrent Run calls as each Run updates it,
+    * create one per thread instead.
+    * @param feed_names, output_names are the names of the feeds and fetches of the Run calls, in order.
+    * @return OK if success, INVALID_ARGUMENT if a name is not an input or output of the model.
+    */
+  common::Status PrepareRun(const std::vector<std::string>& feed_names, const std::vector<std::string>& output_names,
+                            std::unique_ptr<PreparedRun>& prepared_run) const ORT_MUST_USE_RESULT;
+
+  /**
+    * Run a pre-loaded and pre-intialized model with feeds and fetches resolved by PrepareRun.
+    * @param feeds in the order of the feed names of prepared_run.
+    * @param p_fetches output values in the order of the output names of prepared_run, pre-allocated or empty.
+    * @return OK if success.
+    */
+  common::Status Run(const RunOptions& run_options, PreparedRun& prepared_run, const std::vector<OrtValue>& feeds,
+                     std::vector<OrtValue>* p_fetches) ORT_MUST_USE_RESULT;
+
   /**
   * Creates a new binding object for binding inputs and outputs.
   * @param provider_type specifies the location where the inputs need to be potentially copied.
@@ -406,6 +468,28 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Start the calibration mode, in which the following Run calls collect the range and histogram of the float
+    * tensors produced by the nodes of the main graph and of the graph inputs, for the calibration of static
+    * quantization. The tensors don't need to be graph outputs, and are collected on the intra-op thread pool as the
+    * nodes produce them. Requires the sequential execution mode. Must not be called concurrently with Run.
+    * Calling it again discards what was collected. See TensorCalibrationCollector.
+    * @param tensor_names The names of the tensors to collect, or empty to collect all of them.
+    * @param num_bins The number of bins of the histogram of a tensor when it is first collected.
+    */
+  common::Status StartCalibration(const std::vector<std::string>& tensor_names, size_t num_bins);
+
+  /**
+    * Get what was collected since StartCalibration by tensor name.
+    */
+  common::Status GetCalibrationStats(
+      std::unordered_map<std::string, TensorCalibrationCollector::TensorStats>& stats) const;
+
+  /**
+    * End the calibration mode and discard what was collected. Must not be called concurrently with Run.
+    */
+  void EndCalibration();
+
   /**
     * Search registered execution providers for an allocator that has characteristics
     * specified within mem_info
@@ -428,6 +512,19 @@ class InferenceSession {
     return *session_state_;
   }
 
+  /**
+    * Report the always-on metrics of the session, for example to export them to a monitoring system.
+    * Each metric is reported as a Prometheus sample name, including its labels, and a value, so that writing
+    * '<name> <value>' lines gives the Prometheus text exposition format. The metrics are
+    * - the number, failures and latency histogram of the Run calls that passed the validation of their inputs,
+    * - the utilization counters of the intra-op and inter-op thread pools (see concurrency::ThreadPoolUtilization),
+    *   which are shared with other sessions when the env's global thread pools are used,
+    * - the bytes in use and peak bytes in use of each arena used by the session, and
+    * - the bytes copied between the host and the devices.
+    * Counters are cumulative since the session (or thread pool) was created.
+    */
+  void GetMetrics(const std::function<void(const std::string& name, double value)>& report) const;
+
  protected:
 #if !defined(ORT_MINIMAL_BUILD)
   /**
@@ -458,6 +555,9 @@ class InferenceSession {
   }
 
   onnxruntime::concurrency::ThreadPool* GetInterOpThreadPoolToUse() const {
+    if (use_unified_thread_pool_) {
+      return GetIntraOpThreadPoolToUse();
+    }
     return session_options_.use_per_session_threads ? inter_op_thread_pool_.get() : inter_op_thread_pool_from_env_;
   }
 
@@ -495,6 +595,8 @@ class InferenceSession {
   template <typename T>
   common::Status Load(const std::basic_string<T>& model_uri) ORT_MUST_USE_RESULT;
 
+  bool MapOnnxModelBytes(const std::basic_string<ORTCHAR_T>& model_location, gsl::span<const uint8_t>& bytes);
+
   bool HasLocalSchema() const {
     return !custom_schema_registries_.empty();
   }
@@ -525,6 +627,25 @@ class InferenceSession {
 
   common::Status LoadOrtModel(std::function<Status()> load_ort_format_model_bytes) ORT_MUST_USE_RESULT;
 
+  // Read or memory map the ORT format model file into ort_format_model_bytes_.
+  template <typename T>
+  common::Status LoadOrtModelBytesFromFile(const std::basic_string<T>& model_uri) ORT_MUST_USE_RESULT;
+
+  // Verify ort_format_model_bytes_ and create model_ from them. model_ is unchanged if that fails.
+  common::Status CreateModelFromOrtFormatBytes() ORT_MUST_USE_RESULT;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Return the path of the optimized model in the cache directory (kOrtSessionOptionsConfigOptimizedModelCacheDir)
+  // for the loaded model and the session configuration, or an empty path if the cache can't be used.
+  PathString GetOptimizedModelCachePath();
+
+  // Replace model_ with the optimized model in the cache if it exists and is valid.
+  bool LoadFromOptimizedModelCache(const PathString& model_cache_path);
+
+  // Save the optimized model to the cache. Failures are logged as the session can be used anyway.
+  void SaveToOptimizedModelCache(const PathString& model_cache_path);
+#endif
+
 #endif  // defined(ENABLE_ORT_FORMAT_LOAD)
 
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
@@ -543,6 +664,13 @@ class InferenceSession {
   common::Status ValidateInputs(const std::vector<std::string>& feed_names,
                                 const std::vector<OrtValue>& feeds) const ORT_MUST_USE_RESULT;
 
+  struct InputDefMetaData;
+  common::Status ValidateInput(const std::string& feed_name, const InputDefMetaData& input_def,
+                               const OrtValue& feed) const ORT_MUST_USE_RESULT;
+
+  common::Status ValidatePreparedRun(const PreparedRun& prepared_run, const std::vector<OrtValue>& feeds,
+                                     const std::vector<OrtValue>* p_fetches) const ORT_MUST_USE_RESULT;
+
   common::Status ValidateOutputs(const std::vector<std::string>& output_names,
                                  const std::vector<OrtValue>* p_fetches) const ORT_MUST_USE_RESULT;
 
@@ -570,6 +698,74 @@ class InferenceSession {
    */
   void ShrinkMemoryArenas(const std::vector<AllocatorPtr>& arenas_to_shrink);
 
+  /*
+   * Finds the execution provider, if any, that has graph capture (e.g. CUDA graph) enabled and validates that
+   * the whole main graph can be captured by it.
+   */
+  common::Status SetupGraphCaptureProvider() ORT_MUST_USE_RESULT;
+
+  /*
+   * Parses the pairs of graph inputs and outputs of kOrtSessionOptionsConfigStreamingState and validates them
+   * against the main graph.
+   */
+  common::Status SetupStreamingState() ORT_MUST_USE_RESULT;
+
+  /*
+   * Runs the model of a streaming session. The state inputs that are not fed are fed with the state outputs of the
+   * previous Run, and the state outputs of this Run are fetched and kept for the next one.
+   */
+  common::Status RunWithStreamingState(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                       const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info) ORT_MUST_USE_RESULT;
+
+  /*
+   * Runs the model on the batch of the feeds in slices of micro_batch_size rows, see kOrtRunOptionsConfigMicroBatchSize.
+   */
+  common::Status RunInMicroBatches(const RunOptions& run_options, int64_t micro_batch_size,
+                                   const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                   const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                                   const std::vector<OrtDevice>* p_fetches_device_info) ORT_MUST_USE_RESULT;
+
+  /*
+   * Creates the result cache if kOrtSessionOptionsConfigResultCacheMaxBytes is set and the outputs of the model only
+   * depend on its inputs.
+   */
+  common::Status SetupResultCache() ORT_MUST_USE_RESULT;
+
+  /*
+   * Returns the outputs of a cached Run with the same feeds, or runs the model and caches its outputs.
+   */
+  common::Status RunWithResultCache(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                    const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                                    std::vector<OrtValue>* p_fetches,
+                                    const std::vector<OrtDevice>* p_fetches_device_info) ORT_MUST_USE_RESULT;
+
+  // prepared_run is optional. The names of the feeds and fetches are validated and resolved when it is null.
+  common::Status RunImpl(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                         const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                         std::vector<OrtValue>* p_fetches,
+                         const std::vector<OrtDevice>* p_fetches_device_info,
+                         PreparedRun* prepared_run = nullptr) ORT_MUST_USE_RESULT;
+
+  /*
+   * Builds the list of buffer addresses and shapes of the feeds and fetches for a Run.
+   * A captured graph can only be replayed when this signature matches the one it was captured with.
+   * Returns an error if the feeds or fetches cannot be used with a captured graph.
+   */
+  common::Status GetGraphReplayIoSignature(const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches,
+                                           std::vector<std::pair<const void*, TensorShape>>& signature) const
+      ORT_MUST_USE_RESULT;
+
+  /*
+   * Creates the allocators that write the outputs with a buffer in run_options.output_buffers, and no pre-allocated
+   * fetch, into the caller owned buffer when the output fits.
+   */
+  common::Status CreateOutputBufferAllocators(
+      const RunOptions& run_options, const std::vector<std::string>& output_names,
+      const std::vector<OrtValue>& fetches,
+      std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) const ORT_MUST_USE_RESULT;
+
 #if !defined(ORT_MINIMAL_BUILD)
   virtual void AddPredefinedTransformers(GraphTransformerManager& transformer_manager,
                                          TransformerLevel graph_optimization_level);
@@ -609,6 +805,9 @@ class InferenceSession {
   // It has a dependency on execution_providers_.
   std::unique_ptr<SessionState> session_state_;
 
+  // Collector of the calibration mode, between StartCalibration and EndCalibration.
+  std::unique_ptr<TensorCalibrationCollector> calibration_collector_;
+
   // Threadpools per session. These are initialized and used for the entire duration of the session
   // when use_per_session_threads is true.
   std::basic_string<ORTCHAR_T> thread_pool_name_;
@@ -627,6 +826,11 @@ class InferenceSession {
   // If true, use the per session ones, or else the global threadpools.
   bool use_per_session_threads_;
 
+  // initialized from session options
+  // If true, the parallel executor runs the nodes on the intra-op thread pool, which the kernels also use for their
+  // parallel loops, instead of on a separate inter-op thread pool.
+  bool use_unified_thread_pool_{false};
+
   KernelRegistryManager kernel_registry_manager_;
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -661,6 +865,33 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
+  // Number of RunAsync calls that are scheduled but whose callback has not returned yet.
+  // The destructor waits for them since they use the thread pools and the session state.
+  int num_async_runs_ = 0;  // GUARDED_BY(async_runs_mutex_)
+  onnxruntime::OrtMutex async_runs_mutex_;
+  onnxruntime::OrtCondVar async_runs_done_;
+
+  // The execution provider that captures the main graph execution (e.g. into a CUDA graph) and replays it
+  // in later Runs. nullptr if no registered provider has graph capture enabled.
+  IExecutionProvider* graph_capture_provider_ = nullptr;
+
+  // Addresses and shapes of the feeds and fetches the currently captured graph was recorded with.
+  std::vector<std::pair<const void*, TensorShape>> graph_replay_io_signature_;
+
+  // A state carried between the Runs of a streaming session, see kOrtSessionOptionsConfigStreamingState.
+  struct StreamingState {
+    std::string input_name;
+    std::string output_name;
+    // The state output of the previous Run. Not allocated before the first Run and after a reset.
+    OrtValue value;
+  };
+
+  std::vector<StreamingState> streaming_states_;  // GUARDED_BY(streaming_state_mutex_)
+  onnxruntime::OrtMutex streaming_state_mutex_;
+
+  // The outputs of the Runs cached by their feeds, see kOrtSessionOptionsConfigResultCacheMaxBytes.
+  std::unique_ptr<InferenceResultCache> result_cache_;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -683,6 +914,21 @@ class InferenceSession {
     constexpr static long long kDurationBetweenSending = 1000 * 1000 * 60 * 10;  // duration in (us).  send a report every 10 mins
   } telemetry_;
 
+  // Always-on counters of the Run calls, reported by GetMetrics
+  struct RunMetrics {
+    // upper bounds (seconds) of the latency histogram buckets, the last bucket is unbounded
+    static constexpr double kLatencyBuckets[] = {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025,
+                                                 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+    static constexpr size_t kNumLatencyBuckets = sizeof(kLatencyBuckets) / sizeof(kLatencyBuckets[0]) + 1;
+
+    void Record(std::chrono::steady_clock::duration latency, bool succeeded);
+
+    std::atomic<uint64_t> runs{0};
+    std::atomic<uint64_t> failed_runs{0};
+    std::atomic<uint64_t> latency_ns{0};
+    std::atomic<uint64_t> latency_counts[kNumLatencyBuckets]{};
+  } run_metrics_;
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   bool session_activity_started_ = false;
   TraceLoggingActivity<telemetry_provider_handle> session_activity;
@@ -698,14 +944,32 @@ class InferenceSession {
   // Bytes from an ORT format model.
   // We store them currently to make the Load + Initialize behave the same way as for an ONNX model
   // as we need some of the bytes for the Load (create the Model) and some for the Initialize (create SessionState).
-  // Short term we free them after Initialize.
-  // Longer term we may want to directly refer to offsets in this buffer for initializers so we don't need to copy
-  // those into new OrtValue instances, at which point we won't free them until the InferenceSession goes away.
-  std::vector<uint8_t> ort_format_model_bytes_;
+  // If the bytes were read into ort_format_model_bytes_data_holder_ we free them after Initialize.
+  // If the model file was memory mapped (see kOrtSessionOptionsConfigMapOrtModelIntoMemory) the CPU initializers
+  // refer directly to the mapped bytes, so we keep the mapping until the InferenceSession goes away.
+  gsl::span<const uint8_t> ort_format_model_bytes_;
+  std::vector<uint8_t> ort_format_model_bytes_data_holder_;
+  Env::MappedMemoryPtr ort_format_model_mapped_memory_;
+
+  // The memory mapped ONNX model file if kOrtSessionOptionsConfigMapOnnxModelIntoMemory is set. The initializers refer
+  // to the raw data in the mapping, so it is kept until the InferenceSession goes away.
+  Env::MappedMemoryPtr onnx_model_mapped_memory_;
 
   std::shared_ptr<onnxruntime::AllocatorManager> allocator_manager_;
 };
 
+struct InferenceSession::PreparedRun {
+  PreparedRun(const InferenceSession& session0, std::vector<const InputDefMetaData*>&& input_defs0,
+              std::unique_ptr<FeedsFetchesManager>&& feeds_fetches_manager0)
+      : session(session0), input_defs(std::move(input_defs0)), feeds_fetches_manager(std::move(feeds_fetches_manager0)) {
+  }
+
+  const InferenceSession& session;
+  // the metadata of the model input of each feed
+  std::vector<const InputDefMetaData*> input_defs;
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager;
+};
+
 struct SessionIOBinding {
  public:
   SessionIOBinding(InferenceSession* session);
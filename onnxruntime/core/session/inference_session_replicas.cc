@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/inference_session_replicas.h"
+
+#include <limits>
+#include <thread>
+
+#include "core/graph/model.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+// gives access to loading a model from a ModelProto the replicas share
+class ReplicaSession : public InferenceSession {
+ public:
+  ReplicaSession(const SessionOptions& session_options, const Environment& session_env)
+      : InferenceSession(session_options, session_env) {}
+
+  Status LoadFromSharedProto(const ModelProto& model_proto) {
+    return Load(model_proto);
+  }
+};
+}  // namespace
+
+InferenceSessionReplicas::InferenceSessionReplicas(const Environment& session_env)
+    : environment_(session_env) {
+}
+
+InferenceSessionReplicas::~InferenceSessionReplicas() = default;
+
+Status InferenceSessionReplicas::Load(const PathString& model_uri) {
+  ORT_RETURN_IF(model_proto_ != nullptr || !replicas_.empty(), "The model has already been loaded.");
+
+  auto model_proto = std::make_unique<ModelProto>();
+  ORT_RETURN_IF_ERROR(Model::Load(model_uri, *model_proto));
+  model_proto_ = std::move(model_proto);
+  return Status::OK();
+}
+
+Status InferenceSessionReplicas::Load(const void* model_data, int model_data_len) {
+  ORT_RETURN_IF(model_proto_ != nullptr || !replicas_.empty(), "The model has already been loaded.");
+
+  auto model_proto = std::make_unique<ModelProto>();
+  if (!model_proto->ParseFromArray(model_data, model_data_len)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF,
+                  "Failed to load model because protobuf parsing failed.");
+  }
+  model_proto_ = std::move(model_proto);
+  return Status::OK();
+}
+
+Status InferenceSessionReplicas::AddReplica(const SessionOptions& session_options,
+                                            std::vector<std::unique_ptr<IExecutionProvider>> providers,
+                                            const std::vector<OrtCustomOpDomain*>& custom_op_domains) {
+  ORT_RETURN_IF(model_proto_ == nullptr, "Load must be called before AddReplica.");
+  ORT_RETURN_IF(is_initialized_, "Replicas cannot be added after Initialize.");
+
+  // share the weights prepacked by CPU kernels unless the caller explicitly decided otherwise
+  SessionOptions replica_options = session_options;
+  std::string use_env_prepacked_weights;
+  if (!replica_options.config_options.TryGetConfigEntry(kOrtSessionOptionsConfigUseEnvPrepackedWeights,
+                                                        use_env_prepacked_weights)) {
+    ORT_RETURN_IF_ERROR(replica_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseEnvPrepackedWeights,
+                                                                      "1"));
+  }
+
+  auto session = std::make_unique<ReplicaSession>(replica_options, environment_);
+  if (!custom_op_domains.empty()) {
+    ORT_RETURN_IF_ERROR(session->AddCustomOpDomains(custom_op_domains));
+  }
+
+  for (auto& provider : providers) {
+    if (provider) {
+      ORT_RETURN_IF_ERROR(session->RegisterExecutionProvider(std::move(provider)));
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(session->LoadFromSharedProto(*model_proto_));
+
+  replicas_.push_back(Replica{std::move(session), std::make_unique<std::atomic<int>>(0)});
+  return Status::OK();
+}
+
+Status InferenceSessionReplicas::Initialize() {
+  ORT_RETURN_IF(is_initialized_, "The replicas have already been initialized.");
+  ORT_RETURN_IF(replicas_.empty(), "AddReplica must be called before Initialize.");
+
+  // initializing a replica copies its weights to its device, so the replicas are initialized concurrently
+  std::vector<Status> statuses(replicas_.size());
+  std::vector<std::thread> threads;
+  threads.reserve(replicas_.size() - 1);
+  auto initialize_replica = [this, &statuses](size_t i) {
+    ORT_TRY {
+      statuses[i] = replicas_[i].session->Initialize();
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to initialize replica ", i, ": ", ex.what());
+      });
+    }
+  };
+
+  for (size_t i = 1; i < replicas_.size(); ++i) {
+    threads.emplace_back(initialize_replica, i);
+  }
+  initialize_replica(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  model_proto_.reset();
+  is_initialized_ = true;
+  return Status::OK();
+}
+
+size_t InferenceSessionReplicas::AcquireReplica() {
+  const size_t num_replicas = replicas_.size();
+  const size_t start = next_replica_.fetch_add(1, std::memory_order_relaxed);
+
+  size_t best = start % num_replicas;
+  int best_runs = std::numeric_limits<int>::max();
+  for (size_t i = 0; i < num_replicas; ++i) {
+    const size_t candidate = (start + i) % num_replicas;
+    const int runs = replicas_[candidate].runs_in_flight->load(std::memory_order_relaxed);
+    if (runs < best_runs) {
+      best = candidate;
+      best_runs = runs;
+      if (runs == 0) {
+        break;
+      }
+    }
+  }
+
+  replicas_[best].runs_in_flight->fetch_add(1, std::memory_order_relaxed);
+  return best;
+}
+
+Status InferenceSessionReplicas::Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                     const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                                     std::vector<OrtValue>* p_fetches,
+                                     const std::vector<OrtDevice>* p_fetches_device_info) {
+  ORT_RETURN_IF_NOT(is_initialized_, "Initialize must be called before Run.");
+
+  const size_t index = AcquireReplica();
+  auto& replica = replicas_[index];
+  Status status;
+  ORT_TRY {
+    status = replica.session->Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+  replica.runs_in_flight->fetch_sub(1, std::memory_order_relaxed);
+  return status;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
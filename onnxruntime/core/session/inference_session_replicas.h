@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/session/inference_session.h"
+
+namespace ONNX_NAMESPACE {
+class ModelProto;
+}  // namespace ONNX_NAMESPACE
+
+namespace onnxruntime {
+
+/**
+  A set of replicas of one model, each an InferenceSession with its own execution providers (typically the same
+  execution provider on a different device), that serves each Run on the replica with the fewest runs in flight.
+
+  The model is parsed once for all the replicas, and the replicas are initialized in parallel so that the weights
+  are copied to the devices concurrently. The weights prepacked by the CPU kernels are shared between the replicas
+  through the prepacked weights container of the environment.
+
+  Usage:
+    InferenceSessionReplicas replicas(env);
+    ORT_RETURN_IF_ERROR(replicas.Load(model_uri));
+    for (int device_id = 0; device_id < num_devices; ++device_id)
+      ORT_RETURN_IF_ERROR(replicas.AddReplica(session_options, providers_for(device_id)));
+    ORT_RETURN_IF_ERROR(replicas.Initialize());
+    ORT_RETURN_IF_ERROR(replicas.Run(run_options, feed_names, feeds, output_names, &fetches));
+*/
+class InferenceSessionReplicas {
+ public:
+  explicit InferenceSessionReplicas(const Environment& session_env);
+  ~InferenceSessionReplicas();
+
+  /**
+    Parse the ONNX model the replicas are created from. ORT format models are not supported.
+    */
+  common::Status Load(const PathString& model_uri) ORT_MUST_USE_RESULT;
+  common::Status Load(const void* model_data, int model_data_len) ORT_MUST_USE_RESULT;
+
+  /**
+    Create a replica of the loaded model with the given execution providers, in preference order.
+    The replica uses the CPU execution provider only if providers is empty.
+    Must be called after Load() and before Initialize().
+    */
+  common::Status AddReplica(const SessionOptions& session_options,
+                            std::vector<std::unique_ptr<IExecutionProvider>> providers,
+                            const std::vector<OrtCustomOpDomain*>& custom_op_domains = {}) ORT_MUST_USE_RESULT;
+
+  /**
+    Initialize all the replicas in parallel. The parsed model is released afterwards.
+    */
+  common::Status Initialize() ORT_MUST_USE_RESULT;
+
+  /**
+    Run the model on the replica with the fewest runs in flight. Thread safe.
+    See InferenceSession::Run for the arguments.
+    */
+  common::Status Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                     const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                     std::vector<OrtValue>* p_fetches,
+                     const std::vector<OrtDevice>* p_fetches_device_info = nullptr) ORT_MUST_USE_RESULT;
+
+  size_t NumReplicas() const { return replicas_.size(); }
+
+  InferenceSession& GetReplica(size_t index) const { return *replicas_.at(index).session; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InferenceSessionReplicas);
+
+  struct Replica {
+    std::unique_ptr<InferenceSession> session;
+    std::unique_ptr<std::atomic<int>> runs_in_flight;
+  };
+
+  // pick the replica with the fewest runs in flight, starting the search after the last pick to spread ties
+  size_t AcquireReplica();
+
+  const Environment& environment_;
+  std::unique_ptr<ONNX_NAMESPACE::ModelProto> model_proto_;
+  std::vector<Replica> replicas_;
+  std::atomic<size_t> next_replica_{0};
+  bool is_initialized_{false};
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
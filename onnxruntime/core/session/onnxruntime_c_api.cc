@@ -26,9 +26,11 @@
 #include "core/providers/get_execution_providers.h"
 #include "core/session/environment.h"
 #include "core/framework/callback.h"
+#include "core/framework/dlpack_converter.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/onnxruntime_typeinfo.h"
 #include "core/session/inference_session.h"
+#include "core/session/inference_session_replicas.h"
 #include "core/session/ort_apis.h"
 #include "core/session/ort_env.h"
 #include "core/framework/data_types.h"
@@ -129,6 +131,18 @@ ORT_API_STATUS_IMPL(OrtApis::CreateEnvWithCustomLoggerAndGlobalThreadPools, OrtL
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateEnvWithAsyncLogging, _In_opt_ OrtLoggingFunction logging_function,
+                    _In_opt_ void* logger_param, OrtLoggingLevel logging_level, _In_ const char* logid,
+                    _In_opt_ const struct OrtThreadingOptions* tp_options, _Outptr_ OrtEnv** out) {
+  API_IMPL_BEGIN
+  OrtEnv::LoggingManagerConstructionInfo lm_info{logging_function, logger_param, logging_level, logid};
+  lm_info.async_logging = true;
+  Status status;
+  *out = OrtEnv::GetInstance(lm_info, status, tp_options);
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
 // enable platform telemetry
 ORT_API_STATUS_IMPL(OrtApis::EnableTelemetryEvents, _In_ const OrtEnv* ort_env) {
   API_IMPL_BEGIN
@@ -534,13 +548,14 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In
   API_IMPL_END
 }
 
-ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
-                    _In_reads_(input_len) const char* const* input_names,
-                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
-                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
-                    _Inout_updates_all_(output_names_len) OrtValue** output) {
-  API_IMPL_BEGIN
-  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+namespace {
+// run an InferenceSession or InferenceSessionReplicas with the arguments of OrtApis::Run
+template <typename TSession>
+ORT_STATUS_PTR RunSession(TSession& session, _In_opt_ const OrtRunOptions* run_options,
+                          _In_reads_(input_len) const char* const* input_names,
+                          _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                          _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                          _Inout_updates_all_(output_names_len) OrtValue** output) {
   const int queue_id = 0;
 
   std::vector<std::string> feed_names(input_len);
@@ -578,9 +593,9 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   Status status;
   if (run_options == nullptr) {
     OrtRunOptions op;
-    status = session->Run(op, feed_names, feeds, output_names, &fetches, nullptr);
+    status = session.Run(op, feed_names, feeds, output_names, &fetches, nullptr);
   } else {
-    status = session->Run(*run_options, feed_names, feeds, output_names, &fetches, nullptr);
+    status = session.Run(*run_options, feed_names, feeds, output_names, &fetches, nullptr);
   }
 
   if (!status.IsOK())
@@ -594,6 +609,312 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
     }
   }
   return nullptr;
+}
+}  // namespace
+
+ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  return RunSession(*session, run_options, input_names, input, input_len, output_names1, output_names_len, output);
+  API_IMPL_END
+}
+
+namespace {
+// provide either model_path, or model_data + model_data_length.
+ORT_STATUS_PTR CreateSessionReplicasImpl(_In_ const OrtEnv* env,
+                                         _In_opt_z_ const ORTCHAR_T* model_path,
+                                         _In_opt_ const void* model_data,
+                                         size_t model_data_length,
+                                         _In_reads_(num_replicas) const OrtSessionOptions* const* options,
+                                         size_t num_replicas,
+                                         _Outptr_ OrtSessionReplicas** out) {
+  *out = nullptr;
+#if !defined(ORT_MINIMAL_BUILD)
+  if (options == nullptr || num_replicas == 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "At least one replica must be specified.");
+  }
+
+  auto replicas = std::make_unique<onnxruntime::InferenceSessionReplicas>(env->GetEnvironment());
+  if (model_path != nullptr) {
+    ORT_API_RETURN_IF_STATUS_NOT_OK(replicas->Load(model_path));
+  } else {
+    ORT_API_RETURN_IF_STATUS_NOT_OK(replicas->Load(model_data, static_cast<int>(model_data_length)));
+  }
+
+  for (size_t i = 0; i < num_replicas; ++i) {
+    const OrtSessionOptions* replica_options = options[i];
+    std::vector<std::unique_ptr<IExecutionProvider>> provider_list;
+    if (replica_options) {
+      for (auto& factory : replica_options->provider_factories) {
+        provider_list.push_back(factory->CreateProvider());
+      }
+    }
+
+    ORT_API_RETURN_IF_STATUS_NOT_OK(replicas->AddReplica(
+        replica_options == nullptr ? onnxruntime::SessionOptions() : replica_options->value,
+        std::move(provider_list),
+        replica_options == nullptr ? std::vector<OrtCustomOpDomain*>() : replica_options->custom_op_domains_));
+  }
+
+  ORT_API_RETURN_IF_STATUS_NOT_OK(replicas->Initialize());
+
+  *out = reinterpret_cast<OrtSessionReplicas*>(replicas.release());
+  return nullptr;
+#else
+  ORT_UNUSED_PARAMETER(env);
+  ORT_UNUSED_PARAMETER(model_path);
+  ORT_UNUSED_PARAMETER(model_data);
+  ORT_UNUSED_PARAMETER(model_data_length);
+  ORT_UNUSED_PARAMETER(options);
+  ORT_UNUSED_PARAMETER(num_replicas);
+  return OrtApis::CreateStatus(ORT_NOT_IMPLEMENTED, "Session replicas are not supported in a minimal build.");
+#endif
+}
+}  // namespace
+
+ORT_API_STATUS_IMPL(OrtApis::CreateSessionReplicas, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                    _In_reads_(num_replicas) const OrtSessionOptions* const* options, size_t num_replicas,
+                    _Outptr_ OrtSessionReplicas** out) {
+  API_IMPL_BEGIN
+  return CreateSessionReplicasImpl(env, model_path, nullptr, 0, options, num_replicas, out);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateSessionReplicasFromArray, _In_ const OrtEnv* env, _In_ const void* model_data,
+                    size_t model_data_length, _In_reads_(num_replicas) const OrtSessionOptions* const* options,
+                    size_t num_replicas, _Outptr_ OrtSessionReplicas** out) {
+  API_IMPL_BEGIN
+  return CreateSessionReplicasImpl(env, nullptr, model_data, model_data_length, options, num_replicas, out);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunSessionReplicas, _Inout_ OrtSessionReplicas* replicas,
+                    _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output) {
+  API_IMPL_BEGIN
+#if !defined(ORT_MINIMAL_BUILD)
+  auto session_replicas = reinterpret_cast<::onnxruntime::InferenceSessionReplicas*>(replicas);
+  return RunSession(*session_replicas, run_options, input_names, input, input_len, output_names, output_names_len,
+                    output);
+#else
+  ORT_UNUSED_PARAMETER(replicas);
+  ORT_UNUSED_PARAMETER(run_options);
+  ORT_UNUSED_PARAMETER(input_names);
+  ORT_UNUSED_PARAMETER(input);
+  ORT_UNUSED_PARAMETER(input_len);
+  ORT_UNUSED_PARAMETER(output_names);
+  ORT_UNUSED_PARAMETER(output_names_len);
+  ORT_UNUSED_PARAMETER(output);
+  return OrtApis::CreateStatus(ORT_NOT_IMPLEMENTED, "Session replicas are not supported in a minimal build.");
+#endif
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionPrepareRun, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    feed_names[i] = input_names[i];
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::unique_ptr<::onnxruntime::InferenceSession::PreparedRun> prepared_run;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->PrepareRun(feed_names, output_names, prepared_run));
+  *out = reinterpret_cast<OrtPreparedRun*>(prepared_run.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtPreparedRun* prepared_run,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _Inout_updates_all_(output_len) OrtValue** output, size_t output_len) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto& prepared = *reinterpret_cast<::onnxruntime::InferenceSession::PreparedRun*>(prepared_run);
+  const int queue_id = 0;
+
+  std::vector<OrtValue> feeds(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    auto& ort_value = feeds[i] = *reinterpret_cast<const ::OrtValue*>(input[i]);
+    if (ort_value.Fence()) ort_value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+  }
+
+  std::vector<OrtValue> fetches(output_len);
+  for (size_t i = 0; i != output_len; ++i) {
+    if (output[i] != nullptr) {
+      ::OrtValue& value = *(output[i]);
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsOutput(onnxruntime::kCpuExecutionProvider, queue_id);
+      fetches[i] = value;
+    }
+  }
+
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Run(op, prepared, feeds, &fetches);
+  } else {
+    status = session->Run(*run_options, prepared, feeds, &fetches);
+  }
+
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  for (size_t i = 0; i != output_len; ++i) {
+    ::OrtValue& value = fetches[i];
+    if (value.Fence())
+      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+    if (output[i] == nullptr) {
+      output[i] = new OrtValue(value);
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetMetrics, _In_ const OrtSession* sess,
+                    _In_ OrtSessionMetricCallback callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "callback cannot be null");
+  }
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  session->GetMetrics([callback, user_data](const std::string& name, double value) {
+    callback(user_data, name.c_str(), value);
+  });
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  const int queue_id = 0;
+
+  if (run_async_callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "run_async_callback cannot be null");
+  }
+
+  std::vector<std::string> feed_names(input_len);
+  std::vector<OrtValue> feeds(input_len);
+
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+
+    feed_names[i] = input_names[i];
+    auto& ort_value = feeds[i] = *reinterpret_cast<const ::OrtValue*>(input[i]);
+
+    if (ort_value.Fence()) ort_value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::vector<OrtValue> fetches(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output[i] != nullptr) {
+      ::OrtValue& value = *(output[i]);
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsOutput(onnxruntime::kCpuExecutionProvider, queue_id);
+      fetches[i] = value;
+    }
+  }
+
+  auto callback = [output, output_names_len, run_async_callback, user_data](std::vector<OrtValue>& results,
+                                                                            const Status& status) {
+    OrtStatus* ort_status = nullptr;
+    if (status.IsOK()) {
+      for (size_t i = 0; i != output_names_len; ++i) {
+        ::OrtValue& value = results[i];
+        if (value.Fence())
+          value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+        if (output[i] == nullptr) {
+          output[i] = new OrtValue(value);
+        }
+      }
+    } else {
+      ort_status = ToOrtStatus(status);
+    }
+    run_async_callback(user_data, output, output_names_len, ort_status);
+    OrtApis::ReleaseStatus(ort_status);
+  };
+
+  return ToOrtStatus(session->RunAsync(run_options, feed_names, feeds, output_names, std::move(fetches),
+                                       std::move(callback)));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateTensorFromDLPack, _In_ void* dl_managed_tensor, int is_bool_tensor,
+                    _Outptr_ OrtValue** out) {
+  API_IMPL_BEGIN
+  if (dl_managed_tensor == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "dl_managed_tensor is null");
+  }
+  // DlpackToOrtValue throws (and leaves the DLPack tensor to the caller) if it cannot be shared
+  *out = new OrtValue(dlpack::DlpackToOrtValue(static_cast<DLManagedTensor*>(dl_managed_tensor),
+                                               is_bool_tensor != 0));
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::GetTensorDLPack, _Inout_ OrtValue* value, _Outptr_ void** dl_managed_tensor) {
+  API_IMPL_BEGIN
+  if (!value->IsTensor()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "the ort_value must contain a constructed tensor");
+  }
+  *dl_managed_tensor = dlpack::OrtValueToDlpack(*value);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionInitializeSubgraphs, _Inout_ OrtSession* sess,
+                    _In_reads_(node_names_len) const char* const* node_names, size_t node_names_len) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::vector<std::string> node_name_strings;
+  node_name_strings.reserve(node_names_len);
+  for (size_t i = 0; i != node_names_len; ++i) {
+    if (node_names[i] == nullptr || node_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "node name cannot be empty");
+    }
+    node_name_strings.emplace_back(node_names[i]);
+  }
+
+  return ToOrtStatus(session->InitializeSubgraphs(node_name_strings));
   API_IMPL_END
 }
 
@@ -1884,6 +2205,16 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->max_dead_bytes_per_chunk = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "initial_regrowth_chunk_size_bytes") == 0) {
       cfg->initial_regrowth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "idle_release_ms") == 0) {
+      cfg->idle_release_ms = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "idle_release_watermark_bytes") == 0) {
+      cfg->idle_release_watermark_bytes = arena_config_values[i];
+    } else if (strcmp(arena_config_keys[i], "decommit_chunk_bytes") == 0) {
+      cfg->decommit_chunk_bytes = arena_config_values[i];
+    } else if (strcmp(arena_config_keys[i], "thread_cache_max_bytes") == 0) {
+      cfg->thread_cache_max_bytes = arena_config_values[i];
+    } else if (strcmp(arena_config_keys[i], "huge_pages") == 0) {
+      cfg->huge_pages = static_cast<int>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2154,6 +2485,25 @@ static constexpr OrtApi ort_api_1_to_8 = {
     &OrtApis::KernelInfoGetAttributeArray_int64,
     &OrtApis::CreateArenaCfgV2,
     &OrtApis::AddRunConfigEntry,
+    &OrtApis::RunAsync,
+    &OrtApis::CreateTensorFromDLPack,
+    &OrtApis::GetTensorDLPack,
+    &OrtApis::SessionInitializeSubgraphs,
+    &OrtApis::RunOptionsSetOutputBuffer,
+    &OrtApis::RunOptionsClearOutputBuffers,
+    &OrtApis::CreateSessionReplicas,
+    &OrtApis::CreateSessionReplicasFromArray,
+    &OrtApis::RunSessionReplicas,
+    &OrtApis::ReleaseSessionReplicas,
+    &OrtApis::SessionPrepareRun,
+    &OrtApis::RunPrepared,
+    &OrtApis::ReleasePreparedRun,
+    &OrtApis::SessionGetMetrics,
+    &OrtApis::SetGlobalExternalExecutor,
+    &OrtApis::SessionOptionsSetExternalExecutor,
+    &OrtApis::CreateEnvWithAsyncLogging,
+    &OrtApis::KernelContext_ParallelFor,
+    &OrtApis::KernelContext_GetDegreeOfParallelism,
 };
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
@@ -2186,3 +2536,11 @@ DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Value, OrtValue)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(RunOptions, OrtRunOptions)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Session, ::onnxruntime::InferenceSession)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(ModelMetadata, ::onnxruntime::ModelMetadata)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(PreparedRun, ::onnxruntime::InferenceSession::PreparedRun)
+#if !defined(ORT_MINIMAL_BUILD)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(SessionReplicas, ::onnxruntime::InferenceSessionReplicas)
+#else
+ORT_API(void, OrtApis::ReleaseSessionReplicas, _Frees_ptr_opt_ OrtSessionReplicas* value) {
+  ORT_UNUSED_PARAMETER(value);
+}
+#endif
@@ -267,4 +267,50 @@ ORT_API_STATUS_IMPL(CreateArenaCfgV2, _In_reads_(num_keys) const char* const* ar
                     _In_ size_t num_keys, _Outptr_ OrtArenaCfg** out);
 ORT_API_STATUS_IMPL(AddRunConfigEntry, _Inout_ OrtRunOptions* options,
                     _In_z_ const char* config_key, _In_z_ const char* config_value);
+ORT_API_STATUS_IMPL(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(CreateTensorFromDLPack, _In_ void* dl_managed_tensor, int is_bool_tensor, _Outptr_ OrtValue** out);
+ORT_API_STATUS_IMPL(GetTensorDLPack, _Inout_ OrtValue* value, _Outptr_ void** dl_managed_tensor);
+ORT_API_STATUS_IMPL(SessionInitializeSubgraphs, _Inout_ OrtSession* sess,
+                    _In_reads_(node_names_len) const char* const* node_names, size_t node_names_len);
+ORT_API_STATUS_IMPL(RunOptionsSetOutputBuffer, _Inout_ OrtRunOptions* options, _In_z_ const char* output_name,
+                    _In_opt_ void* buffer, size_t buffer_size, _In_opt_ const OrtMemoryInfo* memory_info);
+ORT_API_STATUS_IMPL(RunOptionsClearOutputBuffers, _Inout_ OrtRunOptions* options);
+ORT_API_STATUS_IMPL(CreateSessionReplicas, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                    _In_reads_(num_replicas) const OrtSessionOptions* const* options, size_t num_replicas,
+                    _Outptr_ OrtSessionReplicas** out);
+ORT_API_STATUS_IMPL(CreateSessionReplicasFromArray, _In_ const OrtEnv* env, _In_ const void* model_data,
+                    size_t model_data_length, _In_reads_(num_replicas) const OrtSessionOptions* const* options,
+                    size_t num_replicas, _Outptr_ OrtSessionReplicas** out);
+ORT_API_STATUS_IMPL(RunSessionReplicas, _Inout_ OrtSessionReplicas* replicas, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output);
+ORT_API(void, ReleaseSessionReplicas, _Frees_ptr_opt_ OrtSessionReplicas*);
+ORT_API_STATUS_IMPL(SessionPrepareRun, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out);
+ORT_API_STATUS_IMPL(RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtPreparedRun* prepared_run,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _Inout_updates_all_(output_len) OrtValue** output, size_t output_len);
+ORT_API(void, ReleasePreparedRun, _Frees_ptr_opt_ OrtPreparedRun*);
+ORT_API_STATUS_IMPL(SessionGetMetrics, _In_ const OrtSession* sess, _In_ OrtSessionMetricCallback callback,
+                    _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(SetGlobalExternalExecutor, _Inout_ OrtThreadingOptions* tp_options,
+                    _In_ const OrtExternalExecutor* executor);
+ORT_API_STATUS_IMPL(SessionOptionsSetExternalExecutor, _Inout_ OrtSessionOptions* options,
+                    _In_ const OrtExternalExecutor* executor);
+ORT_API_STATUS_IMPL(CreateEnvWithAsyncLogging, _In_opt_ OrtLoggingFunction logging_function,
+                    _In_opt_ void* logger_param, OrtLoggingLevel logging_level, _In_ const char* logid,
+                    _In_opt_ const struct OrtThreadingOptions* tp_options, _Outptr_ OrtEnv** out);
+ORT_API_STATUS_IMPL(KernelContext_ParallelFor, _In_ const OrtKernelContext* context,
+                    _In_ void(ORT_API_CALL* fn)(void* fn_param, size_t i), _In_opt_ void* fn_param, size_t n);
+ORT_API_STATUS_IMPL(KernelContext_GetDegreeOfParallelism, _In_ const OrtKernelContext* context, _Out_ int* out);
 }  // namespace OrtApis
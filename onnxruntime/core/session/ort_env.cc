@@ -10,6 +10,7 @@
 #include "core/session/environment.h"
 #include "core/session/allocator_impl.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/ring_buffer_sink.h"
 #include "core/framework/provider_shutdown.h"
 #ifdef __ANDROID__
 #include "core/platform/android/logging/android_log_sink.h"
@@ -53,27 +54,24 @@ OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_inf
   if (!p_instance_) {
     std::unique_ptr<LoggingManager> lmgr;
     std::string name = lm_info.logid;
+    std::unique_ptr<ISink> sink;
     if (lm_info.logging_function) {
-      std::unique_ptr<ISink> logger = std::make_unique<LoggingWrapper>(lm_info.logging_function,
-                                                                               lm_info.logger_param);
-      lmgr.reset(new LoggingManager(std::move(logger),
-                                    static_cast<Severity>(lm_info.default_warning_level),
-                                    false,
-                                    LoggingManager::InstanceType::Default,
-                                    &name));
+      sink = std::make_unique<LoggingWrapper>(lm_info.logging_function, lm_info.logger_param);
     } else {
 #ifdef __ANDROID__
-      ISink* sink = new AndroidLogSink();
+      sink = std::make_unique<AndroidLogSink>();
 #else
-      ISink* sink = new CLogSink();
+      sink = std::make_unique<CLogSink>();
 #endif
-
-      lmgr.reset(new LoggingManager(std::unique_ptr<ISink>{sink},
-                                    static_cast<Severity>(lm_info.default_warning_level),
-                                    false,
-                                    LoggingManager::InstanceType::Default,
-                                    &name));
     }
+    if (lm_info.async_logging) {
+      sink = std::make_unique<RingBufferSink>(std::move(sink));
+    }
+    lmgr.reset(new LoggingManager(std::move(sink),
+                                  static_cast<Severity>(lm_info.default_warning_level),
+                                  false,
+                                  LoggingManager::InstanceType::Default,
+                                  &name));
     std::unique_ptr<onnxruntime::Environment> env;
     if (!tp_options) {
       status = onnxruntime::Environment::Create(std::move(lmgr), env);
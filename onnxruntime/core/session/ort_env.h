@@ -41,6 +41,8 @@ struct OrtEnv {
     void* logger_param{};
     OrtLoggingLevel default_warning_level;
     const char* logid{};
+    // If true, the messages are passed to the sink from a background thread, see RingBufferSink.
+    bool async_logging{false};
   };
 
   static OrtEnv* GetInstance(const LoggingManagerConstructionInfo& lm_info,
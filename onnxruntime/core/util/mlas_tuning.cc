@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/util/mlas_tuning.h"
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+static bool FindMlasSgemmTuning(const std::string& tuning_file, const std::string& signature,
+                                MLAS_SGEMM_TUNING_PARAMETERS& parameters) {
+  std::ifstream infile(tuning_file);
+  std::string line;
+  while (std::getline(infile, line)) {
+    auto tab = line.find('\t');
+    if (tab == std::string::npos || line.compare(0, tab, signature) != 0 || tab != signature.size()) {
+      continue;
+    }
+    std::istringstream fields(line.substr(tab + 1));
+    if (fields >> parameters.StrideN >> parameters.StrideK >> parameters.ThreadComplexity) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ApplyMlasSgemmTuning(const std::string& tuning_file, concurrency::ThreadPool* thread_pool,
+                          const logging::Logger& logger) {
+  static std::once_flag once;
+  std::call_once(once, [&] {
+    std::ostringstream signature;
+    signature << CPUIDInfo::GetCPUIDInfo().GetSignature()
+              << " threads=" << concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+
+    MLAS_SGEMM_TUNING_PARAMETERS parameters;
+    if (FindMlasSgemmTuning(tuning_file, signature.str(), parameters)) {
+      if (MlasSgemmSetTuningParameters(&parameters)) {
+        LOGS(logger, INFO) << "Applied MLAS SGEMM tuning for '" << signature.str() << "' from " << tuning_file;
+        return;
+      }
+      LOGS(logger, WARNING) << "Ignoring invalid MLAS SGEMM tuning for '" << signature.str() << "' in " << tuning_file;
+    }
+
+    LOGS(logger, INFO) << "Tuning MLAS SGEMM for '" << signature.str() << "'";
+    MlasSgemmAutoTune(thread_pool, &parameters);
+
+    std::ofstream outfile(tuning_file, std::ofstream::out | std::ofstream::app);
+    outfile << signature.str() << "\t" << parameters.StrideN << " " << parameters.StrideK << " "
+            << parameters.ThreadComplexity << "\n";
+    if (!outfile.good()) {
+      LOGS(logger, WARNING) << "Failed to save the MLAS SGEMM tuning to " << tuning_file;
+    }
+  });
+}
+
+}  // namespace onnxruntime
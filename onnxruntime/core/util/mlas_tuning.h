@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/logging/logging.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Applies the MLAS SGEMM blocking and threading parameters tuned for this CPU.
+//
+// tuning_file holds one line per tuned configuration, '<signature>\t<stride N> <stride K> <thread complexity>',
+// where the signature is the CPU signature from CPUIDInfo and the degree of parallelism of thread_pool. If the file
+// has no entry for this configuration, the parameters are tuned with MlasSgemmAutoTune on thread_pool and the result
+// is appended to the file. The parameters are global to the process, so only the first call has any effect.
+void ApplyMlasSgemmTuning(const std::string& tuning_file, concurrency::ThreadPool* thread_pool,
+                          const logging::Logger& logger);
+
+}  // namespace onnxruntime
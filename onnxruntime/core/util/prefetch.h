@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+
+// Number of rows ahead of the current one that the gather loops request from memory. Lookups into large
+// tables are random accesses the hardware prefetcher can't predict, so the loads are issued explicitly.
+constexpr ptrdiff_t kGatherPrefetchDistance = 8;
+
+// Hints the processor to start loading the cache line holding `p` for reading.
+inline void PrefetchRead(const void* p) {
+#if defined(__GNUC__)
+  __builtin_prefetch(p, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+  (void)p;
+#endif
+}
+
+// Hints the processor to start loading the row [p, p + bytes) for reading. Only the first few cache lines
+// are requested, the hardware prefetcher follows the rest of longer rows once they are read sequentially.
+inline void PrefetchRead(const void* p, size_t bytes) {
+  constexpr size_t kCacheLineSize = 64;
+  constexpr size_t kMaxPrefetchBytes = 4 * kCacheLineSize;
+  const auto* row = static_cast<const uint8_t*>(p);
+  const size_t limit = bytes < kMaxPrefetchBytes ? bytes : kMaxPrefetchBytes;
+  for (size_t offset = 0; offset < limit; offset += kCacheLineSize) {
+    PrefetchRead(row + offset);
+  }
+}
+
+}  // namespace onnxruntime
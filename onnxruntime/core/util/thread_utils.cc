@@ -9,8 +9,90 @@
 
 namespace onnxruntime {
 namespace concurrency {
+// Fills in the affinity and NUMA node of each thread. Returns false if the machine has a single NUMA node.
+static bool SetNumaThreadOptions(OrtThreadPoolParams& options, ThreadOptions& to) {
+  const auto nodes = Env::Default().GetNumaNodeThreadAffinityMasks();
+  if (nodes.size() < 2)
+    return false;
+
+  if (!to.affinity.empty()) {
+    // Keep the given binding and look up the node of each processor.
+    for (size_t cpu : to.affinity) {
+      int node = 0;
+      while (node < static_cast<int>(nodes.size()) &&
+             std::find(nodes[node].begin(), nodes[node].end(), cpu) == nodes[node].end())
+        ++node;
+      if (node == static_cast<int>(nodes.size())) {
+        to.numa_node.clear();
+        return false;
+      }
+      to.numa_node.push_back(node);
+    }
+    return true;
+  }
+
+  size_t total_cores = 0;
+  for (const auto& node : nodes)
+    total_cores += node.size();
+  if (options.thread_pool_size <= 0)
+    options.thread_pool_size = static_cast<int>(total_cores);
+
+  // Give each node a share of the threads proportional to its number of cores, assigning consecutive threads to
+  // the same node.
+  const size_t num_threads = static_cast<size_t>(options.thread_pool_size);
+  size_t cores_before = 0;
+  for (size_t node = 0; node < nodes.size(); ++node) {
+    const size_t first = num_threads * cores_before / total_cores;
+    cores_before += nodes[node].size();
+    const size_t last = num_threads * cores_before / total_cores;
+    for (size_t i = first; i < last; ++i) {
+      to.affinity.push_back(nodes[node][(i - first) % nodes[node].size()]);
+      to.numa_node.push_back(static_cast<int>(node));
+    }
+  }
+  return true;
+}
+
+// Binds the threads to the performance cores of a hybrid CPU. Leaves the options unchanged if the CPU is not hybrid.
+static void SetPerformanceCoreThreadOptions(OrtThreadPoolParams& options, ThreadOptions& to) {
+  const auto cores = Env::Default().GetPerformanceCoreThreadAffinityMasks();
+  if (cores.empty())
+    return;
+
+  if (options.thread_pool_size <= 0)
+    options.thread_pool_size = static_cast<int>(cores.size());
+  for (int i = 0; i < options.thread_pool_size; ++i) {
+    to.affinity.push_back(cores[i % cores.size()]);
+  }
+}
+
+static void ORT_API_CALL RunExternalTask(void* fn_param) {
+  std::unique_ptr<std::function<void()>> fn(static_cast<std::function<void()>*>(fn_param));
+  (*fn)();
+}
+
+static void ORT_API_CALL RunExternalLoopIteration(void* fn_param, size_t i) {
+  (*static_cast<const std::function<void(unsigned)>*>(fn_param))(static_cast<unsigned>(i));
+}
+
+// Wraps the executor of the application in the ExternalExecutor that the ThreadPool forwards its work to.
+static std::unique_ptr<ThreadPool> CreateExternalThreadPool(const OrtExternalExecutor& ort_executor) {
+  ExternalExecutor executor;
+  executor.schedule = [ort_executor](std::function<void()> fn) {
+    ort_executor.Schedule(ort_executor.executor_param, RunExternalTask, new std::function<void()>(std::move(fn)));
+  };
+  executor.parallel_for = [ort_executor](const std::function<void(unsigned)>& fn, unsigned n) {
+    ort_executor.ParallelFor(ort_executor.executor_param, RunExternalLoopIteration,
+                             const_cast<void*>(static_cast<const void*>(&fn)), n);
+  };
+  executor.degree_of_parallelism = std::max(ort_executor.DegreeOfParallelism(ort_executor.executor_param), 1);
+  return std::make_unique<ThreadPool>(executor);
+}
+
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
+  if (options.external_executor.Schedule != nullptr)
+    return CreateExternalThreadPool(options.external_executor);
   if (options.thread_pool_size == 1)
     return nullptr;
   std::vector<size_t> cpu_list;
@@ -18,6 +100,16 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   if (options.affinity_vec_len != 0) {
     to.affinity.assign(options.affinity_vec, options.affinity_vec + options.affinity_vec_len);
   }
+  if (options.performance_cores_only && to.affinity.empty()) {
+    SetPerformanceCoreThreadOptions(options, to);
+    if (options.thread_pool_size == 1)
+      return nullptr;
+  }
+  if (options.numa_aware && SetNumaThreadOptions(options, to)) {
+    to.set_denormal_as_zero = options.set_denormal_as_zero;
+    return std::make_unique<ThreadPool>(env, to, options.name, options.thread_pool_size,
+                                        options.allow_spinning);
+  }
   if (options.thread_pool_size <= 0) {  // default
     cpu_list = Env::Default().GetThreadAffinityMasks();
     if (cpu_list.empty() || cpu_list.size() == 1)
@@ -90,6 +182,20 @@ ORT_API_STATUS_IMPL(SetGlobalSpinControl, _Inout_ OrtThreadingOptions* tp_option
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(SetGlobalExternalExecutor, _Inout_ OrtThreadingOptions* tp_options,
+                    _In_ const OrtExternalExecutor* executor) {
+  if (!tp_options) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
+  }
+  if (!executor || !executor->Schedule || !executor->ParallelFor || !executor->DegreeOfParallelism) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "OrtExternalExecutor must set Schedule, ParallelFor and DegreeOfParallelism");
+  }
+  tp_options->intra_op_thread_pool_params.external_executor = *executor;
+  tp_options->inter_op_thread_pool_params.external_executor = *executor;
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(SetGlobalDenormalAsZero, _Inout_ OrtThreadingOptions* tp_options) {
   if (!tp_options) {
     return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
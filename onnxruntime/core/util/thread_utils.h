@@ -28,6 +28,20 @@ struct OrtThreadPoolParams {
 
   // Set or unset denormal as zero
   bool set_denormal_as_zero = false;
+
+  //If it is true and the machine has more than one NUMA node, the threads are spread across the nodes, each thread
+  //is bound to a core of its node, and the thread pool keeps the work of a parallel loop on as few nodes as possible.
+  //If thread_pool_size = 0, one thread is created per physical core of all nodes.
+  bool numa_aware = false;
+
+  //If it is true and the CPU is hybrid (e.g. P-cores and E-cores, or big.LITTLE), each thread is bound to a
+  //performance core, so that the slower cores do not hold up the parallel loops of latency-critical sessions.
+  //If thread_pool_size = 0, one thread is created per physical performance core. Ignored if affinity_vec is set.
+  bool performance_cores_only = false;
+
+  //If its Schedule function is set, the thread pool creates no threads and forwards its work to this executor of the
+  //application. All the other params are then ignored.
+  OrtExternalExecutor external_executor{};
 };
 
 struct OrtThreadingOptions {
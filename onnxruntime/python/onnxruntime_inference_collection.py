@@ -197,6 +197,26 @@ class Session:
             else:
                 raise
 
+    def prepare_run(self, output_names, input_names):
+        """
+        Resolve the names of the inputs and outputs once for runs that always use the same ones.
+        Running the returned object skips looking up the names and validating them, which is a noticeable
+        part of the run time of small models.
+
+        :param output_names: name of the outputs, all of them if empty
+        :param input_names: name of the inputs, in the order of the values given to :meth:`PreparedRun.run`
+        :return: a :class:`onnxruntime.PreparedRun`, which must not be used by several threads at once
+
+        ::
+
+            prepared = sess.prepare_run([output_name], [input_name])
+            for x in batches:
+                prepared.run([x])
+        """
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return PreparedRun(self._sess, self._sess.prepare_run(input_names, output_names))
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -215,6 +235,31 @@ class Session:
         """
         return self._sess.get_profiling_start_time_ns
 
+    def start_calibration(self, tensor_names=None, num_bins=128):
+        """
+        Start collecting the range and histogram of the float tensors produced by the following runs,
+        for the calibration of static quantization. The tensors don't need to be graph outputs.
+        Requires the sequential execution mode. Calling it again discards what was collected.
+
+        :param tensor_names: names of the tensors to collect, all the tensors if None or empty
+        :param num_bins: number of bins of the histogram of a tensor when it is first collected
+        """
+        self._sess.start_calibration(tensor_names or [], num_bins)
+
+    def get_calibration_stats(self):
+        """
+        Return what was collected since :meth:`start_calibration` as a dictionary mapping each tensor name
+        to a tuple (histogram, min, max, threshold). The bins of the histogram are spread evenly over
+        [-threshold, threshold].
+        """
+        return self._sess.get_calibration_stats()
+
+    def end_calibration(self):
+        """
+        Stop collecting and discard what was collected.
+        """
+        self._sess.end_calibration()
+
     def io_binding(self):
         "Return an onnxruntime.IOBinding object`."
         return IOBinding(self)
@@ -349,6 +394,25 @@ class InferenceSession(Session):
         self._create_inference_session(providers, provider_options)
 
 
+class PreparedRun:
+    '''
+    Runs of a session with input and output names resolved once, see :meth:`Session.prepare_run`.
+    '''
+    def __init__(self, sess, prepared_run):
+        self._sess = sess
+        self._prepared_run = prepared_run
+
+    def run(self, inputs, run_options=None):
+        '''
+        Compute the predictions.
+
+        :param inputs: input values, in the order of the input names given to :meth:`Session.prepare_run`
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: the output values, in the order of the output names
+        '''
+        return self._sess.run_prepared(self._prepared_run, inputs, run_options)
+
+
 class IOBinding:
     '''
     This class provides API to bind input/output to a specified device, e.g. GPU.
@@ -495,6 +559,30 @@ class OrtValue:
         return OrtValue(C.OrtValue.ortvalue_from_shape_and_type(shape, element_type,
                         C.OrtDevice(get_ort_device_type(device_type), C.OrtDevice.default_memory(), device_id)))
 
+    @staticmethod
+    def from_dlpack(data, is_bool_tensor=False):
+        '''
+        Factory method to construct an OrtValue (which holds a Tensor) sharing the buffer of a DLPack tensor.
+        No copy is made, the buffer may be on CPU or on a GPU. Only contiguous tensors are supported.
+        :param data: a DLPack capsule or an object implementing `__dlpack__` (e.g. a torch tensor). A capsule
+            is consumed and cannot be used again.
+        :param is_bool_tensor: DLPack uses the same type for bool and uint8, set it to create a bool tensor
+        '''
+        return OrtValue(C.OrtValue.from_dlpack(data, is_bool_tensor))
+
+    def to_dlpack(self):
+        '''
+        Returns a DLPack capsule sharing the buffer of the OrtValue (which must hold a Tensor), no copy is made.
+        The caller is responsible for synchronizing the stream (if any) that produced the data.
+        '''
+        return self._ortvalue.to_dlpack()
+
+    def __dlpack__(self, stream=None):
+        return self._ortvalue.__dlpack__(stream)
+
+    def __dlpack_device__(self):
+        return self._ortvalue.__dlpack_device__()
+
     def data_ptr(self):
         '''
         Returns the address of the first element in the OrtValue's data buffer
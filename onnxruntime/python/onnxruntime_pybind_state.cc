@@ -27,9 +27,8 @@
 #include "core/session/IOBinding.h"
 #include "core/session/abi_session_options_impl.h"
 
-#ifdef ENABLE_TRAINING
-#include "python/dlpack/dlpack_converter.h"
-#endif
+#include "core/framework/dlpack_converter.h"
+#include <dlpack/dlpack.h>
 
 // execution provider factory creator headers
 #include "core/providers/cpu/cpu_provider_factory_creator.h"
@@ -574,8 +573,9 @@ static void RegisterExecutionProviders(InferenceSession* sess, const std::vector
                                           sess->GetSessionOptions().enable_cpu_mem_arena));
     } else if (type == kTensorrtExecutionProvider) {
 #ifdef USE_TENSORRT
-      OrtTensorRTProviderOptions params{0, 0, nullptr, 0, 1 << 30, 0, 0, nullptr, 0, 0};
+      OrtTensorRTProviderOptions params{0, 0, nullptr, 0, 1 << 30, 0, 0, nullptr, 0, 0, nullptr, nullptr, nullptr};
       std::string trt_int8_calibration_table_name;
+      std::string trt_profile_min_shapes, trt_profile_max_shapes, trt_profile_opt_shapes;
       auto it = provider_options_map.find(type);
       if (it != provider_options_map.end()) {
         for (auto option : it->second) {
@@ -630,6 +630,15 @@ static void RegisterExecutionProviders(InferenceSession* sess, const std::vector
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_int8_use_native_calibration_table' should be a boolean i.e. 'True' or 'False'. Default value is False.\n");
             }
+          } else if (option.first == "trt_profile_min_shapes") {
+            trt_profile_min_shapes = option.second;
+            params.trt_profile_min_shapes = trt_profile_min_shapes.c_str();
+          } else if (option.first == "trt_profile_max_shapes") {
+            trt_profile_max_shapes = option.second;
+            params.trt_profile_max_shapes = trt_profile_max_shapes.c_str();
+          } else if (option.first == "trt_profile_opt_shapes") {
+            trt_profile_opt_shapes = option.second;
+            params.trt_profile_opt_shapes = trt_profile_opt_shapes.c_str();
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -726,6 +735,8 @@ static void RegisterExecutionProviders(InferenceSession* sess, const std::vector
             params.device_id = option.second.c_str();
           } else if (option.first == "num_of_threads") {
             params.num_of_threads = std::stoi(option.second);
+          } else if (option.first == "num_streams") {
+            params.num_streams = std::stoi(option.second);
           } else if (option.first == "blob_dump_path") {
             blob_dump_path = option.second;
             params.blob_dump_path = blob_dump_path.c_str();
@@ -1242,7 +1253,6 @@ void addOpSchemaSubmodule(py::module& m) {
 
 #endif  //onnxruntime_PYBIND_EXPORT_OPSCHEMA
 
-#ifdef ENABLE_TRAINING
 void DlpackCapsuleDestructor(PyObject* data) {
   DLManagedTensor* dlmanged_tensor = (DLManagedTensor*)PyCapsule_GetPointer(data, "dltensor");
   if (dlmanged_tensor) {
@@ -1254,7 +1264,22 @@ void DlpackCapsuleDestructor(PyObject* data) {
     PyErr_Clear();
   }
 }
-#endif
+
+// Accepts a DLPack capsule or any object implementing the __dlpack__ protocol (e.g. a torch.Tensor).
+// The capsule is marked as consumed, the returned OrtValue now owns the DLPack tensor.
+static OrtValue OrtValueFromDlpack(py::object data, bool is_bool_tensor) {
+  if (!PyCapsule_CheckExact(data.ptr()) && py::hasattr(data, "__dlpack__")) {
+    data = data.attr("__dlpack__")();
+  }
+  DLManagedTensor* dlmanaged_tensor = (DLManagedTensor*)PyCapsule_GetPointer(data.ptr(), "dltensor");
+  if (dlmanaged_tensor == nullptr) {
+    throw py::error_already_set();
+  }
+  OrtValue ort_value = dlpack::DlpackToOrtValue(dlmanaged_tensor, is_bool_tensor);
+  // Make sure this capsule will never be used again.
+  PyCapsule_SetName(data.ptr(), "used_dltensor");
+  return ort_value;
+}
 
 void addObjectMethods(py::module& m, Environment& env) {
   py::enum_<GraphOptimizationLevel>(m, "GraphOptimizationLevel")
@@ -1481,21 +1506,30 @@ void addObjectMethods(py::module& m, Environment& env) {
 #endif
         return obj;
       })
-#ifdef ENABLE_TRAINING
+      // DLPack export and import share the tensor buffer (CPU or GPU) with the other framework, nothing is copied
       .def("to_dlpack", [](OrtValue* ort_value) -> py::object {
-        DLManagedTensor* dlmanaged_tensor = OrtValueToDlpack(*ort_value);
+        DLManagedTensor* dlmanaged_tensor = dlpack::OrtValueToDlpack(*ort_value);
         return py::reinterpret_steal<py::object>(
             PyCapsule_New(dlmanaged_tensor, "dltensor", DlpackCapsuleDestructor));
       })
-      .def_static("from_dlpack", [](py::object data, bool is_bool_tensor = false) {
-        DLManagedTensor* dlmanaged_tensor = (DLManagedTensor*)PyCapsule_GetPointer(data.ptr(), "dltensor");
-        OrtValue ort_value = DlpackToOrtValue(dlmanaged_tensor, is_bool_tensor);
-        // Make sure this capsule will never be used again.
-        PyCapsule_SetName(data.ptr(), "used_dltensor");
-        return ort_value;
-      })
+      .def("__dlpack__", [](OrtValue* ort_value, py::object /*stream*/) -> py::object {
+        // ORT synchronizes its streams at the end of every run, the buffer is ready for any consumer stream
+        DLManagedTensor* dlmanaged_tensor = dlpack::OrtValueToDlpack(*ort_value);
+        return py::reinterpret_steal<py::object>(
+            PyCapsule_New(dlmanaged_tensor, "dltensor", DlpackCapsuleDestructor));
+      },
+           py::arg("stream") = py::none())
+      .def("__dlpack_device__", [](OrtValue* ort_value) -> py::tuple {
+        ORT_ENFORCE(ort_value->IsTensor(), "Only tensor type OrtValues are supported");
+        const auto& device = ort_value->Get<Tensor>().Location().device;
+#ifdef USE_ROCM
+        int device_type = device.Type() == OrtDevice::GPU ? static_cast<int>(kDLROCM) : static_cast<int>(kDLCPU);
+#else
+        int device_type = device.Type() == OrtDevice::GPU ? static_cast<int>(kDLGPU) : static_cast<int>(kDLCPU);
 #endif
-      ;
+        return py::make_tuple(device_type, static_cast<int>(device.Id()));
+      })
+      .def_static("from_dlpack", &OrtValueFromDlpack, py::arg("data"), py::arg("is_bool_tensor") = false);
 
   py::class_<SessionIOBinding> session_io_binding(m, "SessionIOBinding");
   session_io_binding
@@ -1892,6 +1926,9 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           },
           "node shape (assuming the node holds a tensor)");
 
+  py::class_<InferenceSession::PreparedRun>(m, "PreparedRun",
+                                            R"pbdoc(The input and output names of runs resolved once.)pbdoc");
+
   py::class_<SessionObjectInitializer>(m, "SessionObjectInitializer");
   py::class_<PyInferenceSession>(m, "InferenceSession", R"pbdoc(This is the main class used to run a model.)pbdoc")
       // In Python3, a Python bytes object will be passed to C++ functions that accept std::string or char*
@@ -1965,6 +2002,56 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                }
              }
 
+             std::vector<py::object> rfetch;
+             rfetch.reserve(fetches.size());
+             for (auto _ : fetches) {
+               if (_.IsTensor()) {
+                 AddTensorAsPyObj(_, rfetch, nullptr, nullptr);
+               } else {
+                 AddNonTensorAsPyObj(_, rfetch, nullptr, nullptr);
+               }
+             }
+             return rfetch;
+           })
+      .def(
+          "prepare_run",
+          [](const PyInferenceSession* sess, const std::vector<std::string>& input_names,
+             const std::vector<std::string>& output_names) -> std::unique_ptr<InferenceSession::PreparedRun> {
+            std::unique_ptr<InferenceSession::PreparedRun> prepared_run;
+            OrtPybindThrowIfError(sess->GetSessionHandle()->PrepareRun(input_names, output_names, prepared_run));
+            return prepared_run;
+          },
+          // the prepared run refers to the session
+          py::keep_alive<0, 1>())
+      .def("run_prepared",
+           [](PyInferenceSession* sess, InferenceSession::PreparedRun& prepared_run, const std::vector<py::object>& pyfeeds,
+              RunOptions* run_options = nullptr) -> std::vector<py::object> {
+             const auto& feed_names = prepared_run.feeds_fetches_manager->GetFeedsFetchesInfo().feed_names;
+             if (pyfeeds.size() != feed_names.size()) {
+               throw std::runtime_error("The prepared run has " + std::to_string(feed_names.size()) +
+                                        " inputs. Got " + std::to_string(pyfeeds.size()));
+             }
+
+             auto px = sess->GetSessionHandle()->GetModelInputs();
+             if (!px.first.IsOK() || !px.second) {
+               throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+             }
+             std::vector<OrtValue> feeds(pyfeeds.size());
+             for (size_t i = 0; i < pyfeeds.size(); ++i) {
+               py::object value = pyfeeds[i];
+               CreateGenericMLValue(px.second, GetAllocator(), feed_names[i], value, &feeds[i]);
+               ThrowIfPyErrOccured();
+             }
+
+             std::vector<OrtValue> fetches;
+             {
+               // release GIL to allow multiple python threads to invoke Run() in parallel.
+               py::gil_scoped_release release;
+               RunOptions default_run_options;
+               OrtPybindThrowIfError(sess->GetSessionHandle()->Run(
+                   run_options != nullptr ? *run_options : default_run_options, prepared_run, feeds, &fetches));
+             }
+
              std::vector<py::object> rfetch;
              rfetch.reserve(fetches.size());
              for (auto _ : fetches) {
@@ -1982,6 +2069,23 @@ including arg name, arg type (contains both type and shape).)pbdoc")
       .def_property_readonly("get_profiling_start_time_ns", [](const PyInferenceSession* sess) -> uint64_t {
         return sess->GetSessionHandle()->GetProfiling().GetStartTimeNs();
       })
+      .def("start_calibration", [](PyInferenceSession* sess, const std::vector<std::string>& tensor_names, size_t num_bins) -> void {
+        OrtPybindThrowIfError(sess->GetSessionHandle()->StartCalibration(tensor_names, num_bins));
+      })
+      .def("get_calibration_stats", [](const PyInferenceSession* sess) {
+        // tensor name: (histogram, min, max, threshold)
+        std::unordered_map<std::string, TensorCalibrationCollector::TensorStats> stats;
+        OrtPybindThrowIfError(sess->GetSessionHandle()->GetCalibrationStats(stats));
+        std::unordered_map<std::string, std::tuple<std::vector<int64_t>, float, float, float>> result;
+        for (auto& entry : stats) {
+          result.emplace(entry.first, std::make_tuple(std::move(entry.second.histogram), entry.second.min,
+                                                      entry.second.max, entry.second.threshold));
+        }
+        return result;
+      })
+      .def("end_calibration", [](PyInferenceSession* sess) -> void {
+        sess->GetSessionHandle()->EndCalibration();
+      })
       .def("get_providers", [](PyInferenceSession* sess) -> const std::vector<std::string>& {
         return sess->GetSessionHandle()->GetRegisteredProviderTypes();
       })
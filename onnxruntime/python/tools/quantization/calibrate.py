@@ -39,11 +39,14 @@ class CalibrationDataReader(metaclass=abc.ABCMeta):
 
 
 class CalibraterBase:
-    def __init__(self, model, op_types_to_calibrate=[], augmented_model_path='augmented_model.onnx'):
+    def __init__(self, model, op_types_to_calibrate=[], augmented_model_path='augmented_model.onnx',
+                 native_collection=False):
         '''
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
         :param op_types_to_calibrate: operator types to calibrate. By default, calibrate all the float32/float16 tensors.
         :param augmented_model_path: save augmented model to this path.
+        :param native_collection: collect the tensors in the calibration mode of the InferenceSession as they are
+            produced instead of adding them to the graph outputs. It is much faster and uses much less memory.
         '''
         if isinstance(model, string_types):
             self.model = onnx.load(model)
@@ -54,10 +57,14 @@ class CalibraterBase:
 
         self.op_types_to_calibrate = op_types_to_calibrate
         self.augmented_model_path = augmented_model_path
+        self.native_collection = native_collection
 
         # augment graph
         self.augment_model = None
-        self.augment_graph()
+        if native_collection:
+            self.tensors_to_calibrate, _ = self.select_tensors_to_calibrate(onnx.shape_inference.infer_shapes(self.model))
+        else:
+            self.augment_graph()
 
         # Create InferenceSession
         self.infer_session = None
@@ -77,9 +84,15 @@ class CalibraterBase:
         '''
         sess_options = onnxruntime.SessionOptions()
         sess_options.graph_optimization_level = onnxruntime.GraphOptimizationLevel.ORT_DISABLE_ALL
-        self.infer_session = onnxruntime.InferenceSession(self.augmented_model_path,
-                                                          sess_options=sess_options,
-                                                          providers=self.execution_providers)
+        if self.native_collection:
+            self.infer_session = onnxruntime.InferenceSession(self.model.SerializeToString(),
+                                                              sess_options=sess_options,
+                                                              providers=self.execution_providers)
+            self.infer_session.start_calibration(list(self.tensors_to_calibrate), self.native_collection_bins())
+        else:
+            self.infer_session = onnxruntime.InferenceSession(self.augmented_model_path,
+                                                              sess_options=sess_options,
+                                                              providers=self.execution_providers)
 
     def select_tensors_to_calibrate(self, model):
         '''
@@ -108,6 +121,31 @@ class CalibraterBase:
 
         return tensors_to_calibrate, value_infos
 
+    def native_collection_bins(self):
+        '''
+        return: the number of histogram bins of the native collection
+        '''
+        return 1
+
+    def run_native_collection(self, data_reader: CalibrationDataReader):
+        '''
+        run the inputs of data_reader in the calibration mode of the InferenceSession.
+        returns: dictionary mapping the collected tensor names to tuples (histogram, min, max, threshold),
+            accumulated since the InferenceSession was created.
+        '''
+        has_data = False
+        while True:
+            inputs = data_reader.get_next()
+            if not inputs:
+                break
+            self.infer_session.run(None, inputs)
+            has_data = True
+
+        if not has_data:
+            raise ValueError("No data is collected.")
+
+        return self.infer_session.get_calibration_stats()
+
     def get_augment_model(self):
         '''
         return: augmented onnx model
@@ -136,13 +174,15 @@ class CalibraterBase:
 
 
 class MinMaxCalibrater(CalibraterBase):
-    def __init__(self, model, op_types_to_calibrate=[], augmented_model_path='augmented_model.onnx'):
+    def __init__(self, model, op_types_to_calibrate=[], augmented_model_path='augmented_model.onnx',
+                 native_collection=False):
         '''
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
         :param op_types_to_calibrate: operator types to calibrate. By default, calibrate all the float32/float16 tensors.
         :param augmented_model_path: save augmented model to this path.
+        :param native_collection: collect the tensors in the calibration mode of the InferenceSession.
         '''
-        super(MinMaxCalibrater, self).__init__(model, op_types_to_calibrate, augmented_model_path)
+        super(MinMaxCalibrater, self).__init__(model, op_types_to_calibrate, augmented_model_path, native_collection)
         self.intermediate_outputs = []
         self.calibrate_tensors_range = None
         self.num_model_outputs = len(self.model.graph.output)
@@ -205,6 +245,12 @@ class MinMaxCalibrater(CalibraterBase):
         self.intermediate_outputs = []
 
     def collect_data(self, data_reader: CalibrationDataReader):
+        if self.native_collection:
+            stats = self.run_native_collection(data_reader)
+            new_range = {tensor: (float(s[1]), float(s[2])) for tensor, s in stats.items()}
+            self.calibrate_tensors_range = self.merge_range(self.calibrate_tensors_range, new_range)
+            return
+
         while True:
             inputs = data_reader.get_next()
             if not inputs:
@@ -222,6 +268,9 @@ class MinMaxCalibrater(CalibraterBase):
             return new_range
 
         for key, value in old_range.items(): 
+            if key not in new_range:
+                new_range[key] = value
+                continue
             min_value = min(value[0], new_range[key][0])
             max_value = max(value[1], new_range[key][1])
             new_range[key] = (min_value, max_value)
@@ -276,13 +325,16 @@ class MinMaxCalibrater(CalibraterBase):
         return self.calibrate_tensors_range
 
 class EntropyCalibrater(CalibraterBase):
-    def __init__(self, model, op_types_to_calibrate=[], augmented_model_path='augmented_model.onnx'):
+    def __init__(self, model, op_types_to_calibrate=[], augmented_model_path='augmented_model.onnx',
+                 native_collection=False):
         '''
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
         :param op_types_to_calibrate: operator types to calibrate. By default, calibrate all the float32/float16 tensors.
         :param augmented_model_path: save augmented model to this path.
+        :param native_collection: collect the tensors and their histograms in the calibration mode of the
+            InferenceSession.
         '''
-        super(EntropyCalibrater, self).__init__(model, op_types_to_calibrate, augmented_model_path)
+        super(EntropyCalibrater, self).__init__(model, op_types_to_calibrate, augmented_model_path, native_collection)
         self.intermediate_outputs = []
         self.calibrate_tensors_range = None
         self.num_model_outputs = len(self.model.graph.output)
@@ -317,6 +369,15 @@ class EntropyCalibrater(CalibraterBase):
         '''
         Entropy Calibrator collects operators' tensors as well as generates tensor histogram for each operator. 
         '''
+        if not self.collector:
+            self.collector = HistogramCollector()
+
+        if self.native_collection:
+            # the histograms are accumulated by the InferenceSession since it was created
+            stats = self.run_native_collection(data_reader)
+            self.collector.set_histograms(stats)
+            return
+
         while True:
             inputs = data_reader.get_next()
             if not inputs:
@@ -339,12 +400,13 @@ class EntropyCalibrater(CalibraterBase):
 
         clean_merged_dict = dict((i, merged_dict[i]) for i in merged_dict if i not in self.model_original_outputs)
 
-        if not self.collector:
-            self.collector = HistogramCollector()
         self.collector.collect(clean_merged_dict)
 
         self.clear_collected_data()
 
+    def native_collection_bins(self):
+        return HistogramCollector().num_quantized_bins
+
     def compute_range(self):
         ''' 
         Compute the min-max range of tensor
@@ -390,6 +452,18 @@ class HistogramCollector(CalibrationDataCollector):
     def get_histogram_dict(self):
         return self.histogram_dict
 
+    def set_histograms(self, stats):
+        '''
+        set the histograms collected by the calibration mode of an InferenceSession.
+        :param stats: dictionary mapping tensor names to tuples (histogram, min, max, threshold)
+        '''
+        for tensor, (hist, min_value, max_value, threshold) in stats.items():
+            hist = np.asarray(hist, dtype=np.int64)
+            # numpy.histogram spreads the bins over [-0.5, 0.5] when the range is empty
+            edge = threshold if threshold > 0 else 0.5
+            hist_edges = np.linspace(-edge, edge, len(hist) + 1)
+            self.histogram_dict[tensor] = (hist, hist_edges, min_value, max_value, threshold)
+
     def collect(self, name_to_arr):
         for tensor, data_arr in name_to_arr.items():
             data_arr = np.asarray(data_arr)
@@ -514,10 +588,11 @@ class HistogramCollector(CalibrationDataCollector):
 def create_calibrator(model,
                       op_types_to_calibrate=[],
                       augmented_model_path='augmented_model.onnx',
-                      calibrate_method=CalibrationMethod.MinMax):
+                      calibrate_method=CalibrationMethod.MinMax,
+                      native_collection=False):
     if calibrate_method == CalibrationMethod.MinMax:
-        return MinMaxCalibrater(model, op_types_to_calibrate, augmented_model_path)
+        return MinMaxCalibrater(model, op_types_to_calibrate, augmented_model_path, native_collection)
     elif calibrate_method == CalibrationMethod.Entropy:
-        return EntropyCalibrater(model, op_types_to_calibrate, augmented_model_path)
+        return EntropyCalibrater(model, op_types_to_calibrate, augmented_model_path, native_collection)
 
     raise ValueError('Unsupported calibration method {}'.format(calibrate_method))
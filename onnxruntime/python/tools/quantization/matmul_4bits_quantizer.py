@@ -0,0 +1,132 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+
+import argparse
+import logging
+
+import numpy as np
+import onnx
+from onnx import numpy_helper
+
+from .onnx_model import ONNXModel
+from .quant_utils import ms_domain
+
+
+class MatMul4BitsQuantizer:
+    '''
+    Replaces the MatMul nodes with a constant 2-D float weight by com.microsoft MatMulNBits nodes, which
+    store the weight block-wise quantized to 4 bits and keep the activations in float (weight-only quantization).
+    '''
+
+    def __init__(self, model, block_size=32, is_symmetric=False, nodes_to_exclude=None):
+        if block_size < 16 or (block_size & (block_size - 1)) != 0:
+            raise ValueError('block_size must be a power of 2 and at least 16, got {}'.format(block_size))
+        self.model = ONNXModel(model)
+        self.block_size = block_size
+        self.is_symmetric = is_symmetric
+        self.nodes_to_exclude = set(nodes_to_exclude or [])
+
+    def quantize_weight(self, weight):
+        '''
+        Quantizes a [K, N] float weight. Returns the packed values [N, ceil(K / block_size), block_size / 2],
+        the scales [N * ceil(K / block_size)] and the packed zero points, None when the blocks are symmetric.
+        '''
+        k, n = weight.shape
+        block_count = (k + self.block_size - 1) // self.block_size
+        padded = np.zeros((block_count * self.block_size, n), dtype=np.float32)
+        padded[:k, :] = weight
+        # [N, block_count, block_size]
+        blocks = padded.T.reshape(n, block_count, self.block_size)
+
+        if self.is_symmetric:
+            absmax = np.abs(blocks).max(axis=2)
+            scales = absmax / 7.0
+            zero_points = np.full((n, block_count), 8, dtype=np.int32)
+        else:
+            rmin = np.minimum(blocks.min(axis=2), 0.0)
+            rmax = np.maximum(blocks.max(axis=2), 0.0)
+            scales = (rmax - rmin) / 15.0
+            zero_points = np.zeros((n, block_count), dtype=np.int32)
+            nonzero = scales != 0
+            zero_points[nonzero] = np.clip(np.round(-rmin[nonzero] / scales[nonzero]), 0, 15).astype(np.int32)
+
+        safe_scales = np.where(scales == 0, 1.0, scales)
+        quantized = np.round(blocks / safe_scales[:, :, None]) + zero_points[:, :, None]
+        quantized = np.clip(quantized, 0, 15).astype(np.uint8)
+        packed = quantized[:, :, 0::2] | (quantized[:, :, 1::2] << 4)
+
+        packed_zero_points = None
+        if not self.is_symmetric:
+            if block_count % 2 != 0:
+                zero_points = np.concatenate([zero_points, np.full((n, 1), 8, dtype=np.int32)], axis=1)
+            zero_points = zero_points.astype(np.uint8)
+            packed_zero_points = (zero_points[:, 0::2] | (zero_points[:, 1::2] << 4)).reshape(-1)
+
+        return packed, scales.astype(np.float32).reshape(-1), packed_zero_points
+
+    def quantize_matmul(self, node):
+        weight_initializer = self.model.get_initializer(node.input[1])
+        if weight_initializer is None:
+            return None
+        weight = numpy_helper.to_array(weight_initializer)
+        if weight.ndim != 2 or weight.dtype != np.float32:
+            return None
+
+        packed, scales, zero_points = self.quantize_weight(weight)
+        k, n = weight.shape
+        prefix = node.input[1] + '_Q4'
+
+        initializers = [numpy_helper.from_array(packed, prefix), numpy_helper.from_array(scales, prefix + '_scales')]
+        inputs = [node.input[0], prefix, prefix + '_scales']
+        if zero_points is not None:
+            initializers.append(numpy_helper.from_array(zero_points, prefix + '_zero_points'))
+            inputs.append(prefix + '_zero_points')
+        for initializer in initializers:
+            self.model.add_initializer(initializer)
+
+        return onnx.helper.make_node('MatMulNBits',
+                                     inputs,
+                                     node.output,
+                                     name=(node.name + '_Q4') if node.name else '',
+                                     domain=ms_domain,
+                                     K=k,
+                                     N=n,
+                                     bits=4,
+                                     block_size=self.block_size)
+
+    def process(self):
+        for node in self.model.nodes():
+            if node.op_type == 'MatMul' and node.name not in self.nodes_to_exclude:
+                quantized_node = self.quantize_matmul(node)
+                if quantized_node is not None:
+                    logging.info('quantized {} to 4 bits'.format(node.name or node.output[0]))
+                    # replace the node in place to keep the nodes sorted
+                    node.CopyFrom(quantized_node)
+
+        if not any(opset.domain == ms_domain for opset in self.model.opset_import()):
+            self.model.opset_import().extend([onnx.helper.make_opsetid(ms_domain, 1)])
+        self.model.remove_unused_constant()
+        return self.model.model
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='Quantize the weights of the MatMul nodes of a model to 4 bits')
+    parser.add_argument('--input_model', required=True, help='path to the float model')
+    parser.add_argument('--output_model', required=True, help='path to save the quantized model')
+    parser.add_argument('--block_size', type=int, default=32, help='rows of the weight in each quantization block')
+    parser.add_argument('--symmetric', action='store_true', help='quantize the blocks without zero points')
+    parser.add_argument('--nodes_to_exclude', nargs='+', default=[], help='names of the MatMul nodes to keep in float')
+    parser.add_argument('--use_external_data_format', action='store_true',
+                        help='save the model with its initializers in external files, for models over 2GB')
+    return parser.parse_args()
+
+
+if __name__ == '__main__':
+    args = parse_args()
+    quantizer = MatMul4BitsQuantizer(onnx.load(args.input_model), args.block_size, args.symmetric,
+                                     args.nodes_to_exclude)
+    quantizer.process()
+    quantizer.model.save_model_to_file(args.output_model, args.use_external_data_format)
@@ -182,6 +182,8 @@ def quantize_static(model_input,
     :param extra_options:
         key value pair dictionary for various options in different case. Current used:
             extra.Sigmoid.nnapi = True  (Default is False)
+            CalibNativeCollection = True  (Default is False): collect the calibration data in the calibration
+                mode of the InferenceSession instead of adding the tensors to the graph outputs.
     '''
 
     if activation_type != QuantType.QUInt8:
@@ -194,7 +196,10 @@ def quantize_static(model_input,
 
     model = load_model(Path(model_input), optimize_model)
 
-    calibrator = create_calibrator(model, op_types_to_quantize, calibrate_method=calibrate_method)
+    calibrator = create_calibrator(model,
+                                   op_types_to_quantize,
+                                   calibrate_method=calibrate_method,
+                                   native_collection=extra_options.get('CalibNativeCollection', False))
     calibrator.collect_data(calibration_data_reader)
     tensors_range = calibrator.compute_range()
 
@@ -7,6 +7,7 @@
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/logging/sinks/composite_sink.h"
 #include "core/common/logging/sinks/file_sink.h"
+#include "core/common/logging/sinks/ring_buffer_sink.h"
 
 #include "test/common/logging/helpers.h"
 
@@ -144,3 +145,39 @@ TEST(LoggingTests, TestCompositeSink) {
 
   LOGS_CATEGORY(*logger, WARNING, "ArbitraryCategory") << "Warning";
 }
+
+/// <summary>
+/// Tests that a ring_buffer_sink passes the messages of all the threads on to its sink.
+/// </summary>
+TEST(LoggingTests, TestRingBufferSink) {
+  const std::string logid{"TestRingBufferSink"};
+  const Severity min_log_level = Severity::kWARNING;
+  const int num_threads = 4;
+  const int num_messages = 10;
+
+  MockSink* sink_ptr = new MockSink();
+  EXPECT_CALL(*sink_ptr, SendImpl(testing::_, logid, testing::_)).Times(num_threads * num_messages + 1);
+
+  {
+    RingBufferSink* sink = new RingBufferSink(std::unique_ptr<ISink>{sink_ptr}, num_messages);
+    LoggingManager manager{std::unique_ptr<ISink>(sink), min_log_level, false, InstanceType::Temporal};
+    auto logger = manager.CreateLogger(logid);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&]() {
+        for (int i = 0; i < num_messages; ++i) {
+          LOGS(*logger, WARNING) << "Warning " << i;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // errors are passed on before the logging call returns
+    LOGS(*logger, ERROR) << "Error";
+    testing::Mock::VerifyAndClearExpectations(sink_ptr);
+    EXPECT_EQ(sink->DroppedMessages(), 0u);
+  }
+}
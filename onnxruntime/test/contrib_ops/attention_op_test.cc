@@ -2,6 +2,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -38,7 +42,8 @@ static void RunAttentionTest(
     MaskIndexType mask_index_type = kMaskIndexEnd,
     int input_hidden_size = 0,
     int max_sequence_length = 0,
-    bool only_enable_cuda = false) {
+    bool only_enable_cuda = false,
+    bool past_present_share_buffer = false) {
   input_hidden_size = (input_hidden_size == 0 ? hidden_size : input_hidden_size); // By default, no pruning.
 
   int min_cuda_architecture = use_float16 ? 530 : 0;
@@ -50,6 +55,9 @@ static void RunAttentionTest(
     OpTester tester("Attention", 1, onnxruntime::kMSDomain);
     tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
     tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(is_unidirectional ? 1 : 0));
+    if (past_present_share_buffer) {
+      tester.AddAttribute<int64_t>("past_present_share_buffer", static_cast<int64_t>(1));
+    }
 
     std::vector<int64_t> input_dims = {batch_size, sequence_length, input_hidden_size};
     std::vector<int64_t> weights_dims = {input_hidden_size, 3 * hidden_size};
@@ -108,18 +116,37 @@ static void RunAttentionTest(
       tester.AddMissingOptionalInput<int32_t>();
     }
 
+    // With a shared buffer, past has the shape of present and holds the past state in the
+    // first past_sequence_length positions of each head.
+    std::vector<float> shared_past_data;
+    if (use_past_state && past_present_share_buffer) {
+      const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;
+      const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;
+      for (size_t i = 0; i < static_cast<size_t>(2 * batch_size * number_of_heads); i++) {
+        shared_past_data.insert(shared_past_data.end(), past_data->begin() + i * past_chunk_length,
+                                past_data->begin() + (i + 1) * past_chunk_length);
+        shared_past_data.insert(shared_past_data.end(), input_chunk_length, 0.0f);
+      }
+      past_dims = present_dims;
+      past_data = &shared_past_data;
+    }
+
     if (use_past_state) {
       if (use_float16) {
-        if (past_sequence_length > 0) {
+        if (past_sequence_length > 0 || past_present_share_buffer) {
           tester.AddInput<MLFloat16>("past", past_dims, ToFloat16(*past_data));
         }
         tester.AddOutput<MLFloat16>("present", present_dims, ToFloat16(*present_data));
       } else {
-        if (past_sequence_length > 0) {
+        if (past_sequence_length > 0 || past_present_share_buffer) {
           tester.AddInput<float>("past", past_dims, *past_data);
         }
         tester.AddOutput<float>("present", present_dims, *present_data);
       }
+
+      if (past_present_share_buffer) {
+        tester.AddInput<int32_t>("past_sequence_length", {}, {past_sequence_length});
+      }
     }
 
     if (enable_cuda) {
@@ -155,17 +182,18 @@ static void RunAttentionTest(
     MaskIndexType mask_index_type = kMaskIndexEnd,
     int input_hidden_size = 0,
     int max_sequence_length = 0,
-    bool only_enable_cuda = false) {
+    bool only_enable_cuda = false,
+    bool past_present_share_buffer = false) {
   RunAttentionTest(input_data, weights_data, false, bias_data, mask_index_data, output_data,
                    batch_size, sequence_length, hidden_size, number_of_heads,
                    use_float16, is_unidirectional, use_past_state, past_sequence_length,
                    past_data, present_data, mask_index_type, input_hidden_size, max_sequence_length,
-                   only_enable_cuda);
+                   only_enable_cuda, past_present_share_buffer);
   RunAttentionTest(input_data, weights_data, true, bias_data, mask_index_data, output_data,
                    batch_size, sequence_length, hidden_size, number_of_heads,
                    use_float16, is_unidirectional, use_past_state, past_sequence_length,
                    past_data, present_data, mask_index_type, input_hidden_size, max_sequence_length,
-                   only_enable_cuda);
+                   only_enable_cuda, past_present_share_buffer);
 }
 
 TEST(AttentionTest, AttentionBatch1) {
@@ -736,6 +764,110 @@ TEST(AttentionTest, AttentionPastStateBatch2) {
                    use_past_state, past_sequence_length, &past_data, &present_data);
 }
 
+TEST(AttentionTest, AttentionPastStateBatch2SharedBuffer) {
+  int batch_size = 2;
+  int sequence_length = 1;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data = {
+      -0.10902753f, 0.0041178204f, 0.1871525f, -0.20399982f,
+      0.027207348f, -0.25321805f, 0.12869114f, 0.023136809f};
+
+  std::vector<float> weight_data = {
+      -0.4738484025001526f,
+      -0.2613658607006073f,
+      -0.0978037416934967f,
+      -0.34988933801651f,
+      0.2243240624666214f,
+      -0.0429205559194088f,
+      0.418695330619812f,
+      0.17441125214099884f,
+      -0.18825532495975494f,
+      0.18357256054878235f,
+      -0.5806483626365662f,
+      -0.02251487597823143f,
+
+      0.08742205798625946f,
+      0.14734269678592682f,
+      0.2387014478445053f,
+      0.2884027063846588f,
+      0.6490834355354309f,
+      0.16965825855731964f,
+      -0.06346885114908218f,
+      0.4073973298072815f,
+      -0.03070945478975773f,
+      0.4110257923603058f,
+      0.07896808534860611f,
+      0.16783113777637482f,
+
+      0.0038893644232302904f,
+      0.06946629285812378f,
+      0.36680519580841064f,
+      -0.07261059433221817f,
+      -0.14960581064224243f,
+      0.020944256335496902f,
+      -0.09378612786531448f,
+      -0.1336742341518402f,
+      0.06061394885182381f,
+      0.2205914407968521f,
+      -0.03519909828901291f,
+      -0.18405692279338837f,
+
+      0.22149960696697235f,
+      -0.1884360909461975f,
+      -0.014074507169425488f,
+      0.4252440333366394f,
+      0.24987126886844635f,
+      -0.31396418809890747f,
+      0.14036843180656433f,
+      0.2854192554950714f,
+      0.09709841012954712f,
+      0.09935075044631958f,
+      -0.012154420837759972f,
+      0.2575816512107849f};
+
+  std::vector<float> bias_data = {
+      0.4803391396999359f,
+      -0.5254325866699219f,
+      -0.42926454544067383f,
+      -0.2059524953365326f,
+      -0.12773379683494568f,
+      -0.09542735666036606f,
+      -0.35286077857017517f,
+      -0.07646317780017853f,
+      -0.04590314254164696f,
+      -0.03752850368618965f,
+      -0.013764488510787487f,
+      -0.18478283286094666f};
+
+  // No mask_index
+  std::vector<int32_t> mask_index_data = {};
+
+  std::vector<float> output_data = {
+      0.14902574f, 0.62273371f, 0.43022552f, 0.12759127f,
+      0.26993567f, 0.23553593f, 0.43190649f, 0.086044826f};
+
+  std::vector<float> past_data = {
+      0.42028648f, 0.55855948f, 0.044569403f, 0.76525789f, 0.13962431f, 0.40977913f, 0.36911047f, 0.83399564f, 0.36905321f, 0.91414654f, 0.17300875f, 0.78793788f,
+      0.10279467f, 0.80501258f, 0.089550517f, 0.85371113f, 0.61801594f, 0.91222942f, 0.88626182f, 0.069776468f, 0.10591964f, 0.84836882f, 0.83520192f, 0.0098680854f,
+      0.3113814f, 0.63999802f, 0.28603253f, 0.98899829f, 0.044405211f, 0.95105386f, 0.81278932f, 0.63969064f, 0.14494057f, 0.11349615f, 0.87086016f, 0.20983537f,
+      0.35107401f, 0.90144604f, 0.68950737f, 0.18928574f, 0.18029204f, 0.074517399f, 0.70763874f, 0.48440042f, 0.58114725f, 0.1048766f, 0.73694098f, 0.17766342f};
+
+  std::vector<float> present_data = {
+      0.42028648f, 0.55855948f, 0.044569403f, 0.76525789f, 0.13962431f, 0.40977913f, -0.22849128f, -0.022080801f, 0.36911047f, 0.83399564f, 0.36905321f, 0.91414654f, 0.17300875f, 0.78793788f, -0.4449589f, -0.17704415f, 0.10279467f, 0.80501258f, 0.089550517f, 0.85371113f, 0.61801594f, 0.91222942f, -0.2994619f, -0.14412443f, 0.88626182f, 0.069776468f, 0.10591964f, 0.84836882f, 0.83520192f, 0.0098680854f, -0.33421949f, -0.18547727f,
+      0.3113814f, 0.63999802f, 0.28603253f, 0.98899829f, 0.044405211f, 0.95105386f, -0.033968594f, -0.034833729f, 0.81278932f, 0.63969064f, 0.14494057f, 0.11349615f, 0.87086016f, 0.20983537f, 0.045759238f, -0.26863033f, 0.35107401f, 0.90144604f, 0.68950737f, 0.18928574f, 0.18029204f, 0.074517399f, -0.033201858f, -0.10592631f, 0.70763874f, 0.48440042f, 0.58114725f, 0.1048766f, 0.73694098f, 0.17766342f, -0.054369561f, -0.24562015f};
+
+  bool is_unidirectional = true;
+  bool use_past_state = true;
+  int past_sequence_length = 3;
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional,
+                   use_past_state, past_sequence_length, &past_data, &present_data,
+                   kMaskIndexEnd, 0, 0, false, true);
+}
+
 TEST(AttentionTest, AttentionPastStateBatch2WithPadding) {
   int batch_size = 2;
   int sequence_length = 1;
@@ -1536,5 +1668,179 @@ TEST(AttentionTest, AttentionPrunedModel) {
                    batch_size, sequence_length, hidden_size, number_of_heads,
                    use_float16, is_unidirectional, use_past_state, past_sequence_length, past_data, present_data, kMaskRaw, input_hidden_size);
 }
+
+// Computes the expected output of Attention without past state, using a raw attention mask [batch_size, sequence_length].
+static std::vector<float> ComputeAttentionReference(const std::vector<float>& input_data,
+                                                    const std::vector<float>& weights_data,
+                                                    const std::vector<float>& bias_data,
+                                                    const std::vector<int32_t>& mask_data,
+                                                    int batch_size,
+                                                    int sequence_length,
+                                                    int hidden_size,
+                                                    int number_of_heads,
+                                                    bool is_unidirectional) {
+  const int head_size = hidden_size / number_of_heads;
+
+  // qkv: [batch_size, sequence_length, 3 * hidden_size]
+  std::vector<double> qkv(static_cast<size_t>(batch_size) * sequence_length * 3 * hidden_size);
+  for (int i = 0; i < batch_size * sequence_length; i++) {
+    for (int j = 0; j < 3 * hidden_size; j++) {
+      double sum = bias_data[j];
+      for (int k = 0; k < hidden_size; k++) {
+        sum += static_cast<double>(input_data[i * hidden_size + k]) * weights_data[k * 3 * hidden_size + j];
+      }
+      qkv[static_cast<size_t>(i) * 3 * hidden_size + j] = sum;
+    }
+  }
+
+  std::vector<float> output(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  std::vector<double> scores(sequence_length);
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      for (int s = 0; s < sequence_length; s++) {
+        const double* q = &qkv[(static_cast<size_t>(b) * sequence_length + s) * 3 * hidden_size + n * head_size];
+        double max = -std::numeric_limits<double>::infinity();
+        for (int m = 0; m < sequence_length; m++) {
+          const double* k = &qkv[(static_cast<size_t>(b) * sequence_length + m) * 3 * hidden_size + hidden_size + n * head_size];
+          double score = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            score += q[h] * k[h];
+          }
+          score /= std::sqrt(static_cast<double>(head_size));
+          if (mask_data[b * sequence_length + m] == 0) {
+            score -= 10000.0;
+          }
+          if (is_unidirectional && m > s) {
+            score -= 10000.0;
+          }
+          scores[m] = score;
+          max = std::max(max, score);
+        }
+
+        double sum = 0.0;
+        for (int m = 0; m < sequence_length; m++) {
+          scores[m] = std::exp(scores[m] - max);
+          sum += scores[m];
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          double value = 0.0;
+          for (int m = 0; m < sequence_length; m++) {
+            value += scores[m] * qkv[(static_cast<size_t>(b) * sequence_length + m) * 3 * hidden_size + 2 * hidden_size + n * head_size + h];
+          }
+          output[(static_cast<size_t>(b) * sequence_length + s) * hidden_size + n * head_size + h] = static_cast<float>(value / sum);
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// Long sequences use the blocked attention of the CPU kernel that does not materialize the attention probs.
+static void RunAttentionLongSequenceTest(bool is_unidirectional) {
+  int batch_size = 2;
+  int sequence_length = 300;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); i++) {
+    input_data[i] = static_cast<float>((i * 17) % 23) / 23.0f - 0.5f;
+  }
+
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = static_cast<float>((i * 7) % 13) / 13.0f - 0.4f;
+  }
+
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); i++) {
+    bias_data[i] = 0.1f * static_cast<float>(i % 5);
+  }
+
+  // The second batch has right-side padding and a masked word in the middle.
+  std::vector<int32_t> mask_data(batch_size * sequence_length, 1);
+  for (int m = 250; m < sequence_length; m++) {
+    mask_data[sequence_length + m] = 0;
+  }
+  mask_data[sequence_length + 100] = 0;
+
+  std::vector<float> output_data = ComputeAttentionReference(input_data, weight_data, bias_data, mask_data,
+                                                             batch_size, sequence_length, hidden_size, number_of_heads,
+                                                             is_unidirectional);
+
+  bool use_float16 = false;
+  bool use_past_state = false;
+  int past_sequence_length = 0;
+  const std::vector<float>* past_data = nullptr;
+  const std::vector<float>* present_data = nullptr;
+  RunAttentionTest(input_data, weight_data, bias_data, mask_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads,
+                   use_float16, is_unidirectional, use_past_state, past_sequence_length, past_data, present_data, kMaskRaw);
+}
+
+TEST(AttentionTest, AttentionLongSequence) {
+  RunAttentionLongSequenceTest(false);
+}
+
+TEST(AttentionTest, AttentionUnidirectionalLongSequence) {
+  RunAttentionLongSequenceTest(true);
+}
+
+// Float16 with head size 64 or 128 and a 1D mask index uses the fused attention kernel of CUDA on sm_70 and above.
+// The sequences are longer than a tile of queries and keys, and the second one ends in the middle of a key tile.
+static void RunAttentionFusedTest(int head_size, bool use_mask) {
+  int batch_size = 2;
+  int sequence_length = 80;
+  int number_of_heads = 2;
+  int hidden_size = number_of_heads * head_size;
+
+  // Values are exact in float16.
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); i++) {
+    input_data[i] = static_cast<float>(static_cast<int>((i * 17) % 23) - 11) / 32.0f;
+  }
+
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = static_cast<float>(static_cast<int>((i * 7) % 13) - 6) / 64.0f;
+  }
+
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); i++) {
+    bias_data[i] = 0.0625f * static_cast<float>(i % 5);
+  }
+
+  std::vector<int32_t> mask_index_data;
+  std::vector<int32_t> mask_data(batch_size * sequence_length, 1);
+  if (use_mask) {
+    mask_index_data = {sequence_length, 50};
+    for (int m = 50; m < sequence_length; m++) {
+      mask_data[sequence_length + m] = 0;
+    }
+  }
+
+  std::vector<float> output_data = ComputeAttentionReference(input_data, weight_data, bias_data, mask_data,
+                                                             batch_size, sequence_length, hidden_size, number_of_heads,
+                                                             false);
+
+  bool use_float16 = true;
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads, use_float16);
+}
+
+TEST(AttentionTest, AttentionFusedHeadSize64) {
+  RunAttentionFusedTest(64, true);
+}
+
+TEST(AttentionTest, AttentionFusedHeadSize128) {
+  RunAttentionFusedTest(128, true);
+}
+
+TEST(AttentionTest, AttentionFusedNoMaskIndex) {
+  RunAttentionFusedTest(64, false);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,247 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "core/graph/model.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/default_providers.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+static constexpr int kVocabSize = 6;
+static constexpr int kEosTokenId = 5;
+static constexpr int kPadTokenId = 0;
+
+/*
+A decoder with one layer of num_heads 1 and head_size 1, where the present state holds the tokens of each beam
+as floats. The logits of a token are its row in an embedding table plus the sum of the present state (twice the
+sum of the tokens of the beam) times a weight per vocabulary entry, so the output depends on the past state being
+reordered correctly with the beams.
+
+ input_ids           past_0
+     |    \            |
+ [Gather]  [Cast]      |
+     |        |        |
+     |   [Unsqueeze]   |
+     |        |        |
+     |    [Concat]     |
+     |         \       |
+     |          [Concat]---------- present_0
+     |              |
+     |         [ReduceSum]
+     |              |
+     |         [Unsqueeze]
+     |              |
+     |            [Mul]
+     |             /
+    [Add]---------/
+     |
+   logits
+*/
+static ONNX_NAMESPACE::GraphProto CreateDecoderSubgraph() {
+  // Unsqueeze and ReduceSum take their axes from an attribute in opset 12
+  Model model("BeamSearch decoder", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{"", 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto int32_tensor;
+  int32_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  int32_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch_beam_size");
+  int32_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("sequence_length");
+
+  TypeProto past_tensor;
+  past_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* past_shape = past_tensor.mutable_tensor_type()->mutable_shape();
+  past_shape->add_dim()->set_dim_value(2);
+  past_shape->add_dim()->set_dim_param("batch_beam_size");
+  past_shape->add_dim()->set_dim_value(1);
+  past_shape->add_dim()->set_dim_param("past_sequence_length");
+  past_shape->add_dim()->set_dim_value(1);
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& input_ids = graph.GetOrCreateNodeArg("input_ids", &int32_tensor);
+  auto& position_ids = graph.GetOrCreateNodeArg("position_ids", &int32_tensor);
+  auto& attention_mask = graph.GetOrCreateNodeArg("attention_mask", &int32_tensor);
+  auto& past_0 = graph.GetOrCreateNodeArg("past_0", &past_tensor);
+
+  auto& embedding = graph.GetOrCreateNodeArg("embedding", &float_tensor);
+  auto& history_weights = graph.GetOrCreateNodeArg("history_weights", &float_tensor);
+  auto& token_logits = graph.GetOrCreateNodeArg("token_logits", &float_tensor);
+  auto& ids_float = graph.GetOrCreateNodeArg("ids_float", &float_tensor);
+  auto& kv_one = graph.GetOrCreateNodeArg("kv_one", &float_tensor);
+  auto& kv = graph.GetOrCreateNodeArg("kv", &float_tensor);
+  auto& present_0 = graph.GetOrCreateNodeArg("present_0", &float_tensor);
+  auto& history_sum = graph.GetOrCreateNodeArg("history_sum", &float_tensor);
+  auto& history_sum_3d = graph.GetOrCreateNodeArg("history_sum_3d", &float_tensor);
+  auto& history_logits = graph.GetOrCreateNodeArg("history_logits", &float_tensor);
+  auto& logits = graph.GetOrCreateNodeArg("logits", &float_tensor);
+
+  TensorProto embedding_proto;
+  embedding_proto.set_name("embedding");
+  embedding_proto.set_data_type(TensorProto_DataType_FLOAT);
+  embedding_proto.add_dims(kVocabSize);
+  embedding_proto.add_dims(kVocabSize);
+  for (float value : {0.0f, 0.6f, -0.79f, 0.46f, 0.18f, -0.7f,
+                      0.79f, -0.61f, 0.01f, 0.59f, -0.8f, 0.47f,
+                      -0.2f, -0.44f, 0.79f, -0.61f, 0.03f, 0.58f,
+                      -0.74f, 0.72f, -0.22f, -0.43f, 0.79f, -0.62f,
+                      0.4f, 0.26f, -0.74f, 0.72f, -0.23f, -0.42f,
+                      0.64f, -0.78f, 0.41f, 0.24f, -0.73f, 0.73f}) {
+    embedding_proto.add_float_data(value);
+  }
+  graph.AddInitializedTensor(embedding_proto);
+
+  TensorProto history_weights_proto;
+  history_weights_proto.set_name("history_weights");
+  history_weights_proto.set_data_type(TensorProto_DataType_FLOAT);
+  history_weights_proto.add_dims(kVocabSize);
+  for (float value : {0.03f, 0.008f, -0.026f, -0.022f, 0.014f, 0.029f}) {
+    history_weights_proto.add_float_data(value);
+  }
+  graph.AddInitializedTensor(history_weights_proto);
+
+  graph.AddNode("gather", "Gather", "Embedding of the tokens", {&embedding, &input_ids}, {&token_logits});
+
+  auto& cast = graph.AddNode("cast", "Cast", "Tokens as the key and value", {&input_ids}, {&ids_float});
+  cast.AddAttribute("to", int64_t{TensorProto_DataType_FLOAT});
+
+  auto& unsqueeze_kv = graph.AddNode("unsqueeze_kv", "Unsqueeze", "", {&ids_float}, {&kv_one});
+  unsqueeze_kv.AddAttribute("axes", std::vector<int64_t>{0, 2, 4});
+
+  auto& concat_kv = graph.AddNode("concat_kv", "Concat", "", {&kv_one, &kv_one}, {&kv});
+  concat_kv.AddAttribute("axis", int64_t{0});
+
+  auto& concat_past = graph.AddNode("concat_past", "Concat", "", {&past_0, &kv}, {&present_0});
+  concat_past.AddAttribute("axis", int64_t{3});
+
+  auto& reduce_sum = graph.AddNode("reduce_sum", "ReduceSum", "", {&present_0}, {&history_sum});
+  reduce_sum.AddAttribute("axes", std::vector<int64_t>{0, 2, 3, 4});
+  reduce_sum.AddAttribute("keepdims", int64_t{0});
+
+  auto& unsqueeze_sum = graph.AddNode("unsqueeze_sum", "Unsqueeze", "", {&history_sum}, {&history_sum_3d});
+  unsqueeze_sum.AddAttribute("axes", std::vector<int64_t>{1, 2});
+
+  graph.AddNode("mul", "Mul", "", {&history_sum_3d, &history_weights}, {&history_logits});
+  graph.AddNode("add", "Add", "", {&token_logits, &history_logits}, {&logits});
+
+  graph.SetInputs({&input_ids, &position_ids, &attention_mask, &past_0});
+  graph.SetOutputs({&logits, &present_0});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  return graph.ToGraphProto();
+}
+
+static void RunBeamSearchTest(const std::vector<int32_t>& input_ids,
+                              int batch_size,
+                              int sequence_length,
+                              int max_length,
+                              int min_length,
+                              int num_beams,
+                              int num_return_sequences,
+                              float temperature,
+                              float length_penalty,
+                              float repetition_penalty,
+                              int no_repeat_ngram_size,
+                              const std::vector<int32_t>& expected_sequences,
+                              const std::vector<float>& expected_sequences_scores) {
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  if (HasCudaEnvironment(0)) {
+    execution_providers.push_back(DefaultCudaExecutionProvider());
+  }
+
+  for (auto& execution_provider : execution_providers) {
+    OpTester tester("BeamSearch", 1, onnxruntime::kMSDomain);
+    tester.AddAttribute<int64_t>("eos_token_id", kEosTokenId);
+    tester.AddAttribute<int64_t>("pad_token_id", kPadTokenId);
+    tester.AddAttribute<int64_t>("no_repeat_ngram_size", no_repeat_ngram_size);
+    tester.AddAttribute("decoder", CreateDecoderSubgraph());
+
+    tester.AddInput<int32_t>("input_ids", {batch_size, sequence_length}, input_ids);
+    tester.AddInput<int32_t>("max_length", {1}, {max_length});
+    tester.AddInput<int32_t>("min_length", {1}, {min_length});
+    tester.AddInput<int32_t>("num_beams", {1}, {num_beams});
+    tester.AddInput<int32_t>("num_return_sequences", {1}, {num_return_sequences});
+    tester.AddInput<float>("temperature", {1}, {temperature});
+    tester.AddInput<float>("length_penalty", {1}, {length_penalty});
+    tester.AddInput<float>("repetition_penalty", {1}, {repetition_penalty});
+
+    tester.AddOutput<int32_t>("sequences", {batch_size, num_return_sequences, max_length}, expected_sequences);
+    tester.AddOutput<float>("sequences_scores", {batch_size, num_return_sequences}, expected_sequences_scores);
+
+    // the decoder subgraph needs an opset import for the ONNX domain
+    std::shared_ptr<Model> model = tester.BuildGraph({{kOnnxDomain, 12}});
+    ASSERT_STATUS_OK(model->MainGraph().Resolve());
+    tester.SetModelCache(model);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> run_execution_providers;
+    run_execution_providers.push_back(std::move(execution_provider));
+    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &run_execution_providers);
+  }
+}
+
+TEST(BeamSearchTest, BeamSearch) {
+  // the second prompt has left-side padding
+  std::vector<int32_t> input_ids = {1, 2, 3,
+                                    0, 4, 2};
+
+  std::vector<int32_t> expected_sequences = {1, 2, 3, 4, 0, 1, 5, 0, 0,
+                                             1, 2, 3, 4, 0, 1, 0, 1, 0,
+
+                                             0, 4, 2, 4, 0, 1, 5, 0, 0,
+                                             0, 4, 2, 4, 0, 1, 0, 1, 0};
+
+  std::vector<float> expected_sequences_scores = {-1.891627f, -2.145672f,
+                                                  -2.216010f, -2.410530f};
+
+  RunBeamSearchTest(input_ids, 2, 3, 9, 6, 3, 2, 1.0f, 0.5f, 1.0f, 0,
+                    expected_sequences, expected_sequences_scores);
+}
+
+TEST(BeamSearchTest, GreedySearchWithLogitsProcessing) {
+  std::vector<int32_t> input_ids = {1, 2, 3,
+                                    0, 4, 2};
+
+  std::vector<int32_t> expected_sequences = {1, 2, 3, 4, 0, 1, 0, 0,
+                                             0, 4, 2, 2, 1, 0, 1, 5};
+
+  std::vector<float> expected_sequences_scores = {-0.802634f, -1.284019f};
+
+  RunBeamSearchTest(input_ids, 2, 3, 8, 5, 1, 1, 0.7f, 1.0f, 1.5f, 2,
+                    expected_sequences, expected_sequences_scores);
+}
+
+TEST(BeamSearchTest, InvalidNumReturnSequences) {
+  OpTester tester("BeamSearch", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("eos_token_id", kEosTokenId);
+  tester.AddAttribute<int64_t>("pad_token_id", kPadTokenId);
+  tester.AddAttribute("decoder", CreateDecoderSubgraph());
+
+  tester.AddInput<int32_t>("input_ids", {1, 3}, {1, 2, 3});
+  tester.AddInput<int32_t>("max_length", {1}, {8});
+  tester.AddMissingOptionalInput<int32_t>();
+  tester.AddInput<int32_t>("num_beams", {1}, {2});
+  tester.AddInput<int32_t>("num_return_sequences", {1}, {3});
+  tester.AddOutput<int32_t>("sequences", {1, 3, 8}, std::vector<int32_t>(24, 0));
+
+  std::shared_ptr<Model> model = tester.BuildGraph({{kOnnxDomain, 12}});
+  ASSERT_STATUS_OK(model->MainGraph().Resolve());
+  tester.SetModelCache(model);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "should be positive and not greater than num_beams", {},
+             nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
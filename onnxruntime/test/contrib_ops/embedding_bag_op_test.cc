@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(EmbeddingBagOpTest, Sum) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 2, 1, -2});
+  test.AddOutput<float>("output", {2, 2}, {6.0f, 8.0f, 6.0f, 8.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, MeanKeepDims) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddAttribute<int64_t>("keepdims", 1);
+  test.AddInput<float>("data", {3, 1, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int32_t>("indices", {1, 3}, {0, 1, 2});
+  test.AddOutput<float>("output", {1, 1, 1, 2}, {3.0f, 4.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, ManyBags) {
+  // enough bags and rows per bag to split across threads and to prefetch across bag boundaries
+  constexpr int64_t num_rows = 100;
+  constexpr int64_t row_size = 24;
+  constexpr int64_t num_bags = 37;
+  constexpr int64_t bag_size = 13;
+
+  std::vector<float> data(num_rows * row_size);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 17) - 8.0f;
+  }
+  std::vector<int64_t> indices(num_bags * bag_size);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int64_t>((i * 31) % num_rows);
+  }
+
+  std::vector<float> expected(num_bags * row_size, 0.0f);
+  for (int64_t bag = 0; bag < num_bags; ++bag) {
+    for (int64_t i = 0; i < bag_size; ++i) {
+      for (int64_t j = 0; j < row_size; ++j) {
+        expected[bag * row_size + j] += data[indices[bag * bag_size + i] * row_size + j];
+      }
+    }
+  }
+
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {num_rows, row_size}, data);
+  test.AddInput<int64_t>("indices", {num_bags, bag_size}, indices);
+  test.AddOutput<float>("output", {num_bags, row_size}, expected);
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, InvalidIndex) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 3});
+  test.AddOutput<float>("output", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds, idx=3");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
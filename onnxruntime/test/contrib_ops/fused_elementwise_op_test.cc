@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static void RunFusedElementwiseTest(const std::vector<int64_t>& x_dims, const std::vector<int64_t>& b_dims,
+                                    const std::vector<int64_t>& s_dims, bool use_float16 = false) {
+  // Y = (X + B) * Sigmoid(X + B) * S - X
+  const std::vector<int64_t> y_dims = x_dims;
+  const int64_t rank = static_cast<int64_t>(y_dims.size());
+
+  auto make_data = [](const std::vector<int64_t>& dims, float scale) {
+    int64_t size = 1;
+    for (int64_t dim : dims) size *= dim;
+    std::vector<float> data(static_cast<size_t>(size));
+    for (int64_t i = 0; i < size; ++i) {
+      data[i] = scale * static_cast<float>(i % 7 - 3);
+    }
+    return data;
+  };
+  const std::vector<float> x_data = make_data(x_dims, 0.5f);
+  const std::vector<float> b_data = make_data(b_dims, 0.25f);
+  const std::vector<float> s_data = make_data(s_dims, 0.125f);
+
+  // offset of the element of an input broadcast to the output coordinates of offset i
+  auto broadcast_offset = [&](const std::vector<int64_t>& dims, int64_t i) {
+    int64_t offset = 0;
+    int64_t stride = 1;
+    int64_t remainder = i;
+    std::vector<int64_t> coordinates(static_cast<size_t>(rank));
+    for (int64_t d = rank - 1; d >= 0; --d) {
+      coordinates[d] = remainder % y_dims[d];
+      remainder /= y_dims[d];
+    }
+    const int64_t padding = rank - static_cast<int64_t>(dims.size());
+    for (int64_t d = rank - 1; d >= padding; --d) {
+      const int64_t dim = dims[d - padding];
+      offset += (dim == 1 ? 0 : coordinates[d]) * stride;
+      stride *= dim;
+    }
+    return offset;
+  };
+
+  std::vector<float> y_data(x_data.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(y_data.size()); ++i) {
+    const float x = x_data[i];
+    const float a = x + b_data[broadcast_offset(b_dims, i)];
+    const float sigmoid = 1.f / (1.f + std::exp(-a));
+    y_data[i] = a * sigmoid * s_data[broadcast_offset(s_dims, i)] - x;
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Sigmoid", "Mul", "Mul", "Sub"});
+  // values: X, B, S, then the results of the ops
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1, 3, 3, 3, 4, 5, 2, 6, 0});
+  if (use_float16) {
+    test.AddInput<MLFloat16>("X", x_dims, ToFloat16(x_data));
+    test.AddInput<MLFloat16>("B", b_dims, ToFloat16(b_data));
+    test.AddInput<MLFloat16>("S", s_dims, ToFloat16(s_data));
+    test.AddOutput<MLFloat16>("Y", y_dims, ToFloat16(y_data));
+  } else {
+    test.AddInput<float>("X", x_dims, x_data);
+    test.AddInput<float>("B", b_dims, b_data);
+    test.AddInput<float>("S", s_dims, s_data);
+    test.AddOutput<float>("Y", y_dims, y_data);
+  }
+
+  if (use_float16) {
+    // the CPU kernel only supports float
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCudaExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  } else {
+    test.Run();
+  }
+}
+
+TEST(FusedElementwiseTest, InnerAndOuterBroadcast) {
+  RunFusedElementwiseTest({2, 3, 8}, {8}, {2, 3, 1});
+#ifdef USE_CUDA
+  RunFusedElementwiseTest({2, 3, 8}, {8}, {2, 3, 1}, true);
+#endif
+}
+
+TEST(FusedElementwiseTest, ScalarAndSameShape) {
+  RunFusedElementwiseTest({4, 5}, {4, 5}, {1});
+}
+
+TEST(FusedElementwiseTest, GeneralBroadcast) {
+  RunFusedElementwiseTest({2, 3, 4, 5}, {3, 1, 5}, {2, 1, 4, 1});
+}
+
+TEST(FusedElementwiseTest, MultipleBlocks) {
+  // runs longer than a block of the CPU kernel, with a partial last block
+  RunFusedElementwiseTest({3, 300}, {300}, {3, 1});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
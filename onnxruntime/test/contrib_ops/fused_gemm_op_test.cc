@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Y = activation(A x B + C) for A (M, K), B (K, N) and C broadcast to (M, N).
+std::vector<float> ComputeFusedGemm(const std::vector<float>& a, const std::vector<float>& b,
+                                    const std::vector<float>& c, const std::vector<int64_t>& c_dims,
+                                    int64_t M, int64_t N, int64_t K, const std::string& activation) {
+  std::vector<float> y(M * N);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a[m * K + k] * b[k * N + n];
+      }
+      if (!c.empty()) {
+        sum += c_dims.size() == 2 && c_dims[0] == M ? c[m * N + n] : c[n];
+      }
+      if (activation == "Relu") {
+        sum = std::max(sum, 0.0f);
+      } else {
+        sum = sum * (0.5f + 0.5f * std::tanh(sum * (0.035677408136300125f * sum * sum + 0.7978845608028654f)));
+      }
+      y[m * N + n] = sum;
+    }
+  }
+  return y;
+}
+
+void RunFusedGemmTest(const std::string& activation, const std::vector<int64_t>& c_dims, bool use_float16) {
+  if (!HasCudaEnvironment(use_float16 ? 530 : 0)) {
+    return;
+  }
+
+  constexpr int64_t M = 4, N = 8, K = 16;
+  std::vector<float> a(M * K), b(K * N), c;
+  for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.125f;
+  for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.25f;
+  if (!c_dims.empty()) {
+    c.resize(c_dims.size() == 2 ? c_dims[0] * c_dims[1] : c_dims[0]);
+    for (size_t i = 0; i < c.size(); ++i) c[i] = static_cast<float>(static_cast<int>(i % 3) - 1) * 0.5f;
+  }
+  const std::vector<float> y = ComputeFusedGemm(a, b, c, c_dims, M, N, K, activation);
+
+  OpTester tester("FusedGemm", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute("activation", activation);
+  if (use_float16) {
+    tester.AddInput<MLFloat16>("A", {M, K}, ToFloat16(a));
+    tester.AddInput<MLFloat16>("B", {K, N}, ToFloat16(b));
+    if (!c_dims.empty()) {
+      tester.AddInput<MLFloat16>("C", c_dims, ToFloat16(c));
+    }
+    tester.AddOutput<MLFloat16>("Y", {M, N}, ToFloat16(y));
+  } else {
+    tester.AddInput<float>("A", {M, K}, a);
+    tester.AddInput<float>("B", {K, N}, b);
+    if (!c_dims.empty()) {
+      tester.AddInput<float>("C", c_dims, c);
+    }
+    tester.AddOutput<float>("Y", {M, N}, y);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+}  // namespace
+
+// C of shape (N,) is added in the epilogue, the others are broadcast to Y before the matrix multiplication.
+TEST(FusedGemmTest, CudaReluBias) {
+  RunFusedGemmTest("Relu", {8}, false);
+}
+
+TEST(FusedGemmTest, CudaReluNoBias) {
+  RunFusedGemmTest("Relu", {}, false);
+}
+
+TEST(FusedGemmTest, CudaFastGeluFullBias) {
+  RunFusedGemmTest("FastGelu", {4, 8}, false);
+}
+
+TEST(FusedGemmTest, CudaFastGeluBiasFloat16) {
+  RunFusedGemmTest("FastGelu", {8}, true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static void RunGroupedMatMulTest(const std::vector<int64_t>& a_dims,
+                                 const std::vector<int64_t>& y_leading_dims,
+                                 const std::vector<float>& a_data,
+                                 bool is_b_constant) {
+  OpTester test("GroupedMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", a_dims, a_data);
+  test.AddInput<float>("B_0", {3, 2}, {1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f}, is_b_constant);
+  test.AddInput<float>("B_1", {3, 1}, {2.0f, -1.0f, 0.5f}, is_b_constant);
+
+  const bool is_empty = a_data.empty();
+  std::vector<int64_t> y0_dims(y_leading_dims);
+  y0_dims.push_back(2);
+  std::vector<int64_t> y1_dims(y_leading_dims);
+  y1_dims.push_back(1);
+  test.AddOutput<float>("Y_0", y0_dims, is_empty ? std::vector<float>{} : std::vector<float>{4.0f, 5.0f, 10.0f, 11.0f});
+  test.AddOutput<float>("Y_1", y1_dims, is_empty ? std::vector<float>{} : std::vector<float>{1.5f, 6.0f});
+  test.Run();
+}
+
+TEST(GroupedMatMulOpTest, GroupedMatMul2D) {
+  const std::vector<float> a_data{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  RunGroupedMatMulTest({2, 3}, {2}, a_data, false);
+  RunGroupedMatMulTest({2, 3}, {2}, a_data, true);
+}
+
+TEST(GroupedMatMulOpTest, GroupedMatMul3D) {
+  const std::vector<float> a_data{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  RunGroupedMatMulTest({2, 1, 3}, {2, 1}, a_data, false);
+  RunGroupedMatMulTest({2, 1, 3}, {2, 1}, a_data, true);
+}
+
+TEST(GroupedMatMulOpTest, GroupedMatMulEmptyInput) {
+  RunGroupedMatMulTest({0, 3}, {0}, {}, true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
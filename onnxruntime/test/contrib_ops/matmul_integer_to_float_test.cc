@@ -147,5 +147,81 @@ TEST(MatMulIntegerToFloat, UInt8_bias_test) {
                                     true /*has_bias*/);
 }
 
+// Checks per-column (block_size == 0) and block-wise (block_size > 0) scales and zero points of B against
+// a reference computed from the dequantized inputs.
+template <typename T>
+void TestMatMulIntegerToFloatPerColumnScales(int64_t M, int64_t N, int64_t K, int64_t block_size,
+                                             bool is_matrix_b_constant) {
+  RandomValueGenerator random{};
+
+  std::vector<uint8_t> A_data;
+  std::vector<int> tmp_A_data = random.Uniform<int32_t>({M, K}, 0, 255);
+  std::transform(tmp_A_data.begin(), tmp_A_data.end(), std::back_inserter(A_data), [](int32_t v) -> uint8_t {
+    return static_cast<uint8_t>(v);
+  });
+
+  std::vector<T> B_data;
+  std::vector<int> tmp_B_data = random.Uniform<int32_t>({K, N}, std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+  std::transform(tmp_B_data.begin(), tmp_B_data.end(), std::back_inserter(B_data), [](int32_t v) -> T {
+    return static_cast<T>(v);
+  });
+
+  const int64_t k_blocks = block_size > 0 ? (K + block_size - 1) / block_size : 1;
+  std::vector<int64_t> B_scale_dims = block_size > 0 ? std::vector<int64_t>{k_blocks, N} : std::vector<int64_t>{N};
+  std::vector<float> A_scale = random.Uniform<float>({1}, 0.01f, 0.1f);
+  std::vector<float> B_scale = random.Uniform<float>(B_scale_dims, -0.1f, 0.1f);
+
+  std::vector<uint8_t> A_zero_point{127};
+  std::vector<T> B_zero_point;
+  std::vector<int> tmp_B_zero_point = random.Uniform<int32_t>(B_scale_dims, -8, 8);
+  std::transform(tmp_B_zero_point.begin(), tmp_B_zero_point.end(), std::back_inserter(B_zero_point), [](int32_t v) -> T {
+    return static_cast<T>(std::is_signed<T>::value ? v : v + 128);
+  });
+
+  std::vector<float> Bias = random.Uniform<float>({N}, -0.1f, 0.1f);
+
+  std::vector<float> Y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = Bias[n];
+      for (int64_t k = 0; k < K; k++) {
+        const int64_t q = (block_size > 0 ? k / block_size : 0) * N + n;
+        sum += (static_cast<float>(A_data[m * K + k]) - A_zero_point[0]) * A_scale[0] *
+               (static_cast<float>(B_data[k * N + n]) - B_zero_point[q]) * B_scale[q];
+      }
+      Y_data[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulIntegerToFloat", 1, onnxruntime::kMSDomain);
+  if (block_size > 0) {
+    test.AddAttribute<int64_t>("block_size", block_size);
+  }
+  test.AddInput<uint8_t>("A", {M, K}, A_data);
+  test.AddInput<T>("B", {K, N}, B_data, is_matrix_b_constant);
+  test.AddInput<float>("a_scale", {1}, A_scale);
+  test.AddInput<float>("b_scale", B_scale_dims, B_scale);
+  test.AddInput<uint8_t>("a_zero_point", {1}, A_zero_point);
+  test.AddInput<T>("b_zero_point", B_scale_dims, B_zero_point);
+  test.AddInput<float>("bias", {N}, Bias);
+  test.AddOutput<float>("Y", {M, N}, Y_data);
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.SetOutputRelErr("Y", 1e-4f);
+  test.Run();
+}
+
+TEST(MatMulIntegerToFloat, PerColumnScales) {
+  TestMatMulIntegerToFloatPerColumnScales<int8_t>(4, 96, 64, 0, false /*is_matrix_b_constant*/);
+  TestMatMulIntegerToFloatPerColumnScales<int8_t>(4, 96, 64, 0, true /*is_matrix_b_constant*/);
+  TestMatMulIntegerToFloatPerColumnScales<uint8_t>(4, 96, 64, 0, true /*is_matrix_b_constant*/);
+}
+
+TEST(MatMulIntegerToFloat, BlockwiseScales) {
+  // K is not a multiple of the block size and N spans more than one column panel
+  TestMatMulIntegerToFloatPerColumnScales<int8_t>(70, 200, 100, 32, false /*is_matrix_b_constant*/);
+  TestMatMulIntegerToFloatPerColumnScales<int8_t>(70, 200, 100, 32, true /*is_matrix_b_constant*/);
+  TestMatMulIntegerToFloatPerColumnScales<uint8_t>(5, 40, 64, 16, true /*is_matrix_b_constant*/);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <random>
+
+namespace onnxruntime {
+namespace test {
+
+void TestMatMulNBits(const std::vector<int64_t>& a_dims, int64_t N, int64_t block_size, bool has_zero_point,
+                     bool has_bias) {
+  const int64_t K = a_dims.back();
+  const int64_t M = TensorShape(a_dims).SizeToDimension(a_dims.size() - 1);
+  const int64_t block_count_k = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size / 2;
+
+  std::default_random_engine generator(static_cast<unsigned>(M * N * K + block_size));
+  std::uniform_int_distribution<int> byte_distribution(0, 255);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+  std::vector<float> a(M * K);
+  for (auto& v : a) v = distribution(generator);
+  std::vector<uint8_t> b(N * block_count_k * blob_size);
+  for (auto& v : b) v = static_cast<uint8_t>(byte_distribution(generator));
+  std::vector<float> scales(N * block_count_k);
+  for (auto& v : scales) v = distribution(generator) * 0.1f;
+  std::vector<uint8_t> zero_points(N * ((block_count_k + 1) / 2));
+  for (auto& v : zero_points) v = static_cast<uint8_t>(byte_distribution(generator));
+  std::vector<float> bias(N);
+  for (auto& v : bias) v = distribution(generator);
+
+  std::vector<float> expected(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = has_bias ? bias[n] : 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        const int64_t block = k / block_size;
+        const uint8_t pair = b[(n * block_count_k + block) * blob_size + (k % block_size) / 2];
+        const int value = (k & 1) ? (pair >> 4) : (pair & 0x0F);
+        int zero_point = 8;
+        if (has_zero_point) {
+          const uint8_t zero_point_pair = zero_points[n * ((block_count_k + 1) / 2) + block / 2];
+          zero_point = (block & 1) ? (zero_point_pair >> 4) : (zero_point_pair & 0x0F);
+        }
+        sum += a[m * K + k] * (value - zero_point) * scales[n * block_count_k + block];
+      }
+      expected[m * N + n] = sum;
+    }
+  }
+
+  std::vector<int64_t> y_dims(a_dims);
+  y_dims.back() = N;
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("bits", 4);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddInput<float>("A", a_dims, a);
+  test.AddInput<uint8_t>("B", {N, block_count_k, blob_size}, b, true);
+  test.AddInput<float>("scales", {N * block_count_k}, scales, true);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {static_cast<int64_t>(zero_points.size())}, zero_points, true);
+  } else {
+    test.AddMissingOptionalInput<uint8_t>();
+  }
+  if (has_bias) {
+    test.AddInput<float>("bias", {N}, bias, true);
+  } else {
+    test.AddMissingOptionalInput<float>();
+  }
+  test.AddOutput<float>("Y", y_dims, expected);
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.SetOutputRelErr("Y", 1e-4f);
+  test.Run();
+}
+
+TEST(MatMulNBits, SingleRow) {
+  TestMatMulNBits({1, 64}, 32, 32, true, false);
+  TestMatMulNBits({1, 100}, 13, 16, false, true);
+  TestMatMulNBits({1, 1, 320}, 40, 64, true, true);
+}
+
+TEST(MatMulNBits, FewRows) {
+  TestMatMulNBits({3, 128}, 20, 32, true, true);
+  TestMatMulNBits({2, 2, 72}, 9, 16, false, false);
+}
+
+TEST(MatMulNBits, ManyRows) {
+  // dequantized panels of B on CPU, cuBLAS on CUDA
+  TestMatMulNBits({37, 96}, 50, 32, true, true);
+  TestMatMulNBits({4, 8, 300}, 24, 128, true, false);
+  TestMatMulNBits({20, 512}, 16, 256, false, true);
+}
+
+TEST(MatMulNBits, InvalidScales) {
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", 32);
+  test.AddAttribute<int64_t>("N", 2);
+  test.AddAttribute<int64_t>("block_size", 32);
+  test.AddInput<float>("A", {1, 32}, std::vector<float>(32, 1.0f));
+  test.AddInput<uint8_t>("B", {2, 1, 16}, std::vector<uint8_t>(32, 0x88));
+  test.AddInput<float>("scales", {1}, {1.0f});
+  test.AddOutput<float>("Y", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "MatMulNBits scales must hold N * ceil(K / block_size) values");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <algorithm>
+#include <limits>
 #include "core/util/math.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -87,7 +88,7 @@ class NhwcMaxPoolOpTester {
       std::vector<int64_t> d_output(kernel_rank, 0);
       std::vector<int64_t> d_kernel(kernel_rank, 0);
       do {
-        std::fill_n(Ydata, channels, static_cast<T>(0));
+        std::fill_n(Ydata, channels, std::numeric_limits<T>::lowest());
         do {
           int64_t input_offset = 0;
           bool is_padding = false;
@@ -200,6 +201,35 @@ TEST(NhwcMaxPoolContribOpTest, MaxPoolStrides) {
   test.Run();
 }
 
+TEST(NhwcMaxPoolContribOpTest, MaxPool2DFloat) {
+  for (int64_t channels = 1; channels < 20; channels++) {
+    NhwcMaxPoolOpTester<float> test;
+    test.GenerateRandomInput({2, 15, 19, channels});
+    test.SetKernelShape({3, 5});
+    test.SetPads({1, 1, 1, 1});
+    test.Run();
+  }
+}
+
+TEST(NhwcMaxPoolContribOpTest, MaxPool2DInt8) {
+  for (int64_t channels = 1; channels < 64; channels++) {
+    NhwcMaxPoolOpTester<int8_t> test;
+    test.GenerateRandomInput({1, 15, 19, channels});
+    test.SetKernelShape({3, 5});
+    test.SetPads({1, 1, 1, 1});
+    test.Run();
+  }
+}
+
+TEST(NhwcMaxPoolContribOpTest, MaxPoolLargeImage) {
+  // The output images span several batches of the indirection buffer.
+  NhwcMaxPoolOpTester<uint8_t> test;
+  test.GenerateRandomInput({3, 41, 37, 24});
+  test.SetKernelShape({3, 3});
+  test.SetPads({1, 1, 1, 1});
+  test.Run();
+}
+
 TEST(NhwcMaxPoolContribOpTest, MaxPoolDilations) {
   NhwcMaxPoolOpTester<uint8_t> test;
   test.GenerateRandomInput({4, 23, 19, 32});
@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+void RunOnCuda(OpTester& tester) {
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+// Computes the output of PackedAttention for the tokens of sequences with the given lengths.
+std::vector<float> ComputePackedAttention(const std::vector<float>& input, const std::vector<float>& weights,
+                                          const std::vector<float>& bias, const std::vector<int32_t>& lengths,
+                                          int hidden_size, int num_heads) {
+  const int head_size = hidden_size / num_heads;
+  const int token_count = static_cast<int>(input.size()) / hidden_size;
+
+  std::vector<double> qkv(static_cast<size_t>(token_count) * 3 * hidden_size);
+  for (int t = 0; t < token_count; t++) {
+    for (int j = 0; j < 3 * hidden_size; j++) {
+      double sum = bias[j];
+      for (int k = 0; k < hidden_size; k++) {
+        sum += static_cast<double>(input[t * hidden_size + k]) * weights[k * 3 * hidden_size + j];
+      }
+      qkv[static_cast<size_t>(t) * 3 * hidden_size + j] = sum;
+    }
+  }
+
+  std::vector<float> output(static_cast<size_t>(token_count) * hidden_size);
+  int start = 0;
+  for (int32_t length : lengths) {
+    for (int n = 0; n < num_heads; n++) {
+      for (int s = start; s < start + length; s++) {
+        std::vector<double> scores(length);
+        double max = -INFINITY;
+        for (int m = 0; m < length; m++) {
+          double score = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            score += qkv[static_cast<size_t>(s) * 3 * hidden_size + n * head_size + h] *
+                     qkv[static_cast<size_t>(start + m) * 3 * hidden_size + hidden_size + n * head_size + h];
+          }
+          scores[m] = score / std::sqrt(static_cast<double>(head_size));
+          max = std::max(max, scores[m]);
+        }
+
+        double sum = 0.0;
+        for (int m = 0; m < length; m++) {
+          scores[m] = std::exp(scores[m] - max);
+          sum += scores[m];
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          double value = 0.0;
+          for (int m = 0; m < length; m++) {
+            value += scores[m] * qkv[static_cast<size_t>(start + m) * 3 * hidden_size + 2 * hidden_size + n * head_size + h];
+          }
+          output[static_cast<size_t>(s) * hidden_size + n * head_size + h] = static_cast<float>(value / sum);
+        }
+      }
+    }
+    start += length;
+  }
+  return output;
+}
+
+void RunPackedAttentionTest(int head_size, bool use_float16) {
+  int min_cuda_architecture = use_float16 ? 530 : 0;
+  if (!HasCudaEnvironment(min_cuda_architecture)) {
+    return;
+  }
+
+  constexpr int batch_size = 3;
+  constexpr int sequence_length = 70;
+  constexpr int num_heads = 2;
+  const int hidden_size = num_heads * head_size;
+  const std::vector<int32_t> lengths = {70, 33, 0};
+  const int token_count = 103;
+
+  // Values are exact in float16.
+  std::vector<float> input(token_count * hidden_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<float>(static_cast<int>((i * 17) % 23) - 11) / 32.0f;
+  }
+  std::vector<float> weights(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weights.size(); i++) {
+    weights[i] = static_cast<float>(static_cast<int>((i * 7) % 13) - 6) / 64.0f;
+  }
+  std::vector<float> bias(3 * hidden_size);
+  for (size_t i = 0; i < bias.size(); i++) {
+    bias[i] = 0.0625f * static_cast<float>(i % 5);
+  }
+
+  // Tokens first, then the padding positions.
+  std::vector<int32_t> token_offset;
+  std::vector<int32_t> padding_offset;
+  std::vector<int32_t> cumulative_sequence_length = {0};
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      (s < lengths[b] ? token_offset : padding_offset).push_back(b * sequence_length + s);
+    }
+    cumulative_sequence_length.push_back(cumulative_sequence_length.back() + lengths[b]);
+  }
+  token_offset.insert(token_offset.end(), padding_offset.begin(), padding_offset.end());
+
+  const std::vector<float> output = ComputePackedAttention(input, weights, bias, lengths, hidden_size, num_heads);
+
+  OpTester tester("PackedAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+  if (use_float16) {
+    tester.AddInput<MLFloat16>("input", {token_count, hidden_size}, ToFloat16(input));
+    tester.AddInput<MLFloat16>("weight", {hidden_size, 3 * hidden_size}, ToFloat16(weights));
+    tester.AddInput<MLFloat16>("bias", {3 * hidden_size}, ToFloat16(bias));
+  } else {
+    tester.AddInput<float>("input", {token_count, hidden_size}, input);
+    tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weights);
+    tester.AddInput<float>("bias", {3 * hidden_size}, bias);
+  }
+  tester.AddInput<int32_t>("token_offset", {batch_size, sequence_length}, token_offset);
+  tester.AddInput<int32_t>("cumulative_sequence_length", {batch_size + 1}, cumulative_sequence_length);
+  if (use_float16) {
+    tester.AddOutput<MLFloat16>("output", {token_count, hidden_size}, ToFloat16(output));
+  } else {
+    tester.AddOutput<float>("output", {token_count, hidden_size}, output);
+  }
+  RunOnCuda(tester);
+}
+}  // namespace
+
+TEST(PackedAttentionTest, RemovePadding) {
+  if (!HasCudaEnvironment(0)) {
+    return;
+  }
+
+  // The count of the second sequence exceeds the sequence length, and the third one is empty.
+  OpTester tester("RemovePadding", 1, onnxruntime::kMSDomain);
+  tester.AddInput<float>("input", {3, 3, 2}, {1.f, 2.f, 3.f, 4.f, 0.f, 0.f,
+                                              5.f, 6.f, 7.f, 8.f, 9.f, 10.f,
+                                              0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+  tester.AddInput<int32_t>("sequence_token_count", {3}, {2, 4, 0});
+  tester.AddOutput<float>("output", {5, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f});
+  tester.AddOutput<int32_t>("token_offset", {3, 3}, {0, 1, 3, 4, 5, 2, 6, 7, 8});
+  tester.AddOutput<int32_t>("cumulative_sequence_length", {4}, {0, 2, 5, 5});
+  RunOnCuda(tester);
+}
+
+TEST(PackedAttentionTest, RestorePadding) {
+  if (!HasCudaEnvironment(530)) {
+    return;
+  }
+
+  OpTester tester("RestorePadding", 1, onnxruntime::kMSDomain);
+  tester.AddInput<MLFloat16>("input", {3, 3}, ToFloat16({1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f}));
+  tester.AddInput<int32_t>("token_offset", {2, 2}, {0, 2, 3, 1});
+  tester.AddOutput<MLFloat16>("output", {2, 2, 3}, ToFloat16({1.f, 2.f, 3.f, 0.f, 0.f, 0.f,
+                                                              4.f, 5.f, 6.f, 7.f, 8.f, 9.f}));
+  RunOnCuda(tester);
+}
+
+// Float32 runs the attention on padded tensors.
+TEST(PackedAttentionTest, PackedAttentionFloat) {
+  RunPackedAttentionTest(4, false);
+}
+
+// Float16 with head size 64 or 128 runs the fused attention kernel on the packed tokens on sm_70 and above.
+TEST(PackedAttentionTest, PackedAttentionFloat16HeadSize64) {
+  RunPackedAttentionTest(64, true);
+}
+
+TEST(PackedAttentionTest, PackedAttentionFloat16HeadSize128) {
+  RunPackedAttentionTest(128, true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -192,6 +192,93 @@ void RunQLinearAveragePoolNchwU8(
   run_test(true /* only_x_not_initializer */, true /* x_y_same_zero_point */);
 }
 
+// Transposes a (N x C x D1 x D2 ... Dn) tensor to (N x D1 x D2 ... Dn x C).
+static std::vector<uint8_t> TransposeNchwToNhwc(const std::vector<uint8_t>& data, const std::vector<int64_t>& dims) {
+  const int64_t batch = dims[0];
+  const int64_t channel = dims[1];
+  const int64_t image_size = std::accumulate(dims.begin() + 2, dims.end(), 1LL, std::multiplies<int64_t>());
+  std::vector<uint8_t> transposed(data.size());
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int64_t c = 0; c < channel; ++c) {
+      for (int64_t i = 0; i < image_size; ++i) {
+        transposed[(b * image_size + i) * channel + c] = data[(b * channel + c) * image_size + i];
+      }
+    }
+  }
+  return transposed;
+}
+
+static std::vector<int64_t> NchwDimsToNhwc(const std::vector<int64_t>& dims) {
+  std::vector<int64_t> nhwc_dims{dims[0]};
+  nhwc_dims.insert(nhwc_dims.end(), dims.begin() + 2, dims.end());
+  nhwc_dims.push_back(dims[1]);
+  return nhwc_dims;
+}
+
+// The dims are given in NCHW order, the operator runs on the transposed NHWC tensors.
+void RunQLinearAveragePoolNhwcU8(
+    const std::vector<int64_t> x_dims,
+    const std::vector<int64_t> y_dims,
+    const std::vector<int64_t> kernel_shape,
+    const std::vector<int64_t> strides,
+    const std::vector<int64_t> pads,
+    const int64_t count_include_pad = 0) {
+  float x_scale = 1.0f / 255.0f;
+  uint8_t x_zero_point = 128;
+  RandomValueGenerator random{};
+  std::vector<float> x_data_fp32 = random.Uniform<float>(x_dims, -0.5f, 0.5f);
+  std::vector<uint8_t> x_data(x_data_fp32.size());
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    x_data[i] = quantize_u8(x_data_fp32[i], x_scale, x_zero_point);
+  }
+
+  float y_scale = 1.0f / 255.0f;
+  uint8_t y_zero_point = 100;
+  int64_t y_size = std::accumulate(y_dims.begin(), y_dims.end(), 1LL, std::multiplies<int64_t>());
+  std::vector<uint8_t> y_data(y_size);
+  CalculateAvgPoolNchwU8(
+      x_data.data(), x_dims, x_scale, x_zero_point,
+      y_data.data(), y_dims, y_scale, y_zero_point,
+      kernel_shape, strides, pads, count_include_pad);
+
+  const std::vector<int64_t> y_nhwc_dims = NchwDimsToNhwc(y_dims);
+  const std::vector<uint8_t> y_nhwc_data = TransposeNchwToNhwc(y_data, y_dims);
+
+  OpTester test("QLinearAveragePool", 1, onnxruntime::kMSDomain);
+
+  test.AddAttribute("auto_pad", "");
+  test.AddAttribute("strides", strides);
+  test.AddAttribute("pads", pads);
+  test.AddAttribute("kernel_shape", kernel_shape);
+  test.AddAttribute("count_include_pad", count_include_pad);
+  test.AddAttribute("channels_last", static_cast<int64_t>(1));
+
+  test.AddInput<uint8_t>("X", NchwDimsToNhwc(x_dims), TransposeNchwToNhwc(x_data, x_dims));
+  test.AddInput<float>("x_scale", {}, {x_scale});
+  test.AddInput<uint8_t>("x_zero_point", {}, {x_zero_point});
+  test.AddInput<float>("y_scale", {}, {y_scale});
+  test.AddInput<uint8_t>("y_zero_point", {}, {y_zero_point});
+  test.AddOutput<uint8_t>("Y", y_nhwc_dims, y_nhwc_data);
+
+  auto q8checker = [&](const std::vector<OrtValue>& fetches, const std::string& provider_type) {
+    const Tensor& output_tensor = fetches[0].Get<Tensor>();
+    ORT_ENFORCE(TensorShape(y_nhwc_dims) == output_tensor.Shape(),
+                "Expected output shape [" + TensorShape(y_nhwc_dims).ToString() +
+                    "] did not match run output shape [" + output_tensor.Shape().ToString() + "] for Y @" +
+                    provider_type);
+    auto* output = output_tensor.Data<uint8_t>();
+    auto size = static_cast<int>(output_tensor.Shape().Size());
+    for (int i = 0; i < size; ++i) {
+      int diff = abs(y_nhwc_data[i] - output[i]);
+      EXPECT_LE(diff, 1) << "i:" << i << " expected:" << (int)y_nhwc_data[i] << ", got:" << (int)output[i]
+                         << ", provider_type: " << provider_type;
+    }
+  };
+  test.SetCustomOutputVerifier(q8checker);
+
+  test.Run();
+}
+
 TEST(QLinearPoolTest, AveragePool1D_ExcludePadPixel) {
   RunQLinearAveragePoolNchwU8(
       {1, 1, 5},  // x shape
@@ -252,5 +339,45 @@ TEST(QLinearPoolTest, AveragePool3D_IncludePadPixel) {
       1);                  // count_include_pad
 }
 
+TEST(QLinearPoolTest, AveragePool1D_Nhwc_ExcludePadPixel) {
+  RunQLinearAveragePoolNhwcU8(
+      {1, 19, 5},  // x shape
+      {1, 19, 6},  // expected y shape
+      {3},         // kernel shape
+      {1},         // strides
+      {1, 2},      // pads
+      0);          // count_include_pad
+}
+
+TEST(QLinearPoolTest, AveragePool2D_Nhwc_ExcludePadPixel) {
+  RunQLinearAveragePoolNhwcU8(
+      {2, 19, 5, 7},  // x shape
+      {2, 19, 6, 4},  // expected y shape
+      {3, 4},         // kernel shape
+      {1, 2},         // strides
+      {1, 3, 2, 1},   // pads
+      0);             // count_include_pad
+}
+
+TEST(QLinearPoolTest, AveragePool2D_Nhwc_IncludePadPixel) {
+  RunQLinearAveragePoolNhwcU8(
+      {2, 19, 5, 7},  // x shape
+      {2, 19, 6, 4},  // expected y shape
+      {3, 4},         // kernel shape
+      {1, 2},         // strides
+      {1, 3, 2, 1},   // pads
+      1);             // count_include_pad
+}
+
+TEST(QLinearPoolTest, AveragePool3D_Nhwc_IncludePadPixel) {
+  RunQLinearAveragePoolNhwcU8(
+      {1, 8, 5, 7, 9},     // x shape
+      {1, 8, 6, 4, 3},     // expected y shape
+      {3, 4, 5},           // kernel shape
+      {1, 2, 3},           // strides
+      {1, 3, 2, 2, 1, 2},  // pads
+      1);                  // count_include_pad
+}
+
 }  // namespace test
 }  // namespace onnxruntime
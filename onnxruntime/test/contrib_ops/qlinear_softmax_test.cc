@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <cfenv>
+
+namespace onnxruntime {
+namespace test {
+
+TEST(QLinearSoftmaxTest, UInt8_LastAxis) {
+  OpTester test("QLinearSoftmax", 1, onnxruntime::kMSDomain);
+  float X_scale = 0.5f;
+  uint8_t X_zero_point = 128;
+  float Y_scale = 1.0f / 256.0f;
+
+  std::vector<int64_t> dims = {2, 4};
+  test.AddInput<uint8_t>("X", dims, {100, 104, 108, 110, 30, 31, 200, 29});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddInput<uint8_t>("X_zero_point", {}, {X_zero_point});
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddMissingOptionalInput<uint8_t>();  // optional "Y_zero_point" using default value here
+  // 1.0 saturates to 255
+  test.AddOutput<uint8_t>("Y", dims, {1, 9, 66, 180, 0, 0, 255, 0});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
+TEST(QLinearSoftmaxTest, Int8_InnerAxis) {
+  OpTester test("QLinearSoftmax", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", 1);
+  float X_scale = 0.25f;
+  float Y_scale = 1.0f / 256.0f;
+  int8_t Y_zero_point = -128;
+
+  std::vector<int64_t> dims = {2, 3, 2};
+  test.AddInput<int8_t>("X", dims, {-10, 5, 0, -3, 4, 20, 1, 1, -50, 2, 3, 0});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddMissingOptionalInput<int8_t>();  // optional "X_zero_point" using default value here
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddInput<int8_t>("Y_zero_point", {}, {Y_zero_point});
+  test.AddOutput<int8_t>("Y", dims, {-122, -122, -61, -127, 55, 121, -31, -44, -128, -21, 31, -63});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
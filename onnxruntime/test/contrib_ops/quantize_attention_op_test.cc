@@ -86,7 +86,8 @@ void RunQAttention(const std::vector<float>& input_data,         // input:
                    int number_of_heads,
                    bool is_unidirectional = false,
                    bool use_float16 = false,
-                   int input_hidden_size = 0) {
+                   int input_hidden_size = 0,
+                   bool quantize_attention = false) {
   input_hidden_size = (input_hidden_size == 0) ? hidden_size : input_hidden_size;
 
   OpTester tester("QAttention", 1, onnxruntime::kMSDomain);
@@ -94,6 +95,9 @@ void RunQAttention(const std::vector<float>& input_data,         // input:
   if (is_unidirectional) {
     tester.AddAttribute<int64_t>("unidirectional", 1);
   }
+  if (quantize_attention) {
+    tester.AddAttribute<int64_t>("quantize_attention", 1);
+  }
 
   std::vector<int64_t> input_dims = {batch_size, sequence_length, input_hidden_size};
   std::vector<int64_t> weights_dims = {input_hidden_size, 3 * hidden_size};
@@ -122,6 +126,10 @@ void RunQAttention(const std::vector<float>& input_data,         // input:
     tester.AddInput<float>("input_scale", {1}, {input_scale});
     tester.AddInput<float>("weight_scale", {1}, {weight_scale});
     tester.AddOutput<float>("output", output_dims, output_data);
+    if (quantize_attention) {
+      // Q, K, V and the attention probs are quantized to 8 bits.
+      tester.SetOutputAbsErr("output", 0.1f);
+    }
   }
 
   if (mask_index_data.size() > 0) {
@@ -345,6 +353,41 @@ TEST(QAttentionTest, QAttentionBatch2) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+TEST(QAttentionTest, QAttentionBatch2_QuantizeAttention) {
+  int batch_size = 2;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f,
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f};
+
+  std::vector<float> weight_data = {
+      0.1f, -0.2f, 0.3f, 1.0f, 1.1f, 0.3f, 0.5f, 0.2f, 0.3f, -0.6f, 1.5f, 2.0f,
+      0.5f, 0.1f, 0.4f, 1.6f, 1.0f, 2.0f, 0.4f, 0.8f, 0.9f, 0.1f, -1.3f, 0.7f,
+      0.3f, 0.2f, 4.0f, 2.2f, 1.6f, 1.1f, 0.7f, 0.2f, 0.4f, 1.0f, 1.2f, 0.5f,
+      0.2f, 0.1f, 0.4f, 1.6f, 2.4f, 3.3f, 2.1f, 4.2f, 8.4f, 0.0f, 2.1f, 3.2f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  std::vector<int32_t> mask_index_data = {2L, 2L};
+
+  std::vector<float> output_data = {
+      3.1495983600616455f, 0.10843668878078461f, 4.25f, 5.6499996185302734f,
+      3.9696791172027588f, 0.073143675923347473f, 4.2499995231628418f, 5.6499991416931152f,
+      3.1495983600616455f, 0.10843668878078461f, 4.25f, 5.6499996185302734f,
+      3.9696791172027588f, 0.073143675923347473f, 4.2499995231628418f, 5.6499991416931152f};
+
+  QuantizeParameters<uint8_t, uint8_t> qp{0.1f, 0.1f, 128, 128};
+  RunQAttention<uint8_t, uint8_t, EP::CPU>(
+      input_data, weight_data, bias_data, mask_index_data, output_data, qp,
+      batch_size, sequence_length, hidden_size, number_of_heads, false, false, 0, true);
+}
+
 TEST(QAttentionTest, QAttentionMaskPartialSequence) {
   int batch_size = 1;
   int sequence_length = 2;
@@ -3,6 +3,8 @@
 
 #ifdef BUILD_MS_EXPERIMENTAL_OPS
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -69,6 +71,52 @@ TEST(MLSignalOpTest, DFTFloat) {
   TestRadix2DFTFloat(true);
 }
 
+// Reference DFT of each row of a [batch, length] real signal, computed in double precision.
+static std::vector<float> ReferenceDFT(const std::vector<float>& input, int64_t batch, int64_t length,
+                                       int64_t output_size) {
+  const double pi = 3.14159265358979323846;
+  std::vector<float> output;
+  for (int64_t b = 0; b < batch; b++) {
+    for (int64_t k = 0; k < output_size; k++) {
+      double real = 0, imag = 0;
+      for (int64_t n = 0; n < length; n++) {
+        const double angle = -2 * pi * static_cast<double>((k * n) % length) / static_cast<double>(length);
+        real += input[b * length + n] * std::cos(angle);
+        imag += input[b * length + n] * std::sin(angle);
+      }
+      output.push_back(static_cast<float>(real));
+      output.push_back(static_cast<float>(imag));
+    }
+  }
+  return output;
+}
+
+static void TestMixedRadixDFTFloat(int64_t length, bool is_onesided) {
+  OpTester test("DFT", 1, onnxruntime::kMSExperimentalDomain);
+
+  const int64_t batch = 3;
+  std::vector<float> input(batch * length);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = std::sin(0.37f * i) + 0.25f * std::cos(1.3f * i);
+  }
+  const int64_t output_size = is_onesided ? (length >> 1) + 1 : length;
+
+  test.AddInput<float>("input", {batch, length}, input);
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(is_onesided));
+  test.AddOutput<float>("output", {batch, output_size, 2}, ReferenceDFT(input, batch, length, output_size));
+  test.SetOutputAbsErr("output", 1e-3f);
+  test.Run();
+}
+
+TEST(MLSignalOpTest, DFTFloatMixedRadixAndBluestein) {
+  // 400 = 4 * 4 * 5 * 5 and 360 = 4 * 2 * 3 * 3 * 5 are mixed radix, 401 is prime and uses Bluestein, and the
+  // half length transform of the real signal of length 14 uses Bluestein
+  for (int64_t length : {400, 360, 401, 14}) {
+    TestMixedRadixDFTFloat(length, false);
+    TestMixedRadixDFTFloat(length, true);
+  }
+}
+
 TEST(MLSignalOpTest, IDFTFloat) {
   OpTester test("IDFT", 1, onnxruntime::kMSExperimentalDomain);
   
@@ -120,6 +168,41 @@ TEST(MLSignalOpTest, STFTFloat) {
   test.Run();
 }
 
+TEST(MLSignalOpTest, STFTFloatWindowLength400) {
+  OpTester test("STFT", 1, onnxruntime::kMSExperimentalDomain);
+
+  const int64_t batch = 2, signal_length = 1000, frame_length = 400, frame_step = 160;
+  const int64_t n_dfts = (signal_length - frame_length) / frame_step + 1;
+  const int64_t output_size = (frame_length >> 1) + 1;
+
+  std::vector<float> signal(batch * signal_length);
+  for (size_t i = 0; i < signal.size(); i++) {
+    signal[i] = std::sin(0.05f * i) + 0.5f * std::sin(0.9f * i);
+  }
+  std::vector<float> window(frame_length);
+  for (int64_t i = 0; i < frame_length; i++) {
+    window[i] = 0.5f - 0.5f * std::cos(6.28318530718f * i / frame_length);
+  }
+
+  std::vector<float> frames;
+  for (int64_t b = 0; b < batch; b++) {
+    for (int64_t f = 0; f < n_dfts; f++) {
+      for (int64_t n = 0; n < frame_length; n++) {
+        frames.push_back(signal[b * signal_length + f * frame_step + n] * window[n]);
+      }
+    }
+  }
+
+  test.AddInput<float>("signal", {batch, signal_length}, signal);
+  test.AddInput<float>("window", {frame_length}, window);
+  test.AddInput<int64_t>("frame_length", {}, {frame_length});
+  test.AddInput<int64_t>("frame_step", {}, {frame_step});
+  test.AddOutput<float>("output", {batch, n_dfts, output_size, 2},
+                        ReferenceDFT(frames, batch * n_dfts, frame_length, output_size));
+  test.SetOutputAbsErr("output", 1e-3f);
+  test.Run();
+}
+
 TEST(MLSignalOpTest, HannWindowFloat) {
   OpTester test("HannWindow", 1, onnxruntime::kMSExperimentalDomain);
 
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -54,8 +56,7 @@ static void RunTest(
 
     test.AddOutput<float>("output", output_dims, output_data);
     test.Run();
-  } else if (HasCudaEnvironment(530 /*min_cuda_architecture*/) ||
-             rocm_ep != nullptr) {
+  } else {
     OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
     test.AddInput<MLFloat16>("input", input_dims, ToFloat16(input_data));
     test.AddInput<MLFloat16>("skip", skip_dims, ToFloat16(skip_data));
@@ -72,12 +73,14 @@ static void RunTest(
 
     test.AddOutput<MLFloat16>("output", output_dims, ToFloat16(output_data));
 
+    // The CPU kernel computes float16 inputs in float.
     std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
     if (rocm_ep != nullptr) {
         execution_providers.push_back(DefaultRocmExecutionProvider());
-    } else {
+    } else if (HasCudaEnvironment(530 /*min_cuda_architecture*/)) {
         execution_providers.push_back(DefaultCudaExecutionProvider());
     }
+    execution_providers.push_back(DefaultCpuExecutionProvider());
 
     test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
   }
@@ -275,5 +278,59 @@ TEST(SkipLayerNormTest, SkipLayerNormBatch2_Bias) {
           hidden_size);
 }
 
+// a hidden size large enough for the single pass vectorized CUDA kernel
+TEST(SkipLayerNormTest, SkipLayerNormBatch2_Bias_Hidden768) {
+  int batch_size = 2;
+  int sequence_length = 3;
+  int hidden_size = 768;
+  const int rows = batch_size * sequence_length;
+
+  std::vector<float> input_data(rows * hidden_size);
+  std::vector<float> skip_data(rows * hidden_size);
+  std::vector<float> gamma_data(hidden_size);
+  std::vector<float> beta_data(hidden_size);
+  std::vector<float> bias_data(hidden_size);
+  for (int i = 0; i < rows * hidden_size; i++) {
+    input_data[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+    skip_data[i] = static_cast<float>(i % 7) * 0.2f - 0.5f;
+  }
+  for (int i = 0; i < hidden_size; i++) {
+    gamma_data[i] = static_cast<float>(i % 5) * 0.25f + 0.5f;
+    beta_data[i] = static_cast<float>(i % 3) * 0.1f - 0.1f;
+    bias_data[i] = static_cast<float>(i % 11) * 0.05f - 0.25f;
+  }
+
+  std::vector<float> output_data(rows * hidden_size);
+  for (int r = 0; r < rows; r++) {
+    std::vector<double> x(hidden_size);
+    double mean = 0.0;
+    for (int i = 0; i < hidden_size; i++) {
+      x[i] = static_cast<double>(input_data[r * hidden_size + i]) + skip_data[r * hidden_size + i] + bias_data[i];
+      mean += x[i];
+    }
+    mean /= hidden_size;
+    double variance = 0.0;
+    for (int i = 0; i < hidden_size; i++) {
+      variance += (x[i] - mean) * (x[i] - mean);
+    }
+    variance /= hidden_size;
+    for (int i = 0; i < hidden_size; i++) {
+      output_data[r * hidden_size + i] =
+          static_cast<float>((x[i] - mean) / std::sqrt(variance + epsilon_) * gamma_data[i] + beta_data[i]);
+    }
+  }
+
+  RunTest(input_data,
+          skip_data,
+          gamma_data,
+          beta_data,
+          bias_data,
+          output_data,
+          epsilon_,
+          batch_size,
+          sequence_length,
+          hidden_size);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
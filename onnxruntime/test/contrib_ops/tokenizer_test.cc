@@ -627,6 +627,29 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharsNoMarkersSeparatorsOverlapin
   }
 }
 
+TEST(ContribOpTest, TokenizerWithSeparators_LaterSeparatorMatchesFirstNC) {
+  // The separators are applied in their order even when
+  // a later one occurs before an earlier one in the text
+  std::vector<std::string> separators = {
+      u8"bc",
+      u8"ab"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 1);
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{u8"abc", u8"xabcab", u8"ab", u8"cab"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(1));
+  std::vector<std::string> output{u8"a", u8"xa", padval, u8"c"};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   // Separators and strings with a mix of latin, Spanish, Cyrillic and Chinese
   // characters and with start/end text markers
@@ -73,5 +73,39 @@ TEST(InvokerTest, Inplace) {
   }
 }
 
+TEST(InvokerTest, ReuseKernel) {
+  std::unique_ptr<IExecutionProvider> cpu_execution_provider = onnxruntime::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  const std::string logger_id{"InvokerTest"};
+  auto logging_manager = onnxruntime::make_unique<logging::LoggingManager>(
+      std::unique_ptr<logging::ISink>{new logging::CLogSink{}},
+      logging::Severity::kVERBOSE, false,
+      logging::LoggingManager::InstanceType::Default,
+      &logger_id);
+  std::unique_ptr<Environment> env;
+  Environment::Create(std::move(logging_manager), env);
+  ORTInvoker kernel_invoker(std::move(cpu_execution_provider), env->GetLoggingManager()->DefaultLogger());
+
+  // the second call re-uses the kernel and frame of the first one, with other values and shapes
+  std::vector<std::vector<int64_t>> dims = {{3, 2}, {2}};
+  std::vector<std::vector<float>> values = {{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, {7.0f, 8.0f}};
+  for (size_t n = 0; n < dims.size(); ++n) {
+    OrtValue A, B;
+    CreateMLValue<float>(kernel_invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault), dims[n], values[n],
+                         &A);
+    CreateMLValue<float>(kernel_invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault), dims[n], values[n],
+                         &B);
+    std::vector<OrtValue> result(1);
+    auto status = kernel_invoker.Invoke("Mul", {A, B}, result, nullptr);
+    ASSERT_TRUE(status.IsOK());
+    const Tensor& C = result.back().Get<Tensor>();
+    EXPECT_EQ(C.Shape().GetDims(), dims[n]);
+
+    auto* c_data = C.Data<float>();
+    for (size_t i = 0; i < values[n].size(); ++i) {
+      EXPECT_EQ(c_data[i], values[n][i] * values[n][i]);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -50,6 +50,10 @@ class DummyArena : public IArenaAllocator {
     ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
   }
 
+  void GetStats(AllocatorStats* /*stats*/) override {
+    ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DummyArena);
 
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -131,15 +132,32 @@ typedef std::unordered_map<const onnxruntime::NodeArg*, TensorShapeProto*> Shape
 
 class SequentialPlannerTestContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerTestContext(ShapeMap* shape_map) : shape_map_(shape_map) {}
+  SequentialPlannerTestContext(ShapeMap* shape_map, bool enable_parallel_execution = false)
+      : shape_map_(shape_map), enable_parallel_execution_(enable_parallel_execution) {}
 
   TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     auto iter = shape_map_->find(&arg);
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  bool IsParallelExecutionEnabled() const override { return enable_parallel_execution_; }
+
  private:
   ShapeMap* shape_map_;
+  bool enable_parallel_execution_;
+};
+
+// A CPU execution provider that reports a configurable list of compute queues.
+class MultiQueueCPUExecutionProvider : public CPUExecutionProvider {
+ public:
+  explicit MultiQueueCPUExecutionProvider(const CPUExecutionProviderInfo& info) : CPUExecutionProvider(info) {}
+
+  std::vector<int> GetComputeQueueIds() const override { return queue_ids_; }
+
+  void SetComputeQueueIds(const std::vector<int>& queue_ids) { queue_ids_ = queue_ids; }
+
+ private:
+  std::vector<int> queue_ids_{0};
 };
 
 class PlannerTest : public ::testing::Test {
@@ -163,6 +181,7 @@ class PlannerTest : public ::testing::Test {
   std::vector<std::unique_ptr<OpKernelInfo>> op_kernel_infos_;
   std::vector<std::pair<onnxruntime::Node*, KernelDef&>> kernel_bindings_;
   ExecutionProviders execution_providers_;
+  MultiQueueCPUExecutionProvider* cpu_execution_provider_;
   std::unique_ptr<concurrency::ThreadPool> tp_;
   DataTransferManager dtm_;
   profiling::Profiler profiler_;
@@ -182,7 +201,8 @@ class PlannerTest : public ::testing::Test {
     external_outputs_kernel_ =
         KernelDefBuilder().SetName("Tanh").Provider(kCpuExecutionProvider).SinceVersion(1, 10).ExternalOutputs().Build();
     CPUExecutionProviderInfo epi;
-    auto execution_provider = std::make_unique<CPUExecutionProvider>(epi);
+    auto execution_provider = std::make_unique<MultiQueueCPUExecutionProvider>(epi);
+    cpu_execution_provider_ = execution_provider.get();
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
 
     state_.reset(new SessionState(graph_, execution_providers_, false, tp_.get(), nullptr, dtm_,
@@ -239,13 +259,16 @@ class PlannerTest : public ::testing::Test {
 
   void SetShape(std::string& name, TensorShapeProto* shape) { shape_map_[Arg(name)] = shape; }
 
+  void SetComputeQueueIds(const std::vector<int>& queue_ids) { cpu_execution_provider_->SetComputeQueueIds(queue_ids); }
+
   void SetShape(std::initializer_list<std::pair<std::string&, TensorShapeProto*>> shapes) {
     for (auto& pair : shapes) {
       SetShape(pair.first, pair.second);
     }
   }
 
-  void CreatePlan(const std::vector<const NodeArg*>& outer_scope_node_args = {}) {
+  void CreatePlan(const std::vector<const NodeArg*>& outer_scope_node_args = {},
+                  bool enable_parallel_execution = false) {
     EXPECT_EQ(graph_.Resolve(), Status::OK());
 
     std::shared_ptr<KernelRegistry> reg = std::make_shared<KernelRegistry>();
@@ -267,7 +290,7 @@ class PlannerTest : public ::testing::Test {
     status = state_->FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, {}, nullptr, remove_initializers);
 
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
-    SequentialPlannerTestContext test_context(&shape_map_);
+    SequentialPlannerTestContext test_context(&shape_map_, enable_parallel_execution);
 
     status = SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph_), outer_scope_node_args, execution_providers_,
                                            kernel_create_info_map, state_->GetOrtValueNameIdxMap(), test_context,
@@ -283,6 +306,12 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  bool HasFence(const std::string& name) {
+    int id;
+    index(name, id);
+    return plan_->allocation_plan[id].create_fence_if_async;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -380,6 +409,69 @@ TEST_F(PlannerTest, InputOutputTest) {
   CheckFreed(2, {});
 }
 
+// ParallelExecutionDependenciesTest: Check the static node dependency graph used by the ParallelExecutor.
+TEST_F(PlannerTest, ParallelExecutionDependenciesTest) {
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6");
+
+  // graph structure: n0 fans out to n1 and n2; n3 is independent.
+  auto* n0 = AddNormalNode(X1, X2);
+  auto* n1 = AddNormalNode(X2, X3);
+  auto* n2 = AddNormalNode(X2, X4);
+  auto* n3 = AddNormalNode(X5, X6);
+
+  CreatePlan({}, true);
+
+  const auto& plan = GetPlan();
+  ASSERT_EQ(plan.node_dependency_counts.size(), GetGraph().MaxNodeIndex());
+  EXPECT_EQ(plan.node_dependency_counts[n0->Index()], 0);
+  EXPECT_EQ(plan.node_dependency_counts[n1->Index()], 1);
+  EXPECT_EQ(plan.node_dependency_counts[n2->Index()], 1);
+  EXPECT_EQ(plan.node_dependency_counts[n3->Index()], 0);
+
+  std::vector<NodeIndex> expected_downstream{n1->Index(), n2->Index()};
+  std::sort(expected_downstream.begin(), expected_downstream.end());
+  EXPECT_EQ(plan.node_downstream_nodes[n0->Index()], expected_downstream);
+  EXPECT_TRUE(plan.node_downstream_nodes[n1->Index()].empty());
+  EXPECT_TRUE(plan.node_downstream_nodes[n3->Index()].empty());
+
+  std::unordered_set<NodeIndex> roots(plan.parallel_root_nodes.cbegin(), plan.parallel_root_nodes.cend());
+  EXPECT_EQ(roots, (std::unordered_set<NodeIndex>{n0->Index(), n3->Index()}));
+}
+
+// MultipleComputeQueuesTest: Check that independent branches are assigned to different compute queues of a
+// provider while chains of dependent nodes stay on one queue, and that the values of the provider are fenced.
+TEST_F(PlannerTest, MultipleComputeQueuesTest) {
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure: n0 fans out to n1 and n2; n3 consumes the output of n1.
+  auto* n0 = AddNormalNode(X1, X2);
+  auto* n1 = AddNormalNode(X2, X3);
+  auto* n2 = AddNormalNode(X2, X4);
+  auto* n3 = AddNormalNode(X3, X5);
+
+  SetComputeQueueIds({0, 3});
+  CreatePlan();
+
+  const auto& plan = GetPlan();
+  ASSERT_EQ(plan.node_exec_queue_ids.size(), GetGraph().MaxNodeIndex());
+  const int q0 = plan.NodeExecQueueId(n0->Index(), 0);
+  const int q1 = plan.NodeExecQueueId(n1->Index(), 0);
+  const int q2 = plan.NodeExecQueueId(n2->Index(), 0);
+  const int q3 = plan.NodeExecQueueId(n3->Index(), 0);
+
+  // one branch continues the queue of n0 and the other one starts on the second queue
+  EXPECT_NE(q1, q2);
+  EXPECT_TRUE(q1 == q0 || q2 == q0);
+  EXPECT_EQ(q3, q1);
+  for (int queue_id : {q0, q1, q2, q3}) {
+    EXPECT_TRUE(queue_id == 0 || queue_id == 3) << "Unexpected queue " << queue_id;
+  }
+
+  for (const auto& name : {X2, X3, X4, X5}) {
+    EXPECT_TRUE(HasFence(name)) << name << " should have a fence";
+  }
+}
+
 // InPlaceTest: Check that we reuse when Inplace allows us to.
 
 TEST_F(PlannerTest, InPlaceTest) {
@@ -3,6 +3,7 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/allocator.h"
+#include "core/framework/huge_page_allocator.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -101,5 +102,52 @@ TEST(AllocatorTest, TestOverflowChecks) {
   EXPECT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size - (kAllocAlignment / num_elements), &size));
   EXPECT_FALSE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size, &size));
 }
+
+#ifdef __linux__
+TEST(AllocatorTest, HugePageAllocatorTest) {
+  constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+  // the hugetlbfs pool is usually empty, in which case transparent huge pages are used
+  for (auto mode : {HugePageMode::kTransparent, HugePageMode::kHugeTlb2MB}) {
+    HugePageAllocator allocator(std::make_unique<CPUAllocator>(), mode);
+    ASSERT_STREQ(allocator.Info().name, CPU);
+
+    // large allocations are mapped on huge page boundaries
+    const size_t size = 3 * huge_page_size + 1;
+    auto* large = static_cast<char*>(allocator.Alloc(size));
+    ASSERT_NE(large, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % huge_page_size, 0u);
+    memset(large, 1, size);
+    EXPECT_EQ(large[size - 1], 1);
+
+    // small allocations are made by the wrapped allocator
+    auto* small = static_cast<char*>(allocator.Alloc(1024));
+    ASSERT_NE(small, nullptr);
+    memset(small, 2, 1024);
+
+    allocator.Free(large);
+    allocator.Free(small);
+  }
+}
+
+TEST(AllocatorTest, HugePageArenaTest) {
+  OrtArenaCfg arena_cfg;
+  arena_cfg.huge_pages = static_cast<int>(HugePageMode::kTransparent);
+  AllocatorCreationInfo info{[](int) { return std::make_unique<CPUAllocator>(); }, 0, true, arena_cfg};
+  auto arena = CreateAllocator(info);
+  ASSERT_NE(arena, nullptr);
+
+  auto* bytes = static_cast<char*>(arena->Alloc(4 * 1024 * 1024));
+  ASSERT_NE(bytes, nullptr);
+  memset(bytes, 1, 4 * 1024 * 1024);
+  arena->Free(bytes);
+
+  // out of range values are rejected
+  arena_cfg.huge_pages = 4;
+  EXPECT_EQ(CreateAllocator(AllocatorCreationInfo{[](int) { return std::make_unique<CPUAllocator>(); },
+                                                  0, true, arena_cfg}),
+            nullptr);
+}
+#endif
 }  // namespace test
 }  // namespace onnxruntime
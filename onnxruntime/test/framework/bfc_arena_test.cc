@@ -5,6 +5,8 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -285,6 +287,109 @@ TEST(BFCArenaTest, TestReserve) {
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
 
+TEST(BFCArenaTest, TestIdleRegionRelease) {
+  // Release regions as soon as they are free, but keep 1MB around.
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             1024, 128 * 1024 * 1024, 1024, 0, 1024 * 1024);
+
+  void* small_ptr = a.Alloc(1024 * 1024);
+  void* large_ptr = a.Alloc(16 * 1024 * 1024);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, 17 * 1024 * 1024);
+
+  // Freeing the large buffer releases its region.
+  a.Free(large_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024 * 1024);
+
+  // The last region is kept because of the watermark.
+  a.Free(small_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024 * 1024);
+}
+
+TEST(BFCArenaTest, TestThreadCache) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_REGROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_IDLE_RELEASE_MS,
+             BFCArena::DEFAULT_IDLE_RELEASE_WATERMARK_BYTES, BFCArena::DEFAULT_DECOMMIT_CHUNK_BYTES, 16 * 1024);
+
+  // A freed chunk stays in use in the cache and serves the next allocation of its bin.
+  void* p = a.Alloc(1000);
+  a.Free(p);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  EXPECT_EQ(a.Alloc(900), p);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_allocs, 1);
+
+  // A chunk freed by another thread goes back to the arena.
+  std::thread([&a, p]() { a.Free(p); }).join();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+
+  // The cache is flushed once its free chunks exceed the limit.
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 20; ++i) {
+    ptrs.push_back(a.Alloc(1024));
+  }
+  for (void* ptr : ptrs) {
+    a.Free(ptr);
+  }
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 3 * 1024);
+
+  // Shrink flushes all the caches.
+  ASSERT_TRUE(a.Shrink().IsOK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, TestNoIdleReleaseByDefault) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+
+  a.Free(a.Alloc(16 * 1024 * 1024));
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_shrinkages, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 16 * 1024 * 1024);
+}
+
+#ifdef __linux__
+TEST(BFCArenaTest, TestDecommitFreeChunks) {
+  // The first region is never released with kNextPowerOfTwo, but its large free chunks can be decommitted.
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             64 * 1024 * 1024, 128 * 1024 * 1024, 1024, 0, 0, 1024 * 1024);
+
+  auto* used = static_cast<char*>(a.Alloc(4 * 1024));
+  auto* buffer = static_cast<char*>(a.Alloc(8 * 1024 * 1024));
+  memset(buffer, 1, 8 * 1024 * 1024);
+  used[0] = 1;
+
+  a.Free(buffer);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_shrinkages, 0);
+  EXPECT_GT(stats.num_decommits, 0);
+
+  // Decommitted memory can be allocated again and the chunk in use is untouched.
+  buffer = static_cast<char*>(a.Alloc(8 * 1024 * 1024));
+  memset(buffer, 2, 8 * 1024 * 1024);
+  EXPECT_EQ(buffer[8 * 1024 * 1024 - 1], 2);
+  EXPECT_EQ(used[0], 1);
+  a.Free(buffer);
+  a.Free(used);
+}
+#endif
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/framework/allocatormgr.h"
+#include "core/framework/tensor.h"
+#include "test/framework/test_utils.h"
+#include "test/util/include/asserts.h"
+#include "gtest/gtest.h"
+#include "cuda_runtime.h"
+#include "core/providers/cuda/cuda_allocator.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/gpu_data_transfer.h"
+
+namespace onnxruntime {
+namespace test {
+
+// copies between pageable host memory and the GPU are staged through the pinned buffers of the data transfer
+TEST(DataTransferTest, CUDAPageableCopyRoundTrip) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+
+  cudaStream_t stream = nullptr;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
+  auto cuda_allocator = std::make_shared<CUDAAllocator>(cuda_device_id, CUDA);
+  const auto& cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+
+  for (bool do_copy_in_default_stream : {true, false}) {
+    GPUDataTransfer data_transfer(stream, do_copy_in_default_stream);
+
+    // more copies than staging buffers, with growing sizes so the buffers are reused and grown
+    for (int64_t size : {1, 1000, 17, 300000, 4096, 1 << 20, 5, 77777}) {
+      TensorShape shape({size});
+      Tensor src(DataTypeImpl::GetType<float>(), shape, cpu_allocator);
+      Tensor gpu(DataTypeImpl::GetType<float>(), shape, cuda_allocator);
+      Tensor dst(DataTypeImpl::GetType<float>(), shape, cpu_allocator);
+
+      float* src_data = src.MutableData<float>();
+      for (int64_t i = 0; i < size; ++i) {
+        src_data[i] = static_cast<float>(i % 1009) + 0.5f;
+      }
+
+      ASSERT_STATUS_OK(data_transfer.CopyTensor(src, gpu, 0));
+      // the source buffer can be reused as soon as the copy returns
+      std::fill(src_data, src_data + size, -1.0f);
+      ASSERT_STATUS_OK(data_transfer.CopyTensor(gpu, dst, 0));
+
+      const float* dst_data = dst.Data<float>();
+      for (int64_t i = 0; i < size; ++i) {
+        ASSERT_EQ(dst_data[i], static_cast<float>(i % 1009) + 0.5f) << "size " << size << " @" << i;
+      }
+    }
+  }
+
+  CUDA_CALL_THROW(cudaStreamDestroy(stream));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
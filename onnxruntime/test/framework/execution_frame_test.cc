@@ -7,6 +7,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -213,6 +214,65 @@ TEST_F(ExecutionFrameTest, FeedInDataTest) {
   ASSERT_EQ(p_tensor_arg_0->MutableData<float>(), value.GetMutable<Tensor>()->MutableData<float>());
 }
 
+TEST_F(ExecutionFrameTest, ResetTest) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           std::unordered_map<std::string, int>{{"", 10}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  onnxruntime::Node& node = graph.AddNode("node1", "Clip", "Clip operator", ArgMap{&input_def}, ArgMap{&output_def});
+  node.SetExecutionProviderType(kCpuExecutionProvider);
+  graph.Resolve();
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  execution_providers.Add(xp_typ, std::move(cpu_xp));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState state(graph, execution_providers, true, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map = state.GetOrtValueNameIdxMap();
+  int x_idx = -1, y_idx = -1;
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X", x_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("Y", y_idx).IsOK());
+
+  auto cpu_allocator = execution_providers.Get(xp_typ)->GetAllocator(0, OrtMemTypeDefault);
+
+  OrtValue value1, value2;
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{3, 2}, std::vector<float>(6, 1.0f), &value1);
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 2}, std::vector<float>(4, 2.0f), &value2);
+
+  vector<OrtValue> outputs;
+  ExecutionFrame frame({x_idx}, {value1}, {y_idx}, outputs, {}, state);
+  ASSERT_TRUE(frame.CanReset({y_idx}));
+  ASSERT_FALSE(frame.CanReset({x_idx}));
+
+  // create an output value that the reset has to release
+  OrtValue* p_output = nullptr;
+  TensorShape output_shape({3, 2});
+  ASSERT_STATUS_OK(frame.GetOrCreateNodeOutputMLValue(0, 1, &output_shape, p_output, node, size_t(0)));
+  ASSERT_TRUE(p_output->IsAllocated());
+
+  frame.Reset({x_idx}, {value2}, outputs, {});
+
+  const OrtValue* p_input = frame.GetNodeInputOrOutputMLValue(0);
+  ASSERT_TRUE(p_input);
+  ASSERT_EQ(p_input->Get<Tensor>().Shape(), TensorShape({2, 2}));
+  ASSERT_EQ(p_input->Get<Tensor>().Data<float>(), value2.Get<Tensor>().Data<float>());
+  ASSERT_FALSE(frame.GetNodeInputOrOutputMLValue(1)->IsAllocated());
+}
+
 TEST_F(ExecutionFrameTest, MemPatternTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
   auto xp_type = cpu_xp->Type();
@@ -386,6 +446,73 @@ TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
 }
 #endif
 
+TEST_F(ExecutionFrameTest, SmallTensorAllocationTest) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), intermediate_def("T", &tensor_float),
+      output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Relu", "Relu operator", ArgMap{&input_def}, ArgMap{&intermediate_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  graph.AddNode("node2", "Relu", "Relu operator", ArgMap{&intermediate_def}, ArgMap{&output_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_typ, std::move(cpu_xp)));
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState state(graph, execution_providers, false, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSmallTensorMaxBytes, "64"));
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, so));
+  ASSERT_EQ(state.GetSmallTensorMaxBytes(), 64u);
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map = state.GetOrtValueNameIdxMap();
+  int t_idx = -1, y_idx = -1;
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T", t_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("Y", y_idx));
+
+  vector<OrtValue> outputs;
+  ExecutionFrame frame({}, {}, {y_idx}, outputs, {}, state);
+  const auto& memory_info = execution_providers.Get(xp_typ)->GetAllocator(0, OrtMemTypeDefault)->Info();
+
+  auto allocate = [&](int ort_value_idx, int64_t size) {
+    OrtValue value;
+    EXPECT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(value, ort_value_idx, DataTypeImpl::GetType<float>(),
+                                                              memory_info, TensorShape({size})));
+    return value;
+  };
+
+  // small intermediate values are placed one after the other in a block of the frame
+  OrtValue small1 = allocate(t_idx, 4);
+  OrtValue small2 = allocate(t_idx, 16);
+  ASSERT_FALSE(small1.Get<Tensor>().OwnsBuffer());
+  ASSERT_FALSE(small2.Get<Tensor>().OwnsBuffer());
+  EXPECT_EQ(static_cast<const char*>(small2.Get<Tensor>().DataRaw()) -
+                static_cast<const char*>(small1.Get<Tensor>().DataRaw()),
+            static_cast<ptrdiff_t>(kAllocAlignment));
+
+  // larger values and graph outputs are allocated as usual
+  EXPECT_TRUE(allocate(t_idx, 17).Get<Tensor>().OwnsBuffer());
+  EXPECT_TRUE(allocate(y_idx, 4).Get<Tensor>().OwnsBuffer());
+
+  // the blocks are re-used from the start after a reset
+  frame.Reset({}, {}, outputs, {});
+  OrtValue small3 = allocate(t_idx, 4);
+  EXPECT_EQ(small3.Get<Tensor>().DataRaw(), small1.Get<Tensor>().DataRaw());
+}
+
 TEST(ExecutionFrameTestWithoutSessionState, BadModelInvalidDimParamUsage) {
   // load model with 2 Scan ops that both incorrectly use shapes of { 'None', 'None' } for their outputs.
   // as 'None' is not a special value it's treated as a variable name, leading to a runtime error when we
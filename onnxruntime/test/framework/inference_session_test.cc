@@ -7,11 +7,14 @@
 #include <cfloat>
 #include <functional>
 #include <iterator>
+#include <map>
 #include <thread>
+#include <unordered_set>
 #include <fstream>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include "core/common/denormal.h"
+#include "core/common/hardware_counters.h"
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/profiler.h"
@@ -28,6 +31,7 @@
 #include "core/graph/op.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/platform/env.h"
+#include "core/platform/path_lib.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #ifdef USE_CUDA
@@ -513,6 +517,72 @@ static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   return true;
 }
 
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  const PathString cache_dir = ORT_TSTR("optimized_model_cache_test");
+  if (Env::Default().FolderExists(cache_dir)) {
+    ASSERT_STATUS_OK(Env::Default().DeleteFolder(cache_dir));
+  }
+
+  auto get_cached_models = [&cache_dir]() {
+    std::vector<PathString> models;
+    LoopDir(cache_dir, [&](const ORTCHAR_T* filename, OrtFileType f_type) -> bool {
+      if (f_type == OrtFileType::TYPE_REG) {
+        models.push_back(ConcatPathComponent<ORTCHAR_T>(cache_dir, filename));
+      }
+      return true;
+    });
+    return models;
+  };
+
+  SessionOptions so;
+  so.session_logid = "OptimizedModelCache";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigOptimizedModelCacheDir,
+                                                    "optimized_model_cache_test"));
+
+  // returns true if the session loaded the optimized model from the cache
+  auto run_session = [&so]() {
+    auto capturing_sink = new CapturingSink();
+    auto logging_manager = std::make_unique<logging::LoggingManager>(
+        std::unique_ptr<ISink>(capturing_sink), logging::Severity::kINFO, false,
+        LoggingManager::InstanceType::Temporal);
+    std::unique_ptr<Environment> env;
+    EXPECT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+    InferenceSession session_object{so, *env};
+    EXPECT_STATUS_OK(session_object.Load(MODEL_URI));
+    EXPECT_STATUS_OK(session_object.Initialize());
+    RunModel(session_object, RunOptions());
+
+    const auto& msgs = capturing_sink->Messages();
+    return std::any_of(msgs.cbegin(), msgs.cend(), [](const std::string& msg) {
+      return msg.find("from the cache.") != std::string::npos;
+    });
+  };
+
+  // the first session saves the optimized model, the second one loads it
+  ASSERT_FALSE(run_session());
+  auto cached_models = get_cached_models();
+  ASSERT_EQ(cached_models.size(), 1u);
+  ASSERT_TRUE(run_session());
+
+  // an invalid model in the cache is ignored and replaced
+  {
+    std::ofstream cached_model(cached_models[0], std::ios::binary | std::ios::trunc);
+    cached_model << "not a model";
+  }
+  ASSERT_FALSE(run_session());
+  ASSERT_TRUE(run_session());
+
+  // a different configuration is cached separately
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDisablePrepacking, "1"));
+  ASSERT_FALSE(run_session());
+  ASSERT_EQ(get_cached_models().size(), 2u);
+
+  ASSERT_STATUS_OK(Env::Default().DeleteFolder(cache_dir));
+}
+#endif
+
 TEST(InferenceSessionTests, ModelMetadata) {
   SessionOptions so;
 
@@ -650,17 +720,223 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   std::vector<std::string> tags = {"pid", "dur", "ts", "ph", "X", "name", "args"};
 
   bool has_kernel_info = false;
+  bool has_kernel_node_name = false;
   for (size_t i = 1; i < size - 1; ++i) {
     for (auto& s : tags) {
       ASSERT_TRUE(lines[i].find(s) != string::npos);
       has_kernel_info = has_kernel_info || (lines[i].find("Kernel") != string::npos);
     }
+    // CUDA kernels are attributed to the node that launched them
+    has_kernel_node_name = has_kernel_node_name || (lines[i].find("\"cat\" : \"Kernel\"") != string::npos &&
+                                                    lines[i].find("node_name") != string::npos);
   }
 #ifdef USE_CUDA
   ASSERT_TRUE(has_kernel_info);
+  ASSERT_TRUE(has_kernel_node_name);
+#else
+  ORT_UNUSED_PARAMETER(has_kernel_node_name);
 #endif
 }
 
+TEST(InferenceSessionTests, CheckRunProfilerWithHardwareCounters) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_hardware_counters_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileHardwareCounters, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_TRUE(session_object.GetProfiling().HardwareCountersEnabled());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_kernel_event = false;
+  bool has_hardware_counters = false;
+  while (std::getline(profile, line)) {
+    if (line.find("_kernel_time") != string::npos) {
+      has_kernel_event = true;
+      has_hardware_counters = has_hardware_counters || (line.find("\"hardware_counters\" : {") != string::npos);
+    }
+  }
+  ASSERT_TRUE(has_kernel_event);
+
+  // the counters are left out when the platform or the kernel settings don't allow them
+  if (profiling::HardwareCounters().IsAvailable()) {
+    ASSERT_TRUE(has_hardware_counters);
+  } else {
+    ASSERT_FALSE(has_hardware_counters);
+  }
+}
+
+TEST(InferenceSessionTests, CheckSessionCreationProfiler) {
+  SessionOptions so;
+
+  so.session_logid = "CheckSessionCreationProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_session_creation_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileSessionCreation, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_TRUE(session_object.GetProfiling().SessionCreationProfilingEnabled());
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  std::unordered_set<std::string> phases;
+  while (std::getline(profile, line)) {
+    if (line.find("\"peak_rss\"") == string::npos) {
+      continue;
+    }
+    const auto name_start = line.find("\"name\" :\"");
+    ASSERT_NE(name_start, string::npos);
+    const auto start = name_start + 9;
+    phases.insert(line.substr(start, line.find('"', start) - start));
+  }
+
+  for (const char* phase : {"model_parse", "graph_resolve", "graph_partitioning", "graph_final_resolve",
+                            "kernel_lookup", "execution_planning", "initializer_copy", "kernel_creation"}) {
+    EXPECT_EQ(phases.count(phase), 1u) << phase;
+  }
+  EXPECT_TRUE(std::any_of(phases.cbegin(), phases.cend(), [](const std::string& phase) {
+    return phase.find("graph_transformer_") == 0;
+  }));
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerWithMemory) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_memory_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileMemory, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_TRUE(session_object.GetProfiling().MemoryProfilingEnabled());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_node_memory = false;
+  bool has_peak = false;
+  while (std::getline(profile, line)) {
+    if (line.find("_memory\"") != string::npos) {
+      // the output of the node is allocated at run time and is still live
+      has_node_memory = line.find("\"dynamic_bytes\":0,") == string::npos &&
+                        line.find("\"live_bytes\":0}") == string::npos;
+    }
+    if (line.find("memory_peak") != string::npos) {
+      // the graph output is live at the peak, and produced by the only node
+      has_peak = line.find("\"Y\":{") != string::npos && line.find("\"producer\":\"\"") == string::npos;
+    }
+  }
+  ASSERT_TRUE(has_node_memory);
+  ASSERT_TRUE(has_peak);
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerWithThreadPoolTasks) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_thread_pool_tasks_test");
+  so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileThreadPoolTasks, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_TRUE(session_object.GetProfiling().ThreadPoolTaskTracingEnabled());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  std::vector<std::string> lines;
+  while (std::getline(profile, line)) {
+    lines.push_back(line);
+  }
+  ASSERT_GT(lines.size(), 1u);
+  ASSERT_EQ(lines.back(), "]");
+
+  // every flow has its start and its end, and the events of the tasks have their worker
+  size_t flow_starts = 0;
+  size_t flow_ends = 0;
+  for (const auto& event : lines) {
+    flow_starts += event.find("\"ph\" : \"s\"") != string::npos ? 1 : 0;
+    flow_ends += event.find("\"ph\" : \"f\"") != string::npos ? 1 : 0;
+    if (event.find("_loop_block\"") != string::npos || event.find("_work_item\"") != string::npos) {
+      ASSERT_NE(event.find("\"worker\""), string::npos);
+    }
+  }
+  ASSERT_EQ(flow_starts, flow_ends);
+}
+
+TEST(InferenceSessionTests, Calibration) {
+  SessionOptions so;
+  so.session_logid = "Calibration";
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_FALSE(session_object.StartCalibration({}, 12).IsOK());
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_FALSE(session_object.StartCalibration({}, 0).IsOK());
+  ASSERT_STATUS_OK(session_object.StartCalibration({}, 12));
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  // the graph input X = {1, .., 6} and the output Y = X * X, in bins of width 1 and 6
+  std::unordered_map<std::string, TensorCalibrationCollector::TensorStats> stats;
+  ASSERT_STATUS_OK(session_object.GetCalibrationStats(stats));
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats["X"].min, 1.f);
+  EXPECT_EQ(stats["X"].max, 6.f);
+  EXPECT_EQ(stats["X"].threshold, 6.f);
+  EXPECT_EQ(stats["X"].histogram, std::vector<int64_t>({0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 4}));
+  EXPECT_EQ(stats["Y"].min, 1.f);
+  EXPECT_EQ(stats["Y"].max, 36.f);
+  EXPECT_EQ(stats["Y"].threshold, 36.f);
+  EXPECT_EQ(stats["Y"].histogram, std::vector<int64_t>({0, 0, 0, 0, 0, 0, 4, 2, 2, 0, 2, 2}));
+
+  // only the named tensors
+  ASSERT_STATUS_OK(session_object.StartCalibration({"Y"}, 12));
+  RunModel(session_object, run_options);
+  ASSERT_STATUS_OK(session_object.GetCalibrationStats(stats));
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats.count("Y"), 1u);
+
+  session_object.EndCalibration();
+  ASSERT_FALSE(session_object.GetCalibrationStats(stats).IsOK());
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
   SessionOptions so;
 
@@ -1150,6 +1426,220 @@ TEST(InferenceSessionTests, TestOptionalInputs) {
   }
 }
 
+// Creates a model that adds the chunk "x" to the running sum "state_in", and returns the sum as both "y" and
+// the next state "state_out".
+static void CreateRunningSumModel(std::string& model_data) {
+  onnxruntime::Model model("running_sum", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& state_in = graph.GetOrCreateNodeArg("state_in", &float_tensor);
+  auto& state_out = graph.GetOrCreateNodeArg("state_out", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("y", &float_tensor);
+  graph.AddNode("add", "Add", "add the chunk to the running sum", {&x, &state_in}, {&state_out});
+  graph.AddNode("identity", "Identity", "return the running sum", {&state_out}, {&y});
+  graph.SetOutputs({&y, &state_out});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  model.ToProto().SerializeToString(&model_data);
+}
+
+TEST(InferenceSessionTests, StreamingState) {
+  std::string model_data;
+  CreateRunningSumModel(model_data);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.StreamingState";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigStreamingState, "state_in:state_out"));
+  InferenceSession session_object{so, GetEnvironment()};
+  std::stringstream sstr(model_data);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto run_chunk = [&](const RunOptions& run_options, const std::vector<float>& chunk,
+                       const std::vector<float>* state_in, const std::vector<float>& expected) {
+    NameMLValMap feeds;
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 2}, chunk, &x);
+    feeds.insert(std::make_pair("x", x));
+    if (state_in != nullptr) {
+      OrtValue state;
+      CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 2}, *state_in, &state);
+      feeds.insert(std::make_pair("state_in", state));
+    }
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y"}, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    auto y = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(std::vector<float>(y.cbegin(), y.cend()), expected);
+  };
+
+  RunOptions run_options;
+  // the state starts from zeros, then accumulates the chunks
+  run_chunk(run_options, {1.f, 2.f}, nullptr, {1.f, 2.f});
+  run_chunk(run_options, {3.f, 4.f}, nullptr, {4.f, 6.f});
+  run_chunk(run_options, {5.f, 6.f}, nullptr, {9.f, 12.f});
+
+  // feeding the state explicitly overrides the carried state
+  std::vector<float> state_in{100.f, 200.f};
+  run_chunk(run_options, {1.f, 1.f}, &state_in, {101.f, 201.f});
+  run_chunk(run_options, {1.f, 1.f}, nullptr, {102.f, 202.f});
+
+  // a reset starts over from zeros
+  RunOptions reset_run_options;
+  ASSERT_STATUS_OK(reset_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigResetStreamingState, "1"));
+  run_chunk(reset_run_options, {7.f, 8.f}, nullptr, {7.f, 8.f});
+  run_chunk(run_options, {1.f, 1.f}, nullptr, {8.f, 9.f});
+}
+
+TEST(InferenceSessionTests, StreamingStateInvalidConfig) {
+  std::string model_data;
+  CreateRunningSumModel(model_data);
+
+  auto initialize = [&](const std::string& streaming_state) {
+    SessionOptions so;
+    ORT_THROW_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigStreamingState,
+                                                        streaming_state.c_str()));
+    InferenceSession session_object{so, GetEnvironment()};
+    std::stringstream sstr(model_data);
+    ORT_THROW_IF_ERROR(session_object.Load(sstr));
+    return session_object.Initialize();
+  };
+
+  auto status = initialize("state_in");
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("must be of the form"));
+
+  status = initialize("state:state_out");
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("is not an input of the model"));
+
+  status = initialize("state_in:state");
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("is not an output of the model"));
+}
+
+TEST(InferenceSessionTests, ResultCache) {
+  std::string model_data;
+  CreateRunningSumModel(model_data);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ResultCache";
+  // the 2 feeds and the output of a Run take 24 bytes, so a single Run is cached
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigResultCacheMaxBytes, "40"));
+  InferenceSession session_object{so, GetEnvironment()};
+  std::stringstream sstr(model_data);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto run = [&](const std::vector<float>& x_data, const std::vector<float>& expected) {
+    NameMLValMap feeds;
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 2}, x_data, &x);
+    feeds.insert(std::make_pair("x", x));
+    OrtValue state;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 2}, {10.f, 20.f},
+                         &state);
+    feeds.insert(std::make_pair("state_in", state));
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions(), feeds, {"y"}, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    auto y = fetches[0].GetMutable<Tensor>()->MutableDataAsSpan<float>();
+    ASSERT_EQ(std::vector<float>(y.cbegin(), y.cend()), expected);
+    // the cached outputs are copied, modifying the fetches doesn't change them
+    std::fill(y.begin(), y.end(), 0.f);
+  };
+
+  run({1.f, 2.f}, {11.f, 22.f});
+  run({1.f, 2.f}, {11.f, 22.f});
+  // evicts the first Run
+  run({3.f, 4.f}, {13.f, 24.f});
+  run({1.f, 2.f}, {11.f, 22.f});
+
+  std::map<std::string, double> metrics;
+  session_object.GetMetrics([&metrics](const std::string& name, double value) { metrics[name] = value; });
+  EXPECT_EQ(metrics["onnxruntime_session_runs_total"], 4.);
+  EXPECT_EQ(metrics["onnxruntime_session_result_cache_hits_total"], 1.);
+  EXPECT_EQ(metrics["onnxruntime_session_result_cache_misses_total"], 3.);
+  EXPECT_EQ(metrics["onnxruntime_session_result_cache_evictions_total"], 2.);
+  EXPECT_EQ(metrics["onnxruntime_session_result_cache_entries"], 1.);
+  EXPECT_EQ(metrics["onnxruntime_session_result_cache_bytes"], 24.);
+}
+
+TEST(InferenceSessionTests, MicroBatching) {
+  onnxruntime::Model model("micro_batching", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("y", &float_tensor);
+  auto& z = graph.GetOrCreateNodeArg("z", &float_tensor);
+  graph.AddNode("add", "Add", "double x", {&x, &x}, {&y});
+  graph.AddNode("relu", "Relu", "clip x", {&x}, {&z});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MicroBatching";
+  InferenceSession session_object{so, GetEnvironment()};
+  std::stringstream sstr(model_data);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // a batch of 5 rows in micro-batches of 2, the last one having a single row
+  const std::vector<float> x_data{1.f, -1.f, 2.f, -2.f, 3.f, -3.f, 4.f, -4.f, 5.f, -5.f};
+  NameMLValMap feeds;
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {5, 2}, x_data, &x_value);
+  feeds.insert(std::make_pair("x", x_value));
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigMicroBatchSize, "2"));
+
+  const std::vector<float> expected_y{2.f, -2.f, 4.f, -4.f, 6.f, -6.f, 8.f, -8.f, 10.f, -10.f};
+  const std::vector<float> expected_z{1.f, 0.f, 2.f, 0.f, 3.f, 0.f, 4.f, 0.f, 5.f, 0.f};
+  auto check = [](const OrtValue& value, const std::vector<float>& expected) {
+    ASSERT_EQ(value.Get<Tensor>().Shape(), TensorShape({5, 2}));
+    auto data = value.Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(std::vector<float>(data.cbegin(), data.cend()), expected);
+  };
+
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y", "z"}, &fetches));
+  ASSERT_EQ(fetches.size(), 2u);
+  check(fetches[0], expected_y);
+  check(fetches[1], expected_z);
+
+  // a pre-allocated output is written in place
+  OrtValue z_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {5, 2},
+                       std::vector<float>(10), &z_value);
+  const void* z_buffer = z_value.Get<Tensor>().DataRaw();
+  fetches = {OrtValue(), z_value};
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"y", "z"}, &fetches));
+  check(fetches[0], expected_y);
+  check(fetches[1], expected_z);
+  EXPECT_EQ(fetches[1].Get<Tensor>().DataRaw(), z_buffer);
+
+  RunOptions invalid_run_options;
+  ASSERT_STATUS_OK(invalid_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigMicroBatchSize, "0"));
+  auto status = session_object.Run(invalid_run_options, feeds, {"y"}, &fetches);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Invalid value"));
+}
+
 TEST(ExecutionProviderTest, FunctionTest) {
   onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
   auto& graph = model.MainGraph();
@@ -1669,6 +2159,102 @@ TEST(InferenceSessionTests, Test2LayerNestedSubgraph) {
   VerifyOutputs(fetches, expected_dims, expected_values);
 }
 
+// If branch that applies op_type to the outer scope value 'x' and itself
+static ONNX_NAMESPACE::GraphProto CreateIfBranch(const std::string& op_type) {
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  onnxruntime::Model model("if_branch_" + op_type, false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  graph.AddOuterScopeNodeArg("x");
+  auto& output = graph.GetOrCreateNodeArg(op_type + "_output", &float_tensor);
+
+  std::vector<onnxruntime::NodeArg*> inputs = {&x, &x};
+  std::vector<onnxruntime::NodeArg*> outputs = {&output};
+  graph.AddNode(op_type + "_0", op_type, "node " + op_type, inputs, outputs);
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  return graph.ToGraphProto();
+}
+
+TEST(InferenceSessionTests, LazySubgraphInitialization) {
+  onnxruntime::Model model("lazy_subgraphs", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  ONNX_NAMESPACE::TypeProto bool_tensor;
+  bool_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
+  bool_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_tensor);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("y", &float_tensor);
+  // 'x' is only consumed by the branches
+  graph.SetInputs({&cond, &x});
+  {
+    std::vector<onnxruntime::NodeArg*> inputs = {&cond};
+    std::vector<onnxruntime::NodeArg*> outputs = {&y};
+    auto& if_node = graph.AddNode("if_0", "If", "If node", inputs, outputs);
+    if_node.AddAttribute("then_branch", CreateIfBranch("Add"));
+    if_node.AddAttribute("else_branch", CreateIfBranch("Mul"));
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.LazySubgraphInitialization";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazySubgraphInitialization, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model.ToProto()));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const SessionState& session_state = session_object.GetSessionState();
+  const SessionState* then_session_state = nullptr;
+  const SessionState* else_session_state = nullptr;
+  for (const auto& node : session_state.GetGraphViewer().Nodes()) {
+    if (node.Name() == "if_0") {
+      then_session_state = session_state.GetSubgraphSessionState(node.Index(), "then_branch");
+      else_session_state = session_state.GetSubgraphSessionState(node.Index(), "else_branch");
+    }
+  }
+  ASSERT_NE(then_session_state, nullptr);
+  ASSERT_NE(else_session_state, nullptr);
+
+  // the kernel of the only node in each branch is created when the If node is first executed
+  EXPECT_EQ(then_session_state->GetKernel(0), nullptr);
+  EXPECT_EQ(else_session_state->GetKernel(0), nullptr);
+
+  auto run = [&session_object](bool condition, const std::vector<float>& expected_values) {
+    OrtValue ml_value_cond;
+    CreateMLValue<bool>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1}, {condition},
+                        &ml_value_cond);
+    OrtValue ml_value_x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2}, {2.f, 3.f},
+                         &ml_value_x);
+    NameMLValMap feeds{{"cond", ml_value_cond}, {"x", ml_value_x}};
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"y"}, &fetches));
+    VerifyOutputs(fetches, {2}, expected_values);
+  };
+
+  run(true, {4.f, 6.f});
+  EXPECT_NE(then_session_state->GetKernel(0), nullptr);
+  EXPECT_EQ(else_session_state->GetKernel(0), nullptr);
+
+  // warm up the other branch ahead of the Run that executes it
+  ASSERT_STATUS_OK(session_object.InitializeSubgraphs({"if_0"}));
+  EXPECT_NE(else_session_state->GetKernel(0), nullptr);
+  run(false, {4.f, 9.f});
+
+  EXPECT_FALSE(session_object.InitializeSubgraphs({"no_such_node"}).IsOK());
+}
+
 TEST(InferenceSessionTests, TestTruncatedSequence) {
   // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
   // Manually updated to have IR version of 4.
@@ -2095,6 +2681,145 @@ TEST(InferenceSessionTests, TestArenaShrinkageAfterRun) {
   ASSERT_EQ(allocated_memory_before_run, allocated_memory_after_run);
 }
 
+TEST(InferenceSessionTests, TestCudaGraphCaptureAndReplay) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestCudaGraphCaptureAndReplay";
+  InferenceSession session_object{so, GetEnvironment()};
+
+  CUDAExecutionProviderInfo epi;
+  epi.device_id = 0;
+  epi.enable_cuda_graph = true;
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(std::make_unique<CUDAExecutionProvider>(epi)));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtMemoryInfo mem_info(CUDA, OrtArenaAllocator);
+  auto cuda_alloc = session_object.GetAllocator(mem_info);
+
+  // the captured graph refers to these buffers so they must stay the same across Runs
+  std::vector<int64_t> dims = {3, 2};
+  OrtValue input;
+  OrtValue output;
+  AllocateMLValue<float>(cuda_alloc, dims, &input);
+  AllocateMLValue<float>(cuda_alloc, dims, &output);
+  float* input_data = input.GetMutable<Tensor>()->MutableData<float>();
+  const float* output_data = output.Get<Tensor>().Data<float>();
+
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+  ASSERT_STATUS_OK(io_binding->BindInput("X", input));
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y", output));
+
+  auto run_and_verify = [&](const std::vector<float>& x, const std::vector<float>& expected_y) {
+    ASSERT_EQ(cudaSuccess, cudaMemcpy(input_data, x.data(), x.size() * sizeof(float), cudaMemcpyHostToDevice));
+    ASSERT_STATUS_OK(session_object.Run(RunOptions(), *io_binding));
+    std::vector<float> y(expected_y.size());
+    ASSERT_EQ(cudaSuccess, cudaMemcpy(y.data(), output_data, y.size() * sizeof(float), cudaMemcpyDeviceToHost));
+    ASSERT_EQ(expected_y, y);
+  };
+
+  // 1st Run warms up, 2nd Run captures the graph and 3rd Run replays it.
+  run_and_verify({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+  run_and_verify({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+  // the replay must read the new content of the bound input buffer
+  run_and_verify({2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f}, {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f});
+
+  // outputs that are not pre-allocated cannot be used with a captured graph
+  unique_ptr<IOBinding> io_binding_no_output;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding_no_output));
+  ASSERT_STATUS_OK(io_binding_no_output->BindInput("X", input));
+  ASSERT_STATUS_OK(io_binding_no_output->BindOutput("Y", OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0)));
+  ASSERT_FALSE(session_object.Run(RunOptions(), *io_binding_no_output).IsOK());
+}
+
+TEST(InferenceSessionTests, TestCudaMultipleComputeStreams) {
+  onnxruntime::Model model("multi_stream_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  // two independent branches joined by the last node: Y = X * X + (X + X)
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& a = graph.GetOrCreateNodeArg("A", &float_tensor);
+  auto& b = graph.GetOrCreateNodeArg("B", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("mul", "Mul", "branch 1", {&x, &x}, {&a});
+  graph.AddNode("add", "Add", "branch 2", {&x, &x}, {&b});
+  graph.AddNode("sum", "Add", "join", {&a, &b}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_file_name = "cuda_multi_stream_test_graph.onnx";
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestCudaMultipleComputeStreams";
+  InferenceSession session_object{so, GetEnvironment()};
+
+  CUDAExecutionProviderInfo epi;
+  epi.device_id = 0;
+  epi.num_compute_streams = 2;
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(std::make_unique<CUDAExecutionProvider>(epi)));
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  CPUExecutionProviderInfo cpu_epi;
+  auto cpu_execution_provider = std::make_unique<::onnxruntime::CPUExecutionProvider>(cpu_epi);
+
+  std::vector<int64_t> dims = {3, 2};
+  OrtValue ml_value_x;
+  CreateMLValue<float>(cpu_execution_provider->GetAllocator(0, OrtMemTypeDefault), dims,
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &ml_value_x);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+
+  std::vector<std::string> output_names{"Y"};
+  std::vector<float> expected_values_y = {3.0f, 8.0f, 15.0f, 24.0f, 35.0f, 48.0f};
+
+  // run more than once so the streams and their contexts are reused
+  for (int i = 0; i < 3; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions(), feeds, output_names, &fetches));
+    VerifyOutputs(fetches, dims, expected_values_y);
+  }
+}
+
+#if CUDART_VERSION >= 11020
+TEST(InferenceSessionTests, TestCudaMemPool) {
+  int device_id = 0;
+  int pools_supported = 0;
+  if (cudaDeviceGetAttribute(&pools_supported, cudaDevAttrMemoryPoolsSupported, device_id) != cudaSuccess ||
+      pools_supported == 0) {
+    GTEST_SKIP() << "The CUDA device does not support stream ordered memory pools.";
+  }
+
+  // two sessions allocate from the same pool
+  std::vector<std::unique_ptr<InferenceSession>> sessions;
+  for (int i = 0; i < 2; ++i) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.TestCudaMemPool";
+    sessions.push_back(std::make_unique<InferenceSession>(so, GetEnvironment()));
+
+    CUDAExecutionProviderInfo epi;
+    epi.device_id = device_id;
+    epi.use_cuda_mem_pool = true;
+    epi.cuda_mem_pool_release_threshold = 1 << 20;
+    ASSERT_STATUS_OK(sessions.back()->RegisterExecutionProvider(std::make_unique<CUDAExecutionProvider>(epi)));
+    ASSERT_STATUS_OK(sessions.back()->Load(MODEL_URI));
+    ASSERT_STATUS_OK(sessions.back()->Initialize());
+  }
+
+  RunOptions run_options;
+  for (int i = 0; i < 3; ++i) {
+    for (auto& session : sessions) {
+      RunModel(*session, run_options);
+    }
+  }
+}
+#endif
+
 #endif
 
 // The model being tested here triggers a case where the allocation planner (AP) tries to reuse a tensor of type
@@ -2411,6 +3136,40 @@ TEST(InferenceSessionTests, CheckIfPerSessionThreadPoolsAreBeingUsed) {
   RunModel(session_object, run_options);
 }
 
+// Test 1b: per session tp with the unified thread pool: the parallel executor should schedule nodes on the intra op tp
+TEST(InferenceSessionTests, CheckIfUnifiedThreadPoolIsBeingUsed) {
+  SessionOptions so;
+  so.use_per_session_threads = true;
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseUnifiedThreadPool, "1"));
+
+  so.session_logid = "CheckIfUnifiedThreadPoolIsBeingUsed";
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+
+  std::unique_ptr<Environment> env;
+  auto st = Environment::Create(std::move(logging_manager), env);
+  ASSERT_TRUE(st.IsOK());
+
+  InferenceSessionTestGlobalThreadPools session_object{so, *env.get()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto intra_tp_from_session = session_object.GetIntraOpThreadPoolToUse();
+  auto inter_tp_from_session = session_object.GetInterOpThreadPoolToUse();
+  auto inter_tp_from_session_state = session_object.GetSessionState().GetInterOpThreadPool();
+
+  ASSERT_TRUE(intra_tp_from_session != nullptr);
+  ASSERT_TRUE(inter_tp_from_session == intra_tp_from_session);
+  ASSERT_TRUE(inter_tp_from_session == inter_tp_from_session_state);
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+  run_options.run_log_severity_level = static_cast<int>(Severity::kVERBOSE);
+  RunModel(session_object, run_options);
+}
+
 // Test 2: env created with global tp / DONT use per session tp: in this case global tps should be in use
 TEST(InferenceSessionTests, CheckIfGlobalThreadPoolsAreBeingUsed) {
   SessionOptions so;
@@ -2884,5 +3643,93 @@ TEST(InferenceSessionTests, InterThreadPoolWithDenormalAsZero) {
   VerifyThreadPoolWithDenormalAsZero(session2.GetInterOpThreadPoolToUse(), false);
 }
 
+// Memory map an ONNX model so the large initializers refer to their raw data in the mapped file
+TEST(InferenceSessionTests, LoadOnnxModelMemoryMapped) {
+  const PathString model_path = ORT_TSTR("testdata/map_onnx_model_into_memory.onnx");
+  {
+    onnxruntime::Model model("map_onnx_model", false, ModelMetaData(), PathString(),
+                             IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {},
+                             DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    TypeProto x_type;
+    x_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+    x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+
+    // W is large enough to be referenced in the mapped file, B is copied into the ModelProto
+    std::vector<float> w_values(64 * 64);
+    for (size_t i = 0; i < w_values.size(); ++i) {
+      w_values[i] = static_cast<float>(i % 7) * 0.5f;
+    }
+
+    TensorProto w;
+    w.set_name("W");
+    w.set_data_type(TensorProto_DataType_FLOAT);
+    w.add_dims(64);
+    w.add_dims(64);
+    w.set_raw_data(w_values.data(), w_values.size() * sizeof(float));
+    graph.AddInitializedTensor(w);
+
+    const float b_value = 2.f;
+    TensorProto b;
+    b.set_name("B");
+    b.set_data_type(TensorProto_DataType_FLOAT);
+    b.add_dims(1);
+    b.set_raw_data(&b_value, sizeof(float));
+    graph.AddInitializedTensor(b);
+
+    auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+    auto& matmul_out = graph.GetOrCreateNodeArg("matmul_out", &x_type);
+    auto& y = graph.GetOrCreateNodeArg("Y", &x_type);
+    graph.AddNode("matmul", "MatMul", "", {&x, graph.GetNodeArg("W")}, {&matmul_out});
+    graph.AddNode("add", "Add", "", {&matmul_out, graph.GetNodeArg("B")}, {&y});
+    ASSERT_STATUS_OK(graph.Resolve());
+    ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_path));
+  }
+
+  std::vector<float> x_values(64);
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    x_values[i] = static_cast<float>(i % 5);
+  }
+
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 64}, x_values, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+
+  auto run = [&](bool map_model, std::vector<OrtValue>& fetches) {
+    SessionOptions so;
+    so.session_logid = "LoadOnnxModelMemoryMapped";
+    so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMapOnnxModelIntoMemory, map_model ? "1" : "0");
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_path));
+
+#if !defined(_WIN32)
+    // memory mapping is only implemented on posix platforms
+    const auto& initializers = session_object.GetGraph().GetAllInitializedTensors();
+    const void* data = nullptr;
+    size_t length = 0;
+    EXPECT_EQ(utils::GetExternalDataMemoryAddress(*initializers.at("W"), data, length), map_model);
+    EXPECT_FALSE(utils::GetExternalDataMemoryAddress(*initializers.at("B"), data, length));
+#endif
+
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_STATUS_OK(session_object.Run(feeds, {"Y"}, &fetches));
+  };
+
+  std::vector<OrtValue> expected_fetches;
+  std::vector<OrtValue> fetches;
+  run(false, expected_fetches);
+  run(true, fetches);
+
+  ASSERT_EQ(fetches.size(), 1u);
+  const auto& expected = expected_fetches[0].Get<Tensor>();
+  const auto& output = fetches[0].Get<Tensor>();
+  ASSERT_EQ(output.Shape(), expected.Shape());
+  for (int64_t i = 0; i < output.Shape().Size(); ++i) {
+    EXPECT_EQ(output.Data<float>()[i], expected.Data<float>()[i]);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
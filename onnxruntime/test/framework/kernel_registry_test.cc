@@ -4,6 +4,9 @@
 #include <gtest/gtest.h>
 #include <core/framework/kernel_registry.h>
 #include <core/framework/op_kernel.h>
+#include <core/graph/model.h>
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
 
 using namespace onnxruntime;
 static Status RegKernels(KernelRegistry& r, std::vector<std::unique_ptr<KernelDef> >& function_table, const KernelCreateFn& kernel_creator) {
@@ -101,4 +104,35 @@ TEST(KernelRegistryTests, two_versions4) {
   function_table.emplace_back(KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(6,7).Provider(kCpuExecutionProvider).Build());
   Status st;
   ASSERT_FALSE((st = RegKernels(r, function_table, CreateFakeKernel)).IsOK());
-}
\ No newline at end of file
+}
+// the kernel is selected by version range and type constraints, regardless of the registration order
+TEST(KernelRegistryTests, find_kernel_by_version_and_type) {
+  KernelRegistry r;
+  std::vector<std::unique_ptr<KernelDef> > function_table;
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("ai.onnx").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(1, 5).Provider(kCpuExecutionProvider).Build());
+  ASSERT_STATUS_OK(RegKernels(r, function_table, CreateFakeKernel));
+
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, test::DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+  onnxruntime::Node& node = graph.AddNode("node1", "Elu", "Elu operator", {&input_def}, {&output_def});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const KernelCreateInfo* kci = nullptr;
+  ASSERT_STATUS_OK(r.TryFindKernel(node, kCpuExecutionProvider, &kci));
+  ASSERT_NE(kci, nullptr);
+  EXPECT_EQ(kci->kernel_def->SinceVersion(), std::make_pair(6, INT_MAX));
+  EXPECT_EQ(kci->kernel_def->Domain(), "ai.onnx");
+
+  const KernelCreateInfo* kci_by_hash = nullptr;
+  ASSERT_STATUS_OK(r.TryFindKernel(node, kCpuExecutionProvider, kci->kernel_def->GetHash(), &kci_by_hash));
+  EXPECT_EQ(kci_by_hash, kci);
+
+  ASSERT_FALSE(r.TryFindKernel(node, kCudaExecutionProvider, &kci).IsOK());
+  EXPECT_EQ(kci, nullptr);
+}
@@ -35,5 +35,30 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+TEST(MemPatternPlannerTest, LifetimePackingTest) {
+  const bool using_counters = false;
+  const bool pack_lifetimes = true;
+  MemPatternPlanner planner{using_counters, pack_lifetimes};
+  planner.TraceAllocation(0, 1024);
+  planner.TraceAllocation(1, 1024);
+
+  // nothing is freed, so the offsets assigned while tracing are already the best ones
+  auto pattern = planner.GenerateMemPattern();
+  EXPECT_EQ(pattern.PeakSize(), 2048u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 1024u);
+
+  // the freed block of 0 is too small for 2 while tracing, so 2 extends the buffer to 4096 bytes.
+  // placing 2 first puts it at offset 0, which 0 can share as their lifetimes do not overlap.
+  planner.TraceFree(0);
+  planner.TraceAllocation(2, 2048);
+
+  pattern = planner.GenerateMemPattern();
+  EXPECT_EQ(pattern.PeakSize(), 3072u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 2048u);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -325,6 +325,52 @@ TEST(OrtModelOnlyTests, TensorAttributeSerialization) {
   SaveAndCompareModels("testdata/ort_minimal_test_models/tensor_attribute.onnx", ort_file);
 }
 
+// the MatMul weights of mnist are prepacked when the model is saved and used without packing them again when loading
+TEST(OrtModelOnlyTests, SerializePrePackedWeights) {
+  const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/mnist.onnx.prepacked.test_output.ort");
+  SaveAndCompareModels("testdata/mnist.onnx", ort_file);
+
+  std::string model_bytes;
+  ASSERT_TRUE(flatbuffers::LoadFile(ToMBString(ort_file).c_str(), true, &model_bytes));
+  const auto* fbs_session = experimental::fbs::GetInferenceSession(model_bytes.data());
+  ASSERT_NE(fbs_session->session_state(), nullptr);
+  const auto* prepacked_weights = fbs_session->session_state()->prepacked_weights();
+  ASSERT_NE(prepacked_weights, nullptr);
+  ASSERT_NE(prepacked_weights->isa(), nullptr);
+  ASSERT_NE(prepacked_weights->initializers(), nullptr);
+  ASSERT_GT(prepacked_weights->initializers()->size(), 0U);
+
+  OrtValue ml_value;
+  vector<float> data(28 * 28);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 17) / 16.f;
+  }
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  std::vector<std::string> output_names{"Plus214_Output_0"};
+
+  SessionOptions so;
+  so.session_logid = "SerializePrePackedWeightsOnnx";
+  InferenceSessionWrapper onnx_session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(onnx_session.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(onnx_session.Initialize());
+  std::vector<OrtValue> expected;
+  ASSERT_STATUS_OK(onnx_session.Run(feeds, output_names, &expected));
+
+  OrtModelTestInfo test_info;
+  test_info.model_filename = ort_file;
+  test_info.logid = "SerializePrePackedWeights";
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+  test_info.inputs = feeds;
+  test_info.output_names = output_names;
+  test_info.output_verifier = [&expected](const std::vector<OrtValue>& fetches) {
+    CompareTensors(fetches[0], expected[0]);
+  };
+
+  RunOrtModel(test_info);
+}
+
 #if !defined(DISABLE_ML_OPS)
 TEST(OrtModelOnlyTests, SerializeToOrtFormatMLOps) {
   const std::basic_string<ORTCHAR_T> ort_file =
@@ -416,6 +462,38 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBuffer) {
   RunOrtModel(test_info);
 }
 
+// Memory map the model file and use the mapped bytes for the initializers
+TEST(OrtModelOnlyTests, LoadOrtFormatModelMemoryMapped) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+
+  SessionOptions so;
+  so.session_logid = "LoadOrtFormatModelMemoryMapped";
+  so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMapOrtModelIntoMemory, "1");
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(test_info.model_filename));
+
+#if !defined(_WIN32)
+  // memory mapping is only implemented on posix platforms
+  const auto& initializers = session_object.GetGraph().GetAllInitializedTensors();
+  ASSERT_FALSE(initializers.empty());
+  for (const auto& entry : initializers) {
+    const void* data = nullptr;
+    size_t length = 0;
+    EXPECT_TRUE(utils::GetExternalDataMemoryAddress(*entry.second, data, length)) << entry.first;
+    EXPECT_GT(length, 0u) << entry.first;
+  }
+#endif
+
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // run twice to make sure the initializers remain valid after Initialize
+  for (int i = 0; i < 2; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(test_info.inputs, test_info.output_names, &fetches));
+    test_info.output_verifier(fetches);
+  }
+}
+
 #if !defined(DISABLE_ML_OPS)
 // test that we can deserialize and run a previously saved ORT format model
 // for a model with sequence and map outputs
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/framework/partitioning_cost_model.h"
+#include "core/graph/model.h"
+#include "test/test_environment.h"
+#include "asserts.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+TypeProto FloatTensorType(std::initializer_list<int64_t> dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return type;
+}
+
+// Builds Relu -> op -> Relu, with the Relu nodes on CPU and the middle node on CUDA, and returns the nodes moved to CPU.
+std::vector<NodeIndex> MoveMiddleNode(const std::string& op_type, const TypeProto& input_type,
+                                      const TypeProto& output_type, bool can_run_on_cpu = true) {
+  Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}},
+              {}, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+
+  auto& input = graph.GetOrCreateNodeArg("input", &input_type);
+  auto& relu_output = graph.GetOrCreateNodeArg("relu_output", &input_type);
+  auto& op_output = graph.GetOrCreateNodeArg("op_output", &output_type);
+  auto& output = graph.GetOrCreateNodeArg("output", &output_type);
+
+  graph.AddNode("relu1", "Relu", "", {&input}, {&relu_output}).SetExecutionProviderType(kCpuExecutionProvider);
+  graph.AddNode("op", op_type, "", {&relu_output, &relu_output}, {&op_output})
+      .SetExecutionProviderType(kCudaExecutionProvider);
+  graph.AddNode("relu2", "Relu", "", {&op_output}, {&output}).SetExecutionProviderType(kCpuExecutionProvider);
+  EXPECT_STATUS_OK(graph.Resolve());
+
+  GraphViewer graph_viewer(graph);
+  return GetIslandsCheaperOnCpu(graph_viewer, PartitioningCostModel{},
+                                [can_run_on_cpu](const Node&) { return can_run_on_cpu; });
+}
+
+}  // namespace
+
+TEST(PartitioningCostModelTest, SmallIslandMovedToCpu) {
+  auto type = FloatTensorType({1, 4});
+  auto cpu_nodes = MoveMiddleNode("Add", type, type);
+  ASSERT_EQ(cpu_nodes.size(), 1u);
+}
+
+TEST(PartitioningCostModelTest, ExpensiveIslandStaysOnDevice) {
+  auto type = FloatTensorType({512, 512});
+  auto cpu_nodes = MoveMiddleNode("MatMul", type, type);
+  ASSERT_TRUE(cpu_nodes.empty());
+}
+
+TEST(PartitioningCostModelTest, IslandWithoutCpuKernelStaysOnDevice) {
+  auto type = FloatTensorType({1, 4});
+  auto cpu_nodes = MoveMiddleNode("Add", type, type, false);
+  ASSERT_TRUE(cpu_nodes.empty());
+}
+
+TEST(PartitioningCostModelTest, IslandWithUnknownShapeStaysOnDevice) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  auto cpu_nodes = MoveMiddleNode("Add", type, type);
+  ASSERT_TRUE(cpu_nodes.empty());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
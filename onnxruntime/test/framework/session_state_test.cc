@@ -7,6 +7,7 @@
 #include "core/framework/execution_providers.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/mem_pattern_planner.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/session_state.h"
@@ -118,7 +119,7 @@ class SessionStateTestP : public testing::TestWithParam<TestParam> {};
 TEST_P(SessionStateTestP, TestInitializerProcessing) {
   const TestParam& param = GetParam();
   OrtThreadPoolParams to;
-  to.thread_pool_size = to.thread_pool_size;
+  to.thread_pool_size = param.thread_count;
   auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
 
   std::basic_ostringstream<ORTCHAR_T> oss;
@@ -265,6 +266,12 @@ TEST(SessionStateTest, CPUPlacementTest5) {
   std::unordered_set<std::string> expected_gpu_nodes = {"shape0", "shape1", "reshape"};
   TestCPUNodePlacement(ORT_TSTR("testdata/cpu_fallback_pattern_5.onnx"), expected_cpu_nodes, expected_gpu_nodes);
 }
+TEST(SessionStateTest, CPUPlacementTest6) {
+  // unique has no GPU kernel, so the concat of its int64 output stays on CPU as well.
+  std::unordered_set<std::string> expected_cpu_nodes = {"unique", "concat"};
+  std::unordered_set<std::string> expected_gpu_nodes = {"shape0", "reshape"};
+  TestCPUNodePlacement(ORT_TSTR("testdata/cpu_fallback_pattern_6.onnx"), expected_cpu_nodes, expected_gpu_nodes);
+}
 #endif
 
 // Test that we allocate memory for an initializer from non-arena memory even if we provide an arena-based allocator
@@ -394,7 +401,7 @@ class PrePackingTestOpKernel : public OpKernel {
   }
 };
 
-static void CreateSimpleGraph(Graph& graph) {
+static void CreateSimpleGraph(Graph& graph, const std::string& op_type = "PrePackingTest") {
   // node creation and placement
   TypeProto type;
   type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
@@ -410,7 +417,7 @@ static void CreateSimpleGraph(Graph& graph) {
   onnxruntime::NodeArg output_arg("node_0_output_0", &type);
   outputs.push_back(&output_arg);
 
-  graph.AddNode("node_0", "PrePackingTest", "node 0", inputs, outputs);
+  graph.AddNode("node_0", op_type, "node 0", inputs, outputs);
 
   // add an initializer
   ONNX_NAMESPACE::TensorProto tensor;
@@ -598,7 +605,332 @@ INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
                                          PrepackingTestParam{true, true}));
+
+class SharedPrePackingTestOpKernel : public OpKernel {
+ public:
+  SharedPrePackingTestOpKernel(const OpKernelInfo& info) : OpKernel(info) {}
+  Status Compute(OpKernelContext* context) const override {
+    ORT_UNUSED_PARAMETER(context);
+    return Status::OK();
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override {
+    is_packed = false;
+    if (input_idx == 1) {
+      auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
+      packed_buffer_ = BufferUniquePtr(alloc->Alloc(tensor.SizeInBytes()), BufferDeleter(alloc));
+      memcpy(packed_buffer_.get(), tensor.DataRaw(), tensor.SizeInBytes());
+      is_packed = true;
+    }
+    return Status::OK();
+  }
+
+  Status TransferPrePackedBuffers(int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers) override {
+    if (input_idx == 1) {
+      prepacked_buffers.push_back(std::move(packed_buffer_));
+    }
+    return Status::OK();
+  }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+    if (input_idx == 1) {
+      packed_buffer_ = std::move(prepacked_buffers[0]);
+      used_shared_buffers = true;
+    }
+    return Status::OK();
+  }
+
+  const void* PackedBuffer() const { return packed_buffer_.get(); }
+
+ private:
+  BufferUniquePtr packed_buffer_;
+};
+
+TEST(SessionStateTest, SharedPrePackedWeights) {
+  OrtThreadPoolParams to;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+  ONNX_OPERATOR_SCHEMA(SharedPrePackingTest)
+      .SetDoc("Faking Node for sharing PrePacked weights")
+      .Input(0, "Input_0", "input 0", "tensor(float)")
+      .Input(1, "Input_1", "input 1", "tensor(float)")
+      .Output(0, "output_0", "docstr for output_0.", "tensor(float)");
+
+  ExecutionProviders execution_providers;
+  auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+  std::shared_ptr<KernelRegistry> kernel_registry = std::make_shared<KernelRegistry>();
+  auto kernel_def = KernelDefBuilder().SetName("SharedPrePackingTest").Provider(kCpuExecutionProvider).SinceVersion(1).Build();
+  ASSERT_STATUS_OK(kernel_registry->Register(
+      KernelCreateInfo(std::move(kernel_def),
+                       [](const OpKernelInfo& info) -> OpKernel* { return new SharedPrePackingTestOpKernel(info); })));
+  kernel_registry_manager.RegisterKernelRegistry(kernel_registry);
+
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 11;
+
+  PrepackedWeightsContainer prepacked_weights_container;
+  const void* packed_buffers[2] = {nullptr, nullptr};
+
+  // two sessions of the same model share the buffer packed for the initializer
+  std::vector<std::unique_ptr<Model>> models;
+  std::vector<std::unique_ptr<SessionState>> session_states;
+  for (int i = 0; i < 2; i++) {
+    models.push_back(std::make_unique<Model>("graph_main", false, ModelMetaData(), PathString(),
+                                             IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                             std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                             DefaultLoggingManager().DefaultLogger()));
+    CreateSimpleGraph(models.back()->MainGraph(), "SharedPrePackingTest");
+    PlaceAllNodesToCPUEP(models.back()->MainGraph());
+
+    session_states.push_back(std::make_unique<SessionState>(models.back()->MainGraph(),
+                                                            execution_providers,
+                                                            true, /*enable_mem_pattern*/
+                                                            tp.get(),
+                                                            nullptr, /*inter_op_thread_pool*/
+                                                            dtm,
+                                                            DefaultLoggingManager().DefaultLogger(),
+                                                            profiler,
+                                                            false, /*use_deterministic_compute*/
+                                                            true,  /*enable_mem_reuse*/
+                                                            &prepacked_weights_container));
+
+    SessionOptions sess_options;
+    ASSERT_STATUS_OK(session_states.back()->FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                                 kernel_registry_manager,
+                                                                 sess_options));
+    ASSERT_EQ(session_states.back()->GetConstantInitializedTensors().size(), size_t(0));
+
+    const auto& node = *models.back()->MainGraph().Nodes().begin();
+    const auto* kernel = static_cast<const SharedPrePackingTestOpKernel*>(session_states.back()->GetKernel(node.Index()));
+    packed_buffers[i] = kernel->PackedBuffer();
+    ASSERT_NE(packed_buffers[i], nullptr);
+  }
+
+  ASSERT_EQ(prepacked_weights_container.GetNumberOfElements(), size_t(1));
+  ASSERT_EQ(packed_buffers[0], packed_buffers[1]);
+  ASSERT_EQ(*static_cast<const float*>(packed_buffers[0]), 1.0f);
+
+  // the container keeps the buffer alive after the sessions are released
+  session_states.clear();
+  ASSERT_EQ(*static_cast<const float*>(packed_buffers[0]), 1.0f);
+}
+
+static std::unique_ptr<MemoryPatternGroup> CreateMemoryPatternGroup(const OrtMemoryInfo& location, size_t size) {
+  MemPatternPlanner planner{false};
+  planner.TraceAllocation(0, size);
+
+  auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+  mem_patterns->locations.push_back(location);
+  mem_patterns->patterns.push_back(planner.GenerateMemPattern());
+  return mem_patterns;
+}
+
+// test the memory pattern cache lookup with shape bucketing, and the eviction once the cache size limit is reached
+TEST(SessionStateTest, MemoryPatternCacheBucketingAndEviction) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq_len");
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("node_1", "Relu", "node 1.", {&input_arg}, {&output_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  const OrtMemoryInfo location = cpu_execution_provider->GetAllocator(0, OrtMemTypeDefault)->Info();
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider)));
+
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState session_state(graph, execution_providers, true, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternShapeBucketing, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternCacheMaxBytes, "2048"));
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, so));
+  ASSERT_TRUE(session_state.GetEnableMemoryPatternShapeBucketing());
+
+  auto get_pattern = [&session_state](int64_t seq_len) {
+    TensorShape shape({seq_len});
+    std::vector<std::reference_wrapper<const TensorShape>> input_shapes{std::cref(shape)};
+    std::unordered_map<int, TensorShape> inferred_shapes;
+    return session_state.GetMemoryPatternGroup(input_shapes, {0}, inferred_shapes);
+  };
+
+  auto add_pattern = [&session_state, &location](int64_t seq_len, size_t size) {
+    TensorShape shape({seq_len});
+    std::vector<std::reference_wrapper<const TensorShape>> input_shapes{std::cref(shape)};
+    return session_state.UpdateMemoryPatternGroupCache(input_shapes, CreateMemoryPatternGroup(location, size));
+  };
+
+  ASSERT_EQ(get_pattern(300), nullptr);
+  ASSERT_STATUS_OK(add_pattern(300, 1024));
+
+  // all sequence lengths from 257 to 512 share the pattern
+  auto pattern = get_pattern(257);
+  ASSERT_NE(pattern, nullptr);
+  EXPECT_EQ(get_pattern(512), pattern);
+  EXPECT_EQ(get_pattern(256), nullptr);
+  EXPECT_EQ(get_pattern(513), nullptr);
+
+  // updating the pattern for a bucket replaces it
+  ASSERT_STATUS_OK(add_pattern(500, 1536));
+  EXPECT_EQ(get_pattern(300)->patterns[0].PeakSize(), 1536u);
+
+  // the original pattern remains valid while it's held
+  EXPECT_EQ(pattern->patterns[0].PeakSize(), 1024u);
+
+  // adding a pattern for a different bucket exceeds the limit so the least recently used one is evicted
+  ASSERT_STATUS_OK(add_pattern(100, 512));
+  ASSERT_NE(get_pattern(100), nullptr);
+  ASSERT_NE(get_pattern(300), nullptr);
+  ASSERT_STATUS_OK(add_pattern(50, 512));
+  EXPECT_EQ(get_pattern(100), nullptr);
+  EXPECT_NE(get_pattern(300), nullptr);
+  EXPECT_NE(get_pattern(50), nullptr);
+
+  // a pattern larger than the limit is not cached
+  ASSERT_STATUS_OK(add_pattern(1000, 4096));
+  EXPECT_EQ(get_pattern(1000), nullptr);
+}
+
+// test the memory patterns generated for any input shapes from the tensor sizes derived from the symbolic input dims
+TEST(SessionStateTest, MemoryPatternSymbolicPlanning) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& t1_arg = graph.GetOrCreateNodeArg("T1", &tensor_float);
+  auto& t2_arg = graph.GetOrCreateNodeArg("T2", &tensor_float);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("node_1", "Relu", "node 1.", {&input_arg}, {&t1_arg});
+  graph.AddNode("node_2", "Relu", "node 2.", {&t1_arg}, {&t2_arg});
+  graph.AddNode("node_3", "Add", "node 3.", {&t1_arg, &t2_arg}, {&output_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  const OrtMemoryInfo location = cpu_execution_provider->GetAllocator(0, OrtMemTypeDefault)->Info();
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider)));
+
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState session_state(graph, execution_providers, true, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternSymbolicPlanning, "1"));
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, so));
+  ASSERT_TRUE(session_state.GetEnableMemoryPatternSymbolicPlanning());
+
+  int x_idx, t1_idx, t2_idx, y_idx;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("X", x_idx));
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("T1", t1_idx));
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("T2", t2_idx));
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("Y", y_idx));
+
+  auto get_pattern = [&session_state, x_idx](int64_t batch, int64_t seq) {
+    TensorShape shape({batch, seq});
+    std::vector<std::reference_wrapper<const TensorShape>> input_shapes{std::cref(shape)};
+    std::unordered_map<int, TensorShape> inferred_shapes;
+    return session_state.GetMemoryPatternGroup(input_shapes, {x_idx}, inferred_shapes);
+  };
+
+  // T1 and T2 are alive at the same time, each taking batch * seq * 4 bytes rounded up to the alignment.
+  // the graph output is not part of the pattern.
+  for (const auto& dims : std::vector<std::pair<int64_t, int64_t>>{{2, 8}, {3, 100}}) {
+    auto mem_patterns = get_pattern(dims.first, dims.second);
+    ASSERT_NE(mem_patterns, nullptr);
+    const auto* pattern = mem_patterns->GetPatterns(location);
+    ASSERT_NE(pattern, nullptr);
+
+    size_t size = 0;
+    ASSERT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(
+        static_cast<size_t>(dims.first * dims.second), sizeof(float), &size));
+    const auto* t1_block = pattern->GetBlock(t1_idx);
+    const auto* t2_block = pattern->GetBlock(t2_idx);
+    ASSERT_NE(t1_block, nullptr);
+    ASSERT_NE(t2_block, nullptr);
+    EXPECT_EQ(t1_block->size_, size);
+    EXPECT_EQ(t2_block->size_, size);
+    EXPECT_NE(t1_block->offset_, t2_block->offset_);
+    EXPECT_EQ(pattern->GetBlock(y_idx), nullptr);
+    EXPECT_EQ(pattern->PeakSize(), 2 * size);
+  }
+
+  // a shape that doesn't match the rank of the input falls back to the cached patterns
+  TensorShape shape({2, 8, 1});
+  std::vector<std::reference_wrapper<const TensorShape>> input_shapes{std::cref(shape)};
+  std::unordered_map<int, TensorShape> inferred_shapes;
+  EXPECT_EQ(session_state.GetMemoryPatternGroup(input_shapes, {x_idx}, inferred_shapes), nullptr);
+}
 #endif
 
+// the execution steps should match the execution plan and the kernels
+TEST(SessionStateTest, ExecutionStepsMatchExecutionPlan) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& intermediate_arg = graph.GetOrCreateNodeArg("T", &tensor_float);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("node_1", "Relu", "node 1.", {&input_arg}, {&intermediate_arg});
+  graph.AddNode("node_2", "Relu", "node 2.", {&intermediate_arg}, {&output_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false))));
+
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState session_state(graph, execution_providers, false, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler);
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+
+  const auto& exec_plan = *session_state.GetExecutionPlan();
+  const auto& steps = session_state.GetExecutionSteps();
+  ASSERT_EQ(steps.size(), exec_plan.execution_plan.size());
+  ASSERT_EQ(steps.size(), 2u);
+  EXPECT_FALSE(session_state.ExecutionStepsHaveFence());
+
+  for (size_t i = 0; i < steps.size(); ++i) {
+    const auto& node_exec_plan = exec_plan.execution_plan[i];
+    EXPECT_EQ(steps[i].node_index, node_exec_plan.node_index);
+    EXPECT_EQ(steps[i].kernel, session_state.GetKernel(node_exec_plan.node_index));
+    EXPECT_FALSE(steps[i].contains_subgraph);
+    EXPECT_EQ(steps[i].free_from_index, node_exec_plan.free_from_index);
+    EXPECT_EQ(steps[i].free_to_index, node_exec_plan.free_to_index);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
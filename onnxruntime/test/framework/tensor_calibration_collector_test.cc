@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+
+#include "core/framework/tensor_calibration_collector.h"
+#include "test_utils.h"
+#include "asserts.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static void Collect(TensorCalibrationCollector& collector, const std::string& name, const std::vector<float>& values) {
+  OrtValue value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault),
+                       {static_cast<int64_t>(values.size())}, values, &value);
+  ASSERT_STATUS_OK(collector.Collect(name, value, nullptr));
+}
+
+TEST(TensorCalibrationCollectorTest, GrowHistogram) {
+  TensorCalibrationCollector collector({}, 4);
+  ASSERT_TRUE(collector.ShouldCollect("any"));
+
+  // bins of width 0.5 over [-1, 1], the threshold being inclusive
+  Collect(collector, "X", {-1.f, 0.5f, 1.f});
+  auto stats = collector.GetStats();
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats["X"].min, -1.f);
+  EXPECT_EQ(stats["X"].max, 1.f);
+  EXPECT_EQ(stats["X"].threshold, 1.f);
+  EXPECT_EQ(stats["X"].histogram, std::vector<int64_t>({1, 0, 0, 2}));
+
+  // 5 bins of the same width are added on both sides to cover 3
+  Collect(collector, "X", {3.f});
+  stats = collector.GetStats();
+  EXPECT_EQ(stats["X"].min, -1.f);
+  EXPECT_EQ(stats["X"].max, 3.f);
+  EXPECT_EQ(stats["X"].threshold, 3.5f);
+  EXPECT_EQ(stats["X"].histogram, std::vector<int64_t>({0, 0, 0, 0, 0, 1, 0, 0, 2, 0, 0, 0, 0, 1}));
+
+  // within the threshold
+  Collect(collector, "X", {2.f});
+  stats = collector.GetStats();
+  EXPECT_EQ(stats["X"].threshold, 3.5f);
+  EXPECT_EQ(stats["X"].histogram, std::vector<int64_t>({0, 0, 0, 0, 0, 1, 0, 0, 2, 0, 0, 1, 0, 1}));
+}
+
+TEST(TensorCalibrationCollectorTest, ZeroThreshold) {
+  TensorCalibrationCollector collector({"X"}, 4);
+  ASSERT_FALSE(collector.ShouldCollect("Y"));
+
+  // all the values go to the middle bin
+  Collect(collector, "X", {0.f, 0.f});
+  auto stats = collector.GetStats();
+  EXPECT_EQ(stats["X"].threshold, 0.f);
+  EXPECT_EQ(stats["X"].histogram, std::vector<int64_t>({0, 0, 2, 0}));
+
+  // the zeros stay in the middle bin, NaN and infinite values are ignored
+  Collect(collector, "X", {std::numeric_limits<float>::quiet_NaN(), 1.f, std::numeric_limits<float>::infinity()});
+  stats = collector.GetStats();
+  EXPECT_EQ(stats["X"].min, 0.f);
+  EXPECT_EQ(stats["X"].max, 1.f);
+  EXPECT_EQ(stats["X"].threshold, 1.f);
+  EXPECT_EQ(stats["X"].histogram, std::vector<int64_t>({0, 0, 2, 1}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
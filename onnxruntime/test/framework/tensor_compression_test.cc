@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <random>
+
+#include "core/framework/tensor_compression.h"
+#include "core/framework/tensorprotoutils.h"
+#include "asserts.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+// quantized weights, a few distinct values spread over more than one chunk
+static std::vector<float> QuantizedValues(size_t count) {
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(-8, 8);
+  std::vector<float> values(count);
+  for (auto& value : values) {
+    value = static_cast<float>(distribution(generator)) * 0.125f;
+  }
+  return values;
+}
+
+TEST(TensorCompressionTest, RoundTrip) {
+  const auto values = QuantizedValues(200 * 1000);
+  const size_t size = values.size() * sizeof(float);
+
+  for (auto compression : {TensorCompression::Lz4, TensorCompression::ByteShuffleLz4}) {
+    std::vector<uint8_t> compressed;
+    ASSERT_TRUE(CompressTensorData(values.data(), size, sizeof(float), compression, compressed));
+    EXPECT_LT(compressed.size(), size - size / 8);
+
+    std::vector<float> decompressed(values.size());
+    ASSERT_STATUS_OK(DecompressTensorData(compressed.data(), compressed.size(), sizeof(float), compression,
+                                          decompressed.data(), size));
+    EXPECT_EQ(decompressed, values);
+
+    // a truncated payload must fail rather than overrun the buffers
+    EXPECT_FALSE(DecompressTensorData(compressed.data(), compressed.size() / 2, sizeof(float), compression,
+                                      decompressed.data(), size)
+                     .IsOK());
+  }
+}
+
+TEST(TensorCompressionTest, IncompressibleData) {
+  std::mt19937 generator(42);
+  std::vector<uint8_t> values(100 * 1000);
+  for (auto& value : values) {
+    value = static_cast<uint8_t>(generator());
+  }
+
+  std::vector<uint8_t> compressed;
+  EXPECT_FALSE(CompressTensorData(values.data(), values.size(), 1, TensorCompression::Lz4, compressed));
+  EXPECT_FALSE(CompressTensorData(values.data(), values.size(), 1, TensorCompression::None, compressed));
+}
+
+TEST(TensorCompressionTest, CompressedExternalData) {
+  const auto values = QuantizedValues(100 * 1000);
+  const size_t size = values.size() * sizeof(float);
+  std::vector<uint8_t> compressed;
+  ASSERT_TRUE(CompressTensorData(values.data(), size, sizeof(float), TensorCompression::ByteShuffleLz4, compressed));
+
+  ONNX_NAMESPACE::TensorProto tensor_proto;
+  tensor_proto.set_name("W");
+  tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_proto.add_dims(static_cast<int64_t>(values.size()));
+  utils::SetCompressedExternalDataMemoryAddress(tensor_proto, compressed.data(), compressed.size(),
+                                                TensorCompression::ByteShuffleLz4);
+
+  ASSERT_TRUE(utils::HasCompressedExternalData(tensor_proto));
+  const void* data = nullptr;
+  size_t length = 0;
+  EXPECT_FALSE(utils::GetExternalDataMemoryAddress(tensor_proto, data, length));
+
+  std::vector<float> decompressed(values.size());
+  ASSERT_STATUS_OK(utils::ReadCompressedExternalData(tensor_proto, decompressed.data(), size));
+  EXPECT_EQ(decompressed, values);
+
+  std::vector<float> unpacked(values.size());
+  ASSERT_STATUS_OK(utils::UnpackTensor(tensor_proto, Path(), unpacked.data(), unpacked.size()));
+  EXPECT_EQ(unpacked, values);
+
+  EXPECT_FALSE(utils::ReadCompressedExternalData(tensor_proto, decompressed.data(), size - sizeof(float)).IsOK());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
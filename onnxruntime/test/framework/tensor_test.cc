@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/TensorSeq.h"
 #include "test_utils.h"
 
 #include "gmock/gmock.h"
@@ -210,5 +211,32 @@ TEST(TensorTest, SizeOverflow) {
   Tensor t(type, shape1, nullptr, alloc->Info());
   EXPECT_THROW(t.SizeInBytes(), OnnxRuntimeException);
 }
+
+TEST(TensorTest, TensorSeqSharesTensors) {
+  auto type = DataTypeImpl::GetType<float>();
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+
+  TensorSeq seq(type);
+  for (int i = 0; i < 3; ++i) {
+    Tensor t(type, TensorShape({2}), alloc);
+    t.MutableData<float>()[0] = static_cast<float>(i);
+    seq.Add(std::move(t));
+  }
+
+  // a second sequence sharing the first two tensors outlives the first one
+  const float* shared_data = seq.Get(1).Data<float>();
+  auto other = std::make_unique<TensorSeq>(type);
+  other->Add(seq.GetOrtValue(0));
+  other->Add(seq.GetOrtValue(1));
+  seq = TensorSeq();
+
+  ASSERT_EQ(other->Size(), 2u);
+  EXPECT_EQ(other->Get(1).Data<float>(), shared_data);
+  float expected = 0.f;
+  for (const Tensor& t : *other) {
+    EXPECT_EQ(t.Data<float>()[0], expected);
+    expected += 1.f;
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -23,6 +23,9 @@ using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+// number of times the type and shape inferencing function of CountInference_Fake was called
+static int num_count_inference_calls = 0;
+
 static bool RegisterCustomSchemas() {
   OPERATOR_SCHEMA(Variable_DFS)
       .SetDoc("Input variable.")
@@ -100,6 +103,17 @@ static bool RegisterCustomSchemas() {
         fail_shape_inference("try harder");
       });
 
+  OPERATOR_SCHEMA(CountInference_Fake)
+      .SetDoc("Counts the calls of its type and shape inferencing function.")
+      .Attr("value", "unused attribute", AttributeProto::INT, static_cast<int64_t>(0))
+      .Input(0, "input_1", "docstr for input_1.", "tensor(int32)")
+      .Output(0, "output_1", "docstr for output_1.", "tensor(int32)")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        ++num_count_inference_calls;
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        propagateShapeFromInputToOutput(ctx, 0, 0);
+      });
+
   OPERATOR_SCHEMA(Fake_Sub)
       .SinceVersion(1)
       .SetDomain(kMSNchwcDomain)
@@ -1471,6 +1485,57 @@ TEST_F(GraphTest, ShapeInferenceErrorHandling) {
                                                         "[ShapeInferenceError] try harder"));
 }
 
+// Resolve only repeats the type and shape inferencing of the nodes that may have changed
+TEST_F(GraphTest, ResolveOnlyInfersChangedNodes) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_int32;
+  tensor_int32.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  tensor_int32.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_int32);
+  auto& y1 = graph.GetOrCreateNodeArg("y1", nullptr);
+  auto& y2 = graph.GetOrCreateNodeArg("y2", nullptr);
+  auto& y3 = graph.GetOrCreateNodeArg("y3", nullptr);
+  graph.AddNode("node_1", "CountInference_Fake", "node 1", {&x}, {&y1});
+  auto& node_2 = graph.AddNode("node_2", "CountInference_Fake", "node 2", {&y1}, {&y2});
+  graph.AddNode("node_3", "CountInference_Fake", "node 3", {&y2}, {&y3});
+
+  num_count_inference_calls = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inference_calls, 3);
+
+  // nothing changed
+  num_count_inference_calls = 0;
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inference_calls, 0);
+
+  // the output type of node_2 doesn't change, so node_3 is not inferred again
+  num_count_inference_calls = 0;
+  node_2.AddAttribute("value", static_cast<int64_t>(1));
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inference_calls, 1);
+
+  // only the new node is inferred
+  num_count_inference_calls = 0;
+  auto& y4 = graph.GetOrCreateNodeArg("y4", nullptr);
+  graph.AddNode("node_4", "CountInference_Fake", "node 4", {&y3}, {&y4});
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inference_calls, 1);
+  ASSERT_NE(y4.Shape(), nullptr);
+  EXPECT_EQ(y4.Shape()->dim(0).dim_value(), 2);
+
+  // the shape of y1 is inferred again by node_1, which changes the input of node_2
+  num_count_inference_calls = 0;
+  y1.ClearShape();
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inference_calls, 2);
+  ASSERT_NE(y1.Shape(), nullptr);
+}
+
 TEST_F(GraphTest, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasChannelNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferScale;
+
+  void Test(size_t N, float Offset) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Output = BufferOutput.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    // A large offset checks that the moments do not cancel out as with the
+    // sum of squares formula.
+    for (size_t i = 0; i < N; i++) {
+      Input[i] = Offset + distribution(generator);
+    }
+
+    double mean = 0.0;
+    for (size_t i = 0; i < N; i++) {
+      mean += Input[i];
+    }
+    mean /= double(N);
+    double variance = 0.0;
+    for (size_t i = 0; i < N; i++) {
+      variance += (Input[i] - mean) * (Input[i] - mean);
+    }
+    variance /= double(N);
+
+    float Mean;
+    float Variance;
+    MlasComputeMeanVariance(Input, N, &Mean, &Variance);
+
+    ASSERT_NEAR(Mean, mean, 1e-6 * (1.0 + std::fabs(mean))) << " N=" << N << ", offset=" << Offset;
+    ASSERT_NEAR(Variance, variance, 1e-4 * (1.0 + variance)) << " N=" << N << ", offset=" << Offset;
+
+    const float Scale = 0.75f;
+    const float Shift = -1.5f;
+    MlasComputeScaleShift(Input, Output, N, Scale, Shift);
+
+    for (size_t i = 0; i < N; i++) {
+      ASSERT_NEAR(Output[i], Input[i] * Scale + Shift, 1e-6f * (1.0f + std::fabs(Output[i])))
+          << " @" << i << " of " << N;
+    }
+
+    TestLayerNormalization(N, Input, distribution, generator);
+  }
+
+  void TestLayerNormalization(size_t N, const float* Input, std::uniform_real_distribution<float>& distribution,
+                              std::default_random_engine& generator) {
+    float* Output = BufferOutput.GetBuffer(N);
+    float* Skip = BufferSkip.GetBuffer(N);
+    float* Bias = BufferBias.GetBuffer(N);
+    float* Scale = BufferScale.GetBuffer(N);
+
+    for (size_t i = 0; i < N; i++) {
+      Skip[i] = distribution(generator);
+      Bias[i] = distribution(generator);
+      Scale[i] = distribution(generator);
+    }
+
+    for (const float* bias : {static_cast<const float*>(nullptr), static_cast<const float*>(Bias)}) {
+      float Mean;
+      float Variance;
+      MlasComputeAddMeanVariance(Input, Skip, bias, Output, N, &Mean, &Variance);
+
+      double mean = 0.0;
+      for (size_t i = 0; i < N; i++) {
+        ASSERT_EQ(Output[i], Input[i] + Skip[i] + (bias != nullptr ? bias[i] : 0.0f)) << " @" << i << " of " << N;
+        mean += Output[i];
+      }
+      mean /= double(N);
+      double variance = 0.0;
+      for (size_t i = 0; i < N; i++) {
+        variance += (Output[i] - mean) * (Output[i] - mean);
+      }
+      variance /= double(N);
+
+      ASSERT_NEAR(Mean, mean, 1e-6 * (1.0 + std::fabs(mean))) << " N=" << N;
+      ASSERT_NEAR(Variance, variance, 1e-4 * (1.0 + variance)) << " N=" << N;
+
+      // normalize the sum in place
+      const float InvStdDev = 1.0f / std::sqrt(Variance + 1e-5f);
+      std::vector<float> sum(Output, Output + N);
+      MlasComputeNormalization(Output, Output, N, Mean, InvStdDev, Scale, bias);
+
+      for (size_t i = 0; i < N; i++) {
+        float expected = (sum[i] - Mean) * InvStdDev * Scale[i] + (bias != nullptr ? bias[i] : 0.0f);
+        ASSERT_NEAR(Output[i], expected, 1e-5f * (1.0f + std::fabs(expected))) << " @" << i << " of " << N;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("ChannelNorm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t N : {size_t(1), size_t(3), size_t(15), size_t(16), size_t(17), size_t(63), size_t(1000),
+                     size_t(64 * 64)}) {
+      Test(N, 0.0f);
+      Test(N, 1000.0f);
+    }
+  }
+};
+
+template <> MlasChannelNormTest* MlasTestFixture<MlasChannelNormTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasChannelNormTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+class MlasConvertTest : public MlasTestBase {
+ private:
+  static uint32_t BitsOf(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+  }
+
+  static float FloatOf(uint32_t u) {
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+  }
+
+  static bool IsHalfNaN(uint16_t h) { return (h & 0x7C00) == 0x7C00 && (h & 0x03FF) != 0; }
+
+  static float ReferenceHalfToFloat(uint16_t h) {
+    const float sign = (h & 0x8000) ? -1.0f : 1.0f;
+    const int exponent = (h >> 10) & 0x1F;
+    const int mantissa = h & 0x3FF;
+    if (exponent == 0x1F) {
+      return mantissa == 0 ? sign * std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    }
+    if (exponent == 0) {
+      return sign * std::ldexp(static_cast<float>(mantissa), -24);
+    }
+    return sign * std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+  }
+
+  // round to nearest even by picking the closer of the two neighbouring half values
+  static uint16_t ReferenceFloatToHalf(float f) {
+    const uint16_t sign = (BitsOf(f) >> 16) & 0x8000;
+    const float a = std::fabs(f);
+    if (a >= 65520.0f) {
+      return static_cast<uint16_t>(sign | 0x7C00);
+    }
+    uint16_t lower = 0;
+    for (int step = 0x4000; step != 0; step >>= 1) {
+      if (lower + step < 0x7C00 && ReferenceHalfToFloat(static_cast<uint16_t>(lower + step)) <= a) {
+        lower = static_cast<uint16_t>(lower + step);
+      }
+    }
+    const float below = ReferenceHalfToFloat(lower);
+    const float above = ReferenceHalfToFloat(static_cast<uint16_t>(lower + 1));
+    const float d0 = a - below;
+    const float d1 = above - a;
+    const bool round_up = d1 < d0 || (d1 == d0 && (lower & 1) != 0);
+    return static_cast<uint16_t>(sign | (round_up ? lower + 1 : lower));
+  }
+
+  static uint16_t ReferenceFloatToBFloat16(float f) {
+    const uint32_t u = BitsOf(f);
+    const uint32_t truncated = u & 0xFFFF0000;
+    const uint32_t remainder = u & 0xFFFF;
+    if (remainder > 0x8000 || (remainder == 0x8000 && (truncated & 0x10000) != 0)) {
+      return static_cast<uint16_t>((truncated + 0x10000) >> 16);
+    }
+    return static_cast<uint16_t>(truncated >> 16);
+  }
+
+  void TestToFloat(size_t Count) {
+    std::vector<uint16_t> Input(Count);
+    std::vector<float> Output(Count);
+    for (size_t i = 0; i < Count; i++) {
+      Input[i] = static_cast<uint16_t>(i * 7919);
+    }
+
+    MlasConvertHalfToFloat(Input.data(), Output.data(), Count);
+    for (size_t i = 0; i < Count; i++) {
+      if (IsHalfNaN(Input[i])) {
+        ASSERT_TRUE(std::isnan(Output[i])) << "half 0x" << std::hex << Input[i];
+      } else {
+        ASSERT_EQ(BitsOf(Output[i]), BitsOf(ReferenceHalfToFloat(Input[i]))) << "half 0x" << std::hex << Input[i];
+      }
+    }
+
+    MlasConvertBFloat16ToFloat(Input.data(), Output.data(), Count);
+    for (size_t i = 0; i < Count; i++) {
+      ASSERT_EQ(BitsOf(Output[i]), uint32_t(Input[i]) << 16) << "bfloat16 0x" << std::hex << Input[i];
+    }
+  }
+
+  void TestFromFloat(size_t Count, uint32_t Stride) {
+    std::vector<float> Input(Count);
+    std::vector<uint16_t> Output(Count);
+    for (size_t i = 0; i < Count; i++) {
+      Input[i] = FloatOf(static_cast<uint32_t>(i * Stride));
+    }
+
+    MlasConvertFloatToHalf(Input.data(), Output.data(), Count);
+    for (size_t i = 0; i < Count; i++) {
+      if (std::isnan(Input[i])) {
+        ASSERT_TRUE(IsHalfNaN(Output[i])) << "float 0x" << std::hex << BitsOf(Input[i]);
+      } else {
+        ASSERT_EQ(Output[i], ReferenceFloatToHalf(Input[i])) << "float 0x" << std::hex << BitsOf(Input[i]);
+      }
+    }
+
+    MlasConvertFloatToBFloat16(Input.data(), Output.data(), Count);
+    for (size_t i = 0; i < Count; i++) {
+      if (std::isnan(Input[i])) {
+        ASSERT_EQ(Output[i] & 0x7FC0, 0x7FC0) << "float 0x" << std::hex << BitsOf(Input[i]);
+      } else {
+        ASSERT_EQ(Output[i], ReferenceFloatToBFloat16(Input[i])) << "float 0x" << std::hex << BitsOf(Input[i]);
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Convert");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // every half precision and bfloat16 value, then shorter buffers for the vector remainders
+    TestToFloat(65536);
+    for (size_t Count = 1; Count < 80; Count++) {
+      TestToFloat(Count);
+    }
+
+    // strides chosen to cover all exponents, halfway cases and NaNs
+    TestFromFloat(1 << 20, 4099);
+    TestFromFloat(1 << 16, 0x10001);
+    TestFromFloat(1 << 16, 0x8000);
+    for (size_t Count = 1; Count < 80; Count++) {
+      TestFromFloat(Count, 0x01234567);
+    }
+  }
+};
+
+template <> MlasConvertTest* MlasTestFixture<MlasConvertTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasConvertTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasFastActivationTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  template <typename ComputeFn, typename ReferenceFn>
+  void Test(const char* Name, ComputeFn Compute, ReferenceFn Reference, float AbsoluteTolerance, size_t N) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Output = BufferOutput.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-12.f, 12.f);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = distribution(generator);
+    }
+
+    Compute(Input, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      float expected = static_cast<float>(Reference(static_cast<double>(Input[n])));
+      ASSERT_LE(std::fabs(Output[n] - expected), AbsoluteTolerance)
+          << Name << " @" << n << " of " << N << ", input: " << Input[n] << ", got: " << Output[n]
+          << ", expecting: " << expected;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("FastActivation");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n = 1; n < 128; n++) {
+      Test("Tanh", MlasComputeFastTanh, [](double x) { return std::tanh(x); }, 7.5e-5f, n);
+      Test("Logistic", MlasComputeFastLogistic, [](double x) { return 1.0 / (1.0 + std::exp(-x)); }, 4e-5f, n);
+      Test("Erf", MlasComputeFastErf, [](double x) { return std::erf(x); }, 5e-4f, n);
+    }
+  }
+};
+
+template <> MlasFastActivationTest* MlasTestFixture<MlasFastActivationTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasFastActivationTest>::RegisterShortExecute() : 0;
+});
@@ -70,6 +70,9 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     test_registered += RegisterTestTransposeABProduct(128, 3072, 768, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
+    // small M with a large K, which the threaded SGEMM also segments along K
+    test_registered += RegisterTestTransposeABProduct(1, 32, 16384, 1, 1.0f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(4, 40, 3000, 1, 0.5f, 1.5f);
     return test_registered;
   }
 
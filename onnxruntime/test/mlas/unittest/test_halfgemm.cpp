@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cstring>
+
+class MlasHalfGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<MLAS_FP16> BufferA;
+  MatrixGuardBuffer<MLAS_FP16> BufferB;
+  MatrixGuardBuffer<MLAS_FP16> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  static float HalfToFloat(MLAS_FP16 h) {
+    const uint32_t sign = uint32_t(h & 0x8000) << 16;
+    uint32_t exponent = (h >> 10) & 0x1f;
+    uint32_t mantissa = h & 0x3ff;
+    uint32_t bits;
+
+    if (exponent == 0x1f) {
+      bits = sign | 0x7f800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+      bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+      exponent = 113;
+      while ((mantissa & 0x400) == 0) {
+        mantissa <<= 1;
+        exponent--;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    } else {
+      bits = sign;
+    }
+
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+  }
+
+  //
+  // The test data is restricted to values that are exactly representable in
+  // half precision, so only a simple conversion is required here.
+  //
+
+  static MLAS_FP16 FloatToHalf(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+
+    const uint16_t sign = uint16_t((bits >> 16) & 0x8000);
+    const int32_t exponent = int32_t((bits >> 23) & 0xff) - 112;
+
+    if (exponent <= 0) {
+      return sign;
+    }
+
+    return uint16_t(sign | (exponent << 10) | ((bits >> 13) & 0x3ff));
+  }
+
+  void Test(size_t M, size_t N, size_t K, float alpha, float beta, bool trans_a, bool trans_b) {
+    const size_t lda = trans_a ? M : K;
+    const size_t ldb = trans_b ? K : N;
+
+    MLAS_FP16* A = BufferA.GetBuffer(M * K);
+    MLAS_FP16* B = BufferB.GetBuffer(K * N);
+    MLAS_FP16* C = BufferC.GetBuffer(M * N);
+    float* CReference = BufferCReference.GetBuffer(M * N);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K + 1));
+    std::uniform_int_distribution<int> distribution(-8, 8);
+
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = FloatToHalf(distribution(generator) * 0.25f);
+    }
+    for (size_t i = 0; i < K * N; i++) {
+      B[i] = FloatToHalf(distribution(generator) * 0.25f);
+    }
+    for (size_t i = 0; i < M * N; i++) {
+      C[i] = FloatToHalf(distribution(generator) * 0.5f);
+    }
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const float a = HalfToFloat(trans_a ? A[k * lda + m] : A[m * lda + k]);
+          const float b = HalfToFloat(trans_b ? B[n * ldb + k] : B[k * ldb + n]);
+          sum += double(a) * double(b);
+        }
+        CReference[m * N + n] = float(alpha * sum + beta * HalfToFloat(C[m * N + n]));
+      }
+    }
+
+    MlasHalfGemm(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
+                 M, N, K, alpha, A, lda, B, ldb, beta, C, N, threadpool_);
+
+    //
+    // Products may be accumulated in half precision, so allow for a rounding
+    // error that grows with the length of the inner dimension.
+    //
+
+    const float AbsoluteTolerance = 0.25f * (1.0f + float(K) / 32.0f);
+    constexpr float RelativeTolerance = 1.0f / 256.0f;
+
+    for (size_t i = 0; i < M * N; i++) {
+      const float value = HalfToFloat(C[i]);
+      const float diff = std::fabs(value - CReference[i]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(CReference[i]) * RelativeTolerance)
+          << " @" << i << " of " << M << "x" << N << "x" << K << ", trans_a=" << trans_a
+          << ", trans_b=" << trans_b << ", alpha=" << alpha << ", beta=" << beta
+          << ", got: " << value << ", expecting: " << CReference[i];
+    }
+  }
+
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasHalfGemmTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("HalfGemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t sizes[] = {1, 3, 16, 17, 33, 67, 130};
+    for (bool trans_a : {false, true}) {
+      for (bool trans_b : {false, true}) {
+        for (size_t M : sizes) {
+          for (size_t N : sizes) {
+            for (size_t K : {size_t(1), size_t(7), size_t(129)}) {
+              Test(M, N, K, 1.0f, 0.0f, trans_a, trans_b);
+              Test(M, N, K, 0.5f, 1.0f, trans_a, trans_b);
+            }
+          }
+        }
+      }
+    }
+    Test(5, 7, 0, 1.0f, 0.5f, false, false);
+  }
+};
+
+template <> MlasHalfGemmTest* MlasTestFixture<MlasHalfGemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasHalfGemmTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <vector>
+
+class MlasQ4GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferQuantBData;
+  MatrixGuardBuffer<float> BufferQuantBScale;
+  MatrixGuardBuffer<uint8_t> BufferQuantBZeroPoint;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  void Test(size_t M, size_t N, size_t K, size_t BatchSize, size_t BlockSize, bool has_zero_point, bool has_bias) {
+    const size_t BlockCountK = (K + BlockSize - 1) / BlockSize;
+    const size_t BlobSize = BlockSize / 2;
+    const size_t ZeroPointStride = (BlockCountK + 1) / 2;
+
+    float* A = BufferA.GetBuffer(M * K * BatchSize);
+    uint8_t* QuantBData = BufferQuantBData.GetBuffer(N * BlockCountK * BlobSize);
+    float* QuantBScale = BufferQuantBScale.GetBuffer(N * BlockCountK);
+    uint8_t* QuantBZeroPoint = BufferQuantBZeroPoint.GetBuffer(N * ZeroPointStride);
+    float* Bias = BufferBias.GetBuffer(N);
+    float* C = BufferC.GetBuffer(M * N * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(M * N * BatchSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K + BlockSize));
+    std::uniform_int_distribution<int> distribution(-8, 8);
+    std::uniform_int_distribution<int> byte_distribution(0, 255);
+
+    for (size_t i = 0; i < M * K * BatchSize; i++) {
+      A[i] = distribution(generator) * 0.25f;
+    }
+    for (size_t i = 0; i < N * BlockCountK * BlobSize; i++) {
+      QuantBData[i] = static_cast<uint8_t>(byte_distribution(generator));
+    }
+    for (size_t i = 0; i < N * BlockCountK; i++) {
+      QuantBScale[i] = distribution(generator) * 0.125f;
+    }
+    for (size_t i = 0; i < N * ZeroPointStride; i++) {
+      QuantBZeroPoint[i] = static_cast<uint8_t>(byte_distribution(generator));
+    }
+    for (size_t i = 0; i < N; i++) {
+      Bias[i] = distribution(generator) * 0.5f;
+    }
+
+    // the dequantized values of matrix B are exact in float
+    std::vector<float> B(K * N);
+    for (size_t n = 0; n < N; n++) {
+      for (size_t k = 0; k < K; k++) {
+        const size_t block = k / BlockSize;
+        const uint8_t pair = QuantBData[(n * BlockCountK + block) * BlobSize + (k % BlockSize) / 2];
+        const int value = (k & 1) ? (pair >> 4) : (pair & 0x0F);
+        int zero_point = 8;
+        if (has_zero_point) {
+          const uint8_t zero_point_pair = QuantBZeroPoint[n * ZeroPointStride + block / 2];
+          zero_point = (block & 1) ? (zero_point_pair >> 4) : (zero_point_pair & 0x0F);
+        }
+        B[k * N + n] = (value - zero_point) * QuantBScale[n * BlockCountK + block];
+      }
+    }
+
+    std::vector<MLAS_Q4_GEMM_DATA_PARAMS> Data(BatchSize);
+
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      const float* a = A + batch * M * K;
+      float* c = C + batch * M * N;
+
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = has_bias ? Bias[n] : 0.0;
+          for (size_t k = 0; k < K; k++) {
+            sum += double(a[m * K + k]) * double(B[k * N + n]);
+          }
+          CReference[batch * M * N + m * N + n] = float(sum);
+          c[m * N + n] = -1.0f;
+        }
+      }
+
+      Data[batch].A = a;
+      Data[batch].lda = K;
+      Data[batch].QuantBData = QuantBData;
+      Data[batch].QuantBScale = QuantBScale;
+      Data[batch].QuantBZeroPoint = has_zero_point ? QuantBZeroPoint : nullptr;
+      Data[batch].Bias = has_bias ? Bias : nullptr;
+      Data[batch].C = c;
+      Data[batch].ldc = N;
+    }
+
+    MlasQ4GemmBatch(M, N, K, BlockSize, Data.data(), BatchSize, threadpool_);
+
+    for (size_t i = 0; i < M * N * BatchSize; i++) {
+      const float diff = std::fabs(C[i] - CReference[i]);
+      ASSERT_TRUE(diff <= 1e-4f * (1.0f + std::fabs(CReference[i])))
+          << " @" << i << " of " << M << "x" << N << "x" << K << " batch " << BatchSize
+          << ", block size " << BlockSize << ", zero point=" << has_zero_point << ", bias=" << has_bias
+          << ", got: " << C[i] << ", expecting: " << CReference[i];
+    }
+  }
+
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasQ4GemmTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Q4Gemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    ASSERT_FALSE(MlasQ4GemmIsBlockSizeSupported(8));
+    ASSERT_FALSE(MlasQ4GemmIsBlockSizeSupported(48));
+    ASSERT_FALSE(MlasQ4GemmIsBlockSizeSupported(512));
+
+    for (size_t BlockSize : {size_t(16), size_t(32), size_t(64), size_t(128), size_t(256)}) {
+      ASSERT_TRUE(MlasQ4GemmIsBlockSizeSupported(BlockSize));
+      for (bool has_zero_point : {false, true}) {
+        // the direct kernels handle up to 15 rows, the dequantized panels handle the rest
+        for (size_t M : {size_t(1), size_t(3), size_t(8), size_t(17), size_t(67)}) {
+          for (size_t N : {size_t(1), size_t(7), size_t(48), size_t(130)}) {
+            for (size_t K : {size_t(16), size_t(100), size_t(320)}) {
+              Test(M, N, K, 1, BlockSize, has_zero_point, false);
+              Test(M, N, K, 1, BlockSize, has_zero_point, true);
+            }
+          }
+        }
+      }
+      Test(5, 64, 96, 3, BlockSize, true, true);
+      Test(33, 64, 96, 3, BlockSize, false, true);
+    }
+  }
+};
+
+template <> MlasQ4GemmTest* MlasTestFixture<MlasQ4GemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasQ4GemmTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <vector>
+
+class MlasQDWConvRequantizeTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferInput;
+  MatrixGuardBuffer<uint8_t> BufferFilter;
+  MatrixGuardBuffer<int32_t> BufferBias;
+  MatrixGuardBuffer<float> BufferScale;
+  MatrixGuardBuffer<int32_t> BufferAccumulators;
+  MatrixGuardBuffer<uint8_t> BufferOutput;
+  MatrixGuardBuffer<uint8_t> BufferOutputReference;
+
+  void Test(size_t Channels, size_t OutputCount, size_t KernelSize, bool FilterIsSigned, bool HasBias,
+            bool PerChannelScale) {
+    // Every output reads its own KernelSize input vectors plus one shared padding vector.
+    uint8_t* Input = BufferInput.GetBuffer((OutputCount * KernelSize + 1) * Channels);
+    uint8_t* Filter = BufferFilter.GetBuffer(KernelSize * Channels);
+    int32_t* Bias = BufferBias.GetBuffer(Channels);
+    float* Scale = BufferScale.GetBuffer(Channels);
+    int32_t* Accumulators = BufferAccumulators.GetBuffer(OutputCount * Channels);
+    uint8_t* Output = BufferOutput.GetBuffer(OutputCount * Channels);
+    uint8_t* OutputReference = BufferOutputReference.GetBuffer(OutputCount * Channels);
+
+    std::default_random_engine generator(static_cast<unsigned>(Channels * OutputCount * KernelSize));
+    std::uniform_int_distribution<int> byte_distribution(0, 255);
+    std::uniform_int_distribution<int> bias_distribution(-20000, 20000);
+    std::uniform_real_distribution<float> scale_distribution(0.0001f, 0.01f);
+
+    for (size_t i = 0; i < (OutputCount * KernelSize + 1) * Channels; i++) {
+      Input[i] = static_cast<uint8_t>(byte_distribution(generator));
+    }
+    for (size_t i = 0; i < KernelSize * Channels; i++) {
+      Filter[i] = static_cast<uint8_t>(byte_distribution(generator));
+    }
+    for (size_t i = 0; i < Channels; i++) {
+      Bias[i] = bias_distribution(generator);
+      Scale[i] = scale_distribution(generator);
+    }
+
+    const uint8_t InputZeroPoint = static_cast<uint8_t>(byte_distribution(generator));
+    const uint8_t FilterZeroPoint = FilterIsSigned ? 0 : static_cast<uint8_t>(byte_distribution(generator));
+    const uint8_t OutputZeroPoint = static_cast<uint8_t>(byte_distribution(generator));
+
+    const uint8_t* Padding = Input + OutputCount * KernelSize * Channels;
+    std::vector<const uint8_t*> Indirection(OutputCount * KernelSize);
+    for (size_t i = 0; i < OutputCount * KernelSize; i++) {
+      Indirection[i] = (i % 7 == 3) ? Padding : Input + i * Channels;
+    }
+
+    // The fused routine must match the int32_t accumulators requantized by MlasRequantizeOutput bit for bit.
+    MlasConvDepthwise(Indirection.data(), InputZeroPoint, Filter, FilterZeroPoint, FilterIsSigned, Accumulators,
+                      Channels, OutputCount, KernelSize);
+    MlasRequantizeOutput(Accumulators, OutputReference, HasBias ? Bias : nullptr, OutputCount, Channels, Scale,
+                         PerChannelScale, OutputZeroPoint);
+
+    MlasConvDepthwise(Indirection.data(), InputZeroPoint, Filter, FilterZeroPoint, FilterIsSigned,
+                      HasBias ? Bias : nullptr, Scale, PerChannelScale, OutputZeroPoint, Output, Channels,
+                      OutputCount, KernelSize);
+
+    for (size_t i = 0; i < OutputCount * Channels; i++) {
+      ASSERT_EQ(Output[i], OutputReference[i])
+          << " @" << i << " of " << Channels << " channels x " << OutputCount << " outputs, kernel size "
+          << KernelSize << ", signed filter=" << FilterIsSigned << ", bias=" << HasBias
+          << ", per channel scale=" << PerChannelScale;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("QDWConvRequantize");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t KernelSize : {size_t(9), size_t(25), size_t(1), size_t(3), size_t(7)}) {
+      for (size_t Channels : {size_t(1), size_t(7), size_t(8), size_t(16), size_t(27), size_t(96), size_t(1100)}) {
+        Test(Channels, 5, KernelSize, true, true, false);
+        Test(Channels, 3, KernelSize, false, true, true);
+        Test(Channels, 1, KernelSize, true, false, true);
+      }
+    }
+  }
+};
+
+template <> MlasQDWConvRequantizeTest* MlasTestFixture<MlasQDWConvRequantizeTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasQDWConvRequantizeTest>::RegisterShortExecute() : 0;
+});
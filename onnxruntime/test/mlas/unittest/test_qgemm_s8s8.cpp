@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Packed, bool Threaded>
+class MlasQgemmS8S8Test : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<int8_t> BufferA;
+  MatrixGuardBuffer<int8_t> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<int8_t> BufferZeroPointB;
+  MatrixGuardBuffer<int32_t> BufferC;
+  MatrixGuardBuffer<int32_t> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t M, size_t N, size_t K, int8_t offa, int8_t offb, bool PerColumnZeroPoints) {
+    const int8_t* A = BufferA.GetBuffer(K * M);
+    const int8_t* B = BufferB.GetBuffer(N * K);
+    const int8_t* ZeroPointB = BufferZeroPointB.GetBuffer(N);
+    int32_t* C = BufferC.GetBuffer(N * M);
+    int32_t* CReference = BufferCReference.GetBuffer(N * M);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const int32_t ZeroPoint = PerColumnZeroPoints ? ZeroPointB[n] : offb;
+        int32_t sum = 0;
+        for (size_t k = 0; k < K; k++) {
+          sum += (int32_t(A[m * K + k]) - offa) * (int32_t(B[k * N + n]) - ZeroPoint);
+        }
+        CReference[m * N + n] = sum;
+      }
+    }
+
+    MLAS_GEMM_U8X8_SHAPE_PARAMS GemmShape;
+    GemmShape.M = M;
+    GemmShape.N = N;
+    GemmShape.K = K;
+    GemmShape.AIsSigned = true;
+    GemmShape.BIsSigned = true;
+
+    MLAS_GEMM_U8X8_DATA_PARAMS GemmParameters;
+    GemmParameters.A = reinterpret_cast<const uint8_t*>(A);
+    GemmParameters.lda = K;
+    GemmParameters.ZeroPointA = static_cast<uint8_t>(offa);
+    GemmParameters.ZeroPointB = PerColumnZeroPoints ? reinterpret_cast<const uint8_t*>(ZeroPointB)
+                                                    : reinterpret_cast<const uint8_t*>(&offb);
+    GemmParameters.PerColumnZeroPoints = PerColumnZeroPoints;
+    GemmParameters.C = C;
+    GemmParameters.ldc = N;
+
+    if (Packed) {
+      size_t PackedBSize = MlasGemmPackBSize(N, K, true, true);
+      if (PackedBSize == 0) {
+        // Packing is not supported by the signed kernels on this platform.
+        return;
+      }
+      void* PackedB = BufferBPacked.GetBuffer(PackedBSize);
+      MlasGemmPackB(N, K, reinterpret_cast<const uint8_t*>(B), N, true, true, PackedB);
+      GemmParameters.B = PackedB;
+      GemmParameters.BIsPacked = true;
+    } else {
+      GemmParameters.B = B;
+      GemmParameters.ldb = N;
+    }
+
+    MlasGemm(GemmShape, GemmParameters, threadpool_);
+
+    for (size_t f = 0; f < M * N; f++) {
+      ASSERT_EQ(C[f], CReference[f]) << "@[" << f / N << "x" << f % N << "], "
+                                     << "M=" << M << ", N=" << N << ", K=" << K
+                                     << ", offa=" << int(offa) << ", offb=" << int(offb)
+                                     << ", PerColumnZeroPoints=" << PerColumnZeroPoints;
+    }
+  }
+
+ public:
+  MlasQgemmS8S8Test() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static std::string suite_name = std::string("QGemmS8S8") +
+                                    (Packed ? "_Int32_Packed" : "_Int32_NoPack") +
+                                    (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const int8_t zero_points[] = {-128, -17, 0, 5, 127};
+    static const size_t ms[] = {1, 2, 3, 4, 5, 16, 31};
+    static const size_t ns[] = {1, 3, 8, 15, 16, 17, 33, 160};
+    static const size_t ks[] = {1, 2, 3, 4, 7, 8, 9, 16, 31, 120, 257};
+
+    for (int8_t offa : zero_points) {
+      for (int8_t offb : zero_points) {
+        for (size_t M : ms) {
+          for (size_t N : ns) {
+            for (size_t K : ks) {
+              Test(M, N, K, offa, offb, false);
+            }
+          }
+        }
+      }
+    }
+
+    for (size_t M : ms) {
+      for (size_t N : ns) {
+        for (size_t K : ks) {
+          Test(M, N, K, 3, 0, true);
+        }
+      }
+    }
+  }
+};
+
+template <> MlasQgemmS8S8Test<false, false>* MlasTestFixture<MlasQgemmS8S8Test<false, false>>::mlas_tester(nullptr);
+template <> MlasQgemmS8S8Test<false, true>* MlasTestFixture<MlasQgemmS8S8Test<false, true>>::mlas_tester(nullptr);
+template <> MlasQgemmS8S8Test<true, false>* MlasTestFixture<MlasQgemmS8S8Test<true, false>>::mlas_tester(nullptr);
+template <> MlasQgemmS8S8Test<true, true>* MlasTestFixture<MlasQgemmS8S8Test<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQgemmS8S8Test<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQgemmS8S8Test<false, true>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQgemmS8S8Test<true, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQgemmS8S8Test<true, true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <vector>
+
+class MlasSBGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  void Test(size_t M, size_t N, size_t K, size_t BatchSize, float alpha, float beta, bool trans_a, bool trans_b) {
+    const size_t lda = trans_a ? M : K;
+    const size_t ldb = trans_b ? K : N;
+
+    float* A = BufferA.GetBuffer(M * K * BatchSize);
+    float* B = BufferB.GetBuffer(K * N * BatchSize);
+    uint8_t* PackedB = BufferPackedB.GetBuffer(MlasSBGemmPackBSize(N, K) * BatchSize);
+    float* C = BufferC.GetBuffer(M * N * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(M * N * BatchSize);
+
+    //
+    // The test data is restricted to values that are exactly representable
+    // in bfloat16, so the products are exact and only the order of the
+    // single precision accumulation differs from the reference.
+    //
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K + 1));
+    std::uniform_int_distribution<int> distribution(-8, 8);
+
+    for (size_t i = 0; i < M * K * BatchSize; i++) {
+      A[i] = distribution(generator) * 0.25f;
+    }
+    for (size_t i = 0; i < K * N * BatchSize; i++) {
+      B[i] = distribution(generator) * 0.25f;
+    }
+    for (size_t i = 0; i < M * N * BatchSize; i++) {
+      C[i] = distribution(generator) * 0.5f;
+    }
+
+    const size_t PackedBSize = MlasSBGemmPackBSize(N, K);
+    std::vector<MLAS_SGEMM_DATA_PARAMS> Data(BatchSize);
+
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      const float* a = A + batch * M * K;
+      const float* b = B + batch * K * N;
+      float* c = C + batch * M * N;
+
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = 0.0;
+          for (size_t k = 0; k < K; k++) {
+            const float av = trans_a ? a[k * lda + m] : a[m * lda + k];
+            const float bv = trans_b ? b[n * ldb + k] : b[k * ldb + n];
+            sum += double(av) * double(bv);
+          }
+          CReference[batch * M * N + m * N + n] = float(alpha * sum + beta * c[m * N + n]);
+        }
+      }
+
+      MlasSBGemmPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, b, ldb, PackedB + batch * PackedBSize);
+
+      Data[batch].A = a;
+      Data[batch].lda = lda;
+      Data[batch].B = reinterpret_cast<const float*>(PackedB + batch * PackedBSize);
+      Data[batch].C = c;
+      Data[batch].ldc = N;
+      Data[batch].alpha = alpha;
+      Data[batch].beta = beta;
+    }
+
+    MlasSBGemmBatch(trans_a ? CblasTrans : CblasNoTrans, M, N, K, Data.data(), BatchSize, threadpool_);
+
+    for (size_t i = 0; i < M * N * BatchSize; i++) {
+      const float diff = std::fabs(C[i] - CReference[i]);
+      ASSERT_TRUE(diff <= 1e-3f * (1.0f + std::fabs(CReference[i])))
+          << " @" << i << " of " << M << "x" << N << "x" << K << " batch " << BatchSize
+          << ", trans_a=" << trans_a << ", trans_b=" << trans_b << ", alpha=" << alpha << ", beta=" << beta
+          << ", got: " << C[i] << ", expecting: " << CReference[i];
+    }
+  }
+
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasSBGemmTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SBGemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t sizes[] = {1, 3, 8, 16, 17, 33, 67, 130};
+    for (bool trans_a : {false, true}) {
+      for (bool trans_b : {false, true}) {
+        for (size_t M : sizes) {
+          for (size_t N : sizes) {
+            for (size_t K : {size_t(1), size_t(7), size_t(64), size_t(129)}) {
+              Test(M, N, K, 1, 1.0f, 0.0f, trans_a, trans_b);
+              Test(M, N, K, 1, 0.5f, 1.0f, trans_a, trans_b);
+            }
+          }
+        }
+      }
+    }
+    Test(33, 70, 45, 3, 1.0f, 0.0f, false, false);
+    Test(5, 7, 0, 1, 1.0f, 0.5f, false, false);
+  }
+};
+
+template <> MlasSBGemmTest* MlasTestFixture<MlasSBGemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  size_t count = 0;
+  if (is_short_execute && MlasSBGemmIsSupported()) {
+    count += MlasDirectShortExecuteTests<MlasSBGemmTest>::RegisterShortExecute();
+  }
+  return count;
+});
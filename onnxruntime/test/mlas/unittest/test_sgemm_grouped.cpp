@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <vector>
+
+class MlasSgemmGroupedTest : public MlasTestBase {
+ private:
+  struct ProblemBuffers {
+    std::vector<float> A;
+    std::vector<float> B;
+    std::vector<float> C;
+    std::vector<float> CReference;
+  };
+
+  static void ReferenceGemm(const MLAS_SGEMM_GROUPED_PROBLEM& Problem, const float* A, const float* B,
+                            float* C) {
+    const size_t lda = Problem.Data.lda;
+    const size_t ldb = Problem.Data.ldb;
+    for (size_t m = 0; m < Problem.M; m++) {
+      for (size_t n = 0; n < Problem.N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < Problem.K; k++) {
+          const float a = Problem.TransA == CblasTrans ? A[k * lda + m] : A[m * lda + k];
+          const float b = Problem.TransB == CblasTrans ? B[n * ldb + k] : B[k * ldb + n];
+          sum += a * b;
+        }
+        float& c = C[m * Problem.Data.ldc + n];
+        c = Problem.Data.alpha * sum + (Problem.Data.beta == 0.0f ? 0.0f : Problem.Data.beta * c);
+      }
+    }
+  }
+
+  void Test(const std::vector<std::pair<size_t, size_t>>& MN, size_t K, bool trans_a, bool trans_b,
+            float beta, bool pack_b, unsigned seed) {
+    std::default_random_engine generator(seed);
+    std::uniform_int_distribution<int> distribution(-8, 8);
+    std::uniform_int_distribution<size_t> k_distribution(1, 2 * K);
+
+    const size_t ProblemCount = MN.size();
+    std::vector<ProblemBuffers> buffers(ProblemCount);
+    std::vector<MLAS_SGEMM_GROUPED_PROBLEM> problems(ProblemCount);
+
+    for (size_t i = 0; i < ProblemCount; i++) {
+      MLAS_SGEMM_GROUPED_PROBLEM& problem = problems[i];
+      ProblemBuffers& buffer = buffers[i];
+
+      // every problem has its own inner dimension
+      problem.TransA = trans_a ? CblasTrans : CblasNoTrans;
+      problem.TransB = trans_b ? CblasTrans : CblasNoTrans;
+      problem.M = MN[i].first;
+      problem.N = MN[i].second;
+      problem.K = k_distribution(generator);
+
+      buffer.A.resize(problem.M * problem.K);
+      buffer.B.resize(problem.K * problem.N);
+      buffer.C.resize(problem.M * problem.N);
+      for (auto& a : buffer.A) a = distribution(generator) * 0.25f;
+      for (auto& b : buffer.B) b = distribution(generator) * 0.25f;
+      for (auto& c : buffer.C) c = distribution(generator) * 0.5f;
+      buffer.CReference = buffer.C;
+
+      problem.Data.A = buffer.A.data();
+      problem.Data.lda = trans_a ? problem.M : problem.K;
+      problem.Data.B = buffer.B.data();
+      problem.Data.ldb = trans_b ? problem.K : problem.N;
+      problem.Data.C = buffer.C.data();
+      problem.Data.ldc = problem.N;
+      problem.Data.alpha = 0.5f + float(i % 3);
+      problem.Data.beta = beta;
+
+      ReferenceGemm(problem, buffer.A.data(), buffer.B.data(), buffer.CReference.data());
+    }
+
+    if (pack_b) {
+      size_t PackedBSize = 0;
+      for (const auto& problem : problems) {
+        PackedBSize += MlasGemmPackBSize(problem.N, problem.K);
+      }
+      uint8_t* PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+      for (auto& problem : problems) {
+        if (problem.N == 0) {
+          continue;
+        }
+        MlasGemmPackB(problem.TransB, problem.N, problem.K, problem.Data.B, problem.Data.ldb, PackedB);
+        problem.Data.B = reinterpret_cast<const float*>(PackedB);
+        problem.Data.BIsPacked = true;
+        PackedB += MlasGemmPackBSize(problem.N, problem.K);
+      }
+    }
+
+    MlasGemmGrouped(problems.data(), ProblemCount, threadpool_);
+
+    for (size_t i = 0; i < ProblemCount; i++) {
+      const MLAS_SGEMM_GROUPED_PROBLEM& problem = problems[i];
+      for (size_t j = 0; j < problem.M * problem.N; j++) {
+        ASSERT_EQ(buffers[i].C[j], buffers[i].CReference[j])
+            << " @" << j << " of problem " << i << " (" << problem.M << "x" << problem.N << "x" << problem.K
+            << "), trans_a=" << trans_a << ", trans_b=" << trans_b << ", beta=" << beta << ", pack_b=" << pack_b;
+      }
+    }
+  }
+
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasSgemmGroupedTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SgemmGrouped");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // many tiny problems, fewer problems than threads, and a mix with an empty output
+    const std::vector<std::vector<std::pair<size_t, size_t>>> groups = {
+        {{1, 1}},
+        {{1, 16}, {2, 33}, {4, 7}, {1, 64}, {3, 3}, {8, 17}, {1, 1}, {5, 80},
+         {1, 16}, {2, 33}, {4, 7}, {1, 64}, {3, 3}, {8, 17}, {1, 1}, {5, 80}},
+        {{256, 96}, {64, 512}},
+        {{128, 300}, {0, 16}, {7, 1}, {33, 0}, {300, 129}},
+    };
+
+    unsigned seed = 1;
+    for (const auto& MN : groups) {
+      for (bool trans_a : {false, true}) {
+        for (bool trans_b : {false, true}) {
+          for (bool pack_b : {false, true}) {
+            for (size_t K : {size_t(3), size_t(70)}) {
+              Test(MN, K, trans_a, trans_b, 0.0f, pack_b, seed++);
+              Test(MN, K, trans_a, trans_b, 1.0f, pack_b, seed++);
+              Test(MN, K, trans_a, trans_b, 0.5f, pack_b, seed++);
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+template <> MlasSgemmGroupedTest* MlasTestFixture<MlasSgemmGroupedTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasSgemmGroupedTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <vector>
+
+class MlasSgemmTuningTest : public MlasTestBase {
+ private:
+  void Test(size_t M, size_t N, size_t K, bool trans_a, bool trans_b, float beta, unsigned seed) {
+    std::default_random_engine generator(seed);
+    std::uniform_int_distribution<int> distribution(-8, 8);
+
+    std::vector<float> A(M * K);
+    std::vector<float> B(K * N);
+    std::vector<float> C(M * N);
+    for (auto& a : A) a = distribution(generator) * 0.25f;
+    for (auto& b : B) b = distribution(generator) * 0.25f;
+    for (auto& c : C) c = distribution(generator) * 0.5f;
+
+    const size_t lda = trans_a ? M : K;
+    const size_t ldb = trans_b ? K : N;
+
+    std::vector<float> CReference(C);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          sum += (trans_a ? A[k * lda + m] : A[m * lda + k]) * (trans_b ? B[n * ldb + k] : B[k * ldb + n]);
+        }
+        float& c = CReference[m * N + n];
+        c = sum + (beta == 0.0f ? 0.0f : beta * c);
+      }
+    }
+
+    MlasGemm(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans, M, N, K, 1.0f,
+             A.data(), lda, B.data(), ldb, beta, C.data(), N, threadpool_);
+
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_EQ(C[i], CReference[i]) << " @" << i << " (" << M << "x" << N << "x" << K << "), trans_a=" << trans_a
+                                     << ", trans_b=" << trans_b << ", beta=" << beta;
+    }
+  }
+
+  void TestAllShapes(unsigned& seed) {
+    for (bool trans_a : {false, true}) {
+      for (bool trans_b : {false, true}) {
+        Test(3, 300, 5, trans_a, trans_b, 0.0f, seed++);
+        Test(17, 40, 600, trans_a, trans_b, 1.0f, seed++);
+        Test(64, 129, 257, trans_a, trans_b, 0.5f, seed++);
+      }
+    }
+  }
+
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasSgemmTuningTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SgemmTuning");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    MLAS_SGEMM_TUNING_PARAMETERS Default;
+    MlasSgemmGetTuningParameters(&Default);
+
+    // strides must be powers of two of at least 16 that fit the packing buffer
+    const size_t InvalidParameters[][3] = {
+        {0, 128, 65536}, {24, 128, 65536}, {128, 8, 65536}, {256, 256, 65536}, {128, 128, 0}};
+    for (const auto& Invalid : InvalidParameters) {
+      MLAS_SGEMM_TUNING_PARAMETERS Parameters;
+      Parameters.StrideN = Invalid[0];
+      Parameters.StrideK = Invalid[1];
+      Parameters.ThreadComplexity = Invalid[2];
+      EXPECT_FALSE(MlasSgemmSetTuningParameters(&Parameters));
+
+      MLAS_SGEMM_TUNING_PARAMETERS Current;
+      MlasSgemmGetTuningParameters(&Current);
+      EXPECT_EQ(Current.StrideN, Default.StrideN);
+      EXPECT_EQ(Current.StrideK, Default.StrideK);
+      EXPECT_EQ(Current.ThreadComplexity, Default.ThreadComplexity);
+    }
+
+    unsigned seed = 1;
+    const size_t ValidParameters[][3] = {
+        {256, 64, 65536}, {64, 256, 16384}, {16, 1024, 1024}, {32, 32, 1 << 20}};
+    for (const auto& Valid : ValidParameters) {
+      MLAS_SGEMM_TUNING_PARAMETERS Parameters;
+      Parameters.StrideN = Valid[0];
+      Parameters.StrideK = Valid[1];
+      Parameters.ThreadComplexity = Valid[2];
+      ASSERT_TRUE(MlasSgemmSetTuningParameters(&Parameters));
+      TestAllShapes(seed);
+    }
+
+    MLAS_SGEMM_TUNING_PARAMETERS Tuned;
+    MlasSgemmAutoTune(threadpool_, &Tuned);
+
+    MLAS_SGEMM_TUNING_PARAMETERS Current;
+    MlasSgemmGetTuningParameters(&Current);
+    EXPECT_EQ(Current.StrideN, Tuned.StrideN);
+    EXPECT_EQ(Current.StrideK, Tuned.StrideK);
+    EXPECT_EQ(Current.ThreadComplexity, Tuned.ThreadComplexity);
+    TestAllShapes(seed);
+
+    MlasSgemmSetTuningParameters(&Default);
+  }
+};
+
+template <> MlasSgemmTuningTest* MlasTestFixture<MlasSgemmTuningTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasSgemmTuningTest>::RegisterShortExecute() : 0;
+});
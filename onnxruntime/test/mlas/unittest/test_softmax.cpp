@@ -97,15 +97,102 @@ class MlasSoftmaxTest : public MlasTestBase {
   }
 };
 
+template <bool Threaded>
+class MlasSoftmaxStridedTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t N, size_t D, size_t Stride, float MinimumValue, float MaximumValue) {
+    const size_t Count = N * D * Stride;
+    float* Input = BufferInput.GetBuffer(Count);
+    float* Output = BufferOutput.GetBuffer(Count);
+    float* OutputReference = BufferOutputReference.GetBuffer(Count);
+
+    std::default_random_engine generator(static_cast<unsigned>(Count));
+    std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+    for (size_t i = 0; i < Count; i++) {
+      Input[i] = distribution(generator);
+    }
+
+    for (bool LogSoftmax : {false, true}) {
+      MlasComputeSoftmaxStrided(Input, Output, N, D, Stride, LogSoftmax, threadpool_);
+      ReferenceSoftmax(Input, OutputReference, N, D, Stride, LogSoftmax);
+
+      constexpr float AbsoluteTolerance = 1e-5f;
+      constexpr float RelativeTolerance = 1e-5f;
+
+      for (size_t i = 0; i < Count; i++) {
+        float diff = std::fabs(Output[i] - OutputReference[i]);
+        ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[i]) * RelativeTolerance)
+            << "LogSoftmax:" << (int)LogSoftmax << " difference " << N << "/" << D << "/" << Stride
+            << ", got: " << Output[i] << ", expecting: " << OutputReference[i];
+      }
+    }
+  }
+
+  void ReferenceSoftmax(const float* Input, float* Output, size_t N, size_t D, size_t Stride, bool LogSoftmax) {
+    for (size_t n = 0; n < N; n++) {
+      for (size_t s = 0; s < Stride; s++) {
+        const float* input = Input + n * D * Stride + s;
+        float* output = Output + n * D * Stride + s;
+
+        float MaximumValue = std::numeric_limits<float>::lowest();
+
+        for (size_t d = 0; d < D; d++) {
+          MaximumValue = (std::max)(MaximumValue, input[d * Stride]);
+        }
+
+        double Sum = 0.0;
+
+        for (size_t d = 0; d < D; d++) {
+          Sum += std::exp(double(input[d * Stride]) - double(MaximumValue));
+        }
+
+        for (size_t d = 0; d < D; d++) {
+          double Value = double(input[d * Stride]) - double(MaximumValue);
+          output[d * Stride] = float(LogSoftmax ? Value - std::log(Sum) : std::exp(Value) / Sum);
+        }
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SoftmaxStrided_Threaded" : "SoftmaxStrided_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasSoftmaxStridedTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) { }
+
+  void ExecuteShort(void) override {
+    for (size_t Stride : {size_t(1), size_t(2), size_t(3), size_t(4), size_t(15), size_t(16), size_t(17), size_t(64),
+                          size_t(65), size_t(200)}) {
+      Test(1, 7, Stride, -10.f, 10.f);
+      Test(3, 1, Stride, -10.f, 10.f);
+      Test(2, 33, Stride, -150.f, 190.f);
+    }
+
+    Test(4, 1000, 49, 20.f, 30.f);
+  }
+};
+
 template <> MlasSoftmaxTest<false>* MlasTestFixture<MlasSoftmaxTest<false>>::mlas_tester(nullptr);
 template <> MlasSoftmaxTest<true>* MlasTestFixture<MlasSoftmaxTest<true>>::mlas_tester(nullptr);
+template <> MlasSoftmaxStridedTest<false>* MlasTestFixture<MlasSoftmaxStridedTest<false>>::mlas_tester(nullptr);
+template <> MlasSoftmaxStridedTest<true>* MlasTestFixture<MlasSoftmaxStridedTest<true>>::mlas_tester(nullptr);
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
   if (is_short_execute) {
     count += MlasDirectShortExecuteTests<MlasSoftmaxTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSoftmaxStridedTest<false>>::RegisterShortExecute();
     if (GetMlasThreadPool() != nullptr) {
       count += MlasDirectShortExecuteTests<MlasSoftmaxTest<true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasSoftmaxStridedTest<true>>::RegisterShortExecute();
     }
   }
   return count;
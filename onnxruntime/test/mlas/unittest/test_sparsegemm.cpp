@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <vector>
+
+class MlasSparseGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+  //
+  // Builds matrix B (K rows, N columns, stored transposed if trans_b) where
+  // each block of block_k x block_n values is zero unless it is one of the
+  // kept blocks, one in keep_every.
+  //
+
+  void BuildB(float* B, size_t N, size_t K, bool trans_b, size_t block_k, size_t block_n, size_t keep_every,
+              std::default_random_engine& generator) {
+    std::uniform_int_distribution<int> distribution(-8, 8);
+    std::uniform_int_distribution<size_t> keep_distribution(0, keep_every - 1);
+    const size_t ldb = trans_b ? K : N;
+
+    for (size_t k0 = 0; k0 < K; k0 += block_k) {
+      for (size_t n0 = 0; n0 < N; n0 += block_n) {
+        const bool keep = keep_distribution(generator) == 0;
+        for (size_t k = k0; k < k0 + block_k; k++) {
+          for (size_t n = n0; n < n0 + block_n; n++) {
+            const float value = keep ? distribution(generator) * 0.25f : 0.0f;
+            (trans_b ? B[n * ldb + k] : B[k * ldb + n]) = value;
+          }
+        }
+      }
+    }
+  }
+
+  void Test(size_t M, size_t N, size_t K, size_t BatchSize, float alpha, float beta, bool trans_a, bool trans_b,
+            size_t block_k, size_t block_n) {
+    const size_t lda = trans_a ? M : K;
+    const size_t ldb = trans_b ? K : N;
+
+    float* A = BufferA.GetBuffer(M * K * BatchSize);
+    float* B = BufferB.GetBuffer(K * N * BatchSize);
+    float* C = BufferC.GetBuffer(M * N * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(M * N * BatchSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K + block_k * 31 + block_n));
+    std::uniform_int_distribution<int> distribution(-8, 8);
+
+    for (size_t i = 0; i < M * K * BatchSize; i++) {
+      A[i] = distribution(generator) * 0.25f;
+    }
+    for (size_t i = 0; i < M * N * BatchSize; i++) {
+      C[i] = distribution(generator) * 0.5f;
+    }
+
+    //
+    // One in eight blocks is kept, so the density is well below the limit.
+    //
+
+    std::vector<size_t> PackedBSizes(BatchSize);
+    std::vector<size_t> PackedBOffsets(BatchSize + 1, 0);
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      float* b = B + batch * K * N;
+      BuildB(b, N, K, trans_b, block_k, block_n, 8, generator);
+
+      const size_t PackedBSize = MlasSparseGemmPackBSize(trans_b ? CblasTrans : CblasNoTrans, N, K, b, ldb,
+                                                         0.0f, 0.5f);
+      ASSERT_NE(PackedBSize, size_t(0)) << " " << M << "x" << N << "x" << K << " block " << block_k << "x" << block_n;
+      PackedBSizes[batch] = PackedBSize;
+      PackedBOffsets[batch + 1] = PackedBOffsets[batch] + (PackedBSize + 63) / 64 * 64;
+    }
+
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBOffsets[BatchSize]);
+    std::vector<MLAS_SGEMM_DATA_PARAMS> Data(BatchSize);
+
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      const float* a = A + batch * M * K;
+      const float* b = B + batch * K * N;
+      float* c = C + batch * M * N;
+
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = 0.0;
+          for (size_t k = 0; k < K; k++) {
+            const float av = trans_a ? a[k * lda + m] : a[m * lda + k];
+            const float bv = trans_b ? b[n * ldb + k] : b[k * ldb + n];
+            sum += double(av) * double(bv);
+          }
+          CReference[batch * M * N + m * N + n] = float(alpha * sum + beta * c[m * N + n]);
+        }
+      }
+
+      void* packed_b = PackedB + PackedBOffsets[batch];
+      MlasSparseGemmPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, b, ldb, 0.0f, 0.5f, packed_b);
+      ASSERT_TRUE(MlasSparseGemmIsPackedB(packed_b, PackedBSizes[batch], N, K));
+
+      Data[batch].A = a;
+      Data[batch].lda = lda;
+      Data[batch].B = reinterpret_cast<const float*>(packed_b);
+      Data[batch].C = c;
+      Data[batch].ldc = N;
+      Data[batch].alpha = alpha;
+      Data[batch].beta = beta;
+    }
+
+    MlasSparseGemmBatch(trans_a ? CblasTrans : CblasNoTrans, M, N, K, Data.data(), BatchSize, threadpool_);
+
+    for (size_t i = 0; i < M * N * BatchSize; i++) {
+      const float diff = std::fabs(C[i] - CReference[i]);
+      ASSERT_TRUE(diff <= 1e-4f * (1.0f + std::fabs(CReference[i])))
+          << " @" << i << " of " << M << "x" << N << "x" << K << " batch " << BatchSize
+          << ", block " << block_k << "x" << block_n
+          << ", trans_a=" << trans_a << ", trans_b=" << trans_b << ", alpha=" << alpha << ", beta=" << beta
+          << ", got: " << C[i] << ", expecting: " << CReference[i];
+    }
+  }
+
+  void TestDense() {
+    const size_t N = 16;
+    const size_t K = 16;
+    float* B = BufferB.GetBuffer(K * N);
+    for (size_t i = 0; i < K * N; i++) {
+      B[i] = 1.0f + float(i % 5);
+    }
+
+    ASSERT_EQ(MlasSparseGemmPackBSize(CblasNoTrans, N, K, B, N, 0.0f, 0.5f), size_t(0));
+
+    // values at or below the zero threshold are dropped
+    ASSERT_NE(MlasSparseGemmPackBSize(CblasNoTrans, N, K, B, N, 5.0f, 0.5f), size_t(0));
+
+    // the block shapes must divide the matrix
+    ASSERT_EQ(MlasSparseGemmPackBSize(CblasNoTrans, 3, 5, B, 3, 0.0f, 1.0f), size_t(0));
+  }
+
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasSparseGemmTest() : threadpool_(GetMlasThreadPool()) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("SparseGemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t block_shapes[][2] = {{4, 4}, {16, 1}, {1, 4}};
+    for (const auto& block_shape : block_shapes) {
+      for (bool trans_a : {false, true}) {
+        for (bool trans_b : {false, true}) {
+          for (size_t M : {size_t(1), size_t(3), size_t(8), size_t(17), size_t(67)}) {
+            for (size_t N : {size_t(16), size_t(48), size_t(128)}) {
+              for (size_t K : {size_t(16), size_t(64), size_t(144)}) {
+                Test(M, N, K, 1, 1.0f, 0.0f, trans_a, trans_b, block_shape[0], block_shape[1]);
+                Test(M, N, K, 1, 0.5f, 1.0f, trans_a, trans_b, block_shape[0], block_shape[1]);
+              }
+            }
+          }
+        }
+      }
+      Test(33, 64, 48, 3, 1.0f, 0.0f, false, false, block_shape[0], block_shape[1]);
+    }
+    TestDense();
+  }
+};
+
+template <> MlasSparseGemmTest* MlasTestFixture<MlasSparseGemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasSparseGemmTest>::RegisterShortExecute() : 0;
+});
@@ -22,10 +22,34 @@ class MlasTransposeTest : public MlasTestBase {
     ASSERT_EQ(memcmp(Output, OutputReference, M * N * sizeof(ElementType)), 0) << " [" << M << "," << N << "]";
   }
 
+  // Transposes a M x N tile out of a (M + 3) x (N + 5) input matrix into a (N + 2) x (M + 7) output matrix.
+  void
+  TestStrided(size_t M, size_t N) {
+    const size_t InputStride = N + 5;
+    const size_t OutputStride = M + 7;
+    const size_t InputSize = (M + 3) * InputStride;
+    const size_t OutputSize = (N + 2) * OutputStride;
+
+    ElementType* Input = BufferInput.GetBuffer(InputSize);
+    ElementType* Output = BufferOutput.GetBuffer(OutputSize, true);
+    ElementType* OutputReference = BufferOutputReference.GetBuffer(OutputSize, true);
+
+    MlasTranspose(Input, InputStride, Output, OutputStride, M, N);
+    ReferenceTranspose(Input, InputStride, OutputReference, OutputStride, M, N);
+
+    ASSERT_EQ(memcmp(Output, OutputReference, OutputSize * sizeof(ElementType)), 0)
+        << " [" << M << "," << N << "] strided";
+  }
+
   void ReferenceTranspose(const ElementType* Input, ElementType* Output, size_t M, size_t N) {
+    ReferenceTranspose(Input, N, Output, M, M, N);
+  }
+
+  void ReferenceTranspose(const ElementType* Input, size_t InputStride, ElementType* Output, size_t OutputStride,
+                          size_t M, size_t N) {
     for (size_t m = 0; m < M; m++) {
       for (size_t n = 0; n < N; n++) {
-        Output[n * M + m] = Input[m * N + n];
+        Output[n * OutputStride + m] = Input[m * InputStride + n];
       }
     }
   }
@@ -40,18 +64,23 @@ class MlasTransposeTest : public MlasTestBase {
     for (size_t m = 1; m <= 32; m++) {
       for (size_t n = 1; n <= 32; n++) {
         Test(m, n);
+        TestStrided(m, n);
       }
     }
   }
 };
 
+template <> MlasTransposeTest<uint64_t>* MlasTestFixture<MlasTransposeTest<uint64_t>>::mlas_tester(nullptr);
 template <> MlasTransposeTest<uint32_t>* MlasTestFixture<MlasTransposeTest<uint32_t>>::mlas_tester(nullptr);
+template <> MlasTransposeTest<uint16_t>* MlasTestFixture<MlasTransposeTest<uint16_t>>::mlas_tester(nullptr);
 template <> MlasTransposeTest<uint8_t>* MlasTestFixture<MlasTransposeTest<uint8_t>>::mlas_tester(nullptr);
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
   if (is_short_execute) {
+      count += MlasDirectShortExecuteTests<MlasTransposeTest<uint64_t>>::RegisterShortExecute();
       count += MlasDirectShortExecuteTests<MlasTransposeTest<uint32_t>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasTransposeTest<uint16_t>>::RegisterShortExecute();
       count += MlasDirectShortExecuteTests<MlasTransposeTest<uint8_t>>::RegisterShortExecute();
   }
   return count;
@@ -319,7 +319,10 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
           0,
           nullptr,
           0,
-          0};
+          0,
+          nullptr,
+          nullptr,
+          nullptr};
 
       OrtCUDAProviderOptions cuda_options{
           0,
@@ -5,6 +5,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <atomic>
 #include <random>
 #include "core/graph/onnx_protobuf.h"
 
@@ -14,6 +15,7 @@
 #include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/optimizer/activation_storage_compression.h"
 #include "core/optimizer/attention_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
@@ -30,13 +32,16 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/gelu_approximation.h"
 #include "core/optimizer/gelu_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
 #include "core/optimizer/gemm_transpose_fusion.h"
+#include "core/optimizer/grouped_matmul_fusion.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/graph_transformer_utils.h"
@@ -59,6 +64,7 @@
 #include "core/optimizer/propagate_cast_ops.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math.h"
@@ -67,6 +73,7 @@
 #include "test/common/tensor_op_test_utils.h"
 #include "test/compare_ortvalue.h"
 #include "test/framework/test_utils.h"
+#include "test/optimizer/graph_transform_test_builder.h"
 #include "test/optimizer/graph_transform_test_fixture.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/test_environment.h"
@@ -329,6 +336,204 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingWithThreadPool) {
+  auto model_uri = MODEL_FOLDER "fusion/fuse-conv-bn-mul-add-unsqueeze.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Unsqueeze"] == 2);
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/), TransformerLevel::Level1);
+
+  // the independent constant nodes are computed concurrently
+  concurrency::ThreadPool tp(&onnxruntime::Env::Default(), ThreadOptions(), ORT_TSTR("ConstantFolding"), 4, true);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_, &tp));
+
+  op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Unsqueeze"] == 0);
+}
+
+namespace {
+// Builds Y = Expand(C, [512, 1024]) + X where C has 1024 floats, so folding the Expand turns a 4 KB initializer
+// into a 2 MB one.
+void BuildExpandAddGraph(Graph& graph) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* shape = float_tensor_type.mutable_tensor_type()->mutable_shape();
+  shape->add_dim()->set_dim_value(512);
+  shape->add_dim()->set_dim_value(1024);
+
+  TensorProto c;
+  c.set_name("C");
+  c.set_data_type(TensorProto_DataType_FLOAT);
+  c.add_dims(1);
+  c.add_dims(1024);
+  for (int i = 0; i < 1024; ++i) {
+    c.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(c);
+
+  TensorProto expand_shape;
+  expand_shape.set_name("expand_shape");
+  expand_shape.set_data_type(TensorProto_DataType_INT64);
+  expand_shape.add_dims(2);
+  expand_shape.add_int64_data(512);
+  expand_shape.add_int64_data(1024);
+  graph.AddInitializedTensor(expand_shape);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor_type);
+  auto& expanded = graph.GetOrCreateNodeArg("expanded", &float_tensor_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor_type);
+  graph.AddNode("expand", "Expand", "", {graph.GetNodeArg("C"), graph.GetNodeArg("expand_shape")}, {&expanded});
+  graph.AddNode("add", "Add", "", {&expanded, &x}, {&y});
+}
+}  // namespace
+
+TEST_F(GraphTransformationTests, ConstantFoldingMaxOutputToInputRatio) {
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+
+  for (float ratio : {0.f, 10.f}) {
+    Model model("ConstantFoldingMaxOutputToInputRatio", false, *logger_);
+    Graph& graph = model.MainGraph();
+    BuildExpandAddGraph(graph);
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    graph_transformation_mgr.Register(std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/,
+                                                                        std::unordered_set<std::string>{},
+                                                                        std::unordered_set<std::string>{}, ratio),
+                                      TransformerLevel::Level1);
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+    // with the limit the 2 MB output of the Expand is computed at run time instead of being stored
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Expand"], ratio > 0.f ? 1 : 0);
+  }
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingSpill) {
+  const std::string spill_directory = "constant_folding_spill_test_dir";
+  TemporaryDirectory temp_dir{ToPathString(spill_directory)};
+
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+
+  // the transformer owns the mapped spill files, so it must be destroyed before temp_dir
+  Model model("ConstantFoldingSpill", false, *logger_);
+  Graph& graph = model.MainGraph();
+  BuildExpandAddGraph(graph);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/,
+                                                                      std::unordered_set<std::string>{},
+                                                                      std::unordered_set<std::string>{}, 0.f,
+                                                                      spill_directory, 1024),
+                                    TransformerLevel::Level1);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Expand"], 0);
+
+  const TensorProto* expanded = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("expanded", expanded));
+  const void* data = nullptr;
+  size_t length = 0;
+  ASSERT_TRUE(utils::GetExternalDataMemoryAddress(*expanded, data, length));
+  ASSERT_EQ(length, 512 * 1024 * sizeof(float));
+
+  // every row of the expanded tensor is a copy of C
+  Initializer initializer(*expanded, graph.ModelPath());
+  const float* values = initializer.data<float>();
+  for (int row : {0, 511}) {
+    for (int col : {0, 1, 1023}) {
+      EXPECT_EQ(values[row * 1024 + col], static_cast<float>(col));
+    }
+  }
+}
+
+namespace {
+// Counts the graphs it is applied to
+class CountingTransformer : public GraphTransformer {
+ public:
+  CountingTransformer() noexcept : GraphTransformer("CountingTransformer") {}
+
+  bool SupportsParallelSubgraphs() const override { return true; }
+
+  mutable std::atomic<int> num_subgraphs{0};
+  mutable int num_main_graphs{0};
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override {
+    if (graph_level == 0) {
+      ++num_main_graphs;
+    } else {
+      ++num_subgraphs;
+    }
+
+    for (auto& node : graph.Nodes()) {
+      ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+    }
+    return Status::OK();
+  }
+};
+}  // namespace
+
+TEST_F(GraphTransformationTests, ParallelSubgraphs) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  GraphProto subgraph;
+  {
+    Model model("ParallelSubgraphs_subgraph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    auto& graph = model.MainGraph();
+    auto& parent_arg = graph.GetOrCreateNodeArg("parent_value", &float_tensor_type);
+    graph.AddOuterScopeNodeArg("parent_value");
+    auto& subgraph_out = graph.GetOrCreateNodeArg("subgraph_out", &float_tensor_type);
+    graph.AddNode("identity", "Identity", "Subgraph output", {&parent_arg}, {&subgraph_out});
+    ASSERT_STATUS_OK(graph.Resolve());
+    subgraph = graph.ToGraphProto();
+  }
+
+  Model model("ParallelSubgraphs_main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+  auto& parent_value = graph.GetOrCreateNodeArg("parent_value", &float_tensor_type);
+  TypeProto if_cond_type;
+  if_cond_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  if_cond_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  auto& if_cond_input = graph.GetOrCreateNodeArg("if_in", &if_cond_type);
+
+  constexpr int num_if_nodes = 4;
+  for (int i = 0; i < num_if_nodes; ++i) {
+    auto& if_output = graph.GetOrCreateNodeArg("if_out_" + std::to_string(i), &float_tensor_type);
+    auto& if_node = graph.AddNode("if_" + std::to_string(i), "If", "If node", {&if_cond_input}, {&if_output});
+    if_node.AddAttribute("then_branch", subgraph);
+    if_node.AddAttribute("else_branch", subgraph);
+  }
+  graph.AddNode("identity", "Identity", "Uses parent_value", {&graph.GetOrCreateNodeArg("parent_in", &float_tensor_type)}, {&parent_value});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto transformer = std::make_unique<CountingTransformer>();
+  const auto& counting_transformer = *transformer;
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(transformer), TransformerLevel::Level1));
+
+  // every subgraph is transformed once, either by the thread pool or by Recurse
+  concurrency::ThreadPool tp(&onnxruntime::Env::Default(), ThreadOptions(), ORT_TSTR("ParallelSubgraphs"), 4, true);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_, &tp));
+  EXPECT_EQ(counting_transformer.num_main_graphs, 1);
+  EXPECT_EQ(counting_transformer.num_subgraphs.load(), 2 * num_if_nodes);
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+  EXPECT_EQ(counting_transformer.num_main_graphs, 2);
+  EXPECT_EQ(counting_transformer.num_subgraphs.load(), 4 * num_if_nodes);
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   auto model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
@@ -4030,6 +4235,248 @@ TEST_F(GraphTransformationTests, MatMulScaleFusionUnsupportedInputType) {
       {kCpuExecutionProvider});
 }
 
+TEST_F(GraphTransformationTests, GroupedMatMulFusion) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 16}, -1.f, 1.f);
+    // four projections of different widths share the input, the last one has a non-constant B
+    for (int64_t n : {8, 32, 1, 5}) {
+      auto* weight_arg = builder.MakeInitializer<float>({16, n}, -1.f, 1.f);
+      builder.AddNode("MatMul", {input_arg, weight_arg}, {builder.MakeOutput()});
+    }
+    auto* dynamic_weight_arg = builder.MakeInput<float>({16, 4}, -1.f, 1.f);
+    builder.AddNode("MatMul", {input_arg, dynamic_weight_arg}, {builder.MakeOutput()});
+  };
+
+  auto check_grouped_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupedMatMul"], 1);
+    EXPECT_EQ(op_to_count["MatMul"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_grouped_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    12,
+                    1e-5,
+                    1e-5);
+}
+
+TEST_F(GraphTransformationTests, GroupedMatMulFusionSingleMatMul) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 16}, -1.f, 1.f);
+    auto* weight_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    builder.AddNode("MatMul", {input_arg, weight_arg}, {builder.MakeOutput()});
+    // the other consumer uses the input as B, which isn't fusable
+    auto* left_arg = builder.MakeInitializer<float>({5, 4}, -1.f, 1.f);
+    builder.AddNode("MatMul", {left_arg, input_arg}, {builder.MakeOutput()});
+  };
+
+  auto check_grouped_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupedMatMul"], 0);
+    EXPECT_EQ(op_to_count["MatMul"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_grouped_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2);
+}
+
+// Builds the graph with build_test_case, assigns its nodes to the execution provider and applies
+// ElementwiseFusion.
+static void ApplyElementwiseFusion(const std::function<void(ModelTestBuilder& builder)>& build_test_case,
+                                   const std::function<void(Graph& graph)>& check_fused_graph,
+                                   const logging::Logger& logger,
+                                   const std::string& provider_type = kCudaExecutionProvider) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}, {kMSDomain, 1}};
+  Model model("ElementwiseFusion", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, logger);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder builder(graph);
+  build_test_case(builder);
+  builder.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(provider_type);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<ElementwiseFusion>(std::unordered_set<std::string>{provider_type}),
+      TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, logger));
+  ASSERT_STATUS_OK(graph.Resolve());
+  check_fused_graph(graph);
+}
+
+TEST_F(GraphTransformationTests, ElementwiseFusion) {
+  // (X + B) * Sigmoid(X + B) * S, with the bias B and the scale S broadcast
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 8}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeInput<float>({2, 3, 1}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* swish_out = builder.MakeIntermediate();
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("Sigmoid", {add_out}, {sigmoid_out});
+    builder.AddNode("Mul", {add_out, sigmoid_out}, {swish_out});
+    builder.AddNode("Mul", {swish_out, scale_arg}, {builder.MakeOutput()});
+  };
+
+  ApplyElementwiseFusion(build_test_case, [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+
+    for (const Node& node : graph.Nodes()) {
+      ASSERT_EQ(node.OpType(), "FusedElementwise");
+      EXPECT_EQ(node.InputDefs().size(), 3u);
+      const auto& ops = node.GetAttributes().at("ops");
+      ASSERT_EQ(ops.strings_size(), 4);
+      EXPECT_EQ(ops.strings(0), "Add");
+      EXPECT_EQ(ops.strings(3), "Mul");
+      // the values are the 3 inputs then the results of the 4 ops
+      const auto& operands = node.GetAttributes().at("operands");
+      ASSERT_EQ(operands.ints_size(), 8);
+      EXPECT_EQ(operands.ints(4), 3);
+      EXPECT_EQ(operands.ints(5), 4);
+    }
+  }, *logger_);
+}
+
+TEST_F(GraphTransformationTests, ElementwiseFusionIntermediateOutput) {
+  // the result of the Add is used outside of the group, so only the nodes after it are fused
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 8}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("Neg", {relu_out}, {builder.MakeOutput()});
+    builder.AddNode("Transpose", {add_out}, {builder.MakeOutput()});
+  };
+
+  ApplyElementwiseFusion(build_test_case, [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Neg"], 0);
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+  }, *logger_);
+}
+
+TEST_F(GraphTransformationTests, ElementwiseFusionCpu) {
+  // float nodes are fused on CPU, float16 nodes are left as they are
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 8}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("Tanh", {add_out}, {tanh_out});
+    builder.AddNode("Mul", {tanh_out, input_arg}, {builder.MakeOutput()});
+
+    auto* half_input_arg = builder.MakeIntermediate();
+    auto* half_relu_out = builder.MakeIntermediate();
+    builder.AddNode("Cast", {input_arg}, {half_input_arg})
+        .AddAttribute("to", static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16));
+    builder.AddNode("Relu", {half_input_arg}, {half_relu_out});
+    builder.AddNode("Neg", {half_relu_out}, {builder.MakeOutput()});
+  };
+
+  ApplyElementwiseFusion(build_test_case, [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+    EXPECT_EQ(op_to_count["Neg"], 1);
+  }, *logger_, kCpuExecutionProvider);
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion) {
+  // ReduceSum with the axes attribute, ReduceMean with a negative axis and keepdims, and opset 13 ReduceSum
+  // with the axes as an input
+  struct ReduceCase {
+    std::string reduce_op;
+    int64_t axis;
+    int64_t keepdims;
+    int opset;
+  };
+  const std::vector<ReduceCase> cases = {
+      {"ReduceSum", 1, 0, 12}, {"ReduceMean", -2, 1, 12}, {"ReduceSum", 1, 0, 13}};
+  for (const auto& test_case : cases) {
+    const std::string& reduce_op = test_case.reduce_op;
+    const int64_t axis = test_case.axis;
+    const int64_t keepdims = test_case.keepdims;
+    const int opset = test_case.opset;
+
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* table_arg = builder.MakeInitializer<float>({50, 16}, -1.f, 1.f);
+      auto* indices_arg = builder.MakeInput<int64_t>({4, 10}, -50, 49);
+      auto* gathered_arg = builder.MakeIntermediate();
+      builder.AddNode("Gather", {table_arg, indices_arg}, {gathered_arg});
+      if (opset >= 13 && reduce_op == "ReduceSum") {
+        auto* axes_arg = builder.Make1DInitializer<int64_t>({axis});
+        builder.AddNode(reduce_op, {gathered_arg, axes_arg}, {builder.MakeOutput()})
+            .AddAttribute("keepdims", keepdims);
+      } else {
+        Node& reduce_node = builder.AddNode(reduce_op, {gathered_arg}, {builder.MakeOutput()});
+        reduce_node.AddAttribute("axes", std::vector<int64_t>{axis});
+        reduce_node.AddAttribute("keepdims", keepdims);
+      }
+    };
+
+    auto check_fused_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+      EXPECT_EQ(op_to_count["Gather"], 0);
+      EXPECT_EQ(op_to_count[reduce_op], 0);
+    };
+
+    TransformerTester(build_test_case,
+                      check_fused_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      opset,
+                      1e-5,
+                      1e-5);
+  }
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusionOtherAxis) {
+  // reducing over the embedding axis instead of the bag axis isn't an embedding bag
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({50, 16}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({4, 10}, 0, 49);
+    auto* gathered_arg = builder.MakeIntermediate();
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gathered_arg});
+    builder.AddNode("ReduceSum", {gathered_arg}, {builder.MakeOutput()})
+        .AddAttribute("axes", std::vector<int64_t>{2});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 0);
+    EXPECT_EQ(op_to_count["Gather"], 1);
+    EXPECT_EQ(op_to_count["ReduceSum"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2);
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 TEST_F(GraphTransformationTests, IsInfReduceSum_Test) {
   auto model_uri = MODEL_FOLDER "fusion/isinf_reducesum.onnx";
@@ -4232,5 +4679,163 @@ TEST_F(GraphTransformationTests, PropagateCastOpsTests) {
   }
 }
 
+TEST_F(GraphTransformationTests, TransposeOptimizerCancelsTransposes) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4, 5}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({3}, -1.f, 1.f);
+    auto* transposed_arg = builder.MakeIntermediate();
+    auto* relu_arg = builder.MakeIntermediate();
+    auto* add_arg = builder.MakeIntermediate();
+    auto* mean_arg = builder.MakeIntermediate();
+    auto* transposed_back_arg = builder.MakeIntermediate();
+
+    // NCHW -> NHWC, ops in NHWC, then back to NCHW
+    builder.AddNode("Transpose", {input_arg}, {transposed_arg}).AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    builder.AddNode("Relu", {transposed_arg}, {relu_arg});
+    builder.AddNode("Add", {relu_arg, bias_arg}, {add_arg});
+    builder.AddNode("ReduceMean", {add_arg}, {mean_arg}).AddAttribute("axes", std::vector<int64_t>{1, 2});
+    builder.AddNode("Transpose", {mean_arg}, {transposed_back_arg})
+        .AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    builder.AddNode("Sigmoid", {transposed_back_arg}, {builder.MakeOutput()});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["ReduceMean"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1, 13,
+                    1e-5, 1e-5);
+}
+
+TEST_F(GraphTransformationTests, TransposeOptimizerConcatSoftmaxReduce) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({2, 3, 4, 5}, -1.f, 1.f);
+    auto* input2_arg = builder.MakeInput<float>({2, 6, 4, 5}, -1.f, 1.f);
+    auto* transposed1_arg = builder.MakeIntermediate();
+    auto* transposed2_arg = builder.MakeIntermediate();
+    auto* concat_arg = builder.MakeIntermediate();
+    auto* softmax_arg = builder.MakeIntermediate();
+
+    builder.AddNode("Transpose", {input1_arg}, {transposed1_arg})
+        .AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    builder.AddNode("Transpose", {input2_arg}, {transposed2_arg})
+        .AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    builder.AddNode("Concat", {transposed1_arg, transposed2_arg}, {concat_arg}).AddAttribute("axis", int64_t{-1});
+    builder.AddNode("Softmax", {concat_arg}, {softmax_arg}).AddAttribute("axis", int64_t{2});
+    auto& reduce = builder.AddNode("ReduceMax", {softmax_arg}, {builder.MakeOutput()});
+    reduce.AddAttribute("axes", std::vector<int64_t>{1});
+    reduce.AddAttribute("keepdims", int64_t{0});
+  };
+
+  // the two input Transpose nodes are replaced by one on the output of the ReduceMax
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+    for (const auto& node : session.GetGraph().Nodes()) {
+      if (node.OpType() == "Transpose") {
+        ASSERT_EQ(node.GetInputEdgesCount(), 1u);
+        EXPECT_EQ(node.InputEdgesBegin()->GetNode().OpType(), "ReduceMax");
+      }
+    }
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1, 13,
+                    1e-5, 1e-5);
+}
+
+TEST_F(GraphTransformationTests, TransposeOptimizerPad) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 3, 4, 5}, -1.f, 1.f);
+    auto* pads_arg = builder.Make1DInitializer<int64_t>({0, 1, 2, 0, 0, 2, 1, 0});
+    auto* transposed_arg = builder.MakeIntermediate();
+    auto* pad_arg = builder.MakeIntermediate();
+    auto* transposed_back_arg = builder.MakeIntermediate();
+
+    builder.AddNode("Transpose", {input_arg}, {transposed_arg}).AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    builder.AddNode("Pad", {transposed_arg, pads_arg}, {pad_arg});
+    builder.AddNode("Transpose", {pad_arg}, {transposed_back_arg})
+        .AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    builder.AddNode("Relu", {transposed_back_arg}, {builder.MakeOutput()});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Pad"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1, 13);
+}
+
+TEST_F(GraphTransformationTests, TransposeOptimizerKeepsSharedTranspose) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* transposed_arg = builder.MakeIntermediate();
+
+    // the Transpose has two consumers, so moving it past one of them would add a Transpose
+    builder.AddNode("Transpose", {input_arg}, {transposed_arg}).AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+    builder.AddNode("Relu", {transposed_arg}, {builder.MakeOutput()});
+    builder.AddNode("Identity", {transposed_arg}, {builder.MakeOutput()});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1, 13);
+}
+
+TEST_F(GraphTransformationTests, ActivationStorageCompression) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}};
+  Model model("ActivationStorageCompression", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), domain_to_version, {}, *logger_);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder builder(graph);
+  // the result of the Relu stays alive while the Sigmoid and Tanh run, the other activations are read right away
+  auto* input_arg = builder.MakeInput<float>({4, 64}, -1.f, 1.f);
+  auto* relu_out = builder.MakeIntermediate();
+  auto* sigmoid_out = builder.MakeIntermediate();
+  auto* tanh_out = builder.MakeIntermediate();
+  builder.AddNode("Relu", {input_arg}, {relu_out});
+  builder.AddNode("Sigmoid", {relu_out}, {sigmoid_out});
+  builder.AddNode("Tanh", {sigmoid_out}, {tanh_out});
+  builder.AddNode("Add", {relu_out, tanh_out}, {builder.MakeOutput()});
+  builder.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<ActivationStorageCompression>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16, 1024,
+                                                     std::unordered_set<std::string>{kCpuExecutionProvider}),
+      TransformerLevel::Level3));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger_));
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // one Cast to float16 after the Relu and one Cast back to float before each of its consumers
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Cast"], 3);
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "Sigmoid" || node.OpType() == "Add") {
+      const Node* restore = graph.GetProducerNode(node.InputDefs()[0]->Name());
+      ASSERT_NE(restore, nullptr);
+      EXPECT_EQ(restore->OpType(), "Cast");
+      EXPECT_EQ(restore->GetAttributes().at("to").i(), ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+      const Node* compress = graph.GetProducerNode(restore->InputDefs()[0]->Name());
+      ASSERT_NE(compress, nullptr);
+      EXPECT_EQ(compress->GetAttributes().at("to").i(), ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+      EXPECT_EQ(graph.GetProducerNode(compress->InputDefs()[0]->Name())->OpType(), "Relu");
+    } else if (node.OpType() == "Tanh") {
+      EXPECT_EQ(graph.GetProducerNode(node.InputDefs()[0]->Name())->OpType(), "Sigmoid");
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -22,7 +22,8 @@ void TransformerTester(const std::function<void(ModelTestBuilder& helper)>& buil
                        TransformerLevel target_level,
                        int opset_version,
                        double per_sample_tolerance,
-                       double relative_per_sample_tolerance) {
+                       double relative_per_sample_tolerance,
+                       const std::function<void(SessionOptions&)>& add_session_options) {
   // Build the model for this test.
   std::unordered_map<std::string, int> domain_to_version;
   domain_to_version[kOnnxDomain] = opset_version;
@@ -42,6 +43,9 @@ void TransformerTester(const std::function<void(ModelTestBuilder& helper)>& buil
   auto run_model = [&](TransformerLevel level, std::vector<OrtValue>& fetches) {
     SessionOptions session_options;
     session_options.graph_optimization_level = level;
+    if (add_session_options) {
+      add_session_options(session_options);
+    }
     InferenceSessionWrapper session{session_options, GetEnvironment()};
     ASSERT_TRUE(session.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
     auto status = session.Initialize();
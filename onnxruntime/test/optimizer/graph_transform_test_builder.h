@@ -9,6 +9,7 @@
 #include "core/common/type_utils.h"
 #include "core/graph/graph.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/session_options.h"
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/graph/onnx_protobuf.h"
 #include "test/framework/test_utils.h"
@@ -250,7 +251,8 @@ void TransformerTester(const std::function<void(ModelTestBuilder& helper)>& buil
                        TransformerLevel target_level,
                        int opset_version = 12,
                        double per_sample_tolerance = 0.0,
-                       double relative_per_sample_tolerance = 0.0);
+                       double relative_per_sample_tolerance = 0.0,
+                       const std::function<void(SessionOptions&)>& add_session_options = {});
 
 }  // namespace test
 }  // namespace onnxruntime
@@ -6,11 +6,14 @@
 #include "core/mlas/inc/mlas.h"
 #include "core/session/environment.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/compare_ortvalue.h"
 #include "test/test_environment.h"
 #include "test/framework/test_utils.h"
 #include "test/util/include/inference_session_wrapper.h"
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 
 #include "gtest/gtest.h"
 
@@ -166,7 +169,8 @@ struct NchwcTestHelper {
 
 void NchwcOptimizerTester(const std::function<void(NchwcTestHelper& helper)>& build_test_case,
                           const std::function<void(InferenceSessionWrapper& session)>& check_nchwc_graph,
-                          int opset_version = 13) {
+                          int opset_version = 13,
+                          const std::unordered_map<std::string, std::string>& config_entries = {}) {
   // Ignore the test if NCHWc is not supported by the platform.
   if (MlasNchwcGetBlockSize() <= 1) {
     return;
@@ -189,6 +193,9 @@ void NchwcOptimizerTester(const std::function<void(NchwcTestHelper& helper)>& bu
     SessionOptions session_options;
     session_options.graph_optimization_level = level;
     session_options.session_logid = "NchwcOptimizerTests";
+    for (const auto& entry : config_entries) {
+      ASSERT_TRUE(session_options.config_options.AddConfigEntry(entry.first.c_str(), entry.second.c_str()).IsOK());
+    }
     InferenceSessionWrapper session{session_options, GetEnvironment()};
     ASSERT_TRUE(session.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
     ASSERT_TRUE(session.Initialize().IsOK());
@@ -1283,6 +1290,62 @@ TEST(NchwcOptimizerTests, Upsample) {
   test_case(13, 2.2f, 2.8f, true);
 }
 
+TEST(NchwcOptimizerTests, UpsampleLinear) {
+  auto test_case = [&](int opset_version, float scale_h, float scale_w, const std::string& transformation_mode) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({3, 16, 21, 11});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {32, 16, 1, 1});
+
+      std::string op_name = opset_version >= 10 ? "Resize" : "Upsample";
+      std::vector<NodeArg*> input_args;
+      input_args.push_back(conv_output_arg);
+      if (opset_version >= 11) {
+        input_args.push_back(helper.Make1DInitializer<float>({0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f}));
+      }
+      input_args.push_back(helper.Make1DInitializer<float>({1.f, 1.f, scale_h, scale_w}));
+      Node& resize_node = helper.AddNode(op_name, input_args, {output_arg});
+      resize_node.AddAttribute("mode", "linear");
+      if (opset_version >= 11 && !transformation_mode.empty()) {
+        resize_node.AddAttribute("coordinate_transformation_mode", transformation_mode);
+      }
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
+      if (transformation_mode != "tf_crop_and_resize") {
+        EXPECT_EQ(op_to_count["com.microsoft.nchwc.Upsample"], 1);
+        EXPECT_EQ(op_to_count["Resize"] + op_to_count["Upsample"], 0);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.nchwc.Upsample"], 0);
+        EXPECT_EQ(op_to_count["Resize"] + op_to_count["Upsample"], 1);
+      }
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph, opset_version);
+  };
+
+  // Verify that linear upsample nodes can be converted to the NCHWc format for
+  // various versions of the operator and coordinate transformation modes.
+  test_case(9, 2.f, 2.f, "");
+  test_case(10, 3.f, 2.f, "");
+  static const int opset_versions[] = {11, 13};
+  for (auto opset_version : opset_versions) {
+    test_case(opset_version, 2.f, 2.f, "");
+    test_case(opset_version, 2.f, 3.f, "asymmetric");
+    test_case(opset_version, 4.f, 2.f, "align_corners");
+    test_case(opset_version, 2.f, 2.f, "half_pixel");
+    test_case(opset_version, 3.f, 3.f, "pytorch_half_pixel");
+  }
+  // Verify that the extrapolating transformation mode is not converted to the NCHWc format.
+  test_case(13, 2.f, 2.f, "tf_crop_and_resize");
+}
+
 TEST(NchwcOptimizerTests, Activation) {
   auto test_case = [&](const std::string& activation_op_type) {
     auto build_test_case = [&](NchwcTestHelper& helper) {
@@ -1344,6 +1407,38 @@ TEST(NchwcOptimizerTests, MaxPoolTypeCheck) {
   NchwcOptimizerTester(build_test_case, check_nchwc_graph, 12);
 }
 
+TEST(NchwcOptimizerTests, ConvAutotune) {
+  const std::string tuning_file = "nchwc_optimizer_test.tuning";
+  std::remove(tuning_file.c_str());
+
+  auto build_test_case = [&](NchwcTestHelper& helper) {
+    auto* input_arg = helper.MakeInput<float>({1, 32, 28, 28});
+    auto* output_arg = helper.MakeOutput();
+
+    auto& conv_node = helper.AddConvNode(input_arg, output_arg, {32, 32, 3, 3});
+    conv_node.AddAttribute("auto_pad", "SAME_UPPER");
+  };
+
+  auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+    // The Conv is benchmarked once and the result saved to the tuning file.
+    std::ifstream infile(tuning_file);
+    std::string line;
+    ASSERT_TRUE(std::getline(infile, line));
+    const bool nchwc_is_faster = line.back() == '1';
+    EXPECT_FALSE(std::getline(infile, line));
+
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Conv"], nchwc_is_faster ? 0 : 1);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], nchwc_is_faster ? 1 : 0);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], nchwc_is_faster ? 1 : 0);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], nchwc_is_faster ? 1 : 0);
+  };
+
+  NchwcOptimizerTester(build_test_case, check_nchwc_graph, 13,
+                       {{kOrtSessionOptionsNchwcAutotune, "1"}, {kOrtSessionOptionsNchwcTuningFile, tuning_file}});
+  std::remove(tuning_file.c_str());
+}
+
 #endif
 
 }  // namespace test
@@ -8,6 +8,8 @@
 #include "graph_transform_test_builder.h"
 
 #include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -441,6 +443,183 @@ TEST(NhwcTransformerTests, ConvMixTensorRanks) {
                     TransformerLevel::Level3);
 }
 
+static void EnableFloatNhwc(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableFloatNhwc, "1"));
+}
+
+TEST(NhwcTransformerTests, FloatConv) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
+                       bool enable_float_nhwc) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      auto* weight_arg = builder.MakeInitializer<float>(weights_shape, -1.f, 1.f);
+      auto* bias_arg = builder.MakeInitializer<float>({weights_shape[0]}, -1.f, 1.f);
+
+      builder.AddNode("Conv", {input_arg, weight_arg, bias_arg}, {output_arg});
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      if (enable_float_nhwc) {
+        EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 1);
+        EXPECT_EQ(op_to_count["Transpose"], 2);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 0);
+      }
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12, 1e-5, 1e-4,
+                      enable_float_nhwc ? EnableFloatNhwc : std::function<void(SessionOptions&)>{});
+  };
+
+  // Test the basic case of a single 1D/2D/3D convolution.
+  test_case({1, 12, 37}, {32, 12, 5}, true);
+  test_case({1, 23, 13, 13}, {30, 23, 3, 3}, true);
+  test_case({1, 22, 11, 13, 15}, {30, 22, 5, 3, 3}, true);
+
+  // Test that float convolutions are left alone unless enabled by the session.
+  test_case({1, 23, 13, 13}, {30, 23, 3, 3}, false);
+}
+
+TEST(NhwcTransformerTests, FloatConvDepthwise) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 24, 15, 15}, -1.f, 1.f);
+    auto* output_arg = builder.MakeOutput();
+    auto* weight_arg = builder.MakeInitializer<float>({24, 1, 3, 3}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({24}, -1.f, 1.f);
+
+    Node& conv_node = builder.AddNode("Conv", {input_arg, weight_arg, bias_arg}, {output_arg});
+    conv_node.AddAttribute("group", static_cast<int64_t>(24));
+    conv_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12, 1e-5, 1e-4,
+                    EnableFloatNhwc);
+}
+
+TEST(NhwcTransformerTests, FloatConvBlock) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 16, 14, 14}, -1.f, 1.f);
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* relu_output_arg = builder.MakeIntermediate();
+    auto* pool_output_arg = builder.MakeIntermediate();
+    auto* conv2_output_arg = builder.MakeIntermediate();
+    auto* add_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv1_weight_arg = builder.MakeInitializer<float>({32, 16, 3, 3}, -1.f, 1.f);
+    auto* conv2_weight_arg = builder.MakeInitializer<float>({24, 32, 1, 1}, -1.f, 1.f);
+
+    Node& conv1_node = builder.AddNode("Conv", {input_arg, conv1_weight_arg}, {conv1_output_arg});
+    conv1_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Relu", {conv1_output_arg}, {relu_output_arg});
+    Node& pool_node = builder.AddNode("MaxPool", {relu_output_arg}, {pool_output_arg});
+    pool_node.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+    pool_node.AddAttribute("strides", std::vector<int64_t>{2, 2});
+    builder.AddNode("Conv", {pool_output_arg, conv2_weight_arg}, {conv2_output_arg});
+    builder.AddNode("Add", {conv2_output_arg, builder.MakeScalarInitializer<float>(0.5f)}, {add_output_arg});
+    builder.AddNode("GlobalAveragePool", {add_output_arg}, {output_arg});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 2);
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcMaxPool"], 1);
+    EXPECT_EQ(op_to_count["ReduceMean"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  // The tensors stay in the NHWC layout from the first convolution to the
+  // global pooling.
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12, 1e-5, 1e-4,
+                    EnableFloatNhwc);
+}
+
+TEST(NhwcTransformerTests, FloatConvResize) {
+  auto test_case = [&](const std::string& mode) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({1, 8, 9, 9}, -1.f, 1.f);
+      auto* conv_output_arg = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+      auto* conv_weight_arg = builder.MakeInitializer<float>({16, 8, 3, 3}, -1.f, 1.f);
+
+      builder.AddNode("Conv", {input_arg, conv_weight_arg}, {conv_output_arg});
+      auto* roi_arg = builder.MakeInitializer<float>({0}, std::vector<float>{});
+      auto* scales_arg = builder.Make1DInitializer<float>({1.f, 1.f, 2.f, 3.f});
+      Node& resize_node = builder.AddNode("Resize", {conv_output_arg, roi_arg, scales_arg}, {output_arg});
+      resize_node.AddAttribute("mode", mode);
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 1);
+      EXPECT_EQ(op_to_count["Resize"], 1);
+      EXPECT_EQ(op_to_count["Transpose"], 2);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12, 1e-5, 1e-4,
+                      EnableFloatNhwc);
+  };
+
+  test_case("nearest");
+  test_case("linear");
+}
+
+TEST(NhwcTransformerTests, FloatConvTransposeSandwich) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 13, 13, 23}, -1.f, 1.f);
+    auto* transpose1_output_arg = builder.MakeIntermediate();
+    auto* conv_output_arg = builder.MakeIntermediate();
+    auto* transpose2_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv_weight_arg = builder.MakeInitializer<float>({30, 23, 3, 3}, -1.f, 1.f);
+
+    Node& transpose1_node = builder.AddNode("Transpose", {input_arg}, {transpose1_output_arg});
+    transpose1_node.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    builder.AddNode("Conv", {transpose1_output_arg, conv_weight_arg}, {conv_output_arg});
+    Node& transpose2_node = builder.AddNode("Transpose", {conv_output_arg}, {transpose2_output_arg});
+    transpose2_node.AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    builder.AddNode("Relu", {transpose2_output_arg}, {output_arg});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+  };
+
+  // The Transpose nodes converting the NHWC tensors to NCHW and back around
+  // the convolution are folded into NhwcConv.
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12, 1e-5, 1e-4,
+                    EnableFloatNhwc);
+}
+
 #endif  // DISABLE_CONTRIB_OPS
 
 }  // namespace test
@@ -1186,6 +1186,212 @@ TEST(QDQTransformerTests, Concat_UInt8) {
   test_case({{1, 6, 36}, {1, 6, 8}, {1, 6, 2}}, 2, false);
 }
 
+TEST(QDQTransformerTests, UnaryOps) {
+  auto test_case = [&](const std::string& op_type, const std::vector<int64_t>& input_shape, int opset_version) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -4.f, 4.f);
+      auto* output_arg = builder.MakeOutput();
+
+      auto* op_output = builder.MakeIntermediate();
+      auto* dq_output = AddQDQNodePair<uint8_t>(builder, input_arg, .03f, 128);
+      builder.AddNode(op_type, {dq_output}, {op_output});
+
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<uint8_t>(op_output, 1.f / 256, 0, q_output);
+      builder.AddDequantizeLinearNode<uint8_t>(q_output, 1.f / 256, 0, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinear" + op_type], 1);
+      EXPECT_EQ(op_to_count[op_type], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      opset_version,
+                      0.01f /*per_sample_tolerance*/,
+                      0.01f /*relative_per_sample_tolerance*/);
+  };
+
+  test_case("Sigmoid", {2, 3, 17}, 12);
+  test_case("LeakyRelu", {2, 3, 17}, 12);
+  test_case("Softmax", {6, 17}, 12);
+  test_case("Softmax", {2, 3, 17}, 13);
+}
+
+TEST(QDQTransformerTests, Softmax_No_Fusion) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 17}, -4.f, 4.f);
+    auto* output_arg = builder.MakeOutput();
+
+    // before opset 13 Softmax normalizes the flattened last 2 dimensions
+    auto* softmax_output = builder.MakeIntermediate();
+    auto* dq_output = AddQDQNodePair<uint8_t>(builder, input_arg, .03f, 128);
+    Node& softmax_node = builder.AddNode("Softmax", {dq_output}, {softmax_output});
+    softmax_node.AddAttribute("axis", static_cast<int64_t>(1));
+
+    builder.AddQuantizeLinearNode<uint8_t>(softmax_output, 1.f / 256, 0, output_arg);
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearSoftmax"], 0);
+    EXPECT_EQ(op_to_count["Softmax"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+}
+
+TEST(QDQTransformerTests, Pad) {
+  auto test_case = [&](const std::string& mode, bool has_constant_value) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<uint8_t>({2, 3, 7}, 0, 255);
+      auto* output_arg = builder.MakeOutput();
+
+      auto* dq_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(input_arg, .003f, 129, dq_output);
+
+      std::vector<NodeArg*> pad_inputs{dq_output, builder.Make1DInitializer<int64_t>({0, 1, 2, 0, 2, 1})};
+      if (has_constant_value) {
+        pad_inputs.push_back(builder.MakeScalarInitializer<float>(0.f));
+      }
+      auto* pad_output = builder.MakeIntermediate();
+      Node& pad_node = builder.AddNode("Pad", pad_inputs, {pad_output});
+      pad_node.AddAttribute("mode", mode);
+
+      builder.AddQuantizeLinearNode<uint8_t>(pad_output, .003f, 129, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["Pad"], 1);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+  };
+
+  test_case("constant", false);
+  test_case("constant", true);
+  test_case("reflect", true);
+  test_case("edge", false);
+}
+
+TEST(QDQTransformerTests, Resize) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<uint8_t>({1, 3, 4, 5}, 0, 255);
+    auto* output_arg = builder.MakeOutput();
+
+    auto* dq_output = builder.MakeIntermediate();
+    builder.AddDequantizeLinearNode<uint8_t>(input_arg, .003f, 129, dq_output);
+
+    auto* resize_output = builder.MakeIntermediate();
+    builder.AddNode("Resize",
+                    {dq_output, builder.MakeInitializer<float>({0}, {}),
+                     builder.Make1DInitializer<float>({1.f, 1.f, 2.f, 2.f})},
+                    {resize_output});
+
+    builder.AddQuantizeLinearNode<uint8_t>(resize_output, .003f, 129, output_arg);
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Resize"], 1);
+    EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+    EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+}
+
+TEST(QDQTransformerTests, Split) {
+  auto test_case = [&](bool quantize_all_outputs) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<uint8_t>({2, 9, 5}, 0, 255);
+
+      auto* dq_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(input_arg, .003f, 129, dq_output);
+
+      std::vector<NodeArg*> split_outputs{builder.MakeIntermediate(), builder.MakeIntermediate(),
+                                          builder.MakeIntermediate()};
+      Node& split_node = builder.AddNode("Split", {dq_output}, split_outputs);
+      split_node.AddAttribute("axis", static_cast<int64_t>(1));
+
+      for (size_t i = 0; i < split_outputs.size(); ++i) {
+        if (!quantize_all_outputs && i == 1) {
+          builder.AddNode("Identity", {split_outputs[i]}, {builder.MakeOutput()});
+        } else {
+          builder.AddQuantizeLinearNode<uint8_t>(split_outputs[i], .003f, 129, builder.MakeOutput());
+        }
+      }
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["Split"], 1);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], quantize_all_outputs ? 0 : 2);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], quantize_all_outputs ? 0 : 1);
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+  };
+
+  test_case(true);
+  test_case(false);
+}
+
+TEST(QDQTransformerTests, Gemm) {
+  auto test_case = [&](int64_t trans_b, bool has_bias) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({12, 37}, -1.f, 1.f);
+      auto* weight_arg = builder.MakeInitializer<uint8_t>(trans_b ? std::vector<int64_t>{13, 37}
+                                                                  : std::vector<int64_t>{37, 13},
+                                                          0, 255);
+      auto* output_arg = builder.MakeOutput();
+
+      auto* dq_input = AddQDQNodePair<uint8_t>(builder, input_arg, .004f, 129);
+      auto* dq_weight = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(weight_arg, .004f, 127, dq_weight);
+
+      std::vector<NodeArg*> gemm_inputs{dq_input, dq_weight};
+      if (has_bias) {
+        gemm_inputs.push_back(builder.MakeInitializer<float>({13}, -1.f, 1.f));
+      }
+      auto* gemm_output = builder.MakeIntermediate();
+      Node& gemm_node = builder.AddNode("Gemm", gemm_inputs, {gemm_output});
+      gemm_node.AddAttribute("transB", trans_b);
+
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<uint8_t>(gemm_output, .039f, 135, q_output);
+      builder.AddDequantizeLinearNode<uint8_t>(q_output, .039f, 135, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["QLinearMatMul"], has_bias ? 0 : 1);
+      EXPECT_EQ(op_to_count["Gemm"], has_bias ? 1 : 0);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.04f /*per_sample_tolerance*/,
+                      0.01f /*relative_per_sample_tolerance*/);
+  };
+
+  test_case(0, false);
+  test_case(1, false);
+  test_case(1, true);
+}
+
 #endif  // DISABLE_CONTRIB_OPS
 
 }  // namespace test
@@ -26,6 +26,7 @@ namespace perftest {
 /*static*/ void CommandLineParser::ShowUsage() {
   printf(
       "perf_test [options...] model_path [result_file]\n"
+      "perf_test [options...] -S scenario_file [result_file]\n"
       "Options:\n"
       "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
@@ -54,6 +55,11 @@ namespace perftest {
       "\t-u [optimized_model_path]: Specify the optimized model path for saving.\n"
       "\t-d [cudnn_conv_algorithm]: Specify CUDNN convolution algothrithms: 0(benchmark), 1(heuristic), 2(default). \n"
       "\t-q: [CUDA only] use separate stream for copy. \n"
+      "\t-S [scenario_file]: Run a mix of models with open-loop Poisson arrivals for the 'duration' given by -t. "
+      "Each line of the file is '<model_path> <requests_per_second>'.\n"
+      "\t\tReports latency percentiles per model and CPU usage per second. -c sets the number of workers.\n"
+      "\t-T: Share env-level thread pools across all sessions instead of giving each session its own. -x and -y size the shared pools.\n"
+      "\t-Q: [CUDA only] Run every session on the shared default stream instead of a stream per session.\n"
       "\t-z: Set denormal as zero. When turning on this option reduces latency dramatically, a model may have denormals.\n"
       "\t-i: Specify EP specific runtime options as key value pairs. Different runtime options available are: \n"
       "\t    [OpenVINO only] [device_type]: Overrides the accelerator hardware type and precision with these values at runtime.\n"
@@ -62,6 +68,7 @@ namespace perftest {
       "\t    [OpenVINO only] [num_of_threads]: Overrides the accelerator hardware type and precision with these values at runtime.\n"
       "\t    [OpenVINO only] [use_compiled_network]: Can be enabled to directly import pre-compiled blobs if exists. currently this feature is only supported on MyriadX(VPU) hardware device target.\n"
       "\t    [OpenVINO only] [blob_dump_path]: Explicitly specify the path where you would like to dump and load the blobs for the use_compiled_network(save/load blob) feature. This overrides the default path.\n"
+      "\t    [OpenVINO only] [num_streams]: Number of parallel OpenVINO streams (throughput mode) that concurrent runs are spread across. 0 uses the device default.\n"
       "\t [Usage]: -e <provider_name> -i '<key1>|<value1> <key2>|<value2>'\n\n"
       "\t [Example] [For OpenVINO EP] -e openvino -i \"device_type|CPU_FP32 enable_vpu_fast_compile|true num_of_threads|5 use_compiled_network|true blob_dump_path|\"<path>\"\"\n"
       "\t    [TensorRT only] [use_trt_options]: Overrides TensorRT environment variables (if any) with following settings at runtime.\n"		  
@@ -71,6 +78,9 @@ namespace perftest {
       "\t    [TensorRT only] [trt_int8_calibration_table_name]: Specify INT8 calibration table name.\n"
       "\t    [TensorRT only] [trt_int8_use_native_calibration_table]: Use Native TensorRT calibration table.\n"
       "\t    [TensorRT only] [trt_force_sequential_engine_build]: Force TensorRT engines to be built sequentially.\n"
+      "\t    [TensorRT only] [trt_profile_min_shapes]: Minimum shapes of the optimization profiles, e.g. 'input_ids:1x1,input_ids:8x128'. Repeat an input to add a profile.\n"
+      "\t    [TensorRT only] [trt_profile_max_shapes]: Maximum shapes of the optimization profiles.\n"
+      "\t    [TensorRT only] [trt_profile_opt_shapes]: Shapes the optimization profiles are tuned for. Default is the maximum shapes.\n"
       "\t [Usage]: -e <provider_name> -i '<key1>|<value1> <key2>|<value2>'\n\n"
       "\t [Example] [For TensorRT EP] -e tensorrt -i 'use_trt_options|true trt_fp16_enable|true trt_int8_enable|true trt_int8_calibration_table_name|calibration.flatbuffers trt_int8_use_native_calibration_table|false trt_force_sequential_engine_build|false'\n"
       "\t-h: help\n");
@@ -101,7 +111,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:AMPIvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:AMPIvhsqzTQ"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -255,6 +265,16 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
       case 'i':
         test_config.run_config.ep_runtime_config_string = optarg;
         break;
+      case 'S':
+        test_config.run_config.scenario_file_path = optarg;
+        test_config.run_config.test_mode = TestMode::kFixDurationMode;
+        break;
+      case 'T':
+        test_config.run_config.share_thread_pools = true;
+        break;
+      case 'Q':
+        test_config.run_config.share_cuda_stream = true;
+        break;
       case '?':
       case 'h':
       default:
@@ -266,6 +286,20 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
   argc -= optind;
   argv += optind;
 
+  // a scenario names its models in the scenario file
+  if (!test_config.run_config.scenario_file_path.empty()) {
+    switch (argc) {
+      case 1:
+        test_config.model_info.result_file_path = argv[0];
+        return true;
+      case 0:
+        test_config.run_config.f_dump_statistics = true;
+        return true;
+      default:
+        return false;
+    }
+  }
+
   switch (argc) {
     case 2:
       test_config.model_info.result_file_path = argv[1];
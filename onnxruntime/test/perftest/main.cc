@@ -6,6 +6,7 @@
 #include <random>
 #include "command_args_parser.h"
 #include "performance_runner.h"
+#include "scenario_runner.h"
 #include <google/protobuf/stubs/common.h>
 
 using namespace onnxruntime;
@@ -29,7 +30,17 @@ int real_main(int argc, char* argv[]) {
       OrtLoggingLevel logging_level = test_config.run_config.f_verbose
                                           ? ORT_LOGGING_LEVEL_VERBOSE
                                           : ORT_LOGGING_LEVEL_WARNING;
-      env = Ort::Env(logging_level, "Default");
+      if (test_config.run_config.share_thread_pools) {
+        OrtThreadingOptions* tp_options = nullptr;
+        Ort::ThrowOnError(g_ort->CreateThreadingOptions(&tp_options));
+        std::unique_ptr<OrtThreadingOptions, decltype(g_ort->ReleaseThreadingOptions)> tp_options_holder(
+            tp_options, g_ort->ReleaseThreadingOptions);
+        Ort::ThrowOnError(g_ort->SetGlobalIntraOpNumThreads(tp_options, test_config.run_config.intra_op_num_threads));
+        Ort::ThrowOnError(g_ort->SetGlobalInterOpNumThreads(tp_options, test_config.run_config.inter_op_num_threads));
+        env = Ort::Env(tp_options, logging_level, "Default");
+      } else {
+        env = Ort::Env(logging_level, "Default");
+      }
     }
     ORT_CATCH(const Ort::Exception& e) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -42,6 +53,18 @@ int real_main(int argc, char* argv[]) {
       return -1;
   }
   std::random_device rd;
+  if (!test_config.run_config.scenario_file_path.empty()) {
+    perftest::ScenarioRunner scenario_runner(env, test_config, rd);
+    auto status = scenario_runner.Run();
+    if (!status.IsOK()) {
+      printf("Run failed:%s\n", status.ErrorMessage().c_str());
+      return -1;
+    }
+
+    scenario_runner.SerializeResult();
+    return 0;
+  }
+
   perftest::PerformanceRunner perf_runner(env, test_config, rd);
   auto status = perf_runner.Run();
   if (!status.IsOK()) {
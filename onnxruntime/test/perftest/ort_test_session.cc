@@ -14,9 +14,13 @@ namespace onnxruntime {
 namespace perftest {
 
 std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
-  //Randomly pick one OrtValueArray from test_inputs_. (NOT ThreadSafe)
+  //Randomly pick one OrtValueArray from test_inputs_.
   const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
-  const size_t id = static_cast<size_t>(dist_(rand_engine_, p));
+  size_t id;
+  {
+    std::lock_guard<OrtMutex> guard(rand_mutex_);
+    id = static_cast<size_t>(dist_(rand_engine_, p));
+  }
   auto& input = test_inputs_.at(id);
   auto start = std::chrono::high_resolution_clock::now();
   auto output_values = session_.Run(Ort::RunOptions{nullptr}, input_names_.data(), input.data(), input_names_.size(),
@@ -48,7 +52,8 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         std::numeric_limits<size_t>::max(),
         0,
         !performance_test_config.run_config.do_cuda_copy_in_separate_stream,
-        0,
+        // a null user stream is the legacy default stream, which every session will then share
+        performance_test_config.run_config.share_cuda_stream ? 1 : 0,
         nullptr,
         nullptr};  // TODO: Support arena configuration for users of perf test
     session_options.AppendExecutionProvider_CUDA(cuda_options);
@@ -70,6 +75,9 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     std::string trt_int8_calibration_table_name = "";
     bool trt_int8_use_native_calibration_table = false;
     bool trt_force_sequential_engine_build = false;
+    std::string trt_profile_min_shapes = "";
+    std::string trt_profile_max_shapes = "";
+    std::string trt_profile_opt_shapes = "";
 
 #ifdef _MSC_VER
     std::string ov_string = ToMBString(performance_test_config.run_config.ep_runtime_config_string);
@@ -141,8 +149,14 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         } else {
           ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_force_sequential_engine_build' should be a boolean i.e. true or false. Default value is false.\n");
         }
+      } else if (key == "trt_profile_min_shapes") {
+        trt_profile_min_shapes = value;
+      } else if (key == "trt_profile_max_shapes") {
+        trt_profile_max_shapes = value;
+      } else if (key == "trt_profile_opt_shapes") {
+        trt_profile_opt_shapes = value;
       } else {
-        ORT_THROW("[ERROR] [TensorRT] wrong key type entered. Choose from the following runtime key options that are available for TensorRT. ['use_trt_options', 'trt_fp16_enable', 'trt_int8_enable', 'trt_int8_calibration_table_name', 'trt_int8_use_native_calibration_table', 'trt_force_sequential_engine_build'] \n");
+        ORT_THROW("[ERROR] [TensorRT] wrong key type entered. Choose from the following runtime key options that are available for TensorRT. ['use_trt_options', 'trt_fp16_enable', 'trt_int8_enable', 'trt_int8_calibration_table_name', 'trt_int8_use_native_calibration_table', 'trt_force_sequential_engine_build', 'trt_profile_min_shapes', 'trt_profile_max_shapes', 'trt_profile_opt_shapes'] \n");
       }
     }
     OrtTensorRTProviderOptions tensorrt_options;
@@ -156,6 +170,9 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     tensorrt_options.trt_int8_calibration_table_name = trt_int8_calibration_table_name.c_str();
     tensorrt_options.trt_int8_use_native_calibration_table = trt_int8_use_native_calibration_table;
     tensorrt_options.trt_force_sequential_engine_build = trt_force_sequential_engine_build;
+    tensorrt_options.trt_profile_min_shapes = trt_profile_min_shapes.empty() ? nullptr : trt_profile_min_shapes.c_str();
+    tensorrt_options.trt_profile_max_shapes = trt_profile_max_shapes.empty() ? nullptr : trt_profile_max_shapes.c_str();
+    tensorrt_options.trt_profile_opt_shapes = trt_profile_opt_shapes.empty() ? nullptr : trt_profile_opt_shapes.c_str();
     session_options.AppendExecutionProvider_TensorRT(tensorrt_options);
 
     OrtCUDAProviderOptions cuda_options{
@@ -164,7 +181,7 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         std::numeric_limits<size_t>::max(),
         0,
         !performance_test_config.run_config.do_cuda_copy_in_separate_stream,
-        0,
+        performance_test_config.run_config.share_cuda_stream ? 1 : 0,
         nullptr,
         nullptr};  // TODO: Support arena configuration for users of perf test
     session_options.AppendExecutionProvider_CUDA(cuda_options);
@@ -176,9 +193,10 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     std::string device_type = "";          // [device_type]: Overrides the accelerator hardware type and precision with these values at runtime.
     bool enable_vpu_fast_compile = false;  // [enable_vpu_fast_compile]: Fast-compile may be optionally enabled to speeds up the model's compilation to VPU device specific format.
     std::string device_id = "";            // [device_id]: Selects a particular hardware device for inference.
-    size_t num_of_threads = 8;             // [num_of_threads]: Overrides the accelerator default value of number of threads with this value at runtime.
+    size_t num_of_threads = 0;             // [num_of_threads]: Overrides the accelerator default value of number of threads with this value at runtime.
     bool use_compiled_network = false;     // [use_compiled_network]: Can be enabled to directly import pre-compiled blobs if exists.
     std::string blob_dump_path = "";       // [blob_dump_path]: Explicitly specify the path where you would like to dump and load the blobs for the use_compiled_network(save/load blob) feature. This overrides the default path.
+    size_t num_streams = 0;                // [num_streams]: Number of parallel OpenVINO streams for concurrent runs. 0 uses the device default.
 
 #ifdef _MSC_VER
     std::string ov_string = ToMBString(performance_test_config.run_config.ep_runtime_config_string);
@@ -232,17 +250,21 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         }
       } else if (key == "blob_dump_path") {
         blob_dump_path = value;
+      } else if (key == "num_streams") {
+        std::stringstream sstream(value);
+        sstream >> num_streams;
       } else {
-        ORT_THROW("[ERROR] [OpenVINO] wrong key type entered. Choose from the following runtime key options that are available for OpenVINO. ['device_type', 'device_id', 'enable_vpu_fast_compile', 'num_of_threads', 'use_compiled_network', 'blob_dump_path'] \n");
+        ORT_THROW("[ERROR] [OpenVINO] wrong key type entered. Choose from the following runtime key options that are available for OpenVINO. ['device_type', 'device_id', 'enable_vpu_fast_compile', 'num_of_threads', 'use_compiled_network', 'blob_dump_path', 'num_streams'] \n");
       }
     }
     OrtOpenVINOProviderOptions options;
     options.device_type = device_type.c_str();                  //To set the device_type
     options.device_id = device_id.c_str();                      // To set the device_id
     options.enable_vpu_fast_compile = enable_vpu_fast_compile;  // To enable_vpu_fast_compile, default is false
-    options.num_of_threads = num_of_threads;                    // To set number of free InferRequests, default is 8
+    options.num_of_threads = num_of_threads;                    // To set number of free InferRequests, default is 8 (or the device's optimal number with num_streams)
     options.use_compiled_network = use_compiled_network;        // To use_compiled_network, default is false
     options.blob_dump_path = blob_dump_path.c_str();            // sets the blob_dump_path, default is ""
+    options.num_streams = num_streams;                          // To set the number of OpenVINO streams, default is 0
     session_options.AppendExecutionProvider_OpenVINO(options);
 #else
     ORT_THROW("OpenVINO is not supported in this build\n");
@@ -312,12 +334,16 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     session_options.DisableMemPattern();
   session_options.SetExecutionMode(performance_test_config.run_config.execution_mode);
 
-  if (performance_test_config.run_config.intra_op_num_threads > 0) {
+  if (performance_test_config.run_config.share_thread_pools) {
+    // the thread pool sizes are set on the env instead, see main.cc
+    session_options.DisablePerSessionThreads();
+  } else if (performance_test_config.run_config.intra_op_num_threads > 0) {
     fprintf(stdout, "Setting intra_op_num_threads to %d\n", performance_test_config.run_config.intra_op_num_threads);
     session_options.SetIntraOpNumThreads(performance_test_config.run_config.intra_op_num_threads);
   }
 
-  if (performance_test_config.run_config.execution_mode == ExecutionMode::ORT_PARALLEL && performance_test_config.run_config.inter_op_num_threads > 0) {
+  if (!performance_test_config.run_config.share_thread_pools &&
+      performance_test_config.run_config.execution_mode == ExecutionMode::ORT_PARALLEL && performance_test_config.run_config.inter_op_num_threads > 0) {
     fprintf(stdout, "Setting inter_op_num_threads to %d\n", performance_test_config.run_config.inter_op_num_threads);
     session_options.SetInterOpNumThreads(performance_test_config.run_config.inter_op_num_threads);
   }
@@ -4,6 +4,7 @@
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
 #include <random>
+#include "core/platform/ort_mutex.h"
 #include "test_configuration.h"
 #include "test_session.h"
 class TestModelInfo;
@@ -39,6 +40,8 @@ class OnnxRuntimeTestSession : public TestSession {
  private:
   Ort::Session session_{nullptr};
   std::mt19937 rand_engine_;
+  // Run() is called concurrently by the parallel and scenario modes.
+  OrtMutex rand_mutex_;
   std::uniform_int_distribution<int> dist_;
   std::vector<std::vector<Ort::Value>> test_inputs_;
   std::vector<std::string> output_names_;
@@ -52,10 +52,15 @@ class PerformanceRunner {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
   }
+  // Loads the test data. Run() calls this itself; ScenarioRunner calls it before issuing its own requests.
+  bool Initialize();
+
+  // Runs a single inference request and returns its duration without recording it. Thread safe.
+  inline std::chrono::duration<double> RunOnce() { return session_->Run(); }
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerformanceRunner);
 
  private:
-  bool Initialize();
 
   template <bool isWarmup>
   Status RunOneIteration() {
@@ -0,0 +1,272 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// TODO: Remove when removing Eigen
+#if defined(_MSC_VER)
+#pragma warning(disable : 4267)
+#endif
+
+#include "scenario_runner.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "performance_runner.h"
+#include "utils.h"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <unsupported/Eigen/CXX11/ThreadPool>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace onnxruntime {
+namespace perftest {
+
+using Clock = std::chrono::high_resolution_clock;
+
+Status ParseScenarioFile(const std::basic_string<ORTCHAR_T>& path, std::vector<ScenarioModel>& models) {
+  std::basic_ifstream<ORTCHAR_T> infile(path);
+  if (!infile.good()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "failed to open scenario file '", ToMBString(path), "'");
+  }
+
+  std::basic_string<ORTCHAR_T> line;
+  size_t line_number = 0;
+  while (std::getline(infile, line)) {
+    ++line_number;
+    std::basic_istringstream<ORTCHAR_T> fields(line);
+    ScenarioModel model;
+    if (!(fields >> model.model_file_path) || model.model_file_path[0] == ORT_TSTR('#')) {
+      continue;
+    }
+    if (!(fields >> model.arrival_rate) || model.arrival_rate <= 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "scenario file line ", line_number,
+                             ": expected '<model_path> <arrival_rate>' with arrival_rate > 0");
+    }
+    models.push_back(std::move(model));
+  }
+
+  if (models.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "scenario file '", ToMBString(path), "' has no models");
+  }
+  return Status::OK();
+}
+
+static void PrintLatencyStats(std::ostream& ostream, std::vector<double> sorted_time) {
+  if (sorted_time.empty()) {
+    return;
+  }
+  std::sort(sorted_time.begin(), sorted_time.end());
+  size_t total = sorted_time.size();
+  ostream << "  P50 Latency: " << sorted_time[static_cast<size_t>(total * 0.5)] << " s\n"
+          << "  P90 Latency: " << sorted_time[static_cast<size_t>(total * 0.9)] << " s\n"
+          << "  P95 Latency: " << sorted_time[static_cast<size_t>(total * 0.95)] << " s\n"
+          << "  P99 Latency: " << sorted_time[static_cast<size_t>(total * 0.99)] << " s\n"
+          << "  P999 Latency: " << sorted_time[static_cast<size_t>(total * 0.999)] << " s\n"
+          << "  Max Latency: " << sorted_time[total - 1] << " s\n";
+}
+
+ScenarioRunner::ScenarioRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
+    : performance_test_config_(test_config), env_(env), rd_(rd) {
+}
+
+ScenarioRunner::~ScenarioRunner() = default;
+
+Status ScenarioRunner::Initialize() {
+  std::vector<ScenarioModel> scenario;
+  ORT_RETURN_IF_ERROR(ParseScenarioFile(performance_test_config_.run_config.scenario_file_path, scenario));
+
+  for (auto& model : scenario) {
+    auto state = std::make_unique<ModelState>();
+    PerformanceTestConfig model_config = performance_test_config_;
+    model_config.model_info.model_file_path = model.model_file_path;
+    state->runner = std::make_unique<PerformanceRunner>(env_, model_config, rd_);
+    if (!state->runner->Initialize()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize ", ToMBString(model.model_file_path));
+    }
+    state->name = state->runner->GetResult().model_name;
+    state->model = std::move(model);
+
+    // warm up
+    state->runner->RunOnce();
+    models_.push_back(std::move(state));
+  }
+
+  return Status::OK();
+}
+
+Status ScenarioRunner::Run() {
+  ORT_RETURN_IF_ERROR(Initialize());
+
+  const auto& run_config = performance_test_config_.run_config;
+  const size_t num_workers = std::max(run_config.concurrent_session_runs, models_.size());
+  auto tpool = std::make_unique<Eigen::ThreadPool>(static_cast<int>(num_workers));
+  int outstanding = 0;
+  OrtMutex m;
+  OrtCondVar cv;
+
+  // std::random_device is not thread safe, so seed the arrival processes up front
+  std::vector<unsigned int> seeds;
+  for (size_t i = 0; i != models_.size(); ++i) {
+    seeds.push_back(rd_());
+  }
+
+  const auto start = Clock::now();
+  const auto end = start + std::chrono::duration_cast<Clock::duration>(
+                               std::chrono::duration<double>(static_cast<double>(run_config.duration_in_seconds)));
+
+  std::thread sampler([this, start, end]() {
+    std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
+    for (auto next = start + std::chrono::seconds(1); next <= end; next += std::chrono::seconds(1)) {
+      std::this_thread::sleep_until(next);
+      UtilizationSample sample;
+      sample.cpu_usage = p_ICPUUsage->GetUsage();
+      p_ICPUUsage->Reset();
+      sample.elapsed_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+      for (auto& state : models_) {
+        std::lock_guard<OrtMutex> guard(state->mutex);
+        sample.completions.push_back(state->completed_in_interval);
+        state->completed_in_interval = 0;
+      }
+      utilization_.push_back(std::move(sample));
+    }
+  });
+
+  std::vector<std::thread> arrivals;
+  for (size_t i = 0; i != models_.size(); ++i) {
+    ModelState* state = models_[i].get();
+    arrivals.emplace_back([&, state, seed = seeds[i]]() {
+      std::mt19937 rand_engine(seed);
+      std::exponential_distribution<double> inter_arrival(state->model.arrival_rate);
+      auto arrival = start;
+      size_t issued = 0;
+      while (true) {
+        arrival += std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(inter_arrival(rand_engine)));
+        if (arrival >= end) {
+          break;
+        }
+        std::this_thread::sleep_until(arrival);
+        {
+          std::lock_guard<OrtMutex> lg(m);
+          ++outstanding;
+        }
+        ++issued;
+        tpool->Schedule([state, arrival, &outstanding, &m, &cv]() {
+          std::chrono::duration<double> service_time(0);
+          auto status = Status::OK();
+          ORT_TRY {
+            service_time = state->runner->RunOnce();
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+            });
+          }
+          std::chrono::duration<double> latency = Clock::now() - arrival;
+
+          {
+            std::lock_guard<OrtMutex> guard(state->mutex);
+            if (status.IsOK()) {
+              state->latencies.push_back(latency.count());
+              state->service_times.push_back(service_time.count());
+              ++state->completed_in_interval;
+            } else {
+              ++state->failed;
+              std::cerr << state->name << ": " << status.ErrorMessage() << std::endl;
+            }
+          }
+
+          // Simplified version of Eigen::Barrier
+          std::lock_guard<OrtMutex> lg(m);
+          --outstanding;
+          cv.notify_all();
+        });
+      }
+      state->issued = issued;
+    });
+  }
+
+  for (auto& t : arrivals) {
+    t.join();
+  }
+  sampler.join();
+
+  //Join
+  std::unique_lock<OrtMutex> lock(m);
+  cv.wait(lock, [&outstanding]() { return outstanding == 0; });
+  run_duration_ = Clock::now() - start;
+
+  const double duration = static_cast<double>(run_config.duration_in_seconds);
+  std::cout << "Scenario run time: " << run_duration_.count() << " s\n"
+            << "Workers: " << num_workers << "\n"
+            << "Shared thread pools: " << (run_config.share_thread_pools ? "yes" : "no") << "\n";
+  for (const auto& state : models_) {
+    double total_service_time = 0;
+    for (double t : state->service_times) {
+      total_service_time += t;
+    }
+    std::cout << "Model: " << state->name << "\n"
+              << "  Arrival rate: " << state->model.arrival_rate << " req/s (offered: "
+              << state->issued / duration << " req/s)\n"
+              << "  Completed requests: " << state->latencies.size() << "\n"
+              << "  Failed requests: " << state->failed << "\n";
+    if (!state->service_times.empty()) {
+      std::cout << "  Average service time: " << total_service_time / state->service_times.size() * 1000 << " ms\n";
+    }
+    PrintLatencyStats(std::cout, state->latencies);
+  }
+
+  std::cout << "Utilization per second (time_s, CPU %, completions per model):\n";
+  for (const auto& sample : utilization_) {
+    std::cout << "  " << sample.elapsed_seconds << ", " << sample.cpu_usage;
+    for (size_t completions : sample.completions) {
+      std::cout << ", " << completions;
+    }
+    std::cout << "\n";
+  }
+  std::cout << "Peak working set size: " << utils::GetPeakWorkingSetSize() << " bytes" << std::endl;
+
+  return Status::OK();
+}
+
+void ScenarioRunner::SerializeResult() const {
+  const auto& path = performance_test_config_.model_info.result_file_path;
+  if (path.empty()) {
+    return;
+  }
+
+  std::ofstream outfile;
+  outfile.open(path, std::ofstream::out | std::ofstream::app);
+  if (!outfile.good()) {
+    std::cerr << "failed to open result file '" << ToMBString(path) << "'.\n";
+    return;
+  }
+
+  // model,latency,service_time,request
+  for (const auto& state : models_) {
+    for (size_t i = 0; i != state->latencies.size(); ++i) {
+      outfile << state->name << "," << state->latencies[i] << "," << state->service_times[i] << "," << i << "\n";
+    }
+  }
+
+  // time_s,cpu_usage,completions per model
+  for (const auto& sample : utilization_) {
+    outfile << sample.elapsed_seconds << "," << sample.cpu_usage;
+    for (size_t completions : sample.completions) {
+      outfile << "," << completions;
+    }
+    outfile << "\n";
+  }
+  outfile.flush();
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+// onnxruntime dependencies
+#include <core/common/common.h>
+#include <core/common/status.h>
+#include <core/platform/ort_mutex.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include "test_configuration.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+class PerformanceRunner;
+
+// One model of a scenario and the rate (requests per second) its requests arrive at.
+struct ScenarioModel {
+  std::basic_string<ORTCHAR_T> model_file_path;
+  double arrival_rate{0};
+};
+
+// Parses a scenario file. Each non-empty line that does not start with '#' is
+// '<model_path> <arrival_rate>', where arrival_rate is the mean number of requests per second.
+Status ParseScenarioFile(const std::basic_string<ORTCHAR_T>& path, std::vector<ScenarioModel>& models);
+
+// Runs a mix of models against each other to reproduce multi-tenant interference.
+//
+// Requests for each model arrive as an independent Poisson process (exponentially distributed
+// inter-arrival times) for run_config.duration_in_seconds. Arrivals are open-loop: they are issued on
+// schedule regardless of how many earlier requests are still queued or running, so a saturated
+// machine shows up as growing latency rather than as a lower request rate. Requests are executed by
+// a pool of run_config.concurrent_session_runs workers (at least one per model).
+//
+// Latency is measured from the scheduled arrival to completion and so includes queueing; the
+// session run time alone is reported as the service time. CPU usage and per-model completions are
+// sampled once a second.
+class ScenarioRunner {
+ public:
+  ScenarioRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd);
+
+  ~ScenarioRunner();
+  Status Run();
+
+  void SerializeResult() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScenarioRunner);
+
+ private:
+  struct ModelState {
+    ScenarioModel model;
+    std::string name;
+    std::unique_ptr<PerformanceRunner> runner;
+    OrtMutex mutex;
+    std::vector<double> latencies;
+    std::vector<double> service_times;
+    size_t issued{0};
+    size_t failed{0};
+    // completions since the last utilization sample
+    size_t completed_in_interval{0};
+  };
+
+  struct UtilizationSample {
+    double elapsed_seconds;
+    short cpu_usage;
+    std::vector<size_t> completions;
+  };
+
+  Status Initialize();
+
+  PerformanceTestConfig performance_test_config_;
+  Ort::Env& env_;
+  std::random_device& rd_;
+  std::vector<std::unique_ptr<ModelState>> models_;
+  std::vector<UtilizationSample> utilization_;
+  std::chrono::duration<double> run_duration_{0};
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -57,6 +57,10 @@ struct RunConfig {
   std::basic_string<ORTCHAR_T> ep_runtime_config_string;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_name_overrides;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_denotation_overrides;
+  // Run a mix of models with open-loop Poisson arrivals. See ScenarioRunner.
+  std::basic_string<ORTCHAR_T> scenario_file_path;
+  bool share_thread_pools{false};
+  bool share_cuda_stream{false};
 };
 
 struct PerformanceTestConfig {
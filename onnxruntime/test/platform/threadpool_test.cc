@@ -4,11 +4,14 @@
 #include "core/platform/threadpool.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
+#include "core/util/thread_utils.h"
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -64,6 +67,25 @@ void TestParallelFor(const std::string& name, int num_threads, int num_tasks) {
   ValidateTestData(*test_data);
 }
 
+// Runs a guided loop whose iterations grow more expensive towards the end, with a cost per iteration
+// that is low enough for the loop to be split into blocks of several iterations.
+void TestGuidedParallelFor(const std::string& name, int num_threads, int num_tasks) {
+  auto test_data = CreateTestData(num_tasks);
+  CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
+    ThreadPool::TryParallelFor(tp, num_tasks, onnxruntime::TensorOpCost{0, 0, 1000.0}, ThreadPool::LoopScheduling::Guided,
+                               [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                 for (std::ptrdiff_t i = first; i < last; i++) {
+                                   volatile int work = 0;
+                                   for (std::ptrdiff_t j = 0; j < i; j++) {
+                                     work = work + 1;
+                                   }
+                                   IncrementElement(*test_data, i);
+                                 }
+                               });
+  });
+  ValidateTestData(*test_data);
+}
+
 void TestBatchParallelFor(const std::string& name, int num_threads, int num_tasks, int batch_size) {
   auto test_data = CreateTestData(num_tasks);
 
@@ -111,6 +133,37 @@ void TestConcurrentParallelFor(const std::string& name, int num_threads, int num
   }
 }
 
+void TestNumaParallelFor(const std::string&, int num_threads, int num_nodes, int num_concurrent, int num_tasks) {
+  // Pretend that the threads are spread over num_nodes NUMA nodes.  No affinity is set, so this
+  // exercises the node-local scheduling and stealing on any machine.
+  onnxruntime::ThreadOptions to;
+  for (int i = 0; i < num_threads; i++) {
+    to.numa_node.push_back(i * num_nodes / num_threads);
+  }
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), to, nullptr, num_threads, true);
+
+  for (int rep = 0; rep < 5; rep++) {
+    std::vector<std::unique_ptr<TestData>> td;
+    onnxruntime::Barrier b(num_concurrent - 1);
+    for (int c = 0; c < num_concurrent; c++) {
+      td.push_back(CreateTestData(num_tasks));
+    }
+    for (int c = 0; c < num_concurrent - 1; c++) {
+      ThreadPool::Schedule(tp.get(), [&, c]() {
+        ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*td[c], i); });
+        b.Notify();
+      });
+    }
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) {
+      IncrementElement(*td[num_concurrent - 1], i);
+    });
+    b.Wait();
+    for (int c = 0; c < num_concurrent; c++) {
+      ValidateTestData(*td[c]);
+    }
+  }
+}
+
 void TestBurstScheduling(const std::string& name, int num_tasks) {
   // Test submitting a burst of functions for executing.  The aim is to provoke cases such
   // as the thread pool's work queues being full.
@@ -216,6 +269,35 @@ void TestStagedMultiLoopSections(const std::string& name, int num_threads, int n
   }
 }
 
+// A minimal executor of the application for the OrtExternalExecutor tests.  Scheduled
+// functions run inline, and the calls of a ParallelFor run on new threads and the caller.
+struct TestExecutor {
+  std::atomic<int> scheduled{0};
+  std::atomic<int> parallel_fors{0};
+};
+
+void ORT_API_CALL TestExecutorSchedule(void* executor_param, void(ORT_API_CALL* fn)(void*), void* fn_param) {
+  static_cast<TestExecutor*>(executor_param)->scheduled++;
+  fn(fn_param);
+}
+
+void ORT_API_CALL TestExecutorParallelFor(void* executor_param, void(ORT_API_CALL* fn)(void*, size_t),
+                                          void* fn_param, size_t n) {
+  static_cast<TestExecutor*>(executor_param)->parallel_fors++;
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < n; i++) {
+    threads.emplace_back([=]() { fn(fn_param, i); });
+  }
+  fn(fn_param, 0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+int ORT_API_CALL TestExecutorDegreeOfParallelism(void*) {
+  return 4;
+}
+
 }  // namespace
 
 namespace onnxruntime {
@@ -263,6 +345,22 @@ TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_81_Task_20_Batch) {
   TestBatchParallelFor("TestBatchParallelFor_2_Thread_81_Task_20_Batch", 2, 81, 20);
 }
 
+TEST(ThreadPoolTest, TestGuidedParallelFor_0Thread_1000Task) {
+  TestGuidedParallelFor("TestGuidedParallelFor_0Thread_1000Task", 0, 1000);
+}
+
+TEST(ThreadPoolTest, TestGuidedParallelFor_2Thread_1Task) {
+  TestGuidedParallelFor("TestGuidedParallelFor_2Thread_1Task", 2, 1);
+}
+
+TEST(ThreadPoolTest, TestGuidedParallelFor_4Thread_1000Task) {
+  TestGuidedParallelFor("TestGuidedParallelFor_4Thread_1000Task", 4, 1000);
+}
+
+TEST(ThreadPoolTest, TestGuidedParallelFor_4Thread_10000Task) {
+  TestGuidedParallelFor("TestGuidedParallelFor_4Thread_10000Task", 4, 10000);
+}
+
 TEST(ThreadPoolTest, TestConcurrentParallelFor_0Thread_1Conc_0Tasks) {
   TestConcurrentParallelFor("TestConcurrentParallelFor_0Thread_1Conc_0Tasks", 0, 1, 0);
 }
@@ -331,6 +429,18 @@ TEST(ThreadPoolTest, TestConcurrentParallelFor_4Thread_4Conc_1MTasks) {
   TestConcurrentParallelFor("TestConcurrentParallelFor_4Thread_4Conc_1MTasks", 4, 4, 1000000);
 }
 
+TEST(ThreadPoolTest, TestNumaParallelFor_4Thread_2Node_1Conc_1KTasks) {
+  TestNumaParallelFor("TestNumaParallelFor_4Thread_2Node_1Conc_1KTasks", 4, 2, 1, 1000);
+}
+
+TEST(ThreadPoolTest, TestNumaParallelFor_8Thread_2Node_4Conc_1KTasks) {
+  TestNumaParallelFor("TestNumaParallelFor_8Thread_2Node_4Conc_1KTasks", 8, 2, 4, 1000);
+}
+
+TEST(ThreadPoolTest, TestNumaParallelFor_8Thread_3Node_4Conc_1MTasks) {
+  TestNumaParallelFor("TestNumaParallelFor_8Thread_3Node_4Conc_1MTasks", 8, 3, 4, 1000000);
+}
+
 TEST(ThreadPoolTest, TestBurstScheduling_0Tasks) {
   TestBurstScheduling("TestBurstScheduling_0Tasks", 0);
 }
@@ -424,6 +534,105 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_10Loop) {
 TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
+
+TEST(ThreadPoolTest, TestPerformanceCoresOnly) {
+  // The pool is bound to the performance cores of hybrid CPUs, and is created as usual elsewhere.
+  const auto performance_cores = Env::Default().GetPerformanceCoreThreadAffinityMasks();
+  OrtThreadPoolParams params;
+  params.performance_cores_only = true;
+  auto tp = concurrency::CreateThreadPool(&Env::Default(), params, concurrency::ThreadPoolType::INTRA_OP);
+  if (performance_cores.size() > 1) {
+    ASSERT_NE(tp, nullptr);
+  }
+
+  auto test_data = CreateTestData(100);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestKeepWorkersHot) {
+  // A pool created without spinning spins only while kept hot, and
+  // the hints may overlap.
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr,
+                                         4, false);
+  auto test_data = CreateTestData(100);
+  {
+    ThreadPool::KeepWorkersHot hot(tp.get());
+    for (int loop = 0; loop < 10; loop++) {
+      ThreadPool::KeepWorkersHot overlapping_hot(tp.get());
+      ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    }
+  }
+  // The workers block again once the hints end, and wake for new work
+  ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ValidateTestData(*test_data, 11);
+
+  ThreadPool::KeepWorkersHot no_pool(nullptr);
+}
+
+#ifndef ORT_MINIMAL_BUILD
+TEST(ThreadPoolTest, TestTaskTrace) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr,
+                                         4, true);
+  auto test_data = CreateTestData(1000);
+  ThreadPool::StartProfiling(tp.get(), false, true);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  std::vector<ThreadPoolTaskRecord> tasks;
+  ThreadPool::StopProfiling(tp.get(), &tasks);
+  ValidateTestData(*test_data);
+
+  // The blocks cover the iterations exactly once, and each task starts after it was queued
+  std::vector<int> iterations(1000, 0);
+  for (const auto& task : tasks) {
+    ASSERT_LE(task.enqueue_time, task.start_time);
+    ASSERT_LE(task.start_time, task.end_time);
+    ASSERT_GE(task.worker, -1);
+    ASSERT_LT(task.worker, 3);
+    if (task.is_loop_block) {
+      for (std::ptrdiff_t i = task.first; i < task.last; i++) {
+        iterations[i]++;
+      }
+    } else {
+      ASSERT_NE(task.worker, -1);
+    }
+  }
+  ASSERT_TRUE(std::all_of(iterations.cbegin(), iterations.cend(), [](int count) { return count == 1; }));
+
+  // The tasks are only recorded with the trace
+  ThreadPool::StartProfiling(tp.get());
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  tasks.clear();
+  ThreadPool::StopProfiling(tp.get(), &tasks);
+  ASSERT_TRUE(tasks.empty());
+  ValidateTestData(*test_data, 2);
+}
+#endif
+
+TEST(ThreadPoolTest, TestExternalExecutor) {
+  // The pool creates no threads and forwards its loops and scheduled functions to the executor.
+  TestExecutor executor;
+  OrtThreadPoolParams params;
+  params.external_executor = {TestExecutorSchedule, TestExecutorParallelFor, TestExecutorDegreeOfParallelism,
+                              &executor};
+  auto tp = concurrency::CreateThreadPool(&Env::Default(), params, concurrency::ThreadPoolType::INTER_OP);
+  ASSERT_NE(tp, nullptr);
+  ASSERT_EQ(ThreadPool::GetUtilization(tp.get()).num_threads, 3);
+
+  auto test_data = CreateTestData(1000);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  {
+    ThreadPool::ParallelSection ps(tp.get());
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  }
+  ValidateTestData(*test_data, 2);
+  ASSERT_EQ(executor.parallel_fors, 2);
+
+  bool ran = false;
+  ThreadPool::Schedule(tp.get(), [&]() { ran = true; });
+  ASSERT_TRUE(ran);
+  ASSERT_EQ(executor.scheduled, 1);
+  ASSERT_EQ(ThreadPool::GetUtilization(tp.get()).parallel_loops, 2u);
+}
 #ifdef _WIN32
 #pragma warning(push)
 #pragma warning(disable : 6387)
@@ -1038,6 +1038,67 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// when the subgraph passes 'cond' through unchanged the trip count is known, so the scan outputs are written
+// directly to the Loop output and the loop carried variable alternates between two buffers.
+TEST(Loop, KnownTripCountWithLoopCarriedAndScanOutputs) {
+  auto create_subgraph = []() {
+    Model model("Known trip count subgraph", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, loop carried state variables.
+
+         iter_num_in    cond_in      loop_var_0_in
+          (unused)         |          |         |
+                           |        [Add]   [Identity]
+                           |          |         |
+                        cond_in  loop_var_0_out  scan_0_out
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& loop_var_0_in = graph.GetOrCreateNodeArg("loop_var_0_in", &float_tensor);
+
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_tensor);
+    auto& scan_0_out = graph.GetOrCreateNodeArg("scan_0_out", &float_tensor);
+
+    graph.AddNode("double", "Add", "Double loop_var_0_in", {&loop_var_0_in, &loop_var_0_in}, {&loop_var_0_out});
+    graph.AddNode("scan_0", "Identity", "Output loop_var_0_in", {&loop_var_0_in}, {&scan_0_out});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &loop_var_0_in});
+    graph.SetOutputs({&cond_in, &loop_var_0_out, &scan_0_out});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {4});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("loop_var_0_initial", {2}, {1.f, 2.f});
+
+  test.AddOutput<float>("loop_var_0_final", {2}, {16.f, 32.f});
+  test.AddOutput<float>("scan_0_final", {4, 2}, {1.f, 2.f, 2.f, 4.f, 4.f, 8.f, 8.f, 16.f});
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #ifdef USE_CUDA
 // test that when part of the subgraph run on CUDA it executes successfully
 TEST(Loop, MixedExecutionProviders) {
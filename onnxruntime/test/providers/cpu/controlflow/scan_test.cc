@@ -1173,6 +1173,56 @@ void UnknownDimInSubgraphOutput(bool is_v8, bool mixed_execution_providers = fal
 
 TEST_8_AND_9(UnknownDimInSubgraphOutput);
 
+// without loop state variables the batch entries (v8) or iterations (v9) are executed concurrently.
+// the subgraph output has a symbolic dimension so the first execution allocates the Scan output,
+// and the reversed input checks each execution reads and writes its own slices.
+static void NoLoopStateVarReversedInput(bool is_v8) {
+  Model model("ScanBody", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("param");
+
+  auto& scan_in_1 = graph.GetOrCreateNodeArg("scan_in_1", &float_tensor);
+  auto& scan_out_1 = graph.GetOrCreateNodeArg("scan_out_1", &float_tensor);
+
+  graph.AddNode("node1", "Identity", "Copy scan_in_1 to scan_out_1", {&scan_in_1}, {&scan_out_1});
+
+  graph.SetInputs({&scan_in_1});
+  graph.SetOutputs({&scan_out_1});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  auto& scan_body = graph.ToGraphProto();
+
+  ScanOpTester test{is_v8 ? 8 : 9};
+
+  std::vector<int64_t> seq_shape;
+  std::vector<float> output;
+  if (is_v8) {
+    seq_shape = {3, 2, 2};
+    output = {2.f, 3.f, 0.f, 1.f, 6.f, 7.f, 4.f, 5.f, 10.f, 11.f, 8.f, 9.f};
+    test.AddMissingOptionalInput<int64_t>();
+    test.AddAttribute<std::vector<int64_t>>("directions", {1});
+  } else {
+    seq_shape = {6, 2};
+    output = {10.f, 11.f, 8.f, 9.f, 6.f, 7.f, 4.f, 5.f, 2.f, 3.f, 0.f, 1.f};
+    test.AddAttribute<std::vector<int64_t>>("scan_input_directions", {1});
+  }
+
+  test.AddAttribute("body", scan_body);
+  test.AddAttribute<int64_t>("num_scan_inputs", 1);
+
+  test.AddInput<float>("scan_input_1", seq_shape, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f});
+  test.AddOutput<float>("scan_output_1", seq_shape, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types);
+}
+
+TEST_8_AND_9(NoLoopStateVarReversedInput);
+
 #ifdef USE_CUDA
 TEST(Scan, MixedExecutionProviders) {
   RunOptions options{};
@@ -6,6 +6,7 @@
 #include "test/common/cuda_op_test_utils.h"
 #include "core/framework/data_types.h"
 #include "core/util/math.h"
+#include "core/providers/cpu/math/einsum_utils/einsum_contraction_planner.h"
 
 namespace onnxruntime {
 namespace test {
@@ -714,5 +715,57 @@ TEST(Einsum, ExplicitEinsumAsTensorContraction_Half) {
   test.Run();
 }
 
+// Contracting the last 2 operands first is cheaper than going left to right
+TEST(Einsum, ContractionPlanPicksCheapestOrder) {
+  // Labels a, b, c, d homogenized: "ab,bc,cd->ad" with a = 1000, b = 10, c = 1000, d = 10
+  std::vector<TensorShape> homogenized_input_dims = {TensorShape({1000, 10, 1, 1}),
+                                                     TensorShape({1, 10, 1000, 1}),
+                                                     TensorShape({1, 1, 1000, 10})};
+  std::vector<int64_t> subscript_indices_to_output_indices = {0, -1, -1, 1};
+  auto plan = EinsumOp::PlanContraction(homogenized_input_dims, subscript_indices_to_output_indices);
+  ASSERT_EQ(plan.size(), static_cast<size_t>(2));
+  EXPECT_EQ(plan[0].left, static_cast<size_t>(1));
+  EXPECT_EQ(plan[0].right, static_cast<size_t>(2));
+  EXPECT_EQ(plan[1].left, static_cast<size_t>(0));
+  EXPECT_EQ(plan[1].right, static_cast<size_t>(1));
+
+  EinsumOp::ContractionPlanCache cache;
+  auto cached_plan = cache.GetOrCreate(homogenized_input_dims, subscript_indices_to_output_indices);
+  ASSERT_EQ(cached_plan.size(), plan.size());
+  EXPECT_EQ(cached_plan[0].left, plan[0].left);
+  EXPECT_EQ(cached_plan[0].right, plan[0].right);
+}
+
+TEST(Einsum, ExplicitEinsumAsChainedMatmulReordered) {
+  const int64_t a = 4, b = 2, c = 4, d = 2;
+  std::vector<float> x(a * b), y(b * c), z(c * d), o(a * d, 0.f);
+  for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>(i + 1);
+  for (size_t i = 0; i < y.size(); ++i) y[i] = static_cast<float>(i % 3) - 1.f;
+  for (size_t i = 0; i < z.size(); ++i) z[i] = static_cast<float>(i % 5);
+  for (int64_t i = 0; i < a; ++i)
+    for (int64_t j = 0; j < b; ++j)
+      for (int64_t k = 0; k < c; ++k)
+        for (int64_t l = 0; l < d; ++l)
+          o[i * d + l] += x[i * b + j] * y[j * c + k] * z[k * d + l];
+
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ab,bc,cd->ad");
+  test.AddInput<float>("x", {a, b}, x);
+  test.AddInput<float>("y", {b, c}, y);
+  test.AddInput<float>("z", {c, d}, z);
+  test.AddOutput<float>("o", {a, d}, o);
+  test.Run();
+}
+
+// The right operand has 2 dims that only it has and that are reduced
+TEST(Einsum, ExplicitEinsumReduceMultipleDimsOfRightOperand) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jkl->i");
+  test.AddInput<float>("x", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<float>("y", {2, 2, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f});
+  test.AddOutput<float>("o", {2}, {62.f, 134.f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -403,6 +403,26 @@ TEST(MathOpTest, Sub_Broadcast_Scalar) {
   run(true);
 }
 
+// Channel-wise broadcast of the first input over an NCHW tensor.
+TEST(MathOpTest, Sub_Broadcast_Channel) {
+  OpTester test("Sub");
+
+  test.AddInput<float>("A", {2, 1, 1}, {100.0f, 200.0f});
+  test.AddInput<float>("B", {2, 2, 2, 3},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f,
+                        7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f,
+
+                        13.0f, 14.0f, 15.0f, 16.0f, 17.0f, 18.0f,
+                        19.0f, 20.0f, 21.0f, 22.0f, 23.0f, 24.0f});
+  test.AddOutput<float>("C", {2, 2, 2, 3},
+                        {99.0f, 98.0f, 97.0f, 96.0f, 95.0f, 94.0f,
+                         193.0f, 192.0f, 191.0f, 190.0f, 189.0f, 188.0f,
+
+                         87.0f, 86.0f, 85.0f, 84.0f, 83.0f, 82.0f,
+                         181.0f, 180.0f, 179.0f, 178.0f, 177.0f, 176.0f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "");
+}
+
 TEST(MathOpTest, Mul_int32) {
   OpTester test("Mul");
   test.AddInput<int32_t>("A", {3}, {1, 2, 3});
@@ -4,6 +4,8 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
+#include "test/util/include/default_providers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace test {
@@ -448,5 +450,55 @@ TEST(GemmOpTest, GemmWithAlphaOpset11) {
   TestGemmWithAlphaOpset11<double>();
 }
 
+// The inputs are small integers that are exactly representable in bfloat16, so the bfloat16 GEMM enabled by
+// kOrtSessionOptionsConfigGemmFastMathBf16 produces the exact result. On platforms without bfloat16 support the
+// option is ignored.
+TEST(GemmOpTest, GemmTransBFastMathBf16) {
+  constexpr int64_t M = 17;
+  constexpr int64_t K = 40;
+  constexpr int64_t N = 24;
+
+  std::vector<float> a_vals(M * K);
+  std::vector<float> b_vals(N * K);
+  std::vector<float> c_vals(N);
+  std::vector<float> y_vals(M * N);
+
+  for (int64_t i = 0; i < M * K; ++i) {
+    a_vals[i] = static_cast<float>((i * 7) % 5 - 2);
+  }
+  for (int64_t i = 0; i < N * K; ++i) {
+    b_vals[i] = static_cast<float>((i * 3) % 7 - 3);
+  }
+  for (int64_t n = 0; n < N; ++n) {
+    c_vals[n] = static_cast<float>(n % 4);
+  }
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a_vals[m * K + k] * b_vals[n * K + k];
+      }
+      y_vals[m * N + n] = 2.0f * sum + 0.5f * c_vals[n];
+    }
+  }
+
+  OpTester test("Gemm", 13);
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 2.0f);
+  test.AddAttribute("beta", 0.5f);
+  test.AddInput<float>("A", {M, K}, a_vals);
+  test.AddInput<float>("B", {N, K}, b_vals, true);
+  test.AddInput<float>("C", {N}, c_vals);
+  test.AddOutput<float>("Y", {M, N}, y_vals);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGemmFastMathBf16, "1"));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
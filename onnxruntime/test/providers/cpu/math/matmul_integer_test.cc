@@ -26,6 +26,16 @@ TEST(MatmulIntegerOpTest, MatMulInteger_2D) {
   test.Run();
 }
 
+TEST(MatmulIntegerOpTest, MatMulInteger_2D_PerColumn_ZeroPoint) {
+  OpTester test("MatMulInteger", 10);
+  test.AddInput<uint8_t>("T1", {4, 3}, {11, 7, 3, 10, 6, 2, 9, 5, 1, 8, 4, 0});
+  test.AddInput<uint8_t>("T2", {3, 2}, {1, 4, 2, 5, 3, 6});
+  test.AddInput<uint8_t>("a_zero_point", {}, {12});
+  test.AddInput<uint8_t>("b_zero_point", {2}, {1, 2});
+  test.AddOutput<int32_t>("T3", {4, 2}, {-23, -53, -26, -62, -29, -71, -32, -80});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider});
+}
+
 TEST(MatmulIntegerOpTest, MatMulInteger_2D_empty_input) {
   OpTester test("MatMulInteger", 10);
   test.AddInput<uint8_t>("T1", {0, 3}, {});
@@ -273,17 +283,18 @@ T GetMiddle(const std::vector<T>& v) {
 }
 
 // [M x N] = [M x K] x [K x N] = [batch_seq x input_dim] x [input_dim x embed_dim]
-template <typename ScalarB>
-void RunMatMulIntegerU8X8Test(const int M, const int N, const int K, bool non_zero_zp, bool B_is_initializer) {
+template <typename ScalarA, typename ScalarB>
+void RunMatMulIntegerX8X8Test(const int M, const int N, const int K, bool non_zero_zp, bool B_is_initializer) {
   OpTester test("MatMulInteger", 10);
   static std::default_random_engine e(123);
-  static std::uniform_int_distribution<int> n_unsigned(0, 127);
+  // Unsigned matrix A is limited to 7 bits to match the U8S8 kernel requirements.
+  static std::uniform_int_distribution<int> n_xint8_a(std::numeric_limits<ScalarA>::min(), 127);
   static std::uniform_int_distribution<int> n_xint8(std::numeric_limits<ScalarB>::min(), std::numeric_limits<ScalarB>::max());
 
   Eigen::MatrixXi matrix_a = Eigen::MatrixXi::Random(K, M)
-                                 .unaryExpr([](int) { return n_unsigned(e); });
-  std::vector<uint8_t> matrix_a_data = ToVector<uint8_t>(matrix_a.data(), M * K);
-  uint8_t a_zero_point = non_zero_zp ? GetMiddle(matrix_a_data) : 0;
+                                 .unaryExpr([](int) { return n_xint8_a(e); });
+  std::vector<ScalarA> matrix_a_data = ToVector<ScalarA>(matrix_a.data(), M * K);
+  ScalarA a_zero_point = non_zero_zp ? GetMiddle(matrix_a_data) : 0;
   Eigen::MatrixXi matrix_a_offset = matrix_a - a_zero_point * Eigen::MatrixXi::Ones(K, M);
 
   Eigen::MatrixXi matrix_b = Eigen::MatrixXi::Random(N, K)
@@ -294,15 +305,23 @@ void RunMatMulIntegerU8X8Test(const int M, const int N, const int K, bool non_ze
 
   Eigen::MatrixXi matrix_c = (matrix_b_offset * matrix_a_offset).eval();
 
-  test.AddInput<uint8_t>("T1", {M, K}, std::move(matrix_a_data));
+  test.AddInput<ScalarA>("T1", {M, K}, std::move(matrix_a_data));
   test.AddInput<ScalarB>("T2", {K, N}, std::move(matrix_b_data), B_is_initializer);
   if (non_zero_zp) {
-    test.AddInput<uint8_t>("a_zero_point", {}, {a_zero_point});
+    test.AddInput<ScalarA>("a_zero_point", {}, {a_zero_point});
     test.AddInput<ScalarB>("b_zero_point", {}, {b_zero_point});
   }
 
   test.AddOutput<int32_t>("T3", {M, N}, ToVector<int32_t>(matrix_c.data(), M * N));
 
+  // Signed matrix A is only verified against the CPU provider.
+  if (std::is_signed<ScalarA>::value) {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+    return;
+  }
+
   // Nuphar provider does not support non-zero zero point
   if (non_zero_zp) {
     test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kNupharExecutionProvider});
@@ -311,15 +330,23 @@ void RunMatMulIntegerU8X8Test(const int M, const int N, const int K, bool non_ze
   }
 }
 
-#define RUN_MATMUL_INTEGER_U8X8(M, N, K)                                                         \
-  RunMatMulIntegerU8X8Test<int8_t>(M, N, K, false /*non_zero_zp*/, false /*B_is_initializer*/);  \
-  RunMatMulIntegerU8X8Test<int8_t>(M, N, K, false /*non_zero_zp*/, true /*B_is_initializer*/);   \
-  RunMatMulIntegerU8X8Test<int8_t>(M, N, K, true /*non_zero_zp*/, false /*B_is_initializer*/);   \
-  RunMatMulIntegerU8X8Test<int8_t>(M, N, K, true /*non_zero_zp*/, true /*B_is_initializer*/);    \
-  RunMatMulIntegerU8X8Test<uint8_t>(M, N, K, false /*non_zero_zp*/, false /*B_is_initializer*/); \
-  RunMatMulIntegerU8X8Test<uint8_t>(M, N, K, false /*non_zero_zp*/, true /*B_is_initializer*/);  \
-  RunMatMulIntegerU8X8Test<uint8_t>(M, N, K, true /*non_zero_zp*/, false /*B_is_initializer*/);  \
-  RunMatMulIntegerU8X8Test<uint8_t>(M, N, K, true /*non_zero_zp*/, true /*B_is_initializer*/);
+#define RUN_MATMUL_INTEGER_U8X8(M, N, K)                                                                  \
+  RunMatMulIntegerX8X8Test<uint8_t, int8_t>(M, N, K, false /*non_zero_zp*/, false /*B_is_initializer*/);  \
+  RunMatMulIntegerX8X8Test<uint8_t, int8_t>(M, N, K, false /*non_zero_zp*/, true /*B_is_initializer*/);   \
+  RunMatMulIntegerX8X8Test<uint8_t, int8_t>(M, N, K, true /*non_zero_zp*/, false /*B_is_initializer*/);   \
+  RunMatMulIntegerX8X8Test<uint8_t, int8_t>(M, N, K, true /*non_zero_zp*/, true /*B_is_initializer*/);    \
+  RunMatMulIntegerX8X8Test<uint8_t, uint8_t>(M, N, K, false /*non_zero_zp*/, false /*B_is_initializer*/); \
+  RunMatMulIntegerX8X8Test<uint8_t, uint8_t>(M, N, K, false /*non_zero_zp*/, true /*B_is_initializer*/);  \
+  RunMatMulIntegerX8X8Test<uint8_t, uint8_t>(M, N, K, true /*non_zero_zp*/, false /*B_is_initializer*/);  \
+  RunMatMulIntegerX8X8Test<uint8_t, uint8_t>(M, N, K, true /*non_zero_zp*/, true /*B_is_initializer*/);
+
+#define RUN_MATMUL_INTEGER_S8X8(M, N, K)                                                                 \
+  RunMatMulIntegerX8X8Test<int8_t, int8_t>(M, N, K, false /*non_zero_zp*/, false /*B_is_initializer*/);  \
+  RunMatMulIntegerX8X8Test<int8_t, int8_t>(M, N, K, false /*non_zero_zp*/, true /*B_is_initializer*/);   \
+  RunMatMulIntegerX8X8Test<int8_t, int8_t>(M, N, K, true /*non_zero_zp*/, false /*B_is_initializer*/);   \
+  RunMatMulIntegerX8X8Test<int8_t, int8_t>(M, N, K, true /*non_zero_zp*/, true /*B_is_initializer*/);    \
+  RunMatMulIntegerX8X8Test<int8_t, uint8_t>(M, N, K, false /*non_zero_zp*/, false /*B_is_initializer*/); \
+  RunMatMulIntegerX8X8Test<int8_t, uint8_t>(M, N, K, true /*non_zero_zp*/, true /*B_is_initializer*/);
 
 TEST(MatmulIntegerOpTest, MatMulInteger_Uint8_Int8_Scalar) {
   RUN_MATMUL_INTEGER_U8X8(1, 1, 32);
@@ -343,5 +370,18 @@ TEST(MatmulIntegerOpTest, MatMulInteger_Uint8_Int8_GEMM) {
   RUN_MATMUL_INTEGER_U8X8(4, 8, 68);
 }
 
+TEST(MatmulIntegerOpTest, MatMulInteger_Int8_Int8_GEMV) {
+  RUN_MATMUL_INTEGER_S8X8(1, 1, 32);
+  RUN_MATMUL_INTEGER_S8X8(1, 8, 68);
+  RUN_MATMUL_INTEGER_S8X8(1, 512, 1024);
+}
+
+TEST(MatmulIntegerOpTest, MatMulInteger_Int8_Int8_GEMM) {
+  RUN_MATMUL_INTEGER_S8X8(2, 2, 40);
+  RUN_MATMUL_INTEGER_S8X8(2, 48, 33);
+  RUN_MATMUL_INTEGER_S8X8(4, 8, 68);
+  RUN_MATMUL_INTEGER_S8X8(31, 67, 130);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace test {
@@ -145,5 +147,87 @@ TEST(MathOpTest, MatMulUint64Type) {
   RunMatMulTest<uint64_t>(9);
 }
 
+// The inputs are small integers that are exactly representable in bfloat16, so the bfloat16 GEMM enabled by
+// kOrtSessionOptionsConfigGemmFastMathBf16 produces the exact result. On platforms without bfloat16 support the
+// option is ignored.
+TEST(MathOpTest, MatMulFloatFastMathBf16) {
+  constexpr int64_t M = 20;
+  constexpr int64_t K = 45;
+  constexpr int64_t N = 35;
+
+  std::vector<float> a_vals(M * K);
+  std::vector<float> b_vals(K * N);
+  std::vector<float> y_vals(M * N, 0.0f);
+
+  for (int64_t i = 0; i < M * K; ++i) {
+    a_vals[i] = static_cast<float>((i * 7) % 5 - 2);
+  }
+  for (int64_t i = 0; i < K * N; ++i) {
+    b_vals[i] = static_cast<float>((i * 3) % 7 - 3);
+  }
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      for (int64_t k = 0; k < K; ++k) {
+        y_vals[m * N + n] += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 13);
+  test.AddInput<float>("A", {M, K}, a_vals);
+  test.AddInput<float>("B", {K, N}, b_vals, true);
+  test.AddOutput<float>("Y", {M, N}, y_vals);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGemmFastMathBf16, "1"));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+// B is a constant pruned to 4x4 blocks of zeros, so MatMul packs it into the block sparse format enabled by
+// kOrtSessionOptionsConfigGemmSparseMaxDensity. The products are exact, so the result matches the dense one.
+TEST(MathOpTest, MatMulFloatBlockSparseB) {
+  constexpr int64_t M = 7;
+  constexpr int64_t K = 32;
+  constexpr int64_t N = 24;
+
+  std::vector<float> a_vals(M * K);
+  std::vector<float> b_vals(K * N, 0.0f);
+  std::vector<float> y_vals(M * N, 0.0f);
+
+  for (int64_t i = 0; i < M * K; ++i) {
+    a_vals[i] = static_cast<float>((i * 7) % 5 - 2);
+  }
+  // keep one in five of the 4x4 blocks
+  for (int64_t k = 0; k < K; ++k) {
+    for (int64_t n = 0; n < N; ++n) {
+      if ((k / 4 * (N / 4) + n / 4) % 5 == 0) {
+        b_vals[k * N + n] = static_cast<float>((k * N + n) % 7 - 3);
+      }
+    }
+  }
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      for (int64_t k = 0; k < K; ++k) {
+        y_vals[m * N + n] += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 13);
+  test.AddInput<float>("A", {M, K}, a_vals);
+  test.AddInput<float>("B", {K, N}, b_vals, true);
+  test.AddOutput<float>("Y", {M, N}, y_vals);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGemmSparseMaxDensity, "0.25"));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -5,6 +5,8 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <random>
+
 namespace onnxruntime {
 namespace test {
 
@@ -245,6 +247,88 @@ TEST(SoftmaxOperator, ThreeDimsNegativeAxis) {
   RunTest(x_vals_3dims, expected_vals, three_dimensions, /*opset*/ 12, /*axis*/ -1);
 }
 
+// softmax along an outer axis, which the float kernel computes without transposing the input
+static void RunOuterAxisTest(const std::vector<int64_t>& dimensions, int64_t axis, bool log_softmax) {
+  const TensorShape shape(dimensions);
+  const size_t N = static_cast<size_t>(shape.SizeToDimension(static_cast<size_t>(axis)));
+  const size_t D = static_cast<size_t>(shape[static_cast<size_t>(axis)]);
+  const size_t stride = static_cast<size_t>(shape.SizeFromDimension(static_cast<size_t>(axis) + 1));
+
+  std::default_random_engine generator(static_cast<unsigned>(N * D * stride));
+  std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+  std::vector<float> x_vals(N * D * stride);
+  for (auto& v : x_vals) v = distribution(generator);
+
+  std::vector<float> expected_vals(x_vals.size());
+  for (size_t n = 0; n < N; n++) {
+    for (size_t s = 0; s < stride; s++) {
+      const size_t offset = n * D * stride + s;
+      float max_value = x_vals[offset];
+      for (size_t d = 1; d < D; d++) max_value = std::max(max_value, x_vals[offset + d * stride]);
+      double sum = 0.0;
+      for (size_t d = 0; d < D; d++) sum += std::exp(double(x_vals[offset + d * stride]) - max_value);
+      for (size_t d = 0; d < D; d++) {
+        const double value = double(x_vals[offset + d * stride]) - max_value;
+        expected_vals[offset + d * stride] = static_cast<float>(log_softmax ? value - std::log(sum)
+                                                                            : std::exp(value) / sum);
+      }
+    }
+  }
+
+  OpTester test(log_softmax ? "LogSoftmax" : "Softmax", 13);
+  test.AddAttribute("axis", axis);
+  test.AddInput<float>("X", dimensions, x_vals);
+  test.AddOutput<float>("Y", dimensions, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+TEST(SoftmaxOperator, OuterAxis_opset13) {
+  RunOuterAxisTest({2, 7, 37}, 1, false);
+  RunOuterAxisTest({3, 16, 5, 5}, 1, false);
+  RunOuterAxisTest({5, 3, 4}, 0, false);
+  RunOuterAxisTest({2, 7, 37}, 1, true);
+  RunOuterAxisTest({3, 16, 5, 5}, 1, true);
+}
+
+TEST(SoftmaxOperator, ThreeDimsAxis1_opset13_Float16) {
+  // same values as ThreeDimsAxis1_opset13, computed in float and rounded to float16
+  std::vector<float> expected_vals = {
+      0.253289f, 0.11198013f, 0.08185529f, 0.35567388f, 0.24795689f,
+      0.44600812f, 0.46761957f, 0.09471639f, 0.2796827f, 0.3307607f,
+      0.16864346f, 0.04540785f, 0.27406466f, 0.14939913f, 0.2167266f,
+      0.1320594f, 0.3749925f, 0.5493636f, 0.21524426f, 0.20455585f,
+
+      0.32341874f, 0.18241648f, 0.1747012f, 0.36767146f, 0.36021632f,
+      0.29275346f, 0.10176494f, 0.28598055f, 0.13050734f, 0.24336906f,
+      0.19977638f, 0.67461985f, 0.40293545f, 0.22843185f, 0.25989732f,
+      0.18405138f, 0.04119869f, 0.13638285f, 0.27338937f, 0.13651732f,
+
+      0.22807457f, 0.2577944f, 0.10201685f, 0.15962972f, 0.09529332f,
+      0.10314508f, 0.5011263f, 0.10428739f, 0.23931651f, 0.63683724f,
+      0.37181312f, 0.12944824f, 0.3946307f, 0.19975942f, 0.0699691f,
+      0.29696727f, 0.11163106f, 0.39906505f, 0.4012943f, 0.1979003f};
+
+  OpTester test("Softmax", 13);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddInput<MLFloat16>("X", three_dimensions, FloatsToMLFloat16s(x_vals_3dims));
+  test.AddOutput<MLFloat16>("Y", three_dimensions, FloatsToMLFloat16s(expected_vals));
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+TEST(SoftmaxOperator, ThreeDimsAxis1_Float16) {
+  // opset-12 and below flatten the dimensions from the axis onwards
+  std::vector<float> x_vals = {-1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 2.0f};
+  std::vector<float> expected_vals = {0.02421295f, 0.06581762f, 0.17891085f, 0.06581762f, 0.17891085f, 0.48633011f};
+
+  OpTester test("Softmax", 11);
+  test.AddInput<MLFloat16>("X", {1, 2, 3}, FloatsToMLFloat16s(x_vals));
+  test.AddOutput<MLFloat16>("Y", {1, 2, 3}, FloatsToMLFloat16s(expected_vals));
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 TEST(SoftmaxOperator, InvalidAxis) {
   std::vector<float> x_vals = {-1.0f, 0.0f, 1.0f};
   std::vector<float> expected_vals = {0.0f, 0.0f, 0.0f};
@@ -842,5 +842,52 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// Long rows with many equal values, which are selected by the radix select of the CUDA kernel: the values are
+// expected in order and equal values by index.
+template <typename T>
+static void TestLongRows(int64_t k, int64_t n, int64_t dimension, int64_t largest) {
+  std::vector<T> input_vals(n * dimension);
+  for (int64_t i = 0; i < n * dimension; ++i) {
+    input_vals[i] = static_cast<T>((i * 7919) % 1009) - static_cast<T>(500);
+  }
+
+  std::vector<int64_t> input_dimensions = {n, dimension};
+  std::vector<T> expected_vals;
+  std::vector<int64_t> expected_indices;
+  std::vector<int64_t> expected_dimensions = {n, k};
+  for (int64_t i = 0; i < n; ++i) {
+    const T* row = input_vals.data() + i * dimension;
+    std::vector<int64_t> indices(dimension);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::stable_sort(indices.begin(), indices.end(), [&](int64_t a, int64_t b) {
+      return largest == 1 ? row[a] > row[b] : row[a] < row[b];
+    });
+    for (int64_t j = 0; j < k; ++j) {
+      expected_vals.push_back(row[indices[j]]);
+      expected_indices.push_back(indices[j]);
+    }
+  }
+
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, -1,
+          largest);
+}
+
+TEST(TopKOperator, LongRowsTopKSorted) {
+  TestLongRows<float>(1000, 1, 1 << 17, 1);
+  TestLongRows<float>(1000, 1, 1 << 17, 0);
+  TestLongRows<float>(5000, 3, 40000, 1);
+  TestLongRows<double>(100, 2, 1 << 16, 1);
+  TestLongRows<int32_t>(5000, 1, 1 << 16, 0);
+}
+
+// Small k over the last axis, as in sampling from the logits of a large vocabulary.
+TEST(TopKOperator, SmallKLongRowsTopKSorted) {
+  TestLongRows<float>(1, 1, 50000, 1);
+  TestLongRows<float>(5, 1, 1 << 17, 1);
+  TestLongRows<float>(10, 4, 50000, 0);
+  TestLongRows<double>(16, 2, 40000, 1);
+  TestLongRows<int64_t>(8, 3, 50000, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -63,6 +63,46 @@ TEST(LabelEncoder, StringToIntOpset2) {
   test.Run();
 }
 
+TEST(LabelEncoder, StringToIntOpset2LargeVocabulary) {
+  constexpr int64_t num_keys = 10000;
+
+  std::vector<std::string> keys;
+  std::vector<std::int64_t> values;
+  for (int64_t i = 0; i < num_keys; ++i) {
+    keys.push_back("key_" + std::to_string(i));
+    values.push_back(i * 3);
+  }
+
+  // a repeated key keeps the last value
+  keys.push_back("key_6");
+  values.push_back(-6);
+  keys.push_back("");
+  values.push_back(-1);
+
+  std::vector<std::string> input;
+  std::vector<std::int64_t> output;
+  for (int64_t i = 0; i < 2 * num_keys; i += 3) {
+    input.push_back("key_" + std::to_string(i));
+    output.push_back(i == 6 ? -6 : (i < num_keys ? i * 3 : 5566));
+  }
+  input.push_back("");
+  output.push_back(-1);
+  input.push_back("key_");
+  output.push_back(5566);
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_strings", keys);
+  test.AddAttribute("values_int64s", values);
+  test.AddAttribute("default_int64", (std::int64_t)5566);
+
+  const std::vector<std::int64_t> dims{static_cast<std::int64_t>(input.size())};
+  test.AddInput<std::string>("X", dims, input);
+  test.AddOutput<std::int64_t>("Y", dims, output);
+
+  test.Run();
+}
+
 TEST(LabelEncoder, IntToStringOpset2) {
   std::vector<std::int64_t> dims{1, 5};
 
@@ -339,5 +339,73 @@ TEST(MLOpTest, TreeRegressorSingleTargetMax) {
   GenTreeAndRunTest1("MAX", true);
 }
 
+void GenTreeMissingTracksAndRunTest(int64_t n_obs, int n_trees) {
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+
+  // Leaves at different depths and missing values going to both sides, the rows are evaluated in blocks.
+  std::vector<int64_t> lefts = {1, 3, 0, 0, 5, 0, 0};
+  std::vector<int64_t> rights = {2, 4, 0, 0, 6, 0, 0};
+  std::vector<int64_t> treeids = {0, 0, 0, 0, 0, 0, 0};
+  std::vector<int64_t> nodeids = {0, 1, 2, 3, 4, 5, 6};
+  std::vector<int64_t> featureids = {0, 1, 0, 0, 0, 0, 0};
+  std::vector<float> thresholds = {0.5f, 0.f, 0.f, 0.f, -1.f, 0.f, 0.f};
+  std::vector<int64_t> missing_tracks_true = {1, 0, 0, 0, 1, 0, 0};
+  std::vector<std::string> modes = {"BRANCH_LEQ", "BRANCH_LEQ", "LEAF", "LEAF", "BRANCH_LEQ", "LEAF", "LEAF"};
+
+  std::vector<int64_t> target_treeids = {0, 0, 0, 0};
+  std::vector<int64_t> target_nodeids = {2, 3, 5, 6};
+  std::vector<int64_t> target_classids = {0, 0, 0, 0};
+  std::vector<float> target_weights = {1.f, 10.f, 100.f, 1000.f};
+
+  if (n_trees > 1) {
+    _multiply_update_array(lefts, n_trees);
+    _multiply_update_array(rights, n_trees);
+    _multiply_update_array(treeids, n_trees, (int64_t)1);
+    _multiply_update_array(nodeids, n_trees);
+    _multiply_update_array(featureids, n_trees);
+    _multiply_update_array(thresholds, n_trees);
+    _multiply_update_array(missing_tracks_true, n_trees);
+    _multiply_update_array_string(modes, n_trees);
+    _multiply_update_array(target_treeids, n_trees, (int64_t)1);
+    _multiply_update_array(target_nodeids, n_trees);
+    _multiply_update_array(target_classids, n_trees);
+    _multiply_update_array(target_weights, n_trees);
+  }
+
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_missing_value_tracks_true", missing_tracks_true);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_classids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<float> X = {1.f, 0.f, nan, -1.f, 0.f, nan, nan, 1.f, -2.f, 2.f};
+  const std::vector<float> results = {1.f, 10.f, 1000.f, 100.f, 100.f};
+  std::vector<float> xn(n_obs * 2);
+  std::vector<float> yn(n_obs);
+  for (int64_t i = 0; i < n_obs; ++i) {
+    xn[i * 2] = X[(i % 5) * 2];
+    xn[i * 2 + 1] = X[(i % 5) * 2 + 1];
+    yn[i] = results[i % 5] * n_trees;
+  }
+  test.AddInput<float>("X", {n_obs, 2}, xn);
+  test.AddOutput<float>("Y", {n_obs, 1}, yn);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorMissingTracksBatch) {
+  GenTreeMissingTracksAndRunTest(37, 1);     // section C
+  GenTreeMissingTracksAndRunTest(203, 1);    // section E
+  GenTreeMissingTracksAndRunTest(203, 130);  // section D
+}
+
 }  // namespace test
 }  // namespace onnxruntime
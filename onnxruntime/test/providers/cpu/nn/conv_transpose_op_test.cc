@@ -593,6 +593,38 @@ TEST(ConvTransposeTest, ConvTranspose_2D_Dilation_Group_1) {
   TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+// Upsampling by 2 with a 4x4 kernel, which runs as a convolution per phase of the output (sub-pixel decomposition)
+TEST(ConvTransposeTest, ConvTranspose_2D_Stride2_Group_Bias) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{4, 4},
+      {},
+      {},
+      vector<int64_t>{1, 1, 1, 1},
+      vector<int64_t>{2, 2},
+      {1, 1},
+      2,
+      "NOTSET"};
+
+  vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f, -1.0f, 0.5f, 2.0f, -2.0f};
+  vector<int64_t> X_shape = {1, 2, 2, 2};
+  vector<float> W = {-2.5f, 1.0f, -1.0f, 2.5f, 0.5f, -1.5f, 2.0f, 0.0f, -2.0f, 1.5f, -0.5f, -2.5f, 1.0f, -1.0f, 2.5f, 0.5f,
+                     -1.5f, 2.0f, 0.0f, -2.0f, 1.5f, -0.5f, -2.5f, 1.0f, -1.0f, 2.5f, 0.5f, -1.5f, 2.0f, 0.0f, -2.0f, 1.5f};
+  vector<int64_t> W_shape = {2, 1, 4, 4};
+  vector<float> B = {0.5f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  vector<int64_t> Y_shape = {1, 2, 4, 4};
+  auto expected_vals = {-1.0f, 3.5f, -2.5f, 4.5f,
+                        5.0f, -17.0f, 12.5f, -4.5f,
+                        -5.0f, 13.0f, -7.0f, 13.5f,
+                        5.0f, -9.0f, -1.0f, -1.5f,
+                        -0.5f, 2.25f, -2.25f, -2.25f,
+                        0.5f, 1.0f, -6.25f, -0.75f,
+                        -2.0f, -6.0f, 0.5f, 3.0f,
+                        4.0f, 2.0f, -9.0f, -2.0f};
+
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 TEST(ConvTransposeTest, ConvTranspose_DefaultStridesAndDilations) {
   ConvTransposeOpAttributes attrs = {
       vector<int64_t>{2, 2},        // kernel_shape
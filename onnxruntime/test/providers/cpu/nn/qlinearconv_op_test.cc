@@ -733,6 +733,17 @@ TEST(QLinearConvTest, Conv2D_U8S8_Groups_PerChannel) {
   test.Run();
 }
 
+TEST(QLinearConvTest, Conv2D_U8S8_Groups_Pointwise) {
+  // Each group reads its slice of the channels directly from the input tensor.
+  QLinearConvOpTester<uint8_t, int8_t> test;
+  test.GenerateRandomInput({2, 8, 13, 17}, .03f, 7);
+  test.GenerateRandomWeights({12, 4, 1, 1}, .10f, 0);
+  test.GenerateRandomBias();
+  test.SetGroups(2);
+  test.SetOutputScaleAndZeroPoint(.76f, 88);
+  test.Run();
+}
+
 TEST(QLinearConvTest, Conv1D_U8S8_Depthwise) {
   for (int64_t channels : std::initializer_list<int64_t>{7, 8, 9, 16, 25, 64}) {
     QLinearConvOpTester<uint8_t, int8_t> test;
@@ -772,6 +783,27 @@ TEST(QLinearConvTest, Conv2D_U8U8_Depthwise) {
   }
 }
 
+TEST(QLinearConvTest, Conv2D_U8S8_Depthwise_PerChannel) {
+  // Covers the 3x3 and 5x5 depthwise kernels with per channel requantization
+  // over several images and output tiles.
+  for (int64_t kernel : std::initializer_list<int64_t>{3, 5}) {
+    QLinearConvOpTester<uint8_t, int8_t> test;
+    test.GenerateRandomInput({2, 20, 29, 23}, .03f, 12);
+    test.GenerateRandomWeights({20, 1, kernel, kernel}, .10f, 0);
+    std::vector<float> weight_scales;
+    for (int64_t c = 0; c < 20; c++) {
+      weight_scales.push_back(.05f + .01f * static_cast<float>(c % 7));
+    }
+    test.SetWeightScales(weight_scales);
+    test.GenerateRandomBias();
+    test.SetPads({kernel / 2, kernel / 2, kernel / 2, kernel / 2});
+    test.SetStrides({2, 1});
+    test.SetGroups(20);
+    test.SetOutputScaleAndZeroPoint(.76f, 88);
+    test.Run();
+  }
+}
+
 TEST(QLinearConvTest, Conv2D_U8S8_DepthwisePointwise) {
   // Tests the combination of using the depthwise convolution path along with the
   // pointed convolution optimization that avoids im2col.
@@ -456,6 +456,32 @@ TEST(TfIdfVectorizerTest, String_TF_UniAndBigrams_Skip5) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, Int64_TF_LongRowUniAndBigrams_Skip1) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=1, Min=1, Max=2, weights empty, int64
+  // The row is long enough to be split by start position between threads.
+  InitTestAttr(test, "TF", 1, 2, 1,
+               {0, 2},
+               {0, 1, 2, 3, 4},  //5 output indexes
+               {},
+               {5, 8,               //1-grams
+                5, 6, 6, 7, 5, 7},  //bi-grams
+               {});
+
+  std::vector<int64_t> dims{3000};
+  std::vector<int64_t> input;
+  for (int64_t i = 0; i < 3000; ++i) {
+    input.push_back(5 + i % 3);
+  }
+  test.AddInput<int64_t>("T", dims, input);
+
+  std::vector<int64_t> out_dims{5};
+  std::vector<float> output = {1000, 0, 1000, 1000, 1000};
+  test.AddOutput<float>("Y", out_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(TfIdfVectorizerTest, String_TF_BatchUniAndBigrams_Skip5) {
   OpTester test("TfIdfVectorizer", opset_ver);
   // s=5, Min=1, Max=2, weights empty, string
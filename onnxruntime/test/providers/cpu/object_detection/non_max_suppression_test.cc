@@ -363,6 +363,50 @@ TEST(NonMaxSuppressionOpTest, BigIntMaxOutputBoxesPerClass) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBoxesTwoBatchesTwoClasses) {
+  // Pairs of identical boxes side by side, so one box of each pair is suppressed.
+  // Selecting 70 boxes per class takes more candidates than the first block that is ordered by score.
+  constexpr int64_t num_boxes = 200;
+  constexpr int64_t max_output_boxes_per_class = 70;
+  std::vector<float> boxes;
+  for (int64_t batch_index = 0; batch_index < 2; ++batch_index) {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      float x = static_cast<float>(box_index / 2) * 2.0f;
+      boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+    }
+  }
+
+  // The scores decrease with the box index for class 0, and increase for class 1.
+  std::vector<float> scores;
+  for (int64_t batch_index = 0; batch_index < 2; ++batch_index) {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      scores.push_back(1.0f - static_cast<float>(box_index) * 0.001f);
+    }
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      scores.push_back(0.5f + static_cast<float>(box_index) * 0.001f);
+    }
+  }
+
+  std::vector<int64_t> selected_indices;
+  for (int64_t batch_index = 0; batch_index < 2; ++batch_index) {
+    for (int64_t i = 0; i < max_output_boxes_per_class; ++i) {
+      selected_indices.insert(selected_indices.end(), {batch_index, 0, i * 2});
+    }
+    for (int64_t i = 0; i < max_output_boxes_per_class; ++i) {
+      selected_indices.insert(selected_indices.end(), {batch_index, 1, num_boxes - 1 - i * 2});
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {2, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {2, 2, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {max_output_boxes_per_class});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {4 * max_output_boxes_per_class, 3}, selected_indices);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   OpTester test("NonMaxSuppression", 11, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
@@ -2268,6 +2268,46 @@ TEST(ReductionOpTest, ArgMin_int32_neg_axis) {
   test.Run();
 }
 
+// ArgMax / ArgMin over the channel axis of a segmentation map, with many equal values and
+// more spatial positions than a tile of the fast reduction.
+static void TestArgMinMaxChannelAxis(const char* op, bool select_last_index) {
+  const int64_t batch = 2, channels = 21, spatial = 300;
+  std::vector<float> data(batch * channels * spatial);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>((i * 7919) % 23);
+  }
+
+  const bool is_max = std::string(op) == "ArgMax";
+  std::vector<int64_t> expected(batch * spatial);
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int64_t s = 0; s < spatial; ++s) {
+      int64_t arg = 0;
+      for (int64_t c = 1; c < channels; ++c) {
+        float v = data[(b * channels + c) * spatial + s];
+        float best = data[(b * channels + arg) * spatial + s];
+        if ((is_max ? v > best : v < best) || (select_last_index && v == best)) {
+          arg = c;
+        }
+      }
+      expected[b * spatial + s] = arg;
+    }
+  }
+
+  OpTester test(op, 12);
+  test.AddAttribute("axis", (int64_t)1);
+  test.AddAttribute("select_last_index", (int64_t)(select_last_index ? 1 : 0));
+  test.AddInput<float>("data", {batch, channels, spatial}, data);
+  test.AddOutput<int64_t>("reduced", {batch, 1, spatial}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(ReductionOpTest, ArgMinMax_channel_axis) {
+  TestArgMinMaxChannelAxis("ArgMax", false);
+  TestArgMinMaxChannelAxis("ArgMax", true);
+  TestArgMinMaxChannelAxis("ArgMin", false);
+  TestArgMinMaxChannelAxis("ArgMin", true);
+}
+
 TEST(ReductionOpTest, OptimizeShapeForFastReduce_ReduceDimWithZero1) {
   FastReduceKind fast_kind;
   std::vector<int64_t> fast_shape, fast_output_shape, fast_axes;
@@ -3914,5 +3954,71 @@ TEST(ReductionOpTest, ReduceSum_RKRK_keepdims) {
   test.Run();
 }
 
+// NHWC channel statistics: few kept columns, the reduced rows are split across threads.
+TEST(ReductionOpTest, ReduceMean_RK_split_rows) {
+  OpTester test("ReduceMean");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 1, 2});
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<float> in_data(64 * 32 * 8);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)(i % 13);
+  test.AddInput<float>("data", {1, 64, 32, 8}, in_data);
+  std::vector<float> expected(8, 0.f);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    expected[i % 8] += in_data[i];
+  for (auto& v : expected)
+    v /= 64 * 32;
+  test.AddOutput<float>("reduced", {8}, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMax_RK_split_rows) {
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 1});
+  test.AddAttribute("keepdims", (int64_t)1);
+  std::vector<int32_t> in_data(4096 * 4);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (int32_t)((i * 7919) % 10007);
+  test.AddInput<int32_t>("data", {64, 64, 4}, in_data);
+  std::vector<int32_t> expected(4, 0);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    expected[i % 4] = std::max(expected[i % 4], in_data[i]);
+  test.AddOutput<int32_t>("reduced", {1, 1, 4}, expected);
+  test.Run();
+}
+
+// The outer kept dimension is 1, the inner one is tiled across threads.
+TEST(ReductionOpTest, ReduceSum_KRK_tiled) {
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<float> in_data(32 * 1024);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)(i % 17);
+  test.AddInput<float>("data", {1, 32, 1024}, in_data);
+  std::vector<float> expected(1024, 0.f);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    expected[i % 1024] += in_data[i];
+  test.AddOutput<float>("reduced", {1, 1024}, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMin_KRK_tiled) {
+  OpTester test("ReduceMin");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)1);
+  std::vector<float> in_data(2 * 16 * 1024);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)((i * 31) % 1009);
+  test.AddInput<float>("data", {2, 16, 1024}, in_data);
+  std::vector<float> expected(2 * 1024, 1e9f);
+  for (size_t d = 0; d < 2; ++d)
+    for (size_t r = 0; r < 16; ++r)
+      for (size_t j = 0; j < 1024; ++j)
+        expected[d * 1024 + j] = std::min(expected[d * 1024 + j], in_data[(d * 16 + r) * 1024 + j]);
+  test.AddOutput<float>("reduced", {2, 1, 1024}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
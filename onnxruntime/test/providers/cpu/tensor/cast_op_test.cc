@@ -130,6 +130,48 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+TEST(CastOpTest, FloatToAndFromFloat16TypesLarge) {
+  // large enough to use the vectorized conversion loops, their remainders and multiple threads
+  const std::vector<int64_t> shape{3, 1031};
+  const size_t size = 3 * 1031;
+
+  std::vector<MLFloat16> float16_data;
+  std::vector<BFloat16> bfloat16_data;
+  std::vector<float> float16_as_float, bfloat16_as_float;
+  for (size_t i = 0; i < size; ++i) {
+    // finite values including zeros and denormals, alternating sign
+    const auto sign = static_cast<uint16_t>((i & 1) << 15);
+    float16_data.emplace_back(static_cast<uint16_t>(sign | (i * 37 % 0x7C00)));
+    bfloat16_data.emplace_back(static_cast<uint16_t>(sign | (i * 4099 % 0x7F80)));
+    float16_as_float.push_back(float16_data.back().ToFloat());
+    bfloat16_as_float.push_back(bfloat16_data.back().ToFloat());
+  }
+
+  TestCastOp(gsl::make_span(float16_data), gsl::make_span(float16_as_float), shape);
+  TestCastOp(gsl::make_span(float16_as_float), gsl::make_span(float16_data), shape);
+  TestCastOp(gsl::make_span(bfloat16_data), gsl::make_span(bfloat16_as_float), shape);
+  TestCastOp(gsl::make_span(bfloat16_as_float), gsl::make_span(bfloat16_data), shape);
+}
+
+TEST(CastOpTest, FloatToFloat16TypesRoundsToNearestEven) {
+  const std::vector<int64_t> shape{2, 4};
+  // 1 + 2^-11 and 1 + 3 * 2^-11 are halfway between two half values, 1 + 2^-8 and 1 + 3 * 2^-8 are halfway
+  // between two bfloat16 values
+  const std::vector<float> input = {1.00048828125f, 1.00146484375f, 1.00390625f, 1.01171875f,
+                                    -65520.0f, 2.98023223876953125e-8f, std::numeric_limits<float>::infinity(), 3.0e38f};
+  const std::vector<MLFloat16> float16_output = {MLFloat16(uint16_t{0x3C00}), MLFloat16(uint16_t{0x3C02}),
+                                                 MLFloat16(uint16_t{0x3C04}), MLFloat16(uint16_t{0x3C0C}),
+                                                 MLFloat16(uint16_t{0xFC00}), MLFloat16(uint16_t{0x0000}),
+                                                 MLFloat16(uint16_t{0x7C00}), MLFloat16(uint16_t{0x7C00})};
+  TestCastOp(gsl::make_span(input), gsl::make_span(float16_output), shape);
+
+  const std::vector<BFloat16> bfloat16_output = {BFloat16(uint16_t{0x3F80}), BFloat16(uint16_t{0x3F80}),
+                                                 BFloat16(uint16_t{0x3F80}), BFloat16(uint16_t{0x3F82}),
+                                                 BFloat16(uint16_t{0xC780}), BFloat16(uint16_t{0x3300}),
+                                                 BFloat16(uint16_t{0x7F80}), BFloat16(uint16_t{0x7F62})};
+  TestCastOp(gsl::make_span(input), gsl::make_span(bfloat16_output), shape);
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
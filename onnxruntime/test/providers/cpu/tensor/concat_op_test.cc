@@ -353,5 +353,25 @@ TEST(ConcatOpTest, Concat4D_2) {
   test.Run();
 }
 
+// Rows large enough to be split into several blocks of the strided copy, which run on the thread pool.
+TEST(ConcatOpTest, Concat2D_LargeRows) {
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+
+  const int64_t rows = 3, cols1 = 40000, cols2 = 25000;
+  std::vector<float> input1(rows * cols1), input2(rows * cols2), output;
+  for (size_t i = 0; i < input1.size(); ++i) input1[i] = static_cast<float>(i);
+  for (size_t i = 0; i < input2.size(); ++i) input2[i] = -static_cast<float>(i);
+  for (int64_t r = 0; r < rows; ++r) {
+    output.insert(output.end(), input1.begin() + r * cols1, input1.begin() + (r + 1) * cols1);
+    output.insert(output.end(), input2.begin() + r * cols2, input2.begin() + (r + 1) * cols2);
+  }
+
+  test.AddInput<float>("input1", {rows, cols1}, input1);
+  test.AddInput<float>("input2", {rows, cols2}, input2);
+  test.AddOutput<float>("concat_result", {rows, cols1 + cols2}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
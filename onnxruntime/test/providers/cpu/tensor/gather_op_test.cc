@@ -282,6 +282,22 @@ TEST(GatherOpTest, Gather_axis1_indices2d_string) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"0", "1",
+                              "10", "11",
+                              "20", "21"});
+  test.AddInput<int64_t>("indices", {3},
+                         {2, 0, -1});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"20", "21",
+                               "0", "1",
+                               "20", "21"});
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_indices2d_bool) {
   OpTester test("Gather");
   test.AddAttribute<int64_t>("axis", 1LL);
@@ -318,6 +334,36 @@ TEST(GatherOpTest, Gather_perf) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis1_scalar_elements_large) {
+  // single element blocks across several batches, large enough to be split across threads
+  constexpr int64_t batches = 5;
+  constexpr int64_t axis_dim = 300;
+  constexpr int64_t num_indices = 257;
+
+  std::vector<double> input(batches * axis_dim);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<double>(i);
+  }
+  std::vector<int64_t> indices(num_indices);
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices[i] = (i * 7) % axis_dim - (i % 3 == 0 ? axis_dim : 0);
+  }
+  std::vector<double> output;
+  for (int64_t b = 0; b < batches; ++b) {
+    for (int64_t i = 0; i < num_indices; ++i) {
+      const int64_t idx = indices[i] < 0 ? indices[i] + axis_dim : indices[i];
+      output.push_back(input[b * axis_dim + idx]);
+    }
+  }
+
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 1LL);
+  test.AddInput<double>("data", {batches, axis_dim}, input);
+  test.AddInput<int64_t>("indices", {num_indices}, indices);
+  test.AddOutput<double>("output", {batches, num_indices}, output);
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   OpTester test("Gather", 11);
   test.AddAttribute<int64_t>("axis", 1LL);
@@ -254,6 +254,36 @@ TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_asymmetric) {
   run_test(true);
 }
 
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_ChannelsLast_asymmetric) {
+  // The images of ResizeOpLinearUpSampleTest_4DBilinear_asymmetric laid out as the channels of an NHWC tensor
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 2.0f, 4.0f, 1.0f};
+
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  const int64_t N = 1, H = 2, W = 2, C = 2;
+  std::vector<float> X = {1.0f, 6.0f, 3.0f, 2.0f,
+                          4.0f, 7.0f, 8.0f, 11.0f};
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales, true);
+
+  std::vector<float> Y = {
+      1.0f, 6.0f, 1.5f, 5.0f, 2.0f, 4.0f, 2.5f, 3.0f, 3.0f, 2.0f, 3.0f, 2.0f, 3.0f, 2.0f, 3.0f, 2.0f,
+      2.5f, 6.5f, 3.25f, 6.5f, 4.0f, 6.5f, 4.75f, 6.5f, 5.5f, 6.5f, 5.5f, 6.5f, 5.5f, 6.5f, 5.5f, 6.5f,
+      4.0f, 7.0f, 5.0f, 8.0f, 6.0f, 9.0f, 7.0f, 10.0f, 8.0f, 11.0f, 8.0f, 11.0f, 8.0f, 11.0f, 8.0f, 11.0f,
+      4.0f, 7.0f, 5.0f, 8.0f, 6.0f, 9.0f, 7.0f, 10.0f, 8.0f, 11.0f, 8.0f, 11.0f, 8.0f, 11.0f, 8.0f, 11.0f};
+
+  test.AddOutput<float>("Y", {N, static_cast<int64_t>(H * scales[1]), static_cast<int64_t>(W * scales[2]), C}, Y);
+  // Only the CPU EP resizes 'Linear' mode inputs laid out as NHWC
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "",
+           {kCudaExecutionProvider, kRocmExecutionProvider, kTensorrtExecutionProvider, kNnapiExecutionProvider,
+            kOpenVINOExecutionProvider, kDnnlExecutionProvider, kNupharExecutionProvider});
+}
+
 TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_2DBilinear_align_corners) {
   OpTester test("Resize", 13);
   std::vector<float> roi{};
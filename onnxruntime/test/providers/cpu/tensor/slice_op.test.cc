@@ -92,6 +92,31 @@ TEST(SliceTest, Slice1D_Perf) {
                       output);
 }
 
+TEST(SliceTest, Slice2D_WithNegativeSteps_Large) {
+  // large enough for the copy to be split across threads
+  const int64_t rows = 64, cols = 2048;
+  std::vector<float> input(rows * cols);
+  for (size_t i = 0; i < input.size(); ++i) input[i] = static_cast<float>(i);
+
+  // every other row in reverse order, columns [1, cols - 1) reversed
+  std::vector<float> output;
+  for (int64_t r = rows - 1; r >= 0; r -= 2) {
+    for (int64_t c = cols - 2; c >= 1; --c) {
+      output.push_back(input[r * cols + c]);
+    }
+  }
+
+  RunSliceTest<float>({rows, cols},
+                      input,
+                      {-1, -2},
+                      {-rows - 1, 0},
+                      {0, 1},
+                      {-2, -1},
+                      {rows / 2, cols - 2},
+                      output,
+                      true);
+}
+
 TEST(SliceTest, Slice1D_EndOutOfBounds) {
   RunSliceTest<float>({6},
                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f},
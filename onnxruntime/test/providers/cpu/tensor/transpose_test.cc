@@ -429,7 +429,7 @@ TEST(TransposeOpTest, NHWC2NCHW_String) {
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals, false);
 }
 
-// test to cover memcpy from single axis moving inwards path
+// test to cover the memcpy of elements that are not 1, 2, 4 or 8 bytes (merged {2, 2} of uint64_t here)
 TEST(TransposeOpTest, SingleAxisMovingInwardsBlockCopy) {
   std::vector<int64_t> input_shape({2, 2, 2, 2});
   std::vector<uint64_t> input_vals = {
@@ -565,6 +565,77 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+template <typename T>
+static void LargeTransposeTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm,
+                               const std::function<T(size_t)>& make_value) {
+  const size_t rank = input_shape.size();
+  const TensorShape shape(input_shape);
+  const size_t size = static_cast<size_t>(shape.Size());
+
+  std::vector<T> input_vals;
+  input_vals.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    input_vals.push_back(make_value(i));
+  }
+
+  // compute the expected output by walking the output and decomposing each index
+  std::vector<int64_t> expected_shape(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  std::vector<T> expected_vals;
+  expected_vals.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    size_t remaining = i;
+    int64_t offset = 0;
+    for (size_t axis = rank; axis > 0; --axis) {
+      auto index = static_cast<int64_t>(remaining % expected_shape[axis - 1]);
+      remaining /= expected_shape[axis - 1];
+      offset += index * shape.SizeFromDimension(perm[axis - 1] + 1);
+    }
+    expected_vals.push_back(input_vals[offset]);
+  }
+
+  OpTester test("Transpose", 13);
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", expected_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+// attention layout transpose, which copies rows of D elements
+TEST(TransposeOpTest, Transpose0213Large_mlfloat16) {
+  LargeTransposeTest<MLFloat16>({2, 67, 12, 64}, {0, 2, 1, 3},
+                                [](size_t i) { return MLFloat16(static_cast<float>(i % 2048)); });
+}
+
+TEST(TransposeOpTest, Transpose0213Large_int8) {
+  LargeTransposeTest<int8_t>({2, 67, 12, 64}, {0, 2, 1, 3},
+                             [](size_t i) { return static_cast<int8_t>(i); });
+}
+
+// transposes of the innermost axis, which use the tiled SIMD kernels for each element size
+TEST(TransposeOpTest, Transpose0231Large_int8) {
+  LargeTransposeTest<int8_t>({2, 67, 12, 131}, {0, 2, 3, 1},
+                             [](size_t i) { return static_cast<int8_t>(i); });
+}
+
+TEST(TransposeOpTest, Transpose0312Large_mlfloat16) {
+  LargeTransposeTest<MLFloat16>({2, 67, 12, 131}, {0, 3, 1, 2},
+                                [](size_t i) { return MLFloat16(static_cast<float>(i % 2048)); });
+}
+
+TEST(TransposeOpTest, Transpose3021Large_float) {
+  LargeTransposeTest<float>({5, 33, 17, 70}, {3, 0, 2, 1},
+                            [](size_t i) { return static_cast<float>(i); });
+}
+
+TEST(TransposeOpTest, Transpose10Large_int64) {
+  LargeTransposeTest<int64_t>({129, 257}, {1, 0},
+                              [](size_t i) { return static_cast<int64_t>(i); });
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
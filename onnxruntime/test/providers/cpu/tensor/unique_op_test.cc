@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <map>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -99,6 +102,53 @@ TEST(Unique, Flatten_Sorted) {
                        inverse_indices_dims, inverse_indices, counts_dims, counts);
 }
 
+// large enough for the flattened input to be split into hash partitions across threads
+static void RunUniqueLargeInputTest(bool sorted) {
+  const int64_t num_elements = 100000;
+  std::vector<int64_t> X(num_elements);
+  for (int64_t i = 0; i < num_elements; ++i) {
+    X[i] = (i * 7919) % 1009 - 500;
+  }
+
+  // expected values, in order of first occurrence
+  std::map<int64_t, int64_t> first_occurrence;
+  std::vector<int64_t> Y;
+  for (int64_t i = 0; i < num_elements; ++i) {
+    if (first_occurrence.emplace(X[i], i).second) {
+      Y.push_back(X[i]);
+    }
+  }
+  if (sorted) {
+    std::sort(Y.begin(), Y.end());
+  }
+
+  std::map<int64_t, int64_t> output_index;
+  std::vector<int64_t> indices;
+  for (int64_t value : Y) {
+    output_index[value] = static_cast<int64_t>(indices.size());
+    indices.push_back(first_occurrence[value]);
+  }
+
+  std::vector<int64_t> inverse_indices(num_elements);
+  std::vector<int64_t> counts(Y.size(), 0);
+  for (int64_t i = 0; i < num_elements; ++i) {
+    inverse_indices[i] = output_index[X[i]];
+    ++counts[inverse_indices[i]];
+  }
+
+  const std::vector<int64_t> unique_dims{static_cast<int64_t>(Y.size())};
+  RunUniqueTest<int64_t>({num_elements}, X, nullptr, sorted, unique_dims, Y, unique_dims, indices,
+                         {num_elements}, inverse_indices, unique_dims, counts);
+}
+
+TEST(Unique, Flatten_Unsorted_LargeInput) {
+  RunUniqueLargeInputTest(false);
+}
+
+TEST(Unique, Flatten_Sorted_LargeInput) {
+  RunUniqueLargeInputTest(true);
+}
+
 TEST(Unique, Flatten_Sorted_String) {
   const std::vector<int64_t> X_dims{2, 3};
   const std::vector<std::string> X{"1.f", "4.f", "1.f", "2.f", "2.f", "0.f"};
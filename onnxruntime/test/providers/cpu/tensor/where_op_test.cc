@@ -124,6 +124,38 @@ TEST(WhereOpTest, BroadcastDimWithZero) {
   test.Run();
 }
 
+// Masking of attention scores, with a condition broadcast over the heads and a scalar Y.
+TEST(WhereOpTest, BroadcastMaskOverHeads) {
+  const int64_t batch = 2, heads = 3, length = 20;
+  // std::vector<bool> has no data() for OpTester::AddInput<bool>()
+  const size_t condition_size = static_cast<size_t>(batch * length * length);
+  std::unique_ptr<bool[]> condition{new bool[condition_size]};
+  for (size_t i = 0; i < condition_size; ++i) {
+    condition[i] = (i * 7) % 5 != 0;
+  }
+  std::vector<float> X(batch * heads * length * length);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(i);
+  }
+
+  std::vector<float> result(X.size());
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int64_t h = 0; h < heads; ++h) {
+      for (int64_t i = 0; i < length * length; ++i) {
+        int64_t index = (b * heads + h) * length * length + i;
+        result[index] = condition[b * length * length + i] ? X[index] : -10000.0f;
+      }
+    }
+  }
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<bool>("condition", {batch, 1, length, length}, condition.get(), condition_size);
+  test.AddInput<float>("X", {batch, heads, length, length}, X);
+  test.AddInput<float>("Y", {}, {-10000.0f});
+  test.AddOutput<float>("output", {batch, heads, length, length}, result);
+  test.Run();
+}
+
 TEST(WhereOpTest, BroadcastWithScalar) {
   OpTester test{kOpName, kOpVersion};
 
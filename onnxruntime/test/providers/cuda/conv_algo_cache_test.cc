@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef USE_CUDA
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace test {
+
+namespace {
+std::string MakeTestKey(const cudaDeviceProp& device_prop, int algo_search, int64_t batch) {
+  return CudnnConvAlgoCache::MakeKey(device_prop, "fwd", algo_search, CUDNN_DATA_FLOAT, {batch, 3, 8, 8},
+                                     {4, 3, 3, 3}, {1, 1, 1, 1}, {1, 1}, {1, 1}, 1);
+}
+}  // namespace
+
+TEST(CudnnConvAlgoCacheTest, KeyIdentifiesDeviceAndConvolution) {
+  cudaDeviceProp device_prop{};
+  const std::string key = MakeTestKey(device_prop, 0, 1);
+  EXPECT_EQ(key, MakeTestKey(device_prop, 0, 1));
+  EXPECT_NE(key, MakeTestKey(device_prop, 1, 1));
+  EXPECT_NE(key, MakeTestKey(device_prop, 0, 2));
+
+  cudaDeviceProp other_device_prop{};
+  other_device_prop.uuid.bytes[0] = 1;
+  EXPECT_NE(key, MakeTestKey(other_device_prop, 0, 1));
+}
+
+TEST(CudnnConvAlgoCacheTest, LoadsAndAppendsToFile) {
+  const std::string path = "cudnn_conv_algo_cache_test.txt";
+  std::remove(path.c_str());
+
+  cudaDeviceProp device_prop{};
+  device_prop.uuid.bytes[0] = 0x42;
+  const std::string loaded_key = MakeTestKey(device_prop, 0, 16);
+  const std::string inserted_key = MakeTestKey(device_prop, 0, 32);
+  {
+    std::ofstream file(path);
+    file << "malformed\n";
+    file << loaded_key << '\t' << 2 << ' ' << 1024 << ' ' << static_cast<int>(CUDNN_TENSOR_OP_MATH) << '\n';
+  }
+
+  auto& cache = CudnnConvAlgoCache::Instance();
+  cache.RegisterFile(path);
+
+  CudnnConvAlgoCache::Entry entry{};
+  ASSERT_TRUE(cache.Lookup(loaded_key, entry));
+  EXPECT_EQ(entry.algo, 2);
+  EXPECT_EQ(entry.memory, 1024u);
+  EXPECT_EQ(entry.math_type, CUDNN_TENSOR_OP_MATH);
+  EXPECT_FALSE(cache.Lookup(inserted_key, entry));
+
+  cache.Insert(inserted_key, {1, 256, CUDNN_DEFAULT_MATH});
+  ASSERT_TRUE(cache.Lookup(inserted_key, entry));
+  EXPECT_EQ(entry.algo, 1);
+
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  EXPECT_NE(contents.str().find(inserted_key + "\t1 256 " + std::to_string(static_cast<int>(CUDNN_DEFAULT_MATH))),
+            std::string::npos);
+
+  file.close();
+  std::remove(path.c_str());
+}
+
+}  // namespace test
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif
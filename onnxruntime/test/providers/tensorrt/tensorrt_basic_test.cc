@@ -1,11 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "core/graph/onnx_protobuf.h"
+#include "core/platform/env.h"
 #include "core/session/inference_session.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/framework/test_utils.h"
 #include "gtest/gtest.h"
 #include "test/util/include/default_providers.h"
+#include "test/util/include/inference_session_wrapper.h"
 #include "test/util/include/scoped_env_vars.h"
 
 using namespace std;
@@ -138,6 +140,190 @@ TEST(TensorrtExecutionProviderTest, EngineCachingTest) {
   VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
 }
 
+TEST(TensorrtExecutionProviderTest, ExplicitProfilesTest) {
+  // Two profiles, the first one tuned for {1, 3, 2}
+  ScopedEnvironmentVariables scoped_env_vars{EnvVarMap{
+      {"ORT_TENSORRT_PROFILE_MIN_SHAPES", {"X:1x1x1,Y:1x1x1,Z:1x1x1,X:1x4x1,Y:1x4x1,Z:1x4x1"}},
+      {"ORT_TENSORRT_PROFILE_MAX_SHAPES", {"X:1x3x3,Y:1x3x3,Z:1x3x3,X:1x8x8,Y:1x8x8,Z:1x8x8"}},
+      {"ORT_TENSORRT_PROFILE_OPT_SHAPES", {"X:1x3x2,Y:1x3x2,Z:1x3x2,X:1x6x1,Y:1x6x1,Z:1x6x1"}}}};
+  onnxruntime::Model model("explicitprofilestest", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  std::vector<onnxruntime::NodeArg*> inputs;
+  std::vector<onnxruntime::NodeArg*> outputs;
+
+  // FLOAT tensor
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("sym1");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("sym2");
+
+  auto& input_arg_1 = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& input_arg_2 = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  inputs.push_back(&input_arg_1);
+  inputs.push_back(&input_arg_2);
+  auto& output_arg = graph.GetOrCreateNodeArg("node_1_out_1", &float_tensor);
+  outputs.push_back(&output_arg);
+  graph.AddNode("node_1", "Add", "node 1.", inputs, outputs);
+
+  auto& input_arg_3 = graph.GetOrCreateNodeArg("Z", &float_tensor);
+  inputs.clear();
+  inputs.push_back(&output_arg);
+  inputs.push_back(&input_arg_3);
+  auto& output_arg_2 = graph.GetOrCreateNodeArg("M", &float_tensor);
+  outputs.clear();
+  outputs.push_back(&output_arg_2);
+  graph.AddNode("node_2", "Add", "node 2.", inputs, outputs);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK());
+  std::string model_file_name = "trt_execution_provider_explicitprofiles_test.onnx";
+  status = onnxruntime::Model::Save(model, model_file_name);
+
+  SessionOptions so;
+  so.session_logid = "TensorrtExecutionProviderTest.ExplicitProfilesTest";
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  InferenceSession session_object{so, GetEnvironment()};
+  auto allocator_manager = session_object.GetAllocatorManager();
+  auto cuda_provider = TestCudaExecutionProvider();
+  cuda_provider->RegisterAllocator(allocator_manager);
+  auto cpu_allocator = cuda_provider->GetAllocator(0, OrtMemTypeCPU);
+
+  std::unique_ptr<IExecutionProvider> execution_provider = DefaultTensorrtExecutionProvider();
+  EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(execution_provider)).IsOK());
+  status = session_object.Load(model_file_name);
+  ASSERT_TRUE(status.IsOK());
+  status = session_object.Initialize();
+  ASSERT_TRUE(status.IsOK());
+
+  std::vector<std::string> output_names;
+  output_names.push_back("M");
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<float> expected_values_mul_m = {3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f};
+
+  // {1, 3, 2} runs with the first profile and {1, 6, 1} with the second one, {1, 9, 1} is outside of both
+  for (const std::vector<int64_t>& dims_mul_x : {std::vector<int64_t>{1, 3, 2}, std::vector<int64_t>{1, 6, 1}, std::vector<int64_t>{1, 9, 1}}) {
+    std::vector<float> values(values_mul_x);
+    values.resize(dims_mul_x[1] * dims_mul_x[2], 1.0f);
+    OrtValue ml_value_x;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values, &ml_value_x);
+    OrtValue ml_value_y;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values, &ml_value_y);
+    OrtValue ml_value_z;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values, &ml_value_z);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value_x));
+    feeds.insert(std::make_pair("Y", ml_value_y));
+    feeds.insert(std::make_pair("Z", ml_value_z));
+
+    std::vector<OrtValue> fetches;
+    status = session_object.Run(run_options, feeds, output_names, &fetches);
+    if (dims_mul_x[1] == 9) {
+      // no engine rebuild, the shape is rejected
+      ASSERT_FALSE(status.IsOK());
+    } else {
+      ASSERT_TRUE(status.IsOK());
+      VerifyOutputs(fetches, dims_mul_x, expected_values_mul_m);
+    }
+  }
+}
+
+TEST(TensorrtExecutionProviderTest, AsyncEngineBuildTest) {
+  ScopedEnvironmentVariables scoped_env_vars{EnvVarMap{{"ORT_TENSORRT_ENGINE_CACHE_ENABLE", {"1"}},
+                                                       {"ORT_TENSORRT_ASYNC_ENGINE_BUILD_ENABLE", {"1"}},
+                                                       {"ORT_TENSORRT_TIMING_CACHE_ENABLE", {"1"}},
+                                                       {"ORT_TENSORRT_CACHE_PATH", {"trt_async_engine_build_cache"}}}};
+  // Start without the engine a previous run may have cached
+  if (Env::Default().FolderExists(ORT_TSTR("trt_async_engine_build_cache"))) {
+    ASSERT_TRUE(Env::Default().DeleteFolder(ORT_TSTR("trt_async_engine_build_cache")).IsOK());
+  }
+  onnxruntime::Model model("asyncenginebuildtest", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  std::vector<onnxruntime::NodeArg*> inputs;
+  std::vector<onnxruntime::NodeArg*> outputs;
+
+  // FLOAT tensor with static shape, so the engine can be built before the first run
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& input_arg_1 = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& input_arg_2 = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  inputs.push_back(&input_arg_1);
+  inputs.push_back(&input_arg_2);
+  auto& output_arg = graph.GetOrCreateNodeArg("node_1_out_1", &float_tensor);
+  outputs.push_back(&output_arg);
+  graph.AddNode("node_1", "Add", "node 1.", inputs, outputs);
+
+  auto& input_arg_3 = graph.GetOrCreateNodeArg("Z", &float_tensor);
+  inputs.clear();
+  inputs.push_back(&output_arg);
+  inputs.push_back(&input_arg_3);
+  auto& output_arg_2 = graph.GetOrCreateNodeArg("M", &float_tensor);
+  outputs.clear();
+  outputs.push_back(&output_arg_2);
+  graph.AddNode("node_2", "Add", "node 2.", inputs, outputs);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK());
+  std::string model_file_name = "trt_execution_provider_asyncenginebuild_test.onnx";
+  status = onnxruntime::Model::Save(model, model_file_name);
+
+  // Returns the number of nodes assigned to TensorRT
+  auto run_session = [&model_file_name](const std::string& logid) {
+    SessionOptions so;
+    so.session_logid = logid;
+    RunOptions run_options;
+    run_options.run_tag = so.session_logid;
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    auto allocator_manager = session_object.GetAllocatorManager();
+    auto cuda_provider = TestCudaExecutionProvider();
+    cuda_provider->RegisterAllocator(allocator_manager);
+    auto cpu_allocator = cuda_provider->GetAllocator(0, OrtMemTypeCPU);
+
+    std::vector<int64_t> dims_mul_x = {1, 3, 2};
+    std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    OrtValue ml_value_x;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_x);
+    OrtValue ml_value_y;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_y);
+    OrtValue ml_value_z;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_z);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value_x));
+    feeds.insert(std::make_pair("Y", ml_value_y));
+    feeds.insert(std::make_pair("Z", ml_value_z));
+
+    std::vector<std::string> output_names;
+    output_names.push_back("M");
+    std::vector<OrtValue> fetches;
+
+    std::unique_ptr<IExecutionProvider> execution_provider = DefaultTensorrtExecutionProvider();
+    EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(execution_provider)).IsOK());
+    EXPECT_TRUE(session_object.Load(model_file_name).IsOK());
+    EXPECT_TRUE(session_object.Initialize().IsOK());
+    EXPECT_TRUE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+    VerifyOutputs(fetches, {1, 3, 2}, std::vector<float>{3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f});
+
+    int trt_nodes = 0;
+    for (const auto& node : session_object.GetGraph().Nodes()) {
+      if (node.GetExecutionProviderType() == kTensorrtExecutionProvider) {
+        trt_nodes++;
+      }
+    }
+    // the session and its provider are destroyed here, which waits for the background build
+    return trt_nodes;
+  };
+
+  // First session falls back to other providers while the engine is built in the background
+  EXPECT_EQ(run_session("TensorrtExecutionProviderTest.AsyncEngineBuildTest.Build"), 0);
+  // Second session picks the engine up from the cache
+  EXPECT_EQ(run_session("TensorrtExecutionProviderTest.AsyncEngineBuildTest.Cached"), 1);
+}
+
 TEST(TensorrtExecutionProviderTest, FunctionTest) {
   onnxruntime::Model model("functiontest", false, DefaultLoggingManager().DefaultLogger());
   auto& graph = model.MainGraph();
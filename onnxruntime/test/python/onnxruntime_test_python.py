@@ -254,6 +254,24 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunPreparedModel(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        prepared = sess.prepare_run(["Y"], ["X"])
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        for scale in [1.0, 2.0]:
+            x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32) * scale
+            res = prepared.run([x])
+            np.testing.assert_allclose(output_expected * scale * scale, res[0], rtol=1e-05, atol=1e-08)
+
+        # all the outputs when none are given
+        res = sess.prepare_run([], ["X"]).run([x])
+        self.assertEqual(len(res), 1)
+
+        with self.assertRaises(RuntimeError):
+            prepared.run([])
+        with self.assertRaises(Exception):
+            sess.prepare_run(["Y"], ["Z"])
+
     def testRunModelFromBytes(self):
         with open(get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
@@ -813,6 +831,36 @@ class TestInferenceSession(unittest.TestCase):
             # The constructed OrtValue should still be valid after being used in a session
             self.assertTrue(np.array_equal(ortvalue2.numpy(), numpy_arr_input))
 
+    def testOrtValueDlpack(self):
+        numpy_arr_input = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        numpy_arr_output = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+
+        ortvalue1 = onnxrt.OrtValue.ortvalue_from_numpy(numpy_arr_input)
+
+        # The imported OrtValue shares the buffer of the exported one
+        ortvalue2 = onnxrt.OrtValue.from_dlpack(ortvalue1.to_dlpack())
+        self.assertEqual(ortvalue2.data_ptr(), ortvalue1.data_ptr())
+        self.assertEqual(ortvalue2.shape(), [3, 2])
+        self.assertEqual(ortvalue2.data_type(), "tensor(float)")
+        self.assertEqual(ortvalue2.__dlpack_device__()[1], 0)
+
+        # Objects implementing __dlpack__ are accepted as well
+        ortvalue3 = onnxrt.OrtValue.from_dlpack(ortvalue2)
+        self.assertEqual(ortvalue3.data_ptr(), ortvalue1.data_ptr())
+
+        io_binding = sess.io_binding()
+        io_binding.bind_ortvalue_input('X', ortvalue3)
+        io_binding.bind_output('Y')
+        sess.run_with_iobinding(io_binding)
+        self.assertTrue(np.array_equal(io_binding.copy_outputs_to_cpu()[0], numpy_arr_output))
+
+        # A capsule can only be consumed once
+        capsule = ortvalue1.to_dlpack()
+        onnxrt.OrtValue.from_dlpack(capsule)
+        with self.assertRaises(Exception):
+            onnxrt.OrtValue.from_dlpack(capsule)
+
     def testRunModelWithCudaCopyStream(self):
         available_providers = onnxrt.get_available_providers()
 
@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# coding: utf-8
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+
+import unittest
+import onnx
+import numpy as np
+import onnxruntime
+from onnx import helper, TensorProto
+from onnxruntime.quantization.matmul_4bits_quantizer import MatMul4BitsQuantizer
+
+
+class TestOpMatMul4Bits(unittest.TestCase):
+    def construct_model_matmul(self, input_shape, weight_shape):
+        #    (input)
+        #      |
+        #     MatMul
+        #      |
+        #    (output)
+        weight_data = np.random.normal(0, 0.1, weight_shape).astype(np.float32)
+        initializers = [onnx.numpy_helper.from_array(weight_data, name='matmul_weight')]
+        matmul_node = onnx.helper.make_node('MatMul', ['input', 'matmul_weight'], ['output'], name='matmul_node')
+
+        output_shape = input_shape[:-1] + [weight_shape[1]]
+        input_tensor = helper.make_tensor_value_info('input', TensorProto.FLOAT, input_shape)
+        output_tensor = helper.make_tensor_value_info('output', TensorProto.FLOAT, output_shape)
+        graph = helper.make_graph([matmul_node], 'MatMul4Bits_Test', [input_tensor], [output_tensor],
+                                  initializer=initializers)
+        return helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)])
+
+    def run_model(self, model, input_data):
+        sess = onnxruntime.InferenceSession(model.SerializeToString(), providers=['CPUExecutionProvider'])
+        return sess.run(None, {'input': input_data})[0]
+
+    def quantize_and_check(self, input_shape, weight_shape, block_size, is_symmetric):
+        np.random.seed(1)
+        model = self.construct_model_matmul(input_shape, weight_shape)
+        input_data = np.random.normal(0, 1, input_shape).astype(np.float32)
+        expected = self.run_model(model, input_data)
+
+        quantized_model = MatMul4BitsQuantizer(model, block_size, is_symmetric).process()
+        self.assertEqual([node.op_type for node in quantized_model.graph.node], ['MatMulNBits'])
+        self.assertEqual(len(quantized_model.graph.initializer), 2 if is_symmetric else 3)
+
+        # 4 bits keep about one significant digit of each weight
+        output = self.run_model(quantized_model, input_data)
+        np.testing.assert_allclose(output, expected, rtol=0.1, atol=0.1 * np.abs(expected).max())
+
+    def test_quantize_matmul_4bits(self):
+        self.quantize_and_check([1, 64], [64, 32], 32, False)
+        self.quantize_and_check([3, 5, 100], [100, 48], 16, False)
+        self.quantize_and_check([20, 256], [256, 40], 128, True)
+
+
+if __name__ == '__main__':
+    unittest.main()
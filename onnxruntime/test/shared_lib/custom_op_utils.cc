@@ -45,6 +45,34 @@ void MyCustomKernel::Compute(OrtKernelContext* context) {
 #endif
 }
 
+OrtStatusPtr MyCustomKernelV2::ComputeV2(OrtKernelContext* context, const OrtCustomOpTensor* inputs,
+                                         size_t num_inputs, OrtCustomOpTensor* outputs, size_t num_outputs) {
+  if (num_inputs != 2 || num_outputs != 1 || outputs[0].data == nullptr) {
+    return Ort::GetApi().CreateStatus(ORT_INVALID_ARGUMENT, "Expected two inputs and a preallocated output");
+  }
+
+  struct AddParams {
+    const float* X;
+    const float* Y;
+    float* out;
+  } params{static_cast<const float*>(inputs[0].data), static_cast<const float*>(inputs[1].data),
+           static_cast<float*>(outputs[0].data)};
+
+  size_t size = 1;
+  for (size_t i = 0; i < outputs[0].num_dims; i++) {
+    size *= static_cast<size_t>(outputs[0].dims[i]);
+  }
+
+  // Do computation
+  ort_.KernelContext_ParallelFor(
+      context, [](void* fn_param, size_t i) {
+        auto* p = static_cast<AddParams*>(fn_param);
+        p->out[i] = p->X[i] + p->Y[i];
+      },
+      &params, size);
+  return nullptr;
+}
+
 void MyCustomKernelMultipleDynamicInputs::Compute(OrtKernelContext* context) {
   // Setup inputs
   const OrtValue* input_X = ort_.KernelContext_GetInput(context, 0);
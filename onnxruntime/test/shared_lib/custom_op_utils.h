@@ -55,6 +55,42 @@ struct MyCustomOp : Ort::CustomOpBase<MyCustomOp, MyCustomKernel> {
   void* compute_stream_;
 };
 
+// Same as MyCustomOp on CPU, computing from the tensor descriptors of KernelComputeV2 with an output preallocated
+// by ORT.
+struct MyCustomKernelV2 {
+  MyCustomKernelV2(Ort::CustomOpApi ort, const OrtKernelInfo* /*info*/) : ort_(ort) {}
+
+  // Required by CustomOpBase, ORT calls ComputeV2 instead
+  void Compute(OrtKernelContext* /*context*/) {}
+  OrtStatusPtr ComputeV2(OrtKernelContext* context, const OrtCustomOpTensor* inputs, size_t num_inputs,
+                         OrtCustomOpTensor* outputs, size_t num_outputs);
+
+ private:
+  Ort::CustomOpApi ort_;
+};
+
+struct MyCustomOpV2 : Ort::CustomOpBase<MyCustomOpV2, MyCustomKernelV2> {
+  MyCustomOpV2() {
+    OrtCustomOp::KernelComputeV2 = [](void* op_kernel, OrtKernelContext* context,
+                                      const OrtCustomOpTensor* inputs, size_t num_inputs,
+                                      OrtCustomOpTensor* outputs, size_t num_outputs) {
+      return static_cast<MyCustomKernelV2*>(op_kernel)->ComputeV2(context, inputs, num_inputs, outputs, num_outputs);
+    };
+  }
+
+  void* CreateKernel(Ort::CustomOpApi api, const OrtKernelInfo* info) const { return new MyCustomKernelV2(api, info); };
+  const char* GetName() const { return "Foo"; };
+
+  size_t GetInputTypeCount() const { return 2; };
+  ONNXTensorElementDataType GetInputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  size_t GetOutputTypeCount() const { return 1; };
+  ONNXTensorElementDataType GetOutputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  // The output has the shape of the first input
+  int GetOutputShapeSource(size_t /*index*/) const { return 0; };
+};
+
 struct MyCustomKernelMultipleDynamicInputs {
   MyCustomKernelMultipleDynamicInputs(Ort::CustomOpApi ort, const OrtKernelInfo* /*info*/, void* compute_stream)
       : ort_(ort), compute_stream_(compute_stream) {
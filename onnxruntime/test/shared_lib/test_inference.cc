@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <map>
 #include <memory>
 #include <vector>
 #include <iostream>
@@ -8,6 +9,8 @@
 #include <sstream>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <algorithm>
 
 #include <gtest/gtest.h>
@@ -265,6 +268,25 @@ TEST(CApiTest, custom_op_handler) {
 #endif
 }
 
+TEST(CApiTest, custom_op_compute_v2_handler) {
+  std::vector<Input> inputs(1);
+  Input& input = inputs[0];
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+  // prepare expected inputs and outputs
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f};
+
+  MyCustomOpV2 custom_op;
+  Ort::CustomOpDomain custom_op_domain("");
+  custom_op_domain.Add(&custom_op);
+
+  TestInference<float>(*ort_env, CUSTOM_OP_MODEL_URI, inputs, "Y", expected_dims_y, expected_values_y, 0,
+                       custom_op_domain, nullptr);
+}
+
 //test custom op which accepts float and double as inputs
 TEST(CApiTest, varied_input_custom_op_handler) {
   std::vector<Input> inputs(2);
@@ -788,6 +810,230 @@ TEST(CApiTest, io_binding) {
   binding.ClearBoundOutputs();
 }
 
+TEST(CApiTest, run_with_output_buffer) {
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  // the buffer may be larger than the output
+  std::vector<float> y_buffer(16);
+  Ort::RunOptions run_options;
+  run_options.SetOutputBuffer("Y", y_buffer.data(), y_buffer.size() * sizeof(float), info_cpu);
+
+  for (int run = 0; run < 2; ++run) {
+    std::vector<Ort::Value> outputs = session.Run(run_options, input_names, &x, 1, output_names, 1);
+    ASSERT_EQ(outputs.size(), 1U);
+    ASSERT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>(x_shape.begin(), x_shape.end()));
+    ASSERT_EQ(outputs[0].GetTensorData<float>(), y_buffer.data());
+    ASSERT_TRUE(std::equal(expected_y.begin(), expected_y.end(), y_buffer.begin()));
+  }
+
+  // an output that does not fit in the buffer is allocated by ORT
+  std::vector<float> small_y_buffer(2);
+  run_options.SetOutputBuffer("Y", small_y_buffer.data(), small_y_buffer.size() * sizeof(float), info_cpu);
+  {
+    std::vector<Ort::Value> outputs = session.Run(run_options, input_names, &x, 1, output_names, 1);
+    const float* y_values = outputs[0].GetTensorData<float>();
+    ASSERT_NE(y_values, small_y_buffer.data());
+    ASSERT_TRUE(std::equal(expected_y.begin(), expected_y.end(), y_values));
+  }
+
+  run_options.ClearOutputBuffers();
+  {
+    std::vector<Ort::Value> outputs = session.Run(run_options, input_names, &x, 1, output_names, 1);
+    ASSERT_NE(outputs[0].GetTensorData<float>(), y_buffer.data());
+  }
+}
+
+TEST(CApiTest, session_replicas) {
+  std::vector<Ort::SessionOptions> replica_options(3);
+#ifdef USE_CUDA
+  int num_devices = 0;
+  if (cudaGetDeviceCount(&num_devices) == cudaSuccess && num_devices > 1) {
+    for (size_t i = 0; i < replica_options.size(); ++i) {
+      OrtCUDAProviderOptions cuda_options{};
+      cuda_options.device_id = static_cast<int>(i) % num_devices;
+      replica_options[i].AppendExecutionProvider_CUDA(cuda_options);
+    }
+  }
+#endif
+  Ort::SessionReplicas replicas(*ort_env, MODEL_URI, replica_options.data(), replica_options.size());
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  std::atomic<int> num_failures{0};
+  auto run = [&]() {
+    std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+    for (int i = 0; i < 10; ++i) {
+      std::vector<Ort::Value> outputs = replicas.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+      if (outputs.size() != 1 ||
+          !std::equal(expected_y.begin(), expected_y.end(), outputs[0].GetTensorData<float>())) {
+        ++num_failures;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(run);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(num_failures, 0);
+
+  // at least one replica is required
+  ASSERT_THROW(Ort::SessionReplicas(*ort_env, MODEL_URI, replica_options.data(), 0), Ort::Exception);
+}
+
+TEST(CApiTest, prepared_run) {
+  Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions{});
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::PreparedRun prepared_run(session, input_names, 1, output_names, 1);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+
+  // outputs allocated by the run
+  for (int i = 0; i < 3; ++i) {
+    std::vector<Ort::Value> outputs = session.Run(Ort::RunOptions{}, prepared_run, &x, 1, 1);
+    ASSERT_EQ(outputs.size(), 1u);
+    ASSERT_TRUE(std::equal(expected_y.begin(), expected_y.end(), outputs[0].GetTensorData<float>()));
+  }
+
+  // pre-allocated outputs
+  std::array<float, 3 * 2> y_values{};
+  Ort::Value y = Ort::Value::CreateTensor(info_cpu, y_values.data(), y_values.size(), x_shape.data(), x_shape.size());
+  session.Run(Ort::RunOptions{}, prepared_run, &x, 1, &y, 1);
+  ASSERT_EQ(y_values, expected_y);
+
+  // the types of the inputs are still checked
+  std::array<int32_t, 3 * 2> int_values{};
+  Ort::Value int_x = Ort::Value::CreateTensor(info_cpu, int_values.data(), int_values.size(), x_shape.data(),
+                                              x_shape.size());
+  ASSERT_THROW(session.Run(Ort::RunOptions{}, prepared_run, &int_x, 1, 1), Ort::Exception);
+  ASSERT_THROW(session.Run(Ort::RunOptions{}, prepared_run, nullptr, 0, 1), Ort::Exception);
+
+  const char* invalid_names[] = {"Z"};
+  ASSERT_THROW(Ort::PreparedRun(session, invalid_names, 1, output_names, 1), Ort::Exception);
+  ASSERT_THROW(Ort::PreparedRun(session, input_names, 1, invalid_names, 1), Ort::Exception);
+}
+
+TEST(CApiTest, session_metrics) {
+  Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions{});
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+  for (int i = 0; i < 3; ++i) {
+    session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+  }
+
+  std::map<std::string, double> metrics;
+  for (auto& metric : session.GetMetrics()) {
+    metrics.insert(std::move(metric));
+  }
+  ASSERT_EQ(metrics["onnxruntime_session_runs_total"], 3);
+  ASSERT_EQ(metrics["onnxruntime_session_run_failures_total"], 0);
+  ASSERT_EQ(metrics["onnxruntime_session_run_latency_seconds_count"], 3);
+  ASSERT_EQ(metrics["onnxruntime_session_run_latency_seconds_bucket{le=\"+Inf\"}"], 3);
+  ASSERT_GT(metrics["onnxruntime_session_run_latency_seconds_sum"], 0);
+  ASSERT_GT(metrics["onnxruntime_arena_max_bytes_in_use{allocator=\"Cpu\",device_id=\"0\"}"], 0);
+  ASSERT_EQ(metrics["onnxruntime_host_to_device_bytes_total"], 0);
+}
+
+namespace {
+struct AsyncRunState {
+  std::array<float, 3 * 2> x_values;
+  Ort::Value x{nullptr};
+  Ort::Value y{nullptr};
+  bool succeeded = false;
+};
+
+struct AsyncRunsTracker {
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t num_done = 0;
+};
+
+struct AsyncRunContext {
+  AsyncRunState* state;
+  AsyncRunsTracker* tracker;
+};
+
+void ORT_API_CALL AsyncRunCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+  auto* context = reinterpret_cast<AsyncRunContext*>(user_data);
+  // the outputs are written into the Ort::Value passed to RunAsync
+  context->state->succeeded = status == nullptr && num_outputs == 1 && outputs[0] != nullptr;
+  std::lock_guard<std::mutex> l(context->tracker->mutex);
+  ++context->tracker->num_done;
+  context->tracker->cv.notify_one();
+}
+}  // namespace
+
+TEST(CApiTest, run_async) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  // keep several runs in flight from the test thread
+  constexpr size_t num_runs = 16;
+  std::vector<AsyncRunState> states(num_runs);
+  std::vector<AsyncRunContext> contexts(num_runs);
+  AsyncRunsTracker tracker;
+  Ort::RunOptions run_options;
+
+  for (size_t r = 0; r < num_runs; ++r) {
+    AsyncRunState& state = states[r];
+    for (size_t i = 0; i < state.x_values.size(); ++i) {
+      state.x_values[i] = static_cast<float>(r + i);
+    }
+    state.x = Ort::Value::CreateTensor(info_cpu, state.x_values.data(), state.x_values.size(),
+                                       x_shape.data(), x_shape.size());
+    contexts[r] = {&state, &tracker};
+    session.RunAsync(run_options, input_names, &state.x, 1, output_names, &state.y, 1,
+                     AsyncRunCallback, &contexts[r]);
+  }
+
+  {
+    std::unique_lock<std::mutex> l(tracker.mutex);
+    tracker.cv.wait(l, [&tracker]() { return tracker.num_done == num_runs; });
+  }
+
+  for (size_t r = 0; r < num_runs; ++r) {
+    const AsyncRunState& state = states[r];
+    ASSERT_TRUE(state.succeeded) << "run " << r;
+    const float* y_values = state.y.GetTensorData<float>();
+    for (size_t i = 0; i < state.x_values.size(); ++i) {
+      ASSERT_EQ(y_values[i], state.x_values[i] * state.x_values[i]);
+    }
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_TENSORRT)
 TEST(CApiTest, io_binding_cuda) {
   struct CudaMemoryDeleter {
@@ -0,0 +1,392 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Times the phases of the session creation for a corpus of models: the parsing of the model, the resolution of the
+// graph, each graph transformer, the partitioning, the kernel creation, the prepacking and the copy of the
+// initializers. The phases are recorded by the session profiler, see kOrtSessionOptionsConfigProfileSessionCreation,
+// and received here through a profiling logger. The results are written as JSON, one object per model, with the median and
+// minimum duration of each phase over the repetitions and the peak resident set size of the process at its end.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "core/common/logging/isink.h"
+#include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/clog_sink.h"
+#include "core/common/path_string.h"
+#include "core/common/profiler.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/path_lib.h"
+#include "core/session/environment.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+namespace startup_benchmark {
+
+// Collects the session events sent to a profiling logger.
+class SessionEventSink : public logging::ISink {
+ public:
+  void SendProfileEvent(profiling::EventRecord& event) const override {
+    if (event.cat != profiling::SESSION_EVENT) {
+      return;
+    }
+    std::lock_guard<OrtMutex> lock(mutex_);
+    events_.push_back(event);
+  }
+
+  std::vector<profiling::EventRecord> TakeEvents() {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    std::vector<profiling::EventRecord> events;
+    events.swap(events_);
+    return events;
+  }
+
+ private:
+  void SendImpl(const logging::Timestamp&, const std::string&, const logging::Capture&) override {}
+
+  mutable OrtMutex mutex_;
+  mutable std::vector<profiling::EventRecord> events_;
+};
+
+struct Options {
+  std::vector<PathString> models;
+  int repetitions = 5;
+  std::string output_file;
+  TransformerLevel optimization_level = TransformerLevel::MaxLevel;
+  int intra_op_num_threads = 0;
+  std::vector<std::pair<std::string, std::string>> config_entries;
+};
+
+struct Phase {
+  std::string name;
+  // the total of the repetitions of the phase in a session creation, e.g. a transformer applied in several steps or
+  // a phase of the subgraphs, for each session creation
+  std::vector<long long> durations_us;
+  size_t peak_rss = 0;
+};
+
+struct ModelResult {
+  std::string model;
+  std::string error;
+  std::vector<long long> session_creation_us;
+  // the peak resident set size before the session creation, after it was reset if possible
+  size_t initial_peak_rss = 0;
+  size_t final_peak_rss = 0;
+  // in the order they were first seen
+  std::vector<Phase> phases;
+};
+
+static void ShowUsage() {
+  std::cout << "onnxruntime_startup_benchmark [options...] <model file or directory>...\n"
+               "Options:\n"
+               "  -r <count>: Number of session creations per model. Default: 5.\n"
+               "  -o <file>: Write the JSON results to the file instead of the standard output.\n"
+               "  -l <level>: Graph optimization level, 0 (disabled), 1 (basic), 2 (extended) or 99 (all). "
+               "Default: 99.\n"
+               "  -x <count>: Number of threads of the intra op thread pool. Default: 0 (one per physical core).\n"
+               "  -c <key>=<value>: Session config entry, can be repeated.\n"
+               "  -h: Show this help.\n"
+               "The directories are searched recursively for .onnx and .ort files.\n";
+}
+
+static bool ParseArguments(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "-h") {
+      return false;
+    } else if (arg == "-r" && has_value) {
+      options.repetitions = std::stoi(argv[++i]);
+      if (options.repetitions < 1) {
+        return false;
+      }
+    } else if (arg == "-o" && has_value) {
+      options.output_file = argv[++i];
+    } else if (arg == "-l" && has_value) {
+      const int level = std::stoi(argv[++i]);
+      switch (level) {
+        case 0:
+          options.optimization_level = TransformerLevel::Default;
+          break;
+        case 1:
+          options.optimization_level = TransformerLevel::Level1;
+          break;
+        case 2:
+          options.optimization_level = TransformerLevel::Level2;
+          break;
+        case 99:
+          options.optimization_level = TransformerLevel::MaxLevel;
+          break;
+        default:
+          return false;
+      }
+    } else if (arg == "-x" && has_value) {
+      options.intra_op_num_threads = std::stoi(argv[++i]);
+    } else if (arg == "-c" && has_value) {
+      const std::string entry = argv[++i];
+      const auto pos = entry.find('=');
+      if (pos == std::string::npos) {
+        return false;
+      }
+      options.config_entries.emplace_back(entry.substr(0, pos), entry.substr(pos + 1));
+    } else if (!arg.empty() && arg[0] == '-') {
+      return false;
+    } else {
+      options.models.push_back(ToPathString(arg));
+    }
+  }
+  return !options.models.empty();
+}
+
+static void FindModels(const PathString& path, std::vector<PathString>& models) {
+  if (!Env::Default().FolderExists(path)) {
+    models.push_back(path);
+    return;
+  }
+
+  std::vector<PathString> entries;
+  LoopDir(path, [&path, &entries](const PathChar* filename, OrtFileType file_type) -> bool {
+    if (filename[0] == '.') {
+      return true;
+    }
+    PathString entry = ConcatPathComponent<PathChar>(path, filename);
+    if (file_type == OrtFileType::TYPE_DIR || HasExtensionOf(entry, ORT_TSTR("onnx")) ||
+        HasExtensionOf(entry, ORT_TSTR("ort"))) {
+      entries.push_back(std::move(entry));
+    }
+    return true;
+  });
+
+  // the order of the directory entries is unspecified, keep the output stable
+  std::sort(entries.begin(), entries.end());
+  for (const auto& entry : entries) {
+    FindModels(entry, models);
+  }
+}
+
+// Reset the peak resident set size of the process to its current size, so the peak of a session creation is not
+// hidden by the sessions created before. Only possible on Linux, returns false elsewhere.
+static bool ResetPeakResidentSetSize() {
+#ifdef __linux__
+  int fd = open("/proc/self/clear_refs", O_WRONLY);
+  if (fd < 0) {
+    return false;
+  }
+  const bool reset = write(fd, "5", 1) == 1;
+  close(fd);
+  return reset;
+#else
+  return false;
+#endif
+}
+
+static long long Median(std::vector<long long> values) {
+  std::sort(values.begin(), values.end());
+  const size_t middle = values.size() / 2;
+  return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+static Status CreateSession(const Options& options, const PathString& model, const Environment& env,
+                            const logging::Logger& profiling_logger) {
+  SessionOptions so;
+  so.session_logid = "StartupBenchmark";
+  so.graph_optimization_level = options.optimization_level;
+  so.intra_op_param.thread_pool_size = options.intra_op_num_threads;
+  ORT_RETURN_IF_ERROR(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfileSessionCreation, "1"));
+  for (const auto& entry : options.config_entries) {
+    ORT_RETURN_IF_ERROR(so.config_options.AddConfigEntry(entry.first.c_str(), entry.second.c_str()));
+  }
+
+  InferenceSession session{so, env};
+  // profile from the start, the profiling enabled by the session options would start after the Load
+  session.StartProfiling(&profiling_logger);
+  ORT_RETURN_IF_ERROR(session.Load(model));
+  ORT_RETURN_IF_ERROR(session.Initialize());
+  session.EndProfiling();
+  return Status::OK();
+}
+
+static ModelResult BenchmarkModel(const Options& options, const PathString& model, const Environment& env,
+                                  SessionEventSink& sink, const logging::Logger& profiling_logger) {
+  ModelResult result;
+  result.model = ToMBString(model);
+  std::unordered_map<std::string, size_t> phase_indices;
+
+  for (int i = 0; i < options.repetitions; ++i) {
+    ResetPeakResidentSetSize();
+    if (i == 0) {
+      result.initial_peak_rss = profiling::Profiler::GetPeakResidentSetSize();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    Status status = CreateSession(options, model, env, profiling_logger);
+    const auto end = std::chrono::steady_clock::now();
+    auto events = sink.TakeEvents();
+    if (!status.IsOK()) {
+      result.error = status.ErrorMessage();
+      return result;
+    }
+
+    result.session_creation_us.push_back(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    if (i == 0) {
+      result.final_peak_rss = profiling::Profiler::GetPeakResidentSetSize();
+    }
+
+    // the phases are the session events with a peak_rss argument
+    std::unordered_map<std::string, long long> durations_us;
+    for (const auto& event : events) {
+      const auto peak_rss = event.args.find("peak_rss");
+      if (peak_rss == event.args.end()) {
+        continue;
+      }
+
+      auto index = phase_indices.find(event.name);
+      if (index == phase_indices.end()) {
+        index = phase_indices.emplace(event.name, result.phases.size()).first;
+        result.phases.push_back(Phase{event.name, {}, 0});
+      }
+
+      // the peak of the first session creation, the later ones may reuse memory freed by the previous sessions
+      Phase& phase = result.phases[index->second];
+      if (i == 0) {
+        phase.peak_rss = std::max(phase.peak_rss, static_cast<size_t>(std::stoull(peak_rss->second)));
+      }
+      durations_us[event.name] += event.dur;
+    }
+
+    for (auto& phase : result.phases) {
+      phase.durations_us.push_back(durations_us[phase.name]);
+    }
+  }
+
+  return result;
+}
+
+static std::string JsonString(const std::string& value) {
+  std::string quoted = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+      quoted += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      quoted += escaped;
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+static void WriteResults(const std::vector<ModelResult>& results, int repetitions, std::ostream& out) {
+  out << "{\n  \"repetitions\": " << repetitions << ",\n  \"models\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& result = results[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"model\": " << JsonString(result.model);
+    if (!result.error.empty()) {
+      out << ", \"error\": " << JsonString(result.error) << "}";
+      continue;
+    }
+
+    out << ", \"session_creation_us\": {\"median\": " << Median(result.session_creation_us)
+        << ", \"min\": " << *std::min_element(result.session_creation_us.begin(), result.session_creation_us.end())
+        << "}, \"initial_peak_rss\": " << result.initial_peak_rss
+        << ", \"final_peak_rss\": " << result.final_peak_rss << ",\n     \"phases\": [";
+    for (size_t j = 0; j < result.phases.size(); ++j) {
+      const auto& phase = result.phases[j];
+      out << (j == 0 ? "\n" : ",\n") << "       {\"name\": " << JsonString(phase.name)
+          << ", \"median_us\": " << Median(phase.durations_us)
+          << ", \"min_us\": " << *std::min_element(phase.durations_us.begin(), phase.durations_us.end())
+          << ", \"peak_rss\": " << phase.peak_rss << "}";
+    }
+    out << "]}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+static int Run(int argc, char* argv[]) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
+    ShowUsage();
+    return -1;
+  }
+
+  std::vector<PathString> models;
+  for (const auto& path : options.models) {
+    FindModels(path, models);
+  }
+
+  const std::string default_logger_id{"Default"};
+  std::unique_ptr<Environment> env;
+  auto status = Environment::Create(
+      std::make_unique<logging::LoggingManager>(std::unique_ptr<logging::ISink>{new logging::CLogSink{}},
+                                                logging::Severity::kWARNING, false,
+                                                logging::LoggingManager::InstanceType::Default, &default_logger_id),
+      env);
+  if (!status.IsOK()) {
+    std::cerr << "Failed to create the environment: " << status.ErrorMessage() << std::endl;
+    return -1;
+  }
+
+  auto* sink = new SessionEventSink();
+  logging::LoggingManager profiling_logging_manager{std::unique_ptr<logging::ISink>{sink},
+                                                    logging::Severity::kFATAL, false,
+                                                    logging::LoggingManager::InstanceType::Temporal};
+  auto profiling_logger = profiling_logging_manager.CreateLogger("StartupBenchmark");
+
+  std::vector<ModelResult> results;
+  for (const auto& model : models) {
+    std::cerr << "Benchmarking " << ToMBString(model) << std::endl;
+    results.push_back(BenchmarkModel(options, model, *env, *sink, *profiling_logger));
+    if (!results.back().error.empty()) {
+      std::cerr << "Failed to create a session for " << ToMBString(model) << ": " << results.back().error
+                << std::endl;
+    }
+  }
+
+  if (options.output_file.empty()) {
+    WriteResults(results, options.repetitions, std::cout);
+  } else {
+    std::ofstream out(options.output_file);
+    WriteResults(results, options.repetitions, out);
+    if (!out.good()) {
+      std::cerr << "Failed to write " << options.output_file << std::endl;
+      return -1;
+    }
+  }
+
+  const bool failed = std::any_of(results.begin(), results.end(),
+                                  [](const ModelResult& result) { return !result.error.empty(); });
+  return failed ? -1 : 0;
+}
+
+}  // namespace startup_benchmark
+}  // namespace onnxruntime
+
+int main(int argc, char* argv[]) {
+  int retval = -1;
+  ORT_TRY {
+    retval = onnxruntime::startup_benchmark::Run(argc, argv);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      std::cerr << ex.what() << std::endl;
+    });
+  }
+  return retval;
+}
@@ -168,3 +168,26 @@ graph_def_5 = helper.make_graph(
 
 model = helper.make_model(graph_def_5, opset_imports=[helper.make_operatorsetid("", 13)])
 onnx.save_model(model, "cpu_fallback_pattern_5.onnx")
+
+graph_def_6 = helper.make_graph(
+    nodes=[
+        helper.make_node(op_type="Shape", inputs=['A'], outputs=['A_shape'], name='shape0'),
+        helper.make_node(op_type="Unique", inputs=['A_shape'], outputs=['A_dims'], name='unique'),
+        helper.make_node(op_type="Concat", inputs=['A_dims', 'one'], outputs=['shape'], name='concat', axis=0),
+        helper.make_node(op_type="Reshape", inputs=['C','shape'], outputs=['D'], name='reshape'),
+    ],
+    name='test-model',
+    inputs=[
+        # create inputs with symbolic dims
+        helper.make_tensor_value_info("A", TensorProto.FLOAT, None),
+        helper.make_tensor_value_info("C", TensorProto.FLOAT, None),
+    ],
+    outputs=[
+        helper.make_tensor_value_info('D', TensorProto.FLOAT, None)
+    ],
+    initializer=[
+        helper.make_tensor('one', TensorProto.INT64, [1], [1]),
+    ])
+
+model = helper.make_model(graph_def_6, opset_imports=[helper.make_operatorsetid("", 13)])
+onnx.save_model(model, "cpu_fallback_pattern_6.onnx")
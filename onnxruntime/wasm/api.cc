@@ -19,9 +19,12 @@ void OrtInit(int numThreads, int logging_level) {
   Ort::ThrowOnError(Ort::GetApi().SetGlobalIntraOpNumThreads(tp_options, numThreads));
   Ort::ThrowOnError(Ort::GetApi().SetGlobalInterOpNumThreads(tp_options, 1));
 
+  // the sessions share the global intra-op thread pool, whose threads run on the pre-spawned web workers.
   g_env = new Ort::Env{tp_options, static_cast<OrtLoggingLevel>(logging_level), "Default"};
-#endif
+  Ort::GetApi().ReleaseThreadingOptions(tp_options);
+#else
   g_env = new Ort::Env{static_cast<OrtLoggingLevel>(logging_level), "Default"};
+#endif
 }
 
 Ort::Session* OrtCreateSession(void* data, size_t data_length) {
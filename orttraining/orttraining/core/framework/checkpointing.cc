@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <fstream>
+#include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -38,30 +40,43 @@ PathString GetCheckpointTensorsDataFilePath(const PathString& checkpoint_directo
   return ConcatPathComponent<PathChar>(checkpoint_directory, k_tensors_data_file_name);
 }
 
+// the first data file keeps the name of a single data file
+PathString GetCheckpointTensorsDataFilePath(const PathString& checkpoint_directory, size_t data_file_index) {
+  if (data_file_index == 0) {
+    return GetCheckpointTensorsDataFilePath(checkpoint_directory);
+  }
+  return ConcatPathComponent<PathChar>(
+      checkpoint_directory, ToPathString("tensors_" + std::to_string(data_file_index) + ".bin"));
+}
+
 PathString GetCheckpointPropertiesFilePath(const PathString& checkpoint_directory) {
   return ConcatPathComponent<PathChar>(checkpoint_directory, k_properties_file_name);
 }
 
+// a tensor copied to host memory
+struct HostTensor {
+  std::string name;
+  std::vector<int64_t> dims;
+  int32_t element_type;
+  std::vector<char> data;
+};
+
 Status SaveRuntimeTensor(
-    const std::string& tensor_name,
-    const Tensor& tensor,
-    gsl::span<const char> tensor_data,
+    const HostTensor& tensor,
     const PathString& relative_data_path,
     std::ofstream& data_file,
     ONNX_NAMESPACE::TensorProto& tensor_proto) {
-  ORT_RETURN_IF(tensor.DataType() == DataTypeImpl::GetType<std::string>(), "tensor.DataType() is std::string");
-
-  VLOGS_DEFAULT(1) << "Saving tensor " << tensor_name;
+  VLOGS_DEFAULT(1) << "Saving tensor " << tensor.name;
 
   ONNX_NAMESPACE::TensorProto saved_tensor_proto{};
 
-  for (const auto dim : tensor.Shape().GetDims()) {
+  for (const auto dim : tensor.dims) {
     saved_tensor_proto.add_dims(dim);
   }
 
-  saved_tensor_proto.set_data_type(tensor.GetElementType());
+  saved_tensor_proto.set_data_type(tensor.element_type);
 
-  saved_tensor_proto.set_name(tensor_name);
+  saved_tensor_proto.set_name(tensor.name);
 
   auto add_external_data = [&saved_tensor_proto](const std::string& key, const std::string& value) {
     auto* kvp = saved_tensor_proto.add_external_data();
@@ -73,20 +88,13 @@ Status SaveRuntimeTensor(
   add_external_data("location", ToMBString(relative_data_path));
   const std::streamoff offset = data_file.tellp();
   add_external_data("offset", std::to_string(offset));
-  const auto length = tensor_data.size_bytes();
+  const auto length = tensor.data.size();
   add_external_data("length", std::to_string(length));
 
   saved_tensor_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
 
-  // TODO need to ensure the data is written in little-endian format...
-  // e.g., with endian_utils.h:WriteLittleEndian()
-  // https://github.com/microsoft/onnxruntime/blob/master/onnxruntime/core/framework/endian_utils.h
-  if (endian::native != endian::little) {
-    ORT_NOT_IMPLEMENTED("checkpointing currently requires little-endian host byte order");
-  }
-
   ORT_RETURN_IF_NOT(
-      data_file.write(tensor_data.data(), length),
+      data_file.write(tensor.data.data(), length),
       "Failed to write to data file: ", ToMBString(relative_data_path));
 
   tensor_proto = std::move(saved_tensor_proto);
@@ -125,39 +133,101 @@ std::vector<std::string> GetOrderedOrtValueNames(const NameMLValMap& name_to_val
   return ordered_names;
 }
 
-Status SaveRuntimeTensors(
-    const PathString& tensors_path,
-    const PathString& tensors_data_path,
+// copies the tensors to host memory, ordered by name
+Status CopyRuntimeTensorsToHost(
     const DataTransferManager& data_transfer_manager,
-    const NameMLValMap& ort_values) {
-  // just write data file basename to TensorProto - this will get overwritten
-  //   with the actual path when loading the checkpoint
-  const PathString tensors_data_relative_path = GetLastComponent(tensors_data_path);
-
-  const std::vector<std::string> ordered_tensor_names = GetOrderedOrtValueNames(ort_values);
-  std::vector<char> tensor_data_buffer{};
+    const NameMLValMap& ort_values,
+    std::vector<HostTensor>& host_tensors) {
   static const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
-  std::vector<ONNX_NAMESPACE::TensorProto> saved_tensor_protos{};
-  saved_tensor_protos.reserve(ordered_tensor_names.size());
-  std::ofstream tensors_data_file{tensors_data_path};
+  const std::vector<std::string> ordered_tensor_names = GetOrderedOrtValueNames(ort_values);
+  std::vector<HostTensor> copied_tensors{};
+  copied_tensors.reserve(ordered_tensor_names.size());
 
   for (const auto& tensor_name : ordered_tensor_names) {
     const OrtValue& ort_value = ort_values.at(tensor_name);
     ORT_RETURN_IF_NOT(ort_value.IsTensor(), "ort_value.IsTensor() was false");
     const Tensor& tensor = ort_value.Get<Tensor>();
-
-    tensor_data_buffer.resize(tensor.SizeInBytes());
+    ORT_RETURN_IF(tensor.DataType() == DataTypeImpl::GetType<std::string>(), "tensor.DataType() is std::string");
+
+    copied_tensors.emplace_back();
+    HostTensor& host_tensor = copied_tensors.back();
+    host_tensor.name = tensor_name;
+    host_tensor.dims = tensor.Shape().GetDims();
+    host_tensor.element_type = tensor.GetElementType();
+    host_tensor.data.resize(tensor.SizeInBytes());
     ORT_RETURN_IF_ERROR(CopyTensorDataToByteSpan(
-        data_transfer_manager, tensor, cpu_alloc_info, gsl::make_span(tensor_data_buffer)));
+        data_transfer_manager, tensor, cpu_alloc_info, gsl::make_span(host_tensor.data)));
+  }
+
+  host_tensors = std::move(copied_tensors);
+  return Status::OK();
+}
 
-    saved_tensor_protos.emplace_back();
-    ORT_RETURN_IF_ERROR(SaveRuntimeTensor(
-        tensor_name, tensor, tensor_data_buffer, tensors_data_relative_path,
-        tensors_data_file, saved_tensor_protos.back()));
+Status SaveRuntimeTensors(
+    const PathString& checkpoint_path,
+    const std::vector<HostTensor>& tensors,
+    size_t num_data_files) {
+  // TODO need to ensure the data is written in little-endian format...
+  // e.g., with endian_utils.h:WriteLittleEndian()
+  // https://github.com/microsoft/onnxruntime/blob/master/onnxruntime/core/framework/endian_utils.h
+  if (endian::native != endian::little) {
+    ORT_NOT_IMPLEMENTED("checkpointing currently requires little-endian host byte order");
+  }
+
+  num_data_files = std::max<size_t>(1, std::min(num_data_files, tensors.size()));
+
+  // split the ordered tensors into contiguous ranges of roughly equal size, one per data file
+  size_t total_bytes = 0;
+  for (const auto& tensor : tensors) {
+    total_bytes += tensor.data.size();
+  }
+  std::vector<size_t> data_file_begin(num_data_files + 1, tensors.size());
+  data_file_begin[0] = 0;
+  {
+    size_t data_file_index = 1;
+    size_t bytes = 0;
+    for (size_t i = 0; i < tensors.size() && data_file_index < num_data_files; ++i) {
+      if (bytes >= total_bytes / num_data_files * data_file_index) {
+        data_file_begin[data_file_index++] = i;
+      }
+      bytes += tensors[i].data.size();
+    }
+  }
+
+  std::vector<ONNX_NAMESPACE::TensorProto> saved_tensor_protos(tensors.size());
+  auto save_data_file = [&](size_t data_file_index) -> Status {
+    const PathString tensors_data_path = GetCheckpointTensorsDataFilePath(checkpoint_path, data_file_index);
+    // just write data file basename to TensorProto - this will get overwritten
+    //   with the actual path when loading the checkpoint
+    const PathString tensors_data_relative_path = GetLastComponent(tensors_data_path);
+    std::ofstream tensors_data_file{tensors_data_path, std::ios::binary};
+    ORT_RETURN_IF_NOT(tensors_data_file, "Failed to open data file: ", ToMBString(tensors_data_path));
+
+    for (size_t i = data_file_begin[data_file_index]; i < data_file_begin[data_file_index + 1]; ++i) {
+      ORT_RETURN_IF_ERROR(SaveRuntimeTensor(
+          tensors[i], tensors_data_relative_path, tensors_data_file, saved_tensor_protos[i]));
+    }
+    return Status::OK();
+  };
+
+  // the data files are independent, write them in parallel
+  std::vector<Status> data_file_statuses(num_data_files);
+  std::vector<std::thread> data_file_writers{};
+  for (size_t data_file_index = 1; data_file_index < num_data_files; ++data_file_index) {
+    data_file_writers.emplace_back([&, data_file_index]() {
+      data_file_statuses[data_file_index] = save_data_file(data_file_index);
+    });
+  }
+  data_file_statuses[0] = save_data_file(0);
+  for (auto& data_file_writer : data_file_writers) {
+    data_file_writer.join();
+  }
+  for (const auto& data_file_status : data_file_statuses) {
+    ORT_RETURN_IF_ERROR(data_file_status);
   }
 
   ORT_RETURN_IF_ERROR(WithOpenFile(
-      tensors_path, false,
+      GetCheckpointTensorsFilePath(checkpoint_path), false,
       [&saved_tensor_protos](int fd) {
         google::protobuf::io::FileOutputStream output{fd};
         ORT_RETURN_IF_ERROR(WriteProtoMessageSequence(saved_tensor_protos, output));
@@ -200,13 +270,11 @@ Status SaveProperties(
   return Status::OK();
 }
 
-}  // namespace
-
-Status SaveModelCheckpoint(
+Status SaveCheckpointFiles(
     const PathString& checkpoint_path,
-    const DataTransferManager& data_transfer_manager,
-    const NameMLValMap& runtime_tensors,
-    const std::unordered_map<std::string, std::string>& properties) {
+    const std::vector<HostTensor>& tensors,
+    const std::unordered_map<std::string, std::string>& properties,
+    size_t num_data_files) {
   LOGS_DEFAULT(INFO) << "Saving model checkpoint files to " << ToMBString(checkpoint_path);
 
   LOGS_DEFAULT_IF(Env::Default().FolderExists(checkpoint_path), WARNING)
@@ -215,10 +283,7 @@ Status SaveModelCheckpoint(
   ORT_RETURN_IF_ERROR(Env::Default().CreateFolder(checkpoint_path));
 
   // write tensors files
-  ORT_RETURN_IF_ERROR(SaveRuntimeTensors(
-      GetCheckpointTensorsFilePath(checkpoint_path),
-      GetCheckpointTensorsDataFilePath(checkpoint_path),
-      data_transfer_manager, runtime_tensors));
+  ORT_RETURN_IF_ERROR(SaveRuntimeTensors(checkpoint_path, tensors, num_data_files));
 
   // write properties file
   ORT_RETURN_IF_ERROR(SaveProperties(
@@ -229,10 +294,68 @@ Status SaveModelCheckpoint(
   return Status::OK();
 }
 
+}  // namespace
+
+Status SaveModelCheckpoint(
+    const PathString& checkpoint_path,
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const std::unordered_map<std::string, std::string>& properties,
+    size_t num_data_files) {
+  std::vector<HostTensor> host_tensors{};
+  ORT_RETURN_IF_ERROR(CopyRuntimeTensorsToHost(data_transfer_manager, runtime_tensors, host_tensors));
+
+  return SaveCheckpointFiles(checkpoint_path, host_tensors, properties, num_data_files);
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+  const Status status = Wait();
+  LOGS_DEFAULT_IF(!status.IsOK(), ERROR)
+      << "Failed to save model checkpoint: " << status.ErrorMessage();
+}
+
+Status AsyncCheckpointWriter::Save(
+    const PathString& checkpoint_path,
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const std::unordered_map<std::string, std::string>& properties,
+    size_t num_data_files) {
+  ORT_RETURN_IF_ERROR(Wait());
+
+  // the copies have to complete before the tensors are updated by the following steps
+  auto host_tensors = std::make_shared<std::vector<HostTensor>>();
+  ORT_RETURN_IF_ERROR(CopyRuntimeTensorsToHost(data_transfer_manager, runtime_tensors, *host_tensors));
+
+  pending_save_ = std::async(
+      std::launch::async,
+      [checkpoint_path, host_tensors, properties, num_data_files]() {
+        return SaveCheckpointFiles(checkpoint_path, *host_tensors, properties, num_data_files);
+      });
+
+  return Status::OK();
+}
+
+Status AsyncCheckpointWriter::Wait() {
+  if (!pending_save_.valid()) {
+    return Status::OK();
+  }
+
+  try {
+    return pending_save_.get();
+  } catch (const std::exception& e) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, e.what());
+  }
+}
+
 namespace {
+// points the external data locations, which hold the data file basenames, to the data files
+//   in checkpoint_directory_path relative to model_directory_path
 Status UpdateTensorsExternalDataLocations(
-    const PathString& external_data_path,
+    const PathString& model_directory_path,
+    const PathString& checkpoint_directory_path,
     std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos) {
+  std::unordered_map<std::string, std::string> data_file_relative_paths{};
+
   for (auto& tensor_proto : tensor_protos) {
     if (tensor_proto.data_location() != ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL) {
       continue;
@@ -244,8 +367,22 @@ Status UpdateTensorsExternalDataLocations(
         [](ONNX_NAMESPACE::StringStringEntryProto& kvp) { return kvp.key() == "location"; });
     ORT_RETURN_IF_NOT(location_it != external_data.end(), "location_it == external_data.end()");
 
-    // TODO is the encoding correct? https://github.com/onnx/onnx/issues/2392
-    location_it->set_value(ToMBString(external_data_path));
+    auto relative_path_it = data_file_relative_paths.find(location_it->value());
+    if (relative_path_it == data_file_relative_paths.end()) {
+      Path relative_data_path_obj{};
+      ORT_RETURN_IF_ERROR(RelativePath(
+          Path::Parse(model_directory_path),
+          Path::Parse(ConcatPathComponent<PathChar>(
+              checkpoint_directory_path, GetLastComponent(ToPathString(location_it->value())))),
+          relative_data_path_obj));
+      // TODO is the encoding correct? https://github.com/onnx/onnx/issues/2392
+      relative_path_it = data_file_relative_paths.emplace(
+                                                     location_it->value(),
+                                                     ToMBString(relative_data_path_obj.ToPathString()))
+                             .first;
+    }
+
+    location_it->set_value(relative_path_it->second);
   }
 
   return Status::OK();
@@ -281,13 +418,8 @@ Status LoadModelCheckpoint(
     ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(
         checkpoint_path, checkpoint_canonical_path));
 
-    Path relative_tensors_data_path_obj{};
-    ORT_RETURN_IF_ERROR(RelativePath(
-        Path::Parse(model_directory_canonical_path),
-        Path::Parse(GetCheckpointTensorsDataFilePath(checkpoint_canonical_path)),
-        relative_tensors_data_path_obj));
     ORT_RETURN_IF_ERROR(UpdateTensorsExternalDataLocations(
-        relative_tensors_data_path_obj.ToPathString(), loaded_tensor_protos));
+        model_directory_canonical_path, checkpoint_canonical_path, loaded_tensor_protos));
   }
 
   // read properties file
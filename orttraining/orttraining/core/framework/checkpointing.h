@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <future>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -21,6 +22,7 @@ namespace training {
  * checkpoint/
  *   tensors.pbseq - tensor protobuf messages
  *   tensors.bin - tensor binary data
+ *   tensors_<i>.bin - additional tensor binary data files, if the data is split into several files
  *   properties.pbseq - property protobuf messages
  */
 
@@ -31,16 +33,60 @@ namespace training {
  * @param data_transfer_manager The DataTransferManager instance.
  * @param runtime_tensors The tensors to persist.
  * @param properties The properties to persist.
+ * @param num_data_files The number of tensor binary data files, which are written in parallel.
  * @return The status of the operation.
  */
 common::Status SaveModelCheckpoint(
     const PathString& checkpoint_path,
     const DataTransferManager& data_transfer_manager,
     const NameMLValMap& runtime_tensors,
-    const std::unordered_map<std::string, std::string>& properties);
+    const std::unordered_map<std::string, std::string>& properties,
+    size_t num_data_files = 1);
+
+/**
+ * Saves model checkpoints in the background.
+ * The tensors are copied to host memory before Save() returns, so they may be
+ * updated afterwards, and the checkpoint files are written on another thread.
+ */
+class AsyncCheckpointWriter {
+ public:
+  AsyncCheckpointWriter() = default;
+  ~AsyncCheckpointWriter();
+
+  /**
+   * Starts saving a model checkpoint in the specified location.
+   * Waits for the previous checkpoint to be saved first.
+   *
+   * @param checkpoint_path The checkpoint location.
+   * @param data_transfer_manager The DataTransferManager instance.
+   * @param runtime_tensors The tensors to persist.
+   * @param properties The properties to persist.
+   * @param num_data_files The number of tensor binary data files, which are written in parallel.
+   * @return The status of the previous checkpoint and of the tensor copies.
+   */
+  common::Status Save(
+      const PathString& checkpoint_path,
+      const DataTransferManager& data_transfer_manager,
+      const NameMLValMap& runtime_tensors,
+      const std::unordered_map<std::string, std::string>& properties,
+      size_t num_data_files = 1);
+
+  /**
+   * Waits for the pending checkpoint, if any, to be saved.
+   *
+   * @return The status of the pending checkpoint.
+   */
+  common::Status Wait();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AsyncCheckpointWriter);
+
+  std::future<common::Status> pending_save_;
+};
 
 /**
  * Loads a model checkpoint from the specified location.
+ * The external data locations of the loaded tensors are relative to the model location.
  *
  * @param checkpoint_path The checkpoint location.
  * @param model_path The model location.
@@ -1,7 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "core/framework/murmurhash3.h"
 #include "core/graph/graph_utils.h"
+#include "core/platform/env.h"
+#include "core/platform/path_lib.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "orttraining/core/framework/ortmodule_graph_builder.h"
 #include "orttraining/core/framework/gradient_graph_builder.h"
@@ -12,6 +20,97 @@ namespace training {
 
 using namespace onnxruntime::common;
 
+namespace {
+
+template <typename T>
+void WriteValues(std::ostream& out, const std::vector<T>& values) {
+  out << values.size() << "\n";
+  for (const auto& value : values) {
+    out << value << "\n";
+  }
+}
+
+// names are read by line as they may contain spaces
+bool ReadValue(std::istream& in, std::string& value) {
+  return static_cast<bool>(std::getline(in, value));
+}
+
+template <typename T>
+bool ReadValue(std::istream& in, T& value) {
+  return static_cast<bool>(in >> value) && static_cast<bool>(in.ignore());
+}
+
+template <typename T>
+bool ReadValues(std::istream& in, std::vector<T>& values) {
+  size_t size;
+  if (!ReadValue(in, size)) {
+    return false;
+  }
+  values.resize(size);
+  for (auto& value : values) {
+    if (!ReadValue(in, value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WriteGraphInfo(std::ostream& out, const GraphInfo& graph_info) {
+  std::vector<std::string> user_input_grad_names;
+  for (const auto& input_name : graph_info.user_input_names) {
+    auto it = graph_info.user_input_grad_names.find(input_name);
+    if (it != graph_info.user_input_grad_names.end()) {
+      user_input_grad_names.push_back(it->first);
+      user_input_grad_names.push_back(it->second);
+    }
+  }
+
+  WriteValues(out, graph_info.user_input_names);
+  WriteValues(out, user_input_grad_names);
+  WriteValues(out, graph_info.initializer_names);
+  WriteValues(out, graph_info.initializer_names_to_train);
+  WriteValues(out, graph_info.initializer_grad_names_to_train);
+  WriteValues(out, graph_info.user_output_names);
+  WriteValues(out, graph_info.output_grad_indices_non_differentiable);
+  WriteValues(out, graph_info.output_grad_indices_require_full_shape);
+  WriteValues(out, graph_info.module_output_gradient_name);
+}
+
+bool ReadGraphInfo(std::istream& in, GraphInfo& graph_info) {
+  std::vector<std::string> user_input_grad_names;
+  if (!ReadValues(in, graph_info.user_input_names) ||
+      !ReadValues(in, user_input_grad_names) ||
+      !ReadValues(in, graph_info.initializer_names) ||
+      !ReadValues(in, graph_info.initializer_names_to_train) ||
+      !ReadValues(in, graph_info.initializer_grad_names_to_train) ||
+      !ReadValues(in, graph_info.user_output_names) ||
+      !ReadValues(in, graph_info.output_grad_indices_non_differentiable) ||
+      !ReadValues(in, graph_info.output_grad_indices_require_full_shape) ||
+      !ReadValues(in, graph_info.module_output_gradient_name) ||
+      user_input_grad_names.size() % 2 != 0) {
+    return false;
+  }
+
+  graph_info.user_input_grad_names.clear();
+  for (size_t i = 0; i < user_input_grad_names.size(); i += 2) {
+    graph_info.user_input_grad_names[user_input_grad_names[i]] = user_input_grad_names[i + 1];
+  }
+  return true;
+}
+
+// Cache entries are written to temporary files first, so concurrent builders never read partial entries.
+PathString GetTemporaryPath(const PathString& path) {
+  return path + ToPathString(".tmp" + std::to_string(Env::Default().GetSelfPid()));
+}
+
+Status RenameFile(const PathString& from, const PathString& to) {
+  ORT_RETURN_IF_NOT(std::rename(ToMBString(from).c_str(), ToMBString(to).c_str()) == 0,
+                    "Failed to rename ", ToMBString(from), " to ", ToMBString(to));
+  return Status::OK();
+}
+
+}  // namespace
+
 Status OrtModuleGraphBuilder::Initialize(std::istream& model_istream,
                                          const OrtModuleGraphBuilderConfiguration& config) {
   // Save the model and config.
@@ -68,6 +167,16 @@ Status OrtModuleGraphBuilder::Initialize(std::istream& model_istream,
 // So each time we need to start from the beginning, i.e., 1) replace input shapes, 2) apply graph optimizers,
 // 3) build gradient graph, and finally 4) adjust the graph inputs and outputs.
 Status OrtModuleGraphBuilder::Build(const std::vector<std::vector<int64_t>>* input_shapes_ptr) {
+  std::string graph_cache_key;
+  if (!config_.graph_cache_dir.empty()) {
+    graph_cache_key = GetGraphCacheKey(input_shapes_ptr);
+    bool found = false;
+    ORT_RETURN_IF_ERROR(LoadFromGraphCache(graph_cache_key, found));
+    if (found) {
+      return Status::OK();
+    }
+  }
+
   // Make a copy of the original model.
   auto model_proto = model_->ToProto();
   ORT_RETURN_IF_ERROR(Model::Load(model_proto, gradient_model_, nullptr, *logger_));
@@ -80,19 +189,120 @@ Status OrtModuleGraphBuilder::Build(const std::vector<std::vector<int64_t>>* inp
   // Optimize the inference graph, and if needed, build the gradient graph.
   std::unordered_set<std::string> x_node_arg_names;
   ORT_RETURN_IF_ERROR(OptimizeInferenceGraph(x_node_arg_names));
-  if (!config_.build_gradient_graph) {
-    // This graph will be used only for inferencing, so stop right here.
-    // No need to build a gradient graph.
+  if (config_.build_gradient_graph) {
+    ORT_RETURN_IF_ERROR(BuildGradientGraph(x_node_arg_names));
+
+    // Handle user outputs and output grads.
+    HandleOutputsAndGrads();
+
+    // Reorder outputs.
+    ReorderOutputs();
+  }
+
+  if (!config_.graph_cache_dir.empty()) {
+    // a failure to cache the graphs does not fail the build
+    const Status status = SaveToGraphCache(graph_cache_key);
+    LOGS_IF(!status.IsOK(), *logger_, WARNING) << "Failed to save the built graphs to the graph cache: " << status.ErrorMessage();
+  }
+
+  return Status::OK();
+}
+
+// Graphs built without concrete input shapes keep the symbolic dims of the exported model, so one cache
+// entry serves all the input shapes of the same input schema.
+std::string OrtModuleGraphBuilder::GetGraphCacheKey(const std::vector<std::vector<int64_t>>* input_shapes_ptr) const {
+  std::ostringstream key_data;
+  std::string model_str;
+  ORT_ENFORCE(model_->ToProto().SerializeToString(&model_str), "Fail to serialize model to string.");
+  key_data << model_str << "\n";
+
+  WriteValues(key_data, config_.initializer_names);
+  WriteValues(key_data, config_.initializer_names_to_train);
+  WriteValues(key_data, config_.input_names_require_grad);
+  const auto& transformer_config = config_.graph_transformer_config;
+  key_data << config_.use_invertible_layernorm_grad << config_.build_gradient_graph
+           << transformer_config.enable_gelu_approximation << transformer_config.attn_dropout_recompute
+           << transformer_config.gelu_recompute << transformer_config.transformer_layer_recompute << " "
+           << transformer_config.number_recompute_layers << " " << transformer_config.recompute_memory_budget_in_bytes
+           << " " << transformer_config.propagate_cast_ops_level << " "
+           << transformer_config.allow_layer_norm_mod_precision << "\n";
+  WriteValues(key_data, transformer_config.propagate_cast_ops_allow);
+
+  if (input_shapes_ptr) {
+    for (const auto& input_shape : *input_shapes_ptr) {
+      WriteValues(key_data, input_shape);
+    }
+  }
+
+  const std::string data = key_data.str();
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(data.data(), static_cast<int>(data.size()), 0, hash);
+
+  std::ostringstream key;
+  key << std::hex << std::setfill('0');
+  for (const auto value : hash) {
+    key << std::setw(8) << value;
+  }
+  return key.str();
+}
+
+Status OrtModuleGraphBuilder::LoadFromGraphCache(const std::string& key, bool& found) {
+  const PathString cache_dir = ToPathString(config_.graph_cache_dir);
+  const PathString graph_info_path = ConcatPathComponent<PathChar>(cache_dir, ToPathString(key + ".graph_info"));
+  const PathString inference_model_path =
+      ConcatPathComponent<PathChar>(cache_dir, ToPathString(key + "_inference_optimized.onnx"));
+  const PathString model_path = ConcatPathComponent<PathChar>(cache_dir, ToPathString(key + ".onnx"));
+
+  // the graph info is written last, so an entry is complete if it exists
+  found = false;
+  std::ifstream graph_info_file{graph_info_path};
+  if (!graph_info_file) {
     return Status::OK();
   }
 
-  ORT_RETURN_IF_ERROR(BuildGradientGraph(x_node_arg_names));
+  GraphInfo graph_info;
+  if (!ReadGraphInfo(graph_info_file, graph_info)) {
+    LOGS(*logger_, WARNING) << "Ignoring the invalid graph cache entry " << key;
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(Model::Load(inference_model_path, inference_optimized_model_, nullptr, *logger_));
+  if (config_.build_gradient_graph) {
+    ORT_RETURN_IF_ERROR(Model::Load(model_path, gradient_model_, nullptr, *logger_));
+  } else {
+    ORT_RETURN_IF_ERROR(Model::Load(inference_optimized_model_->ToProto(), gradient_model_, nullptr, *logger_));
+  }
+  graph_info_ = std::move(graph_info);
+
+  LOGS(*logger_, INFO) << "Loaded the built graphs from the graph cache entry " << key;
+  found = true;
+  return Status::OK();
+}
+
+Status OrtModuleGraphBuilder::SaveToGraphCache(const std::string& key) const {
+  const PathString cache_dir = ToPathString(config_.graph_cache_dir);
+  if (!Env::Default().FolderExists(cache_dir)) {
+    ORT_RETURN_IF_ERROR(Env::Default().CreateFolder(cache_dir));
+  }
+
+  const PathString graph_info_path = ConcatPathComponent<PathChar>(cache_dir, ToPathString(key + ".graph_info"));
+  const PathString inference_model_path =
+      ConcatPathComponent<PathChar>(cache_dir, ToPathString(key + "_inference_optimized.onnx"));
+  const PathString model_path = ConcatPathComponent<PathChar>(cache_dir, ToPathString(key + ".onnx"));
 
-  // Handle user outputs and output grads.
-  HandleOutputsAndGrads();
+  ORT_RETURN_IF_ERROR(Model::Save(*inference_optimized_model_, GetTemporaryPath(inference_model_path)));
+  ORT_RETURN_IF_ERROR(RenameFile(GetTemporaryPath(inference_model_path), inference_model_path));
+  if (config_.build_gradient_graph) {
+    ORT_RETURN_IF_ERROR(Model::Save(*gradient_model_, GetTemporaryPath(model_path)));
+    ORT_RETURN_IF_ERROR(RenameFile(GetTemporaryPath(model_path), model_path));
+  }
 
-  // Reorder outputs.
-  ReorderOutputs();
+  {
+    std::ofstream graph_info_file{GetTemporaryPath(graph_info_path)};
+    WriteGraphInfo(graph_info_file, graph_info_);
+    ORT_RETURN_IF_NOT(graph_info_file.flush(), "Failed to write ", ToMBString(graph_info_path));
+  }
+  ORT_RETURN_IF_ERROR(RenameFile(GetTemporaryPath(graph_info_path), graph_info_path));
 
   return Status::OK();
 }
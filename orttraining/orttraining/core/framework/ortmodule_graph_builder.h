@@ -33,6 +33,10 @@ struct OrtModuleGraphBuilderConfiguration {
 
   // Log severity
   logging::Severity loglevel{logging::Severity::kWARNING};
+
+  // Directory of the persistent cache of built graphs, keyed by the initial model, this configuration
+  // and the input shapes. Empty disables the cache.
+  std::string graph_cache_dir{};
 };
 
 /**
@@ -111,6 +115,15 @@ class OrtModuleGraphBuilder {
   // Reorder gradient graph outputs.
   void ReorderOutputs();
 
+  // Get the key of the built graphs in the graph cache.
+  std::string GetGraphCacheKey(const std::vector<std::vector<int64_t>>* input_shapes_ptr) const;
+
+  // Load the built graphs from the graph cache, found is false if they are not cached.
+  Status LoadFromGraphCache(const std::string& key, bool& found);
+
+  // Save the built graphs to the graph cache.
+  Status SaveToGraphCache(const std::string& key) const;
+
   std::shared_ptr<onnxruntime::Model> model_;
   std::shared_ptr<onnxruntime::Model> inference_optimized_model_;
   std::shared_ptr<onnxruntime::Model> gradient_model_;
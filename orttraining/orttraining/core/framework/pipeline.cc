@@ -11,6 +11,7 @@
 #include <stdexcept>
 #include <thread>
 #include <iomanip>
+#include <utility>
 
 namespace onnxruntime {
 namespace training {
@@ -89,14 +90,19 @@ PipelineScheduler::PipelineScheduler() : num_stages_(0),
 PipelineScheduler::PipelineScheduler(
     int num_batches,
     const int num_stages,
-    const std::vector<int>& stage_id_to_rank_id_map) : num_stages_(num_stages),
-                                                       num_batches_(num_batches),
-                                                       stage_id_to_rank_id_map_(stage_id_to_rank_id_map) {
+    const std::vector<int>& stage_id_to_rank_id_map,
+    const PipelineScheduleType schedule_type) : num_stages_(num_stages),
+                                                num_batches_(num_batches),
+                                                stage_id_to_rank_id_map_(stage_id_to_rank_id_map) {
   if (stage_id_to_rank_id_map.size() != static_cast<size_t>(num_stages)) {
     throw std::invalid_argument("stage_id_to_rank_id_map should contain the MPI ranks from the first to the last pipeline stages");
   }
 
-  CreateComputeSchedule();
+  if (schedule_type == PipelineScheduleType::OneForwardOneBackward) {
+    CreateOneForwardOneBackwardComputeSchedule();
+  } else {
+    CreateComputeSchedule();
+  }
 
   const size_t num_events_per_slot_compute_side = 2;
   std::vector<int> compute_default_events(num_events_per_slot_compute_side, -1);
@@ -466,6 +472,88 @@ void PipelineScheduler::CreateComputeSchedule() {
   }
 }
 
+void PipelineScheduler::CreateOneForwardOneBackwardComputeSchedule() {
+  // Order of the computations on each stage. stage_tasks[s][i] is the batch and pass (true for forward) of the
+  // i-th computation on the s-th stage.
+  std::vector<std::vector<std::pair<int, bool>>> stage_tasks(num_stages_);
+  for (int s = 0; s < num_stages_; ++s) {
+    auto& tasks = stage_tasks.at(s);
+    const int num_warmup_batches = std::min(num_stages_ - s - 1, num_batches_);
+    int next_forward = 0;
+    int next_backward = 0;
+    while (next_forward < num_warmup_batches) {
+      tasks.push_back({next_forward++, true});
+    }
+
+    while (next_backward < num_batches_) {
+      if (next_forward < num_batches_) {
+        tasks.push_back({next_forward++, true});
+      }
+      tasks.push_back({next_backward++, false});
+    }
+  }
+
+  // forward_time[b][s] and backward_time[b][s] are the times of batch b's computations on stage s, -1 until known.
+  std::vector<std::vector<int>> forward_time(num_batches_, std::vector<int>(num_stages_, -1));
+  std::vector<std::vector<int>> backward_time(num_batches_, std::vector<int>(num_stages_, -1));
+  // Index of the next computation to place and the time of the last placed computation on each stage.
+  std::vector<size_t> next_task(num_stages_, 0);
+  std::vector<int> last_time(num_stages_, -1);
+
+  // Place the computations in the order of each stage. A computation happens after the previous one on its stage and
+  // after its upstream computation, so each pass places the computations whose upstream computation is placed.
+  bool all_placed = false;
+  while (!all_placed) {
+    all_placed = true;
+    bool progress = false;
+    for (int s = 0; s < num_stages_; ++s) {
+      auto& tasks = stage_tasks.at(s);
+      for (; next_task.at(s) < tasks.size(); ++next_task.at(s)) {
+        const int batch = tasks.at(next_task.at(s)).first;
+        const bool is_forward = tasks.at(next_task.at(s)).second;
+
+        int upstream_time;
+        if (is_forward) {
+          upstream_time = s == 0 ? -1 : forward_time.at(batch).at(s - 1);
+          if (s > 0 && upstream_time < 0) {
+            break;
+          }
+        } else {
+          upstream_time = s == num_stages_ - 1 ? forward_time.at(batch).at(s) : backward_time.at(batch).at(s + 1);
+          if (upstream_time < 0) {
+            break;
+          }
+        }
+
+        const int time = std::max(last_time.at(s), upstream_time) + 1;
+        (is_forward ? forward_time : backward_time).at(batch).at(s) = time;
+        last_time.at(s) = time;
+        progress = true;
+      }
+
+      all_placed = all_placed && next_task.at(s) == tasks.size();
+    }
+
+    if (!all_placed && !progress) {
+      throw std::runtime_error("Failed to create the 1F1B pipeline schedule.");
+    }
+  }
+
+  const int compute_max_time = *std::max_element(last_time.begin(), last_time.end()) + 1;
+  compute_table_.resize(compute_max_time, std::vector<PipelineSlot>(num_stages_));
+  compute_batch_count_.resize(compute_max_time);
+  commute_batch_count_.resize(compute_max_time);
+
+  for (int batch_id = 0; batch_id < num_batches_; ++batch_id) {
+    InsertForwardCompute(batch_id, forward_time.at(batch_id));
+    InsertBackwardCompute(batch_id, forward_time.at(batch_id), backward_time.at(batch_id));
+
+    for (int t_compute = forward_time.at(batch_id).at(0); t_compute <= backward_time.at(batch_id).at(0); ++t_compute) {
+      ++compute_batch_count_.at(t_compute);
+    }
+  }
+}
+
 std::vector<int> PipelineScheduler::TryGetEvent(
     const bool is_waited_event,
     const int batch_id,
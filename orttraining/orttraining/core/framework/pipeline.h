@@ -143,10 +143,22 @@ class PipelineSlot {
   std::vector<int> recorded_events_;
 };
 
+// How the forward and backward computations of the micro-batches are ordered on each pipeline stage.
+enum class PipelineScheduleType {
+  // Each computation is placed at the earliest free time slot after its upstream computation, with at most
+  // num_stages micro-batches between their forward and backward computations on the first stage.
+  Greedy,
+  // 1F1B (PipeDream-flush). Stage s runs num_stages - s - 1 warm-up forward computations, then alternates one
+  // forward and one backward computation, and ends with the remaining backward computations. At most num_stages - s
+  // micro-batches hold activations on stage s.
+  OneForwardOneBackward
+};
+
 class PipelineScheduler {
  public:
   PipelineScheduler();
-  PipelineScheduler(const int num_batches, const int num_stages, const std::vector<int>& stage_id_to_rank_id_map);
+  PipelineScheduler(const int num_batches, const int num_stages, const std::vector<int>& stage_id_to_rank_id_map,
+                    const PipelineScheduleType schedule_type = PipelineScheduleType::Greedy);
 
   // Number of time steps.
   size_t GetScheduleSize() const { return compute_commute_table_.size(); }
@@ -199,6 +211,7 @@ class PipelineScheduler {
   // forward_time[s] is the forward time for the given batch on stage s.
   std::vector<int> FindBackwardComputeTime(const std::vector<int> forward_time) const;
   void CreateComputeSchedule();
+  void CreateOneForwardOneBackwardComputeSchedule();
   void InsertEvents(std::vector<std::vector<PipelineSlot>>& schedule, const size_t num_events_per_slot, const std::vector<int> initial_events);
   void CreateFullSchedule();
   void MapStageIdToMpiRank();
@@ -234,9 +234,10 @@ Status AdasumOptimizerGraphBuilder::BuildInternal(
                                                      graph_defs,
                                                      opt_graph_config_.adasum_reduction_type));
 
-  //check if allreduced deltas are finite
+  //check if allreduced deltas are finite, bf16 deltas have the range of fp32 and are not checked
   ArgDef adasum_global_grad_finite_argdef;
-  if (opt_graph_config_.use_mixed_precision) {
+  if (opt_graph_config_.use_mixed_precision &&
+      opt_graph_config_.mixed_precision_type == MixedPrecisionDataType::FP16) {
     ORT_RETURN_IF_ERROR(AddFiniteGradientCheck(
         nodearg_name_generator, gradient_argdefs, graph_defs, adasum_global_grad_finite_argdef,
         "adasum_all_deltas_finite"));
@@ -3,6 +3,12 @@
 
 #include "orttraining/core/graph/allreduce_optimizer_graph_builder.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "core/framework/data_types.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
 #include "orttraining/core/framework/distributed_run_context.h"
 
 namespace onnxruntime {
@@ -19,7 +25,9 @@ static bool IsNcclAvailable() {
 static Status AddNcclAllReduceForGradients(
     std::vector<ArgDef>& gradient_argdefs,
     std::vector<ArgDef>& input_gradient_argdef,
-    GraphAugmenter::GraphDefs& graph_defs) {
+    GraphAugmenter::GraphDefs& graph_defs,
+    bool hierarchical,
+    const std::string& node_name = "NcclAllReduce") {
   std::vector<ArgDef> allreduce_outputs(gradient_argdefs.size());
   for (size_t i = 0; i < gradient_argdefs.size(); i++) {
     TypeProto* allreduced_gradient_type_proto = graph_defs.CopyTypeProto(gradient_argdefs[i]);
@@ -34,13 +42,66 @@ static Status AddNcclAllReduceForGradients(
                                   input_gradient_argdef,
                                   allreduce_outputs,
                                   {ONNX_NAMESPACE::MakeAttribute("group_type",
-                                                                 static_cast<int64_t>(WorkerGroupType::DataParallel))},
-                                  "NcclAllReduce")});
+                                                                 static_cast<int64_t>(WorkerGroupType::DataParallel)),
+                                   ONNX_NAMESPACE::MakeAttribute("hierarchical", static_cast<int64_t>(hierarchical))},
+                                  node_name)});
 
   gradient_argdefs = allreduce_outputs;
   return Status::OK();
 }
 
+// Groups the gradients into buckets of about bucket_size_in_bytes, in the order the backward graph produces them,
+// so the AllReduce of a bucket does not have to wait for the gradients of the other buckets.
+static std::vector<std::vector<size_t>> GetGradientBuckets(
+    const Graph& graph,
+    const std::vector<std::string>& gradient_names,
+    const std::vector<ArgDef>& gradient_argdefs,
+    const size_t element_size,
+    const int64_t bucket_size_in_bytes) {
+  std::vector<size_t> order(gradient_argdefs.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (bucket_size_in_bytes <= 0) {
+    return {order};
+  }
+
+  std::unordered_map<NodeIndex, size_t> topological_positions;
+  GraphViewer graph_viewer(graph);
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    topological_positions.emplace(node_index, topological_positions.size());
+  }
+
+  // gradients without a producer, e.g. initializers, are ready first
+  std::vector<size_t> ready_positions(gradient_argdefs.size(), 0);
+  for (size_t i = 0; i < gradient_names.size(); i++) {
+    const Node* producer = graph.GetProducerNode(gradient_names[i]);
+    if (producer != nullptr) {
+      ready_positions[i] = topological_positions[producer->Index()] + 1;
+    }
+  }
+
+  std::stable_sort(order.begin(), order.end(), [&ready_positions](size_t a, size_t b) {
+    return ready_positions[a] < ready_positions[b];
+  });
+
+  std::vector<std::vector<size_t>> buckets;
+  int64_t bucket_bytes = 0;
+  for (size_t i : order) {
+    if (buckets.empty() || bucket_bytes >= bucket_size_in_bytes) {
+      buckets.emplace_back();
+      bucket_bytes = 0;
+    }
+
+    buckets.back().push_back(i);
+    const auto& shape_proto = gradient_argdefs[i].type_proto->tensor_type().shape();
+    const int64_t element_count = utils::GetTensorShapeFromTensorShapeProto(shape_proto).Size();
+    if (element_count > 0) {
+      bucket_bytes += element_count * static_cast<int64_t>(element_size);
+    }
+  }
+
+  return buckets;
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -74,16 +135,35 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
     return graph.GenerateNodeArgName(base_name);
   };
 
-  // add gradient scaling
-  std::vector<ArgDef> output_gradient_argdef;
   const auto total_num_accumulations =
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0, "total_num_accumulations <= 0");
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
 
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  const auto allreduce_type = opt_graph_config_.AllReduceDataType();
+  const size_t element_size = DataTypeImpl::TensorTypeFromONNXEnum(allreduce_type)->GetElementType()->Size();
+  const auto buckets = GetGradientBuckets(graph, gradient_names_, gradient_argdefs, element_size,
+                                          opt_graph_config_.allreduce_bucket_size_in_bytes);
+
+  // add gradient scaling and AllReduce for each bucket
+  for (const auto& bucket : buckets) {
+    std::vector<ArgDef> bucket_gradient_argdefs;
+    for (size_t i : bucket) {
+      bucket_gradient_argdefs.push_back(gradient_argdefs[i]);
+    }
+
+    std::vector<ArgDef> output_gradient_argdef;
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, bucket_gradient_argdefs, output_gradient_argdef,
+                                                graph_defs, allreduce_type));
+
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(bucket_gradient_argdefs, output_gradient_argdef, graph_defs,
+                                                     opt_graph_config_.use_hierarchical_allreduce,
+                                                     buckets.size() == 1 ? "NcclAllReduce" : nodearg_name_generator("NcclAllReduce")));
+
+    for (size_t j = 0; j < bucket.size(); j++) {
+      gradient_argdefs[bucket[j]] = bucket_gradient_argdefs[j];
+    }
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/core/graph/optimizer/fused_adam_optimizer_builder.h"
+#include "orttraining/core/graph/graph_augmenter.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/util/math.h"
+#include "onnx/defs/attr_proto_util.h"
+#include "orttraining/core/session/training_session.h"
+
+namespace onnxruntime {
+namespace training {
+namespace {
+
+float GetFloatAttribute(const OptimizerNodeConfig& opt_config, const std::string& name, float default_value) {
+  auto it = opt_config.attributes.find(name);
+  return it != opt_config.attributes.end() ? it->second : default_value;
+}
+
+int64_t GetIntAttribute(const OptimizerNodeConfig& opt_config, const std::string& name, int64_t default_value) {
+  auto it = opt_config.int_attributes.find(name);
+  return it != opt_config.int_attributes.end() ? it->second : default_value;
+}
+
+}  // namespace
+
+Status FusedAdamOptimizerBuilder::Build(
+    const OptimizerBuilderConfig& config,
+    GraphAugmenter::GraphDefs& graph_defs,
+    std::vector<ONNX_NAMESPACE::TensorProto>& new_external_initializers,
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
+    std::vector<ArgDef>& output_weight_argdefs,
+    std::vector<ArgDef>& output_gradient_argdefs) const {
+  const auto& weight_argdefs = config.weight_argdefs;
+  const auto& gradient_argdefs = config.gradient_argdefs;
+  const auto& opt_configs = config.opt_configs;
+
+  // gradient clipping is disabled by default for Adam.
+  bool enable_grad_clipping = config.enable_grad_clipping.has_value() ? *config.enable_grad_clipping : false;
+
+  ORT_RETURN_IF_NOT(weight_argdefs.size() <= size_t(1024),
+                    "The current FusedAdamOptimizer can only update up to 1024 weight tensors, but ",
+                    "the actual number of weight tensors is ", weight_argdefs.size());
+
+  // Attributes shared by all weights.
+  const int64_t do_bias_correction = GetIntAttribute(opt_configs.front(), "do_bias_correction", 1);
+  const int64_t weight_decay_mode = GetIntAttribute(opt_configs.front(), "weight_decay_mode", 0);
+
+  std::vector<float> alpha;
+  std::vector<float> beta;
+  std::vector<float> lambda;
+  std::vector<float> epsilon;
+  std::vector<float> max_norm_clip;
+
+  // Inputs and outputs of each weight: [w, g, m1, m2, w_mixed_precision] and
+  // [w_new, g_new, m1_new, m2_new, w_mixed_precision_new].
+  std::vector<ArgDef> grouped_input_argdefs;
+  std::vector<ArgDef> grouped_output_argdefs;
+
+  for (size_t i = 0; i < weight_argdefs.size(); ++i) {
+    const std::string& weight_name = weight_argdefs[i].name;
+    const std::string& gradient_name = gradient_argdefs[i].name;
+    const TypeProto* const weight_type_proto = weight_argdefs[i].type_proto;
+    const TypeProto* const gradient_type_proto = gradient_argdefs[i].type_proto;
+
+    // Return either the input gradient/weight/mixed-precision-weight or updated gradient/weight/mixed-precision-weight.
+    ArgDef output_gradient_argdef = gradient_argdefs[i];
+    ArgDef output_weight_argdef = weight_argdefs[i];
+    if (opt_configs[i].mixed_precision_weight_arg != nullptr)
+      output_weight_argdef = ArgDef(opt_configs[i].mixed_precision_weight_arg->Name(), opt_configs[i].mixed_precision_weight_arg->TypeAsProto());
+
+    // In distributed training, some weights may not be updated by all ranks.
+    if (opt_configs[i].enabled) {
+      ORT_RETURN_IF_NOT(GetIntAttribute(opt_configs[i], "do_bias_correction", 1) == do_bias_correction &&
+                            GetIntAttribute(opt_configs[i], "weight_decay_mode", 0) == weight_decay_mode,
+                        "All weights optimized by FusedAdamOptimizer should use the same do_bias_correction and ",
+                        "weight_decay_mode.");
+
+      alpha.push_back(GetFloatAttribute(opt_configs[i], "alpha", 0.9f));
+      beta.push_back(GetFloatAttribute(opt_configs[i], "beta", 0.999f));
+      lambda.push_back(GetFloatAttribute(opt_configs[i], "lambda", 0.0f));
+      epsilon.push_back(GetFloatAttribute(opt_configs[i], "epsilon", 1e-8f));
+      max_norm_clip.push_back(GetFloatAttribute(opt_configs[i], "max_norm_clip", 1.0f));
+
+      std::vector<int64_t> weight_dims;
+      ORT_RETURN_IF_NOT(weight_type_proto &&
+                            weight_type_proto->has_tensor_type() &&
+                            weight_type_proto->tensor_type().has_shape(),
+                        "weight_argsdefs[", i, "] did not have tensor with shape");
+      for (const auto& dim : weight_type_proto->tensor_type().shape().dim()) {
+        weight_dims.push_back(dim.dim_value());
+      }
+
+      grouped_input_argdefs.push_back(weight_argdefs[i]);
+      grouped_input_argdefs.push_back(gradient_argdefs[i]);
+
+      // Output either w_new or g_new based on config.
+      if (opt_configs[i].update_weight) {
+        output_weight_argdef = ArgDef(weight_name + "_Adam_out", weight_type_proto);
+        grouped_output_argdefs.push_back(output_weight_argdef);  // w_new
+        grouped_output_argdefs.push_back(ArgDef());              // g_new
+      } else {
+        output_gradient_argdef = ArgDef(gradient_name + "_Adam_out", gradient_type_proto);
+        grouped_output_argdefs.push_back(ArgDef());                // w_new
+        grouped_output_argdefs.push_back(output_gradient_argdef);  // g_new
+      }
+
+      weight_to_opt_mapping[weight_name] = {};
+      const auto& initial_states = opt_configs[i].initial_states;
+      const auto element_type = opt_configs[i].use_mixed_precision_moments ? ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT16 : ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT;
+      // Add first- and second-order momentums to input list.
+      for (const auto& moments_prefix : MOMENTS_PREFIXES) {
+        const std::string gradient_moment_name = moments_prefix + "_" + weight_name;
+
+        TensorProto moment_tensor_proto;
+        TypeProto* moment_type_proto = graph_defs.CopyTypeProto(weight_argdefs[i]);
+
+        // Update moment initializer with init value
+        const auto moment_state_it = initial_states.find(moments_prefix);
+        if (moment_state_it != initial_states.end()) {
+          const auto& init_tensor = moment_state_it->second.Get<Tensor>();
+          ORT_THROW_IF_ERROR(IsMatchingTypeAndShape(init_tensor, element_type, weight_dims));
+          moment_tensor_proto = utils::TensorToTensorProto(init_tensor, gradient_moment_name);
+        } else if (opt_configs[i].use_mixed_precision_moments) {
+          moment_tensor_proto = CreateTensorProto<MLFloat16>(gradient_moment_name, MLFloat16(math::floatToHalf(0.f)), weight_dims);
+        } else {
+          moment_tensor_proto = CreateTensorProto<float>(gradient_moment_name, 0.f, weight_dims);
+        }
+
+        moment_type_proto->mutable_tensor_type()->set_elem_type(element_type);
+
+        new_external_initializers.emplace_back(std::move(moment_tensor_proto));
+        weight_to_opt_mapping[weight_name][moments_prefix] = gradient_moment_name;
+
+        grouped_input_argdefs.push_back(ArgDef(gradient_moment_name, moment_type_proto));
+        grouped_output_argdefs.push_back(ArgDef(gradient_moment_name + "_Out", moment_type_proto));
+      }
+
+      // w_mixed_precision & w_mixed_precision_new
+      if (opt_configs[i].update_weight && opt_configs[i].mixed_precision_weight_arg != nullptr) {
+        grouped_input_argdefs.push_back(ArgDef(opt_configs[i].mixed_precision_weight_arg->Name(),
+                                               opt_configs[i].mixed_precision_weight_arg->TypeAsProto()));
+        output_weight_argdef = ArgDef(opt_configs[i].mixed_precision_weight_arg->Name() + "_Adam_out",
+                                      opt_configs[i].mixed_precision_weight_arg->TypeAsProto());
+        grouped_output_argdefs.push_back(output_weight_argdef);
+      } else {
+        grouped_input_argdefs.push_back(ArgDef());
+        grouped_output_argdefs.push_back(ArgDef());
+      }
+    }
+
+    output_weight_argdefs.push_back(output_weight_argdef);
+    output_gradient_argdefs.push_back(output_gradient_argdef);
+  }
+
+  // Nothing to update on this rank.
+  if (alpha.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<ArgDef> input_argdefs;
+  std::vector<ArgDef> output_argdefs;
+
+  if (config.gradient_norm_finite_argdef) {
+    input_argdefs.push_back(*config.gradient_norm_finite_argdef);
+  } else {
+    input_argdefs.emplace_back(ArgDef());
+  }
+
+  if (!opt_configs[0].loss_scale_input_name.empty()) {
+    input_argdefs.emplace_back(ArgDef(opt_configs[0].loss_scale_input_name, graph_defs.CreateTypeProto({1}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT)));
+  } else {
+    input_argdefs.emplace_back(ArgDef());
+  }
+
+  if (config.gradient_norm_argdef && enable_grad_clipping) {
+    input_argdefs.push_back(*config.gradient_norm_argdef);
+  } else if (!config.gradient_norm_argdef && enable_grad_clipping) {
+    ORT_THROW("Gradient clipping is enabled but gradient norm is not given.");
+  } else {
+    input_argdefs.push_back(ArgDef());
+  }
+
+  input_argdefs.emplace_back(ArgDef(opt_configs[0].lr_feed_name, CreateLearningRateTypeProto(graph_defs)));
+  graph_defs.AddGraphInputs({opt_configs[0].lr_feed_name});
+
+  // The update count shared by all weights, which is 1 at the first training iteration.
+  TensorProto uc_tensor_proto;
+  const auto& shared_optim_state = config.shared_optimizer_states;
+  const auto uc_state_it = shared_optim_state.find(ADAM_UC_PREFIX);
+  if (uc_state_it != shared_optim_state.end()) {
+    const auto& init_tensor = uc_state_it->second.Get<Tensor>();
+    ORT_THROW_IF_ERROR(IsMatchingTypeAndShape(init_tensor, ONNX_NAMESPACE::TensorProto_DataType_INT64, {1}));
+    uc_tensor_proto = utils::TensorToTensorProto(init_tensor, ADAM_UC_PREFIX);
+  } else {
+    uc_tensor_proto = CreateTensorProto<int64_t>(ADAM_UC_PREFIX, 1);
+  }
+  new_external_initializers.emplace_back(uc_tensor_proto);
+  weight_to_opt_mapping[onnxruntime::training::SHARED_OPTIMIZER_STATES_KEY][ADAM_UC_PREFIX] = ADAM_UC_PREFIX;
+  input_argdefs.emplace_back(ArgDef(ADAM_UC_PREFIX));
+
+  TypeProto* uc_type_proto = graph_defs.CreateTypeProto({}, ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  output_argdefs.emplace_back(ArgDef(ADAM_UC_PREFIX + "_Out", uc_type_proto));
+
+  input_argdefs.insert(input_argdefs.end(), grouped_input_argdefs.begin(), grouped_input_argdefs.end());
+  output_argdefs.insert(output_argdefs.end(), grouped_output_argdefs.begin(), grouped_output_argdefs.end());
+
+  std::vector<AttributeProto> attribute_protos;
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("alpha", alpha));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("beta", beta));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("lambda", lambda));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("epsilon", epsilon));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("max_norm_clip", max_norm_clip));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("do_bias_correction", do_bias_correction));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("weight_decay_mode", weight_decay_mode));
+
+  graph_defs.AddNodeDefs({NodeDef(OpDefinition(),
+                                  input_argdefs,
+                                  output_argdefs,
+                                  attribute_protos,
+                                  OptimizerNodeName("AllWeights"))});
+
+  return Status::OK();
+}
+
+}  // namespace training
+}  // namespace onnxruntime
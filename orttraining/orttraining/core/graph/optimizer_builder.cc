@@ -3,6 +3,7 @@
 
 #include "orttraining/core/graph/optimizer_builder.h"
 #include "orttraining/core/graph/optimizer/adam_optimizer_builder.h"
+#include "orttraining/core/graph/optimizer/fused_adam_optimizer_builder.h"
 #include "orttraining/core/graph/optimizer/lamb_optimizer_builder.h"
 #include "orttraining/core/graph/optimizer/sgd_optimizer_builder.h"
 
@@ -12,6 +13,7 @@ namespace training {
 // Register all optimizers here.
 void OptimizerBuilderRegistry::RegisterBuilders() {
   GetInstance().Register<AdamOptimizerBuilder>("AdamOptimizer");
+  GetInstance().Register<FusedAdamOptimizerBuilder>("FusedAdamOptimizer");
   GetInstance().Register<LambOptimizerBuilder>("LambOptimizer");
   GetInstance().Register<SGDOptimizerBuilder>("SGDOptimizer");
 }
@@ -28,8 +28,9 @@ enum MixedPrecisionDataType {
 };
 
 // Configuration for the DeepSpeed ZeRO technique.  Currently only the stage
-// setting is supported, and only with stages 0 (disabled) and 1 (optimizer
-// state partitioning).
+// setting is supported, and only with stages 0 (disabled), 1 (optimizer
+// state partitioning) and 2 (optimizer state and accumulated gradient
+// partitioning).
 
 struct ZeROConfig {
   // Default configuration
@@ -66,6 +67,10 @@ struct OptimizerGraphConfig {
   MixedPrecisionDataType mixed_precision_type{MixedPrecisionDataType::FP16};
   bool allreduce_in_mixed_precision_type{false};
   bool use_nccl{false};
+  // the gradients are all-reduced in buckets of about this many bytes, 0 means a single AllReduce of all gradients
+  int64_t allreduce_bucket_size_in_bytes{0};
+  // whether the NCCL AllReduce reduces within the node first and only exchanges a shard per GPU across nodes
+  bool use_hierarchical_allreduce{false};
   ZeROConfig deepspeed_zero{0};
   int gradient_accumulation_steps{1};
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
@@ -436,9 +436,8 @@ Status OptimizerGraphBuilder::Build(
   // add gradient accumulation
   std::vector<ArgDef> gradient_accumulation_buffers;
   if (is_gradient_accumulation_enabled) {
-    ArgDef group_accumulate_gradient_output =
-        AddGradientAccumulationNodes(nodearg_name_generator, gradient_argdefs, gradient_accumulation_buffers, graph_defs);
-    optimizer_graph_outputs[OptimizerOutputKey::GradientAccumulation] = group_accumulate_gradient_output.name;
+    ORT_RETURN_IF_ERROR(AddGradientAccumulation(
+        graph, graph_defs, weight_argdefs, gradient_argdefs, gradient_accumulation_buffers, optimizer_graph_outputs));
   }
 
   //gradient norm for bfloat16 is not ready yet. skip it to unblock the testing
@@ -463,6 +462,23 @@ Status OptimizerGraphBuilder::Build(
   return GraphAugmenter::AugmentGraph(graph, graph_defs);
 }
 
+Status OptimizerGraphBuilder::AddGradientAccumulation(
+    Graph& graph,
+    GraphAugmenter::GraphDefs& graph_defs,
+    std::vector<ArgDef>& /*weight_argdefs*/,
+    std::vector<ArgDef>& gradient_argdefs,
+    std::vector<ArgDef>& gradient_accumulation_buffers,
+    OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) {
+  auto nodearg_name_generator = [&graph](const std::string& base_name) {
+    return graph.GenerateNodeArgName(base_name);
+  };
+
+  ArgDef group_accumulate_gradient_output =
+      AddGradientAccumulationNodes(nodearg_name_generator, gradient_argdefs, gradient_accumulation_buffers, graph_defs);
+  optimizer_graph_outputs[OptimizerOutputKey::GradientAccumulation] = group_accumulate_gradient_output.name;
+  return Status::OK();
+}
+
 Status OptimizerGraphBuilder::BuildInternal(
     bool should_add_gradient_norm,
     bool should_add_gradient_finite_check,
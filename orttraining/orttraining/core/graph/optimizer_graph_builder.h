@@ -80,6 +80,16 @@ class OptimizerGraphBuilder {
       std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
       OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs);
 
+  // This function can be overriden by child classes that need to change the
+  // gradients before they are accumulated, e.g. to accumulate only a partition.
+  virtual Status AddGradientAccumulation(
+      Graph& graph,
+      GraphAugmenter::GraphDefs& graph_defs,
+      std::vector<ArgDef>& weight_argdefs,
+      std::vector<ArgDef>& gradient_argdefs,
+      std::vector<ArgDef>& gradient_accumulation_buffers,
+      OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs);
+
   Status AddGradientPassThroughNode(
       const NodeArgNameGeneratorFn& nodearg_name_generator,
       std::vector<ArgDef>& gradient_argdefs,  // update argdefs in place
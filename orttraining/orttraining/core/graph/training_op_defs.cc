@@ -327,6 +327,183 @@ OpSchema& RegisterLambOpSchema(OpSchema&& op_schema) {
   return op_schema;
 }
 
+// Adam over all weights in one node. The inputs and outputs follow LambOptimizer, and the
+// attributes follow AdamOptimizer with one value of each float attribute per weight.
+OpSchema& RegisterFusedAdamOpSchema(OpSchema&& op_schema) {
+  op_schema
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "alpha",
+          "Coefficient of previous gradient in running average.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 0.9f))
+      .Attr(
+          "beta",
+          "Coefficient of previous squared gradient in running average.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 0.999f))
+      .Attr(
+          "lambda",
+          "Regularization coefficient of 0.5 * lambda * ||X||_2^2. Default to 0, "
+          "which means no regularization.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 0.0f))
+      .Attr(
+          "epsilon",
+          "Small scalar to avoid dividing by zero.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 1e-8f))
+      .Attr(
+          "max_norm_clip",
+          "clip threshold of gradients.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 1.f))
+      .Attr(
+          "do_bias_correction",
+          "Compute unbiased 1st and 2nd momentums.",
+          AttributeProto::INT,
+          static_cast<int64_t>(1))
+      .Attr(
+          "weight_decay_mode",
+          "Modes for applying weight decay, "
+          "0 means applying decay before weight update, "
+          "1 means applying decay after weight update.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .TypeConstraint(
+          "T1",
+          {"tensor(float16)", "tensor(float)", "tensor(double)", "tensor(bfloat16)"},
+          "Constrain learning rate to float")
+      .TypeConstraint(
+          "T2",
+          {"tensor(int64)"},
+          "Constrain update count to 64-bit integer")
+      .TypeConstraint(
+          "T3",
+          {"tensor(float)", "tensor(double)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T4",
+          {"tensor(float16)", "tensor(float)", "tensor(double)", "tensor(bfloat16)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T_GRAD",
+          {"tensor(float16)", "tensor(float)", "tensor(double)", "tensor(bfloat16)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T_MIXED_PRECISION_FP",
+          {"tensor(float16)", "tensor(bfloat16)"},
+          "Constrain input types to float16 or bfloat16 tensors.")
+      .TypeConstraint(
+          "T_GRAD_NORM",
+          {"tensor(float16)", "tensor(float)", "tensor(double)", "tensor(bfloat16)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T_BOOL",
+          {"tensor(bool)"},
+          "Constrain types to boolean tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // The update count, the first output, and the grouped outputs mirror their inputs.
+        propagateElemTypeFromInputToOutput(ctx, 4, 0);
+        if (hasInputShape(ctx, 4)) {
+          propagateShapeFromInputToOutput(ctx, 4, 0);
+        }
+
+        for (size_t i = 0; i + 5 < ctx.getNumInputs() && i + 1 < ctx.getNumOutputs(); ++i) {
+          const size_t input_index = 5 + i;
+          const size_t output_index = 1 + i;
+          if (ctx.getInputType(input_index) != nullptr) {
+            propagateElemTypeFromInputToOutput(ctx, input_index, output_index);
+            if (hasInputShape(ctx, input_index)) {
+              propagateShapeFromInputToOutput(ctx, input_index, output_index);
+            }
+          }
+        }
+      });
+
+  op_schema
+      .Input(
+          0,
+          "update_signal",
+          "This signal indicates if weight tensors should be updated.",
+          "T_BOOL",
+          OpSchema::Optional)
+      .Input(
+          1,
+          "loss_scale",
+          "Loss scale for mixed precision training.",
+          "T3",
+          OpSchema::Optional)
+      .Input(
+          2,
+          "global_gradient_norm",
+          "Global gradient norm.",
+          "T_GRAD_NORM",
+          OpSchema::Optional)
+      .Input(
+          3,
+          "R",
+          "The initial learning rate.",
+          "T1")
+      .Input(
+          4,
+          "update_count",
+          "The update count shared by all weights. It should be a scalar.",
+          "T2");
+
+  AddRepeatedInputs(
+      op_schema,
+      5,
+      1024,
+      {"weights",
+       "gradients",
+       "moment1",
+       "moment2",
+       "mixed_precision_weights"},
+      {"weights to optimize.",
+       "gradients computed in this iteration.",
+       "exponentially averaged historical gradients.",
+       "exponentially averaged historical squared gradients.",
+       "FP16 or BF16 weights to optimize."},
+      {"T3",
+       "T_GRAD",
+       "T4",
+       "T4",
+       "T_MIXED_PRECISION_FP"},
+      OpSchema::Optional);
+
+  op_schema
+      .Output(
+          0,
+          "new_update_count",
+          "New update count.",
+          "T2");
+
+  AddRepeatedOutputs(
+      op_schema,
+      1,
+      1024,
+      {"new_weights",
+       "new_gradients",
+       "new_moment_1",
+       "new_moment_2",
+       "new_mixed_precision_weights"},
+      {"New weights",
+       "New gradients",
+       "New averaged gradients",
+       "New averaged squared gradients",
+       "New FP16 or BF16 weights"},
+      {"T3",
+       "T_GRAD",
+       "T4",
+       "T4",
+       "T_MIXED_PRECISION_FP"},
+      OpSchema::Optional);
+
+  return op_schema;
+}
+
 void RegisterTrainingOpSchemas() {
   ONNX_CONTRIB_OPERATOR_SCHEMA(ReluGrad)
       .SetDomain(kMSDomain)
@@ -769,6 +946,8 @@ void RegisterTrainingOpSchemas() {
 
   ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(LambOptimizer, RegisterLambOpSchema);
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(FusedAdamOptimizer, RegisterFusedAdamOpSchema);
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(InPlaceAccumulator)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -991,6 +1170,11 @@ Example 4:
             "4 - horozontal parallel, 5 - model parallel.",
             AttributeProto::INT,
             static_cast<int64_t>(0))
+      .Attr("hierarchical",
+            "If 1, reduce-scatter within the node, all-reduce the shards across nodes and all-gather within the node. "
+            "Falls back to a single all-reduce if the group does not span several nodes with several ranks each.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "tensors to be reduced", "T", OpSchema::Variadic)
       .Output(0, "output", "reduced tensors", "T", OpSchema::Variadic)
       .TypeConstraint(
@@ -1655,6 +1839,44 @@ Example 4:
         propagateElemTypeFromAttributeToOutput(ctx, "to", 0);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GistPackBf16Encoder)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Input(0, "X", "uncompressed input", "T")
+      .Output(0, "Y", "compressed output", "T1")
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain to all numeric tensors.")
+      .TypeConstraint(
+          "T1",
+          {"tensor(bfloat16)"},
+          "16 bits compressed tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::BFLOAT16);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GistPackBf16Decoder)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Input(0, "X", "compressed input", "T1")
+      .Output(0, "Y", "uncompressed output", "T")
+      .Attr("to",
+            "The data type to which the elements of the input tensor are cast. "
+            "Strictly must be one of the types from DataType enum in TensorProto",
+            AttributeProto::INT)
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain to all numeric tensors.")
+      .TypeConstraint(
+          "T1",
+          {"tensor(bfloat16)"},
+          "16 bits compressed tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromAttributeToOutput(ctx, "to", 0);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(GistPackMsfp15Encoder)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
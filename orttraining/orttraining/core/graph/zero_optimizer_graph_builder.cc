@@ -432,17 +432,19 @@ ZeROOptimizerGraphBuilder::ZeROOptimizerGraphBuilder(
   ORT_ENFORCE(opt_graph_config.data_parallel_group_size > 1, "ZeRO optimizer graph builder can only be used for distributed training.");
   ORT_ENFORCE(opt_graph_config.use_nccl, "Distributed training with ZeRO is only supported with NCCL.");
   ORT_ENFORCE(IsNcclAvailable(), "Distributed training with NCCL is not supported, as NCCL is not enabled in this build.");
+  ORT_ENFORCE(opt_graph_config.deepspeed_zero.stage <= 2, "ZeRO stage ", opt_graph_config.deepspeed_zero.stage,
+              " is not supported. Supported stages are 0, 1 and 2.");
 }
 
-Status ZeROOptimizerGraphBuilder::BuildInternal(
-    bool should_add_gradient_norm,
-    bool should_add_gradient_finite_check,
+bool ZeROOptimizerGraphBuilder::ShouldPartitionGradients() const {
+  return opt_graph_config_.deepspeed_zero.stage >= 2 && opt_graph_config_.gradient_accumulation_steps > 1;
+}
+
+Status ZeROOptimizerGraphBuilder::AddGradientReduceScatter(
     Graph& graph,
     GraphAugmenter::GraphDefs& graph_defs,
     std::vector<ArgDef>& weight_argdefs,
-    std::vector<ArgDef>& gradient_argdefs,
-    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& optimizer_state_initializer_names,
-    OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) {
+    std::vector<ArgDef>& gradient_argdefs) {
   auto nodearg_name_generator = [&graph](const std::string& base_name) {
     return graph.GenerateNodeArgName(base_name);
   };
@@ -460,7 +462,56 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
                                               opt_graph_config_.AllReduceDataType(), false));
 
   // add Reducescatter for gradients
-  ORT_RETURN_IF_ERROR(AddNcclReduceScatterForGradients(gradient_argdefs, graph_defs));
+  return AddNcclReduceScatterForGradients(gradient_argdefs, graph_defs);
+}
+
+Status ZeROOptimizerGraphBuilder::AddGradientAccumulation(
+    Graph& graph,
+    GraphAugmenter::GraphDefs& graph_defs,
+    std::vector<ArgDef>& weight_argdefs,
+    std::vector<ArgDef>& gradient_argdefs,
+    std::vector<ArgDef>& gradient_accumulation_buffers,
+    OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) {
+  if (!ShouldPartitionGradients()) {
+    return OptimizerGraphBuilder::AddGradientAccumulation(
+        graph, graph_defs, weight_argdefs, gradient_argdefs, gradient_accumulation_buffers, optimizer_graph_outputs);
+  }
+
+  // Reduce-scatter the gradients of every step, so the accumulation buffers only
+  // hold the partition updated by this rank instead of a copy of all gradients.
+  ORT_RETURN_IF_ERROR(AddGradientReduceScatter(graph, graph_defs, weight_argdefs, gradient_argdefs));
+
+  std::vector<ArgDef> partition_gradient_argdefs = GetGradientNormInputs(gradient_argdefs, opt_configs_);
+  ORT_RETURN_IF_ERROR(OptimizerGraphBuilder::AddGradientAccumulation(
+      graph, graph_defs, weight_argdefs, partition_gradient_argdefs, gradient_accumulation_buffers, optimizer_graph_outputs));
+
+  // the gradients of the partitions of the other ranks are passed through to the disabled optimizers
+  for (size_t i = 0, partition_index = 0; i < gradient_argdefs.size(); i++) {
+    if (opt_configs_[i].enabled) {
+      gradient_argdefs[i] = partition_gradient_argdefs[partition_index++];
+    }
+  }
+
+  return Status::OK();
+}
+
+Status ZeROOptimizerGraphBuilder::BuildInternal(
+    bool should_add_gradient_norm,
+    bool should_add_gradient_finite_check,
+    Graph& graph,
+    GraphAugmenter::GraphDefs& graph_defs,
+    std::vector<ArgDef>& weight_argdefs,
+    std::vector<ArgDef>& gradient_argdefs,
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& optimizer_state_initializer_names,
+    OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) {
+  auto nodearg_name_generator = [&graph](const std::string& base_name) {
+    return graph.GenerateNodeArgName(base_name);
+  };
+
+  // in ZeRO stage 2 the gradients were already reduce-scattered before the accumulation
+  if (!ShouldPartitionGradients()) {
+    ORT_RETURN_IF_ERROR(AddGradientReduceScatter(graph, graph_defs, weight_argdefs, gradient_argdefs));
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
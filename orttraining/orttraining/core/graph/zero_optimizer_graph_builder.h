@@ -27,6 +27,26 @@ class ZeROOptimizerGraphBuilder : public OptimizerGraphBuilder {
       std::vector<ArgDef>& gradient_argdefs,
       std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& optimizer_state_initializer_names,
       OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) override;
+
+  virtual Status AddGradientAccumulation(
+      Graph& graph,
+      GraphAugmenter::GraphDefs& graph_defs,
+      std::vector<ArgDef>& weight_argdefs,
+      std::vector<ArgDef>& gradient_argdefs,
+      std::vector<ArgDef>& gradient_accumulation_buffers,
+      OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) override;
+
+ private:
+  // Partitions the parameters between the ranks and reduce-scatters the scaled gradients.
+  Status AddGradientReduceScatter(
+      Graph& graph,
+      GraphAugmenter::GraphDefs& graph_defs,
+      std::vector<ArgDef>& weight_argdefs,
+      std::vector<ArgDef>& gradient_argdefs);
+
+  // In ZeRO stage 2 the gradients of each step are reduce-scattered before they
+  // are accumulated, so only the partition owned by this rank is accumulated.
+  bool ShouldPartitionGradients() const;
 };
 
  /**
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "core/common/logging/logging.h"
 #include "core/graph/op.h"
 #include "core/optimizer/rewrite_rule.h"
@@ -37,6 +40,27 @@ struct GraphEdgeHelper {
   }
 };
 
+// nodes of the forward pass, excluding GIST and recompute nodes
+static bool IsForwardNode(const Node& node) {
+  const std::string& description = node.Description();
+  return description != "Backward pass" && description != "Encode" && description != "Decode" &&
+         description.compare(0, 13, "Recompute of ") != 0;
+}
+
+// whether a kernel of the compression type exists for the uncompressed element type
+static bool IsCompressionTypeSupported(const std::string& compression_type, int32_t element_type) {
+  static const std::unordered_map<std::string, std::unordered_set<int32_t>> supported_element_types{
+      {"GistBinarize", {ONNX_NAMESPACE::TensorProto_DataType_FLOAT, ONNX_NAMESPACE::TensorProto_DataType_FLOAT16,
+                        ONNX_NAMESPACE::TensorProto_DataType_DOUBLE}},
+      {"GistPack1", {ONNX_NAMESPACE::TensorProto_DataType_BOOL, ONNX_NAMESPACE::TensorProto_DataType_FLOAT}},
+      {"GistPack8", {ONNX_NAMESPACE::TensorProto_DataType_FLOAT, ONNX_NAMESPACE::TensorProto_DataType_FLOAT16}},
+      {"GistPack16", {ONNX_NAMESPACE::TensorProto_DataType_FLOAT}},
+      {"GistPackBf16", {ONNX_NAMESPACE::TensorProto_DataType_FLOAT}},
+      {"GistPackMsfp15", {ONNX_NAMESPACE::TensorProto_DataType_FLOAT}}};
+  const auto it = supported_element_types.find(compression_type);
+  return it != supported_element_types.end() && it->second.count(element_type) != 0;
+}
+
 static std::vector<GraphEdgeHelper> GetNodeOutputEdges(const Node& node) {
   std::vector<GraphEdgeHelper> output_edges;
   for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
@@ -53,7 +77,11 @@ bool GistEncodeDecode::AddEncodeDecode(Graph& graph, Node& curr_node, std::strin
 
   // Collect output tensors for compression + destination nodes + destination nodes' input edge
   std::vector<GraphEdgeHelper> output_edges = GetNodeOutputEdges(curr_node);
-  vector_t lookup_vec = PATTERN_MAP.at(curr_node.OpType());
+  const bool all_activations = operator_type == GIST_ALL_ACTIVATIONS;
+  const auto pattern_it = PATTERN_MAP.find(curr_node.OpType());
+  if (!all_activations && pattern_it == PATTERN_MAP.end()) {
+    return false;
+  }
 
   typedef int src_arg_idx;
   typedef int dst_arg_idx;
@@ -61,10 +89,13 @@ bool GistEncodeDecode::AddEncodeDecode(Graph& graph, Node& curr_node, std::strin
   std::unordered_map<src_arg_idx, std::vector<decode_pair>> decode_map;
   for (auto& output_edge : output_edges) {
     Node* node_dst = graph.GetNode(output_edge.dst_node);
-    for (auto& lookup_OpType : lookup_vec) {
-      if (node_dst->Description() == "Backward pass" && node_dst->OpType() == lookup_OpType) {
-        decode_map[output_edge.src_arg_index].push_back(decode_pair(node_dst, output_edge.dst_arg_index));
-      }
+    if (node_dst->Description() != "Backward pass") {
+      continue;
+    }
+    // all the backward consumers of an activation are decoded when GIST applies to all activations
+    if (all_activations ||
+        std::find(pattern_it->second.begin(), pattern_it->second.end(), node_dst->OpType()) != pattern_it->second.end()) {
+      decode_map[output_edge.src_arg_index].push_back(decode_pair(node_dst, output_edge.dst_arg_index));
     }
   }
 
@@ -73,11 +104,16 @@ bool GistEncodeDecode::AddEncodeDecode(Graph& graph, Node& curr_node, std::strin
   }
 
   std::string user_compression_type = compression_type;
+  bool modified = false;
 
   // Each element in map corresponds to a stash activation
   for (auto& st_act : decode_map) {
     // Create compressed tensor
     NodeArg* curr_node_output_arg = curr_node.MutableOutputDefs()[st_act.first];
+    if (curr_node_output_arg->TypeAsProto() == nullptr || curr_node_output_arg->Shape() == nullptr) {
+      continue;
+    }
+    const int32_t element_type = curr_node_output_arg->TypeAsProto()->tensor_type().elem_type();
     ONNX_NAMESPACE::TypeProto compressed_tensor;
     compression_type = user_compression_type;
 
@@ -86,12 +122,22 @@ bool GistEncodeDecode::AddEncodeDecode(Graph& graph, Node& curr_node, std::strin
     if (*type_string == "bool" || *type_string == "tensor(bool)") {
       LOGS(logger, INFO) << "(Lossless) override compression type to Pack1 for tensor: " << curr_node_output_arg->Name();
       compression_type = "GistPack1";
+    } else if (compression_type == GIST_AUTO_COMPRESSION) {
+      compression_type = ChooseCompressionType(curr_node, element_type, st_act.second);
+    }
+
+    if (!IsCompressionTypeSupported(compression_type, element_type)) {
+      LOGS(logger, VERBOSE) << "Gist skipped for tensor: " << curr_node_output_arg->Name()
+                            << ", compression type " << compression_type << " does not support its element type";
+      continue;
     }
 
     if (compression_type == "GistPack1" || compression_type == "GistPack8" || compression_type == "GistPackMsfp15") {
       compressed_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_UINT8);
     } else if (compression_type == "GistPack16") {
       compressed_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+    } else if (compression_type == "GistPackBf16") {
+      compressed_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16);
     } else if (compression_type == "GistBinarize") {
       compressed_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
     } else {
@@ -131,7 +177,6 @@ bool GistEncodeDecode::AddEncodeDecode(Graph& graph, Node& curr_node, std::strin
     ONNX_NAMESPACE::AttributeProto output_type;
     output_type.set_name("to");
     output_type.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType::AttributeProto_AttributeType_INT);
-    auto element_type = curr_node_output_arg->TypeAsProto()->tensor_type().elem_type();
     output_type.set_i(static_cast<int64_t>(element_type));
 
     const int num_attributes = 1;  // one attribute: decoder's output data type
@@ -146,9 +191,31 @@ bool GistEncodeDecode::AddEncodeDecode(Graph& graph, Node& curr_node, std::strin
     for (auto& dest_pair : st_act.second) {
       graph.AddEdge(decode.Index(), dest_pair.first->Index(), 0, dest_pair.second);
     }
+    modified = true;
+  }
+
+  return modified;
+}
+
+// GistAuto policy: a ReLU output only read through its sign by ReluGrad is binarized, which is lossless,
+// and other float activations are stashed as bf16, which keeps the float range.
+std::string GistEncodeDecode::ChooseCompressionType(const Node& curr_node, int32_t element_type,
+                                                    const std::vector<std::pair<Node*, int>>& decode_pairs) const {
+  const bool relu_grad_only =
+      curr_node.OpType() == "Relu" &&
+      std::all_of(decode_pairs.begin(), decode_pairs.end(),
+                  [](const std::pair<Node*, int>& decode_pair) {
+                    return decode_pair.first->OpType() == "ReluGrad" && decode_pair.second == 1;
+                  });
+  if (relu_grad_only) {
+    return "GistBinarize";
+  }
+
+  if (element_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return "GistPackBf16";
   }
 
-  return true;
+  return "";
 }
 
 std::vector<std::string> GistEncodeDecode::TargetOpTypes() const noexcept {
@@ -180,6 +247,10 @@ std::vector<std::string> GistEncodeDecode::TargetOpTypes() const noexcept {
     case 9:
       return {"Softmax", "Transpose", "Reshape", "Add", "Dropout", "LayerNormalization", "MatMul", "Relu"};
       break;
+    case GIST_ALL_ACTIVATIONS:
+      // any operator type
+      return {};
+      break;
     default:
       return {};
       break;
@@ -187,7 +258,7 @@ std::vector<std::string> GistEncodeDecode::TargetOpTypes() const noexcept {
 }
 
 Status GistEncodeDecode::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const {
-  if (node.Description() != "Backward pass") {
+  if (IsForwardNode(node)) {
     if (GistEncodeDecode::AddEncodeDecode(graph, node, compression_type_, logger)) {
       LOGS(logger, INFO) << "Gist applied to node name -  " << node.Name() << ", node type - "
                          << node.OpType() << ", of compr type - " << compression_type_;
@@ -18,6 +18,12 @@ class GistEncodeDecode : public RewriteRule {
 
   static constexpr int GIST_PACK1_FACTOR = 8;
 
+  // operator type value applying GIST to every activation stashed for the backward pass
+  static constexpr int GIST_ALL_ACTIVATIONS = 10;
+
+  // compression type choosing the compression of each stashed activation, see ChooseCompressionType()
+  static constexpr const char* GIST_AUTO_COMPRESSION = "GistAuto";
+
   mutable int priority_generator_ = INT32_MAX;
 
   // map stores GIST signature - source operator type to destination operator type(s)
@@ -41,6 +47,8 @@ class GistEncodeDecode : public RewriteRule {
   bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
   Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
   bool AddEncodeDecode(Graph& graph, Node& curr_node, std::string compression_type, const logging::Logger& logger) const;
+  std::string ChooseCompressionType(const Node& curr_node, int32_t element_type,
+                                    const std::vector<std::pair<Node*, int>>& decode_pairs) const;
 
   const std::string compression_type_;
 };
@@ -49,6 +49,7 @@
 #include "orttraining/core/optimizer/concat_replacement.h"
 #include "orttraining/core/optimizer/insert_output_rewriter.h"
 #include "orttraining/core/optimizer/localized_recompute.h"
+#include "orttraining/core/optimizer/memory_budget_recompute.h"
 #include "orttraining/core/optimizer/transformer_layer_recompute.h"
 
 namespace onnxruntime {
@@ -118,6 +119,11 @@ std::vector<std::unique_ptr<GraphTransformer>> GeneratePreTrainingTransformers(
         transformers.emplace_back(std::make_unique<TransformerLayerRecompute>(
             config.number_recompute_layers, compatible_eps));
       }
+      if (config.recompute_memory_budget_in_bytes > 0) {
+        // runs after the pattern based recomputes, and only adds to what they recompute
+        transformers.emplace_back(std::make_unique<MemoryBudgetRecompute>(
+            config.recompute_memory_budget_in_bytes, compatible_eps));
+      }
       if (config.propagate_cast_ops_level >= 0) {
         std::unordered_set<std::string> cuda_execution_provider = {onnxruntime::kCudaExecutionProvider};
         transformers.emplace_back(std::make_unique<PropagateCastOps>(static_cast<size_t>(config.propagate_cast_ops_level),
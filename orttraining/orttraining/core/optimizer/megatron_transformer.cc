@@ -3,6 +3,7 @@
 
 #include "core/optimizer/initializer.h"
 #include "orttraining/core/framework/distributed_run_context.h"
+#include "orttraining/core/framework/communication/mpi/mpi_context.h"
 #include "orttraining/core/graph/optimizer_builder.h"
 #include "orttraining/core/optimizer/megatron_transformer.h"
 #include "core/graph/graph_utils.h"
@@ -1402,4 +1403,33 @@ Status MegatronTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_le
   return Status::OK();
 }
 
+std::unique_ptr<GraphTransformer> CreateMegatronInferenceTransformer(int32_t tensor_parallel_size,
+                                                                     const IExecutionProvider& cpu_execution_provider) {
+  const auto& mpi_context = training::MPIContext::GetInstance();
+  const int32_t world_size = mpi_context.GetWorldSize();
+  ORT_ENFORCE(tensor_parallel_size > 0 && world_size % tensor_parallel_size == 0,
+              "The tensor parallel size ", tensor_parallel_size, " must divide the number of MPI ranks ", world_size);
+
+  // the first call creates the context, later calls get the one this process created
+  training::DistributedRunConfig config;
+  config.world_rank = mpi_context.GetWorldRank();
+  config.world_size = world_size;
+  config.local_rank = mpi_context.GetLocalRank();
+  config.local_size = mpi_context.GetLocalSize();
+  config.data_parallel_size = world_size / tensor_parallel_size;
+  config.horizontal_parallel_size = tensor_parallel_size;
+  training::DistributedRunContext::CreateInstance(config);
+
+  const int32_t horizontal_parallel_size =
+      training::DistributedRunContext::GroupSize(training::WorkerGroupType::HorizontalParallel);
+  ORT_ENFORCE(horizontal_parallel_size == tensor_parallel_size,
+              "The distributed run context of this process has a horizontal parallel size of ",
+              horizontal_parallel_size, ", which differs from the tensor parallel size ", tensor_parallel_size);
+
+  LOGS_DEFAULT(INFO) << tensor_parallel_size << "-way tensor parallel inference is enabled";
+  return std::make_unique<MegatronTransformer>(
+      training::DistributedRunContext::RankInGroup(training::WorkerGroupType::HorizontalParallel),
+      tensor_parallel_size, cpu_execution_provider);
+}
+
 }  // namespace onnxruntime
\ No newline at end of file
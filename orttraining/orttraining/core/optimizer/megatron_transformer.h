@@ -27,6 +27,20 @@ class MegatronTransformer : public GraphTransformer {
         initial_optimizer_states_(initial_optimizer_states),
         cpu_execution_provider_ (cpu_execution_provider ) {}
 
+  // Partition the weights of an inference graph, which has no weights to train or optimizer states to update.
+  MegatronTransformer(int32_t horizontal_parallel_rank, int32_t horizontal_parallel_size,
+                      const IExecutionProvider& cpu_execution_provider,
+                      const std::unordered_set<std::string>& compatible_execution_providers = {})
+      : GraphTransformer("MegatronTransformer", compatible_execution_providers),
+        inference_state_(std::make_unique<InferenceState>()),
+        horizontal_parallel_rank_(horizontal_parallel_rank),
+        horizontal_parallel_size_(horizontal_parallel_size),
+        updated_weight_names_(inference_state_->updated_weight_names),
+        weights_to_train_(inference_state_->weights_to_train),
+        weight_partition_info_(inference_state_->weight_partition_info),
+        initial_optimizer_states_(inference_state_->initial_optimizer_states),
+        cpu_execution_provider_(cpu_execution_provider) {}
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level,
                    const logging::Logger& logger) const override;
 
@@ -82,6 +96,15 @@ class MegatronTransformer : public GraphTransformer {
   bool PartitionWeightByRow(const Graph& graph, const NodeArg& input_arg,
                             ONNX_NAMESPACE::TensorProto& initializer_partition) const;
 
+  // the bookkeeping of the partitioned weights when there is no training session to report it to
+  struct InferenceState {
+    std::unordered_map<std::string, std::string> updated_weight_names;
+    std::unordered_set<std::string> weights_to_train;
+    std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+    training::TrainingSession::OptimizerState initial_optimizer_states;
+  };
+  std::unique_ptr<InferenceState> inference_state_;
+
   const int32_t horizontal_parallel_rank_;
   const int32_t horizontal_parallel_size_;
   std::unordered_map<std::string, std::string>& updated_weight_names_;
@@ -91,4 +114,12 @@ class MegatronTransformer : public GraphTransformer {
   const IExecutionProvider& cpu_execution_provider_ ;
 };
 
+/**
+  Create the MegatronTransformer that partitions the weights of an inference graph across the tensor_parallel_size
+  ranks of the horizontal parallel group of this process, one rank per GPU. The distributed run context is created
+  from the MPI world if this process has not created it yet.
+*/
+std::unique_ptr<GraphTransformer> CreateMegatronInferenceTransformer(int32_t tensor_parallel_size,
+                                                                     const IExecutionProvider& cpu_execution_provider);
+
 }  // namespace onnxruntime
\ No newline at end of file
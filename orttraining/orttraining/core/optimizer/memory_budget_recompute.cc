@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/core/optimizer/memory_budget_recompute.h"
+
+#include <algorithm>
+
+#include "core/framework/data_types.h"
+#include "core/graph/graph_utils.h"
+#include "orttraining/core/graph/recompute_graph_utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool TryGetTensorBytes(const NodeArg& arg, int64_t& bytes) {
+  const auto* type = arg.TypeAsProto();
+  const auto* shape = arg.Shape();
+  if (type == nullptr || shape == nullptr || !type->has_tensor_type() ||
+      type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+    return false;
+  }
+
+  int64_t count = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value() || dim.dim_value() < 0) {
+      return false;
+    }
+    count *= dim.dim_value();
+  }
+
+  bytes = count * static_cast<int64_t>(
+                      DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType()->Size());
+  return true;
+}
+
+// Returns the total size of the defs, or false if the size of any existing def is not known.
+bool TryGetTotalBytes(const ConstPointerContainer<std::vector<NodeArg*>>& defs, int64_t& total_bytes) {
+  total_bytes = 0;
+  for (const auto* def : defs) {
+    if (!def->Exists()) {
+      continue;
+    }
+
+    int64_t bytes;
+    if (!TryGetTensorBytes(*def, bytes)) {
+      return false;
+    }
+    total_bytes += bytes;
+  }
+  return true;
+}
+
+// Deterministic nodes that are cheap to run again compared to the size of their outputs.
+// Dropout is not included as the recompute has to reuse its mask, see AttentionDropoutRecompute.
+bool IsRecomputable(const Node& node) {
+  static const std::unordered_set<std::string> recomputable_ops{
+      "Add", "Sub", "Mul", "Div", "Cast", "Relu", "LeakyRelu", "Sigmoid", "Tanh", "Erf", "Sqrt",
+      "Gelu", "FastGelu", "BiasGelu", "Softmax", "LayerNormalization", "SimplifiedLayerNormalization"};
+  return recomputable_ops.count(node.OpType()) != 0 && !node.ContainsSubgraph();
+}
+
+struct RecomputeCandidate {
+  const Node* node;
+  // the size of the outputs that are no longer kept for the backward pass
+  int64_t saved_bytes;
+  // the bytes read and written by the recompute
+  int64_t cost_bytes;
+};
+
+}  // namespace
+
+Status MemoryBudgetRecompute::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                        const logging::Logger& logger) const {
+  if (memory_budget_in_bytes_ <= 0) {
+    return Status::OK();
+  }
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_ids = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_set<const NodeArg*> graph_outputs(graph.GetOutputs().begin(), graph.GetOutputs().end());
+
+  int64_t activation_bytes = 0;
+  std::vector<RecomputeCandidate> candidates;
+  for (auto node_index : node_ids) {
+    const Node& node = *graph.GetNode(node_index);
+
+    int64_t output_bytes = 0;
+    bool is_candidate = IsRecomputable(node);
+    for (const auto* output : node.OutputDefs()) {
+      if (!output->Exists()) {
+        continue;
+      }
+
+      // graph outputs are always kept, and outputs with a recompute are not kept for the backward pass
+      if (graph_outputs.count(output) != 0 ||
+          graph.GetNodeArg(graph_utils::RecomputeName(output->Name())) != nullptr) {
+        is_candidate = false;
+        continue;
+      }
+
+      int64_t bytes;
+      if (!TryGetTensorBytes(*output, bytes)) {
+        is_candidate = false;
+        continue;
+      }
+      output_bytes += bytes;
+    }
+
+    activation_bytes += output_bytes;
+
+    int64_t input_bytes;
+    if (is_candidate && output_bytes > 0 && TryGetTotalBytes(node.InputDefs(), input_bytes)) {
+      candidates.push_back({&node, output_bytes, input_bytes + output_bytes});
+    }
+  }
+
+  if (activation_bytes <= memory_budget_in_bytes_) {
+    LOGS(logger, INFO) << "Activations of " << activation_bytes << " bytes fit in the recompute memory budget of "
+                       << memory_budget_in_bytes_ << " bytes.";
+    return Status::OK();
+  }
+
+  // recompute the activations with the lowest cost per saved byte first
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const RecomputeCandidate& a, const RecomputeCandidate& b) {
+                     return static_cast<double>(a.cost_bytes) / a.saved_bytes <
+                            static_cast<double>(b.cost_bytes) / b.saved_bytes;
+                   });
+
+  std::unordered_set<const Node*> recomputed_nodes;
+  for (const auto& candidate : candidates) {
+    if (activation_bytes <= memory_budget_in_bytes_) {
+      break;
+    }
+    recomputed_nodes.insert(candidate.node);
+    activation_bytes -= candidate.saved_bytes;
+  }
+
+  if (activation_bytes > memory_budget_in_bytes_) {
+    LOGS(logger, WARNING) << "Activations of " << activation_bytes << " bytes are left after recomputing "
+                          << recomputed_nodes.size() << " nodes, which exceeds the recompute memory budget of "
+                          << memory_budget_in_bytes_ << " bytes.";
+  }
+
+  // add the recompute nodes in topological order, chaining recomputed inputs
+  for (auto node_index : node_ids) {
+    Node& node = *graph.GetNode(node_index);
+    if (recomputed_nodes.count(&node) == 0) {
+      continue;
+    }
+
+    std::vector<NodeArg*> recomputed_inputs;
+    for (NodeArg* input : node.MutableInputDefs()) {
+      const Node* producer = input->Exists() ? graph.GetProducerNode(input->Name()) : nullptr;
+      if (producer != nullptr && recomputed_nodes.count(producer) != 0) {
+        recomputed_inputs.push_back(&graph.GetOrCreateNodeArg(graph_utils::RecomputeName(input->Name()),
+                                                              input->TypeAsProto()));
+      } else {
+        recomputed_inputs.push_back(input);
+      }
+    }
+
+    std::vector<NodeArg*> recomputed_outputs;
+    for (NodeArg* output : node.MutableOutputDefs()) {
+      if (!output->Exists()) {
+        recomputed_outputs.push_back(output);
+        continue;
+      }
+      recomputed_outputs.push_back(&graph.GetOrCreateNodeArg(graph_utils::RecomputeName(output->Name()),
+                                                             output->TypeAsProto()));
+    }
+
+    Node& recompute_node = graph.AddNode(node.Name() + "_recompute",
+                                         node.OpType(),
+                                         "Recompute of " + node.Name(),
+                                         recomputed_inputs,
+                                         recomputed_outputs,
+                                         &node.GetAttributes(),
+                                         node.Domain());
+    recompute_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+  }
+
+  LOGS(logger, INFO) << "Recomputing " << recomputed_nodes.size() << " nodes to fit the activations in the "
+                     << "recompute memory budget of " << memory_budget_in_bytes_ << " bytes.";
+
+  modified = !recomputed_nodes.empty();
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
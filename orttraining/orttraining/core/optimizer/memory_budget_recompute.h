@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MemoryBudgetRecompute
+
+Recompute the cheapest activations until the activations kept for the backward pass fit in a memory budget.
+
+Every output of a forward node is assumed to be kept until the backward pass. Outputs of cheap, deterministic nodes
+are candidates for recompute. The candidates are chosen greedily by recompute cost (bytes read and written) per byte
+saved, until the size of the remaining activations is within the budget. Activations without a static shape are
+neither counted nor recomputed.
+
+*/
+class MemoryBudgetRecompute : public GraphTransformer {
+ public:
+  MemoryBudgetRecompute(int64_t memory_budget_in_bytes,
+                        const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MemoryBudgetRecompute", compatible_execution_providers),
+        memory_budget_in_bytes_(memory_budget_in_bytes) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  int64_t memory_budget_in_bytes_;
+};
+
+}  // namespace onnxruntime
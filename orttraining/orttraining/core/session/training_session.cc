@@ -124,6 +124,8 @@ Status SetupOptimizerParams(
   opt_graph_config.gradient_accumulation_steps = config.gradient_accumulation_steps;
   opt_graph_config.allreduce_in_mixed_precision_type = optimizer_config.do_all_reduce_in_mixed_precision_type;
   opt_graph_config.use_nccl = optimizer_config.use_nccl;
+  opt_graph_config.allreduce_bucket_size_in_bytes = optimizer_config.allreduce_bucket_size_in_bytes;
+  opt_graph_config.use_hierarchical_allreduce = optimizer_config.use_hierarchical_allreduce;
   opt_graph_config.adasum_reduction_type = optimizer_config.adasum_reduction_type;
   opt_graph_config.enable_grad_norm_clip = optimizer_config.enable_grad_norm_clip;
   opt_graph_config.deepspeed_zero = optimizer_config.deepspeed_zero;
@@ -1507,6 +1509,7 @@ Status PipelineTrainingSession::SetExtraDataDependency() {
   // event and communication operations.
   for (auto& node : model_->MainGraph().Nodes()) {
     if (node.OpType().compare("AdamOptimizer") == 0 ||
+        node.OpType().compare("FusedAdamOptimizer") == 0 ||
         node.OpType().compare("LambOptimizer") == 0 ||
         node.OpType().compare("SGDOptimizer") == 0) {
       SetDataDependency(graph, node, dependent_node_args);
@@ -1606,7 +1609,8 @@ Status PipelineTrainingSession::SetEventSynchronization(
   const int num_pipeline_stages = distributed_config.value().pipeline_parallel_size;
   pipeline_schedule_ = pipeline::PipelineScheduler(num_pipeline_micro_batches,
                                                    num_pipeline_stages,
-                                                   DistributedRunContext::GetRanks(WorkerGroupType::PipelineParallel));
+                                                   DistributedRunContext::GetRanks(WorkerGroupType::PipelineParallel),
+                                                   pipeline_config.value().schedule_type);
   pipeline_worker_pool_ = pipeline::PipelineWorkerPool(num_pipeline_stages);
 
   // Insert PipelineOps may access "sliced_schema" from "pipeline_context_".
@@ -144,9 +144,11 @@ class TrainingSession : public InferenceSession {
 
     struct GistConfiguration {
       // The operator type to which GIST is applied. Valid Values - 1 (Softmax), 2 (Transpose), 3 (Reshape),
-      // 4 (Add), 5 (Dropout), 6 (LayerNormalization), 7 (MatMul), 8 (Relu), 9 (All the above)
+      // 4 (Add), 5 (Dropout), 6 (LayerNormalization), 7 (MatMul), 8 (Relu), 9 (All the above),
+      // 10 (Any activation stashed for the backward pass)
       int op_type{};
-      // The compression type used for GIST. Valid values - GistBinarize, GistPack1, GistPack8, GistPack16, GistPackMsfp15
+      // The compression type used for GIST. Valid values - GistBinarize, GistPack1, GistPack8, GistPack16,
+      // GistPackBf16, GistPackMsfp15, GistAuto (chosen per activation)
       std::string compr_type{};
     };
     // The GIST configuration.
@@ -185,6 +187,11 @@ class TrainingSession : public InferenceSession {
       bool do_all_reduce_in_mixed_precision_type{};
       // Whether to use NCCL.
       bool use_nccl{};
+      // The size in bytes of the gradient buckets of the NCCL AllReduce, 0 means a single bucket.
+      int64_t allreduce_bucket_size_in_bytes{};
+      // Whether the NCCL AllReduce is hierarchical: reduce-scatter within the node, all-reduce across nodes,
+      // then all-gather within the node.
+      bool use_hierarchical_allreduce{};
       // Whether to partition the optimizer state.
       ZeROConfig deepspeed_zero{};
       // Selects the reduction algorithm for Adasum.
@@ -241,6 +248,10 @@ class TrainingSession : public InferenceSession {
 
       // The base path at which to save the intermediate partitioned input model (forward pass only).
       optional<PathString> partitioned_model_path{};
+
+      // How the micro-batches are scheduled on the pipeline stages. OneForwardOneBackward bounds the activations
+      // held by each stage to the number of stages after it.
+      pipeline::PipelineScheduleType schedule_type{pipeline::PipelineScheduleType::Greedy};
     };
 
     // If pipeline is enabled, this field's has_value() returns true.
@@ -258,6 +269,9 @@ class TrainingSession : public InferenceSession {
       bool transformer_layer_recompute{false};
       // Number of layers to apply recompute
       int number_recompute_layers{0};
+      // Memory budget in bytes for the activations kept for the backward pass.
+      // The cheapest activations are recomputed until they fit, 0 disables it.
+      int64_t recompute_memory_budget_in_bytes{0};
       // Propagate FP16 Cast operations up and FP32 operations down
       int propagate_cast_ops_level{-1};
       std::vector<std::string> propagate_cast_ops_allow;
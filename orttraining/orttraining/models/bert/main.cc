@@ -128,6 +128,10 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("checkpoint_period", "How many weight-update steps to run before saving a model checkpoint.", cxxopts::value<size_t>()->default_value("1000"))
       ("max_num_checkpoints", "Maximum number of checkpoint files to maintain.",
         cxxopts::value<size_t>()->default_value("10"))
+      ("async_checkpoint", "Whether to write checkpoint files in the background while training continues.",
+        cxxopts::value<bool>()->default_value("false"))
+      ("checkpoint_num_data_files", "The number of tensor data files per checkpoint, which are written and read in parallel.",
+        cxxopts::value<size_t>()->default_value("1"))
       ("gradient_accumulation_steps_phase2", "The number of gradient accumulation steps before performing a backward/update pass in phase 2.",
         cxxopts::value<int>()->default_value("1"))
       ("iterations_per_loop", "How many steps to make in each estimator call.", cxxopts::value<int>()->default_value("1000"))
@@ -145,6 +149,10 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("use_fp16_initializer", "FP16 weights will be created. Otherwise, cast nodes will be inserted for converting weights from FP32 to FP16",
         cxxopts::value<bool>()->default_value("true"))
       ("use_nccl", "Whether to use NCCL for distributed training.", cxxopts::value<bool>()->default_value("false"))
+      ("allreduce_bucket_size_mb", "The size in MB of the gradient buckets of the NCCL AllReduce. "
+       "0 means all gradients are all-reduced together.", cxxopts::value<int>()->default_value("0"))
+      ("use_hierarchical_allreduce", "Whether the NCCL AllReduce reduce-scatters within the node, all-reduces "
+       "across nodes and all-gathers within the node.", cxxopts::value<bool>()->default_value("false"))
       ("use_profiler", "Collect runtime profile data during this training run.", cxxopts::value<bool>()->default_value("false"))
       ("use_gist", "Whether to use GIST encoding/decoding.")
       ("gist_op", "Opearator type(s) to which GIST is applied.", cxxopts::value<int>()->default_value("0"))
@@ -165,9 +173,10 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("max_predictions_per_seq",
         "Maximum number of masked LM predictions per sequence. "
         "Must match data generation.", cxxopts::value<int>()->default_value("80"))
-      ("optimizer", "Adam or Lamb", cxxopts::value<std::string>()->default_value("Adam"))
+      ("optimizer", "Adam, FusedAdam or Lamb. FusedAdam updates all weights in a single multi-tensor Adam node.", cxxopts::value<std::string>()->default_value("Adam"))
       ("deepspeed_zero_stage", "Controls whether to partition state using the DeepSpeed ZeRO technique. "
-       "Stages 0 (disabled) and 1 (optimizer state partitioning) are supported.",
+       "Stages 0 (disabled), 1 (optimizer state partitioning) and 2 (optimizer state and accumulated gradient "
+       "partitioning) are supported.",
        cxxopts::value<int>()->default_value("0"))
       ("alpha", "Adam/Lamb alpha parameter", cxxopts::value<float>()->default_value("0.9"))
       ("beta", "Adam/Lamb beta parameter", cxxopts::value<float>()->default_value("0.999"))
@@ -207,6 +216,9 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
         cxxopts::value<bool>()->default_value("false"))
       ("number_recompute_layers", "Number of layers to apply recompute.",
         cxxopts::value<int>()->default_value("0"))
+      ("recompute_memory_budget_mb", "Memory budget in MB for the activations kept for the backward pass. "
+        "The cheapest activations are recomputed until they fit. 0 disables it.",
+        cxxopts::value<int>()->default_value("0"))
       ("use_invertible_layernorm_grad", "Specify whether to use invertible laynorm(dropping the input activation)",
         cxxopts::value<bool>()->default_value("false"))
       ("debug_break", "Specify whether to break at app start, useful for multi-gpu debugging.",
@@ -282,8 +294,12 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
     params.display_loss_steps = flags["display_loss_steps"].as<size_t>();
     params.checkpoint_period = flags["checkpoint_period"].as<size_t>();
     params.max_num_checkpoints = flags["max_num_checkpoints"].as<size_t>();
+    params.async_checkpoint = flags["async_checkpoint"].as<bool>();
+    params.checkpoint_num_data_files = flags["checkpoint_num_data_files"].as<size_t>();
 
     params.use_nccl = flags["use_nccl"].as<bool>();
+    params.allreduce_bucket_size_in_bytes = static_cast<int64_t>(flags["allreduce_bucket_size_mb"].as<int>()) * 1024 * 1024;
+    params.use_hierarchical_allreduce = flags["use_hierarchical_allreduce"].as<bool>();
     params.enable_adasum = flags["enable_adasum"].as<bool>();
     params.use_profiler = flags.count("use_profiler") > 0;
     ort_params.max_num_profiling_events = flags["max_profile_records"].as<size_t>();
@@ -370,10 +386,12 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
     std::string optimizer_name = flags["optimizer"].as<std::string>();
     if (optimizer_name == "adam" || optimizer_name == "Adam") {
       params.training_optimizer_name = "AdamOptimizer";
+    } else if (optimizer_name == "fused_adam" || optimizer_name == "FusedAdam") {
+      params.training_optimizer_name = "FusedAdamOptimizer";
     } else if (optimizer_name == "lamb" || optimizer_name == "Lamb") {
       params.training_optimizer_name = "LambOptimizer";
     } else {
-      return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Incorrect optimizer type: it must be one of [Adam|Lamb]");
+      return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Incorrect optimizer type: it must be one of [Adam|FusedAdam|Lamb]");
     }
 
     params.deepspeed_zero = ZeROConfig(flags["deepspeed_zero_stage"].as<int>());
@@ -507,6 +525,8 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
     params.gelu_recompute = flags["gelu_recompute"].as<bool>();
     params.transformer_layer_recompute = flags["transformer_layer_recompute"].as<bool>();
     params.number_recompute_layers = flags["number_recompute_layers"].as<int>();
+    params.recompute_memory_budget_in_bytes =
+        static_cast<int64_t>(flags["recompute_memory_budget_mb"].as<int>()) * 1024 * 1024;
 
     ort_params.log_severity = static_cast<logging::Severity>(flags["ort_log_severity"].as<int>());
     ORT_RETURN_IF_NOT(
@@ -80,9 +80,10 @@ Status ParseArguments(int argc, char* argv[], GPT2Parameters& params, OrtParamet
         "The maximum total input sequence length after WordPiece tokenization. "
         "Sequences longer than this will be truncated, and sequences shorter "
         "than this will be padded. Must match data generation.", cxxopts::value<int>()->default_value("1024"))
-      ("optimizer", "Adam or Lamb", cxxopts::value<std::string>()->default_value("Adam"))
+      ("optimizer", "Adam, FusedAdam or Lamb. FusedAdam updates all weights in a single multi-tensor Adam node.", cxxopts::value<std::string>()->default_value("Adam"))
       ("deepspeed_zero_stage", "Controls whether to partition state using the DeepSpeed ZeRO technique. "
-       "Stages 0 (disabled) and 1 (optimizer state partitioning) are supported.",
+       "Stages 0 (disabled), 1 (optimizer state partitioning) and 2 (optimizer state and accumulated gradient "
+       "partitioning) are supported.",
        cxxopts::value<int>()->default_value("0"))
       ("alpha", "Adam/Lamb alpha parameter", cxxopts::value<float>()->default_value("0.9"))
       ("beta", "Adam/Lamb beta parameter", cxxopts::value<float>()->default_value("0.999"))
@@ -205,10 +206,12 @@ Status ParseArguments(int argc, char* argv[], GPT2Parameters& params, OrtParamet
     std::string optimizer_name = flags["optimizer"].as<std::string>();
     if (optimizer_name == "adam" || optimizer_name == "Adam") {
       params.training_optimizer_name = "AdamOptimizer";
+    } else if (optimizer_name == "fused_adam" || optimizer_name == "FusedAdam") {
+      params.training_optimizer_name = "FusedAdamOptimizer";
     } else if (optimizer_name == "lamb" || optimizer_name == "Lamb") {
       params.training_optimizer_name = "LambOptimizer";
     } else {
-      return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Incorrect optimizer type: it must be one of [Adam|Lamb]");
+      return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Incorrect optimizer type: it must be one of [Adam|FusedAdam|Lamb]");
     }
 
     params.deepspeed_zero = ZeROConfig(flags["deepspeed_zero_stage"].as<int>());
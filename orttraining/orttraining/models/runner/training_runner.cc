@@ -3,6 +3,7 @@
 
 #include "orttraining/models/runner/training_runner.h"
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <thread>
@@ -144,6 +145,8 @@ Status TrainingRunner::Initialize() {
     opt.use_mixed_precision_moments = params_.use_mixed_precision_moments;
     opt.do_all_reduce_in_mixed_precision_type = params_.allreduce_in_mixed_precision_type;
     opt.use_nccl = params_.use_nccl;
+    opt.allreduce_bucket_size_in_bytes = params_.allreduce_bucket_size_in_bytes;
+    opt.use_hierarchical_allreduce = params_.use_hierarchical_allreduce;
     opt.deepspeed_zero = params_.deepspeed_zero;
     opt.adasum_reduction_type = params_.GetAdasumReductionType();
     opt.enable_grad_norm_clip = params_.enable_grad_norm_clip;
@@ -179,6 +182,7 @@ Status TrainingRunner::Initialize() {
     pipe.cut_list = params_.pipeline_partition_cut_list;
     pipe.op_id_to_stage = params_.op_id_to_stage;
     pipe.partitioned_model_path = params_.pipeline_partitioned_model_path;
+    pipe.schedule_type = params_.pipeline_schedule_type;
     // Do not assign value to config.pipeline_config if pipeline is not used.
     config.pipeline_config = pipe;
   }
@@ -191,6 +195,7 @@ Status TrainingRunner::Initialize() {
     gt_config.gelu_recompute = params_.gelu_recompute;
     gt_config.transformer_layer_recompute = params_.transformer_layer_recompute;
     gt_config.number_recompute_layers = params_.number_recompute_layers;
+    gt_config.recompute_memory_budget_in_bytes = params_.recompute_memory_budget_in_bytes;
 
     config.graph_transformer_config = gt_config;
   }
@@ -221,7 +226,8 @@ Status TrainingRunner::Initialize() {
     pipeline_schedule_ = pipeline::PipelineScheduler(
         params_.gradient_accumulation_steps,
         params_.pipeline_parallel_size,
-        DistributedRunContext::GetRanks(WorkerGroupType::PipelineParallel));
+        DistributedRunContext::GetRanks(WorkerGroupType::PipelineParallel),
+        params_.pipeline_schedule_type);
     pipeline_worker_pool_ = pipeline::PipelineWorkerPool(params_.pipeline_parallel_size);
 
     fetch_names = config_result.pipeline_config_result.value().fetch_names;
@@ -461,7 +467,7 @@ Status TrainingRunner::PrepareFetchNamesAndFetches(const SessionMode mode,
           ORT_RETURN_IF(it == opt_graph_outputs_.end(), "Gradient norm's IsFinite output is missing in the optimizer output");
           fetch_names.push_back(it->second);
         }
-        if (params_.enable_adasum) {
+        if (params_.enable_adasum && !params_.use_bfloat16) {
           auto it = opt_graph_outputs_.find(OptimizerOutputKey::DeltaAllIsFinite);
           ORT_RETURN_IF(it == opt_graph_outputs_.end(), "Adasum delta's IsFinite output is missing in the optimizer output");
           fetch_names.push_back(it->second);
@@ -901,6 +907,8 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
           }
 
           if (should_remove_old_checkpoint) {
+            // the old checkpoint may still be being written
+            ORT_RETURN_IF_ERROR(checkpoint_writer_.Wait());
             const auto status = Env::Default().DeleteFolder(old_checkpoint_path);
             LOGS_DEFAULT_IF(!status.IsOK(), WARNING)
                 << "Failed to delete old checkpoint. "
@@ -922,6 +930,7 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
 
     ++epoch;
   }
+  ORT_RETURN_IF_ERROR(checkpoint_writer_.Wait());
   auto all_steps_time_end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<double> all_steps_duration_seconds = all_steps_time_end - all_steps_time_start;
 
@@ -1212,9 +1221,16 @@ Status TrainingRunner::SaveCheckpoint(const PathString& checkpoint_path) {
   std::unordered_map<std::string, std::string> checkpointed_properties{};
   ORT_RETURN_IF_ERROR(SaveCheckpointProperties(checkpointed_properties));
 
+  if (params_.async_checkpoint) {
+    ORT_RETURN_IF_ERROR(checkpoint_writer_.Save(
+        checkpoint_path, session_.GetDataTransferManager(),
+        checkpointed_tensors, checkpointed_properties, params_.checkpoint_num_data_files));
+    return Status::OK();
+  }
+
   ORT_RETURN_IF_ERROR(SaveModelCheckpoint(
       checkpoint_path, session_.GetDataTransferManager(),
-      checkpointed_tensors, checkpointed_properties));
+      checkpointed_tensors, checkpointed_properties, params_.checkpoint_num_data_files));
 
   return Status::OK();
 }
@@ -1227,27 +1243,59 @@ Status WithOrtValuesFromTensorProtos(
   static const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
 
   NameMLValMap name_to_ort_value{};
-  std::vector<std::vector<char>> tensor_buffers{};
+  std::vector<std::vector<char>> tensor_buffers(tensor_protos.size());
+  std::vector<OrtValue> ort_values(tensor_protos.size());
+
+  // group the tensors by data file, the data files are read in parallel
+  std::map<std::string, std::vector<size_t>> data_file_tensor_indices{};
+  for (size_t i = 0; i < tensor_protos.size(); ++i) {
+    std::string location{};
+    for (const auto& kvp : tensor_protos[i].external_data()) {
+      if (kvp.key() == "location") {
+        location = kvp.value();
+      }
+    }
+    data_file_tensor_indices[location].push_back(i);
+  }
 
-  for (const auto& tensor_proto : tensor_protos) {
-    const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type());
-    const size_t element_size = tensor_type->GetElementType()->Size();
-    const TensorShape shape{
-        tensor_proto.dims().data(), static_cast<size_t>(tensor_proto.dims().size())};
+  auto load_tensors = [&](const std::vector<size_t>& tensor_indices) -> Status {
+    for (const size_t i : tensor_indices) {
+      const auto& tensor_proto = tensor_protos[i];
+      const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type());
+      const size_t element_size = tensor_type->GetElementType()->Size();
+      const TensorShape shape{
+          tensor_proto.dims().data(), static_cast<size_t>(tensor_proto.dims().size())};
 
-    std::vector<char> tensor_buffer{};
-    tensor_buffer.resize(element_size * shape.Size());
+      tensor_buffers[i].resize(element_size * shape.Size());
 
-    const MemBuffer mem_buffer{tensor_buffer.data(), tensor_buffer.size(), cpu_alloc_info};
+      const MemBuffer mem_buffer{tensor_buffers[i].data(), tensor_buffers[i].size(), cpu_alloc_info};
 
-    OrtValue ort_value;
+      ORT_RETURN_IF_ERROR(utils::TensorProtoToMLValue(
+          Env::Default(), model_location.c_str(), tensor_proto, mem_buffer,
+          ort_values[i]));
+    }
+    return Status::OK();
+  };
 
-    ORT_RETURN_IF_ERROR(utils::TensorProtoToMLValue(
-        Env::Default(), model_location.c_str(), tensor_proto, mem_buffer,
-        ort_value));
+  std::vector<Status> data_file_statuses(data_file_tensor_indices.size());
+  std::vector<std::thread> data_file_readers{};
+  size_t data_file_index = 0;
+  for (const auto& location_and_tensor_indices : data_file_tensor_indices) {
+    const auto& tensor_indices = location_and_tensor_indices.second;
+    data_file_readers.emplace_back([&, data_file_index]() {
+      data_file_statuses[data_file_index] = load_tensors(tensor_indices);
+    });
+    ++data_file_index;
+  }
+  for (auto& data_file_reader : data_file_readers) {
+    data_file_reader.join();
+  }
+  for (const auto& data_file_status : data_file_statuses) {
+    ORT_RETURN_IF_ERROR(data_file_status);
+  }
 
-    name_to_ort_value.emplace(tensor_proto.name(), ort_value);
-    tensor_buffers.emplace_back(std::move(tensor_buffer));
+  for (size_t i = 0; i < tensor_protos.size(); ++i) {
+    name_to_ort_value.emplace(tensor_protos[i].name(), ort_values[i]);
   }
 
   ORT_RETURN_IF_ERROR(use_name_to_ort_value_fn(name_to_ort_value));
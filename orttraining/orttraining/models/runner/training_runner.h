@@ -10,6 +10,7 @@
 #include "core/framework/ml_value.h"
 #include "core/providers/providers.h"
 #include "orttraining/core/framework/checkpoint_registry.h"
+#include "orttraining/core/framework/checkpointing.h"
 #include "orttraining/core/framework/communication/mpi/mpi_context.h"
 #include "orttraining/core/framework/pipeline.h"
 #include "orttraining/core/graph/optimizer_config.h"
@@ -91,6 +92,10 @@ class TrainingRunner {
     std::unordered_map<std::string, std::shared_ptr<IExecutionProviderFactory>> providers;
     // Whether to use NCCL for distributed training.
     bool use_nccl = false;
+    // The size in bytes of the gradient buckets of the NCCL AllReduce, 0 means a single bucket.
+    int64_t allreduce_bucket_size_in_bytes = 0;
+    // Whether the NCCL AllReduce reduces within the node before reducing across nodes.
+    bool use_hierarchical_allreduce = false;
     // Whether to partition the optimizer state across nodes for distributed training.
     ZeROConfig deepspeed_zero{};
     // Use Adasum for allreduce.
@@ -116,9 +121,11 @@ class TrainingRunner {
     // GIST configuration
     struct GistConfiguration {
       // The operator type to which GIST is applied. Valid Values - 1 (Softmax), 2 (Transpose), 3 (Reshape),
-      // 4 (Add), 5 (Dropout), 6 (LayerNormalization), 7 (MatMul), 8 (Relu), 9 (All the above)
+      // 4 (Add), 5 (Dropout), 6 (LayerNormalization), 7 (MatMul), 8 (Relu), 9 (All the above),
+      // 10 (Any activation stashed for the backward pass)
       int op_type;
-      // The compression type used for GIST. Valid values - GistBinarize, GistPack1, GistPack8, GistPack16, GistPackMsfp15
+      // The compression type used for GIST. Valid values - GistBinarize, GistPack1, GistPack8, GistPack16,
+      // GistPackBf16, GistPackMsfp15, GistAuto (chosen per activation)
       std::string compr_type;
     };
     GistConfiguration gist_config;
@@ -167,6 +174,10 @@ class TrainingRunner {
     size_t checkpoint_period = 0;
     // upper limit on number of checkpoint files to keep
     size_t max_num_checkpoints = 1;
+    // whether to write checkpoint files in the background while training continues
+    bool async_checkpoint = false;
+    // number of tensor data files per checkpoint, which are written and read in parallel
+    size_t checkpoint_num_data_files = 1;
 
     int data_parallel_size = 1;
     int horizontal_parallel_size = 1;
@@ -189,6 +200,8 @@ class TrainingRunner {
     // The i-th file is run by the i-th MPI rank.
     // If model_paths is not empty, model partition transformation may not be internally invoked.
     VectorString pipeline_stage_paths;
+    // How the micro-batches are scheduled on the pipeline stages.
+    pipeline::PipelineScheduleType pipeline_schedule_type = pipeline::PipelineScheduleType::Greedy;
     // Enable gradient clipping.
     bool enable_grad_norm_clip = true;
 
@@ -202,6 +215,8 @@ class TrainingRunner {
     bool transformer_layer_recompute = false;
     // Number of layers to apply recompute
     int number_recompute_layers = 0;
+    // Memory budget in bytes for the activations kept for the backward pass, 0 disables the recompute planning
+    int64_t recompute_memory_budget_in_bytes = 0;
     // Use invertible layernorm grad
     bool use_invertible_layernorm_grad = false;
   };
@@ -275,6 +290,8 @@ class TrainingRunner {
   AllocatorPtr input_allocator_;
 
   std::unique_ptr<CheckpointRegistry> checkpoint_registry_;
+  // Writes checkpoints in the background if params_.async_checkpoint is set.
+  AsyncCheckpointWriter checkpoint_writer_;
 
   // Pipeline fields are valid only if params_.pipeline_parallel_size > 1.
   // Information for running pipeline.
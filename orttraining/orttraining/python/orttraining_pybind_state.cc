@@ -44,6 +44,7 @@ struct TrainingParameters {
   bool use_fp16_moments = false;
 
   bool use_mixed_precision = false;
+  bool use_bfloat16 = false;
   bool allreduce_post_accumulation = false;
   float loss_scale = 0.0f;
   int world_rank = 0;
@@ -126,6 +127,9 @@ TrainingConfigurationResult ConfigureSessionForTraining(
   if (parameters.use_mixed_precision) {
     training::PipelineTrainingSession::TrainingConfiguration::MixedPrecisionConfiguration mp{};
     mp.use_mixed_precision_initializers = true;
+    if (parameters.use_bfloat16) {
+      mp.mixed_precision_type = MixedPrecisionDataType::BF16;
+    }
 
     config.mixed_precision_config = mp;
   }
@@ -318,6 +322,7 @@ void addObjectMethodsForTraining(py::module& m) {
       .def_readwrite("sliced_axes", &TrainingParameters::sliced_axes)
       .def_readwrite("use_fp16_moments", &TrainingParameters::use_fp16_moments)
       .def_readwrite("use_mixed_precision", &TrainingParameters::use_mixed_precision)
+      .def_readwrite("use_bfloat16", &TrainingParameters::use_bfloat16)
       .def_readwrite("allreduce_post_accumulation", &TrainingParameters::allreduce_post_accumulation)
       .def_readwrite("loss_scale", &TrainingParameters::loss_scale)
       .def_readwrite("world_rank", &TrainingParameters::world_rank)
@@ -548,7 +553,8 @@ void addObjectMethodsForTraining(py::module& m) {
                      &OrtModuleGraphBuilderConfiguration::use_invertible_layernorm_grad)
       .def_readwrite("build_gradient_graph", &OrtModuleGraphBuilderConfiguration::build_gradient_graph)
       .def_readwrite("graph_transformer_config", &OrtModuleGraphBuilderConfiguration::graph_transformer_config)
-      .def_readwrite("loglevel", &OrtModuleGraphBuilderConfiguration::loglevel);
+      .def_readwrite("loglevel", &OrtModuleGraphBuilderConfiguration::loglevel)
+      .def_readwrite("graph_cache_dir", &OrtModuleGraphBuilderConfiguration::graph_cache_dir);
 
   py::class_<GraphInfo> graph_info(m, "GraphInfo",
                                    R"pbdoc(The information of split graphs for frontend.)pbdoc");
@@ -83,6 +83,10 @@ class GraphExecutionManager(ABC):
         # flag to enable symbolic shape inference for dynamic shape inputs to improve performance
         self._run_symbolic_shape_infer = True
 
+        # Directory of the persistent cache of built graphs, reused across runs and processes.
+        # Empty disables the cache.
+        self._graph_cache_dir = ''
+
         self._input_info = None
         self._module_output_schema = None
 
@@ -286,5 +290,6 @@ class GraphExecutionManager(ABC):
                                         _logger.LogLevel.WARNING : C.Severity.WARNING,
                                         _logger.LogLevel.ERROR : C.Severity.ERROR,
                                         _logger.LogLevel.FATAL : C.Severity.FATAL}.get(self._loglevel, C.Severity.WARNING)
+        grad_builder_config.graph_cache_dir = self._graph_cache_dir
         self._graph_builder = C.OrtModuleGraphBuilder()
         self._graph_builder.initialize(self._onnx_model.SerializeToString(), grad_builder_config)
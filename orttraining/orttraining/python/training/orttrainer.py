@@ -164,7 +164,9 @@ class ORTTrainer(object):
         if not options:
             options = ORTTrainerOptions()
         self.options = options
-        if self.options.mixed_precision.enabled and not self.options.mixed_precision.loss_scaler:
+        if self.options.mixed_precision.bf16 and self.options.mixed_precision.loss_scaler:
+            raise ValueError("Loss Scaler cannot be specified when bf16 Mixed Precision is enabled")
+        if self._use_loss_scaling() and not self.options.mixed_precision.loss_scaler:
             # TODO: Move this to model_desc_validation.py
             self.options.mixed_precision.loss_scaler = amp.loss_scaler.DynamicLossScaler()
         # Post processing ONNX model given as input
@@ -373,7 +375,7 @@ class ORTTrainer(object):
             run_options = ort.RunOptions()
             run_options.only_execute_path_to_fetches = True
             outputs_desc = self._model_desc_outputs_with_gradient_accumulation
-        elif self.options.mixed_precision.enabled:
+        elif self._use_loss_scaling():
             mixed_precision_without_fetches = True
             outputs_desc = self._model_desc_outputs_with_all_finite
 
@@ -384,7 +386,7 @@ class ORTTrainer(object):
 
         # Loss Scale for mixed precision
         loss_scale = None
-        if self.options.mixed_precision.enabled:
+        if self._use_loss_scaling():
             loss_scaler = self.options.mixed_precision.loss_scaler
             assert loss_scaler, "Loss scaler is required when mixed precision is enabled"
             loss_scale = loss_scaler.loss_scale
@@ -627,6 +629,7 @@ class ORTTrainer(object):
         ort_parameters = ort.TrainingParameters()
         ort_parameters.loss_output_name = loss_name
         ort_parameters.use_mixed_precision = self.options.mixed_precision.enabled
+        ort_parameters.use_bfloat16 = self.options.mixed_precision.bf16
         ort_parameters.world_rank = self.options.distributed.world_rank
         ort_parameters.world_size = self.options.distributed.world_size
         ort_parameters.gradient_accumulation_steps = self.options.batch.gradient_accumulation_steps
@@ -757,18 +760,20 @@ class ORTTrainer(object):
                                           provider_options=provider_options)
 
         # Update model description to update dtype when mixed precision is enabled
-        # C++ backend modifies model's output dtype from float32 to float16 for mixed precision
-        # Note that for training we must use float32 and for evaluation we must use float16
+        # C++ backend modifies model's output dtype from float32 to float16 (or bfloat16) for mixed precision
+        # Note that for training we must use float32 and for evaluation we must use float16 (or bfloat16)
+        mixed_precision_dtype = torch.bfloat16 if self.options.mixed_precision.bf16 else torch.float16
         for idx, o_desc in enumerate(self.model_desc.outputs):
             if (self.options.mixed_precision.enabled and o_desc.dtype == torch.float32 and
                     not self._training_session.is_output_fp32_node(o_desc.name)):
-                self.model_desc.add_type_to_output_description(idx, o_desc.dtype, torch.float16)
+                self.model_desc.add_type_to_output_description(idx, o_desc.dtype, mixed_precision_dtype)
 
         # Update model description
         self._model_desc_inputs_with_lr = [*self.model_desc.inputs, self.model_desc.learning_rate]
 
         # Update Mixed Precision, if applicable
-        if self.options.mixed_precision.enabled:
+        # bf16 has the range of fp32, so neither the loss scale input nor the all finite output is added
+        if self._use_loss_scaling():
             self.model_desc.loss_scale_input = self._training_session.loss_scale_input_name
             self._model_desc_inputs_with_lr_and_loss_scale = [
                 *self._model_desc_inputs_with_lr, self.model_desc.loss_scale_input]
@@ -778,7 +783,7 @@ class ORTTrainer(object):
             raise ValueError("Loss Scaler cannot be specified when Mixed Precision is not enabled")
 
         # Update Loss Scaler Input Name, if applicable
-        if self.options.mixed_precision.enabled and self.options.mixed_precision.loss_scaler:
+        if self._use_loss_scaling() and self.options.mixed_precision.loss_scaler:
             self.options.mixed_precision.loss_scaler.input_name = self.model_desc.loss_scale_input.name
         elif not self.options.mixed_precision.enabled and self.options.mixed_precision.loss_scaler:
             raise ValueError("Loss Scaler cannot be specified when Mixed Precision is not enabled")
@@ -795,6 +800,10 @@ class ORTTrainer(object):
             self._state_dict_debug = self._state_dict
         self._state_dict = {}
 
+    def _use_loss_scaling(self):
+        '''Only fp16 mixed precision needs a loss scale and the gradients all finite check'''
+        return self.options.mixed_precision.enabled and not self.options.mixed_precision.bf16
+
     def _prepare_model_input(self, inputs_desc, lr, loss_scale, *inputs, **kwargs):
         # Normalize input to tuple of samples
         if type(inputs) == tuple and len(inputs) == 1 and type(inputs[0]) == list:
@@ -875,7 +884,7 @@ class ORTTrainer(object):
         result = {}
         for output_desc in outputs_desc_resolved:
             target_device = self.options.device.id
-            if self.options.mixed_precision.enabled and output_desc.name == self.model_desc.all_finite.name:
+            if self._use_loss_scaling() and output_desc.name == self.model_desc.all_finite.name:
                 # Keep all finite flag on CPU to match backend implementation
                 # This prevents CPU -> GPU -> CPU copies between frontend and backend
                 target_device = 'cpu'
@@ -135,7 +135,7 @@ class ORTTrainerOptions(object):
                                 'stage': {
                                     'type': 'integer',
                                     'min': 0,
-                                    'max': 1,
+                                    'max': 2,
                                     'default': 0
                                 },
                             }
@@ -160,6 +160,10 @@ class ORTTrainerOptions(object):
                             'type' : 'boolean',
                             'default' : False
                         },
+                        'bf16' : {
+                            'type' : 'boolean',
+                            'default' : False
+                        },
                         'loss_scaler' : {
                             'type' : 'amp.loss_scaler',
                             'nullable' : True,
@@ -340,6 +344,7 @@ class ORTTrainerOptions(object):
             DeepSpeed ZeRO options.
         distributed.deepspeed_zero_optimization.stage (int, default is 0):
             select which stage of DeepSpeed ZeRO to use. Stage 0 means disabled.
+            Stage 1 partitions the optimizer states, stage 2 also partitions the accumulated gradients.
         distributed.enable_adasum (bool, default is False):
             enable `Adasum <https://arxiv.org/abs/2006.02924>`_
             algorithm for AllReduce
@@ -349,8 +354,11 @@ class ORTTrainerOptions(object):
             mixed precision training options
         mixed_precision.enabled (bool, default is False):
             enable mixed precision (fp16)
+        mixed_precision.bf16 (bool, default is False):
+            use bf16 instead of fp16 for mixed precision. bf16 has the range of fp32, so training
+            runs without loss scaling and without the per step gradients all finite check
         mixed_precision.loss_scaler (amp.LossScaler, default is None):
-            specifies a loss scaler to be used for fp16. If not specified,
+            specifies a loss scaler to be used for fp16, it must not be set for bf16. If not specified,
             :py:class:`.DynamicLossScaler` is used with default values.
             Users can also instantiate :py:class:`.DynamicLossScaler` and
             override its parameters. Lastly, a completely new implementation
@@ -635,7 +643,7 @@ _ORTTRAINER_OPTIONS_SCHEMA = {
                     'stage': {
                         'type': 'integer',
                         'min': 0,
-                        'max': 1,
+                        'max': 2,
                         'default': 0
                     },
                 }
@@ -660,6 +668,10 @@ _ORTTRAINER_OPTIONS_SCHEMA = {
                 'type': 'boolean',
                 'default': False
             },
+            'bf16': {
+                'type': 'boolean',
+                'default': False
+            },
             'loss_scaler': {
                 'type': 'loss_scaler',
                 'nullable': True,
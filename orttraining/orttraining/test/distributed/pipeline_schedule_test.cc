@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <sstream>
+
 #include "gtest/gtest.h"
 #include "orttraining/core/framework/pipeline.h"
 #include "orttraining/core/framework/distributed_run_context.h"
@@ -112,5 +114,34 @@ TEST(Pipeline, ScheduleB5S3) {
   TestPipelineScheduler(num_batches, num_stages, baseline_events);
 }
 
+TEST(Pipeline, ScheduleB4S3OneForwardOneBackward) {
+  onnxruntime::training::pipeline::PipelineScheduler schedule(
+      4, 3, {0, 1, 2}, onnxruntime::training::pipeline::PipelineScheduleType::OneForwardOneBackward);
+
+  std::ostringstream stream;
+  stream << schedule;
+  std::istringstream lines(stream.str());
+  std::string line;
+  std::getline(lines, line);  // header of the compute schedule
+
+  // Stage s runs 2 - s warm-up forwards, so it never holds the activations of more than 3 - s micro-batches.
+  const std::vector<std::string> baseline_compute_schedule{
+      "FW00    FW01    FW02                    BW00    FW03    BW01            BW02            BW03    ",
+      "        FW00    FW01            BW00    FW02    BW01    FW03    BW02            BW03            ",
+      "                FW00    BW00    FW01    BW01    FW02    BW02    FW03    BW03                    "};
+  for (const auto& baseline : baseline_compute_schedule) {
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_EQ(line, baseline);
+  }
+
+  // Every stage still sends and receives the activations and gradients of each micro-batch.
+  for (int b = 0; b < 4; ++b) {
+    EXPECT_NE(schedule.GetForwardSendRecordedEvent(b, 0), -1) << " batch " << b;
+    EXPECT_NE(schedule.GetForwardRecvRecordedEvent(b, 2), -1) << " batch " << b;
+    EXPECT_NE(schedule.GetBackwardSendRecordedEvent(b, 2), -1) << " batch " << b;
+    EXPECT_NE(schedule.GetBackwardRecvRecordedEvent(b, 0), -1) << " batch " << b;
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
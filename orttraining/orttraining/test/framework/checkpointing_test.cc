@@ -3,6 +3,7 @@
 
 #include "orttraining/core/framework/checkpointing.h"
 
+#include <functional>
 #include <unordered_map>
 #include <vector>
 
@@ -83,12 +84,15 @@ void CompareOrtValuesToTensorProtoValues(
         std::memcmp(a.DataRaw(), b.DataRaw(), a.SizeInBytes()) == 0);
   }
 }
-}  // namespace
 
-TEST(CheckpointingTest, SaveAndLoad) {
+void TestSaveAndLoad(
+    std::function<Status(const PathString&, const DataTransferManager&, const NameMLValMap&,
+                         const std::unordered_map<std::string, std::string>&)>
+        save_fn) {
   std::unordered_map<std::string, OrtValueTensorData> name_to_ort_value_data{
       {"first", {{3}, {1.0f, 2.0f, 3.0f}}},
       {"second", {{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}}},
+      {"third", {{2}, {5.0f, 6.0f}}},
   };
 
   NameMLValMap name_to_ort_value{};
@@ -114,7 +118,7 @@ TEST(CheckpointingTest, SaveAndLoad) {
   DataTransferManager data_transfer{};
   data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>());
 
-  ASSERT_STATUS_OK(SaveModelCheckpoint(
+  ASSERT_STATUS_OK(save_fn(
       checkpoint_path, data_transfer, name_to_ort_value, properties));
 
   std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
@@ -136,6 +140,33 @@ TEST(CheckpointingTest, SaveAndLoad) {
   CompareOrtValuesToTensorProtoValues(
       model_path, name_to_ort_value, name_to_loaded_tensor_proto);
 }
+}  // namespace
+
+TEST(CheckpointingTest, SaveAndLoad) {
+  TestSaveAndLoad(
+      [](const PathString& checkpoint_path, const DataTransferManager& data_transfer,
+         const NameMLValMap& name_to_ort_value, const std::unordered_map<std::string, std::string>& properties) {
+        return SaveModelCheckpoint(checkpoint_path, data_transfer, name_to_ort_value, properties);
+      });
+}
+
+TEST(CheckpointingTest, SaveAndLoadMultipleDataFiles) {
+  TestSaveAndLoad(
+      [](const PathString& checkpoint_path, const DataTransferManager& data_transfer,
+         const NameMLValMap& name_to_ort_value, const std::unordered_map<std::string, std::string>& properties) {
+        return SaveModelCheckpoint(checkpoint_path, data_transfer, name_to_ort_value, properties, 2);
+      });
+}
+
+TEST(CheckpointingTest, SaveAsyncAndLoad) {
+  TestSaveAndLoad(
+      [](const PathString& checkpoint_path, const DataTransferManager& data_transfer,
+         const NameMLValMap& name_to_ort_value, const std::unordered_map<std::string, std::string>& properties) {
+        AsyncCheckpointWriter writer{};
+        ORT_RETURN_IF_ERROR(writer.Save(checkpoint_path, data_transfer, name_to_ort_value, properties, 2));
+        return writer.Wait();
+      });
+}
 
 }  // namespace test
 }  // namespace training
@@ -217,6 +217,41 @@ TEST(GradientGraphBuilderTest, GraphTransformation_WithGist) {
   }
 }
 
+TEST(GradientGraphBuilderTest, GraphTransformation_WithGistAllActivations) {
+  auto config = MakeBasicTrainingConfig();
+  TrainingSession::TrainingConfiguration::GistConfiguration gist{};
+  gist.op_type = 10;  // Apply Gist to any activation stashed for the backward pass
+  gist.compr_type = "GistAuto";
+  config.gist_config = gist;
+
+  PathString backprop_model_file;
+  ASSERT_STATUS_OK(BuildBackPropGraph(ORIGINAL_MODEL_PATH, config, backprop_model_file));
+
+  backprop_model_file = config.model_with_training_graph_path.value();
+  std::shared_ptr<Model> pModel;
+  ASSERT_STATUS_OK(Model::Load(backprop_model_file, pModel, nullptr, DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = pModel->MainGraph();
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  int encoder_count = 0;
+  for (const std::string compr_type : {"GistBinarize", "GistPack1", "GistPackBf16"}) {
+    ASSERT_EQ(op_to_count["com.microsoft." + compr_type + "Encoder"], op_to_count["com.microsoft." + compr_type + "Decoder"]);
+    encoder_count += op_to_count["com.microsoft." + compr_type + "Encoder"];
+  }
+  // the ReLU outputs are only read by ReluGrad and are binarized losslessly
+  ASSERT_GT(op_to_count["com.microsoft.GistBinarizeEncoder"], 0);
+  ASSERT_GT(encoder_count, op_to_count["com.microsoft.GistBinarizeEncoder"]);
+
+  // GIST nodes are not encoded again
+  for (const auto& node : graph.Nodes()) {
+    if (node.Description() == "Encode") {
+      for (auto it = node.InputNodesBegin(); it != node.InputNodesEnd(); ++it) {
+        ASSERT_NE(it->Description(), "Decode");
+      }
+    }
+  }
+}
+
 #ifdef USE_CUDA
 TEST(GradientGraphBuilderTest, TrainingSession_WithGist) {
   // Setup training session configuration including GIST config (op_flag 9 ensures GIST will be applied to all possible supported node types)
@@ -40,6 +40,7 @@ namespace {
 const std::vector<const char*> k_weight_names{"weight_1", "weight_2"};
 constexpr const char* const k_loss_scaling_factor_name = "loss_scaling_factor";
 constexpr const char* const k_adam_optimizer_op_name = "AdamOptimizer";
+constexpr const char* const k_fused_adam_optimizer_op_name = "FusedAdamOptimizer";
 constexpr const char* const k_lamb_optimizer_op_name = "LambOptimizer";
 constexpr const char* const k_all_reduce_op_name = "NcclAllReduce";
 constexpr const char* const k_all_gather_op_name = "NcclAllGather";
@@ -179,6 +180,11 @@ static void TestOptimizerGraphBuilderWithInitialStates(OptimizerGraphConfig conf
     if (optimizer_op_name == k_adam_optimizer_op_name) {
       CreateMLValue<int64_t>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, uc_value, &ml_value);
       per_weight_states.insert(std::make_pair(ADAM_UC_PREFIX, std::move(ml_value)));
+    } else if (optimizer_op_name == k_fused_adam_optimizer_op_name) {
+      // the update count is shared by all weights
+      CreateMLValue<int64_t>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, uc_value, &ml_value);
+      shared_states.insert(std::make_pair(ADAM_UC_PREFIX, std::move(ml_value)));
+      config.shared_optimizer_states = std::move(shared_states);
     } else if (optimizer_op_name == k_lamb_optimizer_op_name) {
       // add "Step" for lamb
       CreateMLValue<int64_t>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, uc_value, &ml_value);
@@ -224,6 +230,44 @@ TEST_F(OptimizerGraphBuilderTest, LoadOptimState_FullPrecision_Lamb) {
   TestOptimizerGraphBuilderWithInitialStates(config, graph_, k_lamb_optimizer_op_name);
 }
 
+TEST_F(OptimizerGraphBuilderTest, LoadOptimState_FullPrecision_FusedAdam) {
+  OptimizerGraphConfig config;
+  config.gradient_accumulation_steps = 1;
+  config.use_mixed_precision = false;
+  TestOptimizerGraphBuilderWithInitialStates(config, graph_, k_fused_adam_optimizer_op_name);
+}
+
+TEST_F(OptimizerGraphBuilderTest, FusedAdam_SingleNodeForAllWeights) {
+  OptimizerGraphConfig config;
+  config.gradient_accumulation_steps = 1;
+  config.use_mixed_precision = true;
+  config.loss_scale_input_name = k_loss_scaling_factor_name;
+
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  OptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, GetOptInfoMap(k_fused_adam_optimizer_op_name),
+      updated_weight_names_map, weight_partition_info);
+
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_STATUS_OK(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs));
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_fused_adam_optimizer_op_name), 1);
+  ASSERT_EQ(GetOpCount(op_counts, k_adam_optimizer_op_name), 0);
+
+  // one shared update count, and [w, g, m1, m2, w_mixed_precision] per weight
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_fused_adam_optimizer_op_name) {
+      ASSERT_EQ(node.InputDefs().size(), 5 + 5 * k_weight_names.size());
+      ASSERT_EQ(node.InputDefs()[4]->Name(), ADAM_UC_PREFIX);
+      ASSERT_EQ(node.InputDefs()[1]->Name(), k_loss_scaling_factor_name);
+    }
+  }
+  ASSERT_EQ(weight_to_opt_mapping[SHARED_OPTIMIZER_STATES_KEY][ADAM_UC_PREFIX], ADAM_UC_PREFIX);
+}
+
 TEST_F(OptimizerGraphBuilderTest, ZeroSplitInitialOptimizerState) {
   NameMLValMap initial_states;
   std::vector<int64_t> param_dims = {784, 128};
@@ -273,6 +317,15 @@ static void TestDefaultOptimizerGraphBuilder(OptimizerGraphConfig config, Graph&
     ASSERT_EQ(GetOpCount(op_counts, k_inplace_accumulator_op_name), k_weight_names.size());
     ASSERT_EQ(GetOpCount(op_counts, k_zero_gradient_op_name), k_weight_names.size());
     ASSERT_GT(opt_graph_outputs.count(OptimizerOutputKey::GradientAccumulation), 0);
+
+    // in ZeRO stage 2 the reduce-scattered gradients are accumulated
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == k_inplace_accumulator_op_name) {
+        const Node* producer = graph.GetProducerNode(node.InputDefs()[1]->Name());
+        const bool accumulates_reduced_gradient = producer != nullptr && producer->OpType() == k_reduce_scatter_op_name;
+        ASSERT_EQ(accumulates_reduced_gradient, config.deepspeed_zero.stage >= 2);
+      }
+    }
   }
 
   // verify mixed precision operations exist
@@ -477,6 +530,19 @@ TEST_F(OptimizerGraphBuilderTest, Allreduce_WithGradientAccumulation_WithMixedPr
   TestAllreduceOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Allreduce_GradientBuckets) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  // each gradient has a single fp32 element, so every gradient gets its own bucket
+  config.allreduce_bucket_size_in_bytes = 4;
+  TestAllreduceOptimizerGraphBuilder(config, graph_);
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_unscale_op_name), k_weight_names.size());
+}
+
 static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
   std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
@@ -495,6 +561,15 @@ static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& gr
     ASSERT_EQ(GetOpCount(op_counts, k_inplace_accumulator_op_name), k_weight_names.size());
     ASSERT_EQ(GetOpCount(op_counts, k_zero_gradient_op_name), k_weight_names.size());
     ASSERT_GT(opt_graph_outputs.count(OptimizerOutputKey::GradientAccumulation), 0);
+
+    // in ZeRO stage 2 the reduce-scattered gradients are accumulated
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == k_inplace_accumulator_op_name) {
+        const Node* producer = graph.GetProducerNode(node.InputDefs()[1]->Name());
+        const bool accumulates_reduced_gradient = producer != nullptr && producer->OpType() == k_reduce_scatter_op_name;
+        ASSERT_EQ(accumulates_reduced_gradient, config.deepspeed_zero.stage >= 2);
+      }
+    }
   }
 
   // verify mixed precision operations exist
@@ -554,6 +629,27 @@ TEST_F(OptimizerGraphBuilderTest, ZeRO_WithGradientAccumulation_WithMixedPrecisi
   TestZeROOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, ZeROStage2_WithGradientAccumulation_NoMixedPrecision) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{2};
+  config.gradient_accumulation_steps = 10;
+  config.use_mixed_precision = false;
+  TestZeROOptimizerGraphBuilder(config, graph_);
+}
+
+TEST_F(OptimizerGraphBuilderTest, ZeROStage2_WithGradientAccumulation_WithMixedPrecision) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{2};
+  config.gradient_accumulation_steps = 10;
+  config.use_mixed_precision = true;
+  config.loss_scale_input_name = k_loss_scaling_factor_name;
+  TestZeROOptimizerGraphBuilder(config, graph_);
+}
+
 #endif  // ORT_USE_NCCL
 
 }  // namespace test
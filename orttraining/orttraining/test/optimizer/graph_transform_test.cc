@@ -17,6 +17,7 @@
 #include "orttraining/core/optimizer/megatron_transformer.h"
 #include "orttraining/core/optimizer/concat_replacement.h"
 #include "orttraining/core/optimizer/localized_recompute.h"
+#include "orttraining/core/optimizer/memory_budget_recompute.h"
 #include "test/optimizer/graph_transform_test_fixture.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
@@ -230,6 +231,37 @@ TEST_F(GraphTransformationTests, MegatronMLPPartitionRank1) {
   }
 }
 
+TEST_F(GraphTransformationTests, MegatronMLPPartitionInference) {
+  auto model_uri = MODEL_FOLDER "model_parallel/mlp_megatron_basic_test.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, p_model, nullptr, *logger_));
+  Graph& graph = p_model->MainGraph();
+
+  // the inference transformer partitions the weights as in training, without a training session to report to
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  IExecutionProvider* e = TestCPUExecutionProvider();
+  graph_transformation_mgr.Register(std::make_unique<MegatronTransformer>(1, 2, *e), TransformerLevel::Level1);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["com.microsoft.MegatronF"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.MegatronG"], 1);
+
+  {
+    std::vector<float> expected_value = {0.08f, 0.09f, 0.10f, 0.11f, 0.12f, 0.13f, 0.14f, 0.15f};
+    auto input_arg = GetNodeByName(graph, "add")->MutableInputDefs()[1];
+    ORT_ENFORCE(input_arg != nullptr);
+    std::vector<int64_t> expected_shape = {8};
+    std::vector<float> actual_val;
+    std::vector<int64_t> actual_shape;
+    horizontal_parallel_test_utils::GetDataAndShapeFromTensorProto(graph, input_arg, actual_val, actual_shape);
+    ASSERT_TRUE(std::equal(expected_shape.begin(), expected_shape.end(), actual_shape.begin()));
+
+    horizontal_parallel_test_utils::VerifyOutputs(expected_value, actual_val, true);
+    horizontal_parallel_test_utils::VerifyOutputs(expected_value, actual_val, false);
+  }
+}
+
 TEST_F(GraphTransformationTests, MegatronSelfAttentionPartitionRank0) {
   auto model_uri = MODEL_FOLDER "model_parallel/self_attention_megatron_basic_test.onnx";
   std::shared_ptr<Model> p_model;
@@ -391,6 +423,54 @@ TEST_F(GraphTransformationTests, BiasGeluRecomputeTest) {
   }
 }
 
+// X -> Relu -> Sigmoid -> MatMul -> Y, where the Relu and Sigmoid outputs are 16KB activations each.
+static void RunMemoryBudgetRecompute(int64_t memory_budget_in_bytes, std::map<std::string, int>& op_to_count,
+                                     const logging::Logger& logger) {
+  Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}},
+              {}, logger);
+  Graph& graph = model.MainGraph();
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type);
+  auto& w = graph.GetOrCreateNodeArg("W", &type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &type);
+  auto& sigmoid_out = graph.GetOrCreateNodeArg("sigmoid_out", &type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type);
+  graph.AddNode("relu", "Relu", "", {&x}, {&relu_out});
+  graph.AddNode("sigmoid", "Sigmoid", "", {&relu_out}, {&sigmoid_out});
+  graph.AddNode("matmul", "MatMul", "", {&sigmoid_out, &w}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  graph_transformation_mgr.Register(std::make_unique<MemoryBudgetRecompute>(memory_budget_in_bytes),
+                                    TransformerLevel::Level2);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, logger));
+
+  op_to_count = CountOpsInGraph(graph);
+}
+
+TEST_F(GraphTransformationTests, MemoryBudgetRecomputeTest) {
+  std::map<std::string, int> op_to_count;
+
+  // the activations fit in the budget
+  RunMemoryBudgetRecompute(64 * 1024, op_to_count, *logger_);
+  ASSERT_EQ(op_to_count["Relu"], 1);
+  ASSERT_EQ(op_to_count["Sigmoid"], 1);
+
+  // recomputing one of the activations is enough
+  RunMemoryBudgetRecompute(20000, op_to_count, *logger_);
+  ASSERT_EQ(op_to_count["Relu"] + op_to_count["Sigmoid"], 3);
+
+  // both activations are recomputed
+  RunMemoryBudgetRecompute(1024, op_to_count, *logger_);
+  ASSERT_EQ(op_to_count["Relu"], 2);
+  ASSERT_EQ(op_to_count["Sigmoid"], 2);
+}
+
 // We only tested on CUDA run.
 #if defined(USE_CUDA)
 static void RunPartitionCorrectnessTest(std::string model_path,
@@ -3,6 +3,7 @@
 # orttraining_test_ortmodule_api.py
 
 import math
+import os
 import random
 import copy
 import torch
@@ -1562,6 +1563,32 @@ def test_model_initializer_requires_grad_changes_from_one_forward_to_next():
     assert torch.equal(weight_grad_2, weight_grad_3)
     assert torch.equal(bias_grad_2, bias_grad_3)
 
+def test_model_graph_cache(tmp_path):
+    device = 'cuda'
+    N, D_in, H, D_out = 64, 784, 500, 10
+    pt_model = NeuralNetSinglePositionalArgument(D_in, H, D_out).to(device)
+    x = torch.randn(N, D_in, device=device)
+
+    def run_step(model):
+        model._execution_manager(model._is_training())._graph_cache_dir = str(tmp_path)
+        prediction = model(x)
+        loss = prediction.sum()
+        loss.backward()
+        return prediction
+
+    ort_model1 = ORTModule(copy.deepcopy(pt_model))
+    ort_prediction1 = run_step(ort_model1)
+    cache_entries = [f for f in os.listdir(tmp_path) if f.endswith('.graph_info')]
+    assert len(cache_entries) == 1
+
+    # the second module loads the built graphs from the cache
+    ort_model2 = ORTModule(copy.deepcopy(pt_model))
+    ort_prediction2 = run_step(ort_model2)
+    assert [f for f in os.listdir(tmp_path) if f.endswith('.graph_info')] == cache_entries
+
+    _test_helpers.assert_values_are_close(ort_prediction1, ort_prediction2)
+    _test_helpers.assert_gradients_match_and_reset_gradient(ort_model1, ort_model2)
+
 def test_model_with_registered_buffers():
     class NeuralNetWithRegisteredBuffer(torch.nn.Module):
         def __init__(self, input_size, hidden_size, num_classes):
@@ -71,6 +71,7 @@ def testORTTrainerOptionsDefaultValues(test_input):
         'lr_scheduler': None,
         'mixed_precision': {
             'enabled': False,
+            'bf16': False,
             'loss_scaler': None
         },
         'graph_transformer': {
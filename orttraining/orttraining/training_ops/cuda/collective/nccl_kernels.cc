@@ -7,6 +7,21 @@ namespace onnxruntime {
 namespace cuda {
 
 NcclAllReduce::NcclAllReduce(const OpKernelInfo& info) : NcclKernel(info) {
+  int64_t hierarchical;
+  info.GetAttrOrDefault("hierarchical", &hierarchical, static_cast<int64_t>(0));
+  hierarchical_ = hierarchical != 0;
+}
+
+bool NcclAllReduce::CanUseHierarchicalAllReduce() const {
+  if (group_type_ != training::WorkerGroupType::DataParallel) {
+    return false;
+  }
+
+  // The node local and cross node groups must split the data parallel group, which is not the case with
+  // horizontal parallelism.
+  const int node_size = nccl_->Size(training::WorkerGroupType::NodeLocalDataParallel);
+  const int cross_node_size = nccl_->Size(training::WorkerGroupType::CrossNodeDataParallel);
+  return node_size > 1 && cross_node_size > 1 && node_size * cross_node_size == nccl_->Size(group_type_);
 }
 
 Status NcclAllReduce::ComputeInternal(OpKernelContext* context) const {
@@ -30,6 +45,34 @@ Status NcclAllReduce::ComputeInternal(OpKernelContext* context) const {
   }
 
   ncclDataType_t dtype = GetNcclDataType(onnx_type);
+
+  if (hierarchical_ && CanUseHierarchicalAllReduce()) {
+    // ReduceScatter over the fast intra-node links, AllReduce one shard per rank across nodes,
+    // then AllGather within the node. Each rank only sends 1/node_size of the buffer across nodes.
+    ncclComm_t node_comm = nccl_->Comm(training::WorkerGroupType::NodeLocalDataParallel);
+    ncclComm_t cross_node_comm = nccl_->Comm(training::WorkerGroupType::CrossNodeDataParallel);
+    const int node_rank = nccl_->Rank(training::WorkerGroupType::NodeLocalDataParallel);
+    const int node_size = nccl_->Size(training::WorkerGroupType::NodeLocalDataParallel);
+
+    // Pad to a multiple of 32 elements per rank, the padding is reduced but never copied to the outputs.
+    const size_t element_size = onnx_type->Size();
+    const size_t alignment = static_cast<size_t>(node_size) * 32;
+    const size_t padded_count = (input_count + alignment - 1) / alignment * alignment;
+    const size_t shard_count = padded_count / node_size;
+    auto fusion_buffer = GetScratchBuffer<int8_t>(padded_count * element_size);
+    int8_t* fusion_data = fusion_buffer.get();
+    int8_t* shard_data = fusion_data + node_rank * shard_count * element_size;
+
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(fusion_data, input_data, num_bytes, cudaMemcpyDeviceToDevice, Stream()));
+#ifdef ORT_USE_NCCL
+    NCCL_RETURN_IF_ERROR(ncclReduceScatter(fusion_data, shard_data, shard_count, dtype, ncclSum, node_comm, Stream()));
+    NCCL_RETURN_IF_ERROR(ncclAllReduce(shard_data, shard_data, shard_count, dtype, ncclSum, cross_node_comm, Stream()));
+    NCCL_RETURN_IF_ERROR(ncclAllGather(shard_data, fusion_data, shard_count, dtype, node_comm, Stream()));
+#endif
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(output_data, fusion_data, num_bytes, cudaMemcpyDeviceToDevice, Stream()));
+    return Status::OK();
+  }
+
 #ifdef ORT_USE_NCCL
   NCCL_RETURN_IF_ERROR(ncclAllReduce(input_data, output_data, input_count, dtype, ncclSum, comm, Stream()));
 #endif
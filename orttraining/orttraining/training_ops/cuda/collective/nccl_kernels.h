@@ -13,6 +13,12 @@ class NcclAllReduce final : public NcclKernel {
   explicit NcclAllReduce(const OpKernelInfo& info);
 
   Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  // Whether the group spans several nodes with several ranks each, so a hierarchical AllReduce is possible.
+  bool CanUseHierarchicalAllReduce() const;
+
+  bool hierarchical_;
 };
 
 class NcclAllGather final : public NcclKernel {
@@ -250,6 +250,68 @@ Status GistPack16DecoderOp<T>::ComputeInternal(OpKernelContext* context) const {
   return Status::OK();
 }
 
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+// Pack BF16
+#define REGISTER_KERNEL_TYPED_PACKBF16_ENC(T)                                   \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                \
+      GistPackBf16Encoder,                                                      \
+      kMSDomain,                                                                \
+      1,                                                                        \
+      T,                                                                        \
+      kCudaExecutionProvider,                                                   \
+      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      GistPackBf16EncoderOp<T>);
+
+REGISTER_KERNEL_TYPED_PACKBF16_ENC(float)
+
+template <typename T>
+Status GistPackBf16EncoderOp<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  ORT_RETURN_IF(X == nullptr, "X input is unavailable");
+
+  Tensor* Y = context->Output(0, X->Shape());
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  GistPackBf16EncoderImpl<CudaT>(
+      Stream(),
+      reinterpret_cast<const CudaT*>(X->template Data<T>()),
+      reinterpret_cast<nv_bfloat16*>(Y->template MutableData<BFloat16>()),
+      Y->Shape().Size());
+
+  return Status::OK();
+}
+
+#define REGISTER_KERNEL_TYPED_PACKBF16_DEC(T)                                   \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                \
+      GistPackBf16Decoder,                                                      \
+      kMSDomain,                                                                \
+      1,                                                                        \
+      T,                                                                        \
+      kCudaExecutionProvider,                                                   \
+      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      GistPackBf16DecoderOp<T>);
+
+REGISTER_KERNEL_TYPED_PACKBF16_DEC(float)
+
+template <typename T>
+Status GistPackBf16DecoderOp<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  ORT_RETURN_IF(X == nullptr, "X input is unavailable");
+  Tensor* Y = context->Output(0, X->Shape());
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  GistPackBf16DecoderImpl<CudaT>(
+      Stream(),
+      reinterpret_cast<const nv_bfloat16*>(X->template Data<BFloat16>()),
+      reinterpret_cast<CudaT*>(Y->template MutableData<T>()),
+      Y->Shape().Size());
+
+  return Status::OK();
+}
+#endif
+
 // Pack MSFP15
 #define REGISTER_KERNEL_TYPED_PACKMSFP15_ENC(T)                                 \
   ONNX_OPERATOR_TYPED_KERNEL_EX(                                                \
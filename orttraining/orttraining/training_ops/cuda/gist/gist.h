@@ -69,6 +69,20 @@ class GistPack16DecoderOp final : public CudaKernel {
   Status ComputeInternal(OpKernelContext* context) const override;
 };
 
+template <typename T>
+class GistPackBf16EncoderOp final : public CudaKernel {
+ public:
+  GistPackBf16EncoderOp(const OpKernelInfo& info) : CudaKernel(info) {}
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
+template <typename T>
+class GistPackBf16DecoderOp final : public CudaKernel {
+ public:
+  GistPackBf16DecoderOp(const OpKernelInfo& info) : CudaKernel(info) {}
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
 template <typename T>
 class GistPackMsfp15EncoderOp final : public CudaKernel {
  public:
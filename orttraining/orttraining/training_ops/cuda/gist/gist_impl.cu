@@ -195,6 +195,26 @@ __global__ void _GistPack16DecoderKernel(
   output_data[id] = (T)__half2float(X);
 }
 
+#if CUDA_VERSION >= 11000
+template <typename T>
+__global__ void _GistPackBf16EncoderKernel(
+    const T* input_data,
+    nv_bfloat16* output_data,
+    const CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+  output_data[id] = __float2bfloat16(static_cast<float>(input_data[id]));
+}
+
+template <typename T>
+__global__ void _GistPackBf16DecoderKernel(
+    const nv_bfloat16* input_data,
+    T* output_data,
+    const CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+  output_data[id] = (T)__bfloat162float(input_data[id]);
+}
+#endif
+
 template <typename T>
 __global__ void _GistPackMsfp15EncoderKernel(
     const T* input_data,
@@ -456,6 +476,30 @@ void GistPack16DecoderImpl(
   _GistPack16DecoderKernel<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(input_data, output_data, (CUDA_LONG)N);
 }
 
+#if CUDA_VERSION >= 11000
+template <typename T>
+void GistPackBf16EncoderImpl(
+    cudaStream_t stream,
+    const T* input_data,
+    nv_bfloat16* output_data,
+    const size_t N) {
+  int blocksPerGrid = (int)(ceil(static_cast<float>(N) / GridDim::maxThreadsPerBlock));
+
+  _GistPackBf16EncoderKernel<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(input_data, output_data, (CUDA_LONG)N);
+}
+
+template <typename T>
+void GistPackBf16DecoderImpl(
+    cudaStream_t stream,
+    const nv_bfloat16* input_data,
+    T* output_data,
+    const size_t N) {
+  int blocksPerGrid = (int)(ceil(static_cast<float>(N) / GridDim::maxThreadsPerBlock));
+
+  _GistPackBf16DecoderKernel<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(input_data, output_data, (CUDA_LONG)N);
+}
+#endif
+
 template <typename T>
 void GistPackMsfp15EncoderImpl(
     cudaStream_t stream,
@@ -565,6 +609,11 @@ SPECIALIZED_IMPL_PACK16_ENC(float)
 
 SPECIALIZED_IMPL_PACK16_DEC(float)
 
+#if CUDA_VERSION >= 11000
+template void GistPackBf16EncoderImpl<float>(cudaStream_t stream, const float* input_data, nv_bfloat16* output_data, const size_t N);
+template void GistPackBf16DecoderImpl<float>(cudaStream_t stream, const nv_bfloat16* input_data, float* output_data, const size_t N);
+#endif
+
 SPECIALIZED_IMPL_PACKMSFP15_ENC(float)
 
 SPECIALIZED_IMPL_PACKMSFP15_DEC(float)
@@ -66,6 +66,22 @@ void GistPack16DecoderImpl(
     T* output_data,
     const size_t nums_of_elements);
 
+#if CUDA_VERSION >= 11000
+template <typename T>
+void GistPackBf16EncoderImpl(
+    cudaStream_t stream,
+    const T* input_data,
+    nv_bfloat16* output_data,
+    const size_t nums_of_elements);
+
+template <typename T>
+void GistPackBf16DecoderImpl(
+    cudaStream_t stream,
+    const nv_bfloat16* input_data,
+    T* output_data,
+    const size_t nums_of_elements);
+#endif
+
 template <typename T>
 void GistPackMsfp15EncoderImpl(
     cudaStream_t stream,
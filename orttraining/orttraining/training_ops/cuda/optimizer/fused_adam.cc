@@ -0,0 +1,253 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <map>
+#include <tuple>
+#include "orttraining/training_ops/cuda/optimizer/common.h"
+#include "orttraining/training_ops/cuda/optimizer/adam.h"
+#include "orttraining/training_ops/cuda/optimizer/fused_adam.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+std::vector<std::pair<int, int>> GenerateFusedAdamAliasMapping() {
+  // Starting index of grouped inputs.
+  constexpr int input_index_bias = 5;
+  // Starting index of grouped outputs.
+  constexpr int output_index_bias = 1;
+  // Count of I/O groups. One group corresponds to a weight update.
+  constexpr int group_count = 1024;
+  // length of [w, g, m1, m2, w_mixed_precision] and [w_new, g_new, m1_new, m2_new, w_mixed_precision_new].
+  constexpr int group_size = 5;
+
+  std::vector<std::pair<int, int>> alias_pairs{};
+  for (int i = 0; i < group_count; ++i) {
+    for (int j = 0; j < group_size; ++j) {
+      alias_pairs.emplace_back(std::make_pair(input_index_bias + i * group_size + j,
+                                              output_index_bias + i * group_size + j));
+    }
+  }
+
+  // update_count is updated in place.
+  alias_pairs.emplace_back(std::make_pair(4, 0));
+
+  return alias_pairs;
+}
+
+#define REGISTER_FUSED_ADAM_KERNEL_TYPED(T1, T2, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP)    \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                       \
+      FusedAdamOptimizer,                                                                              \
+      kMSDomain,                                                                                       \
+      1,                                                                                               \
+      T1##_##T2##_##T3##_##T4##_##T_GRAD##_##T_GRAD_NORM##_##T_MIXED_PRECISION_FP,                     \
+      kCudaExecutionProvider,                                                                          \
+      KernelDefBuilder()                                                                               \
+          .Alias(GenerateFusedAdamAliasMapping())                                                      \
+          .InputMemoryType<OrtMemTypeCPUInput>(0)   /* Keep do_update in CPU */                        \
+          .InputMemoryType<OrtMemTypeCPUInput>(4)   /* Keep update count in CPU */                     \
+          .OutputMemoryType<OrtMemTypeCPUOutput>(0) /* Keep update count in CPU */                     \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T1>())                                     \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T2>())                                     \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<T3>())                                     \
+          .TypeConstraint("T4", DataTypeImpl::GetTensorType<T4>())                                     \
+          .TypeConstraint("T_GRAD", DataTypeImpl::GetTensorType<T_GRAD>())                             \
+          .TypeConstraint("T_MIXED_PRECISION_FP", DataTypeImpl::GetTensorType<T_MIXED_PRECISION_FP>()) \
+          .TypeConstraint("T_GRAD_NORM", DataTypeImpl::GetTensorType<T_GRAD_NORM>()),                  \
+      FusedAdamOptimizer<T1, T2, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>);
+
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, float, float, float, MLFloat16)
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, float, MLFloat16, MLFloat16, MLFloat16)
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, float, MLFloat16, float, MLFloat16)
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, MLFloat16, MLFloat16, MLFloat16, MLFloat16)
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, MLFloat16, MLFloat16, float, MLFloat16)
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, float, float, float, BFloat16)
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, float, BFloat16, BFloat16, BFloat16)
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, float, BFloat16, float, BFloat16)
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, BFloat16, BFloat16, BFloat16, BFloat16)
+REGISTER_FUSED_ADAM_KERNEL_TYPED(float, int64_t, float, BFloat16, BFloat16, float, BFloat16)
+#endif
+
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+Status FusedAdamOptimizer<T1, T2, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>::ComputeInternal(OpKernelContext* ctx) const {
+  typedef typename ToCudaType<T1>::MappedType CudaT1;
+  typedef typename ToCudaType<T3>::MappedType CudaT3;
+  typedef typename ToCudaType<T4>::MappedType CudaT4;
+  typedef typename ToCudaType<T_GRAD>::MappedType CudaT_GRAD;
+  typedef typename ToCudaType<T_GRAD_NORM>::MappedType CudaT_GRAD_NORM;
+  typedef typename ToCudaType<T_MIXED_PRECISION_FP>::MappedType CudaT_MIXED_PRECISION_FP;
+
+  constexpr int non_grouped_input_count = 5;
+  constexpr int non_grouped_output_count = 1;
+  constexpr int group_size = 5;
+  const int grouped_input_tensor_count = ctx->InputCount() - non_grouped_input_count;
+  const int grouped_output_tensor_count = ctx->OutputCount() - non_grouped_output_count;
+
+  // Inputs after the first non_grouped_input_count ones are repeated sequences of [w, g, m1, m2, w_mixed_precision].
+  // Trailing optional tensors of the last group may be omitted.
+  const int group_count = (grouped_input_tensor_count + group_size - 1) / group_size;
+  ORT_ENFORCE(
+      group_count > 0,
+      "Input count must be ", non_grouped_input_count, " + ", group_size,
+      " x (number of weights to optimize).");
+  ORT_ENFORCE(
+      group_count == (grouped_output_tensor_count + group_size - 1) / group_size,
+      "Input and output tensor counts are not aligned. Please check FusedAdamOptimizer's input and output lists.");
+
+  ORT_ENFORCE(alpha_.size() >= static_cast<size_t>(group_count));
+  ORT_ENFORCE(beta_.size() >= static_cast<size_t>(group_count));
+  ORT_ENFORCE(lambda_.size() >= static_cast<size_t>(group_count));
+  ORT_ENFORCE(epsilon_.size() >= static_cast<size_t>(group_count));
+  ORT_ENFORCE(max_norm_clip_.size() >= static_cast<size_t>(group_count));
+
+  const Tensor* do_update_tensor = ctx->Input<Tensor>(0);
+  const bool do_update = do_update_tensor == nullptr || *(do_update_tensor->template Data<bool>());
+
+  const CudaT3* loss_scale = nullptr;
+  if (ctx->Input<Tensor>(1)) {
+    loss_scale = reinterpret_cast<const CudaT3*>(ctx->Input<Tensor>(1)->template Data<T3>());
+  }
+
+  const CudaT_GRAD_NORM* grad_norm = nullptr;
+  if (ctx->Input<Tensor>(2)) {
+    grad_norm = reinterpret_cast<const CudaT_GRAD_NORM*>(ctx->Input<Tensor>(2)->template Data<T_GRAD_NORM>());
+  }
+
+  const CudaT1* eta = reinterpret_cast<const CudaT1*>(ctx->Input<Tensor>(3)->template Data<T1>());
+
+  const Tensor& S = *ctx->Input<Tensor>(4);
+  const T2 update_count = *S.template Data<T2>();
+
+  constexpr int tensor_count_per_group = 7;
+  const int max_tensor_size = compute_max_tensor_size_per_launch<tensor_count_per_group>(4);
+  // Bucketize tensor groups by the associated optimizer configuration.
+  // If two tensor groups use different "alpha", they should be put into two distinct buckets.
+  std::map<std::tuple<float, float, float, float, float>, std::vector<std::vector<void*>>> buckets;
+  std::map<std::tuple<float, float, float, float, float>, std::vector<int>> tensor_sizes_in_buckets;
+
+  for (int group_index = 0; group_index < group_count; ++group_index) {
+    const int input_start_index = non_grouped_input_count + group_index * group_size;
+    const Tensor& W = *ctx->Input<Tensor>(input_start_index);
+    const Tensor& G = *ctx->Input<Tensor>(input_start_index + 1);
+    const Tensor& M1 = *ctx->Input<Tensor>(input_start_index + 2);
+    const Tensor& M2 = *ctx->Input<Tensor>(input_start_index + 3);
+    const Tensor* W_MIXED_FP = ctx->Input<Tensor>(input_start_index + 4);
+
+    const int output_start_index = non_grouped_output_count + group_index * group_size;
+    Tensor* NW = ctx->Output(output_start_index, W.Shape());
+    Tensor* NG = ctx->Output(output_start_index + 1, G.Shape());
+    Tensor& NM1 = *ctx->Output(output_start_index + 2, M1.Shape());
+    Tensor& NM2 = *ctx->Output(output_start_index + 3, M2.Shape());
+    Tensor* NW_MIXED_FP = W_MIXED_FP != nullptr ? ctx->Output(output_start_index + 4, W_MIXED_FP->Shape()) : nullptr;
+
+    // TODO: temporary hack until View is improved (it doesn't work with Alias)
+    if (NW != nullptr)
+      NW->SetByteOffset(W.ByteOffset());
+    if (NG != nullptr)
+      NG->SetByteOffset(G.ByteOffset());
+    if (NW_MIXED_FP != nullptr)
+      NW_MIXED_FP->SetByteOffset(W_MIXED_FP->ByteOffset());
+
+    // The momentums are updated in place.
+    ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T4>(Stream(), M1, NM1));
+    ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T4>(Stream(), M2, NM2));
+
+    if (!do_update) {
+      if (NW != nullptr) {
+        ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T3>(Stream(), W, *NW));
+      }
+      if (NG != nullptr) {
+        ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T_GRAD>(Stream(), G, *NG));
+      }
+      if (NW_MIXED_FP != nullptr) {
+        ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T_MIXED_PRECISION_FP>(Stream(), *W_MIXED_FP, *NW_MIXED_FP));
+      }
+      continue;
+    }
+
+    ORT_ENFORCE(W.Shape().Size() < static_cast<int64_t>(std::numeric_limits<int>::max()));
+    const int tensor_size = static_cast<int>(W.Shape().Size());
+
+    CudaT4* m1_new = reinterpret_cast<CudaT4*>(NM1.template MutableData<T4>());
+    CudaT4* m2_new = reinterpret_cast<CudaT4*>(NM2.template MutableData<T4>());
+    CudaT3* w_new = NW != nullptr ? reinterpret_cast<CudaT3*>(NW->template MutableData<T3>()) : nullptr;
+    CudaT_GRAD* g_new = NG != nullptr ? reinterpret_cast<CudaT_GRAD*>(NG->template MutableData<T_GRAD>()) : nullptr;
+    CudaT_MIXED_PRECISION_FP* w_mixed_precision_new =
+        NW_MIXED_FP != nullptr ? reinterpret_cast<CudaT_MIXED_PRECISION_FP*>(NW_MIXED_FP->template MutableData<T_MIXED_PRECISION_FP>()) : nullptr;
+
+    if (tensor_size > max_tensor_size) {
+      AdamOptimizerImpl(
+          Stream(),
+          eta,
+          update_count,
+          reinterpret_cast<const CudaT3*>(W.template Data<T3>()),
+          reinterpret_cast<const CudaT_GRAD*>(G.template Data<T_GRAD>()),
+          m1_new,
+          m2_new,
+          loss_scale,
+          grad_norm,
+          alpha_[group_index],
+          beta_[group_index],
+          lambda_[group_index],
+          epsilon_[group_index],
+          max_norm_clip_[group_index],
+          do_bias_correction_,
+          weight_decay_mode_,
+          m1_new,
+          m2_new,
+          w_new,
+          g_new,
+          w_mixed_precision_new,
+          tensor_size);
+    } else {
+      std::vector<void*> ptrs(tensor_count_per_group);
+      ptrs[0] = const_cast<T3*>(W.template Data<T3>());
+      ptrs[1] = const_cast<T_GRAD*>(G.template Data<T_GRAD>());
+      ptrs[2] = m1_new;
+      ptrs[3] = m2_new;
+      ptrs[4] = w_new;
+      ptrs[5] = g_new;
+      ptrs[6] = w_mixed_precision_new;
+
+      auto key = std::make_tuple(alpha_[group_index], beta_[group_index], lambda_[group_index],
+                                 epsilon_[group_index], max_norm_clip_[group_index]);
+      buckets[key].push_back(ptrs);
+      tensor_sizes_in_buckets[key].push_back(tensor_size);
+    }
+  }
+
+  for (auto& pair : buckets) {
+    const auto key = pair.first;
+    float alpha = 0.f, beta = 0.f, lambda = 0.f, epsilon = 0.f, max_norm = 0.f;
+    std::tie(alpha, beta, lambda, epsilon, max_norm) = key;
+
+    // If bias correction coefficients are set to 1s, it's equivalent to disabling bias correction.
+    const float alpha_correction =
+        do_bias_correction_ ? onnxruntime::contrib::compute_bias_correction_coefficient(alpha, update_count) : 1.f;
+    const float beta_correction =
+        do_bias_correction_ ? onnxruntime::contrib::compute_bias_correction_coefficient(beta, update_count) : 1.f;
+
+    typedef AdamMultiTensorFunctor<CudaT1, CudaT3, CudaT4, CudaT_GRAD, CudaT_GRAD_NORM, CudaT_MIXED_PRECISION_FP> AdamFunctor;
+    AdamFunctor adam_functor;
+
+    launch_multi_tensor_functor<tensor_count_per_group, AdamFunctor>(
+        Stream(),
+        2048 * 32,
+        tensor_sizes_in_buckets[key],
+        pair.second,
+        adam_functor,
+        eta, loss_scale, grad_norm, alpha, beta, lambda, epsilon, max_norm,
+        alpha_correction, beta_correction, weight_decay_mode_);
+  }
+
+  Tensor* NS = ctx->Output(0, S.Shape());
+  if (NS != nullptr) {
+    *(NS->template MutableData<T2>()) = do_update ? update_count + 1 : update_count;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
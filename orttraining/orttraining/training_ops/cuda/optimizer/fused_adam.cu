@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "orttraining/training_ops/cuda/optimizer/common.cuh"
+#include "orttraining/training_ops/cuda/optimizer/fused_adam.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Computes the weight delta of one element, see _AdamOptimizer_mode0 and _AdamOptimizer_mode1
+// in adam.cu for the two weight decay modes.
+__device__ __forceinline__ float _AdamComputeDeltaRule(
+    const float eta,
+    const float w,
+    const float g,
+    const float alpha,
+    const float beta,
+    const float lambda,
+    const float epsilon,
+    const float alpha_correction,
+    const float beta_correction,
+    const int64_t weight_decay_mode,
+    float& m1,
+    float& m2) {
+  const float one = 1.0f;
+  m1 = alpha * m1 + (one - alpha) * g;
+  m2 = beta * m2 + (one - beta) * g * g;
+
+  if (weight_decay_mode == 0) {
+    const float denom = _Sqrt(m2 / beta_correction) + epsilon;
+    return -eta * ((m1 / alpha_correction) / denom + lambda * w);
+  }
+
+  const float denom = _Sqrt(m2) + epsilon;
+  const float step_size = eta * _Sqrt(beta_correction) / alpha_correction;
+  return -step_size * m1 / denom - eta * lambda * (w - step_size * m1 / denom);
+}
+
+template <typename T1, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+__global__ void AdamMultiTensorImpl(
+    ChunkGroup<7> chunk_group,
+    const T1* eta,
+    const T3* loss_scale,
+    const T_GRAD_NORM* grad_norm,
+    const float alpha,
+    const float beta,
+    const float lambda,
+    const float epsilon,
+    const float max_norm,
+    const float alpha_correction,
+    const float beta_correction,
+    const int64_t weight_decay_mode) {
+  const int group_index = chunk_group.block_index_to_tensor_group_index[blockIdx.x];
+  const int tensor_size = chunk_group.tensor_sizes[group_index];
+  const int chunk_size = chunk_group.chunk_size;
+  const int chunk_start = chunk_group.block_index_to_chunk_start_index[blockIdx.x];
+  const T3* w = reinterpret_cast<const T3*>(chunk_group.tensor_ptrs[0][group_index]) + chunk_start;
+  const T_GRAD* g = reinterpret_cast<const T_GRAD*>(chunk_group.tensor_ptrs[1][group_index]) + chunk_start;
+  T4* m1_new = reinterpret_cast<T4*>(chunk_group.tensor_ptrs[2][group_index]) + chunk_start;
+  T4* m2_new = reinterpret_cast<T4*>(chunk_group.tensor_ptrs[3][group_index]) + chunk_start;
+  T3* w_new = reinterpret_cast<T3*>(chunk_group.tensor_ptrs[4][group_index]);
+  T_GRAD* g_new = reinterpret_cast<T_GRAD*>(chunk_group.tensor_ptrs[5][group_index]);
+  T_MIXED_PRECISION_FP* w_mixed_precision_new = reinterpret_cast<T_MIXED_PRECISION_FP*>(chunk_group.tensor_ptrs[6][group_index]);
+  const float scale = _ComputeGradScale<T3, T_GRAD_NORM, float>(loss_scale, grad_norm, max_norm);
+  const float lr = static_cast<float>(*eta);
+
+#pragma unroll
+  for (int i = threadIdx.x; i < chunk_size && i + chunk_start < tensor_size; i += blockDim.x) {
+    float m1 = static_cast<float>(m1_new[i]);
+    float m2 = static_cast<float>(m2_new[i]);
+    const float delta = _AdamComputeDeltaRule(
+        lr,
+        static_cast<float>(w[i]),
+        static_cast<float>(g[i]) / scale,
+        alpha,
+        beta,
+        lambda,
+        epsilon,
+        alpha_correction,
+        beta_correction,
+        weight_decay_mode,
+        m1,
+        m2);
+
+    if (g_new) {
+      g_new[chunk_start + i] = T_GRAD(delta);
+    }
+
+    if (w_new) {
+      const T3 w_updated = w[i] + T3(delta);
+      w_new[chunk_start + i] = w_updated;
+      if (w_mixed_precision_new) {
+        w_mixed_precision_new[chunk_start + i] = static_cast<T_MIXED_PRECISION_FP>(w_updated);
+      }
+    }
+
+    m1_new[i] = T4(m1);
+    m2_new[i] = T4(m2);
+  }
+}
+
+template <typename T1, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+void AdamMultiTensorFunctor<T1, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>::operator()(
+    cudaStream_t stream,
+    ChunkGroup<7> chunk_group,
+    const T1* eta,
+    const T3* loss_scale,
+    const T_GRAD_NORM* grad_norm,
+    const float alpha,
+    const float beta,
+    const float lambda,
+    const float epsilon,
+    const float max_norm,
+    const float alpha_correction,
+    const float beta_correction,
+    const int64_t weight_decay_mode) {
+  const int thread_count = ChunkGroup<7>::thread_count_per_block;
+  const int block_count = chunk_group.chunk_count;
+
+  AdamMultiTensorImpl<T1, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP><<<block_count, thread_count, 0, stream>>>(
+      chunk_group,
+      eta,
+      loss_scale,
+      grad_norm,
+      alpha,
+      beta,
+      lambda,
+      epsilon,
+      max_norm,
+      alpha_correction,
+      beta_correction,
+      weight_decay_mode);
+}
+
+#define INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(T1, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP)       \
+  template void AdamMultiTensorFunctor<T1, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>::operator()( \
+      cudaStream_t stream,                                                                                 \
+      ChunkGroup<7> chunk_group,                                                                           \
+      const T1* eta,                                                                                       \
+      const T3* loss_scale,                                                                                \
+      const T_GRAD_NORM* grad_norm,                                                                        \
+      const float alpha,                                                                                   \
+      const float beta,                                                                                    \
+      const float lambda,                                                                                  \
+      const float epsilon,                                                                                 \
+      const float max_norm,                                                                                \
+      const float alpha_correction,                                                                        \
+      const float beta_correction,                                                                         \
+      const int64_t weight_decay_mode);
+
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, float, float, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, half, half, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, half, float, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, half, half, half, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, half, half, float, half)
+
+#if CUDA_VERSION >= 11000 && (__CUDA_ARCH__ >= 800 || !defined(__CUDA_ARCH__))
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, float, float, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, nv_bfloat16, nv_bfloat16, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, nv_bfloat16, float, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, nv_bfloat16, nv_bfloat16, nv_bfloat16, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, nv_bfloat16, nv_bfloat16, float, nv_bfloat16)
+#endif
+
+}  // namespace cuda
+}  // namespace onnxruntime
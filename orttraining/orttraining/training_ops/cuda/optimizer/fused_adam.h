@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/common/common.h"
+#include "core/providers/cuda/cuda_kernel.h"
+#include "core/providers/cuda/multi_tensor/common.cuh"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Adam over all the weights of a model in one node. Small weights are grouped into
+// multi-tensor launches, one per distinct set of hyperparameters, and weights too large
+// for a multi-tensor launch fall back to AdamOptimizerImpl.
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+class FusedAdamOptimizer final : public CudaKernel {
+ public:
+  FusedAdamOptimizer(const OpKernelInfo& info) : CudaKernel(info) {
+    alpha_ = info.GetAttrsOrDefault("alpha", std::vector<float>(1024, 0.9f));
+    beta_ = info.GetAttrsOrDefault("beta", std::vector<float>(1024, 0.999f));
+    lambda_ = info.GetAttrsOrDefault("lambda", std::vector<float>(1024, 0.0f));
+    epsilon_ = info.GetAttrsOrDefault("epsilon", std::vector<float>(1024, 1e-8f));
+    max_norm_clip_ = info.GetAttrsOrDefault("max_norm_clip", std::vector<float>(1024, 1.0f));
+    for (const auto& max_norm : max_norm_clip_) {
+      ORT_ENFORCE(max_norm != 0, "max_norm_clip must NOT be 0.");
+    }
+
+    int64_t tmp_flag = static_cast<int64_t>(0);
+    ORT_ENFORCE(info.GetAttr<int64_t>("do_bias_correction", &tmp_flag).IsOK(), "Missing/Invalid do_bias_correction");
+    ORT_ENFORCE(tmp_flag == 0 || tmp_flag == 1, "do_bias_correction must be either 0 or 1.");
+    do_bias_correction_ = tmp_flag != 0 ? true : false;
+    info.GetAttrOrDefault("weight_decay_mode", &weight_decay_mode_, static_cast<int64_t>(0));
+    ORT_ENFORCE(weight_decay_mode_ == 0 || weight_decay_mode_ == 1, "Unsupported Adamw optimizer mode.");
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  std::vector<float> alpha_;
+  std::vector<float> beta_;
+  std::vector<float> lambda_;
+  std::vector<float> epsilon_;
+  std::vector<float> max_norm_clip_;
+  bool do_bias_correction_;
+  int64_t weight_decay_mode_;
+};
+
+// Adam's multi-tensor update maps [w, g, m1, m2] to [w_new, g_new, m1_new, m2_new, w_mixed_precision_new].
+// The momentums are updated in place, so callers copy m1 and m2 to m1_new and m2_new first
+// if they do not share buffers. There are 7 distinct tensors in total and therefore the
+// type of chunk_group is ChunkGroup<7>.
+//
+// Tensor pointers associated with the i-th tensor in this chunk:
+//  w: chunk_group.tensor_ptrs[0][i]
+//  g: chunk_group.tensor_ptrs[1][i]
+//  m1_new: chunk_group.tensor_ptrs[2][i]
+//  m2_new: chunk_group.tensor_ptrs[3][i]
+//  w_new (nullable): chunk_group.tensor_ptrs[4][i]
+//  g_new (nullable): chunk_group.tensor_ptrs[5][i]
+//  w_mixed_precision_new (nullable): chunk_group.tensor_ptrs[6][i]
+template <typename T1, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+struct AdamMultiTensorFunctor {
+  void operator()(
+      cudaStream_t stream,
+      ChunkGroup<7> chunk_group,
+      const T1* eta,
+      const T3* loss_scale,
+      const T_GRAD_NORM* grad_norm,
+      const float alpha,
+      const float beta,
+      const float lambda,
+      const float epsilon,
+      const float max_norm,
+      const float alpha_correction,
+      const float beta_correction,
+      const int64_t weight_decay_mode);
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
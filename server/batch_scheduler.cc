@@ -0,0 +1,296 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "batch_scheduler.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Returns the size in bytes of a tensor element, or 0 if the type cannot be batched by copying bytes.
+static size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+BatchScheduler::BatchScheduler(const Ort::Session& session, const BatchingOptions& options)
+    : session_(session), options_(options), worker_([this]() { ProcessBatches(); }) {
+}
+
+BatchScheduler::~BatchScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+std::vector<Ort::Value> BatchScheduler::RunSingle(const Ort::RunOptions& run_options,
+                                                  const std::vector<std::string>& input_names,
+                                                  const std::vector<Ort::Value>& input_values,
+                                                  const std::vector<std::string>& output_names) const {
+  std::vector<const char*> input_ptrs;
+  input_ptrs.reserve(input_names.size());
+  for (const auto& name : input_names) {
+    input_ptrs.push_back(name.c_str());
+  }
+  std::vector<const char*> output_ptrs;
+  output_ptrs.reserve(output_names.size());
+  for (const auto& name : output_names) {
+    output_ptrs.push_back(name.c_str());
+  }
+
+  return const_cast<Ort::Session&>(session_).Run(run_options, input_ptrs.data(), input_values.data(), input_ptrs.size(),
+                                                 output_ptrs.data(), output_ptrs.size());
+}
+
+void BatchScheduler::RunIndividually(std::vector<std::unique_ptr<Request>>& batch) const {
+  for (auto& request : batch) {
+    try {
+      request->result.set_value(RunSingle(*request->run_options, *request->input_names, *request->input_values,
+                                          *request->output_names));
+    } catch (...) {
+      request->result.set_exception(std::current_exception());
+    }
+  }
+}
+
+// Computes the batch size and compatibility signature of a request.
+// Returns false if the request cannot be combined with other requests.
+bool BatchScheduler::PrepareRequest(Request& request) const {
+  const auto& input_names = *request.input_names;
+  const auto& input_values = *request.input_values;
+  if (input_names.empty()) {
+    return false;
+  }
+
+  request.input_order.resize(input_names.size());
+  std::iota(request.input_order.begin(), request.input_order.end(), size_t{0});
+  std::sort(request.input_order.begin(), request.input_order.end(),
+            [&input_names](size_t a, size_t b) { return input_names[a] < input_names[b]; });
+
+  request.batch_size = -1;
+  std::string& signature = request.signature;
+  for (size_t index : request.input_order) {
+    const auto& value = input_values[index];
+    if (!value.IsTensor()) {
+      return false;
+    }
+
+    auto type_and_shape = value.GetTensorTypeAndShapeInfo();
+    const auto element_type = type_and_shape.GetElementType();
+    const auto shape = type_and_shape.GetShape();
+    if (shape.empty() || GetElementSize(element_type) == 0) {
+      return false;
+    }
+
+    // All inputs must share the leading batch dimension.
+    if (request.batch_size == -1) {
+      request.batch_size = shape[0];
+    } else if (request.batch_size != shape[0]) {
+      return false;
+    }
+
+    signature += input_names[index];
+    signature += ':';
+    signature += std::to_string(static_cast<int>(element_type));
+    for (size_t i = 1; i < shape.size(); i++) {
+      signature += ',';
+      signature += std::to_string(shape[i]);
+    }
+    signature += ';';
+  }
+
+  signature += '|';
+  for (const auto& name : *request.output_names) {
+    signature += name;
+    signature += ';';
+  }
+
+  return request.batch_size > 0 && static_cast<size_t>(request.batch_size) < options_.max_batch_size;
+}
+
+std::vector<Ort::Value> BatchScheduler::Run(const Ort::RunOptions& run_options,
+                                            const std::vector<std::string>& input_names,
+                                            const std::vector<Ort::Value>& input_values,
+                                            const std::vector<std::string>& output_names) {
+  auto request = std::make_unique<Request>();
+  request->run_options = &run_options;
+  request->input_names = &input_names;
+  request->input_values = &input_values;
+  request->output_names = &output_names;
+
+  if (!PrepareRequest(*request)) {
+    return RunSingle(run_options, input_names, input_values, output_names);
+  }
+
+  auto result = request->result.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    request->enqueue_time = std::chrono::steady_clock::now();
+    pending_.push_back(std::move(request));
+  }
+  cv_.notify_all();
+
+  // The inputs are owned by the caller, which stays blocked here until the batch has run.
+  return result.get();
+}
+
+size_t BatchScheduler::PendingBatchSize(const std::string& signature) const {
+  size_t total = 0;
+  for (const auto& request : pending_) {
+    if (request->signature == signature) {
+      total += static_cast<size_t>(request->batch_size);
+    }
+  }
+  return total;
+}
+
+void BatchScheduler::ProcessBatches() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this]() { return shutdown_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      return;
+    }
+
+    // Wait for the batch of the oldest request to fill up or for its timeout to expire.
+    const std::string signature = pending_.front()->signature;
+    const auto deadline = pending_.front()->enqueue_time + options_.batch_timeout;
+    cv_.wait_until(lock, deadline, [this, &signature]() {
+      return shutdown_ || PendingBatchSize(signature) >= options_.max_batch_size;
+    });
+
+    std::vector<std::unique_ptr<Request>> batch;
+    int64_t total_batch_size = 0;
+    for (auto it = pending_.begin(); it != pending_.end();) {
+      if ((*it)->signature == signature &&
+          static_cast<size_t>(total_batch_size + (*it)->batch_size) <= options_.max_batch_size) {
+        total_batch_size += (*it)->batch_size;
+        batch.push_back(std::move(*it));
+        it = pending_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    lock.unlock();
+    RunBatch(batch, total_batch_size);
+    lock.lock();
+  }
+}
+
+void BatchScheduler::RunBatch(std::vector<std::unique_ptr<Request>>& batch, int64_t total_batch_size) {
+  const Request& head = *batch.front();
+
+  if (batch.size() == 1) {
+    RunIndividually(batch);
+    return;
+  }
+
+  std::vector<std::vector<Ort::Value>> results(batch.size());
+  bool batch_major = true;
+  try {
+    Ort::AllocatorWithDefaultOptions allocator;
+
+    // Concatenate each input along the batch dimension. The requests share a signature, so the
+    // inputs have the same names, element types and trailing dimensions in input_order.
+    std::vector<std::string> input_names;
+    std::vector<Ort::Value> input_values;
+    for (size_t i = 0; i < head.input_order.size(); i++) {
+      const size_t head_index = head.input_order[i];
+      auto type_and_shape = (*head.input_values)[head_index].GetTensorTypeAndShapeInfo();
+      const auto element_type = type_and_shape.GetElementType();
+      auto shape = type_and_shape.GetShape();
+      shape[0] = total_batch_size;
+
+      auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), element_type);
+      auto* dst = value.GetTensorMutableData<uint8_t>();
+      for (const auto& request : batch) {
+        const auto& src = (*request->input_values)[request->input_order[i]];
+        const size_t bytes = src.GetTensorTypeAndShapeInfo().GetElementCount() * GetElementSize(element_type);
+        std::memcpy(dst, src.GetTensorData<uint8_t>(), bytes);
+        dst += bytes;
+      }
+
+      input_names.push_back((*head.input_names)[head_index]);
+      input_values.push_back(std::move(value));
+    }
+
+    auto outputs = RunSingle(*head.run_options, input_names, input_values, *head.output_names);
+
+    // Split each output back along the batch dimension.
+    for (const auto& output : outputs) {
+      if (!output.IsTensor()) {
+        batch_major = false;
+        break;
+      }
+      auto type_and_shape = output.GetTensorTypeAndShapeInfo();
+      const auto shape = type_and_shape.GetShape();
+      if (shape.empty() || shape[0] != total_batch_size || GetElementSize(type_and_shape.GetElementType()) == 0) {
+        batch_major = false;
+        break;
+      }
+    }
+
+    if (batch_major) {
+      for (auto& output : outputs) {
+        auto type_and_shape = output.GetTensorTypeAndShapeInfo();
+        const auto element_type = type_and_shape.GetElementType();
+        auto shape = type_and_shape.GetShape();
+        const size_t row_bytes =
+            type_and_shape.GetElementCount() / static_cast<size_t>(total_batch_size) * GetElementSize(element_type);
+
+        const auto* src = output.GetTensorData<uint8_t>();
+        for (size_t r = 0; r < batch.size(); r++) {
+          shape[0] = batch[r]->batch_size;
+          auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), element_type);
+          const size_t bytes = row_bytes * static_cast<size_t>(batch[r]->batch_size);
+          std::memcpy(value.GetTensorMutableData<uint8_t>(), src, bytes);
+          src += bytes;
+          results[r].push_back(std::move(value));
+        }
+      }
+    }
+  } catch (...) {
+    for (auto& request : batch) {
+      request->result.set_exception(std::current_exception());
+    }
+    return;
+  }
+
+  if (!batch_major) {
+    RunIndividually(batch);
+    return;
+  }
+
+  for (size_t r = 0; r < batch.size(); r++) {
+    batch[r]->result.set_value(std::move(results[r]));
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+struct BatchingOptions {
+  // Maximum number of rows along the batch dimension that are run together.
+  // A value of 0 or 1 disables batching.
+  size_t max_batch_size = 0;
+
+  // Maximum time the oldest pending request waits for other requests to join its batch.
+  std::chrono::microseconds batch_timeout{1000};
+
+  bool Enabled() const { return max_batch_size > 1; }
+};
+
+// Collects concurrent Predict requests for one session and runs them as a single batch.
+//
+// Requests are compatible when they have the same input names, element types and dimensions
+// other than the leading batch dimension, and request the same outputs. A batch is run once the
+// pending compatible requests fill max_batch_size rows or the oldest request has waited for
+// batch_timeout. The inputs are concatenated along dimension 0 and the outputs are split back
+// along dimension 0. Requests that cannot be batched, and batches whose outputs are not batch
+// major, are run individually.
+class BatchScheduler {
+ public:
+  BatchScheduler(const Ort::Session& session, const BatchingOptions& options);
+  ~BatchScheduler();
+
+  BatchScheduler(const BatchScheduler&) = delete;
+  BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+  // Runs the request as part of a batch and blocks until its outputs are available.
+  // Throws Ort::Exception on failure, like Ort::Session::Run.
+  std::vector<Ort::Value> Run(const Ort::RunOptions& run_options,
+                              const std::vector<std::string>& input_names,
+                              const std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names);
+
+ private:
+  struct Request {
+    const Ort::RunOptions* run_options;
+    const std::vector<std::string>* input_names;
+    const std::vector<Ort::Value>* input_values;
+    const std::vector<std::string>* output_names;
+    // Indices of the inputs sorted by name so the order of the request map does not matter.
+    std::vector<size_t> input_order;
+    std::string signature;
+    int64_t batch_size;
+    std::chrono::steady_clock::time_point enqueue_time;
+    std::promise<std::vector<Ort::Value>> result;
+  };
+
+  bool PrepareRequest(Request& request) const;
+  size_t PendingBatchSize(const std::string& signature) const;
+  void ProcessBatches();
+  void RunBatch(std::vector<std::unique_ptr<Request>>& batch, int64_t total_batch_size);
+  void RunIndividually(std::vector<std::unique_ptr<Request>>& batch) const;
+  std::vector<Ort::Value> RunSingle(const Ort::RunOptions& run_options,
+                                    const std::vector<std::string>& input_names,
+                                    const std::vector<Ort::Value>& input_values,
+                                    const std::vector<std::string>& output_names) const;
+
+  const Ort::Session& session_;
+  const BatchingOptions options_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::list<std::unique_ptr<Request>> pending_;
+  bool shutdown_{false};
+  std::thread worker_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -18,6 +18,8 @@ std::string InternalRequestId() {
 }
 const std::string MS_REQUEST_ID_HEADER = "x-ms-request-id";
 const std::string MS_CLIENT_REQUEST_ID_HEADER = "x-ms-client-request-id";
+const std::string MS_REQUEST_PRIORITY_HEADER = "x-ms-request-priority";
+const std::string MS_REQUEST_TIMEOUT_HEADER = "x-ms-request-timeout-ms";
 }  // namespace util
 }  // namespace server
 }  // namespace onnxruntime
\ No newline at end of file
@@ -11,6 +11,10 @@ namespace util {
 std::string InternalRequestId();
 extern const std::string MS_REQUEST_ID_HEADER;
 extern const std::string MS_CLIENT_REQUEST_ID_HEADER;
+// Integer priority of the request, larger values are served first.
+extern const std::string MS_REQUEST_PRIORITY_HEADER;
+// Time in milliseconds after which the request is dropped if it has not started running.
+extern const std::string MS_REQUEST_TIMEOUT_HEADER;
 }  // namespace util
 }  // namespace server
 }  // namespace onnxruntime
\ No newline at end of file
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <memory>
 #include "environment.h"
 #include "onnxruntime_cxx_api.h"
@@ -50,17 +51,44 @@ void ORT_API_CALL Log(void* param, OrtLoggingLevel severity, const char* categor
   return;
 }
 
-ServerEnvironment::ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink) : severity_(severity),
-                                                                                               logger_id_("ServerApp"),
-                                                                                               sink_(sink),
-                                                                                               default_logger_(std::make_shared<spdlog::logger>(logger_id_, sink)),
-                                                                                               runtime_environment_(severity, logger_id_.c_str(), Log, default_logger_.get()) {
+static Ort::Env CreateRuntimeEnvironment(OrtLoggingLevel severity, const std::string& logger_id, spdlog::logger* logger,
+                                         const ThreadingOptions& threading_options) {
+  if (!threading_options.use_global_thread_pools) {
+    return Ort::Env(severity, logger_id.c_str(), Log, logger);
+  }
+
+  const auto& api = Ort::GetApi();
+  OrtThreadingOptions* tp_options = nullptr;
+  Ort::ThrowOnError(api.CreateThreadingOptions(&tp_options));
+  std::unique_ptr<OrtThreadingOptions, decltype(api.ReleaseThreadingOptions)> tp_options_holder(tp_options, api.ReleaseThreadingOptions);
+  Ort::ThrowOnError(api.SetGlobalIntraOpNumThreads(tp_options, threading_options.intra_op_num_threads));
+  Ort::ThrowOnError(api.SetGlobalInterOpNumThreads(tp_options, threading_options.inter_op_num_threads));
+  Ort::ThrowOnError(api.SetGlobalSpinControl(tp_options, threading_options.allow_spinning ? 1 : 0));
+  return Ort::Env(tp_options, Log, logger, severity, logger_id.c_str());
+}
+
+ServerEnvironment::ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink,
+                                     const ThreadingOptions& threading_options) : severity_(severity),
+                                                                                  logger_id_("ServerApp"),
+                                                                                  sink_(sink),
+                                                                                  default_logger_(std::make_shared<spdlog::logger>(logger_id_, sink)),
+                                                                                  runtime_environment_(CreateRuntimeEnvironment(severity, logger_id_, default_logger_.get(), threading_options)) {
   spdlog::set_automatic_registration(false);
   spdlog::set_level(Convert(severity_));
   spdlog::initialize_logger(default_logger_);
+
+  // The sessions share the pools of the environment
+  if (threading_options.use_global_thread_pools) {
+    options_.DisablePerSessionThreads();
+  }
 }
 
 void ServerEnvironment::RegisterExecutionProviders(){
+  if (execution_providers_registered_) {
+    return;
+  }
+  execution_providers_registered_ = true;
+
   #ifdef USE_DNNL
   Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_Dnnl(options_, 1));
   #endif
@@ -76,33 +104,167 @@ void ServerEnvironment::RegisterExecutionProviders(){
 
 }
 
-void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
-  RegisterExecutionProviders();
-  auto result = sessions_.emplace(std::piecewise_construct, std::forward_as_tuple(model_name, model_version), std::forward_as_tuple(runtime_environment_, model_path.c_str(), options_));
+// Runs the session with zero filled inputs, using 1 for the symbolic dimensions.
+// Models with non tensor or string inputs are not warmed up.
+void ServerEnvironment::WarmUp(SessionHolder& holder) const {
+  auto& session = holder.session;
+  const size_t input_count = session.GetInputCount();
 
-  if (!result.second) {
-    throw Ort::Exception("Model of that name already loaded.", ORT_INVALID_ARGUMENT);
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::vector<std::string> input_names;
+  std::vector<std::vector<int64_t>> input_shapes;
+  std::vector<std::vector<int64_t>> input_buffers;
+  std::vector<Ort::Value> input_values;
+  for (size_t i = 0; i < input_count; i++) {
+    auto type_info = session.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      default_logger_->info("Skipping warm-up of a model with non tensor inputs");
+      return;
+    }
+
+    auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+    const auto element_type = tensor_info.GetElementType();
+    if (element_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING ||
+        element_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
+      default_logger_->info("Skipping warm-up of a model with string inputs");
+      return;
+    }
+
+    auto shape = tensor_info.GetShape();
+    size_t element_count = 1;
+    for (auto& dim : shape) {
+      if (dim < 0) {
+        dim = 1;
+      }
+      element_count *= static_cast<size_t>(dim);
+    }
+
+    auto name = session.GetInputName(i, allocator);
+    input_names.emplace_back(name);
+    allocator.Free(name);
+
+    // int64_t elements are at least as large as any other numeric element type, so the zeros fit any of them
+    input_buffers.emplace_back(std::max<size_t>(element_count, 1), 0);
+    input_shapes.push_back(std::move(shape));
+    input_values.push_back(Ort::Value::CreateTensor(memory_info, input_buffers.back().data(),
+                                                    input_buffers.back().size() * sizeof(int64_t),
+                                                    input_shapes.back().data(), input_shapes.back().size(),
+                                                    element_type));
   }
 
-  auto iterator = result.first;
-  auto output_count = (iterator->second).session.GetOutputCount();
+  std::vector<const char*> input_ptrs;
+  for (const auto& name : input_names) {
+    input_ptrs.push_back(name.c_str());
+  }
+  std::vector<const char*> output_ptrs;
+  for (const auto& name : holder.output_names) {
+    output_ptrs.push_back(name.c_str());
+  }
+
+  Ort::RunOptions run_options{};
+  run_options.SetRunTag("warmup");
+  for (int run = 0; run < warmup_runs_; run++) {
+    try {
+      session.Run(run_options, input_ptrs.data(), input_values.data(), input_values.size(),
+                  output_ptrs.data(), output_ptrs.size());
+    } catch (const Ort::Exception& ex) {
+      // zero inputs are not valid for every model, which only costs the warm-up
+      default_logger_->warn("Model warm-up failed: {}", ex.what());
+      return;
+    }
+  }
+}
+
+std::shared_ptr<ServerEnvironment::SessionHolder> ServerEnvironment::LoadModel(const std::string& model_path, const ModelOptions& model_options) {
+  auto holder = std::make_shared<SessionHolder>(runtime_environment_, model_path, options_);
+  holder->model_options = model_options;
+  auto output_count = holder->session.GetOutputCount();
 
   Ort::AllocatorWithDefaultOptions allocator;
   for (size_t i = 0; i < output_count; i++) {
-    auto name = (iterator->second).session.GetOutputName(i, allocator);
-    (iterator->second).output_names.push_back(name);
+    auto name = holder->session.GetOutputName(i, allocator);
+    holder->output_names.push_back(name);
     allocator.Free(name);
   }
+
+  if (warmup_runs_ > 0) {
+    WarmUp(*holder);
+  }
+
+  if (batching_options_.Enabled()) {
+    holder->batch_scheduler = std::make_unique<BatchScheduler>(holder->session, batching_options_);
+  }
+
+  const size_t max_concurrent_runs = model_options.max_concurrent_runs > 0 ? model_options.max_concurrent_runs
+                                                                            : max_concurrent_runs_;
+  if (max_concurrent_runs > 0) {
+    holder->request_scheduler = std::make_unique<RequestScheduler>(max_concurrent_runs);
+  }
+
+  return holder;
 }
 
-const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
+void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version,
+                                        const ModelOptions& model_options) {
+  RegisterExecutionProviders();
+  auto holder = LoadModel(model_path, model_options);
+
+  std::lock_guard<std::mutex> lock(sessions_mutex_);
+  auto result = sessions_.emplace(std::make_pair(model_name, model_version), std::move(holder));
+
+  if (!result.second) {
+    throw Ort::Exception("Model of that name already loaded.", ORT_INVALID_ARGUMENT);
+  }
+}
+
+void ServerEnvironment::ReloadModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
+  ModelOptions model_options{};
+  {
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    auto it = sessions_.find(std::make_pair(model_name, model_version));
+    if (it != sessions_.end()) {
+      model_options = it->second->model_options;
+    }
+  }
+
+  auto holder = LoadModel(model_path, model_options);
+
+  // The previous model is destroyed when its last running request releases it, outside of the lock.
+  std::shared_ptr<SessionHolder> previous;
+  {
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    auto& current = sessions_[std::make_pair(model_name, model_version)];
+    previous = std::move(current);
+    current = std::move(holder);
+  }
+}
+
+void ServerEnvironment::SetBatchingOptions(const BatchingOptions& options) {
+  batching_options_ = options;
+}
+
+void ServerEnvironment::SetWarmupRuns(int warmup_runs) {
+  warmup_runs_ = warmup_runs;
+}
+
+void ServerEnvironment::SetMaxConcurrentRuns(size_t max_concurrent_runs) {
+  max_concurrent_runs_ = max_concurrent_runs;
+}
+
+std::shared_ptr<ServerEnvironment::SessionHolder> ServerEnvironment::GetModel(const std::string& model_name, const std::string& model_version) const {
   auto identifier = std::make_pair(model_name, model_version);
+  std::lock_guard<std::mutex> lock(sessions_mutex_);
   auto it = sessions_.find(identifier);
   if (it == sessions_.end()) {
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
 
-  return it->second.output_names;
+  return it->second;
+}
+
+const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
+  return GetModel(model_name, model_version)->output_names;
 }
 
 OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
@@ -110,13 +272,11 @@ OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
 }
 
 const Ort::Session& ServerEnvironment::GetSession(const std::string& model_name, const std::string& model_version) const {
-  auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
-    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
-  }
+  return GetModel(model_name, model_version)->session;
+}
 
-  return it->second.session;
+BatchScheduler* ServerEnvironment::GetBatchScheduler(const std::string& model_name, const std::string& model_version) const {
+  return GetModel(model_name, model_version)->batch_scheduler.get();
 }
 
 std::shared_ptr<spdlog::logger> ServerEnvironment::GetLogger(const std::string& request_id) const {
@@ -131,12 +291,17 @@ std::shared_ptr<spdlog::logger> ServerEnvironment::GetAppLogger() const {
 
 void ServerEnvironment::UnloadModel(const std::string& model_name, const std::string& model_version) {
   auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
-    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
-  }
+  std::shared_ptr<SessionHolder> previous;
+  {
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    auto it = sessions_.find(identifier);
+    if (it == sessions_.end()) {
+      throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+    }
 
-  sessions_.erase(it);
+    previous = std::move(it->second);
+    sessions_.erase(it);
+  }
 }
 
 }  // namespace server
@@ -4,9 +4,12 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "onnxruntime_cxx_api.h"
+#include "batch_scheduler.h"
+#include "request_scheduler.h"
 #include <spdlog/spdlog.h>
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
@@ -14,16 +17,68 @@
 namespace onnxruntime {
 namespace server {
 
+// Thread pools shared by all the models of the server, instead of a pair of pools per session.
+struct ThreadingOptions {
+  bool use_global_thread_pools = false;
+  // 0 uses the default number of threads.
+  int intra_op_num_threads = 0;
+  int inter_op_num_threads = 0;
+  bool allow_spinning = true;
+};
+
+// Per model settings, kept when the model is reloaded.
+struct ModelOptions {
+  // Maximum number of concurrent Runs of the model, its quota of the shared thread pools.
+  // 0 uses the value set with ServerEnvironment::SetMaxConcurrentRuns.
+  size_t max_concurrent_runs = 0;
+};
+
 class ServerEnvironment {
  public:
-  explicit ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink);
+  struct SessionHolder {
+    Ort::Session session;
+    ModelOptions model_options;
+    std::vector<std::string> output_names;
+    // Declared after the session so that it is destroyed first.
+    std::unique_ptr<BatchScheduler> batch_scheduler;
+    // Bounds the concurrent Runs of the model, or nullptr if they are not bounded.
+    std::unique_ptr<RequestScheduler> request_scheduler;
+    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
+      session = Ort::Session(env, path.c_str(), options);
+    };
+    ~SessionHolder() = default;
+    SessionHolder(const SessionHolder&) = delete;
+    SessionHolder(const SessionHolder&&) = delete;
+    SessionHolder& operator=(const SessionHolder&) = delete;
+  };
+
+  explicit ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink,
+                             const ThreadingOptions& threading_options = ThreadingOptions{});
   ~ServerEnvironment() = default;
   ServerEnvironment(const ServerEnvironment&) = delete;
 
   OrtLoggingLevel GetLogSeverity() const;
 
+  // Returns the loaded model. The model stays alive while the returned pointer is held, even if it is
+  // reloaded or unloaded in the meantime, so a request should get it once and use it throughout.
+  std::shared_ptr<SessionHolder> GetModel(const std::string& model_name, const std::string& model_version) const;
+  // The references returned by GetSession and GetModelOutputNames, and the batch scheduler, are only valid
+  // until the model is reloaded or unloaded.
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
-  void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
+  // Returns the batch scheduler of the model, or nullptr if dynamic batching is disabled.
+  BatchScheduler* GetBatchScheduler(const std::string& model_name, const std::string& model_version) const;
+  // Applies to models initialized after the call.
+  void SetBatchingOptions(const BatchingOptions& options);
+  // Number of runs with zero filled inputs done before a model serves traffic, to prime the arenas,
+  // memory patterns and execution provider caches. Applies to models initialized after the call.
+  void SetWarmupRuns(int warmup_runs);
+  // Maximum number of concurrent Runs per model, 0 means unbounded. Applies to models initialized after the call.
+  void SetMaxConcurrentRuns(size_t max_concurrent_runs);
+  void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version,
+                       const ModelOptions& model_options = ModelOptions{});
+  // Loads and warms up the model at model_path, then replaces the served model of that name and version
+  // with it. Requests already running keep the previous model until they complete.
+  void ReloadModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
@@ -31,6 +86,9 @@ class ServerEnvironment {
   void RegisterExecutionProviders();
 
  private:
+  std::shared_ptr<SessionHolder> LoadModel(const std::string& model_path, const ModelOptions& model_options);
+  void WarmUp(SessionHolder& holder) const;
+
   const OrtLoggingLevel severity_;
   const std::string logger_id_;
   const std::vector<spdlog::sink_ptr> sink_;
@@ -38,20 +96,14 @@ class ServerEnvironment {
 
   Ort::Env runtime_environment_;
   Ort::SessionOptions options_;
+  bool execution_providers_registered_{false};
+  BatchingOptions batching_options_;
+  int warmup_runs_{0};
+  size_t max_concurrent_runs_{0};
 
-  struct SessionHolder {
-    Ort::Session session;
-    std::vector<std::string> output_names;
-    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
-      session = Ort::Session(env, path.c_str(), options);
-    };
-    ~SessionHolder() = default;
-    SessionHolder(const SessionHolder&) = delete;
-    SessionHolder(const SessionHolder&&) = delete;
-    SessionHolder& operator=(const SessionHolder&) = delete;
-  };
-
-  std::unordered_map<std::pair<std::string, std::string>, ServerEnvironment::SessionHolder, boost::hash<std::pair<std::string, std::string>>> sessions_;
+  // Guards sessions_. Models are loaded and warmed up outside of the lock and only swapped in under it.
+  mutable std::mutex sessions_mutex_;
+  std::unordered_map<std::pair<std::string, std::string>, std::shared_ptr<SessionHolder>, boost::hash<std::pair<std::string, std::string>>> sessions_;
 };
 
 }  // namespace server
@@ -23,6 +23,16 @@ protobufutil::Status Executor::SetMLValue(const onnx::TensorProto& input_tensor,
                                           /* out */ Ort::Value& ml_value) {
   auto logger = env_->GetLogger(request_id_);
 
+  // Large payloads are sent in raw_data, use it in place when possible
+  try {
+    if (onnxruntime::server::TryWrapTensorProtoRawData(input_tensor, *cpu_memory_info, ml_value)) {
+      return protobufutil::Status::OK;
+    }
+  } catch (const Ort::Exception& e) {
+    logger->error("TryWrapTensorProtoRawData() failed. Error Message: {}", e.what());
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
   size_t cpu_tensor_length = 0;
   try {
     onnxruntime::server::GetSizeInBytesFromTensorProto<0>(input_tensor, &cpu_tensor_length);
@@ -116,6 +126,14 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
   run_options.SetRunLogVerbosityLevel(static_cast<int>(env_->GetLogSeverity()));
   run_options.SetRunTag(request_id_.c_str());
 
+  // Hold on to the model for the whole request, so a reload does not swap it mid request
+  std::shared_ptr<ServerEnvironment::SessionHolder> model;
+  try {
+    model = env_->GetModel(model_name, model_version);
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
   // Prepare the output names
   std::vector<std::string> output_names;
 
@@ -125,33 +143,51 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
       output_names.push_back(name);
     }
   } else {
-    output_names = env_->GetModelOutputNames(model_name, model_version);
+    output_names = model->output_names;
+  }
+
+  // Shed requests that can no longer meet their deadline instead of running them
+  const auto deadline_exceeded =
+      protobufutil::Status(protobufutil::error::Code::DEADLINE_EXCEEDED, "Request deadline exceeded before it could run");
+  RequestScheduler::Slot slot;
+  if (model->request_scheduler != nullptr) {
+    slot = model->request_scheduler->Acquire(request_options_);
+    if (!slot) {
+      logger->info("Request shed, its deadline passed while waiting to run");
+      return deadline_exceeded;
+    }
+  } else if (request_options_.DeadlineExceeded()) {
+    logger->info("Request shed, its deadline passed before it could run");
+    return deadline_exceeded;
   }
 
   std::vector<Ort::Value> outputs;
   try {
-    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    if (model->batch_scheduler != nullptr) {
+      outputs = model->batch_scheduler->Run(run_options, input_names, input_values, output_names);
+    } else {
+      outputs = Run(model->session, run_options, input_names, input_values, output_names);
+    }
   } catch (const Ort::Exception& e) {
     return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
   }
 
-  // Build the response
+  // Build the response, converting each output in place so its data is only copied once
   for (size_t i = 0, sz = outputs.size(); i < sz; ++i) {
-    onnx::TensorProto output_tensor{};
+    auto insertion_result = response.mutable_outputs()->insert({output_names[i], onnx::TensorProto{}});
+
+    if (!insertion_result.second) {
+      logger->error("SetNameMLValueMap() failed. Output name: {}. Trying to overwrite existing output value", output_names[i]);
+      return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "SetNameMLValueMap() failed: Cannot have two outputs with the same name");
+    }
+
     try {
-      MLValueToTensorProto(outputs[i], using_raw_data_, logger, output_tensor);
+      MLValueToTensorProto(outputs[i], using_raw_data_, logger, insertion_result.first->second);
     } catch (const Ort::Exception& e) {
       logger = env_->GetLogger(request_id_);
       logger->error("MLValueToTensorProto() failed. Output name: {}. Error Message: {}", output_names[i], e.what());
       return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
     }
-
-    auto insertion_result = response.mutable_outputs()->insert({output_names[i], output_tensor});
-
-    if (!insertion_result.second) {
-      logger->error("SetNameMLValueMap() failed. Output name: {}. Trying to overwrite existing output value", output_names[i]);
-      return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "SetNameMLValueMap() failed: Cannot have two outputs with the same name");
-    }
   }
 
   return protobufutil::Status::OK;
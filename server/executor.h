@@ -7,6 +7,7 @@
 
 #include "environment.h"
 #include "predict.pb.h"
+#include "request_scheduler.h"
 #include "util.h"
 #include "onnxruntime_cxx_api.h"
 
@@ -15,9 +16,11 @@ namespace server {
 
 class Executor {
  public:
-  Executor(ServerEnvironment* server_env, std::string request_id) : env_(server_env),
-                                                                    request_id_(std::move(request_id)),
-                                                                    using_raw_data_(true) {}
+  Executor(ServerEnvironment* server_env, std::string request_id,
+           RequestOptions request_options = RequestOptions{}) : env_(server_env),
+                                                                request_id_(std::move(request_id)),
+                                                                request_options_(request_options),
+                                                                using_raw_data_(true) {}
 
   // Prediction method
   google::protobuf::util::Status Predict(const std::string& model_name,
@@ -28,6 +31,7 @@ class Executor {
  private:
   ServerEnvironment* env_;
   const std::string request_id_;
+  const RequestOptions request_options_;
   bool using_raw_data_;
 
   google::protobuf::util::Status SetMLValue(const onnx::TensorProto& input_tensor,
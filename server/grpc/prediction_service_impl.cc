@@ -12,7 +12,7 @@ PredictionServiceImpl::PredictionServiceImpl(const std::shared_ptr<onnxruntime::
 
 ::grpc::Status PredictionServiceImpl::Predict(::grpc::ServerContext* context, const ::onnxruntime::server::PredictRequest* request, ::onnxruntime::server::PredictResponse* response) {
   auto request_id = SetRequestContext(context);
-  onnxruntime::server::Executor executor(environment_.get(), request_id);
+  onnxruntime::server::Executor executor(environment_.get(), request_id, GetRequestOptions(context));
   //TODO: (csteegz) Add modelspec for both paths.
   auto status = executor.Predict("default", "1", *request, *response);  // Currently only support one model so hard coded.
   if (!status.ok()) {
@@ -21,6 +21,30 @@ PredictionServiceImpl::PredictionServiceImpl(const std::shared_ptr<onnxruntime::
   return ::grpc::Status::OK;
 }
 
+RequestOptions PredictionServiceImpl::GetRequestOptions(::grpc::ServerContext* context) {
+  RequestOptions request_options{};
+
+  // The gRPC deadline is a system clock time point, the scheduler uses the steady clock
+  const auto deadline = context->deadline();
+  if (deadline != std::chrono::system_clock::time_point::max()) {
+    request_options.deadline = std::chrono::steady_clock::now() +
+                               std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                   deadline - std::chrono::system_clock::now());
+  }
+
+  auto metadata = context->client_metadata();
+  auto search = metadata.find(util::MS_REQUEST_PRIORITY_HEADER);
+  if (search != metadata.end()) {
+    try {
+      request_options.priority = std::stoi(std::string{search->second.data(), search->second.length()});
+    } catch (const std::exception&) {
+      environment_->GetAppLogger()->warn("Ignoring invalid {} metadata", util::MS_REQUEST_PRIORITY_HEADER);
+    }
+  }
+
+  return request_options;
+}
+
 std::string PredictionServiceImpl::SetRequestContext(::grpc::ServerContext* context) {
   auto metadata = context->client_metadata();
   auto request_id = util::InternalRequestId();
@@ -20,6 +20,9 @@ class PredictionServiceImpl final : public onnxruntime::server::PredictionServic
 
   //Extract customer request ID and set request ID for response.
   std::string SetRequestContext(::grpc::ServerContext* context);
+
+  //Extract the request deadline and priority.
+  RequestOptions GetRequestOptions(::grpc::ServerContext* context);
 };
 }  // namespace grpc
 }  // namespace server
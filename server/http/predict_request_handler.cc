@@ -30,6 +30,7 @@ namespace protobufutil = google::protobuf::util;
 
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type,
                                 /* out */ PredictRequest& predictRequest, /* out */ http::status& error_code, /* out */ std::string& error_message);
+static bool ParseRequestOptions(const HttpContext& context, /* out */ RequestOptions& request_options, /* out */ std::string& error_message);
 
 void Predict(const std::string& name,
              const std::string& version,
@@ -54,7 +55,6 @@ void Predict(const std::string& name,
   }
 
   // Deserialize the payload
-  auto body = context.request.body();
   PredictRequest predict_request{};
   http::status error_code;
   std::string error_message;
@@ -64,8 +64,14 @@ void Predict(const std::string& name,
     return;
   }
 
+  RequestOptions request_options{};
+  if (!ParseRequestOptions(context, request_options, error_message)) {
+    GenerateErrorResponse(logger, http::status::bad_request, error_message, context);
+    return;
+  }
+
   // Run Prediction
-  Executor executor(env.get(), context.request_id);
+  Executor executor(env.get(), context.request_id, request_options);
   PredictResponse predict_response{};
   auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
   if (!status.ok()) {
@@ -96,12 +102,40 @@ void Predict(const std::string& name,
   if (!context.client_request_id.empty()) {
     context.response.insert(util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
   }
-  context.response.body() = response_body;
+  context.response.body() = std::move(response_body);
   context.response.result(http::status::ok);
 };
 
+static bool ParseRequestOptions(const HttpContext& context, RequestOptions& request_options, std::string& error_message) {
+  auto priority = context.request.find(util::MS_REQUEST_PRIORITY_HEADER);
+  if (priority != context.request.end()) {
+    try {
+      request_options.priority = std::stoi(priority->value().to_string());
+    } catch (const std::exception&) {
+      error_message = "Invalid '" + util::MS_REQUEST_PRIORITY_HEADER + "' header field in the request";
+      return false;
+    }
+  }
+
+  auto timeout = context.request.find(util::MS_REQUEST_TIMEOUT_HEADER);
+  if (timeout != context.request.end()) {
+    long long timeout_ms = -1;
+    try {
+      timeout_ms = std::stoll(timeout->value().to_string());
+    } catch (const std::exception&) {
+    }
+    if (timeout_ms < 0) {
+      error_message = "Invalid '" + util::MS_REQUEST_TIMEOUT_HEADER + "' header field in the request";
+      return false;
+    }
+    request_options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  }
+
+  return true;
+}
+
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type, PredictRequest& predictRequest, http::status& error_code, std::string& error_message) {
-  auto body = context.request.body();
+  const auto& body = context.request.body();
   protobufutil::Status status;
   switch (request_type) {
     case SupportedContentType::Json: {
@@ -3,6 +3,7 @@
 
 #include "environment.h"
 #include "http_server.h"
+#include "model_watcher.h"
 #include "predict_request_handler.h"
 #include "server_configuration.h"
 #include "grpc/grpc_app.h"
@@ -58,12 +59,35 @@ int main(int argc, char* argv[]) {
     exit(EXIT_FAILURE);
   }
 
-  const auto env = std::make_shared<server::ServerEnvironment>(config.logging_level, spdlog::sinks_init_list{std::make_shared<spdlog::sinks::stdout_sink_mt>(), std::make_shared<spdlog::sinks::syslog_sink_mt>()});
+  server::ThreadingOptions threading_options;
+  threading_options.use_global_thread_pools = config.use_global_thread_pools;
+  threading_options.intra_op_num_threads = config.intra_op_num_threads;
+  threading_options.inter_op_num_threads = config.inter_op_num_threads;
+  threading_options.allow_spinning = config.allow_spinning;
+
+  const auto env = std::make_shared<server::ServerEnvironment>(config.logging_level, spdlog::sinks_init_list{std::make_shared<spdlog::sinks::stdout_sink_mt>(), std::make_shared<spdlog::sinks::syslog_sink_mt>()}, threading_options);
   auto logger = env->GetAppLogger();
+  if (config.use_global_thread_pools) {
+    logger->info("Shared thread pools: {} intra-op threads, {} inter-op threads", config.intra_op_num_threads, config.inter_op_num_threads);
+  }
   logger->info("Model path: {}, ", config.model_path);
   logger->info("Model name: {}", config.model_name);
   logger->info("Model version: {}", config.model_version);
 
+  if (config.max_batch_size > 1) {
+    server::BatchingOptions batching_options;
+    batching_options.max_batch_size = static_cast<size_t>(config.max_batch_size);
+    batching_options.batch_timeout = std::chrono::microseconds(config.batch_timeout_micros);
+    env->SetBatchingOptions(batching_options);
+    logger->info("Dynamic batching: max batch size {}, timeout {}us", config.max_batch_size, config.batch_timeout_micros);
+  }
+
+  env->SetWarmupRuns(config.warmup_runs);
+  if (config.max_concurrent_runs > 0) {
+    env->SetMaxConcurrentRuns(static_cast<size_t>(config.max_concurrent_runs));
+    logger->info("Concurrent runs per model: {}", config.max_concurrent_runs);
+  }
+
   try {
     env->InitializeModel(config.model_path, config.model_name, config.model_version);
     logger->debug("Initialize Model Successfully!");
@@ -72,6 +96,13 @@ int main(int argc, char* argv[]) {
     exit(EXIT_FAILURE);
   }
 
+  std::unique_ptr<server::ModelWatcher> model_watcher;
+  if (config.model_poll_interval_ms > 0) {
+    model_watcher = std::make_unique<server::ModelWatcher>(*env, config.model_path, config.model_name, config.model_version,
+                                                           std::chrono::milliseconds(config.model_poll_interval_ms));
+    logger->info("Watching {} for new model versions every {}ms", config.model_path, config.model_poll_interval_ms);
+  }
+
   //Setup GRPC Server
   auto const grpc_address = config.address;
   auto const grpc_port = config.grpc_port;
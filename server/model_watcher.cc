@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "model_watcher.h"
+
+namespace onnxruntime {
+namespace server {
+
+ModelWatcher::ModelWatcher(ServerEnvironment& env, std::string model_path, std::string model_name,
+                           std::string model_version, std::chrono::milliseconds poll_interval)
+    : env_(env),
+      model_path_(std::move(model_path)),
+      model_name_(std::move(model_name)),
+      model_version_(std::move(model_version)),
+      poll_interval_(poll_interval),
+      worker_([this]() { Watch(); }) {
+}
+
+ModelWatcher::~ModelWatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+bool ModelWatcher::GetFileStamp(FileStamp& stamp) const {
+  struct stat file_stat;
+  if (stat(model_path_.c_str(), &file_stat) != 0) {
+    return false;
+  }
+
+  stamp.modification_time = file_stat.st_mtime;
+  stamp.size = static_cast<long long>(file_stat.st_size);
+  return true;
+}
+
+void ModelWatcher::Watch() {
+  auto logger = env_.GetAppLogger();
+
+  // the stamp of the served file, and of a change that has not been stable for a full interval yet
+  FileStamp served_stamp;
+  GetFileStamp(served_stamp);
+  FileStamp pending_stamp = served_stamp;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!cv_.wait_for(lock, poll_interval_, [this]() { return shutdown_; })) {
+    FileStamp stamp;
+    if (!GetFileStamp(stamp) || stamp == served_stamp) {
+      pending_stamp = served_stamp;
+      continue;
+    }
+
+    if (stamp != pending_stamp) {
+      pending_stamp = stamp;
+      continue;
+    }
+
+    // Load without holding the lock so the destructor is not blocked behind a slow load
+    lock.unlock();
+    logger->info("Model file {} changed, loading the new version of model {} version {}",
+                 model_path_, model_name_, model_version_);
+    try {
+      env_.ReloadModel(model_path_, model_name_, model_version_);
+      logger->info("Model {} version {} reloaded", model_name_, model_version_);
+    } catch (const Ort::Exception& ex) {
+      logger->error("Reloading model {} version {} failed, the previous version keeps serving: {}",
+                    model_name_, model_version_, ex.what());
+    }
+    // A file that failed to load is not retried until it changes again
+    served_stamp = stamp;
+    lock.lock();
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
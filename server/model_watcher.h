@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "environment.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Watches the file of a served model and hot-swaps the model when the file is replaced.
+//
+// The file is polled every poll_interval. A change is only picked up once the modification time and size
+// have been stable for one interval, so a model that is still being copied is not loaded. The new version
+// is loaded and warmed up on the watcher thread while the previous one keeps serving, then swapped in with
+// ServerEnvironment::ReloadModel. If the new file fails to load, the previous model keeps serving.
+class ModelWatcher {
+ public:
+  ModelWatcher(ServerEnvironment& env, std::string model_path, std::string model_name, std::string model_version,
+               std::chrono::milliseconds poll_interval);
+  ~ModelWatcher();
+
+  ModelWatcher(const ModelWatcher&) = delete;
+  ModelWatcher& operator=(const ModelWatcher&) = delete;
+
+ private:
+  struct FileStamp {
+    std::time_t modification_time{0};
+    long long size{-1};
+
+    bool operator==(const FileStamp& other) const {
+      return modification_time == other.modification_time && size == other.size;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+  };
+
+  // Returns false if the file cannot be accessed.
+  bool GetFileStamp(FileStamp& stamp) const;
+  void Watch();
+
+  ServerEnvironment& env_;
+  const std::string model_path_;
+  const std::string model_name_;
+  const std::string model_version_;
+  const std::chrono::milliseconds poll_interval_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool shutdown_{false};
+  std::thread worker_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "request_scheduler.h"
+
+namespace onnxruntime {
+namespace server {
+
+RequestScheduler::Slot::~Slot() {
+  if (scheduler_ != nullptr) {
+    scheduler_->Release();
+  }
+}
+
+RequestScheduler::Slot& RequestScheduler::Slot::operator=(Slot&& other) noexcept {
+  if (this != &other) {
+    if (scheduler_ != nullptr) {
+      scheduler_->Release();
+    }
+    scheduler_ = other.scheduler_;
+    other.scheduler_ = nullptr;
+  }
+  return *this;
+}
+
+RequestScheduler::RequestScheduler(size_t max_concurrent_runs) : max_concurrent_runs_(max_concurrent_runs) {
+}
+
+RequestScheduler::Slot RequestScheduler::Acquire(const RequestOptions& options) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (options.DeadlineExceeded()) {
+    return Slot{};
+  }
+
+  if (running_ < max_concurrent_runs_ && waiting_.empty()) {
+    ++running_;
+    return Slot{this};
+  }
+
+  Waiter waiter{options.priority, options.deadline, next_sequence_++, false};
+  waiting_.insert(&waiter);
+
+  // waiting until time_point::max() overflows in some implementations
+  if (options.HasDeadline()) {
+    cv_.wait_until(lock, options.deadline, [&waiter]() { return waiter.granted; });
+  } else {
+    cv_.wait(lock, [&waiter]() { return waiter.granted; });
+  }
+
+  if (!waiter.granted) {
+    waiting_.erase(&waiter);
+    return Slot{};
+  }
+  return Slot{this};
+}
+
+void RequestScheduler::Release() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --running_;
+
+    // Hand the slot to the best waiter that can still meet its deadline; the others time out on their own
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = waiting_.begin(); it != waiting_.end() && running_ < max_concurrent_runs_;) {
+      Waiter* waiter = *it;
+      it = waiting_.erase(it);
+      if (waiter->deadline <= now) {
+        continue;
+      }
+      waiter->granted = true;
+      ++running_;
+    }
+  }
+  cv_.notify_all();
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+
+namespace onnxruntime {
+namespace server {
+
+// Scheduling information of a request, taken from the request headers or the gRPC context.
+struct RequestOptions {
+  // Requests with a larger priority run first, e.g. interactive traffic above batch traffic.
+  int priority = 0;
+  // The request is dropped if it has not started running by then.
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+  bool HasDeadline() const { return deadline != std::chrono::steady_clock::time_point::max(); }
+  bool DeadlineExceeded() const { return HasDeadline() && std::chrono::steady_clock::now() >= deadline; }
+};
+
+// Bounds the number of concurrent Runs of one model.
+//
+// Requests beyond max_concurrent_runs wait, and the next free slot goes to the waiting request with the
+// highest priority, then the earliest deadline, then the earliest arrival. Requests whose deadline passes
+// while they wait are shed without running, so a backlog of low priority traffic does not delay
+// requests that can still meet their deadline.
+class RequestScheduler {
+ public:
+  explicit RequestScheduler(size_t max_concurrent_runs);
+
+  RequestScheduler(const RequestScheduler&) = delete;
+  RequestScheduler& operator=(const RequestScheduler&) = delete;
+
+  // A slot to run in, released when destroyed.
+  class Slot {
+   public:
+    Slot() = default;
+    ~Slot();
+    Slot(Slot&& other) noexcept : scheduler_(other.scheduler_) { other.scheduler_ = nullptr; }
+    Slot& operator=(Slot&& other) noexcept;
+    Slot(const Slot&) = delete;
+    Slot& operator=(const Slot&) = delete;
+
+    // Whether the slot was acquired, false if the request missed its deadline.
+    explicit operator bool() const { return scheduler_ != nullptr; }
+
+   private:
+    friend class RequestScheduler;
+    explicit Slot(RequestScheduler* scheduler) : scheduler_(scheduler) {}
+    RequestScheduler* scheduler_ = nullptr;
+  };
+
+  // Blocks until the request may run. Returns an empty slot if the deadline passes first.
+  Slot Acquire(const RequestOptions& options);
+
+ private:
+  struct Waiter {
+    int priority;
+    std::chrono::steady_clock::time_point deadline;
+    uint64_t sequence;
+    bool granted;
+  };
+
+  struct WaiterOrder {
+    bool operator()(const Waiter* a, const Waiter* b) const {
+      if (a->priority != b->priority) {
+        return a->priority > b->priority;
+      }
+      if (a->deadline != b->deadline) {
+        return a->deadline < b->deadline;
+      }
+      return a->sequence < b->sequence;
+    }
+  };
+
+  void Release();
+
+  const size_t max_concurrent_runs_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t running_{0};
+  uint64_t next_sequence_{0};
+  std::set<Waiter*, WaiterOrder> waiting_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "tensorprotoutils.h"
 
+#include <cstdint>
 #include <memory>
 #include <algorithm>
 #include <limits>
@@ -378,6 +379,35 @@ void TensorProtoToMLValue(const onnx::TensorProto& tensor_proto, const MemBuffer
   value = Ort::Value::CreateTensor(&allocator, tensor_data, m.GetLen(), tensor_shape_vec.data(), tensor_shape_vec.size(), (ONNXTensorElementDataType)tensor_proto.data_type());
   return;
 }
+bool TryWrapTensorProtoRawData(const onnx::TensorProto& tensor_proto, const OrtMemoryInfo& memory_info,
+                               Ort::Value& value) {
+  // raw_data is little endian, and the kernels expect the buffer to be aligned like an allocation
+  constexpr size_t alignment = 16;
+  ONNXTensorElementDataType ele_type = server::GetTensorElementType(tensor_proto);
+  if (!IsLittleEndianOrder() || !tensor_proto.has_raw_data() ||
+      tensor_proto.data_location() == onnx::TensorProto_DataLocation::TensorProto_DataLocation_EXTERNAL ||
+      ele_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING || ele_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
+    return false;
+  }
+
+  const std::string& raw_data = tensor_proto.raw_data();
+  if (reinterpret_cast<uintptr_t>(raw_data.data()) % alignment != 0) {
+    return false;
+  }
+
+  // let TensorProtoToMLValue report a size mismatch
+  size_t expected_size;
+  GetSizeInBytesFromTensorProto<0>(tensor_proto, &expected_size);
+  if (raw_data.size() != expected_size) {
+    return false;
+  }
+
+  std::vector<int64_t> tensor_shape_vec = GetTensorShapeFromTensorProto(tensor_proto);
+  value = Ort::Value::CreateTensor(&memory_info, const_cast<char*>(raw_data.data()), raw_data.size(),
+                                   tensor_shape_vec.data(), tensor_shape_vec.size(), ele_type);
+  return true;
+}
+
 template void GetSizeInBytesFromTensorProto<256>(const onnx::TensorProto& tensor_proto,
                                                  size_t* out);
 template void GetSizeInBytesFromTensorProto<0>(const onnx::TensorProto& tensor_proto, size_t* out);
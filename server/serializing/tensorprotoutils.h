@@ -27,6 +27,14 @@ void GetSizeInBytesFromTensorProto(const onnx::TensorProto& tensor_proto, size_t
  */
 void TensorProtoToMLValue(const onnx::TensorProto& input, const server::MemBuffer& m, /* out */ Ort::Value& value);
 
+/**
+ * wrap the raw_data of a TensorProto as a tensor without copying it.
+ * The TensorProto must outlive the value. Returns false if the data has to be copied with TensorProtoToMLValue,
+ * e.g. if it is not in raw_data, is not aligned or needs a byte swap.
+ */
+bool TryWrapTensorProtoRawData(const onnx::TensorProto& input, const OrtMemoryInfo& memory_info,
+                               /* out */ Ort::Value& value);
+
 template <typename T>
 void UnpackTensor(const onnx::TensorProto& tensor, const void* raw_data, size_t raw_data_len,
                   /*out*/ T* p_data, int64_t expected_size);
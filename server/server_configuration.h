@@ -45,6 +45,15 @@ class ServerConfiguration {
   unsigned short http_port = 8001;
   unsigned short grpc_port = 50051;
   int num_http_threads = std::thread::hardware_concurrency();
+  int max_batch_size = 0;
+  int batch_timeout_micros = 1000;
+  int warmup_runs = 1;
+  int model_poll_interval_ms = 0;
+  int max_concurrent_runs = 0;
+  bool use_global_thread_pools = false;
+  int intra_op_num_threads = 0;
+  int inter_op_num_threads = 0;
+  bool allow_spinning = true;
   OrtLoggingLevel logging_level{};
 
   ServerConfiguration() {
@@ -57,6 +66,15 @@ class ServerConfiguration {
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Maximum batch size for dynamic batching of concurrent requests. 0 or 1 disables batching");
+    desc.add_options()("batch_timeout_micros", po::value(&batch_timeout_micros)->default_value(batch_timeout_micros), "Maximum time in microseconds a request waits for a batch to fill up");
+    desc.add_options()("warmup_runs", po::value(&warmup_runs)->default_value(warmup_runs), "Number of runs with zero filled inputs before a model version serves requests");
+    desc.add_options()("max_concurrent_runs", po::value(&max_concurrent_runs)->default_value(max_concurrent_runs), "Maximum number of concurrent runs per model, further requests wait by priority and deadline. 0 means unbounded");
+    desc.add_options()("use_global_thread_pools", po::value(&use_global_thread_pools)->default_value(use_global_thread_pools), "Share one intra-op and one inter-op thread pool between all the models");
+    desc.add_options()("intra_op_num_threads", po::value(&intra_op_num_threads)->default_value(intra_op_num_threads), "Number of threads of the shared intra-op thread pool. 0 uses the default");
+    desc.add_options()("inter_op_num_threads", po::value(&inter_op_num_threads)->default_value(inter_op_num_threads), "Number of threads of the shared inter-op thread pool. 0 uses the default");
+    desc.add_options()("allow_spinning", po::value(&allow_spinning)->default_value(allow_spinning), "Whether the threads of the shared thread pools spin while waiting for work");
+    desc.add_options()("model_poll_interval_ms", po::value(&model_poll_interval_ms)->default_value(model_poll_interval_ms), "Interval in milliseconds at which model_path is checked for a new version to hot-swap. 0 disables reloading");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -103,6 +121,24 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
+    } else if (max_batch_size < 0) {
+      PrintHelp(std::cerr, "max_batch_size must not be negative");
+      return Result::ExitFailure;
+    } else if (batch_timeout_micros < 0) {
+      PrintHelp(std::cerr, "batch_timeout_micros must not be negative");
+      return Result::ExitFailure;
+    } else if (warmup_runs < 0) {
+      PrintHelp(std::cerr, "warmup_runs must not be negative");
+      return Result::ExitFailure;
+    } else if (max_concurrent_runs < 0) {
+      PrintHelp(std::cerr, "max_concurrent_runs must not be negative");
+      return Result::ExitFailure;
+    } else if (intra_op_num_threads < 0 || inter_op_num_threads < 0) {
+      PrintHelp(std::cerr, "intra_op_num_threads and inter_op_num_threads must not be negative");
+      return Result::ExitFailure;
+    } else if (model_poll_interval_ms < 0) {
+      PrintHelp(std::cerr, "model_poll_interval_ms must not be negative");
+      return Result::ExitFailure;
     } else if (!file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "batch_scheduler.h"
+#include "executor.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+class BatchSchedulerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // mul_batch.onnx computes Y = X * X for X of shape [N, 2].
+    const static auto model_file = "testdata/mul_batch.onnx";
+
+    BatchingOptions options;
+    options.max_batch_size = 8;
+    options.batch_timeout = std::chrono::microseconds(100000);
+
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->SetBatchingOptions(options);
+    env->InitializeModel(model_file, "Batch", "1");
+  }
+
+  void TearDown() override {
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->UnloadModel("Batch", "1");
+    env->SetBatchingOptions(BatchingOptions{});
+  }
+
+  static PredictRequest MakeRequest(const std::vector<float>& values) {
+    PredictRequest request{};
+    auto& tensor = (*request.mutable_inputs())["X"];
+    tensor.set_data_type(onnx::TensorProto_DataType_FLOAT);
+    tensor.add_dims(static_cast<int64_t>(values.size() / 2));
+    tensor.add_dims(2);
+    for (float value : values) {
+      tensor.add_float_data(value);
+    }
+    request.add_output_filter("Y");
+    return request;
+  }
+
+  static void CheckResponse(const PredictResponse& response, const std::vector<float>& values) {
+    const auto it = response.outputs().find("Y");
+    ASSERT_NE(it, response.outputs().end());
+    const auto& tensor = it->second;
+    ASSERT_EQ(tensor.dims_size(), 2);
+    EXPECT_EQ(tensor.dims(0), static_cast<int64_t>(values.size() / 2));
+    EXPECT_EQ(tensor.dims(1), 2);
+
+    std::vector<float> actual;
+    if (tensor.has_raw_data()) {
+      actual.resize(tensor.raw_data().size() / sizeof(float));
+      memcpy(actual.data(), tensor.raw_data().data(), tensor.raw_data().size());
+    } else {
+      actual.assign(tensor.float_data().begin(), tensor.float_data().end());
+    }
+    ASSERT_EQ(actual.size(), values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      EXPECT_EQ(actual[i], values[i] * values[i]);
+    }
+  }
+};
+
+TEST_F(BatchSchedulerTest, BatchesConcurrentRequests) {
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+  ASSERT_NE(env->GetBatchScheduler("Batch", "1"), nullptr);
+
+  // Requests with one to three rows are combined and scattered back in order.
+  constexpr int kRequests = 12;
+  std::vector<std::vector<float>> inputs(kRequests);
+  std::vector<PredictResponse> responses(kRequests);
+  std::vector<int> succeeded(kRequests, 0);
+  std::vector<std::thread> threads;
+
+  for (int r = 0; r < kRequests; r++) {
+    for (int i = 0; i < 2 * (r % 3 + 1); i++) {
+      inputs[r].push_back(static_cast<float>(r * 10 + i));
+    }
+  }
+
+  for (int r = 0; r < kRequests; r++) {
+    threads.emplace_back([&, r]() {
+      onnxruntime::server::Executor executor(env, "RequestId" + std::to_string(r));
+      auto request = MakeRequest(inputs[r]);
+      succeeded[r] = executor.Predict("Batch", "1", request, responses[r]).ok();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int r = 0; r < kRequests; r++) {
+    EXPECT_TRUE(succeeded[r]) << "request " << r;
+    CheckResponse(responses[r], inputs[r]);
+  }
+}
+
+TEST_F(BatchSchedulerTest, LargeRequestRunsDirectly) {
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  // A request that fills the maximum batch size by itself is not queued.
+  std::vector<float> input(2 * 8);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<float>(i);
+  }
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  PredictResponse response{};
+  auto request = MakeRequest(input);
+  EXPECT_TRUE(executor.Predict("Batch", "1", request, response).ok());
+  CheckResponse(response, input);
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -52,6 +54,61 @@ TEST_F(ExecutorTest, TestMul_1) {
   EXPECT_EQ(expected, body);
 }
 
+TEST_F(ExecutorTest, TestMul_1AfterReload) {
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})";
+  const static auto expected = R"({"outputs":{"Y":{"dims":["3","2"],"dataType":1,"floatData":[1,4,9,16,25,36]}}})";
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  // A request holding the previous version keeps it alive across the swap.
+  auto previous = env->GetModel("Name", "version");
+  env->ReloadModel("testdata/mul_1.onnx", "Name", "version");
+  EXPECT_NE(previous, env->GetModel("Name", "version"));
+  EXPECT_EQ(previous->output_names, env->GetModelOutputNames("Name", "version"));
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  auto protostatus = onnxruntime::server::GetRequestFromJson(input_json, request);
+  EXPECT_TRUE(protostatus.ok());
+
+  auto prediction_res = executor.Predict("Name", "version", request, response);
+  EXPECT_TRUE(prediction_res.ok());
+
+  std::string body;
+  protostatus = GenerateResponseInJson(response, body);
+  EXPECT_EQ(expected, body);
+}
+
+TEST_F(ExecutorTest, TestMul_1RawData) {
+  const std::vector<float> input{1, 2, 3, 4, 5, 6};
+  const std::vector<float> expected{1, 4, 9, 16, 25, 36};
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  onnx::TensorProto& x = (*request.mutable_inputs())["X"];
+  x.add_dims(3);
+  x.add_dims(2);
+  x.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  x.set_raw_data(input.data(), input.size() * sizeof(float));
+  request.add_output_filter("Y");
+
+  auto prediction_res = executor.Predict("Name", "version", request, response);
+  EXPECT_TRUE(prediction_res.ok());
+
+  ASSERT_EQ(response.outputs().count("Y"), 1u);
+  const auto& y = response.outputs().at("Y");
+  ASSERT_EQ(y.raw_data().size(), expected.size() * sizeof(float));
+  std::vector<float> actual(expected.size());
+  memcpy(actual.data(), y.raw_data().data(), y.raw_data().size());
+  EXPECT_EQ(expected, actual);
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "request_scheduler.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+TEST(RequestSchedulerTest, ShedsRequestsPastDeadline) {
+  RequestScheduler scheduler(1);
+
+  RequestOptions expired{};
+  expired.deadline = std::chrono::steady_clock::now() - std::chrono::milliseconds(1);
+  EXPECT_FALSE(scheduler.Acquire(expired));
+
+  // A waiting request is shed when its deadline passes before a slot frees up.
+  auto slot = scheduler.Acquire(RequestOptions{});
+  ASSERT_TRUE(slot);
+  RequestOptions waiting{};
+  waiting.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+  EXPECT_FALSE(scheduler.Acquire(waiting));
+}
+
+TEST(RequestSchedulerTest, GrantsSlotsByPriority) {
+  RequestScheduler scheduler(1);
+  auto slot = scheduler.Acquire(RequestOptions{});
+  ASSERT_TRUE(slot);
+
+  std::vector<int> order;
+  std::mutex order_mutex;
+  std::atomic<int> started{0};
+  std::vector<std::thread> threads;
+  for (int priority : {0, 2, 1}) {
+    threads.emplace_back([&, priority]() {
+      RequestOptions options{};
+      options.priority = priority;
+      ++started;
+      auto waiter_slot = scheduler.Acquire(options);
+      ASSERT_TRUE(waiter_slot);
+      std::lock_guard<std::mutex> lock(order_mutex);
+      order.push_back(priority);
+    });
+    // Let each request queue up before the next one arrives.
+    while (started.load() < static_cast<int>(threads.size())) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  slot = RequestScheduler::Slot{};
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(order, (std::vector<int>{2, 1, 0}));
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -48,9 +48,70 @@ TEST(ConfigParsingTests, Defaults) {
   EXPECT_EQ(config.address, "0.0.0.0");
   EXPECT_EQ(config.http_port, 8001);
   EXPECT_EQ(config.num_http_threads, 3);
+  EXPECT_EQ(config.max_batch_size, 0);
+  EXPECT_EQ(config.warmup_runs, 1);
+  EXPECT_EQ(config.model_poll_interval_ms, 0);
   EXPECT_EQ(config.logging_level, ORT_LOGGING_LEVEL_INFO);
 }
 
+TEST(ConfigParsingTests, Batching) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("16"),
+      const_cast<char*>("--batch_timeout_micros"), const_cast<char*>("500")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(7, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_EQ(config.max_batch_size, 16);
+  EXPECT_EQ(config.batch_timeout_micros, 500);
+}
+
+TEST(ConfigParsingTests, WarmupAndReloading) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--warmup_runs"), const_cast<char*>("3"),
+      const_cast<char*>("--model_poll_interval_ms"), const_cast<char*>("1000")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(7, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_EQ(config.warmup_runs, 3);
+  EXPECT_EQ(config.model_poll_interval_ms, 1000);
+}
+
+TEST(ConfigParsingTests, ThreadPools) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--use_global_thread_pools"), const_cast<char*>("true"),
+      const_cast<char*>("--intra_op_num_threads"), const_cast<char*>("8"),
+      const_cast<char*>("--inter_op_num_threads"), const_cast<char*>("2"),
+      const_cast<char*>("--max_concurrent_runs"), const_cast<char*>("4")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(11, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_TRUE(config.use_global_thread_pools);
+  EXPECT_EQ(config.intra_op_num_threads, 8);
+  EXPECT_EQ(config.inter_op_num_threads, 2);
+  EXPECT_EQ(config.max_concurrent_runs, 4);
+  EXPECT_TRUE(config.allow_spinning);
+}
+
+TEST(ConfigParsingTests, NegativeBatchSize) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("-1")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(5, test_argv);
+  EXPECT_EQ(res, Result::ExitFailure);
+}
+
 TEST(ConfigParsingTests, Help) {
   char* test_argv[] = {
       const_cast<char*>("/path/to/binary"),
@@ -18,11 +18,15 @@ contrib_ops_excluded_files = [
                     'bert/attention_impl.h',
                     'bert/attention_transpose.cu',
                     'bert/attention_past.cu',
+                    'bert/bert_padding.cu',
+                    'bert/bert_padding.h',
                     'bert/embed_layer_norm.cc',
                     'bert/embed_layer_norm.h',
                     'bert/embed_layer_norm_impl.cu',
                     'bert/embed_layer_norm_impl.h',
                     'bert/fast_gelu_impl.cu',
+                    'bert/fused_multihead_attention.cu',
+                    'bert/fused_multihead_attention.h',
                     'bert/layer_norm.cuh',
                     'bert/longformer_attention.cc',
                     'bert/longformer_attention.h',
@@ -32,6 +36,12 @@ contrib_ops_excluded_files = [
                     'bert/longformer_attention_impl.h',
                     'bert/longformer_global_impl.cu',
                     'bert/longformer_global_impl.h',
+                    'bert/packed_attention.cc',
+                    'bert/packed_attention.h',
+                    'bert/remove_padding.cc',
+                    'bert/remove_padding.h',
+                    'bert/restore_padding.cc',
+                    'bert/restore_padding.h',
                     'math/bias_softmax.cc',
                     'math/bias_softmax.h',
                     'math/bias_softmax_impl.cu',
@@ -44,10 +54,19 @@ contrib_ops_excluded_files = [
                     'math/fft_ops.h',
                     'math/fft_ops_impl.cu',
                     'math/fft_ops_impl.h',
+                    'math/fused_elementwise.cc',
+                    'math/fused_elementwise.h',
+                    'math/fused_elementwise_impl.cu',
+                    'math/fused_elementwise_impl.h',
+                    'math/fused_gemm.cc',
                     'quantization/attention_quantization.cc',
                     'quantization/attention_quantization.h',
                     'quantization/attention_quantization_impl.cu',
                     'quantization/attention_quantization_impl.cuh',
+                    'quantization/matmul_nbits.cc',
+                    'quantization/matmul_nbits.h',
+                    'quantization/matmul_nbits_impl.cu',
+                    'quantization/matmul_nbits_impl.h',
                     'quantization/quantize_dequantize_linear.cc',
                     'tensor/crop.cc',
                     'tensor/crop.h',
@@ -81,12 +100,16 @@ provider_excluded_files = [
                 'math/einsum_utils/einsum_auxiliary_ops_diagonal.h',
                 'math/einsum.cc',
                 'math/einsum.h',
+                'math/cublaslt_matmul.cc',
+                'math/cublaslt_matmul.h',
                 'math/gemm.cc',
                 'math/matmul.cc',
                 'math/matmul_integer.cc',
                 'math/matmul_integer.cu',
                 'math/matmul_integer.cuh',
                 'math/matmul_integer.h',
+                'math/quantize_linear_matmul.cc',
+                'math/quantize_linear_matmul.h',
                 'math/softmax_impl.cu',
                 'math/softmax.cc',
                 'math/topk.cc',
@@ -97,6 +120,8 @@ provider_excluded_files = [
                 'nn/batch_norm.h',
                 'nn/conv.cc',
                 'nn/conv.h',
+                'nn/conv_algo_cache.cc',
+                'nn/conv_algo_cache.h',
                 'nn/conv_transpose.cc',
                 'nn/conv_transpose.h',
                 'nn/instance_norm.cc',
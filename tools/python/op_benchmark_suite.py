@@ -0,0 +1,372 @@
+"""
+Generates and runs a per-operator benchmark suite from the nodes of an ONNX model.
+
+generate: Runs shape inference and the model once, then creates a single node model (plus input data captured from
+          the run) for each distinct (domain, op, attributes, input types and shapes) tuple in the model.
+run:      Times every model in a suite with a given execution provider. Each single node model is run with graph
+          optimizations disabled, so the kernel chosen from the execution provider's kernel registry for that node is
+          timed in isolation. Kernel times are read from the ORT profiler so they exclude session and python overhead.
+compare:  Compares the results of two runs (e.g. from two ORT versions) and reports kernels that got slower.
+"""
+
+import argparse
+import csv
+import glob
+import json
+import os
+import sys
+import tempfile
+import time
+
+import numpy as np
+import onnx
+from onnx import helper, numpy_helper, shape_inference
+
+import onnx_test_data_utils
+import ort_test_dir_utils
+
+SUITE_MANIFEST = 'suite.json'
+
+
+def _tensor_types(graph):
+    """Map of value name to TypeProto for every value in the graph with an inferred tensor type."""
+    types = {}
+    for vi in list(graph.input) + list(graph.value_info) + list(graph.output):
+        if vi.type.WhichOneof('value') == 'tensor_type' and vi.type.tensor_type.elem_type:
+            types[vi.name] = vi.type
+    return types
+
+
+def _has_subgraph(node):
+    return any(attr.type in (onnx.AttributeProto.GRAPH, onnx.AttributeProto.GRAPHS) for attr in node.attribute)
+
+
+def _capture_values(model, feeds):
+    """Run the model once and return a map of every tensor value name to its numpy data."""
+    import onnxruntime as ort
+
+    graph = model.graph
+    types = _tensor_types(graph)
+    initializers = {init.name for init in graph.initializer}
+    existing_outputs = {o.name for o in graph.output}
+
+    # expose every intermediate value the nodes consume as a graph output
+    capture_model = onnx.ModelProto()
+    capture_model.CopyFrom(model)
+    for node in graph.node:
+        for name in node.input:
+            if name and name not in initializers and name not in feeds and name not in existing_outputs \
+                    and name in types:
+                capture_model.graph.output.append(helper.make_value_info(name, types[name]))
+                existing_outputs.add(name)
+
+    so = ort.SessionOptions()
+    so.graph_optimization_level = ort.GraphOptimizationLevel.ORT_DISABLE_ALL
+    sess = ort.InferenceSession(capture_model.SerializeToString(), so, providers=['CPUExecutionProvider'])
+    output_names = [o.name for o in sess.get_outputs()]
+    values = dict(zip(output_names, sess.run(output_names, feeds)))
+    values.update(feeds)
+    for init in graph.initializer:
+        values[init.name] = numpy_helper.to_array(init)
+    return values
+
+
+def _load_feeds(model, input_dir, symbolic_dims):
+    feeds = {}
+    if input_dir:
+        for pb in sorted(glob.glob(os.path.join(input_dir, 'input_*.pb'))):
+            name, data = onnx_test_data_utils.read_tensorproto_pb_file(pb)
+            feeds[name] = data
+
+    initializer_set = {init.name for init in model.graph.initializer}
+    ort_test_dir_utils._create_missing_input_data(model.graph.input, feeds, symbolic_dims, initializer_set)
+    return feeds
+
+
+def _node_key(node, input_values, initializers):
+    attributes = tuple(attr.SerializeToString() for attr in sorted(node.attribute, key=lambda a: a.name))
+    inputs = tuple((str(input_values[name].dtype), input_values[name].shape, name in initializers) if name else None
+                   for name in node.input)
+    return (node.domain, node.op_type, attributes, inputs, len(node.output))
+
+
+def _describe_shapes(entry_inputs):
+    return ';'.join('x'.join(str(d) for d in i['shape']) if i else '' for i in entry_inputs)
+
+
+def generate_suite(model_path, output_dir, input_dir=None, symbolic_dims=None):
+    """
+    Create a benchmark suite with one single node model per distinct node configuration in a model.
+
+    :param model_path: Path to the onnx model.
+    :param output_dir: Directory to create the suite in. Each entry is a test directory that can also be run with
+                       onnxruntime_perf_test.
+    :param input_dir: Optional test_data_set directory with input_<n>.pb files to run the model with.
+                      Random data is generated for any missing inputs.
+    :param symbolic_dims: Map of symbolic dimension name to the value to use when generating input data.
+    :return: List of the suite entries.
+    """
+    model = shape_inference.infer_shapes(onnx.load(model_path))
+    graph = model.graph
+    types = _tensor_types(graph)
+    initializers = {init.name for init in graph.initializer}
+
+    feeds = _load_feeds(model, input_dir, symbolic_dims or {})
+    values = _capture_values(model, feeds)
+
+    entries = []
+    entry_by_key = {}
+    skipped = 0
+    for node in graph.node:
+        # Constant nodes are turned into initializers when the graph is loaded
+        if node.op_type == 'Constant' or _has_subgraph(node):
+            continue
+
+        if any(name and (name not in values or not isinstance(values[name], np.ndarray)) for name in node.input):
+            skipped += 1
+            continue
+
+        key = _node_key(node, values, initializers)
+        if key in entry_by_key:
+            entry_by_key[key]['count'] += 1
+            continue
+
+        name = '{:04d}_{}'.format(len(entries), node.op_type)
+        graph_inputs = []
+        graph_initializers = []
+        seen = set()
+        for input_name in node.input:
+            if not input_name or input_name in seen:
+                continue
+            seen.add(input_name)
+            data = values[input_name]
+            if input_name in initializers:
+                # keep weights constant so the kernel can pre-pack them as it would in the full model
+                graph_initializers.append(numpy_helper.from_array(data, input_name))
+            else:
+                elem_type = onnx.mapping.NP_TYPE_TO_TENSOR_TYPE[data.dtype]
+                graph_inputs.append(helper.make_tensor_value_info(input_name, elem_type, data.shape))
+
+        graph_outputs = []
+        for output_name in node.output:
+            if not output_name:
+                continue
+            if output_name in types:
+                graph_outputs.append(helper.make_value_info(output_name, types[output_name]))
+            else:
+                graph_outputs.append(helper.make_empty_tensor_value_info(output_name))
+
+        bench_node = onnx.NodeProto()
+        bench_node.CopyFrom(node)
+        bench_node.name = name
+        bench_graph = helper.make_graph([bench_node], name, graph_inputs, graph_outputs, graph_initializers)
+        bench_model = helper.make_model(bench_graph, opset_imports=model.opset_import)
+        bench_model.ir_version = model.ir_version
+
+        test_dir = os.path.join(output_dir, name)
+        test_data_dir = os.path.join(test_dir, 'test_data_set_0')
+        os.makedirs(test_data_dir, exist_ok=True)
+        onnx.save(bench_model, os.path.join(test_dir, 'model.onnx'))
+        for idx, graph_input in enumerate(graph_inputs):
+            onnx_test_data_utils.numpy_to_pb(graph_input.name, values[graph_input.name],
+                                             os.path.join(test_data_dir, 'input_{}.pb'.format(idx)))
+
+        entry = {
+            'name': name,
+            'domain': node.domain,
+            'op_type': node.op_type,
+            'attributes': {attr.name: str(helper.get_attribute_value(attr)) for attr in node.attribute},
+            'inputs': [{
+                'dtype': str(values[i].dtype),
+                'shape': list(values[i].shape),
+                'initializer': i in initializers
+            } if i else None for i in node.input],
+            'count': 1,
+        }
+        entry_by_key[key] = entry
+        entries.append(entry)
+
+    with open(os.path.join(output_dir, SUITE_MANIFEST), 'w') as f:
+        json.dump({'model': os.path.abspath(model_path), 'entries': entries}, f, indent=2)
+
+    print('Created {} benchmarks for {} nodes in {}'.format(len(entries), sum(e['count'] for e in entries),
+                                                              output_dir))
+    if skipped:
+        print('Skipped {} nodes with inputs that could not be captured.'.format(skipped))
+    return entries
+
+
+def _percentile(sorted_values, p):
+    return sorted_values[min(int(len(sorted_values) * p), len(sorted_values) - 1)]
+
+
+def run_suite(suite_dir, providers, intra_op_num_threads=0, min_time=1.0, min_iterations=10):
+    """
+    Time each single node model of a suite.
+
+    :param suite_dir: Directory created by generate_suite.
+    :param providers: List of execution providers to run with, in priority order.
+    :param intra_op_num_threads: Number of intra op threads. 0 lets ORT choose.
+    :param min_time: Minimum time in seconds to spend timing each entry.
+    :param min_iterations: Minimum number of timed runs for each entry.
+    :return: List of result rows.
+    """
+    import onnxruntime as ort
+
+    with open(os.path.join(suite_dir, SUITE_MANIFEST)) as f:
+        manifest = json.load(f)
+
+    results = []
+    profile_dir = tempfile.mkdtemp()
+    for entry in manifest['entries']:
+        test_dir = os.path.join(suite_dir, entry['name'])
+        feeds = {}
+        for pb in sorted(glob.glob(os.path.join(test_dir, 'test_data_set_0', 'input_*.pb'))):
+            name, data = onnx_test_data_utils.read_tensorproto_pb_file(pb)
+            feeds[name] = data
+
+        so = ort.SessionOptions()
+        so.graph_optimization_level = ort.GraphOptimizationLevel.ORT_DISABLE_ALL
+        so.intra_op_num_threads = intra_op_num_threads
+        so.enable_profiling = True
+        so.profile_file_prefix = os.path.join(profile_dir, entry['name'])
+        try:
+            sess = ort.InferenceSession(os.path.join(test_dir, 'model.onnx'), so, providers=providers)
+            for _ in range(5):
+                sess.run(None, feeds)
+
+            wall_times = []
+            start = time.perf_counter()
+            while len(wall_times) < min_iterations or time.perf_counter() - start < min_time:
+                run_start = time.perf_counter()
+                sess.run(None, feeds)
+                wall_times.append(time.perf_counter() - run_start)
+        except Exception as e:
+            print('{}: {}'.format(entry['name'], e), file=sys.stderr)
+            continue
+
+        with open(sess.end_profiling()) as f:
+            events = json.load(f)
+        kernel_events = [e for e in events if e.get('cat') == 'Node' and e['name'] == entry['name'] + '_kernel_time']
+        # the timed runs are the last ones profiled
+        kernel_events = kernel_events[-len(wall_times):]
+        kernel_times = sorted(e['dur'] for e in kernel_events)
+        wall_times.sort()
+
+        row = {
+            'name': entry['name'],
+            'op_type': entry['op_type'],
+            'domain': entry['domain'],
+            'input_shapes': _describe_shapes(entry['inputs']),
+            'count': entry['count'],
+            'provider': kernel_events[0]['args'].get('provider', '') if kernel_events else '',
+            'iterations': len(wall_times),
+            'kernel_avg_us': sum(kernel_times) / len(kernel_times) if kernel_times else '',
+            'kernel_p50_us': _percentile(kernel_times, 0.5) if kernel_times else '',
+            'kernel_p90_us': _percentile(kernel_times, 0.9) if kernel_times else '',
+            'wall_p50_us': _percentile(wall_times, 0.5) * 1e6,
+        }
+        results.append(row)
+        print('{name} {op_type} [{input_shapes}] {provider}: p50 {kernel_p50_us} us'.format(**row))
+
+    return results
+
+
+def compare_results(baseline_rows, current_rows, threshold):
+    """
+    Print the kernel p50 time of each entry in the current results relative to the baseline.
+
+    :return: Names of the entries that are slower than the baseline by more than threshold (e.g. 0.1 for 10%).
+    """
+    baseline = {row['name']: row for row in baseline_rows}
+    comparisons = []
+    for row in current_rows:
+        base = baseline.get(row['name'])
+        if not base or not base['kernel_p50_us'] or not row['kernel_p50_us']:
+            continue
+        ratio = float(row['kernel_p50_us']) / float(base['kernel_p50_us'])
+        comparisons.append((ratio, row, base))
+
+    regressions = []
+    base_total = 0.0
+    current_total = 0.0
+    for ratio, row, base in sorted(comparisons, key=lambda c: c[0], reverse=True):
+        count = int(row['count'])
+        base_total += float(base['kernel_p50_us']) * count
+        current_total += float(row['kernel_p50_us']) * count
+        flag = ''
+        if ratio > 1 + threshold:
+            flag = ' REGRESSION'
+            regressions.append(row['name'])
+        print('{} {} [{}] x{}: {} us -> {} us ({:.2f}x){}'.format(row['name'], row['op_type'], row['input_shapes'],
+                                                                 count, base['kernel_p50_us'], row['kernel_p50_us'],
+                                                                 ratio, flag))
+
+    if base_total > 0:
+        print('Sum of kernel p50 times over all nodes: {:.1f} us -> {:.1f} us ({:.2f}x)'.format(
+            base_total, current_total, current_total / base_total))
+    return regressions
+
+
+def _read_csv(path):
+    with open(path, newline='') as f:
+        return list(csv.DictReader(f))
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(os.path.basename(__file__),
+                                     description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    subparsers = parser.add_subparsers(dest='action', required=True)
+
+    generate = subparsers.add_parser('generate', help='Create a benchmark suite from a model.')
+    generate.add_argument('-m', '--model', required=True, help='model file')
+    generate.add_argument('-o', '--out', required=True, help='directory to create the suite in')
+    generate.add_argument('--input_dir', help='test_data_set directory with input_<n>.pb files to run the model with')
+    generate.add_argument('--symbolic_dims', default='',
+                          help='comma separated name=value pairs for symbolic dimensions of generated input data. '
+                          'e.g. batch=1,seq_len=128')
+
+    run = subparsers.add_parser('run', help='Time each kernel in a benchmark suite.')
+    run.add_argument('-s', '--suite', required=True, help='suite directory')
+    run.add_argument('-o', '--out', required=True, help='csv file to write the results to')
+    run.add_argument('-p', '--providers', default='CPUExecutionProvider',
+                     help='comma separated execution providers in priority order')
+    run.add_argument('-x', '--intra_op_num_threads', type=int, default=0)
+    run.add_argument('-t', '--min_time', type=float, default=1.0, help='minimum seconds to time each kernel for')
+
+    compare = subparsers.add_parser('compare', help='Compare two sets of results.')
+    compare.add_argument('baseline', help='csv results to compare against')
+    compare.add_argument('current', help='csv results to check')
+    compare.add_argument('--threshold', type=float, default=0.1,
+                         help='relative slowdown of the kernel p50 time that counts as a regression')
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    if args.action == 'generate':
+        symbolic_dims = {}
+        for pair in filter(None, args.symbolic_dims.split(',')):
+            name, value = pair.split('=')
+            symbolic_dims[name] = int(value)
+        os.makedirs(args.out, exist_ok=True)
+        generate_suite(args.model, args.out, args.input_dir, symbolic_dims)
+    elif args.action == 'run':
+        results = run_suite(args.suite, args.providers.split(','), args.intra_op_num_threads, args.min_time)
+        if results:
+            with open(args.out, 'w', newline='') as f:
+                writer = csv.DictWriter(f, fieldnames=list(results[0].keys()))
+                writer.writeheader()
+                writer.writerows(results)
+    else:
+        regressions = compare_results(_read_csv(args.baseline), _read_csv(args.current), args.threshold)
+        if regressions:
+            print('{} kernels regressed by more than {:.0%}'.format(len(regressions), args.threshold))
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
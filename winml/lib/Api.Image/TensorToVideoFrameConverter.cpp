@@ -274,24 +274,39 @@ void TensorToVideoFrameConverter::ConvertDX12TensorToUnsupportedVideoFrameFormat
   ComPtr<ID3D11Device> d3d11Device;
   unsupportedTexture->GetDevice(&d3d11Device);
 
-  output_resource_ = CreateShareableD3D12Texture(supportedDesc, device_cache.GetD3D12Device());
-  ComPtr<ID3D11Texture2D> spSharedD3D11Texture = ShareD3D12Texture(output_resource_.Get(), d3d11Device.Get());
+  // Reuse the converted texture and video frame of the previous evaluation when they match, so that a video pipeline
+  // doesn't create and share a texture for every frame. The CPU path also uses converted_video_frame_, for a frame
+  // backed by a SoftwareBitmap.
+  bool isCachedTextureReusable = false;
+  if (converted_D3D11_texture_ && converted_video_frame_ && converted_video_frame_.Direct3DSurface()) {
+    D3D11_TEXTURE2D_DESC cachedDesc;
+    converted_D3D11_texture_->GetDesc(&cachedDesc);
+    ComPtr<ID3D11Device> cachedDevice;
+    converted_D3D11_texture_->GetDevice(&cachedDevice);
+    isCachedTextureReusable = cachedDesc.Width == supportedDesc.Width && cachedDesc.Height == supportedDesc.Height &&
+                              cachedDesc.Format == supportedDesc.Format && cachedDevice.Get() == d3d11Device.Get();
+  }
+
+  if (!isCachedTextureReusable) {
+    converted_resource_ = CreateShareableD3D12Texture(supportedDesc, device_cache.GetD3D12Device());
+    converted_D3D11_texture_ = ShareD3D12Texture(converted_resource_.Get(), d3d11Device.Get());
 
-  ComPtr<IDXGISurface> dxgiSurface;
-  WINML_THROW_IF_FAILED(spSharedD3D11Texture->QueryInterface(IID_PPV_ARGS(&dxgiSurface)));
+    ComPtr<IDXGISurface> dxgiSurface;
+    WINML_THROW_IF_FAILED(converted_D3D11_texture_->QueryInterface(IID_PPV_ARGS(&dxgiSurface)));
 
-  ComPtr<IInspectable> inspectableSurface;
-  WINML_THROW_IF_FAILED(CreateDirect3D11SurfaceFromDXGISurface(dxgiSurface.Get(), &inspectableSurface));
+    ComPtr<IInspectable> inspectableSurface;
+    WINML_THROW_IF_FAILED(CreateDirect3D11SurfaceFromDXGISurface(dxgiSurface.Get(), &inspectableSurface));
 
-  wgdx::Direct3D11::IDirect3DSurface surface;
-  WINML_THROW_IF_FAILED(inspectableSurface->QueryInterface(winrt::guid_of<decltype(surface)>(), reinterpret_cast<void**>(winrt::put_abi(surface))));
-  converted_video_frame_ = wm::VideoFrame::CreateWithDirect3D11Surface(surface);
+    wgdx::Direct3D11::IDirect3DSurface surface;
+    WINML_THROW_IF_FAILED(inspectableSurface->QueryInterface(winrt::guid_of<decltype(surface)>(), reinterpret_cast<void**>(winrt::put_abi(surface))));
+    converted_video_frame_ = wm::VideoFrame::CreateWithDirect3D11Surface(surface);
+  }
 
   // Detensorize
-  ConvertGPUTensorToDX12Texture(batchIdx, pInputTensor, device_cache, tensorDesc, output_resource_.Get());
+  ConvertGPUTensorToDX12Texture(batchIdx, pInputTensor, device_cache, tensorDesc, converted_resource_.Get());
 
   // Wait for the D3D12 work to complete before using the resource
-  SyncD3D12ToD3D11(device_cache, spSharedD3D11Texture.Get());
+  SyncD3D12ToD3D11(device_cache, converted_D3D11_texture_.Get());
 
   // Finally, convert and copy the texture to the destination video frame
   converted_video_frame_.CopyToAsync(unsupportedVideoFrame).get();
@@ -435,7 +450,7 @@ void TensorToVideoFrameConverter::ConvertGPUTensorToDX12Texture(
   UINT srvUavDescriptorSize = spDx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
   // Create a UAV resource for the shader
-  D3D12_RESOURCE_DESC outputResourceDesc = output_resource_->GetDesc();
+  D3D12_RESOURCE_DESC outputResourceDesc = outputDesc;
   outputResourceDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
 
   if (!UAV_resource_ || outputDesc.Format != UAV_resource_->GetDesc().Format || outputDesc.Width != UAV_resource_->GetDesc().Width || outputDesc.Height != UAV_resource_->GetDesc().Height) {
@@ -240,7 +240,8 @@ void VideoFrameToTensorConverter::VideoFrameToDX12Tensor(
         D3D11_TEXTURE2D_DESC cachedTextureDesc;
         D3D11_cached_texture_->GetDesc(&cachedTextureDesc);
 
-        if (cachedTextureDesc.Width != scaledBounds.Width || cachedTextureDesc.Height != scaledBounds.Height || cachedTextureDesc.Format != videoFrameTextureDesc.Format) {
+        // The cached texture has the size of the whole video frame texture, not of the bounds, which are a crop of it
+        if (cachedTextureDesc.Width != videoFrameTextureDesc.Width || cachedTextureDesc.Height != videoFrameTextureDesc.Height || cachedTextureDesc.Format != videoFrameTextureDesc.Format) {
           // The dimensions or format don't match, so we need to re-create our texture
           WINML_THROW_IF_FAILED(pDeviceCache->GetD3D11Device()->CreateTexture2D(&videoFrameTextureDesc, nullptr, &D3D11_cached_texture_));
           input_D3D12_resource_ = ShareD3D11Texture(D3D11_cached_texture_.Get(), pDeviceCache->GetD3D12Device());
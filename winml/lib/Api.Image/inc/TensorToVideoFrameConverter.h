@@ -42,6 +42,9 @@ class TensorToVideoFrameConverter : public ImageConverter {
   Microsoft::WRL::ComPtr<ID3D12Resource> readback_heap_;
   Microsoft::WRL::ComPtr<ID3D12Resource> output_resource_;
   Microsoft::WRL::ComPtr<ID3D12Resource> UAV_resource_;
+  // texture of a format supported for UAV, converted to the format of the destination video frame
+  Microsoft::WRL::ComPtr<ID3D12Resource> converted_resource_;
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> converted_D3D11_texture_;
   HANDLE shared_handle_;
 
   Microsoft::WRL::ComPtr<ID3D11Texture2D> ShareD3D12Texture(ID3D12Resource* pResource, ID3D11Device* pDevice);